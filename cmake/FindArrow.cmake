@@ -0,0 +1,47 @@
+# Find Arrow - Apache Arrow columnar format with its Parquet reader
+#
+# This module defines
+#  ARROW_FOUND - whether the arrow and parquet libraries were found
+#  ARROW_LIBRARIES - the arrow and parquet libraries
+#  ARROW_INCLUDE_DIR - the include path of the arrow library
+#
+
+if (ARROW_INCLUDE_DIR AND ARROW_LIBRARIES)
+
+  # Already in cache
+  set (ARROW_FOUND TRUE)
+
+else (ARROW_INCLUDE_DIR AND ARROW_LIBRARIES)
+
+  find_library (ARROW_LIBRARY
+    NAMES
+    arrow
+    PATHS
+  )
+
+  find_library (PARQUET_LIBRARY
+    NAMES
+    parquet
+    PATHS
+  )
+
+  find_path (ARROW_INCLUDE_DIR
+    NAMES
+    arrow/api.h
+    PATHS
+  )
+
+  find_path (PARQUET_INCLUDE_DIR
+    NAMES
+    parquet/arrow/reader.h
+    PATHS
+  )
+
+  if (ARROW_LIBRARY AND PARQUET_LIBRARY)
+    set (ARROW_LIBRARIES ${PARQUET_LIBRARY} ${ARROW_LIBRARY})
+  endif ()
+
+  include(FindPackageHandleStandardArgs)
+  find_package_handle_standard_args(Arrow DEFAULT_MSG ARROW_LIBRARIES ARROW_INCLUDE_DIR PARQUET_INCLUDE_DIR)
+
+endif (ARROW_INCLUDE_DIR AND ARROW_LIBRARIES)
@@ -0,0 +1,104 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _SHOGUN_COREML_CONVERTERS_H__
+#define _SHOGUN_COREML_CONVERTERS_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGVector.h>
+
+#include <Model.pb.h>
+
+#include <memory>
+#include <string>
+
+namespace shogun
+{
+	class CARTree;
+	class KernelMachine;
+	class LinearMachine;
+	class NeuralNetwork;
+	class RandomForest;
+
+	namespace coreml
+	{
+		namespace detail
+		{
+			using CoreML::Specification::Model;
+
+			/** name of the input of converted machines */
+			constexpr const char* kInput = "input";
+			/** name of the predicted class of classifiers */
+			constexpr const char* kClassLabel = "classLabel";
+			/** name of the class probabilities of classifiers */
+			constexpr const char* kClassProbability = "classProbability";
+			/** name of the prediction of regressors */
+			constexpr const char* kPrediction = "prediction";
+
+			/** @return dimension of the input of a machine
+			 *
+			 * @param model_dim dimension the machine was trained on, -1 if
+			 * unknown
+			 * @param num_features requested dimension, -1 if unknown
+			 * @param name name of the machine
+			 */
+			int32_t input_dim(
+			    int32_t model_dim, int32_t num_features, const char* name);
+
+			/** add a multi-array of doubles to the inputs of the model */
+			void add_array_input(
+			    Model& model, const std::string& name, int32_t dim);
+
+			/** add a multi-array of doubles to the outputs of the model */
+			void add_array_output(
+			    Model& model, const std::string& name, int32_t dim);
+
+			/** add the predicted class and optionally the class
+			 * probabilities to the outputs of the model */
+			void add_classifier_outputs(Model& model, bool probabilities);
+
+			/** add the double prediction to the outputs of the model */
+			void add_regressor_output(Model& model);
+
+			/** @return class labels of a classifier model */
+			const CoreML::Specification::Int64Vector&
+			class_labels(const Model& model);
+
+			/** fill an Int64Vector with the given labels */
+			void set_labels(
+			    CoreML::Specification::Int64Vector* vector,
+			    const SGVector<int64_t>& labels);
+
+			/** LinearMachine as generalized linear model */
+			Model convert_linear_machine(
+			    const std::shared_ptr<LinearMachine>& machine,
+			    int32_t num_features, const std::string& input);
+
+			/** KernelMachine as support vector machine */
+			Model convert_kernel_machine(
+			    const std::shared_ptr<KernelMachine>& machine,
+			    int32_t num_features, const std::string& input);
+
+			/** CARTree as tree ensemble of one tree */
+			Model convert_cart_tree(
+			    const std::shared_ptr<CARTree>& tree, int32_t num_features,
+			    const std::string& input);
+
+			/** RandomForest as tree ensemble */
+			Model convert_random_forest(
+			    const std::shared_ptr<RandomForest>& forest,
+			    int32_t num_features, const std::string& input);
+
+			/** NeuralNetwork as chain of neural network layers */
+			Model convert_neural_network(
+			    const std::shared_ptr<NeuralNetwork>& network,
+			    int32_t num_features, const std::string& input);
+		} // namespace detail
+	} // namespace coreml
+} // namespace shogun
+
+#endif /* _SHOGUN_COREML_CONVERTERS_H__ */
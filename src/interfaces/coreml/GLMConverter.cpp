@@ -0,0 +1,63 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include "Converters.h"
+
+#include <shogun/machine/LinearMachine.h>
+
+using namespace shogun;
+using namespace shogun::coreml::detail;
+namespace spec = CoreML::Specification;
+
+Model coreml::detail::convert_linear_machine(
+    const std::shared_ptr<LinearMachine>& machine, int32_t num_features,
+    const std::string& input)
+{
+	const auto w = machine->get_w();
+	const auto bias = machine->get_bias();
+	require(w.vlen > 0, "{} is not trained", machine->get_name());
+
+	Model model;
+	add_array_input(
+	    model, input, input_dim(w.vlen, num_features, machine->get_name()));
+
+	switch (machine->get_machine_problem_type())
+	{
+	case PT_BINARY:
+	{
+		// the logistic of the output is the probability of the second
+		// class, the sign of the output picks the same label as shogun
+		auto glm = model.mutable_glmclassifier();
+		auto weights = glm->add_weights();
+		for (auto w_i : w)
+			weights->add_value(w_i);
+		glm->add_offset(bias);
+		glm->set_postevaluationtransform(spec::GLMClassifier::Logit);
+		glm->set_classencoding(spec::GLMClassifier::ReferenceClass);
+		set_labels(glm->mutable_int64classlabels(), SGVector<int64_t>{-1, 1});
+		add_classifier_outputs(model, true);
+		break;
+	}
+	case PT_REGRESSION:
+	{
+		auto glm = model.mutable_glmregressor();
+		auto weights = glm->add_weights();
+		for (auto w_i : w)
+			weights->add_value(w_i);
+		glm->add_offset(bias);
+		glm->set_postevaluationtransform(spec::GLMRegressor::NoTransform);
+		add_regressor_output(model);
+		break;
+	}
+	default:
+		error(
+		    "{} of problem type {} can not be converted to CoreML",
+		    machine->get_name(),
+		    static_cast<int32_t>(machine->get_machine_problem_type()));
+	}
+
+	return model;
+}
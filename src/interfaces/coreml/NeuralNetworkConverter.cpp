@@ -0,0 +1,199 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include "Converters.h"
+
+#include <shogun/neuralnets/NeuralInputLayer.h>
+#include <shogun/neuralnets/NeuralLayer.h>
+#include <shogun/neuralnets/NeuralLeakyRectifiedLinearLayer.h>
+#include <shogun/neuralnets/NeuralNetwork.h>
+
+#include <google/protobuf/repeated_field.h>
+
+using namespace shogun;
+using namespace shogun::coreml::detail;
+namespace spec = CoreML::Specification;
+
+namespace
+{
+	typedef google::protobuf::RepeatedPtrField<spec::NeuralNetworkLayer>
+	    Layers;
+
+	/** append a fully connected layer
+	 *
+	 * @param weights weights of the outputs, one column per input
+	 */
+	void add_inner_product(
+	    Layers* layers, const std::string& input, const std::string& output,
+	    const SGVector<float64_t>& bias, const SGMatrix<float64_t>& weights)
+	{
+		auto layer = layers->Add();
+		layer->set_name(output);
+		layer->add_input(input);
+		layer->add_output(output);
+
+		// CoreML stores the weights row-major
+		auto inner_product = layer->mutable_innerproduct();
+		inner_product->set_inputchannels(weights.num_cols);
+		inner_product->set_outputchannels(weights.num_rows);
+		inner_product->set_hasbias(true);
+		for (auto o : range(weights.num_rows))
+		{
+			for (auto i : range(weights.num_cols))
+				inner_product->mutable_weights()->add_floatvalue(weights(o, i));
+		}
+		for (auto b : bias)
+			inner_product->mutable_bias()->add_floatvalue(b);
+	}
+
+	spec::NeuralNetworkLayer* add_layer(
+	    Layers* layers, const std::string& input, const std::string& output)
+	{
+		auto layer = layers->Add();
+		layer->set_name(output);
+		layer->add_input(input);
+		layer->add_output(output);
+		return layer;
+	}
+} // namespace
+
+Model coreml::detail::convert_neural_network(
+    const std::shared_ptr<NeuralNetwork>& network, int32_t num_features,
+    const std::string& input)
+{
+	const auto& layers = network->get_layers();
+	const auto parameters = network->get_layer_parameters();
+	require(
+	    layers.size() > 1 && parameters.size() == layers.size(),
+	    "{} is not initialized", network->get_name());
+
+	auto input_layer = std::dynamic_pointer_cast<NeuralInputLayer>(layers[0]);
+	require(
+	    input_layer && input_layer->get_start_index() == 0 &&
+	        input_layer->get_num_neurons() == network->get_num_inputs(),
+	    "{} has to start with one input layer of all features",
+	    network->get_name());
+
+	Model model;
+	add_array_input(
+	    model, input,
+	    input_dim(network->get_num_inputs(), num_features, network->get_name()));
+
+	const auto problem_type = network->get_machine_problem_type();
+	const int32_t num_outputs = network->get_num_outputs();
+	Layers* spec_layers;
+	std::string output;
+	switch (problem_type)
+	{
+	case PT_BINARY:
+	case PT_MULTICLASS:
+		spec_layers = model.mutable_neuralnetworkclassifier()->mutable_layers();
+		output = kClassProbability;
+		break;
+	case PT_REGRESSION:
+		spec_layers = model.mutable_neuralnetworkregressor()->mutable_layers();
+		output = kPrediction;
+		break;
+	default:
+		error(
+		    "{} of problem type {} can not be converted to CoreML",
+		    network->get_name(), static_cast<int32_t>(problem_type));
+	}
+
+	// the single output of binary networks is the probability of 1, it is
+	// extended to the probabilities of -1 and 1
+	const bool binary_probability =
+	    problem_type == PT_BINARY && num_outputs == 1;
+
+	std::string previous = input;
+	for (auto l : range<size_t>(1, layers.size()))
+	{
+		const auto& layer = layers[l];
+		const std::string name = layer->get_name();
+		const auto inputs = layer->get_input_indices();
+		require(
+		    inputs.vlen == 1 && inputs[0] == static_cast<int32_t>(l) - 1,
+		    "Only chains of layers can be converted to CoreML, layer {} is "
+		    "not connected to the previous layer only",
+		    l);
+
+		const bool last = l + 1 == layers.size() && !binary_probability;
+		const auto layer_output = last ? output : "layer" + std::to_string(l);
+		const bool activation = name != "NeuralLinearLayer";
+		require(
+		    !activation || name == "NeuralLogisticLayer" ||
+		        name == "NeuralRectifiedLinearLayer" ||
+		        name == "NeuralLeakyRectifiedLinearLayer" ||
+		        name == "NeuralSoftmaxLayer",
+		    "{} can not be converted to CoreML", name);
+
+		// the parameters are the biases followed by the weights with one
+		// column per input
+		const int32_t num_neurons = layer->get_num_neurons();
+		const int32_t num_inputs = layers[l - 1]->get_num_neurons();
+		const auto& params = parameters[l];
+		SGVector<float64_t> bias(params.vector, num_neurons, false);
+		SGMatrix<float64_t> weights(
+		    params.vector + num_neurons, num_neurons, num_inputs, false);
+		add_inner_product(
+		    spec_layers, previous,
+		    activation ? layer_output + "_linear" : layer_output, bias,
+		    weights);
+
+		if (name == "NeuralLogisticLayer")
+			add_layer(spec_layers, layer_output + "_linear", layer_output)
+			    ->mutable_activation()
+			    ->mutable_sigmoid();
+		else if (name == "NeuralRectifiedLinearLayer")
+			add_layer(spec_layers, layer_output + "_linear", layer_output)
+			    ->mutable_activation()
+			    ->mutable_relu();
+		else if (name == "NeuralLeakyRectifiedLinearLayer")
+			add_layer(spec_layers, layer_output + "_linear", layer_output)
+			    ->mutable_activation()
+			    ->mutable_leakyrelu()
+			    ->set_alpha(
+			        layer->as<NeuralLeakyRectifiedLinearLayer>()->get_alpha());
+		else if (name == "NeuralSoftmaxLayer")
+			add_layer(spec_layers, layer_output + "_linear", layer_output)
+			    ->mutable_softmax();
+
+		previous = layer_output;
+	}
+
+	if (problem_type == PT_REGRESSION)
+	{
+		add_array_output(model, kPrediction, num_outputs);
+		return model;
+	}
+
+	auto classifier = model.mutable_neuralnetworkclassifier();
+	if (binary_probability)
+	{
+		// [1-p, p]
+		add_inner_product(
+		    spec_layers, previous, output, SGVector<float64_t>{1, 0},
+		    SGMatrix<float64_t>(SGVector<float64_t>{-1, 1}, 2, 1));
+		set_labels(classifier->mutable_int64classlabels(), {-1, 1});
+	}
+	else if (problem_type == PT_BINARY)
+	{
+		// the first output is the score of 1
+		require(
+		    num_outputs == 2, "Binary {} has {} outputs", network->get_name(),
+		    num_outputs);
+		set_labels(classifier->mutable_int64classlabels(), {1, -1});
+	}
+	else
+	{
+		SGVector<int64_t> labels(num_outputs);
+		labels.range_fill();
+		set_labels(classifier->mutable_int64classlabels(), labels);
+	}
+	add_classifier_outputs(model, true);
+
+	return model;
+}
@@ -0,0 +1,149 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include "Converters.h"
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/normalizer/KernelNormalizer.h>
+#include <shogun/machine/KernelMachine.h>
+
+using namespace shogun;
+using namespace shogun::coreml::detail;
+namespace spec = CoreML::Specification;
+
+namespace
+{
+	void convert_kernel(
+	    const std::shared_ptr<Kernel>& kernel, spec::Kernel* spec_kernel)
+	{
+		auto normalizer = kernel->get_normalizer();
+		require(
+		    !normalizer ||
+		        std::string(normalizer->get_name()) ==
+		            "IdentityKernelNormalizer",
+		    "{} with {} can not be converted to CoreML", kernel->get_name(),
+		    normalizer ? normalizer->get_name() : "");
+
+		switch (kernel->get_kernel_type())
+		{
+		case K_LINEAR:
+			spec_kernel->mutable_linearkernel();
+			break;
+		case K_GAUSSIAN:
+			// exp(-gamma |x-y|^2)
+			spec_kernel->mutable_rbfkernel()->set_gamma(
+			    1.0 / kernel->as<GaussianKernel>()->get_width());
+			break;
+		case K_POLY:
+		{
+			// (gamma <x,y> + c)^degree
+			auto poly = spec_kernel->mutable_polykernel();
+			poly->set_degree(kernel->get<int32_t>("degree"));
+			poly->set_c(kernel->get<float64_t>("c"));
+			poly->set_gamma(kernel->get<float64_t>("gamma"));
+			break;
+		}
+		case K_SIGMOID:
+		{
+			// tanh(gamma <x,y> + c)
+			auto sigmoid = spec_kernel->mutable_sigmoidkernel();
+			sigmoid->set_gamma(kernel->get<float64_t>("gamma"));
+			sigmoid->set_c(kernel->get<float64_t>("coef0"));
+			break;
+		}
+		default:
+			error("{} can not be converted to CoreML", kernel->get_name());
+		}
+	}
+
+	void add_support_vector(
+	    spec::DenseSupportVectors* vectors,
+	    const std::shared_ptr<DenseFeatures<float64_t>>& features, int32_t idx)
+	{
+		auto vector = vectors->add_vectors();
+		for (auto x : features->get_feature_vector(idx))
+			vector->add_values(x);
+	}
+} // namespace
+
+Model coreml::detail::convert_kernel_machine(
+    const std::shared_ptr<KernelMachine>& machine, int32_t num_features,
+    const std::string& input)
+{
+	auto kernel = machine->get_kernel();
+	require(kernel, "{} has no kernel", machine->get_name());
+	require(
+	    kernel->get_lhs() &&
+	        kernel->get_lhs()->get_feature_class() == C_DENSE &&
+	        kernel->get_lhs()->get_feature_type() == F_DREAL,
+	    "{} can only be converted to CoreML with dense real features",
+	    machine->get_name());
+	auto features = kernel->get_lhs()->as<DenseFeatures<float64_t>>();
+
+	const auto svs = machine->get_support_vectors();
+	const auto alphas = machine->get_alphas();
+	require(svs.vlen > 0, "{} is not trained", machine->get_name());
+
+	Model model;
+	add_array_input(
+	    model, input,
+	    input_dim(features->get_num_features(), num_features, machine->get_name()));
+
+	// both compute sum_i coef_i k(x_i, x) - rho
+	switch (machine->get_machine_problem_type())
+	{
+	case PT_BINARY:
+	{
+		// the support vectors are grouped by class, the first class is
+		// predicted for positive outputs
+		auto svc = model.mutable_supportvectorclassifier();
+		convert_kernel(kernel, svc->mutable_kernel());
+		auto vectors = svc->mutable_densesupportvectors();
+		auto coefficients = svc->add_coefficients();
+		int32_t num_positive = 0;
+		for (auto positive : {true, false})
+		{
+			for (auto i : range(svs.vlen))
+			{
+				if ((alphas[i] >= 0) != positive)
+					continue;
+				add_support_vector(vectors, features, svs[i]);
+				coefficients->add_alpha(alphas[i]);
+				num_positive += positive;
+			}
+		}
+		svc->add_numberofsupportvectorsperclass(num_positive);
+		svc->add_numberofsupportvectorsperclass(svs.vlen - num_positive);
+		svc->add_rho(-machine->get_bias());
+		set_labels(svc->mutable_int64classlabels(), SGVector<int64_t>{1, -1});
+		add_classifier_outputs(model, false);
+		break;
+	}
+	case PT_REGRESSION:
+	{
+		auto svr = model.mutable_supportvectorregressor();
+		convert_kernel(kernel, svr->mutable_kernel());
+		auto vectors = svr->mutable_densesupportvectors();
+		auto coefficients = svr->mutable_coefficients();
+		for (auto i : range(svs.vlen))
+		{
+			add_support_vector(vectors, features, svs[i]);
+			coefficients->add_alpha(alphas[i]);
+		}
+		svr->set_rho(-machine->get_bias());
+		add_regressor_output(model);
+		break;
+	}
+	default:
+		error(
+		    "{} of problem type {} can not be converted to CoreML",
+		    machine->get_name(),
+		    static_cast<int32_t>(machine->get_machine_problem_type()));
+	}
+
+	return model;
+}
@@ -0,0 +1,349 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include "ShogunCoreML.h"
+#include "Converters.h"
+
+#include <shogun/machine/KernelMachine.h>
+#include <shogun/machine/LinearMachine.h>
+#include <shogun/machine/Pipeline.h>
+#include <shogun/machine/RandomForest.h>
+#include <shogun/multiclass/tree/CARTree.h>
+#include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/transformer/Transformer.h>
+
+#include <fstream>
+#include <vector>
+
+using namespace shogun;
+using namespace shogun::coreml::detail;
+namespace spec = CoreML::Specification;
+
+int32_t coreml::detail::input_dim(
+    int32_t model_dim, int32_t num_features, const char* name)
+{
+	if (num_features < 0)
+	{
+		require(
+		    model_dim > 0,
+		    "Number of features of {} is unknown, pass num_features", name);
+		return model_dim;
+	}
+
+	require(
+	    model_dim < 0 || model_dim == num_features,
+	    "{} expects {} features but {} were requested", name, model_dim,
+	    num_features);
+	return num_features;
+}
+
+void coreml::detail::add_array_input(
+    Model& model, const std::string& name, int32_t dim)
+{
+	auto input = model.mutable_description()->add_input();
+	input->set_name(name);
+	auto array = input->mutable_type()->mutable_multiarraytype();
+	array->add_shape(dim);
+	array->set_datatype(spec::ArrayFeatureType::DOUBLE);
+}
+
+void coreml::detail::add_array_output(
+    Model& model, const std::string& name, int32_t dim)
+{
+	auto output = model.mutable_description()->add_output();
+	output->set_name(name);
+	auto array = output->mutable_type()->mutable_multiarraytype();
+	array->add_shape(dim);
+	array->set_datatype(spec::ArrayFeatureType::DOUBLE);
+}
+
+void coreml::detail::add_classifier_outputs(Model& model, bool probabilities)
+{
+	auto description = model.mutable_description();
+	auto label = description->add_output();
+	label->set_name(kClassLabel);
+	label->mutable_type()->mutable_int64type();
+	description->set_predictedfeaturename(kClassLabel);
+
+	if (probabilities)
+	{
+		auto probability = description->add_output();
+		probability->set_name(kClassProbability);
+		probability->mutable_type()
+		    ->mutable_dictionarytype()
+		    ->mutable_int64keytype();
+		description->set_predictedprobabilitiesname(kClassProbability);
+	}
+}
+
+void coreml::detail::add_regressor_output(Model& model)
+{
+	auto prediction = model.mutable_description()->add_output();
+	prediction->set_name(kPrediction);
+	prediction->mutable_type()->mutable_doubletype();
+}
+
+const spec::Int64Vector& coreml::detail::class_labels(const Model& model)
+{
+	switch (model.Type_case())
+	{
+	case Model::kGlmClassifier:
+		return model.glmclassifier().int64classlabels();
+	case Model::kSupportVectorClassifier:
+		return model.supportvectorclassifier().int64classlabels();
+	case Model::kTreeEnsembleClassifier:
+		return model.treeensembleclassifier().int64classlabels();
+	case Model::kNeuralNetworkClassifier:
+		return model.neuralnetworkclassifier().int64classlabels();
+	case Model::kPipelineClassifier:
+		return model.pipelineclassifier().int64classlabels();
+	default:
+		error(
+		    "Model of type {} is not a classifier",
+		    static_cast<int32_t>(model.Type_case()));
+	}
+
+	return spec::Int64Vector::default_instance();
+}
+
+void coreml::detail::set_labels(
+    spec::Int64Vector* vector, const SGVector<int64_t>& labels)
+{
+	for (auto label : labels)
+		vector->add_vector(label);
+}
+
+namespace
+{
+	/** preprocessing stage of a pipeline, the dimensions are -1 while
+	 * they are unknown */
+	struct Stage
+	{
+		Model model;
+		int32_t in_dim;
+		int32_t out_dim;
+	};
+
+	Stage scaler(
+	    const SGVector<float64_t>& shift, const SGVector<float64_t>& scale)
+	{
+		Stage stage{Model(), shift.vlen, shift.vlen};
+		auto scaler = stage.model.mutable_scaler();
+		for (auto i : range(shift.vlen))
+		{
+			scaler->add_shiftvalue(shift[i]);
+			scaler->add_scalevalue(scale[i]);
+		}
+		return stage;
+	}
+
+	/** append the stages of a transformer
+	 *
+	 * @param dim dimension of the input, -1 if unknown, updated to the
+	 * dimension of the output
+	 */
+	void convert_transformer(
+	    const std::shared_ptr<Transformer>& transformer, int32_t& dim,
+	    std::vector<Stage>& stages)
+	{
+		const std::string name = transformer->get_name();
+		if (name == "PruneVarSubMean")
+		{
+			auto idx = transformer->get<SGVector<int32_t>>("idx_vec");
+			auto mean = transformer->get<SGVector<float64_t>>("mean_vec");
+			auto stddev = transformer->get<SGVector<float64_t>>("std_vec");
+			require(mean.vlen > 0, "{} is not fitted", name);
+
+			// the features with small variance are removed
+			bool pruned = dim != idx.vlen;
+			for (auto i : range(idx.vlen))
+				pruned |= idx[i] != i;
+			if (pruned)
+			{
+				require(
+				    dim > 0, "Number of features of {} is unknown, pass "
+				             "num_features",
+				    name);
+				Stage stage{Model(), dim, idx.vlen};
+				auto extractor = stage.model.mutable_arrayfeatureextractor();
+				for (auto i : idx)
+				{
+					require(
+					    i < dim, "{} uses feature {} of {} features", name, i,
+					    dim);
+					extractor->add_extractindex(i);
+				}
+				stages.push_back(std::move(stage));
+			}
+
+			SGVector<float64_t> shift(mean.vlen);
+			SGVector<float64_t> scale(mean.vlen);
+			const bool divide = transformer->get<bool>("divide_by_std");
+			for (auto i : range(mean.vlen))
+			{
+				shift[i] = -mean[i];
+				scale[i] = divide ? 1.0 / stddev[i] : 1.0;
+			}
+			stages.push_back(scaler(shift, scale));
+			dim = mean.vlen;
+		}
+		else if (name == "RescaleFeatures")
+		{
+			auto min = transformer->get<SGVector<float64_t>>("min");
+			// the range is stored as its reciprocal
+			auto scale = transformer->get<SGVector<float64_t>>("range");
+			require(min.vlen > 0, "{} is not fitted", name);
+			dim = coreml::detail::input_dim(min.vlen, dim, name.c_str());
+
+			SGVector<float64_t> shift(min.vlen);
+			for (auto i : range(min.vlen))
+				shift[i] = -min[i];
+			stages.push_back(scaler(shift, scale));
+		}
+		else if (name == "NormOne")
+		{
+			Stage stage{Model(), dim, dim};
+			stage.model.mutable_normalizer()->set_normtype(spec::Normalizer::L2);
+			stages.push_back(std::move(stage));
+		}
+		else
+			error("Transformer {} can not be converted to CoreML", name);
+	}
+
+	Model convert_machine(
+	    const std::shared_ptr<Machine>& machine, int32_t num_features,
+	    const std::string& input);
+
+	Model convert_pipeline(
+	    const std::shared_ptr<Pipeline>& pipeline, int32_t num_features,
+	    const std::string& input)
+	{
+		std::vector<Stage> stages;
+		int32_t dim = num_features;
+		for (const auto& transformer : pipeline->get_transformers())
+			convert_transformer(transformer, dim, stages);
+
+		const auto machine_input =
+		    stages.empty() ? input : "stage" + std::to_string(stages.size() - 1);
+		auto machine_model =
+		    convert_machine(pipeline->get_machine(), dim, machine_input);
+		if (stages.empty())
+			return machine_model;
+
+		// dimensions that are left unknown are the ones of the machine
+		dim = machine_model.description()
+		          .input(0)
+		          .type()
+		          .multiarraytype()
+		          .shape(0);
+		for (auto it = stages.rbegin(); it != stages.rend(); ++it)
+		{
+			if (it->out_dim < 0)
+				it->out_dim = dim;
+			require(
+			    it->out_dim == dim,
+			    "Pipeline stage has {} outputs but the next stage {} inputs",
+			    it->out_dim, dim);
+			if (it->in_dim < 0)
+				it->in_dim = it->out_dim;
+			dim = it->in_dim;
+		}
+
+		Model model;
+		spec::Pipeline* models;
+		if (machine_model.description().predictedfeaturename().empty())
+			models = model.mutable_pipelineregressor()->mutable_pipeline();
+		else
+		{
+			auto classifier = model.mutable_pipelineclassifier();
+			*classifier->mutable_int64classlabels() =
+			    class_labels(machine_model);
+			models = classifier->mutable_pipeline();
+		}
+
+		for (auto i : range(stages.size()))
+		{
+			auto& stage = stages[i];
+			const auto stage_input =
+			    i == 0 ? input : "stage" + std::to_string(i - 1);
+			add_array_input(stage.model, stage_input, stage.in_dim);
+			add_array_output(
+			    stage.model, "stage" + std::to_string(i), stage.out_dim);
+			stage.model.set_specificationversion(1);
+			*models->add_models() = std::move(stage.model);
+		}
+
+		auto description = model.mutable_description();
+		*description->add_input() = models->models(0).description().input(0);
+		*description->mutable_output() = machine_model.description().output();
+		description->set_predictedfeaturename(
+		    machine_model.description().predictedfeaturename());
+		description->set_predictedprobabilitiesname(
+		    machine_model.description().predictedprobabilitiesname());
+		*models->add_models() = std::move(machine_model);
+
+		return model;
+	}
+
+	Model convert_machine(
+	    const std::shared_ptr<Machine>& machine, int32_t num_features,
+	    const std::string& input)
+	{
+		require(machine, "No machine provided");
+
+		Model model;
+		if (auto pipeline = std::dynamic_pointer_cast<Pipeline>(machine))
+			model = convert_pipeline(pipeline, num_features, input);
+		else if (
+		    auto network = std::dynamic_pointer_cast<NeuralNetwork>(machine))
+			model = convert_neural_network(network, num_features, input);
+		else if (
+		    auto forest = std::dynamic_pointer_cast<RandomForest>(machine))
+			model = convert_random_forest(forest, num_features, input);
+		else if (auto tree = std::dynamic_pointer_cast<CARTree>(machine))
+			model = convert_cart_tree(tree, num_features, input);
+		else if (
+		    auto kernel_machine =
+		        std::dynamic_pointer_cast<KernelMachine>(machine))
+			model = convert_kernel_machine(kernel_machine, num_features, input);
+		else if (
+		    auto linear_machine =
+		        std::dynamic_pointer_cast<LinearMachine>(machine))
+			model = convert_linear_machine(linear_machine, num_features, input);
+		else
+			error("{} can not be converted to CoreML", machine->get_name());
+
+		model.set_specificationversion(1);
+		return model;
+	}
+} // namespace
+
+std::shared_ptr<Model> coreml::convert(
+    const std::shared_ptr<Machine>& machine, int32_t num_features)
+{
+	auto model = std::make_shared<Model>(
+	    convert_machine(machine, num_features, kInput));
+	model->mutable_description()->mutable_metadata()->set_shortdescription(
+	    machine->get_name());
+	return model;
+}
+
+void coreml::save(
+    const std::shared_ptr<Machine>& machine, const std::string& filename,
+    int32_t num_features)
+{
+	auto model = convert(machine, num_features);
+
+	std::string bytes;
+	require(
+	    model->SerializeToString(&bytes), "Could not serialize {}",
+	    machine->get_name());
+
+	std::ofstream file(filename, std::ios::binary);
+	require(file.good(), "Could not open {} for writing", filename);
+	file.write(bytes.data(), bytes.size());
+	require(file.good(), "Could not write {}", filename);
+}
@@ -0,0 +1,73 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _SHOGUN_COREML_H__
+#define _SHOGUN_COREML_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/machine/Machine.h>
+
+#include <Model.pb.h>
+
+#include <memory>
+#include <string>
+
+namespace shogun
+{
+	/** @brief Export of trained machines to CoreML models, so that they can
+	 * be served by the CoreML runtime while training stays in shogun.
+	 *
+	 * The models take one multi-array of doubles named "input", with the
+	 * features of one vector. Classifiers predict the int64 "classLabel"
+	 * and, where the machine has scores, the "classProbability" of every
+	 * class; regressors predict the double "prediction".
+	 *
+	 * Supported machines are
+	 * - LinearMachine, binary as GLMClassifier with labels -1 and 1 and the
+	 *   logistic of the output as probability of 1, regression as
+	 *   GLMRegressor
+	 * - KernelMachine with a linear, Gaussian, polynomial or sigmoid kernel
+	 *   on dense real features and without kernel normalization, binary as
+	 *   SupportVectorClassifier, regression as SupportVectorRegressor
+	 * - CARTree and RandomForest with continuous features, multiclass with
+	 *   labels 0..C-1 and the fraction of votes as probabilities (majority
+	 *   vote), regression as the mean of the trees
+	 * - NeuralNetwork made of a chain of linear, logistic, (leaky) rectified
+	 *   linear and softmax layers
+	 * - Pipeline of PruneVarSubMean, RescaleFeatures and NormOne followed by
+	 *   one of the machines above
+	 *
+	 * Other machines or settings raise ShogunException.
+	 */
+	namespace coreml
+	{
+		/** convert a trained machine
+		 *
+		 * @param machine trained machine
+		 * @param num_features dimension of the input vectors, required when
+		 * the machine does not determine it, e.g. when a pipeline starts
+		 * with PruneVarSubMean
+		 * @return CoreML model of the machine
+		 */
+		std::shared_ptr<CoreML::Specification::Model> convert(
+		    const std::shared_ptr<Machine>& machine,
+		    int32_t num_features = -1);
+
+		/** convert a trained machine and write the model to an .mlmodel
+		 * file
+		 *
+		 * @param machine trained machine
+		 * @param filename name of the file
+		 * @param num_features dimension of the input vectors, see convert()
+		 */
+		void save(
+		    const std::shared_ptr<Machine>& machine,
+		    const std::string& filename, int32_t num_features = -1);
+	} // namespace coreml
+} // namespace shogun
+
+#endif /* _SHOGUN_COREML_H__ */
@@ -0,0 +1,182 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include "Converters.h"
+
+#include <shogun/ensemble/CombinationRule.h>
+#include <shogun/machine/RandomForest.h>
+#include <shogun/multiclass/tree/CARTree.h>
+
+#include <vector>
+
+using namespace shogun;
+using namespace shogun::coreml::detail;
+namespace spec = CoreML::Specification;
+
+namespace
+{
+	typedef BinaryTreeMachineNode<CARTreeNodeData> bnode_t;
+	typedef spec::TreeEnsembleParameters::TreeNode TreeNode;
+
+	/** trees of an ensemble, the output is the weighted sum of the trees
+	 * or of the votes for the labels of the trees */
+	struct Ensemble
+	{
+		std::vector<std::shared_ptr<CARTree>> trees;
+		float64_t weight;
+	};
+
+	/** append the nodes of a subtree in pre-order
+	 *
+	 * @param next_id id of the next node, incremented for every node
+	 * @param num_classes updated to cover the labels of the leaves
+	 * @return id of the node
+	 */
+	uint64_t add_nodes(
+	    spec::TreeEnsembleParameters* params, uint64_t tree_id,
+	    const std::shared_ptr<bnode_t>& node, const SGVector<bool>& nominal,
+	    bool classification, float64_t weight, uint64_t& next_id,
+	    int64_t& num_classes)
+	{
+		const uint64_t id = next_id++;
+		auto spec_node = params->add_nodes();
+		spec_node->set_treeid(tree_id);
+		spec_node->set_nodeid(id);
+		spec_node->set_relativehitrate(node->data.total_weight);
+
+		if (node->data.num_leaves == 1)
+		{
+			spec_node->set_nodebehavior(TreeNode::LeafNode);
+			auto info = spec_node->add_evaluationinfo();
+			if (classification)
+			{
+				const auto label = static_cast<int64_t>(node->data.node_label);
+				info->set_evaluationindex(label);
+				info->set_evaluationvalue(weight);
+				num_classes = std::max(num_classes, label + 1);
+			}
+			else
+			{
+				info->set_evaluationindex(0);
+				info->set_evaluationvalue(weight * node->data.node_label);
+			}
+			return id;
+		}
+
+		const auto attribute = node->data.attribute_id;
+		require(
+		    !nominal[attribute],
+		    "Trees with nominal features can not be converted to CoreML");
+
+		// vectors with attribute values up to the threshold go left
+		auto left = node->left();
+		spec_node->set_nodebehavior(TreeNode::BranchOnValueLessThanEqual);
+		spec_node->set_branchfeatureindex(attribute);
+		spec_node->set_branchfeaturevalue(left->data.transit_into_values[0]);
+		spec_node->set_truechildnodeid(add_nodes(
+		    params, tree_id, left, nominal, classification, weight, next_id,
+		    num_classes));
+		spec_node->set_falsechildnodeid(add_nodes(
+		    params, tree_id, node->right(), nominal, classification, weight,
+		    next_id, num_classes));
+		return id;
+	}
+
+	Model convert_ensemble(
+	    const Ensemble& ensemble, EProblemType problem_type,
+	    int32_t num_features, const std::string& input)
+	{
+		require(!ensemble.trees.empty(), "No trees to convert");
+
+		const bool classification = problem_type == PT_MULTICLASS;
+		require(
+		    classification || problem_type == PT_REGRESSION,
+		    "Trees of problem type {} can not be converted to CoreML",
+		    static_cast<int32_t>(problem_type));
+
+		Model model;
+		spec::TreeEnsembleParameters* params = classification
+		    ? model.mutable_treeensembleclassifier()->mutable_treeensemble()
+		    : model.mutable_treeensembleregressor()->mutable_treeensemble();
+
+		int32_t dim = -1;
+		int64_t num_classes = 0;
+		for (auto i : range(ensemble.trees.size()))
+		{
+			const auto& tree = ensemble.trees[i];
+			require(tree->get_root(), "{} is not trained", tree->get_name());
+			const auto nominal = tree->get_feature_types();
+			require(
+			    dim < 0 || dim == nominal.vlen,
+			    "Trees are trained on {} and {} features", dim, nominal.vlen);
+			dim = nominal.vlen;
+
+			uint64_t next_id = 0;
+			add_nodes(
+			    params, i, tree->get_root()->as<bnode_t>(), nominal,
+			    classification, ensemble.weight, next_id, num_classes);
+		}
+		add_array_input(model, input, input_dim(dim, num_features, "Tree"));
+
+		if (classification)
+		{
+			// the class with the largest sum of votes is predicted
+			auto classifier = model.mutable_treeensembleclassifier();
+			classifier->set_postevaluationtransform(spec::NoTransform);
+			SGVector<int64_t> labels(num_classes);
+			labels.range_fill();
+			set_labels(classifier->mutable_int64classlabels(), labels);
+			params->set_numpredictiondimensions(num_classes);
+			for (auto c = 0; c < num_classes; c++)
+				params->add_basepredictionvalue(0);
+			add_classifier_outputs(model, true);
+		}
+		else
+		{
+			model.mutable_treeensembleregressor()->set_postevaluationtransform(
+			    spec::NoTransform);
+			params->set_numpredictiondimensions(1);
+			params->add_basepredictionvalue(0);
+			add_regressor_output(model);
+		}
+
+		return model;
+	}
+} // namespace
+
+Model coreml::detail::convert_cart_tree(
+    const std::shared_ptr<CARTree>& tree, int32_t num_features,
+    const std::string& input)
+{
+	return convert_ensemble(
+	    {{tree}, 1.0}, tree->get_machine_problem_type(), num_features, input);
+}
+
+Model coreml::detail::convert_random_forest(
+    const std::shared_ptr<RandomForest>& forest, int32_t num_features,
+    const std::string& input)
+{
+	auto bags = forest->get<std::vector<std::shared_ptr<Machine>>>("bags");
+	require(!bags.empty(), "{} is not trained", forest->get_name());
+
+	Ensemble ensemble{{}, 1.0 / bags.size()};
+	for (const auto& bag : bags)
+		ensemble.trees.push_back(bag->as<CARTree>());
+
+	// majority vote picks the label with the most votes, the mean rule
+	// averages the trees
+	auto rule = forest->get_combination_rule();
+	require(rule, "{} has no combination rule", forest->get_name());
+	const std::string rule_name = rule->get_name();
+	const auto problem_type = forest->get_machine_problem_type();
+	require(
+	    (problem_type == PT_MULTICLASS && rule_name == "MajorityVote") ||
+	        (problem_type == PT_REGRESSION && rule_name == "MeanRule"),
+	    "{} with {} can not be converted to CoreML", forest->get_name(),
+	    rule_name);
+
+	return convert_ensemble(ensemble, problem_type, num_features, input);
+}
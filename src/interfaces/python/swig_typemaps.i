@@ -15,6 +15,8 @@
 #include <shogun/lib/DataType.h>
 #include <shogun/lib/memory.h>
 
+#include <functional>
+
 #undef _POSIX_C_SOURCE
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 extern "C" {
@@ -165,9 +167,79 @@ static int is_pysparse_matrix(PyObject* obj, int typecode)
          ) ? 1 : 0;
 }
 
+/* Whether the memory of a NumPy array can be used in place: of the
+ * requested type, aligned, writeable, in native byte order and contiguous in
+ * column-major order (which 1d arrays with unit stride always are). Other
+ * arrays, e.g. C-ordered matrices or slices with steps, are copied.
+ */
+static bool can_borrow(PyObject* obj, int dims, int typecode, size_t itemsize)
+{
+    if (!::is_array(obj) || array_dimensions(obj)!=dims ||
+        !PyArray_EquivTypenums(array_type(obj), typecode))
+        return false;
+
+    PyArrayObject* array=(PyArrayObject*) obj;
+    return PyArray_ISFARRAY(array) && PyArray_ISNOTSWAPPED(array) &&
+        size_t(PyArray_ITEMSIZE(array))==itemsize;
+}
+
+/* Holds a reference to a NumPy array whose memory a SGVector or SGMatrix
+ * borrows, which is dropped when the last SGReferencedData goes away. That
+ * can happen on any thread, hence the GIL is acquired.
+ */
+static std::function<void()> numpy_owner(PyArrayObject* array)
+{
+    Py_INCREF(array);
+    return [array]() {
+        if (!Py_IsInitialized())
+            return;
+
+        PyGILState_STATE state=PyGILState_Ensure();
+        Py_DECREF(array);
+        PyGILState_Release(state);
+    };
+}
+
+/* Base object of NumPy arrays that view the memory of a SGVector or
+ * SGMatrix, it holds a reference to the data.
+ */
+template <class container>
+static void release_container_capsule(PyObject* capsule)
+{
+    delete (container*) PyCapsule_GetPointer(capsule, NULL);
+}
+
+template <class container>
+static PyObject* numpy_view(
+    const container& data, void* memory, int nd, npy_intp* dims, PyArray_Descr* descr)
+{
+    PyObject* obj = PyArray_NewFromDescr(&PyArray_Type,
+        descr, nd, dims, NULL, memory, NPY_ARRAY_FARRAY | NPY_ARRAY_WRITEABLE, NULL);
+    if (!obj)
+        return NULL;
+
+    PyObject* capsule=PyCapsule_New(
+        new container(data), NULL, release_container_capsule<container>);
+    // PyArray_SetBaseObject steals the reference, also on failure
+    if (!capsule || PyArray_SetBaseObject((PyArrayObject*) obj, capsule)<0)
+    {
+        Py_DECREF(obj);
+        return NULL;
+    }
+    return obj;
+}
+
 template <class type>
 static bool vector_from_numpy(SGVector<type>& sg_vec, PyObject* obj, int typecode)
 {
+    if (can_borrow(obj, 1, typecode, sizeof(type)))
+    {
+        PyArrayObject* array=(PyArrayObject*) obj;
+        sg_vec=shogun::SGVector<type>((type*) PyArray_DATA(array),
+            PyArray_DIM(array,0), numpy_owner(array));
+        return true;
+    }
+
     int is_new_object;
     PyArrayObject* array = make_contiguous(obj, &is_new_object, 1,typecode, true);
     if (!array)
@@ -189,6 +261,13 @@ static bool vector_to_numpy(PyObject* &obj, SGVector<type> sg_vec, int typecode)
     npy_intp dims= (npy_intp) sg_vec.vlen;
     PyArray_Descr* descr=PyArray_DescrFromType(typecode);
 
+    // reference counted vectors are viewed, the array keeps them alive
+    if (descr && sg_vec.vector && !sg_vec.on_gpu() && sg_vec.ref_count()>0)
+    {
+        obj=numpy_view(sg_vec, sg_vec.vector, 1, &dims, descr);
+        return obj!=NULL;
+    }
+
     if (descr)
     {
         void* copy=get_copy(sg_vec.vector, sizeof(type)*size_t(sg_vec.vlen));
@@ -209,6 +288,14 @@ static bool matrix_from_numpy(SGMatrix<type>& sg_matrix, PyObject* obj, int type
         return false;
     }
 
+    if (can_borrow(obj, 2, typecode, sizeof(type)))
+    {
+        PyArrayObject* array=(PyArrayObject*) obj;
+        sg_matrix = shogun::SGMatrix<type>((type*) PyArray_DATA(array),
+                PyArray_DIM(array,0), PyArray_DIM(array,1), numpy_owner(array));
+        return true;
+    }
+
     int is_new_object;
     PyArrayObject* array = make_contiguous(obj, &is_new_object, 2,typecode, true);
     if (!array)
@@ -229,6 +316,13 @@ static bool matrix_to_numpy(PyObject* &obj, SGMatrix<type> sg_matrix, int typeco
     npy_intp dims[2]= {(npy_intp) sg_matrix.num_rows, (npy_intp) sg_matrix.num_cols };
     PyArray_Descr* descr=PyArray_DescrFromType(typecode);
 
+    // reference counted matrices are viewed, the array keeps them alive
+    if (descr && sg_matrix.matrix && !sg_matrix.on_gpu() && sg_matrix.ref_count()>0)
+    {
+        obj=numpy_view(sg_matrix, sg_matrix.matrix, 2, dims, descr);
+        return obj!=NULL;
+    }
+
     if (descr)
     {
         void* copy=get_copy(sg_matrix.matrix, sizeof(type)*size_t(sg_matrix.num_rows)*size_t(sg_matrix.num_cols));
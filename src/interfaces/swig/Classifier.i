@@ -22,6 +22,7 @@
 
 /* Remove C Prefix */
 %shared_ptr(shogun::Machine)
+%shared_ptr(shogun::AsyncTraining)
 %shared_ptr(shogun::KernelMachine)
 %shared_ptr(shogun::LinearMachine)
 %shared_ptr(shogun::SVM)
@@ -30,8 +31,22 @@
 
 /* Include Class Headers to make them visible from within the target language */
 %include <shogun/machine/Machine.h>
+%include <shogun/machine/AsyncTraining.h>
 %include <shogun/machine/KernelMachine.h>
 %include <shogun/machine/LinearMachine.h>
 %include <shogun/classifier/svm/SVM.h>
 %include <shogun/machine/DirectorLinearMachine.h>
 %include <shogun/machine/DirectorKernelMachine.h>
+
+#ifdef SWIGPYTHON
+%pythoncode %{
+def _async_training_to_asyncio(self, loop=None):
+    """Returns an asyncio future of the result of get(), which waits
+    without the GIL in the executor of the event loop."""
+    import asyncio
+    if loop is None:
+        loop = asyncio.get_event_loop()
+    return loop.run_in_executor(None, self.get)
+_swig_monkey_patch(AsyncTraining, "to_asyncio", _async_training_to_asyncio)
+%}
+#endif
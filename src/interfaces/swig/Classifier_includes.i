@@ -1,6 +1,7 @@
 
 %{
  #include <shogun/machine/Machine.h>
+ #include <shogun/machine/AsyncTraining.h>
  #include <shogun/machine/KernelMachine.h>
  #include <shogun/machine/LinearMachine.h>
  #include <shogun/classifier/svm/SVM.h>
@@ -171,6 +171,7 @@ namespace shogun
 
 %shared_ptr(shogun::EigenSolver)
 %shared_ptr(shogun::LanczosEigenSolver)
+%shared_ptr(shogun::LOBPCGEigenSolver)
 
 %shared_ptr(shogun::LogDetEstimator)
 
@@ -208,5 +209,7 @@ RANDOM_INTERFACE(TraceSampler)
 
 %include <shogun/mathematics/linalg/eigsolver/EigenSolver.h>
 %include <shogun/mathematics/linalg/eigsolver/LanczosEigenSolver.h>
+RANDOM_INTERFACE(EigenSolver)
+%include <shogun/mathematics/linalg/eigsolver/LOBPCGEigenSolver.h>
 
 %include <shogun/mathematics/linalg/ratapprox/logdet/LogDetEstimator.h>
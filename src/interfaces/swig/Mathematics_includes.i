@@ -31,6 +31,7 @@
 
 #include <shogun/mathematics/linalg/eigsolver/EigenSolver.h>
 #include <shogun/mathematics/linalg/eigsolver/LanczosEigenSolver.h>
+#include <shogun/mathematics/linalg/eigsolver/LOBPCGEigenSolver.h>
 
 #include <shogun/mathematics/linalg/ratapprox/logdet/LogDetEstimator.h>
 %}
@@ -0,0 +1,145 @@
+#ifndef _HASH_PARAMETER_H
+#define _HASH_PARAMETER_H
+
+#include <shogun/base/SGObject.h>
+#include <vector>
+
+namespace shogun
+{
+    namespace detail
+    {
+        /** Parameters in registration order, like VectorParameter, with a
+         * flat open addressing table from the tag hashes to their
+         * positions, so that a lookup is a few probes instead of a scan
+         * over all parameters.
+         */
+        struct HashParameter
+        {
+            using ParametersContainer = std::vector<std::pair<BaseTag, AnyParameter>>;
+
+            void create(BaseTag&& tag, AnyParameter&& parameter)
+            {
+                auto [has_tag, tag_it] = has(tag);
+                if (has_tag)
+                {
+                    error("Can not register {} twice", tag.name());
+                }
+                map.emplace_back(std::move(tag), std::move(parameter));
+
+                // keep the table at most half full
+                if (2 * map.size() > slots.size())
+                    rehash(std::max<size_t>(16, 2 * slots.size()));
+                else
+                    insert(map.size() - 1);
+            }
+
+            void update(const BaseTag& tag, const Any& value)
+            {
+                auto [has_tag, tag_it] = has(tag);
+                if (!has_tag)
+                {
+                    error(
+                        "Can not update unregistered parameter {}",
+                        tag.name().c_str());
+                }
+                tag_it->second.set_value(value);
+            }
+
+            auto find(const BaseTag& tag)
+            {
+                const auto pos = position(tag);
+                return pos < 0 ? map.end() : map.begin() + pos;
+            }
+
+            auto find(const BaseTag& tag) const
+            {
+                const auto pos = position(tag);
+                return pos < 0 ? map.cend() : map.cbegin() + pos;
+            }
+
+            AnyParameter& at(const BaseTag& tag)
+            {
+                return find(tag)->second;
+            }
+
+            const AnyParameter& at(const BaseTag& tag) const
+            {
+                return find(tag)->second;
+            }
+
+            AnyParameter get(const BaseTag& tag) const
+            {
+                auto [has_tag, tag_it] = has(tag);
+                if(!has_tag)
+                    return AnyParameter();
+                return tag_it->second;
+            }
+
+            std::tuple<bool, ParametersContainer::iterator> has(const BaseTag& tag)
+            {
+                auto it = find(tag);
+                return std::make_tuple(it != map.end(), it);
+            }
+
+            std::tuple<bool, ParametersContainer::const_iterator> has(const BaseTag& tag) const
+            {
+                auto it = find(tag);
+                return std::make_tuple(it != map.cend(), it);
+            }
+
+            ParametersContainer filter(ParameterProperties pprop) const
+            {
+                ParametersContainer result;
+                std::copy_if(
+                    map.cbegin(), map.cend(), std::back_inserter(result),
+                    [&pprop](const auto& each) {
+                        auto p = each.second.get_properties();
+                        // if the filter mask is ALL, also include parameters with no set properties (NONE)
+                        return p.has_property(pprop) ||
+                                    (pprop==ParameterProperties::ALL &&
+                                    p.compare_mask(ParameterProperties::NONE));
+                    });
+                return result;
+            }
+
+            ParametersContainer map;
+
+            /** positions in map, -1 for empty slots, the size is a power
+             * of two */
+            std::vector<int32_t> slots;
+
+        private:
+            int64_t position(const BaseTag& tag) const
+            {
+                if (slots.empty())
+                    return -1;
+
+                const size_t mask = slots.size() - 1;
+                for (size_t s = tag.hash() & mask;; s = (s + 1) & mask)
+                {
+                    const auto pos = slots[s];
+                    if (pos < 0 || map[pos].first == tag)
+                        return pos;
+                }
+            }
+
+            void insert(int32_t pos)
+            {
+                const size_t mask = slots.size() - 1;
+                size_t s = map[pos].first.hash() & mask;
+                while (slots[s] >= 0)
+                    s = (s + 1) & mask;
+                slots[s] = pos;
+            }
+
+            void rehash(size_t size)
+            {
+                slots.assign(size, -1);
+                for (size_t pos = 0; pos < map.size(); pos++)
+                    insert(pos);
+            }
+        };
+    } // namespace detail
+} // namespace detail
+
+#endif /* _HASH_PARAMETER_H */
@@ -6,10 +6,12 @@
  */
 
 #include <shogun/base/Parallel.h>
+#include <shogun/io/SGIO.h>
 #include <shogun/lib/RefCount.h>
 #include <shogun/lib/config.h>
 #include <shogun/lib/memory.h>
 
+#include <algorithm>
 #include <thread>
 
 #if defined(LINUX)
@@ -28,18 +30,22 @@ using namespace shogun;
 Parallel::Parallel()
 {
 	num_threads=get_num_cpus();
+	max_nesting_level=2;
 #ifdef HAVE_OPENMP
 	omp_set_dynamic(0);
 	omp_set_num_threads(num_threads);
+	omp_set_max_active_levels(max_nesting_level);
 #endif
 }
 
 Parallel::Parallel(const Parallel& orig)
 {
-	num_threads=orig.get_num_threads();
+	num_threads=orig.num_threads;
+	max_nesting_level=orig.max_nesting_level;
 #ifdef HAVE_OPENMP
 	omp_set_dynamic(0);
 	omp_set_num_threads(num_threads);
+	omp_set_max_active_levels(max_nesting_level);
 #endif
 }
 
@@ -85,6 +91,47 @@ void Parallel::set_num_threads(int32_t n)
 }
 
 int32_t Parallel::get_num_threads() const
+{
+#ifdef HAVE_OPENMP
+	const int32_t level=omp_get_active_level();
+	if (level==0)
+		return num_threads;
+	// regions nested deeper than allowed would run serially anyway
+	if (level>=max_nesting_level)
+		return 1;
+
+	int32_t num_sharing=1;
+	for (int32_t l=1; l<=level; l++)
+		num_sharing*=omp_get_team_size(l);
+	return std::max(1, num_threads/num_sharing);
+#else
+	return num_threads;
+#endif
+}
+
+int32_t Parallel::get_max_num_threads() const
 {
 	return num_threads;
 }
+
+void Parallel::limit_nested_threads() const
+{
+#ifdef HAVE_OPENMP
+	if (omp_get_active_level()>0)
+		omp_set_num_threads(get_num_threads());
+#endif
+}
+
+int32_t Parallel::get_max_nesting_level() const
+{
+	return max_nesting_level;
+}
+
+void Parallel::set_max_nesting_level(int32_t levels)
+{
+	require(levels>0, "Maximum nesting level ({}) must be positive", levels);
+	max_nesting_level=levels;
+#ifdef HAVE_OPENMP
+	omp_set_max_active_levels(max_nesting_level);
+#endif
+}
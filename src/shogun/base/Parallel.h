@@ -43,10 +43,47 @@ public:
 	void set_num_threads(int32_t n);
 
 	/** get number of threads
-	 * @return number of threads
+	 *
+	 * Outside of parallel regions this is the number of threads set with
+	 * set_num_threads(). Inside a parallel region, the threads are shared
+	 * among the threads of the enclosing teams, so that a nested region
+	 * opened with num_threads(get_num_threads()) uses the cores left idle
+	 * by the outer region instead of oversubscribing them.
+	 *
+	 * @return number of threads available to the calling thread
 	 */
 	int32_t get_num_threads() const;
 
+	/** get number of threads set with set_num_threads(), independent of
+	 * the calling context
+	 *
+	 * To be used to size per-thread storage that outlives the current call.
+	 *
+	 * @return number of threads
+	 */
+	int32_t get_max_num_threads() const;
+
+	/** limit parallel regions opened by the calling thread to its share of
+	 * threads
+	 *
+	 * To be called at the start of an iteration of a parallel loop whose
+	 * body may open parallel regions itself, eg training a machine. Regions
+	 * without a num_threads clause then use get_num_threads() threads too.
+	 * Does nothing outside of parallel regions.
+	 */
+	void limit_nested_threads() const;
+
+	/** get maximum number of nested active parallel regions
+	 * @return maximum nesting level
+	 */
+	int32_t get_max_nesting_level() const;
+
+	/** set maximum number of nested active parallel regions, regions
+	 * nested deeper run on a single thread
+	 * @param levels maximum nesting level
+	 */
+	void set_max_nesting_level(int32_t levels);
+
 	// FIXME: Should be dropped, but needed to be wrappable by some
 	int32_t ref() { return 1; }
 	int32_t ref_count() const { return 1; }
@@ -55,6 +92,9 @@ public:
 private:
 	/** number of threads */
 	int32_t num_threads;
+
+	/** maximum number of nested active parallel regions */
+	int32_t max_nesting_level;
 };
 }
 #endif
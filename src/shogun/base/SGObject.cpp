@@ -36,7 +36,10 @@
 #include <vector>
 
 #include <shogun/base/ParameterInterface.h>
-#ifdef USE_VECTOR_BACKEND
+#ifdef USE_HASH_BACKEND
+#include <shogun/base/HashParameter.h>
+using ParameterBackend = shogun::detail::HashParameter;
+#elif USE_VECTOR_BACKEND
 #include <shogun/base/VectorParameter.h>
 using ParameterBackend = shogun::detail::VectorParameter;
 #elif USE_MAP_BACKEND
@@ -323,8 +326,16 @@ std::shared_ptr<SGObject> SGObject::clone(ParameterProperties pp) const
 	          "SGObject::create_empty() overridden.\n",
 	    get_name());
 
-	for (const auto& it : self->filter(pp))
+	// the properties are checked in place, filter() would copy all
+	// matching parameters first
+	for (const auto& it : *self)
 	{
+		const auto properties = it.second.get_properties();
+		if (!properties.has_property(pp) &&
+		    !(pp == ParameterProperties::ALL &&
+		      properties.compare_mask(ParameterProperties::NONE)))
+			continue;
+
 		const BaseTag& tag = it.first;
 		const Any& own = it.second.get_value();
 
@@ -351,6 +362,7 @@ void SGObject::create_parameter(
     BaseTag&& _tag, AnyParameter&& parameter)
 {
 	self->create(std::forward<BaseTag>(_tag), std::forward<AnyParameter>(parameter));
+	m_parameter_generation++;
 }
 
 const AnyParameter& SGObject::get_parameter(const BaseTag& _tag) const
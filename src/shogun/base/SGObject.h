@@ -42,6 +42,8 @@ class Parallel;
 class ParameterObserverInterface;
 class ObservedValue;
 class ParameterObserver;
+template <typename T>
+class ParameterRef;
 
 template <class T>
 class ObservedValueTemplated;
@@ -131,6 +133,9 @@ SG_FORCED_INLINE const char* convert_string_to_char(const char* name)
  */
 class SGObject: public std::enable_shared_from_this<SGObject>
 {
+	template <typename T>
+	friend class ParameterRef;
+
 	template <typename ReturnType, typename CastType>
 	struct ParameterGetterInterface
 	{
@@ -312,16 +317,16 @@ public:
 		      typename std::enable_if_t<!is_string<T>::value>* = nullptr>
 	void put(const Tag<T>& _tag, const T& value)
 	{
-		const auto& parameter_value = get_parameter(_tag).get_value();
+		auto& param = get_parameter(_tag);
 
-		if (!parameter_value.cloneable())
+		if (!param.get_value().cloneable())
 		{
 			error(
 				"Cannot put parameter {}::{}.", get_name(),
 				_tag.name().c_str());
 		}
 
-		update_parameter(_tag, value);
+		update_parameter(param, _tag.name(), value);
 	}
 
 	/** Setter for a class parameter that has values of type string,
@@ -515,52 +520,27 @@ public:
 	template <typename T>
 	auto get(const Tag<T>& _tag) const
 	{
-		using ReturnType = std::conditional_t<is_sg_base<T>::value, std::shared_ptr<T>, T>;
-		ReturnType result;
-		
-		const auto& param = get_parameter(_tag);
-
 		if constexpr (is_string<T>::value)
 		{
 			if (m_string_to_enum_map.count(_tag.name()))
 				return std::string(string_enum_reverse_lookup(_tag.name(), get<machine_int_t>(_tag.name())));
 		}
-		
-		const auto& value = param.get_value();
-		try
-		{
-			if (param.get_properties().has_property(ParameterProperties::CONSTFUNCTION))
-			{
-				ParameterGetterInterface<ReturnType, std::function<ReturnType()>> visitor{result};
-				value.visit_with(&visitor);
-			}
-			else if (param.get_properties().has_property(ParameterProperties::AUTO))
-			{
-				ParameterGetterInterface<ReturnType, AutoValue<ReturnType>> visitor{result};
-				value.visit_with(&visitor);
-			}
-			else
-			{
-				ParameterGetterInterface<ReturnType, ReturnType> visitor{result};
-				value.visit_with(&visitor);
-			}
-		}
-		catch (const std::bad_optional_access&)
-		{
-			const auto& heuristic = param.get_init_function();
-			error("The value of parameter {}::{} is automatically computed using \"{}\" during model training, "
-				  "and is currently not set. Either set a value or read value after training.",
-				  get_name(),_tag.name(), heuristic->display_name());
-		}
-		catch (const std::logic_error&)
-		{
-			error(
-				"Cannot get parameter {}::{} of type {}, incompatible with "
-				"requested type {}.",
-				get_name(), _tag.name().c_str(), value.type().c_str(),
-				demangled_type<T>().c_str());
-		}
-		return result;
+
+		return get_parameter_value<T>(get_parameter(_tag), _tag.name());
+	}
+
+	/** Returns a typed handle to a class parameter, identified by a name.
+	 * The parameter is looked up once, get() and put() of the handle then
+	 * access it directly, with the same checks as get() and put() of the
+	 * object. The handle must not outlive the object.
+	 *
+	 * @param name name of the parameter
+	 * @return handle of the parameter
+	 */
+	template <typename T>
+	ParameterRef<T> get_parameter_ref(std::string_view name)
+	{
+		return ParameterRef<T>(this, name);
 	}
 #endif
 
@@ -1065,7 +1045,10 @@ public:
 
 	/** Creates a clone of the current object. This is done via recursively
 	 * traversing all parameters, which corresponds to a deep copy.
+	 * Within a clone_utils::ShareDataScope, the storage of vectors and
+	 * matrices is shared instead of copied.
 	 *
+	 * @param pp properties of the parameters to clone
 	 * @return Cloned object
 	 */
 	virtual std::shared_ptr<SGObject> clone(ParameterProperties pp = ParameterProperties::ALL) const;
@@ -1137,13 +1120,26 @@ private:
 	template <typename T>
 	void update_parameter(const BaseTag& _tag, const T& value, bool do_checks = true)
 	{
-		auto& param = get_parameter(_tag);
+		update_parameter(get_parameter(_tag), _tag.name(), value, do_checks);
+	}
+
+	/** Updates a parameter that was already looked up.
+	 *
+	 * @param param the parameter
+	 * @param name name of the parameter, for error messages
+	 * @param value new value of parameter
+	 */
+	template <typename T>
+	void update_parameter(
+		AnyParameter& param, std::string_view name, const T& value,
+		bool do_checks = true)
+	{
 		auto& pprop = param.get_properties();
 		auto& parameter_value = param.get_value();
 		if (pprop.has_property(ParameterProperties::READONLY))
 		        require(!do_checks,
 				"{}::{} is marked as read-only and cannot be modified!",
-		          	get_name(), _tag.name().c_str());
+		          	get_name(), name);
 
 		if (pprop.has_property(ParameterProperties::CONSTRAIN))
 		{
@@ -1152,7 +1148,7 @@ private:
 			{
 				require(!do_checks,
 					"{}::{} cannot be updated because it must be: {}!",
-					get_name(), _tag.name().c_str(), *val);
+					get_name(), name, *val);
 			}
 		}
 		if constexpr (std::is_same_v<T, Any>)
@@ -1172,7 +1168,7 @@ private:
 				error(
 					"Cannot put parameter {}::{} of type {}, incompatible with "
 					"provided type {}.",
-					get_name(), _tag.name().c_str(), parameter_value.type().c_str(),
+					get_name(), name, parameter_value.type().c_str(),
 					demangled_type<T>().c_str());
 			}
 		}
@@ -1181,6 +1177,55 @@ private:
 			method();
 	}
 
+	/** Reads the value of a parameter that was already looked up.
+	 *
+	 * @param param the parameter
+	 * @param name name of the parameter, for error messages
+	 * @return value of the parameter
+	 */
+	template <typename T>
+	auto get_parameter_value(const AnyParameter& param, std::string_view name) const
+	{
+		using ReturnType = std::conditional_t<is_sg_base<T>::value, std::shared_ptr<T>, T>;
+		ReturnType result;
+
+		const auto& value = param.get_value();
+		try
+		{
+			if (param.get_properties().has_property(ParameterProperties::CONSTFUNCTION))
+			{
+				ParameterGetterInterface<ReturnType, std::function<ReturnType()>> visitor{result};
+				value.visit_with(&visitor);
+			}
+			else if (param.get_properties().has_property(ParameterProperties::AUTO))
+			{
+				ParameterGetterInterface<ReturnType, AutoValue<ReturnType>> visitor{result};
+				value.visit_with(&visitor);
+			}
+			else
+			{
+				ParameterGetterInterface<ReturnType, ReturnType> visitor{result};
+				value.visit_with(&visitor);
+			}
+		}
+		catch (const std::bad_optional_access&)
+		{
+			const auto& heuristic = param.get_init_function();
+			error("The value of parameter {}::{} is automatically computed using \"{}\" during model training, "
+				  "and is currently not set. Either set a value or read value after training.",
+				  get_name(), name, heuristic->display_name());
+		}
+		catch (const std::logic_error&)
+		{
+			error(
+				"Cannot get parameter {}::{} of type {}, incompatible with "
+				"requested type {}.",
+				get_name(), name, value.type().c_str(),
+				demangled_type<T>().c_str());
+		}
+		return result;
+	}
+
 	/** Getter for a class parameter, identified by a BaseTag.
 	 * Throws an exception if the class does not have such a parameter.
 	 *
@@ -1280,15 +1325,18 @@ protected:
 	template <class T>
 	void observe(const int64_t step, std::string_view name) const
 	{
+		// If there are no observers attached, do not look up or copy the
+		// parameter.
+		if (get_num_subscriptions() == 0)
+			return;
+
 		const auto tag = Tag<T>(name);
 		auto& param = this->get_parameter(tag);
 		auto pprop = param.get_properties();
-		auto cloned = get(tag);
 		pprop.remove_property(ParameterProperties::CONSTFUNCTION);
 		pprop.remove_property(ParameterProperties::FUNCTION);
-		this->observe(
-			step, name, static_cast<T>(clone_utils::clone(cloned)),
-			pprop);
+		// the value is cloned once when it is emitted
+		this->observe(step, name, get(tag), pprop);
 	}
 
 	/**
@@ -1323,6 +1371,10 @@ protected:
 		mutable size_t m_hash;
 
 	private:
+		/** incremented whenever a parameter is registered, which can move
+		 * the parameters in memory, see ParameterRef */
+		uint64_t m_parameter_generation = 0;
+
 		EPrimitiveType m_generic;
 		bool m_load_pre_called;
 		bool m_load_post_called;
@@ -1343,19 +1395,105 @@ protected:
 		int64_t m_next_subscription_index;
 	};
 
+/** @brief Typed handle to a parameter of an SGObject.
+ *
+ * Obtained once with SGObject::get_parameter_ref(), the handle keeps a
+ * pointer to the parameter, so that get() and put() skip the lookup by name
+ * that SGObject::get() and SGObject::put() do on every call. The pointer is
+ * looked up again only if parameters were registered in the meantime.
+ * Strings mapped to enums are not supported, use SGObject::put() for them.
+ */
+template <typename T>
+class ParameterRef
+{
+	static_assert(!is_string<T>::value, "Use SGObject::put() for string parameters");
+
+public:
+	/** value type of the parameter, objects are held by shared pointers */
+	using ValueType = std::conditional_t<is_sg_base<T>::value, std::shared_ptr<T>, T>;
+
+	/** constructor
+	 *
+	 * @param object object of the parameter
+	 * @param name name of the parameter
+	 */
+	ParameterRef(SGObject* object, std::string_view name)
+		: m_object(object), m_tag(name)
+	{
+		require(m_object, "No object provided.");
+		resolve();
+		require(m_parameter->get_value().cloneable(),
+			"Cannot put parameter {}::{}.", m_object->get_name(), m_tag.name());
+	}
+
+	/** @return value of the parameter */
+	ValueType get() const
+	{
+		return m_object->template get_parameter_value<T>(resolve(), m_tag.name());
+	}
+
+	/** @param value new value of the parameter */
+	void put(const ValueType& value)
+	{
+		m_object->update_parameter(resolve(), m_tag.name(), value);
+	}
+
+	/** @return name of the parameter */
+	std::string name() const
+	{
+		return m_tag.name();
+	}
+
+private:
+	AnyParameter& resolve() const
+	{
+		if (!m_parameter || m_generation != m_object->m_parameter_generation)
+		{
+			m_parameter = &m_object->get_parameter(m_tag);
+			m_generation = m_object->m_parameter_generation;
+		}
+		return *m_parameter;
+	}
+
+	SGObject* m_object;
+	BaseTag m_tag;
+	mutable AnyParameter* m_parameter = nullptr;
+	mutable uint64_t m_generation = 0;
+};
+
+/** Clones an object, see SGObject::clone()
+ *
+ * @param orig object to clone
+ * @param pp properties of the parameters to clone
+ * @param share_data whether the clone shares the storage of vectors and
+ * matrices with orig, see clone_utils::ShareDataScope
+ * @return clone of orig
+ */
 template <class T>
-std::shared_ptr<T> make_clone(std::shared_ptr<T> orig, ParameterProperties pp = ParameterProperties::ALL)
+std::shared_ptr<T> make_clone(std::shared_ptr<T> orig,
+	ParameterProperties pp = ParameterProperties::ALL, bool share_data = false)
 {
 	require(orig, "No object provided.");
+	clone_utils::ShareDataScope scope(share_data);
 	auto clone = orig->clone(pp);
 	ASSERT(clone);
 	return std::static_pointer_cast<T>(clone);
 }
 
+/** Clones a const object, see SGObject::clone()
+ *
+ * @param orig object to clone
+ * @param pp properties of the parameters to clone
+ * @param share_data whether the clone shares the storage of vectors and
+ * matrices with orig, see clone_utils::ShareDataScope
+ * @return clone of orig
+ */
 template <class T>
-std::shared_ptr<const T> make_clone(std::shared_ptr<const T> orig, ParameterProperties pp = ParameterProperties::ALL)
+std::shared_ptr<const T> make_clone(std::shared_ptr<const T> orig,
+	ParameterProperties pp = ParameterProperties::ALL, bool share_data = false)
 {
 	require(orig, "No object provided.");
+	clone_utils::ShareDataScope scope(share_data);
 	auto clone = orig->clone(pp);
 	ASSERT(clone);
 	return std::static_pointer_cast<const T>(clone);
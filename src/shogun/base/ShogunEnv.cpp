@@ -10,7 +10,10 @@
 #include <shogun/io/fs/FileSystemRegistry.h>
 
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/CacheManager.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/linalg/SGLinalg.h>
 
 #include <rxcpp/rx-lite.hpp>
@@ -36,6 +39,7 @@ ShogunEnv::ShogunEnv()
 	sg_io = std::make_unique<io::SGIO>();
 	sg_linalg = std::make_unique<SGLinalg>();
 	sg_signal = std::make_unique<Signal>();
+	sg_cache_manager = std::make_shared<CacheManager>();
 
 	sg_fequals_epsilon = 0.0;
 	sg_fequals_tolerant = false;
@@ -47,6 +51,13 @@ ShogunEnv::ShogunEnv()
 
 ShogunEnv::~ShogunEnv()
 {
+	if (!sg_trace_file.empty() && !profiler()->export_trace(sg_trace_file))
+	{
+		sg_io->message(
+		    io::MSG_WARN, "Could not write the trace to {}!\n",
+		    sg_trace_file);
+	}
+
 	delete Signal::m_subscriber;
 	delete Signal::m_observable;
 	delete Signal::m_subject;
@@ -82,6 +93,48 @@ void ShogunEnv::init_from_env()
 			sg_linalg->set_linalg_warnings(false);
 	}
 
+	char* env_simd_val = NULL;
+	env_simd_val = getenv("SHOGUN_SIMD_ISA");
+	if (env_simd_val && !set_simd_isa(env_simd_val))
+	{
+		sg_io->message(
+		    io::MSG_WARN,
+		    "The instruction set of the SHOGUN_SIMD_ISA environment "
+		    "variable ({}) is unknown or not supported, using {}!\n",
+		    env_simd_val, simd_isa());
+	}
+
+	char* env_profiling_val = NULL;
+	env_profiling_val = getenv("SHOGUN_PROFILING");
+	if (env_profiling_val && strncmp(env_profiling_val, "0", 1) != 0)
+		profiler()->set_enabled(true);
+
+	char* env_trace_val = NULL;
+	env_trace_val = getenv("SHOGUN_TRACE_FILE");
+	if (env_trace_val)
+	{
+		sg_trace_file = env_trace_val;
+		profiler()->set_tracing(true);
+	}
+
+	char* env_cache_val = NULL;
+	env_cache_val = getenv("SHOGUN_CACHE_BUDGET");
+	if (env_cache_val)
+	{
+		try
+		{
+			set_cache_budget(std::stoll(std::string(env_cache_val)));
+		}
+		catch (...)
+		{
+			sg_io->message(
+			    io::MSG_WARN,
+			    "The specified SHOGUN_CACHE_BUDGET environment ({})"
+			    "variable could not be parsed as integer!\n",
+			    env_cache_val);
+		}
+	}
+
 	char* env_thread_val = NULL;
 	env_thread_val = getenv("SHOGUN_NUM_THREADS");
 	if (env_thread_val)
@@ -126,6 +179,35 @@ bool ShogunEnv::fequals_tolerant()
 	return sg_fequals_tolerant;
 }
 
+std::string ShogunEnv::simd_isa()
+{
+	return simd::isa_name(simd::selected_isa());
+}
+
+bool ShogunEnv::set_simd_isa(const std::string& isa)
+{
+	simd::ISA parsed;
+	if (!simd::parse_isa(isa.c_str(), parsed))
+		return false;
+
+	return simd::select_isa(parsed);
+}
+
+void ShogunEnv::set_cache_budget(int64_t megabytes)
+{
+	sg_cache_manager->set_budget(megabytes * 1024 * 1024);
+}
+
+int64_t ShogunEnv::get_cache_budget()
+{
+	return sg_cache_manager->get_budget() / 1024 / 1024;
+}
+
+std::shared_ptr<CacheManager> ShogunEnv::cache_manager()
+{
+	return sg_cache_manager;
+}
+
 Signal* ShogunEnv::signal()
 {
 	return sg_signal.get();
@@ -135,3 +217,12 @@ SGLinalg* ShogunEnv::linalg()
 {
 	return sg_linalg.get();
 }
+
+Profiler* ShogunEnv::profiler()
+{
+	// the profiler is an SGObject, most processes never probe anything
+	std::call_once(sg_profiler_created, [this]() {
+		sg_profiler = std::make_shared<Profiler>();
+	});
+	return sg_profiler.get();
+}
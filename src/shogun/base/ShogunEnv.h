@@ -15,6 +15,8 @@
 #include <shogun/io/fs/FileSystemRegistry.h>
 
 #include <memory>
+#include <mutex>
+#include <string>
 
 namespace shogun
 {
@@ -24,6 +26,8 @@ namespace shogun
 	}
 	class SGLinalg;
 	class Signal;
+	class Profiler;
+	class CacheManager;
 
 	class ShogunEnv : public io::FileSystemRegistry, public Parallel, public Version
 	{
@@ -67,6 +71,34 @@ namespace shogun
 		 */
 		void set_global_fequals_tolerant(bool fequals_tolerant);
 
+		/** @return name of the instruction set the vectorized kernels
+		 * selected at startup, e.g. "avx2" (@see simd::ISA)
+		 */
+		std::string simd_isa();
+
+		/** Select the instruction set of the vectorized kernels, at most the
+		 * one detected at startup.
+		 *
+		 * @param isa name of the instruction set, "generic", "sse4.2",
+		 * "avx2", "avx512f" or "neon"
+		 * @return whether the instruction set is known and supported by the
+		 * processor
+		 */
+		bool set_simd_isa(const std::string& isa);
+
+		/** Set the memory budget of all caches together, e.g. kernel and
+		 * feature caches (@see CacheManager). Caches that use more than
+		 * their share shrink when they are allocated the next time.
+		 *
+		 * @param megabytes budget in megabytes, 0 for no limit
+		 */
+		void set_cache_budget(int64_t megabytes);
+
+		/** @return memory budget of all caches in megabytes, 0 if there
+		 * is no limit
+		 */
+		int64_t get_cache_budget();
+
 #ifndef SWIG // SWIG should skip this part
 		/** get the global linalg library object
 		 *
@@ -79,6 +111,20 @@ namespace shogun
 		 * @return linalg object
 		 */
 		Signal* signal();
+
+		/** get the global profiler, which the probes of the library
+		 * report to (@see Profiler)
+		 *
+		 * @return profiler object
+		 */
+		Profiler* profiler();
+
+		/** get the global cache manager, which the caches of the library
+		 * register with (@see CacheManager)
+		 *
+		 * @return cache manager
+		 */
+		std::shared_ptr<CacheManager> cache_manager();
 #endif
 
 	private:
@@ -93,6 +139,14 @@ namespace shogun
 		std::unique_ptr<io::SGIO> sg_io;
 		std::unique_ptr<Signal> sg_signal;
 		std::unique_ptr<SGLinalg> sg_linalg;
+		/** created on the first call of profiler() */
+		std::shared_ptr<Profiler> sg_profiler;
+		std::once_flag sg_profiler_created;
+		/** shared with the registered caches, which may outlive the
+		 * environment */
+		std::shared_ptr<CacheManager> sg_cache_manager;
+		/** file the trace of the profiler is written to on exit */
+		std::string sg_trace_file;
 		float64_t sg_fequals_epsilon;
 		bool sg_fequals_tolerant;
 	};
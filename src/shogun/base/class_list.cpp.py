@@ -190,16 +190,60 @@ def get_template_definitions(classes, supports_complex):
     return definitions
 
 
+def name_hash(name, seed):
+    # FNV-1a, must match name_hash() in class_list.cpp.templ
+    h = (2166136261 ^ seed) & 0xffffffff
+    for ch in name.encode():
+        h ^= ch
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+
+def get_perfect_hash(names):
+    """Hash and displace: the names are distributed into buckets, and for
+    every bucket, largest first, a seed is searched that hashes all of its
+    names to free slots. Returns the seed of every bucket and the name of
+    every slot (None for empty slots)."""
+    num_buckets = max(1, len(names) // 4)
+    num_slots = max(1, len(names) + len(names) // 4)
+    buckets = [[] for _ in range(num_buckets)]
+    for name in names:
+        buckets[name_hash(name, 0) % num_buckets].append(name)
+
+    seeds = [0] * num_buckets
+    slots = [None] * num_slots
+    for b in sorted(range(num_buckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        seed = 1
+        while True:
+            positions = [name_hash(name, seed) % num_slots for name in buckets[b]]
+            if len(set(positions)) == len(positions) and \
+                    all(slots[p] is None for p in positions):
+                break
+            seed += 1
+        seeds[b] = seed
+        for name, p in zip(buckets[b], positions):
+            slots[p] = name
+    return seeds, slots
+
+
 def get_struct(classes):
-    struct = []
+    prefixes = dict()
     for c, template in classes:
-        prefix = SHOGUN_BASIC_CLASS
-        if template:
-            prefix = SHOGUN_TEMPLATE_CLASS
+        # first declaration wins, like the former std::map initializer
+        if c not in prefixes:
+            prefixes[c] = SHOGUN_TEMPLATE_CLASS if template else SHOGUN_BASIC_CLASS
 
-        s = '{"%s", %s __new_%s},' % (c, prefix, c)
-        struct.append(s)
-    return struct
+    seeds, slots = get_perfect_hash(sorted(prefixes.keys()))
+    struct = []
+    for c in slots:
+        if c is None:
+            struct.append('{nullptr, nullptr},')
+        else:
+            struct.append('{"%s", %s __new_%s},' % (c, prefixes[c], c))
+    bucket_seeds = ['%du,' % seed for seed in seeds]
+    return struct, bucket_seeds
 
 
 def extract_block(c, lines, start_line, stop_line, start_sym, stop_sym):
@@ -370,12 +414,13 @@ if __name__ == '__main__':
     definitions = get_definitions(classes)
     template_definitions = get_template_definitions(template_classes, False)
     complex_template_definitions = get_template_definitions(complex_template_classes, True)
-    struct = get_struct(classes+template_classes+complex_template_classes)
+    struct, bucket_seeds = get_struct(classes+template_classes+complex_template_classes)
     substitutes = {'includes': includes,
                    'definitions': definitions,
                    'template_definitions': template_definitions,
                    'complex_template_definitions': complex_template_definitions,
-                   'struct': struct
+                   'struct': struct,
+                   'bucket_seeds': bucket_seeds
                    }
 
     write_templated_file(TEMPL_FILE, substitutes)
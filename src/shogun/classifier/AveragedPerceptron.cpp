@@ -91,8 +91,11 @@ void AveragedPerceptron::iteration()
 		linalg::update_mean(w, cached_w, num_prev_weights);
 		linalg::update_mean(bias, cached_bias, num_prev_weights);
 
-		observe<SGVector<float64_t>>(m_current_iteration, "w");
-		observe<float64_t>(m_current_iteration, "bias");
+		if (observes_iteration())
+		{
+			observe<SGVector<float64_t>>(m_current_iteration, "w");
+			observe<float64_t>(m_current_iteration, "bias");
+		}
 
 		num_prev_weights++;
 	}
@@ -38,6 +38,7 @@
 
 #include <shogun/lib/config.h>
 #include <shogun/classifier/GaussianProcessClassification.h>
+#include <shogun/machine/gp/SparseInference.h>
 #include <shogun/mathematics/Math.h>
 #ifdef USE_GPL_SHOGUN
 #include <shogun/machine/gp/SingleFITCLaplaceInferenceMethod.h>
@@ -147,15 +148,11 @@ bool GaussianProcessClassification::train_machine(std::shared_ptr<Features> data
 		m_method->set_features(data);
 	}
 	auto lik = m_method->get_model();
-	// set inducing features for FITC inference method
+	// set inducing features for sparse inference methods
 	if (m_inducing_features)
 	{
-#ifdef USE_GPL_SHOGUN
-			auto fitc_method = m_method->as<SingleFITCLaplaceInferenceMethod>();
-		    fitc_method->set_inducing_features(m_inducing_features);
-#else
-			error("Single FITC Laplace inference only supported under GPL.");
-#endif //USE_GPL_SHOGUN
+		auto sparse_method = m_method->as<SparseInference>();
+		sparse_method->set_inducing_features(m_inducing_features);
 	}
 
 	require(
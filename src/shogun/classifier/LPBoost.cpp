@@ -9,6 +9,7 @@
 
 #ifdef USE_CPLEX
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/classifier/LPBoost.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/mathematics/Math.h>
@@ -65,21 +66,32 @@ void CLPBoost::cleanup()
 
 float64_t CLPBoost::find_max_violator(int32_t& max_dim)
 {
-	float64_t max_val=0;
-	max_dim=-1;
-
+	// u_i*y_i is shared by all columns
+	SGVector<float64_t> uy(num_sfeat);
+	for (int32_t i=0; i<num_sfeat; i++)
+		uy[i]=u[i]*((BinaryLabels*)m_labels)->get_confidence(i);
+
+	// the columns of the transposed features are scored in parallel and
+	// compared in order
+	SGVector<float64_t> vals(num_svec);
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(env()->get_num_threads())
 	for (int32_t i=0; i<num_svec; i++)
 	{
-		float64_t valplus=0;
-		float64_t valminus=0;
-
+		float64_t val=0;
 		for (int32_t j=0; j<sfeat[i].num_feat_entries; j++)
 		{
 			int32_t idx=sfeat[i].features[j].feat_index;
-			float64_t v=u[idx]*((BinaryLabels*)m_labels)->get_confidence(idx)*sfeat[i].features[j].entry;
-			valplus+=v;
-			valminus-=v;
+			val+=uy[idx]*sfeat[i].features[j].entry;
 		}
+		vals[i]=val;
+	}
+
+	float64_t max_val=0;
+	max_dim=-1;
+	for (int32_t i=0; i<num_svec; i++)
+	{
+		float64_t valplus=vals[i];
+		float64_t valminus=-vals[i];
 
 		if (valplus>max_val || max_dim==-1)
 		{
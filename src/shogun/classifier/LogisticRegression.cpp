@@ -0,0 +1,191 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/classifier/LogisticRegression.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/optimization/AllreduceCostFunction.h>
+#include <shogun/optimization/ParallelCostFunction.h>
+#include <shogun/optimization/lbfgs/LBFGSMinimizer.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+namespace
+{
+/* loss of the local data, the regularizer is divided by the number of
+ * shards so that the sum over the shards is the full objective */
+class LogisticLossCostFunction : public ParallelCostFunction
+{
+public:
+	LogisticLossCostFunction(
+		std::shared_ptr<DotFeatures> features, SGVector<float64_t> labels,
+		SGVector<float64_t> variables, float64_t C, bool use_bias,
+		int32_t num_shards)
+		: ParallelCostFunction(), m_features(std::move(features)),
+		  m_labels(labels), m_variables(variables), m_C(C),
+		  m_use_bias(use_bias), m_num_shards(num_shards)
+	{
+	}
+
+	SGVector<float64_t> obtain_variable_reference() override
+	{
+		return m_variables;
+	}
+
+	const char* get_name() const override
+	{
+		return "LogisticLossCostFunction";
+	}
+
+protected:
+	index_t get_num_samples() override
+	{
+		return m_features->get_num_vectors();
+	}
+
+	float64_t get_block_cost(
+		index_t begin, index_t end, SGVector<float64_t> gradient) override
+	{
+		const int32_t dim=m_features->get_dim_feature_space();
+
+		// y_i*(w^T x_i+b) for the vectors of the block
+		SGVector<float64_t> margins(end-begin);
+		m_features->dense_dot_range(
+			margins.vector, begin, end, m_labels.vector+begin,
+			m_variables.vector, dim, 0.0);
+
+		float64_t loss=0;
+		float64_t bias_gradient=0;
+		for (index_t i=begin; i<end; i++)
+		{
+			float64_t z=margins[i-begin];
+			if (m_use_bias)
+				z+=m_labels[i]*m_variables[dim];
+			loss+=z>0 ? std::log1p(std::exp(-z)) : -z+std::log1p(std::exp(z));
+
+			// derivative of the loss wrt the output of vector i
+			const float64_t d=-m_C*m_labels[i]/(1+std::exp(z));
+			m_features->add_to_dense_vec(d, i, gradient.vector, dim);
+			bias_gradient+=d;
+		}
+		if (m_use_bias)
+			gradient[dim]+=bias_gradient;
+
+		return m_C*loss;
+	}
+
+	float64_t get_regularization(SGVector<float64_t> gradient) override
+	{
+		const int32_t dim=m_features->get_dim_feature_space();
+		float64_t sq_norm=0;
+		for (int32_t j=0; j<dim; j++)
+		{
+			sq_norm+=Math::sq(m_variables[j]);
+			gradient[j]+=m_variables[j]/m_num_shards;
+		}
+
+		return 0.5*sq_norm/m_num_shards;
+	}
+
+private:
+	std::shared_ptr<DotFeatures> m_features;
+	SGVector<float64_t> m_labels;
+	SGVector<float64_t> m_variables;
+	float64_t m_C;
+	bool m_use_bias;
+	int32_t m_num_shards;
+};
+}
+
+LogisticRegression::LogisticRegression() : LinearMachine()
+{
+	init();
+}
+
+LogisticRegression::LogisticRegression(float64_t C) : LinearMachine()
+{
+	init();
+	set_C(C);
+}
+
+LogisticRegression::~LogisticRegression()
+{
+}
+
+void LogisticRegression::init()
+{
+	m_C=1;
+	m_use_bias=true;
+	m_max_iterations=1000;
+	m_epsilon=1e-5;
+
+	SG_ADD(&m_C, "C", "Weight of the loss.", ParameterProperties::HYPER);
+	SG_ADD(&m_use_bias, "use_bias", "Whether a bias is trained.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_max_iterations, "max_iterations",
+		"Maximum number of L-BFGS iterations.", ParameterProperties::SETTING);
+	SG_ADD(&m_epsilon, "epsilon", "Relative gradient norm to stop at.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_communicator, "communicator",
+		"Communicator for sharded training data.");
+}
+
+bool LogisticRegression::train_machine(std::shared_ptr<Features> data)
+{
+	require(m_labels, "No labels set!");
+	if (data)
+	{
+		if (!data->has_property(FP_DOT))
+			error("Specified features are not of type CDotFeatures");
+		set_features(std::static_pointer_cast<DotFeatures>(data));
+	}
+	require(features, "No features set!");
+
+	const int32_t dim=features->get_dim_feature_space();
+	require(features->get_num_vectors()==m_labels->get_num_labels(),
+		"Number of vectors ({}) does not match number of labels ({})!",
+		features->get_num_vectors(), m_labels->get_num_labels());
+
+	SGVector<float64_t> variables(dim+(m_use_bias ? 1 : 0));
+	variables.zero();
+	if (m_warm_start && m_w.vlen==dim)
+	{
+		sg_memcpy(variables.vector, m_w.vector, sizeof(float64_t)*dim);
+		if (m_use_bias)
+			variables[dim]=bias;
+	}
+
+	const int32_t num_shards=m_communicator ? m_communicator->get_size() : 1;
+	std::shared_ptr<FirstOrderCostFunction> fun=
+		std::make_shared<LogisticLossCostFunction>(
+			features, binary_labels(m_labels)->get_labels(), variables, m_C,
+			m_use_bias, num_shards);
+	std::shared_ptr<AllreduceCostFunction> allreduce_fun;
+	if (m_communicator)
+	{
+		allreduce_fun=
+			std::make_shared<AllreduceCostFunction>(fun, m_communicator);
+		fun=allreduce_fun;
+	}
+
+	auto minimizer=std::make_shared<LBFGSMinimizer>(fun);
+	minimizer->set_lbfgs_parameters(
+		10, 1000, BACKTRACKING_STRONG_WOLFE, m_max_iterations, 0.0, 0,
+		m_epsilon);
+	minimizer->minimize();
+
+	// guards against the processes drifting apart by rounding
+	if (allreduce_fun)
+		allreduce_fun->broadcast_variables();
+
+	m_w=SGVector<float64_t>(dim);
+	sg_memcpy(m_w.vector, variables.vector, sizeof(float64_t)*dim);
+	bias=m_use_bias ? variables[dim] : 0;
+
+	return true;
+}
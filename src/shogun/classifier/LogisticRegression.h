@@ -0,0 +1,149 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _LOGISTICREGRESSION_H__
+#define _LOGISTICREGRESSION_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DotFeatures.h>
+#include <shogun/lib/Communicator.h>
+#include <shogun/lib/common.h>
+#include <shogun/machine/LinearMachine.h>
+
+namespace shogun
+{
+/** @brief L2 regularized logistic regression trained by L-BFGS.
+ *
+ * Minimizes
+ * \f[
+ * \frac{1}{2}\|w\|^2+C\sum_i\log(1+e^{-y_i(w^Tx_i+b)})
+ * \f]
+ * with LBFGSMinimizer, the bias is not regularized. The loss and its
+ * gradient are evaluated on all threads, see ParallelCostFunction.
+ *
+ * The training data can be sharded across processes: every process trains
+ * on its own shard with the same Communicator, see set_communicator(). The
+ * losses and gradients are summed by AllreduceCostFunction, so all
+ * processes minimize the objective of the union of the shards and end with
+ * the model of rank 0. Only the dimension of the features has to agree, the
+ * shards may have different sizes.
+ *
+ * A warm start, see LinearMachine::train(), starts from the given w and
+ * bias.
+ */
+class LogisticRegression : public LinearMachine
+{
+public:
+	/** problem type */
+	MACHINE_PROBLEM_TYPE(PT_BINARY);
+
+	/** default constructor */
+	LogisticRegression();
+
+	/** constructor
+	 *
+	 * @param C weight of the loss
+	 */
+	LogisticRegression(float64_t C);
+
+	~LogisticRegression() override;
+
+	/** @param C weight of the loss */
+	void set_C(float64_t C)
+	{
+		require(C>0, "C ({}) must be positive!", C);
+		m_C=C;
+	}
+
+	/** @return weight of the loss */
+	float64_t get_C() const
+	{
+		return m_C;
+	}
+
+	/** @param use_bias whether a bias is trained */
+	void set_bias_enabled(bool use_bias)
+	{
+		m_use_bias=use_bias;
+	}
+
+	/** @return whether a bias is trained */
+	bool get_bias_enabled() const
+	{
+		return m_use_bias;
+	}
+
+	/** @param max_iterations maximum number of L-BFGS iterations */
+	void set_max_iterations(int32_t max_iterations)
+	{
+		m_max_iterations=max_iterations;
+	}
+
+	/** @return maximum number of L-BFGS iterations */
+	int32_t get_max_iterations() const
+	{
+		return m_max_iterations;
+	}
+
+	/** @param epsilon relative gradient norm at which L-BFGS stops */
+	void set_epsilon(float64_t epsilon)
+	{
+		m_epsilon=epsilon;
+	}
+
+	/** @return relative gradient norm at which L-BFGS stops */
+	float64_t get_epsilon() const
+	{
+		return m_epsilon;
+	}
+
+	/** set the communicator to train on data sharded across processes,
+	 * nullptr trains on the local data only
+	 *
+	 * @param communicator communicator of the processes
+	 */
+	void set_communicator(std::shared_ptr<Communicator> communicator)
+	{
+		m_communicator=std::move(communicator);
+	}
+
+	/** @return communicator of the processes */
+	std::shared_ptr<Communicator> get_communicator() const
+	{
+		return m_communicator;
+	}
+
+	/** @return object name */
+	const char* get_name() const override
+	{
+		return "LogisticRegression";
+	}
+
+protected:
+	bool train_machine(std::shared_ptr<Features> data=NULL) override;
+
+private:
+	void init();
+
+protected:
+	/** weight of the loss */
+	float64_t m_C;
+
+	/** whether a bias is trained */
+	bool m_use_bias;
+
+	/** maximum number of L-BFGS iterations */
+	int32_t m_max_iterations;
+
+	/** relative gradient norm at which L-BFGS stops */
+	float64_t m_epsilon;
+
+	/** communicator for sharded data */
+	std::shared_ptr<Communicator> m_communicator;
+};
+}
+#endif /* _LOGISTICREGRESSION_H__ */
@@ -75,8 +75,11 @@ void Perceptron::iteration()
 			bias += gradient;
 			v.add(gradient, w);
 
-			observe<SGVector<float64_t>>(m_current_iteration, "w");
-			observe<float64_t>(m_current_iteration, "bias");
+			if (observes_iteration())
+			{
+				observe<SGVector<float64_t>>(m_current_iteration, "w");
+				observe<float64_t>(m_current_iteration, "bias");
+			}
 		}
 	}
 	m_complete = converged;
@@ -10,6 +10,7 @@
 #include <shogun/classifier/mkl/MKL.h>
 #include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
 #include <shogun/lib/Signal.h>
 #include <utility>
 
@@ -389,6 +390,23 @@ bool MKL::train_machine(std::shared_ptr<Features> data)
 		set_solver_type(ST_DIRECT);
 	}
 
+	// the p-norm weights have a closed form, the LP solvers are only
+	// required for the cutting planes of 1-norm MKL
+	if (((get_solver_type()==ST_CPLEX || get_solver_type()==ST_GLPK) &&
+			mkl_norm>1)
+#ifndef USE_CPLEX
+		|| get_solver_type()==ST_CPLEX
+#endif
+#ifndef USE_GLPK
+		|| get_solver_type()==ST_GLPK
+#endif
+		)
+	{
+		io::warn("Switching to the analytic ST_DIRECT method with mkl_norm={:g}",
+			mkl_norm);
+		set_solver_type(ST_DIRECT);
+	}
+
 	if (get_solver_type()==ST_ELASTICNET)
 	{
 	  // -- Initialize subkernel weights for Elasticnet MKL
@@ -742,20 +760,11 @@ float64_t MKL::compute_elasticnet_dual_objective()
 
 		int32_t k=0;
 		auto combined_kernel = std::static_pointer_cast<CombinedKernel>(kernel);
+		auto sums=combined_kernel->compute_subkernel_quadratic_forms(
+			get_support_vectors(), get_alphas());
 		for (index_t k_idx=0; k_idx<combined_kernel->get_num_kernels(); k_idx++)
 		{
-			auto kn = combined_kernel->get_kernel(k_idx);
-			float64_t sum=0;
-			for (int32_t i=0; i<n; i++)
-			{
-				int32_t ii=get_support_vector(i);
-
-				for (int32_t j=0; j<n; j++)
-				{
-					int32_t jj=get_support_vector(j);
-					sum+=get_alpha(i)*get_alpha(j)*kn->kernel(ii,jj);
-				}
-			}
+			float64_t sum=sums[k_idx];
 			nm[k]= Math::pow(sum, 0.5);
 			del = Math::max(del, nm[k]);
 
@@ -1631,6 +1640,31 @@ void MKL::compute_sum_beta(float64_t* sumw)
 	ASSERT(nweights==num_kernels)
 	ASSERT(old_beta)
 
+	// the squared norms of the subkernels are computed directly from the
+	// (cached) subkernels in parallel, unless the combined kernel has
+	// subkernel weights of its own or normalizes the weighted sum
+	auto combined_kernel=std::dynamic_pointer_cast<CombinedKernel>(kernel);
+	if (combined_kernel && !combined_kernel->get_append_subkernel_weights() &&
+		std::dynamic_pointer_cast<IdentityKernelNormalizer>(
+			kernel->get_normalizer()))
+	{
+		SGVector<index_t> sv_idx(nsv);
+		SGVector<float64_t> sv_alpha(nsv);
+		for (int32_t i=0; i<nsv; i++)
+		{
+			sv_idx[i]=svm->get_support_vector(i);
+			sv_alpha[i]=svm->get_alpha(i);
+		}
+
+		auto sums=combined_kernel->compute_subkernel_quadratic_forms(
+			sv_idx, sv_alpha);
+		for (int32_t n=0; n<num_kernels; n++)
+			sumw[n]=0.5*sums[n];
+
+		mkl_iterations++;
+		return;
+	}
+
 	for (int32_t i=0; i<num_kernels; i++)
 	{
 		beta.vector[i]=0;
@@ -1671,26 +1705,16 @@ float64_t MKL::compute_mkl_dual_objective()
 		return compute_elasticnet_dual_objective();
 	}
 
-	int32_t n=get_num_support_vectors();
 	float64_t mkl_obj=0;
 
 	if (m_labels && kernel && kernel->get_kernel_type() == K_COMBINED)
 	{
 		auto combined_kernel = std::static_pointer_cast<CombinedKernel>(kernel);
+		auto sums=combined_kernel->compute_subkernel_quadratic_forms(
+			get_support_vectors(), get_alphas());
 		for (index_t k_idx=0; k_idx<combined_kernel->get_num_kernels(); k_idx++)
 		{
-			auto kn = combined_kernel->get_kernel(k_idx);
-			float64_t sum=0;
-			for (int32_t i=0; i<n; i++)
-			{
-				int32_t ii=get_support_vector(i);
-
-				for (int32_t j=0; j<n; j++)
-				{
-					int32_t jj=get_support_vector(j);
-					sum+=get_alpha(i)*get_alpha(j)*kn->kernel(ii,jj);
-				}
-			}
+			float64_t sum=sums[k_idx];
 
 			if (mkl_norm==1.0)
 				mkl_obj = Math::max(mkl_obj, sum);
@@ -7,6 +7,7 @@
  */
 #include <shogun/lib/config.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/classifier/svm/LibLinear.h>
 #include <shogun/features/DotFeatures.h>
@@ -19,6 +20,7 @@
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 
+#include <algorithm>
 #include <utility>
 
 
@@ -54,6 +56,7 @@ void LibLinear::init()
 	set_C(1, 1);
 	set_max_iterations();
 	set_epsilon(1e-5);
+	m_parallel_dual = false;
 
 	SG_ADD(&C1, "C1", "C Cost constant 1.", ParameterProperties::HYPER);
 	SG_ADD(&C2, "C2", "C Cost constant 2.", ParameterProperties::HYPER);
@@ -61,6 +64,10 @@ void LibLinear::init()
 	SG_ADD(&epsilon, "epsilon", "Convergence precision.", ParameterProperties::HYPER);
 	SG_ADD(&max_iterations, "max_iterations", "Max number of iterations.", ParameterProperties::HYPER);
 	SG_ADD(&m_linear_term, "linear_term", "Linear Term", ParameterProperties::MODEL);
+	SG_ADD(
+	    &m_parallel_dual, "parallel_dual",
+	    "Whether the dual solvers run in parallel.",
+	    ParameterProperties::SETTING);
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&liblinear_solver_type, "liblinear_solver_type",
 	    "Type of LibLinear solver.", ParameterProperties::SETTING,
@@ -136,6 +143,25 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 		prob.n = w.vlen;
 		memset(w.vector, 0, sizeof(float64_t) * (w.vlen + 0));
 	}
+	if (m_warm_start)
+	{
+		if (solver_type == L2R_LR || solver_type == L2R_L2LOSS_SVC)
+		{
+			require(
+			    m_w.vlen == num_feat,
+			    "Dimension of the previous w ({}) does not match the number "
+			    "of features ({})",
+			    m_w.vlen, num_feat);
+			sg_memcpy(w.vector, m_w.vector, sizeof(float64_t) * num_feat);
+			if (get_bias_enabled())
+				w.vector[num_feat] = bias;
+		}
+		else
+			io::warn(
+			    "Warm starts are only supported by L2R_LR and L2R_L2LOSS_SVC, "
+			    "training from scratch");
+	}
+
 	prob.l = num_vec;
 	prob.x = features;
 	prob.y = SG_MALLOC(double, prob.l);
@@ -167,6 +193,10 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 
 	io::info("{} training points {} dims", prob.l, prob.n);
 
+	const int32_t num_blocks = m_parallel_dual
+	                               ? Math::min(env()->get_num_threads(), prob.l)
+	                               : 1;
+
 	function* fun_obj = NULL;
 	switch (solver_type)
 	{
@@ -193,12 +223,12 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 		break;
 	}
 	case L2R_L2LOSS_SVC_DUAL:
-		solve_l2r_l1l2_svc(
-		    w, &prob, get_epsilon(), Cp, Cn, L2R_L2LOSS_SVC_DUAL);
-		break;
 	case L2R_L1LOSS_SVC_DUAL:
-		solve_l2r_l1l2_svc(
-		    w, &prob, get_epsilon(), Cp, Cn, L2R_L1LOSS_SVC_DUAL);
+		if (num_blocks > 1)
+			solve_l2r_l1l2_svc_parallel(
+			    w, &prob, get_epsilon(), Cp, Cn, solver_type, num_blocks);
+		else
+			solve_l2r_l1l2_svc(w, &prob, get_epsilon(), Cp, Cn, solver_type);
 		break;
 	case L1R_L2LOSS_SVC:
 	{
@@ -216,7 +246,11 @@ bool LibLinear::train_machine(std::shared_ptr<Features> data)
 	}
 	case L2R_LR_DUAL:
 	{
-		solve_l2r_lr_dual(w, &prob, get_epsilon(), Cp, Cn);
+		if (num_blocks > 1)
+			solve_l2r_lr_dual_parallel(
+			    w, &prob, get_epsilon(), Cp, Cn, num_blocks);
+		else
+			solve_l2r_lr_dual(w, &prob, get_epsilon(), Cp, Cn);
 		break;
 	}
 	default:
@@ -458,6 +492,206 @@ void LibLinear::solve_l2r_l1l2_svc(
 	SG_FREE(index);
 }
 
+namespace
+{
+	/** @return first position of a block of the shuffled instances */
+	index_t block_begin(int32_t block, int32_t num_blocks, index_t l)
+	{
+		return int64_t(block) * l / num_blocks;
+	}
+
+	/** add the updates of all blocks to w, the local copies hold
+	 * w + sigma * update of the block
+	 */
+	void reconcile_blocks(
+	    SGVector<float64_t>& w, const SGMatrix<float64_t>& local_w,
+	    index_t w_size, float64_t sigma)
+	{
+#pragma omp parallel for
+		for (index_t j = 0; j < w_size; j++)
+		{
+			float64_t delta = 0;
+			for (index_t b = 0; b < local_w.num_cols; b++)
+				delta += local_w(j, b) - w.vector[j];
+			w.vector[j] += delta / sigma;
+		}
+	}
+} // namespace
+
+// Block-parallel variant of solve_l2r_l1l2_svc
+//
+// Every pass splits the shuffled instances into num_blocks blocks. Each block
+// runs coordinate descent on
+//
+//  min_\delta  w^T A \delta + 0.5 sigma ||A \delta||^2 +
+//		0.5 (\alpha+\delta)^T D (\alpha+\delta) - e^T \delta
+//
+// over its own coordinates, with A = [y_i x_i] and sigma = num_blocks,
+// against a local copy w + sigma A \delta of w. Summing the updates of all
+// blocks cannot increase the dual objective (CoCoA+ with adding).
+
+void LibLinear::solve_l2r_l1l2_svc_parallel(
+    SGVector<float64_t>& w, const liblinear_problem* prob, double eps,
+    double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st, int32_t num_blocks)
+{
+	const index_t l = prob->l;
+	const index_t w_size = prob->n;
+	const float64_t sigma = num_blocks;
+	int iter = 0;
+	SGVector<float64_t> QD(l);
+	SGVector<index_t> index(l);
+	SGVector<float64_t> alpha(l);
+	SGVector<int32_t> y(l);
+	SGMatrix<float64_t> local_w(w_size, num_blocks);
+	SGVector<float64_t> PGmax_blocks(num_blocks);
+	SGVector<float64_t> PGmin_blocks(num_blocks);
+
+	SGVector<float64_t> linear_term;
+	if (linear_term_inited())
+	{
+		linear_term = get_linear_term();
+	}
+
+	// default solver_type: L2R_L2LOSS_SVC_DUAL
+	double diag[3] = {0.5 / Cn, 0, 0.5 / Cp};
+	double upper_bound[3] = {Math::INFTY, 0, Math::INFTY};
+	if (st == L2R_L1LOSS_SVC_DUAL)
+	{
+		diag[0] = 0;
+		diag[2] = 0;
+		upper_bound[0] = Cn;
+		upper_bound[2] = Cp;
+	}
+
+	index_t n = prob->n;
+
+	if (prob->use_bias)
+		n--;
+
+	for (index_t j = 0; j < w_size; j++)
+		w[j] = 0;
+
+#pragma omp parallel for num_threads(num_blocks)
+	for (index_t i = 0; i < l; i++)
+	{
+		alpha[i] = 0;
+		y[i] = prob->y[i] > 0 ? +1 : -1;
+		QD[i] = prob->x->dot(i, prob->x, i);
+		if (prob->use_bias)
+			QD[i] += 1;
+		QD[i] = sigma * QD[i] + diag[GETI(i)];
+		index[i] = i;
+	}
+
+	auto pb = SG_PROGRESS(range(10));
+	Time start_time;
+	while (iter < get_max_iterations())
+	{
+		COMPUTATION_CONTROLLERS
+		if (m_max_train_time > 0 &&
+		    start_time.cur_time_diff() > m_max_train_time)
+			break;
+
+		random::shuffle(index.vector, index.vector + l, m_prng);
+
+#pragma omp parallel for num_threads(num_blocks)
+		for (int32_t b = 0; b < num_blocks; b++)
+		{
+			float64_t* wb = local_w.get_column_vector(b);
+			std::copy_n(w.vector, w_size, wb);
+			SGVector<float64_t> wb_features(wb, n, false);
+
+			float64_t PGmax = -Math::INFTY;
+			float64_t PGmin = Math::INFTY;
+			const index_t end = block_begin(b + 1, num_blocks, l);
+			for (index_t s = block_begin(b, num_blocks, l); s < end; s++)
+			{
+				const index_t i = index[s];
+				const int32_t yi = y[i];
+
+				double G = prob->x->dot(i, wb_features);
+				if (prob->use_bias)
+					G += wb[n];
+
+				if (linear_term.vector)
+					G = G * yi + linear_term.vector[i];
+				else
+					G = G * yi - 1;
+
+				const double C = upper_bound[GETI(i)];
+				G += alpha[i] * diag[GETI(i)];
+
+				double PG = 0;
+				if (alpha[i] == 0)
+				{
+					if (G < 0)
+						PG = G;
+				}
+				else if (alpha[i] == C)
+				{
+					if (G > 0)
+						PG = G;
+				}
+				else
+					PG = G;
+
+				PGmax = Math::max(PGmax, PG);
+				PGmin = Math::min(PGmin, PG);
+
+				if (fabs(PG) > 1.0e-12)
+				{
+					const double alpha_old = alpha[i];
+					alpha[i] =
+					    Math::min(Math::max(alpha[i] - G / QD[i], 0.0), C);
+					const double d = sigma * (alpha[i] - alpha_old) * yi;
+
+					prob->x->add_to_dense_vec(d, i, wb, n);
+
+					if (prob->use_bias)
+						wb[n] += d;
+				}
+			}
+			PGmax_blocks[b] = PGmax;
+			PGmin_blocks[b] = PGmin;
+		}
+
+		reconcile_blocks(w, local_w, w_size, sigma);
+		iter++;
+
+		const float64_t gap = Math::max(PGmax_blocks.vector, num_blocks) -
+		                       Math::min(PGmin_blocks.vector, num_blocks);
+		pb.print_absolute(
+		    gap, -Math::log10(gap), -Math::log10(1), -Math::log10(eps));
+
+		if (gap <= eps)
+			break;
+	}
+
+	pb.complete_absolute();
+	io::info("optimization finished, #iter = {}", iter);
+	if (iter >= get_max_iterations())
+	{
+		io::warn(
+		    "reaching max number of iterations\nUsing -s 2 may be faster"
+		    "(also see liblinear FAQ)\n\n");
+	}
+
+	// calculate objective value
+
+	double v = 0;
+	int nSV = 0;
+	for (index_t j = 0; j < w_size; j++)
+		v += w.vector[j] * w.vector[j];
+	for (index_t i = 0; i < l; i++)
+	{
+		v += alpha[i] * (alpha[i] * diag[GETI(i)] - 2);
+		if (alpha[i] > 0)
+			++nSV;
+	}
+	io::info("Objective value = {}", v / 2);
+	io::info("nSV = {}", nSV);
+}
+
 // A coordinate descent algorithm for
 // L1-regularized L2-loss support vector classification
 //
@@ -1370,6 +1604,195 @@ void LibLinear::solve_l2r_lr_dual(
 	delete[] index;
 }
 
+// Block-parallel variant of solve_l2r_lr_dual
+//
+// As in solve_l2r_l1l2_svc_parallel, each block solves the sub-problems of
+// its coordinates with the quadratic term scaled by sigma = num_blocks
+// against a local copy of w, the updates of all blocks are added up after
+// every pass.
+
+void LibLinear::solve_l2r_lr_dual_parallel(
+    SGVector<float64_t>& w, const liblinear_problem* prob, double eps,
+    double Cp, double Cn, int32_t num_blocks)
+{
+	const index_t l = prob->l;
+	const index_t w_size = prob->n;
+	const index_t num_weights = num_weights;
+	const float64_t sigma = num_blocks;
+	int iter = 0;
+	SGVector<float64_t> xTx(l);
+	int max_iter = 1000;
+	SGVector<index_t> index(l);
+	SGVector<float64_t> alpha(2 * l); // store alpha and C - alpha
+	SGVector<int32_t> y(l);
+	int max_inner_iter = 100; // for inner Newton
+	double innereps = 1e-2;
+	double innereps_min = Math::min(1e-8, eps);
+	double upper_bound[3] = {Cn, 0, Cp};
+	double Gmax_init = 0;
+	SGMatrix<float64_t> local_w(num_weights, num_blocks);
+	SGVector<float64_t> Gmax_blocks(num_blocks);
+	SGVector<int32_t> newton_iter_blocks(num_blocks);
+
+	// Initial alpha can be set here. Note that
+	// 0 < alpha[i] < upper_bound[GETI(i)]
+	// alpha[2*i] + alpha[2*i+1] = upper_bound[GETI(i)]
+	for (index_t i = 0; i < l; i++)
+	{
+		y[i] = prob->y[i] > 0 ? +1 : -1;
+		alpha[2 * i] = Math::min(0.001 * upper_bound[GETI(i)], 1e-8);
+		alpha[2 * i + 1] = upper_bound[GETI(i)] - alpha[2 * i];
+		index[i] = i;
+	}
+
+	// w = \sum_i y_i alpha_i x_i, accumulated per block
+	for (index_t j = 0; j < w_size; j++)
+		w[j] = 0;
+
+	local_w.zero();
+#pragma omp parallel for num_threads(num_blocks)
+	for (int32_t block = 0; block < num_blocks; block++)
+	{
+		float64_t* wb = local_w.get_column_vector(block);
+		const index_t end = block_begin(block + 1, num_blocks, l);
+		for (index_t i = block_begin(block, num_blocks, l); i < end; i++)
+		{
+			xTx[i] = prob->x->dot(i, prob->x, i);
+			prob->x->add_to_dense_vec(y[i] * alpha[2 * i], i, wb, w_size);
+
+			if (prob->use_bias)
+			{
+				wb[w_size] += y[i] * alpha[2 * i];
+				xTx[i] += 1;
+			}
+		}
+	}
+	reconcile_blocks(w, local_w, num_weights, 1);
+
+	auto pb = SG_PROGRESS(range(10));
+	while (iter < max_iter)
+	{
+		random::shuffle(index.vector, index.vector + l, m_prng);
+
+#pragma omp parallel for num_threads(num_blocks)
+		for (int32_t block = 0; block < num_blocks; block++)
+		{
+			float64_t* wb = local_w.get_column_vector(block);
+			std::copy_n(w.vector, num_weights, wb);
+			SGVector<float64_t> wb_features(wb, w_size, false);
+
+			int32_t newton_iter = 0;
+			double Gmax = 0;
+			const index_t end = block_begin(block + 1, num_blocks, l);
+			for (index_t s = block_begin(block, num_blocks, l); s < end; s++)
+			{
+				const index_t i = index[s];
+				const int32_t yi = y[i];
+				const double C = upper_bound[GETI(i)];
+
+				double ywTx = prob->x->dot(i, wb_features);
+				if (prob->use_bias)
+					ywTx += wb[w_size];
+
+				ywTx *= y[i];
+				const double a = sigma * xTx[i], b = ywTx;
+
+				// Decide to minimize g_1(z) or g_2(z)
+				index_t ind1 = 2 * i, ind2 = 2 * i + 1;
+				int sign = 1;
+				if (0.5 * a * (alpha[ind2] - alpha[ind1]) + b < 0)
+				{
+					ind1 = 2 * i + 1;
+					ind2 = 2 * i;
+					sign = -1;
+				}
+
+				//  g_t(z) = z*log(z) + (C-z)*log(C-z) + 0.5a(z-alpha_old)^2 +
+				//  sign*b(z-alpha_old)
+				const double alpha_old = alpha[ind1];
+				double z = alpha_old;
+				if (C - z < 0.5 * C)
+					z = 0.1 * z;
+				double gp =
+				    a * (z - alpha_old) + sign * b + std::log(z / (C - z));
+				Gmax = Math::max(Gmax, Math::abs(gp));
+
+				// Newton method on the sub-problem
+				const double eta = 0.1; // xi in the paper
+				int inner_iter = 0;
+				while (inner_iter <= max_inner_iter)
+				{
+					if (fabs(gp) < innereps)
+						break;
+					double gpp = a + C / (C - z) / z;
+					double tmpz = z - gp / gpp;
+					if (tmpz <= 0)
+						z *= eta;
+					else // tmpz in (0, C)
+						z = tmpz;
+					gp = a * (z - alpha_old) + sign * b +
+					     std::log(z / (C - z));
+					newton_iter++;
+					inner_iter++;
+				}
+
+				if (inner_iter > 0) // update w
+				{
+					alpha[ind1] = z;
+					alpha[ind2] = C - z;
+
+					const double d = sigma * sign * (z - alpha_old) * yi;
+					prob->x->add_to_dense_vec(d, i, wb, w_size);
+
+					if (prob->use_bias)
+						wb[w_size] += d;
+				}
+			}
+			Gmax_blocks[block] = Gmax;
+			newton_iter_blocks[block] = newton_iter;
+		}
+
+		reconcile_blocks(w, local_w, num_weights, sigma);
+
+		const double Gmax = Math::max(Gmax_blocks.vector, num_blocks);
+		if (iter == 0)
+			Gmax_init = Gmax;
+		iter++;
+
+		pb.print_absolute(
+		    Gmax, -Math::log10(Gmax), -Math::log10(Gmax_init),
+		    -Math::log10(eps * Gmax_init));
+
+		if (Gmax < eps)
+			break;
+
+		int32_t newton_iter = 0;
+		for (auto block_iter : newton_iter_blocks)
+			newton_iter += block_iter;
+		if (newton_iter <= l / 10)
+			innereps = Math::max(innereps_min, 0.1 * innereps);
+	}
+
+	pb.complete_absolute();
+	io::info("optimization finished, #iter = {}", iter);
+
+	if (iter >= get_max_iterations())
+		io::warn("reaching max number of iterations\nUsing -s 0 may be "
+		           "faster (also see FAQ)\n\n");
+
+	// calculate objective value
+
+	double v = 0;
+	for (index_t j = 0; j < w_size; j++)
+		v += w[j] * w[j];
+	v *= 0.5;
+	for (index_t i = 0; i < l; i++)
+		v += alpha[2 * i] * log(alpha[2 * i]) +
+		     alpha[2 * i + 1] * log(alpha[2 * i + 1]) -
+		     upper_bound[GETI(i)] * log(upper_bound[GETI(i)]);
+	io::info("Objective value = {}", v);
+}
+
 void LibLinear::set_linear_term(const SGVector<float64_t> linear_term)
 {
 	if (!m_labels)
@@ -192,6 +192,31 @@ namespace shogun
 			max_iterations = max_iter;
 		}
 
+		/** set whether the dual coordinate descent solvers
+		 * (L2R_L2LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL and L2R_LR_DUAL) run in
+		 * parallel
+		 *
+		 * In every pass the shuffled instances are split into one block per
+		 * thread of the ShogunEnv. Each block is optimized against its own
+		 * copy of w and the updates are added up after the pass. The local
+		 * sub-problems are scaled by the number of blocks, which keeps the
+		 * summed update a descent step (see Ma et al., "Adding vs. Averaging
+		 * in Distributed Primal-Dual Optimization"). The result only depends
+		 * on the seed and the number of threads. Shrinking is not used.
+		 *
+		 * @param parallel_dual whether to use the parallel solvers
+		 */
+		inline void set_parallel_dual(bool parallel_dual)
+		{
+			m_parallel_dual = parallel_dual;
+		}
+
+		/** @return whether the dual solvers run in parallel */
+		inline bool get_parallel_dual()
+		{
+			return m_parallel_dual;
+		}
+
 		/** set the linear term for qp */
 		void set_linear_term(const SGVector<float64_t> linear_term);
 
@@ -244,6 +269,17 @@ namespace shogun
 		    SGVector<float64_t>& w, const liblinear_problem* prob, double eps,
 		    double Cp, double Cn);
 
+		/** block-parallel variants of the dual solvers, see
+		 * set_parallel_dual()
+		 */
+		void solve_l2r_l1l2_svc_parallel(
+		    SGVector<float64_t>& w, const liblinear_problem* prob, double eps,
+		    double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st,
+		    int32_t num_blocks);
+		void solve_l2r_lr_dual_parallel(
+		    SGVector<float64_t>& w, const liblinear_problem* prob, double eps,
+		    double Cp, double Cn, int32_t num_blocks);
+
 	protected:
 		/** C1 */
 		float64_t C1;
@@ -259,6 +295,9 @@ namespace shogun
 		/** precomputed linear term */
 		SGVector<float64_t> m_linear_term;
 
+		/** whether the dual solvers run in parallel */
+		bool m_parallel_dual;
+
 		/** solver type */
 		LIBLINEAR_SOLVER_TYPE liblinear_solver_type;
 	};
@@ -140,6 +140,22 @@ bool LibSVM::train_machine(std::shared_ptr<Features> data)
 	param.weight = weights;
 	param.use_bias = get_bias_enabled();
 
+	SGVector<float64_t> alpha_init;
+	if (m_warm_start && get_num_support_vectors())
+	{
+		if (solver_type == LIBSVM_C_SVC)
+		{
+			alpha_init = SGVector<float64_t>(problem.l);
+			alpha_init.zero();
+			for (int32_t i=0; i<get_num_support_vectors(); i++)
+				alpha_init[get_support_vector(i)] = get_alpha(i);
+			problem.alpha_init = alpha_init.vector;
+		}
+		else
+			io::warn("{}: Warm starts are only supported by C-SVC, training from "
+				"scratch", get_name());
+	}
+
 	const char* error_msg = svm_check_parameter(&problem, &param);
 
 	if(error_msg)
@@ -148,7 +148,6 @@ void NewtonSVM::line_search_linear(const SGVector<float64_t>& d)
 	SGVector<float64_t> Y = binary_labels(m_labels)->get_labels();
 	SGVector<float64_t> outz(x_n);
 	SGVector<float64_t> temp1(x_n);
-	SGVector<float64_t> temp1forout(x_n);
 	SGVector<float64_t> outzsv(x_n);
 	SGVector<float64_t> Ysv(x_n);
 	SGVector<float64_t> Xsv(x_n);
@@ -169,10 +168,8 @@ void NewtonSVM::line_search_linear(const SGVector<float64_t>& d)
 
 	while (1)
 	{
-		temp1 = linalg::element_prod(Y, Xd);
-		temp1forout = temp1.clone();
-		linalg::scale(temp1forout, temp1forout, t);
-		outz = linalg::add(out, temp1forout, 1.0, -1.0);
+		linalg::eval(
+		    linalg::lazy(out) - linalg::lazy(Y) * linalg::lazy(Xd) * t, outz);
 
 		// Calculation of sv
 		sv_len=0;
@@ -229,12 +226,8 @@ void NewtonSVM::obj_fun_linear()
 	sg_memcpy(w0, weights, sizeof(float64_t)*(x_d));
 	w0[x_d]=0; //do not penalize b
 
-	//create copy of out
-	SGVector<float64_t> out1(x_n);
-
 	//compute steps for obj
-	out1 = linalg::element_prod(out, out);
-	float64_t p1 = linalg::sum(out1) / 2;
+	float64_t p1 = linalg::dot(out, out) / 2;
 
 	SGVector<float64_t> w0copy(x_d + 1);
 	w0copy = w0.clone();
@@ -120,11 +120,8 @@ public:
 		 */
 		void train_example(std::shared_ptr<StreamingDotFeatures >feature, float64_t label) override;
 
-private:
-		/** Set up parameters */
-		void init();
-
-		/** train on one vector
+		/** train on one vector, the weights must already have the
+		 * dimension of the vector (e.g. after train_example())
 		 * @param ex the example being trained
 		 * @param label label of this example
 		 */
@@ -137,6 +134,10 @@ private:
 		 */
 		void train_one(SGSparseVector<float32_t> ex, float64_t label);
 
+private:
+		/** Set up parameters */
+		void init();
+
 private:
 		/// use bias or not
 		bool use_bias;
@@ -13,6 +13,7 @@
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -90,46 +91,55 @@ bool OnlineSVMSGD::train(std::shared_ptr<Features> data)
 	if ((loss_type == L_LOGLOSS) || (loss_type == L_LOGLOSSMARGIN))
 		is_log_loss = true;
 
+	SGVector<float32_t> w_sum;
+	float64_t bias_sum = 0;
+	int64_t num_sums = 0;
+
 	int32_t vec_count;
 	for (auto e : SG_PROGRESS(range(epochs)))
 	{
 		COMPUTATION_CONTROLLERS
 		vec_count=0;
 		count = skip;
-		while (features->get_next_example())
+		if (m_num_workers > 1)
+			train_parallel_epoch(is_log_loss, w_sum, bias_sum, num_sums);
+		else
 		{
-			vec_count++;
-			// Expand w vector if more features are seen in this example
-			features->expand_if_required(m_w.vector, m_w.vlen);
+			while (features->get_next_example())
+			{
+				vec_count++;
+				// Expand w vector if more features are seen in this example
+				features->expand_if_required(m_w.vector, m_w.vlen);
 
-			float64_t eta = 1.0 / (lambda * t);
-			float64_t y = features->get_label();
-			float64_t z = y * (features->dense_dot(m_w.vector, m_w.vlen) + bias);
+				float64_t eta = 1.0 / (lambda * t);
+				float64_t y = features->get_label();
+				float64_t z = y * (features->dense_dot(m_w.vector, m_w.vlen) + bias);
 
-			if (z < 1 || is_log_loss)
-			{
-				float64_t etd = -eta * loss->first_derivative(z,1);
-				features->add_to_dense_vec(etd * y / wscale, m_w.vector, m_w.vlen);
+				if (z < 1 || is_log_loss)
+				{
+					float64_t etd = -eta * loss->first_derivative(z,1);
+					features->add_to_dense_vec(etd * y / wscale, m_w.vector, m_w.vlen);
+
+					if (use_bias)
+					{
+						if (use_regularized_bias)
+							bias *= 1 - eta * lambda * bscale;
+						bias += etd * y * bscale;
+					}
+				}
 
-				if (use_bias)
+				if (--count <= 0)
 				{
-					if (use_regularized_bias)
-						bias *= 1 - eta * lambda * bscale;
-					bias += etd * y * bscale;
+					float32_t r = 1 - eta * lambda * skip;
+					if (r < 0.8)
+						r = pow(1 - eta * lambda, skip);
+					linalg::scale(m_w, m_w, r);
+					count = skip;
 				}
-			}
+				t++;
 
-			if (--count <= 0)
-			{
-				float32_t r = 1 - eta * lambda * skip;
-				if (r < 0.8)
-					r = pow(1 - eta * lambda, skip);
-				linalg::scale(m_w, m_w, r);
-				count = skip;
+				features->release_example();
 			}
-			t++;
-
-			features->release_example();
 		}
 
 		// If the stream is seekable, reset the stream to the first
@@ -141,6 +151,14 @@ bool OnlineSVMSGD::train(std::shared_ptr<Features> data)
 
 	}
 
+	if (m_num_workers > 1 && m_averaging && num_sums > 0)
+	{
+		m_w = SGVector<float32_t>(w_sum.vlen);
+		for (index_t i = 0; i < w_sum.vlen; i++)
+			m_w[i] = w_sum[i] / num_sums;
+		bias = bias_sum / num_sums;
+	}
+
 	features->end_parser();
 	float64_t wnorm = linalg::dot(m_w, m_w);
 	io::info("Norm: {:.6f}, Bias: {:.6f}", wnorm, bias);
@@ -148,6 +166,116 @@ bool OnlineSVMSGD::train(std::shared_ptr<Features> data)
 	return true;
 }
 
+SGSparseVector<float32_t> OnlineSVMSGD::copy_example()
+{
+	SGSparseVector<float32_t> example(features->get_nnz_features_for_vector());
+
+	void* it = features->get_feature_iterator();
+	int32_t index;
+	float32_t value;
+	index_t num_entries = 0;
+	while (features->get_next_feature(index, value, it))
+	{
+		example.features[num_entries].feat_index = index;
+		example.features[num_entries].entry = value;
+		num_entries++;
+	}
+	features->free_feature_iterator(it);
+	example.num_feat_entries = num_entries;
+
+	return example;
+}
+
+void OnlineSVMSGD::train_parallel_epoch(
+	bool is_log_loss, SGVector<float32_t>& w_sum, float64_t& bias_sum,
+	int64_t& num_sums)
+{
+	std::vector<SGSparseVector<float32_t>> examples;
+	std::vector<float64_t> labels;
+	examples.reserve(m_batch_size);
+	labels.reserve(m_batch_size);
+
+	while (true)
+	{
+		// the stream has a single reader, so the batch is copied out of it
+		// while the parser thread keeps filling the ring
+		examples.clear();
+		labels.clear();
+		while ((int32_t)examples.size() < m_batch_size &&
+		       features->get_next_example())
+		{
+			features->expand_if_required(m_w.vector, m_w.vlen);
+			examples.push_back(copy_example());
+			labels.push_back(features->get_label());
+			features->release_example();
+		}
+
+		const int64_t num_examples = examples.size();
+		if (num_examples == 0)
+			break;
+
+		// lock-free updates of the shared w, the updates of an example only
+		// touch its non-zero features
+		const float64_t t0 = t;
+		float32_t* w = m_w.vector;
+		float64_t bias_update = 0;
+		int64_t num_updates = 0;
+#pragma omp parallel for num_threads(m_num_workers) \
+	reduction(+:bias_update, num_updates)
+		for (int64_t k = 0; k < num_examples; k++)
+		{
+			const auto& x = examples[k];
+			const float64_t eta = 1.0 / (lambda * (t0 + k));
+			const float64_t y = labels[k];
+
+			float64_t wx = 0;
+			for (index_t j = 0; j < x.num_feat_entries; j++)
+				wx += w[x.features[j].feat_index] * x.features[j].entry;
+			const float64_t z = y * (wx + bias);
+
+			if (z < 1 || is_log_loss)
+			{
+				const float64_t etd = -eta * loss->first_derivative(z, 1);
+				const float32_t scale = etd * y / wscale;
+				for (index_t j = 0; j < x.num_feat_entries; j++)
+					w[x.features[j].feat_index] += scale * x.features[j].entry;
+
+				bias_update += etd * y * bscale;
+				num_updates++;
+			}
+		}
+
+		t += num_examples;
+		const float64_t eta = 1.0 / (lambda * t);
+		if (use_bias)
+		{
+			if (use_regularized_bias)
+				bias *= pow(1 - eta * lambda * bscale, num_updates);
+			bias += bias_update;
+		}
+
+		count -= num_examples;
+		while (count <= 0)
+		{
+			float32_t r = 1 - eta * lambda * skip;
+			if (r < 0.8)
+				r = pow(1 - eta * lambda, skip);
+			linalg::scale(m_w, m_w, r);
+			count += skip;
+		}
+
+		if (m_averaging)
+		{
+			if (w_sum.vlen < m_w.vlen)
+				w_sum.resize_vector(m_w.vlen);
+			for (index_t i = 0; i < m_w.vlen; i++)
+				w_sum[i] += m_w[i];
+			bias_sum += bias;
+			num_sums++;
+		}
+	}
+}
+
 void OnlineSVMSGD::calibrate(int32_t max_vec_num)
 {
 	int32_t c_dim=1;
@@ -203,6 +331,9 @@ void OnlineSVMSGD::init()
 	use_bias=true;
 
 	use_regularized_bias=false;
+	m_num_workers=1;
+	m_batch_size=1024;
+	m_averaging=false;
 
 	loss=std::make_shared<HingeLoss>();
 
@@ -220,4 +351,14 @@ void OnlineSVMSGD::init()
 	SG_ADD(
 	    &use_regularized_bias, "use_regularized_bias",
 	    "Indicates if bias is regularized.", ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_num_workers, "num_workers", "Number of parallel workers.",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_batch_size, "batch_size", "Examples per batch of the workers.",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_averaging, "averaging",
+	    "Whether the iterates after each batch are averaged.",
+	    ParameterProperties::SETTING);
 }
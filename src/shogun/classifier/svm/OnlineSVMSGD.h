@@ -11,6 +11,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/labels/Labels.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/machine/OnlineLinearMachine.h>
 #include <shogun/features/streaming/StreamingDotFeatures.h>
 #include <shogun/loss/LossFunction.h>
@@ -126,6 +127,48 @@ class OnlineSVMSGD : public OnlineLinearMachine
 		 */
 		inline bool get_regularized_bias_enabled() { return use_regularized_bias; }
 
+		/** set the number of workers
+		 *
+		 * With more than one worker, batches of examples are read from the
+		 * stream and processed by the workers in parallel. The workers
+		 * update the shared w without locks (Hogwild!, Niu et al., 2011),
+		 * which works well for sparse examples.
+		 *
+		 * @param num_workers number of workers, 1 for sequential training
+		 */
+		inline void set_num_workers(int32_t num_workers)
+		{
+			require(num_workers>0, "Number of workers ({}) must be positive", num_workers);
+			m_num_workers=num_workers;
+		}
+
+		/** @return number of workers */
+		inline int32_t get_num_workers() { return m_num_workers; }
+
+		/** set the number of examples read from the stream per batch of the
+		 * workers
+		 *
+		 * @param batch_size examples per batch
+		 */
+		inline void set_batch_size(int32_t batch_size)
+		{
+			require(batch_size>0, "Batch size ({}) must be positive", batch_size);
+			m_batch_size=batch_size;
+		}
+
+		/** @return examples per batch of the workers */
+		inline int32_t get_batch_size() { return m_batch_size; }
+
+		/** set whether the result is the average of w and bias after each
+		 * batch of the workers instead of the last iterate
+		 *
+		 * @param averaging whether to average
+		 */
+		inline void set_averaging(bool averaging) { m_averaging=averaging; }
+
+		/** @return whether the iterates of the workers are averaged */
+		inline bool get_averaging() { return m_averaging; }
+
 		/** Set the loss function to use
 		 *
 		 * @param loss_func object derived from CLossFunction
@@ -152,6 +195,14 @@ class OnlineSVMSGD : public OnlineLinearMachine
 	private:
 		void init();
 
+		/** copy the current example of the stream */
+		SGSparseVector<float32_t> copy_example();
+
+		/** one epoch with m_num_workers workers */
+		void train_parallel_epoch(
+			bool is_log_loss, SGVector<float32_t>& w_sum,
+			float64_t& bias_sum, int64_t& num_sums);
+
 	private:
 		float64_t t;
 		float64_t lambda;
@@ -167,6 +218,15 @@ class OnlineSVMSGD : public OnlineLinearMachine
 		bool use_regularized_bias;
 
 		std::shared_ptr<LossFunction> loss;
+
+		/** number of workers */
+		int32_t m_num_workers;
+
+		/** examples per batch of the workers */
+		int32_t m_batch_size;
+
+		/** whether to average the iterates after each batch */
+		bool m_averaging;
 };
 }
 #endif
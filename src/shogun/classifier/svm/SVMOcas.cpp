@@ -10,6 +10,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/Time.h>
 #include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/labels/Labels.h>
@@ -20,6 +21,9 @@
 
 using namespace shogun;
 
+/* minimum number of examples per thread when accumulating a cut */
+#define OCAS_MIN_BLOCK_SIZE 1024
+
 SVMOcas::SVMOcas()
 : LinearMachine()
 {
@@ -201,14 +205,46 @@ int SVMOcas::add_new_cut(
 	float64_t* new_a = o->tmp_a_buf;
 	memset(new_a, 0, sizeof(float64_t)*nDim);
 
-	for(i=0; i < cut_length; i++)
+	/* every block of the cut is accumulated into its own vector, the first
+	 * one into new_a, and the vectors are summed afterwards */
+	const int32_t num_blocks=Math::max(1, Math::min(
+		env()->get_num_threads(), int32_t(cut_length/OCAS_MIN_BLOCK_SIZE)));
+	SGMatrix<float64_t> local_a;
+	if (num_blocks>1)
+		local_a=SGMatrix<float64_t>(nDim, num_blocks-1);
+	float64_t bias_sum=0;
+#pragma omp parallel for num_threads(num_blocks) reduction(+:bias_sum)
+	for (int32_t b=0; b<num_blocks; b++)
 	{
-		f->add_to_dense_vec(y[new_cut[i]], new_cut[i], new_a, nDim);
+		float64_t* a=new_a;
+		if (b>0)
+		{
+			a=local_a.get_column_vector(b-1);
+			memset(a, 0, sizeof(float64_t)*nDim);
+		}
 
-		if (o->use_bias)
-			c_bias[nSel]+=y[new_cut[i]];
+		const uint32_t begin=int64_t(b)*cut_length/num_blocks;
+		const uint32_t end=int64_t(b+1)*cut_length/num_blocks;
+		for (uint32_t k=begin; k<end; k++)
+		{
+			f->add_to_dense_vec(y[new_cut[k]], new_cut[k], a, nDim);
+			bias_sum+=y[new_cut[k]];
+		}
 	}
 
+	if (num_blocks>1)
+	{
+#pragma omp parallel for
+		for (int64_t k=0; k<nDim; k++)
+		{
+			for (int32_t b=1; b<num_blocks; b++)
+				new_a[k]+=local_a(k, b-1);
+		}
+	}
+
+	if (o->use_bias)
+		c_bias[nSel]+=bias_sum;
+
 	/* compute new_a'*new_a and count number of non-zerou dimensions */
 	nz_dims = 0;
 	sq_norm_a = Math::sq(c_bias[nSel]);
@@ -242,6 +278,7 @@ int SVMOcas::add_new_cut(
 
 	new_col_H[nSel] = sq_norm_a;
 
+#pragma omp parallel for schedule(dynamic) private(j)
 	for(i=0; i < nSel; i++)
 	{
 		float64_t tmp = c_bias[nSel]*c_bias[i];
@@ -0,0 +1,70 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/machine/Machine_benchmark.h>
+
+namespace shogun
+{
+
+std::shared_ptr<LibSVM> make_libsvm(const MachineFixture& fixture)
+{
+	auto kernel = std::make_shared<GaussianKernel>(2.0 * MachineFixture::kNumDims);
+	return std::make_shared<LibSVM>(1.0, kernel, fixture.binary_labels);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, LibSVM_RBF_Train)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		auto svm = make_libsvm(*this);
+		svm->train(features_train);
+	}
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, LibSVM_RBF_Apply)(benchmark::State& state)
+{
+	auto svm = make_libsvm(*this);
+	svm->train(features_train);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(svm->apply_binary(features_test));
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, LibLinear_Train)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		auto svm = std::make_shared<LibLinear>(L2R_L2LOSS_SVC_DUAL);
+		svm->set_labels(binary_labels);
+		svm->train(features_train);
+	}
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, LibLinear_Apply)(benchmark::State& state)
+{
+	auto svm = std::make_shared<LibLinear>(L2R_L2LOSS_SVC_DUAL);
+	svm->set_labels(binary_labels);
+	svm->train(features_train);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(svm->apply_binary(features_test));
+	set_counters(state);
+}
+
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, LibSVM_RBF_Train), 1000, 10000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, LibSVM_RBF_Apply), 1000, 10000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, LibLinear_Train), 1000, 100000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, LibLinear_Apply), 1000, 100000, 8);
+
+} // namespace shogun
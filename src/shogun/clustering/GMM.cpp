@@ -15,14 +15,145 @@
 #include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/KNN.h>
+
+#include <algorithm>
+#include <limits>
 #include <utility>
 #include <vector>
 
 using namespace shogun;
 using namespace std;
+using namespace Eigen;
+
+namespace
+{
+/* number of vectors the E- and M-step process at once */
+const index_t block_size=1024;
+
+/** terms of the log density of a component that do not depend on the
+ * vector */
+struct ComponentFactor
+{
+	ECovType cov_type;
+	VectorXd mean;
+	/** lower Cholesky factor of the covariance, FULL only */
+	MatrixXd cholesky;
+	/** inverse variance of each dimension, DIAG and SPHERICAL only */
+	VectorXd inv_variance;
+	/** log coefficient minus half the log normalization */
+	float64_t offset;
+};
+
+ComponentFactor factor_component(
+	const shared_ptr<Gaussian>& component, float64_t coefficient)
+{
+	ComponentFactor factor;
+	factor.cov_type=component->get_cov_type();
+	auto mean=component->get_mean();
+	auto d=component->get_d();
+	const index_t num_dim=mean.vlen;
+	factor.mean=Map<VectorXd>(mean.vector, num_dim);
+
+	float64_t log_det=0;
+	switch (factor.cov_type)
+	{
+		case FULL:
+		{
+			auto u=component->get_u();
+			Map<MatrixXd> eigenvectors(u.matrix, num_dim, num_dim);
+			Map<VectorXd> eigenvalues(d.vector, num_dim);
+			MatrixXd cov=eigenvectors*eigenvalues.asDiagonal()*
+				eigenvectors.transpose();
+			factor.cholesky=cov.llt().matrixL();
+			log_det=2*factor.cholesky.diagonal().array().log().sum();
+			break;
+		}
+		case DIAG:
+			factor.inv_variance=Map<VectorXd>(d.vector, num_dim).cwiseInverse();
+			log_det=-factor.inv_variance.array().log().sum();
+			break;
+		case SPHERICAL:
+			factor.inv_variance=VectorXd::Constant(num_dim, 1.0/d[0]);
+			log_det=num_dim*std::log(d[0]);
+			break;
+	}
+	factor.offset=std::log(coefficient)-
+		0.5*(num_dim*std::log(2*M_PI)+log_det);
+
+	return factor;
+}
+
+/** log of the coefficient times the density of every component at every
+ * vector, blocks of vectors are processed in parallel with one triangular
+ * solve per component and block
+ *
+ * @return num_components x num_vectors matrix, i.e. the layout of alpha
+ */
+SGMatrix<float64_t> log_joint_likelihoods(
+	const SGMatrix<float64_t>& data,
+	const vector<shared_ptr<Gaussian>>& components,
+	const SGVector<float64_t>& coefficients)
+{
+	const index_t num_dim=data.num_rows;
+	const index_t num_vectors=data.num_cols;
+	const index_t num_components=components.size();
+
+	vector<ComponentFactor> factors(num_components);
+	for (index_t j=0; j<num_components; j++)
+		factors[j]=factor_component(components[j], coefficients[j]);
+
+	SGMatrix<float64_t> result(num_components, num_vectors);
+	const index_t num_blocks=(num_vectors+block_size-1)/block_size;
+#pragma omp parallel for
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		const index_t begin=b*block_size;
+		const index_t len=std::min(block_size, num_vectors-begin);
+		Map<const MatrixXd> block(
+			data.matrix+int64_t(begin)*num_dim, num_dim, len);
+		Map<MatrixXd> log_pxy(
+			result.matrix+int64_t(begin)*num_components, num_components, len);
+
+		MatrixXd centered(num_dim, len);
+		for (index_t j=0; j<num_components; j++)
+		{
+			const auto& factor=factors[j];
+			centered=block.colwise()-factor.mean;
+			if (factor.cov_type==FULL)
+			{
+				factor.cholesky.triangularView<Lower>().solveInPlace(centered);
+				log_pxy.row(j)=(factor.offset-
+					0.5*centered.colwise().squaredNorm().array()).matrix();
+			}
+			else
+			{
+				log_pxy.row(j)=(factor.offset-0.5*(factor.inv_variance.transpose()*
+					centered.array().square().matrix()).array()).matrix();
+			}
+		}
+	}
+
+	return result;
+}
+
+/** @return log of the sum of the exponentials of the values */
+float64_t log_sum_exp(const float64_t* values, index_t num, float64_t add=0)
+{
+	const float64_t max=*std::max_element(values, values+num);
+	if (max==-std::numeric_limits<float64_t>::infinity())
+		return std::log(add);
+
+	float64_t sum=add*std::exp(-max);
+	for (index_t i=0; i<num; i++)
+		sum+=std::exp(values[i]-max);
+
+	return max+std::log(sum);
+}
+}
 
 GMM::GMM() : RandomMixin<Distribution>(), m_components(), m_coefficients()
 {
@@ -146,36 +277,26 @@ float64_t GMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chang
 	int32_t iter=0;
 	float64_t log_likelihood_prev=0;
 	float64_t log_likelihood_cur=0;
-	SGVector<float64_t> logPxy(num_vectors * m_components.size());
-	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
+	const index_t num_components=m_components.size();
+	SGMatrix<float64_t> data=dotdata->get_feature_matrix();
 	auto pb = SG_PROGRESS(range(max_iter));
 	while (iter<max_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		auto logPxy=log_joint_likelihoods(data, m_components, m_coefficients);
+#pragma omp parallel for reduction(+:log_likelihood_cur)
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    std::log(m_coefficients[j]);
-				logPx[i] +=
-				    std::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
+			const float64_t* log_pxy=logPxy.get_column_vector(i);
+			const float64_t logPx=log_sum_exp(log_pxy, num_components);
+			log_likelihood_cur+=logPx;
 
-			logPx[i] = std::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
+			for (index_t j=0; j<num_components; j++)
 			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i * m_components.size() + j] = std::exp(
-				    logPxy[index_t(i * m_components.size() + j)] - logPx[i]);
+				alpha.matrix[i * num_components + j] =
+				    std::exp(log_pxy[j] - logPx);
 			}
 		}
 
@@ -204,8 +325,9 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 	if (m_components.size()<3)
 		error("Can't run SMEM with less than 3 component mixture model.");
 
-	auto dotdata = features->as<DotFeatures>();
+	auto dotdata = features->as<DenseFeatures<float64_t>>();
 	auto num_vectors = dotdata->get_num_vectors();
+	SGMatrix<float64_t> data = dotdata->get_feature_matrix();
 
 	float64_t cur_likelihood=train_em(min_cov, max_em_iter, min_change);
 
@@ -230,20 +352,13 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 		linalg::zero(logPostSum);
 		linalg::zero(logPostSum2);
 		linalg::zero(logPostSumSum);
+		auto log_pxy=log_joint_likelihoods(
+		    data, m_components, m_coefficients);
+		std::copy_n(log_pxy.matrix, logPxy.vlen, logPxy.vector);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    std::log(m_coefficients[j]);
-				logPx[i] +=
-				    std::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
-
-			logPx[i] = std::log(logPx[i]);
+			logPx[i] = log_sum_exp(
+			    log_pxy.get_column_vector(i), m_components.size());
 
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
 			{
@@ -351,35 +466,28 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 
 void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_cov, int32_t max_em_iter, float64_t min_change)
 {
-	auto dotdata=features->as<DotFeatures>();
+	auto dotdata=features->as<DenseFeatures<float64_t>>();
 	int32_t num_vectors=dotdata->get_num_vectors();
+	SGMatrix<float64_t> data=dotdata->get_feature_matrix();
 
-	SGVector<float64_t> init_logPxy(num_vectors * m_components.size());
 	SGVector<float64_t> init_logPx(num_vectors);
 	SGVector<float64_t> init_logPx_fix(num_vectors);
 	SGVector<float64_t> post_add(num_vectors);
 
+	auto init_logPxy=log_joint_likelihoods(data, m_components, m_coefficients);
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		init_logPx[i]=0;
+		init_logPx[i]=log_sum_exp(
+		    init_logPxy.get_column_vector(i), m_components.size());
 		init_logPx_fix[i]=0;
-
-		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
 		for (int32_t j=0; j<int32_t(m_components.size()); j++)
 		{
-			init_logPxy[index_t(i * m_components.size() + j)] =
-			    m_components[j]->compute_log_PDF(v) +
-			    std::log(m_coefficients[j]);
-			init_logPx[i] +=
-			    std::exp(init_logPxy[index_t(i * m_components.size() + j)]);
 			if (j!=comp1 && j!=comp2 && j!=comp3)
 			{
 				init_logPx_fix[i] +=
 				    std::exp(init_logPxy[index_t(i * m_components.size() + j)]);
 			}
 		}
-
-		init_logPx[i] = std::log(init_logPx[i]);
 		post_add[i] = std::log(
 		    std::exp(
 		        init_logPxy[index_t(i * m_components.size() + comp1)] -
@@ -498,34 +606,24 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 	float64_t log_likelihood_cur=0;
 	int32_t iter=0;
 	SGMatrix<float64_t> alpha(num_vectors, 3);
-	SGVector<float64_t> logPxy(num_vectors * 3);
-	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
 
 	while (iter<max_em_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		auto logPxy=log_joint_likelihoods(data, components, coefficients);
+#pragma omp parallel for reduction(+:log_likelihood_cur)
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<3; j++)
-			{
-				logPxy[i * 3 + j] = components[j]->compute_log_PDF(v) +
-				                    std::log(coefficients[j]);
-				logPx[i] += std::exp(logPxy[i * 3 + j]);
-			}
-
-			logPx[i] = std::log(logPx[i] + init_logPx_fix[i]);
-			log_likelihood_cur+=logPx[i];
+			const float64_t* log_pxy=logPxy.get_column_vector(i);
+			const float64_t logPx=log_sum_exp(log_pxy, 3, init_logPx_fix[i]);
+			log_likelihood_cur+=logPx;
 
 			for (int32_t j=0; j<3; j++)
 			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
 				alpha.matrix[i * 3 + j] =
-				    std::exp(logPxy[i * 3 + j] - logPx[i] + post_add[i]);
+				    std::exp(log_pxy[j] - logPx + post_add[i]);
 			}
 		}
 
@@ -548,124 +646,153 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 
 void GMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 {
-	auto dotdata=features->as<DotFeatures>();
-	int32_t num_dim=dotdata->get_dim_feature_space();
-
-	float64_t alpha_sum;
-	float64_t alpha_sum_sum=0;
-
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	SGMatrix<float64_t> data=features->as<DenseFeatures<float64_t>>()
+		->get_feature_matrix();
+	const index_t num_dim=data.num_rows;
+	const index_t num_vectors=alpha.num_rows;
+	const index_t num_components=alpha.num_cols;
+	require(num_vectors==data.num_cols,
+		"Number of assignments ({}) does not match number of vectors ({})",
+		num_vectors, data.num_cols);
+
+	// the assignments of a vector are contiguous, i.e. alpha holds the
+	// num_components x num_vectors matrix of posteriors
+	Map<const MatrixXd> posteriors(alpha.matrix, num_components, num_vectors);
+	Map<const MatrixXd> X(data.matrix, num_dim, num_vectors);
+	const index_t num_blocks=(num_vectors+block_size-1)/block_size;
+
+	// weights and weighted sums of the vectors, accumulated per thread
+	VectorXd weights=VectorXd::Zero(num_components);
+	MatrixXd means=MatrixXd::Zero(num_dim, num_components);
+#pragma omp parallel
 	{
-		alpha_sum=0;
-		SGVector<float64_t> mean_sum(num_dim);
-		linalg::zero(mean_sum);
-
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		VectorXd local_weights=VectorXd::Zero(num_components);
+		MatrixXd local_sums=MatrixXd::Zero(num_dim, num_components);
+#pragma omp for
+		for (index_t b=0; b<num_blocks; b++)
 		{
-			alpha_sum+=alpha.matrix[j*alpha.num_cols+i];
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			linalg::add(
-			    v, mean_sum, mean_sum, alpha.matrix[j * alpha.num_cols + i],
-			    1.0);
+			const index_t begin=b*block_size;
+			const index_t len=std::min(block_size, num_vectors-begin);
+			local_weights+=posteriors.middleCols(begin, len).rowwise().sum();
+			local_sums.noalias()+=X.middleCols(begin, len)*
+				posteriors.middleCols(begin, len).transpose();
 		}
-
-		linalg::scale(mean_sum, mean_sum, 1.0 / alpha_sum);
-
-		m_components[i]->set_mean(mean_sum);
-
-		SGMatrix<float64_t> cov_sum;
-
-		ECovType cov_type = m_components[i]->get_cov_type();
-		if (cov_type==FULL)
-		{
-			cov_sum = SGMatrix<float64_t>(num_dim, num_dim);
-			linalg::zero(cov_sum);
-		}
-		else if(cov_type==DIAG)
+#pragma omp critical
 		{
-			cov_sum = SGMatrix<float64_t>(1, num_dim);
-			linalg::zero(cov_sum);
+			weights+=local_weights;
+			means+=local_sums;
 		}
-		else if(cov_type==SPHERICAL)
+	}
+	means*=weights.cwiseInverse().asDiagonal();
+
+	// weighted scatter around the new means, a full matrix, the diagonal
+	// or the trace depending on the covariance type
+	vector<MatrixXd> scatters(num_components);
+	for (index_t j=0; j<num_components; j++)
+	{
+		switch (m_components[j]->get_cov_type())
 		{
-			cov_sum = SGMatrix<float64_t>(1, 1);
-			linalg::zero(cov_sum);
+			case FULL:
+				scatters[j]=MatrixXd::Zero(num_dim, num_dim);
+				break;
+			case DIAG:
+				scatters[j]=MatrixXd::Zero(num_dim, 1);
+				break;
+			case SPHERICAL:
+				scatters[j]=MatrixXd::Zero(1, 1);
+				break;
 		}
+	}
+#pragma omp parallel
+	{
+		vector<MatrixXd> local_scatters(num_components);
+		for (index_t j=0; j<num_components; j++)
+			local_scatters[j]=MatrixXd::Zero(scatters[j].rows(), scatters[j].cols());
 
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		MatrixXd centered;
+#pragma omp for
+		for (index_t b=0; b<num_blocks; b++)
 		{
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-
-			linalg::add(v, mean_sum, v, 1.0, -1.0);
-			switch (cov_type)
+			const index_t begin=b*block_size;
+			const index_t len=std::min(block_size, num_vectors-begin);
+			for (index_t j=0; j<num_components; j++)
 			{
-				case FULL:
-				    linalg::rank_update(
-				        cov_sum, v, alpha.matrix[j * alpha.num_cols + i]);
-				    break;
-			    case DIAG:
-			    {
-				    auto temp_matrix = SGMatrix<float64_t>(v.vector, 1, v.vlen);
-				    auto temp_result = linalg::matrix_prod(
-				        temp_matrix, temp_matrix, true, false);
-				    cov_sum = temp_result.get_diagonal_vector().clone();
-				    linalg::scale(
-				        cov_sum, cov_sum, alpha.matrix[j * alpha.num_cols + i]);
-			    }
-
-			    break;
-			    case SPHERICAL:
-				    float64_t temp = 0;
-
-				    temp = linalg::dot(v, v);
-
-				    cov_sum(0, 0) +=
-				        temp * alpha.matrix[j * alpha.num_cols + i];
-				    break;
+				auto w=posteriors.row(j).segment(begin, len).array();
+				centered=X.middleCols(begin, len).colwise()-means.col(j);
+				switch (m_components[j]->get_cov_type())
+				{
+					case FULL:
+						local_scatters[j].noalias()+=
+							(centered.array().rowwise()*w).matrix()*
+							centered.transpose();
+						break;
+					case DIAG:
+						local_scatters[j]+=(centered.array().square().rowwise()*w)
+							.rowwise().sum().matrix();
+						break;
+					case SPHERICAL:
+						local_scatters[j](0, 0)+=
+							(centered.colwise().squaredNorm().array()*w).sum();
+						break;
+				}
 			}
 		}
+#pragma omp critical
+		for (index_t j=0; j<num_components; j++)
+			scatters[j]+=local_scatters[j];
+	}
 
-		switch (cov_type)
+	for (index_t j=0; j<num_components; j++)
+	{
+		SGVector<float64_t> mean(num_dim);
+		Map<VectorXd>(mean.vector, num_dim)=means.col(j);
+		m_components[j]->set_mean(mean);
+
+		switch (m_components[j]->get_cov_type())
 		{
 			case FULL:
-		    {
-			    linalg::scale(cov_sum, cov_sum, 1.0 / alpha_sum);
+			{
+				SGMatrix<float64_t> cov_sum(num_dim, num_dim);
+				Map<MatrixXd>(cov_sum.matrix, num_dim, num_dim)=
+					scatters[j]/weights[j];
 
-			    SGVector<float64_t> d0(num_dim);
-			    linalg::eigen_solver_symmetric(cov_sum, d0, cov_sum);
+				SGVector<float64_t> d0(num_dim);
+				linalg::eigen_solver_symmetric(cov_sum, d0, cov_sum);
 
-			    for (auto& v: d0)
-				    v = Math::max(min_cov, v);
+				for (auto& v: d0)
+					v = Math::max(min_cov, v);
 
-			    m_components[i]->set_d(d0);
-			    m_components[i]->set_u(cov_sum);
+				m_components[j]->set_d(d0);
+				m_components[j]->set_u(cov_sum);
 
-			    break;
-		    }
-		    case DIAG:
-			    for (int32_t j = 0; j < num_dim; j++)
-			    {
-				    cov_sum(0, j) /= alpha_sum;
-				    cov_sum(0, j) = Math::max(min_cov, cov_sum(0, j));
-			    }
+				break;
+			}
+			case DIAG:
+			{
+				SGVector<float64_t> d0(num_dim);
+				for (index_t k = 0; k < num_dim; k++)
+					d0[k] = Math::max(min_cov, scatters[j](k, 0) / weights[j]);
 
-			    m_components[i]->set_d(cov_sum.get_row_vector(0));
+				m_components[j]->set_d(d0);
 
-			    break;
-		    case SPHERICAL:
-			    cov_sum[0] /= alpha_sum * num_dim;
-			    cov_sum[0] = Math::max(min_cov, cov_sum[0]);
+				break;
+			}
+			case SPHERICAL:
+			{
+				SGVector<float64_t> d0(1);
+				d0[0] = Math::max(
+					min_cov, scatters[j](0, 0) / (weights[j] * num_dim));
 
-			    m_components[i]->set_d(cov_sum.get_row_vector(0));
+				m_components[j]->set_d(d0);
 
-			    break;
+				break;
+			}
 		}
 
-		m_coefficients.vector[i]=alpha_sum;
-		alpha_sum_sum+=alpha_sum;
+		m_coefficients.vector[j]=weights[j];
 	}
 
-	linalg::scale(m_coefficients, m_coefficients, 1.0 / alpha_sum_sum);
+	linalg::scale(m_coefficients, m_coefficients, 1.0 / weights.sum());
 }
 
 int32_t GMM::get_num_model_parameters()
@@ -9,23 +9,212 @@
 #include <shogun/base/progress.h>
 #include <shogun/clustering/Hierarchical.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
 #include <utility>
 
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct pair
+namespace
 {
-	/** index 1 */
-	int32_t idx1;
-	/** index 2 */
-	int32_t idx2;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
+	/* Lance-Williams update of the linkage distance of cluster k to the
+	 * union of clusters a and b */
+	float64_t lance_williams(
+		EHierarchicalLinkage linkage, float64_t d_ka, float64_t d_kb,
+		float64_t d_ab, float64_t n_a, float64_t n_b, float64_t n_k)
+	{
+		switch (linkage)
+		{
+		case LINKAGE_SINGLE:
+			return std::min(d_ka, d_kb);
+		case LINKAGE_COMPLETE:
+			return std::max(d_ka, d_kb);
+		case LINKAGE_AVERAGE:
+			return (n_a*d_ka+n_b*d_kb)/(n_a+n_b);
+		case LINKAGE_WARD:
+			return std::sqrt(std::max(
+				((n_a+n_k)*d_ka*d_ka+(n_b+n_k)*d_kb*d_kb-n_k*d_ab*d_ab)/
+				(n_a+n_b+n_k), 0.0));
+		}
+
+		return 0;
+	}
+
+	/* linkage distances in a condensed distance matrix */
+	class CondensedLinkage
+	{
+	public:
+		CondensedLinkage(index_t num, EHierarchicalLinkage linkage)
+			: m_num(num), m_linkage(linkage),
+			  m_dists(int64_t(num)*(num-1)/2), m_sizes(num, 1.0)
+		{
+		}
+
+		float64_t& at(index_t a, index_t b)
+		{
+			if (a>b)
+				std::swap(a, b);
+			return m_dists[int64_t(a)*(2*m_num-a-1)/2+(b-a-1)];
+		}
+
+		float64_t distance(index_t a, index_t b)
+		{
+			return at(a, b);
+		}
+
+		/* merge cluster b into cluster a */
+		void merge(index_t a, index_t b, float64_t d_ab,
+			const std::vector<index_t>& active)
+		{
+			const index_t num_active=active.size();
+#pragma omp parallel for if (num_active>1024)
+			for (index_t p=0; p<num_active; p++)
+			{
+				const index_t c=active[p];
+				if (c==a || c==b)
+					continue;
+
+				at(a, c)=lance_williams(m_linkage, at(c, a), at(c, b), d_ab,
+					m_sizes[a], m_sizes[b], m_sizes[c]);
+			}
+			m_sizes[a]+=m_sizes[b];
+		}
+
+	private:
+		index_t m_num;
+		EHierarchicalLinkage m_linkage;
+		std::vector<float64_t> m_dists;
+		std::vector<float64_t> m_sizes;
+	};
+
+	/* Ward linkage distances computed from cluster centroids, in the same
+	 * scale as the Lance-Williams update, i.e. the Euclidean distance for
+	 * two singletons */
+	class CentroidWardLinkage
+	{
+	public:
+		CentroidWardLinkage(SGMatrix<float64_t> centroids)
+			: m_centroids(centroids), m_sizes(centroids.num_cols, 1.0)
+		{
+		}
+
+		float64_t distance(index_t a, index_t b)
+		{
+			const float64_t* c_a=m_centroids.get_column_vector(a);
+			const float64_t* c_b=m_centroids.get_column_vector(b);
+			float64_t sq=0;
+			for (index_t d=0; d<m_centroids.num_rows; d++)
+				sq+=Math::sq(c_a[d]-c_b[d]);
+
+			return std::sqrt(
+				2*m_sizes[a]*m_sizes[b]/(m_sizes[a]+m_sizes[b])*sq);
+		}
+
+		/* merge cluster b into cluster a */
+		void merge(index_t a, index_t b, float64_t, const std::vector<index_t>&)
+		{
+			float64_t* c_a=m_centroids.get_column_vector(a);
+			const float64_t* c_b=m_centroids.get_column_vector(b);
+			const float64_t n=m_sizes[a]+m_sizes[b];
+			for (index_t d=0; d<m_centroids.num_rows; d++)
+				c_a[d]=(m_sizes[a]*c_a[d]+m_sizes[b]*c_b[d])/n;
+			m_sizes[a]=n;
+		}
+
+	private:
+		SGMatrix<float64_t> m_centroids;
+		std::vector<float64_t> m_sizes;
+	};
+
+	struct NearestCluster
+	{
+		float64_t dist;
+		index_t idx;
+	};
+
+	/* Nearest-neighbour chain algorithm for a reducible linkage, the merges
+	 * are found in arbitrary order */
+	template <class Linkage, class Merge>
+	std::vector<Merge> nearest_neighbour_chain(index_t num, Linkage& linkage)
+	{
+		std::vector<index_t> active(num);
+		std::iota(active.begin(), active.end(), 0);
+		std::vector<index_t> position(num);
+		std::iota(position.begin(), position.end(), 0);
+		std::vector<index_t> chain;
+		chain.reserve(num);
+		std::vector<Merge> result;
+		result.reserve(num-1);
+
+		while (active.size()>1)
+		{
+			if (chain.empty())
+				chain.push_back(active[0]);
+
+			const index_t a=chain.back();
+			const index_t prev=chain.size()>1 ? chain[chain.size()-2] : -1;
+
+			/* the previous element of the chain wins ties, so that the chain
+			 * cannot cycle, other ties go to the smallest index */
+			NearestCluster nearest={std::numeric_limits<float64_t>::infinity(), -1};
+			if (prev>=0)
+				nearest={linkage.distance(a, prev), prev};
+
+			const index_t num_active=active.size();
+#pragma omp parallel if (num_active>1024)
+			{
+				NearestCluster local=nearest;
+#pragma omp for nowait
+				for (index_t p=0; p<num_active; p++)
+				{
+					const index_t c=active[p];
+					if (c==a || c==prev)
+						continue;
+
+					const float64_t d=linkage.distance(a, c);
+					if (d<local.dist ||
+						(d==local.dist && local.idx!=prev && c<local.idx))
+						local={d, c};
+				}
+#pragma omp critical
+				{
+					if (local.dist<nearest.dist ||
+						(local.dist==nearest.dist && nearest.idx!=prev &&
+						 local.idx<nearest.idx))
+						nearest=local;
+				}
+			}
+
+			if (nearest.idx!=prev)
+			{
+				chain.push_back(nearest.idx);
+				continue;
+			}
+
+			/* a and prev are reciprocal nearest neighbours */
+			chain.pop_back();
+			chain.pop_back();
+			const index_t keep=std::min(a, prev);
+			const index_t drop=std::max(a, prev);
+			result.push_back({keep, drop, nearest.dist});
+			linkage.merge(keep, drop, nearest.dist, active);
+
+			const index_t last=active.back();
+			active[position[drop]]=last;
+			position[last]=position[drop];
+			active.pop_back();
+		}
+
+		return result;
+	}
+}
 
 Hierarchical::Hierarchical()
 : DistanceMachine()
@@ -54,6 +243,8 @@ void Hierarchical::init()
 	pairs_len = 0;
 	merge_distance = NULL;
 	merge_distance_len = 0;
+	linkage = LINKAGE_SINGLE;
+	precompute_distances = true;
 }
 
 void Hierarchical::register_parameters()
@@ -64,6 +255,15 @@ void Hierarchical::register_parameters()
 	watch_param("table_size", &table_size);
 	watch_param("pairs", &pairs, &pairs_len);
 	watch_param("merge_distance", &merge_distance, &merge_distance_len);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&linkage, "linkage", "Linkage criterion",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(
+	        LINKAGE_SINGLE, LINKAGE_COMPLETE, LINKAGE_AVERAGE, LINKAGE_WARD));
+	SG_ADD(
+	    &precompute_distances, "precompute_distances",
+	    "Whether the distance matrix is precomputed",
+	    ParameterProperties::SETTING);
 }
 
 Hierarchical::~Hierarchical()
@@ -91,7 +291,122 @@ bool Hierarchical::train_machine(std::shared_ptr<Features> data)
 	int32_t num=lhs->get_num_vectors();
 	ASSERT(num>0)
 
-	const int32_t num_pairs=num*(num-1)/2;
+	std::vector<Merge> result;
+	if (precompute_distances)
+		result=merges_precomputed(num);
+	else if (linkage==LINKAGE_SINGLE)
+		result=merges_single_on_demand(num);
+	else if (linkage==LINKAGE_WARD)
+		result=merges_ward_on_demand(num);
+	else
+		error("Complete and average linkage require precomputed distances");
+
+	store_merges(num, result);
+	ASSERT(table_size>0)
+
+	return true;
+}
+
+std::vector<Hierarchical::Merge> Hierarchical::merges_precomputed(index_t num)
+{
+	CondensedLinkage condensed(num, linkage);
+
+	// distances of a block of rows to all later vectors at once
+	const index_t block_size=128;
+	const index_t num_blocks=(num+block_size-1)/block_size;
+	for (auto block : SG_PROGRESS(range(num_blocks)))
+	{
+		const index_t begin=block*block_size;
+		SGVector<index_t> row_idx(Math::min(block_size, num-begin));
+		row_idx.range_fill(begin);
+		SGVector<index_t> col_idx(num-begin);
+		col_idx.range_fill(begin);
+		auto block_dists=distance->get_distance_block(row_idx, col_idx);
+
+		for (index_t i=0; i<row_idx.vlen; i++)
+		{
+			for (index_t j=i+1; j<col_idx.vlen; j++)
+				condensed.at(begin+i, begin+j)=block_dists(i, j);
+		}
+	}
+
+	return nearest_neighbour_chain<CondensedLinkage, Merge>(num, condensed);
+}
+
+std::vector<Hierarchical::Merge> Hierarchical::merges_single_on_demand(index_t num)
+{
+	// distance of each vector outside the tree to the tree
+	std::vector<float64_t> min_dist(num, std::numeric_limits<float64_t>::infinity());
+	std::vector<index_t> parent(num, 0);
+	std::vector<bool> in_tree(num, false);
+	std::vector<Merge> result;
+	result.reserve(num-1);
+
+	index_t current=0;
+	in_tree[0]=true;
+	for (auto step : SG_PROGRESS(range(1, num)))
+	{
+		(void)step;
+		NearestCluster nearest={std::numeric_limits<float64_t>::infinity(), -1};
+#pragma omp parallel
+		{
+			NearestCluster local=nearest;
+#pragma omp for nowait
+			for (index_t j=0; j<num; j++)
+			{
+				if (in_tree[j])
+					continue;
+
+				const float64_t d=distance->distance(current, j);
+				if (d<min_dist[j])
+				{
+					min_dist[j]=d;
+					parent[j]=current;
+				}
+				if (min_dist[j]<local.dist || local.idx<0)
+					local={min_dist[j], j};
+			}
+#pragma omp critical
+			{
+				if (local.idx>=0 && (nearest.idx<0 || local.dist<nearest.dist ||
+					(local.dist==nearest.dist && local.idx<nearest.idx)))
+					nearest=local;
+			}
+		}
+
+		current=nearest.idx;
+		in_tree[current]=true;
+		result.push_back({parent[current], current, nearest.dist});
+	}
+
+	return result;
+}
+
+std::vector<Hierarchical::Merge> Hierarchical::merges_ward_on_demand(index_t num)
+{
+	require(distance->get_distance_type()==D_EUCLIDEAN,
+		"Ward linkage without precomputed distances requires EuclideanDistance");
+	auto lhs=distance->get_lhs();
+	require(lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL,
+		"Ward linkage without precomputed distances requires dense real features");
+	auto features=lhs->as<DenseFeatures<float64_t>>();
+
+	SGMatrix<float64_t> centroids(features->get_num_features(), num);
+	for (index_t i=0; i<num; i++)
+	{
+		auto vec=features->get_feature_vector(i);
+		std::copy_n(vec.vector, vec.vlen, centroids.get_column_vector(i));
+		features->free_feature_vector(vec, i);
+	}
+
+	CentroidWardLinkage ward(centroids);
+	return nearest_neighbour_chain<CentroidWardLinkage, Merge>(num, ward);
+}
+
+void Hierarchical::store_merges(index_t num, std::vector<Merge>& result)
+{
+	std::stable_sort(result.begin(), result.end(),
+		[](const Merge& a, const Merge& b) { return a.dist<b.dist; });
 
 	SG_FREE(merge_distance);
 	merge_distance=SG_MALLOC(float64_t, num);
@@ -101,82 +416,52 @@ bool Hierarchical::train_machine(std::shared_ptr<Features> data)
 	SG_FREE(assignment);
 	assignment=SG_MALLOC(int32_t, num);
 	assignment_len = num;
-	SGVector<int32_t>::range_fill_vector(assignment, num);
 
 	SG_FREE(pairs);
 	pairs=SG_MALLOC(int32_t, 2*num);
+	pairs_len=2*num;
 	SGVector<int32_t>::fill_vector(pairs, 2*num, -1);
 
-	pair* index=SG_MALLOC(pair, num_pairs);
-	float64_t* distances=SG_MALLOC(float64_t, num_pairs);
+	// merge until fewer than merges clusters are left
+	const index_t num_merges=Math::min(num-1, num-merges+1);
 
-	int32_t offs=0;
-	for (auto i : SG_PROGRESS(range(0, num)))
-	{
-		for (int32_t j=i+1; j<num; j++)
+	// union-find over the vectors, label holds the cluster id of a root
+	std::vector<index_t> root(num);
+	std::iota(root.begin(), root.end(), 0);
+	std::vector<int32_t> label(num);
+	std::iota(label.begin(), label.end(), 0);
+	auto find=[&root](index_t i) {
+		while (root[i]!=i)
 		{
-			distances[offs] = distance->distance(i, j);
-			index[offs].idx1 = i;
-			index[offs].idx2 = j;
-			offs++; // offs=i*(i+1)/2+j
+			root[i]=root[root[i]];
+			i=root[i];
 		}
-	}
-
-	Math::qsort_index<float64_t,pair>(distances, index, (num-1)*num/2);
-	//Math::display_vector(distances, (num-1)*num/2, "dists");
+		return i;
+	};
 
-	auto pb = SG_PROGRESS(range(0, num_pairs - 1));
-	int32_t k=-1;
-	int32_t l=0;
-	for (; l<num && (num-l)>=merges && k<num_pairs-1; l++)
+	index_t l=0;
+	for (; l<num_merges; l++)
 	{
-		while (k<num_pairs-1)
-		{
-			k++;
-
-			int32_t i=index[k].idx1;
-			int32_t j=index[k].idx2;
-			int32_t c1=assignment[i];
-			int32_t c2=assignment[j];
-
-			if (c1==c2)
-				continue;
+		const index_t r1=find(result[l].first);
+		const index_t r2=find(result[l].second);
+		const int32_t c1=label[r1];
+		const int32_t c2=label[r2];
 
-			pb.print_progress();
+		pairs[2*l]=Math::min(c1, c2);
+		pairs[2*l+1]=Math::max(c1, c2);
+		merge_distance[l]=result[l].dist;
 
-			if (c1<c2)
-			{
-				pairs[2*l]=c1;
-				pairs[2*l+1]=c2;
-			}
-			else
-			{
-				pairs[2*l]=c2;
-				pairs[2*l+1]=c1;
-			}
-			merge_distance[l]=distances[k];
-
-			int32_t c=num+l;
-			for (int32_t m=0; m<num; m++)
-			{
-				if (assignment[m] == c1 || assignment[m] == c2)
-					assignment[m] = c;
-			}
+		root[r2]=r1;
+		label[r1]=num+l;
 #ifdef DEBUG_HIERARCHICAL
-			io::print("l={:04} i={:04d} j={:04d} c1={:+04} c2={:+04d} c={:+04d} dist={:6.6f}\n", l,i,j, c1,c2,c, merge_distance[l]);
+		io::print("l={:04} c1={:+04} c2={:+04d} c={:+04d} dist={:6.6f}\n", l, c1, c2, num+l, merge_distance[l]);
 #endif
-			break;
-		}
 	}
-	pb.complete();
-
-	table_size=l-1;
-	ASSERT(table_size>0)
-	SG_FREE(distances);
-	SG_FREE(index);
 
+	for (index_t m=0; m<num; m++)
+		assignment[m]=label[find(m)];
 
-	return true;
+	table_size=l-1;
 }
 
 bool Hierarchical::load(FILE* srcfile)
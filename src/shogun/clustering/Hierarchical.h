@@ -15,23 +15,50 @@
 #include <shogun/distance/Distance.h>
 #include <shogun/machine/DistanceMachine.h>
 
+#include <vector>
+
 namespace shogun
 {
 class DistanceMachine;
 
-/** @brief Agglomerative hierarchical single linkage clustering.
+/** linkage criterion of hierarchical clustering */
+enum EHierarchicalLinkage
+{
+	/** minimum distance between the elements of two clusters */
+	LINKAGE_SINGLE,
+	/** maximum distance between the elements of two clusters */
+	LINKAGE_COMPLETE,
+	/** average distance between the elements of two clusters */
+	LINKAGE_AVERAGE,
+	/** increase of the within-cluster variance (Euclidean distance only) */
+	LINKAGE_WARD
+};
+
+/** @brief Agglomerative hierarchical clustering.
  *
  * Starting with each object being assigned to its own cluster clusters are
- * iteratively merged.  Here the clusters are merged whose elements have
- * minimum distance, i.e.  the clusters A and B that obtain
+ * iteratively merged.  By default (single linkage) the clusters are merged
+ * whose elements have minimum distance, i.e.  the clusters A and B that
+ * obtain
  *
  * \f[
  * \min\{d({\bf x},{\bf x'}): {\bf x}\in {\cal A},{\bf x'}\in {\cal B}\}
  * \f]
  *
- * are merged.
+ * are merged. Complete, average and Ward linkage are supported as well.
+ *
+ * The merges are found by the nearest-neighbour chain algorithm on the
+ * condensed distance matrix, which takes n(n-1)/2 distances of memory. With
+ * precompute_distances disabled only O(n) memory is used and distances are
+ * evaluated on demand: single linkage then builds the minimum spanning tree
+ * with Prim's algorithm and Ward linkage runs the chain on cluster
+ * centroids (dense real features with EuclideanDistance), complete and
+ * average linkage always need the distance matrix. The nearest neighbour
+ * searches are parallelized. Either way the merges are reported in order of
+ * increasing distance.
  *
- * cf e.g. http://en.wikipedia.org/wiki/Data_clustering*/
+ * cf e.g. http://en.wikipedia.org/wiki/Data_clustering
+ * cf. http://en.wikipedia.org/wiki/Nearest-neighbor_chain_algorithm */
 class Hierarchical : public DistanceMachine
 {
 	public:
@@ -85,6 +112,36 @@ class Hierarchical : public DistanceMachine
 		 */
 		int32_t get_merges();
 
+		/** set linkage criterion
+		 *
+		 * @param l linkage criterion
+		 */
+		inline void set_linkage(EHierarchicalLinkage l)
+		{
+			linkage=l;
+		}
+
+		/** @return linkage criterion */
+		inline EHierarchicalLinkage get_linkage() const
+		{
+			return linkage;
+		}
+
+		/** set whether the distance matrix is precomputed
+		 *
+		 * @param precompute false to evaluate distances on demand
+		 */
+		inline void set_precompute_distances(bool precompute)
+		{
+			precompute_distances=precompute;
+		}
+
+		/** @return whether the distance matrix is precomputed */
+		inline bool get_precompute_distances() const
+		{
+			return precompute_distances;
+		}
+
 		/** get assignment
 		 *
 		 */
@@ -126,6 +183,47 @@ class Hierarchical : public DistanceMachine
 		/** Register all parameters (aka this class' attributes) */
 		void register_parameters();
 
+		/** merge of two clusters, represented by one of their elements */
+		struct Merge
+		{
+			/** element of the first cluster */
+			index_t first;
+			/** element of the second cluster */
+			index_t second;
+			/** linkage distance */
+			float64_t dist;
+		};
+
+		/** nearest-neighbour chain on the condensed distance matrix
+		 *
+		 * @param num number of vectors
+		 * @return all num-1 merges
+		 */
+		std::vector<Merge> merges_precomputed(index_t num);
+
+		/** Prim's minimum spanning tree with on demand distances, equivalent
+		 * to single linkage
+		 *
+		 * @param num number of vectors
+		 * @return all num-1 merges
+		 */
+		std::vector<Merge> merges_single_on_demand(index_t num);
+
+		/** nearest-neighbour chain on cluster centroids for Ward linkage
+		 *
+		 * @param num number of vectors
+		 * @return all num-1 merges
+		 */
+		std::vector<Merge> merges_ward_on_demand(index_t num);
+
+		/** sort the merges by distance and store the first ones in
+		 * assignment, pairs and merge_distance
+		 *
+		 * @param num number of vectors
+		 * @param result all num-1 merges
+		 */
+		void store_merges(index_t num, std::vector<Merge>& result);
+
 	protected:
 		/// the number of merges in hierarchical clustering
 		int32_t merges;
@@ -147,6 +245,12 @@ class Hierarchical : public DistanceMachine
 		/// distance at which pair i/j was added
 		float64_t* merge_distance;
 		int32_t merge_distance_len;
+
+		/// linkage criterion
+		EHierarchicalLinkage linkage;
+
+		/// whether the distance matrix is precomputed
+		bool precompute_distances;
 };
 }
 #endif
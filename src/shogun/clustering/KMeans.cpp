@@ -15,11 +15,99 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 using namespace Eigen;
 using namespace shogun;
 
+namespace
+{
+	/* number of points whose distances to all centers are computed at once */
+	const int32_t block_size=256;
+
+	/* Euclidean distances between all pairs of centers */
+	SGMatrix<float64_t> center_distances(const SGMatrix<float64_t>& centers)
+	{
+		const index_t num_centers=centers.num_cols;
+		SGMatrix<float64_t> result(num_centers, num_centers);
+
+#pragma omp parallel for schedule(dynamic)
+		for (index_t i=0; i<num_centers; i++)
+		{
+			result(i, i)=0;
+			for (index_t j=i+1; j<num_centers; j++)
+			{
+				float64_t sq=0;
+				for (index_t d=0; d<centers.num_rows; d++)
+					sq+=Math::sq(centers(d, i)-centers(d, j));
+				result(i, j)=std::sqrt(sq);
+				result(j, i)=result(i, j);
+			}
+		}
+
+		return result;
+	}
+
+	/* half the distance of each center to its closest other center */
+	SGVector<float64_t> half_separations(const SGMatrix<float64_t>& dists)
+	{
+		SGVector<float64_t> result(dists.num_cols);
+		for (index_t i=0; i<dists.num_cols; i++)
+		{
+			result[i]=std::numeric_limits<float64_t>::infinity();
+			for (index_t j=0; j<dists.num_rows; j++)
+			{
+				if (j!=i)
+					result[i]=std::min(result[i], 0.5*dists(j, i));
+			}
+		}
+
+		return result;
+	}
+
+	/* Euclidean distance each center moved */
+	SGVector<float64_t> center_movements(
+		const SGMatrix<float64_t>& old_centers, const SGMatrix<float64_t>& centers)
+	{
+		SGVector<float64_t> result(centers.num_cols);
+		for (index_t i=0; i<centers.num_cols; i++)
+		{
+			float64_t sq=0;
+			for (index_t d=0; d<centers.num_rows; d++)
+				sq+=Math::sq(centers(d, i)-old_centers(d, i));
+			result[i]=std::sqrt(sq);
+		}
+
+		return result;
+	}
+
+	/* call f(i, dists, row) for every point i, where row is the row of the
+	 * point in the block dists of its distances to all centers */
+	template <class F>
+	void for_each_distance_block(
+		const std::shared_ptr<Distance>& distance, int32_t num_points,
+		int32_t num_centers, F&& f)
+	{
+		SGVector<index_t> center_idx(num_centers);
+		center_idx.range_fill();
+		const int32_t num_blocks=(num_points+block_size-1)/block_size;
+
+#pragma omp parallel for schedule(dynamic)
+		for (int32_t b=0; b<num_blocks; b++)
+		{
+			const int32_t begin=b*block_size;
+			SGVector<index_t> point_idx(std::min(block_size, num_points-begin));
+			point_idx.range_fill(begin);
+			auto dists=distance->get_distance_block(point_idx, center_idx);
+
+			for (int32_t i=begin; i<begin+point_idx.vlen; i++)
+				f(i, dists, i-begin);
+		}
+	}
+}
+
 
 namespace shogun
 {
@@ -73,116 +161,442 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 		auto rhs_mus = std::make_shared<DenseFeatures<float64_t>>(centers.clone());
 		distance->replace_rhs(rhs_mus);
 
+		SGVector<index_t> center_idx(num_centers);
+		center_idx.range_fill();
+		const int32_t num_blocks=(lhs_size+block_size-1)/block_size;
+
 #pragma omp parallel for firstprivate(lhs_size, dim, num_centers) \
 		shared(centers, cluster_assignments, weights_set) \
 		reduction(+:changed) if (!fixed_centers)
 		/* Assigment step : Assign each point to nearest cluster */
-		for (int32_t i=0; i<lhs_size; i++)
+		for (int32_t b=0; b<num_blocks; b++)
 		{
-			const int32_t cluster_assignments_i=cluster_assignments[i];
-			int32_t min_cluster, j;
-			float64_t min_dist, dist;
+			/* distances of a block of points to all centers at once */
+			const int32_t begin=b*block_size;
+			SGVector<index_t> point_idx(std::min(block_size, lhs_size-begin));
+			point_idx.range_fill(begin);
+			auto dists=distance->get_distance_block(point_idx, center_idx);
 
-			min_cluster=0;
-		   	min_dist=distance->distance(i,0);
-			for (j=1; j<num_centers; j++)
+			for (int32_t i=begin; i<begin+point_idx.vlen; i++)
 			{
-				dist=distance->distance(i,j);
-				if (dist<min_dist)
+				const int32_t cluster_assignments_i=cluster_assignments[i];
+				int32_t min_cluster, j;
+				float64_t min_dist, dist;
+
+				min_cluster=0;
+				min_dist=dists(i-begin,0);
+				for (j=1; j<num_centers; j++)
 				{
-					min_dist=dist;
-					min_cluster=j;
+					dist=dists(i-begin,j);
+					if (dist<min_dist)
+					{
+						min_dist=dist;
+						min_cluster=j;
+					}
 				}
-			}
 
-			if (min_cluster!=cluster_assignments_i)
-			{
-				changed++;
+				if (min_cluster!=cluster_assignments_i)
+				{
+					changed++;
 #pragma omp atomic
-				++weights_set[min_cluster];
+					++weights_set[min_cluster];
 #pragma omp atomic
-				--weights_set[cluster_assignments_i];
-
-				if(fixed_centers)
-				{
-					SGVector<float64_t>vec=lhs->get_feature_vector(i);
-					float64_t temp_min = 1.0 / weights_set[min_cluster];
+					--weights_set[cluster_assignments_i];
 
-					/* mu_new = mu_old + (x - mu_old)/(w) */
-					for (j=0; j<dim; j++)
+					if(fixed_centers)
 					{
-						centers(j, min_cluster)+=
-							(vec[j]-centers(j, min_cluster))*temp_min;
-					}
+						SGVector<float64_t>vec=lhs->get_feature_vector(i);
+						float64_t temp_min = 1.0 / weights_set[min_cluster];
 
-					lhs->free_feature_vector(vec, i);
+						/* mu_new = mu_old + (x - mu_old)/(w) */
+						for (j=0; j<dim; j++)
+						{
+							centers(j, min_cluster)+=
+								(vec[j]-centers(j, min_cluster))*temp_min;
+						}
 
-					/* mu_new = mu_old - (x - mu_old)/(w-1) */
-					/* if weights_set(j)~=0 */
-					if (weights_set[cluster_assignments_i]!=0)
-					{
-						float64_t temp_i = 1.0 / weights_set[cluster_assignments_i];
-						SGVector<float64_t>vec1=lhs->get_feature_vector(i);
+						lhs->free_feature_vector(vec, i);
 
-						for (j=0; j<dim; j++)
+						/* mu_new = mu_old - (x - mu_old)/(w-1) */
+						/* if weights_set(j)~=0 */
+						if (weights_set[cluster_assignments_i]!=0)
 						{
-							centers(j, cluster_assignments_i)-=
-								(vec1[j]-centers(j, cluster_assignments_i))*temp_i;
+							float64_t temp_i = 1.0 / weights_set[cluster_assignments_i];
+							SGVector<float64_t>vec1=lhs->get_feature_vector(i);
+
+							for (j=0; j<dim; j++)
+							{
+								centers(j, cluster_assignments_i)-=
+									(vec1[j]-centers(j, cluster_assignments_i))*temp_i;
+							}
+							lhs->free_feature_vector(vec1, i);
 						}
-						lhs->free_feature_vector(vec1, i);
-					}
-					else
-					{
-						centers.get_column(cluster_assignments_i).zero();
+						else
+						{
+							centers.get_column(cluster_assignments_i).zero();
+						}
+
 					}
 
+					cluster_assignments[i] = min_cluster;
 				}
-
-				cluster_assignments[i] = min_cluster;
 			}
 		}
+		if (m_communicator)
+			changed=int32_t(m_communicator->allreduce_sum(float64_t(changed)));
 		if(changed==0)
 			break;
 
 		/* Update Step : Calculate new means */
 		if (!fixed_centers)
+			update_centers(lhs, centers, cluster_assignments, weights_set);
+
+		observe<SGMatrix<float64_t>>(iter, "cluster_centers");
+
+		if (iter%(max_iter/10) == 0)
+			io::info("Iteration[{}/{}]: Assignment of {} patterns changed.", iter, max_iter, changed);
+	}
+	distance->reset_precompute();
+	distance->replace_rhs(rhs_cache);
+
+
+}
+
+void KMeans::Hamerly_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
+{
+	auto lhs =
+		std::dynamic_pointer_cast<DenseFeatures<float64_t>>(distance->get_lhs());
+	int32_t lhs_size=lhs->get_num_vectors();
+	auto rhs_cache = distance->get_rhs();
+
+	SGVector<int32_t> cluster_assignments(lhs_size);
+	SGVector<int64_t> weights_set(num_centers);
+	weights_set.zero();
+	/* upper bound on the distance to the assigned center */
+	SGVector<float64_t> upper(lhs_size);
+	/* lower bound on the distance to all other centers */
+	SGVector<float64_t> lower(lhs_size);
+
+	distance->precompute_lhs();
+	distance->replace_rhs(
+		std::make_shared<DenseFeatures<float64_t>>(centers.clone()));
+
+	/* exhaustive initial assignment */
+	for_each_distance_block(distance, lhs_size, num_centers,
+		[&](int32_t i, const SGMatrix<float64_t>& dists, index_t row) {
+			int32_t min_cluster=0;
+			float64_t min_dist=dists(row, 0);
+			float64_t second_dist=std::numeric_limits<float64_t>::infinity();
+			for (int32_t j=1; j<num_centers; j++)
+			{
+				const float64_t dist=dists(row, j);
+				if (dist<min_dist)
+				{
+					second_dist=min_dist;
+					min_dist=dist;
+					min_cluster=j;
+				}
+				else if (dist<second_dist)
+					second_dist=dist;
+			}
+
+			cluster_assignments[i]=min_cluster;
+			upper[i]=min_dist;
+			lower[i]=second_dist;
+		});
+	for (int32_t i=0; i<lhs_size; i++)
+		++weights_set[cluster_assignments[i]];
+
+	for (auto iter : SG_PROGRESS(range(max_iter)))
+	{
+		if (iter==max_iter-1)
+			io::warn("KMeans clustering has reached maximum number of ( {} ) iterations without having converged. \
+				   	Terminating. ", iter);
+
+		/* Update Step : Calculate new means and move the bounds */
+		SGMatrix<float64_t> old_centers=centers.clone();
+		update_centers(lhs, centers, cluster_assignments, weights_set);
+		auto moved=center_movements(old_centers, centers);
+
+		int32_t max_moved=0;
+		for (int32_t j=1; j<num_centers; j++)
+		{
+			if (moved[j]>moved[max_moved])
+				max_moved=j;
+		}
+		float64_t second_moved=0;
+		for (int32_t j=0; j<num_centers; j++)
 		{
-			centers.zero();
+			if (j!=max_moved)
+				second_moved=std::max(second_moved, moved[j]);
+		}
 
-			for (int32_t i=0; i<lhs_size; i++)
+		distance->replace_rhs(
+			std::make_shared<DenseFeatures<float64_t>>(centers.clone()));
+		auto separations=half_separations(center_distances(centers));
+
+		int32_t changed=0;
+		int64_t num_computed=0;
+#pragma omp parallel for schedule(dynamic, block_size) \
+		reduction(+:changed, num_computed)
+		/* Assigment step : only points whose bounds overlap are checked */
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			const int32_t cluster_assignments_i=cluster_assignments[i];
+			upper[i]+=moved[cluster_assignments_i];
+			lower[i]-=cluster_assignments_i==max_moved ? second_moved : moved[max_moved];
+
+			const float64_t bound=std::max(separations[cluster_assignments_i], lower[i]);
+			if (upper[i]<=bound)
+				continue;
+
+			upper[i]=distance->distance(i, cluster_assignments_i);
+			num_computed++;
+			if (upper[i]<=bound)
+				continue;
+
+			int32_t min_cluster=cluster_assignments_i;
+			float64_t min_dist=upper[i];
+			float64_t second_dist=std::numeric_limits<float64_t>::infinity();
+			for (int32_t j=0; j<num_centers; j++)
 			{
-				int32_t cluster_i=cluster_assignments[i];
+				if (j==cluster_assignments_i)
+					continue;
+
+				const float64_t dist=distance->distance(i, j);
+				num_computed++;
+				if (dist<min_dist)
+				{
+					second_dist=min_dist;
+					min_dist=dist;
+					min_cluster=j;
+				}
+				else if (dist<second_dist)
+					second_dist=dist;
+			}
+			upper[i]=min_dist;
+			lower[i]=second_dist;
+
+			if (min_cluster!=cluster_assignments_i)
+			{
+				changed++;
+#pragma omp atomic
+				++weights_set[min_cluster];
+#pragma omp atomic
+				--weights_set[cluster_assignments_i];
+				cluster_assignments[i]=min_cluster;
+			}
+		}
 
-				auto vec = lhs->get_feature_vector(i);
-				linalg::add_col_vec(centers, cluster_i, vec, centers);
-				lhs->free_feature_vector(vec, i);
+		observe<SGMatrix<float64_t>>(iter, "cluster_centers");
+		SG_DEBUG("Iteration[{}/{}]: {} point-center distances computed.",
+			iter, max_iter, num_computed);
+
+		if (m_communicator)
+			changed=int32_t(m_communicator->allreduce_sum(float64_t(changed)));
+		if (changed==0)
+			break;
+
+		if (iter%(max_iter/10) == 0)
+			io::info("Iteration[{}/{}]: Assignment of {} patterns changed.", iter, max_iter, changed);
+	}
+	distance->reset_precompute();
+	distance->replace_rhs(rhs_cache);
+}
+
+void KMeans::Elkan_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
+{
+	auto lhs =
+		std::dynamic_pointer_cast<DenseFeatures<float64_t>>(distance->get_lhs());
+	int32_t lhs_size=lhs->get_num_vectors();
+	auto rhs_cache = distance->get_rhs();
+
+	SGVector<int32_t> cluster_assignments(lhs_size);
+	SGVector<int64_t> weights_set(num_centers);
+	weights_set.zero();
+	/* upper bound on the distance to the assigned center */
+	SGVector<float64_t> upper(lhs_size);
+	/* lower bounds on the distances to each center, one column per point */
+	SGMatrix<float64_t> lower(num_centers, lhs_size);
+
+	distance->precompute_lhs();
+	distance->replace_rhs(
+		std::make_shared<DenseFeatures<float64_t>>(centers.clone()));
+
+	/* exhaustive initial assignment */
+	for_each_distance_block(distance, lhs_size, num_centers,
+		[&](int32_t i, const SGMatrix<float64_t>& dists, index_t row) {
+			int32_t min_cluster=0;
+			for (int32_t j=0; j<num_centers; j++)
+			{
+				lower(j, i)=dists(row, j);
+				if (lower(j, i)<lower(min_cluster, i))
+					min_cluster=j;
 			}
 
-			for (int32_t i=0; i<num_centers; i++)
+			cluster_assignments[i]=min_cluster;
+			upper[i]=lower(min_cluster, i);
+		});
+	for (int32_t i=0; i<lhs_size; i++)
+		++weights_set[cluster_assignments[i]];
+
+	for (auto iter : SG_PROGRESS(range(max_iter)))
+	{
+		if (iter==max_iter-1)
+			io::warn("KMeans clustering has reached maximum number of ( {} ) iterations without having converged. \
+				   	Terminating. ", iter);
+
+		/* Update Step : Calculate new means */
+		SGMatrix<float64_t> old_centers=centers.clone();
+		update_centers(lhs, centers, cluster_assignments, weights_set);
+		auto moved=center_movements(old_centers, centers);
+
+		distance->replace_rhs(
+			std::make_shared<DenseFeatures<float64_t>>(centers.clone()));
+		auto dists=center_distances(centers);
+		auto separations=half_separations(dists);
+
+		int32_t changed=0;
+		int64_t num_computed=0;
+#pragma omp parallel for schedule(dynamic, block_size) \
+		reduction(+:changed, num_computed)
+		/* Assigment step : only centers whose bounds overlap are checked */
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			const int32_t cluster_assignments_i=cluster_assignments[i];
+			float64_t* lower_i=lower.get_column_vector(i);
+			for (int32_t j=0; j<num_centers; j++)
+				lower_i[j]=std::max(lower_i[j]-moved[j], 0.0);
+			upper[i]+=moved[cluster_assignments_i];
+
+			if (upper[i]<=separations[cluster_assignments_i])
+				continue;
+
+			int32_t min_cluster=cluster_assignments_i;
+			bool tight=false;
+			for (int32_t j=0; j<num_centers; j++)
 			{
-				if (weights_set[i]!=0)
+				if (j==min_cluster || upper[i]<=lower_i[j] ||
+					upper[i]<=0.5*dists(min_cluster, j))
+					continue;
+
+				if (!tight)
 				{
-					auto col = centers.get_column(i);
-					linalg::scale(col, col, 1.0 / weights_set[i]);
+					upper[i]=distance->distance(i, min_cluster);
+					lower_i[min_cluster]=upper[i];
+					num_computed++;
+					tight=true;
+					if (upper[i]<=lower_i[j] || upper[i]<=0.5*dists(min_cluster, j))
+						continue;
 				}
+
+				lower_i[j]=distance->distance(i, j);
+				num_computed++;
+				if (lower_i[j]<upper[i])
+				{
+					min_cluster=j;
+					upper[i]=lower_i[j];
+				}
+			}
+
+			if (min_cluster!=cluster_assignments_i)
+			{
+				changed++;
+#pragma omp atomic
+				++weights_set[min_cluster];
+#pragma omp atomic
+				--weights_set[cluster_assignments_i];
+				cluster_assignments[i]=min_cluster;
 			}
 		}
 
 		observe<SGMatrix<float64_t>>(iter, "cluster_centers");
+		SG_DEBUG("Iteration[{}/{}]: {} point-center distances computed.",
+			iter, max_iter, num_computed);
+
+		if (m_communicator)
+			changed=int32_t(m_communicator->allreduce_sum(float64_t(changed)));
+		if (changed==0)
+			break;
 
 		if (iter%(max_iter/10) == 0)
 			io::info("Iteration[{}/{}]: Assignment of {} patterns changed.", iter, max_iter, changed);
 	}
 	distance->reset_precompute();
 	distance->replace_rhs(rhs_cache);
+}
 
+bool KMeans::can_use_bounds() const
+{
+	if (fixed_centers || distance->get_distance_type()!=D_EUCLIDEAN)
+		return false;
 
+	return !distance->as<EuclideanDistance>()->get_disable_sqrt();
+}
+
+void KMeans::update_centers(
+	const std::shared_ptr<DenseFeatures<float64_t>>& lhs,
+	SGMatrix<float64_t> centers, const SGVector<int32_t>& cluster_assignments,
+	const SGVector<int64_t>& weights_set) const
+{
+	centers.zero();
+
+	for (int32_t i=0; i<cluster_assignments.vlen; i++)
+	{
+		int32_t cluster_i=cluster_assignments[i];
+
+		auto vec = lhs->get_feature_vector(i);
+		linalg::add_col_vec(centers, cluster_i, vec, centers);
+		lhs->free_feature_vector(vec, i);
+	}
+
+	/* sums and counts of the points of all shards, appended to the sums */
+	const int64_t num_sums=int64_t(centers.num_rows)*centers.num_cols;
+	SGVector<float64_t> sums_and_counts(num_sums+centers.num_cols);
+	sg_memcpy(sums_and_counts.vector, centers.matrix, sizeof(float64_t)*num_sums);
+	for (int32_t i=0; i<centers.num_cols; i++)
+		sums_and_counts[num_sums+i]=weights_set[i];
+	if (m_communicator)
+	{
+		m_communicator->allreduce_sum(sums_and_counts);
+		sg_memcpy(centers.matrix, sums_and_counts.vector, sizeof(float64_t)*num_sums);
+	}
+
+	for (int32_t i=0; i<centers.num_cols; i++)
+	{
+		const float64_t count=sums_and_counts[num_sums+i];
+		if (count!=0)
+		{
+			auto col = centers.get_column(i);
+			linalg::scale(col, col, 1.0 / count);
+		}
+	}
 }
 
 bool KMeans::train_machine(std::shared_ptr<Features> data)
 {
 	initialize_training(data);
-	Lloyd_KMeans(cluster_centers, k);
+
+	EKMeansAlgorithm algorithm=m_algorithm;
+	if (algorithm!=KMEANS_LLOYD && !can_use_bounds())
+	{
+		io::warn("Bounds need a Euclidean distance and variable centers, "
+			"falling back to Lloyd's algorithm.");
+		algorithm=KMEANS_LLOYD;
+	}
+
+	switch (algorithm)
+	{
+	case KMEANS_LLOYD:
+		Lloyd_KMeans(cluster_centers, k);
+		break;
+	case KMEANS_HAMERLY:
+		Hamerly_KMeans(cluster_centers, k);
+		break;
+	case KMEANS_ELKAN:
+		Elkan_KMeans(cluster_centers, k);
+		break;
+	}
 	compute_cluster_variances();
 	auto cluster_centres =
 		std::make_shared<DenseFeatures<float64_t>>(cluster_centers);
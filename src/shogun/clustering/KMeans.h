@@ -35,6 +35,11 @@ class KMeansBase;
  *
  * To use mini-batch based training was see KMeansMiniBatch 
  *
+ * Data that is sharded across processes is clustered with a Communicator,
+ * see set_communicator(). The processes compute the sums and counts of the
+ * points of every cluster on their shard, and their allreduce gives all of
+ * them the same centers.
+ *
  * cf. http://en.wikipedia.org/wiki/K-means_algorithm
  * cf. http://en.wikipedia.org/wiki/Lloyd's_algorithm
  *
@@ -82,6 +87,38 @@ class KMeans : public KMeansBase
 		/** Lloyd's KMeans training method
 		 */
 		void Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+		/** Hamerly's KMeans training method, keeps an upper bound on the
+		 * distance to the assigned center and a lower bound on the distance
+		 * to all other centers of each point
+		 */
+		void Hamerly_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+		/** Elkan's KMeans training method, keeps an upper bound on the
+		 * distance to the assigned center and lower bounds on the distances
+		 * to each center of each point
+		 */
+		void Elkan_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+		/** @return whether the triangle inequality holds for the distance
+		 * and Hamerly's or Elkan's algorithm can be used
+		 */
+		bool can_use_bounds() const;
+
+		/** set the centers to the means of their assigned points, centers
+		 * without points are set to zero. The points of all shards are
+		 * averaged if a communicator is set.
+		 *
+		 * @param lhs training data
+		 * @param centers cluster centers
+		 * @param cluster_assignments cluster of each point
+		 * @param weights_set number of points of the shard in each cluster
+		 */
+		void update_centers(
+			const std::shared_ptr<DenseFeatures<float64_t>>& lhs,
+			SGMatrix<float64_t> centers,
+			const SGVector<int32_t>& cluster_assignments,
+			const SGVector<int64_t>& weights_set) const;
 };
 }
 #endif
@@ -5,6 +5,7 @@
  */
 
 #include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/clustering/KMeansBase.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/distance/EuclideanDistance.h>
@@ -15,11 +16,160 @@
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <algorithm>
+#include <limits>
+#include <set>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 using namespace Eigen;
 
+namespace
+{
+	/* number of points whose distances to all centers are computed at once */
+	const int32_t block_size=256;
+
+	/* number of sampling rounds of k-means||, the paper finds that a
+	 * handful of rounds with an oversampling factor of 2k suffice */
+	const int32_t kmeans_parallel_rounds=5;
+
+	/* lower the squared distances of the lhs points of the distance to
+	 * their closest center by the given centers, closest gets the index of
+	 * the closest center unless it is empty */
+	void update_closest(
+		const std::shared_ptr<Distance>& distance,
+		const SGMatrix<float64_t>& centers, SGVector<float64_t>& min_sq_dist,
+		SGVector<int32_t>& closest)
+	{
+		distance->replace_rhs(
+			std::make_shared<DenseFeatures<float64_t>>(centers));
+		SGVector<index_t> center_idx(centers.num_cols);
+		center_idx.range_fill();
+		const int32_t num_points=min_sq_dist.vlen;
+		const int32_t num_blocks=(num_points+block_size-1)/block_size;
+
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (int32_t b=0; b<num_blocks; b++)
+		{
+			const int32_t begin=b*block_size;
+			SGVector<index_t> point_idx(std::min(block_size, num_points-begin));
+			point_idx.range_fill(begin);
+			auto dists=distance->get_distance_block(point_idx, center_idx);
+
+			for (int32_t i=begin; i<begin+point_idx.vlen; i++)
+			{
+				for (index_t j=0; j<centers.num_cols; j++)
+				{
+					const float64_t sq_dist=Math::sq(dists(i-begin, j));
+					if (sq_dist<min_sq_dist[i])
+					{
+						min_sq_dist[i]=sq_dist;
+						if (closest.vlen)
+							closest[i]=j;
+					}
+				}
+			}
+		}
+	}
+
+	/* the feature vectors of the given indices as columns */
+	SGMatrix<float64_t> select_columns(
+		const std::shared_ptr<DenseFeatures<float64_t>>& features,
+		const std::vector<index_t>& indices)
+	{
+		SGMatrix<float64_t> result(features->get_num_features(), indices.size());
+		for (index_t i=0; i<result.num_cols; i++)
+		{
+			auto vec=features->get_feature_vector(indices[i]);
+			sg_memcpy(result.get_column_vector(i), vec.vector,
+				sizeof(float64_t)*result.num_rows);
+			features->free_feature_vector(vec, indices[i]);
+		}
+		return result;
+	}
+
+	/* draw an index with a probability proportional to its weight */
+	template <class PRNG>
+	index_t draw_weighted(const VectorXd& weights, PRNG& prng)
+	{
+		UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+		const float64_t target=uniform(prng)*weights.sum();
+		float64_t cumulative=0;
+		for (index_t i=0; i<weights.size(); i++)
+		{
+			cumulative+=weights[i];
+			if (target<cumulative)
+				return i;
+		}
+
+		/* rounding, the last index with a positive weight */
+		index_t last=weights.size()-1;
+		while (last>0 && weights[last]<=0)
+			last--;
+		return last;
+	}
+
+	/* cluster weighted points into num_centers centers by k-means++ and
+	 * Lloyd iterations under the squared Euclidean distance */
+	template <class PRNG>
+	SGMatrix<float64_t> weighted_kmeans(
+		const SGMatrix<float64_t>& points, const SGVector<float64_t>& weights,
+		int32_t num_centers, int32_t max_iter, PRNG& prng)
+	{
+		const index_t dim=points.num_rows;
+		const index_t num_points=points.num_cols;
+		Map<const MatrixXd> x(points.matrix, dim, num_points);
+		Map<const VectorXd> w(weights.vector, num_points);
+		SGMatrix<float64_t> centers(dim, num_centers);
+		Map<MatrixXd> c(centers.matrix, dim, num_centers);
+
+		c.col(0)=x.col(draw_weighted(w, prng));
+		VectorXd min_sq_dist=
+			(x.colwise()-c.col(0)).colwise().squaredNorm().transpose();
+		for (int32_t j=1; j<num_centers; j++)
+		{
+			/* fewer distinct points than centers repeat a point */
+			const VectorXd p=w.cwiseProduct(min_sq_dist);
+			c.col(j)=x.col(draw_weighted(p.sum()>0 ? p : VectorXd(w), prng));
+			min_sq_dist=min_sq_dist.cwiseMin(
+				(x.colwise()-c.col(j)).colwise().squaredNorm().transpose());
+		}
+
+		SGVector<int32_t> assignments(num_points);
+		assignments.set_const(-1);
+		for (int32_t iter=0; iter<max_iter; iter++)
+		{
+			bool changed=false;
+			for (index_t i=0; i<num_points; i++)
+			{
+				index_t closest;
+				(c.colwise()-x.col(i)).colwise().squaredNorm().minCoeff(&closest);
+				changed|=assignments[i]!=closest;
+				assignments[i]=closest;
+			}
+			if (!changed)
+				break;
+
+			MatrixXd sums=MatrixXd::Zero(dim, num_centers);
+			VectorXd counts=VectorXd::Zero(num_centers);
+			for (index_t i=0; i<num_points; i++)
+			{
+				sums.col(assignments[i])+=w[i]*x.col(i);
+				counts[assignments[i]]+=w[i];
+			}
+			for (int32_t j=0; j<num_centers; j++)
+			{
+				if (counts[j]>0)
+					c.col(j)=sums.col(j)/counts[j];
+			}
+		}
+
+		return centers;
+	}
+}
+
 KMeansBase::KMeansBase()
 : RandomMixin<DistanceMachine>()
 {
@@ -66,6 +216,37 @@ void KMeansBase::set_random_centers()
 		distance->get_lhs()->as<DenseFeatures<float64_t>>();
 	int32_t lhs_size=lhs->get_num_vectors();
 
+	if (m_communicator)
+	{
+		/* k distinct points of the union of the shards, drawn the same
+		 * way on all processes */
+		SGVector<float64_t> sizes(m_communicator->get_size());
+		sizes.zero();
+		sizes[m_communicator->get_rank()]=lhs_size;
+		m_communicator->allreduce_sum(sizes);
+		int64_t offset=0;
+		for (int32_t r=0; r<m_communicator->get_rank(); r++)
+			offset+=sizes[r];
+		const int64_t total=linalg::sum(sizes);
+		require(total>=k, "Expected at least {} vectors, got {}", k, total);
+
+		auto prng=make_shared_streams()(0);
+		UniformIntDistribution<int64_t> uniform_int_dist(0, total-1);
+		std::set<int64_t> drawn;
+		while (drawn.size()<size_t(k))
+			drawn.insert(uniform_int_dist(prng));
+
+		std::vector<index_t> local;
+		for (auto idx : drawn)
+		{
+			if (idx>=offset && idx<offset+lhs_size)
+				local.push_back(idx-offset);
+		}
+		cluster_centers=gather_columns(select_columns(lhs, local));
+		observe<SGMatrix<float64_t>>(0, "cluster_centers");
+		return;
+	}
+
 	SGVector<int32_t> temp=SGVector<int32_t>(lhs_size);
 	SGVector<int32_t>::range_fill_vector(temp, lhs_size, 0);
 	random::shuffle(temp, m_prng);
@@ -157,10 +338,12 @@ void KMeansBase::initialize_training(const std::shared_ptr<Features>& data)
 
 	require(lhs_size>0, "Lhs features should not be empty");
 	require(dimensions>0, "Lhs features should have more than zero dimensions");
+	require(!m_communicator || !fixed_centers,
+		"Fixed centers are not supported on sharded data");
 
 	/* if kmeans++ to be used */
 	if (use_kmeanspp)
-		initial_centers = kmeanspp();
+		initial_centers = m_communicator ? kmeans_parallel() : kmeanspp();
 
 	R=SGVector<float64_t>(k);
 
@@ -169,6 +352,13 @@ void KMeansBase::initialize_training(const std::shared_ptr<Features>& data)
 	if (initial_centers.matrix)
 	{
 		cluster_centers = initial_centers;
+		/* all processes start from the centers of rank 0 */
+		if (m_communicator)
+		{
+			SGVector<float64_t> centers(
+				cluster_centers.matrix, dimensions*k, false);
+			m_communicator->broadcast(centers);
+		}
 		observe<SGMatrix<float64_t>>(0, "cluster_centers");
 	}
 	else
@@ -292,6 +482,124 @@ SGMatrix<float64_t> KMeansBase::kmeanspp()
 	return centers;
 }
 
+SGMatrix<float64_t> KMeansBase::kmeans_parallel()
+{
+	require(m_communicator, "k-means|| needs a communicator");
+	auto lhs=distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	const int32_t lhs_size=lhs->get_num_vectors();
+	auto rhs_cache=distance->get_rhs();
+
+	/* the shared stream makes the same draws on all processes, the
+	 * stream of the rank samples the local points */
+	auto streams=make_shared_streams();
+	auto shared_prng=streams(0);
+	auto local_prng=streams(1+m_communicator->get_rank());
+	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
+
+	/* the first candidate is drawn uniformly from all points, the local
+	 * point of every process is weighted by the size of its shard */
+	SGVector<float64_t> sizes(m_communicator->get_size());
+	sizes.zero();
+	sizes[m_communicator->get_rank()]=lhs_size;
+	m_communicator->allreduce_sum(sizes);
+	UniformIntDistribution<int32_t> uniform_int_dist(0, lhs_size-1);
+	auto first=gather_columns(
+		select_columns(lhs, {uniform_int_dist(local_prng)}));
+	Map<VectorXd> shard_sizes(sizes.vector, sizes.vlen);
+	const index_t first_rank=draw_weighted(VectorXd(shard_sizes), shared_prng);
+	SGMatrix<float64_t> candidates(dimensions, 1);
+	sg_memcpy(candidates.matrix, first.get_column_vector(first_rank),
+		sizeof(float64_t)*dimensions);
+
+	SGVector<float64_t> min_sq_dist(lhs_size);
+	min_sq_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	SGVector<int32_t> no_closest;
+	update_closest(distance, candidates, min_sq_dist, no_closest);
+
+	const float64_t oversampling=2.0*k;
+	for (int32_t round=0; round<kmeans_parallel_rounds; round++)
+	{
+		const float64_t cost=
+			m_communicator->allreduce_sum(linalg::sum(min_sq_dist));
+		if (cost<=0)
+			break;
+
+		std::vector<index_t> sampled;
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			if (uniform_real_dist(local_prng)<oversampling*min_sq_dist[i]/cost)
+				sampled.push_back(i);
+		}
+
+		auto new_candidates=gather_columns(select_columns(lhs, sampled));
+		if (!new_candidates.num_cols)
+			continue;
+		update_closest(distance, new_candidates, min_sq_dist, no_closest);
+
+		SGMatrix<float64_t> all(dimensions, candidates.num_cols+new_candidates.num_cols);
+		sg_memcpy(all.matrix, candidates.matrix,
+			sizeof(float64_t)*candidates.num_rows*candidates.num_cols);
+		sg_memcpy(all.get_column_vector(candidates.num_cols), new_candidates.matrix,
+			sizeof(float64_t)*new_candidates.num_rows*new_candidates.num_cols);
+		candidates=all;
+	}
+
+	/* weight of a candidate: the number of points closest to it */
+	SGVector<int32_t> closest(lhs_size);
+	closest.zero();
+	min_sq_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	update_closest(distance, candidates, min_sq_dist, closest);
+	SGVector<float64_t> weights(candidates.num_cols);
+	weights.zero();
+	for (int32_t i=0; i<lhs_size; i++)
+		weights[closest[i]]+=1;
+	m_communicator->allreduce_sum(weights);
+
+	distance->replace_rhs(rhs_cache);
+	io::info("k-means|| reduces {} candidates to {} centers",
+		candidates.num_cols, k);
+
+	return weighted_kmeans(candidates, weights, k, max_iter, shared_prng);
+}
+
+random::RandomStreams KMeansBase::make_shared_streams() const
+{
+	/* the key of rank 0, sent in two halves that doubles represent exactly */
+	const uint64_t key=make_streams().get_key();
+	SGVector<float64_t> halves(2);
+	halves[0]=float64_t(key>>32);
+	halves[1]=float64_t(key&0xFFFFFFFF);
+	m_communicator->broadcast(halves);
+	return random::RandomStreams(
+		(uint64_t(halves[0])<<32) | uint64_t(halves[1]));
+}
+
+SGMatrix<float64_t> KMeansBase::gather_columns(const SGMatrix<float64_t>& local) const
+{
+	const int32_t rank=m_communicator->get_rank();
+	SGVector<float64_t> sizes(m_communicator->get_size());
+	sizes.zero();
+	sizes[rank]=local.num_cols;
+	m_communicator->allreduce_sum(sizes);
+
+	index_t offset=0;
+	for (int32_t r=0; r<rank; r++)
+		offset+=sizes[r];
+	const index_t total=linalg::sum(sizes);
+
+	/* every process fills its own range, the sum adds only zeros to it */
+	SGMatrix<float64_t> result(dimensions, total);
+	result.zero();
+	if (local.num_cols)
+	{
+		sg_memcpy(result.get_column_vector(offset), local.matrix,
+			sizeof(float64_t)*local.num_rows*local.num_cols);
+	}
+	SGVector<float64_t> data(result.matrix, dimensions*total, false);
+	m_communicator->allreduce_sum(data);
+	return result;
+}
+
 void KMeansBase::init()
 {
 	max_iter = 300;
@@ -300,6 +608,7 @@ void KMeansBase::init()
 	fixed_centers = false;
 	use_kmeanspp = false;
 	initial_centers = SGMatrix<float64_t>();
+	m_algorithm = KMEANS_LLOYD;
 	SG_ADD(
 	    &max_iter, "max_iter", "Maximum number of iterations",
 	    ParameterProperties::HYPER);
@@ -317,6 +626,13 @@ void KMeansBase::init()
 	SG_ADD(
 	    &use_kmeanspp, "kmeanspp", "Whether to use kmeans++",
 	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_algorithm, "algorithm", "Training algorithm",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(KMEANS_LLOYD, KMEANS_HAMERLY, KMEANS_ELKAN));
+	SG_ADD(
+	    &m_communicator, "communicator",
+	    "Communicator for sharded training data.");
 	watch_method("cluster_centers", &KMeansBase::get_cluster_centers);
 	SG_ADD(
 	    &initial_centers, "initial_centers", "Initial centers",
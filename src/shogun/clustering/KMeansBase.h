@@ -13,6 +13,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/lib/Communicator.h>
 #include <shogun/machine/DistanceMachine.h>
 #include <shogun/mathematics/RandomMixin.h>
 
@@ -21,6 +22,19 @@ namespace shogun
 {
 class DistanceMachine;
 
+/** algorithm used to train KMeans */
+enum EKMeansAlgorithm
+{
+	/** Lloyd's algorithm, all point-center distances in every iteration */
+	KMEANS_LLOYD,
+	/** Hamerly's algorithm, one upper and one lower bound per point */
+	KMEANS_HAMERLY,
+	/** Elkan's algorithm, one upper bound per point and one lower bound per
+	 * point and center
+	 */
+	KMEANS_ELKAN
+};
+
 /**
   Base Class for different KMeans clustering implementations.
   */
@@ -85,6 +99,52 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 		 */
 		virtual void set_initial_centers(SGMatrix<float64_t> centers);
 
+		/** set the training algorithm
+		 *
+		 * Hamerly's and Elkan's algorithm give the same result as Lloyd's
+		 * algorithm, but use the triangle inequality to skip most distance
+		 * computations. They require a Euclidean distance that does not
+		 * disable the square root and variable centers; Lloyd's algorithm is
+		 * used otherwise. Elkan's algorithm skips more computations but
+		 * needs memory for k bounds per point, Hamerly's algorithm is
+		 * preferable for large k.
+		 *
+		 * @param algorithm training algorithm
+		 */
+		void set_algorithm(EKMeansAlgorithm algorithm)
+		{
+			m_algorithm=algorithm;
+		}
+
+		/** @return training algorithm */
+		EKMeansAlgorithm get_algorithm() const
+		{
+			return m_algorithm;
+		}
+
+		/** set the communicator to cluster data that is sharded across
+		 * processes, nullptr clusters the local data only
+		 *
+		 * Every process holds a shard of the data and calls train() with
+		 * the same communicator and parameters. The processes share the
+		 * sums and counts of the points of every cluster, so all of them
+		 * end with the same centers of the union of the shards. KMeans++
+		 * is replaced by the distributed k-means|| initialization, see
+		 * kmeans_parallel(). Fixed centers are not supported.
+		 *
+		 * @param communicator communicator of the processes
+		 */
+		void set_communicator(std::shared_ptr<Communicator> communicator)
+		{
+			m_communicator=std::move(communicator);
+		}
+
+		/** @return communicator of the processes */
+		std::shared_ptr<Communicator> get_communicator() const
+		{
+			return m_communicator;
+		}
+
 		bool train_require_labels() const override
 		{
 			return false;
@@ -100,6 +160,23 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 		*/
 		SGMatrix<float64_t> kmeanspp();
 
+		/** k-means|| algorithm to initialize cluster centers on data that
+		 * is sharded across the processes of the communicator
+		 *
+		 * Bahmani, Moseley, Vattani, Kumar and Vassilvitskii, "Scalable
+		 * K-Means++", VLDB 2012
+		 *
+		 * Every round samples each point independently with a probability
+		 * proportional to its squared distance to the candidates, about 2k
+		 * points in total. The candidates are weighted by the number of
+		 * points closest to them and reduced to k centers by weighted
+		 * k-means++ and Lloyd iterations, which every process computes
+		 * identically.
+		 *
+		 * @return initial cluster centers: matrix (k columns, dim rows)
+		 */
+		SGMatrix<float64_t> kmeans_parallel();
+
 		/**
 		 * Init the model (register params)
 		 */
@@ -113,6 +190,18 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 
 		void compute_cluster_variances();
 
+		/** random streams with a key that is the same on all processes of
+		 * the communicator
+		 */
+		random::RandomStreams make_shared_streams() const;
+
+		/** @return the columns of all processes, in the order of the
+		 * ranks
+		 *
+		 * @param local columns of this process
+		 */
+		SGMatrix<float64_t> gather_columns(const SGMatrix<float64_t>& local) const;
+
 	protected:
 		/** Maximum number of iterations */
 		int32_t max_iter;
@@ -137,6 +226,12 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 
 		/** Cluster centers */
 		SGMatrix<float64_t> cluster_centers;
+
+		/** Training algorithm */
+		EKMeansAlgorithm m_algorithm;
+
+		/** communicator for sharded data */
+		std::shared_ptr<Communicator> m_communicator;
 };
 }
 #endif
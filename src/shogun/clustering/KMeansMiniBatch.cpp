@@ -12,9 +12,13 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+#include <limits>
 #include <utility>
+#include <vector>
 
 #ifdef _WIN32
 #undef far
@@ -23,6 +27,17 @@
 
 using namespace shogun;
 
+namespace
+{
+	float64_t sq_distance(const float64_t* a, const float64_t* b, index_t dim)
+	{
+		float64_t result=0;
+		for (index_t i=0; i<dim; i++)
+			result+=Math::sq(a[i]-b[i]);
+		return result;
+	}
+}
+
 namespace shogun
 {
 KMeansMiniBatch::KMeansMiniBatch():KMeansBase()
@@ -90,6 +105,306 @@ void KMeansMiniBatch::minibatch_KMeans()
 	distance->replace_rhs(rhs_cache);
 }
 
+void KMeansMiniBatch::minibatch_KMeans_streaming(
+	const std::shared_ptr<StreamingDenseFeatures<float64_t>>& data)
+{
+	require(batch_size>0,
+		"batch size not set to positive value. Current batch size {} ", batch_size);
+	require(num_passes>0,
+		"number of passes not set to positive value. Current passes {} ", num_passes);
+
+	data->start_parser();
+
+	/* the first examples initialize the centers */
+	dimensions=0;
+	auto sample=read_batch(data, std::max({init_sample_size, batch_size, k}));
+	require(sample.num_cols>=k,
+		"Stream contains {} examples only, at least k ({}) are required",
+		sample.num_cols, k);
+	dimensions=sample.num_rows;
+
+	if (initial_centers.matrix)
+	{
+		require(initial_centers.num_rows==dimensions && initial_centers.num_cols==k,
+			"Initial centers must be a {}x{} matrix", dimensions, k);
+		cluster_centers=initial_centers.clone();
+	}
+	else
+		cluster_centers=kmeans_parallel(sample);
+	observe<SGMatrix<float64_t>>(0, "cluster_centers");
+
+	SGVector<float64_t> counts(k);
+	counts.zero();
+	int32_t iter=0;
+	for (auto pass : SG_PROGRESS(range(num_passes)))
+	{
+		if (pass>0)
+			data->reset_stream();
+
+		index_t offset=0;
+		while (!cancel_computation())
+		{
+			SGMatrix<float64_t> batch;
+			if (pass==0 && offset<sample.num_cols)
+			{
+				/* the buffered sample is trained on first */
+				const index_t num=std::min<index_t>(batch_size, sample.num_cols-offset);
+				batch=SGMatrix<float64_t>(
+					sample.get_column_vector(offset), dimensions, num, false);
+				offset+=num;
+			}
+			else
+				batch=read_batch(data, batch_size);
+
+			if (!batch.num_cols)
+				break;
+
+			update_centers(batch, counts);
+			observe<SGMatrix<float64_t>>(++iter, "cluster_centers");
+		}
+	}
+
+	data->end_parser();
+
+	R=SGVector<float64_t>(k);
+	auto centers=std::make_shared<DenseFeatures<float64_t>>(cluster_centers);
+	distance->init(centers, centers);
+}
+
+SGMatrix<float64_t> KMeansMiniBatch::read_batch(
+	const std::shared_ptr<StreamingDenseFeatures<float64_t>>& data, index_t num)
+{
+	SGMatrix<float64_t> batch;
+	index_t num_read=0;
+	while (num_read<num && data->get_next_example())
+	{
+		auto vec=data->get_vector();
+		if (!batch.matrix)
+			batch=SGMatrix<float64_t>(vec.vlen, num);
+		require(vec.vlen==batch.num_rows,
+			"Example has {} features, expected {}", vec.vlen, batch.num_rows);
+		require(!dimensions || vec.vlen==dimensions,
+			"Example has {} features, expected {}", vec.vlen, dimensions);
+
+		std::copy_n(vec.vector, vec.vlen, batch.get_column_vector(num_read));
+		data->release_example();
+		num_read++;
+	}
+
+	if (num_read==num || !num_read)
+		return num_read ? batch : SGMatrix<float64_t>();
+
+	/* end of the stream */
+	SGMatrix<float64_t> result(batch.num_rows, num_read);
+	std::copy_n(batch.matrix, int64_t(batch.num_rows)*num_read, result.matrix);
+	return result;
+}
+
+void KMeansMiniBatch::update_centers(
+	const SGMatrix<float64_t>& batch, SGVector<float64_t>& counts)
+{
+	auto batch_features=std::make_shared<DenseFeatures<float64_t>>(batch);
+	auto centers=std::make_shared<DenseFeatures<float64_t>>(cluster_centers);
+	distance->init(batch_features, centers);
+
+	SGVector<index_t> batch_idx(batch.num_cols);
+	batch_idx.range_fill();
+	SGVector<index_t> center_idx(k);
+	center_idx.range_fill();
+	auto dists=distance->get_distance_block(batch_idx, center_idx);
+
+	SGVector<int32_t> nearest(batch.num_cols);
+#pragma omp parallel for
+	for (index_t j=0; j<batch.num_cols; j++)
+	{
+		int32_t near=0;
+		for (int32_t p=1; p<k; p++)
+		{
+			if (dists(j, p)<dists(j, near))
+				near=p;
+		}
+		nearest[j]=near;
+	}
+
+	for (index_t j=0; j<batch.num_cols; j++)
+	{
+		const int32_t near=nearest[j];
+		SGVector<float64_t> c_alive(
+			cluster_centers.get_column_vector(near), dimensions, false);
+		SGVector<float64_t> x(batch.get_column_vector(j), dimensions, false);
+		counts[near]+=1.0;
+		float64_t eta=1.0/counts[near];
+		linalg::add(c_alive, x, c_alive, 1.0 - eta, eta);
+	}
+
+	distance->remove_lhs_and_rhs();
+}
+
+SGMatrix<float64_t> KMeansMiniBatch::kmeans_parallel(const SGMatrix<float64_t>& sample)
+{
+	const index_t num=sample.num_cols;
+	const index_t dim=sample.num_rows;
+
+	/* squared distance of each example to its closest candidate */
+	SGVector<float64_t> min_dist(num);
+	min_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	SGVector<index_t> closest(num);
+	std::vector<index_t> candidates;
+
+	auto add_candidates=[&](index_t first) {
+#pragma omp parallel for
+		for (index_t i=0; i<num; i++)
+		{
+			for (index_t c=first; c<index_t(candidates.size()); c++)
+			{
+				const float64_t dist=sq_distance(sample.get_column_vector(i),
+					sample.get_column_vector(candidates[c]), dim);
+				if (dist<min_dist[i])
+				{
+					min_dist[i]=dist;
+					closest[i]=c;
+				}
+			}
+		}
+	};
+
+	UniformIntDistribution<index_t> uniform_int(0, num-1);
+	candidates.push_back(uniform_int(m_prng));
+	add_candidates(0);
+
+	UniformRealDistribution<float64_t> uniform_real(0.0, 1.0);
+	for (int32_t round=0; round<init_rounds; round++)
+	{
+		const float64_t cost=linalg::sum(min_dist);
+		if (cost<=0)
+			break;
+
+		/* sample each example with probability proportional to its cost */
+		const index_t first=candidates.size();
+		for (index_t i=0; i<num; i++)
+		{
+			if (uniform_real(m_prng)<oversampling*k*min_dist[i]/cost)
+				candidates.push_back(i);
+		}
+		add_candidates(first);
+	}
+
+	/* weight candidates by the number of examples closest to them */
+	SGMatrix<float64_t> points(dim, candidates.size());
+	SGVector<float64_t> weights(candidates.size());
+	weights.zero();
+	for (index_t c=0; c<index_t(candidates.size()); c++)
+		std::copy_n(sample.get_column_vector(candidates[c]), dim, points.get_column_vector(c));
+	for (index_t i=0; i<num; i++)
+		weights[closest[i]]+=1;
+
+	SG_DEBUG("k-means|| sampled {} candidates", candidates.size());
+
+	return reduce_candidates(points, weights);
+}
+
+SGMatrix<float64_t> KMeansMiniBatch::reduce_candidates(
+	const SGMatrix<float64_t>& points, const SGVector<float64_t>& weights)
+{
+	const index_t num=points.num_cols;
+	const index_t dim=points.num_rows;
+	SGMatrix<float64_t> centers(dim, k);
+
+	/* weighted k-means++ seeding, if there are fewer candidates than
+	 * centers some are duplicated */
+	SGVector<float64_t> min_dist(num);
+	min_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	SGVector<float64_t> probs(num);
+	for (int32_t c=0; c<k; c++)
+	{
+		for (index_t i=0; i<num; i++)
+			probs[i]=c ? weights[i]*min_dist[i] : weights[i];
+		const index_t chosen=sample_weighted(probs);
+		std::copy_n(points.get_column_vector(chosen), dim, centers.get_column_vector(c));
+
+#pragma omp parallel for
+		for (index_t i=0; i<num; i++)
+		{
+			min_dist[i]=std::min(min_dist[i], sq_distance(
+				points.get_column_vector(i), centers.get_column_vector(c), dim));
+		}
+	}
+
+	/* weighted Lloyd iterations, empty centers stay in place */
+	const int32_t num_lloyd_iter=10;
+	SGVector<int32_t> assignment(num);
+	for (int32_t iter=0; iter<num_lloyd_iter; iter++)
+	{
+#pragma omp parallel for
+		for (index_t i=0; i<num; i++)
+		{
+			int32_t best=0;
+			float64_t best_dist=std::numeric_limits<float64_t>::infinity();
+			for (int32_t c=0; c<k; c++)
+			{
+				const float64_t dist=sq_distance(
+					points.get_column_vector(i), centers.get_column_vector(c), dim);
+				if (dist<best_dist)
+				{
+					best_dist=dist;
+					best=c;
+				}
+			}
+			assignment[i]=best;
+		}
+
+		SGMatrix<float64_t> sums(dim, k);
+		sums.zero();
+		SGVector<float64_t> total(k);
+		total.zero();
+		for (index_t i=0; i<num; i++)
+		{
+			const float64_t* point=points.get_column_vector(i);
+			float64_t* sum=sums.get_column_vector(assignment[i]);
+			for (index_t d=0; d<dim; d++)
+				sum[d]+=weights[i]*point[d];
+			total[assignment[i]]+=weights[i];
+		}
+
+		for (int32_t c=0; c<k; c++)
+		{
+			if (total[c]<=0)
+				continue;
+			for (index_t d=0; d<dim; d++)
+				centers(d, c)=sums(d, c)/total[c];
+		}
+	}
+
+	return centers;
+}
+
+index_t KMeansMiniBatch::sample_weighted(const SGVector<float64_t>& weights)
+{
+	const float64_t total=linalg::sum(weights);
+	if (total<=0)
+	{
+		UniformIntDistribution<index_t> uniform_int(0, weights.vlen-1);
+		return uniform_int(m_prng);
+	}
+
+	UniformRealDistribution<float64_t> uniform_real(0.0, total);
+	const float64_t threshold=uniform_real(m_prng);
+	float64_t sum=0;
+	index_t last=0;
+	for (index_t i=0; i<weights.vlen; i++)
+	{
+		if (weights[i]<=0)
+			continue;
+
+		sum+=weights[i];
+		last=i;
+		if (sum>threshold)
+			return i;
+	}
+
+	return last;
+}
+
 SGVector<int32_t> KMeansMiniBatch::mbchoose_rand(int32_t b, int32_t num)
 {
 	SGVector<int32_t> chosen=SGVector<int32_t>(num);
@@ -113,16 +428,46 @@ SGVector<int32_t> KMeansMiniBatch::mbchoose_rand(int32_t b, int32_t num)
 void KMeansMiniBatch::init_mb_params()
 {
 	batch_size = 100;
+	num_passes = 1;
+	init_sample_size = 10000;
+	init_rounds = 5;
+	oversampling = 2.0;
 
 	SG_ADD(
 	&batch_size, "batch_size", "batch size for mini-batch KMeans",
 	ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD(
+	&num_passes, "num_passes", "number of passes over a training stream",
+	ParameterProperties::SETTING);
+	SG_ADD(
+	&init_sample_size, "init_sample_size",
+	"number of examples of a stream buffered for initialization",
+	ParameterProperties::SETTING);
+	SG_ADD(
+	&init_rounds, "init_rounds", "number of k-means|| rounds",
+	ParameterProperties::SETTING);
+	SG_ADD(
+	&oversampling, "oversampling",
+	"expected number of k-means|| candidates per round in multiples of k",
+	ParameterProperties::SETTING);
 }
 
 bool KMeansMiniBatch::train_machine(std::shared_ptr<Features> data)
 {
-	initialize_training(data);
-	minibatch_KMeans();
+	require(!m_communicator,
+		"Mini-batch training does not support sharded data");
+	if (data && data->get_feature_class()==C_STREAMING_DENSE)
+	{
+		require(data->get_feature_type()==F_DREAL,
+			"Streaming features must be of type REAL");
+		require(distance, "Distance is not provided");
+		minibatch_KMeans_streaming(data->as<StreamingDenseFeatures<float64_t>>());
+	}
+	else
+	{
+		initialize_training(data);
+		minibatch_KMeans();
+	}
 	compute_cluster_variances();
 	return true;
 }
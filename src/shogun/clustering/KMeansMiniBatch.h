@@ -14,12 +14,23 @@
 #include <shogun/distance/Distance.h>
 #include <shogun/machine/DistanceMachine.h>
 #include <shogun/clustering/KMeansBase.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 
 namespace shogun
 {
 class KMeansBase;
 	
-/** Class for the mini batch KMeans */
+/** Class for the mini batch KMeans
+ *
+ * Training on StreamingDenseFeatures consumes the stream batch by batch
+ * while the parser thread prefetches the next examples, so the data never
+ * has to fit in memory. The first init_sample_size examples are buffered to
+ * initialize the centers with k-means|| (Bahmani et al., "Scalable
+ * K-Means++") unless initial centers are given, and are then trained on like
+ * every other batch. Each of the num_passes passes over the stream does one
+ * update per batch; passes after the first require a stream that can be
+ * reset. max_iter only applies to training on in-memory features.
+ */
 class KMeansMiniBatch : public KMeansBase
 {
 	public:
@@ -65,6 +76,13 @@ class KMeansMiniBatch : public KMeansBase
 		 */
 		void minibatch_KMeans();
 
+		/** mini-batch KMeans training method on a stream
+		 *
+		 * @param data training stream
+		 */
+		void minibatch_KMeans_streaming(
+			const std::shared_ptr<StreamingDenseFeatures<float64_t>>& data);
+
 	private:
 
 		void init_mb_params();
@@ -74,10 +92,62 @@ class KMeansMiniBatch : public KMeansBase
 		 */
 		SGVector<int32_t> mbchoose_rand(int32_t b, int32_t num);
 
+		/** read up to num examples from a stream
+		 *
+		 * @param data stream, the parser must be running
+		 * @param num maximum number of examples
+		 * @return examples, one per column, empty at the end of the stream
+		 */
+		SGMatrix<float64_t> read_batch(
+			const std::shared_ptr<StreamingDenseFeatures<float64_t>>& data,
+			index_t num);
+
+		/** move the centers towards the examples of a batch
+		 *
+		 * @param batch examples, one per column
+		 * @param counts number of examples assigned to each center so far
+		 */
+		void update_centers(
+			const SGMatrix<float64_t>& batch, SGVector<float64_t>& counts);
+
+		/** initialize the centers by k-means|| on a sample
+		 *
+		 * @param sample examples, one per column
+		 * @return k centers
+		 */
+		SGMatrix<float64_t> kmeans_parallel(const SGMatrix<float64_t>& sample);
+
+		/** reduce weighted candidates to k centers by k-means++ seeding
+		 * followed by weighted Lloyd iterations
+		 *
+		 * @param points candidates, one per column
+		 * @param weights weight of each candidate
+		 * @return k centers
+		 */
+		SGMatrix<float64_t> reduce_candidates(
+			const SGMatrix<float64_t>& points, const SGVector<float64_t>& weights);
+
+		/** draw an index with probability proportional to its weight */
+		index_t sample_weighted(const SGVector<float64_t>& weights);
+
 	protected:
 
 		/** Batch size for mini-batch KMeans */
 		int32_t batch_size;
+
+		/** Number of passes over a training stream */
+		int32_t num_passes;
+
+		/** Number of examples of a stream buffered for initialization */
+		int32_t init_sample_size;
+
+		/** Number of k-means|| rounds */
+		int32_t init_rounds;
+
+		/** Expected number of candidates sampled per k-means|| round, in
+		 * multiples of k
+		 */
+		float64_t oversampling;
 };
 }
 #endif
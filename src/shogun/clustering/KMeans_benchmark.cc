@@ -0,0 +1,43 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/clustering/KMeans.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/machine/Machine_benchmark.h>
+
+namespace shogun
+{
+
+std::shared_ptr<KMeans> make_kmeans()
+{
+	auto kmeans = std::make_shared<KMeans>(
+		MachineFixture::kNumClasses, std::make_shared<EuclideanDistance>());
+	kmeans->put("seed", 17);
+	return kmeans;
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, KMeans_Train)(benchmark::State& state)
+{
+	for (auto _ : state)
+		make_kmeans()->train(features_train);
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, KMeans_Apply)(benchmark::State& state)
+{
+	auto kmeans = make_kmeans();
+	kmeans->train(features_train);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(kmeans->apply(features_test));
+	set_counters(state);
+}
+
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, KMeans_Train), 1000, 100000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, KMeans_Apply), 1000, 100000, 8);
+
+} // namespace shogun
@@ -18,6 +18,7 @@ DiffusionMaps::DiffusionMaps() :
 {
 	m_t = 10;
 	m_width = 1.0;
+	m_k = 0;
 	set_distance(std::make_shared<EuclideanDistance>());
 
 	init();
@@ -27,6 +28,7 @@ void DiffusionMaps::init()
 {
 	SG_ADD(&m_t, "t", "number of steps", ParameterProperties::HYPER);
 	SG_ADD(&m_width, "width", "gaussian kernel width", ParameterProperties::HYPER);
+	SG_ADD(&m_k, "k", "number of neighbors", ParameterProperties::HYPER);
 }
 
 DiffusionMaps::~DiffusionMaps()
@@ -53,6 +55,17 @@ float64_t DiffusionMaps::get_width() const
 	return m_width;
 }
 
+void DiffusionMaps::set_k(int32_t k)
+{
+	require(k>=0, "Number of neighbors ({}) must not be negative", k);
+	m_k = k;
+}
+
+int32_t DiffusionMaps::get_k() const
+{
+	return m_k;
+}
+
 const char* DiffusionMaps::get_name() const
 {
 	return "DiffusionMaps";
@@ -80,5 +93,13 @@ std::shared_ptr<DenseFeatures<float64_t>> DiffusionMaps::embed_distance(std::sha
 	parameters.method = SHOGUN_DIFFUSION_MAPS;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance.get();
+	std::shared_ptr<NeighborGraph> graph;
+	if (m_k > 0)
+	{
+		parameters.n_neighbors = m_k;
+		parameters.diffusion_map_sparse = true;
+		graph = neighbor_graph(distance, m_k);
+		parameters.neighbors = graph.get();
+	}
 	return tapkee_embed(parameters);
 }
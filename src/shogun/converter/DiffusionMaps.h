@@ -73,6 +73,18 @@ public:
 	 */
 	float64_t get_width() const;
 
+	/** setter for number of neighbors, the diffusion is restricted to
+	 * the k nearest neighbors of each vector and solved as a sparse problem
+	 * if k is positive, otherwise all pairs are used
+	 * @param k number of neighbors
+	 */
+	void set_k(int32_t k);
+
+	/** getter for number of neighbors
+	 * @return number of neighbors
+	 */
+	int32_t get_k() const;
+
 	/** get name */
 	const char* get_name() const override;
 
@@ -89,6 +101,9 @@ protected:
 	/** gaussian kernel width */
 	float64_t m_width;
 
+	/** number of neighbors, dense diffusion if not positive */
+	int32_t m_k;
+
 };
 }
 
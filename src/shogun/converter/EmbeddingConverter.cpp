@@ -70,6 +70,55 @@ std::shared_ptr<Kernel> EmbeddingConverter::get_kernel() const
 	return m_kernel;
 }
 
+void EmbeddingConverter::set_neighbor_graph(std::shared_ptr<NeighborGraph> graph)
+{
+	m_neighbor_graph = std::move(graph);
+}
+
+std::shared_ptr<NeighborGraph> EmbeddingConverter::get_neighbor_graph() const
+{
+	return m_neighbor_graph;
+}
+
+std::shared_ptr<NeighborGraph> EmbeddingConverter::compute_neighbor_graph(
+	const std::shared_ptr<Features>& features, int32_t max_k)
+{
+	require(features, "Features not set.");
+	require(m_distance, "Distance not set.");
+	m_distance->init(features, features);
+	m_neighbor_graph = std::make_shared<NeighborGraph>(m_distance, max_k, true);
+	m_distance->remove_lhs_and_rhs();
+	return m_neighbor_graph;
+}
+
+std::shared_ptr<NeighborGraph> EmbeddingConverter::neighbor_graph(
+	const std::shared_ptr<Features>& features, int32_t k)
+{
+	if (m_neighbor_graph)
+		return m_neighbor_graph;
+	if (!m_distance ||
+		m_distance->get_feature_class() != features->get_feature_class() ||
+		m_distance->get_feature_type() != features->get_feature_type())
+		return nullptr;
+
+	m_distance->init(features, features);
+	auto graph = neighbor_graph(m_distance, k);
+	m_distance->remove_lhs_and_rhs();
+	return graph;
+}
+
+std::shared_ptr<NeighborGraph> EmbeddingConverter::neighbor_graph(
+	const std::shared_ptr<Distance>& distance, int32_t k) const
+{
+	if (m_neighbor_graph)
+		return m_neighbor_graph;
+	// Tapkee reduces k and warns about it
+	if (k >= distance->get_num_vec_lhs())
+		return nullptr;
+
+	return std::make_shared<NeighborGraph>(distance, k, true);
+}
+
 void EmbeddingConverter::init()
 {
 	SG_ADD(&m_target_dim, "target_dim",
@@ -79,5 +128,9 @@ void EmbeddingConverter::init()
 		ParameterProperties::HYPER);
 	SG_ADD(
 		&m_kernel, "kernel", "kernel to be used for embedding", ParameterProperties::HYPER);
+	SG_ADD(
+		&m_neighbor_graph, "neighbor_graph",
+		"precomputed neighbours of the features to embed",
+		ParameterProperties::SETTING);
 }
 }
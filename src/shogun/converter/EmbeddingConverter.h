@@ -13,6 +13,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/distance/NeighborGraph.h>
 #include <shogun/kernel/Kernel.h>
 
 namespace shogun
@@ -73,6 +74,33 @@ public:
 	 */
 	std::shared_ptr<Kernel> get_kernel() const;
 
+	/** setter for precomputed neighbours of the features to embed, used by
+	 * the neighbourhood based embeddings instead of searching them. The
+	 * graph must exclude every vector from its own neighbours, see
+	 * NeighborGraph::build(), and hold at least k neighbours, so one graph
+	 * serves several embeddings and values of k.
+	 *
+	 * @param graph neighbour graph, nullptr to search the neighbours
+	 */
+	void set_neighbor_graph(std::shared_ptr<NeighborGraph> graph);
+
+	/** getter for precomputed neighbours
+	 * @return neighbour graph
+	 */
+	std::shared_ptr<NeighborGraph> get_neighbor_graph() const;
+
+	/** finds the max_k nearest neighbours of the features to embed under
+	 * the distance and keeps them as precomputed neighbours, see
+	 * set_neighbor_graph(). The returned graph can be passed on to other
+	 * embeddings of the same features.
+	 *
+	 * @param features features to embed
+	 * @param max_k largest number of neighbours the graph is used with
+	 * @return neighbour graph
+	 */
+	std::shared_ptr<NeighborGraph> compute_neighbor_graph(
+		const std::shared_ptr<Features>& features, int32_t max_k);
+
 	const char* get_name() const override { return "EmbeddingConverter"; };
 
 protected:
@@ -80,6 +108,28 @@ protected:
 	/** default init */
 	void init();
 
+	/** neighbours used to embed features, the precomputed graph if set,
+	 * otherwise the k nearest neighbours under the distance, searched by
+	 * blocks of the distance matrix in parallel
+	 *
+	 * @param features features to embed
+	 * @param k number of neighbours
+	 * @return neighbour graph, nullptr if the distance does not apply to
+	 * the features, then the neighbours are searched by Tapkee
+	 */
+	std::shared_ptr<NeighborGraph> neighbor_graph(
+		const std::shared_ptr<Features>& features, int32_t k);
+
+	/** neighbours used to embed features, the precomputed graph if set,
+	 * otherwise the k nearest neighbours under the given distance
+	 *
+	 * @param distance distance initialized with the features to embed
+	 * @param k number of neighbours
+	 * @return neighbour graph, nullptr if there are not more than k vectors
+	 */
+	std::shared_ptr<NeighborGraph> neighbor_graph(
+		const std::shared_ptr<Distance>& distance, int32_t k) const;
+
 protected:
 
 	/** target dim of dimensionality reduction preprocessor */
@@ -90,6 +140,9 @@ protected:
 
 	/** kernel to be used */
 	std::shared_ptr<Kernel> m_kernel;
+
+	/** precomputed neighbours of the features to embed */
+	std::shared_ptr<NeighborGraph> m_neighbor_graph;
 };
 }
 
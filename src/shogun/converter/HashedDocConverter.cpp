@@ -4,6 +4,7 @@
  * Authors: Evangelos Anagnostopoulos, Sergey Lisitsyn, Bjoern Esser
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/Hash.h>
@@ -80,12 +81,25 @@ std::shared_ptr<Features> HashedDocConverter::transform(std::shared_ptr<Features
 	auto s_features = std::static_pointer_cast<StringFeatures<char>>(features);
 
 	int32_t dim = Math::pow(2, num_bits);
-	SGSparseMatrix<float64_t> matrix(dim,features->get_num_vectors());
-	for (index_t vec_idx=0; vec_idx<s_features->get_num_vectors(); vec_idx++)
+	const index_t num_vectors = s_features->get_num_vectors();
+	for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
 	{
-		SGVector<char> doc = s_features->get_feature_vector(vec_idx);
-		matrix[vec_idx] = apply(doc);
-		s_features->free_feature_vector(doc, vec_idx);
+		require(s_features->get_vector_length(vec_idx)>0,
+			"Document {} is empty", vec_idx);
+	}
+
+	SGSparseMatrix<float64_t> matrix(dim,num_vectors);
+#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<std::pair<index_t, index_t>> tokens;
+		std::vector<uint32_t> hashed_indices;
+#pragma omp for schedule(dynamic, 64)
+		for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		{
+			SGVector<char> doc = s_features->get_feature_vector(vec_idx);
+			matrix[vec_idx] = apply(doc, tokens, hashed_indices);
+			s_features->free_feature_vector(doc, vec_idx);
+		}
 	}
 
 	return std::make_shared<SparseFeatures<float64_t>>(matrix);
@@ -94,10 +108,21 @@ std::shared_ptr<Features> HashedDocConverter::transform(std::shared_ptr<Features
 SGSparseVector<float64_t> HashedDocConverter::apply(SGVector<char> document)
 {
 	ASSERT(document.size()>0)
-	const int32_t array_size = 1024*1024;
-	/** the array will contain all the hashes generated from the tokens */
+	std::vector<std::pair<index_t, index_t>> tokens;
 	std::vector<uint32_t> hashed_indices;
-	hashed_indices.reserve(array_size);
+	return apply(document, tokens, hashed_indices);
+}
+
+SGSparseVector<float64_t> HashedDocConverter::apply(SGVector<char> document,
+	std::vector<std::pair<index_t, index_t>>& tokens,
+	std::vector<uint32_t>& hashed_indices)
+{
+	/** the array will contain all the hashes generated from the tokens */
+	hashed_indices.clear();
+
+	/** all tokens are found at once, which leaves the tokenizer untouched
+	 * and allows to hash documents concurrently */
+	tokenizer->tokenize(document, tokens);
 
 	/** this vector will maintain the current n+k active tokens
 	 * in a circular manner */
@@ -112,22 +137,21 @@ SGSparseVector<float64_t> HashedDocConverter::apply(SGVector<char> document)
 
 	/** Reading n+s-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	tokenizer->set_text(document);
-	index_t token_start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && tokenizer->has_next())
+	size_t next_token = 0;
+	while (hashes_end<ngrams-1+tokens_to_skip && next_token<tokens.size())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &document.vector[token_start],
-				end-token_start, seed);
+		const auto& token = tokens[next_token++];
+		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &document.vector[token.first],
+				token.second-token.first, seed);
 		cached_hashes[hashes_end++] = token_hash;
 	}
 
 	/** Reading token and storing index to hashed_indices */
-	while (tokenizer->has_next())
+	while (next_token<tokens.size())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &document.vector[token_start],
-				end-token_start, seed);
+		const auto& token = tokens[next_token++];
+		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &document.vector[token.first],
+				token.second-token.first, seed);
 		cached_hashes[hashes_end] = token_hash;
 
 		HashedDocConverter::generate_ngram_hashes(cached_hashes, hashes_start, len,
@@ -63,7 +63,8 @@ public:
 	/** Destructor */
 	~HashedDocConverter() override;
 
-	/** Hashes each string contained in features
+	/** Hashes each string contained in features, the documents are
+	 * hashed in parallel, see Tokenizer::tokenize()
 	 *
 	 * @param features the strings to be hashed. Must be an instance of CStringFeatures.
 	 * @return a SparseFeatures object containing the hashes of the strings.
@@ -136,6 +137,17 @@ protected:
 	 */
 	SGSparseVector<float64_t> create_hashed_representation(std::vector<uint32_t>& hashed_indices);
 
+	/** Hashes the tokens contained in document, thread safe
+	 *
+	 * @param document the char vector to tokenize and hash
+	 * @param tokens buffer for the tokens, reused between documents
+	 * @param hashed_indices buffer for the hashed indices, reused between documents
+	 * @return a SGSparseVector with the hashed representation of the document
+	 */
+	SGSparseVector<float64_t> apply(SGVector<char> document,
+			std::vector<std::pair<index_t, index_t>>& tokens,
+			std::vector<uint32_t>& hashed_indices);
+
 protected:
 
 	/** the number of bits of the hash */
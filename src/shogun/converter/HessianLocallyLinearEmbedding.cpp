@@ -36,6 +36,8 @@ HessianLocallyLinearEmbedding::transform(std::shared_ptr<Features> features, boo
 	parameters.method = SHOGUN_HESSIAN_LOCALLY_LINEAR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
 	parameters.kernel = kernel.get();
+	auto graph = neighbor_graph(features, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
@@ -59,6 +59,8 @@ std::shared_ptr<DenseFeatures<float64_t>> Isomap::embed_distance(std::shared_ptr
 	parameters.n_neighbors = m_k;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance.get();
+	auto graph = neighbor_graph(distance, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
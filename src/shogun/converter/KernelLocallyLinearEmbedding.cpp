@@ -61,6 +61,7 @@ std::shared_ptr<DenseFeatures<float64_t>> KernelLocallyLinearEmbedding::embed_ke
 	parameters.method = SHOGUN_KERNEL_LOCALLY_LINEAR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
 	parameters.kernel = kernel.get();
+	parameters.neighbors = m_neighbor_graph.get();
 	return tapkee_embed(parameters);
 }
 
@@ -84,5 +84,7 @@ std::shared_ptr<DenseFeatures<float64_t>> LaplacianEigenmaps::embed_distance(std
 	parameters.method = SHOGUN_LAPLACIAN_EIGENMAPS;
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = distance.get();
+	auto graph = neighbor_graph(distance, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
@@ -38,6 +38,8 @@ LinearLocalTangentSpaceAlignment::transform(std::shared_ptr<Features> features,
 	parameters.target_dimension = m_target_dim;
 	parameters.kernel = kernel.get();
 	parameters.features = (DotFeatures*)features.get();
+	auto graph = neighbor_graph(features, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
@@ -37,6 +37,8 @@ LocalTangentSpaceAlignment::transform(std::shared_ptr<Features> features, bool i
 	parameters.method = SHOGUN_LOCAL_TANGENT_SPACE_ALIGNMENT;
 	parameters.target_dimension = m_target_dim;
 	parameters.kernel = kernel.get();
+	auto graph = neighbor_graph(features, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
@@ -37,6 +37,8 @@ LocalityPreservingProjections::transform(std::shared_ptr<Features> features, boo
 	parameters.target_dimension = m_target_dim;
 	parameters.distance = m_distance.get();
 	parameters.features = (DotFeatures*)features.get();
+	auto graph = neighbor_graph(m_distance, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
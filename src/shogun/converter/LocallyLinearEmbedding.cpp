@@ -85,6 +85,8 @@ std::shared_ptr<Features> LocallyLinearEmbedding::transform(std::shared_ptr<Feat
 	parameters.method = SHOGUN_LOCALLY_LINEAR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
 	parameters.kernel = kernel.get();
+	auto graph = neighbor_graph(features, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
@@ -39,6 +39,8 @@ NeighborhoodPreservingEmbedding::transform(std::shared_ptr<Features> features, b
 	parameters.target_dimension = m_target_dim;
 	parameters.kernel = kernel.get();
 	parameters.features = dot_feats.get();
+	auto graph = neighbor_graph(features, m_k);
+	parameters.neighbors = graph.get();
 	return tapkee_embed(parameters);
 }
 
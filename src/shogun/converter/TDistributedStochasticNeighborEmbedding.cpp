@@ -16,6 +16,7 @@ TDistributedStochasticNeighborEmbedding::TDistributedStochasticNeighborEmbedding
 	// Default values
 	m_perplexity = 30.0;
 	m_theta = 0.5;
+	m_interpolation = false;
 	init();
 }
 
@@ -23,6 +24,8 @@ void TDistributedStochasticNeighborEmbedding::init()
 {
 	SG_ADD(&m_perplexity, "perplexity", "perplexity");
 	SG_ADD(&m_theta, "theta", "learning rate");
+	SG_ADD(&m_interpolation, "interpolation",
+	    "whether repulsive forces are interpolated on a grid");
 }
 
 TDistributedStochasticNeighborEmbedding::~TDistributedStochasticNeighborEmbedding()
@@ -55,12 +58,23 @@ float64_t TDistributedStochasticNeighborEmbedding::get_perplexity() const
 	return m_perplexity;
 }
 
+void TDistributedStochasticNeighborEmbedding::set_interpolation(const bool interpolation)
+{
+	m_interpolation = interpolation;
+}
+
+bool TDistributedStochasticNeighborEmbedding::get_interpolation() const
+{
+	return m_interpolation;
+}
+
 std::shared_ptr<Features> TDistributedStochasticNeighborEmbedding::transform(
     std::shared_ptr<Features> features, bool inplace)
 {
 	TAPKEE_PARAMETERS_FOR_SHOGUN parameters;
 	parameters.sne_theta = m_theta;
 	parameters.sne_perplexity = m_perplexity;
+	parameters.sne_interpolation = m_interpolation;
 	parameters.features = (DotFeatures*)features.get();
 	parameters.method = SHOGUN_TDISTRIBUTED_STOCHASTIC_NEIGHBOR_EMBEDDING;
 	parameters.target_dimension = m_target_dim;
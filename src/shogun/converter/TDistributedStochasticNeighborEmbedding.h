@@ -64,6 +64,21 @@ public:
 	 */
 	float64_t get_perplexity() const;
 
+	/** setter for interpolation, if enabled the repulsive forces
+	 * of two-dimensional embeddings are computed by FFT-accelerated
+	 * interpolation on a grid instead of the Barnes-Hut tree, which
+	 * is faster for large numbers of vectors
+	 *
+	 * @param interpolation whether to use interpolation
+	 */
+	void set_interpolation(const bool interpolation);
+
+	/** getter for interpolation
+	 *
+	 * @return whether interpolation is used
+	 */
+	bool get_interpolation() const;
+
 private:
 
 	/** default init */
@@ -77,6 +92,9 @@ private:
 	/** perplexity */
 	float64_t m_perplexity;
 
+	/** whether the repulsive forces are interpolated */
+	bool m_interpolation;
+
 }; /* class CTDistributedStochasticNeighborEmbedding */
 
 } /* namespace shogun */
@@ -8,6 +8,7 @@
 
 #include <shogun/features/DenseFeatures.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
@@ -36,11 +37,14 @@ namespace {
 		return std::tanh(x * alpha);
 	}
 
-	float64_t g_x(float64_t x)
+	/** derivative of gx given gx(x) */
+	float64_t g_x(float64_t g)
 	{
-		return alpha * (1.0 - pow(gx(x),2));
+		return alpha * (1.0 - g * g);
 	}
 
+	const index_t block_size = 4096;
+
 };
 
 FastICA::FastICA() : RandomMixin<ICAConverter>()
@@ -84,26 +88,24 @@ void FastICA::fit_dense(std::shared_ptr<DenseFeatures<float64_t>> features)
 	if (whiten)
 	{
 		VectorXd mean = (EX.rowwise().sum() / (float64_t)p);
-		MatrixXd SPX = EX.colwise() - mean;
-
-		Eigen::JacobiSVD<MatrixXd> svd;
-		svd.compute(SPX, Eigen::ComputeThinU);
-
-		MatrixXd u = svd.matrixU();
-		MatrixXd d = svd.singularValues();
 
-		// for matching numpy/scikit-learn
-		//u.rightCols(u.cols() - 1) *= -1;
+		// the eigendecomposition of the covariance, accumulated by blocks
+		// of samples, gives the left singular vectors of the centered data
+		auto cov = lagged_covariances(X, SGVector<float64_t>({0.0}));
+		SelfAdjointEigenSolver<MatrixXd> eig;
+		eig.compute(Map<MatrixXd>(cov.get_matrix(0), n, n));
 
-		// see Hyvarinen (6.33) p.140
-		K = u.transpose();
+		// see Hyvarinen (6.33) p.140, with components in order of
+		// decreasing variance as given by the SVD
+		K = eig.eigenvectors().rowwise().reverse().transpose();
+		VectorXd d = eig.eigenvalues().reverse().cwiseSqrt();
 		for (int r = 0; r < K.rows(); r++)
 			K.row(r) /= d(r);
 
 		// see Hyvarinen (13.6) p.267 Here WX is white and data
 		// in X has been projected onto a subspace by PCA
-		WX = K * SPX;
-		WX *= std::sqrt((float64_t)p);
+		WX = K * (EX.colwise() - mean);
+		K /= std::sqrt((float64_t)p);
 	}
 	else
 	{
@@ -121,15 +123,38 @@ void FastICA::fit_dense(std::shared_ptr<DenseFeatures<float64_t>> features)
 
 	W = sym_decorrelation(W);
 
+	const index_t num_blocks = (p + block_size - 1) / block_size;
 	float64_t lim = tol+1;
 	for (auto i : SG_PROGRESS(range(0, max_iter), [&] { return lim > tol; }))
 	{
-		MatrixXd wtx = W * WX;
-
-		MatrixXd gwtx = wtx.unaryExpr([](float64_t x) { return gx(x); });
-		MatrixXd g_wtx = wtx.unaryExpr([](float64_t x) { return g_x(x); });
-
-		MatrixXd W1 = (gwtx * WX.transpose()) / (float64_t)p - (g_wtx.rowwise().sum()/(float64_t)p).asDiagonal() * W;
+		// E[g(wx) x^T] and E[g'(wx)] of all components, accumulated by
+		// blocks of samples with a single product per block
+		MatrixXd gwtx_x = MatrixXd::Zero(m, WX.rows());
+		VectorXd g_wtx = VectorXd::Zero(m);
+#pragma omp parallel num_threads(env()->get_num_threads())
+		{
+			MatrixXd local_gwtx_x = MatrixXd::Zero(m, WX.rows());
+			VectorXd local_g_wtx = VectorXd::Zero(m);
+#pragma omp for schedule(static)
+			for (index_t b = 0; b < num_blocks; b++)
+			{
+				const index_t begin = b * block_size;
+				const index_t len = std::min(block_size, p - begin);
+				MatrixXd gwtx = (W * WX.middleCols(begin, len)).unaryExpr(
+				    [](float64_t x) { return gx(x); });
+				local_g_wtx += gwtx.unaryExpr([](float64_t g) {
+					return g_x(g);
+				}).rowwise().sum();
+				local_gwtx_x.noalias() += gwtx * WX.middleCols(begin, len).transpose();
+			}
+#pragma omp critical
+			{
+				gwtx_x += local_gwtx_x;
+				g_wtx += local_g_wtx;
+			}
+		}
+
+		MatrixXd W1 = gwtx_x / (float64_t)p - (g_wtx / (float64_t)p).asDiagonal() * W;
 
 		W1 = sym_decorrelation(W1);
 
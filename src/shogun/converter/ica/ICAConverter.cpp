@@ -4,14 +4,22 @@
  * Authors: Kevin Hughes, Heiko Strathmann, Bjoern Esser
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/converter/ica/ICAConverter.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <vector>
+
 using namespace shogun;
 using namespace Eigen;
 
+namespace
+{
+	const index_t block_size = 4096;
+}
+
 ICAConverter::ICAConverter() : Converter()
 {
 	init();
@@ -106,3 +114,59 @@ std::shared_ptr<Features> ICAConverter::inverse_transform(std::shared_ptr<Featur
 
 	return std::make_shared<DenseFeatures<float64_t>>(X);
 }
+
+SGNDArray<float64_t> ICAConverter::lagged_covariances(
+    const SGMatrix<float64_t>& X, const SGVector<float64_t>& tau)
+{
+	const index_t m = X.num_rows;
+	const index_t n = X.num_cols;
+	const index_t num_lags = tau.vlen;
+	for (index_t t = 0; t < num_lags; t++)
+	{
+		require(
+		    tau[t] >= 0 && tau[t] < n,
+		    "Lag {} must be in [0, {}) for {} samples", tau[t], n, n);
+	}
+
+	Map<const MatrixXd> EX(X.matrix, m, n);
+	const VectorXd mean = EX.rowwise().sum() / n;
+	const index_t num_blocks = (n + block_size - 1) / block_size;
+
+	std::vector<MatrixXd> covs(num_lags, MatrixXd::Zero(m, m));
+#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<MatrixXd> local_covs(num_lags, MatrixXd::Zero(m, m));
+#pragma omp for schedule(static)
+		for (index_t b = 0; b < num_blocks; b++)
+		{
+			const index_t begin = b * block_size;
+			const index_t end = std::min(begin + block_size, n);
+			const MatrixXd left = EX.middleCols(begin, end - begin).colwise() - mean;
+			for (index_t t = 0; t < num_lags; t++)
+			{
+				// pairs (i, i + tau) with i in the block
+				const index_t lag = tau[t];
+				const index_t len = std::min(end, n - lag) - begin;
+				if (len <= 0)
+					continue;
+				local_covs[t].noalias() += left.leftCols(len) *
+				    (EX.middleCols(begin + lag, len).colwise() - mean).transpose();
+			}
+		}
+#pragma omp critical
+		for (index_t t = 0; t < num_lags; t++)
+			covs[t] += local_covs[t];
+	}
+
+	index_t* dims = SG_MALLOC(index_t, 3);
+	dims[0] = m;
+	dims[1] = m;
+	dims[2] = num_lags;
+	SGNDArray<float64_t> result(dims, 3);
+	for (index_t t = 0; t < num_lags; t++)
+	{
+		Map<MatrixXd> C(result.get_matrix(t), m, m);
+		C = (covs[t] + covs[t].transpose()) / (2.0 * (n - index_t(tau[t])));
+	}
+	return result;
+}
@@ -11,6 +11,8 @@
 #include <shogun/converter/Converter.h>
 #include <shogun/features/Features.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGNDArray.h>
+#include <shogun/lib/SGVector.h>
 
 namespace shogun
 {
@@ -100,6 +102,17 @@ namespace shogun
 
 		virtual void fit_dense(std::shared_ptr<DenseFeatures<float64_t>> features) = 0;
 
+		/** Symmetrized time lagged covariance matrices of the mean
+		 * centered signals, \f$ \frac{1}{T-\tau} \sum_t x_t x_{t+\tau}^T \f$.
+		 * Blocks of samples are accumulated in parallel for all lags at
+		 * once, without a centered copy of the signals.
+		 * @param X signals, one per row
+		 * @param tau lags in samples
+		 * @return one covariance matrix per lag
+		 */
+		static SGNDArray<float64_t> lagged_covariances(
+		    const SGMatrix<float64_t>& X, const SGVector<float64_t>& tau);
+
 		/** mixing_matrix */
 		SGMatrix<float64_t> m_mixing_matrix;
 
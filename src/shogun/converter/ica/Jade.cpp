@@ -6,6 +6,7 @@
 
 #include <shogun/converter/ica/Jade.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/DenseFeatures.h>
 
 
@@ -20,6 +21,24 @@
 using namespace shogun;
 using namespace Eigen;
 
+namespace
+{
+	const index_t block_size = 4096;
+
+	/** X diag(w) X^T, by blocks of samples to avoid a weighted copy of X */
+	MatrixXd weighted_scatter(const MatrixXd& X, const VectorXd& w)
+	{
+		MatrixXd scatter = MatrixXd::Zero(X.rows(), X.rows());
+		for (index_t begin = 0; begin < X.cols(); begin += block_size)
+		{
+			const index_t len = std::min<index_t>(block_size, X.cols() - begin);
+			scatter.noalias() += (X.middleCols(begin, len) *
+			    w.segment(begin, len).asDiagonal()) * X.middleCols(begin, len).transpose();
+		}
+		return scatter;
+	}
+}
+
 Jade::Jade() : ICAConverter()
 {
 	init();
@@ -54,9 +73,9 @@ void Jade::fit_dense(std::shared_ptr<DenseFeatures<float64_t>> features)
 
 	// Mean center X
 	VectorXd mean = (EX.rowwise().sum() / (float64_t)T);
-	MatrixXd SPX = EX.colwise() - mean;
 
-	MatrixXd cov = (SPX * SPX.transpose()) / (float64_t)T;
+	auto covs = lagged_covariances(X, SGVector<float64_t>({0.0}));
+	Eigen::Map<MatrixXd> cov(covs.get_matrix(0),m,m);
 
 	#ifdef DEBUG_JADE
 	std::cout << "cov" << std::endl;
@@ -85,7 +104,7 @@ void Jade::fit_dense(std::shared_ptr<DenseFeatures<float64_t>> features)
 	#endif
 
 	// Sphering
-	SPX = B * SPX;
+	MatrixXd SPX = B * (EX.colwise() - mean);
 
 	// Estimation of the cumulant matrices
 	int dimsymm = (m * ( m + 1)) / 2; // Dim. of the space of real symm matrices
@@ -93,24 +112,21 @@ void Jade::fit_dense(std::shared_ptr<DenseFeatures<float64_t>> features)
 	m_cumulant_matrix = SGMatrix<float64_t>(m,m*nbcm);	// Storage for cumulant matrices
 	Eigen::Map<MatrixXd> CM(m_cumulant_matrix.matrix,m,m*nbcm);
 	MatrixXd R(m,m); R.setIdentity();
-	MatrixXd Qij = MatrixXd::Zero(m,m); // Temp for a cum. matrix
-	VectorXd Xim = VectorXd::Zero(m); // Temp
-	VectorXd Xjm = VectorXd::Zero(m); // Temp
-	VectorXd Xijm = VectorXd::Zero(m); // Temp
-	int Range = 0;
 
+	// the matrices of each component are computed in parallel, they are
+	// stored after those of all previous components
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
 	for (int im = 0; im < m; im++)
 	{
-		Xim = SPX.row(im);
-		Xijm = Xim.cwiseProduct(Xim);
-		Qij = SPX.cwiseProduct(Xijm.replicate(1,m).transpose()) * SPX.transpose() / (float)T - R - 2*R.col(im)*R.col(im).transpose();
+		int Range = m * ((im * (im + 1)) / 2);
+		VectorXd Xim = SPX.row(im);
+		MatrixXd Qij = weighted_scatter(SPX, Xim.cwiseProduct(Xim)) / (float64_t)T - R - 2*R.col(im)*R.col(im).transpose();
 		CM.block(0,Range,m,m) = Qij;
 		Range = Range + m;
 		for (int jm = 0; jm < im; jm++)
 		{
-			Xjm = SPX.row(jm);
-			Xijm = Xim.cwiseProduct(Xjm);
-			Qij = SPX.cwiseProduct(Xijm.replicate(1,m).transpose()) * SPX.transpose() / (float)T - R.col(im)*R.col(jm).transpose() - R.col(jm)*R.col(im).transpose();
+			VectorXd Xjm = SPX.row(jm);
+			Qij = weighted_scatter(SPX, Xim.cwiseProduct(Xjm)) / (float64_t)T - R.col(im)*R.col(jm).transpose() - R.col(jm)*R.col(im).transpose();
 			CM.block(0,Range,m,m) =  sqrt(2)*Qij;
 			Range = Range + m;
 		}
@@ -61,6 +61,17 @@ class CosineDistance: public DenseDistance<float64_t>
 		 */
 		EDistanceType get_distance_type() override { return D_COSINE; }
 
+		/** get the metric of linalg::pairwise_distance()
+		 *
+		 * @param metric Cosine
+		 * @return true
+		 */
+		bool get_pairwise_metric(linalg::DistanceMetric& metric) const override
+		{
+			metric=linalg::DistanceMetric::Cosine;
+			return true;
+		}
+
 		/** get name of the distance
 		 *
 		 * @return name Cosine distance
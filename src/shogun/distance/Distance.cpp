@@ -19,7 +19,10 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/distance/Distance.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/LinalgSpecialPurposes.h>
 
 #include <string.h>
 #ifndef _WIN32
@@ -29,6 +32,8 @@
 #ifdef HAVE_OPENMP
 #include <omp.h>
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 
 #endif
@@ -264,6 +269,49 @@ void Distance::init()
 	SG_ADD(&rhs, "rhs", "Right hand side features.");
 }
 
+template <class T>
+bool Distance::compute_distance_matrix_blockwise(T* result)
+{
+	const index_t m=get_num_vec_lhs();
+	const index_t n=get_num_vec_rhs();
+	const index_t block_size=128;
+	const index_t num_blocks=(n+block_size-1)/block_size;
+
+	SGVector<index_t> lhs_idx(m);
+	lhs_idx.range_fill();
+
+	std::atomic<bool> supported(true);
+	auto pb=SG_PROGRESS(range(num_blocks));
+#pragma omp parallel for schedule(dynamic)
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		if (!supported)
+			continue;
+
+		const index_t begin=b*block_size;
+		const index_t len=std::min(block_size, n-begin);
+		SGVector<index_t> rhs_idx(len);
+		rhs_idx.range_fill(begin);
+
+		SGMatrix<float64_t> block(m, len);
+		if (!compute_block(lhs_idx, rhs_idx, block))
+		{
+			supported=false;
+			continue;
+		}
+
+		for (index_t j=0; j<len; j++)
+		{
+			for (index_t i=0; i<m; i++)
+				result[i+(begin+j)*int64_t(m)]=block(i, j);
+		}
+		pb.print_progress();
+	}
+	pb.complete();
+
+	return supported;
+}
+
 template <class T>
 SGMatrix<T> Distance::get_distance_matrix()
 {
@@ -285,6 +333,9 @@ SGMatrix<T> Distance::get_distance_matrix()
 
 	result=SG_MALLOC(T, total_num);
 
+	if (!precompute_matrix && compute_distance_matrix_blockwise(result))
+		return SGMatrix<T>(result,m,n,true);
+
 	PRange<int64_t> pb = PRange<int64_t>(
 	    range(total_num), "PROGRESS: ", UTF8, []() { return true; });
 	int32_t num_threads;
@@ -347,3 +398,49 @@ SGMatrix<T> Distance::get_distance_matrix()
 
 template SGMatrix<float64_t> Distance::get_distance_matrix<float64_t>();
 template SGMatrix<float32_t> Distance::get_distance_matrix<float32_t>();
+
+bool Distance::compute_block_gpu(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	linalg::DistanceMetric metric;
+	if (!env()->linalg()->get_gpu_backend() || !get_pairwise_metric(metric))
+		return false;
+
+	if (lhs->get_feature_class()!=C_DENSE || lhs->get_feature_type()!=F_DREAL ||
+		rhs->get_feature_class()!=C_DENSE || rhs->get_feature_type()!=F_DREAL)
+		return false;
+
+	SGMatrix<float64_t> lhs_block;
+	SGMatrix<float64_t> rhs_block;
+	linalg::to_gpu(
+		lhs->copy_subset(lhs_idx)->as<DenseFeatures<float64_t>>()->get_feature_matrix(),
+		lhs_block);
+	linalg::to_gpu(
+		rhs->copy_subset(rhs_idx)->as<DenseFeatures<float64_t>>()->get_feature_matrix(),
+		rhs_block);
+
+	auto block_gpu=linalg::pairwise_distance(lhs_block, rhs_block, metric);
+	linalg::from_gpu(block_gpu, block);
+
+	return true;
+}
+
+SGMatrix<float64_t> Distance::get_distance_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx)
+{
+	require(has_features(), "no features assigned to distance");
+
+	SGMatrix<float64_t> block(lhs_idx.vlen, rhs_idx.vlen);
+	if (!compute_block_gpu(lhs_idx, rhs_idx, block) &&
+		!compute_block(lhs_idx, rhs_idx, block))
+	{
+		const int64_t num_rows=block.num_rows;
+		const int64_t total=num_rows*block.num_cols;
+#pragma omp parallel for
+		for (int64_t k=0; k<total; ++k)
+			block.matrix[k]=distance(lhs_idx[k%num_rows], rhs_idx[k/num_rows]);
+	}
+
+	return block;
+}
@@ -19,6 +19,7 @@
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/features/Features.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/linalg/LinalgEnums.h>
 
 namespace shogun
 {
@@ -50,7 +51,8 @@ enum EDistanceType
 	D_MAHALANOBIS = 180,
 	D_DIRECTOR = 190,
 	D_CUSTOMMAHALANOBIS = 200,
-	D_LEVENSHTEIN = 210
+	D_LEVENSHTEIN = 210,
+	D_PQ = 220
 };
 
 /** @brief Class Distance, a base class for all the distances used in
@@ -162,6 +164,19 @@ class Distance : public SGObject
 		 */
 		template <class T> SGMatrix<T> get_distance_matrix();
 
+		/** get a block of the distance matrix, i.e. distance(lhs_idx[i],
+		 * rhs_idx[j]) for all pairs of the given indices
+		 *
+		 * The block is computed with a single call to compute_block() if the
+		 * distance supports it and element-wise otherwise.
+		 *
+		 * @param lhs_idx indices of the lhs vectors
+		 * @param rhs_idx indices of the rhs vectors
+		 * @return block of size lhs_idx.vlen x rhs_idx.vlen
+		 */
+		SGMatrix<float64_t> get_distance_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx);
+
 		/** compute row start offset for parallel kernel matrix computation
 		 *
 		 * @param offs offset
@@ -275,6 +290,20 @@ class Distance : public SGObject
 		 */
 		virtual EFeatureClass get_feature_class()=0;
 
+		/** get the metric of linalg::pairwise_distance() that computes this
+		 * distance on dense real features
+		 *
+		 * Distances that have one are computed on the GPU backend by
+		 * get_distance_block() if a GPU backend is registered.
+		 *
+		 * @param metric set to the metric if there is one
+		 * @return whether there is such a metric
+		 */
+		virtual bool get_pairwise_metric(linalg::DistanceMetric& metric) const
+		{
+			return false;
+		}
+
 		/** FIXME: precompute matrix should be dropped, handling
 		 * should be via customdistance
 		 *
@@ -366,6 +395,46 @@ class Distance : public SGObject
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b)=0;
 
+		/** compute a whole block of distances at once
+		 *
+		 * Distances that can compute many pairs faster than one by one
+		 * (e.g. through a sparse matrix product) override this, so that
+		 * get_distance_block() and get_distance_matrix() dispatch once per
+		 * block instead of once per pair.
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of size lhs_idx.vlen x rhs_idx.vlen
+		 * @return whether the block was computed, false if not supported
+		 */
+		virtual bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block)
+		{
+			return false;
+		}
+
+		/** compute a whole block of distances with
+		 * linalg::pairwise_distance() on the GPU backend, only the block
+		 * vectors are transferred to the device
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block block of the distance matrix, replaced by the result
+		 * @return whether the block was computed, false if there is no GPU
+		 * backend, no pairwise metric or the features are not dense real
+		 */
+		bool compute_block_gpu(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block);
+
+		/** compute the distance matrix block-wise with compute_block()
+		 *
+		 * @param result preallocated distance matrix, column-major
+		 * @return whether the distance supports block computation
+		 */
+		template <class T> bool compute_distance_matrix_blockwise(T* result);
+
 		/// matrix precomputation
 		void do_precompute_matrix();
 
@@ -12,6 +12,8 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 EuclideanDistance::EuclideanDistance() : Distance()
@@ -76,6 +78,45 @@ float64_t EuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return std::sqrt(result);
 }
 
+bool EuclideanDistance::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	if (m_lhs_squared_norms.vlen!=lhs->get_num_vectors() ||
+		m_rhs_squared_norms.vlen!=rhs->get_num_vectors())
+		return false;
+
+	auto casted_lhs=std::static_pointer_cast<DotFeatures>(lhs);
+	auto casted_rhs=std::static_pointer_cast<DotFeatures>(rhs);
+
+	if (lhs->get_feature_class()==rhs->get_feature_class() || lhs->support_compatible_class())
+		casted_lhs->dot_block(lhs_idx, casted_rhs, rhs_idx, block);
+	else
+	{
+		SGMatrix<float64_t> transposed(rhs_idx.vlen, lhs_idx.vlen);
+		casted_rhs->dot_block(rhs_idx, casted_lhs, lhs_idx, transposed);
+		for (index_t j=0; j<rhs_idx.vlen; j++)
+		{
+			for (index_t i=0; i<lhs_idx.vlen; i++)
+				block(i, j)=transposed(j, i);
+		}
+	}
+
+	for (index_t j=0; j<rhs_idx.vlen; j++)
+	{
+		const float64_t sq_b=m_rhs_squared_norms[rhs_idx[j]];
+		for (index_t i=0; i<lhs_idx.vlen; i++)
+		{
+			// the expansion may become slightly negative for close vectors
+			const float64_t result=std::max(
+				m_lhs_squared_norms[lhs_idx[i]]+sq_b-2*block(i, j), 0.0);
+			block(i, j)=disable_sqrt ? result : std::sqrt(result);
+		}
+	}
+
+	return true;
+}
+
 void EuclideanDistance::precompute_lhs()
 {
 	require(lhs, "Left hand side feature cannot be NULL!");
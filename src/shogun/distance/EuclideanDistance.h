@@ -84,6 +84,18 @@ public:
 	 */
 	EDistanceType get_distance_type() override { return D_EUCLIDEAN; }
 
+	/** get the metric of linalg::pairwise_distance()
+	 *
+	 * @param metric Euclidean, or SquaredEuclidean if sqrt is disabled
+	 * @return true
+	 */
+	bool get_pairwise_metric(linalg::DistanceMetric& metric) const override
+	{
+		metric=disable_sqrt ? linalg::DistanceMetric::SquaredEuclidean
+			: linalg::DistanceMetric::Euclidean;
+		return true;
+	}
+
 	/** get feature class the distance can deal with
 	 *
 	 * @return feature class DENSE
@@ -176,6 +188,21 @@ protected:
 	/// in the corresponding feature object
 	float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+	/** compute a block of distances as
+	 * \f$\|{\bf x}\|^2+\|{\bf x'}\|^2-2{\bf x}^\top{\bf x'}\f$ from the
+	 * precomputed squared norms and a single DotFeatures::dot_block() (a
+	 * matrix-matrix product for dense features), see
+	 * Distance::compute_block()
+	 *
+	 * @param lhs_idx indices of the lhs vectors of the block
+	 * @param rhs_idx indices of the rhs vectors of the block
+	 * @param block preallocated block of the distance matrix
+	 * @return false if the squared norms are not precomputed
+	 */
+	bool compute_block(
+		const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+		SGMatrix<float64_t>& block) override;
+
 	/** if application of sqrt on matrix computation is disabled */
 	bool disable_sqrt;
 
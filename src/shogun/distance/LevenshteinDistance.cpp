@@ -6,6 +6,7 @@
  *
  */
 #include <algorithm>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/distance/LevenshteinDistance.h>
 #include <shogun/features/StringFeatures.h>
 
@@ -64,28 +65,112 @@ float64_t LevenshteinDistance::compute(int32_t idx_a, int32_t idx_b)
 float64_t LevenshteinDistance::compute_impl(
     const SGVector<char>& lhs_str, const SGVector<char>& rhs_str)
 {
-	int lhs_size = lhs_str.vlen, rhs_size = rhs_str.vlen;
-	SGMatrix<int> dist(lhs_size + 1, rhs_size + 1);
-	for (int i = 0; i <= lhs_size; ++i)
-		dist(i, 0) = i;
-	for (int i = 0; i <= rhs_size; ++i)
-		dist(0, i) = i;
-	for (int i = 1; i <= lhs_size; ++i)
+	// the shorter string is the pattern, it needs fewer words per column
+	if (lhs_str.vlen < rhs_str.vlen)
+		return bit_parallel_distance(
+		    match_masks(lhs_str), lhs_str.vlen, rhs_str);
+	return bit_parallel_distance(match_masks(rhs_str), rhs_str.vlen, lhs_str);
+}
+
+bool LevenshteinDistance::compute_block(
+    const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+    SGMatrix<float64_t>& block)
+{
+	auto casted_lhs = std::dynamic_pointer_cast<StringFeatures<char>>(lhs);
+	auto casted_rhs = std::dynamic_pointer_cast<StringFeatures<char>>(rhs);
+
+	// the side with fewer strings provides the patterns
+	const bool lhs_patterns = lhs_idx.vlen <= rhs_idx.vlen;
+	const auto& pattern_idx = lhs_patterns ? lhs_idx : rhs_idx;
+	const auto& text_idx = lhs_patterns ? rhs_idx : lhs_idx;
+	auto pattern_feats = lhs_patterns ? casted_lhs : casted_rhs;
+	auto text_feats = lhs_patterns ? casted_rhs : casted_lhs;
+
+	std::vector<SGVector<char>> patterns(pattern_idx.vlen);
+	for (index_t i = 0; i < pattern_idx.vlen; ++i)
+		patterns[i] = pattern_feats->get_feature_vector(pattern_idx[i]);
+	std::vector<SGVector<char>> texts(text_idx.vlen);
+	for (index_t j = 0; j < text_idx.vlen; ++j)
+		texts[j] = text_feats->get_feature_vector(text_idx[j]);
+
+	std::vector<std::vector<uint64_t>> masks(patterns.size());
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < pattern_idx.vlen; ++i)
+		masks[i] = match_masks(patterns[i]);
+
+	const int64_t total = int64_t(pattern_idx.vlen) * text_idx.vlen;
+#pragma omp parallel for num_threads(env()->get_num_threads()) schedule(dynamic, 64)
+	for (int64_t k = 0; k < total; ++k)
 	{
-		for (int j = 1; j <= rhs_size; ++j)
+		const index_t i = k / text_idx.vlen;
+		const index_t j = k % text_idx.vlen;
+		const float64_t dist =
+		    bit_parallel_distance(masks[i], patterns[i].vlen, texts[j]);
+		if (lhs_patterns)
+			block(i, j) = dist;
+		else
+			block(j, i) = dist;
+	}
+
+	return true;
+}
+
+std::vector<uint64_t>
+LevenshteinDistance::match_masks(const SGVector<char>& pattern)
+{
+	const int32_t num_words = (pattern.vlen + 63) / 64;
+	std::vector<uint64_t> masks(256 * int64_t(num_words), 0);
+	for (int32_t i = 0; i < pattern.vlen; ++i)
+		masks[(i / 64) * 256 + uint8_t(pattern[i])] |= uint64_t(1) << (i % 64);
+
+	return masks;
+}
+
+int32_t LevenshteinDistance::bit_parallel_distance(
+    const std::vector<uint64_t>& masks, int32_t pattern_len,
+    const SGVector<char>& text)
+{
+	if (pattern_len == 0)
+		return text.vlen;
+
+	// vertical differences of the column, +1 (pos) or -1 (neg) per row,
+	// initially the first column 0,1,...,m
+	const int32_t num_words = (pattern_len + 63) / 64;
+	std::vector<uint64_t> pos(num_words, ~uint64_t(0));
+	std::vector<uint64_t> neg(num_words, 0);
+	const uint64_t last_row = uint64_t(1) << ((pattern_len - 1) % 64);
+	const uint64_t high_bit = uint64_t(1) << 63;
+
+	int32_t score = pattern_len;
+	for (int32_t j = 0; j < text.vlen; ++j)
+	{
+		const uint64_t* eq_words = &masks[uint8_t(text[j])];
+		// horizontal difference entering the top of the word, the first
+		// row grows by one per text character
+		int32_t h_in = 1;
+		for (int32_t w = 0; w < num_words; ++w)
 		{
-			if (lhs_str[i - 1] == rhs_str[j - 1])
-			{
-				dist(i, j) = dist(i - 1, j - 1);
-			}
-			else
-			{
-				dist(i, j) = std::min(
-				                 dist(i - 1, j - 1),
-				                 std::min(dist(i - 1, j), dist(i, j - 1))) +
-				             1;
-			}
+			const uint64_t h_pos = h_in > 0;
+			const uint64_t h_neg = h_in < 0;
+			const uint64_t pv = pos[w], mv = neg[w];
+
+			uint64_t eq = eq_words[w * 256];
+			const uint64_t xv = eq | mv;
+			eq |= h_neg;
+			const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+			uint64_t ph = mv | ~(xh | pv);
+			uint64_t mh = pv & xh;
+
+			const uint64_t out = w == num_words - 1 ? last_row : high_bit;
+			h_in = int32_t((ph & out) != 0) - int32_t((mh & out) != 0);
+
+			ph = (ph << 1) | h_pos;
+			mh = (mh << 1) | h_neg;
+			pos[w] = mh | ~(xv | ph);
+			neg[w] = ph & xv;
 		}
+		score += h_in;
 	}
-	return dist(lhs_size, rhs_size);
-}
\ No newline at end of file
+
+	return score;
+}
@@ -14,6 +14,8 @@
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -22,6 +24,24 @@ namespace shogun
 	template <typename T>
 	class SGVector;
 
+	/** @brief Levenshtein (edit) distance between two strings, the
+	 * minimum number of insertions, deletions and substitutions of
+	 * characters that turn one string into the other.
+	 *
+	 * The distance is computed with the bit-parallel algorithm of Myers
+	 * (1999) in the blocked form of Hyyroe (2003): a column of the dynamic
+	 * programming table is encoded as vertical +1/-1 differences in 64 bit
+	 * words, and every character of the text updates 64 cells with a
+	 * constant number of word operations. This takes
+	 * \f$O(\lceil m/64\rceil n)\f$ time instead of \f$O(mn)\f$ for
+	 * strings of length m and n.
+	 *
+	 * compute_block() builds the match masks of every string of the
+	 * smaller side of a block once and evaluates it against all strings of
+	 * the other side in parallel, so that get_distance_block() with a few
+	 * queries against many strings (e.g. in KNN) does not repeat any work
+	 * per pair.
+	 */
 	class LevenshteinDistance : public Distance
 	{
 	public:
@@ -121,9 +141,32 @@ namespace shogun
 		/// in the corresponding feature object
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute a block of distances with the match masks of every
+		 * string built once, see Distance::compute_block()
+		 */
+		bool compute_block(
+		    const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+		    SGMatrix<float64_t>& block) override;
+
 	private:
 		float64_t
 		compute_impl(const SGVector<char>& lhs, const SGVector<char>& rhs);
+
+		/** @return bit masks of the positions of every byte value in the
+		 * pattern, 256 words for each block of 64 characters
+		 */
+		static std::vector<uint64_t>
+		match_masks(const SGVector<char>& pattern);
+
+		/** @return edit distance between pattern and text
+		 *
+		 * @param masks match masks of the pattern, see match_masks()
+		 * @param pattern_len length of the pattern
+		 * @param text text to compare the pattern with
+		 */
+		static int32_t bit_parallel_distance(
+		    const std::vector<uint64_t>& masks, int32_t pattern_len,
+		    const SGVector<char>& text);
 	};
 
 } // namespace shogun
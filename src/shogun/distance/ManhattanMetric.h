@@ -61,6 +61,17 @@ class ManhattanMetric: public DenseDistance<float64_t>
 		 */
 		EDistanceType get_distance_type() override { return D_MANHATTAN; }
 
+		/** get the metric of linalg::pairwise_distance()
+		 *
+		 * @param metric Manhattan
+		 * @return true
+		 */
+		bool get_pairwise_metric(linalg::DistanceMetric& metric) const override
+		{
+			metric=linalg::DistanceMetric::Manhattan;
+			return true;
+		}
+
 		/** get name of the distance
 		 *
 		 * @return name Manhattan-Metric
@@ -0,0 +1,130 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/distance/NeighborGraph.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/LinalgSpecialPurposes.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+NeighborGraph::NeighborGraph() : SGObject()
+{
+	init();
+}
+
+NeighborGraph::NeighborGraph(
+	const std::shared_ptr<Distance>& distance, int32_t max_k,
+	bool exclude_self)
+	: SGObject()
+{
+	init();
+	build(distance, max_k, exclude_self);
+}
+
+NeighborGraph::~NeighborGraph()
+{
+}
+
+void NeighborGraph::init()
+{
+	SG_ADD(&m_indices, "indices", "Indices of the nearest neighbours.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_distances, "distances", "Distances to the nearest neighbours.",
+		ParameterProperties::READONLY);
+}
+
+void NeighborGraph::build(
+	const std::shared_ptr<Distance>& distance, int32_t max_k,
+	bool exclude_self)
+{
+	require(distance, "Distance not set.");
+	require(distance->get_lhs() && distance->get_rhs(),
+		"Distance is not initialized.");
+
+	const index_t num_lhs=distance->get_num_vec_lhs();
+	const index_t num_rhs=distance->get_num_vec_rhs();
+	// one more candidate per vector covers the vector itself
+	const int32_t num_candidates=exclude_self ? max_k+1 : max_k;
+	require(max_k>0, "Number of neighbours ({}) must be positive.", max_k);
+	require(num_candidates<=num_lhs,
+		"Number of neighbours ({}) must be less than the number of vectors "
+		"({}).", max_k, num_lhs);
+	require(!exclude_self || num_lhs==num_rhs,
+		"Excluding the vectors themselves requires the same number of lhs "
+		"({}) and rhs ({}) vectors.", num_lhs, num_rhs);
+
+	m_indices=SGMatrix<index_t>(max_k, num_rhs);
+	m_distances=SGMatrix<float64_t>(max_k, num_rhs);
+
+	distance->precompute_lhs();
+	distance->precompute_rhs();
+
+	SGVector<index_t> lhs_idx(num_lhs);
+	lhs_idx.range_fill();
+	const index_t block_size=128;
+	const index_t num_blocks=(num_rhs+block_size-1)/block_size;
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		const index_t begin=b*block_size;
+		SGVector<index_t> rhs_idx(std::min(block_size, num_rhs-begin));
+		rhs_idx.range_fill(begin);
+
+		auto block=distance->get_distance_block(lhs_idx, rhs_idx);
+		auto block_nn=linalg::colwise_k_smallest(block, num_candidates);
+
+#pragma omp parallel for num_threads(env()->get_num_threads())
+		for (index_t j=0; j<rhs_idx.vlen; j++)
+		{
+			const index_t* candidates=block_nn.get_column_vector(j);
+			index_t* indices=m_indices.get_column_vector(begin+j);
+			float64_t* distances=m_distances.get_column_vector(begin+j);
+			for (int32_t i=0, n=0; i<num_candidates && n<max_k; i++)
+			{
+				// without the vector itself in the list the last candidate
+				// is dropped
+				if (exclude_self && candidates[i]==begin+j)
+					continue;
+				indices[n]=candidates[i];
+				distances[n]=block(candidates[i], j);
+				n++;
+			}
+		}
+	}
+
+	distance->reset_precompute();
+}
+
+SGMatrix<index_t> NeighborGraph::get_neighbors(int32_t k) const
+{
+	require(k>0 && k<=get_max_k(),
+		"Number of neighbours ({}) must be in [1, {}].", k, get_max_k());
+	if (k==get_max_k())
+		return m_indices;
+
+	SGMatrix<index_t> result(k, get_num_vectors());
+	for (index_t j=0; j<get_num_vectors(); j++)
+		std::copy_n(m_indices.get_column_vector(j), k, result.get_column_vector(j));
+
+	return result;
+}
+
+SGMatrix<float64_t> NeighborGraph::get_distances(int32_t k) const
+{
+	require(k>0 && k<=get_max_k(),
+		"Number of neighbours ({}) must be in [1, {}].", k, get_max_k());
+	if (k==get_max_k())
+		return m_distances;
+
+	SGMatrix<float64_t> result(k, get_num_vectors());
+	for (index_t j=0; j<get_num_vectors(); j++)
+		std::copy_n(m_distances.get_column_vector(j), k, result.get_column_vector(j));
+
+	return result;
+}
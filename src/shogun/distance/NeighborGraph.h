@@ -0,0 +1,100 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _NEIGHBORGRAPH_H___
+#define _NEIGHBORGRAPH_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+class Distance;
+
+/** @brief Lists of the nearest neighbours of all rhs vectors of a Distance.
+ *
+ * build() finds the max_k closest lhs vectors of every rhs vector in one
+ * pass over blocks of the distance matrix and stores their indices and
+ * distances sorted by increasing distance. The neighbours for any smaller k
+ * are the first k rows of the lists, so a graph built once for the largest
+ * k of a sweep serves all smaller k without another search.
+ *
+ * When lhs and rhs are the same vectors, e.g. for the neighbourhood graph
+ * of an embedding, exclude_self drops every vector from its own list.
+ */
+class NeighborGraph : public SGObject
+{
+public:
+	/** default constructor */
+	NeighborGraph();
+
+	/** constructor, builds the graph
+	 *
+	 * @param distance initialized distance
+	 * @param max_k number of neighbours per rhs vector
+	 * @param exclude_self whether rhs vector i is not a neighbour of itself
+	 */
+	NeighborGraph(
+		const std::shared_ptr<Distance>& distance, int32_t max_k,
+		bool exclude_self=false);
+
+	~NeighborGraph() override;
+
+	/** find the max_k nearest lhs vectors of every rhs vector
+	 *
+	 * @param distance initialized distance
+	 * @param max_k number of neighbours per rhs vector
+	 * @param exclude_self whether rhs vector i is not a neighbour of itself
+	 */
+	void build(
+		const std::shared_ptr<Distance>& distance, int32_t max_k,
+		bool exclude_self=false);
+
+	/** @param k number of neighbours, at most get_max_k()
+	 * @return indices of the k nearest lhs vectors, k rows and one column
+	 * per rhs vector, closest first
+	 */
+	SGMatrix<index_t> get_neighbors(int32_t k) const;
+
+	/** @param k number of neighbours, at most get_max_k()
+	 * @return distances to the k nearest lhs vectors, same layout as
+	 * get_neighbors()
+	 */
+	SGMatrix<float64_t> get_distances(int32_t k) const;
+
+	/** @return number of neighbours per rhs vector */
+	int32_t get_max_k() const
+	{
+		return m_indices.num_rows;
+	}
+
+	/** @return number of rhs vectors */
+	index_t get_num_vectors() const
+	{
+		return m_indices.num_cols;
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "NeighborGraph";
+	}
+
+private:
+	void init();
+
+protected:
+	/** neighbour indices, max_k x num_vectors */
+	SGMatrix<index_t> m_indices;
+
+	/** neighbour distances, max_k x num_vectors */
+	SGMatrix<float64_t> m_distances;
+};
+}
+#endif /* _NEIGHBORGRAPH_H___ */
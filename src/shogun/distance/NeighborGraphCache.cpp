@@ -0,0 +1,94 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/distance/Distance.h>
+#include <shogun/distance/NeighborGraphCache.h>
+#include <shogun/features/Features.h>
+#include <shogun/features/SubsetStack.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+NeighborGraphCache::NeighborGraphCache() : SGObject()
+{
+	init();
+}
+
+NeighborGraphCache::NeighborGraphCache(int32_t max_k) : SGObject()
+{
+	init();
+	set_max_k(max_k);
+}
+
+NeighborGraphCache::~NeighborGraphCache()
+{
+}
+
+void NeighborGraphCache::init()
+{
+	m_max_k=1;
+
+	SG_ADD(&m_max_k, "max_k", "Number of neighbours to build the graphs for.",
+		ParameterProperties::SETTING);
+}
+
+std::vector<index_t> NeighborGraphCache::get_root_indices(
+	const std::shared_ptr<Features>& features)
+{
+	auto subset_stack=features->get_subset_stack();
+	std::vector<index_t> result(features->get_num_vectors());
+	for (index_t i=0; i<(index_t)result.size(); i++)
+		result[i]=subset_stack->subset_idx_conversion(i);
+
+	return result;
+}
+
+std::shared_ptr<NeighborGraph> NeighborGraphCache::get_graph(
+	const std::shared_ptr<Distance>& distance, int32_t k, bool exclude_self)
+{
+	require(distance, "Distance not set.");
+	require(distance->get_lhs() && distance->get_rhs(),
+		"Distance is not initialized.");
+
+	Key key(std::make_pair(get_root_indices(distance->get_lhs()),
+		get_root_indices(distance->get_rhs())), exclude_self);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it=m_graphs.find(key);
+		if (it!=m_graphs.end() && it->second->get_max_k()>=k)
+			return it->second;
+	}
+
+	// built without the lock, the folds of a cross-validation query
+	// different keys in parallel. max_k is capped by the number of vectors
+	const int32_t max_k=std::min<int32_t>(m_max_k,
+		distance->get_num_vec_lhs()-(exclude_self ? 1 : 0));
+	auto graph=std::make_shared<NeighborGraph>(
+		distance, std::max(k, max_k), exclude_self);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_graphs[key]=graph;
+
+	return graph;
+}
+
+int32_t NeighborGraphCache::get_num_graphs() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_graphs.size();
+}
+
+void NeighborGraphCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_graphs.clear();
+}
+
+std::shared_ptr<SGObject> NeighborGraphCache::clone(ParameterProperties pp) const
+{
+	return std::const_pointer_cast<SGObject>(shared_from_this());
+}
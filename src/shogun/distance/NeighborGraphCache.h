@@ -0,0 +1,122 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _NEIGHBORGRAPHCACHE_H___
+#define _NEIGHBORGRAPHCACHE_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/distance/NeighborGraph.h>
+#include <shogun/lib/common.h>
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace shogun
+{
+class Distance;
+class Features;
+
+/** @brief Cache of neighbour graphs of subsets of one data set.
+ *
+ * The graphs are keyed by the vectors that the lhs and rhs of a distance
+ * select from the data set, i.e. by their indices through all subsets. A
+ * cross-validation fold trains on and applies to views of the same features
+ * whatever k is evaluated, so with the cache attached to a KNN, see
+ * KNN::set_neighbor_cache(), every fold searches the neighbours only once for
+ * a whole sweep over k. Set max_k to the largest k of the sweep, otherwise a
+ * larger k rebuilds the graph of the fold.
+ *
+ * Clones of the cache, e.g. of the machine in each cross-validation fold,
+ * are the cache itself, and the graphs are looked up and stored under a lock.
+ * The cache belongs to one data set and one distance, clear() it when either
+ * changes.
+ */
+class NeighborGraphCache : public SGObject
+{
+public:
+	/** default constructor */
+	NeighborGraphCache();
+
+	/** constructor
+	 *
+	 * @param max_k number of neighbours to build the graphs for
+	 */
+	NeighborGraphCache(int32_t max_k);
+
+	~NeighborGraphCache() override;
+
+	/** get the graph of the current lhs and rhs of a distance, building it
+	 * for max(k, max_k) neighbours if it is not cached yet
+	 *
+	 * @param distance initialized distance
+	 * @param k number of required neighbours
+	 * @param exclude_self passed to NeighborGraph::build()
+	 * @return graph of at least k neighbours
+	 */
+	std::shared_ptr<NeighborGraph> get_graph(
+		const std::shared_ptr<Distance>& distance, int32_t k,
+		bool exclude_self=false);
+
+	/** @return number of cached graphs */
+	int32_t get_num_graphs() const;
+
+	/** remove all graphs */
+	void clear();
+
+	/** @param max_k number of neighbours to build the graphs for */
+	void set_max_k(int32_t max_k)
+	{
+		require(max_k>0, "Number of neighbours ({}) must be positive.", max_k);
+		m_max_k=max_k;
+	}
+
+	/** @return number of neighbours to build the graphs for */
+	int32_t get_max_k() const
+	{
+		return m_max_k;
+	}
+
+	/** the cache is shared, a clone is the cache itself
+	 *
+	 * @return this cache
+	 */
+	std::shared_ptr<SGObject> clone(
+		ParameterProperties pp=ParameterProperties::ALL) const override;
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "NeighborGraphCache";
+	}
+
+private:
+	void init();
+
+	/** lhs and rhs vectors of the data set and exclude_self */
+	typedef std::pair<
+		std::pair<std::vector<index_t>, std::vector<index_t>>, bool> Key;
+
+	/** @return indices of the vectors of features in the data set */
+	static std::vector<index_t> get_root_indices(
+		const std::shared_ptr<Features>& features);
+
+protected:
+	/** number of neighbours to build the graphs for */
+	int32_t m_max_k;
+
+private:
+	/** cached graphs */
+	std::map<Key, std::shared_ptr<NeighborGraph>> m_graphs;
+
+	/** guards m_graphs */
+	mutable std::mutex m_mutex;
+};
+}
+#endif /* _NEIGHBORGRAPHCACHE_H___ */
@@ -0,0 +1,117 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/distance/PQDistance.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+PQDistance::PQDistance() : Distance()
+{
+	disable_sqrt=false;
+	SG_ADD(&disable_sqrt, "disable_sqrt", "If sqrt shall not be applied.",
+		ParameterProperties::SETTING);
+}
+
+PQDistance::PQDistance(
+	const std::shared_ptr<PQDenseFeatures>& l,
+	const std::shared_ptr<Features>& r)
+	: PQDistance()
+{
+	init(l, r);
+}
+
+PQDistance::~PQDistance()
+{
+	cleanup();
+}
+
+bool PQDistance::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	return Distance::init(l, r);
+}
+
+bool PQDistance::check_compatibility(
+	std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	require(l, "Left hand side features must be set!");
+	require(r, "Right hand side features must be set!");
+	require(l->get_feature_class()==C_PQ,
+		"Left hand side features ({}) must be PQDenseFeatures!", l->get_name());
+
+	const auto dim=l->as<PQDenseFeatures>()->get_dim();
+	if (r->get_feature_class()==C_PQ)
+	{
+		require(r->as<PQDenseFeatures>()->get_dim()==dim,
+			"Dimension mismatch (l:{} vs. r:{})!", dim,
+			r->as<PQDenseFeatures>()->get_dim());
+	}
+	else
+	{
+		require(r->get_feature_class()==C_DENSE && r->get_feature_type()==F_DREAL,
+			"Right hand side features ({}) must be dense real or "
+			"PQDenseFeatures!", r->get_name());
+		require(r->as<DenseFeatures<float64_t>>()->get_num_features()==dim,
+			"Dimension mismatch (l:{} vs. r:{})!", dim,
+			r->as<DenseFeatures<float64_t>>()->get_num_features());
+	}
+
+	return true;
+}
+
+void PQDistance::cleanup()
+{
+}
+
+SGVector<float64_t> PQDistance::get_query(int32_t idx) const
+{
+	if (rhs->get_feature_class()==C_PQ)
+		return rhs->as<PQDenseFeatures>()->decode(idx);
+
+	auto features=rhs->as<DenseFeatures<float64_t>>();
+	auto vec=features->get_feature_vector(idx);
+	auto query=vec.clone();
+	features->free_feature_vector(vec, idx);
+
+	return query;
+}
+
+float64_t PQDistance::compute(int32_t idx_a, int32_t idx_b)
+{
+	auto codes=lhs->as<PQDenseFeatures>();
+	auto query=get_query(idx_b);
+	auto reconstruction=codes->decode(idx_a);
+
+	float64_t result=0;
+	for (index_t d=0; d<query.vlen; d++)
+		result+=Math::sq(query[d]-reconstruction[d]);
+
+	return disable_sqrt ? result : std::sqrt(result);
+}
+
+bool PQDistance::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto codes=lhs->as<PQDenseFeatures>();
+
+#pragma omp parallel for
+	for (index_t j=0; j<rhs_idx.vlen; j++)
+	{
+		auto query=get_query(rhs_idx[j]);
+		auto table=codes->compute_lookup_table(query.vector);
+		float64_t* column=block.get_column_vector(j);
+		for (index_t i=0; i<lhs_idx.vlen; i++)
+		{
+			const float64_t result=codes->asymmetric_distance(table, lhs_idx[i]);
+			column[i]=disable_sqrt ? result : std::sqrt(result);
+		}
+	}
+
+	return true;
+}
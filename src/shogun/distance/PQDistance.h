@@ -0,0 +1,133 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _PQDISTANCE_H___
+#define _PQDISTANCE_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/distance/Distance.h>
+#include <shogun/features/PQDenseFeatures.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+/** @brief class PQDistance
+ *
+ * Approximate Euclidean distance of dense real queries to product quantized
+ * vectors, see PQDenseFeatures. The lhs are PQDenseFeatures, the rhs are
+ * DenseFeatures<float64_t> of the same dimension, or PQDenseFeatures which
+ * are decoded to their reconstruction.
+ *
+ * The distance of query \f$\bf{x}\f$ to the encoded vector with codes
+ * \f$c_1,\dots,c_m\f$ is
+ *
+ * \f[\displaystyle
+ *  d(\bf{x},c) = \sqrt{\sum_{s=1}^{m} \|\bf{x}_s-\bf{q}_{s,c_s}\|^2}
+ * \f]
+ *
+ * where \f$\bf{x}_s\f$ is the s-th subvector of the query and
+ * \f$\bf{q}_{s,c}\f$ the c-th centroid of subspace s. Blocks of distances
+ * compute one lookup table per query and then only sum m table entries per
+ * encoded vector, so e.g. the brute force KNN solver scans the compressed
+ * vectors without decoding them.
+ */
+class PQDistance: public Distance
+{
+	public:
+		/** default constructor */
+		PQDistance();
+
+		/** constructor
+		 *
+		 * @param l product quantized features of left-hand side
+		 * @param r features of right-hand side
+		 */
+		PQDistance(
+			const std::shared_ptr<PQDenseFeatures>& l,
+			const std::shared_ptr<Features>& r);
+		~PQDistance() override;
+
+		/** init distance
+		 *
+		 * @param l features of left-hand side
+		 * @param r features of right-hand side
+		 * @return if init was successful
+		 */
+		bool init(std::shared_ptr<Features> l, std::shared_ptr<Features> r) override;
+
+		/** check that the lhs are product quantized and the rhs are dense
+		 * real or product quantized features of the same dimension
+		 *
+		 * @param l features of left-hand side
+		 * @param r features of right-hand side
+		 * @return if features are compatible
+		 */
+		bool check_compatibility(
+			std::shared_ptr<Features> l, std::shared_ptr<Features> r) override;
+
+		/** cleanup distance */
+		void cleanup() override;
+
+		/** get distance type we are
+		 *
+		 * @return distance type PQ
+		 */
+		EDistanceType get_distance_type() override { return D_PQ; }
+
+		/** get feature type the distance can deal with
+		 *
+		 * @return feature type BYTE
+		 */
+		EFeatureType get_feature_type() override { return F_BYTE; }
+
+		/** get feature class the distance can deal with
+		 *
+		 * @return feature class PQ
+		 */
+		EFeatureClass get_feature_class() override { return C_PQ; }
+
+		/** @param state whether the squared distance is returned */
+		void set_disable_sqrt(bool state) { disable_sqrt=state; }
+
+		/** @return whether the squared distance is returned */
+		bool get_disable_sqrt() const { return disable_sqrt; }
+
+		/** get name of the distance
+		 *
+		 * @return name PQDistance
+		 */
+		const char* get_name() const override { return "PQDistance"; }
+
+	protected:
+		/// compute distance for features a and b
+		/// idx_{a,b} denote the index of the feature vectors
+		/// in the corresponding feature object
+		float64_t compute(int32_t idx_a, int32_t idx_b) override;
+
+		/** compute a block of distances with one lookup table per rhs
+		 * vector, see Distance::compute_block()
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the distance matrix
+		 * @return true
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
+	private:
+		/** @return rhs vector idx, decoded if the rhs are product quantized */
+		SGVector<float64_t> get_query(int32_t idx) const;
+
+	protected:
+		/** whether the squared distance is returned */
+		bool disable_sqrt;
+};
+
+} // namespace shogun
+#endif /* _PQDISTANCE_H___ */
@@ -10,6 +10,8 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/SparseFeatures.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 SparseEuclideanDistance::SparseEuclideanDistance()
@@ -70,6 +72,27 @@ float64_t SparseEuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return std::sqrt(result);
 }
 
+bool SparseEuclideanDistance::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto sf_lhs=std::static_pointer_cast<SparseFeatures<float64_t>>(lhs);
+	auto sf_rhs=std::static_pointer_cast<SparseFeatures<float64_t>>(rhs);
+	sf_lhs->dot_block(lhs_idx, sf_rhs, rhs_idx, block);
+
+	for (index_t j=0; j<rhs_idx.vlen; j++)
+	{
+		const float64_t sq_b=sq_rhs[rhs_idx[j]];
+		for (index_t i=0; i<lhs_idx.vlen; i++)
+		{
+			const float64_t sq_dist=sq_lhs[lhs_idx[i]]+sq_b-2*block(i, j);
+			block(i, j)=std::sqrt(std::max(sq_dist, 0.0));
+		}
+	}
+
+	return true;
+}
+
 void SparseEuclideanDistance::init()
 {
 	sq_lhs=NULL;
@@ -68,6 +68,18 @@ class SparseEuclideanDistance: public SparseDistance<float64_t>
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 		/*    compute_kernel*/
 
+		/** compute a block of distances from a single sparse matrix product
+		 * and the precomputed squared norms, see Distance::compute_block()
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the distance matrix
+		 * @return true
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 	private:
 		void init();
 
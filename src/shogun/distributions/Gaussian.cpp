@@ -248,7 +248,7 @@ float64_t Gaussian::compute_log_PDF(SGVector<float64_t> point)
 		    CblasRowMajor, CblasNoTrans, m_d.vlen, m_d.vlen, 1, m_u.matrix,
 		    m_d.vlen, difference, 1, 0, temp_holder, 1);
 #else
-		linalg::dgemv<float64_t>(1, m_u, false, difference, 0, temp_holder);
+		linalg::dgemv<float64_t>(1, m_u, true, difference, 0, temp_holder);
 #endif
 
 		for (int32_t i=0; i<m_d.vlen; i++)
@@ -319,8 +319,8 @@ SGMatrix<float64_t> Gaussian::get_cov()
 		    cov.matrix, m_d.vlen);
 #else
 		linalg::dgemm<float64_t>(
-		    1, m_u, diag_holder, true, false, 0, temp_holder);
-		linalg::dgemm<float64_t>(1, temp_holder, m_u, false, false, 0, cov);
+		    1, m_u, diag_holder, false, false, 0, temp_holder);
+		linalg::dgemm<float64_t>(1, temp_holder, m_u, false, true, 0, cov);
 #endif
 	}
 	else if (m_cov_type == DIAG)
@@ -7,6 +7,7 @@
  */
 #include <shogun/distributions/HMM.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/config.h>
@@ -187,7 +188,7 @@ HMM::HMM(const std::shared_ptr<HMM>& h)
 : RandomMixin<Distribution>(), iterations(150), epsilon(1e-4), conv_it(5)
 {
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	io::info("hmm is using {} separate tables",  env()->get_num_threads());
+	io::info("hmm is using {} separate tables",  env()->get_max_num_threads());
 #endif
 
 	this->N=h->get_N();
@@ -205,7 +206,7 @@ HMM::HMM(int32_t p_N, int32_t p_M, Model* p_model, float64_t p_PSEUDO)
 	model=NULL ;
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	io::info("hmm is using {} separate tables",  env()->get_num_threads());
+	io::info("hmm is using {} separate tables",  env()->get_max_num_threads());
 #endif
 
 	status=initialize_hmm(p_model, p_PSEUDO);
@@ -222,7 +223,7 @@ HMM::HMM(
 	model=NULL ;
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	io::info("hmm is using {} separate tables",  env()->get_num_threads());
+	io::info("hmm is using {} separate tables",  env()->get_max_num_threads());
 #endif
 
 	initialize_hmm(model, p_PSEUDO);
@@ -393,7 +394,7 @@ HMM::HMM(FILE* model_file, float64_t p_PSEUDO)
 : RandomMixin<Distribution>(), iterations(150), epsilon(1e-4), conv_it(5)
 {
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	io::info("hmm is using {} separate tables",  env()->get_num_threads());
+	io::info("hmm is using {} separate tables",  env()->get_max_num_threads());
 #endif
 
 	status=initialize_hmm(NULL, p_PSEUDO, model_file);
@@ -436,7 +437,7 @@ HMM::~HMM()
 #ifdef USE_HMMPARALLEL_STRUCTURES
 		if (mem_initialized)
 		{
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 			{
 				SG_FREE(alpha_cache[i].table);
 				SG_FREE(beta_cache[i].table);
@@ -464,7 +465,7 @@ HMM::~HMM()
 	{
 		if (mem_initialized)
 		{
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 				SG_FREE(arrayS[i]);
 		}
 		SG_FREE(arrayS);
@@ -481,7 +482,7 @@ HMM::~HMM()
 		{
 			SG_FREE(path_prob_updated);
 			SG_FREE(path_prob_dimension);
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 				SG_FREE(path[i]);
 		}
 #endif //USE_HMMPARALLEL_STRUCTURES
@@ -518,7 +519,7 @@ bool HMM::alloc_state_dependend_arrays()
 	}
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	for (int32_t i=0; i<env()->get_num_threads(); i++)
+	for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 	{
 		arrayN1[i]=SG_MALLOC(float64_t, N);
 		arrayN2[i]=SG_MALLOC(float64_t, N);
@@ -530,7 +531,7 @@ bool HMM::alloc_state_dependend_arrays()
 
 #ifdef LOG_SUMARRAY
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	for (int32_t i=0; i<env()->get_num_threads(); i++)
+	for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 		arrayS[i]=SG_MALLOC(float64_t, (int32_t)(this->N/2+1));
 #else //USE_HMMPARALLEL_STRUCTURES
 	arrayS=SG_MALLOC(float64_t, (int32_t)(this->N/2+1));
@@ -565,7 +566,7 @@ void HMM::free_state_dependend_arrays()
 #ifdef USE_HMMPARALLEL_STRUCTURES
 	if (arrayN1 && arrayN2)
 	{
-		for (int32_t i=0; i<env()->get_num_threads(); i++)
+		for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 		{
 			SG_FREE(arrayN1[i]);
 			SG_FREE(arrayN2[i]);
@@ -621,11 +622,11 @@ bool HMM::initialize_hmm(Model* m, float64_t pseudo, FILE* modelfile)
 	this->reused_caches=false;
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	alpha_cache=SG_MALLOC(T_ALPHA_BETA, env()->get_num_threads());
-	beta_cache=SG_MALLOC(T_ALPHA_BETA, env()->get_num_threads());
-	states_per_observation_psi=SG_MALLOC(P_STATES, env()->get_num_threads());
+	alpha_cache=SG_MALLOC(T_ALPHA_BETA, env()->get_max_num_threads());
+	beta_cache=SG_MALLOC(T_ALPHA_BETA, env()->get_max_num_threads());
+	states_per_observation_psi=SG_MALLOC(P_STATES, env()->get_max_num_threads());
 
-	for (int32_t i=0; i<env()->get_num_threads(); i++)
+	for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 	{
 		this->alpha_cache[i].table=NULL;
 		this->beta_cache[i].table=NULL;
@@ -646,12 +647,12 @@ bool HMM::initialize_hmm(Model* m, float64_t pseudo, FILE* modelfile)
 		files_ok= files_ok && load_model(modelfile);
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	path_prob_updated=SG_MALLOC(bool, env()->get_num_threads());
-	path_prob_dimension=SG_MALLOC(int, env()->get_num_threads());
+	path_prob_updated=SG_MALLOC(bool, env()->get_max_num_threads());
+	path_prob_dimension=SG_MALLOC(int, env()->get_max_num_threads());
 
-	path=SG_MALLOC(P_STATES, env()->get_num_threads());
+	path=SG_MALLOC(P_STATES, env()->get_max_num_threads());
 
-	for (int32_t i=0; i<env()->get_num_threads(); i++)
+	for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 		this->path[i]=NULL;
 
 #else // USE_HMMPARALLEL_STRUCTURES
@@ -660,13 +661,13 @@ bool HMM::initialize_hmm(Model* m, float64_t pseudo, FILE* modelfile)
 #endif //USE_HMMPARALLEL_STRUCTURES
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	arrayN1=SG_MALLOC(float64_t*, env()->get_num_threads());
-	arrayN2=SG_MALLOC(float64_t*, env()->get_num_threads());
+	arrayN1=SG_MALLOC(float64_t*, env()->get_max_num_threads());
+	arrayN2=SG_MALLOC(float64_t*, env()->get_max_num_threads());
 #endif //USE_HMMPARALLEL_STRUCTURES
 
 #ifdef LOG_SUMARRAY
 #ifdef USE_HMMPARALLEL_STRUCTURES
-	arrayS=SG_MALLOC(float64_t*, env()->get_num_threads());
+	arrayS=SG_MALLOC(float64_t*, env()->get_max_num_threads());
 #endif // USE_HMMPARALLEL_STRUCTURES
 #endif //LOG_SUMARRAY
 
@@ -1281,81 +1282,172 @@ float64_t HMM::best_path(int32_t dimension)
 	}
 }
 
-#ifndef USE_HMMPARALLEL
-float64_t HMM::model_probability_comp()
+namespace
 {
-	//for faster calculation cache model probability
-	mod_prob=0 ;
-	for (int32_t dim=0; dim<p_observations->get_num_vectors(); dim++) //sum in log space
-		mod_prob+=forward(p_observations->get_vector_length(dim), 0, dim);
-
-	mod_prob_updated=true;
-	return mod_prob;
-}
-
-#else
+	/** parameters of a HMM as probabilities, for the scaled forward and
+	 * backward recursions */
+	struct ScaledModel
+	{
+		ScaledModel(const HMM& hmm)
+		{
+			const int32_t N=hmm.get_N();
+			const int32_t M=hmm.get_M();
+			p.resize(N);
+			q.resize(N);
+			a.resize(N, N);
+			b.resize(N, M);
+			for (int32_t i=0; i<N; i++)
+			{
+				p[i]=std::exp(hmm.get_p(i));
+				q[i]=std::exp(hmm.get_q(i));
+				for (int32_t j=0; j<N; j++)
+					a(i, j)=std::exp(hmm.get_a(i, j));
+				for (int32_t j=0; j<M; j++)
+					b(i, j)=std::exp(hmm.get_b(i, j));
+			}
+		}
 
-float64_t HMM::model_probability_comp()
-{
-	std::vector<S_BW_THREAD_PARAM> params(env()->get_num_threads());
+		Eigen::VectorXd p;
+		Eigen::VectorXd q;
+		Eigen::MatrixXd a;
+		Eigen::MatrixXd b;
+	};
+
+	/** buffers of one thread, grown to the longest sequence */
+	struct ScaledWorkspace
+	{
+		/** normalized forward variables, one column per time step */
+		Eigen::MatrixXd alpha;
+		/** normalizers of the forward variables */
+		Eigen::VectorXd scale;
+		/** emission weighted normalized backward variables */
+		Eigen::MatrixXd weighted_beta;
+		Eigen::VectorXd beta;
+		Eigen::VectorXd gamma;
+	};
+
+	/** expected counts of the Baum-Welch algorithm */
+	struct ExpectedCounts
+	{
+		ExpectedCounts(int32_t N, int32_t M)
+		    : p(Eigen::VectorXd::Zero(N)), q(Eigen::VectorXd::Zero(N)),
+		      a(Eigen::MatrixXd::Zero(N, N)), b(Eigen::MatrixXd::Zero(N, M)),
+		      log_likelihood(0)
+		{
+		}
 
-	io::info("computing full model probablity");
-	mod_prob=0;
+		Eigen::VectorXd p;
+		Eigen::VectorXd q;
+		Eigen::MatrixXd a;
+		Eigen::MatrixXd b;
+		float64_t log_likelihood;
+	};
+
+	/** Forward algorithm with the forward variables normalized to sum to
+	 * one at every time step, as matrix-vector products over the states.
+	 *
+	 * @return log probability of the sequence, -infinity if impossible
+	 */
+	float64_t scaled_forward(
+	    const ScaledModel& model, const uint16_t* obs, int32_t len,
+	    ScaledWorkspace& ws)
+	{
+		const auto N=model.p.size();
+		if (ws.alpha.cols()<len)
+		{
+			ws.alpha.resize(N, len);
+			ws.scale.resize(len);
+		}
 
-	std::vector<std::thread> threads;
-	threads.reserve(env()->get_num_threads());
+		float64_t log_likelihood=0;
+		for (int32_t t=0; t<len; t++)
+		{
+			if (t==0)
+				ws.alpha.col(0)=model.p.cwiseProduct(model.b.col(obs[0]));
+			else
+				ws.alpha.col(t).noalias()=(model.a.transpose()*ws.alpha.col(t-1)).cwiseProduct(model.b.col(obs[t]));
+
+			const float64_t scale=ws.alpha.col(t).sum();
+			if (!(scale>0))
+				return -Math::INFTY;
+			ws.alpha.col(t)/=scale;
+			ws.scale[t]=scale;
+			log_likelihood+=std::log(scale);
+		}
 
-	for (int32_t cpu=0; cpu<env()->get_num_threads(); cpu++)
-	{
-		params[cpu].hmm=shared_from_base<HMM>();
-		params[cpu].dim_start= p_observations->get_num_vectors()*cpu/env()->get_num_threads();
-		params[cpu].dim_stop= p_observations->get_num_vectors()*(cpu+1)/env()->get_num_threads();
-		params[cpu].p_buf=SG_MALLOC(float64_t, N);
-		params[cpu].q_buf=SG_MALLOC(float64_t, N);
-		params[cpu].a_buf=SG_MALLOC(float64_t, N*N);
-		params[cpu].b_buf=SG_MALLOC(float64_t, N*M);
-		threads.emplace_back([&p=params[cpu], this](){bw_dim_prefetch(&p);});
+		const float64_t end=ws.alpha.col(len-1).dot(model.q);
+		if (!(end>0))
+			return -Math::INFTY;
+		return log_likelihood+std::log(end);
 	}
 
-	for (int32_t cpu=0; cpu<env()->get_num_threads(); cpu++)
+	/** Adds the expected counts of a sequence, computed with the scaled
+	 * forward and backward recursions. The expected transitions are one
+	 * matrix product of the forward and the backward variables of all time
+	 * steps.
+	 */
+	void add_expected_counts(
+	    const ScaledModel& model, const uint16_t* obs, int32_t len,
+	    ScaledWorkspace& ws, ExpectedCounts& counts)
 	{
-		threads[cpu].join();	
-		mod_prob+=params[cpu].ret;
+		const auto N=model.p.size();
+		const float64_t log_likelihood=scaled_forward(model, obs, len, ws);
+		counts.log_likelihood+=log_likelihood;
+		if (log_likelihood==-Math::INFTY)
+			return;
+
+		if (ws.weighted_beta.cols()<len)
+			ws.weighted_beta.resize(N, len);
+
+		ws.beta=model.q/ws.alpha.col(len-1).dot(model.q);
+		ws.gamma=ws.alpha.col(len-1).cwiseProduct(ws.beta);
+		counts.q+=ws.gamma;
+		counts.b.col(obs[len-1])+=ws.gamma;
+
+		for (int32_t t=len-2; t>=0; t--)
+		{
+			ws.weighted_beta.col(t)=model.b.col(obs[t+1]).cwiseProduct(ws.beta)/ws.scale[t+1];
+			ws.beta.noalias()=model.a*ws.weighted_beta.col(t);
+			ws.gamma=ws.alpha.col(t).cwiseProduct(ws.beta);
+			counts.b.col(obs[t])+=ws.gamma;
+		}
+		counts.p+=ws.gamma;
+
+		if (len>1)
+		{
+			counts.a+=(ws.alpha.leftCols(len-1)*ws.weighted_beta.leftCols(len-1).transpose()).cwiseProduct(model.a);
+		}
 	}
+} // namespace
 
-	for (int32_t i=0; i<env()->get_num_threads(); i++)
+float64_t HMM::model_probability_comp()
+{
+	//for faster calculation cache model probability
+	const ScaledModel model(*this);
+	const int32_t num_vectors=p_observations->get_num_vectors();
+	float64_t sum=0;
+
+#pragma omp parallel num_threads(env()->get_num_threads()) reduction(+:sum)
 	{
-		SG_FREE(params[i].p_buf);
-		SG_FREE(params[i].q_buf);
-		SG_FREE(params[i].a_buf);
-		SG_FREE(params[i].b_buf);
+		ScaledWorkspace ws;
+#pragma omp for schedule(dynamic)
+		for (int32_t dim=0; dim<num_vectors; dim++)
+		{
+			int32_t len=0;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+			if (len>0)
+				sum+=scaled_forward(model, obs, len, ws);
+			p_observations->free_feature_vector(obs, dim, free_vec);
+		}
 	}
 
+	mod_prob=sum;
 	mod_prob_updated=true;
 	return mod_prob;
 }
 
-void HMM::bw_dim_prefetch(S_BW_THREAD_PARAM* params)
-{
-	auto hmm=params->hmm;
-	int32_t start=params->dim_start;
-	int32_t stop=params->dim_stop;
-	float64_t* p_buf=params->p_buf;
-	float64_t* q_buf=params->q_buf;
-	float64_t* a_buf=params->a_buf;
-	float64_t* b_buf=params->b_buf;
-	params->ret=0;
-
-	for (int32_t dim=start; dim<stop; dim++)
-	{
-		hmm->forward_comp(hmm->p_observations->get_vector_length(dim), hmm->N-1, dim) ;
-		hmm->backward_comp(hmm->p_observations->get_vector_length(dim), hmm->N-1, dim) ;
-		float64_t modprob=hmm->model_probability(dim) ;
-		hmm->ab_buf_comp(p_buf, q_buf, a_buf, b_buf, dim) ;
-		params->ret+= modprob;
-	}
-}
-
+#ifdef USE_HMMPARALLEL
 void HMM::bw_single_dim_prefetch(S_DIM_THREAD_PARAM* params)
 {
 	auto hmm=params->hmm ;
@@ -1369,240 +1461,74 @@ void HMM::vit_dim_prefetch(S_DIM_THREAD_PARAM* params)
 	int32_t dim=params->dim ;
 	params->prob_sum = hmm->best_path(dim);
 }
-
 #endif //USE_HMMPARALLEL
 
-
-#ifdef USE_HMMPARALLEL
-
-void HMM::ab_buf_comp(
-	float64_t* p_buf, float64_t* q_buf, float64_t *a_buf, float64_t* b_buf,
-	int32_t dim)
+//estimates new model lambda out of lambda_estimate using baum welch algorithm
+void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>& estimate)
 {
-	int32_t i,j,t ;
-	float64_t a_sum;
-	float64_t b_sum;
-
-	float64_t dimmodprob=model_probability(dim);
-
-	for (i=0; i<N; i++)
-	{
-		//estimate initial+end state distribution numerator
-		p_buf[i]=get_p(i)+get_b(i,p_observations->get_feature(dim,0))+backward(0,i,dim) - dimmodprob;
-		q_buf[i]=forward(p_observations->get_vector_length(dim)-1, i, dim)+get_q(i) - dimmodprob;
-
-		//estimate a
-		for (j=0; j<N; j++)
+	// the expected counts are accumulated in probability space, with the
+	// sequences distributed dynamically over the threads and every thread
+	// adding up its own counts
+	const ScaledModel model(*estimate);
+	const int32_t num_vectors=p_observations->get_num_vectors();
+	ExpectedCounts counts(N, M);
+
+#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		ScaledWorkspace ws;
+		ExpectedCounts thread_counts(N, M);
+#pragma omp for schedule(dynamic)
+		for (int32_t dim=0; dim<num_vectors; dim++)
 		{
-			a_sum=-Math::INFTY;
-
-			for (t=0; t<p_observations->get_vector_length(dim)-1; t++)
-			{
-				a_sum= Math::logarithmic_sum(a_sum, forward(t,i,dim)+
-						get_a(i,j)+get_b(j,p_observations->get_feature(dim,t+1))+backward(t+1,j,dim));
-			}
-			a_buf[N*i+j]=a_sum-dimmodprob ;
+			int32_t len=0;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+			if (len>0)
+				add_expected_counts(model, obs, len, ws, thread_counts);
+			p_observations->free_feature_vector(obs, dim, free_vec);
 		}
 
-		//estimate b
-		for (j=0; j<M; j++)
+#pragma omp critical
 		{
-			b_sum=-Math::INFTY;
-
-			for (t=0; t<p_observations->get_vector_length(dim); t++)
-			{
-				if (p_observations->get_feature(dim,t)==j)
-					b_sum=Math::logarithmic_sum(b_sum, forward(t,i,dim)+backward(t, i, dim));
-			}
-
-			b_buf[M*i+j]=b_sum-dimmodprob ;
+			counts.p+=thread_counts.p;
+			counts.q+=thread_counts.q;
+			counts.a+=thread_counts.a;
+			counts.b+=thread_counts.b;
+			counts.log_likelihood+=thread_counts.log_likelihood;
 		}
 	}
-}
 
-//estimates new model lambda out of lambda_train using baum welch algorithm
-void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>&	hmm)
-{
-	int32_t i,j,cpu;
-	float64_t fullmodprob=0;	//for all dims
-
-	//clear actual model a,b,p,q are used as numerator
-	for (i=0; i<N; i++)
-	{
-	  if (hmm->get_p(i)>Math::ALMOST_NEG_INFTY)
-	    set_p(i,log(PSEUDO));
-	  else
-	    set_p(i,hmm->get_p(i));
-	  if (hmm->get_q(i)>Math::ALMOST_NEG_INFTY)
-	    set_q(i,log(PSEUDO));
-	  else
-	    set_q(i,hmm->get_q(i));
-
-	  for (j=0; j<N; j++)
-	    if (hmm->get_a(i,j)>Math::ALMOST_NEG_INFTY)
-	      set_a(i,j, log(PSEUDO));
-	    else
-	      set_a(i,j,hmm->get_a(i,j));
-	  for (j=0; j<M; j++)
-	    if (hmm->get_b(i,j)>Math::ALMOST_NEG_INFTY)
-	      set_b(i,j, log(PSEUDO));
-	    else
-	      set_b(i,j,hmm->get_b(i,j));
-	}
-	invalidate_model();
-
-	int32_t num_threads = env()->get_num_threads();
-
-	std::vector<S_BW_THREAD_PARAM> params(num_threads);
-
-	if (p_observations->get_num_vectors()<num_threads)
-		num_threads=p_observations->get_num_vectors();
-
-	std::vector<std::thread> threads;
-	threads.reserve(num_threads);
-
-	for (cpu=0; cpu<num_threads; cpu++)
-	{
-		params[cpu].p_buf=SG_MALLOC(float64_t, N);
-		params[cpu].q_buf=SG_MALLOC(float64_t, N);
-		params[cpu].a_buf=SG_MALLOC(float64_t, N*N);
-		params[cpu].b_buf=SG_MALLOC(float64_t, N*M);
-
-		params[cpu].hmm=hmm;
-		int32_t start = p_observations->get_num_vectors()*cpu / num_threads;
-		int32_t stop=p_observations->get_num_vectors()*(cpu+1) / num_threads;
-
-		if (cpu == env()->get_num_threads()-1)
-			stop=p_observations->get_num_vectors();
-
-		ASSERT(start<stop)
-		params[cpu].dim_start=start;
-		params[cpu].dim_stop=stop;
-
-		threads.emplace_back([&p=params[cpu], this](){bw_dim_prefetch(&p);});
-	}
-
-	for (cpu=0; cpu<num_threads; cpu++)
-	{
-		threads[cpu].join();
-
-		for (i=0; i<N; i++)
-		{
-			//estimate initial+end state distribution numerator
-			set_p(i, Math::logarithmic_sum(get_p(i), params[cpu].p_buf[i]));
-			set_q(i, Math::logarithmic_sum(get_q(i), params[cpu].q_buf[i]));
-
-			//estimate numerator for a
-			for (j=0; j<N; j++)
-				set_a(i,j, Math::logarithmic_sum(get_a(i,j), params[cpu].a_buf[N*i+j]));
-
-			//estimate numerator for b
-			for (j=0; j<M; j++)
-				set_b(i,j, Math::logarithmic_sum(get_b(i,j), params[cpu].b_buf[M*i+j]));
-		}
-
-		fullmodprob+=params[cpu].ret;
-
-	}
-
-	for (cpu=0; cpu<num_threads; cpu++)
-	{
-		SG_FREE(params[cpu].p_buf);
-		SG_FREE(params[cpu].q_buf);
-		SG_FREE(params[cpu].a_buf);
-		SG_FREE(params[cpu].b_buf);
-	}
-
-	//cache hmm model probability
-	hmm->mod_prob=fullmodprob;
-	hmm->mod_prob_updated=true ;
-
-	//new model probability is unknown
-	normalize();
-	invalidate_model();
-}
-
-#else // USE_HMMPARALLEL
-
-//estimates new model lambda out of lambda_estimate using baum welch algorithm
-void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>& estimate)
-{
-	int32_t i,j,t,dim;
-	float64_t a_sum, b_sum;	//numerator
-	float64_t dimmodprob=0;	//model probability for dim
-	float64_t fullmodprob=0;	//for all dims
-
-	//clear actual model a,b,p,q are used as numerator
-	for (i=0; i<N; i++)
+	//numerators are the pseudo counts plus the expected counts, parameters
+	//that are impossible in the estimate stay impossible
+	for (int32_t i=0; i<N; i++)
 	{
 		if (estimate->get_p(i)>Math::ALMOST_NEG_INFTY)
-			set_p(i,log(PSEUDO));
+			set_p(i, log(PSEUDO+counts.p[i]));
 		else
-			set_p(i,estimate->get_p(i));
+			set_p(i, estimate->get_p(i));
 		if (estimate->get_q(i)>Math::ALMOST_NEG_INFTY)
-			set_q(i,log(PSEUDO));
+			set_q(i, log(PSEUDO+counts.q[i]));
 		else
-			set_q(i,estimate->get_q(i));
+			set_q(i, estimate->get_q(i));
 
-		for (j=0; j<N; j++)
+		for (int32_t j=0; j<N; j++)
+		{
 			if (estimate->get_a(i,j)>Math::ALMOST_NEG_INFTY)
-				set_a(i,j, log(PSEUDO));
+				set_a(i,j, log(PSEUDO+counts.a(i,j)));
 			else
-				set_a(i,j,estimate->get_a(i,j));
-		for (j=0; j<M; j++)
+				set_a(i,j, estimate->get_a(i,j));
+		}
+		for (int32_t j=0; j<M; j++)
+		{
 			if (estimate->get_b(i,j)>Math::ALMOST_NEG_INFTY)
-				set_b(i,j, log(PSEUDO));
+				set_b(i,j, log(PSEUDO+counts.b(i,j)));
 			else
-				set_b(i,j,estimate->get_b(i,j));
-	}
-	invalidate_model();
-
-	//change summation order to make use of alpha/beta caches
-	for (dim=0; dim<p_observations->get_num_vectors(); dim++)
-	{
-		dimmodprob=estimate->model_probability(dim);
-		fullmodprob+=dimmodprob ;
-
-		for (i=0; i<N; i++)
-		{
-			//estimate initial+end state distribution numerator
-			set_p(i, Math::logarithmic_sum(get_p(i), estimate->get_p(i)+estimate->get_b(i,p_observations->get_feature(dim,0))+estimate->backward(0,i,dim) - dimmodprob));
-			set_q(i, Math::logarithmic_sum(get_q(i), estimate->forward(p_observations->get_vector_length(dim)-1, i, dim)+estimate->get_q(i) - dimmodprob ));
-
-			int32_t num = trans_list_backward_cnt[i] ;
-
-			//estimate a
-			for (j=0; j<num; j++)
-			{
-				int32_t jj = trans_list_backward[i][j] ;
-				a_sum=-Math::INFTY;
-
-				for (t=0; t<p_observations->get_vector_length(dim)-1; t++)
-				{
-					a_sum= Math::logarithmic_sum(a_sum, estimate->forward(t,i,dim)+
-							estimate->get_a(i,jj)+estimate->get_b(jj,p_observations->get_feature(dim,t+1))+estimate->backward(t+1,jj,dim));
-				}
-				set_a(i,jj, Math::logarithmic_sum(get_a(i,jj), a_sum-dimmodprob));
-			}
-
-			//estimate b
-			for (j=0; j<M; j++)
-			{
-				b_sum=-Math::INFTY;
-
-				for (t=0; t<p_observations->get_vector_length(dim); t++)
-				{
-					if (p_observations->get_feature(dim,t)==j)
-						b_sum=Math::logarithmic_sum(b_sum, estimate->forward(t,i,dim)+estimate->backward(t, i, dim));
-				}
-
-				set_b(i,j, Math::logarithmic_sum(get_b(i,j), b_sum-dimmodprob));
-			}
+				set_b(i,j, estimate->get_b(i,j));
 		}
 	}
 
 	//cache estimate model probability
-	estimate->mod_prob=fullmodprob;
+	estimate->mod_prob=counts.log_likelihood;
 	estimate->mod_prob_updated=true ;
 
 	//new model probability is unknown
@@ -1610,6 +1536,7 @@ void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>& estimate)
 	invalidate_model();
 }
 
+#ifndef USE_HMMPARALLEL
 //estimates new model lambda out of lambda_estimate using baum welch algorithm
 void HMM::estimate_model_baum_welch_old(const std::shared_ptr<HMM>& estimate)
 {
@@ -1803,7 +1730,7 @@ void HMM::estimate_model_baum_welch_defined(const std::shared_ptr<HMM>& estimate
 	}
 
 #ifdef USE_HMMPARALLEL
-	int32_t num_threads = env()->get_num_threads();
+	int32_t num_threads = env()->get_max_num_threads();
 	std::vector<std::thread> threads;
 	threads.reserve(num_threads);
 	std::vector<S_DIM_THREAD_PARAM> params(num_threads);
@@ -1963,7 +1890,7 @@ void HMM::estimate_model_viterbi(const std::shared_ptr<HMM>& estimate)
 	float64_t allpatprob=0 ;
 
 #ifdef USE_HMMPARALLEL
-	int32_t num_threads = env()->get_num_threads();
+	int32_t num_threads = env()->get_max_num_threads();
 	std::vector<std::thread> threads;
 	threads.reserve(num_threads);
 	std::vector<S_DIM_THREAD_PARAM> params(num_threads);
@@ -2084,7 +2011,7 @@ void HMM::estimate_model_viterbi_defined(const std::shared_ptr<HMM>& estimate)
 	}
 
 #ifdef USE_HMMPARALLEL
-	int32_t num_threads = env()->get_num_threads();
+	int32_t num_threads = env()->get_max_num_threads();
 	std::vector<std::thread> threads;
 	threads.reserve(num_threads);
 	std::vector<S_DIM_THREAD_PARAM> params(num_threads);
@@ -2772,7 +2699,7 @@ void HMM::invalidate_model()
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
 	{
-		for (int32_t i=0; i<env()->get_num_threads(); i++)
+		for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 		{
 			this->alpha_cache[i].updated=false;
 			this->beta_cache[i].updated=false;
@@ -4378,7 +4305,7 @@ bool HMM::save_model_derivatives_bin(FILE* file)
 		io::info("writing derivatives of changed weights only");
 
 #ifdef USE_HMMPARALLEL
-	int32_t num_threads = env()->get_num_threads();
+	int32_t num_threads = env()->get_max_num_threads();
 	std::vector<std::thread> threads;
 	threads.reserve(num_threads);
 	std::vector<S_DIM_THREAD_PARAM> params(num_threads);
@@ -5262,7 +5189,7 @@ void HMM::set_observation_nocache(const std::shared_ptr<Features>& obs)
 	if (!reused_caches)
 	{
 #ifdef USE_HMMPARALLEL_STRUCTURES
-		for (int32_t i=0; i<env()->get_num_threads(); i++)
+		for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 		{
 			SG_FREE(alpha_cache[i].table);
 			SG_FREE(beta_cache[i].table);
@@ -5316,7 +5243,7 @@ void HMM::set_observations(const std::shared_ptr<Features>& obs, const std::shar
 	if (!reused_caches)
 	{
 #ifdef USE_HMMPARALLEL_STRUCTURES
-		for (int32_t i=0; i<env()->get_num_threads(); i++)
+		for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 		{
 			SG_FREE(alpha_cache[i].table);
 			SG_FREE(beta_cache[i].table);
@@ -5349,7 +5276,7 @@ void HMM::set_observations(const std::shared_ptr<Features>& obs, const std::shar
 		if (lambda)
 		{
 #ifdef USE_HMMPARALLEL_STRUCTURES
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 			{
 				this->alpha_cache[i].table= lambda->alpha_cache[i].table;
 				this->beta_cache[i].table=	lambda->beta_cache[i].table;
@@ -5370,7 +5297,7 @@ void HMM::set_observations(const std::shared_ptr<Features>& obs, const std::shar
 			this->reused_caches=false;
 #ifdef USE_HMMPARALLEL_STRUCTURES
 			io::info("allocating mem for path-table of size {:.2f} Megabytes ({}*{}) each:", ((float32_t)max_T)*N*sizeof(T_STATES)/(1024*1024), max_T, N);
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 			{
 				if ((states_per_observation_psi[i]=SG_MALLOC(T_STATES,max_T*N))!=NULL)
 					SG_DEBUG("path_table[{}] successfully allocated",i)
@@ -5391,7 +5318,7 @@ void HMM::set_observations(const std::shared_ptr<Features>& obs, const std::shar
 			io::info("allocating mem for caches each of size {:.2f} Megabytes ({}*{}) ....", ((float32_t)max_T)*N*sizeof(T_ALPHA_BETA_TABLE)/(1024*1024), max_T, N);
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 			{
 				if ((alpha_cache[i].table=SG_MALLOC(T_ALPHA_BETA_TABLE, max_T*N))!=NULL)
 					SG_DEBUG("alpha_cache[{}].table successfully allocated",i)
@@ -5417,7 +5344,7 @@ void HMM::set_observations(const std::shared_ptr<Features>& obs, const std::shar
 #endif // USE_HMMPARALLEL_STRUCTURES
 #else // USE_HMMCACHE
 #ifdef USE_HMMPARALLEL_STRUCTURES
-			for (int32_t i=0; i<env()->get_num_threads(); i++)
+			for (int32_t i=0; i<env()->get_max_num_threads(); i++)
 			{
 				alpha_cache[i].table=NULL ;
 				beta_cache[i].table=NULL ;
@@ -385,43 +385,28 @@ class HMM : public RandomMixin<Distribution>
 			float64_t prob_sum;
 		};
 
-		/// Datatype that is used in parrallel baum welch model estimation
-		struct S_BW_THREAD_PARAM
-		{
-			std::shared_ptr<HMM> hmm;
-			int32_t dim_start;
-			int32_t dim_stop;
-
-			float64_t ret;
-
-			float64_t* p_buf;
-			float64_t* q_buf;
-			float64_t* a_buf;
-			float64_t* b_buf;
-		};
-
 		inline T_ALPHA_BETA & ALPHA_CACHE(int32_t dim) {
-			return alpha_cache[dim%env()->get_num_threads()] ; } ;
+			return alpha_cache[dim%env()->get_max_num_threads()] ; } ;
 		inline T_ALPHA_BETA & BETA_CACHE(int32_t dim) {
-			return beta_cache[dim%env()->get_num_threads()] ; } ;
+			return beta_cache[dim%env()->get_max_num_threads()] ; } ;
 #ifdef USE_LOGSUMARRAY
 		inline float64_t* ARRAYS(int32_t dim) {
-			return arrayS[dim%env()->get_num_threads()] ; } ;
+			return arrayS[dim%env()->get_max_num_threads()] ; } ;
 #endif
 		inline float64_t* ARRAYN1(int32_t dim) {
-			return arrayN1[dim%env()->get_num_threads()] ; } ;
+			return arrayN1[dim%env()->get_max_num_threads()] ; } ;
 		inline float64_t* ARRAYN2(int32_t dim) {
-			return arrayN2[dim%env()->get_num_threads()] ; } ;
+			return arrayN2[dim%env()->get_max_num_threads()] ; } ;
 		inline T_STATES* STATES_PER_OBSERVATION_PSI(int32_t dim) {
-			return states_per_observation_psi[dim%env()->get_num_threads()] ; } ;
+			return states_per_observation_psi[dim%env()->get_max_num_threads()] ; } ;
 		inline const T_STATES* STATES_PER_OBSERVATION_PSI(int32_t dim) const {
-			return states_per_observation_psi[dim%env()->get_num_threads()] ; } ;
+			return states_per_observation_psi[dim%env()->get_max_num_threads()] ; } ;
 		inline T_STATES* PATH(int32_t dim) {
-			return path[dim%env()->get_num_threads()] ; } ;
+			return path[dim%env()->get_max_num_threads()] ; } ;
 		inline bool & PATH_PROB_UPDATED(int32_t dim) {
-			return path_prob_updated[dim%env()->get_num_threads()] ; } ;
+			return path_prob_updated[dim%env()->get_max_num_threads()] ; } ;
 		inline int32_t & PATH_PROB_DIMENSION(int32_t dim) {
-			return path_prob_dimension[dim%env()->get_num_threads()] ; } ;
+			return path_prob_dimension[dim%env()->get_max_num_threads()] ; } ;
 #else
 		inline T_ALPHA_BETA & ALPHA_CACHE(int32_t /*dim*/) {
 			return alpha_cache ; } ;
@@ -454,7 +439,6 @@ class HMM : public RandomMixin<Distribution>
 		bool converged(float64_t x, float64_t y);
 
 #ifdef USE_HMMPARALLEL_STRUCTURES
-		static void bw_dim_prefetch(S_BW_THREAD_PARAM* params);
 		static void bw_single_dim_prefetch(S_DIM_THREAD_PARAM* params);
 		static void vit_dim_prefetch(S_DIM_THREAD_PARAM* params);
 #endif
@@ -644,11 +628,7 @@ class HMM : public RandomMixin<Distribution>
 		void estimate_model_baum_welch(const std::shared_ptr<HMM>& train);
 		void estimate_model_baum_welch_trans(const std::shared_ptr<HMM>& train);
 
-#ifdef USE_HMMPARALLEL_STRUCTURES
-		void ab_buf_comp(
-			float64_t* p_buf, float64_t* q_buf, float64_t* a_buf,
-			float64_t* b_buf, int32_t dim) ;
-#else
+#ifndef USE_HMMPARALLEL_STRUCTURES
 		void estimate_model_baum_welch_old(const std::shared_ptr<HMM>& train);
 #endif
 
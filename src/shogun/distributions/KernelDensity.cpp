@@ -47,6 +47,10 @@ KernelDensity::KernelDensity(float64_t bandwidth, EKernelType kernel, EDistanceT
 	m_rtol=rtol;
 	m_dist=dist;
 	m_kernel_type=kernel;
+
+	require(kernel==K_GAUSSIAN || kernel==K_EXPONENTIAL ||
+		kernel==K_EPANECHNIKOV || kernel==K_TOPHAT,
+		"Kernel type {} not supported", (int32_t)kernel);
 }
 
 KernelDensity::~KernelDensity()
@@ -109,17 +113,7 @@ SGVector<float64_t> KernelDensity::get_log_density(const std::shared_ptr<Feature
 		error("Evaluation mode not identified");
 
 	query_tree->build_tree(dense_feat);
-	std::shared_ptr<BinaryTreeMachineNode<NbodyTreeNodeData>> qroot=NULL;
-	auto root=query_tree->get_root();
-	if (root)
-		qroot=std::dynamic_pointer_cast<BinaryTreeMachineNode<NbodyTreeNodeData>>(root);
-	else
-		error("Query tree root not found!");
-
-	SGVector<index_t> qid=query_tree->get_rearranged_vector_ids();
-	SGVector<float64_t> ret=tree->log_kernel_density_dual(dense_feat->get_feature_matrix(),qid,qroot,m_kernel_type,m_bandwidth,m_atol,m_rtol);
-
-	return ret;
+	return tree->log_kernel_density_dual(query_tree,m_kernel_type,m_bandwidth,m_atol,m_rtol);
 }
 
 int32_t KernelDensity::get_num_model_parameters()
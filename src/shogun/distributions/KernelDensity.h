@@ -55,8 +55,13 @@ enum EEvaluationMode
  * pdf(x')= \frac{1}{nh} \sum_{i=1}^n K(\frac{||x-x_i||}{h})
  * \f]
  * K() in the above formula is called the kernel function and is controlled by the parameter h called kernel bandwidth.
- * Presently, this class supports only Gaussian kernel which can be used with either Euclidean distance or Manhattan
- * distance. This class makes use of 2 tree structures KD-tree and Ball tree for fast calculation. KD-trees are
+ * Supported kernels are the Gaussian kernel K_GAUSSIAN, the exponential kernel K_EXPONENTIAL and the compact
+ * Epanechnikov kernel K_EPANECHNIKOV and tophat kernel K_TOPHAT, which can be used with either Euclidean distance or
+ * Manhattan distance. The kernels are normalized for Euclidean distance. This class makes use of 2 tree structures
+ * KD-tree and Ball tree for fast calculation. With the dual tree evaluation modes the query points are put into a
+ * tree as well, query subtrees are evaluated in parallel, pairs of nodes farther apart than the bandwidth of a compact
+ * kernel are skipped and the error of every density is at most atol+rtol*density, see
+ * CNbodyTree::log_kernel_density_dual(). KD-trees are
  * faster than ball trees at lower dimensions. In case of high dimensional data, ball tree tends to out-perform KD-tree.
  * By default, the class used is Ball tree.
  */
@@ -140,6 +145,10 @@ public :
 	 */
 	inline static float64_t log_norm(EKernelType kernel, float64_t width, int32_t dim)
 	{
+		// log of the volume of the unit ball
+		const float64_t log_volume = 0.5 * dim * std::log(Math::PI) -
+		                             std::lgamma(0.5 * dim + 1);
+
 		switch(kernel)
 		{
 			case K_GAUSSIAN:
@@ -148,6 +157,23 @@ public :
 				       dim * std::log(width);
 				break;
 			}
+			case K_EXPONENTIAL:
+			{
+				return -log_volume - std::lgamma(dim + 1) -
+				       dim * std::log(width);
+				break;
+			}
+			case K_EPANECHNIKOV:
+			{
+				return -log_volume + std::log(0.5 * dim + 1) -
+				       dim * std::log(width);
+				break;
+			}
+			case K_TOPHAT:
+			{
+				return -log_volume - dim * std::log(width);
+				break;
+			}
 			default:
 				io::print("kernel type not recognized\n");
 		}
@@ -160,7 +186,8 @@ public :
 	 * @param kernel kernel type
 	 * @param dist distance
 	 * @param width kernel width
-	 * @return log of kernel
+	 * @return log of kernel, -infinity outside of the support of
+	 * compact kernels
 	 */
 	inline static float64_t log_kernel(EKernelType kernel, float64_t dist, float64_t width)
 	{
@@ -171,6 +198,27 @@ public :
 				return -0.5*dist*dist/(width*width);
 				break;
 			}
+			case K_EXPONENTIAL:
+			{
+				return -dist/width;
+				break;
+			}
+			case K_EPANECHNIKOV:
+			{
+				if (dist>=width)
+					return -Math::INFTY;
+
+				return std::log(1-dist*dist/(width*width));
+				break;
+			}
+			case K_TOPHAT:
+			{
+				if (dist>=width)
+					return -Math::INFTY;
+
+				return 0.0;
+				break;
+			}
 			default:
 				io::print("kernel type not recognized\n");
 		}
@@ -0,0 +1,65 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/BinaryClassEvaluation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace shogun;
+
+SGVector<index_t> BinaryClassEvaluation::argsort_descending(const SGVector<float64_t>& scores)
+{
+	const index_t length = scores.vlen;
+
+	index_t num_nan = 0;
+	#pragma omp parallel for reduction(+ : num_nan) \
+		num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < length; i++)
+		num_nan += std::isnan(scores[i]);
+	require(num_nan == 0, "{} of the scores are NaN", num_nan);
+
+	auto greater = [&scores](index_t a, index_t b) {
+		return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+	};
+
+	SGVector<index_t> idx(length);
+	idx.range_fill();
+
+	// sort one chunk per thread, then merge pairs of neighbouring chunks
+	const int32_t num_chunks = std::max<int64_t>(
+		1, std::min<int64_t>(env()->get_num_threads(), length / 4096));
+	std::vector<index_t> bounds(num_chunks + 1);
+	for (int32_t c = 0; c <= num_chunks; c++)
+		bounds[c] = (int64_t)length * c / num_chunks;
+
+	#pragma omp parallel for num_threads(num_chunks) schedule(static)
+	for (int32_t c = 0; c < num_chunks; c++)
+		std::sort(idx.vector + bounds[c], idx.vector + bounds[c + 1], greater);
+
+	if (num_chunks == 1)
+		return idx;
+
+	SGVector<index_t> buffer(length);
+	for (int32_t width = 1; width < num_chunks; width *= 2)
+	{
+		#pragma omp parallel for num_threads(num_chunks) schedule(static)
+		for (int32_t c = 0; c < num_chunks; c += 2 * width)
+		{
+			const index_t begin = bounds[c];
+			const index_t middle = bounds[std::min(c + width, num_chunks)];
+			const index_t end = bounds[std::min(c + 2 * width, num_chunks)];
+			std::merge(
+				idx.vector + begin, idx.vector + middle, idx.vector + middle,
+				idx.vector + end, buffer.vector + begin, greater);
+		}
+		std::swap(idx, buffer);
+	}
+
+	return idx;
+}
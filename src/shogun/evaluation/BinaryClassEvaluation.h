@@ -44,6 +44,15 @@ public:
 	{
 		return "BinaryClassEvaluation";
 	}
+
+protected:
+	/** sorts scores in descending order, ties by index, with a merge sort
+	 * on env()->get_num_threads() threads
+	 *
+	 * @param scores scores, must not be NaN
+	 * @return indices of the scores in descending order
+	 */
+	static SGVector<index_t> argsort_descending(const SGVector<float64_t>& scores);
 };
 
 }
@@ -0,0 +1,318 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/range.h>
+#include <shogun/evaluation/BinaryScoreHistogram.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace shogun;
+
+BinaryScoreHistogram::BinaryScoreHistogram() : SGObject()
+{
+	init();
+}
+
+BinaryScoreHistogram::BinaryScoreHistogram(
+	int32_t num_bins, float64_t min_score, float64_t max_score)
+	: SGObject()
+{
+	init();
+
+	require(num_bins > 0, "Number of bins ({}) must be positive", num_bins);
+	require(
+		std::isfinite(min_score) && std::isfinite(max_score) &&
+			min_score <= max_score,
+		"Invalid score range [{}, {}]", min_score, max_score);
+
+	m_num_bins = num_bins;
+	m_min_score = min_score;
+	m_max_score = max_score;
+	m_positives = SGVector<int64_t>(num_bins);
+	m_negatives = SGVector<int64_t>(num_bins);
+	m_positives.zero();
+	m_negatives.zero();
+}
+
+BinaryScoreHistogram::~BinaryScoreHistogram()
+{
+}
+
+void BinaryScoreHistogram::init()
+{
+	m_num_bins = 0;
+	m_min_score = 0;
+	m_max_score = 0;
+
+	SG_ADD(&m_num_bins, "num_bins", "Number of bins");
+	SG_ADD(&m_min_score, "min_score", "Lower end of the first bin");
+	SG_ADD(&m_max_score, "max_score", "Upper end of the last bin");
+	SG_ADD(&m_positives, "positives", "Counts of positive examples per bin");
+	SG_ADD(&m_negatives, "negatives", "Counts of negative examples per bin");
+}
+
+index_t BinaryScoreHistogram::bin(float64_t score) const
+{
+	if (!(score > m_min_score))
+		return 0;
+
+	const float64_t scaled =
+		(score - m_min_score) / (m_max_score - m_min_score) * m_num_bins;
+	return scaled >= m_num_bins ? m_num_bins - 1 : (index_t)scaled;
+}
+
+void BinaryScoreHistogram::add(
+	SGVector<float64_t> scores, SGVector<float64_t> labels)
+{
+	require(m_num_bins > 0, "{} has no bins", get_name());
+	require(
+		scores.vlen == labels.vlen,
+		"Number of scores ({}) does not match number of labels ({})",
+		scores.vlen, labels.vlen);
+
+	const index_t length = scores.vlen;
+	// every thread counts into its own histogram, which are summed up in a
+	// fixed order afterwards
+	const int32_t num_threads = std::max<int64_t>(
+		1, std::min<int64_t>(
+			   env()->get_num_threads(), length / (4 * m_num_bins)));
+
+	std::vector<std::vector<int64_t>> counts(
+		num_threads, std::vector<int64_t>(2 * m_num_bins, 0));
+
+	#pragma omp parallel for num_threads(num_threads) schedule(static)
+	for (int32_t t = 0; t < num_threads; t++)
+	{
+		auto& local = counts[t];
+		const index_t begin = (int64_t)length * t / num_threads;
+		const index_t end = (int64_t)length * (t + 1) / num_threads;
+		for (index_t i = begin; i < end; i++)
+			local[2 * bin(scores[i]) + (labels[i] > 0 ? 0 : 1)]++;
+	}
+
+	for (const auto& local : counts)
+	{
+		for (auto b : range(m_num_bins))
+		{
+			m_positives[b] += local[2 * b];
+			m_negatives[b] += local[2 * b + 1];
+		}
+	}
+}
+
+void BinaryScoreHistogram::add(
+	const std::shared_ptr<BinaryLabels>& predicted,
+	const std::shared_ptr<BinaryLabels>& ground_truth)
+{
+	require(predicted, "No predicted labels provided.");
+	require(ground_truth, "No ground truth labels provided.");
+
+	add(predicted->get_values(), ground_truth->get_labels());
+}
+
+void BinaryScoreHistogram::merge(
+	const std::shared_ptr<BinaryScoreHistogram>& other)
+{
+	require(other, "No histogram provided.");
+	require(
+		other->m_num_bins == m_num_bins &&
+			other->m_min_score == m_min_score &&
+			other->m_max_score == m_max_score,
+		"Cannot merge histograms with different binning, {} bins on [{}, {}] "
+		"and {} bins on [{}, {}]",
+		m_num_bins, m_min_score, m_max_score, other->m_num_bins,
+		other->m_min_score, other->m_max_score);
+
+	for (auto b : range(m_num_bins))
+	{
+		m_positives[b] += other->m_positives[b];
+		m_negatives[b] += other->m_negatives[b];
+	}
+}
+
+int64_t BinaryScoreHistogram::get_num_positives() const
+{
+	int64_t sum = 0;
+	for (auto b : range(m_num_bins))
+		sum += m_positives[b];
+	return sum;
+}
+
+int64_t BinaryScoreHistogram::get_num_negatives() const
+{
+	int64_t sum = 0;
+	for (auto b : range(m_num_bins))
+		sum += m_negatives[b];
+	return sum;
+}
+
+index_t BinaryScoreHistogram::num_nonempty_bins() const
+{
+	index_t count = 0;
+	for (auto b : range(m_num_bins))
+	{
+		if (m_positives[b] + m_negatives[b] > 0)
+			count++;
+	}
+	return count;
+}
+
+float64_t BinaryScoreHistogram::get_auROC() const
+{
+	const float64_t pos_count = get_num_positives();
+	const float64_t neg_count = get_num_negatives();
+	require(
+		pos_count > 0 && neg_count > 0,
+		"{}: Number of positive ({}) and negative ({}) examples must be "
+		"positive",
+		get_name(), pos_count, neg_count);
+
+	// every negative example scores below all positives of higher bins and
+	// ties with the positives of its own bin
+	float64_t area = 0;
+	float64_t tp = 0;
+	for (index_t b = m_num_bins - 1; b >= 0; b--)
+	{
+		area += m_negatives[b] * (tp + 0.5 * m_positives[b]);
+		tp += m_positives[b];
+	}
+
+	return area / (pos_count * neg_count);
+}
+
+float64_t BinaryScoreHistogram::get_auROC_error_bound() const
+{
+	const float64_t pos_count = get_num_positives();
+	const float64_t neg_count = get_num_negatives();
+
+	float64_t tied = 0;
+	for (auto b : range(m_num_bins))
+		tied += (float64_t)m_positives[b] * m_negatives[b];
+
+	return 0.5 * tied / (pos_count * neg_count);
+}
+
+SGMatrix<float64_t> BinaryScoreHistogram::get_ROC() const
+{
+	const float64_t pos_count = get_num_positives();
+	const float64_t neg_count = get_num_negatives();
+
+	SGMatrix<float64_t> graph(2, num_nonempty_bins() + 1);
+	graph(0, 0) = 0;
+	graph(1, 0) = 0;
+
+	float64_t tp = 0;
+	float64_t fp = 0;
+	index_t j = 1;
+	for (index_t b = m_num_bins - 1; b >= 0; b--)
+	{
+		if (m_positives[b] + m_negatives[b] == 0)
+			continue;
+
+		tp += m_positives[b];
+		fp += m_negatives[b];
+		graph(0, j) = fp / neg_count;
+		graph(1, j) = tp / pos_count;
+		j++;
+	}
+
+	return graph;
+}
+
+SGMatrix<float64_t> BinaryScoreHistogram::get_PRC() const
+{
+	const float64_t pos_count = get_num_positives();
+
+	SGMatrix<float64_t> graph(2, num_nonempty_bins());
+	float64_t tp = 0;
+	float64_t count = 0;
+	index_t j = 0;
+	for (index_t b = m_num_bins - 1; b >= 0; b--)
+	{
+		if (m_positives[b] + m_negatives[b] == 0)
+			continue;
+
+		tp += m_positives[b];
+		count += m_positives[b] + m_negatives[b];
+		graph(0, j) = tp / count;
+		graph(1, j) = tp / pos_count;
+		j++;
+	}
+
+	return graph;
+}
+
+float64_t BinaryScoreHistogram::get_auPRC() const
+{
+	require(
+		get_num_positives() > 0, "{}: Number of positive examples is zero",
+		get_name());
+
+	auto graph = get_PRC();
+
+	// the curve starts at zero recall with the precision of the first bin
+	return graph(1, 0) * graph(0, 0) +
+	       Math::area_under_curve(graph.matrix, graph.num_cols, true);
+}
+
+float64_t BinaryScoreHistogram::get_auPRC_error_bound() const
+{
+	const float64_t pos_count = get_num_positives();
+
+	// the precision at a positive example within a bin depends on how many
+	// of the bin's negatives precede it, which changes it by at most
+	// negatives / (examples before the bin + negatives + 1)
+	float64_t bound = 1.0 / pos_count;
+	float64_t count = 0;
+	for (index_t b = m_num_bins - 1; b >= 0; b--)
+	{
+		bound += m_positives[b] / pos_count * m_negatives[b] /
+		         (count + m_negatives[b] + 1);
+		count += m_positives[b] + m_negatives[b];
+	}
+
+	return std::min(bound, 1.0);
+}
+
+SGVector<float64_t> BinaryScoreHistogram::get_thresholds() const
+{
+	SGVector<float64_t> thresholds(num_nonempty_bins());
+	const float64_t width = (m_max_score - m_min_score) / m_num_bins;
+
+	index_t j = 0;
+	for (index_t b = m_num_bins - 1; b >= 0; b--)
+	{
+		if (m_positives[b] + m_negatives[b] > 0)
+			thresholds[j++] = m_min_score + b * width;
+	}
+
+	return thresholds;
+}
+
+void BinaryScoreHistogram::score_range(
+	const SGVector<float64_t>& scores, float64_t& min_score,
+	float64_t& max_score)
+{
+	float64_t lo = std::numeric_limits<float64_t>::infinity();
+	float64_t hi = -std::numeric_limits<float64_t>::infinity();
+
+	#pragma omp parallel for reduction(min : lo) reduction(max : hi) \
+		num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < scores.vlen; i++)
+	{
+		lo = std::min(lo, scores[i]);
+		hi = std::max(hi, scores[i]);
+	}
+
+	min_score = lo;
+	max_score = hi;
+}
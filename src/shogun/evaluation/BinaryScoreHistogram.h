@@ -0,0 +1,153 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef BINARYSCOREHISTOGRAM_H_
+#define BINARYSCOREHISTOGRAM_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+
+class BinaryLabels;
+
+/** @brief Counts of positive and negative examples in fixed-width bins of
+ * their scores, from which ROC and PR curves are approximated without
+ * sorting.
+ *
+ * Scores outside of the range are counted in the first or last bin.
+ * Histograms with the same binning can be merged, so scores can be added
+ * in chunks or on several shards and combined afterwards. Adding scores
+ * takes one pass over the data on env()->get_num_threads() threads, each
+ * counting into its own histogram.
+ *
+ * Examples in the same bin are treated as tied. The error of the areas
+ * under the curves is therefore bounded by what the order within the bins
+ * could change, see get_auROC_error_bound() and get_auPRC_error_bound().
+ * Scores that really are tied do not contribute to the error, but are
+ * included in the bounds.
+ */
+class BinaryScoreHistogram: public SGObject
+{
+public:
+	/** constructor */
+	BinaryScoreHistogram();
+
+	/** constructor
+	 * @param num_bins number of bins
+	 * @param min_score lower end of the first bin
+	 * @param max_score upper end of the last bin
+	 */
+	BinaryScoreHistogram(int32_t num_bins, float64_t min_score, float64_t max_score);
+
+	/** destructor */
+	~BinaryScoreHistogram() override;
+
+	/** get name */
+	const char* get_name() const override { return "BinaryScoreHistogram"; };
+
+	/** count scores
+	 * @param scores scores
+	 * @param labels labels, positive if greater than zero
+	 */
+	void add(SGVector<float64_t> scores, SGVector<float64_t> labels);
+
+	/** count the values of predicted labels
+	 * @param predicted predicted labels
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void add(
+		const std::shared_ptr<BinaryLabels>& predicted,
+		const std::shared_ptr<BinaryLabels>& ground_truth);
+
+	/** add the counts of a histogram with the same binning
+	 * @param other histogram
+	 */
+	void merge(const std::shared_ptr<BinaryScoreHistogram>& other);
+
+	/** @return number of positive examples */
+	int64_t get_num_positives() const;
+
+	/** @return number of negative examples */
+	int64_t get_num_negatives() const;
+
+	/** @return counts of positive examples per bin */
+	SGVector<int64_t> get_positives() const { return m_positives; }
+
+	/** @return counts of negative examples per bin */
+	SGVector<int64_t> get_negatives() const { return m_negatives; }
+
+	/** @return area under the ROC curve, counting examples in the same bin
+	 * as tied */
+	float64_t get_auROC() const;
+
+	/** @return largest possible difference between get_auROC() and the
+	 * exact area */
+	float64_t get_auROC_error_bound() const;
+
+	/** @return ROC curve, one point (false positive rate, true positive
+	 * rate) before the first and after every non-empty bin, from the
+	 * highest scores to the lowest */
+	SGMatrix<float64_t> get_ROC() const;
+
+	/** @return area under the PR curve */
+	float64_t get_auPRC() const;
+
+	/** @return bound of the difference between get_auPRC() and the area
+	 * under the exact step-wise PR curve */
+	float64_t get_auPRC_error_bound() const;
+
+	/** @return PR curve, one point (precision, recall) after every
+	 * non-empty bin, from the highest scores to the lowest */
+	SGMatrix<float64_t> get_PRC() const;
+
+	/** @return lower end of every non-empty bin, from the highest to the
+	 * lowest, the thresholds of the points of get_PRC() and of all but the
+	 * first point of get_ROC() */
+	SGVector<float64_t> get_thresholds() const;
+
+	/** computes the range of scores on env()->get_num_threads() threads
+	 * @param scores scores
+	 * @param min_score smallest score
+	 * @param max_score largest score
+	 */
+	static void score_range(
+		const SGVector<float64_t>& scores, float64_t& min_score,
+		float64_t& max_score);
+
+private:
+	void init();
+
+	/** @return bin of a score */
+	index_t bin(float64_t score) const;
+
+	/** @return number of non-empty bins */
+	index_t num_nonempty_bins() const;
+
+protected:
+	/** number of bins */
+	int32_t m_num_bins;
+
+	/** lower end of the first bin */
+	float64_t m_min_score;
+
+	/** upper end of the last bin */
+	float64_t m_max_score;
+
+	/** counts of positive examples per bin */
+	SGVector<int64_t> m_positives;
+
+	/** counts of negative examples per bin */
+	SGVector<int64_t> m_negatives;
+};
+
+}
+
+#endif /* BINARYSCOREHISTOGRAM_H_ */
@@ -0,0 +1,61 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/Calibration.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <exception>
+
+using namespace shogun;
+
+std::shared_ptr<MulticlassLabels>
+Calibration::calibrate_multiclass(std::shared_ptr<MulticlassLabels> predictions)
+{
+	index_t num_classes = predictions->get_num_classes();
+	index_t num_samples = predictions->get_num_labels();
+	require(
+	    get_num_calibrated_classes() == num_classes,
+	    "Parameters not fitted, which need to be fitted before calibrating.");
+
+	auto result_labels = std::make_shared<MulticlassLabels>(num_samples);
+	result_labels->allocate_confidences_for(num_classes);
+
+	std::exception_ptr exception;
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < num_samples; ++i)
+	{
+		try
+		{
+			auto values = predictions->get_multiclass_confidences(i);
+			calibrate_multiclass_outputs(values);
+			result_labels->set_label(
+			    i, Math::arg_max(values.vector, 1, values.vlen));
+			result_labels->set_multiclass_confidences(i, values);
+		}
+		catch (...)
+		{
+			#pragma omp critical
+			exception = std::current_exception();
+		}
+	}
+	if (exception)
+		std::rethrow_exception(exception);
+
+	return result_labels;
+}
+
+void Calibration::normalize_probabilities(SGVector<float64_t> outputs)
+{
+	float64_t sum = SGVector<float64_t>::sum(outputs);
+
+	if (sum == 0)
+		linalg::add_scalar(outputs, 1. / (float64_t)outputs.vlen);
+	else
+		linalg::scale(outputs, outputs, 1 / sum);
+}
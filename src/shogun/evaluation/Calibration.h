@@ -59,11 +59,32 @@ namespace shogun
 
 		/** Calibrate multiclass predictions based on parameters learned by
 		*calling fit.
+		* The predictions of every vector are calibrated in parallel by
+		* calibrate_multiclass_outputs(), their labels are the most probable
+		* classes.
 		* @param predictions The predictions outputted by the machine
-		* @return Calibrated binary labels
+		* @return Calibrated multiclass labels
 		**/
 		virtual std::shared_ptr<MulticlassLabels>
-		calibrate_multiclass(std::shared_ptr<MulticlassLabels> predictions) = 0;
+		calibrate_multiclass(std::shared_ptr<MulticlassLabels> predictions);
+
+		/** Calibrate the outputs of one vector for all classes in place and
+		* normalize them to probabilities. Only reads the parameters learned
+		* by fit_multiclass(), so vectors can be calibrated concurrently.
+		* @param outputs The outputs of the vector for every class
+		**/
+		virtual void
+		calibrate_multiclass_outputs(SGVector<float64_t> outputs) const = 0;
+
+		/** @return Number of classes the parameters are fitted for **/
+		virtual index_t get_num_calibrated_classes() const = 0;
+
+	protected:
+		/** Normalize calibrated outputs to sum to one. All classes have
+		* equal probability when the outputs sum to zero.
+		* @param outputs The calibrated outputs of a vector
+		**/
+		static void normalize_probabilities(SGVector<float64_t> outputs);
 	};
 }
 #endif
\ No newline at end of file
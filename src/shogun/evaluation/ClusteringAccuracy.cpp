@@ -4,6 +4,7 @@
  * Authors: Soeren Sonnenburg, Chiyuan Zhang
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/ClusteringAccuracy.h>
 #include <shogun/labels/MulticlassLabels.h>
 
@@ -16,7 +17,9 @@ float64_t ClusteringAccuracy::evaluate_impl(std::shared_ptr<Labels> predicted, s
 	ASSERT(predicted->get_label_type() == LT_MULTICLASS)
 	SGVector<int32_t> predicted_ilabels=multiclass_labels(predicted)->get_int_labels();
 	SGVector<int32_t> groundtruth_ilabels=multiclass_labels(ground_truth)->get_int_labels();
-	int32_t correct=0;
+	int64_t correct=0;
+	#pragma omp parallel for reduction(+:correct) \
+		num_threads(env()->get_num_threads())
 	for (int32_t i=0; i < predicted_ilabels.vlen; ++i)
 	{
 		if (predicted_ilabels[i] == groundtruth_ilabels[i])
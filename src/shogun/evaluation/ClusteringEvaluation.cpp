@@ -4,14 +4,15 @@
  * Authors: Chiyuan Zhang, Soeren Sonnenburg, Bjoern Esser
  */
 
-#include <set>
-#include <map>
-#include <vector>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/range.h>
 #include <shogun/evaluation/ClusteringEvaluation.h>
 #include <shogun/labels/MulticlassLabels.h>
-#include <shogun/mathematics/munkres.h>
+#include <shogun/mathematics/SparseAssignment.h>
 
 using namespace shogun;
 using namespace std;
@@ -49,51 +50,155 @@ int32_t ClusteringEvaluation::find_mismatch_count(SGVector<int32_t> l1, int32_t
 	return l1.vlen - find_match_count(l1, m1, l2, m2);
 }
 
+namespace
+{
+	SGVector<int32_t> unique_labels(const SGVector<int32_t>& labels)
+	{
+		std::vector<int32_t> unique(labels.begin(), labels.end());
+		std::sort(unique.begin(), unique.end());
+		unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+		return SGVector<int32_t>(unique.begin(), unique.end());
+	}
+
+	index_t label_index(const SGVector<int32_t>& unique, int32_t label)
+	{
+		return std::lower_bound(unique.begin(), unique.end(), label) -
+			unique.begin();
+	}
+}
+
+ClusteringEvaluation::ContingencyTable ClusteringEvaluation::contingency_table(
+	const SGVector<int32_t>& ground_truth, const SGVector<int32_t>& predicted)
+{
+	require(
+		ground_truth.vlen == predicted.vlen,
+		"Number of ground truth labels ({}) does not match number of "
+		"predicted labels ({})", ground_truth.vlen, predicted.vlen);
+
+	ContingencyTable table;
+	table.row_labels = unique_labels(ground_truth);
+	table.col_labels = unique_labels(predicted);
+	const int64_t num_cols = table.col_labels.vlen;
+
+	// every thread counts the cells of its chunk of the labels, the sparse
+	// counts are merged afterwards
+	const index_t length = predicted.vlen;
+	const int32_t num_threads = std::max<int64_t>(
+		1, std::min<int64_t>(env()->get_num_threads(), length / 1024));
+	std::vector<std::vector<std::pair<int64_t, int64_t>>> cells(num_threads);
+
+	#pragma omp parallel for num_threads(num_threads) schedule(static)
+	for (int32_t t = 0; t < num_threads; t++)
+	{
+		const index_t begin = (int64_t)length * t / num_threads;
+		const index_t end = (int64_t)length * (t + 1) / num_threads;
+		std::vector<int64_t> keys(end - begin);
+		for (index_t i = begin; i < end; i++)
+		{
+			keys[i - begin] =
+				label_index(table.row_labels, ground_truth[i]) * num_cols +
+				label_index(table.col_labels, predicted[i]);
+		}
+		std::sort(keys.begin(), keys.end());
+
+		auto& local = cells[t];
+		for (const auto key : keys)
+		{
+			if (local.empty() || local.back().first != key)
+				local.emplace_back(key, 0);
+			local.back().second++;
+		}
+	}
+
+	std::vector<std::pair<int64_t, int64_t>> merged;
+	for (const auto& local : cells)
+		merged.insert(merged.end(), local.begin(), local.end());
+	std::sort(merged.begin(), merged.end());
+
+	index_t num_cells = 0;
+	for (index_t i = 0; i < (index_t)merged.size(); i++)
+	{
+		if (num_cells && merged[num_cells - 1].first == merged[i].first)
+			merged[num_cells - 1].second += merged[i].second;
+		else
+			merged[num_cells++] = merged[i];
+	}
+
+	table.rows = SGVector<index_t>(num_cells);
+	table.cols = SGVector<index_t>(num_cells);
+	table.counts = SGVector<int64_t>(num_cells);
+	table.row_sums = SGVector<int64_t>(table.row_labels.vlen);
+	table.col_sums = SGVector<int64_t>(table.col_labels.vlen);
+	table.row_sums.zero();
+	table.col_sums.zero();
+	for (index_t i = 0; i < num_cells; i++)
+	{
+		table.rows[i] = merged[i].first / num_cols;
+		table.cols[i] = merged[i].first % num_cols;
+		table.counts[i] = merged[i].second;
+		table.row_sums[table.rows[i]] += table.counts[i];
+		table.col_sums[table.cols[i]] += table.counts[i];
+	}
+
+	return table;
+}
+
 std::shared_ptr<Labels> ClusteringEvaluation::best_map(const std::shared_ptr<Labels>& predicted, const std::shared_ptr<Labels>& ground_truth)
 {
 	ASSERT(predicted->get_num_labels() == ground_truth->get_num_labels())
 	ASSERT(predicted->get_label_type() == LT_MULTICLASS)
 	ASSERT(ground_truth->get_label_type() == LT_MULTICLASS)
 
-	SGVector<float64_t> label_p=multiclass_labels(predicted)->get_unique_labels();
-	SGVector<float64_t> label_g=multiclass_labels(ground_truth)->get_unique_labels();
-
 	SGVector<int32_t> predicted_ilabels=multiclass_labels(predicted)->get_int_labels();
 	SGVector<int32_t> groundtruth_ilabels=multiclass_labels(ground_truth)->get_int_labels();
 
-	int32_t n_class=max(label_p.vlen, label_g.vlen);
-	SGMatrix<float64_t> G(n_class, n_class);
-	G.zero();
+	auto table = contingency_table(groundtruth_ilabels, predicted_ilabels);
+	const index_t num_rows = table.row_labels.vlen;
+	const index_t num_cols = table.col_labels.vlen;
 
-	for (int32_t i=0; i < label_g.vlen; ++i)
+	// maximize the number of matches, the rows are the ground truth labels
+	SparseAssignment assignment(num_rows, num_cols);
+	for (auto i : range(table.counts.vlen))
+		assignment.add_edge(table.rows[i], table.cols[i], table.counts[i]);
+	auto row_to_col = assignment.solve();
+
+	SGVector<int32_t> label_map(num_cols);
+	label_map.set_const(-1);
+	std::vector<bool> used(num_rows, false);
+	for (auto row : range(num_rows))
 	{
-		for (int32_t j=0; j < label_p.vlen; ++j)
+		if (row_to_col[row] >= 0)
 		{
-			G(i, j)=find_mismatch_count(groundtruth_ilabels, static_cast<int32_t>(label_g[i]),
-				predicted_ilabels, static_cast<int32_t>(label_p[j]));
+			label_map[row_to_col[row]] = table.row_labels[row];
+			used[row] = true;
 		}
 	}
 
-	Munkres munkres_solver(G);
-	munkres_solver.solve();
-
-	std::map<int32_t, int32_t> label_map;
-	for (int32_t i=0; i < label_p.vlen; ++i)
+	// unassigned predicted labels take the remaining true labels, and new
+	// ones once those run out
+	index_t next_row = 0;
+	int32_t next_label =
+		num_rows ? table.row_labels[num_rows - 1] + 1 : 0;
+	for (auto col : range(num_cols))
 	{
-		for (int32_t j=0; j < label_g.vlen; ++j)
+		if (label_map[col] >= 0)
+			continue;
+
+		while (next_row < num_rows && used[next_row])
+			next_row++;
+		if (next_row < num_rows)
 		{
-			if (G(j, i) == 0)
-			{
-				label_map.insert(make_pair(static_cast<int32_t>(label_p[i]),
-						static_cast<int32_t>(label_g[j])));
-				break;
-			}
+			label_map[col] = table.row_labels[next_row];
+			used[next_row] = true;
 		}
+		else
+			label_map[col] = next_label++;
 	}
 
-	auto result = std::make_shared<MulticlassLabels>(predicted->get_num_labels());
-	for (int32_t i= 0; i < predicted_ilabels.vlen; ++i)
-		result->set_int_label(i, label_map[predicted_ilabels[i]]);
+	SGVector<float64_t> result(predicted_ilabels.vlen);
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < predicted_ilabels.vlen; ++i)
+		result[i] = label_map[label_index(table.col_labels, predicted_ilabels[i])];
 
-	return result;
+	return std::make_shared<MulticlassLabels>(result);
 }
@@ -28,8 +28,10 @@ public:
 
 	/** permute the order of the predicted labels to match the ground_truth as good as possible.
 	 *
-	 * The Munkres assignment algorithm is used to find the best match.
-	 * Note this method perform inplace modification on the parameter predicted
+	 * The assignment of predicted to true labels that maximizes the number
+	 * of matches is found by SparseAssignment on the non-zero cells of the
+	 * contingency table. Predicted labels that are not assigned are mapped
+	 * to the remaining true labels, and to new labels once these run out.
 	 * @param predicted labels for evaluating
 	 * @param ground_truth labels assumed to be correct
 	 */
@@ -65,6 +67,38 @@ protected:
 	 */
 	int32_t find_mismatch_count(SGVector<int32_t> l1, int32_t m1, const SGVector<int32_t>& l2, int32_t m2);
 
+	/** @brief Sparse contingency table of two labelings, the number of
+	 * vectors for every pair of labels that occurs.
+	 */
+	struct ContingencyTable
+	{
+		/** sorted unique ground truth labels, one per row */
+		SGVector<int32_t> row_labels;
+		/** sorted unique predicted labels, one per column */
+		SGVector<int32_t> col_labels;
+		/** rows of the non-zero cells, ordered by row and column */
+		SGVector<index_t> rows;
+		/** columns of the non-zero cells */
+		SGVector<index_t> cols;
+		/** counts of the non-zero cells */
+		SGVector<int64_t> counts;
+		/** number of vectors per row */
+		SGVector<int64_t> row_sums;
+		/** number of vectors per column */
+		SGVector<int64_t> col_sums;
+	};
+
+	/** computes the contingency table in one parallel pass over the
+	 * labels, with memory linear in the number of non-zero cells rather
+	 * than quadratic in the number of labels
+	 * @param ground_truth ground truth labels
+	 * @param predicted predicted labels
+	 * @return contingency table
+	 */
+	static ContingencyTable contingency_table(
+		const SGVector<int32_t>& ground_truth,
+		const SGVector<int32_t>& predicted);
+
 private:
 	// A flag to find best match between predicted labels and the ground truth
 	// before evaluation
@@ -15,55 +15,32 @@ float64_t ClusteringMutualInformation::evaluate_impl(std::shared_ptr<Labels> pre
 	ASSERT(predicted && ground_truth)
 	ASSERT(predicted->get_label_type() == LT_MULTICLASS)
 	ASSERT(ground_truth->get_label_type() == LT_MULTICLASS)
-	SGVector<float64_t> label_p=multiclass_labels(predicted)->get_unique_labels();
-	SGVector<float64_t> label_g=multiclass_labels(ground_truth)->get_unique_labels();
-
-	if (label_p.vlen != label_g.vlen)
-		error("Number of classes are different");
-	index_t n_class=label_p.vlen;
-	float64_t n_label=predicted->get_num_labels();
-
 	SGVector<int32_t> ilabels_p=multiclass_labels(predicted)->get_int_labels();
 	SGVector<int32_t> ilabels_g=multiclass_labels(ground_truth)->get_int_labels();
 
-	SGMatrix<float64_t> G(n_class, n_class);
-	for (index_t i=0; i < n_class; ++i)
-	{
-		for (index_t j=0; j < n_class; ++j)
-			G(i, j)=find_match_count(ilabels_g, label_g[i],
-				ilabels_p, label_p[j])/n_label;
-	}
-
-	SGVector<float64_t> G_rowsum(n_class);
-	G_rowsum.zero();
-	SGVector<float64_t> G_colsum(n_class);
-	G_colsum.zero();
-	for (index_t i=0; i < n_class; ++i)
-	{
-		for (index_t j=0; j < n_class; ++j)
-		{
-			G_rowsum[i] += G(i, j);
-			G_colsum[i] += G(j, i);
-		}
-	}
+	auto table = contingency_table(ilabels_g, ilabels_p);
+	if (table.row_labels.vlen != table.col_labels.vlen)
+		error("Number of classes are different");
+	float64_t n_label=predicted->get_num_labels();
 
+	// only the non-zero cells of the contingency table contribute
 	float64_t mutual_info = 0;
-	for (index_t i=0; i < n_class; ++i)
+	for (index_t k=0; k < table.counts.vlen; ++k)
 	{
-		for (index_t j=0; j < n_class; ++j)
-		{
-			if (G(i, j) != 0)
-				mutual_info += G(i, j) * log(G(i,j) /
-					(G_rowsum[i]*G_colsum[j]))/log(2.);
-		}
+		float64_t p_gp = table.counts[k] / n_label;
+		float64_t p_g = table.row_sums[table.rows[k]] / n_label;
+		float64_t p_p = table.col_sums[table.cols[k]] / n_label;
+		mutual_info += p_gp * log(p_gp / (p_g * p_p)) / log(2.);
 	}
 
 	float64_t entropy_p = 0;
 	float64_t entropy_g = 0;
-	for (index_t i=0; i < n_class; ++i)
+	for (index_t i=0; i < table.row_sums.vlen; ++i)
 	{
-		entropy_g += -G_rowsum[i] * log(G_rowsum[i])/log(2.);
-		entropy_p += -G_colsum[i] * log(G_colsum[i])/log(2.);
+		float64_t p_g = table.row_sums[i] / n_label;
+		float64_t p_p = table.col_sums[i] / n_label;
+		entropy_g += -p_g * log(p_g)/log(2.);
+		entropy_p += -p_p * log(p_p)/log(2.);
 	}
 
 	return mutual_info / Math::max(entropy_g, entropy_p);
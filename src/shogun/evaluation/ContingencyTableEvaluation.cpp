@@ -5,6 +5,7 @@
  *          Roman Votyakov, Viktor Gal
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/ContingencyTableEvaluation.h>
 #include <shogun/labels/BinaryLabels.h>
 
@@ -104,28 +105,38 @@ ContingencyTableEvaluation::get_evaluation_direction() const
 
 void ContingencyTableEvaluation::compute_scores(const std::shared_ptr<BinaryLabels>& predicted, const std::shared_ptr<BinaryLabels>& ground_truth)
 {
-	m_TP = 0.0;
-	m_FP = 0.0;
-	m_TN = 0.0;
-	m_FN = 0.0;
 	m_N = predicted->get_num_labels();
+	auto predicted_labels = predicted->get_labels();
+	auto ground_truth_labels = ground_truth->get_labels();
 
-	for (int i = 0; i < predicted->get_num_labels(); i++)
+	int64_t tp = 0;
+	int64_t fp = 0;
+	int64_t tn = 0;
+	int64_t fn = 0;
+	#pragma omp parallel for reduction(+:tp,fp,tn,fn) \
+		num_threads(env()->get_num_threads())
+	for (int32_t i = 0; i < m_N; i++)
 	{
-		if (ground_truth->get_label(i) == 1)
+		const bool predicted_positive = predicted_labels[i] == 1;
+		if (ground_truth_labels[i] == 1)
 		{
-			if (predicted->get_label(i) == 1)
-				m_TP += 1.0;
+			if (predicted_positive)
+				tp++;
 			else
-				m_FN += 1.0;
+				fn++;
 		}
 		else
 		{
-			if (predicted->get_label(i) == 1)
-				m_FP += 1.0;
+			if (predicted_positive)
+				fp++;
 			else
-				m_TN += 1.0;
+				tn++;
 		}
 	}
+
+	m_TP = tp;
+	m_FP = fp;
+	m_TN = tn;
+	m_FN = fn;
 	m_computed = true;
 }
@@ -6,16 +6,25 @@
  *          Leon Kuchenbecker
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/evaluation/CrossValidation.h>
 #include <shogun/evaluation/CrossValidationStorage.h>
 #include <shogun/evaluation/Evaluation.h>
+#include <shogun/evaluation/LOOCrossValidationSplitting.h>
+#include <shogun/evaluation/RidgeLeaveOneOut.h>
 #include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/labels/RegressionLabels.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
+#include <shogun/machine/KernelMachine.h>
+#include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/lib/View.h>
 
+#include <algorithm>
 #include <utility>
 
 using namespace shogun;
@@ -50,19 +59,38 @@ CrossValidation::~CrossValidation()
 void CrossValidation::init()
 {
 	m_num_runs = 1;
+	m_precompute_kernel = false;
+	m_warm_start = false;
 
 	SG_ADD(&m_num_runs, kNumRuns, "Number of repetitions");
+	SG_ADD(
+	    &m_precompute_kernel, kPrecomputeKernel,
+	    "Whether the kernel matrix is shared by all folds");
+	SG_ADD(
+	    &m_warm_start, kWarmStart,
+	    "Whether folds start from the solution of the previous fold");
 }
 
 std::shared_ptr<EvaluationResult> CrossValidation::evaluate_impl() const
 {
+	if (std::dynamic_pointer_cast<LOOCrossValidationSplitting>(
+	        m_splitting_strategy) &&
+	    m_features && RidgeLeaveOneOut::is_supported(m_machine))
+	{
+		return evaluate_leave_one_out();
+	}
+
 	SGVector<float64_t> results(m_num_runs);
 
+	SGMatrix<float32_t> kernel_matrix;
+	if (m_precompute_kernel)
+		kernel_matrix = compute_kernel_matrix();
+
 	/* perform all the x-val runs */
 	SG_DEBUG("starting {} runs of cross-validation", m_num_runs);
 	for (auto i : SG_PROGRESS(range(m_num_runs)))
 	{
-		results[i] = evaluate_one_run(i);
+		results[i] = evaluate_one_run(i, kernel_matrix);
 		io::info("Result of cross-validation run {}/{} is {}", i+1, m_num_runs, results[i]);
 	}
 
@@ -77,6 +105,33 @@ std::shared_ptr<EvaluationResult> CrossValidation::evaluate_impl() const
 	return result;
 }
 
+std::shared_ptr<EvaluationResult> CrossValidation::evaluate_leave_one_out() const
+{
+	SG_DEBUG(
+	    "computing leave-one-out predictions of {} analytically",
+	    m_machine->get_name());
+	auto predictions =
+	    RidgeLeaveOneOut(m_machine, m_features, m_labels).loo_predictions();
+
+	/* every fold holds out a single vector */
+	SGVector<float64_t> results(predictions.vlen);
+	for (auto i : range(predictions.vlen))
+	{
+		auto evaluation_criterion = make_clone(m_evaluation_criterion);
+		auto labels_test = view(m_labels, SGVector<index_t>({i}));
+		auto result_labels = std::make_shared<RegressionLabels>(
+		    SGVector<float64_t>({predictions[i]}));
+		results[i] = evaluation_criterion->evaluate(result_labels, labels_test);
+	}
+
+	/* all runs would hold out the same vectors */
+	auto result = std::make_shared<CrossValidationResult>();
+	result->set_mean(Statistics::mean(results));
+	result->set_std_dev(0);
+
+	return result;
+}
+
 void CrossValidation::set_num_runs(int32_t num_runs)
 {
 	if (num_runs < 1)
@@ -85,7 +140,90 @@ void CrossValidation::set_num_runs(int32_t num_runs)
 	m_num_runs = num_runs;
 }
 
-float64_t CrossValidation::evaluate_one_run(int64_t index) const
+void CrossValidation::set_precompute_kernel(bool precompute_kernel)
+{
+	m_precompute_kernel = precompute_kernel;
+}
+
+void CrossValidation::set_warm_start(bool warm_start)
+{
+	m_warm_start = warm_start;
+}
+
+SGMatrix<float32_t> CrossValidation::compute_kernel_matrix() const
+{
+	auto kernel_machine = std::dynamic_pointer_cast<KernelMachine>(m_machine);
+	require(
+	    kernel_machine && kernel_machine->get_kernel(),
+	    "Precomputing the kernel matrix requires a kernel machine with a "
+	    "kernel, got {}",
+	    m_machine->get_name());
+
+	auto kernel = kernel_machine->get_kernel();
+	if (std::dynamic_pointer_cast<CustomKernel>(kernel))
+		return SGMatrix<float32_t>();
+
+	require(m_features, "Precomputing the kernel matrix requires features");
+
+	SG_DEBUG(
+	    "precomputing {} kernel matrix of {} vectors", kernel->get_name(),
+	    m_features->get_num_vectors());
+	// the clone only gets initialized with other features, so it can
+	// share the data of the kernel instead of copying it
+	kernel = make_clone(kernel, ParameterProperties::ALL, true);
+	kernel->init(m_features, m_features);
+	auto kernel_matrix = kernel->get_kernel_matrix<float32_t>();
+	kernel->remove_lhs_and_rhs();
+
+	return kernel_matrix;
+}
+
+namespace
+{
+	/** trains a machine starting from the solution of the machine of the
+	 * previous fold */
+	void train_warm_started(
+	    const std::shared_ptr<Machine>& machine,
+	    const std::shared_ptr<Features>& features,
+	    const std::shared_ptr<Machine>& previous,
+	    const SGVector<index_t>& previous_idx_train,
+	    const SGVector<index_t>& idx_train, index_t num_vectors)
+	{
+		if (auto linear = std::dynamic_pointer_cast<LinearMachine>(machine))
+		{
+			linear->train(
+			    features, std::static_pointer_cast<LinearMachine>(previous));
+			return;
+		}
+
+		auto kernel = std::dynamic_pointer_cast<KernelMachine>(machine);
+		if (!kernel)
+		{
+			machine->train(features);
+			return;
+		}
+
+		/* support vectors index the previous training vectors, map them to
+		 * the current ones, those now being tested on are dropped */
+		SGVector<index_t> position(num_vectors);
+		position.set_const(-1);
+		for (auto i : range(idx_train.vlen))
+			position[idx_train[i]] = i;
+
+		auto previous_kernel = std::static_pointer_cast<KernelMachine>(previous);
+		SGVector<int32_t> svs = previous_kernel->get_support_vectors().clone();
+		for (auto i : range(svs.vlen))
+			svs[i] = position[previous_idx_train[svs[i]]];
+
+		auto start = std::make_shared<KernelMachine>(
+		    nullptr, previous_kernel->get_alphas(), svs,
+		    previous_kernel->get_bias());
+		kernel->train(features, start);
+	}
+} // namespace
+
+float64_t CrossValidation::evaluate_one_run(
+    int64_t index, const SGMatrix<float32_t>& kernel_matrix) const
 {
 	SG_TRACE("entering {}::evaluate_one_run()", get_name());
 	index_t num_subsets = m_splitting_strategy->get_num_subsets();
@@ -94,10 +232,21 @@ float64_t CrossValidation::evaluate_one_run(int64_t index) const
 	m_splitting_strategy->build_subsets();
 
 	SGVector<float64_t> results(num_subsets);
+	const index_t num_vectors = m_labels->get_num_labels();
+
+	/* warm started folds depend on each other and run one after another */
+	const bool warm_start = m_warm_start;
+	std::shared_ptr<Machine> previous;
+	SGVector<index_t> previous_idx_train;
 
-	#pragma omp parallel for shared(results)
+	// each fold gets an equal share of the threads for its own parallel work
+	#pragma omp parallel for shared(results, previous, previous_idx_train) \
+		if(!warm_start) \
+		num_threads(std::min(num_subsets, env()->get_num_threads()))
 	for (auto i = 0; i<num_subsets; ++i)
 	{
+		env()->limit_nested_threads();
+
 		// only need to clone hyperparameters and settings of machine
 		// model parameters are inferred/learned during training
 		auto machine = make_clone(m_machine,
@@ -109,20 +258,48 @@ float64_t CrossValidation::evaluate_one_run(int64_t index) const
 		SGVector<index_t> idx_test =
 			m_splitting_strategy->generate_subset_indices(i);
 
-		auto features_train = view(m_features, idx_train);
+		std::shared_ptr<Features> features_train;
+		std::shared_ptr<Features> features_test;
+		if (kernel_matrix.matrix)
+		{
+			// the fold's kernel is a view on the shared matrix
+			auto kernel = std::make_shared<CustomKernel>();
+			kernel->set_full_kernel_matrix_from_full(kernel_matrix);
+			machine->as<KernelMachine>()->set_kernel(kernel);
+
+			features_train = std::make_shared<IndexFeatures>(idx_train);
+			features_test = std::make_shared<IndexFeatures>(idx_test);
+		}
+		else
+		{
+			features_train = view(m_features, idx_train);
+			features_test = view(m_features, idx_test);
+		}
 		auto labels_train = view(m_labels, idx_train);
-		auto features_test = view(m_features, idx_test);
 		auto labels_test = view(m_labels, idx_test);
 
 		auto evaluation_criterion = make_clone(m_evaluation_criterion);
 
 		machine->set_labels(labels_train);
-		machine->train(features_train);
+		if (previous)
+		{
+			train_warm_started(
+			    machine, features_train, previous, previous_idx_train,
+			    idx_train, num_vectors);
+		}
+		else
+			machine->train(features_train);
 
 		auto result_labels = machine->apply(features_test);
 
 		results[i] = evaluation_criterion->evaluate(result_labels, labels_test);
 		io::info("Result of cross-validation fold {}/{} is {}", i+1, num_subsets, results[i]);
+
+		if (warm_start)
+		{
+			previous = machine;
+			previous_idx_train = idx_train;
+		}
 	}
 
 	/* build arithmetic mean of results */
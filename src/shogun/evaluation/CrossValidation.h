@@ -13,6 +13,7 @@
 
 #include <shogun/evaluation/EvaluationResult.h>
 #include <shogun/evaluation/MachineEvaluation.h>
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/Seedable.h>
 
 namespace shogun
@@ -116,6 +117,15 @@ namespace shogun
 	 * overwriting
 	 * the evaluate_one_run method.
 	 *
+	 * For kernel machines, the kernel matrix of all features can be computed
+	 * once and shared by all folds and runs, see set_precompute_kernel().
+	 * Kernel and linear machines can also be trained starting from the
+	 * solution of the previous fold, see set_warm_start().
+	 *
+	 * Leave-one-out cross-validation of LinearRidgeRegression,
+	 * KernelRidgeRegression and exact GaussianProcessRegression is computed
+	 * in closed form, see RidgeLeaveOneOut.
+	 *
 	 * See [Forman, G. and Scholz, M. (2009). Apples-to-apples in
 	 * cross-validation
 	 * studies: Pitfalls in classifier performance measurement. Technical
@@ -159,6 +169,28 @@ namespace shogun
 		/** setter for the number of runs to use for evaluation */
 		void set_num_runs(int32_t num_runs);
 
+		/** Whether the kernel matrix of all features is computed once and
+		 * shared by all folds. Each fold then trains on a CustomKernel over
+		 * that matrix with IndexFeatures of its training and test vectors,
+		 * instead of computing the kernel on its own. Only for kernel
+		 * machines. The matrix is stored in single precision and needs
+		 * n^2 floats of memory.
+		 *
+		 * @param precompute_kernel whether to precompute the kernel matrix
+		 */
+		void set_precompute_kernel(bool precompute_kernel);
+
+		/** Whether every fold is trained starting from the solution of the
+		 * previous fold, see KernelMachine::train() and
+		 * LinearMachine::train(). Support vectors of the previous fold are
+		 * mapped to the training vectors of the current one, those in its
+		 * test set are dropped. Folds are then trained one after another,
+		 * each using all threads.
+		 *
+		 * @param warm_start whether to warm start the folds
+		 */
+		void set_warm_start(bool warm_start);
+
 		/** @return name of the SGSerializable */
 		const char* get_name() const override
 		{
@@ -182,16 +214,39 @@ namespace shogun
 		 * F1-measure. Has to be overridden by sub-classes if results have to be
 		 * merged differently
 		 *
+		 * @param index index of the run
+		 * @param kernel_matrix precomputed kernel matrix of all features, or
+		 * an empty matrix
 		 * @return evaluation result of one cross-validation run
 		 */
-		float64_t evaluate_one_run(int64_t index) const;
+		float64_t evaluate_one_run(
+		    int64_t index, const SGMatrix<float32_t>& kernel_matrix) const;
+
+		/** Evaluates leave-one-out cross-validation of a machine supported
+		 * by RidgeLeaveOneOut without retraining.
+		 *
+		 * @return the cross-validation result
+		 */
+		std::shared_ptr<EvaluationResult> evaluate_leave_one_out() const;
+
+		/** @return kernel matrix of all features, or an empty matrix if the
+		 * machine's kernel is a CustomKernel already */
+		SGMatrix<float32_t> compute_kernel_matrix() const;
 
 		/** number of evaluation runs for one fold */
 		int32_t m_num_runs;
 
+		/** whether the kernel matrix is shared by all folds */
+		bool m_precompute_kernel;
+
+		/** whether folds start from the solution of the previous fold */
+		bool m_warm_start;
+
 	#ifndef SWIG
 	public:
 		static constexpr std::string_view kNumRuns = "num_runs";
+		static constexpr std::string_view kPrecomputeKernel = "precompute_kernel";
+		static constexpr std::string_view kWarmStart = "warm_start";
 	#endif
 	};
 }
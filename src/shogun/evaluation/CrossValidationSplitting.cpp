@@ -27,33 +27,27 @@ CrossValidationSplitting::CrossValidationSplitting(
 void CrossValidationSplitting::build_subsets()
 {
 	require(m_labels, "No labels provided.");
-	/* ensure that subsets are empty and set flag to filled */
+	/* ensure that subsets are empty */
 	reset_subsets();
-	m_is_filled=true;
 
-	/* permute indices */
+	/* permute indices, every subset is a consecutive range of them */
 	SGVector<index_t> indices(m_labels->get_num_labels());
 	indices.range_fill();
-	random::shuffle(indices, m_prng);
+	random::parallel_shuffle(indices, m_prng);
 
-	index_t num_subsets=m_subset_indices.size();
-
-	/* distribute indices to subsets */
-	index_t current_subset=0;
-	for (index_t i=0; i<indices.vlen; ++i)
+	/* the first num_labels % num_subsets subsets get one more element */
+	index_t num_subsets=m_num_subsets;
+	std::vector<std::pair<index_t, index_t>> ranges(num_subsets);
+	index_t begin=0;
+	for (index_t i=0; i<num_subsets; ++i)
 	{
-		/* fill current subset */
-		auto& current = m_subset_indices[current_subset];
-
-		/* add element of current index */
-		current.push_back(indices.vector[i]);
-
-		/* iterate over subsets */
-		current_subset=(current_subset+1) % num_subsets;
+		index_t size=indices.vlen/num_subsets+(i<indices.vlen%num_subsets);
+		ranges[i]=std::make_pair(begin, begin+size);
+		begin+=size;
 	}
 
 	/* finally shuffle to avoid that subsets with low indices have more
-	 * elements, which happens if the number of class labels is not equal to
-	 * the number of subsets (external random state important for threads) */
-	random::shuffle(m_subset_indices, m_prng);
+	 * elements (external random state important for threads) */
+	random::shuffle(ranges, m_prng);
+	set_subsets(indices, ranges);
 }
@@ -0,0 +1,430 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/Evaluation.h>
+#include <shogun/evaluation/HyperparameterSearch.h>
+#include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/Features.h>
+#include <shogun/labels/Labels.h>
+#include <shogun/lib/View.h>
+#include <shogun/machine/Machine.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+using namespace shogun;
+using namespace Eigen;
+
+HyperparameterSearch::HyperparameterSearch() : RandomMixin<SGObject>()
+{
+	init();
+}
+
+HyperparameterSearch::HyperparameterSearch(
+    std::shared_ptr<Machine> machine, std::shared_ptr<Features> features,
+    std::shared_ptr<Labels> labels,
+    std::shared_ptr<SplittingStrategy> splitting_strategy,
+    std::shared_ptr<Evaluation> evaluation_criterion)
+    : RandomMixin<SGObject>()
+{
+	init();
+
+	m_machine = std::move(machine);
+	m_features = std::move(features);
+	m_labels = std::move(labels);
+	m_splitting_strategy = std::move(splitting_strategy);
+	m_evaluation_criterion = std::move(evaluation_criterion);
+}
+
+HyperparameterSearch::~HyperparameterSearch()
+{
+}
+
+void HyperparameterSearch::init()
+{
+	m_strategy = HSS_GRID;
+	m_num_candidates = 10;
+	m_min_budget = 1;
+	m_max_budget = 1;
+	m_eta = 3;
+	m_best_score = 0;
+
+	SG_ADD(&m_machine, "machine", "Machine whose hyperparameters are searched");
+	SG_ADD(&m_features, "features", "Used features");
+	SG_ADD(&m_labels, "labels", "Used labels");
+	SG_ADD(
+	    &m_splitting_strategy, "splitting_strategy",
+	    "Used splitting strategy");
+	SG_ADD(
+	    &m_evaluation_criterion, "evaluation_criterion",
+	    "Used evaluation criterion");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_strategy, "strategy", "Search strategy",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(
+	        HSS_GRID, HSS_RANDOM, HSS_SUCCESSIVE_HALVING, HSS_HYPERBAND));
+	SG_ADD(
+	    &m_num_candidates, "num_candidates", "Number of random candidates",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_min_budget, "min_budget", "Smallest budget",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_max_budget, "max_budget", "Largest budget",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_eta, "eta", "Reduction factor of successive halving",
+	    ParameterProperties::SETTING);
+	SG_ADD(&m_best_parameters, "best_parameters", "Best parameters");
+	SG_ADD(&m_best_score, "best_score", "Score of the best parameters");
+}
+
+void HyperparameterSearch::add_parameter(
+    std::string_view name, SGVector<float64_t> values)
+{
+	require(values.vlen > 0, "Parameter {} needs at least one value", name);
+	auto [min, max] = std::minmax_element(values.begin(), values.end());
+	m_parameters.push_back(
+	    ParameterSpace{std::string(name), values, *min, *max, false});
+}
+
+void HyperparameterSearch::add_parameter(
+    std::string_view name, float64_t min, float64_t max, bool log_scale)
+{
+	require(
+	    min <= max, "Range [{}, {}] of parameter {} is empty", min, max, name);
+	require(
+	    !log_scale || min > 0,
+	    "Log scale range of parameter {} must be positive", name);
+	m_parameters.push_back(ParameterSpace{
+	    std::string(name), SGVector<float64_t>(), min, max, log_scale});
+}
+
+void HyperparameterSearch::set_strategy(EHyperparameterSearchStrategy strategy)
+{
+	m_strategy = strategy;
+}
+
+void HyperparameterSearch::set_num_candidates(int32_t num_candidates)
+{
+	require(
+	    num_candidates > 0, "Number of candidates ({}) must be positive",
+	    num_candidates);
+	m_num_candidates = num_candidates;
+}
+
+void HyperparameterSearch::set_budget(
+    std::string_view name, int32_t min_budget, int32_t max_budget, int32_t eta)
+{
+	require(
+	    min_budget > 0 && min_budget <= max_budget,
+	    "Budget range [{}, {}] is invalid", min_budget, max_budget);
+	require(eta > 1, "Reduction factor ({}) must be larger than one", eta);
+	m_budget_name = name;
+	m_min_budget = min_budget;
+	m_max_budget = max_budget;
+	m_eta = eta;
+}
+
+std::shared_ptr<Machine> HyperparameterSearch::search()
+{
+	require(m_machine, "{}::search() requires a machine", get_name());
+	require(m_features, "{}::search() requires features", get_name());
+	require(m_labels, "{}::search() requires labels", get_name());
+	require(
+	    m_splitting_strategy, "{}::search() requires a splitting strategy",
+	    get_name());
+	require(
+	    m_evaluation_criterion, "{}::search() requires an evaluation criterion",
+	    get_name());
+	require(!m_parameters.empty(), "No parameters to search");
+
+	const bool budgeted = m_strategy == HSS_SUCCESSIVE_HALVING ||
+	                      m_strategy == HSS_HYPERBAND;
+	require(
+	    !budgeted || !m_budget_name.empty(),
+	    "{} requires a budget parameter, see set_budget()", get_name());
+
+	m_evaluated.clear();
+	m_scores.clear();
+	m_budgets.clear();
+	m_best_parameters = SGVector<float64_t>();
+	build_folds();
+
+	switch (m_strategy)
+	{
+	case HSS_GRID:
+		evaluate_candidates(grid_candidates(), -1);
+		break;
+	case HSS_RANDOM:
+		evaluate_candidates(random_candidates(m_num_candidates), -1);
+		break;
+	case HSS_SUCCESSIVE_HALVING:
+		successive_halving(random_candidates(m_num_candidates), m_min_budget);
+		break;
+	case HSS_HYPERBAND:
+	{
+		const int32_t s_max = std::floor(
+		    std::log(float64_t(m_max_budget) / m_min_budget) / std::log(m_eta) +
+		    1e-9);
+		for (int32_t s = s_max; s >= 0; s--)
+		{
+			const float64_t scale = std::pow(m_eta, s);
+			const int32_t num_candidates =
+			    std::ceil((s_max + 1) * scale / (s + 1));
+			const int32_t budget =
+			    std::max<int32_t>(m_min_budget, m_max_budget / scale);
+			successive_halving(random_candidates(num_candidates), budget);
+		}
+		break;
+	}
+	}
+
+	// only evaluations at the final budget compete for the best parameters
+	const int32_t final_budget = budgeted ? m_max_budget : -1;
+	for (size_t i = 0; i < m_scores.size(); i++)
+	{
+		if (m_budgets[i] != final_budget)
+			continue;
+		if (!m_best_parameters.vlen || is_better(m_scores[i], m_best_score))
+		{
+			m_best_parameters = m_evaluated[i];
+			m_best_score = m_scores[i];
+		}
+	}
+	io::info(
+	    "Best of {} evaluations has score {}", m_scores.size(), m_best_score);
+
+	m_folds.clear();
+
+	auto machine = configure(m_best_parameters.vector, final_budget);
+	machine->set_labels(m_labels);
+	machine->train(m_features);
+	return machine;
+}
+
+void HyperparameterSearch::build_folds()
+{
+	m_splitting_strategy->build_subsets();
+	const index_t num_folds = m_splitting_strategy->get_num_subsets();
+
+	m_folds.resize(num_folds);
+	for (index_t i = 0; i < num_folds; i++)
+	{
+		auto idx_train = m_splitting_strategy->generate_subset_inverse(i);
+		auto idx_test = m_splitting_strategy->generate_subset_indices(i);
+
+		m_folds[i].features_train = view(m_features, idx_train);
+		m_folds[i].labels_train = view(m_labels, idx_train);
+		m_folds[i].features_test = view(m_features, idx_test);
+		m_folds[i].labels_test = view(m_labels, idx_test);
+	}
+}
+
+SGMatrix<float64_t> HyperparameterSearch::grid_candidates() const
+{
+	index_t num_candidates = 1;
+	for (const auto& param : m_parameters)
+	{
+		require(
+		    param.values.vlen > 0,
+		    "Grid search needs discrete values of parameter {}", param.name);
+		num_candidates *= param.values.vlen;
+	}
+
+	// the first parameter varies fastest
+	SGMatrix<float64_t> candidates(m_parameters.size(), num_candidates);
+	for (index_t c = 0; c < num_candidates; c++)
+	{
+		index_t rest = c;
+		for (size_t p = 0; p < m_parameters.size(); p++)
+		{
+			const auto& values = m_parameters[p].values;
+			candidates(p, c) = values[rest % values.vlen];
+			rest /= values.vlen;
+		}
+	}
+	return candidates;
+}
+
+SGMatrix<float64_t>
+HyperparameterSearch::random_candidates(int32_t num_candidates)
+{
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	UniformIntDistribution<index_t> uniform_int;
+
+	SGMatrix<float64_t> candidates(m_parameters.size(), num_candidates);
+	for (index_t c = 0; c < num_candidates; c++)
+	{
+		for (size_t p = 0; p < m_parameters.size(); p++)
+		{
+			const auto& param = m_parameters[p];
+			if (param.values.vlen > 0)
+			{
+				candidates(p, c) = param.values[uniform_int(
+				    m_prng, {0, param.values.vlen - 1})];
+			}
+			else if (param.log_scale)
+			{
+				const float64_t log_min = std::log(param.min);
+				const float64_t log_max = std::log(param.max);
+				candidates(p, c) =
+				    std::exp(log_min + (log_max - log_min) * uniform(m_prng));
+			}
+			else
+			{
+				candidates(p, c) =
+				    param.min + (param.max - param.min) * uniform(m_prng);
+			}
+		}
+	}
+	return candidates;
+}
+
+SGVector<float64_t> HyperparameterSearch::evaluate_candidates(
+    SGMatrix<float64_t> candidates, int32_t budget)
+{
+	const index_t num_candidates = candidates.num_cols;
+	const index_t num_folds = m_folds.size();
+	SGMatrix<float64_t> fold_scores(num_folds, num_candidates);
+
+	SG_DEBUG(
+	    "evaluating {} candidates on {} folds with budget {}", num_candidates,
+	    num_folds, budget);
+
+	// every (candidate, fold) pair is a task, candidates of different cost
+	// are balanced by the dynamic schedule
+	const int64_t num_tasks = int64_t(num_candidates) * num_folds;
+	#pragma omp parallel for schedule(dynamic) \
+		num_threads(std::min<int64_t>(num_tasks, env()->get_num_threads()))
+	for (int64_t task = 0; task < num_tasks; task++)
+	{
+		env()->limit_nested_threads();
+		const index_t c = task / num_folds;
+		const index_t f = task % num_folds;
+		const auto& fold = m_folds[f];
+
+		auto machine = configure(candidates.get_column_vector(c), budget);
+		machine->set_labels(fold.labels_train);
+		machine->train(fold.features_train);
+		auto predictions = machine->apply(fold.features_test);
+
+		auto evaluation_criterion = make_clone(m_evaluation_criterion);
+		fold_scores(f, c) =
+		    evaluation_criterion->evaluate(predictions, fold.labels_test);
+	}
+
+	SGVector<float64_t> scores(num_candidates);
+	Map<VectorXd>(scores.vector, num_candidates) =
+	    Map<MatrixXd>(fold_scores.matrix, num_folds, num_candidates)
+	        .colwise()
+	        .mean();
+
+	for (index_t c = 0; c < num_candidates; c++)
+	{
+		m_evaluated.push_back(SGVector<float64_t>(
+		    candidates.get_column_vector(c), candidates.num_rows, false)
+		                          .clone());
+		m_scores.push_back(scores[c]);
+		m_budgets.push_back(budget);
+	}
+	return scores;
+}
+
+void HyperparameterSearch::successive_halving(
+    SGMatrix<float64_t> candidates, int32_t budget)
+{
+	while (true)
+	{
+		auto scores = evaluate_candidates(candidates, budget);
+		if (budget >= m_max_budget)
+			break;
+
+		std::vector<index_t> order(candidates.num_cols);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](index_t a, index_t b) {
+			return is_better(scores[a], scores[b]);
+		});
+
+		const index_t num_kept =
+		    std::max<index_t>(1, candidates.num_cols / m_eta);
+		SGMatrix<float64_t> kept(candidates.num_rows, num_kept);
+		for (index_t c = 0; c < num_kept; c++)
+		{
+			std::copy_n(
+			    candidates.get_column_vector(order[c]), candidates.num_rows,
+			    kept.get_column_vector(c));
+		}
+
+		candidates = kept;
+		budget = std::min<int64_t>(int64_t(budget) * m_eta, m_max_budget);
+	}
+}
+
+std::shared_ptr<Machine> HyperparameterSearch::configure(
+    const float64_t* parameters, int32_t budget) const
+{
+	auto machine = make_clone(
+	    m_machine, ParameterProperties::HYPER | ParameterProperties::SETTING);
+
+	auto put_value = [](std::shared_ptr<SGObject> obj, std::string_view path,
+	                    float64_t value) {
+		// walk nested parameters separated by "::"
+		size_t pos;
+		while ((pos = path.find("::")) != std::string_view::npos)
+		{
+			obj = obj->get(path.substr(0, pos));
+			path = path.substr(pos + 2);
+		}
+
+		if (obj->has<int32_t>(path))
+			obj->put<int32_t>(path, std::lround(value));
+		else
+			obj->put<float64_t>(path, value);
+	};
+
+	for (size_t p = 0; p < m_parameters.size(); p++)
+		put_value(machine, m_parameters[p].name, parameters[p]);
+	if (budget >= 0)
+		put_value(machine, m_budget_name, budget);
+
+	return machine;
+}
+
+bool HyperparameterSearch::is_better(float64_t a, float64_t b) const
+{
+	return m_evaluation_criterion->get_evaluation_direction() == ED_MAXIMIZE
+	           ? a > b
+	           : a < b;
+}
+
+SGMatrix<float64_t> HyperparameterSearch::get_candidates() const
+{
+	SGMatrix<float64_t> candidates(m_parameters.size(), m_evaluated.size());
+	for (size_t c = 0; c < m_evaluated.size(); c++)
+	{
+		std::copy_n(
+		    m_evaluated[c].vector, m_evaluated[c].vlen,
+		    candidates.get_column_vector(c));
+	}
+	return candidates;
+}
+
+SGVector<float64_t> HyperparameterSearch::get_scores() const
+{
+	return SGVector<float64_t>(m_scores.begin(), m_scores.end());
+}
+
+SGVector<int32_t> HyperparameterSearch::get_budgets() const
+{
+	return SGVector<int32_t>(m_budgets.begin(), m_budgets.end());
+}
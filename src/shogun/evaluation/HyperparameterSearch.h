@@ -0,0 +1,248 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __HYPERPARAMETERSEARCH_H_
+#define __HYPERPARAMETERSEARCH_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace shogun
+{
+	class Machine;
+	class Features;
+	class Labels;
+	class SplittingStrategy;
+	class Evaluation;
+
+	/** strategies to generate and select candidates in HyperparameterSearch */
+	enum EHyperparameterSearchStrategy
+	{
+		/** all combinations of the given parameter values */
+		HSS_GRID = 0,
+		/** a number of randomly sampled candidates */
+		HSS_RANDOM = 1,
+		/** randomly sampled candidates, the best 1/eta of which are
+		 * evaluated again with eta times the budget until the maximum
+		 * budget is reached */
+		HSS_SUCCESSIVE_HALVING = 2,
+		/** several successive halving brackets trading off the number of
+		 * candidates against their initial budget */
+		HSS_HYPERBAND = 3
+	};
+
+	/** @brief Cross-validated search over hyperparameters of a machine.
+	 *
+	 * Parameters are addressed by name, nested ones with "::" (eg
+	 * "kernel::width"), and set on clones of the machine. Integer
+	 * parameters are rounded. Candidates are drawn from a grid, at random,
+	 * or by successive halving / Hyperband, see Li et al., "Hyperband: A
+	 * Novel Bandit-Based Approach to Hyperparameter Optimization", JMLR
+	 * 2018. For the latter two, an integer parameter of the machine (eg
+	 * "max_iterations") is used as the budget.
+	 *
+	 * Every (candidate, fold) pair is an independent task, and all tasks of a
+	 * round are run in one parallel loop on env()->get_num_threads() threads.
+	 * The folds are built once and their feature and label views are shared
+	 * by all candidates, so training must not modify its features.
+	 *
+	 * The score of a candidate is the mean of the evaluation criterion over
+	 * the folds.
+	 */
+	class HyperparameterSearch : public RandomMixin<SGObject>
+	{
+	public:
+		HyperparameterSearch();
+
+		/** constructor
+		 * @param machine machine whose hyperparameters are searched
+		 * @param features features
+		 * @param labels labels
+		 * @param splitting_strategy splitting strategy of the folds
+		 * @param evaluation_criterion evaluation criterion
+		 */
+		HyperparameterSearch(
+		    std::shared_ptr<Machine> machine, std::shared_ptr<Features> features,
+		    std::shared_ptr<Labels> labels,
+		    std::shared_ptr<SplittingStrategy> splitting_strategy,
+		    std::shared_ptr<Evaluation> evaluation_criterion);
+
+		~HyperparameterSearch() override;
+
+		/** add a parameter with a discrete set of values
+		 * @param name parameter name
+		 * @param values candidate values
+		 */
+		void add_parameter(std::string_view name, SGVector<float64_t> values);
+
+		/** add a parameter with a continuous range, which can only be used by
+		 * the random strategies
+		 * @param name parameter name
+		 * @param min smallest value
+		 * @param max largest value
+		 * @param log_scale whether values are sampled uniformly in log space
+		 */
+		void add_parameter(
+		    std::string_view name, float64_t min, float64_t max,
+		    bool log_scale = false);
+
+		/** @param strategy search strategy */
+		void set_strategy(EHyperparameterSearchStrategy strategy);
+
+		/** @param num_candidates number of candidates of HSS_RANDOM and
+		 * HSS_SUCCESSIVE_HALVING */
+		void set_num_candidates(int32_t num_candidates);
+
+		/** set the budget of HSS_SUCCESSIVE_HALVING and HSS_HYPERBAND
+		 * @param name integer parameter of the machine used as budget
+		 * @param min_budget smallest budget
+		 * @param max_budget largest budget
+		 * @param eta factor by which candidates are reduced and the budget
+		 * is increased in every round
+		 */
+		void set_budget(
+		    std::string_view name, int32_t min_budget, int32_t max_budget,
+		    int32_t eta = 3);
+
+		/** run the search
+		 * @return clone of the machine with the best parameters (and the
+		 * largest budget), trained on all data
+		 */
+		std::shared_ptr<Machine> search();
+
+		/** @return evaluated candidates, one column per evaluation */
+		SGMatrix<float64_t> get_candidates() const;
+
+		/** @return score of every evaluation */
+		SGVector<float64_t> get_scores() const;
+
+		/** @return budget of every evaluation, -1 if no budget is used */
+		SGVector<int32_t> get_budgets() const;
+
+		/** @return best parameters */
+		SGVector<float64_t> get_best_parameters() const
+		{
+			return m_best_parameters;
+		}
+
+		/** @return score of the best parameters */
+		float64_t get_best_score() const
+		{
+			return m_best_score;
+		}
+
+		const char* get_name() const override
+		{
+			return "HyperparameterSearch";
+		}
+
+	private:
+		/** values or range of a searched parameter */
+		struct ParameterSpace
+		{
+			std::string name;
+			SGVector<float64_t> values;
+			float64_t min;
+			float64_t max;
+			bool log_scale;
+		};
+
+		/** index sets and views of a fold */
+		struct Fold
+		{
+			std::shared_ptr<Features> features_train;
+			std::shared_ptr<Labels> labels_train;
+			std::shared_ptr<Features> features_test;
+			std::shared_ptr<Labels> labels_test;
+		};
+
+		void init();
+
+		/** builds the folds once for all candidates */
+		void build_folds();
+
+		/** @return all combinations of the parameter values */
+		SGMatrix<float64_t> grid_candidates() const;
+
+		/** @return num_candidates randomly sampled candidates */
+		SGMatrix<float64_t> random_candidates(int32_t num_candidates);
+
+		/** evaluates all candidates on all folds in parallel and records
+		 * the scores
+		 * @param candidates candidates, one per column
+		 * @param budget budget, -1 if no budget is used
+		 * @return mean score of every candidate
+		 */
+		SGVector<float64_t> evaluate_candidates(
+		    SGMatrix<float64_t> candidates, int32_t budget);
+
+		/** runs successive halving starting at a budget */
+		void successive_halving(
+		    SGMatrix<float64_t> candidates, int32_t budget);
+
+		/** @return untrained clone of the machine with the given parameters */
+		std::shared_ptr<Machine>
+		configure(const float64_t* parameters, int32_t budget) const;
+
+		/** @return whether score a is better than score b */
+		bool is_better(float64_t a, float64_t b) const;
+
+		std::shared_ptr<Machine> m_machine;
+		std::shared_ptr<Features> m_features;
+		std::shared_ptr<Labels> m_labels;
+		std::shared_ptr<SplittingStrategy> m_splitting_strategy;
+		std::shared_ptr<Evaluation> m_evaluation_criterion;
+
+		/** search strategy */
+		EHyperparameterSearchStrategy m_strategy;
+
+		/** number of random candidates */
+		int32_t m_num_candidates;
+
+		/** name of the budget parameter */
+		std::string m_budget_name;
+
+		/** smallest budget */
+		int32_t m_min_budget;
+
+		/** largest budget */
+		int32_t m_max_budget;
+
+		/** reduction factor of successive halving */
+		int32_t m_eta;
+
+		/** searched parameters */
+		std::vector<ParameterSpace> m_parameters;
+
+		/** cached folds */
+		std::vector<Fold> m_folds;
+
+		/** evaluated candidates */
+		std::vector<SGVector<float64_t>> m_evaluated;
+
+		/** scores of the evaluated candidates */
+		std::vector<float64_t> m_scores;
+
+		/** budgets of the evaluated candidates */
+		std::vector<int32_t> m_budgets;
+
+		/** best parameters */
+		SGVector<float64_t> m_best_parameters;
+
+		/** score of the best parameters */
+		float64_t m_best_score;
+	};
+} // namespace shogun
+
+#endif /* __HYPERPARAMETERSEARCH_H_ */
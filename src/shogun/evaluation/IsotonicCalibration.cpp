@@ -0,0 +1,241 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/IsotonicCalibration.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+	/** Nondecreasing step function fitted by isotonic regression. Its
+	 * knots are the lowest and highest prediction of every step. */
+	struct IsotonicFunction
+	{
+		std::vector<float64_t> predictions;
+		std::vector<float64_t> probabilities;
+	};
+
+	/** Fit the probability of positive targets as a nondecreasing function
+	 * of the predictions by pooling adjacent violators. */
+	IsotonicFunction
+	fit_isotonic(SGVector<float64_t> predictions, SGVector<float64_t> targets)
+	{
+		std::vector<index_t> order(predictions.vlen);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&predictions](index_t a, index_t b) {
+			return predictions[a] < predictions[b];
+		});
+
+		struct Step
+		{
+			float64_t lowest;
+			float64_t highest;
+			float64_t num_positive;
+			float64_t weight;
+
+			float64_t probability() const
+			{
+				return num_positive / weight;
+			}
+		};
+
+		std::vector<Step> steps;
+		for (auto i : order)
+		{
+			float64_t positive = targets[i] > 0 ? 1.0 : 0.0;
+			/** Equal predictions share their probability. */
+			if (!steps.empty() && steps.back().highest == predictions[i])
+			{
+				steps.back().num_positive += positive;
+				steps.back().weight += 1.0;
+			}
+			else
+				steps.push_back({predictions[i], predictions[i], positive, 1.0});
+
+			while (steps.size() > 1 &&
+			       steps[steps.size() - 2].probability() >=
+			           steps.back().probability())
+			{
+				Step last = steps.back();
+				steps.pop_back();
+				steps.back().highest = last.highest;
+				steps.back().num_positive += last.num_positive;
+				steps.back().weight += last.weight;
+			}
+		}
+
+		IsotonicFunction function;
+		for (const auto& step : steps)
+		{
+			function.predictions.push_back(step.lowest);
+			function.probabilities.push_back(step.probability());
+			if (step.highest > step.lowest)
+			{
+				function.predictions.push_back(step.highest);
+				function.probabilities.push_back(step.probability());
+			}
+		}
+		return function;
+	}
+
+	/** Concatenate the knots of the functions of all classes. */
+	void store_functions(
+	    const std::vector<IsotonicFunction>& functions,
+	    SGVector<float64_t>& predictions, SGVector<float64_t>& probabilities,
+	    SGVector<index_t>& offsets)
+	{
+		index_t num_classes = functions.size();
+		offsets = SGVector<index_t>(num_classes + 1);
+		offsets[0] = 0;
+		for (index_t i = 0; i < num_classes; ++i)
+			offsets[i + 1] = offsets[i] + functions[i].predictions.size();
+
+		predictions = SGVector<float64_t>(offsets[num_classes]);
+		probabilities = SGVector<float64_t>(offsets[num_classes]);
+		for (index_t i = 0; i < num_classes; ++i)
+		{
+			std::copy(
+			    functions[i].predictions.begin(),
+			    functions[i].predictions.end(),
+			    predictions.vector + offsets[i]);
+			std::copy(
+			    functions[i].probabilities.begin(),
+			    functions[i].probabilities.end(),
+			    probabilities.vector + offsets[i]);
+		}
+	}
+}
+
+IsotonicCalibration::IsotonicCalibration() : Calibration()
+{
+	init();
+}
+
+IsotonicCalibration::~IsotonicCalibration()
+{
+}
+
+void IsotonicCalibration::init()
+{
+	SG_ADD(
+	    &m_predictions, kPredictions,
+	    "Predictions where the functions of all classes are fitted.");
+	SG_ADD(
+	    &m_probabilities, kProbabilities,
+	    "Probabilities of the fitted predictions.");
+	SG_ADD(
+	    &m_offsets, kOffsets,
+	    "Offset of the fitted predictions of each class.");
+}
+
+bool IsotonicCalibration::fit_binary(
+    std::shared_ptr<BinaryLabels> predictions,
+    std::shared_ptr<BinaryLabels> targets)
+{
+	require(
+	    predictions->get_num_labels() > 0,
+	    "Cannot fit the calibration without predictions.");
+
+	store_functions(
+	    {fit_isotonic(predictions->get_values(), targets->get_labels())},
+	    m_predictions, m_probabilities, m_offsets);
+
+	return true;
+}
+
+std::shared_ptr<BinaryLabels>
+IsotonicCalibration::calibrate_binary(std::shared_ptr<BinaryLabels> predictions)
+{
+	require(
+	    get_num_calibrated_classes() == 1,
+	    "Parameters not fitted, which need to be fitted before calibrating.");
+
+	auto probabilities = predictions->get_values().clone();
+	for (index_t i = 0; i < probabilities.vlen; ++i)
+		probabilities[i] = calibrate_value(probabilities[i], 0);
+
+	return std::make_shared<BinaryLabels>(probabilities);
+}
+
+bool IsotonicCalibration::fit_multiclass(
+    std::shared_ptr<MulticlassLabels> predictions,
+    std::shared_ptr<MulticlassLabels> targets)
+{
+	require(
+	    predictions->get_num_labels() > 0,
+	    "Cannot fit the calibration without predictions.");
+
+	index_t num_classes = predictions->get_num_classes();
+	std::vector<IsotonicFunction> functions(num_classes);
+
+	/** The classes are independent, fit them in parallel. */
+	std::exception_ptr exception;
+	#pragma omp parallel for schedule(dynamic) \
+		num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < num_classes; ++i)
+	{
+		try
+		{
+			auto class_targets = targets->get_binary_for_class(i);
+			functions[i] = fit_isotonic(
+			    predictions->get_confidences_for_class(i),
+			    class_targets->get_labels());
+		}
+		catch (...)
+		{
+			#pragma omp critical
+			exception = std::current_exception();
+		}
+	}
+	if (exception)
+		std::rethrow_exception(exception);
+
+	store_functions(functions, m_predictions, m_probabilities, m_offsets);
+
+	return true;
+}
+
+void IsotonicCalibration::calibrate_multiclass_outputs(
+    SGVector<float64_t> outputs) const
+{
+	require(
+	    outputs.vlen == get_num_calibrated_classes(),
+	    "Number of outputs ({}) does not match the number of fitted classes "
+	    "({}).",
+	    outputs.vlen, get_num_calibrated_classes());
+
+	for (index_t i = 0; i < outputs.vlen; ++i)
+		outputs[i] = calibrate_value(outputs[i], i);
+
+	normalize_probabilities(outputs);
+}
+
+float64_t IsotonicCalibration::calibrate_value(float64_t value, index_t c) const
+{
+	const float64_t* predictions = m_predictions.vector + m_offsets[c];
+	const float64_t* probabilities = m_probabilities.vector + m_offsets[c];
+	index_t num_knots = m_offsets[c + 1] - m_offsets[c];
+
+	/** Constant outside of the fitted predictions, linear between them. */
+	index_t k = std::upper_bound(predictions, predictions + num_knots, value) -
+	            predictions;
+	if (k == 0)
+		return probabilities[0];
+	if (k == num_knots)
+		return probabilities[num_knots - 1];
+
+	float64_t t = (value - predictions[k - 1]) /
+	              (predictions[k] - predictions[k - 1]);
+	return probabilities[k - 1] + t * (probabilities[k] - probabilities[k - 1]);
+}
@@ -0,0 +1,110 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _ISOTONIC_CALIBRATION_H__
+#define _ISOTONIC_CALIBRATION_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/evaluation/Calibration.h>
+
+namespace shogun
+{
+	/** @brief Calibrates labels by isotonic regression [1]. The
+	* probability of the positive class is fitted as a nondecreasing
+	* function of the prediction by pooling adjacent violators, and linearly
+	* interpolated between the fitted predictions. Unlike Platt scaling
+	* (see SigmoidCalibration) this makes no assumption on the shape of the
+	* function, but needs more data to fit.
+	* First call fit_binary() or fit_multiclass(), then calibrate_binary()
+	* or calibrate_multiclass().
+	* [1] Zadrozny B. and Elkan C. Transforming classifier scores into
+	* accurate multiclass probability estimates. KDD 2002
+	*/
+	class IsotonicCalibration : public Calibration
+	{
+	public:
+		/** Constructor. */
+		IsotonicCalibration();
+
+		/** Destructor. */
+		~IsotonicCalibration() override;
+
+		/** Get name. */
+		const char* get_name() const override
+		{
+			return "IsotonicCalibration";
+		}
+
+		/** Fit the isotonic function for binary labels.
+		* @param predictions The predictions outputted by the machine
+		* @param targets The true labels corresponding to the predictions
+		* @return Indicates whether the calibration was succesful
+		**/
+		bool fit_binary(
+		    std::shared_ptr<BinaryLabels> predictions,
+		    std::shared_ptr<BinaryLabels> targets) override;
+
+		/** Calibrate binary predictions based on the function learned by
+		* calling fit.
+		* @param predictions The predictions outputted by the machine
+		* @return Calibrated binary labels
+		**/
+		std::shared_ptr<BinaryLabels>
+		calibrate_binary(std::shared_ptr<BinaryLabels> predictions) override;
+
+		/** Fit an isotonic function for each class seperately, the classes
+		* in parallel.
+		* @param predictions The predictions outputted by the machine
+		* @param targets The true labels corresponding to the predictions
+		* @return Indicates whether the calibration was succesful
+		**/
+		bool fit_multiclass(
+		    std::shared_ptr<MulticlassLabels> predictions,
+		    std::shared_ptr<MulticlassLabels> targets) override;
+
+		/** Calibrate the outputs of one vector by the function of each
+		* class. The outputs are normalized over all classes.
+		* @param outputs The outputs of the vector for every class
+		**/
+		void
+		calibrate_multiclass_outputs(SGVector<float64_t> outputs) const override;
+
+		/** @return Number of classes the functions are fitted for **/
+		index_t get_num_calibrated_classes() const override
+		{
+			return m_offsets.vlen ? m_offsets.vlen - 1 : 0;
+		}
+
+	private:
+		/** Initialize parameters */
+		void init();
+
+		/** Probability of a prediction under the function of a class
+		* @param value The prediction
+		* @param c The class
+		* @return The calibrated probability
+		*/
+		float64_t calibrate_value(float64_t value, index_t c) const;
+
+	private:
+		/** Predictions where the functions of all classes are fitted, the
+		* ones of each class in increasing order. */
+		SGVector<float64_t> m_predictions;
+		/** Probabilities of the fitted predictions. */
+		SGVector<float64_t> m_probabilities;
+		/** Offset of the fitted predictions of each class, the last one is
+		* the total number of them. */
+		SGVector<index_t> m_offsets;
+	#ifndef SWIG
+	public:
+		static constexpr std::string_view kPredictions = "predictions";
+		static constexpr std::string_view kProbabilities = "probabilities";
+		static constexpr std::string_view kOffsets = "offsets";
+	#endif
+	};
+}
+#endif
@@ -4,11 +4,15 @@
  * Authors: Soeren Sonnenburg, Sergey Lisitsyn, Evan Shelhamer
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/MulticlassAccuracy.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace shogun;
 
 float64_t MulticlassAccuracy::evaluate(std::shared_ptr<Labels> predicted, std::shared_ptr<Labels> ground_truth)
@@ -18,34 +22,29 @@ float64_t MulticlassAccuracy::evaluate(std::shared_ptr<Labels> predicted, std::s
 	int32_t length = predicted->get_num_labels();
 	auto predicted_mc = multiclass_labels(predicted);
 	auto ground_truth_mc = multiclass_labels(ground_truth);
-	int32_t correct = 0;
-	if (m_ignore_rejects)
+	auto predicted_labels = predicted_mc->get_int_labels();
+	auto ground_truth_labels = ground_truth_mc->get_int_labels();
+	const int32_t rejection_label = predicted_mc->REJECTION_LABEL;
+
+	int64_t correct = 0;
+	int64_t rejected = 0;
+	#pragma omp parallel for reduction(+:correct,rejected) \
+		num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<length; i++)
 	{
-		for (int32_t i=0; i<length; i++)
-		{
-			if (predicted_mc->get_int_label(i) ==
-			    ground_truth_mc->get_int_label(i))
-				correct++;
-		}
-		return ((float64_t)correct)/length;
+		if (!m_ignore_rejects && predicted_labels[i] == rejection_label)
+			rejected++;
+		else if (predicted_labels[i] == ground_truth_labels[i])
+			correct++;
 	}
-	else
-	{
-		int32_t total = length;
-		for (int32_t i=0; i<length; i++)
-		{
-			int32_t predicted_label = predicted_mc->get_int_label(i);
 
-			if (predicted_label == predicted_mc->REJECTION_LABEL)
-				total--;
-			else if (predicted_label == ground_truth_mc->get_int_label(i))
-				correct++;
-		}
-		m_rejects_num = length-total;
-		SG_DEBUG("correct={}, total={}, rejected={}",correct,total,length-total)
-		return ((float64_t)correct)/total;
-	}
-	return 0.0;
+	if (m_ignore_rejects)
+		return ((float64_t)correct)/length;
+
+	int32_t total = length - rejected;
+	m_rejects_num = rejected;
+	SG_DEBUG("correct={}, total={}, rejected={}",correct,total,length-total)
+	return ((float64_t)correct)/total;
 }
 
 SGMatrix<int32_t> MulticlassAccuracy::get_confusion_matrix(const std::shared_ptr<Labels>& predicted, const std::shared_ptr<Labels>& ground_truth)
@@ -55,19 +54,40 @@ SGMatrix<int32_t> MulticlassAccuracy::get_confusion_matrix(const std::shared_ptr
 	auto predicted_mc = multiclass_labels(predicted);
 	auto ground_truth_mc = multiclass_labels(ground_truth);
 	int32_t num_classes = ground_truth_mc->get_num_classes();
-	SGMatrix<int32_t> confusion_matrix(num_classes, num_classes);
-	memset(confusion_matrix.matrix,0,sizeof(int32_t)*num_classes*num_classes);
+	auto predicted_labels = predicted_mc->get_int_labels();
+	auto ground_truth_labels = ground_truth_mc->get_int_labels();
+	const int64_t num_cells = int64_t(num_classes) * num_classes;
 
-	for (int32_t i=0; i<length; i++)
+	// every thread counts into its own table, as long as the tables are
+	// small compared to the number of labels
+	const int32_t num_threads = std::max<int64_t>(
+		1, std::min<int64_t>(
+			   env()->get_num_threads(), length / std::max<int64_t>(num_cells, 1024)));
+	std::vector<SGMatrix<int32_t>> tables(num_threads);
+
+	#pragma omp parallel for num_threads(num_threads) schedule(static)
+	for (int32_t t = 0; t < num_threads; t++)
 	{
-		int32_t predicted_label = predicted_mc->get_int_label(i);
-		int32_t ground_truth_label = ground_truth_mc->get_int_label(i);
+		SGMatrix<int32_t> table(num_classes, num_classes);
+		table.zero();
+		const int32_t begin = (int64_t)length * t / num_threads;
+		const int32_t end = (int64_t)length * (t + 1) / num_threads;
+		for (int32_t i = begin; i < end; i++)
+		{
+			int32_t predicted_label = predicted_labels[i];
+			if (predicted_label==predicted_mc->REJECTION_LABEL)
+				continue;
 
-		if (predicted_label==predicted_mc->REJECTION_LABEL)
-			continue;
+			table[predicted_label*num_classes+ground_truth_labels[i]]++;
+		}
+		tables[t] = table;
+	}
 
-		confusion_matrix[predicted_label*num_classes+ground_truth_label]++;
+	SGMatrix<int32_t> confusion_matrix = tables[0];
+	for (int32_t t = 1; t < num_threads; t++)
+	{
+		for (int64_t k = 0; k < num_cells; k++)
+			confusion_matrix[k] += tables[t][k];
 	}
 	return confusion_matrix;
 }
-
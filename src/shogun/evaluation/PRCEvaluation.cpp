@@ -5,11 +5,16 @@
  *          Evangelos Anagnostopoulos
  */
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/BinaryScoreHistogram.h>
 #include <shogun/evaluation/PRCEvaluation.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace shogun;
 
 PRCEvaluation::PRCEvaluation() : BinaryClassEvaluation(), m_computed(false)
@@ -17,6 +22,10 @@ PRCEvaluation::PRCEvaluation() : BinaryClassEvaluation(), m_computed(false)
 	m_PRC_graph = SGMatrix<float64_t>();
 	m_thresholds = SGVector<float64_t>();
 	m_auPRC = 0.0;
+	m_tolerance = 0.0;
+	SG_ADD(
+	    &m_tolerance, "tolerance",
+	    "Error bound of the approximate auPRC, exact if zero");
 	watch_method("PRC", &PRCEvaluation::get_PRC);
 	watch_method("thresholds", &PRCEvaluation::get_thresholds);
 	watch_method("auPRC", &PRCEvaluation::get_auPRC);
@@ -34,56 +43,65 @@ float64_t PRCEvaluation::evaluate(std::shared_ptr<Labels> predicted, std::shared
 	ASSERT(ground_truth->get_label_type() == LT_BINARY)
 	ground_truth->ensure_valid();
 
-	// number of true positive examples
-	float64_t tp = 0.0;
-	int32_t i;
+	auto scores = predicted->get_values();
+	auto truth = ground_truth->get_values();
 
-	// total number of positive labels in predicted
-	int32_t pos_count = 0;
+	if (m_tolerance > 0)
+		return evaluate_approximate(scores, truth);
 
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels = predicted->get_values();
-	int32_t length = orig_labels.vlen;
-	float64_t* labels =
-	    SGVector<float64_t>::clone_vector(orig_labels.vector, length);
+	const index_t length = scores.vlen;
+	auto idxs = argsort_descending(scores);
 
-	// get indexes for sort
-	int32_t* idxs = SG_MALLOC(int32_t, length);
-	for (i = 0; i < length; i++)
-		idxs[i] = i;
+	// every thread counts the positives of a chunk of the sorted scores,
+	// then writes its part of the graph starting from the counts of all
+	// preceding chunks
+	const int32_t num_chunks = std::max<int64_t>(
+		1, std::min<int64_t>(env()->get_num_threads(), length / 4096));
+	std::vector<index_t> bounds(num_chunks + 1);
+	for (int32_t c = 0; c <= num_chunks; c++)
+		bounds[c] = (int64_t)length * c / num_chunks;
 
-	// sort indexes by labels ascending
-	Math::qsort_backward_index(labels, idxs, length);
+	std::vector<index_t> pos(num_chunks + 1, 0);
 
-	// clean and initialize graph and auPRC
-	SG_FREE(labels);
-	m_PRC_graph = SGMatrix<float64_t>(2, length);
-	m_thresholds = SGVector<float64_t>(length);
-	m_auPRC = 0.0;
-
-	// get total numbers of positive and negative labels
-	for (i = 0; i < length; i++)
+	#pragma omp parallel for num_threads(num_chunks) schedule(static)
+	for (int32_t c = 0; c < num_chunks; c++)
 	{
-		if (ground_truth->get_value(i) > 0)
-			pos_count++;
+		for (index_t i = bounds[c]; i < bounds[c + 1]; i++)
+			pos[c + 1] += truth[idxs[i]] > 0;
 	}
 
+	for (int32_t c = 0; c < num_chunks; c++)
+		pos[c + 1] += pos[c];
+
+	// total number of positive labels
+	const index_t pos_count = pos[num_chunks];
+
 	// assure number of positive examples is >0
 	ASSERT(pos_count > 0)
 
+	// clean and initialize graph and auPRC
+	m_PRC_graph = SGMatrix<float64_t>(2, length);
+	m_thresholds = SGVector<float64_t>(length);
+	m_auPRC = 0.0;
+
 	// create PRC curve
-	for (i = 0; i < length; i++)
+	#pragma omp parallel for num_threads(num_chunks) schedule(static)
+	for (int32_t c = 0; c < num_chunks; c++)
 	{
-		// update number of true positive examples
-		if (ground_truth->get_value(idxs[i]) > 0)
-			tp += 1.0;
-
-		// precision (x)
-		m_PRC_graph[2 * i] = tp / float64_t(i + 1);
-		// recall (y)
-		m_PRC_graph[2 * i + 1] = tp / float64_t(pos_count);
-
-		m_thresholds[i] = predicted->get_value(idxs[i]);
+		// number of true positive examples
+		float64_t tp = pos[c];
+		for (index_t i = bounds[c]; i < bounds[c + 1]; i++)
+		{
+			if (truth[idxs[i]] > 0)
+				tp += 1.0;
+
+			// precision (x)
+			m_PRC_graph[2 * i] = tp / float64_t(i + 1);
+			// recall (y)
+			m_PRC_graph[2 * i + 1] = tp / float64_t(pos_count);
+
+			m_thresholds[i] = scores[idxs[i]];
+		}
 	}
 
 	// calc auRPC using area under curve
@@ -92,10 +110,51 @@ float64_t PRCEvaluation::evaluate(std::shared_ptr<Labels> predicted, std::shared
 	// set computed indicator
 	m_computed = true;
 
-	SG_FREE(idxs);
 	return m_auPRC;
 }
 
+float64_t PRCEvaluation::evaluate_approximate(
+    const SGVector<float64_t>& scores, const SGVector<float64_t>& truth)
+{
+	float64_t min_score;
+	float64_t max_score;
+	BinaryScoreHistogram::score_range(scores, min_score, max_score);
+
+	// refine the bins until the error bound meets the tolerance
+	std::shared_ptr<BinaryScoreHistogram> histogram;
+	for (int32_t num_bins = kInitialNumBins;; num_bins *= 16)
+	{
+		histogram = std::make_shared<BinaryScoreHistogram>(
+		    num_bins, min_score, max_score);
+		histogram->add(scores, truth);
+
+		if (histogram->get_auPRC_error_bound() <= m_tolerance)
+			break;
+		if (num_bins >= kMaxNumBins)
+		{
+			io::warn(
+			    "{}: auPRC error bound {} exceeds tolerance {} with {} bins, "
+			    "probably because of tied scores",
+			    get_name(), histogram->get_auPRC_error_bound(), m_tolerance,
+			    num_bins);
+			break;
+		}
+	}
+
+	m_PRC_graph = histogram->get_PRC();
+	m_thresholds = histogram->get_thresholds();
+	m_auPRC = histogram->get_auPRC();
+	m_computed = true;
+
+	return m_auPRC;
+}
+
+void PRCEvaluation::set_tolerance(float64_t tolerance)
+{
+	require(tolerance >= 0, "Tolerance ({}) must not be negative", tolerance);
+	m_tolerance = tolerance;
+}
+
 SGMatrix<float64_t> PRCEvaluation::get_PRC() const
 {
 	if (!m_computed)
@@ -20,6 +20,12 @@ class Labels;
 /** @brief Class PRCEvaluation used to evaluate PRC
  * (Precision Recall Curve) and an area under PRC curve (auPRC).
  *
+ * The scores are sorted and scanned on env()->get_num_threads() threads.
+ * For very large numbers of examples, a tolerance can be set instead, in
+ * which case the PRC is approximated from a BinaryScoreHistogram without
+ * sorting. The bins are refined until the auPRC error bound meets the
+ * tolerance, and the PRC graph and thresholds then have one point per
+ * non-empty bin.
  */
 class PRCEvaluation: public BinaryClassEvaluation
 {
@@ -62,7 +68,20 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds() const;
 
+	/** set the tolerance of the approximate auPRC
+	 * @param tolerance error bound of the auPRC, exact evaluation if zero
+	 */
+	void set_tolerance(float64_t tolerance);
+
 protected:
+	/** approximate PRC and auPRC from a histogram of the scores
+	 * @param scores predicted scores
+	 * @param truth ground truth labels
+	 * @return auPRC
+	 */
+	float64_t evaluate_approximate(
+		const SGVector<float64_t>& scores, const SGVector<float64_t>& truth);
+
 
 	/** 2-d array used to store PRC graph */
 	SGMatrix<float64_t> m_PRC_graph;
@@ -75,6 +94,15 @@ protected:
 
 	/** indicator of PRC and auPRC being computed already */
 	bool m_computed;
+
+	/** error bound of the approximate auPRC, exact if zero */
+	float64_t m_tolerance;
+
+	/** number of bins of the first approximation */
+	static constexpr int32_t kInitialNumBins = 1024;
+
+	/** largest number of bins */
+	static constexpr int32_t kMaxNumBins = 1 << 22;
 };
 
 }
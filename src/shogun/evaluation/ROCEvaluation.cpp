@@ -5,15 +5,24 @@
  *          Chinmay Kousik, Leon Kuchenbecker
  */
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/BinaryScoreHistogram.h>
 #include <shogun/evaluation/ROCEvaluation.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace shogun;
 
 ROCEvaluation::ROCEvaluation() : BinaryClassEvaluation(), m_computed(false)
 {
 	m_ROC_graph = SGMatrix<float64_t>();
 	m_thresholds = SGVector<float64_t>();
+	m_tolerance = 0.0;
+	SG_ADD(
+	    &m_tolerance, "tolerance",
+	    "Error bound of the approximate auROC, exact if zero");
 	watch_method("auROC", &ROCEvaluation::get_auROC);
 	watch_method("ROC", &ROCEvaluation::get_ROC);
 	watch_method("thresholds", &ROCEvaluation::get_thresholds);
@@ -45,59 +54,58 @@ float64_t ROCEvaluation::evaluate_roc(const std::shared_ptr<BinaryLabels>& predi
 	ASSERT(predicted->get_num_labels() == ground_truth->get_num_labels())
 	ground_truth->ensure_valid();
 
-	// assume threshold as negative infinity
-	float64_t threshold = Math::ALMOST_NEG_INFTY;
-	// false positive rate
-	float64_t fp = 0.0;
-	// true positive rate
-	float64_t tp = 0.0;
-
-	int32_t i;
-	// total number of positive labels in predicted
-	int32_t pos_count = 0;
-	int32_t neg_count = 0;
-
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels(predicted->get_num_labels());
-	int32_t length = orig_labels.vlen;
-	for (i = 0; i < length; i++)
-		orig_labels[i] = predicted->get_value(i);
-	float64_t* labels =
-	    SGVector<float64_t>::clone_vector(orig_labels.vector, length);
-
-	// get sorted indexes
-	SGVector<int32_t> idxs(length);
-	for (i = 0; i < length; i++)
-		idxs[i] = i;
-
-	Math::qsort_backward_index(labels, idxs.vector, idxs.vlen);
+	auto scores = predicted->get_values();
+	auto truth = ground_truth->get_labels();
 
-	// number of different predicted labels
-	int32_t diff_count = 1;
+	if (m_tolerance > 0)
+		return evaluate_approximate(scores, truth);
 
-	// get number of different labels
-	for (i = 0; i < length - 1; i++)
-	{
-		if (labels[i] != labels[i + 1])
-			diff_count++;
-	}
+	const index_t length = scores.vlen;
+	auto idxs = argsort_descending(scores);
 
-	SG_FREE(labels);
+	// every thread scans a chunk of the sorted scores twice, first to count
+	// its positives, negatives and thresholds, then to write its part of the
+	// graph starting from the counts of all preceding chunks
+	const int32_t num_chunks = std::max<int64_t>(
+		1, std::min<int64_t>(env()->get_num_threads(), length / 4096));
+	std::vector<index_t> bounds(num_chunks + 1);
+	for (int32_t c = 0; c <= num_chunks; c++)
+		bounds[c] = (int64_t)length * c / num_chunks;
 
-	// initialize graph and auROC
-	m_ROC_graph = SGMatrix<float64_t>(2, diff_count + 1);
-	m_thresholds = SGVector<float64_t>(length);
-	m_auROC = 0.0;
+	auto is_new_threshold = [&](index_t i) {
+		return i == 0 || scores[idxs[i]] != scores[idxs[i - 1]];
+	};
+
+	std::vector<index_t> pos(num_chunks + 1, 0);
+	std::vector<index_t> neg(num_chunks + 1, 0);
+	std::vector<index_t> diff(num_chunks + 1, 0);
+
+	#pragma omp parallel for num_threads(num_chunks) schedule(static)
+	for (int32_t c = 0; c < num_chunks; c++)
+	{
+		for (index_t i = bounds[c]; i < bounds[c + 1]; i++)
+		{
+			if (truth[idxs[i]] > 0)
+				pos[c + 1]++;
+			else
+				neg[c + 1]++;
+			diff[c + 1] += is_new_threshold(i);
+		}
+	}
 
-	// get total numbers of positive and negative labels
-	for (i = 0; i < length; i++)
+	for (int32_t c = 0; c < num_chunks; c++)
 	{
-		if (ground_truth->get_label(i) >= 0)
-			pos_count++;
-		else
-			neg_count++;
+		pos[c + 1] += pos[c];
+		neg[c + 1] += neg[c];
+		diff[c + 1] += diff[c];
 	}
 
+	// total numbers of positive and negative labels
+	const index_t pos_count = pos[num_chunks];
+	const index_t neg_count = neg[num_chunks];
+	// number of different predicted labels
+	const index_t diff_count = diff[num_chunks];
+
 	// assure both number of positive and negative examples is >0
 	require(
 	    pos_count > 0,
@@ -110,28 +118,34 @@ float64_t ROCEvaluation::evaluate_roc(const std::shared_ptr<BinaryLabels>& predi
 	    "zero, ROC fails!",
 	    get_name());
 
-	int32_t j = 0;
-	float64_t label;
+	// initialize graph and auROC
+	m_ROC_graph = SGMatrix<float64_t>(2, diff_count + 1);
+	m_thresholds = SGVector<float64_t>(length);
+	m_auROC = 0.0;
 
-	// create ROC curve and calculate auROC
-	for (i = 0; i < length; i++)
+	// create ROC curve, with a point before every new threshold
+	#pragma omp parallel for num_threads(num_chunks) schedule(static)
+	for (int32_t c = 0; c < num_chunks; c++)
 	{
-		label = predicted->get_value(idxs[i]);
-
-		if (label != threshold)
+		float64_t tp = pos[c];
+		float64_t fp = neg[c];
+		index_t j = diff[c];
+		for (index_t i = bounds[c]; i < bounds[c + 1]; i++)
 		{
-			threshold = label;
-			m_ROC_graph[2 * j] = fp / neg_count;
-			m_ROC_graph[2 * j + 1] = tp / pos_count;
-			j++;
+			if (is_new_threshold(i))
+			{
+				m_ROC_graph[2 * j] = fp / neg_count;
+				m_ROC_graph[2 * j + 1] = tp / pos_count;
+				j++;
+			}
+
+			m_thresholds[i] = scores[idxs[i]];
+
+			if (truth[idxs[i]] > 0)
+				tp += 1.0;
+			else
+				fp += 1.0;
 		}
-
-		m_thresholds[i] = threshold;
-
-		if (ground_truth->get_label(idxs[i]) > 0)
-			tp += 1.0;
-		else
-			fp += 1.0;
 	}
 
 	// add (1,1) to ROC curve
@@ -147,6 +161,48 @@ float64_t ROCEvaluation::evaluate_roc(const std::shared_ptr<BinaryLabels>& predi
 	return m_auROC;
 }
 
+float64_t ROCEvaluation::evaluate_approximate(
+    const SGVector<float64_t>& scores, const SGVector<float64_t>& truth)
+{
+	float64_t min_score;
+	float64_t max_score;
+	BinaryScoreHistogram::score_range(scores, min_score, max_score);
+
+	// refine the bins until the error bound meets the tolerance
+	std::shared_ptr<BinaryScoreHistogram> histogram;
+	for (int32_t num_bins = kInitialNumBins;; num_bins *= 16)
+	{
+		histogram = std::make_shared<BinaryScoreHistogram>(
+		    num_bins, min_score, max_score);
+		histogram->add(scores, truth);
+
+		if (histogram->get_auROC_error_bound() <= m_tolerance)
+			break;
+		if (num_bins >= kMaxNumBins)
+		{
+			io::warn(
+			    "{}: auROC error bound {} exceeds tolerance {} with {} bins, "
+			    "probably because of tied scores",
+			    get_name(), histogram->get_auROC_error_bound(), m_tolerance,
+			    num_bins);
+			break;
+		}
+	}
+
+	m_ROC_graph = histogram->get_ROC();
+	m_thresholds = histogram->get_thresholds();
+	m_auROC = histogram->get_auROC();
+	m_computed = true;
+
+	return m_auROC;
+}
+
+void ROCEvaluation::set_tolerance(float64_t tolerance)
+{
+	require(tolerance >= 0, "Tolerance ({}) must not be negative", tolerance);
+	m_tolerance = tolerance;
+}
+
 SGMatrix<float64_t> ROCEvaluation::get_ROC() const
 {
 	if (!m_computed)
@@ -25,6 +25,13 @@ class Labels;
  *
  * Fawcett, Tom (2004) ROC Graphs:
  * Notes and Practical Considerations for Researchers; Machine Learning, 2004
+ *
+ * The scores are sorted and scanned on env()->get_num_threads() threads.
+ * For very large numbers of examples, a tolerance can be set instead, in
+ * which case the ROC is approximated from a BinaryScoreHistogram without
+ * sorting. The bins are refined until the auROC is accurate to the
+ * tolerance, and the ROC graph and thresholds then have one point per
+ * non-empty bin.
  */
 class ROCEvaluation: public BinaryClassEvaluation
 {
@@ -65,6 +72,11 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds() const;
 
+	/** set the tolerance of the approximate auROC
+	 * @param tolerance largest error of the auROC, exact evaluation if zero
+	 */
+	void set_tolerance(float64_t tolerance);
+
 protected:
 
 	/** evaluate ROC and auROC
@@ -74,6 +86,14 @@ protected:
 	 */
 	float64_t evaluate_roc(const std::shared_ptr<BinaryLabels>& predicted, const std::shared_ptr<BinaryLabels>& ground_truth);
 
+	/** approximate ROC and auROC from a histogram of the scores
+	 * @param scores predicted scores
+	 * @param truth ground truth labels
+	 * @return auROC
+	 */
+	float64_t evaluate_approximate(
+		const SGVector<float64_t>& scores, const SGVector<float64_t>& truth);
+
 protected:
 
 	/** 2-d array used to store ROC graph */
@@ -87,6 +107,15 @@ protected:
 
 	/** indicator of ROC and auROC being computed already */
 	bool m_computed;
+
+	/** error bound of the approximate auROC, exact if zero */
+	float64_t m_tolerance;
+
+	/** number of bins of the first approximation */
+	static constexpr int32_t kInitialNumBins = 1024;
+
+	/** largest number of bins */
+	static constexpr int32_t kMaxNumBins = 1 << 22;
 };
 
 }
@@ -0,0 +1,285 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/range.h>
+#include <shogun/evaluation/RidgeLeaveOneOut.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/machine/GaussianProcess.h>
+#include <shogun/machine/KernelMachine.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/gp/MeanFunction.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <string_view>
+
+using namespace shogun;
+using namespace Eigen;
+
+RidgeLeaveOneOut::RidgeLeaveOneOut() : SGObject()
+{
+	init();
+}
+
+RidgeLeaveOneOut::RidgeLeaveOneOut(
+    const std::shared_ptr<Machine>& machine,
+    const std::shared_ptr<Features>& features,
+    const std::shared_ptr<Labels>& labels)
+    : SGObject()
+{
+	init();
+
+	require(
+	    is_supported(machine), "Leave-one-out predictions of {} cannot be "
+	    "computed analytically", machine ? machine->get_name() : "NULL");
+	require(features, "No features provided");
+	require(labels, "No labels provided");
+	require(
+	    features->get_num_vectors() == labels->get_num_labels(),
+	    "Number of vectors ({}) does not match number of labels ({})",
+	    features->get_num_vectors(), labels->get_num_labels());
+
+	m_labels = regression_labels(labels)->get_labels();
+	const index_t n = m_labels.vlen;
+	m_offset = SGVector<float64_t>(n);
+	m_offset.zero();
+
+	const std::string_view name = machine->get_name();
+	if (name == "LinearRidgeRegression")
+	{
+		m_regularization = machine->get<float64_t>("tau");
+
+		auto dot_features = std::dynamic_pointer_cast<DotFeatures>(features);
+		require(dot_features, "{} requires dot features", name);
+		auto X = dot_features->get_computed_dot_feature_matrix();
+		Map<MatrixXd> eigen_X(X.matrix, X.num_rows, X.num_cols);
+
+		if (machine->get<bool>("use_bias"))
+		{
+			/* the unpenalized bias is fitted by centering, its leverage is
+			 * 1/n for every vector */
+			Map<VectorXd>(m_offset.vector, n).setConstant(
+			    Map<VectorXd>(m_labels.vector, n).mean());
+			m_offset_leverage = 1.0 / n;
+			VectorXd mean = eigen_X.rowwise().mean();
+			eigen_X.colwise() -= mean;
+		}
+
+		if (X.num_rows < n)
+		{
+			SelfAdjointEigenSolver<MatrixXd> solver(
+			    eigen_X * eigen_X.transpose());
+			m_eigenvalues = SGVector<float64_t>(X.num_rows);
+			m_basis = SGMatrix<float64_t>(X.num_rows, n);
+			Map<VectorXd>(m_eigenvalues.vector, X.num_rows) =
+			    solver.eigenvalues().cwiseMax(0.0);
+			Map<MatrixXd>(m_basis.matrix, X.num_rows, n) =
+			    solver.eigenvectors().transpose() * eigen_X;
+		}
+		else
+		{
+			SGMatrix<float64_t> gram(n, n);
+			Map<MatrixXd>(gram.matrix, n, n) = eigen_X.transpose() * eigen_X;
+			decompose_kernel(gram);
+		}
+	}
+	else if (name == "KernelRidgeRegression")
+	{
+		m_regularization = machine->get<float64_t>("tau");
+
+		auto kernel =
+		    make_clone(machine->as<KernelMachine>()->get_kernel());
+		kernel->init(features, features);
+		decompose_kernel(kernel->get_kernel_matrix());
+		kernel->remove_lhs_and_rhs();
+	}
+	else
+	{
+		auto inference =
+		    machine->as<GaussianProcess>()->get_inference_method();
+		auto likelihood =
+		    inference->get_model()->as<GaussianLikelihood>();
+		m_regularization = Math::sq(likelihood->get_sigma());
+
+		m_offset = inference->get_mean()->get_mean_vector(features);
+
+		auto kernel = make_clone(inference->get_kernel());
+		kernel->init(features, features);
+		auto kernel_matrix = kernel->get_kernel_matrix();
+		kernel->remove_lhs_and_rhs();
+
+		Map<MatrixXd>(kernel_matrix.matrix, n, n) *=
+		    Math::sq(inference->get_scale());
+		decompose_kernel(kernel_matrix);
+	}
+
+	m_projected_labels = SGVector<float64_t>(m_eigenvalues.vlen);
+	Map<VectorXd>(m_projected_labels.vector, m_eigenvalues.vlen) =
+	    Map<MatrixXd>(m_basis.matrix, m_basis.num_rows, n) *
+	    (Map<VectorXd>(m_labels.vector, n) - Map<VectorXd>(m_offset.vector, n));
+}
+
+RidgeLeaveOneOut::~RidgeLeaveOneOut()
+{
+}
+
+void RidgeLeaveOneOut::init()
+{
+	m_offset_leverage = 0;
+	m_regularization = 0;
+
+	SG_ADD(&m_labels, "labels", "Labels");
+	SG_ADD(&m_offset, "offset", "Offset subtracted from the labels");
+	SG_ADD(&m_offset_leverage, "offset_leverage", "Leverage of the offset");
+	SG_ADD(&m_eigenvalues, "eigenvalues", "Eigenvalues");
+	SG_ADD(&m_basis, "basis", "Training vectors in the eigenbasis");
+	SG_ADD(
+	    &m_projected_labels, "projected_labels",
+	    "Labels in the eigenbasis");
+	SG_ADD(&m_regularization, "regularization", "Regularization of the machine");
+}
+
+bool RidgeLeaveOneOut::is_supported(const std::shared_ptr<Machine>& machine)
+{
+	if (!machine)
+		return false;
+
+	const std::string_view name = machine->get_name();
+	if (name == "LinearRidgeRegression")
+		return true;
+
+	if (name == "KernelRidgeRegression")
+		return machine->as<KernelMachine>()->get_kernel() != nullptr;
+
+	if (name == "GaussianProcessRegression")
+	{
+		auto inference =
+		    machine->as<GaussianProcess>()->get_inference_method();
+		return inference &&
+		       std::string_view(inference->get_name()) ==
+		           "ExactInferenceMethod" &&
+		       inference->get_model() &&
+		       inference->get_model()->get_model_type() == LT_GAUSSIAN;
+	}
+
+	return false;
+}
+
+void RidgeLeaveOneOut::decompose_kernel(SGMatrix<float64_t> kernel_matrix)
+{
+	const index_t n = kernel_matrix.num_rows;
+	SelfAdjointEigenSolver<MatrixXd> solver(
+	    Map<MatrixXd>(kernel_matrix.matrix, n, n));
+
+	/* K = U diag(l) U^T, so with B = diag(sqrt(l)) U^T the hat matrix is
+	 * B^T diag(1/(l+tau)) B, as in the primal case */
+	m_eigenvalues = SGVector<float64_t>(n);
+	Map<VectorXd> eigenvalues(m_eigenvalues.vector, n);
+	eigenvalues = solver.eigenvalues().cwiseMax(0.0);
+
+	m_basis = SGMatrix<float64_t>(n, n);
+	Map<MatrixXd>(m_basis.matrix, n, n) =
+	    eigenvalues.cwiseSqrt().asDiagonal() *
+	    solver.eigenvectors().transpose();
+}
+
+void RidgeLeaveOneOut::fit(
+    float64_t regularization, SGVector<float64_t>& fitted,
+    SGVector<float64_t>& leverage) const
+{
+	require(
+	    regularization > 0, "Regularization ({}) must be positive",
+	    regularization);
+
+	const index_t n = m_labels.vlen;
+	Map<const MatrixXd> basis(m_basis.matrix, m_basis.num_rows, n);
+	ArrayXd shrinkage =
+	    (Map<const ArrayXd>(m_eigenvalues.vector, m_eigenvalues.vlen) +
+	     regularization)
+	        .inverse();
+
+	fitted = SGVector<float64_t>(n);
+	Map<VectorXd>(fitted.vector, n) =
+	    Map<const VectorXd>(m_offset.vector, n) +
+	    basis.transpose() *
+	        (Map<const ArrayXd>(
+	             m_projected_labels.vector, m_projected_labels.vlen) *
+	         shrinkage)
+	            .matrix();
+
+	leverage = SGVector<float64_t>(n);
+	Map<VectorXd>(leverage.vector, n) =
+	    (basis.array().square().colwise() * shrinkage)
+	        .colwise()
+	        .sum()
+	        .transpose() +
+	    m_offset_leverage;
+}
+
+SGVector<float64_t>
+RidgeLeaveOneOut::loo_predictions(float64_t regularization) const
+{
+	if (regularization < 0)
+		regularization = m_regularization;
+
+	SGVector<float64_t> fitted;
+	SGVector<float64_t> leverage;
+	fit(regularization, fitted, leverage);
+
+	SGVector<float64_t> predictions(m_labels.vlen);
+	for (auto i : range(m_labels.vlen))
+	{
+		predictions[i] = m_labels[i] -
+		                 (m_labels[i] - fitted[i]) / (1.0 - leverage[i]);
+	}
+
+	return predictions;
+}
+
+SGVector<float64_t>
+RidgeLeaveOneOut::loo_errors(SGVector<float64_t> regularizations) const
+{
+	SGVector<float64_t> errors(regularizations.vlen);
+	for (auto k : range(regularizations.vlen))
+	{
+		SGVector<float64_t> fitted;
+		SGVector<float64_t> leverage;
+		fit(regularizations[k], fitted, leverage);
+
+		float64_t sum = 0;
+		for (auto i : range(m_labels.vlen))
+			sum += Math::sq((m_labels[i] - fitted[i]) / (1.0 - leverage[i]));
+		errors[k] = sum / m_labels.vlen;
+	}
+
+	return errors;
+}
+
+SGVector<float64_t>
+RidgeLeaveOneOut::gcv_errors(SGVector<float64_t> regularizations) const
+{
+	SGVector<float64_t> errors(regularizations.vlen);
+	for (auto k : range(regularizations.vlen))
+	{
+		SGVector<float64_t> fitted;
+		SGVector<float64_t> leverage;
+		fit(regularizations[k], fitted, leverage);
+
+		float64_t residuals = 0;
+		float64_t trace = 0;
+		for (auto i : range(m_labels.vlen))
+		{
+			residuals += Math::sq(m_labels[i] - fitted[i]);
+			trace += leverage[i];
+		}
+		errors[k] = residuals / m_labels.vlen /
+		            Math::sq(1.0 - trace / m_labels.vlen);
+	}
+
+	return errors;
+}
@@ -0,0 +1,142 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __RIDGELEAVEONEOUT_H_
+#define __RIDGELEAVEONEOUT_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+	class Machine;
+	class Features;
+	class Labels;
+
+	/** @brief Exact leave-one-out and generalized cross-validation of
+	 * ridge-type regression machines, without retraining.
+	 *
+	 * The predictions of LinearRidgeRegression, KernelRidgeRegression and
+	 * GaussianProcessRegression (with exact inference and a Gaussian
+	 * likelihood) on their training data are \f$\hat{y}=Hy\f$, with the hat
+	 * matrix \f$H=K(K+\tau I)^{-1}\f$, where \f$K\f$ is the (linear) kernel
+	 * matrix and \f$\tau\f$ the regularization, i.e. tau or the noise
+	 * variance \f$\sigma^2\f$. The leave-one-out residuals then are
+	 *
+	 * \f[
+	 *   y_i-\hat{y}_{-i}=\frac{y_i-\hat{y}_i}{1-H_{ii}}
+	 * \f]
+	 *
+	 * and the generalized cross-validation error is
+	 * \f$\frac{1}{n}\|y-\hat{y}\|^2/(1-\mathrm{tr}(H)/n)^2\f$.
+	 *
+	 * The kernel matrix, or for LinearRidgeRegression with more vectors
+	 * than features the scatter matrix, is eigendecomposed once, after which
+	 * the scores for any regularization cost \f$O(rn)\f$ for rank \f$r\f$.
+	 * The unpenalized bias of LinearRidgeRegression is handled by centering,
+	 * the mean function of a Gaussian process is subtracted from the labels.
+	 *
+	 * CrossValidation uses this class when a supported machine is evaluated
+	 * with LOOCrossValidationSplitting.
+	 */
+	class RidgeLeaveOneOut : public SGObject
+	{
+	public:
+		RidgeLeaveOneOut();
+
+		/** constructor, decomposes the kernel matrix
+		 * @param machine supported regression machine, see is_supported()
+		 * @param features training features
+		 * @param labels training regression labels
+		 */
+		RidgeLeaveOneOut(
+		    const std::shared_ptr<Machine>& machine,
+		    const std::shared_ptr<Features>& features,
+		    const std::shared_ptr<Labels>& labels);
+
+		~RidgeLeaveOneOut() override;
+
+		/** @param machine machine
+		 * @return whether leave-one-out predictions of the machine can be
+		 * computed analytically
+		 */
+		static bool is_supported(const std::shared_ptr<Machine>& machine);
+
+		/** @return regularization of the machine, tau or the noise variance
+		 */
+		float64_t get_regularization() const
+		{
+			return m_regularization;
+		}
+
+		/** @param regularization regularization, defaults to the machine's
+		 * @return prediction for every training vector by the machine
+		 * trained on all other vectors
+		 */
+		SGVector<float64_t>
+		loo_predictions(float64_t regularization = -1) const;
+
+		/** @param regularizations regularizations
+		 * @return mean squared leave-one-out error for every regularization
+		 */
+		SGVector<float64_t>
+		loo_errors(SGVector<float64_t> regularizations) const;
+
+		/** @param regularizations regularizations
+		 * @return generalized cross-validation error for every
+		 * regularization
+		 */
+		SGVector<float64_t>
+		gcv_errors(SGVector<float64_t> regularizations) const;
+
+		const char* get_name() const override
+		{
+			return "RidgeLeaveOneOut";
+		}
+
+	private:
+		void init();
+
+		/** computes fitted values and hat matrix diagonal
+		 * @param regularization regularization
+		 * @param fitted fitted values of the training labels
+		 * @param leverage diagonal of the hat matrix
+		 */
+		void fit(
+		    float64_t regularization, SGVector<float64_t>& fitted,
+		    SGVector<float64_t>& leverage) const;
+
+		/** decomposes a symmetric kernel matrix into m_basis */
+		void decompose_kernel(SGMatrix<float64_t> kernel_matrix);
+
+		/** labels */
+		SGVector<float64_t> m_labels;
+
+		/** offset subtracted from the labels, the label mean or the mean
+		 * function of a Gaussian process */
+		SGVector<float64_t> m_offset;
+
+		/** leverage of the offset, 1/n if it is fitted, 0 otherwise */
+		float64_t m_offset_leverage;
+
+		/** eigenvalues */
+		SGVector<float64_t> m_eigenvalues;
+
+		/** training vectors in the eigenbasis, one row per eigenvalue */
+		SGMatrix<float64_t> m_basis;
+
+		/** projection of the offset-free labels on the eigenbasis */
+		SGVector<float64_t> m_projected_labels;
+
+		/** regularization of the machine */
+		float64_t m_regularization;
+	};
+} // namespace shogun
+
+#endif /* __RIDGELEAVEONEOUT_H_ */
@@ -4,13 +4,27 @@
  * Authors: Heiko Strathmann, Dhruv Arya
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/SigmoidCalibration.h>
+#include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/Statistics.h>
-#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <exception>
 
 using namespace shogun;
 
+namespace
+{
+	/** Probability of a value under the sigmoid with parameters a and b */
+	float64_t sigmoid(float64_t value, float64_t a, float64_t b)
+	{
+		float64_t fApB = value * a + b;
+		return fApB >= 0 ? std::exp(-fApB) / (1.0 + std::exp(-fApB))
+		                 : 1.0 / (1 + std::exp(fApB));
+	}
+}
+
 SigmoidCalibration::SigmoidCalibration() : Calibration()
 {
 	init();
@@ -120,67 +134,49 @@ bool SigmoidCalibration::fit_multiclass(
 	m_sigmoid_as.resize_vector(num_classes);
 	m_sigmoid_bs.resize_vector(num_classes);
 
+	/** The classes are independent, fit them in parallel. */
+	std::exception_ptr exception;
+	#pragma omp parallel for schedule(dynamic) \
+		num_threads(env()->get_num_threads())
 	for (index_t i = 0; i < num_classes; ++i)
 	{
-		auto class_targets = targets->get_binary_for_class(i);
-		auto pred_values = predictions->get_confidences_for_class(i);
-		auto target_labels = class_targets->get_labels();
-
-		auto sigmoid_params = Statistics::fit_sigmoid(
-		    pred_values, target_labels, m_maxiter, m_minstep, m_sigma,
-		    m_epsilon);
-		m_sigmoid_as[i] = sigmoid_params.a;
-		m_sigmoid_bs[i] = sigmoid_params.b;
-
-
+		try
+		{
+			auto class_targets = targets->get_binary_for_class(i);
+			auto pred_values = predictions->get_confidences_for_class(i);
+			auto target_labels = class_targets->get_labels();
+
+			auto sigmoid_params = Statistics::fit_sigmoid(
+			    pred_values, target_labels, m_maxiter, m_minstep, m_sigma,
+			    m_epsilon);
+			m_sigmoid_as[i] = sigmoid_params.a;
+			m_sigmoid_bs[i] = sigmoid_params.b;
+		}
+		catch (...)
+		{
+			#pragma omp critical
+			exception = std::current_exception();
+		}
 	}
+	if (exception)
+		std::rethrow_exception(exception);
 
 	return true;
 }
 
-std::shared_ptr<MulticlassLabels>
-SigmoidCalibration::calibrate_multiclass(std::shared_ptr<MulticlassLabels> predictions)
+void SigmoidCalibration::calibrate_multiclass_outputs(
+    SGVector<float64_t> outputs) const
 {
-	index_t num_classes = predictions->get_num_classes();
-	index_t num_samples = predictions->get_num_labels();
 	require(
-	    m_sigmoid_as.size() == num_classes,
-	    "Parameters not fitted, which need to be fitted before calibrating.");
+	    outputs.vlen == m_sigmoid_as.vlen,
+	    "Number of outputs ({}) does not match the number of fitted classes "
+	    "({}).",
+	    outputs.vlen, m_sigmoid_as.vlen);
 
-	/** Temporarily stores the probabilities. */
-	SGMatrix<float64_t> confidence_values(num_samples, num_classes);
+	for (index_t i = 0; i < outputs.vlen; ++i)
+		outputs[i] = sigmoid(outputs[i], m_sigmoid_as[i], m_sigmoid_bs[i]);
 
-	for (index_t i = 0; i < num_classes; ++i)
-	{
-		auto class_values = predictions->get_confidences_for_class(i);
-
-		Statistics::SigmoidParamters sigmoid_params;
-		sigmoid_params.a = m_sigmoid_as[i];
-		sigmoid_params.b = m_sigmoid_bs[i];
-
-		SGVector<float64_t> calibrated_values =
-		    calibrate_values(class_values, sigmoid_params);
-
-		confidence_values.set_column(i, calibrated_values);
-	}
-
-	auto result_labels = std::make_shared<MulticlassLabels>(num_samples);
-	result_labels->allocate_confidences_for(num_classes);
-
-	/** Normalize the probabilities. */
-	for (index_t i = 0; i < num_samples; ++i)
-	{
-		SGVector<float64_t> values = confidence_values.get_row_vector(i);
-		float64_t sum = SGVector<float64_t>::sum(values);
-
-		/** All classes have equal probability when sum is zero */
-		if (sum == 0)
-			linalg::add_scalar(values, 1. / (float64_t)num_classes);
-		else
-			linalg::scale(values, values, 1 / sum);
-		result_labels->set_multiclass_confidences(i, values);
-	}
-	return result_labels;
+	normalize_probabilities(outputs);
 }
 
 SGVector<float64_t> SigmoidCalibration::calibrate_values(
@@ -188,10 +184,6 @@ SGVector<float64_t> SigmoidCalibration::calibrate_values(
 {
 	/** Calibrate values by passing them to a sigmoid function. */
 	for (index_t i = 0; i < values.vlen; ++i)
-	{
-		float64_t fApB = values[i] * params.a + params.b;
-		values[i] = fApB >= 0 ? std::exp(-fApB) / (1.0 + std::exp(-fApB))
-		                      : 1.0 / (1 + std::exp(fApB));
-	}
+		values[i] = sigmoid(values[i], params.a, params.b);
 	return values;
 }
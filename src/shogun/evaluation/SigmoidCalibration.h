@@ -55,7 +55,7 @@ namespace shogun
 		std::shared_ptr<BinaryLabels> calibrate_binary(std::shared_ptr<BinaryLabels> predictions) override;
 
 		/** Fit calibration parameters for multiclass labels. Fits sigmoid
-		* parameters for each class seperately.
+		* parameters for each class seperately, the classes in parallel.
 		* @param predictions The predictions outputted by the machine
 		* @param targets The true labels corresponding to the predictions
 		* @return Indicates whether the calibration was succesful
@@ -63,14 +63,18 @@ namespace shogun
 		bool fit_multiclass(
 		    std::shared_ptr<MulticlassLabels> predictions, std::shared_ptr<MulticlassLabels> targets) override;
 
-		/** Calibrate multiclass predictions based on parameters learned by
-		*calling fit.
-		* The predictions are normalized over all classes.
-		* @param predictions The predictions outputted by the machine
-		* @return Calibrated binary labels
+		/** Calibrate the outputs of one vector by the sigmoid of each class.
+		* The outputs are normalized over all classes.
+		* @param outputs The outputs of the vector for every class
 		**/
-		std::shared_ptr<MulticlassLabels>
-		calibrate_multiclass(std::shared_ptr<MulticlassLabels> predictions) override;
+		void
+		calibrate_multiclass_outputs(SGVector<float64_t> outputs) const override;
+
+		/** @return Number of classes the sigmoids are fitted for **/
+		index_t get_num_calibrated_classes() const override
+		{
+			return m_sigmoid_as.size();
+		}
 
 		/** Set maximum number of iterations
 		* @param maxiter maximum number of iterations
@@ -35,24 +35,70 @@ SplittingStrategy::SplittingStrategy(const std::shared_ptr<Labels>& labels, int3
 
 void SplittingStrategy::reset_subsets()
 {
-	/* construct all arrays */
-	m_subset_indices.clear();
-	m_subset_indices.resize(m_num_subsets);
+	m_permutation = SGVector<index_t>();
+	m_subset_begin = SGVector<index_t>(m_num_subsets);
+	m_subset_end = SGVector<index_t>(m_num_subsets);
+	m_subset_begin.zero();
+	m_subset_end.zero();
 
 	m_is_filled=false;
 }
 
+void SplittingStrategy::set_subsets(
+	SGVector<index_t> permutation,
+	const std::vector<std::pair<index_t, index_t>>& ranges)
+{
+	require(
+		ranges.size() == (size_t)m_num_subsets,
+		"Number of subset ranges ({}) must match number of subsets ({})",
+		ranges.size(), m_num_subsets);
+
+	m_permutation = permutation;
+	for (index_t i=0; i<m_num_subsets; ++i)
+	{
+		require(
+			0 <= ranges[i].first && ranges[i].first <= ranges[i].second &&
+				ranges[i].second <= permutation.vlen,
+			"Range [{}, {}) of subset {} is not within the {} indices",
+			ranges[i].first, ranges[i].second, i, permutation.vlen);
+		m_subset_begin[i] = ranges[i].first;
+		m_subset_end[i] = ranges[i].second;
+	}
+
+	m_is_filled=true;
+}
+
+std::pair<index_t, index_t>
+SplittingStrategy::subset_range(index_t subset_idx) const
+{
+	if (!m_is_filled)
+	{
+		error("Call {}::build_subsets() before accessing them! If this error"
+				" stays, its an implementation error of {}::build_subsets()",
+				get_name(), get_name());
+	}
+
+	require(
+		subset_idx >= 0 && subset_idx < m_num_subsets,
+		"Subset index ({}) must be in [0, {})", subset_idx, m_num_subsets);
+
+	return std::make_pair(m_subset_begin[subset_idx], m_subset_end[subset_idx]);
+}
+
 void SplittingStrategy::init()
 {
 	m_labels=NULL;
-	m_subset_indices.clear();
 
 	m_is_filled=false;
 	m_num_subsets=0;
 
 	SG_ADD(&m_labels, kLabels, "Labels for subsets");
 	SG_ADD(
-	    &m_subset_indices, kSubsetIndices, "Set of sets of subset indices");
+	    &m_permutation, kPermutation, "Indices of all subsets");
+	SG_ADD(
+	    &m_subset_begin, kSubsetBegin, "First index of every subset");
+	SG_ADD(
+	    &m_subset_end, kSubsetEnd, "Index after the last of every subset");
 	SG_ADD(
 	    &m_is_filled, kIsFilled, "Whether ther are index sets");
 	SG_ADD(
@@ -67,51 +113,38 @@ SplittingStrategy::~SplittingStrategy()
 
 SGVector<index_t> SplittingStrategy::generate_subset_indices(index_t subset_idx) const
 {
-	if (!m_is_filled)
-	{
-		error("Call {}::build_subsets() before accessing them! If this error"
-				" stays, its an implementation error of {}::build_subsets()",
-				get_name(), get_name());
-	}
+	auto range = subset_range(subset_idx);
 
-	/* construct SGVector copy from index vector */
-	auto& to_copy = m_subset_indices.at(subset_idx);
-
-	index_t num_elements=to_copy.size();
+	index_t num_elements=range.second-range.first;
 	SGVector<index_t> result(num_elements, true);
 
 	/* copy data */
-	sg_memcpy(result.vector, to_copy.data(), sizeof(index_t)*num_elements);
-
-
+	sg_memcpy(
+		result.vector, m_permutation.vector+range.first,
+		sizeof(index_t)*num_elements);
 
 	return result;
 }
 
 SGVector<index_t> SplittingStrategy::generate_subset_inverse(index_t subset_idx) const
 {
-	if (!m_is_filled)
-	{
-		error("Call {}::build_subsets() before accessing them! If this error"
-				" stays, its an implementation error of {}::build_subsets()",
-				get_name(), get_name());
-	}
+	auto range = subset_range(subset_idx);
+	index_t num_labels=m_labels->get_num_labels();
 
-	auto& to_invert = m_subset_indices.at(subset_idx);
+	/* mark the subset, the inverse is all unmarked indices in order */
+	std::vector<bool> in_subset(num_labels, false);
+	for (index_t i=range.first; i<range.second; ++i)
+		in_subset[m_permutation[i]]=true;
 
-	SGVector<index_t> result(
-			m_labels->get_num_labels()-to_invert.size(), true);
+	SGVector<index_t> result(num_labels-(range.second-range.first), true);
 
 	index_t index=0;
-	for (index_t i=0; i<m_labels->get_num_labels(); ++i)
+	for (index_t i=0; i<num_labels; ++i)
 	{
-		/* add i to inverse indices if it is not in the to be inverted set */
-		if (std::find(to_invert.begin(), to_invert.end(), i)==to_invert.end())
+		if (!in_subset[i])
 			result.vector[index++]=i;
 	}
 
-
-
 	return result;
 }
 
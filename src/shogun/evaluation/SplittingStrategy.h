@@ -11,7 +11,10 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/base/SGObject.h>
-#include <shogun/lib/DynamicArray.h>
+#include <shogun/lib/SGVector.h>
+
+#include <utility>
+#include <vector>
 
 namespace shogun
 {
@@ -25,13 +28,14 @@ class Labels;
  * When being extended, the abstract method build_subsets() has to be
  * implemented.
  * build_subsets implementations HAVE TO call reset_subsets before, in order
- * to allow calling them from the outside. Also they HAVE to set the m_is_filled
- * flag to true (otherwise there will be an error when accessing the index sets)
+ * to allow calling them from the outside, and pass the subsets to
+ * set_subsets(), which sets the m_is_filled flag (otherwise there will be an
+ * error when accessing the index sets)
  *
- * Implementations have to (re)fill the DynamicArray<index_t> elements in the
- * (inherited) m_subset_indices variable. Note that these elements are already
- * created by the constructor of this class - they just have to be filled. Every
- * element represents one index subset.
+ * The subsets are stored compactly: all indices are stored once, in
+ * m_permutation, and every subset is a range [begin, end) of it. Ranges of
+ * different subsets may overlap, e.g. the growing windows of
+ * TimeSeriesSplitting all share the same indices.
  *
  * Calling the method agains means that the indices are rebuilt.
  */
@@ -77,9 +81,7 @@ public:
 	index_t get_num_subsets() const;
 
 	/** Abstract method.
-	 * Has to refill the elements of the m_subset_indices variable with concrete
-	 * indices. Note that DynamicArray<index_t> instances for every subset are
-	 * created in the constructor of this class - they just have to be filled.
+	 * Has to build the subsets and pass them to set_subsets().
 	 */
 	virtual void build_subsets()=0;
 
@@ -88,6 +90,20 @@ protected:
 	 * be empty again. To be called before build_subsets. */
 	void reset_subsets();
 
+	/** stores the subsets and sets the m_is_filled flag
+	 *
+	 * @param permutation indices of all subsets
+	 * @param ranges range [begin, end) of permutation of every subset
+	 */
+	void set_subsets(
+		SGVector<index_t> permutation,
+		const std::vector<std::pair<index_t, index_t>>& ranges);
+
+	/** @param subset_idx subset index
+	 * @return range [begin, end) of the subset in m_permutation
+	 */
+	std::pair<index_t, index_t> subset_range(index_t subset_idx) const;
+
 private:
 	void init();
 
@@ -97,8 +113,14 @@ protected:
 	/** labels */
 	std::shared_ptr<Labels> m_labels;
 
-	/** subset indices */
-	std::vector<std::vector<index_t>> m_subset_indices;
+	/** indices of all subsets */
+	SGVector<index_t> m_permutation;
+
+	/** first position of every subset in m_permutation */
+	SGVector<index_t> m_subset_begin;
+
+	/** position after the last of every subset in m_permutation */
+	SGVector<index_t> m_subset_end;
 
 	/** additional variable to store number of index subsets */
 	index_t m_num_subsets;
@@ -109,7 +131,9 @@ protected:
 #ifndef SWIG
 public:
 	static constexpr std::string_view kLabels = "labels";
-	static constexpr std::string_view kSubsetIndices = "subset_indices";
+	static constexpr std::string_view kPermutation = "permutation";
+	static constexpr std::string_view kSubsetBegin = "subset_begin";
+	static constexpr std::string_view kSubsetEnd = "subset_end";
 	static constexpr std::string_view kIsFilled = "is_filled";
 	static constexpr std::string_view kSumSubsets = "num_subsets";
 #endif
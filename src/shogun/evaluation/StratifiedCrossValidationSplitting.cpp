@@ -11,7 +11,9 @@
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -26,23 +28,10 @@ StratifiedCrossValidationSplitting::StratifiedCrossValidationSplitting(
 {
 }
 
-void StratifiedCrossValidationSplitting::check_labels() const
+void StratifiedCrossValidationSplitting::check_labels(
+	const SGVector<float64_t>& classes,
+	const std::vector<index_t>& labels_per_class) const
 {
-	auto dense_labels = std::static_pointer_cast<DenseLabels>(m_labels);
-	auto classes = dense_labels->get_labels().unique();
-
-	SGVector<index_t> labels_per_class(classes.size());
-
-	for (auto i : range(classes.size()))
-	{
-		labels_per_class[i] = 0;
-		for (auto j : range(dense_labels->get_num_labels()))
-		{
-			if (classes[i] == dense_labels->get_label(j))
-				labels_per_class[i]++;
-		}
-	}
-
 	for (index_t i = 0; i < classes.size(); ++i)
 	{
 		if (labels_per_class[i] < m_num_subsets)
@@ -58,64 +47,96 @@ void StratifiedCrossValidationSplitting::check_labels() const
 
 void StratifiedCrossValidationSplitting::build_subsets()
 {
-	check_labels();
-
-	/* ensure that subsets are empty and set flag to filled */
+	/* ensure that subsets are empty */
 	reset_subsets();
-	m_is_filled=true;
 
 	auto dense_labels = m_labels->as<DenseLabels>();
-	auto classes = dense_labels->get_labels().unique();
-
-	/* for every label, build set for indices */
-	std::vector<std::vector<index_t>> label_indices;
-	label_indices.resize(classes.size());
-
-	/* fill set with indices, for each label type ... */
-	for (auto i : range(classes.size()))
+	auto labels = dense_labels->get_labels();
+	auto classes = labels.unique();
+	index_t num_labels = labels.vlen;
+	index_t num_classes = classes.vlen;
+
+	/* stable counting sort of the indices by class, in blocks */
+	index_t num_blocks =
+		std::max(1, std::min(env()->get_num_threads(), num_labels));
+	auto block_begin = [&](index_t b) {
+		return (index_t)((int64_t)b * num_labels / num_blocks);
+	};
+
+	SGVector<index_t> label_class(num_labels);
+	std::vector<index_t> offsets(num_blocks * num_classes, 0);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t b = 0; b < num_blocks; ++b)
 	{
-		/* ... iterate over all labels and add indices with same label to set */
-		for (auto j : range(m_labels->get_num_labels()))
+		auto* counts = offsets.data() + b * num_classes;
+		for (auto i = block_begin(b); i < block_begin(b + 1); ++i)
 		{
-			if (dense_labels->get_label(j) == classes[i])
-			{
-				label_indices[i].push_back(j);
-
-			}
+			label_class[i] =
+				std::lower_bound(classes.begin(), classes.end(), labels[i]) -
+				classes.begin();
+			++counts[label_class[i]];
 		}
 	}
 
-	/* shuffle created label sets */
-	for (index_t i=0; i<label_indices.size(); ++i)
+	std::vector<index_t> class_begin(num_classes + 1, 0);
+	std::vector<index_t> labels_per_class(num_classes);
+	for (auto c : range(num_classes))
 	{
-		auto& current = label_indices[i];
-
-		// external random state important for threads
-		random::shuffle(current, m_prng);
+		auto offset = class_begin[c];
+		for (auto b : range(num_blocks))
+		{
+			auto count = offsets[b * num_classes + c];
+			offsets[b * num_classes + c] = offset;
+			offset += count;
+		}
+		class_begin[c + 1] = offset;
+		labels_per_class[c] = class_begin[c + 1] - class_begin[c];
+	}
 
+	check_labels(classes, labels_per_class);
 
+	SGVector<index_t> sorted(num_labels);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t b = 0; b < num_blocks; ++b)
+	{
+		auto* positions = offsets.data() + b * num_classes;
+		for (auto i = block_begin(b); i < block_begin(b + 1); ++i)
+			sorted[positions[label_class[i]]++] = i;
 	}
 
-	/* distribute labels to subsets for all label types */
-	index_t target_set=0;
-	for (auto i : range(classes.size()))
+	/* shuffle the indices of every class, in a fixed order for
+	 * reproducibility (external random state important for threads) */
+	for (auto c : range(num_classes))
 	{
-		/* current index set for current label */
-		auto& current = label_indices[i];
-
-		for (index_t j=0; j<current.size(); ++j)
-		{
-			auto& next = m_subset_indices[target_set++];
-			next.push_back(current[j]);
-			target_set%=m_subset_indices.size();
-
-		}
+		random::parallel_shuffle(
+			sorted.begin() + class_begin[c], sorted.begin() + class_begin[c + 1],
+			m_prng);
+	}
 
+	/* distribute the classes to the subsets in turn, i.e. subset i gets
+	 * positions i, i + num_subsets, ... of the sorted indices, and store
+	 * every subset as a consecutive range */
+	SGVector<index_t> indices(num_labels);
+	std::vector<std::pair<index_t, index_t>> ranges(m_num_subsets);
+	index_t begin = 0;
+	for (auto i : range(m_num_subsets))
+	{
+		index_t size =
+			num_labels / m_num_subsets + (i < num_labels % m_num_subsets);
+		ranges[i] = std::make_pair(begin, begin + size);
+		begin += size;
+	}
 
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < m_num_subsets; ++i)
+	{
+		for (auto j = ranges[i].first; j < ranges[i].second; ++j)
+			indices[j] = sorted[i + (j - ranges[i].first) * m_num_subsets];
 	}
 
 	/* finally shuffle to avoid that subsets with low indices have more
 	 * elements, which happens if the number of class labels is not equal to
 	 * the number of subsets (external random state important for threads) */
-	random::shuffle(m_subset_indices, m_prng);
+	random::shuffle(ranges, m_prng);
+	set_subsets(indices, ranges);
 }
@@ -12,6 +12,8 @@
 #include <shogun/evaluation/SplittingStrategy.h>
 #include <shogun/mathematics/RandomMixin.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -49,9 +51,14 @@ protected:
 	/* check for "stupid" combinations of label numbers and num_subsets.
 	 * if there are of a class less labels than num_subsets, the class will not
 	 * appear in every subset, leading to subsets of only one class in the
-	 * extreme case of a two class labeling. */
-
-	void check_labels() const;
+	 * extreme case of a two class labeling.
+	 *
+	 * @param classes sorted classes of the labels
+	 * @param labels_per_class number of labels of every class
+	 */
+	void check_labels(
+		const SGVector<float64_t>& classes,
+		const std::vector<index_t>& labels_per_class) const;
 };
 }
 
@@ -60,37 +60,31 @@ void TimeSeriesSplitting::init()
 void TimeSeriesSplitting::build_subsets()
 {
 	reset_subsets();
-	m_is_filled = true;
 
+	/* all subsets are windows up to the end of the same index range */
 	SGVector<index_t> indices(m_labels->get_num_labels());
 	indices.range_fill();
-	index_t num_subsets = m_subset_indices.size();
+	index_t num_subsets = m_num_subsets;
 	index_t split_index;
 
+	std::vector<std::pair<index_t, index_t>> ranges(num_subsets);
 	for (auto i = 0; i < num_subsets; ++i)
 	{
-		auto& current = m_subset_indices[i];
-
 		if (i == num_subsets - 1)
 			split_index = indices.vlen - m_min_subset_size;
 		else
 			split_index = (i + 1) * (indices.vlen / num_subsets);
 
-		/* filling current with indices on right end  */
-		for (auto k = split_index; k < indices.vlen; ++k)
-		{
-			current.push_back(indices.vector[k]);
-		}
-
-
+		ranges[i] = std::make_pair(split_index, indices.vlen);
 	}
 
-	random::shuffle(m_subset_indices, m_prng);
+	random::shuffle(ranges, m_prng);
+	set_subsets(indices, ranges);
 }
 
 void TimeSeriesSplitting::set_min_subset_size(index_t min_size)
 {
-	index_t num_subsets = m_subset_indices.size();
+	index_t num_subsets = m_num_subsets;
 	index_t num_labels = m_labels->get_num_labels();
 
 	/* min_size should be less than difference between number of labels
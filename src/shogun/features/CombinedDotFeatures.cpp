@@ -5,10 +5,14 @@
  *          Sergey Lisitsyn, Bjoern Esser
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/CombinedDotFeatures.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 
+#include <algorithm>
 #include <vector>
 
 using namespace shogun;
@@ -112,28 +116,118 @@ float64_t CombinedDotFeatures::dot(
 	return result;
 }
 
+namespace
+{
+	/** dot products of the vectors start to stop-1 when all subfeatures
+	 * are 64 bit dense features held in memory without subset or with a
+	 * range subset: the columns of the subfeature matrices form one
+	 * virtual, strided matrix of the concatenated vectors
+	 *
+	 * @return false if the subfeatures are not of that kind
+	 */
+	bool dense_dot_range_concatenated(
+		const std::vector<std::shared_ptr<DotFeatures>>& feats,
+		const std::vector<float64_t>& weights,
+		const std::vector<int32_t>& offsets, float64_t* output,
+		int32_t start, int32_t stop, const float64_t* alphas,
+		const float64_t* vec, float64_t b)
+	{
+		const index_t num_obj=feats.size();
+		std::vector<Eigen::Map<const Eigen::MatrixXd>> matrices;
+		std::vector<index_t> shifts(num_obj);
+		matrices.reserve(num_obj);
+		for (index_t f_idx=0; f_idx<num_obj; f_idx++)
+		{
+			const auto& f=feats[f_idx];
+			if (f->get_feature_class()!=C_DENSE ||
+				f->get_feature_type()!=F_DREAL || f->get_num_preprocessors())
+				return false;
+
+			auto subset_stack=f->get_subset_stack();
+			if (!subset_stack->is_contiguous())
+				return false;
+
+			int32_t num_feat, num_vec;
+			const float64_t* matrix=std::static_pointer_cast<DenseFeatures<float64_t>>(
+				f)->get_feature_matrix(num_feat, num_vec);
+			if (!matrix || num_feat!=offsets[f_idx+1]-offsets[f_idx])
+				return false;
+
+			matrices.emplace_back(matrix, num_feat, num_vec);
+			shifts[f_idx]=subset_stack->subset_idx_conversion(0);
+		}
+
+		const int32_t block_size=256;
+		const int32_t num_blocks=(stop-start+block_size-1)/block_size;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+		for (int32_t k=0; k<num_blocks; k++)
+		{
+			const int32_t begin=start+k*block_size;
+			const int32_t len=std::min(block_size, stop-begin);
+			Eigen::Map<Eigen::VectorXd> out(output+begin-start, len);
+			out.setZero();
+			for (index_t f_idx=0; f_idx<num_obj; f_idx++)
+			{
+				const auto& X=matrices[f_idx];
+				Eigen::Map<const Eigen::VectorXd> w(
+					vec+offsets[f_idx], X.rows());
+				out.noalias()+=weights[f_idx]*
+					(X.middleCols(shifts[f_idx]+begin, len).transpose()*w);
+			}
+
+			if (alphas)
+			{
+				out.array()*=Eigen::Map<const Eigen::ArrayXd>(
+					alphas+begin-start, len);
+			}
+			out.array()+=b;
+		}
+
+		return true;
+	}
+}
+
 void CombinedDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
 {
 	ASSERT(stop > start)
 	ASSERT(dim==num_dimensions)
 
-	uint32_t offs=0;
-	int32_t num=stop-start;
-	SGVector<float64_t> tmp(num);
-	std::fill(output, output + num, b);
+	const index_t num_obj=get_num_feature_obj();
+	std::vector<std::shared_ptr<DotFeatures>> feats(num_obj);
+	std::vector<float64_t> weights(num_obj);
+	std::vector<int32_t> offsets(num_obj+1, 0);
+	for (index_t f_idx=0; f_idx<num_obj; f_idx++)
+	{
+		feats[f_idx]=get_feature_obj(f_idx);
+		weights[f_idx]=get_subfeature_weight(f_idx);
+		offsets[f_idx+1]=offsets[f_idx]+feats[f_idx]->get_dim_feature_space();
+	}
 
-	for (index_t f_idx=0; f_idx<get_num_feature_obj(); f_idx++)
+	if (dense_dot_range_concatenated(
+			feats, weights, offsets, output, start, stop, alphas, vec, b))
+		return;
+
+	// with at least as many subfeatures as threads each thread computes
+	// the dot products of whole subfeatures, otherwise the subfeatures
+	// parallelize their own ranges
+	const int32_t num=stop-start;
+	const int32_t num_threads=env()->get_num_threads();
+	SGMatrix<float64_t> tmp(num, num_obj);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) \
+	if (num_obj>=num_threads)
+	for (index_t f_idx=0; f_idx<num_obj; f_idx++)
 	{
-		auto f = get_feature_obj(f_idx);
-		int32_t f_dim = f->get_dim_feature_space();
+		feats[f_idx]->dense_dot_range(
+			tmp.get_column_vector(f_idx), start, stop, alphas,
+			vec+offsets[f_idx], offsets[f_idx+1]-offsets[f_idx], 0);
+	}
 
-		f->dense_dot_range(
-		    tmp.vector, start, stop, alphas, vec + offs, f_dim, 0);
+	std::fill(output, output + num, b);
+	for (index_t f_idx=0; f_idx<num_obj; f_idx++)
+	{
+		const float64_t* column=tmp.get_column_vector(f_idx);
 		for (int32_t i=0; i<num; i++)
-			output[i] += get_subfeature_weight(f_idx) * tmp[i];
-
-		offs += f_dim;
-
+			output[i] += weights[f_idx] * column[i];
 	}
 }
 
@@ -91,6 +91,12 @@ class CombinedDotFeatures : public DotFeatures
 		/** Compute the dot product for a range of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
+		 * When all subfeatures are 64 bit dense features in memory without
+		 * preprocessors and with at most a range subset, blocks of vectors
+		 * are computed in parallel over all subfeatures at once. Otherwise
+		 * the subfeatures are computed in parallel if there are at least as
+		 * many as threads, else one after the other.
+		 *
 		 * @param output result for the given vector range
 		 * @param start start vector range from this idx
 		 * @param stop stop vector range at this idx
@@ -242,6 +242,24 @@ void CombinedFeatures::add_subset(SGVector<index_t> subset)
 	SG_TRACE("leaving {}::add_subset()", get_name());
 }
 
+void CombinedFeatures::add_subset_range(index_t start, index_t size)
+{
+	std::unordered_set<std::shared_ptr<Features>> processed;
+
+	for (index_t f_idx=0; f_idx<get_num_feature_obj(); f_idx++)
+	{
+		auto current=get_feature_obj(f_idx);
+		if (processed.find(current) == processed.end())
+		{
+			current->add_subset_range(start, size);
+			processed.insert(current);
+		}
+	}
+
+	m_subset_stack->add_subset_range(start, size);
+	subset_changed_post();
+}
+
 void CombinedFeatures::remove_subset()
 {
 	SG_TRACE("entering {}::remove_subset()", get_name());
@@ -148,6 +148,14 @@ class CombinedFeatures : public Features
 		 * */
 		void add_subset(SGVector<index_t> subset) override;
 
+		/** adds a range of indices on top of the current subsets of all
+		 * sub-features, see Features::add_subset_range()
+		 *
+		 * @param start first index of the range
+		 * @param size number of indices
+		 * */
+		void add_subset_range(index_t start, index_t size) override;
+
 		/** removes that last added subset from subset stack, if existing
 		 * Calls subset_changed_post() afterwards
 		 *
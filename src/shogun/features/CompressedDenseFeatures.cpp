@@ -0,0 +1,529 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/features/CompressedDenseFeatures.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+/** iterator over the features of a vector */
+struct compressed_feature_iterator
+{
+	/** index of the vector without subset */
+	int32_t real_num;
+	/** next feature */
+	int32_t feature;
+};
+
+/** vectors decoded at once by dense_dot_range() */
+constexpr int32_t decode_block_size=1024;
+
+/** @return bytes of the values of a feature, rounded to 8 bytes */
+int64_t encoded_size(ECompressedEncoding encoding, int32_t bits, int32_t num)
+{
+	int64_t bytes;
+	switch (encoding)
+	{
+	case CE_DICTIONARY:
+		bytes=(int64_t(num)*bits+7)/8;
+		break;
+	case CE_FLOAT16:
+	case CE_BFLOAT16:
+		bytes=int64_t(num)*sizeof(uint16_t);
+		break;
+	default:
+		bytes=int64_t(num)*sizeof(float64_t);
+	}
+
+	return (bytes+7)/8*8;
+}
+}
+
+CompressedDenseFeatures::CompressedDenseFeatures() : DotFeatures()
+{
+	init();
+}
+
+CompressedDenseFeatures::CompressedDenseFeatures(
+	const SGMatrix<float64_t>& matrix, ECompressedEncoding fallback,
+	int32_t max_dictionary_size)
+	: DotFeatures()
+{
+	init();
+
+	set_fallback_encoding(fallback);
+	set_max_dictionary_size(max_dictionary_size);
+	compress(matrix);
+}
+
+CompressedDenseFeatures::CompressedDenseFeatures(
+	const CompressedDenseFeatures& orig)
+	: DotFeatures(orig)
+{
+	init();
+
+	m_fallback_encoding=orig.m_fallback_encoding;
+	m_max_dictionary_size=orig.m_max_dictionary_size;
+	m_num_features=orig.m_num_features;
+	m_num_vectors=orig.m_num_vectors;
+	m_encoding=orig.m_encoding;
+	m_bits=orig.m_bits;
+	m_offset=orig.m_offset;
+	m_dictionary_offset=orig.m_dictionary_offset;
+	m_data=orig.m_data;
+	m_dictionary=orig.m_dictionary;
+}
+
+CompressedDenseFeatures::~CompressedDenseFeatures()
+{
+}
+
+void CompressedDenseFeatures::init()
+{
+	m_fallback_encoding=CE_RAW;
+	m_max_dictionary_size=256;
+	m_num_features=0;
+	m_num_vectors=0;
+
+	SG_ADD(&m_fallback_encoding, "fallback_encoding",
+		"Encoding of features with many distinct values.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_max_dictionary_size, "max_dictionary_size",
+		"Largest number of distinct values of dictionary encoded features.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_num_features, "num_features", "Number of features.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_num_vectors, "num_vectors", "Number of vectors.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_encoding, "encoding", "Encoding of every feature.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_bits, "bits", "Bits per dictionary index of every feature.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_offset, "offset", "Offset of the values of every feature.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_dictionary_offset, "dictionary_offset",
+		"Offset of the dictionary of every feature.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_data, "data", "Encoded values of all features.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_dictionary, "dictionary", "Distinct values of all features.",
+		ParameterProperties::READONLY);
+}
+
+void CompressedDenseFeatures::set_fallback_encoding(ECompressedEncoding fallback)
+{
+	require(fallback!=CE_DICTIONARY,
+		"Dictionary encoding cannot be the fallback encoding!");
+	m_fallback_encoding=fallback;
+}
+
+void CompressedDenseFeatures::set_max_dictionary_size(int32_t max_dictionary_size)
+{
+	require(max_dictionary_size>=0 && max_dictionary_size<=256,
+		"Maximum dictionary size ({}) must be in [0, 256]!",
+		max_dictionary_size);
+	m_max_dictionary_size=max_dictionary_size;
+}
+
+void CompressedDenseFeatures::compress(const SGMatrix<float64_t>& matrix)
+{
+	require(matrix.matrix, "No feature matrix provided!");
+
+	const int32_t num_features=matrix.num_rows;
+	const int32_t num_vectors=matrix.num_cols;
+	m_subset_stack->remove_all_subsets();
+	m_num_features=num_features;
+	m_num_vectors=num_vectors;
+	m_encoding=SGVector<int32_t>(num_features);
+	m_bits=SGVector<int32_t>(num_features);
+	m_offset=SGVector<int64_t>(num_features+1);
+	m_dictionary_offset=SGVector<int64_t>(num_features+1);
+
+	/* choose the encodings */
+	std::vector<std::vector<float64_t>> dictionaries(num_features);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t f=0; f<num_features; f++)
+	{
+		std::vector<float64_t> values(num_vectors);
+		bool has_nan=false;
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			values[i]=matrix(f, i);
+			has_nan|=std::isnan(values[i]);
+		}
+
+		m_encoding[f]=m_fallback_encoding;
+		m_bits[f]=0;
+		if (has_nan)
+			continue;
+
+		std::sort(values.begin(), values.end());
+		values.erase(std::unique(values.begin(), values.end()), values.end());
+		if (int32_t(values.size())>m_max_dictionary_size)
+			continue;
+
+		int32_t bits=1;
+		while ((1<<bits)<int32_t(values.size()))
+			bits*=2;
+		m_encoding[f]=CE_DICTIONARY;
+		m_bits[f]=bits;
+		dictionaries[f]=std::move(values);
+	}
+
+	m_offset[0]=0;
+	m_dictionary_offset[0]=0;
+	for (int32_t f=0; f<num_features; f++)
+	{
+		m_offset[f+1]=m_offset[f]+encoded_size(
+			(ECompressedEncoding) m_encoding[f], m_bits[f], num_vectors);
+		m_dictionary_offset[f+1]=m_dictionary_offset[f]+dictionaries[f].size();
+	}
+
+	m_data=SGVector<uint8_t>(m_offset[num_features]);
+	m_data.zero();
+	m_dictionary=SGVector<float64_t>(m_dictionary_offset[num_features]);
+
+	/* encode the values */
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t f=0; f<num_features; f++)
+	{
+		uint8_t* data=m_data.vector+m_offset[f];
+		switch (m_encoding[f])
+		{
+		case CE_DICTIONARY:
+		{
+			const auto& dictionary=dictionaries[f];
+			std::copy(dictionary.begin(), dictionary.end(),
+				m_dictionary.vector+m_dictionary_offset[f]);
+			const int32_t bits=m_bits[f];
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				const int32_t code=std::lower_bound(dictionary.begin(),
+					dictionary.end(), matrix(f, i))-dictionary.begin();
+				const int64_t bit=int64_t(i)*bits;
+				data[bit>>3]|=uint8_t(code<<(bit&7));
+			}
+			break;
+		}
+		case CE_FLOAT16:
+			for (int32_t i=0; i<num_vectors; i++)
+				((uint16_t*) data)[i]=float_to_half(matrix(f, i));
+			break;
+		case CE_BFLOAT16:
+			for (int32_t i=0; i<num_vectors; i++)
+				((uint16_t*) data)[i]=float_to_bfloat16(matrix(f, i));
+			break;
+		default:
+			for (int32_t i=0; i<num_vectors; i++)
+				((float64_t*) data)[i]=matrix(f, i);
+		}
+	}
+}
+
+int64_t CompressedDenseFeatures::get_memory_size() const
+{
+	return m_data.vlen+m_dictionary.vlen*int64_t(sizeof(float64_t));
+}
+
+void CompressedDenseFeatures::decode_feature(
+	int32_t feature, int32_t start, int32_t num, float64_t* output) const
+{
+	const uint8_t* data=m_data.vector+m_offset[feature];
+	switch (m_encoding[feature])
+	{
+	case CE_DICTIONARY:
+	{
+		const float64_t* dictionary=m_dictionary.vector+m_dictionary_offset[feature];
+		const int32_t bits=m_bits[feature];
+		if (bits==8)
+		{
+			for (int32_t i=0; i<num; i++)
+				output[i]=dictionary[data[start+i]];
+			break;
+		}
+
+		const int32_t mask=(1<<bits)-1;
+		for (int32_t i=0; i<num; i++)
+		{
+			const int64_t bit=int64_t(start+i)*bits;
+			output[i]=dictionary[(data[bit>>3]>>(bit&7)) & mask];
+		}
+		break;
+	}
+	case CE_FLOAT16:
+	{
+		const uint16_t* values=(const uint16_t*) data+start;
+		for (int32_t i=0; i<num; i++)
+			output[i]=half_to_float(values[i]);
+		break;
+	}
+	case CE_BFLOAT16:
+	{
+		const uint16_t* values=(const uint16_t*) data+start;
+		for (int32_t i=0; i<num; i++)
+			output[i]=bfloat16_to_float(values[i]);
+		break;
+	}
+	default:
+		std::copy_n((const float64_t*) data+start, num, output);
+	}
+}
+
+int32_t CompressedDenseFeatures::real_index(int32_t num) const
+{
+	require(num>=0 && num<get_num_vectors(),
+		"Index out of bounds (number of vectors {}, you requested {})",
+		get_num_vectors(), num);
+	return m_subset_stack->subset_idx_conversion(num);
+}
+
+SGVector<float64_t> CompressedDenseFeatures::get_feature_vector(int32_t num) const
+{
+	const int32_t real_num=real_index(num);
+	SGVector<float64_t> vec(m_num_features);
+	for (int32_t f=0; f<m_num_features; f++)
+		vec[f]=get_value(f, real_num);
+
+	return vec;
+}
+
+SGMatrix<float64_t> CompressedDenseFeatures::get_feature_matrix() const
+{
+	const int32_t num_vectors=get_num_vectors();
+	SGMatrix<float64_t> matrix(m_num_features, num_vectors);
+	if (!m_subset_stack->has_subsets())
+	{
+#pragma omp parallel num_threads(env()->get_num_threads())
+		{
+			std::vector<float64_t> buffer(decode_block_size);
+#pragma omp for
+			for (int32_t start=0; start<num_vectors; start+=decode_block_size)
+			{
+				const int32_t num=std::min(decode_block_size, num_vectors-start);
+				for (int32_t f=0; f<m_num_features; f++)
+				{
+					decode_feature(f, start, num, buffer.data());
+					for (int32_t i=0; i<num; i++)
+						matrix(f, start+i)=buffer[i];
+				}
+			}
+		}
+		return matrix;
+	}
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		const int32_t real_num=m_subset_stack->subset_idx_conversion(i);
+		for (int32_t f=0; f<m_num_features; f++)
+			matrix(f, i)=get_value(f, real_num);
+	}
+	return matrix;
+}
+
+float64_t CompressedDenseFeatures::dot(
+	int32_t vec_idx1, std::shared_ptr<DotFeatures> df, int32_t vec_idx2) const
+{
+	require(df, "No features provided!");
+	require(df->get_dim_feature_space()==m_num_features,
+		"Dimension of the features ({}) does not match ({})!",
+		df->get_dim_feature_space(), m_num_features);
+
+	return df->dot(vec_idx2, get_feature_vector(vec_idx1));
+}
+
+float64_t CompressedDenseFeatures::dot(
+	int32_t vec_idx1, const SGVector<float64_t>& vec2) const
+{
+	require(vec2.vlen==m_num_features,
+		"Dimension of the vector ({}) does not match the features ({})!",
+		vec2.vlen, m_num_features);
+
+	const int32_t real_num=real_index(vec_idx1);
+	float64_t result=0;
+	for (int32_t f=0; f<m_num_features; f++)
+		result+=vec2[f]*get_value(f, real_num);
+
+	return result;
+}
+
+void CompressedDenseFeatures::add_to_dense_vec(float64_t alpha,
+	int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val) const
+{
+	require(vec2_len==m_num_features,
+		"Dimension of the vector ({}) does not match the features ({})!",
+		vec2_len, m_num_features);
+
+	const int32_t real_num=real_index(vec_idx1);
+	for (int32_t f=0; f<m_num_features; f++)
+	{
+		const float64_t value=get_value(f, real_num);
+		vec2[f]+=alpha*(abs_val ? std::abs(value) : value);
+	}
+}
+
+void CompressedDenseFeatures::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b) const
+{
+	if (m_subset_stack->has_subsets())
+	{
+		DotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+		return;
+	}
+
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	require(dim==m_num_features,
+		"Dimension of the vector ({}) does not match the features ({})!",
+		dim, m_num_features);
+
+	const int32_t num_vectors=stop-start;
+#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<float64_t> values(decode_block_size);
+		std::vector<float64_t> sums(decode_block_size);
+#pragma omp for
+		for (int32_t block=0; block<num_vectors; block+=decode_block_size)
+		{
+			const int32_t num=std::min(decode_block_size, num_vectors-block);
+			std::fill_n(sums.begin(), num, 0.0);
+			for (int32_t f=0; f<m_num_features; f++)
+			{
+				const float64_t w=vec[f];
+				if (w==0)
+					continue;
+
+				decode_feature(f, start+block, num, values.data());
+				for (int32_t i=0; i<num; i++)
+					sums[i]+=w*values[i];
+			}
+
+			for (int32_t i=0; i<num; i++)
+			{
+				const int32_t j=block+i;
+				output[j]=(alphas ? alphas[j]*sums[i] : sums[i])+b;
+			}
+		}
+	}
+}
+
+void* CompressedDenseFeatures::get_feature_iterator(int32_t vector_index)
+{
+	auto* iterator=SG_MALLOC(compressed_feature_iterator, 1);
+	iterator->real_num=real_index(vector_index);
+	iterator->feature=0;
+	return iterator;
+}
+
+bool CompressedDenseFeatures::get_next_feature(
+	int32_t& index, float64_t& value, void* iterator)
+{
+	auto* it=(compressed_feature_iterator*) iterator;
+	if (!it || it->feature>=m_num_features)
+		return false;
+
+	index=it->feature++;
+	value=get_value(index, it->real_num);
+	return true;
+}
+
+void CompressedDenseFeatures::free_feature_iterator(void* iterator)
+{
+	SG_FREE(iterator);
+}
+
+std::shared_ptr<Features> CompressedDenseFeatures::duplicate() const
+{
+	return std::make_shared<CompressedDenseFeatures>(*this);
+}
+
+int32_t CompressedDenseFeatures::get_num_vectors() const
+{
+	return m_subset_stack->has_subsets() ? m_subset_stack->get_size()
+		: m_num_vectors;
+}
+
+uint16_t CompressedDenseFeatures::float_to_half(float32_t f)
+{
+	uint32_t x;
+	std::memcpy(&x, &f, sizeof(x));
+	const uint16_t sign=(x>>16) & 0x8000;
+	const uint32_t mantissa=x & 0x7fffff;
+	const int32_t exponent=int32_t((x>>23) & 0xff)-127+15;
+
+	/* infinity and NaN */
+	if (((x>>23) & 0xff)==0xff)
+		return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+	/* overflow */
+	if (exponent>=31)
+		return sign | 0x7c00;
+
+	/* subnormal or zero */
+	if (exponent<=0)
+	{
+		if (exponent<-10)
+			return sign;
+
+		const uint32_t m=mantissa | 0x800000;
+		const int32_t shift=14-exponent;
+		uint32_t h=m>>shift;
+		const uint32_t rest=m & ((1u<<shift)-1);
+		const uint32_t halfway=1u<<(shift-1);
+		if (rest>halfway || (rest==halfway && (h & 1)))
+			h++;
+		return sign | h;
+	}
+
+	/* a carry of the rounding goes into the exponent */
+	uint32_t h=(uint32_t(exponent)<<10) | (mantissa>>13);
+	const uint32_t rest=mantissa & 0x1fff;
+	if (rest>0x1000 || (rest==0x1000 && (h & 1)))
+		h++;
+	return sign | h;
+}
+
+float32_t CompressedDenseFeatures::half_to_float(uint16_t h)
+{
+	const uint32_t sign=uint32_t(h & 0x8000)<<16;
+	const uint32_t exponent=(h>>10) & 0x1f;
+	const uint32_t mantissa=h & 0x3ff;
+
+	uint32_t x;
+	if (exponent==0)
+	{
+		const float32_t value=std::ldexp(float32_t(mantissa), -24);
+		return sign ? -value : value;
+	}
+	else if (exponent==31)
+		x=sign | 0x7f800000 | (mantissa<<13);
+	else
+		x=sign | ((exponent+112)<<23) | (mantissa<<13);
+
+	float32_t f;
+	std::memcpy(&f, &x, sizeof(f));
+	return f;
+}
+
+uint16_t CompressedDenseFeatures::float_to_bfloat16(float32_t f)
+{
+	uint32_t x;
+	std::memcpy(&x, &f, sizeof(x));
+	if (std::isnan(f))
+		return (x>>16) | 0x40;
+
+	x+=0x7fff+((x>>16) & 1);
+	return x>>16;
+}
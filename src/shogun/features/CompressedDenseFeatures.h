@@ -0,0 +1,286 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _COMPRESSEDDENSEFEATURES__H__
+#define _COMPRESSEDDENSEFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DotFeatures.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+
+#include <cstring>
+
+namespace shogun
+{
+/** encoding of a feature of CompressedDenseFeatures */
+enum ECompressedEncoding
+{
+	/** 64 bit floats */
+	CE_RAW=0,
+	/** bit-packed indices into the sorted distinct values */
+	CE_DICTIONARY=1,
+	/** IEEE 754 half precision floats */
+	CE_FLOAT16=2,
+	/** bfloat16, the upper half of a single precision float */
+	CE_BFLOAT16=3
+};
+
+/** @brief Dense real features stored column by column in compressed form.
+ *
+ * Every feature is encoded on its own: features with at most
+ * get_max_dictionary_size() distinct values store the sorted distinct
+ * values once and an index of 1, 2, 4 or 8 bits per vector, all other
+ * features use the fallback encoding, 64 bit floats by default or, lossy,
+ * 16 bit floats. Features containing NaN always use the fallback.
+ *
+ * The values of a feature are contiguous, dense_dot_range() therefore
+ * decodes blocks of a feature at a time, one feature after the other, and
+ * skips the features with zero weight. dot() and add_to_dense_vec() decode
+ * the features of a single vector.
+ */
+class CompressedDenseFeatures : public DotFeatures
+{
+public:
+	/** default constructor */
+	CompressedDenseFeatures();
+
+	/** constructor
+	 *
+	 * @param matrix feature matrix, one vector per column
+	 * @param fallback encoding of the features with too many distinct values
+	 * @param max_dictionary_size largest number of distinct values of
+	 * dictionary encoded features, at most 256
+	 */
+	CompressedDenseFeatures(
+		const SGMatrix<float64_t>& matrix, ECompressedEncoding fallback=CE_RAW,
+		int32_t max_dictionary_size=256);
+
+	/** copy constructor */
+	CompressedDenseFeatures(const CompressedDenseFeatures& orig);
+
+	~CompressedDenseFeatures() override;
+
+	/** encode a feature matrix, replaces the stored vectors and removes
+	 * all subsets
+	 *
+	 * @param matrix feature matrix, one vector per column
+	 */
+	void compress(const SGMatrix<float64_t>& matrix);
+
+	/** @param fallback encoding of the features with too many distinct
+	 * values, used by the next compress() */
+	void set_fallback_encoding(ECompressedEncoding fallback);
+
+	/** @return encoding of the features with too many distinct values */
+	ECompressedEncoding get_fallback_encoding() const
+	{
+		return (ECompressedEncoding) m_fallback_encoding;
+	}
+
+	/** @param max_dictionary_size largest number of distinct values of
+	 * dictionary encoded features, used by the next compress() */
+	void set_max_dictionary_size(int32_t max_dictionary_size);
+
+	/** @return largest number of distinct values of dictionary encoded
+	 * features */
+	int32_t get_max_dictionary_size() const
+	{
+		return m_max_dictionary_size;
+	}
+
+	/** @return encoding of a feature */
+	ECompressedEncoding get_encoding(int32_t feature) const
+	{
+		return (ECompressedEncoding) m_encoding[feature];
+	}
+
+	/** @return number of features */
+	int32_t get_num_features() const
+	{
+		return m_num_features;
+	}
+
+	/** @return bytes of the encoded values and dictionaries */
+	int64_t get_memory_size() const;
+
+	/** value of a feature of a vector
+	 *
+	 * @param feature index of the feature
+	 * @param real_num index of the vector, subsets are ignored
+	 * @return decoded value
+	 */
+	float64_t get_value(int32_t feature, int32_t real_num) const
+	{
+		const uint8_t* data=m_data.vector+m_offset[feature];
+		switch (m_encoding[feature])
+		{
+		case CE_DICTIONARY:
+		{
+			const int32_t bits=m_bits[feature];
+			const int64_t bit=int64_t(real_num)*bits;
+			const int32_t code=(data[bit>>3]>>(bit&7)) & ((1<<bits)-1);
+			return m_dictionary[m_dictionary_offset[feature]+code];
+		}
+		case CE_FLOAT16:
+			return half_to_float(((const uint16_t*) data)[real_num]);
+		case CE_BFLOAT16:
+			return bfloat16_to_float(((const uint16_t*) data)[real_num]);
+		default:
+			return ((const float64_t*) data)[real_num];
+		}
+	}
+
+	/** decode the values of a feature of a range of vectors
+	 *
+	 * @param feature index of the feature
+	 * @param start first vector, subsets are ignored
+	 * @param num number of vectors
+	 * @param output decoded values
+	 */
+	void decode_feature(
+		int32_t feature, int32_t start, int32_t num, float64_t* output) const;
+
+	/** decoded feature vector
+	 *
+	 * possible with subset
+	 *
+	 * @param num index of the vector
+	 * @return feature vector
+	 */
+	SGVector<float64_t> get_feature_vector(int32_t num) const;
+
+	/** decoded feature matrix
+	 *
+	 * possible with subset
+	 *
+	 * @return feature matrix, one vector per column
+	 */
+	SGMatrix<float64_t> get_feature_matrix() const;
+
+	int32_t get_dim_feature_space() const override
+	{
+		return m_num_features;
+	}
+
+	float64_t dot(int32_t vec_idx1, std::shared_ptr<DotFeatures> df,
+		int32_t vec_idx2) const override;
+
+	float64_t
+	dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const override;
+
+	using DotFeatures::dot;
+
+	void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
+		float64_t* vec2, int32_t vec2_len, bool abs_val=false) const override;
+
+	/** Compute the dot products of a range of vectors feature by feature,
+	 * decoding blocks of the contiguous values of every feature
+	 *
+	 * @param output result for the given vector range
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	void dense_dot_range(float64_t* output, int32_t start, int32_t stop,
+		float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const override;
+
+	int32_t get_nnz_features_for_vector(int32_t num) const override
+	{
+		return m_num_features;
+	}
+
+	void* get_feature_iterator(int32_t vector_index) override;
+
+	bool get_next_feature(int32_t& index, float64_t& value,
+		void* iterator) override;
+
+	void free_feature_iterator(void* iterator) override;
+
+	std::shared_ptr<Features> duplicate() const override;
+
+	/** @return feature type DREAL */
+	EFeatureType get_feature_type() const override
+	{
+		return F_DREAL;
+	}
+
+	/** @return feature class COMPRESSED_DENSE */
+	EFeatureClass get_feature_class() const override
+	{
+		return C_COMPRESSED_DENSE;
+	}
+
+	int32_t get_num_vectors() const override;
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "CompressedDenseFeatures";
+	}
+
+	/** @return half precision float of f, rounded to nearest even */
+	static uint16_t float_to_half(float32_t f);
+
+	/** @return single precision float of a half precision float */
+	static float32_t half_to_float(uint16_t h);
+
+	/** @return bfloat16 of f, rounded to nearest even */
+	static uint16_t float_to_bfloat16(float32_t f);
+
+	/** @return single precision float of a bfloat16 */
+	static float32_t bfloat16_to_float(uint16_t h)
+	{
+		const uint32_t bits=uint32_t(h)<<16;
+		float32_t f;
+		std::memcpy(&f, &bits, sizeof(f));
+		return f;
+	}
+
+private:
+	void init();
+
+	/** @return vector index without subset, checks bounds */
+	int32_t real_index(int32_t num) const;
+
+protected:
+	/** encoding of the features with too many distinct values */
+	int32_t m_fallback_encoding;
+
+	/** largest number of distinct values of dictionary encoded features */
+	int32_t m_max_dictionary_size;
+
+	/** number of features */
+	int32_t m_num_features;
+
+	/** number of vectors without subset */
+	int32_t m_num_vectors;
+
+	/** encoding of every feature */
+	SGVector<int32_t> m_encoding;
+
+	/** bits per index of dictionary encoded features */
+	SGVector<int32_t> m_bits;
+
+	/** byte offset of the values of every feature in m_data */
+	SGVector<int64_t> m_offset;
+
+	/** first distinct value of every feature in m_dictionary */
+	SGVector<int64_t> m_dictionary_offset;
+
+	/** encoded values of all features */
+	SGVector<uint8_t> m_data;
+
+	/** sorted distinct values of all dictionary encoded features */
+	SGVector<float64_t> m_dictionary;
+};
+}
+#endif /* _COMPRESSEDDENSEFEATURES__H__ */
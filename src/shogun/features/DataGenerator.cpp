@@ -11,6 +11,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/distributions/Gaussian.h>
 #include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/Philox.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
@@ -88,6 +89,8 @@ SGMatrix<float64_t> DataGenerator::generate_checkboard_data(int32_t num_classes,
 
 template SGMatrix<float64_t> DataGenerator::generate_checkboard_data<std::mt19937_64>(int32_t num_classes,
 		int32_t dim, int32_t num_points, float64_t overlap, std::mt19937_64& prng);
+template SGMatrix<float64_t> DataGenerator::generate_checkboard_data<Philox4x32>(int32_t num_classes,
+		int32_t dim, int32_t num_points, float64_t overlap, Philox4x32& prng);
 
 
 template <typename PRNG>
@@ -113,6 +116,9 @@ SGMatrix<float64_t> DataGenerator::generate_mean_data(index_t m,
 template SGMatrix<float64_t> DataGenerator::generate_mean_data<std::mt19937_64>(index_t m,
 		index_t dim, float64_t mean_shift, std::mt19937_64& prng,
 		const SGMatrix<float64_t>& target);
+template SGMatrix<float64_t> DataGenerator::generate_mean_data<Philox4x32>(index_t m,
+		index_t dim, float64_t mean_shift, Philox4x32& prng,
+		const SGMatrix<float64_t>& target);
 
 
 template <typename PRNG>
@@ -149,6 +155,8 @@ SGMatrix<float64_t> DataGenerator::generate_sym_mix_gauss(index_t m,
 
 template SGMatrix<float64_t> DataGenerator::generate_sym_mix_gauss<std::mt19937_64>(index_t m,
 		float64_t d, float64_t angle, std::mt19937_64& prng, const SGMatrix<float64_t>& target);
+template SGMatrix<float64_t> DataGenerator::generate_sym_mix_gauss<Philox4x32>(index_t m,
+		float64_t d, float64_t angle, Philox4x32& prng, const SGMatrix<float64_t>& target);
 
 
 template <typename PRNG>
@@ -187,4 +195,6 @@ SGMatrix<float64_t> DataGenerator::generate_gaussians(index_t m, index_t n, inde
 
 template SGMatrix<float64_t> DataGenerator::generate_gaussians<std::mt19937_64>(
 	index_t m, index_t n, index_t dim, std::mt19937_64& prng);
+template SGMatrix<float64_t> DataGenerator::generate_gaussians<Philox4x32>(
+	index_t m, index_t n, index_t dim, Philox4x32& prng);
 
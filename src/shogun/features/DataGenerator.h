@@ -20,6 +20,10 @@ namespace shogun
 
 /** @brief Class that is able to generate various data samples, which may be
  * used for examples in SHOGUN.
+ *
+ * The generators are instantiated for std::mt19937_64 and Philox4x32. The
+ * streams of random::RandomStreams generate independent blocks of samples
+ * in parallel, reproducibly for any number of threads.
  */
 class DataGenerator: public SGObject
 {
@@ -11,10 +11,12 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <algorithm>
+#include <atomic>
 #include <string.h>
 
 #define ASSERT_FLOATING_POINT                                                  \
@@ -139,7 +141,14 @@ template<class ST> ST* DenseFeatures<ST>::get_feature_vector(int32_t num, int32_
 			feat = feature_cache->lock_entry(real_num);
 
 			if (!feat)
+			{
 				feat = feature_cache->set_entry(real_num);
+				if (feat)
+				{
+					compute_feature_vector(num, len, feat);
+					feature_cache->commit_entry(real_num);
+				}
+			}
 		}
 
 		if (!feat)
@@ -149,7 +158,19 @@ template<class ST> ST* DenseFeatures<ST>::get_feature_vector(int32_t num, int32_
 		}
 	}
 
-	if (get_num_preprocessors())
+	if (get_num_preprocessors() && preprocessors_in_place())
+	{
+		if (!dofree)
+		{
+			ST* buffer=SG_MALLOC(ST, len);
+			sg_memcpy(buffer, feat, len*sizeof(ST));
+			free_feature_vector(feat, num, dofree);
+			feat=buffer;
+			dofree=true;
+		}
+		len=apply_preprocessors_in_place(feat, len);
+	}
+	else if (get_num_preprocessors())
 	{
 		SGVector<ST> feat_vec(feat, len, false);
 
@@ -174,6 +195,92 @@ template<class ST> ST* DenseFeatures<ST>::get_feature_vector(int32_t num, int32_
 	return feat;
 }
 
+template <class ST>
+bool DenseFeatures<ST>::preprocessors_in_place() const
+{
+	for (auto i = 0; i < get_num_preprocessors(); i++)
+	{
+		auto preprocessor =
+			get_preprocessor(i)->template as<DensePreprocessor<ST>>();
+		if (!preprocessor->supports_in_place())
+			return false;
+	}
+	return true;
+}
+
+template <class ST>
+int32_t DenseFeatures<ST>::apply_preprocessors_in_place(ST* vector, int32_t len) const
+{
+	for (auto i = 0; i < get_num_preprocessors(); i++)
+	{
+		auto preprocessor =
+			get_preprocessor(i)->template as<DensePreprocessor<ST>>();
+		len = preprocessor->apply_in_place(vector, len);
+	}
+	return len;
+}
+
+template <class ST>
+void DenseFeatures<ST>::apply_preprocessors()
+{
+	require(!m_subset_stack->has_subsets(), "Not allowed with subset");
+	if (!get_num_preprocessors())
+		return;
+
+	const int32_t num_vecs=get_num_vectors();
+	if (!num_vecs)
+	{
+		clean_preprocessors();
+		return;
+	}
+
+	// the first vector gives the dimension of the result
+	int32_t len;
+	bool dofree;
+	ST* first=get_feature_vector(0, len, dofree);
+	SGMatrix<ST> result(len, num_vecs);
+	sg_memcpy(result.matrix, first, len*sizeof(ST));
+	free_feature_vector(first, 0, dofree);
+
+	if (feature_matrix.matrix && preprocessors_in_place())
+	{
+		std::atomic<int32_t> mismatch{-1};
+#pragma omp parallel num_threads(env()->get_num_threads())
+		{
+			SGVector<ST> buffer(num_features);
+#pragma omp for
+			for (int32_t i=1; i<num_vecs; i++)
+			{
+				sg_memcpy(buffer.vector, feature_matrix.get_column_vector(i),
+					num_features*sizeof(ST));
+				if (apply_preprocessors_in_place(buffer.vector, num_features)==len)
+					sg_memcpy(result.get_column_vector(i), buffer.vector, len*sizeof(ST));
+				else
+					mismatch=i;
+			}
+		}
+		require(mismatch<0,
+			"Preprocessed feature vector {} does not have length {}!",
+			mismatch.load(), len);
+	}
+	else
+	{
+		for (int32_t i=1; i<num_vecs; i++)
+		{
+			int32_t vlen;
+			ST* vec=get_feature_vector(i, vlen, dofree);
+			require(vlen==len,
+				"Preprocessed feature vector {} has length {} instead of {}!",
+				i, vlen, len);
+			sg_memcpy(result.get_column_vector(i), vec, len*sizeof(ST));
+			free_feature_vector(vec, i, dofree);
+		}
+	}
+
+	clean_preprocessors();
+	set_feature_matrix(result);
+}
+
 template<class ST> SGVector<ST> DenseFeatures<ST>::get_feature_vector(int32_t num) const
 {
 	/* index conversion for subset, only for array access */
@@ -191,10 +298,24 @@ template<class ST> SGVector<ST> DenseFeatures<ST>::get_feature_vector(int32_t nu
 	return SGVector<ST>(vector, vlen, do_free);
 }
 
+template <class ST>
+SGVectorView<const ST> DenseFeatures<ST>::get_feature_vector_view(int32_t num) const
+{
+	require(feature_matrix.matrix, "Feature matrix is not set!");
+	require(num>=0 && num<get_num_vectors(),
+		"Index out of bounds (number of vectors {}, you requested {})",
+		get_num_vectors(), num);
+
+	const int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	return SGVectorView<const ST>(
+		&feature_matrix.matrix[real_num * int64_t(num_features)], num_features);
+}
+
 template<class ST> void DenseFeatures<ST>::free_feature_vector(ST* feat_vec, int32_t num, bool dofree) const
 {
 	if (feature_cache)
-		feature_cache->unlock_entry(m_subset_stack->subset_idx_conversion(num));
+		feature_cache->unlock_entry(
+			m_subset_stack->subset_idx_conversion(num), feat_vec);
 
 	if (dofree)
 		SG_FREE(feat_vec);
@@ -277,6 +398,47 @@ SGMatrix<ST> DenseFeatures<ST>::get_feature_matrix() const
 	return target;
 }
 
+template <class ST>
+SGMatrix<ST> DenseFeatures<ST>::get_feature_matrix_block(const SGVector<index_t>& indices) const
+{
+	const index_t num_vecs=indices.vlen;
+	bool contiguous=true;
+	for (index_t i=0; i<num_vecs; ++i)
+	{
+		require(indices[i]>=0 && indices[i]<get_num_vectors(),
+				"Index {} out of range (number of vectors {})!",
+				indices[i], get_num_vectors());
+		contiguous&=(indices[i]==indices[0]+i);
+	}
+
+	if (num_vecs && contiguous && feature_matrix.matrix &&
+		m_subset_stack->is_contiguous() && !get_num_preprocessors())
+	{
+		const index_t first=m_subset_stack->subset_idx_conversion(indices[0]);
+		return SGMatrix<ST>(
+			feature_matrix.matrix+first*int64_t(num_features),
+			num_features, num_vecs, false);
+	}
+
+	SGMatrix<ST> block;
+	for (index_t i=0; i<num_vecs; ++i)
+	{
+		int32_t len;
+		bool dofree;
+		ST* vec=get_feature_vector(indices[i], len, dofree);
+		if (!block.matrix)
+			block=SGMatrix<ST>(len, num_vecs);
+
+		require(len==block.num_rows,
+				"Feature vector {} has length {} but {} was expected!",
+				indices[i], len, block.num_rows);
+		sg_memcpy(block.get_column_vector(i), vec, len*sizeof(ST));
+		free_feature_vector(vec, indices[i], dofree);
+	}
+
+	return block;
+}
+
 template <class ST>
 void DenseFeatures<ST>::copy_feature_matrix(SGMatrix<ST>& target, index_t column_offset) const
 {
@@ -300,6 +462,14 @@ void DenseFeatures<ST>::copy_feature_matrix(SGMatrix<ST>& target, index_t column
 		auto dest=target.matrix+int64_t(num_features)*column_offset;
 		sg_memcpy(dest, src, feature_matrix.size()*sizeof(ST));
 	}
+	else if (m_subset_stack->is_contiguous())
+	{
+		/* a range of columns is one block */
+		auto src=feature_matrix.matrix+
+			m_subset_stack->subset_idx_conversion(0)*int64_t(num_features);
+		auto dest=target.matrix+int64_t(num_features)*column_offset;
+		sg_memcpy(dest, src, int64_t(num_features)*num_vecs*sizeof(ST));
+	}
 	else
 	{
 		for (int32_t i=0; i<num_vecs; ++i)
@@ -330,6 +500,14 @@ ST* DenseFeatures<ST>::get_feature_matrix(
 	return feature_matrix.matrix;
 }
 
+template <class ST>
+SGMatrixView<const ST> DenseFeatures<ST>::get_feature_matrix_view() const
+{
+	require(feature_matrix.matrix, "Feature matrix is not set!");
+	return SGMatrixView<const ST>(
+		feature_matrix.matrix, num_features, num_vectors, num_features);
+}
+
 template<class ST> std::shared_ptr<DenseFeatures<ST>> DenseFeatures<ST>::get_transposed()
 {
 	int32_t num_feat;
@@ -391,8 +569,8 @@ template<class ST> void DenseFeatures<ST>::initialize_cache()
 	if (num_features && num_vectors)
 	{
 
-		feature_cache = std::make_shared<Cache<ST>>(get_cache_size(), num_features,
-				num_vectors);
+		feature_cache = std::make_shared<ConcurrentCache<ST>>(
+			get_cache_size(), num_features, num_vectors, 0, get_name());
 
 	}
 }
@@ -425,40 +603,49 @@ template<class ST> float64_t DenseFeatures<ST>::dot(int32_t vec_idx1, std::share
 	return result;
 }
 
-template<class ST> void DenseFeatures<ST>::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
-		float64_t* vec2, int32_t vec2_len, bool abs_val) const
+template <class ST>
+void DenseFeatures<ST>::dot_block(
+	const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+	const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const
 {
-	ASSERT(vec2_len == num_features)
-
-	int32_t vlen;
-	bool vfree;
-	ST* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
-
-	ASSERT(vlen == num_features)
-
-	if (abs_val)
-	{
-		for (int32_t i = 0; i < num_features; i++)
-			vec2[i] += alpha * Math::abs(vec1[i]);
-	}
-	else
+	auto sf = std::dynamic_pointer_cast<DenseFeatures<ST>>(df);
+	if constexpr (
+		std::is_same<ST, float64_t>::value || std::is_same<ST, float32_t>::value)
 	{
-		for (int32_t i = 0; i < num_features; i++)
-			vec2[i] += alpha * vec1[i];
+		if (sf)
+		{
+			require(
+				result.num_rows == vec_idx1.vlen &&
+					result.num_cols == vec_idx2.vlen,
+				"Result matrix ({}x{}) does not match the block size ({}x{})!",
+				result.num_rows, result.num_cols, vec_idx1.vlen,
+				vec_idx2.vlen);
+
+			auto block1 = get_feature_matrix_block(vec_idx1);
+			auto block2 = sf->get_feature_matrix_block(vec_idx2);
+			if constexpr (std::is_same<ST, float64_t>::value)
+				linalg::matrix_prod(block1, block2, result, true, false);
+			else
+			{
+				auto dots = linalg::matrix_prod(block1, block2, true, false);
+				for (index_t i = 0; i < dots.size(); ++i)
+					result[i] = dots[i];
+			}
+			return;
+		}
 	}
 
-	free_feature_vector(vec1, vec_idx1, vfree);
+	DotFeatures::dot_block(vec_idx1, df, vec_idx2, result);
 }
 
-template<>
-void DenseFeatures<float64_t>::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
+template<class ST> void DenseFeatures<ST>::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 		float64_t* vec2, int32_t vec2_len, bool abs_val) const
 {
 	ASSERT(vec2_len == num_features)
 
 	int32_t vlen;
 	bool vfree;
-	float64_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+	ST* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
 
 	ASSERT(vlen == num_features)
 
@@ -468,9 +655,7 @@ void DenseFeatures<float64_t>::add_to_dense_vec(float64_t alpha, int32_t vec_idx
 			vec2[i] += alpha * Math::abs(vec1[i]);
 	}
 	else
-	{
-		SGVector<float64_t>::vec1_plus_scalar_times_vec2(vec2, alpha, vec1, num_features);
-	}
+		simd::axpy(alpha, vec1, vec2, num_features);
 
 	free_feature_vector(vec1, vec_idx1, vfree);
 }
@@ -627,11 +812,111 @@ float64_t
 DenseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 {
 	SGVector<ST> vec1 = get_feature_vector(vec_idx1);
-	float64_t result = linalg::dot(vec2, vec1, linalg::allow_cast{});
+	require(vec1.vlen == vec2.vlen,
+		"Length of the feature vector ({}) does not match the dense vector ({})!",
+		vec1.vlen, vec2.vlen);
+	float64_t result;
+	if constexpr (std::is_same<ST, floatmax_t>::value)
+		result = linalg::dot(vec2, vec1, linalg::allow_cast{});
+	else
+		result = simd::dot(vec1.vector, vec2.vector, vec1.vlen);
 	free_feature_vector(vec1, vec_idx1);
 	return result;
 }
 
+template <typename ST>
+void DenseFeatures<ST>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	if constexpr (
+		std::is_same<ST, float64_t>::value || std::is_same<ST, float32_t>::value)
+	{
+		if (feature_matrix.matrix)
+		{
+			ASSERT(output)
+			ASSERT(start>=0 && start<stop && stop<=get_num_vectors())
+			require(dim==num_features,
+				"Dimension of the vector ({}) does not match the features ({})!",
+				dim, num_features);
+
+			typedef Eigen::Matrix<ST, Eigen::Dynamic, Eigen::Dynamic> MatrixXt;
+			Eigen::Map<const MatrixXt> X(
+				feature_matrix.matrix, num_features, feature_matrix.num_cols);
+			Eigen::Map<const Eigen::VectorXd> w(vec, dim);
+
+			// a range subset only shifts the columns
+			const bool contiguous=m_subset_stack->is_contiguous();
+			const int32_t shift=
+				contiguous ? m_subset_stack->subset_idx_conversion(0) : 0;
+
+			// one matrix-vector product per block of columns
+			const int32_t block_size=256;
+			const int32_t num_blocks=(stop-start+block_size-1)/block_size;
+#pragma omp parallel for
+			for (int32_t k=0; k<num_blocks; k++)
+			{
+				const int32_t begin=start+k*block_size;
+				const int32_t len=std::min(block_size, stop-begin);
+				Eigen::Map<Eigen::VectorXd> out(output+begin-start, len);
+				if (contiguous)
+				{
+					if constexpr (std::is_same<ST, float64_t>::value)
+						out.noalias()=X.middleCols(shift+begin, len).transpose()*w;
+					else
+					{
+						out.noalias()=X.middleCols(shift+begin, len).transpose()
+							.template cast<float64_t>()*w;
+					}
+				}
+				else
+				{
+					MatrixXt block(num_features, len);
+					for (int32_t i=0; i<len; i++)
+						block.col(i)=X.col(m_subset_stack->subset_idx_conversion(begin+i));
+
+					if constexpr (std::is_same<ST, float64_t>::value)
+						out.noalias()=block.transpose()*w;
+					else
+						out.noalias()=block.transpose().template cast<float64_t>()*w;
+				}
+
+				if (alphas)
+				{
+					out.array()*=Eigen::Map<const Eigen::ArrayXd>(
+						alphas+begin-start, len);
+				}
+				out.array()+=b;
+			}
+			return;
+		}
+	}
+
+	DotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+}
+
+template <typename ST>
+SGMatrix<float64_t> DenseFeatures<ST>::get_dense_block(int32_t start, int32_t num) const
+{
+	require(start>=0 && num>=0 && start+num<=get_num_vectors(),
+		"Block of {} vectors from {} exceeds the {} vectors!",
+		num, start, get_num_vectors());
+
+	SGVector<index_t> indices(num);
+	indices.range_fill(start);
+	auto block=get_feature_matrix_block(indices);
+	if constexpr (std::is_same<ST, float64_t>::value)
+		return block;
+	else
+	{
+		SGMatrix<float64_t> result(block.num_rows, block.num_cols);
+		std::copy(
+			block.matrix, block.matrix+int64_t(block.num_rows)*block.num_cols,
+			result.matrix);
+		return result;
+	}
+}
+
 template<class ST> bool DenseFeatures<ST>::is_equal(std::shared_ptr<DenseFeatures> rhs)
 {
 	if ( num_features != rhs->num_features || num_vectors != rhs->num_vectors )
@@ -14,7 +14,7 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/File.h>
-#include <shogun/lib/Cache.h>
+#include <shogun/lib/ConcurrentCache.h>
 #include <shogun/lib/DataType.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/common.h>
@@ -118,6 +118,11 @@ public:
 	 * initialized, else return preprocessed compute_feature_vector (not
 	 * implemented)
 	 *
+	 * Attached preprocessors are applied on access. If all of them
+	 * support DensePreprocessor::apply_in_place(), the chain is fused: the
+	 * vector is copied once into a buffer that every preprocessor
+	 * transforms in place, no intermediate vectors are allocated.
+	 *
 	 * @param num index of feature vector
 	 * @param len length is returned by reference
 	 * @param dofree whether returned vector must be freed by
@@ -135,6 +140,17 @@ public:
 	 */
 	SGVector<ST> get_feature_vector(int32_t num) const;
 
+	/** view of feature vector num in the feature matrix, without
+	 * reference counting
+	 *
+	 * possible with subset, requires the feature matrix to be set, the
+	 * view is valid as long as the matrix
+	 *
+	 * @param num index of vector
+	 * @return view of the feature vector
+	 */
+	SGVectorView<const ST> get_feature_vector_view(int32_t num) const;
+
 	/** free feature vector
 	 *
 	 * possible with subset
@@ -193,6 +209,29 @@ public:
 	 */
 	SGMatrix<ST> get_feature_matrix() const;
 
+	/** Getter for a block of feature vectors, stored column-wise
+	 *
+	 * in-place for a contiguous range of indices without preprocessors and
+	 * without subset or with a range subset, see
+	 * SubsetStack::add_subset_range(), a copy otherwise
+	 *
+	 * @param indices indices of the vectors in the block
+	 * @return matrix with the requested feature vectors as columns
+	 */
+	SGMatrix<ST> get_feature_matrix_block(const SGVector<index_t>& indices) const;
+
+	/** apply the attached preprocessors to all vectors in a single pass,
+	 * replace the feature matrix by the result and remove the
+	 * preprocessors
+	 *
+	 * not possible with subset
+	 *
+	 * If all preprocessors support DensePreprocessor::apply_in_place(),
+	 * the vectors are processed in parallel. No matrix is allocated
+	 * besides the result.
+	 */
+	void apply_preprocessors();
+
 	/** get the pointer to the feature matrix
 	 * num_feat,num_vectors are returned by reference
 	 *
@@ -204,6 +243,14 @@ public:
 	 */
 	ST* get_feature_matrix(int32_t& num_feat, int32_t& num_vec) const;
 
+	/** view of the feature matrix without reference counting
+	 *
+	 * subset is ignored, requires the feature matrix to be set
+	 *
+	 * @return view of the feature matrix
+	 */
+	SGMatrixView<const ST> get_feature_matrix_view() const;
+
 	/** get a transposed copy of the features
 	 *
 	 * possible with subset
@@ -290,6 +337,26 @@ public:
 	float64_t dot(int32_t vec_idx1, std::shared_ptr<DotFeatures> df,
 			int32_t vec_idx2) const override;
 
+	using DotFeatures::dot;
+
+	/** compute dot products between two blocks of vectors
+	 *
+	 * possible with subset
+	 *
+	 * For floating point features this is a single matrix-matrix product
+	 * of the two blocks of feature vectors.
+	 *
+	 * @param vec_idx1 indices of the vectors of this object
+	 * @param df DotFeatures (of same kind) to compute dot products with
+	 * @param vec_idx2 indices of the vectors of df
+	 * @param result preallocated matrix of size
+	 * vec_idx1.vlen x vec_idx2.vlen
+	 */
+	void dot_block(
+		const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+		const SGVector<index_t>& vec_idx2,
+		SGMatrix<float64_t>& result) const override;
+
 	/** Computes the sum of all feature vectors
 	 * @return Sum of all feature vectors
 	 */
@@ -347,6 +414,39 @@ public:
 	float64_t
 	dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const override;
 
+	/** compute the dot products of a range of vectors with a dense vector
+	 *
+	 * possible with subset
+	 *
+	 * For floating point features held in memory this is a blocked,
+	 * parallel matrix-vector product on the feature matrix, under a subset
+	 * that is not a range the vectors of each block are gathered first.
+	 *
+	 * @param output result for the given vector range
+	 * @param start first index of vector range
+	 * @param stop last vector range index (excluded)
+	 * @param alphas scalars to multiply the dot products with, may be NULL
+	 * @param vec dense vector
+	 * @param dim length of the dense vector
+	 * @param b bias added to the results
+	 */
+	void dense_dot_range(
+		float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+		float64_t* vec, int32_t dim, float64_t b) const override;
+
+	/** get the vectors start, ..., start+num-1 as dense matrix
+	 *
+	 * possible with subset
+	 *
+	 * in-place for 64 bit float features as in get_feature_matrix_block(),
+	 * a converted copy otherwise
+	 *
+	 * @param start first vector of the block
+	 * @param num number of vectors in the block
+	 * @return matrix with the vectors as columns
+	 */
+	SGMatrix<float64_t> get_dense_block(int32_t start, int32_t num) const override;
+
 	/** add vector 1 multiplied with alpha to dense vector2
 	 *
 	 * possible with subset
@@ -533,6 +633,18 @@ protected:
 private:
 	void init();
 
+	/** @return whether all preprocessors support
+	 * DensePreprocessor::apply_in_place() */
+	bool preprocessors_in_place() const;
+
+	/** apply all preprocessors in place
+	 *
+	 * @param vector feature vector, overwritten by the result
+	 * @param len length of vector
+	 * @return length of the result
+	 */
+	int32_t apply_preprocessors_in_place(ST* vector, int32_t len) const;
+
 protected:
 	/*
 	 * Helper method which copies the working feature matrix into the pre-allocated
@@ -555,8 +667,9 @@ protected:
 	 * */
 	SGMatrix<ST> feature_matrix;
 
-	/** feature cache */
-	std::shared_ptr<Cache<ST>> feature_cache;
+	/** cache of the computed feature vectors, safe to use from parallel
+	 * loops, see ConcurrentCache */
+	std::shared_ptr<ConcurrentCache<ST>> feature_cache;
 };
 }
 #endif // _DENSEFEATURES__H__
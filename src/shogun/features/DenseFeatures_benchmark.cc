@@ -0,0 +1,56 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/features/DenseFeatures.h"
+#include "shogun/features/DotFeatures_benchmark.h"
+#include <random>
+
+namespace shogun
+{
+
+template <class ST>
+class DenseFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		std::mt19937_64 prng(17);
+		std::uniform_int_distribution<int32_t> uniform_int_dist(0, 100);
+
+		index_t num_dim = st.range(0);
+		index_t num_vecs = 10000;
+		SGMatrix<ST> mat(num_dim, num_vecs);
+		for (index_t i=0; i<num_dim*num_vecs; i++)
+			mat.matrix[i] = uniform_int_dist(prng);
+
+		f = std::make_shared<DenseFeatures<ST>>(mat);
+		w = SGVector<float64_t>(num_dim);
+		w.range_fill(17.0);
+	}
+
+	void TearDown(const ::benchmark::State&) { f.reset(); }
+
+	std::shared_ptr<DenseFeatures<ST>> f;
+	SGVector<float64_t> w;
+};
+
+class DenseFloat64Fixture : public DenseFixture<float64_t> {};
+class DenseFloat32Fixture : public DenseFixture<float32_t> {};
+class DenseUint8Fixture : public DenseFixture<uint8_t> {};
+
+#define ADD_DENSE_ARGS(WHAT)	\
+	WHAT->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond);
+
+ADD_DENSE_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(DenseFloat64Fixture, DenseFeatures_Float64_DenseDot))
+ADD_DENSE_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(DenseFloat64Fixture, DenseFeatures_Float64_AddDense))
+ADD_DENSE_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(DenseFloat32Fixture, DenseFeatures_Float32_DenseDot))
+ADD_DENSE_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(DenseFloat32Fixture, DenseFeatures_Float32_AddDense))
+ADD_DENSE_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(DenseUint8Fixture, DenseFeatures_Uint8_DenseDot))
+ADD_DENSE_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(DenseUint8Fixture, DenseFeatures_Uint8_AddDense))
+
+}
@@ -44,6 +44,34 @@ DotFeatures::DotFeatures(std::shared_ptr<File> loader)
 	init();
 }
 
+float64_t DotFeatures::dot(
+	int32_t vec_idx1, const SGVectorView<const float64_t>& vec2) const
+{
+	if (!vec2.is_contiguous())
+		return dot(vec_idx1, vec2.clone());
+
+	/* non-owning vector, no reference count */
+	SGVector<float64_t> dense(
+		const_cast<float64_t*>(vec2.data()), vec2.size(), false);
+	return dot(vec_idx1, dense);
+}
+
+void DotFeatures::dot_block(
+	const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+	const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const
+{
+	require(df, "Features to compute dot products with are not set!");
+	require(result.num_rows==vec_idx1.vlen && result.num_cols==vec_idx2.vlen,
+		"Result matrix ({}x{}) does not match the block size ({}x{})!",
+		result.num_rows, result.num_cols, vec_idx1.vlen, vec_idx2.vlen);
+
+	for (index_t j=0; j<vec_idx2.vlen; ++j)
+	{
+		for (index_t i=0; i<vec_idx1.vlen; ++i)
+			result(i, j)=dot(vec_idx1[i], df, vec_idx2[j]);
+	}
+}
+
 void DotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
 {
 	ASSERT(output)
@@ -96,6 +124,21 @@ void DotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop
 	pb.complete();
 }
 
+void DotFeatures::add_to_dense_vec_range(
+		const float64_t* alphas, int32_t start, int32_t stop, float64_t* vec,
+		int32_t dim, bool abs_val) const
+{
+	ASSERT(alphas)
+	ASSERT(start>=0)
+	ASSERT(stop<=get_num_vectors())
+
+	for (int32_t i=start; i<stop; i++)
+	{
+		if (alphas[i-start]!=0)
+			add_to_dense_vec(alphas[i-start], i, vec, dim, abs_val);
+	}
+}
+
 void DotFeatures::dense_dot_range_subset(int32_t* sub_index, int32_t num, float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
 {
 	ASSERT(sub_index)
@@ -177,6 +220,57 @@ SGVector<float64_t> DotFeatures::get_computed_dot_feature_vector(int32_t num) co
 	return v;
 }
 
+SGMatrix<float64_t> DotFeatures::get_dense_block(int32_t start, int32_t num) const
+{
+	require(start>=0 && num>=0 && start+num<=get_num_vectors(),
+		"Block of {} vectors from {} exceeds the {} vectors!",
+		num, start, get_num_vectors());
+	const int32_t dim=get_dim_feature_space();
+
+	SGMatrix<float64_t> block(dim, num);
+	block.zero();
+	for (int32_t i=0; i<num; i++)
+		add_to_dense_vec(1.0, start+i, block.get_column_vector(i), dim);
+
+	return block;
+}
+
+DotFeatures::SparseBlock DotFeatures::get_sparse_block(int32_t start, int32_t num) const
+{
+	const auto dense=get_dense_block(start, num);
+
+	SparseBlock block;
+	block.num_features=dense.num_rows;
+	block.row_offsets=SGVector<index_t>(num+1);
+	block.row_offsets[0]=0;
+	index_t nnz=0;
+	for (int32_t i=0; i<num; i++)
+	{
+		const float64_t* col=dense.get_column_vector(i);
+		for (int32_t j=0; j<dense.num_rows; j++)
+			nnz+=(col[j]!=0);
+		block.row_offsets[i+1]=nnz;
+	}
+
+	block.feature_indices=SGVector<index_t>(nnz);
+	block.values=SGVector<float64_t>(nnz);
+	index_t k=0;
+	for (int32_t i=0; i<num; i++)
+	{
+		const float64_t* col=dense.get_column_vector(i);
+		for (int32_t j=0; j<dense.num_rows; j++)
+		{
+			if (col[j]!=0)
+			{
+				block.feature_indices[k]=j;
+				block.values[k++]=col[j];
+			}
+		}
+	}
+
+	return block;
+}
+
 SGVector<float64_t> DotFeatures::get_mean() const
 {
 	int32_t num=get_num_vectors();
@@ -14,6 +14,10 @@
 #include <shogun/lib/common.h>
 #include <shogun/features/Features.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVectorView.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
 
 namespace shogun
 {
@@ -41,6 +45,20 @@ namespace shogun
 class DotFeatures : public Features
 {
 	public:
+		/** block of vectors in compressed sparse row form, one row per
+		 * vector, see get_sparse_block()
+		 */
+		struct SparseBlock
+		{
+			/** number of columns, i.e. the dimension of the feature space */
+			int32_t num_features=0;
+			/** the entries of row i are row_offsets[i] to row_offsets[i+1]-1 */
+			SGVector<index_t> row_offsets;
+			/** feature index of every entry */
+			SGVector<index_t> feature_indices;
+			/** value of every entry */
+			SGVector<float64_t> values;
+		};
 
 		/** constructor
 		 *
@@ -85,6 +103,33 @@ class DotFeatures : public Features
 		virtual float64_t
 		dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const = 0;
 
+		/** compute dot product between vector1 and a view of a dense
+		 * vector, the view is not copied if it is contiguous
+		 *
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 view of a dense vector
+		 */
+		float64_t
+		dot(int32_t vec_idx1, const SGVectorView<const float64_t>& vec2) const;
+
+		/** compute dot products between a block of vectors and a block of
+		 * vectors of another DotFeatures object, i.e.
+		 * result(i,j)=dot(vec_idx1[i], df, vec_idx2[j])
+		 *
+		 * The default implementation calls dot() for every pair, subclasses
+		 * may compute the whole block at once (e.g. via a matrix-matrix
+		 * product).
+		 *
+		 * @param vec_idx1 indices of the vectors of this object
+		 * @param df DotFeatures (of same kind) to compute dot products with
+		 * @param vec_idx2 indices of the vectors of df
+		 * @param result preallocated matrix of size
+		 * vec_idx1.vlen x vec_idx2.vlen
+		 */
+		virtual void dot_block(
+			const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+			const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const;
+
 		/** add vector 1 multiplied with alpha to dense vector2
 		 *
 		 * @param alpha scalar alpha
@@ -95,6 +140,23 @@ class DotFeatures : public Features
 		 */
 		virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val=false) const = 0;
 
+		/** add a range of vectors multiplied with alphas to a dense vector,
+		 * i.e. vec+=alphas[i]*x_{start+i} for 0<=i<stop-start
+		 *
+		 * The default implementation calls add_to_dense_vec() for every
+		 * vector with a non-zero alpha.
+		 *
+		 * @param alphas scalars to multiply with
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param vec dense vector to add to
+		 * @param dim length of the dense vector
+		 * @param abs_val if true add the absolute values
+		 */
+		virtual void add_to_dense_vec_range(
+				const float64_t* alphas, int32_t start, int32_t stop,
+				float64_t* vec, int32_t dim, bool abs_val=false) const;
+
 		/** Compute the dot product for a range of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
@@ -139,6 +201,51 @@ class DotFeatures : public Features
 		 */
 		SGMatrix<float64_t> get_computed_dot_feature_matrix() const;
 
+		/** get the vectors start, ..., start+num-1 as dense matrix
+		 *
+		 * possible with subset
+		 *
+		 * The default implementation adds every vector to a zero matrix via
+		 * add_to_dense_vec(), subclasses may return the block in place.
+		 *
+		 * @param start first vector of the block
+		 * @param num number of vectors in the block
+		 * @return matrix of get_dim_feature_space() rows, one column per
+		 * vector, must not be modified
+		 */
+		virtual SGMatrix<float64_t> get_dense_block(int32_t start, int32_t num) const;
+
+		/** get the vectors start, ..., start+num-1 in compressed sparse
+		 * row form
+		 *
+		 * possible with subset
+		 *
+		 * The default implementation keeps the non-zero entries of
+		 * get_dense_block(), sparse subclasses build the rows from their
+		 * vectors directly.
+		 *
+		 * @param start first vector of the block
+		 * @param num number of vectors in the block
+		 * @return block with one row per vector
+		 */
+		virtual SparseBlock get_sparse_block(int32_t start, int32_t num) const;
+
+		/** call fn(start, block) for consecutive dense blocks of at most
+		 * block_size vectors covering all vectors, see get_dense_block()
+		 *
+		 * @param block_size largest number of vectors per block
+		 * @param fn function taking the index of the first vector of the
+		 * block and the block
+		 */
+		template <class F>
+		void for_each_dense_block(int32_t block_size, F&& fn) const
+		{
+			require(block_size>0, "Block size ({}) must be positive!", block_size);
+			const int32_t num=get_num_vectors();
+			for (int32_t start=0; start<num; start+=block_size)
+				fn(start, get_dense_block(start, std::min(block_size, num-start)));
+		}
+
 		/** compute the feature vector in feature space
 		 *
 		 * @return computed feature vector
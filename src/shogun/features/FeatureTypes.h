@@ -55,6 +55,9 @@ namespace shogun
 		C_FACTOR_GRAPH = 190,
 		C_INDEX = 200,
 		C_SUB_SAMPLES_DENSE=300,
+		C_PQ=310,
+		C_COMPRESSED_DENSE=320,
+		C_PACKED_STRING=330,
 		C_ANY = 1000
 	};
 
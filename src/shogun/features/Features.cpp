@@ -167,6 +167,12 @@ void Features::add_subset(SGVector<index_t> subset)
 	subset_changed_post();
 }
 
+void Features::add_subset_range(index_t start, index_t size)
+{
+	m_subset_stack->add_subset_range(start, size);
+	subset_changed_post();
+}
+
 void Features::add_subset_in_place(SGVector<index_t> subset)
 {
 	m_subset_stack->add_subset_in_place(subset);
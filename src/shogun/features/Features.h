@@ -254,6 +254,17 @@ class Features : public SGObject
 		 * */
 		virtual void add_subset(SGVector<index_t> subset);
 
+		/** Adds the range of indices start, ..., start+size-1 on top of
+		 * the current subsets without storing indices, see
+		 * SubsetStack::add_subset_range()
+		 *
+		 * Calls subset_changed_post() afterwards
+		 *
+		 * @param start first index of the range
+		 * @param size number of indices
+		 */
+		virtual void add_subset_range(index_t start, index_t size);
+
 		/** Sets/changes latest added subset. This allows to add multiple subsets
 		 * with in-place memory requirements. They cannot be removed one-by-one
 		 * afterwards, only the latest active can. If this is needed, use
@@ -0,0 +1,61 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/features/MappedDenseFeatures.h>
+
+#include <utility>
+
+using namespace shogun;
+
+template <class ST>
+MappedDenseFeatures<ST>::MappedDenseFeatures() : DenseFeatures<ST>()
+{
+}
+
+template <class ST>
+MappedDenseFeatures<ST>::MappedDenseFeatures(const char* fname)
+	: MappedDenseFeatures(std::make_shared<MappedBinaryFile>(fname))
+{
+}
+
+template <class ST>
+MappedDenseFeatures<ST>::MappedDenseFeatures(std::shared_ptr<MappedBinaryFile> file)
+	: DenseFeatures<ST>(), m_file(std::move(file))
+{
+	require(m_file, "No mapped file given.");
+	this->set_feature_matrix(m_file->template get_matrix<ST>());
+}
+
+template <class ST>
+MappedDenseFeatures<ST>::MappedDenseFeatures(const MappedDenseFeatures& orig)
+	: DenseFeatures<ST>(orig), m_file(orig.m_file)
+{
+}
+
+template <class ST>
+MappedDenseFeatures<ST>::~MappedDenseFeatures()
+{
+}
+
+template <class ST>
+std::shared_ptr<Features> MappedDenseFeatures<ST>::duplicate() const
+{
+	return std::make_shared<MappedDenseFeatures>(*this);
+}
+
+template class MappedDenseFeatures<bool>;
+template class MappedDenseFeatures<char>;
+template class MappedDenseFeatures<int8_t>;
+template class MappedDenseFeatures<uint8_t>;
+template class MappedDenseFeatures<int16_t>;
+template class MappedDenseFeatures<uint16_t>;
+template class MappedDenseFeatures<int32_t>;
+template class MappedDenseFeatures<uint32_t>;
+template class MappedDenseFeatures<int64_t>;
+template class MappedDenseFeatures<uint64_t>;
+template class MappedDenseFeatures<float32_t>;
+template class MappedDenseFeatures<float64_t>;
+template class MappedDenseFeatures<floatmax_t>;
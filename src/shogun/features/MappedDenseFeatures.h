@@ -0,0 +1,70 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _MAPPEDDENSEFEATURES__H__
+#define _MAPPEDDENSEFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/io/MappedBinaryFile.h>
+
+#include <memory>
+
+namespace shogun
+{
+/** @brief Dense features whose feature matrix is the memory mapped matrix
+ * of a MappedBinaryFile.
+ *
+ * The features keep the mapping alive, so do their duplicates. Nothing is
+ * copied or parsed when loading, pages of the matrix are read from the
+ * file when they are first used and are shared with other processes that
+ * map the same file. Writing to the matrix, e.g. by apply_preprocessors(),
+ * copies the written pages and leaves the file unchanged.
+ */
+template <class ST> class MappedDenseFeatures : public DenseFeatures<ST>
+{
+public:
+	/** default constructor */
+	MappedDenseFeatures();
+
+	/** constructor
+	 *
+	 * @param fname name of a MappedBinaryFile with a dense matrix
+	 */
+	MappedDenseFeatures(const char* fname);
+
+	/** constructor
+	 *
+	 * @param file mapped file with a dense matrix
+	 */
+	MappedDenseFeatures(std::shared_ptr<MappedBinaryFile> file);
+
+	/** copy constructor, shares the mapping */
+	MappedDenseFeatures(const MappedDenseFeatures& orig);
+
+	~MappedDenseFeatures() override;
+
+	std::shared_ptr<Features> duplicate() const override;
+
+	/** @return mapped file */
+	std::shared_ptr<MappedBinaryFile> get_file() const
+	{
+		return m_file;
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "MappedDenseFeatures";
+	}
+
+private:
+	/** mapped file whose matrix backs the features */
+	std::shared_ptr<MappedBinaryFile> m_file;
+};
+}
+#endif /* _MAPPEDDENSEFEATURES__H__ */
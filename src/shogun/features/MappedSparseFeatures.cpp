@@ -0,0 +1,61 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/features/MappedSparseFeatures.h>
+
+#include <utility>
+
+using namespace shogun;
+
+template <class ST>
+MappedSparseFeatures<ST>::MappedSparseFeatures() : SparseFeatures<ST>()
+{
+}
+
+template <class ST>
+MappedSparseFeatures<ST>::MappedSparseFeatures(const char* fname)
+	: MappedSparseFeatures(std::make_shared<MappedBinaryFile>(fname))
+{
+}
+
+template <class ST>
+MappedSparseFeatures<ST>::MappedSparseFeatures(std::shared_ptr<MappedBinaryFile> file)
+	: SparseFeatures<ST>(), m_file(std::move(file))
+{
+	require(m_file, "No mapped file given.");
+	this->set_sparse_feature_matrix(m_file->template get_sparse_vectors<ST>());
+}
+
+template <class ST>
+MappedSparseFeatures<ST>::MappedSparseFeatures(const MappedSparseFeatures& orig)
+	: SparseFeatures<ST>(orig), m_file(orig.m_file)
+{
+}
+
+template <class ST>
+MappedSparseFeatures<ST>::~MappedSparseFeatures()
+{
+}
+
+template <class ST>
+std::shared_ptr<Features> MappedSparseFeatures<ST>::duplicate() const
+{
+	return std::make_shared<MappedSparseFeatures>(*this);
+}
+
+template class MappedSparseFeatures<bool>;
+template class MappedSparseFeatures<char>;
+template class MappedSparseFeatures<int8_t>;
+template class MappedSparseFeatures<uint8_t>;
+template class MappedSparseFeatures<int16_t>;
+template class MappedSparseFeatures<uint16_t>;
+template class MappedSparseFeatures<int32_t>;
+template class MappedSparseFeatures<uint32_t>;
+template class MappedSparseFeatures<int64_t>;
+template class MappedSparseFeatures<uint64_t>;
+template class MappedSparseFeatures<float32_t>;
+template class MappedSparseFeatures<float64_t>;
+template class MappedSparseFeatures<floatmax_t>;
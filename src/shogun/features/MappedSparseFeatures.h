@@ -0,0 +1,70 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _MAPPEDSPARSEFEATURES__H__
+#define _MAPPEDSPARSEFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/io/MappedBinaryFile.h>
+
+#include <memory>
+
+namespace shogun
+{
+/** @brief Sparse features whose vectors are the memory mapped sparse vectors
+ * of a MappedBinaryFile.
+ *
+ * The features keep the mapping alive, so do their duplicates. Nothing is
+ * copied or parsed when loading, pages of the matrix are read from the
+ * file when they are first used and are shared with other processes that
+ * map the same file. Writing to the vectors, e.g. by sort_features(), copies
+ * the written pages and leaves the file unchanged.
+ */
+template <class ST> class MappedSparseFeatures : public SparseFeatures<ST>
+{
+public:
+	/** default constructor */
+	MappedSparseFeatures();
+
+	/** constructor
+	 *
+	 * @param fname name of a MappedBinaryFile with a sparse matrix
+	 */
+	MappedSparseFeatures(const char* fname);
+
+	/** constructor
+	 *
+	 * @param file mapped file with a sparse matrix
+	 */
+	MappedSparseFeatures(std::shared_ptr<MappedBinaryFile> file);
+
+	/** copy constructor, shares the mapping */
+	MappedSparseFeatures(const MappedSparseFeatures& orig);
+
+	~MappedSparseFeatures() override;
+
+	std::shared_ptr<Features> duplicate() const override;
+
+	/** @return mapped file */
+	std::shared_ptr<MappedBinaryFile> get_file() const
+	{
+		return m_file;
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "MappedSparseFeatures";
+	}
+
+private:
+	/** mapped file whose vectors back the features */
+	std::shared_ptr<MappedBinaryFile> m_file;
+};
+}
+#endif /* _MAPPEDSPARSEFEATURES__H__ */
@@ -0,0 +1,278 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/features/PQDenseFeatures.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+PQDenseFeatures::PQDenseFeatures() : RandomMixin<Features>()
+{
+	init();
+}
+
+PQDenseFeatures::PQDenseFeatures(
+	int32_t num_subspaces, int32_t num_bits, int32_t max_iter)
+	: RandomMixin<Features>()
+{
+	init();
+
+	require(num_subspaces>0, "Number of subspaces ({}) must be positive!",
+		num_subspaces);
+	require(num_bits>0 && num_bits<=8,
+		"Number of bits per code ({}) must be in [1, 8]!", num_bits);
+	m_num_subspaces=num_subspaces;
+	m_num_bits=num_bits;
+	m_max_iter=max_iter;
+}
+
+PQDenseFeatures::PQDenseFeatures(const PQDenseFeatures& orig)
+	: RandomMixin<Features>()
+{
+	init();
+
+	m_num_subspaces=orig.m_num_subspaces;
+	m_num_bits=orig.m_num_bits;
+	m_max_iter=orig.m_max_iter;
+	m_codebooks=orig.m_codebooks;
+	m_codes=orig.m_codes;
+}
+
+PQDenseFeatures::~PQDenseFeatures()
+{
+}
+
+void PQDenseFeatures::init()
+{
+	m_num_subspaces=1;
+	m_num_bits=8;
+	m_max_iter=25;
+
+	SG_ADD(&m_num_subspaces, "num_subspaces", "Number of subspaces.",
+		ParameterProperties::HYPER);
+	SG_ADD(&m_num_bits, "num_bits", "Bits per code.",
+		ParameterProperties::HYPER);
+	SG_ADD(&m_max_iter, "max_iter", "Maximum number of k-means iterations.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_codebooks, "codebooks", "Centroids of all subspaces.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_codes, "codes", "Codes of the vectors.",
+		ParameterProperties::READONLY);
+}
+
+void PQDenseFeatures::fit(const std::shared_ptr<DenseFeatures<float64_t>>& data)
+{
+	require(data, "No features provided!");
+
+	const int32_t dim=data->get_num_features();
+	const int32_t num_centroids=get_num_centroids();
+	require(m_num_subspaces<=dim,
+		"Number of subspaces ({}) must not exceed the dimension ({})!",
+		m_num_subspaces, dim);
+	require(data->get_num_vectors()>=num_centroids,
+		"Number of vectors ({}) must be at least the number of centroids ({})!",
+		data->get_num_vectors(), num_centroids);
+
+	auto matrix=data->get_feature_matrix();
+	if (data->get_num_vectors()!=matrix.num_cols)
+	{
+		SGVector<index_t> idx(data->get_num_vectors());
+		idx.range_fill();
+		matrix=data->copy_subset(idx)->as<DenseFeatures<float64_t>>()
+			->get_feature_matrix();
+	}
+
+	m_codebooks=SGMatrix<float64_t>(dim, num_centroids);
+
+	// one generator per subspace, so that the result does not depend on
+	// the number of threads
+	std::vector<uint64_t> seeds(m_num_subspaces);
+	for (auto& seed : seeds)
+		seed=m_prng();
+
+#pragma omp parallel for schedule(dynamic)
+	for (int32_t s=0; s<m_num_subspaces; s++)
+		fit_subspace(matrix, s, seeds[s]);
+
+	encode(data);
+}
+
+void PQDenseFeatures::fit_subspace(
+	const SGMatrix<float64_t>& data, int32_t s, uint64_t seed)
+{
+	const int32_t begin=subspace_begin(s);
+	const int32_t dsub=subspace_begin(s+1)-begin;
+	const int32_t num_centroids=get_num_centroids();
+	const index_t num_vectors=data.num_cols;
+
+	auto sq_dist=[&](const float64_t* x, int32_t c) {
+		float64_t result=0;
+		for (int32_t d=0; d<dsub; d++)
+			result+=Math::sq(x[d]-m_codebooks(begin+d, c));
+		return result;
+	};
+
+	std::mt19937_64 prng(seed);
+	SGVector<index_t> perm(num_vectors);
+	perm.range_fill();
+	random::shuffle(perm, prng);
+	for (int32_t c=0; c<num_centroids; c++)
+	{
+		std::copy_n(data.get_column_vector(perm[c])+begin, dsub,
+			m_codebooks.get_column_vector(c)+begin);
+	}
+
+	std::vector<int32_t> assignment(num_vectors, -1);
+	std::vector<float64_t> sums(int64_t(dsub)*num_centroids);
+	std::vector<index_t> counts(num_centroids);
+	std::uniform_int_distribution<index_t> uniform(0, num_vectors-1);
+	for (int32_t iter=0; iter<m_max_iter; iter++)
+	{
+		bool changed=false;
+		for (index_t i=0; i<num_vectors; i++)
+		{
+			const float64_t* x=data.get_column_vector(i)+begin;
+			int32_t best=0;
+			float64_t best_dist=std::numeric_limits<float64_t>::infinity();
+			for (int32_t c=0; c<num_centroids; c++)
+			{
+				const float64_t dist=sq_dist(x, c);
+				if (dist<best_dist)
+				{
+					best_dist=dist;
+					best=c;
+				}
+			}
+			changed|=assignment[i]!=best;
+			assignment[i]=best;
+		}
+
+		if (!changed)
+			break;
+
+		std::fill(sums.begin(), sums.end(), 0.0);
+		std::fill(counts.begin(), counts.end(), 0);
+		for (index_t i=0; i<num_vectors; i++)
+		{
+			const float64_t* x=data.get_column_vector(i)+begin;
+			float64_t* sum=&sums[int64_t(assignment[i])*dsub];
+			for (int32_t d=0; d<dsub; d++)
+				sum[d]+=x[d];
+			counts[assignment[i]]++;
+		}
+
+		for (int32_t c=0; c<num_centroids; c++)
+		{
+			float64_t* centroid=m_codebooks.get_column_vector(c)+begin;
+			// restart empty clusters at a random vector
+			if (counts[c]==0)
+			{
+				std::copy_n(data.get_column_vector(uniform(prng))+begin, dsub,
+					centroid);
+				continue;
+			}
+
+			for (int32_t d=0; d<dsub; d++)
+				centroid[d]=sums[int64_t(c)*dsub+d]/counts[c];
+		}
+	}
+}
+
+void PQDenseFeatures::encode(const std::shared_ptr<DenseFeatures<float64_t>>& data)
+{
+	require(data, "No features provided!");
+	require(m_codebooks.num_cols==get_num_centroids(),
+		"Codebooks are not learned, call fit()!");
+	require(data->get_num_features()==get_dim(),
+		"Dimension of the data ({}) must match the codebooks ({})!",
+		data->get_num_features(), get_dim());
+
+	const int32_t num_vectors=data->get_num_vectors();
+	const int32_t num_centroids=get_num_centroids();
+	m_codes=SGMatrix<uint8_t>(m_num_subspaces, num_vectors);
+	m_subset_stack->remove_all_subsets();
+
+#pragma omp parallel for
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		auto vec=data->get_feature_vector(i);
+		uint8_t* codes=m_codes.get_column_vector(i);
+		for (int32_t s=0; s<m_num_subspaces; s++)
+		{
+			const int32_t begin=subspace_begin(s);
+			const int32_t end=subspace_begin(s+1);
+			uint8_t best=0;
+			float64_t best_dist=std::numeric_limits<float64_t>::infinity();
+			for (int32_t c=0; c<num_centroids; c++)
+			{
+				float64_t dist=0;
+				for (int32_t d=begin; d<end; d++)
+					dist+=Math::sq(vec[d]-m_codebooks(d, c));
+				if (dist<best_dist)
+				{
+					best_dist=dist;
+					best=c;
+				}
+			}
+			codes[s]=best;
+		}
+		data->free_feature_vector(vec, i);
+	}
+}
+
+SGVector<float64_t> PQDenseFeatures::decode(int32_t idx) const
+{
+	const uint8_t* codes=m_codes.get_column_vector(
+		m_subset_stack->subset_idx_conversion(idx));
+
+	SGVector<float64_t> result(get_dim());
+	for (int32_t s=0; s<m_num_subspaces; s++)
+	{
+		for (int32_t d=subspace_begin(s); d<subspace_begin(s+1); d++)
+			result[d]=m_codebooks(d, codes[s]);
+	}
+
+	return result;
+}
+
+SGMatrix<float64_t> PQDenseFeatures::compute_lookup_table(
+	const float64_t* query) const
+{
+	const int32_t num_centroids=get_num_centroids();
+	SGMatrix<float64_t> table(num_centroids, m_num_subspaces);
+	for (int32_t s=0; s<m_num_subspaces; s++)
+	{
+		const int32_t begin=subspace_begin(s);
+		const int32_t end=subspace_begin(s+1);
+		float64_t* entries=table.get_column_vector(s);
+		for (int32_t c=0; c<num_centroids; c++)
+		{
+			const float64_t* centroid=m_codebooks.get_column_vector(c);
+			float64_t dist=0;
+			for (int32_t d=begin; d<end; d++)
+				dist+=Math::sq(query[d]-centroid[d]);
+			entries[c]=dist;
+		}
+	}
+
+	return table;
+}
+
+std::shared_ptr<Features> PQDenseFeatures::duplicate() const
+{
+	return std::make_shared<PQDenseFeatures>(*this);
+}
+
+int32_t PQDenseFeatures::get_num_vectors() const
+{
+	return m_subset_stack->has_subsets() ? m_subset_stack->get_size()
+		: m_codes.num_cols;
+}
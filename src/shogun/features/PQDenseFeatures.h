@@ -0,0 +1,186 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _PQDENSEFEATURES__H__
+#define _PQDENSEFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/Features.h>
+#include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+namespace shogun
+{
+/** @brief Product quantization compressed dense real features.
+ *
+ * The feature space is split into m contiguous subspaces and every subspace
+ * is quantized with its own codebook of \f$2^b\f$ centroids learned by
+ * k-means, see Jegou et al., "Product Quantization for Nearest Neighbor
+ * Search". A vector is stored as m codes of one byte each, i.e. m bytes
+ * instead of 8d bytes for DenseFeatures<float64_t>.
+ *
+ * Distances of a query to the encoded vectors are computed asymmetrically:
+ * compute_lookup_table() computes the squared distance of each query
+ * subvector to all centroids of its subspace once, the squared distance to
+ * an encoded vector is then the sum of m table entries. The table of a
+ * subspace holds \f$2^b\f$ contiguous entries, with b=4 a subspace table
+ * has 16 entries. See PQDistance to use the features with a Distance, e.g.
+ * in KNN.
+ */
+class PQDenseFeatures : public RandomMixin<Features>
+{
+public:
+	/** default constructor */
+	PQDenseFeatures();
+
+	/** constructor
+	 *
+	 * @param num_subspaces number of subspaces m, i.e. bytes per vector
+	 * @param num_bits bits per code, the number of centroids per subspace
+	 * is 2^num_bits
+	 * @param max_iter maximum number of k-means iterations per subspace
+	 */
+	PQDenseFeatures(
+		int32_t num_subspaces, int32_t num_bits=8, int32_t max_iter=25);
+
+	/** copy constructor */
+	PQDenseFeatures(const PQDenseFeatures& orig);
+
+	~PQDenseFeatures() override;
+
+	/** learn the codebooks on the given data and encode it
+	 *
+	 * @param data training data
+	 */
+	void fit(const std::shared_ptr<DenseFeatures<float64_t>>& data);
+
+	/** encode data with the learned codebooks, replaces the stored codes
+	 *
+	 * @param data data of the dimension passed to fit()
+	 */
+	void encode(const std::shared_ptr<DenseFeatures<float64_t>>& data);
+
+	/** reconstruct a vector from its codes
+	 *
+	 * @param idx index of the vector
+	 * @return concatenated centroids of the codes
+	 */
+	SGVector<float64_t> decode(int32_t idx) const;
+
+	/** compute the squared distances of the subvectors of a query to all
+	 * centroids of their subspace
+	 *
+	 * @param query query vector of dimension get_dim()
+	 * @return table of size get_num_centroids() x get_num_subspaces()
+	 */
+	SGMatrix<float64_t> compute_lookup_table(const float64_t* query) const;
+
+	/** asymmetric squared distance of a query to an encoded vector
+	 *
+	 * @param table lookup table of the query, see compute_lookup_table()
+	 * @param idx index of the vector
+	 * @return sum of the table entries of the codes of the vector
+	 */
+	float64_t asymmetric_distance(
+		const SGMatrix<float64_t>& table, int32_t idx) const
+	{
+		const uint8_t* codes=m_codes.get_column_vector(
+			m_subset_stack->subset_idx_conversion(idx));
+		const float64_t* entries=table.matrix;
+		float64_t result=0;
+		for (int32_t s=0; s<m_num_subspaces; s++, entries+=table.num_rows)
+			result+=entries[codes[s]];
+
+		return result;
+	}
+
+	/** @return number of subspaces m */
+	int32_t get_num_subspaces() const
+	{
+		return m_num_subspaces;
+	}
+
+	/** @return number of centroids per subspace */
+	int32_t get_num_centroids() const
+	{
+		return 1<<m_num_bits;
+	}
+
+	/** @return dimension of the encoded vectors */
+	int32_t get_dim() const
+	{
+		return m_codebooks.num_rows;
+	}
+
+	/** @return codes, one column of m bytes per vector */
+	SGMatrix<uint8_t> get_codes() const
+	{
+		return m_codes;
+	}
+
+	/** @return codebooks, column c holds centroid c of every subspace */
+	SGMatrix<float64_t> get_codebooks() const
+	{
+		return m_codebooks;
+	}
+
+	std::shared_ptr<Features> duplicate() const override;
+
+	/** @return feature type BYTE */
+	EFeatureType get_feature_type() const override
+	{
+		return F_BYTE;
+	}
+
+	/** @return feature class PQ */
+	EFeatureClass get_feature_class() const override
+	{
+		return C_PQ;
+	}
+
+	int32_t get_num_vectors() const override;
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "PQDenseFeatures";
+	}
+
+private:
+	void init();
+
+	/** @return first dimension of a subspace, get_dim() for s=m */
+	int32_t subspace_begin(int32_t s) const
+	{
+		return int64_t(s)*get_dim()/m_num_subspaces;
+	}
+
+	/** learn the codebook of a subspace by Lloyd's algorithm started from
+	 * distinct random vectors
+	 */
+	void fit_subspace(
+		const SGMatrix<float64_t>& data, int32_t s, uint64_t seed);
+
+protected:
+	/** number of subspaces */
+	int32_t m_num_subspaces;
+
+	/** bits per code */
+	int32_t m_num_bits;
+
+	/** maximum number of k-means iterations */
+	int32_t m_max_iter;
+
+	/** codebooks, dim x num_centroids */
+	SGMatrix<float64_t> m_codebooks;
+
+	/** codes, num_subspaces x num_vectors */
+	SGMatrix<uint8_t> m_codes;
+};
+}
+#endif /* _PQDENSEFEATURES__H__ */
@@ -0,0 +1,171 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/features/PackedStringFeatures.h>
+#include <shogun/features/StringFeatures.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace shogun;
+
+PackedStringFeatures::PackedStringFeatures() : Features()
+{
+	init();
+}
+
+PackedStringFeatures::PackedStringFeatures(
+	const std::shared_ptr<StringFeatures<char>>& sf)
+	: Features()
+{
+	init();
+	pack(sf);
+}
+
+PackedStringFeatures::PackedStringFeatures(const PackedStringFeatures& orig)
+	: Features(orig)
+{
+	init();
+
+	m_alphabet=orig.m_alphabet;
+	m_bits_per_symbol=orig.m_bits_per_symbol;
+	m_num_vectors=orig.m_num_vectors;
+	m_offset=orig.m_offset;
+	m_data=orig.m_data;
+}
+
+PackedStringFeatures::~PackedStringFeatures()
+{
+}
+
+void PackedStringFeatures::init()
+{
+	m_bits_per_symbol=2;
+	m_num_vectors=0;
+
+	SG_ADD(&m_alphabet, "alphabet", "Alphabet of the strings.");
+	SG_ADD(&m_bits_per_symbol, "bits_per_symbol", "Bits per stored symbol.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_num_vectors, "num_vectors", "Number of strings.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_offset, "offset", "Position of the first symbol of every string.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_data, "data", "Packed symbols of all strings.",
+		ParameterProperties::READONLY);
+}
+
+void PackedStringFeatures::pack(const std::shared_ptr<StringFeatures<char>>& sf)
+{
+	require(sf, "No strings to pack given");
+	auto alpha=sf->get_alphabet();
+	require(alpha->get_num_symbols()<=16,
+		"Only alphabets with at most 16 symbols can be packed ({} symbols)",
+		alpha->get_num_symbols());
+
+	remove_all_subsets();
+
+	m_alphabet=std::make_shared<Alphabet>(alpha);
+	m_bits_per_symbol=alpha->get_num_symbols()<=4 ? 2 : 4;
+	m_num_vectors=sf->get_num_vectors();
+
+	m_offset=SGVector<int64_t>(m_num_vectors+1);
+	m_offset[0]=0;
+	for (int32_t i=0; i<m_num_vectors; i++)
+		m_offset[i+1]=m_offset[i]+sf->get_vector_length(i);
+
+	const int32_t per_word=64/m_bits_per_symbol;
+	m_data=SGVector<uint64_t>((m_offset[m_num_vectors]+per_word-1)/per_word);
+	m_data.zero();
+
+	for (int32_t i=0; i<m_num_vectors; i++)
+	{
+		auto str=sf->get_feature_vector(i);
+		int64_t pos=m_offset[i];
+		for (int32_t j=0; j<str.vlen; j++, pos++)
+		{
+			const uint8_t c=str[j];
+			require(alpha->is_valid(c),
+				"Character {} at position {} of string {} is not in the "
+				"alphabet", (int32_t) c, j, i);
+			m_data[pos/per_word]|=uint64_t(alpha->remap_to_bin(c))<<
+				((pos%per_word)*m_bits_per_symbol);
+		}
+	}
+}
+
+std::shared_ptr<StringFeatures<char>> PackedStringFeatures::unpack() const
+{
+	const int32_t num_vectors=get_num_vectors();
+	std::vector<SGVector<char>> strings;
+	strings.reserve(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		const int32_t real_num=real_index(i);
+		const int64_t offset=m_offset[real_num];
+		SGVector<char> str(m_offset[real_num+1]-offset);
+		for (int32_t j=0; j<str.vlen; j++)
+			str[j]=m_alphabet->remap_to_char(symbol_at(offset+j));
+		strings.push_back(str);
+	}
+
+	return std::make_shared<StringFeatures<char>>(
+		strings, std::make_shared<Alphabet>(m_alphabet));
+}
+
+int32_t PackedStringFeatures::real_index(int32_t num) const
+{
+	require(num>=0 && num<get_num_vectors(),
+		"Index out of bounds (number of strings {}, you requested {})",
+		get_num_vectors(), num);
+	return m_subset_stack->subset_idx_conversion(num);
+}
+
+int32_t PackedStringFeatures::get_vector_length(int32_t num) const
+{
+	const int32_t real_num=real_index(num);
+	return m_offset[real_num+1]-m_offset[real_num];
+}
+
+int32_t PackedStringFeatures::get_max_vector_length() const
+{
+	int32_t max_length=0;
+	for (int32_t i=0; i<get_num_vectors(); i++)
+		max_length=std::max(max_length, get_vector_length(i));
+
+	return max_length;
+}
+
+uint8_t PackedStringFeatures::get_symbol(int32_t num, int32_t pos) const
+{
+	const int32_t real_num=real_index(num);
+	const int64_t offset=m_offset[real_num];
+	require(pos>=0 && pos<m_offset[real_num+1]-offset,
+		"Position {} out of bounds (string length {})", pos,
+		m_offset[real_num+1]-offset);
+	return symbol_at(offset+pos);
+}
+
+SGVector<uint8_t> PackedStringFeatures::get_feature_vector(int32_t num) const
+{
+	const int32_t real_num=real_index(num);
+	const int64_t offset=m_offset[real_num];
+	SGVector<uint8_t> vec(m_offset[real_num+1]-offset);
+	for (int32_t j=0; j<vec.vlen; j++)
+		vec[j]=symbol_at(offset+j);
+
+	return vec;
+}
+
+std::shared_ptr<Features> PackedStringFeatures::duplicate() const
+{
+	return std::make_shared<PackedStringFeatures>(*this);
+}
+
+int32_t PackedStringFeatures::get_num_vectors() const
+{
+	return m_subset_stack->has_subsets() ? m_subset_stack->get_size() :
+		m_num_vectors;
+}
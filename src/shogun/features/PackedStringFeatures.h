@@ -0,0 +1,173 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _PACKEDSTRINGFEATURES__H__
+#define _PACKEDSTRINGFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/Alphabet.h>
+#include <shogun/features/Features.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+template <class ST> class StringFeatures;
+
+/** @brief Strings over a small alphabet stored with 2 or 4 bits per symbol.
+ *
+ * Every character is remapped to its binary symbol with
+ * Alphabet::remap_to_bin() and stored in 64 bit words, 32 symbols per
+ * word for alphabets of up to 4 symbols (DNA, RNA, RAWDNA) and 16 symbols
+ * per word for alphabets of up to 16 symbols (e.g. IUPAC_NUCLEIC_ACID). The
+ * strings are stored back to back, a genome therefore needs a quarter of
+ * the memory of StringFeatures<char>.
+ *
+ * StringFeatures<ST>::obtain_from_packed() extracts the k-mers of order k
+ * directly from the packed words, which gives the same features as
+ * StringFeatures<ST>::obtain_from_char() without the intermediate copy of
+ * remapped characters, e.g. for CommWordStringKernel or
+ * SpectrumRBFKernel. Kernels working on characters, like
+ * WeightedDegreeStringKernel, are used with unpack().
+ */
+class PackedStringFeatures : public Features
+{
+	template <class ST> friend class StringFeatures;
+
+public:
+	/** default constructor */
+	PackedStringFeatures();
+
+	/** constructor
+	 *
+	 * @param sf strings to pack, subset of sf is possible
+	 */
+	PackedStringFeatures(const std::shared_ptr<StringFeatures<char>>& sf);
+
+	/** copy constructor */
+	PackedStringFeatures(const PackedStringFeatures& orig);
+
+	~PackedStringFeatures() override;
+
+	/** pack strings, replaces the stored strings and removes all subsets
+	 *
+	 * the alphabet of sf must have at most 16 symbols and every character
+	 * must be valid in it
+	 *
+	 * @param sf strings to pack, subset of sf is possible
+	 */
+	void pack(const std::shared_ptr<StringFeatures<char>>& sf);
+
+	/** unpack the strings to characters
+	 *
+	 * possible with subset
+	 *
+	 * @return strings with the alphabet of the packed strings
+	 */
+	std::shared_ptr<StringFeatures<char>> unpack() const;
+
+	/** @return alphabet of the strings */
+	std::shared_ptr<Alphabet> get_alphabet() const
+	{
+		return m_alphabet;
+	}
+
+	/** @return bits per stored symbol, 2 or 4 */
+	int32_t get_bits_per_symbol() const
+	{
+		return m_bits_per_symbol;
+	}
+
+	/** possible with subset
+	 *
+	 * @param num index of the string
+	 * @return length of the string
+	 */
+	int32_t get_vector_length(int32_t num) const;
+
+	/** possible with subset
+	 *
+	 * @return length of the longest string
+	 */
+	int32_t get_max_vector_length() const;
+
+	/** possible with subset
+	 *
+	 * @param num index of the string
+	 * @param pos position in the string
+	 * @return binary symbol at the position, see Alphabet::remap_to_bin()
+	 */
+	uint8_t get_symbol(int32_t num, int32_t pos) const;
+
+	/** possible with subset
+	 *
+	 * @param num index of the string
+	 * @return binary symbols of the string
+	 */
+	SGVector<uint8_t> get_feature_vector(int32_t num) const;
+
+	/** @return bytes used by the packed symbols of all strings */
+	int64_t get_memory_size() const
+	{
+		return m_data.vlen*int64_t(sizeof(uint64_t));
+	}
+
+	std::shared_ptr<Features> duplicate() const override;
+
+	/** @return feature type CHAR */
+	EFeatureType get_feature_type() const override
+	{
+		return F_CHAR;
+	}
+
+	/** @return feature class PACKED_STRING */
+	EFeatureClass get_feature_class() const override
+	{
+		return C_PACKED_STRING;
+	}
+
+	int32_t get_num_vectors() const override;
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "PackedStringFeatures";
+	}
+
+private:
+	void init();
+
+	/** @return string index without subset, checks bounds */
+	int32_t real_index(int32_t num) const;
+
+	/** @return binary symbol at the position of all strings */
+	uint8_t symbol_at(int64_t pos) const
+	{
+		const int32_t per_word=64/m_bits_per_symbol;
+		return (m_data[pos/per_word]>>((pos%per_word)*m_bits_per_symbol)) &
+			((uint64_t(1)<<m_bits_per_symbol)-1);
+	}
+
+protected:
+	/** alphabet of the strings */
+	std::shared_ptr<Alphabet> m_alphabet;
+
+	/** bits per stored symbol */
+	int32_t m_bits_per_symbol;
+
+	/** number of strings without subset */
+	int32_t m_num_vectors;
+
+	/** position of the first symbol of every string, and the total
+	 * number of symbols */
+	SGVector<int64_t> m_offset;
+
+	/** packed symbols of all strings */
+	SGVector<uint64_t> m_data;
+};
+}
+#endif /* _PACKEDSTRINGFEATURES__H__ */
@@ -1,4 +1,8 @@
 #include <shogun/features/PolyFeatures.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <cmath>
+#include <vector>
 
 using namespace shogun;
 
@@ -30,6 +34,7 @@ PolyFeatures::PolyFeatures(const std::shared_ptr<DenseFeatures<float64_t>>& feat
 	m_output_dimensions=calc_feature_space_dimensions(m_input_dimensions, m_degree);
 
 	store_multi_index();
+	store_shared_prefix();
 	store_multinomial_coefficients();
 	if (m_normalize)
 		store_normalization_values();
@@ -107,33 +112,16 @@ float64_t PolyFeatures::dot(int32_t vec_idx1, std::shared_ptr<DotFeatures> df, i
 	ASSERT(df->get_feature_class() == get_feature_class())
 
 	auto pf=std::static_pointer_cast<PolyFeatures>(df);
+	require(pf->m_output_dimensions==m_output_dimensions,
+		"Dimensions don't match, {} vs {}", pf->m_output_dimensions,
+		m_output_dimensions);
 
-	int32_t len1;
-	bool do_free1;
-	float64_t* vec1 = m_feat->get_feature_vector(vec_idx1, len1, do_free1);
-
-	int32_t len2;
-	bool do_free2;
-	float64_t* vec2 = pf->m_feat->get_feature_vector(vec_idx2, len2, do_free2);
-
-	float64_t sum=0;
-	int cnt=0;
-	for (int j=0; j<m_output_dimensions; j++)
-	{
-		float64_t out1=m_multinomial_coefficients[j];
-		float64_t out2=m_multinomial_coefficients[j];
-		for (int k=0; k<m_degree; k++)
-		{
-			out1*=vec1[m_multi_index[cnt]];
-			out2*=vec2[m_multi_index[cnt]];
-			cnt++;
-		}
-		sum+=out1*out2;
-	}
-	m_feat->free_feature_vector(vec1, len1, do_free1);
-	pf->m_feat->free_feature_vector(vec2, len2, do_free2);
+	SGVector<float64_t> out1(m_output_dimensions);
+	SGVector<float64_t> out2(m_output_dimensions);
+	expand(vec_idx1, out1.vector);
+	pf->expand(vec_idx2, out2.vector);
 
-	return sum;
+	return linalg::dot(out1, out2);
 }
 
 float64_t
@@ -144,77 +132,154 @@ PolyFeatures::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 	    "Dimensions don't match, vec2_dim={}, m_output_dimensions={}",
 	    vec2.size(), m_output_dimensions);
 
-	int32_t len;
-	bool do_free;
-	float64_t* vec = m_feat->get_feature_vector(vec_idx1, len, do_free);
+	SGVector<float64_t> output(m_output_dimensions);
+	expand(vec_idx1, output.vector);
+
+	return linalg::dot(output, vec2);
+}
+
+void PolyFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val) const
+{
+	if (vec2_len != m_output_dimensions)
+		error("Dimensions don't match, vec2_dim={}, m_output_dimensions={}", vec2_len, m_output_dimensions);
 
+	SGVector<float64_t> output(m_output_dimensions);
+	expand(vec_idx1, output.vector);
 
-	int cnt=0;
-	float64_t sum=0;
-	for (int j = 0; j < vec2.size(); j++)
+	if (abs_val)
 	{
-		float64_t output=m_multinomial_coefficients[j];
-		for (int k=0; k<m_degree; k++)
-		{
-			output*=vec[m_multi_index[cnt]];
-			cnt++;
-		}
-		sum+=output*vec2[j];
+		for (int32_t j=0; j<vec2_len; j++)
+			vec2[j]+=alpha*Math::abs(output[j]);
 	}
-	if (m_normalize)
-		sum = sum/m_normalization_values[vec_idx1];
+	else
+	{
+		for (int32_t j=0; j<vec2_len; j++)
+			vec2[j]+=alpha*output[j];
+	}
+}
+
+void PolyFeatures::dot_block(
+	const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+	const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const
+{
+	require(df, "Features to compute dot products with are not set!");
+	require(result.num_rows==vec_idx1.vlen && result.num_cols==vec_idx2.vlen,
+		"Result matrix ({}x{}) does not match the block size ({}x{})!",
+		result.num_rows, result.num_cols, vec_idx1.vlen, vec_idx2.vlen);
 
-	m_feat->free_feature_vector(vec, len, do_free);
-	return sum;
+	auto pf=std::dynamic_pointer_cast<PolyFeatures>(df);
+	if (!pf)
+	{
+		DotFeatures::dot_block(vec_idx1, df, vec_idx2, result);
+		return;
+	}
+	require(pf->m_output_dimensions==m_output_dimensions,
+		"Dimensions don't match, {} vs {}", pf->m_output_dimensions,
+		m_output_dimensions);
+
+	SGMatrix<float64_t> block1(m_output_dimensions, vec_idx1.vlen);
+	SGMatrix<float64_t> block2(m_output_dimensions, vec_idx2.vlen);
+	#pragma omp parallel for
+	for (index_t i=0; i<vec_idx1.vlen; i++)
+		expand(vec_idx1[i], block1.get_column_vector(i));
+	#pragma omp parallel for
+	for (index_t j=0; j<vec_idx2.vlen; j++)
+		pf->expand(vec_idx2[j], block2.get_column_vector(j));
+
+	linalg::matrix_prod(block1, block2, result, true, false);
 }
 
-void PolyFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val) const
+SGMatrix<float64_t> PolyFeatures::get_dense_block(int32_t start, int32_t num) const
 {
-	if (vec2_len != m_output_dimensions)
-		error("Dimensions don't match, vec2_dim={}, m_output_dimensions={}", vec2_len, m_output_dimensions);
+	require(start>=0 && num>=0 && start+num<=get_num_vectors(),
+		"Block of {} vectors from {} exceeds the {} vectors!",
+		num, start, get_num_vectors());
 
-	int32_t len;
-	bool do_free;
-	float64_t* vec = m_feat->get_feature_vector(vec_idx1, len, do_free);
+	SGMatrix<float64_t> block(m_output_dimensions, num);
+	#pragma omp parallel for
+	for (int32_t i=0; i<num; i++)
+		expand(start+i, block.get_column_vector(i));
+
+	return block;
+}
 
+void PolyFeatures::expand(const float64_t* vec, float64_t* output) const
+{
+	// prefix[k] is the product of the first k factors of the current
+	// monomial, only the factors after the shared prefix change
+	std::vector<float64_t> prefix(m_degree+1);
+	prefix[0]=1.0;
 
-	int cnt=0;
-	float32_t norm_val=1;
-	if (m_normalize)
-		norm_val = m_normalization_values[vec_idx1];
-	alpha/=norm_val;
-	for (int j=0; j<vec2_len; j++)
+	const uint16_t* index=m_multi_index;
+	for (int32_t j=0; j<m_output_dimensions; j++)
 	{
-		float64_t output=m_multinomial_coefficients[j];
-		for (int k=0; k<m_degree; k++)
-		{
-			output*=vec[m_multi_index[cnt]];
-			cnt++;
-		}
-		if (abs_val)
-			output=Math::abs(output);
+		for (int32_t k=m_shared_prefix[j]; k<m_degree; k++)
+			prefix[k+1]=prefix[k]*vec[index[k]];
 
-		vec2[j]+=alpha*output;
+		output[j]=m_multinomial_coefficients[j]*prefix[m_degree];
+		index+=m_degree;
 	}
-	m_feat->free_feature_vector(vec, len, do_free);
 }
+
+void PolyFeatures::expand(int32_t vec_idx, float64_t* output) const
+{
+	int32_t len;
+	bool do_free;
+	float64_t* vec=m_feat->get_feature_vector(vec_idx, len, do_free);
+	expand(vec, output);
+	m_feat->free_feature_vector(vec, vec_idx, do_free);
+
+	if (m_normalize && m_normalization_values)
+	{
+		const float64_t norm_val=m_normalization_values[vec_idx];
+		for (int32_t j=0; j<m_output_dimensions; j++)
+			output[j]/=norm_val;
+	}
+}
+
 void PolyFeatures::store_normalization_values()
 {
 	SG_FREE(m_normalization_values);
+	m_normalization_values=NULL;
 
 	int32_t num_vec = this->get_num_vectors();
+	float32_t* norms=SG_MALLOC(float32_t, num_vec);
 
-	m_normalization_values=SG_MALLOC(float32_t, num_vec);
-	for (int i=0; i<num_vec; i++)
+	#pragma omp parallel
 	{
-		float64_t tmp = std::sqrt(dot(i, std::dynamic_pointer_cast<std::remove_pointer_t<decltype(this)>>(shared_from_this()), i));
-		if (tmp==0)
+		SGVector<float64_t> output(m_output_dimensions);
+		#pragma omp for
+		for (int32_t i=0; i<num_vec; i++)
+		{
+			int32_t len;
+			bool do_free;
+			float64_t* vec=m_feat->get_feature_vector(i, len, do_free);
+			expand(vec, output.vector);
+			m_feat->free_feature_vector(vec, i, do_free);
+
+			float64_t tmp=std::sqrt(linalg::dot(output, output));
 			// trap division by zero
-			m_normalization_values[i]=1;
-		else
-			m_normalization_values[i]=tmp;
+			norms[i]=(tmp==0) ? 1 : tmp;
+		}
 	}
 
+	m_normalization_values=norms;
+}
+
+void PolyFeatures::store_shared_prefix()
+{
+	m_shared_prefix=SGVector<int32_t>(m_output_dimensions);
+	for (int32_t j=0; j<m_output_dimensions; j++)
+	{
+		int32_t k=0;
+		if (j>0)
+		{
+			const uint16_t* index=m_multi_index+j*m_degree;
+			while (k<m_degree && index[k]==index[k-m_degree])
+				k++;
+		}
+		m_shared_prefix[j]=k;
+	}
 }
 
 void PolyFeatures::store_multi_index()
@@ -391,6 +456,9 @@ void PolyFeatures::register_parameters()
 	SG_ADD(
 	    &m_output_dimensions, "output_dimensions",
 	    "Dimensions of the feature space of the polynomial kernel.");
+	SG_ADD(
+	    &m_shared_prefix, "shared_prefix",
+	    "Number of leading factors every monomial shares with the previous.");
 
 	multi_index_length=m_output_dimensions*m_degree;
 	/*m_parameters->add_vector(
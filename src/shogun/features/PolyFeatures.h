@@ -20,6 +20,16 @@ namespace shogun
  *
  * see DotFeatures for further discription
  *
+ * The monomials are enumerated in lexicographic order once, when the
+ * features are constructed. Consecutive monomials share their leading
+ * factors, so expanding a vector only multiplies the factors following
+ * the shared prefix onto the stored prefix products. All operations
+ * expand the involved vectors and work on the dense expansion, blocks of
+ * expanded vectors are materialized in parallel by get_dense_block() for
+ * solvers that work on explicit feature matrices.
+ *
+ * If normalization is enabled, every expanded vector is scaled to unit
+ * norm.
  */
 class PolyFeatures : public DotFeatures
 {
@@ -115,6 +125,29 @@ class PolyFeatures : public DotFeatures
 		 */
 		void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val) const override;
 
+		/** compute dot products between a block of vectors and a block of
+		 * vectors of another PolyFeatures object by a matrix-matrix product
+		 * of the expanded blocks
+		 *
+		 * @param vec_idx1 indices of the vectors of this object
+		 * @param df PolyFeatures to compute dot products with
+		 * @param vec_idx2 indices of the vectors of df
+		 * @param result preallocated matrix of size
+		 * vec_idx1.vlen x vec_idx2.vlen
+		 */
+		void dot_block(
+			const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+			const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const override;
+
+		/** expand the vectors start, ..., start+num-1 in parallel
+		 *
+		 * @param start first vector of the block
+		 * @param num number of vectors in the block
+		 * @return matrix of get_dim_feature_space() rows, one column per
+		 * vector
+		 */
+		SGMatrix<float64_t> get_dense_block(int32_t start, int32_t num) const override;
+
 		#ifndef DOXYGEN_SHOULD_SKIP_THIS
 		/** iterator for weighted spectrum features */
 		struct poly_feature_iterator
@@ -167,9 +200,27 @@ class PolyFeatures : public DotFeatures
 
 	protected:
 
+		/** expand a vector of the input space into the monomials
+		 *
+		 * @param vec vector of m_input_dimensions values
+		 * @param output m_output_dimensions values
+		 */
+		void expand(const float64_t* vec, float64_t* output) const;
+
+		/** expand a vector, normalized if normalization is enabled
+		 *
+		 * @param vec_idx index of the vector
+		 * @param output m_output_dimensions values
+		 */
+		void expand(int32_t vec_idx, float64_t* output) const;
+
 		/** store the norm of each training example */
 		void store_normalization_values();
 
+		/** store the number of leading factors every monomial shares with
+		 * its predecessor */
+		void store_shared_prefix();
+
 		/** caller function for the recursive function enumerate_multi_index */
 		void store_multi_index();
 
@@ -226,6 +277,9 @@ class PolyFeatures : public DotFeatures
 		float64_t* m_multinomial_coefficients;
 		/**store norm of each training example */
 		float32_t* m_normalization_values;
+		/** number of leading factors every monomial shares with the
+		 *  previous one in m_multi_index */
+		SGVector<int32_t> m_shared_prefix;
 	private:
 		index_t multi_index_length;
 		index_t multinomial_coefficients_length;
@@ -7,24 +7,73 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
 #include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/eigen3.h>
 
+#include <algorithm>
 #include <utility>
 
 namespace shogun {
 
 enum KernelName;
 
+namespace
+{
+	/** in-place unnormalized fast Walsh-Hadamard transform of a vector of
+	 * length a power of two */
+	void walsh_hadamard_transform(Eigen::VectorXd& x)
+	{
+		const index_t n = x.size();
+		index_t h = 1;
+		// the first butterflies are too short for vector operations
+		for (; h < std::min<index_t>(n, 8); h *= 2)
+		{
+			for (index_t i = 0; i < n; i += 2 * h)
+			{
+				for (index_t j = i; j < i + h; ++j)
+				{
+					const float64_t a = x[j];
+					const float64_t b = x[j + h];
+					x[j] = a + b;
+					x[j + h] = a - b;
+				}
+			}
+		}
+		for (; h < n; h *= 2)
+		{
+			for (index_t i = 0; i < n; i += 2 * h)
+			{
+				auto lo = x.segment(i, h);
+				auto hi = x.segment(i + h, h);
+				lo += hi;
+				hi = lo - 2 * hi;
+			}
+		}
+	}
+} // namespace
+
 RandomFourierDotFeatures::RandomFourierDotFeatures()
 {
-	init(NOT_SPECIFIED, SGVector<float64_t>());
+	init(NOT_SPECIFIED, SGVector<float64_t>(), DENSE_PROJECTION);
 }
 
 RandomFourierDotFeatures::RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features,
 	int32_t D, KernelName kernel_name, SGVector<float64_t> params)
 : RandomKitchenSinksDotFeatures(std::move(features), D)
 {
-	init(kernel_name, params);
+	init(kernel_name, params, DENSE_PROJECTION);
+	random_coeff = generate_random_coefficients();
+}
+
+RandomFourierDotFeatures::RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features,
+	int32_t D, KernelName kernel_name, SGVector<float64_t> params,
+	RandomFeatureStructure structure_type)
+: RandomKitchenSinksDotFeatures(std::move(features), D)
+{
+	init(kernel_name, params, structure_type);
+	if (structure == STRUCTURED_ORTHOGONAL)
+		generate_random_signs();
 	random_coeff = generate_random_coefficients();
 }
 
@@ -33,7 +82,7 @@ RandomFourierDotFeatures::RandomFourierDotFeatures(std::shared_ptr<DotFeatures>
 	SGMatrix<float64_t> coeff)
 : RandomKitchenSinksDotFeatures(std::move(features), D, coeff)
 {
-	init(kernel_name, params);
+	init(kernel_name, params, DENSE_PROJECTION);
 }
 
 RandomFourierDotFeatures::RandomFourierDotFeatures(const std::shared_ptr<File>& loader)
@@ -44,7 +93,8 @@ RandomFourierDotFeatures::RandomFourierDotFeatures(const std::shared_ptr<File>&
 RandomFourierDotFeatures::RandomFourierDotFeatures(const RandomFourierDotFeatures& orig)
 : RandomKitchenSinksDotFeatures(orig)
 {
-	init(orig.kernel, orig.kernel_params);
+	init(orig.kernel, orig.kernel_params, orig.structure);
+	signs = orig.signs;
 }
 
 RandomFourierDotFeatures::~RandomFourierDotFeatures()
@@ -52,10 +102,12 @@ RandomFourierDotFeatures::~RandomFourierDotFeatures()
 }
 
 	void RandomFourierDotFeatures::init(
-	    KernelName kernel_name, const SGVector<float64_t>& params)
+	    KernelName kernel_name, const SGVector<float64_t>& params,
+	    RandomFeatureStructure structure_type)
 	{
 		kernel = kernel_name;
 		kernel_params = params;
+		structure = structure_type;
 
 		constant = num_samples > 0 ? std::sqrt(2.0 / num_samples) : 1;
 		SG_ADD(
@@ -65,6 +117,14 @@ RandomFourierDotFeatures::~RandomFourierDotFeatures()
 		SG_ADD_OPTIONS(
 		    (machine_int_t*)&kernel, "kernel", "The kernel to approximate",
 		    ParameterProperties::NONE, SG_OPTIONS(GAUSSIAN, NOT_SPECIFIED));
+		SG_ADD_OPTIONS(
+		    (machine_int_t*)&structure, "structure",
+		    "Representation of the random projection",
+		    ParameterProperties::NONE,
+		    SG_OPTIONS(DENSE_PROJECTION, STRUCTURED_ORTHOGONAL));
+		SG_ADD(
+		    &signs, "signs",
+		    "Random signs of the structured projection");
 	}
 
 std::shared_ptr<Features> RandomFourierDotFeatures::duplicate() const
@@ -89,6 +149,14 @@ void RandomFourierDotFeatures::generate_random_params(SGVector<float64_t>& vec)
 	switch (kernel)
 	{
 		case GAUSSIAN:
+			// the structured projection is fixed by the signs, only the
+			// offset is drawn per sample
+			if (structure == STRUCTURED_ORTHOGONAL)
+			{
+				vec[0] = uniform_real_dist(m_prng);
+				break;
+			}
+
 			for (index_t i=0; i<vec.vlen-1; i++)
 			{
 				vec[i] = std::sqrt((float64_t)1 / kernel_params[0]) *
@@ -106,7 +174,69 @@ void RandomFourierDotFeatures::generate_random_params(SGVector<float64_t>& vec)
 int32_t RandomFourierDotFeatures::get_num_params() const
 {
 	/* returns number of features + offset */
+	if (structure == STRUCTURED_ORTHOGONAL)
+		return 1;
+
 	return feats->get_dim_feature_space() + 1;
 }
 
+int32_t RandomFourierDotFeatures::get_block_size() const
+{
+	int32_t n = 1;
+	while (n < feats->get_dim_feature_space())
+		n *= 2;
+	return n;
+}
+
+void RandomFourierDotFeatures::generate_random_signs()
+{
+	require(kernel == GAUSSIAN, "Unknown kernel");
+
+	const int32_t n = get_block_size();
+	const int32_t num_blocks = (num_samples + n - 1) / n;
+	UniformIntDistribution<int32_t> uniform_int_dist(0, 1);
+
+	signs = SGMatrix<float64_t>(n, 3 * num_blocks);
+	for (auto i : range(int64_t(signs.num_rows) * signs.num_cols))
+		signs.matrix[i] = 2 * uniform_int_dist(m_prng) - 1;
+}
+
+SGVector<float64_t> RandomFourierDotFeatures::get_random_features(index_t vec_idx) const
+{
+	if (structure != STRUCTURED_ORTHOGONAL)
+		return RandomKitchenSinksDotFeatures::get_random_features(vec_idx);
+
+	const int32_t n = get_block_size();
+	const int32_t num_blocks = signs.num_cols / 3;
+	require(
+		signs.num_rows == n && num_blocks * n >= num_samples,
+		"Random signs ({}x{}) do not match {} samples of dimension {}",
+		signs.num_rows, signs.num_cols, num_samples, n);
+
+	// the rows of sqrt(n)/sigma H D1 H D2 H D3 with normalized H, that
+	// is n^(-3/2) times the unnormalized transforms
+	const float64_t scale = std::sqrt(2.0 / kernel_params[0]) / n;
+
+	auto x = feats->get_computed_dot_feature_vector(vec_idx);
+	SGVector<float64_t> z(num_samples);
+	Eigen::VectorXd buffer(n);
+	for (auto b : range(num_blocks))
+	{
+		buffer.setZero();
+		buffer.head(x.vlen) = Eigen::Map<Eigen::VectorXd>(x.vector, x.vlen);
+		for (auto k : range(3))
+		{
+			buffer.array() *= Eigen::Map<Eigen::ArrayXd>(
+				signs.get_column_vector(3 * b + k), n);
+			walsh_hadamard_transform(buffer);
+		}
+
+		const index_t offset = b * n;
+		const index_t len = std::min(n, num_samples - offset);
+		for (auto j : range(len))
+			z[offset + j] = post_dot(scale * buffer[j], offset + j);
+	}
+	return z;
+}
+
 }
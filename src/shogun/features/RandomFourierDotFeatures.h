@@ -31,6 +31,18 @@ enum KernelName
 	NOT_SPECIFIED
 };
 
+/** representations of the random projection of the random fourier features */
+enum RandomFeatureStructure
+{
+	/** dense gaussian projection, \f$O(Dd)\f$ memory and time per vector */
+	DENSE_PROJECTION,
+
+	/** structured orthogonal random features (SORF), \f$O(D)\f$ memory and
+	 * \f$O(D \log d)\f$ time per vector
+	 */
+	STRUCTURED_ORTHOGONAL
+};
+
 /** @brief This class implements the random fourier features for the DotFeatures
  *  framework.
  *  Basically upon the object creation it computes the random coefficients, namely w and b,
@@ -38,8 +50,17 @@ enum KernelName
  *  based on the following formula z(x) = sqrt(2/D) * cos(w'*x + b), where D is the number
  *  of samples that are used.
  *
+ *  With STRUCTURED_ORTHOGONAL, the dense gaussian projection is replaced by
+ *  blocks of \f$\frac{\sqrt{n}}{\sigma} H D_1 H D_2 H D_3\f$, where
+ *  \f$n\f$ is the input dimension rounded up to a power of two, \f$H\f$
+ *  is the normalized Walsh-Hadamard matrix and \f$D_i\f$ are diagonal
+ *  matrices of random signs. Only the signs and the offsets b are stored and
+ *  each block is applied by fast Walsh-Hadamard transforms.
+ *
  *  For more detailed information you can take a look at this source:
  *  i) Random Features for Large-Scale Kernel Machines - Ali Rahimi and Ben Recht
+ *  ii) Orthogonal Random Features - Felix Yu, Ananda Theertha Suresh,
+ *  Krzysztof Choromanski, Daniel Holtmann-Rice and Sanjiv Kumar
  */
 class RandomFourierDotFeatures : public RandomKitchenSinksDotFeatures
 {
@@ -58,6 +79,19 @@ public:
 	RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features, int32_t D, KernelName kernel_name,
 			SGVector<float64_t> params);
 
+	/** constructor that creates new random coefficients of a structured
+	 * random projection.
+	 *
+	 * @param features the dense features to use as a base
+	 * @param D the number of random fourier samples to draw / dimensionality of new feature space
+	 * @param kernel_name the name of the kernel to approximate
+	 * @param params kernel parameters (see kernel's description in KernelName to see what each kernel expects)
+	 * @param structure representation of the random projection, the random
+	 * coefficients only hold the offsets b for STRUCTURED_ORTHOGONAL
+	 */
+	RandomFourierDotFeatures(std::shared_ptr<DotFeatures> features, int32_t D, KernelName kernel_name,
+			SGVector<float64_t> params, RandomFeatureStructure structure);
+
 	/** constructor that uses the specified random coefficients.
 	 *
 	 * @param features the dense features to use as a base
@@ -86,6 +120,14 @@ public:
 		return "RandomFourierDotFeatures";
 	}
 
+	SGVector<float64_t> get_random_features(index_t vec_idx) const override;
+
+	/** @return representation of the random projection */
+	RandomFeatureStructure get_structure() const
+	{
+		return structure;
+	}
+
 protected:
 
 	float64_t post_dot(float64_t dot_result, index_t par_idx) const override;
@@ -95,7 +137,15 @@ protected:
 	int32_t get_num_params() const override;
 
 private:
-	void init(KernelName kernel_name, const SGVector<float64_t>& params);
+	void init(KernelName kernel_name, const SGVector<float64_t>& params,
+			RandomFeatureStructure structure_type);
+
+	/** @return block size of the structured projection, the input dimension
+	 * rounded up to a power of two */
+	int32_t get_block_size() const;
+
+	/** draw the random signs of the structured projection */
+	void generate_random_signs();
 
 private:
 	/** the kernel to approximate */
@@ -106,6 +156,13 @@ private:
 
 	/** norm const */
 	float64_t constant;
+
+	/** representation of the random projection */
+	RandomFeatureStructure structure;
+
+	/** random signs of \f$D_3, D_2, D_1\f$ of all blocks of the structured
+	 * projection, three columns per block */
+	SGMatrix<float64_t> signs;
 };
 }
 
@@ -14,7 +14,8 @@
 namespace shogun
 {
 
-static std::shared_ptr<RandomFourierDotFeatures> createRandomData(const benchmark::State& state)
+static std::shared_ptr<RandomFourierDotFeatures> createRandomData(
+    const benchmark::State& state, RandomFeatureStructure structure)
 {
 	std::random_device rd;
 	std::mt19937_64 prng(rd());
@@ -34,15 +35,16 @@ static std::shared_ptr<RandomFourierDotFeatures> createRandomData(const benchmar
 	auto dense_feats = std::make_shared<DenseFeatures<float64_t>>(mat);
 	SGVector<float64_t> params(1);
 	params[0] = num_dim - 20;
-	return std::make_shared<RandomFourierDotFeatures>(dense_feats, state.range(1), KernelName::GAUSSIAN, params);
+	return std::make_shared<RandomFourierDotFeatures>(dense_feats, state.range(1), KernelName::GAUSSIAN, params, structure);
 }
 
+template <RandomFeatureStructure structure>
 class RFFixture : public benchmark::Fixture
 {
 public:
 	void SetUp(const ::benchmark::State& st)
 	{
-		f = createRandomData(st);
+		f = createRandomData(st, structure);
 		w = SGVector<float64_t>(f->get_dim_feature_space());
 		w.range_fill(17.0);
 	}
@@ -56,7 +58,12 @@ public:
 #define ADD_RANDOMFOURIER_ARGS(WHAT)	\
 	WHAT->RangeMultiplier(2)->Ranges({{128, 512}, {64, 512}})->Unit(benchmark::kMillisecond);
 
-ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(RFFixture, RandomFourierDotFeatures_DenseDot))
-ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(RFFixture, RandomFourierDotFeatures_AddDense))
+typedef RFFixture<DENSE_PROJECTION> RFDenseFixture;
+typedef RFFixture<STRUCTURED_ORTHOGONAL> RFStructuredFixture;
+
+ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(RFDenseFixture, RandomFourierDotFeatures_DenseDot))
+ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(RFDenseFixture, RandomFourierDotFeatures_AddDense))
+ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_DENSEDOT(RFStructuredFixture, RandomFourierDotFeatures_Structured_DenseDot))
+ADD_RANDOMFOURIER_ARGS(DOTFEATURES_BENCHMARK_ADDDENSE(RFStructuredFixture, RandomFourierDotFeatures_Structured_AddDense))
 
 }
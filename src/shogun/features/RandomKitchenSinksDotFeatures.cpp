@@ -89,16 +89,12 @@ float64_t RandomKitchenSinksDotFeatures::dot(int32_t vec_idx1, std::shared_ptr<D
 	auto other = std::static_pointer_cast<RandomKitchenSinksDotFeatures>(df);
 	ASSERT(get_dim_feature_space()==other->get_dim_feature_space());
 
+	auto z1 = get_random_features(vec_idx1);
+	auto z2 = other->get_random_features(vec_idx2);
+
 	float64_t dot_product = 0;
 	for (index_t i=0; i<num_samples; i++)
-	{
-		float64_t tmp_dot_1 = dot(vec_idx1, i);
-		float64_t tmp_dot_2 = other->dot(vec_idx2, i);
-
-		tmp_dot_1 = post_dot(tmp_dot_1, i);
-		tmp_dot_2 = other->post_dot(tmp_dot_2, i);
-		dot_product += tmp_dot_1 * tmp_dot_2;
-	}
+		dot_product += z1[i] * z2[i];
 	return dot_product;
 }
 
@@ -108,13 +104,11 @@ float64_t RandomKitchenSinksDotFeatures::dot(
 	SG_TRACE("entering dense_dot()");
 	ASSERT(vec2.size() == get_dim_feature_space());
 
+	auto z = get_random_features(vec_idx1);
+
 	float64_t dot_product = 0;
 	for (index_t i=0; i<num_samples; i++)
-	{
-		float64_t tmp_dot = dot(vec_idx1, i);
-		tmp_dot = post_dot(tmp_dot, i);
-		dot_product += tmp_dot * vec2[i];
-	}
+		dot_product += z[i] * vec2[i];
 	SG_TRACE("Leaving dense_dot()");
 	return dot_product;
 }
@@ -125,14 +119,14 @@ void RandomKitchenSinksDotFeatures::add_to_dense_vec(float64_t alpha,
 	SG_TRACE("Entering add_to_dense()");
 	ASSERT(vec2_len == get_dim_feature_space());
 
+	auto z = get_random_features(vec_idx1);
+
 	for (index_t i=0; i<num_samples; i++)
 	{
-		float64_t tmp_dot = dot(vec_idx1, i);
-		tmp_dot = post_dot(tmp_dot, i);
 		if (abs_val)
-			vec2[i] += Math::abs(alpha * tmp_dot);
+			vec2[i] += Math::abs(alpha * z[i]);
 		else
-			vec2[i] += alpha * tmp_dot;
+			vec2[i] += alpha * z[i];
 	}
 	SG_TRACE("Leaving add_to_dense()");
 }
@@ -191,6 +185,14 @@ SGMatrix<float64_t> RandomKitchenSinksDotFeatures::get_random_coefficients()
 	return random_coeff;
 }
 
+SGVector<float64_t> RandomKitchenSinksDotFeatures::get_random_features(index_t vec_idx) const
+{
+	SGVector<float64_t> z(num_samples);
+	for (index_t i=0; i<num_samples; i++)
+		z[i] = post_dot(dot(vec_idx, i), i);
+	return z;
+}
+
 float64_t RandomKitchenSinksDotFeatures::dot(index_t vec_idx, index_t par_idx) const
 {
 	auto vec2 = random_coeff.get_column(par_idx).slice(0, feats->get_dim_feature_space());
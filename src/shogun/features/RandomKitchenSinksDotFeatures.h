@@ -202,6 +202,14 @@ public:
 	/** @return object name */
 	const char* get_name() const override;
 
+	/** compute all random features
+	 * \f$z_i = [\phi(x_i; w_1),\dots,\phi(x_i; w_K)]^{\top}\f$ of a vector
+	 *
+	 * @param vec_idx the feature vector index
+	 * @return the K random features of the vector
+	 */
+	virtual SGVector<float64_t> get_random_features(index_t vec_idx) const;
+
 protected:
 	/** Method used before computing the dot product between
 	 * a feature vector and a parameter vector
@@ -4,13 +4,65 @@
  * Authors: Soeren Sonnenburg, Vladislav Horbatiuk, Evgeniy Andreev
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/SNPFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/features/Alphabet.h>
+#include <shogun/lib/Hash.h>
 #include <shogun/lib/memory.h>
 
+#include <algorithm>
+#include <utility>
+
 using namespace shogun;
 
+namespace
+{
+	constexpr int32_t kBitsPerWord = 64;
+
+	/** planes of the genotypes of a vector, see SNPFeatures */
+	enum EGenotypePlane
+	{
+		HOM_MINOR = 0,
+		HOM_MAJOR = 1,
+		HETEROZYGOUS = 2
+	};
+
+	int32_t popcount(uint64_t word)
+	{
+		return __builtin_popcountll(word);
+	}
+
+	/** twice the number of shared alleles and the number of loci
+	 * genotyped in both vectors
+	 */
+	std::pair<int64_t, int64_t> ibs_counts(
+	    const uint64_t* a, const uint64_t* b, int32_t num_words)
+	{
+		const uint64_t* a_min = a + HOM_MINOR * num_words;
+		const uint64_t* a_maj = a + HOM_MAJOR * num_words;
+		const uint64_t* a_het = a + HETEROZYGOUS * num_words;
+		const uint64_t* b_min = b + HOM_MINOR * num_words;
+		const uint64_t* b_maj = b + HOM_MAJOR * num_words;
+		const uint64_t* b_het = b + HETEROZYGOUS * num_words;
+
+		int64_t shared = 0;
+		int64_t typed = 0;
+		for (int32_t w = 0; w < num_words; w++)
+		{
+			const uint64_t a_hom = a_min[w] | a_maj[w];
+			const uint64_t b_hom = b_min[w] | b_maj[w];
+			const uint64_t ibs2 = (a_min[w] & b_min[w]) |
+			                      (a_maj[w] & b_maj[w]) | (a_het[w] & b_het[w]);
+			const uint64_t ibs1 = (a_het[w] & b_hom) | (a_hom & b_het[w]);
+
+			shared += 2 * popcount(ibs2) + popcount(ibs1);
+			typed += popcount((a_hom | a_het[w]) & (b_hom | b_het[w]));
+		}
+		return {shared, typed};
+	}
+} // namespace
+
 SNPFeatures::SNPFeatures()
 {
 	unstable(SOURCE_LOCATION);
@@ -25,10 +77,13 @@ SNPFeatures::SNPFeatures()
 
 	m_str_min = NULL;
 	m_str_maj = NULL;
+
+	m_num_words = 0;
+	m_bases_hash = 0;
 }
 
 SNPFeatures::SNPFeatures(const std::shared_ptr<StringFeatures<uint8_t>>& str) : DotFeatures(),
-	m_str_min(NULL), m_str_maj(NULL)
+	m_str_min(NULL), m_str_maj(NULL), m_num_words(0), m_bases_hash(0)
 {
 	ASSERT(str)
 	ASSERT(str->have_same_length())
@@ -50,7 +105,7 @@ SNPFeatures::SNPFeatures(const std::shared_ptr<StringFeatures<uint8_t>>& str) :
 SNPFeatures::SNPFeatures(const SNPFeatures& orig)
 	: DotFeatures(orig), strings(orig.strings),
 	normalization_const(orig.normalization_const),
-	m_str_min(NULL), m_str_maj(NULL)
+	m_str_min(NULL), m_str_maj(NULL), m_num_words(0), m_bases_hash(0)
 {
 
 
@@ -58,7 +113,7 @@ SNPFeatures::SNPFeatures(const SNPFeatures& orig)
 	{
 		string_length=strings->get_max_vector_length();
 		ASSERT((string_length & 1) == 0) // length divisible by 2
-			w_dim=3*string_length;
+		w_dim=3*string_length/2;
 		num_strings=strings->get_num_vectors();
 	}
 	else
@@ -73,7 +128,8 @@ SNPFeatures::SNPFeatures(const SNPFeatures& orig)
 
 SNPFeatures::~SNPFeatures()
 {
-
+	SG_FREE(m_str_min);
+	SG_FREE(m_str_maj);
 }
 
 int32_t SNPFeatures::get_dim_feature_space() const
@@ -108,12 +164,18 @@ float64_t SNPFeatures::get_normalization_const()
 
 void SNPFeatures::set_minor_base_string(const char* str)
 {
+	SG_FREE(m_str_min);
 	m_str_min=(uint8_t*) get_strdup(str);
+	if (m_str_maj)
+		compute_bit_planes();
 }
 
 void SNPFeatures::set_major_base_string(const char* str)
 {
+	SG_FREE(m_str_maj);
 	m_str_maj=(uint8_t*) get_strdup(str);
+	if (m_str_min)
+		compute_bit_planes();
 }
 
 char* SNPFeatures::get_minor_base_string()
@@ -133,11 +195,40 @@ float64_t SNPFeatures::dot(int32_t idx_a, std::shared_ptr<DotFeatures> df, int32
 	ASSERT(df->get_feature_class() == get_feature_class())
 	auto sf=std::static_pointer_cast<SNPFeatures>(df);
 
+	if (!has_same_bit_planes(*sf))
+		return dot_strings(idx_a, *sf, idx_b);
+
+	// the number of loci with the same genotype, heterozygous and missing
+	// genotypes are the same feature
+	const uint64_t* a=get_bit_planes(idx_a);
+	const uint64_t* b=sf->get_bit_planes(idx_b);
+	const int32_t num_loci=string_length/2;
+
+	int64_t total=0;
+	for (int32_t w=0; w<m_num_words; w++)
+	{
+		const uint64_t a_min=a[HOM_MINOR*m_num_words+w];
+		const uint64_t a_maj=a[HOM_MAJOR*m_num_words+w];
+		const uint64_t b_min=b[HOM_MINOR*m_num_words+w];
+		const uint64_t b_maj=b[HOM_MAJOR*m_num_words+w];
+
+		const int32_t num_bits=std::min(kBitsPerWord, num_loci-w*kBitsPerWord);
+		const uint64_t loci=num_bits==kBitsPerWord ? ~uint64_t(0) : (uint64_t(1)<<num_bits)-1;
+
+		total+=popcount(a_min & b_min)+popcount(a_maj & b_maj)+
+			popcount(~(a_min | a_maj | b_min | b_maj) & loci);
+	}
+
+	return total;
+}
+
+float64_t SNPFeatures::dot_strings(int32_t idx_a, const SNPFeatures& sf, int32_t idx_b) const
+{
 	int32_t alen, blen;
 	bool free_avec, free_bvec;
 
 	uint8_t* avec = strings->get_feature_vector(idx_a, alen, free_avec);
-	uint8_t* bvec = sf->strings->get_feature_vector(idx_b, blen, free_bvec);
+	uint8_t* bvec = sf.strings->get_feature_vector(idx_b, blen, free_bvec);
 
 	ASSERT(alen==blen)
 	if (alen!=string_length)
@@ -180,7 +271,7 @@ float64_t SNPFeatures::dot(int32_t idx_a, std::shared_ptr<DotFeatures> df, int32
 	}
 
 	strings->free_feature_vector(avec, idx_a, free_avec);
-	sf->strings->free_feature_vector(bvec, idx_b, free_bvec);
+	sf.strings->free_feature_vector(bvec, idx_b, free_bvec);
 	return total;
 }
 
@@ -191,36 +282,23 @@ SNPFeatures::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 	    vec2.size() == w_dim, "Dimensions don't match, vec2_dim={}, w_dim={}",
 	    vec2.size(), w_dim);
 
+	const uint64_t* planes=get_bit_planes(vec_idx1);
+	const int32_t num_loci=string_length/2;
 	float64_t sum=0;
-	int32_t len;
-	bool free_vec1;
-	uint8_t* vec = strings->get_feature_vector(vec_idx1, len, free_vec1);
-	int32_t offs=0;
 
-	for (int32_t i=0; i<len; i+=2)
+	for (int32_t w=0; w<m_num_words; w++)
 	{
-		int32_t dim=0;
-
-		char a1=vec[i];
-		char a2=vec[i+1];
+		const uint64_t minor=planes[HOM_MINOR*m_num_words+w];
+		const uint64_t major=planes[HOM_MAJOR*m_num_words+w];
+		const float64_t* weights=vec2.vector+int64_t(3)*kBitsPerWord*w;
+		const int32_t num_bits=std::min(kBitsPerWord, num_loci-w*kBitsPerWord);
 
-		if (a1==a2 && a1!='0' && a2!='0')
+		for (int32_t j=0; j<num_bits; j++)
 		{
-			if (a1==m_str_min[i])
-				dim=1;
-			else if (a1==m_str_maj[i])
-				dim=2;
-			else
-			{
-				error("The impossible happened i={} a1={} a2={} min={} maj={}",
-						i, a1,a2, m_str_min[i], m_str_maj[i]);
-			}
+			const int32_t dim=((minor>>j) & 1) | (((major>>j) & 1)<<1);
+			sum+=weights[3*j+dim];
 		}
-
-		sum+=vec2[offs+dim];
-		offs+=3;
 	}
-	strings->free_feature_vector(vec, vec_idx1, free_vec1);
 
 	return sum/normalization_const;
 }
@@ -230,38 +308,25 @@ void SNPFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t*
 	if (vec2_len != w_dim)
 		error("Dimensions don't match, vec2_dim={}, w_dim={}", vec2_len, w_dim);
 
-	int32_t len;
-	bool free_vec1;
-	uint8_t* vec = strings->get_feature_vector(vec_idx1, len, free_vec1);
-	int32_t offs=0;
-
 	if (abs_val)
 		alpha=Math::abs(alpha);
 
-	for (int32_t i=0; i<len; i+=2)
-	{
-		int32_t dim=0;
+	const uint64_t* planes=get_bit_planes(vec_idx1);
+	const int32_t num_loci=string_length/2;
 
-		char a1=vec[i];
-		char a2=vec[i+1];
+	for (int32_t w=0; w<m_num_words; w++)
+	{
+		const uint64_t minor=planes[HOM_MINOR*m_num_words+w];
+		const uint64_t major=planes[HOM_MAJOR*m_num_words+w];
+		float64_t* weights=vec2+int64_t(3)*kBitsPerWord*w;
+		const int32_t num_bits=std::min(kBitsPerWord, num_loci-w*kBitsPerWord);
 
-		if (a1==a2 && a1!='0' && a2!='0')
+		for (int32_t j=0; j<num_bits; j++)
 		{
-			if (a1==m_str_min[i])
-				dim=1;
-			else if (a1==m_str_maj[i])
-				dim=2;
-			else
-			{
-				error("The impossible happened i={} a1={} a2={} min={} maj={}",
-						i, a1,a2, m_str_min[i], m_str_maj[i]);
-			}
+			const int32_t dim=((minor>>j) & 1) | (((major>>j) & 1)<<1);
+			weights[3*j+dim]+=alpha;
 		}
-
-		vec2[offs+dim]+=alpha;
-		offs+=3;
 	}
-	strings->free_feature_vector(vec, vec_idx1, free_vec1);
 }
 
 void SNPFeatures::find_minor_major_strings(uint8_t* minor, uint8_t* major)
@@ -314,6 +379,126 @@ void SNPFeatures::obtain_base_strings(const std::shared_ptr<SNPFeatures>& snp)
 		if (m_str_min[j]>m_str_maj[j])
 			Math::swap(m_str_min[j], m_str_maj[j]);
 	}
+
+	compute_bit_planes();
+}
+
+void SNPFeatures::compute_bit_planes()
+{
+	const int32_t num_loci=string_length/2;
+	m_num_words=(num_loci+kBitsPerWord-1)/kBitsPerWord;
+	m_bit_planes.assign(int64_t(num_strings)*3*m_num_words, 0);
+	m_bases_hash=(uint64_t(Hash::MurmurHash3(m_str_min, string_length, 0))<<32) |
+		Hash::MurmurHash3(m_str_maj, string_length, 0);
+
+	// the first genotype that is neither missing nor heterozygous nor
+	// homozygous in one of the base alleles, errors are raised outside of
+	// the parallel region
+	int32_t invalid_vec=-1;
+	int32_t invalid_pos=-1;
+
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint8_t* vec=strings->get_feature_vector(i, len, free_vec);
+
+		uint64_t* planes=m_bit_planes.data()+int64_t(i)*3*m_num_words;
+		for (int32_t j=0; j<len; j+=2)
+		{
+			const uint8_t a1=vec[j];
+			const uint8_t a2=vec[j+1];
+			const int32_t locus=j/2;
+			const uint64_t bit=uint64_t(1)<<(locus % kBitsPerWord);
+
+			int32_t plane;
+			if (a1=='0' || a2=='0')
+				continue;
+			else if (a1!=a2)
+				plane=HETEROZYGOUS;
+			else if (a1==m_str_min[j])
+				plane=HOM_MINOR;
+			else if (a1==m_str_maj[j])
+				plane=HOM_MAJOR;
+			else
+			{
+				#pragma omp critical
+				{
+					if (invalid_vec<0 || i<invalid_vec)
+					{
+						invalid_vec=i;
+						invalid_pos=j;
+					}
+				}
+				break;
+			}
+
+			planes[plane*m_num_words+locus/kBitsPerWord]|=bit;
+		}
+
+		strings->free_feature_vector(vec, i, free_vec);
+	}
+
+	if (invalid_vec>=0)
+	{
+		int32_t len;
+		bool free_vec;
+		uint8_t* vec=strings->get_feature_vector(invalid_vec, len, free_vec);
+		const uint8_t a1=vec[invalid_pos];
+		const uint8_t a2=vec[invalid_pos+1];
+		strings->free_feature_vector(vec, invalid_vec, free_vec);
+
+		error("The impossible happened i={} a1={} a2={} min={} maj={}",
+				invalid_pos, a1, a2, m_str_min[invalid_pos], m_str_maj[invalid_pos]);
+	}
+}
+
+bool SNPFeatures::has_same_bit_planes(const SNPFeatures& other) const
+{
+	return other.string_length==string_length &&
+		other.m_bases_hash==m_bases_hash;
+}
+
+float64_t SNPFeatures::ibs(int32_t idx_a, const std::shared_ptr<SNPFeatures>& other, int32_t idx_b) const
+{
+	require(other, "No features provided");
+	require(has_same_bit_planes(*other),
+			"Features have different base strings, see obtain_base_strings()");
+	require(idx_a>=0 && idx_a<num_strings, "Index {} out of range [0, {})",
+			idx_a, num_strings);
+	require(idx_b>=0 && idx_b<other->num_strings,
+			"Index {} out of range [0, {})", idx_b, other->num_strings);
+
+	const auto counts=ibs_counts(get_bit_planes(idx_a),
+			other->get_bit_planes(idx_b), m_num_words);
+	return counts.second ? counts.first/(2.0*counts.second) : 0.0;
+}
+
+SGMatrix<float64_t> SNPFeatures::get_ibs_matrix(const std::shared_ptr<SNPFeatures>& other) const
+{
+	require(other, "No features provided");
+	require(has_same_bit_planes(*other),
+			"Features have different base strings, see obtain_base_strings()");
+
+	const int32_t num_other=other->num_strings;
+	const bool symmetric=other.get()==this;
+	SGMatrix<float64_t> result(num_strings, num_other);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num_strings; i++)
+	{
+		const uint64_t* a=get_bit_planes(i);
+		for (int32_t j=symmetric ? i : 0; j<num_other; j++)
+		{
+			const auto counts=ibs_counts(a, other->get_bit_planes(j), m_num_words);
+			result(i, j)=counts.second ? counts.first/(2.0*counts.second) : 0.0;
+			if (symmetric)
+				result(j, i)=result(i, j);
+		}
+	}
+
+	return result;
 }
 
 void SNPFeatures::set_normalization_const(float64_t n)
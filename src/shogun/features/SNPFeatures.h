@@ -14,6 +14,8 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/features/StringFeatures.h>
 
+#include <vector>
+
 namespace shogun
 {
 template <class ST> class StringFeatures;
@@ -21,6 +23,13 @@ template <class ST> class StringFeatures;
 /** @brief Features that compute the Weighted Degreee Kernel feature space
  * explicitly.
  *
+ * Every genotype (pair of characters) is encoded once in three bit planes
+ * of 64 bit words, marking the loci that are homozygous in the minor
+ * allele, homozygous in the major allele and heterozygous. Missing
+ * genotypes ('0') are in none of them. Dot products between vectors and
+ * the identity by state similarity are computed a word at a time with
+ * popcount.
+ *
  * \sa CWeightedDegreeStringKernel
  */
 class SNPFeatures : public DotFeatures
@@ -189,6 +198,25 @@ class SNPFeatures : public DotFeatures
 		 */
 		static SGMatrix<float64_t> get_2x3_table(const std::shared_ptr<SNPFeatures>& pos, const std::shared_ptr<SNPFeatures>& neg);
 
+		/** compute the identity by state similarity of two vectors, i.e.
+		 * the number of alleles shared per locus (0, 1 or 2) averaged over
+		 * the loci genotyped in both vectors and divided by 2
+		 *
+		 * @param idx_a index of the vector of this
+		 * @param other features with the same base strings
+		 * @param idx_b index of the vector of other
+		 * @return similarity in [0, 1], 0 if no locus is genotyped in both
+		 */
+		float64_t ibs(int32_t idx_a, const std::shared_ptr<SNPFeatures>& other, int32_t idx_b) const;
+
+		/** compute the identity by state similarities between all vectors
+		 * of this and all vectors of other, in parallel
+		 *
+		 * @param other features with the same base strings
+		 * @return matrix of ibs(i, other, j) with a row per vector of this
+		 */
+		SGMatrix<float64_t> get_ibs_matrix(const std::shared_ptr<SNPFeatures>& other) const;
+
 	private:
 		/** determine minor and major base strings from current strings
 		 * @arg minor - array of string_length inited with zero that will
@@ -198,6 +226,25 @@ class SNPFeatures : public DotFeatures
 		 */
 		void find_minor_major_strings(uint8_t* minor, uint8_t* major);
 
+		/** encode the genotypes of all vectors in bit planes with the
+		 * current base strings
+		 */
+		void compute_bit_planes();
+
+		/** @return bit planes of a vector */
+		const uint64_t* get_bit_planes(int32_t num) const
+		{
+			return m_bit_planes.data() + int64_t(num) * 3 * m_num_words;
+		}
+
+		/** @return whether other encodes its genotypes in the same way */
+		bool has_same_bit_planes(const SNPFeatures& other) const;
+
+		/** compute the dot product on the genotype strings, for features
+		 * with different base strings
+		 */
+		float64_t dot_strings(int32_t idx_a, const SNPFeatures& sf, int32_t idx_b) const;
+
 	protected:
 		/** stringfeatures the wdfeatures are based on*/
 		std::shared_ptr<StringFeatures<uint8_t>> strings;
@@ -216,6 +263,14 @@ class SNPFeatures : public DotFeatures
 		uint8_t* m_str_min;
 		/** allele B */
 		uint8_t* m_str_maj;
+
+		/** number of 64 bit words of a bit plane */
+		int32_t m_num_words;
+		/** bit planes of all vectors, the homozygous minor, homozygous major
+		 * and heterozygous planes of a vector are stored consecutively */
+		std::vector<uint64_t> m_bit_planes;
+		/** hash of the base strings the bit planes were computed with */
+		uint64_t m_bases_hash;
 };
 }
 #endif // _SNPFEATURES_H___
@@ -5,7 +5,9 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/io/SGIO.h>
 
+#include <algorithm>
 #include <string.h>
+#include <vector>
 #include <stdlib.h>
 
 namespace shogun
@@ -451,6 +453,72 @@ template<> float64_t SparseFeatures<complex128_t>::dot(int32_t vec_idx1,
 	return 0.0;
 }
 
+template <class ST>
+void SparseFeatures<ST>::dot_block(
+	const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+	const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const
+{
+	auto sf = std::dynamic_pointer_cast<SparseFeatures<ST>>(df);
+	if (!sf)
+	{
+		DotFeatures::dot_block(vec_idx1, df, vec_idx2, result);
+		return;
+	}
+
+	require(
+		result.num_rows == vec_idx1.vlen && result.num_cols == vec_idx2.vlen,
+		"Result matrix ({}x{}) does not match the block size ({}x{})!",
+		result.num_rows, result.num_cols, vec_idx1.vlen, vec_idx2.vlen);
+
+	struct BlockEntry
+	{
+		index_t feat_index;
+		index_t column;
+		float64_t entry;
+	};
+
+	// invert the second block: all its non-zeros ordered by feature
+	std::vector<BlockEntry> entries;
+	for (index_t j = 0; j < vec_idx2.vlen; ++j)
+	{
+		auto bvec = sf->get_sparse_feature_vector(vec_idx2[j]);
+		for (index_t k = 0; k < bvec.num_feat_entries; ++k)
+		{
+			entries.push_back({bvec.features[k].feat_index, j,
+			                   (float64_t)bvec.features[k].entry});
+		}
+		sf->free_sparse_feature_vector(vec_idx2[j]);
+	}
+	auto by_feature = [](const BlockEntry& a, const BlockEntry& b) {
+		return a.feat_index < b.feat_index;
+	};
+	std::stable_sort(entries.begin(), entries.end(), by_feature);
+
+	result.zero();
+	for (index_t i = 0; i < vec_idx1.vlen; ++i)
+	{
+		auto avec = get_sparse_feature_vector(vec_idx1[i]);
+		for (index_t k = 0; k < avec.num_feat_entries; ++k)
+		{
+			const BlockEntry key = {avec.features[k].feat_index, 0, 0.0};
+			const float64_t a = avec.features[k].entry;
+			auto range = std::equal_range(
+				entries.begin(), entries.end(), key, by_feature);
+			for (auto it = range.first; it != range.second; ++it)
+				result(i, it->column) += a * it->entry;
+		}
+		free_sparse_feature_vector(vec_idx1[i]);
+	}
+}
+
+template <>
+void SparseFeatures<complex128_t>::dot_block(
+	const SGVector<index_t>& vec_idx1, const std::shared_ptr<DotFeatures>& df,
+	const SGVector<index_t>& vec_idx2, SGMatrix<float64_t>& result) const
+{
+	not_implemented(SOURCE_LOCATION);;
+}
+
 template <class ST>
 float64_t
 SparseFeatures<ST>::dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const
@@ -493,6 +561,81 @@ float64_t SparseFeatures<complex128_t>::dot(
 	return 0.0;
 }
 
+template <class ST>
+void SparseFeatures<ST>::dense_dot_range(
+	float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	float64_t* vec, int32_t dim, float64_t b) const
+{
+	if constexpr (!std::is_same<ST, complex128_t>::value)
+	{
+		if (sparse_feature_matrix.sparse_matrix)
+		{
+			ASSERT(output)
+			ASSERT(start>=0 && start<stop && stop<=get_num_vectors())
+			require(dim>=get_num_features(),
+				"Dimension of the vector ({}) is smaller than the number of "
+				"features ({})!", dim, get_num_features());
+
+			const SGSparseVector<ST>* vectors=sparse_feature_matrix.sparse_matrix;
+#pragma omp parallel for schedule(dynamic, 256)
+			for (int32_t i=start; i<stop; i++)
+			{
+				const SGSparseVector<ST>& sv=
+					vectors[m_subset_stack->subset_idx_conversion(i)];
+				const SGSparseVectorEntry<ST>* entries=sv.features;
+				float64_t result=0;
+				for (int32_t j=0; j<sv.num_feat_entries; j++)
+					result+=vec[entries[j].feat_index]*entries[j].entry;
+
+				output[i-start]=(alphas ? alphas[i-start]*result : result)+b;
+			}
+			return;
+		}
+	}
+
+	DotFeatures::dense_dot_range(output, start, stop, alphas, vec, dim, b);
+}
+
+template <class ST>
+DotFeatures::SparseBlock SparseFeatures<ST>::get_sparse_block(int32_t start, int32_t num) const
+{
+	if constexpr (std::is_same<ST, complex128_t>::value)
+	{
+		not_implemented(SOURCE_LOCATION);
+		return SparseBlock();
+	}
+	else
+	{
+		require(start>=0 && num>=0 && start+num<=get_num_vectors(),
+			"Block of {} vectors from {} exceeds the {} vectors!",
+			num, start, get_num_vectors());
+
+		SparseBlock block;
+		block.num_features=get_num_features();
+		block.row_offsets=SGVector<index_t>(num+1);
+		block.row_offsets[0]=0;
+		std::vector<index_t> indices;
+		std::vector<float64_t> values;
+		for (int32_t i=0; i<num; i++)
+		{
+			SGSparseVector<ST> sv=get_sparse_feature_vector(start+i);
+			for (int32_t j=0; j<sv.num_feat_entries; j++)
+			{
+				indices.push_back(sv.features[j].feat_index);
+				values.push_back(sv.features[j].entry);
+			}
+			block.row_offsets[i+1]=indices.size();
+			free_sparse_feature_vector(start+i);
+		}
+
+		block.feature_indices=SGVector<index_t>(indices.size());
+		block.values=SGVector<float64_t>(values.size());
+		std::copy(indices.begin(), indices.end(), block.feature_indices.vector);
+		std::copy(values.begin(), values.end(), block.values.vector);
+		return block;
+	}
+}
+
 template<class ST> void* SparseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
 	if (vector_index>=get_num_vectors())
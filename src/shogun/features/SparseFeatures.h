@@ -383,6 +383,26 @@ template <class ST> class SparseFeatures : public DotFeatures
 		 */
 		float64_t dot(int32_t vec_idx1, std::shared_ptr<DotFeatures> df, int32_t vec_idx2) const override;
 
+		/** compute dot products between two blocks of vectors
+		 *
+		 * possible with subset
+		 *
+		 * The non-zero entries of the vectors of df are indexed by feature
+		 * once, so every entry of the vectors of this object is matched
+		 * against all vectors of the block at once.
+		 *
+		 * @param vec_idx1 indices of the vectors of this object
+		 * @param df DotFeatures (of same kind) to compute dot products with
+		 * @param vec_idx2 indices of the vectors of df
+		 * @param result preallocated matrix of size
+		 * vec_idx1.vlen x vec_idx2.vlen
+		 */
+		void dot_block(
+			const SGVector<index_t>& vec_idx1,
+			const std::shared_ptr<DotFeatures>& df,
+			const SGVector<index_t>& vec_idx2,
+			SGMatrix<float64_t>& result) const override;
+
 		/** compute dot product between vector1 and a dense vector
 		 *
 		 * possible with subset
@@ -393,6 +413,38 @@ template <class ST> class SparseFeatures : public DotFeatures
 		float64_t
 		dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const override;
 
+		/** compute the dot products of a range of vectors with a dense
+		 * vector
+		 *
+		 * possible with subset
+		 *
+		 * For a sparse matrix held in memory the entries are read in place
+		 * and the vectors are processed in parallel.
+		 *
+		 * @param output result for the given vector range
+		 * @param start first index of vector range
+		 * @param stop last vector range index (excluded)
+		 * @param alphas scalars to multiply the dot products with, may be
+		 * NULL
+		 * @param vec dense vector
+		 * @param dim length of the dense vector
+		 * @param b bias added to the results
+		 */
+		void dense_dot_range(
+			float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+			float64_t* vec, int32_t dim, float64_t b) const override;
+
+		/** get the vectors start, ..., start+num-1 in compressed sparse
+		 * row form, built from the sparse vectors
+		 *
+		 * possible with subset
+		 *
+		 * @param start first vector of the block
+		 * @param num number of vectors in the block
+		 * @return block with one row per vector
+		 */
+		SparseBlock get_sparse_block(int32_t start, int32_t num) const override;
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 		/** iterator for sparse features */
 		struct sparse_feature_iterator
@@ -1,5 +1,6 @@
 #include <shogun/base/progress.h>
 #include <shogun/base/ShogunEnv.h>
+#include <shogun/features/PackedStringFeatures.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/MemoryMappedFile.h>
 #include <shogun/io/fs/FileSystem.h>
@@ -1153,6 +1154,84 @@ template<class ST> bool StringFeatures<ST>::obtain_from_char(std::shared_ptr<Str
 	return obtain_from_char_features(sf, start, p_order, gap, rev);
 }
 
+template<class ST> bool StringFeatures<ST>::obtain_from_packed(std::shared_ptr<PackedStringFeatures> pf,
+		int32_t start, int32_t p_order, bool rev)
+{
+	remove_all_subsets();
+	require(pf, "No packed strings given");
+	require(p_order>0, "Order ({}) must be positive", p_order);
+	require(start>=0, "Start ({}) must not be negative", start);
+
+	auto alpha=pf->get_alphabet();
+	this->order=p_order;
+	cleanup();
+
+	const int32_t num_vectors=pf->get_num_vectors();
+	ASSERT(num_vectors>0)
+
+	original_num_symbols=alpha->get_num_symbols();
+	const int32_t max_val=alpha->get_num_bits();
+
+	if (p_order>1)
+		num_symbols=Math::powl((floatmax_t) 2, (floatmax_t) max_val*p_order);
+	else
+		num_symbols=original_num_symbols;
+	io::info("max_val (bit): {} order: {} -> results in num_symbols: {:.0f}", max_val, p_order, num_symbols);
+
+	if ( ((floatmax_t) num_symbols) > Math::powl(((floatmax_t) 2),((floatmax_t) sizeof(ST)*8)) )
+	{
+		error("symbol does not fit into datatype \"{}\" ({})", (char) max_val, (int) max_val);
+		return false;
+	}
+
+	features.reserve(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		features.emplace_back(std::max(pf->get_vector_length(i)-start, 0));
+
+	// the k-mer ending at a position is shifted in from the one before,
+	// without reverse the last symbol is in the lowest bits, with reverse
+	// in the highest, positions before the string count as symbol 0
+	const int32_t bits=pf->get_bits_per_symbol();
+	const int32_t per_word=64/bits;
+	const uint64_t symbol_mask=(uint64_t(1)<<bits)-1;
+	const uint64_t kmer_mask=max_val*p_order>=64 ? ~uint64_t(0) :
+		(uint64_t(1)<<(max_val*p_order))-1;
+	const int32_t high=max_val*(p_order-1);
+	const uint64_t* data=pf->m_data.vector;
+
+	#pragma omp parallel for num_threads(env()->get_num_threads()) schedule(dynamic, 16)
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		const int32_t real_num=pf->real_index(i);
+		int64_t pos=pf->m_offset[real_num];
+		const int32_t len=pf->m_offset[real_num+1]-pos;
+		ST* fv=features[i].vector;
+
+		uint64_t word=0;
+		uint64_t value=0;
+		for (int32_t j=0; j<len; j++, pos++)
+		{
+			if (j==0 || pos%per_word==0)
+				word=data[pos/per_word]>>((pos%per_word)*bits);
+
+			const uint64_t symbol=word & symbol_mask;
+			word>>=bits;
+
+			if (rev)
+				value=(value>>max_val) | (symbol<<high);
+			else
+				value=((value<<max_val) | symbol) & kmer_mask;
+
+			if (j>=start)
+				fv[j-start]=(ST) value;
+		}
+	}
+
+	compute_symbol_mask_table(max_val);
+
+	return true;
+}
+
 template<class ST> bool StringFeatures<ST>::have_same_length(int32_t len)
 {
 	int32_t max_string_length = get_max_vector_length();
@@ -1707,6 +1786,19 @@ template<>	template <class CT> bool StringFeatures<floatmax_t>::obtain_from_char
 }
 #endif
 
+template<>	bool StringFeatures<float32_t>::obtain_from_packed(std::shared_ptr<PackedStringFeatures> pf, int32_t start, int32_t p_order, bool rev)
+{
+	return false;
+}
+template<>	bool StringFeatures<float64_t>::obtain_from_packed(std::shared_ptr<PackedStringFeatures> pf, int32_t start, int32_t p_order, bool rev)
+{
+	return false;
+}
+template<>	bool StringFeatures<floatmax_t>::obtain_from_packed(std::shared_ptr<PackedStringFeatures> pf, int32_t start, int32_t p_order, bool rev)
+{
+	return false;
+}
+
 template<>	void StringFeatures<float32_t>::embed_features(int32_t p_order)
 {
 }
@@ -23,6 +23,7 @@ namespace shogun
 {
 class Alphabet;
 class File;
+class PackedStringFeatures;
 template <class T> class SGVector;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -531,6 +532,23 @@ template <class ST> class StringFeatures : public Features
 			bool obtain_from_char_features(std::shared_ptr<StringFeatures<CT>> sf, int32_t start,
 					int32_t p_order, int32_t gap, bool rev);
 
+		/** obtain k-mer features directly from packed strings
+		 *
+		 * gives the same features as obtain_from_char() with gap 0, the
+		 * k-mers are shifted in from the packed symbols without
+		 * remapping a copy of the characters first
+		 *
+		 * any subset is removed before, subset of parameter pf is possible
+		 *
+		 * @param pf packed strings
+		 * @param start start
+		 * @param p_order order
+		 * @param rev reverse
+		 * @return if obtaining was successful
+		 */
+		bool obtain_from_packed(std::shared_ptr<PackedStringFeatures> pf,
+				int32_t start, int32_t p_order, bool rev);
+
 		/** check if length of each vector in this feature object equals the
 		 * given length. if existant, only subset is checked
 		 *
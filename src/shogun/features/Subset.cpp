@@ -18,13 +18,41 @@ Subset::Subset(const SGVector<index_t>& subset_idx)
 	init();
 
 	m_subset_idx = subset_idx.clone();
+	m_size = subset_idx.vlen;
+}
+
+Subset::Subset(index_t start, index_t size)
+{
+	init();
+
+	m_offset = start;
+	m_size = size;
 }
 
 Subset::~Subset()
 {
 }
 
+SGVector<index_t> Subset::get_subset_idx() const
+{
+	if (m_offset==0 && m_shift==0 && m_subset_idx.vlen==m_size)
+		return m_subset_idx;
+
+	SGVector<index_t> idx(m_size);
+	for (index_t i=0; i<m_size; ++i)
+		idx[i]=index(i);
+
+	return idx;
+}
+
 void Subset::init()
 {
+	m_offset = 0;
+	m_size = 0;
+	m_shift = 0;
+
 	SG_ADD(&m_subset_idx, "subset", "Vector of subset indices");
+	SG_ADD(&m_offset, "offset", "Position of the first index");
+	SG_ADD(&m_size, "size", "Number of indices");
+	SG_ADD(&m_shift, "shift", "Added to all indices");
 }
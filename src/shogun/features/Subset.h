@@ -17,11 +17,17 @@
 
 namespace shogun
 {
-/** @brief Wrapper class for an index subset which is used by SubsetStack. */
+/** @brief Wrapper class for an index subset which is used by SubsetStack.
+ *
+ * Index i of the subset maps to
+ * \f$\textrm{idx}[\textrm{offset}+i]+\textrm{shift}\f$, or to
+ * \f$\textrm{offset}+i+\textrm{shift}\f$ for ranges, which store no
+ * indices. This lets SubsetStack compose ranges with ranges and index
+ * vectors without copying indices.
+ */
 class Subset: public SGObject
 {
 	friend class SubsetStack;
-
 public:
 	/** default constructor, do not use */
 	Subset();
@@ -32,24 +38,50 @@ public:
 	 */
 	Subset(const SGVector<index_t>& subset_idx);
 
+	/** constructor of a range subset
+	 *
+	 * @param start first index
+	 * @param size number of indices
+	 */
+	Subset(index_t start, index_t size);
+
 	/** destructor */
 	~Subset() override;
 
 	/** @return size of subset index array */
-	index_t get_size() const { return m_subset_idx.vlen; }
+	index_t get_size() const { return m_size; }
 
 	/** @return name of the SGSerializable */
 	inline const char* get_name() const override { return "Subset"; }
 
-	/** get subset indices */
-	SGVector<index_t> get_subset_idx() const { return m_subset_idx; }
+	/** get subset indices, computed for ranges and composed subsets */
+	SGVector<index_t> get_subset_idx() const;
+
+	/** @return whether the subset is a contiguous range of indices */
+	bool is_range() const { return m_subset_idx.vlen==0; }
+
+	/** @return index i of the subset */
+	inline index_t index(index_t i) const
+	{
+		return (m_subset_idx.vector ? m_subset_idx.vector[m_offset+i]
+			: m_offset+i)+m_shift;
+	}
 
 private:
 	void init();
 
 private:
+	/** indices, empty for ranges */
 	SGVector<index_t> m_subset_idx;
-};
 
+	/** position of the first index in m_subset_idx, first index of ranges */
+	index_t m_offset;
+
+	/** number of indices */
+	index_t m_size;
+
+	/** added to all indices */
+	index_t m_shift;
+};
 }
 #endif /* __SUBSET_H_ */
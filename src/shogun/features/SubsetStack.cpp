@@ -63,74 +63,117 @@ void SubsetStack::init()
 	m_active_subset=NULL;
 }
 
-void SubsetStack::add_subset(const SGVector<index_t>& subset)
+void SubsetStack::check_subset(const SGVector<index_t>& subset) const
 {
 	/* if there are already subsets on stack, do some legality checks */
 	if (!m_active_subsets_stack.empty())
 	{
 		/* check that subsets may only be smaller or equal than existing */
 		auto latest=m_active_subsets_stack.back();
-		if (subset.vlen>latest->m_subset_idx.vlen)
+		if (subset.vlen>latest->get_size())
 		{
 			subset.display_vector("subset");
-			latest->m_subset_idx.display_vector("last on stack");
 			error("{}::add_subset(): Provided index vector is "
 					"larger than the subsets on the stubset stack!", get_name());
 		}
 
 		/* check for range of indices */
 		index_t max_index=Math::max(subset.vector, subset.vlen);
-		if (max_index>=latest->m_subset_idx.vlen)
+		if (max_index>=latest->get_size())
 		{
 			subset.display_vector("subset");
-			latest->m_subset_idx.display_vector("last on stack");
 			error("{}::add_subset(): Provided index vector contains"
 					" indices larger than possible range!", get_name());
 		}
 	}
+}
 
-	/* active subset will be changed anyway, no setting to NULL */
-
-
-	/* two cases: stack is empty/stack is not empty */
-	if (!m_active_subsets_stack.empty())
+std::shared_ptr<Subset> SubsetStack::compose(const SGVector<index_t>& subset) const
+{
+	/* contiguous indices are stored as range */
+	bool contiguous=subset.vlen>0;
+	for (index_t i=1; i<subset.vlen && contiguous; ++i)
+		contiguous=subset.vector[i]==subset.vector[0]+i;
+	if (contiguous)
+		return compose_range(subset.vector[0], subset.vlen);
+
+	/* just use plain given subset since there is nothing to map */
+	if (m_active_subsets_stack.empty())
+		return std::make_shared<Subset>(subset);
+
+	auto latest=m_active_subsets_stack.back();
+	if (latest->is_range())
 	{
-		/* if there are already subsets, we need to map given one through
-		 * existing ones */
+		/* the indices of a range are shifted by its start */
+		auto result=std::make_shared<Subset>(subset);
+		result->m_shift=latest->m_offset+latest->m_shift;
+		return result;
+	}
 
-		/* get latest current subset */
-		auto latest=m_active_subsets_stack.back();
+	/* using the latest current subset, transform all indices by the latest
+	 * added subset (dynamic programming greets you) */
+	auto result=std::make_shared<Subset>();
+	result->m_subset_idx=SGVector<index_t>(subset.vlen);
+	result->m_size=subset.vlen;
+	for (index_t i=0; i<subset.vlen; ++i)
+		result->m_subset_idx.vector[i]=latest->index(subset.vector[i]);
 
-		/* create new index vector */
-		SGVector<index_t> new_active_subset=SGVector<index_t>(subset.vlen);
+	return result;
+}
 
-		/* using the latest current subset, transform all indices by the latest
-		 * added subset (dynamic programming greets you) */
-		for (index_t i=0; i<subset.vlen; ++i)
-		{
-			new_active_subset.vector[i]=
-					latest->m_subset_idx.vector[subset.vector[i]];
-		}
+std::shared_ptr<Subset> SubsetStack::compose_range(index_t start, index_t size) const
+{
+	if (m_active_subsets_stack.empty())
+		return std::make_shared<Subset>(start, size);
+
+	/* a range of the latest subset shares its indices */
+	auto latest=m_active_subsets_stack.back();
+	auto result=std::make_shared<Subset>();
+	result->m_subset_idx=latest->m_subset_idx;
+	result->m_offset=latest->m_offset+start;
+	result->m_size=size;
+	result->m_shift=latest->m_shift;
+	return result;
+}
 
-		/* replace active subset */
-		m_active_subset=std::make_shared<Subset>(new_active_subset);
+void SubsetStack::add_subset(const SGVector<index_t>& subset)
+{
+	check_subset(subset);
 
+	/* add current active subset on stack of active subsets in any case */
+	m_active_subset=compose(subset);
+	m_active_subsets_stack.push_back(m_active_subset);
+}
 
-	}
-	else
+void SubsetStack::add_subset_range(index_t start, index_t size)
+{
+	require(start>=0 && size>=0, "{}::add_subset_range(): Start ({}) and "
+			"size ({}) cannot be negative!", get_name(), start, size);
+	if (!m_active_subsets_stack.empty())
 	{
-		/* just use plain given subset since there is nothing to map */
-		m_active_subset=std::make_shared<Subset>(subset);
-
+		require(start+size<=m_active_subsets_stack.back()->get_size(),
+				"{}::add_subset_range(): Range [{}, {}) exceeds the size of "
+				"the active subset ({})!", get_name(), start, start+size,
+				m_active_subsets_stack.back()->get_size());
 	}
 
-	/* add current active subset on stack of active subsets in any case */
+	m_active_subset=compose_range(start, size);
 	m_active_subsets_stack.push_back(m_active_subset);
 }
 
 void SubsetStack::add_subset_in_place(SGVector<index_t> subset)
 {
-	not_implemented(SOURCE_LOCATION);;
+	if (m_active_subsets_stack.empty())
+	{
+		add_subset(subset);
+		return;
+	}
+
+	check_subset(subset);
+
+	/* replace the latest subset by its composition with the given one */
+	m_active_subset=compose(subset);
+	m_active_subsets_stack.back()=m_active_subset;
 }
 
 void SubsetStack::remove_subset()
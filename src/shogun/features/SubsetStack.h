@@ -31,6 +31,11 @@ namespace shogun
  * added, a new element will be put on stack, using the old element to get
  * mapping. On  removal, the last element on stack will be removed. This is done
  * for computational convenience.
+ *
+ * Contiguous ranges, see add_subset_range(), are composed without copying:
+ * a range on top of any subset shares its indices, an index vector on top of
+ * a range is only shifted. Only index vectors on top of index vectors are
+ * mapped into a new vector.
  */
 class SubsetStack: public SGObject
 {
@@ -59,6 +64,16 @@ public:
 	 * */
 	virtual void add_subset(const SGVector<index_t>& subset);
 
+	/** Adds the range of indices start, ..., start+size-1 on top of the
+	 * current subsets. The range stores no indices and shares the indices
+	 * of the current subset, as do index vectors of contiguous indices
+	 * passed to add_subset(), so pushing ranges costs no memory.
+	 *
+	 * @param start first index of the range
+	 * @param size number of indices
+	 * */
+	virtual void add_subset_range(index_t start, index_t size);
+
 	/** Sets/changes latest added subset. This allows to add multiple subsets
 	 * with in-place memory requirements. They cannot be removed one-by-one
 	 * afterwards, only the latest active can. If this is needed, use
@@ -102,13 +117,29 @@ public:
 	 */
 	inline index_t subset_idx_conversion(index_t idx) const
 	{
-		return m_active_subset ? m_active_subset->m_subset_idx.vector[idx] : idx;
+		return m_active_subset ? m_active_subset->index(idx) : idx;
+	}
+
+	/** @return whether the active subset maps to contiguous indices, true
+	 * without subsets */
+	bool is_contiguous() const
+	{
+		return !m_active_subset || m_active_subset->is_range();
 	}
 
 private:
 	/** registers and initializes parameters */
 	void init();
 
+	/** check that the indices of a subset are within the active subset */
+	void check_subset(const SGVector<index_t>& subset) const;
+
+	/** @return the given subset mapped through the active subset */
+	std::shared_ptr<Subset> compose(const SGVector<index_t>& subset) const;
+
+	/** @return the given range mapped through the active subset */
+	std::shared_ptr<Subset> compose_range(index_t start, index_t size) const;
+
 private:
 	/** stack of active subsets. All active subsets are stored to avoid
 	 * recomputing them when subsets are removed. There is always the identity
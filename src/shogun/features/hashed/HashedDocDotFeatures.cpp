@@ -11,6 +11,7 @@
 
 #include <cmath>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -132,24 +133,26 @@ float64_t HashedDocDotFeatures::dot(
 	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
 
 	float64_t result = 0;
-	auto local_tzer = tokenizer->get_copy();
+	std::vector<std::pair<index_t, index_t>> tokens;
+	tokenizer->tokenize(sv, tokens);
 
 	/** Reading n+k-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	local_tzer->set_text(sv);
-	index_t start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && local_tzer->has_next())
+	size_t next_token = 0;
+	while (hashes_end<ngrams-1+tokens_to_skip && next_token<tokens.size())
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
+		const auto& token = tokens[next_token++];
+		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[token.first],
+				token.second-token.first, seed);
 		hashes[hashes_end++] = token_hash;
 	}
 
 	/** Reading token and storing indices to hashed_indices */
-	while (local_tzer->has_next())
+	while (next_token<tokens.size())
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
+		const auto& token = tokens[next_token++];
+		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[token.first],
+				token.second-token.first, seed);
 		hashes[hashes_end] = token_hash;
 
 		HashedDocConverter::generate_ngram_hashes(hashes, hashes_start, len, hashed_indices,
@@ -210,23 +213,25 @@ void HashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	 * stored here to avoid creating new objects */
 	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
 
-	auto local_tzer = tokenizer->get_copy();
+	std::vector<std::pair<index_t, index_t>> tokens;
+	tokenizer->tokenize(sv, tokens);
 
 	/** Reading n+k-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	local_tzer->set_text(sv);
-	index_t start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && local_tzer->has_next())
+	size_t next_token = 0;
+	while (hashes_end<ngrams-1+tokens_to_skip && next_token<tokens.size())
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
+		const auto& token = tokens[next_token++];
+		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[token.first],
+				token.second-token.first, seed);
 		hashes[hashes_end++] = token_hash;
 	}
 
-	while (local_tzer->has_next())
+	while (next_token<tokens.size())
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
+		const auto& token = tokens[next_token++];
+		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[token.first],
+				token.second-token.first, seed);
 		hashes[hashes_end] = token_hash;
 
 		HashedDocConverter::generate_ngram_hashes(hashes, hashes_start, len, hashed_indices,
@@ -4,35 +4,29 @@
  * Authors: Giovanni De Toni, Sergey Lisitsyn, Viktor Gal
  */
 
-#include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/features/hashed/HashedWDFeaturesTransposed.h>
 #include <shogun/io/SGIO.h>
-#include <shogun/lib/Signal.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-
-#endif
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct HASHEDWD_THREAD_PARAM
+namespace
 {
-	const HashedWDFeaturesTransposed* hf;
-	int32_t* sub_index;
-	float64_t* output;
-	int32_t start;
-	int32_t stop;
-	float64_t* alphas;
-	float64_t* vec;
-	float64_t bias;
-	bool progress;
-	PRange<int32_t>* progress_bar;
-	uint32_t* index;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
+	/* number of vectors whose outputs are computed together, they share
+	 * the part of w that belongs to a position */
+	const int32_t block_size=256;
+
+	/* number of vectors per thread whose features are accumulated at once */
+	const int32_t add_block_size=64;
+
+	/* seed of the k-mer hashes */
+	const uint32_t hash_seed=0xDEADBEAF;
+}
 
 HashedWDFeaturesTransposed::HashedWDFeaturesTransposed()
 	:DotFeatures()
@@ -76,8 +70,8 @@ HashedWDFeaturesTransposed::HashedWDFeaturesTransposed(const std::shared_ptr<Str
 
 	string_length=str->get_max_vector_length();
 	num_strings=str->get_num_vectors();
-	ASSERT(transposed_num_feat==num_strings)
-	ASSERT(transposed_num_vec==string_length)
+	ASSERT(transposed_num_feat==string_length)
+	ASSERT(transposed_num_vec==num_strings)
 
 	auto alpha=str->get_alphabet();
 	alphabet_size=alpha->get_num_symbols();
@@ -144,6 +138,28 @@ float64_t HashedWDFeaturesTransposed::dot(int32_t vec_idx1, std::shared_ptr<DotF
 	return sum/Math::sq(normalization_const);
 }
 
+template <class F>
+void HashedWDFeaturesTransposed::for_each_feature(const uint8_t* vec, int32_t len, F&& f) const
+{
+	std::vector<uint32_t> hashes(degree);
+	uint32_t offs=0;
+
+	for (int32_t i=0; i<len; i++)
+	{
+		/* the k-mers of all orders starting at position i */
+		const int32_t num_orders=std::min(degree, len-i);
+		Hash::MurmurHash3Prefixes(&vec[i], num_orders, hash_seed, hashes.data());
+
+		uint32_t o=offs;
+		for (int32_t k=0; k<num_orders; k++)
+		{
+			f(o+(hashes[k] & mask), wd_weights[k]);
+			o+=partial_w_dim;
+		}
+		offs+=partial_w_dim*degree;
+	}
+}
+
 float64_t HashedWDFeaturesTransposed::dot(
     int32_t vec_idx1, const SGVector<float64_t>& vec2) const
 {
@@ -155,131 +171,81 @@ float64_t HashedWDFeaturesTransposed::dot(
 	int32_t len;
 	bool free_vec1;
 	uint8_t* vec = strings->get_feature_vector(vec_idx1, len, free_vec1);
-	uint32_t* val=SG_MALLOC(uint32_t, len);
 
-	uint32_t offs=0;
+	for_each_feature(vec, len, [&](uint32_t idx, float64_t wd) {
+		sum+=vec2[idx]*wd;
+	});
+	strings->free_feature_vector(vec, vec_idx1, free_vec1);
 
-	SGVector<uint32_t>::fill_vector(val, len, 0xDEADBEAF);
+	return sum/normalization_const;
+}
 
-	for (int32_t i=0; i < len; i++)
-	{
-		uint32_t o=offs;
-		uint32_t carry = 0;
-		uint32_t chunk = 0;
+void HashedWDFeaturesTransposed::dense_dot_block(
+		const int32_t* indices, int32_t num, const float64_t* vec,
+		float64_t* output) const
+{
+	std::vector<uint8_t> kmer(degree);
+	std::vector<uint32_t> hashes(degree);
+	std::fill(output, output+num, 0.0);
 
-		for (int32_t k=0; k<degree && i+k<len; k++)
+	uint32_t offs=0;
+	for (int32_t i=0; i<string_length; i++)
+	{
+		/* all vectors of the block look up the same part of vec */
+		const int32_t num_orders=std::min(degree, string_length-i);
+		for (int32_t j=0; j<num; j++)
 		{
-			const float64_t wd = wd_weights[k];
-			chunk++;
-			Hash::IncrementalMurmurHash3(&(val[i]), &carry, &(vec[i+k]), 1);
-			uint32_t h =
-					Hash::FinalizeIncrementalMurmurHash3(val[i], carry, chunk);
-#ifdef DEBUG_HASHEDWD
-			io::print("vec[i]={}, k={}, offs={} o={} h={} \n", vec[i], k,offs, o, h);
-#endif
-			sum+=vec2[o+(h & mask)]*wd;
-			o+=partial_w_dim;
+			for (int32_t k=0; k<num_orders; k++)
+				kmer[k]=transposed_strings[i+k].vector[indices[j]];
+			Hash::MurmurHash3Prefixes(kmer.data(), num_orders, hash_seed, hashes.data());
+
+			float64_t sum=0;
+			uint32_t o=offs;
+			for (int32_t k=0; k<num_orders; k++)
+			{
+				sum+=vec[o+(hashes[k] & mask)]*wd_weights[k];
+				o+=partial_w_dim;
+			}
+			output[j]+=sum;
 		}
-		val[i] = Hash::FinalizeIncrementalMurmurHash3(val[i], carry, chunk);
 		offs+=partial_w_dim*degree;
 	}
-	SG_FREE(val);
-	strings->free_feature_vector(vec, vec_idx1, free_vec1);
-
-	return sum/normalization_const;
 }
 
 void HashedWDFeaturesTransposed::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
 {
 	ASSERT(output)
-	// write access is internally between output[start..stop] so the following
-	// line is necessary to write to output[0...(stop-start-1)]
-	output-=start;
 	ASSERT(start>=0)
 	ASSERT(start<stop)
 	ASSERT(stop<=get_num_vectors())
-	uint32_t* index=SG_MALLOC(uint32_t, stop);
-
-	int32_t num_vectors=stop-start;
-	ASSERT(num_vectors>0)
-
-	// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-	int32_t num_threads=env()->get_num_threads();
-#else
-	int32_t num_threads=1;
-#endif
-	ASSERT(num_threads>0)
 
 	if (dim != w_dim)
 		error("Dimensions don't match, vec_len={}, w_dim={}", dim, w_dim);
 
-	if (num_threads < 2)
-	{
-		HASHEDWD_THREAD_PARAM params;
-		auto pb = SG_PROGRESS(range(start, stop));
-		params.hf=this;
-		params.sub_index=NULL;
-		params.output=output;
-		params.start=start;
-		params.stop=stop;
-		params.alphas=alphas;
-		params.vec=vec;
-		params.bias=b;
-		params.progress=false; //true;
-		params.progress_bar = &pb;
-		params.index = index;
-		dense_dot_range_helper((void*) &params);
-		pb.complete();
-	}
-#ifdef HAVE_PTHREAD
-	else
-	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		HASHEDWD_THREAD_PARAM* params = SG_MALLOC(HASHEDWD_THREAD_PARAM, num_threads);
-		auto pb = SG_PROGRESS(range(start, stop));
-		int32_t step= num_vectors/num_threads;
+	// the result is written to output[0...(stop-start-1)]
+	const int32_t num_vectors=stop-start;
+	const int32_t num_blocks=(num_vectors+block_size-1)/block_size;
+	auto pb = SG_PROGRESS(range(num_blocks));
 
-		int32_t t;
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int32_t blk=0; blk<num_blocks; blk++)
+	{
+		const int32_t begin=blk*block_size;
+		const int32_t end=std::min(num_vectors, begin+block_size);
+		SGVector<int32_t> indices(end-begin);
+		indices.range_fill(start+begin);
+		dense_dot_block(indices.vector, indices.vlen, vec, &output[begin]);
 
-		for (t=0; t<num_threads-1; t++)
+		for (int32_t j=begin; j<end; j++)
 		{
-			params[t].hf = this;
-			params[t].sub_index=NULL;
-			params[t].output = output;
-			params[t].start = start+t*step;
-			params[t].stop = start+(t+1)*step;
-			params[t].alphas=alphas;
-			params[t].vec=vec;
-			params[t].bias=b;
-			params[t].progress = false;
-			params[t].progress_bar = &pb;
-			params[t].index=index;
-			pthread_create(&threads[t], NULL,
-					HashedWDFeaturesTransposed::dense_dot_range_helper, (void*)&params[t]);
+			if (alphas)
+				output[j]=output[j]*alphas[start+j]/normalization_const+b;
+			else
+				output[j]=output[j]/normalization_const+b;
 		}
-
-		params[t].hf = this;
-		params[t].sub_index=NULL;
-		params[t].output = output;
-		params[t].start = start+t*step;
-		params[t].stop = stop;
-		params[t].alphas=alphas;
-		params[t].vec=vec;
-		params[t].bias=b;
-		params[t].progress = false; //true;
-		params[t].progress_bar = &pb;
-		params[t].index=index;
-		HashedWDFeaturesTransposed::dense_dot_range_helper((void*) &params[t]);
-
-		for (t=0; t<num_threads-1; t++)
-			pthread_join(threads[t], NULL);
-
-		SG_FREE(params);
-		SG_FREE(threads);
+		pb.print_progress();
 	}
-#endif
-	SG_FREE(index);
+	pb.complete();
 }
 
 void HashedWDFeaturesTransposed::dense_dot_range_subset(int32_t* sub_index, int num, float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
@@ -287,214 +253,29 @@ void HashedWDFeaturesTransposed::dense_dot_range_subset(int32_t* sub_index, int
 	ASSERT(sub_index)
 	ASSERT(output)
 
-	uint32_t* index=SG_MALLOC(uint32_t, num);
-
-	// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-	int32_t num_threads=env()->get_num_threads();
-#else
-	int32_t num_threads=1;
-#endif
-	ASSERT(num_threads>0)
-
 	if (dim != w_dim)
 		error("Dimensions don't match, vec_len={}, w_dim={}", dim, w_dim);
 
-	if (num_threads < 2)
-	{
-		HASHEDWD_THREAD_PARAM params;
-		auto pb = SG_PROGRESS(range(num));
-		params.hf=this;
-		params.sub_index=sub_index;
-		params.output=output;
-		params.start=0;
-		params.stop=num;
-		params.alphas=alphas;
-		params.vec=vec;
-		params.bias=b;
-		params.progress=false; //true;
-		params.progress_bar = &pb;
-		params.index=index;
-		dense_dot_range_helper((void*) &params);
-		pb.complete();
-	}
-#ifdef HAVE_PTHREAD
-	else
-	{
-		pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-		HASHEDWD_THREAD_PARAM* params = SG_MALLOC(HASHEDWD_THREAD_PARAM, num_threads);
-		int32_t step= num/num_threads;
-		auto pb = SG_PROGRESS(range(num));
-		int32_t t;
-
-		for (t=0; t<num_threads-1; t++)
-		{
-			params[t].hf = this;
-			params[t].sub_index=sub_index;
-			params[t].output = output;
-			params[t].start = t*step;
-			params[t].stop = (t+1)*step;
-			params[t].alphas=alphas;
-			params[t].vec=vec;
-			params[t].bias=b;
-			params[t].progress = false;
-			params[t].progress_bar = &pb;
-			params[t].index=index;
-			pthread_create(&threads[t], NULL,
-					HashedWDFeaturesTransposed::dense_dot_range_helper, (void*)&params[t]);
-		}
-
-		params[t].hf = this;
-		params[t].sub_index=sub_index;
-		params[t].output = output;
-		params[t].start = t*step;
-		params[t].stop = num;
-		params[t].alphas=alphas;
-		params[t].vec=vec;
-		params[t].bias=b;
-		params[t].progress = false; //true;
-		params[t].progress_bar = &pb;
-		params[t].index=index;
-		HashedWDFeaturesTransposed::dense_dot_range_helper((void*) &params[t]);
-
-		for (t=0; t<num_threads-1; t++)
-			pthread_join(threads[t], NULL);
-
-		pb.complete();
-		SG_FREE(params);
-		SG_FREE(threads);
-		SG_FREE(index);
-	}
-#endif
-}
-
-void* HashedWDFeaturesTransposed::dense_dot_range_helper(void* p)
-{
-	HASHEDWD_THREAD_PARAM* par=(HASHEDWD_THREAD_PARAM*) p;
-	const HashedWDFeaturesTransposed* hf=par->hf;
-	int32_t* sub_index=par->sub_index;
-	float64_t* output=par->output;
-	int32_t start=par->start;
-	int32_t stop=par->stop;
-	float64_t* alphas=par->alphas;
-	float64_t* vec=par->vec;
-	float64_t bias=par->bias;
-	bool progress=par->progress;
-	auto pb = par->progress_bar;
-	uint32_t* index=par->index;
-	int32_t string_length=hf->string_length;
-	int32_t degree=hf->degree;
-	float64_t* wd_weights=hf->wd_weights;
-	auto& transposed_strings=hf->transposed_strings;
-	uint32_t mask=hf->mask;
-	int32_t partial_w_dim=hf->partial_w_dim;
-	float64_t normalization_const=hf->normalization_const;
-
-	if (sub_index)
-	{
-		for (int32_t j=start; j<stop; j++)
-			output[j]=0.0;
-
-		uint32_t offs=0;
-		for (int32_t i=0; i<string_length; i++)
-		{
-			uint32_t o=offs;
-			for (int32_t k=0; k<degree && i+k<string_length; k++)
-			{
-				const float64_t wd = wd_weights[k];
-				uint8_t* dim=transposed_strings[i+k].vector;
-				uint32_t carry = 0;
-				uint32_t chunk = 0;
-				for (int32_t j=start; j<stop; j++)
-				{
-					uint8_t bval=dim[sub_index[j]];
-					if (k==0)
-						index[j] = 0xDEADBEAF;
-
-					Hash::IncrementalMurmurHash3(&index[j], &carry, &bval, 1);
-
-					chunk++;
-					uint32_t h =
-							Hash::FinalizeIncrementalMurmurHash3(
-									index[j], carry, chunk);
-
-					output[j]+=vec[o + (h & mask)]*wd;
-					index[j] = h;
-				}
-
-				index[stop-1] =
-						Hash::FinalizeIncrementalMurmurHash3(
-								index[stop-1], carry, chunk);
+	const int32_t num_blocks=(num+block_size-1)/block_size;
+	auto pb = SG_PROGRESS(range(num_blocks));
 
-				o+=partial_w_dim;
-			}
-			offs+=partial_w_dim*degree;
-
-			if (progress)
-				pb->print_progress();
-		}
-
-		for (int32_t j=start; j<stop; j++)
-		{
-			if (alphas)
-				output[j]=output[j]*alphas[sub_index[j]]/normalization_const+bias;
-			else
-				output[j]=output[j]/normalization_const+bias;
-		}
-	}
-	else
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int32_t blk=0; blk<num_blocks; blk++)
 	{
-		SGVector<float64_t>::fill_vector(&output[start], stop-start, 0.0);
+		const int32_t begin=blk*block_size;
+		const int32_t end=std::min(num, begin+block_size);
+		dense_dot_block(&sub_index[begin], end-begin, vec, &output[begin]);
 
-		uint32_t offs=0;
-		for (int32_t i=0; i<string_length; i++)
-		{
-			uint32_t o=offs;
-			for (int32_t k=0; k<degree && i+k<string_length; k++)
-			{
-				const float64_t wd = wd_weights[k];
-				uint8_t* dim=transposed_strings[i+k].vector;
-				uint32_t carry = 0;
-				uint32_t chunk = 0;
-
-				for (int32_t j=start; j<stop; j++)
-				{
-					uint8_t bval=dim[sub_index[j]];
-					if (k==0)
-						index[j] = 0xDEADBEAF;
-
-					Hash::IncrementalMurmurHash3(&index[j], &carry, &bval, 1);
-
-					chunk++;
-					uint32_t h =
-							Hash::FinalizeIncrementalMurmurHash3(
-									index[j], carry, chunk);
-
-					index[j] = h;
-					output[j]+=vec[o + (h & mask)]*wd;
-				}
-
-				index[stop-1] = Hash::FinalizeIncrementalMurmurHash3(
-						index[stop-1], carry, chunk);
-
-				o+=partial_w_dim;
-			}
-			offs+=partial_w_dim*degree;
-
-			if (progress)
-				pb->print_progress();
-		}
-
-		for (int32_t j=start; j<stop; j++)
+		for (int32_t j=begin; j<end; j++)
 		{
 			if (alphas)
-				output[j]=output[j]*alphas[j]/normalization_const+bias;
+				output[j]=output[j]*alphas[sub_index[j]]/normalization_const+b;
 			else
-				output[j]=output[j]/normalization_const+bias;
+				output[j]=output[j]/normalization_const+b;
 		}
+		pb.print_progress();
 	}
-
-	return NULL;
+	pb.complete();
 }
 
 void HashedWDFeaturesTransposed::add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val) const
@@ -505,43 +286,86 @@ void HashedWDFeaturesTransposed::add_to_dense_vec(float64_t alpha, int32_t vec_i
 	int32_t len;
 	bool free_vec1;
 	uint8_t* vec = strings->get_feature_vector(vec_idx1, len, free_vec1);
-	uint32_t* val=SG_MALLOC(uint32_t, len);
 
-	uint32_t offs=0;
 	float64_t factor=alpha/normalization_const;
 	if (abs_val)
 		factor=Math::abs(factor);
 
-	SGVector<uint32_t>::fill_vector(val, len, 0xDEADBEAF);
+	for_each_feature(vec, len, [&](uint32_t idx, float64_t wd) {
+		vec2[idx]+=wd*factor;
+	});
 
-	for (int32_t i=0; i<len; i++)
+	strings->free_feature_vector(vec, vec_idx1, free_vec1);
+}
+
+void HashedWDFeaturesTransposed::add_to_dense_vec_range(
+		const float64_t* alphas, int32_t start, int32_t stop, float64_t* vec,
+		int32_t dim, bool abs_val) const
+{
+	ASSERT(alphas)
+	ASSERT(start>=0)
+	ASSERT(stop<=get_num_vectors())
+
+	if (dim != w_dim)
+		error("Dimensions don't match, vec_len={}, w_dim={}", dim, w_dim);
+
+	const int32_t num_threads=env()->get_num_threads();
+	if (num_threads<2)
 	{
-		uint32_t o=offs;
-		uint32_t carry = 0;
-		uint32_t chunk = 0;
+		DotFeatures::add_to_dense_vec_range(alphas, start, stop, vec, dim, abs_val);
+		return;
+	}
+
+	/* every thread collects the sparse deltas of a contiguous part of a
+	 * chunk of vectors, bucketed by the part of vec they fall into. Thread
+	 * t then adds the buckets t of all threads in thread order, so every
+	 * entry of vec gets its deltas in the same order as in a serial loop
+	 * over the vectors. */
+	using Delta=std::pair<uint32_t, float64_t>;
+	std::vector<std::vector<std::vector<Delta>>> deltas(
+			num_threads, std::vector<std::vector<Delta>>(num_threads));
+	const int64_t bucket_size=(int64_t(w_dim)+num_threads-1)/num_threads;
+	const int32_t chunk_size=add_block_size*num_threads;
+
+	for (int32_t chunk_start=start; chunk_start<stop; chunk_start+=chunk_size)
+	{
+		const int32_t chunk_len=std::min(stop-chunk_start, chunk_size);
 
-		for (int32_t k=0; k<degree && i+k<len; k++)
+		#pragma omp parallel for schedule(static) num_threads(num_threads)
+		for (int32_t t=0; t<num_threads; t++)
 		{
-			float64_t wd = wd_weights[k]*factor;
-			chunk++;
-			Hash::IncrementalMurmurHash3(&(val[i]), &carry, &(vec[i+k]), 1);
-			uint32_t h =
-					Hash::FinalizeIncrementalMurmurHash3(val[i], carry, chunk);
-#ifdef DEBUG_HASHEDWD
-			io::print("offs={} o={} h={} \n", offs, o, h);
-			io::print("vec[i]={}, k={}, offs={} o={}\n", vec[i], k,offs, o);
-#endif
-			vec2[o+(h & mask)]+=wd;
-			val[i] = h;
-			o+=partial_w_dim;
+			const int32_t begin=chunk_start+int64_t(chunk_len)*t/num_threads;
+			const int32_t end=chunk_start+int64_t(chunk_len)*(t+1)/num_threads;
+			for (int32_t j=begin; j<end; j++)
+			{
+				if (alphas[j-start]==0)
+					continue;
+
+				float64_t factor=alphas[j-start]/normalization_const;
+				if (abs_val)
+					factor=Math::abs(factor);
+
+				int32_t len;
+				bool free_vec;
+				uint8_t* str=strings->get_feature_vector(j, len, free_vec);
+				for_each_feature(str, len, [&](uint32_t idx, float64_t wd) {
+					deltas[t][idx/bucket_size].emplace_back(idx, wd*factor);
+				});
+				strings->free_feature_vector(str, j, free_vec);
+			}
 		}
 
-		val[i] = Hash::FinalizeIncrementalMurmurHash3(val[i], carry, chunk);
-		offs+=partial_w_dim*degree;
+		#pragma omp parallel for schedule(static) num_threads(num_threads)
+		for (int32_t r=0; r<num_threads; r++)
+		{
+			for (int32_t t=0; t<num_threads; t++)
+			{
+				for (const auto& delta : deltas[t][r])
+					vec[delta.first]+=delta.second;
+				deltas[t][r].clear();
+			}
+		}
 	}
-
-	SG_FREE(val);
-	strings->free_feature_vector(vec, vec_idx1, free_vec1);
 }
 
 void HashedWDFeaturesTransposed::set_wd_weights()
@@ -78,6 +78,8 @@ class HashedWDFeaturesTransposed : public DotFeatures
 		/** Compute the dot product for a range of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
+		 * Blocks of vectors are computed in parallel, see dense_dot_block().
+		 *
 		 * @param output result for the given vector range
 		 * @param start start vector range from this idx
 		 * @param stop stop vector range at this idx
@@ -112,6 +114,24 @@ class HashedWDFeaturesTransposed : public DotFeatures
 		 */
 		void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val=false) const override;
 
+		/** add a range of vectors multiplied with alphas to a dense vector
+		 *
+		 * The features of the vectors are hashed in parallel into per
+		 * thread sparse deltas, which are added to disjoint parts of the
+		 * dense vector in parallel. The result is the same as the one of
+		 * a serial loop over add_to_dense_vec().
+		 *
+		 * @param alphas scalars to multiply with, alphas[i] for vector start+i
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param vec dense vector to add to
+		 * @param dim length of the dense vector
+		 * @param abs_val if true add the absolute values
+		 */
+		void add_to_dense_vec_range(
+				const float64_t* alphas, int32_t start, int32_t stop,
+				float64_t* vec, int32_t dim, bool abs_val=false) const override;
+
 		/** get number of non-zero features in vector
 		 *
 		 * @param num which vector
@@ -218,8 +238,30 @@ class HashedWDFeaturesTransposed : public DotFeatures
 		/** create wd kernel weighting heuristic */
 		void set_wd_weights();
 
-		/** helper function for parallel dense_dot computation */
-		static void* dense_dot_range_helper(void* p);
+		/** call f(index, wd weight) for the hashed k-mers of all orders at
+		 * all positions of a string, the hash of a k-mer is
+		 * Hash::MurmurHash3() of its bytes
+		 *
+		 * @param vec string
+		 * @param len length of the string
+		 * @param f function to call
+		 */
+		template <class F>
+		void for_each_feature(const uint8_t* vec, int32_t len, F&& f) const;
+
+		/** compute the unnormalized dot products of a block of vectors with
+		 * a dense vector. The position loop is shared by the vectors, so
+		 * the part of the dense vector that belongs to a position stays in
+		 * cache.
+		 *
+		 * @param indices indices of the vectors
+		 * @param num number of vectors
+		 * @param vec dense vector
+		 * @param output num dot products
+		 */
+		void dense_dot_block(
+				const int32_t* indices, int32_t num, const float64_t* vec,
+				float64_t* output) const;
 
 	protected:
 		/** stringfeatures the wdfeatures are based on*/
@@ -62,13 +62,18 @@ template<class T> void StreamingDenseFeatures<T>::reset_stream()
 {
 	if (seekable)
 	{
-		std::static_pointer_cast<StreamingFileFromDenseFeatures<T>>(working_file)->reset_stream();
-		if (parser.is_running())
-			parser.end_parser();
+		/* the parser reads ahead, stop it before the file is reset */
 		parser.exit_parser();
-		parser.init(working_file, has_labels, 1);
+		working_file->reset_stream();
+
+		/* vectors streamed from features belong to the features */
+		const bool from_features=std::dynamic_pointer_cast<
+				StreamingFileFromDenseFeatures<T>>(working_file)!=nullptr;
+		parser.init(working_file, has_labels,
+				from_features ? 1 : parser.get_ring_size());
 		parser.set_free_vector_after_release(false);
-		parser.set_free_vectors_on_destruct(false);
+		if (from_features)
+			parser.set_free_vectors_on_destruct(false);
 		parser.start_parser();
 	}
 }
@@ -136,6 +141,43 @@ template<class T> int32_t StreamingDenseFeatures<T>::get_nnz_features_for_vector
 	return current_vector.vlen;
 }
 
+template<class T> void* StreamingDenseFeatures<T>::get_feature_iterator()
+{
+	dense_feature_iterator* it=new dense_feature_iterator();
+	it->vec=current_vector;
+	it->index=0;
+
+	return it;
+}
+
+template<class T> bool StreamingDenseFeatures<T>::get_next_feature(
+		int32_t& index, float32_t& value, void* iterator)
+{
+	dense_feature_iterator* it=(dense_feature_iterator*) iterator;
+	if (!it)
+		return false;
+
+	// skip zeros
+	while (it->index<it->vec.vlen && it->vec[it->index]==0)
+		it->index++;
+
+	if (it->index>=it->vec.vlen)
+		return false;
+
+	index=it->index;
+	value=(float32_t) it->vec[it->index++];
+
+	return true;
+}
+
+template<class T> void StreamingDenseFeatures<T>::free_feature_iterator(void* iterator)
+{
+	if (!iterator)
+		return;
+
+	delete ((dense_feature_iterator*) iterator);
+}
+
 template<class T> int32_t StreamingDenseFeatures<T>::get_num_vectors() const
 {
 	return 1;
@@ -196,7 +238,7 @@ void StreamingDenseFeatures<T>::init(std::shared_ptr<StreamingFile> file, bool i
 	working_file=file;
 
 	parser.init(file, is_labelled, size);
-	seekable=false;
+	seekable=file && file->is_seekable();
 }
 
 template<class T>
@@ -192,6 +192,32 @@ SGSparseVector<float64_t> StreamingHashedDocDotFeatures::get_vector()
 	return current_vector;
 }
 
+std::shared_ptr<Features> StreamingHashedDocDotFeatures::get_streamed_features(
+	index_t num_elements)
+{
+	require(num_elements>0, "Requested number of documents ({}) must be "
+			"positive", num_elements);
+
+	std::vector<SGVector<char>> documents;
+	documents.reserve(num_elements);
+	while ((index_t)documents.size()<num_elements)
+	{
+		char* document;
+		int32_t length;
+		if (!parser.get_next_example(document, length, current_label))
+		{
+			io::warn("Ran out of streaming data, returning {} documents",
+					documents.size());
+			break;
+		}
+		documents.push_back(SGVector<char>(document, length, false).clone());
+		parser.finalize_example();
+	}
+
+	return converter->transform(
+		std::make_shared<StringFeatures<char>>(documents, RAWBYTE));
+}
+
 void StreamingHashedDocDotFeatures::set_normalization(bool normalize)
 {
 	converter->set_normalization(normalize);
@@ -208,6 +208,15 @@ public:
 	 */
 	SGSparseVector<float64_t> get_vector();
 
+	/** Reads up to num_elements documents from the stream and hashes them
+	 * in parallel, see HashedDocConverter::transform()
+	 *
+	 * @param num_elements number of documents to read
+	 * @return SparseFeatures with the hashed documents, might contain fewer
+	 * documents if the stream ended (a warning is written)
+	 */
+	std::shared_ptr<Features> get_streamed_features(index_t num_elements) override;
+
 	/** specify whether hashed vector should be normalized or not
 	 *
 	 * @param normalize  whether to normalize
@@ -45,7 +45,15 @@ T StreamingSparseFeatures<T>::get_feature(int32_t index)
 template <class T>
 void StreamingSparseFeatures<T>::reset_stream()
 {
-	not_implemented(SOURCE_LOCATION);
+	if (!seekable)
+		not_implemented(SOURCE_LOCATION);
+
+	/* the parser reads ahead, stop it before the file is reset */
+	parser.exit_parser();
+	working_file->reset_stream();
+	parser.init(working_file, has_labels, parser.get_ring_size());
+	parser.set_free_vector_after_release(false);
+	parser.start_parser();
 }
 
 template <class T>
@@ -262,6 +270,7 @@ void StreamingSparseFeatures<T>::init()
 	working_file=NULL;
 	current_vec_index=0;
 	current_num_features=-1;
+	seekable=false;
 
 	set_generic<T>();
 }
@@ -277,6 +286,7 @@ void StreamingSparseFeatures<T>::init(std::shared_ptr<StreamingFile> file,
 	
 	parser.init(file, is_labelled, size);
 	parser.set_free_vector_after_release(false);
+	seekable=file && file->is_seekable();
 }
 
 template <class T>
@@ -362,6 +372,41 @@ int32_t StreamingSparseFeatures<T>::get_nnz_features_for_vector()
 	return current_sgvector.num_feat_entries;
 }
 
+template <class T>
+void* StreamingSparseFeatures<T>::get_feature_iterator()
+{
+	sparse_feature_iterator* it=new sparse_feature_iterator();
+	it->sv=current_sgvector;
+	it->index=0;
+
+	return it;
+}
+
+template <class T>
+bool StreamingSparseFeatures<T>::get_next_feature(
+		int32_t& index, float32_t& value, void* iterator)
+{
+	sparse_feature_iterator* it=(sparse_feature_iterator*) iterator;
+	if (!it || it->index>=it->sv.num_feat_entries)
+		return false;
+
+	int32_t i=it->index++;
+
+	index=it->sv.features[i].feat_index;
+	value=(float32_t) it->sv.features[i].entry;
+
+	return true;
+}
+
+template <class T>
+void StreamingSparseFeatures<T>::free_feature_iterator(void* iterator)
+{
+	if (!iterator)
+		return;
+
+	delete ((sparse_feature_iterator*) iterator);
+}
+
 template <class T>
 EFeatureClass StreamingSparseFeatures<T>::get_feature_class() const
 {
@@ -291,6 +291,31 @@ public:
 	 */
 	int32_t get_nnz_features_for_vector() override;
 
+	/** iterate over the non-zero features of the current example
+	 *
+	 * call get_feature_iterator first, followed by get_next_feature and
+	 * free_feature_iterator to cleanup. The iterator is only valid until
+	 * release_example() is called.
+	 *
+	 * @return feature iterator (to be passed to get_next_feature)
+	 */
+	void* get_feature_iterator() override;
+
+	/** iterate over the non-zero features of the current example
+	 *
+	 * @param index is returned by reference
+	 * @param value is returned by reference
+	 * @param iterator as returned by get_feature_iterator
+	 * @return true if a new non-zero feature got returned
+	 */
+	bool get_next_feature(int32_t& index, float32_t& value, void* iterator) override;
+
+	/** clean up iterator
+	 *
+	 * @param iterator as returned by get_feature_iterator
+	 */
+	void free_feature_iterator(void* iterator) override;
+
 	/**
 	 * Return the feature type, depending on T.
 	 *
@@ -320,6 +345,16 @@ public:
 	int32_t get_num_vectors() const override;
 
 private:
+	/** iterator over the features of the current example */
+	struct sparse_feature_iterator
+	{
+		/** feature vector */
+		SGSparseVector<T> sv;
+
+		/** feature index */
+		int32_t index;
+	};
+
 	/**
 	 * Initializes members to null values.
 	 * current_length is set to -1.
@@ -4,12 +4,15 @@
  * Authors: Heiko Strathmann
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/streaming/generators/GaussianBlobsDataGenerator.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
-#include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
 
+/* number of examples sampled from one random stream in parallel mode */
+static const index_t BLOCK_SIZE=4096;
+
 GaussianBlobsDataGenerator::GaussianBlobsDataGenerator() :
 		RandomMixin<StreamingDenseFeatures<float64_t>>()
 {
@@ -61,6 +64,7 @@ void GaussianBlobsDataGenerator::init()
 	SG_ADD(&m_stretch, "stretch", "Stretch of blobs");
 	SG_ADD(&m_angle, "angle", "Angle of Blobs");
 	SG_ADD(&m_cholesky, "cholesky", "Cholesky factor of covariance matrix");
+	SG_ADD(&m_parallel, "parallel", "Whether blocks are sampled in parallel");
 
 	m_sqrt_num_blobs=1;
 	m_distance=0;
@@ -71,30 +75,35 @@ void GaussianBlobsDataGenerator::init()
 	m_cholesky(0, 1)=0;
 	m_cholesky(1, 0)=0;
 	m_cholesky(1, 1)=1;
+	m_parallel=false;
 
 	unset_generic();
 }
 
-bool GaussianBlobsDataGenerator::get_next_example()
+template <typename PRNG>
+void GaussianBlobsDataGenerator::sample(float64_t* result, PRNG& prng) const
 {
-	SG_TRACE("entering GaussianBlobsDataGenerator::get_next_example()");
-
-	/* allocate space */
-	SGVector<float64_t> result=SGVector<float64_t>(2);
-
 	UniformIntDistribution<index_t> uniform_int_dist(0, m_sqrt_num_blobs-1);
 	/* sample latent distribution to compute offsets */
-	index_t x_offset=uniform_int_dist(m_prng)*m_distance;
-	index_t y_offset=uniform_int_dist(m_prng)*m_distance;
+	index_t x_offset=uniform_int_dist(prng)*m_distance;
+	index_t y_offset=uniform_int_dist(prng)*m_distance;
 
-	NormalDistribution<float64_t> normal_dist;
 	/* sample from std Gaussian */
-	float64_t x=normal_dist(m_prng);
-	float64_t y=normal_dist(m_prng);
+	float64_t x=m_normal(prng);
+	float64_t y=m_normal(prng);
 
 	/* transform through cholesky and add offset */
 	result[0]=m_cholesky(0, 0)*x+m_cholesky(0, 1)*y+x_offset;
 	result[1]=m_cholesky(1, 0)*x+m_cholesky(1, 1)*y+y_offset;
+}
+
+bool GaussianBlobsDataGenerator::get_next_example()
+{
+	SG_TRACE("entering GaussianBlobsDataGenerator::get_next_example()");
+
+	/* allocate space */
+	SGVector<float64_t> result=SGVector<float64_t>(2);
+	sample(result.vector, m_prng);
 
 	/* save example back to superclass */
 	GaussianBlobsDataGenerator::current_vector=result;
@@ -103,6 +112,36 @@ bool GaussianBlobsDataGenerator::get_next_example()
 	return true;
 }
 
+std::shared_ptr<Features> GaussianBlobsDataGenerator::get_streamed_features(
+		index_t num_elements)
+{
+	require(num_elements>0, "Requested number of feature vectors ({}) must be "
+			"positive", num_elements);
+
+	SGMatrix<float64_t> matrix(2, num_elements);
+	if (!m_parallel)
+	{
+		for (index_t i=0; i<num_elements; ++i)
+			sample(matrix.get_column_vector(i), m_prng);
+	}
+	else
+	{
+		const auto streams=make_streams();
+		const index_t num_blocks=(num_elements+BLOCK_SIZE-1)/BLOCK_SIZE;
+
+		#pragma omp parallel for schedule(static) num_threads(env()->get_num_threads())
+		for (index_t b=0; b<num_blocks; ++b)
+		{
+			auto prng=streams(b);
+			const index_t end=std::min(num_elements, (b+1)*BLOCK_SIZE);
+			for (index_t i=b*BLOCK_SIZE; i<end; ++i)
+				sample(matrix.get_column_vector(i), prng);
+		}
+	}
+
+	return std::make_shared<DenseFeatures<float64_t>>(matrix);
+}
+
 void GaussianBlobsDataGenerator::release_example()
 {
 	SGVector<float64_t> temp=SGVector<float64_t>();
@@ -10,6 +10,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomMixin.h>
 
 namespace shogun
@@ -64,10 +65,47 @@ public:
 	/** release the example when done w/ processing */
 	void release_example() override;
 
+	/** sample a block of examples directly into a feature matrix
+	 *
+	 * The examples are the ones that get_next_example() would return, unless
+	 * parallel sampling is enabled, see set_parallel().
+	 *
+	 * @param num_elements number of examples
+	 * @return dense features with the examples
+	 */
+	std::shared_ptr<Features> get_streamed_features(index_t num_elements) override;
+
+	/** sample the blocks of get_streamed_features() in parallel
+	 *
+	 * Every block of examples is sampled from its own counter-based random
+	 * stream, so the examples depend on the seed but not on the number of
+	 * threads. They differ from the examples of get_next_example().
+	 *
+	 * @param parallel whether to sample in parallel
+	 */
+	void set_parallel(bool parallel)
+	{
+		m_parallel=parallel;
+	}
+
+	/** @return whether blocks are sampled in parallel */
+	bool get_parallel() const
+	{
+		return m_parallel;
+	}
+
 private:
 	/** registers all parameters and initializes variables with defaults */
 	void init();
 
+	/** sample one example
+	 *
+	 * @param result memory for the example
+	 * @param prng random generator
+	 */
+	template <typename PRNG>
+	void sample(float64_t* result, PRNG& prng) const;
+
 protected:
 	/** number of blobs per row/column in the grid */
 	index_t m_sqrt_num_blobs;
@@ -84,6 +122,12 @@ protected:
 	/** Cholesky factor of covariance matrix of single Gaussians. Stored to
 	 * increase sampling performance */
 	SGMatrix<float64_t> m_cholesky;
+
+	/** whether blocks are sampled in parallel */
+	bool m_parallel;
+
+	/** standard normal distribution, its tables are computed once */
+	NormalDistribution<float64_t> m_normal;
 };
 
 }
@@ -5,12 +5,15 @@
  */
 
 #include <shogun/lib/common.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
-#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
 using namespace shogun;
 
+/* number of examples sampled from one random stream in parallel mode */
+static const index_t BLOCK_SIZE=4096;
+
 MeanShiftDataGenerator::MeanShiftDataGenerator() :
 		RandomMixin<StreamingDenseFeatures<float64_t>>()
 {
@@ -46,26 +49,33 @@ void MeanShiftDataGenerator::init()
 	SG_ADD(&m_dimension, "dimension", "Dimension of data");
 	SG_ADD(&m_mean_shift, "mean_shift", "Mean shift in one dimension");
 	SG_ADD(&m_dimension_shift, "m_dimension_shift", "Dimension of mean shift");
+	SG_ADD(&m_parallel, "parallel", "Whether blocks are sampled in parallel");
 
 	m_dimension=0;
 	m_mean_shift=0;
 	m_dimension_shift=0;
+	m_parallel=false;
 
 	unset_generic();
 }
 
+template <typename PRNG>
+void MeanShiftDataGenerator::sample(float64_t* result, PRNG& prng) const
+{
+	/* fill with std normal data */
+	random::fill_array(result, result+m_dimension, m_normal, prng);
+
+	/* mean shift in selected dimension */
+	result[m_dimension_shift]+=m_mean_shift;
+}
+
 bool MeanShiftDataGenerator::get_next_example()
 {
 	SG_TRACE("entering");
 
 	/* allocate space */
 	SGVector<float64_t> result=SGVector<float64_t>(m_dimension);
-
-	/* fill with std normal data */
-	random::fill_array(result, NormalDistribution<float64_t>(), m_prng);
-
-	/* mean shift in selected dimension */
-	result[m_dimension_shift]+=m_mean_shift;
+	sample(result.vector, m_prng);
 
 	/* save example back to superclass */
 	MeanShiftDataGenerator::current_vector=result;
@@ -74,6 +84,36 @@ bool MeanShiftDataGenerator::get_next_example()
 	return true;
 }
 
+std::shared_ptr<Features> MeanShiftDataGenerator::get_streamed_features(
+		index_t num_elements)
+{
+	require(num_elements>0, "Requested number of feature vectors ({}) must be "
+			"positive", num_elements);
+
+	SGMatrix<float64_t> matrix(m_dimension, num_elements);
+	if (!m_parallel)
+	{
+		for (index_t i=0; i<num_elements; ++i)
+			sample(matrix.get_column_vector(i), m_prng);
+	}
+	else
+	{
+		const auto streams=make_streams();
+		const index_t num_blocks=(num_elements+BLOCK_SIZE-1)/BLOCK_SIZE;
+
+		#pragma omp parallel for schedule(static) num_threads(env()->get_num_threads())
+		for (index_t b=0; b<num_blocks; ++b)
+		{
+			auto prng=streams(b);
+			const index_t end=std::min(num_elements, (b+1)*BLOCK_SIZE);
+			for (index_t i=b*BLOCK_SIZE; i<end; ++i)
+				sample(matrix.get_column_vector(i), prng);
+		}
+	}
+
+	return std::make_shared<DenseFeatures<float64_t>>(matrix);
+}
+
 void MeanShiftDataGenerator::release_example()
 {
 	SGVector<float64_t> temp=SGVector<float64_t>();
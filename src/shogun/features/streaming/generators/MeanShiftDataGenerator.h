@@ -11,6 +11,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomMixin.h>
 
 namespace shogun
@@ -68,10 +69,47 @@ public:
 	/** release the example when done w/ processing */
 	void release_example() override;
 
+	/** sample a block of examples directly into a feature matrix
+	 *
+	 * The examples are the ones that get_next_example() would return, unless
+	 * parallel sampling is enabled, see set_parallel().
+	 *
+	 * @param num_elements number of examples
+	 * @return dense features with the examples
+	 */
+	std::shared_ptr<Features> get_streamed_features(index_t num_elements) override;
+
+	/** sample the blocks of get_streamed_features() in parallel
+	 *
+	 * Every block of examples is sampled from its own counter-based random
+	 * stream, so the examples depend on the seed but not on the number of
+	 * threads. They differ from the examples of get_next_example().
+	 *
+	 * @param parallel whether to sample in parallel
+	 */
+	void set_parallel(bool parallel)
+	{
+		m_parallel=parallel;
+	}
+
+	/** @return whether blocks are sampled in parallel */
+	bool get_parallel() const
+	{
+		return m_parallel;
+	}
+
 private:
 	/** registers all parameters and initializes variables with defaults */
 	void init();
 
+	/** sample one example
+	 *
+	 * @param result memory for the example
+	 * @param prng random generator
+	 */
+	template <typename PRNG>
+	void sample(float64_t* result, PRNG& prng) const;
+
 protected:
 	/** model of data to generate */
 	float64_t m_mean_shift;
@@ -81,6 +119,12 @@ protected:
 
 	/** Dimension that is shifted */
 	index_t m_dimension_shift;
+
+	/** whether blocks are sampled in parallel */
+	bool m_parallel;
+
+	/** standard normal distribution, its tables are computed once */
+	NormalDistribution<float64_t> m_normal;
 };
 
 }
@@ -0,0 +1,140 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __ARROWCOLUMN_H__
+#define __ARROWCOLUMN_H__
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_ARROW
+
+#include <shogun/io/SGIO.h>
+
+#include <arrow/api.h>
+
+#include <string>
+#include <utility>
+
+namespace shogun
+{
+namespace io
+{
+	/** raise an error if an Arrow operation failed
+	 *
+	 * @param status status of the operation
+	 * @param what description of the operation
+	 */
+	inline void check_arrow(const arrow::Status& status, const char* what)
+	{
+		if (!status.ok())
+			error("{}: {}", what, status.ToString());
+	}
+
+	/** @return value of a successful Arrow operation, raises an error
+	 * otherwise
+	 *
+	 * @param result result of the operation
+	 * @param what description of the operation
+	 */
+	template <class T>
+	T unwrap_arrow(arrow::Result<T> result, const char* what)
+	{
+		check_arrow(result.status(), what);
+		return std::move(result).ValueUnsafe();
+	}
+
+	/** raise an error unless the column can be copied by copy_arrow_array
+	 *
+	 * @param array the column
+	 * @param name column name used in the error message
+	 */
+	inline void check_arrow_numeric(
+	    const arrow::Array& array, const std::string& name)
+	{
+		const auto& type = *array.type();
+		if (!arrow::is_integer(type.id()) && !arrow::is_floating(type.id()) &&
+		    type.id() != arrow::Type::BOOL)
+			error("Column '{}' has non-numeric type {}.", name, type.ToString());
+		if (type.id() == arrow::Type::HALF_FLOAT)
+			error("Column '{}' has unsupported type {}.", name, type.ToString());
+		if (array.null_count() > 0)
+			error(
+			    "Column '{}' has {} missing values.", name, array.null_count());
+	}
+
+	/** @see check_arrow_numeric */
+	inline void check_arrow_numeric(
+	    const arrow::ChunkedArray& column, const std::string& name)
+	{
+		for (const auto& chunk : column.chunks())
+			check_arrow_numeric(*chunk, name);
+	}
+
+	template <class T, class V>
+	void copy_arrow_values(
+	    const V* values, int64_t begin, int64_t len, T* dst, int64_t stride)
+	{
+		for (int64_t i = 0; i < len; i++)
+			dst[i * stride] = static_cast<T>(values[begin + i]);
+	}
+
+	/** copy rows [begin, begin+len) of a column checked by
+	 * check_arrow_numeric, the i-th value goes to dst[i*stride]
+	 */
+	template <class T>
+	void copy_arrow_array(
+	    const arrow::Array& array, int64_t begin, int64_t len, T* dst,
+	    int64_t stride)
+	{
+#define COPY_ARROW_VALUES(type_id, array_type)                                 \
+	case arrow::Type::type_id:                                                 \
+		copy_arrow_values(                                                     \
+		    static_cast<const arrow::array_type&>(array).raw_values(), begin,  \
+		    len, dst, stride);                                                 \
+		break;
+
+		switch (array.type_id())
+		{
+			COPY_ARROW_VALUES(INT8, Int8Array)
+			COPY_ARROW_VALUES(UINT8, UInt8Array)
+			COPY_ARROW_VALUES(INT16, Int16Array)
+			COPY_ARROW_VALUES(UINT16, UInt16Array)
+			COPY_ARROW_VALUES(INT32, Int32Array)
+			COPY_ARROW_VALUES(UINT32, UInt32Array)
+			COPY_ARROW_VALUES(INT64, Int64Array)
+			COPY_ARROW_VALUES(UINT64, UInt64Array)
+			COPY_ARROW_VALUES(FLOAT, FloatArray)
+			COPY_ARROW_VALUES(DOUBLE, DoubleArray)
+		case arrow::Type::BOOL:
+		{
+			const auto& bools = static_cast<const arrow::BooleanArray&>(array);
+			for (int64_t i = 0; i < len; i++)
+				dst[i * stride] = static_cast<T>(bools.Value(begin + i));
+			break;
+		}
+		default:
+			break;
+		}
+#undef COPY_ARROW_VALUES
+	}
+
+	/** copy all rows of a column checked by check_arrow_numeric, the i-th
+	 * value goes to dst[i*stride]
+	 */
+	template <class T>
+	void copy_arrow_column(
+	    const arrow::ChunkedArray& column, T* dst, int64_t stride)
+	{
+		for (const auto& chunk : column.chunks())
+		{
+			copy_arrow_array(*chunk, 0, chunk->length(), dst, stride);
+			dst += chunk->length() * stride;
+		}
+	}
+} // namespace io
+} // namespace shogun
+#endif // HAVE_ARROW
+#endif // __ARROWCOLUMN_H__
@@ -0,0 +1,400 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_ARROW
+
+#include <shogun/io/ArrowFile.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/ArrowColumn.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/memory.h>
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/reader.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace shogun;
+
+namespace
+{
+	/** @return whether the statistics give the signed range of a column */
+	bool statistics_range(
+	    const parquet::Statistics& stats, float64_t& min, float64_t& max)
+	{
+		if (!stats.HasMinMax() ||
+		    stats.descr()->sort_order() != parquet::SortOrder::SIGNED)
+			return false;
+
+#define STATISTICS_RANGE(type, stats_type)                                     \
+	case parquet::Type::type:                                                  \
+	{                                                                          \
+		const auto& typed = static_cast<const parquet::stats_type&>(stats);    \
+		min = typed.min();                                                     \
+		max = typed.max();                                                     \
+		return true;                                                           \
+	}
+
+		switch (stats.physical_type())
+		{
+			STATISTICS_RANGE(INT32, Int32Statistics)
+			STATISTICS_RANGE(INT64, Int64Statistics)
+			STATISTICS_RANGE(FLOAT, FloatStatistics)
+			STATISTICS_RANGE(DOUBLE, DoubleStatistics)
+		default:
+			return false;
+		}
+#undef STATISTICS_RANGE
+	}
+}
+
+ArrowFile::ArrowFile() : File()
+{
+}
+
+ArrowFile::ArrowFile(const char* fname, char rw, const char* name)
+	: File(fname, rw, name)
+{
+	if (rw!='r')
+		error("ArrowFile '{}' can only be read.", fname);
+}
+
+ArrowFile::~ArrowFile()
+{
+}
+
+void ArrowFile::set_columns(const std::vector<std::string>& columns)
+{
+	m_columns=columns;
+}
+
+void ArrowFile::add_range_predicate(
+		const std::string& column, float64_t min, float64_t max)
+{
+	m_predicates.push_back({column, min, max});
+}
+
+void ArrowFile::clear_predicates()
+{
+	m_predicates.clear();
+}
+
+bool ArrowFile::is_parquet() const
+{
+	require(file, "File invalid.");
+
+	char magic[6]={};
+	rewind(file);
+	const size_t num_read=fread(magic, 1, sizeof(magic), file);
+	rewind(file);
+
+	if (num_read>=4 && !memcmp(magic, "PAR1", 4))
+		return true;
+	if (num_read==6 && !memcmp(magic, "ARROW1", 6))
+		return false;
+
+	error("'{}' is neither a Parquet nor an Arrow IPC file.", filename);
+	return false;
+}
+
+void ArrowFile::open_parquet(
+		std::unique_ptr<parquet::arrow::FileReader>& reader,
+		std::vector<int>& row_groups, std::vector<int>& columns) const
+{
+	auto input=io::unwrap_arrow(
+			arrow::io::ReadableFile::Open(filename), "Opening file");
+
+	parquet::ArrowReaderProperties properties;
+	properties.set_use_threads(env()->get_num_threads()>1);
+
+	parquet::arrow::FileReaderBuilder builder;
+	io::check_arrow(builder.Open(input), "Opening Parquet file");
+	io::check_arrow(
+			builder.properties(properties)->Build(&reader),
+			"Opening Parquet file");
+
+	const auto metadata=reader->parquet_reader()->metadata();
+	const auto* schema=metadata->schema();
+
+	auto column_index=[&](const std::string& name) {
+		const int index=schema->ColumnIndex(name);
+		if (index<0)
+			error("Column '{}' not found in '{}'.", name, filename);
+		return index;
+	};
+
+	columns.clear();
+	if (m_columns.empty())
+	{
+		for (int c=0; c<schema->num_columns(); c++)
+			columns.push_back(c);
+	}
+	else
+	{
+		for (const auto& name : m_columns)
+			columns.push_back(column_index(name));
+		std::sort(columns.begin(), columns.end());
+	}
+
+	std::vector<int> predicate_columns;
+	for (const auto& predicate : m_predicates)
+		predicate_columns.push_back(column_index(predicate.column));
+
+	row_groups.clear();
+	for (int g=0; g<metadata->num_row_groups(); g++)
+	{
+		const auto group=metadata->RowGroup(g);
+		bool may_match=true;
+
+		for (size_t p=0; p<m_predicates.size() && may_match; p++)
+		{
+			const auto chunk=group->ColumnChunk(predicate_columns[p]);
+			if (!chunk->is_stats_set())
+				continue;
+
+			const auto stats=chunk->statistics();
+			float64_t min, max;
+			if (stats && statistics_range(*stats, min, max))
+				may_match=max>=m_predicates[p].min && min<=m_predicates[p].max;
+		}
+
+		if (may_match)
+			row_groups.push_back(g);
+	}
+
+	SG_DEBUG("Reading {} of {} row groups of '{}'.", row_groups.size(),
+			metadata->num_row_groups(), filename);
+}
+
+void ArrowFile::open_ipc(
+		std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+		std::shared_ptr<arrow::Schema>& schema) const
+{
+	/* batches reference the mapped pages, unselected columns are
+	 * never touched */
+	auto input=io::unwrap_arrow(
+			arrow::io::MemoryMappedFile::Open(
+					filename, arrow::io::FileMode::READ),
+			"Mapping file");
+
+	auto options=arrow::ipc::IpcReadOptions::Defaults();
+	options.use_threads=env()->get_num_threads()>1;
+	auto reader=io::unwrap_arrow(
+			arrow::ipc::RecordBatchFileReader::Open(input, options),
+			"Opening Arrow IPC file");
+
+	std::vector<int> columns;
+	if (!m_columns.empty())
+	{
+		for (const auto& name : m_columns)
+		{
+			const int index=reader->schema()->GetFieldIndex(name);
+			if (index<0)
+				error("Column '{}' not found in '{}'.", name, filename);
+			columns.push_back(index);
+		}
+		std::sort(columns.begin(), columns.end());
+	}
+
+	schema=reader->schema();
+	if (!m_columns.empty())
+	{
+		std::vector<std::shared_ptr<arrow::Field>> fields;
+		for (int index : columns)
+			fields.push_back(schema->field(index));
+		schema=arrow::schema(fields);
+	}
+
+	batches.clear();
+	for (int i=0; i<reader->num_record_batches(); i++)
+	{
+		auto batch=io::unwrap_arrow(
+				reader->ReadRecordBatch(i), "Reading record batch");
+		if (!m_columns.empty())
+			batch=io::unwrap_arrow(
+					batch->SelectColumns(columns), "Selecting columns");
+		batches.push_back(batch);
+	}
+}
+
+std::shared_ptr<arrow::RecordBatchReader> ArrowFile::read_batches() const
+{
+	if (is_parquet())
+	{
+		std::unique_ptr<parquet::arrow::FileReader> reader;
+		std::vector<int> row_groups;
+		std::vector<int> columns;
+		open_parquet(reader, row_groups, columns);
+
+		std::unique_ptr<arrow::RecordBatchReader> batches;
+		io::check_arrow(
+				reader->GetRecordBatchReader(row_groups, columns, &batches),
+				"Reading Parquet file");
+
+		/* the batch reader reads through the file reader */
+		struct OwningReader : public arrow::RecordBatchReader
+		{
+			std::shared_ptr<arrow::Schema> schema() const override
+			{
+				return batches->schema();
+			}
+			arrow::Status ReadNext(
+					std::shared_ptr<arrow::RecordBatch>* batch) override
+			{
+				return batches->ReadNext(batch);
+			}
+
+			std::unique_ptr<parquet::arrow::FileReader> reader;
+			std::unique_ptr<arrow::RecordBatchReader> batches;
+		};
+		auto owning=std::make_shared<OwningReader>();
+		owning->reader=std::move(reader);
+		owning->batches=std::move(batches);
+		return owning;
+	}
+
+	std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+	std::shared_ptr<arrow::Schema> schema;
+	open_ipc(batches, schema);
+	return io::unwrap_arrow(
+			arrow::RecordBatchReader::Make(batches, schema),
+			"Reading Arrow IPC file");
+}
+
+std::shared_ptr<arrow::Table> ArrowFile::read_table() const
+{
+	std::shared_ptr<arrow::Table> table;
+	if (is_parquet())
+	{
+		std::unique_ptr<parquet::arrow::FileReader> reader;
+		std::vector<int> row_groups;
+		std::vector<int> columns;
+		open_parquet(reader, row_groups, columns);
+
+		if (row_groups.empty())
+		{
+			std::shared_ptr<arrow::Schema> schema;
+			io::check_arrow(reader->GetSchema(&schema), "Reading Parquet schema");
+
+			std::vector<std::shared_ptr<arrow::Field>> fields;
+			for (int index : columns)
+				fields.push_back(schema->field(index));
+			table=io::unwrap_arrow(
+					arrow::Table::MakeEmpty(arrow::schema(fields)),
+					"Reading Parquet file");
+		}
+		else
+		{
+			/* row groups and their columns are decoded in parallel */
+			io::check_arrow(
+					reader->ReadRowGroups(row_groups, columns, &table),
+					"Reading Parquet file");
+		}
+	}
+	else
+	{
+		std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+		std::shared_ptr<arrow::Schema> schema;
+		open_ipc(batches, schema);
+		table=io::unwrap_arrow(
+				arrow::Table::FromRecordBatches(schema, batches),
+				"Reading Arrow IPC file");
+	}
+
+	if (!m_columns.empty())
+	{
+		std::vector<int> columns;
+		for (const auto& name : m_columns)
+			columns.push_back(table->schema()->GetFieldIndex(name));
+		table=io::unwrap_arrow(
+				table->SelectColumns(columns), "Selecting columns");
+	}
+
+	if (table->num_rows()>std::numeric_limits<int32_t>::max())
+		error("'{}' has {} rows, more than can be indexed.", filename,
+				table->num_rows());
+
+	for (int c=0; c<table->num_columns(); c++)
+		io::check_arrow_numeric(*table->column(c), table->field(c)->name());
+
+	return table;
+}
+
+template <class T>
+void ArrowFile::read_matrix(T*& matrix, int32_t& num_feat, int32_t& num_vec)
+{
+	const auto table=read_table();
+	num_feat=table->num_columns();
+	num_vec=table->num_rows();
+	matrix=SG_MALLOC(T, int64_t(num_feat)*num_vec);
+
+	/* every column fills its own row of the matrix */
+	const int32_t num_threads=env()->get_num_threads();
+#pragma omp parallel for num_threads(num_threads)
+	for (int32_t j=0; j<num_feat; j++)
+		io::copy_arrow_column(*table->column(j), matrix+j, num_feat);
+}
+
+template <class T>
+void ArrowFile::read_vector(T*& vector, int32_t& len)
+{
+	const auto table=read_table();
+	if (table->num_columns()!=1)
+		error("Reading a vector from '{}' needs a single column, not {}.",
+				filename, table->num_columns());
+
+	len=table->num_rows();
+	vector=SG_MALLOC(T, len);
+	io::copy_arrow_column(*table->column(0), vector, 1);
+}
+
+#define GET_VECTOR(sg_type) \
+void ArrowFile::get_vector(sg_type*& vector, int32_t& len) \
+{ \
+	read_vector(vector, len); \
+}
+
+GET_VECTOR(int8_t)
+GET_VECTOR(uint8_t)
+GET_VECTOR(int32_t)
+GET_VECTOR(uint32_t)
+GET_VECTOR(float64_t)
+GET_VECTOR(float32_t)
+GET_VECTOR(floatmax_t)
+GET_VECTOR(int16_t)
+GET_VECTOR(uint16_t)
+GET_VECTOR(int64_t)
+GET_VECTOR(uint64_t)
+#undef GET_VECTOR
+
+#define GET_MATRIX(sg_type) \
+void ArrowFile::get_matrix(sg_type*& matrix, int32_t& num_feat, int32_t& num_vec) \
+{ \
+	read_matrix(matrix, num_feat, num_vec); \
+}
+
+GET_MATRIX(uint8_t)
+GET_MATRIX(int8_t)
+GET_MATRIX(int32_t)
+GET_MATRIX(uint32_t)
+GET_MATRIX(int64_t)
+GET_MATRIX(uint64_t)
+GET_MATRIX(float32_t)
+GET_MATRIX(float64_t)
+GET_MATRIX(floatmax_t)
+GET_MATRIX(int16_t)
+GET_MATRIX(uint16_t)
+#undef GET_MATRIX
+
+#endif // HAVE_ARROW
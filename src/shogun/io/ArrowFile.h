@@ -0,0 +1,207 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __ARROWFILE_H__
+#define __ARROWFILE_H__
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_ARROW
+
+#include <shogun/io/File.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow
+{
+class RecordBatch;
+class RecordBatchReader;
+class Schema;
+class Table;
+}
+
+namespace parquet
+{
+namespace arrow
+{
+class FileReader;
+}
+}
+
+namespace shogun
+{
+
+/** @brief Read only file of numeric columns in the Apache Parquet or the
+ * Arrow IPC file format.
+ *
+ * Every selected column is one feature and every row one vector, columns
+ * must be numeric and must not contain nulls. A single selected column is
+ * read as vector, e.g. for DenseLabels.
+ *
+ * Parquet row groups and columns are decoded in parallel, row groups whose
+ * statistics rule out the range predicates are not read at all. Arrow IPC
+ * files are memory mapped and read without decoding.
+ */
+class ArrowFile : public File
+{
+public:
+	/** default constructor */
+	ArrowFile();
+
+	/** constructor
+	 *
+	 * @param fname filename to open
+	 * @param rw mode, only 'r' is supported
+	 * @param name variable name (e.g. "x" or "/path/to/x")
+	 */
+	ArrowFile(const char* fname, char rw='r', const char* name=NULL);
+
+	/** destructor */
+	~ArrowFile() override;
+
+	/** select the columns to read, in the given order
+	 *
+	 * @param columns column names, empty for all columns
+	 */
+	void set_columns(const std::vector<std::string>& columns);
+
+	/** read only the Parquet row groups whose statistics allow values of
+	 * the column in [min, max], all predicates must hold
+	 *
+	 * @param column column name
+	 * @param min smallest value of interest
+	 * @param max largest value of interest
+	 */
+	void add_range_predicate(const std::string& column, float64_t min, float64_t max);
+
+	/** remove all range predicates */
+	void clear_predicates();
+
+	/** @return selected columns, empty for all */
+	const std::vector<std::string>& get_columns() const
+	{
+		return m_columns;
+	}
+
+#ifndef SWIG // SWIG should skip this
+	/** @return record batches of the selected columns of the rows that
+	 * are read, the column order of the batches is the file's
+	 */
+	std::shared_ptr<arrow::RecordBatchReader> read_batches() const;
+
+	/** @name Vector Access Functions
+	 *
+	 * Functions to access the single selected column as vector.
+	 */
+	//@{
+	void get_vector(int8_t*& vector, int32_t& len) override;
+	void get_vector(uint8_t*& vector, int32_t& len) override;
+	void get_vector(int32_t*& vector, int32_t& len) override;
+	void get_vector(uint32_t*& vector, int32_t& len) override;
+	void get_vector(float64_t*& vector, int32_t& len) override;
+	void get_vector(float32_t*& vector, int32_t& len) override;
+	void get_vector(floatmax_t*& vector, int32_t& len) override;
+	void get_vector(int16_t*& vector, int32_t& len) override;
+	void get_vector(uint16_t*& vector, int32_t& len) override;
+	void get_vector(int64_t*& vector, int32_t& len) override;
+	void get_vector(uint64_t*& vector, int32_t& len) override;
+	//@}
+
+	/** @name Matrix Access Functions
+	 *
+	 * Functions to access the selected columns as matrix with one
+	 * feature per column and one vector per row.
+	 */
+	//@{
+	void get_matrix(
+			uint8_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			int8_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			int32_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			uint32_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			int64_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			uint64_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			float32_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			float64_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			floatmax_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			int16_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	void get_matrix(
+			uint16_t*& matrix, int32_t& num_feat, int32_t& num_vec) override;
+	//@}
+#endif // #ifndef SWIG
+
+	/** @return object name */
+	const char* get_name() const override { return "ArrowFile"; }
+
+private:
+	/** a range predicate on a column */
+	struct RangePredicate
+	{
+		/** column name */
+		std::string column;
+		/** smallest value */
+		float64_t min;
+		/** largest value */
+		float64_t max;
+	};
+
+	/** @return the selected columns of the rows that are read, in the
+	 * order of the selection
+	 */
+	std::shared_ptr<arrow::Table> read_table() const;
+
+	/** open a Parquet file and resolve the selection
+	 *
+	 * @param reader the opened reader
+	 * @param row_groups row groups the predicates allow
+	 * @param columns selected leaf columns, in file order
+	 */
+	void open_parquet(
+			std::unique_ptr<parquet::arrow::FileReader>& reader,
+			std::vector<int>& row_groups, std::vector<int>& columns) const;
+
+	/** read the selected columns of a memory mapped Arrow IPC file
+	 *
+	 * @param batches the record batches
+	 * @param schema schema of the batches
+	 */
+	void open_ipc(
+			std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+			std::shared_ptr<arrow::Schema>& schema) const;
+
+	/** @return whether the file is in the Parquet format, otherwise it is
+	 * in the Arrow IPC file format
+	 */
+	bool is_parquet() const;
+
+	/** read the selected columns into a column-major matrix */
+	template <class T>
+	void read_matrix(T*& matrix, int32_t& num_feat, int32_t& num_vec);
+
+	/** read the single selected column */
+	template <class T>
+	void read_vector(T*& vector, int32_t& len);
+
+private:
+	/** selected columns, empty for all */
+	std::vector<std::string> m_columns;
+
+	/** range predicates of the row groups */
+	std::vector<RangePredicate> m_predicates;
+};
+}
+#endif // HAVE_ARROW
+#endif // __ARROWFILE_H__
@@ -7,12 +7,17 @@
 
 #include <shogun/io/CSVFile.h>
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/ChunkedLineReader.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/io/LineReader.h>
 #include <shogun/io/Parser.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace shogun;
 
 CSVFile::CSVFile()
@@ -77,15 +82,9 @@ int32_t CSVFile::get_stats(int32_t& num_tokens)
 		if (num_tokens==-1)
 		{
 			SGVector<char> line=m_line_reader->read_line();
-			m_tokenizer->set_text(line);
-
-			num_tokens=0;
-			while (m_tokenizer->has_next())
-			{
-				index_t temp_start=0;
-				m_tokenizer->next_token_idx(temp_start);
-				num_tokens++;
-			}
+			std::vector<std::pair<index_t, index_t>> tokens;
+			m_tokenizer->tokenize(line, tokens);
+			num_tokens=tokens.size();
 		}
 		else
 			m_line_reader->skip_line();
@@ -168,51 +167,168 @@ GET_VECTOR(read_long, int64_t)
 GET_VECTOR(read_ulong, uint64_t)
 #undef GET_VECTOR
 
+namespace
+{
+	/** values of the lines of a piece of a block, line after line */
+	template <class T>
+	struct CSVPiece
+	{
+		/** values */
+		std::vector<T> values;
+		/** number of lines with values */
+		int32_t num_lines=0;
+		/** number of values of the first line, -1 without lines */
+		int32_t num_tokens=-1;
+		/** first line with another number of values, -1 if none */
+		int32_t bad_line=-1;
+		/** number of values of bad_line */
+		int32_t bad_num_tokens=0;
+	};
+
+	/** parse the values of all lines from begin to end, lines without
+	 * values are skipped and the rest of a token after a number is
+	 * ignored, like by the Parser
+	 */
+	template <class T>
+	void parse_csv_piece(
+		const char* begin, const char* end, char delimiter, CSVPiece<T>& piece)
+	{
+		auto is_delimiter=[delimiter](char c) {
+			return c==delimiter || c==' ' || c=='\r';
+		};
+
+		piece.values.clear();
+		piece.num_lines=0;
+		piece.num_tokens=-1;
+		piece.bad_line=-1;
+
+		const char* line=begin;
+		while (line<end)
+		{
+			const char* line_stop=ChunkedLineReader::line_end(line, end);
+			int32_t num_tokens=0;
+			const char* p=line;
+			while (true)
+			{
+				while (p<line_stop && is_delimiter(*p))
+					p++;
+				if (p==line_stop)
+					break;
+
+				T value;
+				p=ChunkedLineReader::parse(p, line_stop, value);
+				while (p<line_stop && !is_delimiter(*p))
+					p++;
+				piece.values.push_back(value);
+				num_tokens++;
+			}
+
+			if (num_tokens>0)
+			{
+				if (piece.num_tokens<0)
+					piece.num_tokens=num_tokens;
+				else if (num_tokens!=piece.num_tokens && piece.bad_line<0)
+				{
+					piece.bad_line=piece.num_lines;
+					piece.bad_num_tokens=num_tokens;
+				}
+				piece.num_lines++;
+			}
+			line=line_stop<end ? line_stop+1 : end;
+		}
+	}
+}
+
+template <class T>
+void CSVFile::read_matrix(T*& matrix, int32_t& num_feat, int32_t& num_vec)
+{
+	// the chunked reader reads the file from the beginning on its own
+	m_line_reader->reset();
+	ChunkedLineReader reader(file);
+	reader.skip_lines(m_num_to_skip);
+
+	const int32_t num_threads=env()->get_num_threads();
+	std::vector<CSVPiece<T>> pieces(num_threads);
+
+	T* data=nullptr;
+	int64_t size=0;
+	int64_t capacity=0;
+	int32_t num_lines=0;
+	int32_t num_tokens=-1;
+
+	SG_SET_LOCALE_C;
+
+	while (true)
+	{
+		auto block=reader.next_block(num_threads);
+		if (block.empty())
+			break;
+
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+		for (int32_t k=0; k<(int32_t) block.size(); k++)
+			parse_csv_piece(block[k].begin, block[k].end, m_delimiter, pieces[k]);
+
+		for (int32_t k=0; k<(int32_t) block.size(); k++)
+		{
+			const CSVPiece<T>& piece=pieces[k];
+			if (piece.num_tokens<0)
+				continue;
+
+			if (num_tokens<0)
+				num_tokens=piece.num_tokens;
+
+			if (piece.num_tokens!=num_tokens || piece.bad_line>=0)
+			{
+				SG_RESET_LOCALE;
+				SG_FREE(data);
+				const bool first=piece.num_tokens!=num_tokens;
+				error(
+					"Data line {} of {} has {} values, expected {}.",
+					num_lines+(first ? 0 : piece.bad_line)+1, filename,
+					first ? piece.num_tokens : piece.bad_num_tokens, num_tokens);
+			}
+
+			const int64_t num_values=piece.values.size();
+			if (size+num_values>capacity)
+			{
+				const int64_t new_capacity=std::max(2*capacity, size+num_values);
+				data=SG_REALLOC(T, data, capacity, new_capacity);
+				capacity=new_capacity;
+			}
+			std::copy(piece.values.begin(), piece.values.end(), data+size);
+			size+=num_values;
+			num_lines+=piece.num_lines;
+		}
+	}
+
+	SG_RESET_LOCALE;
+
+	num_tokens=std::max(num_tokens, 0);
+	if (!is_data_transposed)
+	{
+		matrix=SG_REALLOC(T, data, capacity, size);
+		num_feat=num_tokens;
+		num_vec=num_lines;
+	}
+	else
+	{
+		// every line of the file is a feature
+		matrix=SG_MALLOC(T, size);
+		for (int32_t i=0; i<num_lines; i++)
+		{
+			for (int32_t j=0; j<num_tokens; j++)
+				matrix[i+int64_t(j)*num_lines]=data[j+int64_t(i)*num_tokens];
+		}
+		SG_FREE(data);
+		num_feat=num_lines;
+		num_vec=num_tokens;
+	}
+}
+
 #define GET_MATRIX(read_func, sg_type) \
 void CSVFile::get_matrix(sg_type*& matrix, int32_t& num_feat, int32_t& num_vec) \
 { \
-	int32_t num_lines=0; \
-	int32_t num_tokens=-1; \
-	int32_t current_line_idx=0; \
-	SGVector<char> line; \
-	\
-	skip_lines(m_num_to_skip); \
-	num_lines=get_stats(num_tokens); \
-	\
-	SG_SET_LOCALE_C; \
-	\
-	matrix=SG_MALLOC(sg_type, num_lines*num_tokens); \
-	skip_lines(m_num_to_skip); \
-	while (m_line_reader->has_next()) \
-	{ \
-		line=m_line_reader->read_line(); \
-		m_parser->set_text(line); \
-		\
-		for (int32_t i=0; i<num_tokens; i++) \
-		{ \
-			if (!m_parser->has_next()) \
-				return; \
-			\
-			if (!is_data_transposed) \
-				matrix[i+current_line_idx*num_tokens]=m_parser->read_func(); \
-			else \
-				matrix[current_line_idx+i*num_tokens]=m_parser->read_func(); \
-		} \
-		current_line_idx++; \
-	} \
-	\
-	SG_RESET_LOCALE; \
-	\
-	if (!is_data_transposed) \
-	{ \
-		num_feat=num_tokens; \
-		num_vec=num_lines; \
-	} \
-	else \
-	{ \
-		num_feat=num_lines; \
-		num_vec=num_tokens; \
-	} \
+	read_matrix(matrix, num_feat, num_vec); \
 }
 
 GET_MATRIX(read_char, int8_t)
@@ -322,8 +438,8 @@ void CSVFile::set_matrix(const sg_type* matrix, int32_t num_feat, int32_t num_ve
 		{ \
 			int32_t j; \
 			for (j=0; j<num_vec-1; j++) \
-				fprintf(file, "%" format "%c", matrix[i+j*num_vec], m_delimiter); \
-			fprintf(file, "%" format "\n", matrix[i+j*num_vec]); \
+				fprintf(file, "%" format "%c", matrix[i+j*num_feat], m_delimiter); \
+			fprintf(file, "%" format "\n", matrix[i+j*num_feat]); \
 		} \
 	} \
 	\
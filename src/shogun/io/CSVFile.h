@@ -24,6 +24,9 @@ template <class T> class SGSparseVector;
 
 /** @brief Class CSVFile used to read data from comma-separated values (CSV)
  * files. See http://en.wikipedia.org/wiki/Comma-separated_values.
+ *
+ * Matrices are read in blocks of lines that are parsed in parallel, see
+ * ChunkedLineReader.
  */
 class CSVFile : public File
 {
@@ -385,6 +388,11 @@ private:
 	/** skip m_num_skipped lines */
 	void skip_lines(int32_t num_lines);
 
+	/** read the numbers of all lines after the lines to skip, the blocks
+	 * of lines are parsed in parallel */
+	template <class T>
+	void read_matrix(T*& matrix, int32_t& num_feat, int32_t& num_vec);
+
 private:
 	/** object for reading lines from file */
 	std::shared_ptr<LineReader> m_line_reader;
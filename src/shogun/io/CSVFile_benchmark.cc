@@ -0,0 +1,60 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/io/CSVFile.h>
+#include <shogun/machine/Machine_benchmark.h>
+
+namespace shogun
+{
+
+/** writes the training features of MachineFixture to a CSV file */
+class CSVFileFixture : public MachineFixture
+{
+public:
+	void SetUp(const ::benchmark::State& st) override
+	{
+		MachineFixture::SetUp(st);
+		auto file = std::make_shared<CSVFile>(kFileName, 'w');
+		features_train->save(file);
+	}
+
+	void TearDown(const ::benchmark::State& st) override
+	{
+		if (!env()->file_exists(kFileName))
+			env()->delete_file(kFileName);
+		MachineFixture::TearDown(st);
+	}
+
+	static constexpr const char* kFileName = "CSVFile_benchmark.csv";
+};
+
+BENCHMARK_DEFINE_F(CSVFileFixture, CSVFile_Load)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		auto file = std::make_shared<CSVFile>(kFileName);
+		benchmark::DoNotOptimize(
+			std::make_shared<DenseFeatures<float64_t>>(file));
+	}
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(CSVFileFixture, CSVFile_Save)(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		auto file = std::make_shared<CSVFile>(kFileName, 'w');
+		features_train->save(file);
+	}
+	set_counters(state);
+}
+
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(CSVFileFixture, CSVFile_Load), 1000, 100000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(CSVFileFixture, CSVFile_Save), 1000, 100000, 1);
+
+} // namespace shogun
@@ -0,0 +1,177 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/io/ChunkedLineReader.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+ChunkedLineReader::ChunkedLineReader(FILE* stream, int64_t block_size)
+	: m_stream(stream), m_block_size(block_size), m_size(0), m_consumed(0),
+	  m_bytes_read(0), m_file_size(0), m_eof(false)
+{
+	require(stream, "No file to read from.");
+	if (m_block_size<=0)
+		m_block_size=int64_t(16)*1024*1024*env()->get_num_threads();
+
+	const long position=ftell(m_stream);
+	if (position>=0 && fseek(m_stream, 0, SEEK_END)==0)
+	{
+		const long size=ftell(m_stream);
+		if (size>=position)
+			m_file_size=size-position;
+		fseek(m_stream, position, SEEK_SET);
+	}
+}
+
+void ChunkedLineReader::fill(int64_t bytes)
+{
+	if (m_consumed>0)
+	{
+		std::copy(
+			m_buffer.begin()+m_consumed, m_buffer.begin()+m_size,
+			m_buffer.begin());
+		m_size-=m_consumed;
+		m_consumed=0;
+	}
+
+	if (m_eof)
+		return;
+
+	if ((int64_t) m_buffer.size()<m_size+bytes)
+		m_buffer.resize(m_size+bytes);
+
+	const size_t num_read=fread(m_buffer.data()+m_size, 1, bytes, m_stream);
+	if (ferror(m_stream))
+		error("Error reading file.");
+
+	m_size+=num_read;
+	m_bytes_read+=num_read;
+	m_eof=int64_t(num_read)<bytes;
+}
+
+void ChunkedLineReader::skip_lines(int32_t num_lines)
+{
+	for (int32_t i=0; i<num_lines; i++)
+	{
+		// empty lines are not counted
+		while (true)
+		{
+			while (m_consumed<m_size && m_buffer[m_consumed]=='\n')
+				m_consumed++;
+			if (m_consumed<m_size)
+				break;
+			if (m_eof)
+				return;
+			fill(m_block_size);
+		}
+
+		while (true)
+		{
+			const char* begin=m_buffer.data()+m_consumed;
+			const char* newline=line_end(begin, m_buffer.data()+m_size);
+			if (newline<m_buffer.data()+m_size)
+			{
+				m_consumed=newline-m_buffer.data()+1;
+				break;
+			}
+			if (m_eof)
+			{
+				m_consumed=m_size;
+				return;
+			}
+			fill(m_block_size);
+		}
+	}
+}
+
+std::vector<ChunkedLineReader::Piece> ChunkedLineReader::next_block(int32_t num_pieces)
+{
+	fill(m_block_size);
+
+	// the block ends after the last newline, lines longer than a block
+	// make it grow
+	const char* last=nullptr;
+	while (true)
+	{
+		if (m_size==0)
+			return {};
+
+		const char* begin=m_buffer.data();
+		const char* end=begin+m_size;
+		if (m_eof)
+		{
+			last=end;
+			break;
+		}
+
+		const char* p=end;
+		while (p>begin && p[-1]!='\n')
+			p--;
+		if (p>begin)
+		{
+			last=p;
+			break;
+		}
+		fill(m_block_size);
+	}
+
+	const char* begin=m_buffer.data();
+	m_consumed=last-begin;
+
+	std::vector<Piece> pieces;
+	num_pieces=std::max(num_pieces, 1);
+	const int64_t length=last-begin;
+	const char* piece_begin=begin;
+	for (int32_t k=1; k<=num_pieces && piece_begin<last; k++)
+	{
+		const char* piece_end=last;
+		if (k<num_pieces)
+		{
+			const char* target=std::max(piece_begin, begin+length*k/num_pieces);
+			const char* newline=line_end(target, last);
+			piece_end=newline<last ? newline+1 : last;
+		}
+		pieces.push_back({piece_begin, piece_end});
+		piece_begin=piece_end;
+	}
+
+	return pieces;
+}
+
+const char* ChunkedLineReader::parse_float_fallback(
+	const char* begin, const char* end, float64_t& value)
+{
+	char number[128];
+	const int64_t length=std::min<int64_t>(end-begin, sizeof(number)-1);
+	std::memcpy(number, begin, length);
+	number[length]='\0';
+
+	char* last=nullptr;
+	value=std::strtod(number, &last);
+	return begin+(last-number);
+}
+
+const char* ChunkedLineReader::parse_float_fallback(
+	const char* begin, const char* end, floatmax_t& value)
+{
+	char number[128];
+	const int64_t length=std::min<int64_t>(end-begin, sizeof(number)-1);
+	std::memcpy(number, begin, length);
+	number[length]='\0';
+
+	char* last=nullptr;
+#ifdef HAVE_STRTOLD
+	value=std::strtold(number, &last);
+#else
+	value=std::strtod(number, &last);
+#endif
+	return begin+(last-number);
+}
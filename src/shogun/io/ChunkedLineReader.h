@@ -0,0 +1,206 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __CHUNKEDLINEREADER_H__
+#define __CHUNKEDLINEREADER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace shogun
+{
+/** @brief Reads a text file in large blocks of complete lines for parsing
+ * the lines of a block in parallel.
+ *
+ * Every block is split at line boundaries into pieces of about equal size
+ * that can be parsed independently, the lines are scanned with memchr. The
+ * partial line at the end of a block is carried over to the next block, no
+ * memory is allocated per line.
+ *
+ * The number parsers work on the text in place and, unlike strtod, do not
+ * depend on the locale when the standard library implements
+ * std::from_chars for floating point numbers.
+ */
+class ChunkedLineReader
+{
+public:
+	/** complete lines of a block */
+	struct Piece
+	{
+		/** first character */
+		const char* begin;
+		/** one past the last character */
+		const char* end;
+	};
+
+	/** constructor
+	 *
+	 * @param stream file, read from its current position
+	 * @param block_size bytes read at once, 0 for 16 MB per thread
+	 */
+	ChunkedLineReader(FILE* stream, int64_t block_size=0);
+
+	/** skip lines before the first block
+	 *
+	 * @param num_lines number of non-empty lines to skip
+	 */
+	void skip_lines(int32_t num_lines);
+
+	/** read the next block of complete lines
+	 *
+	 * @param num_pieces number of pieces to split the block into
+	 * @return pieces of the block, which stay valid until the next call,
+	 * empty at the end of the file
+	 */
+	std::vector<Piece> next_block(int32_t num_pieces);
+
+	/** @return bytes of the file read so far */
+	int64_t get_num_bytes_read() const
+	{
+		return m_bytes_read;
+	}
+
+	/** @return bytes from the initial position to the end of the file, 0
+	 * if unknown */
+	int64_t get_file_size() const
+	{
+		return m_file_size;
+	}
+
+	/** @return end of the line that begins at begin, the position of the
+	 * newline or end */
+	static const char* line_end(const char* begin, const char* end)
+	{
+		const void* newline=std::memchr(begin, '\n', end-begin);
+		return newline ? (const char*) newline : end;
+	}
+
+	/** parse a number like the Parser of the same type, integers of 64
+	 * bits exactly and all other types as 64 bit float
+	 *
+	 * @param begin first character of the number
+	 * @param end end of the text
+	 * @param value parsed number, 0 if there is none
+	 * @return one past the last character of the number, begin if there is
+	 * none
+	 */
+	template <class T>
+	static const char* parse(const char* begin, const char* end, T& value)
+	{
+		if constexpr (std::is_same<T, int64_t>::value || std::is_same<T, uint64_t>::value)
+		{
+			return parse_integer(begin, end, value);
+		}
+		else if constexpr (std::is_same<T, floatmax_t>::value)
+		{
+			return parse_float(begin, end, value);
+		}
+		else
+		{
+			float64_t v=0;
+			const char* last=parse_float(begin, end, v);
+			value=(T) v;
+			return last;
+		}
+	}
+
+private:
+	/** parse a floating point number, strtod on out of range numbers */
+	template <class T>
+	static const char* parse_float(const char* begin, const char* end, T& value)
+	{
+		value=0;
+		const char* first=begin;
+		if (first<end && *first=='+')
+			first++;
+
+#ifdef __cpp_lib_to_chars
+		auto result=std::from_chars(first, end, value);
+		if (result.ec==std::errc())
+			return result.ptr;
+		if (result.ec!=std::errc::result_out_of_range)
+			return begin;
+#endif
+		return parse_float_fallback(begin, end, value);
+	}
+
+	/** parse an integer, saturated like strtoll and strtoull */
+	template <class T>
+	static const char* parse_integer(const char* begin, const char* end, T& value)
+	{
+		value=0;
+		const char* first=begin;
+		if (first<end && *first=='+')
+			first++;
+
+		if (std::is_unsigned<T>::value && first<end && *first=='-')
+		{
+			int64_t v=0;
+			const char* last=parse_integer(first, end, v);
+			value=(T) v;
+			return last==first ? begin : last;
+		}
+
+		auto result=std::from_chars(first, end, value);
+		if (result.ec==std::errc::result_out_of_range)
+		{
+			value=*first=='-' ? std::numeric_limits<T>::min()
+				: std::numeric_limits<T>::max();
+		}
+		else if (result.ec!=std::errc())
+			return begin;
+		return result.ptr;
+	}
+
+	/** strtod on a terminated copy of the number */
+	static const char* parse_float_fallback(
+		const char* begin, const char* end, float64_t& value);
+
+	/** strtold on a terminated copy of the number */
+	static const char* parse_float_fallback(
+		const char* begin, const char* end, floatmax_t& value);
+
+	/** drop the consumed bytes of the buffer and read up to bytes more
+	 * bytes from the stream */
+	void fill(int64_t bytes);
+
+private:
+	/** file */
+	FILE* m_stream;
+
+	/** bytes read at once */
+	int64_t m_block_size;
+
+	/** current block followed by the partial line at its end */
+	std::vector<char> m_buffer;
+
+	/** bytes of m_buffer holding data */
+	int64_t m_size;
+
+	/** bytes of m_buffer returned by the last next_block() */
+	int64_t m_consumed;
+
+	/** bytes of the file read so far */
+	int64_t m_bytes_read;
+
+	/** bytes from the initial position to the end of the file, 0 if
+	 * unknown */
+	int64_t m_file_size;
+
+	/** whether the end of the file was reached */
+	bool m_eof;
+};
+}
+#endif /* __CHUNKEDLINEREADER_H__ */
@@ -16,19 +16,39 @@
 #include <shogun/io/HDF5File.h>
 #include <shogun/io/SGIO.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
+namespace
+{
+	/** elements per chunk of compressed datasets without a chunk size */
+	const int64_t default_chunk_size=1<<18;
+
+	/** registered ids of the zstd and blosc filter plugins */
+	const H5Z_filter_t zstd_filter=32015;
+	const H5Z_filter_t blosc_filter=32001;
+}
+
 HDF5File::HDF5File()
 {
 	unstable(SOURCE_LOCATION);
 
 	get_boolean_type();
 	h5file = -1;
+	m_chunk_size = 0;
+	m_compression = HDF5_UNCOMPRESSED;
+	m_compression_level = 5;
+	m_range_dataset = -1;
 }
 
 HDF5File::HDF5File(char* fname, char rw, const char* name) : File()
 {
 	get_boolean_type();
+	m_chunk_size = 0;
+	m_compression = HDF5_UNCOMPRESSED;
+	m_compression_level = 5;
+	m_range_dataset = -1;
 	H5Eset_auto2(H5E_DEFAULT, NULL, NULL);
 
 	if (name)
@@ -57,9 +77,102 @@ HDF5File::HDF5File(char* fname, char rw, const char* name) : File()
 
 HDF5File::~HDF5File()
 {
+	if (m_range_dataset>=0)
+		H5Dclose(m_range_dataset);
 	H5Fclose(h5file);
 }
 
+void HDF5File::set_chunk_size(int64_t num_elements)
+{
+	require(num_elements>=0, "Chunk size must not be negative.");
+	m_chunk_size=num_elements;
+}
+
+void HDF5File::set_compression(EHDF5Compression compression, int32_t level)
+{
+	m_compression=compression;
+	m_compression_level=level;
+}
+
+void HDF5File::get_matrix_dims(int32_t& num_feat, int32_t& num_vec, const char* name)
+{
+	hid_t dataset=open_range_dataset(name);
+	int32_t* dims;
+	int32_t ndims;
+	int64_t nelements;
+	get_dims(dataset, dims, ndims, nelements);
+	if (ndims!=2)
+	{
+		SG_FREE(dims);
+		error("Error not a 2-dimensional matrix");
+	}
+	num_feat=dims[0];
+	num_vec=dims[1];
+	SG_FREE(dims);
+}
+
+template <class T>
+void HDF5File::read_matrix_range(T*& matrix, int32_t& num_feat,
+		int32_t first_vec, int32_t& num_vec, const char* name, hid_t h5_type)
+{
+	int32_t total_vec;
+	get_matrix_dims(num_feat, total_vec, name);
+	require(first_vec>=0 && first_vec<=total_vec,
+			"First vector {} is out of range [0, {}].", first_vec, total_vec);
+	require(num_vec>=0, "Number of vectors must not be negative.");
+
+	num_vec=std::min(num_vec, total_vec-first_vec);
+	matrix=SG_MALLOC(T, int64_t(num_feat)*num_vec);
+	if (read_elements(name, h5_type, int64_t(first_vec)*num_feat,
+			int64_t(num_feat)*num_vec, matrix)<0)
+	{
+		SG_FREE(matrix);
+		error("Error reading dataset");
+	}
+}
+
+#define GET_MATRIX_RANGE(sg_type, h5type)											\
+void HDF5File::get_matrix_range(sg_type*& matrix, int32_t& num_feat,				\
+		int32_t first_vec, int32_t& num_vec, const char* name)						\
+{																					\
+	read_matrix_range(matrix, num_feat, first_vec, num_vec, name, h5type);		\
+}
+GET_MATRIX_RANGE(uint8_t, H5T_NATIVE_UINT8)
+GET_MATRIX_RANGE(int8_t, H5T_NATIVE_INT8)
+GET_MATRIX_RANGE(int16_t, H5T_NATIVE_INT16)
+GET_MATRIX_RANGE(uint16_t, H5T_NATIVE_UINT16)
+GET_MATRIX_RANGE(int32_t, H5T_NATIVE_INT32)
+GET_MATRIX_RANGE(uint32_t, H5T_NATIVE_UINT32)
+GET_MATRIX_RANGE(int64_t, H5T_NATIVE_INT64)
+GET_MATRIX_RANGE(uint64_t, H5T_NATIVE_UINT64)
+GET_MATRIX_RANGE(float32_t, H5T_NATIVE_FLOAT)
+GET_MATRIX_RANGE(float64_t, H5T_NATIVE_DOUBLE)
+GET_MATRIX_RANGE(floatmax_t, H5T_NATIVE_LDOUBLE)
+#undef GET_MATRIX_RANGE
+
+void HDF5File::get_vector_range(float64_t*& vector, int32_t first, int32_t& len,
+		const char* name)
+{
+	hid_t dataset=open_range_dataset(name);
+	int32_t* dims;
+	int32_t ndims;
+	int64_t nelements;
+	get_dims(dataset, dims, ndims, nelements);
+	SG_FREE(dims);
+
+	require(first>=0 && first<=nelements,
+			"First element {} is out of range [0, {}].", first, nelements);
+	require(len>=0, "Number of elements must not be negative.");
+
+	len=std::min<int64_t>(len, nelements-first);
+	vector=SG_MALLOC(float64_t, len);
+	if (read_elements(name, H5T_NATIVE_DOUBLE, first, len, vector)<0)
+	{
+		SG_FREE(vector);
+		error("Error reading dataset");
+	}
+}
+
 #define GET_VECTOR(fname, sg_type, datatype)										\
 void HDF5File::fname(sg_type*& vec, int32_t& len)									\
 {																					\
@@ -223,8 +336,11 @@ void HDF5File::fname(const sg_type* vec, int32_t len)						\
 	dataspace=H5Screate_simple(1, &dims, NULL);							\
 	if (dataspace<0)														\
 		error("Could not create hdf5 dataspace");						\
+	hid_t properties=create_dataset_properties(1, &dims);					\
 	dataset=H5Dcreate2(h5file, variable_name, h5type, dataspace, H5P_DEFAULT,\
-			H5P_DEFAULT, H5P_DEFAULT);										\
+			properties, H5P_DEFAULT);										\
+	if (properties!=H5P_DEFAULT)											\
+		H5Pclose(properties);												\
 	if (dataset<0)															\
 	{																		\
 		error("Could not create hdf5 dataset - does"						\
@@ -264,8 +380,11 @@ void HDF5File::fname(const sg_type* matrix, int32_t num_feat, int32_t num_vec)	\
 	dataspace=H5Screate_simple(2, dims, NULL);									\
 	if (dataspace<0)															\
 		error("Could not create hdf5 dataspace");							\
+	hid_t properties=create_dataset_properties(2, dims);						\
 	dataset=H5Dcreate2(h5file, variable_name, h5type, dataspace, H5P_DEFAULT,	\
-			H5P_DEFAULT, H5P_DEFAULT);											\
+			properties, H5P_DEFAULT);											\
+	if (properties!=H5P_DEFAULT)												\
+		H5Pclose(properties);													\
 	if (dataset<0)																\
 	{																			\
 		error("Could not create hdf5 dataset - does"							\
@@ -445,4 +564,182 @@ void HDF5File::create_group_hierarchy()
 	}
 	SG_FREE(vname);
 }
+hid_t HDF5File::create_dataset_properties(int32_t ndims, const hsize_t* dims)
+{
+	if (m_chunk_size==0 && m_compression==HDF5_UNCOMPRESSED)
+		return H5P_DEFAULT;
+
+	for (int32_t i=0; i<ndims; i++)
+	{
+		if (dims[i]==0)
+			return H5P_DEFAULT;
+	}
+
+	/* a chunk is a run of elements in memory order, i.e. whole rows of
+	 * the last dimension, or a part of one row if a row is larger */
+	const hsize_t chunk_size=m_chunk_size>0 ? m_chunk_size : default_chunk_size;
+	hsize_t chunk[2];
+	chunk[ndims-1]=std::min(dims[ndims-1], chunk_size);
+	if (ndims==2)
+		chunk[0]=std::min(dims[0], std::max<hsize_t>(1, chunk_size/chunk[1]));
+
+	hid_t properties=H5Pcreate(H5P_DATASET_CREATE);
+	if (properties<0 || H5Pset_chunk(properties, ndims, chunk)<0)
+		error("Could not create hdf5 dataset properties");
+
+	herr_t status=0;
+	switch (m_compression)
+	{
+		case HDF5_UNCOMPRESSED:
+			break;
+		case HDF5_DEFLATE:
+			status=H5Pset_shuffle(properties);
+			if (status>=0)
+				status=H5Pset_deflate(properties, m_compression_level);
+			break;
+		case HDF5_ZSTD:
+		{
+			if (H5Zfilter_avail(zstd_filter)<=0)
+				error("The hdf5 zstd filter plugin is not available, "
+						"set HDF5_PLUGIN_PATH.");
+			const unsigned int level=m_compression_level;
+			status=H5Pset_shuffle(properties);
+			if (status>=0)
+				status=H5Pset_filter(properties, zstd_filter,
+						H5Z_FLAG_MANDATORY, 1, &level);
+			break;
+		}
+		case HDF5_BLOSC:
+		{
+			if (H5Zfilter_avail(blosc_filter)<=0)
+				error("The hdf5 blosc filter plugin is not available, "
+						"set HDF5_PLUGIN_PATH.");
+			/* the first four values are set by the filter, blosc shuffles
+			 * itself */
+			const unsigned int values[7]={0, 0, 0, 0,
+				(unsigned int) m_compression_level, 1, 0};
+			status=H5Pset_filter(properties, blosc_filter,
+					H5Z_FLAG_MANDATORY, 7, values);
+			break;
+		}
+	}
+
+	if (status<0)
+	{
+		H5Pclose(properties);
+		error("Could not set the hdf5 compression filter");
+	}
+
+	return properties;
+}
+
+hid_t HDF5File::open_range_dataset(const char* name)
+{
+	const char* dataset_name=name ? name : variable_name;
+	if (h5file<0 || !dataset_name)
+		error("File invalid.");
+
+	if (m_range_dataset>=0 && m_range_name==dataset_name)
+		return m_range_dataset;
+
+	if (m_range_dataset>=0)
+	{
+		H5Dclose(m_range_dataset);
+		m_range_dataset=-1;
+	}
+
+	hid_t dataset=H5Dopen2(h5file, dataset_name, H5P_DEFAULT);
+	if (dataset<0)
+		error("Error opening data set");
+
+	/* the chunk cache has to hold the chunks of one range and the chunk
+	 * it shares with the next one, otherwise chunks are decompressed
+	 * again for every range that touches them */
+	hid_t properties=H5Dget_create_plist(dataset);
+	if (H5Pget_layout(properties)==H5D_CHUNKED)
+	{
+		hsize_t chunk[H5S_MAX_RANK];
+		const int32_t ndims=H5Pget_chunk(properties, H5S_MAX_RANK, chunk);
+		hid_t dtype=H5Dget_type(dataset);
+		size_t chunk_bytes=H5Tget_size(dtype);
+		H5Tclose(dtype);
+		for (int32_t i=0; i<ndims; i++)
+			chunk_bytes*=chunk[i];
+
+		hid_t access=H5Pcreate(H5P_DATASET_ACCESS);
+		H5Pset_chunk_cache(access, 521,
+				std::max<size_t>(4*chunk_bytes, 1<<20), 1.0);
+		H5Dclose(dataset);
+		dataset=H5Dopen2(h5file, dataset_name, access);
+		H5Pclose(access);
+		if (dataset<0)
+		{
+			H5Pclose(properties);
+			error("Error opening data set");
+		}
+	}
+	H5Pclose(properties);
+
+	m_range_dataset=dataset;
+	m_range_name=dataset_name;
+	return m_range_dataset;
+}
+
+herr_t HDF5File::read_elements(const char* name, hid_t h5_type, int64_t first,
+		int64_t len, void* buffer)
+{
+	if (len==0)
+		return 0;
+
+	hid_t dataset=open_range_dataset(name);
+	hid_t filespace=H5Dget_space(dataset);
+	if (filespace<0)
+		error("Error obtaining hdf5 dataspace");
+
+	const int32_t ndims=H5Sget_simple_extent_ndims(filespace);
+	if (ndims<1 || ndims>2)
+	{
+		H5Sclose(filespace);
+		error("Error not a vector or matrix (ndims={})", ndims);
+	}
+	hsize_t dims[2];
+	H5Sget_simple_extent_dims(filespace, dims, NULL);
+
+	/* in memory order the range is the tail of a row, whole rows and the
+	 * head of a row, a vector is a single row */
+	const hsize_t row_len=dims[ndims-1];
+	const hsize_t first_row=first/row_len;
+	const hsize_t first_col=first%row_len;
+	const hsize_t end_row=(first+len)/row_len;
+	const hsize_t end_col=(first+len)%row_len;
+
+	H5S_seloper_t op=H5S_SELECT_SET;
+	auto select=[&](hsize_t row, hsize_t col, hsize_t num_rows, hsize_t num_cols)
+	{
+		hsize_t start[2]={row, col};
+		hsize_t count[2]={num_rows, num_cols};
+		H5Sselect_hyperslab(filespace, op, start+2-ndims, NULL,
+				count+2-ndims, NULL);
+		op=H5S_SELECT_OR;
+	};
+
+	if (first_row==end_row)
+		select(first_row, first_col, 1, end_col-first_col);
+	else
+	{
+		select(first_row, first_col, 1, row_len-first_col);
+		if (end_row>first_row+1)
+			select(first_row+1, 0, end_row-first_row-1, row_len);
+		if (end_col>0)
+			select(end_row, 0, 1, end_col);
+	}
+
+	const hsize_t mem_dims=len;
+	hid_t memspace=H5Screate_simple(1, &mem_dims, NULL);
+	herr_t status=H5Dread(dataset, h5_type, memspace, filespace,
+			H5P_DEFAULT, buffer);
+	H5Sclose(memspace);
+	H5Sclose(filespace);
+	return status;
+}
 #endif //  HDF5
@@ -15,6 +15,8 @@
 #include <shogun/io/File.h>
 #include <hdf5.h>
 
+#include <string>
+
 
 namespace shogun
 {
@@ -22,11 +24,27 @@ template <class ST> class SGVector;
 template <class ST> class SGSparseVector;
 struct TSGDataType;
 
+/** compression filter of written HDF5 datasets */
+enum EHDF5Compression
+{
+	/** no filter */
+	HDF5_UNCOMPRESSED,
+	/** deflate (gzip), built into HDF5 */
+	HDF5_DEFLATE,
+	/** zstd, needs the registered filter plugin 32015 */
+	HDF5_ZSTD,
+	/** blosc, needs the registered filter plugin 32001 */
+	HDF5_BLOSC
+};
+
 /** @brief A HDF5 File access class.
  *
  * This class allows reading and writing of vectors and matrices
  * in the hierarchical file format version 5.
  *
+ * Datasets are written contiguously unless a chunk size or a compression
+ * is set. Matrices are chunked along their memory order, so a range of
+ * vectors, see get_matrix_range(), only decompresses the chunks it spans.
  */
 #define IGNORE_IN_CLASSLIST
 IGNORE_IN_CLASSLIST class HDF5File : public File
@@ -46,7 +64,86 @@ public:
 	/** default destructor */
 	~HDF5File() override;
 
+	/** set the chunk size of written datasets
+	 *
+	 * @param num_elements elements per chunk, 0 for contiguous datasets
+	 * or the default chunk size if compressed
+	 */
+	void set_chunk_size(int64_t num_elements);
+
+	/** set the compression of written datasets, compressed datasets are
+	 * chunked
+	 *
+	 * @param compression compression filter
+	 * @param level compression level of the filter
+	 */
+	void set_compression(EHDF5Compression compression, int32_t level=5);
+
+	/** get the dimensions of a matrix without reading it
+	 *
+	 * @param num_feat number of features (returned by reference)
+	 * @param num_vec number of vectors (returned by reference)
+	 * @param name dataset name, NULL for the variable name
+	 */
+	void get_matrix_dims(
+			int32_t& num_feat, int32_t& num_vec, const char* name=NULL);
+
 #ifndef SWIG // SWIG should skip this
+	/** @name Matrix Range Access Functions
+	 *
+	 * Functions to read the vectors first_vec, ..., first_vec+num_vec-1 of
+	 * a matrix, so a matrix can be loaded in pieces. num_vec is clipped to
+	 * the end of the matrix. The dataset stays open between calls, so
+	 * consecutive ranges decompress every chunk once.
+	 */
+	//@{
+	void get_matrix_range(
+			uint8_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			int8_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			int16_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			uint16_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			int32_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			uint32_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			int64_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			uint64_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			float32_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			float64_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	void get_matrix_range(
+			floatmax_t*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name=NULL);
+	//@}
+
+	/** read the elements first, ..., first+len-1 of a vector, len is
+	 * clipped to the end of the vector
+	 *
+	 * @param vector the elements (returned by reference)
+	 * @param first first element
+	 * @param len number of elements (returned by reference)
+	 * @param name dataset name, NULL for the variable name
+	 */
+	void get_vector_range(
+			float64_t*& vector, int32_t first, int32_t& len,
+			const char* name=NULL);
+
 	/** @name Vector Access Functions
 	 *
 	 * Functions to access vectors of one of the several base data types.
@@ -376,11 +473,58 @@ protected:
 	/** create a group hierarchy in the hdf5 file h5file according to name */
 	void create_group_hierarchy();
 
+	/** create the dataset creation properties of a dataset
+	 *
+	 * @param ndims number of dimensions
+	 * @param dims dimensions
+	 *
+	 * @return property list, H5P_DEFAULT for contiguous datasets
+	 */
+	hid_t create_dataset_properties(int32_t ndims, const hsize_t* dims);
+
+	/** open a dataset for range reads, keeps it open for the next call
+	 *
+	 * @param name dataset name, NULL for the variable name
+	 *
+	 * @return the dataset
+	 */
+	hid_t open_range_dataset(const char* name);
+
+	/** read a range of elements in memory order
+	 *
+	 * @param name dataset name, NULL for the variable name
+	 * @param h5_type hdf5 type of the elements in memory
+	 * @param first first element
+	 * @param len number of elements
+	 * @param buffer elements read
+	 *
+	 * @return hdf5 status of the read
+	 */
+	herr_t read_elements(
+			const char* name, hid_t h5_type, int64_t first, int64_t len,
+			void* buffer);
+
+	/** read a range of vectors of a matrix */
+	template <class T>
+	void read_matrix_range(
+			T*& matrix, int32_t& num_feat, int32_t first_vec,
+			int32_t& num_vec, const char* name, hid_t h5_type);
+
 protected:
 	/** hdf5 file handle */
 	hid_t h5file;
 	/** hdf5 type closest to 'bool' */
 	hid_t boolean_type;
+	/** elements per chunk of written datasets, 0 for default */
+	int64_t m_chunk_size;
+	/** compression of written datasets */
+	EHDF5Compression m_compression;
+	/** compression level of written datasets */
+	int32_t m_compression_level;
+	/** dataset kept open for range reads, -1 if none */
+	hid_t m_range_dataset;
+	/** name of m_range_dataset */
+	std::string m_range_name;
 };
 }
 #endif //  HAVE_HDF5
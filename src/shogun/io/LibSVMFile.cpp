@@ -7,7 +7,9 @@
 
 #include <shogun/io/LibSVMFile.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
+#include <shogun/io/ChunkedLineReader.h>
 #include <shogun/io/LineReader.h>
 #include <shogun/io/Parser.h>
 #include <shogun/lib/DelimiterTokenizer.h>
@@ -15,6 +17,7 @@
 #include <shogun/lib/SGVector.h>
 
 #include <algorithm>
+#include <iterator>
 #include <vector>
 
 using namespace shogun;
@@ -144,119 +147,223 @@ GET_LABELED_SPARSE_MATRIX(read_long, int64_t)
 GET_LABELED_SPARSE_MATRIX(read_ulong, uint64_t)
 #undef GET_LABELED_SPARSE_MATRIX
 
+namespace
+{
+	/** vectors of the lines of a piece of a block */
+	template <class T>
+	struct LibSVMPiece
+	{
+		/** sparse vectors */
+		std::vector<SGSparseVector<T>> vectors;
+		/** labels of the vectors */
+		std::vector<SGVector<float64_t>> labels;
+		/** sorted distinct labels */
+		std::vector<float64_t> classes;
+		/** largest feature index */
+		int32_t num_feat=0;
+		/** entries of the current line */
+		std::vector<SGSparseVectorEntry<T>> entries;
+		/** labels of the current line */
+		std::vector<float64_t> label;
+	};
+
+	inline bool is_space(char c)
+	{
+		return c==' ' || c=='\t' || c=='\r';
+	}
+
+	/** @return whether the token is an index:value feature entry */
+	inline bool is_feat_entry(const char* begin, const char* end, char delimiter)
+	{
+		while (begin<end && *begin==delimiter)
+			begin++;
+		while (begin<end && *begin!=delimiter)
+			begin++;
+		while (begin<end && *begin==delimiter)
+			begin++;
+		return begin<end;
+	}
+
+	/** parse the vectors of all non-empty lines from begin to end, the
+	 * tokens between delimiters are read like by the Parser
+	 */
+	template <class T>
+	void parse_libsvm_piece(
+		const char* begin, const char* end, char delimiter_feat,
+		char delimiter_label, bool load_labels, LibSVMPiece<T>& piece)
+	{
+		piece.vectors.clear();
+		piece.labels.clear();
+		piece.classes.clear();
+		piece.num_feat=0;
+
+		const char* line=begin;
+		while (line<end)
+		{
+			const char* line_stop=ChunkedLineReader::line_end(line, end);
+			if (line==line_stop)
+			{
+				line=line_stop<end ? line_stop+1 : end;
+				continue;
+			}
+
+			piece.entries.clear();
+			piece.label.clear();
+			bool first=true;
+			const char* p=line;
+			while (true)
+			{
+				while (p<line_stop && is_space(*p))
+					p++;
+				if (p==line_stop)
+					break;
+
+				const char* token_end=p;
+				while (token_end<line_stop && !is_space(*token_end))
+					token_end++;
+
+				if (first && load_labels &&
+					!is_feat_entry(p, token_end, delimiter_feat))
+				{
+					const char* q=p;
+					while (true)
+					{
+						while (q<token_end && *q==delimiter_label)
+							q++;
+						if (q==token_end)
+							break;
+						float64_t value;
+						q=ChunkedLineReader::parse(q, token_end, value);
+						while (q<token_end && *q!=delimiter_label)
+							q++;
+						piece.label.push_back(value);
+					}
+				}
+				else
+				{
+					const char* q=p;
+					while (q<token_end && *q==delimiter_feat)
+						q++;
+					int32_t feat_index=0;
+					q=ChunkedLineReader::parse(q, token_end, feat_index);
+					while (q<token_end && *q!=delimiter_feat)
+						q++;
+					while (q<token_end && *q==delimiter_feat)
+						q++;
+					T entry=0;
+					if (q<token_end)
+						ChunkedLineReader::parse(q, token_end, entry);
+
+					piece.num_feat=std::max(piece.num_feat, feat_index);
+					piece.entries.push_back({feat_index-1, entry});
+				}
+				first=false;
+				p=token_end;
+			}
+
+			SGSparseVector<T> vec(piece.entries.size());
+			std::copy(piece.entries.begin(), piece.entries.end(), vec.features);
+			piece.vectors.push_back(vec);
+
+			if (load_labels)
+			{
+				SGVector<float64_t> label(piece.label.size());
+				std::copy(piece.label.begin(), piece.label.end(), label.vector);
+				piece.labels.push_back(label);
+				piece.classes.insert(
+					piece.classes.end(), piece.label.begin(), piece.label.end());
+			}
+			line=line_stop<end ? line_stop+1 : end;
+		}
+
+		std::sort(piece.classes.begin(), piece.classes.end());
+		piece.classes.erase(
+			std::unique(piece.classes.begin(), piece.classes.end()),
+			piece.classes.end());
+	}
+}
+
+template <class T>
+void LibSVMFile::read_sparse_matrix(
+	SGSparseVector<T>*& mat_feat, int32_t& num_feat, int32_t& num_vec,
+	SGVector<float64_t>*& multilabel, int32_t& num_classes, bool load_labels)
+{
+	// the chunked reader reads the file from the beginning on its own
+	m_line_reader->reset();
+	ChunkedLineReader reader(file);
+
+	const int32_t num_threads=env()->get_num_threads();
+	std::vector<LibSVMPiece<T>> pieces(num_threads);
+	std::vector<SGSparseVector<T>> vectors;
+	std::vector<SGVector<float64_t>> labels;
+	std::vector<float64_t> classes;
+	std::vector<float64_t> merged;
+	num_feat=0;
+
+	auto pb=SG_PROGRESS(range(0, 1));
+	SG_SET_LOCALE_C;
+
+	while (true)
+	{
+		auto block=reader.next_block(num_threads);
+		if (block.empty())
+			break;
+
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+		for (int32_t k=0; k<(int32_t) block.size(); k++)
+		{
+			parse_libsvm_piece(
+				block[k].begin, block[k].end, m_delimiter_feat,
+				m_delimiter_label, load_labels, pieces[k]);
+		}
+
+		for (int32_t k=0; k<(int32_t) block.size(); k++)
+		{
+			const LibSVMPiece<T>& piece=pieces[k];
+			vectors.insert(vectors.end(), piece.vectors.begin(), piece.vectors.end());
+			labels.insert(labels.end(), piece.labels.begin(), piece.labels.end());
+			num_feat=std::max(num_feat, piece.num_feat);
+
+			merged.clear();
+			std::set_union(
+				classes.begin(), classes.end(), piece.classes.begin(),
+				piece.classes.end(), std::back_inserter(merged));
+			classes.swap(merged);
+		}
+
+		if (reader.get_file_size()>0)
+		{
+			pb.print_absolute(
+				reader.get_num_bytes_read(), reader.get_num_bytes_read(), 0,
+				reader.get_file_size());
+		}
+	}
+	pb.complete_absolute();
+
+	SG_RESET_LOCALE;
+
+	num_vec=vectors.size();
+	num_classes=classes.size();
+	mat_feat=SG_MALLOC(SGSparseVector<T>, num_vec);
+	multilabel=SG_MALLOC(SGVector<float64_t>, num_vec);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		mat_feat[i]=vectors[i];
+		if (load_labels)
+			multilabel[i]=labels[i];
+	}
+
+	io::info("File {} with {} lines successfully read.", filename, num_vec);
+}
+
 #define GET_MULTI_LABELED_SPARSE_MATRIX(read_func, sg_type)                    \
 	void LibSVMFile::get_sparse_matrix(                                       \
 	    SGSparseVector<sg_type>*& mat_feat, int32_t& num_feat,                 \
 	    int32_t& num_vec, SGVector<float64_t>*& multilabel,                    \
 	    int32_t& num_classes, bool load_labels)                                \
 	{                                                                          \
-		num_feat = 0;                                                          \
-                                                                               \
-		io::info("counting line numbers in file {}.", filename);               \
-		num_vec = get_num_lines();                                             \
-		io::info("File {} has {} lines.", filename, num_vec);                  \
-                                                                               \
-		int32_t current_line_ind = 0;                                          \
-		SGVector<char> line;                                                   \
-                                                                               \
-		int32_t num_feat_entries = 0;                                          \
-		std::vector<SGVector<char>> entries_feat;                              \
-		std::vector<float64_t> entries_label;                                  \
-		std::vector<float64_t> classes;                                        \
-                                                                               \
-		mat_feat = SG_MALLOC(SGSparseVector<sg_type>, num_vec);                \
-		multilabel = SG_MALLOC(SGVector<float64_t>, num_vec);                  \
-                                                                               \
-		auto pb = SG_PROGRESS(range(0, num_vec));                              \
-		num_classes = 0;                                                       \
-		SG_SET_LOCALE_C;                                                       \
-                                                                               \
-		while (m_line_reader->has_next())                                      \
-		{                                                                      \
-			num_feat_entries = 0;                                              \
-			entries_feat.clear();                                              \
-			line = m_line_reader->read_line();                                 \
-                                                                               \
-			m_parser->set_tokenizer(m_whitespace_tokenizer);                   \
-			m_parser->set_text(line);                                          \
-                                                                               \
-			SGVector<char> entry_label;                                        \
-			if (load_labels && m_parser->has_next())                           \
-			{                                                                  \
-				entry_label = m_parser->read_string();                         \
-				if (is_feat_entry(entry_label))                                \
-				{                                                              \
-					entries_feat.push_back(entry_label);                       \
-					num_feat_entries++;                                        \
-					entry_label = SGVector<char>(0);                           \
-				}                                                              \
-			}                                                                  \
-                                                                               \
-			while (m_parser->has_next())                                       \
-			{                                                                  \
-				entries_feat.push_back(m_parser->read_string());               \
-				num_feat_entries++;                                            \
-			}                                                                  \
-                                                                               \
-			mat_feat[current_line_ind] =                                       \
-			    SGSparseVector<sg_type>(num_feat_entries);                     \
-			for (int32_t i = 0; i < num_feat_entries; i++)                     \
-			{                                                                  \
-				m_parser->set_tokenizer(m_delimiter_feat_tokenizer);           \
-				m_parser->set_text(entries_feat[i]);                           \
-                                                                               \
-				int32_t feat_index = 0;                                        \
-                                                                               \
-				if (m_parser->has_next())                                      \
-					feat_index = m_parser->read_int();                         \
-                                                                               \
-				sg_type entry = 0;                                             \
-                                                                               \
-				if (m_parser->has_next())                                      \
-					entry = m_parser->read_func();                             \
-                                                                               \
-				if (feat_index > num_feat)                                     \
-					num_feat = feat_index;                                     \
-                                                                               \
-				mat_feat[current_line_ind].features[i].feat_index =            \
-				    feat_index - 1;                                            \
-				mat_feat[current_line_ind].features[i].entry = entry;          \
-			}                                                                  \
-                                                                               \
-			if (load_labels)                                                   \
-			{                                                                  \
-				m_parser->set_tokenizer(m_delimiter_label_tokenizer);          \
-				m_parser->set_text(entry_label);                               \
-                                                                               \
-				int32_t num_label_entries = 0;                                 \
-				entries_label.clear();                                         \
-                                                                               \
-				while (m_parser->has_next())                                   \
-				{                                                              \
-					num_label_entries++;                                       \
-					float64_t label_val = m_parser->read_real();               \
-													\
-					if (std::find(classes.begin(),classes.end(),label_val) == classes.end()) \
-						classes.push_back(label_val);                          \
-                                                                               \
-					entries_label.push_back(label_val);                        \
-				}                                                              \
-				multilabel[current_line_ind] =                                 \
-				    SGVector<float64_t>(num_label_entries);                    \
-                                                                               \
-				for (int32_t j = 0; j < num_label_entries; j++)                \
-					multilabel[current_line_ind][j] = entries_label[j];        \
-			}                                                                  \
-                                                                               \
-			current_line_ind++;                                                \
-			pb.print_progress();                                               \
-		}                                                                      \
-		pb.complete();                                                         \
-		num_classes = classes.size();										   \
-                                                                               \
-		SG_RESET_LOCALE;                                                       \
-                                                                               \
-		io::info("file successfully read");                                    \
+		read_sparse_matrix(                                                    \
+		    mat_feat, num_feat, num_vec, multilabel, num_classes, load_labels); \
 	}
 
 GET_MULTI_LABELED_SPARSE_MATRIX(read_bool, bool)
@@ -381,37 +488,3 @@ SET_MULTI_LABELED_SPARSE_MATRIX(".16Lg", floatmax_t)
 SET_MULTI_LABELED_SPARSE_MATRIX(SCNi16, int16_t)
 SET_MULTI_LABELED_SPARSE_MATRIX(SCNu16, uint16_t)
 #undef SET_MULTI_LABELED_SPARSE_MATRIX
-
-int32_t LibSVMFile::get_num_lines()
-{
-	int32_t num_lines=0;
-	while (m_line_reader->has_next())
-	{
-		m_line_reader->skip_line();
-		num_lines++;
-	}
-	m_line_reader->reset();
-
-	return num_lines;
-}
-
-bool LibSVMFile::is_feat_entry(const SGVector<char>& entry)
-{
-	auto parser = std::make_shared<Parser>();
-	parser->set_tokenizer(m_delimiter_feat_tokenizer);
-	parser->set_text(entry);
-	bool isfeat = false;
-
-	if (parser->has_next())
-	{
-		parser->read_real();
-
-		if (parser->has_next())
-			isfeat = true;
-
-	}
-
-
-
-	return isfeat;
-}
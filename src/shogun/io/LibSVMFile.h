@@ -27,6 +27,9 @@ template <class T> class SGSparseVector;
  * and dim 1    - value  10.0
  *     dim 2    - value 100.2
  *     dim 1000 - value   1.3
+ *
+ * The file is read in blocks of lines that are parsed in parallel, see
+ * ChunkedLineReader.
  */
 class LibSVMFile : public File
 {
@@ -329,11 +332,13 @@ private:
 	/** class initialization */
 	void init_with_defaults();
 
-	/** get number of lines */
-	int32_t get_num_lines();
-
-	/** is it a feature entry */
-	bool is_feat_entry(const SGVector<char>& entry);
+	/** read the vectors of all lines, the blocks of lines are parsed in
+	 * parallel */
+	template <class T>
+	void read_sparse_matrix(
+		SGSparseVector<T>*& mat_feat, int32_t& num_feat, int32_t& num_vec,
+		SGVector<float64_t>*& multilabel, int32_t& num_classes,
+		bool load_labels);
 private:
 	/** delimiter for index and data in sparse entries */
 	char m_delimiter_feat;
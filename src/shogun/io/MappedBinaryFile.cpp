@@ -0,0 +1,373 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/io/MappedBinaryFile.h>
+
+#include <shogun/io/SGIO.h>
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace shogun;
+
+namespace
+{
+	const char magic[8]={'S', 'G', 'M', 'A', 'P', 'B', 'I', 'N'};
+
+	static_assert(
+		sizeof(MappedBinaryFile::Header)==64, "header has to take 64 bytes");
+
+	template <class T>
+	EPrimitiveType ptype_of()
+	{
+		if (std::is_same<T, bool>::value)
+			return PT_BOOL;
+		if (std::is_same<T, char>::value)
+			return PT_CHAR;
+		if (std::is_same<T, int8_t>::value)
+			return PT_INT8;
+		if (std::is_same<T, uint8_t>::value)
+			return PT_UINT8;
+		if (std::is_same<T, int16_t>::value)
+			return PT_INT16;
+		if (std::is_same<T, uint16_t>::value)
+			return PT_UINT16;
+		if (std::is_same<T, int32_t>::value)
+			return PT_INT32;
+		if (std::is_same<T, uint32_t>::value)
+			return PT_UINT32;
+		if (std::is_same<T, int64_t>::value)
+			return PT_INT64;
+		if (std::is_same<T, uint64_t>::value)
+			return PT_UINT64;
+		if (std::is_same<T, float32_t>::value)
+			return PT_FLOAT32;
+		if (std::is_same<T, float64_t>::value)
+			return PT_FLOAT64;
+		if (std::is_same<T, floatmax_t>::value)
+			return PT_FLOATMAX;
+		return PT_UNDEFINED;
+	}
+
+	/** @return offset rounded up to the alignment */
+	int64_t aligned(int64_t offset)
+	{
+		const int64_t a=MappedBinaryFile::alignment;
+		return (offset+a-1)/a*a;
+	}
+
+	/** writes the sections of a file, padding them to the alignment */
+	class SectionWriter
+	{
+	public:
+		SectionWriter(const char* fname) : m_offset(0)
+		{
+			m_file=fopen(fname, "wb");
+			require(m_file, "Could not open {} for writing.", fname);
+		}
+
+		~SectionWriter()
+		{
+			if (m_file)
+				fclose(m_file);
+		}
+
+		/** write bytes at the next aligned offset
+		 *
+		 * @return offset of the bytes
+		 */
+		int64_t write(const void* data, int64_t bytes)
+		{
+			const int64_t offset=aligned(m_offset);
+			const char zeros[MappedBinaryFile::alignment]={};
+			if (offset>m_offset)
+				write_bytes(zeros, offset-m_offset);
+			write_bytes(data, bytes);
+			return offset;
+		}
+
+		/** write bytes right after the previous ones */
+		void append(const void* data, int64_t bytes)
+		{
+			write_bytes(data, bytes);
+		}
+
+		/** write the header at the beginning */
+		void write_header(const MappedBinaryFile::Header& header)
+		{
+			if (fseek(m_file, 0, SEEK_SET)!=0 ||
+				fwrite(&header, sizeof(header), 1, m_file)!=1)
+				error("Error writing file header.");
+
+			if (fclose(m_file)!=0)
+			{
+				m_file=nullptr;
+				error("Error closing file.");
+			}
+			m_file=nullptr;
+		}
+
+	private:
+		void write_bytes(const void* data, int64_t bytes)
+		{
+			if (bytes>0 && fwrite(data, 1, bytes, m_file)!=size_t(bytes))
+				error("Error writing {} bytes.", bytes);
+			m_offset+=bytes;
+		}
+
+	private:
+		FILE* m_file;
+		int64_t m_offset;
+	};
+
+	template <class T>
+	MappedBinaryFile::Header make_header(
+		EMappedStorage storage, int64_t num_features, int64_t num_vectors,
+		int64_t num_entries, const SGVector<float64_t>& labels)
+	{
+		require(
+			ptype_of<T>()!=PT_UNDEFINED, "The type of the values is not supported.");
+		require(
+			labels.vlen==0 || labels.vlen==num_vectors,
+			"Number of labels ({}) has to match the number of vectors ({}).",
+			labels.vlen, num_vectors);
+
+		MappedBinaryFile::Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version=MappedBinaryFile::version;
+		header.primitive_type=ptype_of<T>();
+		header.storage=storage;
+		header.has_labels=labels.vlen>0;
+		header.num_features=num_features;
+		header.num_vectors=num_vectors;
+		header.num_entries=num_entries;
+		return header;
+	}
+}
+
+MappedBinaryFile::MappedBinaryFile() : SGObject(), m_header(nullptr)
+{
+}
+
+MappedBinaryFile::MappedBinaryFile(const char* fname)
+	: SGObject(), m_header(nullptr)
+{
+	m_file=std::make_shared<MemoryMappedFile<uint8_t>>(fname, 'c');
+
+	const int64_t size=m_file->get_size();
+	require(
+		size>=(int64_t) sizeof(Header) &&
+			std::memcmp(m_file->get_map(), magic, sizeof(magic))==0,
+		"{} is not a mapped binary file.", fname);
+
+	m_header=(const Header*) m_file->get_map();
+	require(
+		m_header->version==version,
+		"{} has format version {}, only version {} is supported.", fname,
+		m_header->version, version);
+	require(
+		m_header->storage==MS_DENSE || m_header->storage==MS_SPARSE,
+		"{} has unknown storage {}.", fname, m_header->storage);
+	require(
+		m_header->num_features>=0 && m_header->num_vectors>=0 &&
+			m_header->num_features<=std::numeric_limits<int32_t>::max() &&
+			m_header->num_vectors<=std::numeric_limits<int32_t>::max(),
+		"{} has invalid dimensions {}x{}.", fname, m_header->num_features,
+		m_header->num_vectors);
+
+	const int64_t entry_size=m_header->storage==MS_DENSE
+		? TSGDataType::sizeof_ptype(get_primitive_type())
+		: TSGDataType::sizeof_sparseentry(get_primitive_type());
+	require(entry_size>0, "{} has unknown value type.", fname);
+
+	/* all sections have to lie inside of the file */
+	auto check_section=[&](int64_t offset, int64_t bytes, const char* what) {
+		require(
+			offset>=(int64_t) sizeof(Header) && offset%alignment==0 &&
+				bytes>=0 && offset<=size && bytes<=size-offset,
+			"{} has a truncated {} section.", fname, what);
+	};
+
+	if (m_header->storage==MS_DENSE)
+	{
+		require(
+			m_header->num_entries==m_header->num_features*m_header->num_vectors,
+			"{} has {} values for a {}x{} matrix.", fname,
+			m_header->num_entries, m_header->num_features,
+			m_header->num_vectors);
+	}
+	check_section(m_header->values_offset, m_header->num_entries*entry_size, "values");
+
+	if (m_header->storage==MS_SPARSE)
+	{
+		check_section(
+			m_header->offsets_offset,
+			(m_header->num_vectors+1)*sizeof(int64_t), "offsets");
+
+		const int64_t* offsets=(const int64_t*) at(m_header->offsets_offset);
+		require(
+			offsets[0]==0 && offsets[m_header->num_vectors]==m_header->num_entries,
+			"{} has invalid sparse vector offsets.", fname);
+	}
+
+	if (m_header->has_labels)
+	{
+		check_section(
+			m_header->labels_offset, m_header->num_vectors*sizeof(float64_t),
+			"labels");
+	}
+}
+
+MappedBinaryFile::~MappedBinaryFile()
+{
+}
+
+template <class T>
+void MappedBinaryFile::write(
+	const char* fname, const SGMatrix<T>& matrix,
+	const SGVector<float64_t>& labels)
+{
+	Header header=make_header<T>(
+		MS_DENSE, matrix.num_rows, matrix.num_cols,
+		int64_t(matrix.num_rows)*matrix.num_cols, labels);
+
+	SectionWriter writer(fname);
+	writer.write(&header, sizeof(header));
+	header.values_offset=writer.write(
+		matrix.matrix, header.num_entries*sizeof(T));
+	if (header.has_labels)
+	{
+		header.labels_offset=writer.write(
+			labels.vector, labels.vlen*sizeof(float64_t));
+	}
+	writer.write_header(header);
+}
+
+template <class T>
+void MappedBinaryFile::write(
+	const char* fname, const SGSparseMatrix<T>& matrix,
+	const SGVector<float64_t>& labels)
+{
+	SGVector<int64_t> offsets(matrix.num_vectors+1);
+	offsets[0]=0;
+	for (index_t i=0; i<matrix.num_vectors; i++)
+		offsets[i+1]=offsets[i]+matrix[i].num_feat_entries;
+
+	Header header=make_header<T>(
+		MS_SPARSE, matrix.num_features, matrix.num_vectors,
+		offsets[matrix.num_vectors], labels);
+
+	SectionWriter writer(fname);
+	writer.write(&header, sizeof(header));
+
+	/* contiguous entries are written at once, others vector after vector */
+	bool contiguous=matrix.is_contiguous();
+	for (index_t i=0; i<matrix.num_vectors && contiguous; i++)
+	{
+		contiguous=matrix[i].num_feat_entries==0 ||
+			matrix[i].features==matrix.contiguous_entries+offsets[i];
+	}
+
+	if (contiguous)
+	{
+		header.values_offset=writer.write(
+			matrix.contiguous_entries,
+			header.num_entries*sizeof(SGSparseVectorEntry<T>));
+	}
+	else
+	{
+		header.values_offset=writer.write(nullptr, 0);
+		for (index_t i=0; i<matrix.num_vectors; i++)
+		{
+			writer.append(
+				matrix[i].features,
+				matrix[i].num_feat_entries*sizeof(SGSparseVectorEntry<T>));
+		}
+	}
+
+	header.offsets_offset=writer.write(
+		offsets.vector, offsets.vlen*sizeof(int64_t));
+	if (header.has_labels)
+	{
+		header.labels_offset=writer.write(
+			labels.vector, labels.vlen*sizeof(float64_t));
+	}
+	writer.write_header(header);
+}
+
+void MappedBinaryFile::check_values(
+	EPrimitiveType ptype, EMappedStorage storage) const
+{
+	require(m_header, "No file is mapped.");
+	require(
+		get_storage()==storage, "The file holds a {} matrix.",
+		get_storage()==MS_DENSE ? "dense" : "sparse");
+	require(
+		get_primitive_type()==ptype, "The file holds values of type {}, not {}.",
+		ptype_name(get_primitive_type()), ptype_name(ptype));
+}
+
+template <class T>
+SGMatrix<T> MappedBinaryFile::get_matrix() const
+{
+	check_values(ptype_of<T>(), MS_DENSE);
+	return SGMatrix<T>(
+		(T*) at(m_header->values_offset), m_header->num_features,
+		m_header->num_vectors, false);
+}
+
+template <class T>
+SGSparseMatrix<T> MappedBinaryFile::get_sparse_vectors() const
+{
+	check_values(ptype_of<T>(), MS_SPARSE);
+
+	auto entries=(SGSparseVectorEntry<T>*) at(m_header->values_offset);
+	const int64_t* offsets=(const int64_t*) at(m_header->offsets_offset);
+
+	SGSparseMatrix<T> matrix(m_header->num_features, m_header->num_vectors);
+	for (index_t i=0; i<matrix.num_vectors; i++)
+	{
+		require(
+			offsets[i]<=offsets[i+1],
+			"Invalid offsets of sparse vector {}.", i);
+		matrix[i]=SGSparseVector<T>(
+			entries+offsets[i], offsets[i+1]-offsets[i], false);
+	}
+	return matrix;
+}
+
+SGVector<float64_t> MappedBinaryFile::get_labels() const
+{
+	require(m_header, "No file is mapped.");
+	require(has_labels(), "The file has no labels.");
+	return SGVector<float64_t>(
+		(float64_t*) at(m_header->labels_offset), m_header->num_vectors, false);
+}
+
+#define MAPPED_BINARY_FILE(T)                                                  \
+	template void MappedBinaryFile::write<T>(                                  \
+		const char*, const SGMatrix<T>&, const SGVector<float64_t>&);          \
+	template void MappedBinaryFile::write<T>(                                  \
+		const char*, const SGSparseMatrix<T>&, const SGVector<float64_t>&);    \
+	template SGMatrix<T> MappedBinaryFile::get_matrix<T>() const;              \
+	template SGSparseMatrix<T> MappedBinaryFile::get_sparse_vectors<T>() const;
+MAPPED_BINARY_FILE(bool)
+MAPPED_BINARY_FILE(char)
+MAPPED_BINARY_FILE(int8_t)
+MAPPED_BINARY_FILE(uint8_t)
+MAPPED_BINARY_FILE(int16_t)
+MAPPED_BINARY_FILE(uint16_t)
+MAPPED_BINARY_FILE(int32_t)
+MAPPED_BINARY_FILE(uint32_t)
+MAPPED_BINARY_FILE(int64_t)
+MAPPED_BINARY_FILE(uint64_t)
+MAPPED_BINARY_FILE(float32_t)
+MAPPED_BINARY_FILE(float64_t)
+MAPPED_BINARY_FILE(floatmax_t)
+#undef MAPPED_BINARY_FILE
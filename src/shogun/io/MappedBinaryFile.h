@@ -0,0 +1,194 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __MAPPEDBINARYFILE_H__
+#define __MAPPEDBINARYFILE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/io/MemoryMappedFile.h>
+#include <shogun/lib/DataType.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+
+#include <memory>
+
+namespace shogun
+{
+/** storage of the matrix of a MappedBinaryFile */
+enum EMappedStorage
+{
+	/** column-major dense matrix */
+	MS_DENSE=0,
+	/** sparse vectors one after the other */
+	MS_SPARSE=1
+};
+
+/** @brief Native binary file of a dense or sparse matrix and optional
+ * labels that is used in place through a memory mapping.
+ *
+ * The file starts with a 64 byte Header, followed by sections that start
+ * at multiples of 64 bytes, all in native byte order:
+ *  - the values: the column-major matrix for dense storage, the
+ *    SGSparseVectorEntry of all vectors one after the other for sparse
+ *    storage
+ *  - for sparse storage the offsets of the first entry of every vector,
+ *    num_vectors+1 64 bit integers
+ *  - optionally one 64 bit float label per vector
+ *
+ * The file is mapped copy-on-write: the matrices returned by get_matrix()
+ * and get_sparse_vectors() point into the mapping, so opening takes no
+ * time independent of the size and processes mapping the same file share
+ * its pages in the page cache. Pages written to become private copies, the
+ * file is never changed.
+ *
+ * The returned matrices do not keep the mapping alive, see
+ * MappedDenseFeatures and MappedSparseFeatures for features that do.
+ */
+class MappedBinaryFile : public SGObject
+{
+public:
+	/** file header */
+	struct Header
+	{
+		/** "SGMAPBIN" */
+		char magic[8];
+		/** format version */
+		uint32_t version;
+		/** EPrimitiveType of the values */
+		uint16_t primitive_type;
+		/** EMappedStorage */
+		uint8_t storage;
+		/** 1 if the file has labels */
+		uint8_t has_labels;
+		/** number of features */
+		int64_t num_features;
+		/** number of vectors */
+		int64_t num_vectors;
+		/** number of stored values */
+		int64_t num_entries;
+		/** byte offset of the values */
+		int64_t values_offset;
+		/** byte offset of the vector offsets of sparse storage, 0 for dense */
+		int64_t offsets_offset;
+		/** byte offset of the labels, 0 without labels */
+		int64_t labels_offset;
+	};
+
+	/** current format version */
+	static constexpr uint32_t version=1;
+
+	/** alignment of the header and the sections */
+	static constexpr int64_t alignment=64;
+
+	/** default constructor */
+	MappedBinaryFile();
+
+	/** constructor, maps the file and checks its header
+	 *
+	 * @param fname name of the file
+	 */
+	MappedBinaryFile(const char* fname);
+
+	~MappedBinaryFile() override;
+
+	/** write a dense matrix
+	 *
+	 * @param fname name of the file
+	 * @param matrix matrix, one vector per column
+	 * @param labels one label per vector, may be empty
+	 */
+	template <class T>
+	static void write(
+		const char* fname, const SGMatrix<T>& matrix,
+		const SGVector<float64_t>& labels=SGVector<float64_t>());
+
+	/** write a sparse matrix
+	 *
+	 * @param fname name of the file
+	 * @param matrix matrix
+	 * @param labels one label per vector, may be empty
+	 */
+	template <class T>
+	static void write(
+		const char* fname, const SGSparseMatrix<T>& matrix,
+		const SGVector<float64_t>& labels=SGVector<float64_t>());
+
+	/** @return header of the file */
+	const Header& get_header() const
+	{
+		return *m_header;
+	}
+
+	/** @return storage of the matrix */
+	EMappedStorage get_storage() const
+	{
+		return (EMappedStorage) m_header->storage;
+	}
+
+	/** @return primitive type of the values */
+	EPrimitiveType get_primitive_type() const
+	{
+		return (EPrimitiveType) m_header->primitive_type;
+	}
+
+	/** @return number of features */
+	int32_t get_num_features() const
+	{
+		return m_header->num_features;
+	}
+
+	/** @return number of vectors */
+	int32_t get_num_vectors() const
+	{
+		return m_header->num_vectors;
+	}
+
+	/** @return whether the file has labels */
+	bool has_labels() const
+	{
+		return m_header->has_labels;
+	}
+
+	/** @return dense matrix in the mapping, of the values of type T */
+	template <class T>
+	SGMatrix<T> get_matrix() const;
+
+	/** @return sparse vectors in the mapping, of the values of type T */
+	template <class T>
+	SGSparseMatrix<T> get_sparse_vectors() const;
+
+	/** @return labels in the mapping */
+	SGVector<float64_t> get_labels() const;
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "MappedBinaryFile";
+	}
+
+private:
+	/** @return pointer to byte offset of the mapping */
+	uint8_t* at(int64_t offset) const
+	{
+		return m_file->get_map()+offset;
+	}
+
+	/** require the values to be of type T and the given storage */
+	void check_values(EPrimitiveType ptype, EMappedStorage storage) const;
+
+private:
+	/** mapping of the file */
+	std::shared_ptr<MemoryMappedFile<uint8_t>> m_file;
+
+	/** header in the mapping */
+	const Header* m_header;
+};
+}
+#endif /* __MAPPEDBINARYFILE_H__ */
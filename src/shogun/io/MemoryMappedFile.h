@@ -13,6 +13,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/base/SGObject.h>
 
+#include <algorithm>
 #include <stdio.h>
 #include <string.h>
 #ifndef _MSC_VER
@@ -48,10 +49,14 @@ template <class T> class MemoryMappedFile : public SGObject
 
 		/** constructor
 		 *
-		 * open a memory mapped file for read or read/write mode
+		 * open a memory mapped file for read, read/write or copy-on-write
+		 * mode
 		 *
 		 * @param fname name of file, zero terminated string
-		 * @param flag determines read or read write mode (can be 'r' or 'w')
+		 * @param flag determines read, read write or copy-on-write mode (can
+		 *   be 'r', 'w' or 'c'); in copy-on-write mode the mapping can be
+		 *   written to, the written pages become private copies and the file
+		 *   is left unchanged
 		 * @param fsize overestimate of expected file size (in bytes)
 		 *   when opened in write  mode; Underestimating the file size will
 		 *   result in an error to occur upon writing. In case the exact file
@@ -62,7 +67,9 @@ template <class T> class MemoryMappedFile : public SGObject
 		MemoryMappedFile(const char* fname, char flag='r', int64_t fsize=0)
 		: SGObject()
 		{
-			require(flag=='w' || flag=='r', "Only 'r' and 'w' flags are allowed");
+			require(
+				flag=='w' || flag=='r' || flag=='c',
+				"Only 'r', 'w' and 'c' flags are allowed");
 
 			last_written_byte=0;
 			rw=flag;
@@ -81,6 +88,11 @@ template <class T> class MemoryMappedFile : public SGObject
 				mmap_prot = PAGE_READWRITE;
 				mmap_flags = FILE_MAP_ALL_ACCESS;
 			}
+			else if (rw=='c')
+			{
+				mmap_prot = PAGE_WRITECOPY;
+				mmap_flags = FILE_MAP_COPY;
+			}
 
 			fd = CreateFile(fname, open_flags, share_mode, 0, create_disp, FILE_ATTRIBUTE_NORMAL, NULL);
 			if (rw=='w' && fsize)
@@ -113,6 +125,8 @@ template <class T> class MemoryMappedFile : public SGObject
 				mmap_prot=PROT_READ|PROT_WRITE;
 				mmap_flags=MAP_SHARED;
 			}
+			else if (rw=='c')
+				mmap_prot=PROT_READ|PROT_WRITE;
 
 			fd = open(fname, open_flags, S_IRWXU | S_IRWXG | S_IRWXO);
 			if (fd == -1)
@@ -197,6 +211,27 @@ template <class T> class MemoryMappedFile : public SGObject
 			return length;
 		}
 
+		/** hint the operating system that the given range of objects will
+		 * be accessed soon, so that their pages get read ahead of time
+		 *
+		 * @param index index of the first object of type T
+		 * @param num number of objects
+		 */
+		void prefetch(uint64_t index, uint64_t num) const
+		{
+#ifndef _MSC_VER
+			uint64_t begin=index*sizeof(T);
+			uint64_t end=std::min<uint64_t>((index+num)*sizeof(T), length);
+			if (begin>=end)
+				return;
+
+			// madvise requires page aligned addresses
+			const uint64_t page_size=sysconf(_SC_PAGESIZE);
+			begin-=begin%page_size;
+			madvise(((char*) address)+begin, end-begin, MADV_WILLNEED);
+#endif
+		}
+
 		/** get next line from file
 		 *
 		 * The returned line may be modfied in case the file was opened
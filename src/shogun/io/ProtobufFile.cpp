@@ -8,16 +8,61 @@
 
 #ifdef HAVE_PROTOBUF
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/io/SGIO.h>
 
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
-#include <shogun/lib/SGVector.h>
 #include <google/protobuf/message.h>
 
+#include <algorithm>
+#include <exception>
+
 using namespace shogun;
 
+namespace
+{
+	/* message type of the chunks of elements of type T */
+	template <class T> struct ChunkOf;
+	template <> struct ChunkOf<bool> { typedef BoolChunk type; };
+	template <> struct ChunkOf<int8_t> { typedef Int32Chunk type; };
+	template <> struct ChunkOf<uint8_t> { typedef UInt32Chunk type; };
+	template <> struct ChunkOf<char> { typedef UInt32Chunk type; };
+	template <> struct ChunkOf<int16_t> { typedef Int32Chunk type; };
+	template <> struct ChunkOf<uint16_t> { typedef UInt32Chunk type; };
+	template <> struct ChunkOf<int32_t> { typedef Int32Chunk type; };
+	template <> struct ChunkOf<uint32_t> { typedef UInt32Chunk type; };
+	template <> struct ChunkOf<int64_t> { typedef Int64Chunk type; };
+	template <> struct ChunkOf<uint64_t> { typedef UInt64Chunk type; };
+	template <> struct ChunkOf<float32_t> { typedef Float32Chunk type; };
+	template <> struct ChunkOf<float64_t> { typedef Float64Chunk type; };
+	template <> struct ChunkOf<floatmax_t> { typedef Float64Chunk type; };
+
+	/* number of chunks every thread decodes or encodes per batch */
+	const int64_t CHUNKS_PER_THREAD=2;
+
+	/* index of the vector holding an element, given the offsets of the
+	 * vectors in the list of all elements */
+	index_t vector_of(const std::vector<uint64_t>& offsets, uint64_t element)
+	{
+		return std::upper_bound(offsets.begin(), offsets.end(), element)-
+			offsets.begin()-1;
+	}
+
+	/* offsets of vectors of the given lengths in the list of all elements */
+	template <class Lengths>
+	std::vector<uint64_t> offsets_of(index_t num_vectors, Lengths lengths)
+	{
+		std::vector<uint64_t> offsets(num_vectors+1);
+		offsets[0]=0;
+		for (index_t i=0; i<num_vectors; i++)
+			offsets[i+1]=offsets[i]+lengths(i);
+		return offsets;
+	}
+}
+
 ProtobufFile::ProtobufFile()
 {
 	init();
@@ -37,15 +82,12 @@ ProtobufFile::ProtobufFile(const char* fname, char rw, const char* name) :
 
 ProtobufFile::~ProtobufFile()
 {
-	SG_FREE(buffer);
 }
 
 void ProtobufFile::init()
 {
 	version=1;
 	message_size=1024*1024;
-
-	buffer=SG_MALLOC(uint8_t, message_size*sizeof(uint32_t));
 }
 
 #define GET_VECTOR(sg_type) \
@@ -410,28 +452,53 @@ WRITE_STRING_LIST_HEADER(uint16_t)
 #undef WRITE_STRING_LIST_HEADER
 
 void ProtobufFile::read_message(google::protobuf::Message& message)
+{
+	read_raw_message(buffer);
+
+	// try to parse message from read data
+	require(message.ParseFromString(buffer), "cannot parse header");
+}
+
+void ProtobufFile::write_message(const google::protobuf::Message& message)
+{
+	require(message.SerializeToString(&buffer), "cannot serialize message");
+	write_raw_message(buffer);
+}
+
+uint32_t ProtobufFile::read_message_size()
 {
 	uint32_t bytes_read=0;
 	uint32_t msg_size=0;
 
-	// read size of message
 	bytes_read=fread(uint_buffer, sizeof(char), sizeof(uint32_t), file);
 	require(bytes_read==sizeof(uint32_t), "IO error");
 	msg_size=read_big_endian_uint(uint_buffer, sizeof(uint32_t));
 	require(msg_size>0, "message size should be more than zero");
 
-	// read message
-	bytes_read=fread(buffer, sizeof(char), msg_size, file);
+	return msg_size;
+}
+
+void ProtobufFile::read_raw_message(std::string& bytes)
+{
+	uint32_t msg_size=read_message_size();
+	bytes.resize(msg_size);
+	uint32_t bytes_read=fread(&bytes[0], sizeof(char), msg_size, file);
 	require(bytes_read==msg_size, "IO error");
+}
 
-	// try to parse message from read data
-	require(message.ParseFromArray(buffer, msg_size), "cannot parse header");
+void ProtobufFile::skip_messages(int64_t num_messages)
+{
+	for (int64_t i=0; i<num_messages; i++)
+	{
+		uint32_t msg_size=read_message_size();
+		require(fseek(file, msg_size, SEEK_CUR)==0, "IO error");
+	}
 }
 
-void ProtobufFile::write_message(const google::protobuf::Message& message)
+void ProtobufFile::write_raw_message(const std::string& bytes)
 {
 	uint32_t bytes_write=0;
-	uint32_t msg_size=message.ByteSize();
+	uint32_t msg_size=bytes.size();
 
 	// write size of message
 	write_big_endian_uint(msg_size, uint_buffer, sizeof(uint32_t));
@@ -439,259 +506,392 @@ void ProtobufFile::write_message(const google::protobuf::Message& message)
 	require(bytes_write==sizeof(uint32_t), "IO error");
 
 	// write serialized message
-	message.SerializeToArray(buffer, msg_size);
-	bytes_write=fwrite(buffer, sizeof(char), msg_size, file);
+	bytes_write=fwrite(bytes.data(), sizeof(char), msg_size, file);
 	require(bytes_write==msg_size, "IO error");
 }
 
-#define READ_MEMORY_BLOCK(chunk_type, sg_type) \
-void ProtobufFile::read_memory_block(sg_type*& vector, uint64_t len, int32_t num_messages) \
-{ \
-	vector=SG_MALLOC(sg_type, len); \
-	\
-	chunk_type chunk; \
-	int32_t elements_in_message=message_size/sizeof(sg_type); \
-	for (int32_t i=0; i<num_messages; i++) \
-	{ \
-		read_message(chunk); \
-		\
-		int32_t num_elements_to_read=0; \
-		if ((len-(i+1)*elements_in_message)<=0) \
-			num_elements_to_read=len-i*elements_in_message; \
-		else \
-			num_elements_to_read=elements_in_message; \
-		\
-		for (int32_t j=0; j<num_elements_to_read; j++) \
-			vector[j+i*elements_in_message]=chunk.data(j); \
-	} \
+void ProtobufFile::read_chunks(
+	int64_t first_chunk, int64_t num_chunks, int32_t messages_per_chunk,
+	const std::function<void(int64_t, const std::vector<std::string>&)>& decode)
+{
+	const int32_t num_threads=env()->get_num_threads();
+	const int64_t batch_size=num_threads*CHUNKS_PER_THREAD;
+	std::vector<std::vector<std::string>> batch(
+		std::min(batch_size, num_chunks),
+		std::vector<std::string>(messages_per_chunk));
+
+	for (int64_t start=0; start<num_chunks; start+=batch_size)
+	{
+		const int64_t end=std::min(start+batch_size, num_chunks);
+		for (int64_t c=start; c<end; c++)
+		{
+			for (auto& bytes : batch[c-start])
+				read_raw_message(bytes);
+		}
+
+		std::exception_ptr exception;
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads) \
+			if (end-start>1)
+		for (int64_t c=start; c<end; c++)
+		{
+			try
+			{
+				decode(first_chunk+c, batch[c-start]);
+			}
+			catch (...)
+			{
+				#pragma omp critical
+				exception=std::current_exception();
+			}
+		}
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+}
+
+void ProtobufFile::write_chunks(
+	int64_t num_chunks, int32_t messages_per_chunk,
+	const std::function<void(int64_t, std::vector<std::string>&)>& encode)
+{
+	const int32_t num_threads=env()->get_num_threads();
+	const int64_t batch_size=num_threads*CHUNKS_PER_THREAD;
+	std::vector<std::vector<std::string>> batch(
+		std::min(batch_size, num_chunks),
+		std::vector<std::string>(messages_per_chunk));
+
+	for (int64_t start=0; start<num_chunks; start+=batch_size)
+	{
+		const int64_t end=std::min(start+batch_size, num_chunks);
+
+		std::exception_ptr exception;
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads) \
+			if (end-start>1)
+		for (int64_t c=start; c<end; c++)
+		{
+			try
+			{
+				encode(c, batch[c-start]);
+			}
+			catch (...)
+			{
+				#pragma omp critical
+				exception=std::current_exception();
+			}
+		}
+		if (exception)
+			std::rethrow_exception(exception);
+
+		for (int64_t c=start; c<end; c++)
+		{
+			for (const auto& bytes : batch[c-start])
+				write_raw_message(bytes);
+		}
+	}
+}
+
+template <class T>
+int64_t ProtobufFile::elements_in_message() const
+{
+	return message_size/sizeof(T);
 }
 
-READ_MEMORY_BLOCK(Int32Chunk, int8_t)
-READ_MEMORY_BLOCK(UInt32Chunk, uint8_t)
-READ_MEMORY_BLOCK(UInt32Chunk, char)
-READ_MEMORY_BLOCK(Int32Chunk, int32_t)
-READ_MEMORY_BLOCK(UInt32Chunk, uint32_t)
-READ_MEMORY_BLOCK(Float32Chunk, float32_t)
-READ_MEMORY_BLOCK(Float64Chunk, float64_t)
-READ_MEMORY_BLOCK(Float64Chunk, floatmax_t)
-READ_MEMORY_BLOCK(Int32Chunk, int16_t)
-READ_MEMORY_BLOCK(UInt32Chunk, uint16_t)
-READ_MEMORY_BLOCK(Int64Chunk, int64_t)
-READ_MEMORY_BLOCK(UInt64Chunk, uint64_t)
-#undef READ_MEMORY_BLOCK
-
-#define WRITE_MEMORY_BLOCK(chunk_type, sg_type) \
-void ProtobufFile::write_memory_block(const sg_type* vector, uint64_t len, int32_t num_messages) \
-{ \
-	chunk_type chunk; \
-	int32_t elements_in_message=message_size/sizeof(sg_type); \
-	for (int32_t i=0; i<num_messages; i++) \
-	{ \
-		\
-		int32_t num_elements_to_write=0; \
-		if ((len-(i+1)*elements_in_message)<=0) \
-			num_elements_to_write=len-i*elements_in_message; \
-		else \
-			num_elements_to_write=elements_in_message; \
-		\
-		for (int32_t j=0; j<num_elements_to_write; j++) \
-			chunk.add_data(vector[j+i*elements_in_message]); \
-		\
-		write_message(chunk); \
-		chunk.Clear(); \
-	} \
-}
+template <class T>
+void ProtobufFile::read_elements(T* dst, uint64_t len, uint64_t begin, uint64_t end)
+{
+	if (begin==end)
+		return;
+
+	const int64_t n=elements_in_message<T>();
+	const int64_t first_chunk=begin/n;
+	const int64_t last_chunk=(end+n-1)/n;
+	skip_messages(first_chunk);
+	read_chunks(first_chunk, last_chunk-first_chunk, 1,
+		[&](int64_t c, const std::vector<std::string>& messages)
+		{
+			typename ChunkOf<T>::type chunk;
+			require(chunk.ParseFromString(messages[0]), "cannot parse chunk");
+
+			const uint64_t chunk_begin=c*n;
+			const uint64_t chunk_end=std::min<uint64_t>(chunk_begin+n, len);
+			// earlier versions padded the last chunk to the full size
+			require(uint64_t(chunk.data_size())>=chunk_end-chunk_begin,
+				"Chunk {} has {} elements, expected {}", c, chunk.data_size(),
+				chunk_end-chunk_begin);
+
+			const uint64_t to=std::min(end, chunk_end);
+			for (uint64_t k=std::max(begin, chunk_begin); k<to; k++)
+				dst[k-begin]=static_cast<T>(chunk.data(k-chunk_begin));
+		});
+}
+
+template <class T>
+void ProtobufFile::read_memory_block(T*& vector, uint64_t len, int32_t num_messages)
+{
+	require(num_messages==compute_num_messages(len, sizeof(T)),
+		"Block of {} elements should have {} chunks, not {}", len,
+		compute_num_messages(len, sizeof(T)), num_messages);
 
-WRITE_MEMORY_BLOCK(Int32Chunk, int8_t)
-WRITE_MEMORY_BLOCK(UInt32Chunk, uint8_t)
-WRITE_MEMORY_BLOCK(UInt32Chunk, char)
-WRITE_MEMORY_BLOCK(Int32Chunk, int32_t)
-WRITE_MEMORY_BLOCK(UInt64Chunk, uint32_t)
-WRITE_MEMORY_BLOCK(Int64Chunk, int64_t)
-WRITE_MEMORY_BLOCK(UInt64Chunk, uint64_t)
-WRITE_MEMORY_BLOCK(Float32Chunk, float32_t)
-WRITE_MEMORY_BLOCK(Float64Chunk, float64_t)
-WRITE_MEMORY_BLOCK(Float64Chunk, floatmax_t)
-WRITE_MEMORY_BLOCK(Int32Chunk, int16_t)
-WRITE_MEMORY_BLOCK(UInt32Chunk, uint16_t)
-#undef WRITE_MEMORY_BLOCK
-
-#define READ_SPARSE_MATRIX(chunk_type, sg_type) \
-void ProtobufFile::read_sparse_matrix( \
-			SGSparseVector<sg_type>*& matrix, const SparseMatrixHeader& data_header) \
-{ \
-	matrix=SG_MALLOC(SGSparseVector<sg_type>, data_header.num_vectors()); \
-	\
-	UInt64Chunk feat_index_chunk; \
-	chunk_type entry_chunk; \
-	read_message(feat_index_chunk); \
-	read_message(entry_chunk); \
-	\
-	int32_t elements_in_message=message_size/sizeof(sg_type); \
-	int32_t buffer_counter=0; \
-	for (uint32_t i=0; i<data_header.num_vectors(); i++) \
-	{ \
-		matrix[i]=SGSparseVector<sg_type>(data_header.num_feat_entries(i)); \
-		for (int32_t j=0; j<matrix[i].num_feat_entries; j++) \
-		{ \
-			matrix[i].features[j].feat_index=feat_index_chunk.data(buffer_counter); \
-			matrix[i].features[j].entry=entry_chunk.data(buffer_counter); \
-			buffer_counter++; \
-			\
-			if (buffer_counter==elements_in_message) \
-			{ \
-				read_message(feat_index_chunk); \
-				read_message(entry_chunk); \
-				buffer_counter=0; \
-			} \
-		} \
-	} \
+	vector=SG_MALLOC(T, len);
+	read_elements(vector, len, 0, len);
 }
 
-READ_SPARSE_MATRIX(BoolChunk, bool)
-READ_SPARSE_MATRIX(Int32Chunk, int8_t)
-READ_SPARSE_MATRIX(UInt32Chunk, uint8_t)
-READ_SPARSE_MATRIX(UInt32Chunk, char)
-READ_SPARSE_MATRIX(Int32Chunk, int32_t)
-READ_SPARSE_MATRIX(UInt32Chunk, uint32_t)
-READ_SPARSE_MATRIX(Float32Chunk, float32_t)
-READ_SPARSE_MATRIX(Float64Chunk, float64_t)
-READ_SPARSE_MATRIX(Float64Chunk, floatmax_t)
-READ_SPARSE_MATRIX(Int32Chunk, int16_t)
-READ_SPARSE_MATRIX(UInt32Chunk, uint16_t)
-READ_SPARSE_MATRIX(Int64Chunk, int64_t)
-READ_SPARSE_MATRIX(UInt64Chunk, uint64_t)
-#undef READ_SPARSE_MATRIX
-
-#define WRITE_SPARSE_MATRIX(chunk_type, sg_type) \
-void ProtobufFile::write_sparse_matrix( \
-			const SGSparseVector<sg_type>* matrix, int32_t num_vec) \
-{ \
-	UInt64Chunk feat_index_chunk; \
-	chunk_type entry_chunk; \
-	int32_t elements_in_message=message_size/sizeof(sg_type); \
-	int32_t buffer_counter=0; \
-	for (int32_t i=0; i<num_vec; i++) \
-	{ \
-		for (int32_t j=0; j<matrix[i].num_feat_entries; j++) \
-		{ \
-			feat_index_chunk.add_data(matrix[i].features[j].feat_index); \
-			entry_chunk.add_data(matrix[i].features[j].entry); \
-			buffer_counter++; \
-			\
-			if (buffer_counter==elements_in_message) \
-			{ \
-				write_message(feat_index_chunk); \
-				write_message(entry_chunk); \
-				feat_index_chunk.Clear(); \
-				entry_chunk.Clear(); \
-				buffer_counter=0; \
-			} \
-		} \
-	} \
-	\
-	if (buffer_counter!=0) \
-	{ \
-		write_message(feat_index_chunk); \
-		write_message(entry_chunk); \
-	} \
-}
+template <class T>
+void ProtobufFile::write_memory_block(const T* vector, uint64_t len, int32_t num_messages)
+{
+	const int64_t n=elements_in_message<T>();
+	write_chunks(num_messages, 1,
+		[&](int64_t c, std::vector<std::string>& messages)
+		{
+			typename ChunkOf<T>::type chunk;
+			const uint64_t chunk_begin=c*n;
+			const uint64_t chunk_end=std::min<uint64_t>(chunk_begin+n, len);
+			chunk.mutable_data()->Reserve(chunk_end-chunk_begin);
+			for (uint64_t k=chunk_begin; k<chunk_end; k++)
+				chunk.add_data(vector[k]);
+
+			require(chunk.SerializeToString(&messages[0]), "cannot serialize chunk");
+		});
+}
+
+template <class T>
+void ProtobufFile::read_sparse_entries(
+	SGSparseVector<T>* vectors, const SparseMatrixHeader& data_header,
+	int32_t first_vec, int32_t num_vec)
+{
+	const auto offsets=offsets_of(data_header.num_vectors(),
+		[&data_header](index_t i) { return data_header.num_feat_entries(i); });
+	const uint64_t total=offsets.back();
+	const uint64_t begin=offsets[first_vec];
+	const uint64_t end=offsets[first_vec+num_vec];
+	if (begin==end)
+		return;
+
+	// every chunk is a message of feature indices and one of entries
+	const int64_t n=elements_in_message<T>();
+	const int64_t first_chunk=begin/n;
+	const int64_t last_chunk=(end+n-1)/n;
+	skip_messages(2*first_chunk);
+	read_chunks(first_chunk, last_chunk-first_chunk, 2,
+		[&](int64_t c, const std::vector<std::string>& messages)
+		{
+			UInt64Chunk feat_index_chunk;
+			typename ChunkOf<T>::type entry_chunk;
+			require(feat_index_chunk.ParseFromString(messages[0]) &&
+				entry_chunk.ParseFromString(messages[1]), "cannot parse chunk");
+
+			const uint64_t chunk_begin=c*n;
+			const uint64_t chunk_end=std::min<uint64_t>(chunk_begin+n, total);
+			require(uint64_t(feat_index_chunk.data_size())==chunk_end-chunk_begin &&
+				uint64_t(entry_chunk.data_size())==chunk_end-chunk_begin,
+				"Chunk {} has {} and {} elements, expected {}", c,
+				feat_index_chunk.data_size(), entry_chunk.data_size(),
+				chunk_end-chunk_begin);
+
+			const uint64_t from=std::max(begin, chunk_begin);
+			const uint64_t to=std::min(end, chunk_end);
+			index_t v=vector_of(offsets, from);
+			for (uint64_t k=from; k<to; k++)
+			{
+				while (offsets[v+1]<=k)
+					v++;
+
+				auto& entry=vectors[v-first_vec].features[k-offsets[v]];
+				entry.feat_index=feat_index_chunk.data(k-chunk_begin);
+				entry.entry=static_cast<T>(entry_chunk.data(k-chunk_begin));
+			}
+		});
+}
+
+template <class T>
+void ProtobufFile::read_sparse_matrix(
+	SGSparseVector<T>*& matrix, const SparseMatrixHeader& data_header)
+{
+	matrix=SG_MALLOC(SGSparseVector<T>, data_header.num_vectors());
+	for (uint32_t i=0; i<data_header.num_vectors(); i++)
+		matrix[i]=SGSparseVector<T>(data_header.num_feat_entries(i));
 
-WRITE_SPARSE_MATRIX(BoolChunk, bool)
-WRITE_SPARSE_MATRIX(Int32Chunk, int8_t)
-WRITE_SPARSE_MATRIX(UInt32Chunk, uint8_t)
-WRITE_SPARSE_MATRIX(UInt32Chunk, char)
-WRITE_SPARSE_MATRIX(Int32Chunk, int32_t)
-WRITE_SPARSE_MATRIX(UInt64Chunk, uint32_t)
-WRITE_SPARSE_MATRIX(Int64Chunk, int64_t)
-WRITE_SPARSE_MATRIX(UInt64Chunk, uint64_t)
-WRITE_SPARSE_MATRIX(Float32Chunk, float32_t)
-WRITE_SPARSE_MATRIX(Float64Chunk, float64_t)
-WRITE_SPARSE_MATRIX(Float64Chunk, floatmax_t)
-WRITE_SPARSE_MATRIX(Int32Chunk, int16_t)
-WRITE_SPARSE_MATRIX(UInt32Chunk, uint16_t)
-#undef WRITE_SPARSE_MATRIX
-
-#define READ_STRING_LIST(chunk_type, sg_type) \
-void ProtobufFile::read_string_list( \
-			SGVector<sg_type>*& strings, const StringListHeader& data_header) \
-{ \
-	strings=SG_MALLOC(SGVector<sg_type>, data_header.num_str()); \
-	\
-	chunk_type chunk; \
-	read_message(chunk); \
-	int32_t elements_in_message=message_size/sizeof(sg_type); \
-	int32_t buffer_counter=0; \
-	for (uint32_t i=0; i<data_header.num_str(); i++) \
-	{ \
-		strings[i]=SGVector<sg_type>(data_header.str_len(i)); \
-		for (int32_t j=0; j<strings[i].vlen; j++) \
-		{ \
-			strings[i].vector[j]=chunk.data(buffer_counter); \
-			buffer_counter++; \
-			\
-			if (buffer_counter==elements_in_message) \
-			{ \
-				read_message(chunk); \
-				buffer_counter=0; \
-			} \
-		} \
-	} \
+	read_sparse_entries(matrix, data_header, 0, data_header.num_vectors());
 }
 
-READ_STRING_LIST(Int32Chunk, int8_t)
-READ_STRING_LIST(UInt32Chunk, uint8_t)
-READ_STRING_LIST(UInt32Chunk, char)
-READ_STRING_LIST(Int32Chunk, int32_t)
-READ_STRING_LIST(UInt32Chunk, uint32_t)
-READ_STRING_LIST(Float32Chunk, float32_t)
-READ_STRING_LIST(Float64Chunk, float64_t)
-READ_STRING_LIST(Float64Chunk, floatmax_t)
-READ_STRING_LIST(Int32Chunk, int16_t)
-READ_STRING_LIST(UInt32Chunk, uint16_t)
-READ_STRING_LIST(Int64Chunk, int64_t)
-READ_STRING_LIST(UInt64Chunk, uint64_t)
-#undef READ_STRING_LIST
-
-#define WRITE_STRING_LIST(chunk_type, sg_type) \
-void ProtobufFile::write_string_list( \
-			const SGVector<sg_type>* strings, int32_t num_str) \
-{ \
-	chunk_type chunk; \
-	int32_t elements_in_message=message_size/sizeof(sg_type); \
-	int32_t buffer_counter=0; \
-	for (int32_t i=0; i<num_str; i++) \
-	{ \
-		for (int32_t j=0; j<strings[i].vlen; j++) \
-		{ \
-			chunk.add_data(strings[i].vector[j]); \
-			buffer_counter++; \
-			\
-			if (buffer_counter==elements_in_message) \
-			{ \
-				write_message(chunk); \
-				chunk.Clear(); \
-				buffer_counter=0; \
-			} \
-		} \
-	} \
-	\
-	if (buffer_counter!=0) \
-		write_message(chunk); \
-}
-
-WRITE_STRING_LIST(Int32Chunk, int8_t)
-WRITE_STRING_LIST(UInt32Chunk, uint8_t)
-WRITE_STRING_LIST(UInt32Chunk, char)
-WRITE_STRING_LIST(Int32Chunk, int32_t)
-WRITE_STRING_LIST(UInt64Chunk, uint32_t)
-WRITE_STRING_LIST(Int64Chunk, int64_t)
-WRITE_STRING_LIST(UInt64Chunk, uint64_t)
-WRITE_STRING_LIST(Float32Chunk, float32_t)
-WRITE_STRING_LIST(Float64Chunk, float64_t)
-WRITE_STRING_LIST(Float64Chunk, floatmax_t)
-WRITE_STRING_LIST(Int32Chunk, int16_t)
-WRITE_STRING_LIST(UInt32Chunk, uint16_t)
-#undef WRITE_STRING_LIST
+template <class T>
+void ProtobufFile::write_sparse_matrix(const SGSparseVector<T>* matrix, int32_t num_vec)
+{
+	const auto offsets=offsets_of(num_vec,
+		[matrix](index_t i) { return matrix[i].num_feat_entries; });
+	const uint64_t total=offsets.back();
+
+	const int64_t n=elements_in_message<T>();
+	write_chunks((total+n-1)/n, 2,
+		[&](int64_t c, std::vector<std::string>& messages)
+		{
+			UInt64Chunk feat_index_chunk;
+			typename ChunkOf<T>::type entry_chunk;
+			const uint64_t chunk_begin=c*n;
+			const uint64_t chunk_end=std::min<uint64_t>(chunk_begin+n, total);
+			feat_index_chunk.mutable_data()->Reserve(chunk_end-chunk_begin);
+			entry_chunk.mutable_data()->Reserve(chunk_end-chunk_begin);
+
+			index_t v=vector_of(offsets, chunk_begin);
+			for (uint64_t k=chunk_begin; k<chunk_end; k++)
+			{
+				while (offsets[v+1]<=k)
+					v++;
+
+				const auto& entry=matrix[v].features[k-offsets[v]];
+				feat_index_chunk.add_data(entry.feat_index);
+				entry_chunk.add_data(entry.entry);
+			}
+
+			require(feat_index_chunk.SerializeToString(&messages[0]) &&
+				entry_chunk.SerializeToString(&messages[1]),
+				"cannot serialize chunk");
+		});
+}
+
+template <class T>
+void ProtobufFile::read_string_list(
+	SGVector<T>*& strings, const StringListHeader& data_header)
+{
+	strings=SG_MALLOC(SGVector<T>, data_header.num_str());
+	for (uint32_t i=0; i<data_header.num_str(); i++)
+		strings[i]=SGVector<T>(data_header.str_len(i));
+
+	const auto offsets=offsets_of(data_header.num_str(),
+		[&data_header](index_t i) { return data_header.str_len(i); });
+	const uint64_t total=offsets.back();
+
+	const int64_t n=elements_in_message<T>();
+	read_chunks(0, (total+n-1)/n, 1,
+		[&](int64_t c, const std::vector<std::string>& messages)
+		{
+			typename ChunkOf<T>::type chunk;
+			require(chunk.ParseFromString(messages[0]), "cannot parse chunk");
+
+			const uint64_t chunk_begin=c*n;
+			const uint64_t chunk_end=std::min<uint64_t>(chunk_begin+n, total);
+			require(uint64_t(chunk.data_size())==chunk_end-chunk_begin,
+				"Chunk {} has {} elements, expected {}", c, chunk.data_size(),
+				chunk_end-chunk_begin);
+
+			index_t v=vector_of(offsets, chunk_begin);
+			for (uint64_t k=chunk_begin; k<chunk_end; k++)
+			{
+				while (offsets[v+1]<=k)
+					v++;
+
+				strings[v].vector[k-offsets[v]]=
+					static_cast<T>(chunk.data(k-chunk_begin));
+			}
+		});
+}
+
+template <class T>
+void ProtobufFile::write_string_list(const SGVector<T>* strings, int32_t num_str)
+{
+	const auto offsets=offsets_of(num_str,
+		[strings](index_t i) { return strings[i].vlen; });
+	const uint64_t total=offsets.back();
+
+	const int64_t n=elements_in_message<T>();
+	write_chunks((total+n-1)/n, 1,
+		[&](int64_t c, std::vector<std::string>& messages)
+		{
+			typename ChunkOf<T>::type chunk;
+			const uint64_t chunk_begin=c*n;
+			const uint64_t chunk_end=std::min<uint64_t>(chunk_begin+n, total);
+			chunk.mutable_data()->Reserve(chunk_end-chunk_begin);
+
+			index_t v=vector_of(offsets, chunk_begin);
+			for (uint64_t k=chunk_begin; k<chunk_end; k++)
+			{
+				while (offsets[v+1]<=k)
+					v++;
+
+				chunk.add_data(strings[v].vector[k-offsets[v]]);
+			}
+
+			require(chunk.SerializeToString(&messages[0]), "cannot serialize chunk");
+		});
+}
+
+template <class T>
+void ProtobufFile::get_matrix_block(
+	SGMatrix<T>& matrix, int32_t first_vec, int32_t num_vec)
+{
+	const long start=ftell(file);
+	require(start>=0, "{}::get_matrix_block(): File is not seekable",
+		get_name());
+
+	read_and_validate_global_header(ShogunVersion::MATRIX);
+	MatrixHeader data_header=read_matrix_header();
+	const int32_t num_feat=data_header.num_cols();
+	const int32_t num_vectors=data_header.num_rows();
+	if (num_vec<0)
+		num_vec=num_vectors-first_vec;
+	require(first_vec>=0 && num_vec>=0 && first_vec+num_vec<=num_vectors,
+		"{}::get_matrix_block(): Vectors [{}, {}) are out of range [0, {})",
+		get_name(), first_vec, first_vec+num_vec, num_vectors);
+
+	if (!matrix.matrix)
+		matrix=SGMatrix<T>(num_feat, num_vec);
+	require(matrix.num_rows==num_feat && matrix.num_cols==num_vec,
+		"{}::get_matrix_block(): Matrix is {}x{}, expected {}x{}", get_name(),
+		matrix.num_rows, matrix.num_cols, num_feat, num_vec);
+
+	read_elements(matrix.matrix, uint64_t(num_feat)*num_vectors,
+		uint64_t(num_feat)*first_vec, uint64_t(num_feat)*(first_vec+num_vec));
+	require(fseek(file, start, SEEK_SET)==0, "IO error");
+}
+
+template <class T>
+void ProtobufFile::get_sparse_matrix_block(
+	SGSparseMatrix<T>& matrix, int32_t first_vec, int32_t num_vec)
+{
+	const long start=ftell(file);
+	require(start>=0, "{}::get_sparse_matrix_block(): File is not seekable",
+		get_name());
+
+	read_and_validate_global_header(ShogunVersion::SPARSE_MATRIX);
+	SparseMatrixHeader data_header=read_sparse_matrix_header();
+	const int32_t num_vectors=data_header.num_vectors();
+	if (num_vec<0)
+		num_vec=num_vectors-first_vec;
+	require(first_vec>=0 && num_vec>=0 && first_vec+num_vec<=num_vectors,
+		"{}::get_sparse_matrix_block(): Vectors [{}, {}) are out of range "
+		"[0, {})", get_name(), first_vec, first_vec+num_vec, num_vectors);
+
+	matrix=SGSparseMatrix<T>(data_header.num_features(), num_vec);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		matrix.sparse_matrix[i]=SGSparseVector<T>(
+			data_header.num_feat_entries(first_vec+i));
+	}
+
+	read_sparse_entries(matrix.sparse_matrix, data_header, first_vec, num_vec);
+	require(fseek(file, start, SEEK_SET)==0, "IO error");
+}
+
+#define INSTANTIATE_BLOCKS(sg_type) \
+template void ProtobufFile::get_matrix_block<sg_type>( \
+	SGMatrix<sg_type>&, int32_t, int32_t); \
+template void ProtobufFile::get_sparse_matrix_block<sg_type>( \
+	SGSparseMatrix<sg_type>&, int32_t, int32_t);
+
+INSTANTIATE_BLOCKS(int8_t)
+INSTANTIATE_BLOCKS(uint8_t)
+INSTANTIATE_BLOCKS(char)
+INSTANTIATE_BLOCKS(int32_t)
+INSTANTIATE_BLOCKS(uint32_t)
+INSTANTIATE_BLOCKS(int64_t)
+INSTANTIATE_BLOCKS(uint64_t)
+INSTANTIATE_BLOCKS(float32_t)
+INSTANTIATE_BLOCKS(float64_t)
+INSTANTIATE_BLOCKS(floatmax_t)
+INSTANTIATE_BLOCKS(int16_t)
+INSTANTIATE_BLOCKS(uint16_t)
+#undef INSTANTIATE_BLOCKS
+
+template void ProtobufFile::get_sparse_matrix_block<bool>(
+	SGSparseMatrix<bool>&, int32_t, int32_t);
 
 #endif /* HAVE_PROTOBUF */
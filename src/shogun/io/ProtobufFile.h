@@ -34,6 +34,13 @@
 #include <shogun/io/protobuf/Headers.pb.h>
 #include <shogun/io/protobuf/Chunks.pb.h>
 
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
 namespace shogun
 {
 
@@ -48,6 +55,12 @@ namespace shogun
  * data message, e.g. Int32Chunk
  * ...
  * </pre>
+ *
+ * The data is split into chunks of a fixed number of elements, which are
+ * encoded and decoded in parallel. Since the header tells which chunks
+ * hold which elements, blocks of vectors of dense and sparse matrices can
+ * be read without decoding the others (see get_matrix_block() and
+ * get_sparse_matrix_block()).
  */
 class ProtobufFile : public File
 {
@@ -235,6 +248,36 @@ public:
 			int32_t& max_string_len) override;
 	//@}
 
+	/** read a block of vectors of a matrix, only the chunks holding them
+	 * are decoded
+	 *
+	 * The vectors are written into matrix if it is allocated, its
+	 * dimensions must then match, otherwise it is allocated. The file is
+	 * left at the start of the matrix, so that further blocks of it can be
+	 * read.
+	 *
+	 * @param matrix matrix to read into
+	 * @param first_vec index of the first vector to read
+	 * @param num_vec number of vectors to read, -1 for all remaining ones
+	 */
+	template <class T>
+	void get_matrix_block(
+		SGMatrix<T>& matrix, int32_t first_vec=0, int32_t num_vec=-1);
+
+	/** read a block of vectors of a sparse matrix, only the chunks holding
+	 * them are decoded
+	 *
+	 * The file is left at the start of the sparse matrix, so that further
+	 * blocks of it can be read.
+	 *
+	 * @param matrix sparse matrix the vectors are returned in
+	 * @param first_vec index of the first vector to read
+	 * @param num_vec number of vectors to read, -1 for all remaining ones
+	 */
+	template <class T>
+	void get_sparse_matrix_block(
+		SGSparseMatrix<T>& matrix, int32_t first_vec=0, int32_t num_vec=-1);
+
 	/** vector access functions */
 	/*virtual void get_vector(void*& vector, int32_t& len, DataType& dtype);*/
 
@@ -465,159 +508,88 @@ private:
 	/** write message */
 	void write_message(const google::protobuf::Message& message);
 
-	/** @name Memory Block Access Functions
+	/** read the size of the next message */
+	uint32_t read_message_size();
+
+	/** read the serialized bytes of the next message */
+	void read_raw_message(std::string& bytes);
+
+	/** skip messages without parsing them
 	 *
-	 * Read chunks from protobuf binary file
+	 * @param num_messages number of messages to skip
 	 */
-	//@{
-	void read_memory_block(uint8_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(int8_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(char*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(int32_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(uint32_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(float64_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(float32_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(floatmax_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(int16_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(uint16_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(int64_t*& vector, uint64_t len, int32_t num_messages);
-	void read_memory_block(uint64_t*& vector, uint64_t len, int32_t num_messages);
-	//@}
+	void skip_messages(int64_t num_messages);
 
-	/** @name Memory Block Access Functions
+	/** write serialized message bytes */
+	void write_raw_message(const std::string& bytes);
+
+	/** read chunks of messages and decode them in parallel
+	 *
+	 * The messages are read in batches of a few chunks per thread, then
+	 * every chunk of a batch is decoded by one thread.
 	 *
-	 * Write chunks to protobuf binary file
+	 * @param first_chunk index of the first chunk, passed on to decode
+	 * @param num_chunks number of chunks to read
+	 * @param messages_per_chunk number of messages of every chunk
+	 * @param decode decodes the serialized messages of a chunk
 	 */
-	//@{
-	void write_memory_block(const int8_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const uint8_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const char* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const int32_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const uint32_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const float32_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const float64_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const floatmax_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const int16_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const uint16_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const int64_t* vector, uint64_t len, int32_t num_messages);
-	void write_memory_block(const uint64_t* vector, uint64_t len, int32_t num_messages);
-	//@}
+	void read_chunks(
+		int64_t first_chunk, int64_t num_chunks, int32_t messages_per_chunk,
+		const std::function<void(int64_t, const std::vector<std::string>&)>& decode);
 
-	//@{
-	void read_sparse_matrix(SGSparseVector<bool>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<uint8_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<int8_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<char>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<int32_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<uint32_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<int16_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<uint16_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<int64_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<uint64_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<float32_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<float64_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	void read_sparse_matrix(SGSparseVector<floatmax_t>*& matrix,
-			const SparseMatrixHeader& data_header);
-	//@}
+	/** encode chunks of messages in parallel and write them in order
+	 *
+	 * @param num_chunks number of chunks to write
+	 * @param messages_per_chunk number of messages of every chunk
+	 * @param encode serializes the messages of a chunk
+	 */
+	void write_chunks(
+		int64_t num_chunks, int32_t messages_per_chunk,
+		const std::function<void(int64_t, std::vector<std::string>&)>& encode);
+
+	/** number of elements of type T in one chunk message */
+	template <class T>
+	int64_t elements_in_message() const;
 
-	/**
+	/** read the elements [begin, end) of a block of len elements stored
+	 * in chunks starting at the current position, to dst
 	 */
-	//@{
-	void write_sparse_matrix(
-			const SGSparseVector<bool>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<uint8_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<int8_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<char>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<int32_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<uint32_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<int16_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<uint16_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<int64_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<uint64_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<float32_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<float64_t>* matrix, int32_t num_vec);
-	void write_sparse_matrix(
-			const SGSparseVector<floatmax_t>* matrix, int32_t num_vec);
-	//@}
+	template <class T>
+	void read_elements(T* dst, uint64_t len, uint64_t begin, uint64_t end);
 
-	//@{
-	void read_string_list(SGVector<uint8_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<int8_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<char>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<int32_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<uint32_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<int16_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<uint16_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<int64_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<uint64_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<float32_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<float64_t>*& strings,
-			const StringListHeader& data_header);
-	void read_string_list(SGVector<floatmax_t>*& strings,
-			const StringListHeader& data_header);
-	//@}
+	/** read a block of len elements of num_messages chunks */
+	template <class T>
+	void read_memory_block(T*& vector, uint64_t len, int32_t num_messages);
+
+	/** write a block of len elements of num_messages chunks */
+	template <class T>
+	void write_memory_block(const T* vector, uint64_t len, int32_t num_messages);
 
-	/**
+	/** read the entries of the sparse vectors [first_vec, first_vec+num_vec)
+	 * of a sparse matrix to the preallocated vectors
 	 */
-	//@{
-	void write_string_list(
-			const SGVector<uint8_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<int8_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<char>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<int32_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<uint32_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<int16_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<uint16_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<int64_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<uint64_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<float32_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<float64_t>* strings, int32_t num_str);
-	void write_string_list(
-			const SGVector<floatmax_t>* strings, int32_t num_str);
-	//@}
+	template <class T>
+	void read_sparse_entries(
+		SGSparseVector<T>* vectors, const SparseMatrixHeader& data_header,
+		int32_t first_vec, int32_t num_vec);
+
+	/** read the entries of a sparse matrix */
+	template <class T>
+	void read_sparse_matrix(
+		SGSparseVector<T>*& matrix, const SparseMatrixHeader& data_header);
+
+	/** write the entries of a sparse matrix */
+	template <class T>
+	void write_sparse_matrix(const SGSparseVector<T>* matrix, int32_t num_vec);
+
+	/** read the elements of a string list */
+	template <class T>
+	void read_string_list(
+		SGVector<T>*& strings, const StringListHeader& data_header);
+
+	/** write the elements of a string list */
+	template <class T>
+	void write_string_list(const SGVector<T>* strings, int32_t num_str);
 
 private:
 	/** version of protobuf file */
@@ -627,7 +599,7 @@ private:
 	int32_t message_size;
 
 	/** byte buffer */
-	uint8_t* buffer;
+	std::string buffer;
 
 	/** buffer for numbers */
 	uint8_t uint_buffer[4];
@@ -0,0 +1,446 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/io/fs/HttpFileSystem.h>
+
+#ifdef HAVE_CURL
+#include <shogun/io/ShogunErrc.h>
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+using namespace shogun;
+using namespace shogun::io;
+using namespace std;
+
+namespace
+{
+	struct Response
+	{
+		long status = 0;
+		string body;
+		int64_t content_length = -1;
+	};
+
+	size_t append_body(char* ptr, size_t size, size_t nmemb, void* userdata)
+	{
+		static_cast<string*>(userdata)->append(ptr, size * nmemb);
+		return size * nmemb;
+	}
+
+	struct Upload
+	{
+		string_view data;
+		size_t pos = 0;
+	};
+
+	size_t read_upload(char* ptr, size_t size, size_t nmemb, void* userdata)
+	{
+		auto upload = static_cast<Upload*>(userdata);
+		auto bytes = min(size * nmemb, upload->data.size() - upload->pos);
+		memcpy(ptr, upload->data.data() + upload->pos, bytes);
+		upload->pos += bytes;
+		return bytes;
+	}
+
+	error_condition status_to_error(long status)
+	{
+		if (status >= 200 && status < 300)
+			return {};
+		if (status == 404)
+			return make_error_condition(errc::no_such_file_or_directory);
+		if (status == 401 || status == 403)
+			return make_error_condition(errc::permission_denied);
+		return make_error_condition(errc::io_error);
+	}
+
+	/** Connections kept alive between the requests of a file */
+	class HandlePool
+	{
+	public:
+		~HandlePool()
+		{
+			for (auto handle : m_handles)
+				curl_easy_cleanup(handle);
+		}
+
+		CURL* take()
+		{
+			{
+				lock_guard<mutex> lock(m_mutex);
+				if (!m_handles.empty())
+				{
+					auto handle = m_handles.back();
+					m_handles.pop_back();
+					return handle;
+				}
+			}
+			return curl_easy_init();
+		}
+
+		void give_back(CURL* handle)
+		{
+			curl_easy_reset(handle);
+			lock_guard<mutex> lock(m_mutex);
+			m_handles.push_back(handle);
+		}
+
+	private:
+		mutex m_mutex;
+		vector<CURL*> m_handles;
+	};
+
+	/**
+	 * Perform a request
+	 *
+	 * @param method "GET", "HEAD", "PUT" or "DELETE"
+	 * @param range byte range "first-last" of a GET, empty for all
+	 * @param upload body of a PUT
+	 */
+	error_condition perform(
+		HandlePool& pool, const string& url, const char* method,
+		Response* response, const string& range = "",
+		string_view upload_data = {})
+	{
+		CURL* curl = pool.take();
+		if (curl == nullptr)
+			return make_error_condition(errc::not_enough_memory);
+
+		Upload upload{upload_data};
+		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+		curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+		curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &append_body);
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response->body);
+		if (strcmp(method, "HEAD") == 0)
+			curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+		else if (strcmp(method, "PUT") == 0)
+		{
+			curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
+			curl_easy_setopt(curl, CURLOPT_READFUNCTION, &read_upload);
+			curl_easy_setopt(curl, CURLOPT_READDATA, &upload);
+			curl_easy_setopt(
+				curl, CURLOPT_INFILESIZE_LARGE, (curl_off_t)upload_data.size());
+		}
+		else if (strcmp(method, "GET") != 0)
+			curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method);
+		if (!range.empty())
+			curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+
+		error_condition ec;
+		if (curl_easy_perform(curl) != CURLE_OK)
+			ec = make_error_condition(errc::io_error);
+		else
+		{
+			curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response->status);
+			curl_off_t length = -1;
+			curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+			response->content_length = length;
+			ec = status_to_error(response->status);
+		}
+		pool.give_back(curl);
+		return ec;
+	}
+} // namespace
+
+class HttpRandomAccessFile: public RandomAccessFile
+{
+public:
+	HttpRandomAccessFile(
+		const string& url, int64_t size, int64_t block_bytes,
+		int32_t cache_blocks):
+		m_url(url), m_size(size), m_block_bytes(block_bytes),
+		m_cache_blocks(cache_blocks)
+	{
+	}
+
+	error_condition read(uint64_t offset, size_t n, string_view* result, char* scratch) const override
+	{
+		*result = string_view(scratch, 0);
+		if (n == 0)
+			return {};
+		if (offset >= (uint64_t)m_size)
+			return make_error_condition(ShogunErrc::OutOfRange);
+
+		const int64_t end = min<int64_t>(offset + n, m_size);
+		const int64_t first = offset / m_block_bytes;
+		const int64_t last = (end - 1) / m_block_bytes;
+
+		vector<shared_ptr<const string>> blocks(last - first + 1);
+		vector<int64_t> missing;
+		{
+			lock_guard<mutex> lock(m_cache_mutex);
+			for (int64_t b = first; b <= last; b++)
+			{
+				auto found = m_cache.find(b);
+				if (found == m_cache.end())
+					missing.push_back(b);
+				else
+				{
+					m_lru.splice(m_lru.begin(), m_lru, found->second.second);
+					blocks[b - first] = found->second.first;
+				}
+			}
+		}
+
+		auto ec = fetch(missing, first, blocks);
+		if (ec)
+			return ec;
+
+		char* dst = scratch;
+		for (int64_t b = first; b <= last; b++)
+		{
+			const auto& block = *blocks[b - first];
+			const int64_t from = max<int64_t>(offset, b * m_block_bytes);
+			const int64_t to = min<int64_t>(end, (b + 1) * m_block_bytes);
+			memcpy(dst, block.data() + from - b * m_block_bytes, to - from);
+			dst += to - from;
+		}
+		*result = string_view(scratch, dst - scratch);
+		if ((size_t)(dst - scratch) < n)
+			return make_error_condition(ShogunErrc::OutOfRange);
+		return {};
+	}
+
+private:
+	/** fetch the missing blocks in parallel and add them to the cache */
+	error_condition fetch(
+		const vector<int64_t>& missing, int64_t first,
+		vector<shared_ptr<const string>>& blocks) const
+	{
+		if (missing.empty())
+			return {};
+
+		vector<error_condition> status(missing.size());
+		atomic<size_t> next(0);
+		auto worker = [&]() {
+			for (size_t i = next++; i < missing.size(); i = next++)
+			{
+				const int64_t b = missing[i];
+				const int64_t from = b * m_block_bytes;
+				const int64_t to = min(m_size, from + m_block_bytes);
+				Response response;
+				response.body.reserve(to - from);
+				status[i] = perform(
+					m_handles, m_url, "GET", &response,
+					to_string(from) + "-" + to_string(to - 1));
+				if (status[i])
+					continue;
+
+				// a server that ignores the range sends the whole file
+				if (response.status == 200 && (int64_t)response.body.size() == m_size)
+					response.body = response.body.substr(from, to - from);
+				if ((int64_t)response.body.size() != to - from)
+				{
+					status[i] = make_error_condition(errc::io_error);
+					continue;
+				}
+				blocks[b - first] = make_shared<const string>(std::move(response.body));
+			}
+		};
+
+		const size_t num_workers = min<size_t>(missing.size(), max(env()->get_num_threads(), 1));
+		vector<thread> workers;
+		for (size_t i = 1; i < num_workers; i++)
+			workers.emplace_back(worker);
+		worker();
+		for (auto& t : workers)
+			t.join();
+
+		for (const auto& ec : status)
+		{
+			if (ec)
+				return ec;
+		}
+
+		lock_guard<mutex> lock(m_cache_mutex);
+		for (auto b : missing)
+		{
+			if (m_cache.count(b))
+				continue;
+			m_lru.push_front(b);
+			m_cache.emplace(b, make_pair(blocks[b - first], m_lru.begin()));
+			if ((int32_t)m_lru.size() > m_cache_blocks)
+			{
+				m_cache.erase(m_lru.back());
+				m_lru.pop_back();
+			}
+		}
+		return {};
+	}
+
+private:
+	string m_url;
+	int64_t m_size;
+	int64_t m_block_bytes;
+	int32_t m_cache_blocks;
+
+	mutable HandlePool m_handles;
+	mutable mutex m_cache_mutex;
+	/** block indices, most recently used first */
+	mutable list<int64_t> m_lru;
+	mutable unordered_map<int64_t,
+		pair<shared_ptr<const string>, list<int64_t>::iterator>> m_cache;
+};
+
+class HttpWritableFile: public WritableFile
+{
+public:
+	HttpWritableFile(const string& url): m_url(url), m_closed(false)
+	{
+	}
+
+	~HttpWritableFile() override
+	{
+		// Ignoring any potential errors
+		if (!m_closed)
+			close();
+	}
+
+	error_condition append(string_view data) override
+	{
+		if (m_closed)
+			return generic_category().default_error_condition(EBADF);
+		m_buffer.append(data.data(), data.size());
+		return {};
+	}
+
+	error_condition close() override
+	{
+		if (m_closed)
+			return generic_category().default_error_condition(EBADF);
+		m_closed = true;
+		Response response;
+		return perform(m_handles, m_url, "PUT", &response, "", m_buffer);
+	}
+
+	/** the object is uploaded as a whole on close */
+	error_condition flush() override
+	{
+		return {};
+	}
+
+	error_condition sync() override
+	{
+		return {};
+	}
+
+private:
+	string m_url;
+	string m_buffer;
+	bool m_closed;
+	HandlePool m_handles;
+};
+
+HttpFileSystem::HttpFileSystem(int64_t block_bytes, int32_t cache_blocks):
+	FileSystem(), m_block_bytes(max<int64_t>(block_bytes, 1)),
+	m_cache_blocks(max(cache_blocks, 1))
+{
+	curl_global_init(CURL_GLOBAL_DEFAULT);
+}
+
+HttpFileSystem::~HttpFileSystem()
+{
+	curl_global_cleanup();
+}
+
+error_condition HttpFileSystem::new_random_access_file(
+	const string& fname, unique_ptr<RandomAccessFile>* file) const
+{
+	HandlePool pool;
+	Response response;
+	auto ec = perform(pool, translate_name(fname), "HEAD", &response);
+	if (ec)
+		return ec;
+	if (response.content_length < 0)
+		return make_error_condition(errc::not_supported);
+
+	file->reset(new HttpRandomAccessFile(
+		translate_name(fname), response.content_length, m_block_bytes,
+		m_cache_blocks));
+	return {};
+}
+
+error_condition HttpFileSystem::new_writable_file(const string& fname, unique_ptr<WritableFile>* file) const
+{
+	file->reset(new HttpWritableFile(translate_name(fname)));
+	return {};
+}
+
+error_condition HttpFileSystem::new_appendable_file(const string& fname, unique_ptr<WritableFile>* file) const
+{
+	return make_error_condition(errc::not_supported);
+}
+
+error_condition HttpFileSystem::file_exists(const string& fname) const
+{
+	HandlePool pool;
+	Response response;
+	return perform(pool, translate_name(fname), "HEAD", &response);
+}
+
+error_condition HttpFileSystem::delete_file(const string& fname) const
+{
+	HandlePool pool;
+	Response response;
+	return perform(pool, translate_name(fname), "DELETE", &response);
+}
+
+error_condition HttpFileSystem::create_dir(const string& name) const
+{
+	return make_error_condition(errc::not_supported);
+}
+
+error_condition HttpFileSystem::delete_dir(const string& name) const
+{
+	return make_error_condition(errc::not_supported);
+}
+
+error_condition HttpFileSystem::rename_file(const string& src, const string& target) const
+{
+	return make_error_condition(errc::not_supported);
+}
+
+int64_t HttpFileSystem::get_file_size(const string& fname) const
+{
+	HandlePool pool;
+	Response response;
+	if (perform(pool, translate_name(fname), "HEAD", &response))
+		return -1;
+	return response.content_length;
+}
+
+error_condition HttpFileSystem::is_directory(const string& fname) const
+{
+	auto r = file_exists(fname);
+	if (r)
+		return r;
+	return generic_category().default_error_condition(ENOTDIR);
+}
+
+error_condition HttpFileSystem::get_children(const string& dir,
+	vector<string>* result) const
+{
+	return make_error_condition(errc::not_supported);
+}
+
+error_condition HttpFileSystem::get_paths(const string& pattern,
+	vector<string>* results) const
+{
+	return make_error_condition(errc::not_supported);
+}
+
+REGISTER_FILE_SYSTEM("http", HttpFileSystem);
+REGISTER_FILE_SYSTEM("https", HttpFileSystem);
+#endif // HAVE_CURL
@@ -0,0 +1,79 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __HTTP_FILE_SYSTEM_H__
+#define __HTTP_FILE_SYSTEM_H__
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_CURL
+#include <shogun/io/fs/FileSystem.h>
+
+namespace shogun
+{
+	namespace io
+	{
+		/**
+		 * File system of objects served over HTTP(S), e.g. S3 or GCS
+		 * buckets accessed through public or presigned URLs.
+		 *
+		 * Files are read with ranged GET requests in blocks, the
+		 * blocks a read needs are fetched in parallel and the most
+		 * recently used ones are kept in a cache per file. Writable
+		 * files are buffered and uploaded with a PUT request on close.
+		 * Object stores have no directories, the directory operations
+		 * are not supported.
+		 */
+		class HttpFileSystem : public FileSystem
+		{
+		public:
+			/**
+			 * @param block_bytes bytes fetched per request
+			 * @param cache_blocks number of blocks cached per file
+			 */
+			HttpFileSystem(
+				int64_t block_bytes = 8 << 20, int32_t cache_blocks = 16);
+
+			~HttpFileSystem() override;
+
+			std::error_condition new_random_access_file(
+				const std::string& fname, std::unique_ptr<RandomAccessFile>*) const override;
+
+			std::error_condition new_writable_file(
+				const std::string& fname, std::unique_ptr<WritableFile>*) const override;
+
+			std::error_condition new_appendable_file(
+				const std::string& fname, std::unique_ptr<WritableFile>*) const override;
+
+			std::error_condition file_exists(const std::string& fname) const override;
+
+			std::error_condition delete_file(const std::string& fname) const override;
+
+			std::error_condition create_dir(const std::string& name) const override;
+
+			std::error_condition delete_dir(const std::string& name) const override;
+
+			std::error_condition rename_file(const std::string& src, const std::string& target) const override;
+
+			int64_t get_file_size(const std::string& fname) const override;
+
+			std::error_condition is_directory(const std::string& fname) const override;
+
+			std::error_condition get_children(const std::string& dir,
+				std::vector<std::string>* result) const override;
+
+			std::error_condition get_paths(const std::string& pattern,
+				std::vector<std::string>* results) const override;
+
+		private:
+			int64_t m_block_bytes;
+			int32_t m_cache_blocks;
+		};
+	}
+}
+
+#endif // HAVE_CURL
+#endif // __HTTP_FILE_SYSTEM_H__
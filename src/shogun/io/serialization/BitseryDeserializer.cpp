@@ -49,6 +49,12 @@ public:
 		SG_DEBUG("read floatmax_t with value {}", *v);
 	}
 
+	template <class U>
+	void on_buffer(S& s, U* v, int64_t length)
+	{
+		s.adapter().template readBuffer<sizeof(U)>(v, length);
+	}
+
 	void on_object(S& s, std::shared_ptr<SGObject>* v)
 	{
 		SG_DEBUG("reading SGObject: ");
@@ -73,6 +79,7 @@ public:
 	}
 
 	std::optional<float64_t> m_auto_value;
+	const Deserializer* m_deserializer = nullptr;
 
 private:
 	SG_DELETE_COPY_AND_ASSIGN(BitseryReaderVisitor);
@@ -144,13 +151,24 @@ std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Rea
 	{
 		pre_deserialize(obj);
 
+		auto load = visitor->m_deserializer->parameter_predicate(*obj);
+		// the parameters left out are read into a scratch object as the
+		// format does not allow skipping them, and dropped with it
+		std::shared_ptr<SGObject> scratch;
 		size_t num_params;
 		reader.value8b(num_params);
 		for (size_t i = 0; i < num_params; ++i)
 		{
 			string param_name;
 			reader.text1b(param_name, 64);
-			obj->visit_parameter(BaseTag(param_name), visitor);
+			if (load(param_name))
+				obj->visit_parameter(BaseTag(param_name), visitor);
+			else
+			{
+				if (!scratch)
+					scratch = create(obj_name.c_str(), static_cast<EPrimitiveType>(primitive_type));
+				scratch->visit_parameter(BaseTag(param_name), visitor);
+			}
 		}
 
 		post_deserialize(obj);
@@ -181,6 +199,7 @@ std::shared_ptr<SGObject> BitseryDeserializer::read_object()
 	InputStreamAdapter adapter { stream() };
 	BitseryDeser deser {std::move(adapter)};
 	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
+	reader_visitor.m_deserializer = this;
 	return object_reader(deser, addressof(reader_visitor));
 }
 
@@ -189,5 +208,6 @@ void BitseryDeserializer::read(std::shared_ptr<SGObject> _this)
 	InputStreamAdapter adapter { stream() };
 	BitseryDeser deser {std::move(adapter)};
 	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
+	reader_visitor.m_deserializer = this;
 	object_reader(deser, addressof(reader_visitor), _this);
 }
@@ -55,6 +55,12 @@ public:
 		writer.value8b(lsb);
 	}
 
+	template <class U>
+	void on_buffer(Writer& writer, U* v, int64_t length)
+	{
+		writer.adapter().template writeBuffer<sizeof(U)>(v, length);
+	}
+
 	void on_object(Writer& writer, shared_ptr<SGObject>* v)
 	{
 		if (*v)
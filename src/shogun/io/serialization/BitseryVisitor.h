@@ -124,6 +124,29 @@ namespace shogun
 					static_cast<T*>(this)->on_object(m_s, v);
 				}
 
+				/** values are stored in the same little endian layout as
+				 * one by one, but copied with one buffer operation */
+				bool on_contiguous(void* data, size_t value_bytes, int64_t length) override
+				{
+					switch (value_bytes)
+					{
+					case 1:
+						static_cast<T*>(this)->on_buffer(m_s, static_cast<uint8_t*>(data), length);
+						return true;
+					case 2:
+						static_cast<T*>(this)->on_buffer(m_s, static_cast<uint16_t*>(data), length);
+						return true;
+					case 4:
+						static_cast<T*>(this)->on_buffer(m_s, static_cast<uint32_t*>(data), length);
+						return true;
+					case 8:
+						static_cast<T*>(this)->on_buffer(m_s, static_cast<uint64_t*>(data), length);
+						return true;
+					default:
+						return false;
+					}
+				}
+
 				void enter_matrix_row(index_t *rows, index_t *cols) override {}
 				void exit_matrix_row(index_t *rows, index_t *cols) override {}
 				void exit_matrix(index_t* rows, index_t* cols) override {}
@@ -7,7 +7,7 @@
 #include <shogun/io/serialization/Deserializer.h>
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/io/fs/FileSystem.h>
-#include <shogun/io/stream/FileInputStream.h>
+#include <shogun/io/stream/ReadaheadInputStream.h>
 
 #include <utility>
 
@@ -33,6 +33,32 @@ std::shared_ptr<InputStream> Deserializer::stream() const
 	return m_stream;
 }
 
+void Deserializer::set_parameter_filter(ParameterFilter filter)
+{
+	m_parameter_filter = std::move(filter);
+}
+
+Deserializer::ParameterFilter Deserializer::with_properties(ParameterProperties properties)
+{
+	return [properties](const SGObject&, const std::string&,
+			const AnyParameterProperties& param_properties) {
+		return param_properties.has_property(properties);
+	};
+}
+
+std::function<bool(const std::string&)> Deserializer::parameter_predicate(
+	const SGObject& obj) const
+{
+	if (!m_parameter_filter)
+		return [](const std::string&) { return true; };
+
+	return [this, &obj, params = obj.get_params()](const std::string& name) {
+		auto found = params.find(name);
+		return found == params.end()
+			|| m_parameter_filter(obj, name, found->second->get_properties());
+	};
+}
+
 void shogun::io::pre_deserialize(const std::shared_ptr<SGObject>& obj) noexcept(false)
 {
 	obj->load_serializable_pre();
@@ -68,7 +94,9 @@ std::shared_ptr<SGObject> shogun::io::deserialize(const std::string& _path, cons
 	if ((ec = fs->new_random_access_file(_path, &raf)))
 		throw to_system_error(ec);
 
-	auto fis = std::make_shared<io::FileInputStream>(raf.get());
+	// the stream outlives this call in the deserializer and may still be
+	// reading ahead, so it owns the file
+	auto fis = std::make_shared<io::ReadaheadInputStream>(raf.release(), 1 << 20, true);
 	_deser->attach(fis);
 	return _deser->read_object();
 }
@@ -8,6 +8,8 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/io/stream/InputStream.h>
 
+#include <functional>
+
 namespace shogun
 {
 	namespace io
@@ -15,6 +17,11 @@ namespace shogun
 		class Deserializer : public SGObject
 		{
 		public:
+			/** decides whether a parameter of an object is loaded */
+			using ParameterFilter = std::function<bool(
+				const SGObject& obj, const std::string& name,
+				const AnyParameterProperties& properties)>;
+
 			Deserializer();
 			~Deserializer() override;
 			virtual void attach(std::shared_ptr<io::InputStream> stream);
@@ -22,8 +29,33 @@ namespace shogun
 			virtual void read(std::shared_ptr<SGObject> _this) = 0;
 			std::shared_ptr<io::InputStream> stream() const;
 
+			/**
+			 * Load only the parameters the filter accepts, of the object
+			 * and of all objects it holds. The other parameters keep
+			 * the values of a newly created object, e.g. to leave out
+			 * the training state of a model that is only applied.
+			 *
+			 * @param filter filter, empty to load all parameters
+			 */
+			void set_parameter_filter(ParameterFilter filter);
+
+			/**
+			 * @param properties properties of the parameters to load
+			 * @return filter accepting the parameters that have any of
+			 * the properties
+			 */
+			static ParameterFilter with_properties(ParameterProperties properties);
+
+			/**
+			 * @param obj object that is read
+			 * @return whether a parameter of obj is to be loaded
+			 */
+			std::function<bool(const std::string&)> parameter_predicate(
+				const SGObject& obj) const;
+
 		private:
 			std::shared_ptr<io::InputStream> m_stream;
+			ParameterFilter m_parameter_filter;
 		};
 
 		std::shared_ptr<SGObject> deserialize(const std::string& _path, const std::shared_ptr<Deserializer>& _deser);
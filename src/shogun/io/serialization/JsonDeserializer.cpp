@@ -244,6 +244,9 @@ private:
 		} while (++rbegin != rend);
 	}
 
+public:
+	const Deserializer* m_deserializer = nullptr;
+
 private:
 	stack<const ValueType*> m_value_stack;
 	SG_DELETE_COPY_AND_ASSIGN(JSONReaderVisitor);
@@ -356,8 +359,12 @@ std::shared_ptr<SGObject> object_reader(const V* v, JSONReaderVisitor<V>* visito
 	{
 		pre_deserialize(obj);
 
+		// the parameters left out are simply not visited in the document
+		auto load = visitor->m_deserializer->parameter_predicate(*obj);
 		for_each(obj_params.MemberBegin(), obj_params.MemberEnd(),
-			[&obj, &visitor](const auto& member) {
+			[&obj, &visitor, &load](const auto& member) {
+				if (!load(member.name.GetString()))
+					return;
 				visitor->push(addressof(member.value));
 				obj->visit_parameter(BaseTag(member.name.GetString()), visitor);
 			});
@@ -390,6 +397,7 @@ std::shared_ptr<SGObject> JsonDeserializer::read_object()
 	reader.ParseStream<kParseNanAndInfFlag>(is);
 	auto reader_visitor =
 		make_unique<JSONReaderVisitor<Document::ValueType>>();
+	reader_visitor->m_deserializer = this;
 	return object_reader(
 		dynamic_cast<Document::ValueType*>(&reader),
 		reader_visitor.get()
@@ -404,6 +412,7 @@ void JsonDeserializer::read(std::shared_ptr<SGObject> _this)
 	reader.ParseStream<kParseNanAndInfFlag>(is);
 	auto reader_visitor =
 		make_unique<JSONReaderVisitor<Document::ValueType>>();
+	reader_visitor->m_deserializer = this;
 	object_reader(dynamic_cast<Document::ValueType*>(&reader),
 		reader_visitor.get(), _this);
 }
@@ -0,0 +1,110 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/ensemble/MajorityVote.h>
+#include <shogun/io/serialization/BitseryDeserializer.h>
+#include <shogun/io/serialization/BitserySerializer.h>
+#include <shogun/io/serialization/JsonDeserializer.h>
+#include <shogun/io/serialization/JsonSerializer.h>
+#include <shogun/io/stream/ByteArrayInputStream.h>
+#include <shogun/io/stream/ByteArrayOutputStream.h>
+#include <shogun/machine/Machine_benchmark.h>
+#include <shogun/machine/RandomForest.h>
+
+namespace shogun
+{
+
+/** Round trips through memory, so that the file system is not measured.
+ *
+ * state.range(2) selects the format, 0 for Bitsery and 1 for JSON, and
+ * state.range(3) the object, 0 for the training features and 1 for a
+ * random forest trained on them, which consists of many small objects.
+ */
+class SerializationFixture : public MachineFixture
+{
+public:
+	void SetUp(const ::benchmark::State& st) override
+	{
+		MachineFixture::SetUp(st);
+		json = st.range(2);
+		if (st.range(3))
+		{
+			auto forest = std::make_shared<RandomForest>(4, 10);
+			forest->set_combination_rule(std::make_shared<MajorityVote>());
+			forest->set_labels(multiclass_labels);
+			forest->put("seed", 17);
+			forest->train(features_train);
+			object = forest;
+		}
+		else
+			object = features_train;
+	}
+
+	void TearDown(const ::benchmark::State& st) override
+	{
+		object.reset();
+		MachineFixture::TearDown(st);
+	}
+
+	std::string write() const
+	{
+		auto stream = std::make_shared<io::ByteArrayOutputStream>();
+		std::shared_ptr<io::Serializer> serializer;
+		if (json)
+			serializer = std::make_shared<io::JsonSerializer>();
+		else
+			serializer = std::make_shared<io::BitserySerializer>();
+		serializer->attach(stream);
+		serializer->write(object);
+		return stream->as_string();
+	}
+
+	std::shared_ptr<SGObject> read(const std::string& buffer) const
+	{
+		auto stream = std::make_shared<io::ByteArrayInputStream>(buffer);
+		std::shared_ptr<io::Deserializer> deserializer;
+		if (json)
+			deserializer = std::make_shared<io::JsonDeserializer>();
+		else
+			deserializer = std::make_shared<io::BitseryDeserializer>();
+		deserializer->attach(stream);
+		return deserializer->read_object();
+	}
+
+	bool json;
+	std::shared_ptr<SGObject> object;
+};
+
+BENCHMARK_DEFINE_F(SerializationFixture, Serialize)(benchmark::State& state)
+{
+	int64_t num_bytes = 0;
+	for (auto _ : state)
+		num_bytes += write().size();
+	state.SetBytesProcessed(num_bytes);
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(SerializationFixture, Deserialize)(benchmark::State& state)
+{
+	const auto buffer = write();
+	for (auto _ : state)
+		benchmark::DoNotOptimize(read(buffer));
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+	set_counters(state);
+}
+
+#define ADD_SERIALIZATION_ARGS(WHAT)                                           \
+	WHAT->ArgNames({"vectors", "threads", "json", "forest"})                   \
+	    ->ArgsProduct(                                                         \
+	        {benchmark::CreateRange(1000, 100000, 10), {1}, {0, 1}, {0, 1}})   \
+	    ->UseRealTime()                                                        \
+	    ->Unit(benchmark::kMillisecond)
+
+ADD_SERIALIZATION_ARGS(BENCHMARK_REGISTER_F(SerializationFixture, Serialize));
+ADD_SERIALIZATION_ARGS(
+	BENCHMARK_REGISTER_F(SerializationFixture, Deserialize));
+
+} // namespace shogun
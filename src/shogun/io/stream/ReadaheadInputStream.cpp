@@ -0,0 +1,142 @@
+/** This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/io/ShogunErrc.h>
+#include <shogun/io/stream/ReadaheadInputStream.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace shogun::io;
+
+ReadaheadInputStream::ReadaheadInputStream(
+	RandomAccessFile* src, size_t block_bytes, bool free)
+	: InputStream(), m_src(src), m_block_bytes(std::max<size_t>(block_bytes, 1)),
+	  m_free(free)
+{
+	prefetch(0);
+}
+
+ReadaheadInputStream::~ReadaheadInputStream()
+{
+	if (m_next.valid())
+		m_next.wait();
+	if (m_free)
+		delete m_src;
+}
+
+ReadaheadInputStream::Block ReadaheadInputStream::read_block(int64_t offset) const
+{
+	Block block;
+	block.offset = offset;
+	block.data.resize(m_block_bytes);
+	char* scratch = &block.data[0];
+	string_view data;
+	block.status = m_src->read(offset, m_block_bytes, &data, scratch);
+
+	if (data.data() != scratch)
+		memmove(scratch, data.data(), data.size());
+	block.data.resize(data.size());
+	return block;
+}
+
+void ReadaheadInputStream::prefetch(int64_t offset)
+{
+	m_next = std::async(
+		std::launch::async, [this, offset]() { return read_block(offset); });
+}
+
+void ReadaheadInputStream::advance()
+{
+	m_current = m_next.get();
+	// a short or failed read ends the file, nothing more to read ahead
+	if (!m_current.status && m_current.data.size() == m_block_bytes)
+		prefetch(m_current.offset + m_current.data.size());
+}
+
+void ReadaheadInputStream::seek(int64_t pos)
+{
+	if (m_next.valid())
+		m_next.wait();
+	m_current = Block();
+	m_current.offset = pos;
+	m_pos = pos;
+	prefetch(pos);
+}
+
+error_condition ReadaheadInputStream::read(string* buffer, int64_t size)
+{
+	if (size < 0)
+		return make_error_condition(errc::invalid_argument);
+
+	buffer->clear();
+	buffer->reserve(size);
+	while (buffer->size() < static_cast<size_t>(size))
+	{
+		const int64_t available =
+			m_current.offset + m_current.data.size() - m_pos;
+		if (available == 0)
+		{
+			if (!m_next.valid())
+				return m_current.status;
+			advance();
+			continue;
+		}
+
+		const int64_t bytes_to_copy =
+			std::min<int64_t>(available, size - buffer->size());
+		buffer->append(m_current.data, m_pos - m_current.offset, bytes_to_copy);
+		m_pos += bytes_to_copy;
+	}
+	return {};
+}
+
+error_condition ReadaheadInputStream::skip(int64_t bytes)
+{
+	if (bytes < 0)
+		return make_error_condition(errc::invalid_argument);
+
+	const int64_t target = m_pos + bytes;
+	if (target <= m_current.offset + (int64_t)m_current.data.size())
+	{
+		m_pos = target;
+		return {};
+	}
+
+	if (bytes > 0)
+	{
+		// try quickly jumping on the position
+		char last;
+		string_view data;
+		auto r = m_src->read(target - 1, 1, &data, &last);
+		if ((!r || io::is_out_of_range(r)) && data.size() == 1)
+		{
+			seek(target);
+			return {};
+		}
+	}
+
+	// skip past the end of the file by reading up to it
+	string scratch;
+	while (bytes > 0)
+	{
+		auto r = read(&scratch, std::min<int64_t>(m_block_bytes, bytes));
+		bytes -= scratch.size();
+		if (r)
+			return r;
+	}
+	return {};
+}
+
+int64_t ReadaheadInputStream::tell() const
+{
+	return m_pos;
+}
+
+void ReadaheadInputStream::reset()
+{
+	seek(0);
+}
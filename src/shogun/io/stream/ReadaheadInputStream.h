@@ -0,0 +1,91 @@
+/** This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#ifndef __READAHEAD_INPUT_STREAM_H__
+#define __READAHEAD_INPUT_STREAM_H__
+
+#include <shogun/io/fs/FileSystem.h>
+#include <shogun/io/stream/InputStream.h>
+
+#include <future>
+#include <string>
+
+namespace shogun
+{
+	namespace io
+	{
+#define IGNORE_IN_CLASSLIST
+
+		/**
+		 * Input stream of a file that reads ahead: while the caller
+		 * consumes a block, the next block is read in the background.
+		 *
+		 * The reads are double buffered, so reading the file overlaps
+		 * with processing its contents, which hides the latency of
+		 * network filesystems and keeps fast drives busy.
+		 */
+		IGNORE_IN_CLASSLIST class ReadaheadInputStream : public InputStream
+		{
+		public:
+			/**
+			 * Construct a readahead stream, the first block is read
+			 * right away
+			 *
+			 * @param src file to read
+			 * @param block_bytes bytes read at once
+			 * @param free whether to delete src on destruction
+			 */
+			ReadaheadInputStream(
+				RandomAccessFile* src, size_t block_bytes = 1 << 20,
+				bool free = false);
+			~ReadaheadInputStream() override;
+
+			std::error_condition read(std::string* buffer, int64_t size) override;
+			std::error_condition skip(int64_t bytes) override;
+			int64_t tell() const override;
+			void reset() override;
+
+			const char* get_name() const override
+			{
+				return "ReadaheadInputStream";
+			}
+
+		private:
+			/** a block of the file */
+			struct Block
+			{
+				/** offset of the block in the file */
+				int64_t offset = 0;
+				/** contents */
+				std::string data;
+				/** status of the read */
+				std::error_condition status;
+			};
+
+			/** read a block of the file */
+			Block read_block(int64_t offset) const;
+
+			/** start reading the block at offset in the background */
+			void prefetch(int64_t offset);
+
+			/** make the block read in the background the current one */
+			void advance();
+
+			/** drop the buffered blocks and continue at pos */
+			void seek(int64_t pos);
+
+		private:
+			RandomAccessFile* m_src;
+			size_t m_block_bytes;
+			bool m_free;
+			int64_t m_pos = 0;
+			Block m_current;
+			std::future<Block> m_next;
+
+			SG_DELETE_COPY_AND_ASSIGN(ReadaheadInputStream);
+		};
+	}
+}
+
+#endif /* __READAHEAD_INPUT_STREAM_H__ */
@@ -60,7 +60,9 @@ namespace shogun
  * Parsing is done through the ParseBuffer object, which in its
  * current implementation is a ring of a specified number of examples.
  * It is the task of the InputParser object to ensure that this ring
- * is being updated with new parsed examples.
+ * is being updated with new parsed examples. Examples are parsed in
+ * place into the ring and handed over to the caller in batches, without
+ * taking a lock per example.
  *
  * InputParser provides mainly the get_next_example function which
  * returns the next example from the ParseBuffer object to the caller
@@ -218,10 +220,10 @@ public:
     void copy_example_into_buffer(Example<T>* ex);
 
     /**
-     * Retrieves the next example from the buffer.
+     * Retrieves the next example from the buffer without waiting.
      *
      *
-     * @return The example pointer.
+     * @return The example pointer, NULL if none is ready.
      */
     Example<T>* retrieve_example();
 
@@ -509,15 +511,10 @@ template <class T> void* InputParser<T>::main_parse_loop(void* params)
 
     while (keep_running.load(std::memory_order_acquire))
 	{
-		std::unique_lock<std::mutex> lock(examples_state_lock);
-
-		if (parsing_done)
-		{
-			return NULL;
-		}
-		lock.unlock();
-
 		current_example = examples_ring->get_free_example();
+		if (current_example == NULL)
+			break;
+
 		current_feature_vector = current_example->fv;
 		current_len = current_example->length;
 		current_label = current_example->label;
@@ -528,51 +525,29 @@ template <class T> void* InputParser<T>::main_parse_loop(void* params)
 			get_vector_only(current_feature_vector,	current_len);
 
 		if (current_len < 0)
-		{
-			lock.lock();
-			parsing_done = true;
-			examples_state_changed.notify_one();
-			return NULL;
-		}
+			break;
 
 		current_example->label = current_label;
 		current_example->fv = current_feature_vector;
 		current_example->length = current_len;
 
 		examples_ring->copy_example(current_example);
-		lock.lock();
 		number_of_vectors_parsed++;
-		examples_state_changed.notify_one();
 	}
+
+	examples_ring->finish();
+	std::lock_guard<std::mutex> lock(examples_state_lock);
+	parsing_done = true;
+	examples_state_changed.notify_one();
     return NULL;
 }
 
 template <class T> Example<T>* InputParser<T>::retrieve_example()
 {
-    /* This function should be guarded by mutexes while calling  */
-    Example<T> *ex;
-
-    if (parsing_done)
-    {
-        if (number_of_vectors_read == number_of_vectors_parsed)
-        {
-            reading_done = true;
-            /* Signal to waiting threads that no more examples are left */
-			examples_state_changed.notify_one();
-            return NULL;
-        }
-    }
-
-    if (number_of_vectors_parsed <= 0)
-        return NULL;
+    Example<T> *ex = examples_ring->get_unused_example();
 
-    if (number_of_vectors_read == number_of_vectors_parsed)
-    {
-        return NULL;
-    }
-
-    ex = examples_ring->get_unused_example();
-    number_of_vectors_read++;
+    if (ex != NULL)
+        number_of_vectors_read++;
 
     return ex;
 }
@@ -585,37 +560,21 @@ template <class T> int32_t InputParser<T>::get_next_example(T* &fv,
        otherwise, wait for further parsing, get the example and
        return 1 */
 
-    Example<T> *ex;
+    if (reading_done || !keep_running.load(std::memory_order_acquire))
+        return 0;
 
-    while (keep_running.load(std::memory_order_acquire))
+    Example<T> *ex = examples_ring->wait_unused_example();
+
+    if (ex == NULL)
     {
-        if (reading_done)
-            return 0;
-
-		std::unique_lock<std::mutex> lock(examples_state_lock);
-        ex = retrieve_example();
-
-        if (ex == NULL)
-        {
-            if (reading_done)
-            {
-                /* No more examples left, return */
-                return 0;
-            }
-            else
-            {
-                /* Examples left, wait for one to become ready */
-				examples_state_changed.wait(lock);
-                continue;
-            }
-        }
-        else
-        {
-            /* Example ready, return the example */
-            break;
-        }
+        /* No more examples left, return */
+        std::lock_guard<std::mutex> lock(examples_state_lock);
+        reading_done = true;
+        examples_state_changed.notify_one();
+        return 0;
     }
 
+    number_of_vectors_read++;
     fv = ex->fv;
     length = ex->length;
     label = ex->label;
@@ -650,6 +609,8 @@ template <class T> void InputParser<T>::exit_parser()
 {
 	SG_TRACE("cancelling parse thread");
 	keep_running.store(false, std::memory_order_release);
+	if (examples_ring)
+		examples_ring->close();
 	examples_state_changed.notify_one();
 	if (parse_thread.joinable())
 		parse_thread.join();
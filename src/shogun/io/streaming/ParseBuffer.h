@@ -12,10 +12,11 @@
 #include <shogun/lib/common.h>
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/DataType.h>
+#include <shogun/lib/Profiler.h>
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <memory>
 #include <mutex>
-#include <vector>
 
 namespace shogun
 {
@@ -62,8 +63,13 @@ public:
  * when the example is used to make room for another
  * example to take its place.
  *
- * Writing of examples is done into whichever position
- * in the ring is free to be overwritten, or empty.
+ * The ring has a single writer and a single reader. Examples are
+ * written in place into the slot returned by get_free_example() and
+ * handed over to the reader in batches: the position up to which
+ * examples may be read is published with one atomic store per batch,
+ * and neither side takes a lock unless the ring is full or empty.
+ * Unless freed on release, the vector of a slot is handed back to the
+ * writer with the slot, so the memory of the vectors is recycled.
  */
 template <class T> class ParseBuffer: public SGObject
 {
@@ -72,8 +78,10 @@ public:
 	 * Constructor, taking buffer size as argument.
 	 *
 	 * @param size Ring size as number of examples
+	 * @param batch_size Number of examples published at
+	 * once, 0 for a quarter of the ring up to 256
 	 */
-	ParseBuffer(int32_t size = 1024);
+	ParseBuffer(int32_t size = 1024, int32_t batch_size = 0);
 
 	/**
 	 * Destructor, frees up buffer.
@@ -83,24 +91,16 @@ public:
 
 	/**
 	 * Return the next position to write the example
-	 * into the ring.
+	 * into the ring, waiting for the reader if the
+	 * ring is full.
 	 *
-	 * @return pointer to example
+	 * @return pointer to example, NULL if the ring was closed
 	 */
-	Example<T>* get_free_example()
-	{
-		std::unique_lock<std::mutex> write_lk(*write_mutex, std::defer_lock);
-		std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[ex_write_index], std::defer_lock);
-		std::lock(write_lk, current_ex_lock);
-		while (ex_used[ex_write_index] == E_NOT_USED)
-			ex_in_use_cond[ex_write_index]->wait(current_ex_lock);
-		Example<T>* ex=&ex_ring[ex_write_index];
-		return ex;
-	}
+	Example<T>* get_free_example();
 
 	/**
-	 * Writes the given example into the appropriate buffer space.
-	 * Feature vector is copied into a separate block.
+	 * Writes the given example into the 'write' position, which
+	 * must be free. The feature vector is not copied.
 	 *
 	 * @param ex Example to copy into buffer
 	 *
@@ -122,16 +122,44 @@ public:
 	 */
 	Example<T>* get_unused_example();
 
+	/**
+	 * Returns the next example from the buffer, waiting for the
+	 * writer if none is published yet.
+	 *
+	 * @return unused example object at next 'read' position, NULL
+	 * once all examples were read after finish() or if the ring
+	 * was closed
+	 */
+	Example<T>* wait_unused_example();
+
 	/**
 	 * Copies an example into the buffer, waiting for the
-	 * destination example to be used if necessary.
+	 * destination example to be used if necessary. The example
+	 * may be the one returned by get_free_example().
 	 *
 	 * @param ex Example to copy into buffer
 	 *
-	 * @return 1 on success, 0 on memory errors
+	 * @return 1 on success, 0 if the ring was closed
 	 */
 	int32_t copy_example(Example<T>* ex);
 
+	/**
+	 * Publish the examples written so far to the reader.
+	 */
+	void flush();
+
+	/**
+	 * Publish the examples written so far and signal the reader
+	 * that no more examples follow.
+	 */
+	void finish();
+
+	/**
+	 * Close the ring, waking up the writer and the reader waiting
+	 * for it.
+	 */
+	void close();
+
 	/**
 	 * Mark the example in 'read' position as 'used'.
 	 *
@@ -164,6 +192,13 @@ public:
 		return free_vectors_on_destruct;
 	}
 
+	/**
+	 * Return the number of examples published at once
+	 *
+	 * @return batch size
+	 */
+	int32_t get_batch_size() const { return batch_size; }
+
 	/**
 	 * Return the name of the object
 	 *
@@ -184,6 +219,7 @@ protected:
 	virtual void inc_read_index()
 	{
 		ex_read_index=(ex_read_index + 1) % ring_size;
+		num_read++;
 	}
 
 	/**
@@ -193,36 +229,69 @@ protected:
 	virtual void inc_write_index()
 	{
 		ex_write_index=(ex_write_index + 1) % ring_size;
+		num_written++;
+	}
+
+	/** Wake up the other side if it waits for the count
+	 *
+	 * @param waiting_for count the other side waits for, -1 if none
+	 * @param count count reached
+	 * @param cond condition variable of the other side
+	 */
+	void wake_up(
+		const std::atomic<int64_t>& waiting_for, int64_t count,
+		std::condition_variable& cond)
+	{
+		int64_t target = waiting_for.load(std::memory_order_seq_cst);
+		if (target >= 0 && count >= target)
+		{
+			std::lock_guard<std::mutex> lk(wait_mutex);
+			cond.notify_one();
+		}
 	}
 
 protected:
 
 	/// Size of ring as number of examples
 	int32_t ring_size;
+	/// Number of examples published at once
+	int32_t batch_size;
 	/// Ring of examples
 	Example<T>* ex_ring;
 
-	/// Enum used for representing used/unused/empty state of example
-	E_IS_EXAMPLE_USED* ex_used;
-	/// Lock on state of example - used or unused
-	std::vector<std::shared_ptr<std::mutex> > ex_in_use_mutex;
-	/// Condition variable triggered when example is being/not being used
-	std::vector<std::shared_ptr<std::condition_variable> > ex_in_use_cond;
-	/// Lock for reading examples from the ring
-	std::shared_ptr<std::mutex> read_mutex;
-	/// Lock for writing new examples
-	std::shared_ptr<std::mutex> write_mutex;
-
 	/// Write position for next example
 	int32_t ex_write_index;
 	/// Position of next example to be read
 	int32_t ex_read_index;
+	/// Number of examples written, owned by the writer
+	int64_t num_written;
+	/// Number of examples read, owned by the reader
+	int64_t num_read;
+
+	/// Number of examples the reader may read
+	alignas(CPU_CACHE_LINE_SIZE) std::atomic<int64_t> num_published;
+	/// Number of examples the reader has released
+	alignas(CPU_CACHE_LINE_SIZE) std::atomic<int64_t> num_released;
+	/// Number of released examples the waiting writer needs, -1 if not waiting
+	alignas(CPU_CACHE_LINE_SIZE) std::atomic<int64_t> writer_waits_for;
+	/// Number of published examples the waiting reader needs, -1 if not waiting
+	std::atomic<int64_t> reader_waits_for;
+	/// Whether the writer has finished
+	std::atomic_bool finished;
+	/// Whether the ring was closed
+	std::atomic_bool closed;
+
+	/// Lock for waiting on a full or empty ring
+	std::mutex wait_mutex;
+	/// Condition variable the writer waits on if the ring is full
+	std::condition_variable not_full;
+	/// Condition variable the reader waits on if the ring is empty
+	std::condition_variable not_empty;
 
 	/// Whether examples on the ring will be freed on destruction
 	bool free_vectors_on_destruct;
 };
 
-
 template <class T> void ParseBuffer<T>::init_vector()
 {
 	if (!free_vectors_on_destruct)
@@ -234,28 +303,32 @@ template <class T> void ParseBuffer<T>::init_vector()
 	}
 }
 
-template <class T> ParseBuffer<T>::ParseBuffer(int32_t size)
+template <class T> ParseBuffer<T>::ParseBuffer(int32_t size, int32_t batch)
 {
+	require(size > 0, "Ring size ({}) must be positive.", size);
 	ring_size = size;
+	if (batch <= 0)
+		batch = std::min(std::max(size / 4, 1), 256);
+	batch_size = std::min(batch, size);
 	ex_ring = SG_CALLOC(Example<T>, ring_size);
-	ex_used = SG_MALLOC(E_IS_EXAMPLE_USED, ring_size);
-	read_mutex = std::make_shared<std::mutex>();
-	write_mutex = std::make_shared<std::mutex>();
 	io::info("Initialized with ring size: {}.", ring_size);
 
 	ex_write_index = 0;
 	ex_read_index = 0;
+	num_written = 0;
+	num_read = 0;
+	num_published.store(0);
+	num_released.store(0);
+	writer_waits_for.store(-1);
+	reader_waits_for.store(-1);
+	finished.store(false);
+	closed.store(false);
 
 	for (int32_t i=0; i<ring_size; i++)
 	{
-		ex_used[i] = E_EMPTY;
-
 		ex_ring[i].fv = NULL;
 		ex_ring[i].length = 1;
 		ex_ring[i].label = FLT_MAX;
-
-		ex_in_use_mutex.push_back(std::make_shared<std::mutex>());
-		ex_in_use_cond.push_back(std::make_shared<std::condition_variable>());
 	}
 	free_vectors_on_destruct = true;
 }
@@ -272,23 +345,45 @@ template <class T> ParseBuffer<T>::~ParseBuffer()
 		}
 	}
 	SG_FREE(ex_ring);
-	SG_FREE(ex_used);
+}
 
-	ex_in_use_mutex.clear();
-	ex_in_use_cond.clear();
-	read_mutex.reset();
-	write_mutex.reset();
+template <class T>
+Example<T>* ParseBuffer<T>::get_free_example()
+{
+	if (num_written - num_released.load(std::memory_order_acquire) >= ring_size)
+	{
+		// hand over what was written before waiting, and wait for a
+		// whole batch to be released rather than for every example
+		flush();
+		SG_PROFILE_SCOPE("ParseBuffer::writer_stall");
+		std::unique_lock<std::mutex> lk(wait_mutex);
+		writer_waits_for.store(num_written - ring_size + batch_size);
+		while (!closed.load()
+			&& num_written - num_released.load() >= ring_size)
+			not_full.wait(lk);
+		writer_waits_for.store(-1);
+	}
+	if (closed.load(std::memory_order_acquire))
+		return NULL;
+
+	return &ex_ring[ex_write_index];
 }
 
 template <class T>
 int32_t ParseBuffer<T>::write_example(Example<T> *ex)
 {
-	ex_ring[ex_write_index].label = ex->label;
-	ex_ring[ex_write_index].fv = ex->fv;
-	ex_ring[ex_write_index].length = ex->length;
-	ex_used[ex_write_index] = E_NOT_USED;
+	Example<T>* slot = &ex_ring[ex_write_index];
+	if (slot != ex)
+	{
+		slot->label = ex->label;
+		slot->fv = ex->fv;
+		slot->length = ex->length;
+	}
 	inc_write_index();
 
+	if (num_written - num_published.load(std::memory_order_relaxed) >= batch_size)
+		flush();
+
 	return 1;
 }
 
@@ -304,47 +399,74 @@ Example<T>* ParseBuffer<T>::return_example_to_read()
 template <class T>
 Example<T>* ParseBuffer<T>::get_unused_example()
 {
-	std::lock_guard<std::mutex> read_lk(*read_mutex);
-
-	Example<T> *ex;
-	int32_t current_index = ex_read_index;
-	// Because read index will change after return_example_to_read
+	if (num_read < num_published.load(std::memory_order_acquire))
+		return return_example_to_read();
 
-	std::lock_guard<std::mutex> current_ex_lk(*ex_in_use_mutex[current_index]);
+	return NULL;
+}
 
-	if (ex_used[current_index] == E_NOT_USED)
-		ex = return_example_to_read();
-	else
-		ex = NULL;
+template <class T>
+Example<T>* ParseBuffer<T>::wait_unused_example()
+{
+	Example<T>* ex = get_unused_example();
+	if (ex != NULL || closed.load(std::memory_order_acquire))
+		return ex;
 
-	return ex;
+	SG_PROFILE_SCOPE("ParseBuffer::reader_stall");
+	std::unique_lock<std::mutex> lk(wait_mutex);
+	reader_waits_for.store(num_read + 1);
+	while (!closed.load() && num_read >= num_published.load()
+		&& !finished.load())
+		not_empty.wait(lk);
+	reader_waits_for.store(-1);
+	lk.unlock();
+
+	// finish() publishes before it is flagged, so nothing is missed
+	if (closed.load(std::memory_order_acquire))
+		return NULL;
+	return get_unused_example();
 }
 
 template <class T>
 int32_t ParseBuffer<T>::copy_example(Example<T> *ex)
 {
-	std::lock_guard<std::mutex> write_lk(*write_mutex);
-	int32_t ret;
-	int32_t current_index = ex_write_index;
+	if (get_free_example() == NULL)
+		return 0;
 
-	std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[current_index]);
-	while (ex_used[ex_write_index] == E_NOT_USED)
-	{
-		ex_in_use_cond[ex_write_index]->wait(current_ex_lock);
-	}
+	return write_example(ex);
+}
 
-	ret = write_example(ex);
+template <class T>
+void ParseBuffer<T>::flush()
+{
+	if (num_published.load(std::memory_order_relaxed) == num_written)
+		return;
 
-	return ret;
+	num_published.store(num_written, std::memory_order_seq_cst);
+	wake_up(reader_waits_for, num_written, not_empty);
 }
 
 template <class T>
-void ParseBuffer<T>::finalize_example(bool free_after_release)
+void ParseBuffer<T>::finish()
 {
-	std::lock_guard<std::mutex> read_lk(*read_mutex);
-	std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[ex_read_index]);
-	ex_used[ex_read_index] = E_USED;
+	num_published.store(num_written, std::memory_order_seq_cst);
+	std::lock_guard<std::mutex> lk(wait_mutex);
+	finished.store(true);
+	not_empty.notify_one();
+}
 
+template <class T>
+void ParseBuffer<T>::close()
+{
+	std::lock_guard<std::mutex> lk(wait_mutex);
+	closed.store(true);
+	not_full.notify_one();
+	not_empty.notify_one();
+}
+
+template <class T>
+void ParseBuffer<T>::finalize_example(bool free_after_release)
+{
 	if (free_after_release)
 	{
 		SG_DEBUG("Freeing object in ring at index {} and address: {}.",
@@ -354,9 +476,9 @@ void ParseBuffer<T>::finalize_example(bool free_after_release)
 		ex_ring[ex_read_index].fv=NULL;
 	}
 
-	ex_in_use_cond[ex_read_index]->notify_one();
-	current_ex_lock.unlock();
 	inc_read_index();
+	num_released.store(num_read, std::memory_order_seq_cst);
+	wake_up(writer_waits_for, num_read, not_full);
 }
 
 }
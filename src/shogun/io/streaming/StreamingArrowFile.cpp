@@ -0,0 +1,146 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_ARROW
+
+#include <shogun/io/streaming/StreamingArrowFile.h>
+
+#include <shogun/io/ArrowColumn.h>
+#include <shogun/lib/memory.h>
+
+using namespace shogun;
+
+StreamingArrowFile::StreamingArrowFile() : StreamingFile()
+{
+	m_row=0;
+	m_label=-1;
+}
+
+StreamingArrowFile::StreamingArrowFile(
+	std::shared_ptr<ArrowFile> file, const char* label_column)
+	: StreamingFile()
+{
+	require(file, "No file provided.");
+
+	m_file=std::move(file);
+	if (label_column)
+		m_label_column=label_column;
+
+	reset_stream();
+}
+
+StreamingArrowFile::~StreamingArrowFile()
+{
+}
+
+void StreamingArrowFile::reset_stream()
+{
+	m_reader=m_file->read_batches();
+	m_batch=nullptr;
+	m_row=0;
+
+	const auto schema=m_reader->schema();
+	m_label=-1;
+	if (!m_label_column.empty())
+	{
+		m_label=schema->GetFieldIndex(m_label_column);
+		require(m_label>=0, "Label column '{}' not found in '{}'.",
+			m_label_column, m_file->get_filename());
+	}
+
+	/* batch columns are in file order, features follow the selection */
+	m_features.clear();
+	const auto& columns=m_file->get_columns();
+	if (columns.empty())
+	{
+		for (int c=0; c<schema->num_fields(); c++)
+			if (c!=m_label)
+				m_features.push_back(c);
+	}
+	else
+	{
+		for (const auto& name : columns)
+		{
+			const int c=schema->GetFieldIndex(name);
+			if (c!=m_label)
+				m_features.push_back(c);
+		}
+	}
+}
+
+bool StreamingArrowFile::next_row()
+{
+	if (m_batch && ++m_row<m_batch->num_rows())
+		return true;
+
+	do
+	{
+		io::check_arrow(m_reader->ReadNext(&m_batch), "Reading record batch");
+		if (!m_batch)
+			return false;
+	}
+	while (m_batch->num_rows()==0);
+
+	for (int c=0; c<m_batch->num_columns(); c++)
+		io::check_arrow_numeric(
+			*m_batch->column(c), m_batch->schema()->field(c)->name());
+
+	m_row=0;
+	return true;
+}
+
+template <class T>
+void StreamingArrowFile::read_row(T*& vector, int32_t& len)
+{
+	if (!next_row())
+	{
+		vector=NULL;
+		len=-1;
+		return;
+	}
+
+	const int32_t num_feat=m_features.size();
+	if (!vector || len<num_feat)
+		vector=SG_REALLOC(T, vector, vector ? len : 0, num_feat);
+	len=num_feat;
+
+	for (int32_t j=0; j<num_feat; j++)
+		io::copy_arrow_array(
+			*m_batch->column(m_features[j]), m_row, 1, vector+j, 1);
+}
+
+#define GET_VECTOR(sg_type)												\
+void StreamingArrowFile::get_vector(sg_type*& vector, int32_t& len)		\
+{																		\
+	read_row(vector, len);												\
+}																		\
+																		\
+void StreamingArrowFile::get_vector_and_label(							\
+	sg_type*& vector, int32_t& len, float64_t& label)					\
+{																		\
+	require(m_label>=0, "No label column set.");						\
+	read_row(vector, len);												\
+	if (vector)															\
+		io::copy_arrow_array(											\
+			*m_batch->column(m_label), m_row, 1, &label, 1);			\
+}
+
+GET_VECTOR(uint8_t)
+GET_VECTOR(int32_t)
+GET_VECTOR(float32_t)
+GET_VECTOR(float64_t)
+GET_VECTOR(int16_t)
+GET_VECTOR(uint16_t)
+GET_VECTOR(int8_t)
+GET_VECTOR(uint32_t)
+GET_VECTOR(int64_t)
+GET_VECTOR(uint64_t)
+GET_VECTOR(floatmax_t)
+#undef GET_VECTOR
+
+#endif // HAVE_ARROW
@@ -0,0 +1,118 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#ifndef __STREAMING_ARROWFILE_H__
+#define __STREAMING_ARROWFILE_H__
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_ARROW
+
+#include <shogun/io/ArrowFile.h>
+#include <shogun/io/streaming/StreamingFile.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace arrow
+{
+class RecordBatch;
+class RecordBatchReader;
+}
+
+namespace shogun
+{
+
+/** @brief Class StreamingArrowFile to read vector-by-vector from the record
+ * batches of an ArrowFile.
+ *
+ * The column selection and the predicates of the ArrowFile apply. One
+ * record batch is held in memory at a time, so Parquet and Arrow IPC files
+ * of any size can feed StreamingDenseFeatures.
+ */
+class StreamingArrowFile: public StreamingFile
+{
+public:
+	/** default constructor */
+	StreamingArrowFile();
+
+	/** constructor
+	 *
+	 * @param file the file to stream
+	 * @param label_column column of the labels, NULL if unlabelled
+	 */
+	StreamingArrowFile(
+		std::shared_ptr<ArrowFile> file, const char* label_column=NULL);
+
+	/** destructor */
+	~StreamingArrowFile() override;
+
+#ifndef SWIG // SWIG should skip this
+	/** @return true, the stream restarts at the first record batch */
+	bool is_seekable() override { return true; }
+
+	/** restart at the first record batch */
+	void reset_stream() override;
+
+#define GET_VECTOR_DECL(sg_type)					\
+	void get_vector						\
+		(sg_type*& vector, int32_t& len) override;			\
+									\
+	void get_vector_and_label				\
+		(sg_type*& vector, int32_t& len, float64_t& label) override;
+
+	GET_VECTOR_DECL(uint8_t)
+	GET_VECTOR_DECL(int32_t)
+	GET_VECTOR_DECL(float32_t)
+	GET_VECTOR_DECL(float64_t)
+	GET_VECTOR_DECL(int16_t)
+	GET_VECTOR_DECL(uint16_t)
+	GET_VECTOR_DECL(int8_t)
+	GET_VECTOR_DECL(uint32_t)
+	GET_VECTOR_DECL(int64_t)
+	GET_VECTOR_DECL(uint64_t)
+	GET_VECTOR_DECL(floatmax_t)
+#undef GET_VECTOR_DECL
+#endif // #ifndef SWIG
+
+	/** @return object name */
+	const char* get_name() const override { return "StreamingArrowFile"; }
+
+private:
+	/** @return whether there is a row left, loads the next record batch
+	 * when the current one is exhausted
+	 */
+	bool next_row();
+
+	/** copy the features of the current row into vector */
+	template <class T>
+	void read_row(T*& vector, int32_t& len);
+
+private:
+	/** the streamed file */
+	std::shared_ptr<ArrowFile> m_file;
+
+	/** column of the labels, empty if unlabelled */
+	std::string m_label_column;
+
+	/** record batches of the file */
+	std::shared_ptr<arrow::RecordBatchReader> m_reader;
+
+	/** current record batch */
+	std::shared_ptr<arrow::RecordBatch> m_batch;
+
+	/** current row of the batch */
+	int64_t m_row;
+
+	/** batch columns of the features */
+	std::vector<int> m_features;
+
+	/** batch column of the labels, -1 if unlabelled */
+	int m_label;
+};
+}
+#endif // HAVE_ARROW
+#endif // __STREAMING_ARROWFILE_H__
@@ -33,7 +33,7 @@ StreamingAsciiFile::~StreamingAsciiFile()
 /* Methods for reading dense vectors from an ascii file */
 
 #define GET_VECTOR(fname, conv, sg_type)									\
-void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& num_feat)	\
+void StreamingAsciiFile::parse_vector(sg_type*& vector, int32_t& num_feat)	\
 {																			\
 		char* buffer = NULL;												\
 		ssize_t bytes_read;													\
@@ -116,7 +116,7 @@ GET_VECTOR(get_longreal_vector, atoi, floatmax_t)
 #undef GET_VECTOR
 
 #define GET_FLOAT_VECTOR(sg_type)											\
-		void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& len)\
+		void StreamingAsciiFile::parse_vector(sg_type*& vector, int32_t& len)\
 		{																	\
 				char *line=NULL;											\
 				SG_SET_LOCALE_C;											\
@@ -155,7 +155,7 @@ GET_FLOAT_VECTOR(float64_t)
 /* Methods for reading a dense vector and a label from an ascii file */
 
 #define GET_VECTOR_AND_LABEL(fname, conv, sg_type)						\
-		void StreamingAsciiFile::get_vector_and_label(sg_type*& vector, int32_t& num_feat, float64_t& label) \
+		void StreamingAsciiFile::parse_vector_and_label(sg_type*& vector, int32_t& num_feat, float64_t& label) \
 		{																\
 				char* buffer = NULL;									\
 				ssize_t bytes_read;										\
@@ -240,7 +240,7 @@ GET_VECTOR_AND_LABEL(get_longreal_vector_and_label, atoi, floatmax_t)
 #undef GET_VECTOR_AND_LABEL
 
 #define GET_FLOAT_VECTOR_AND_LABEL(sg_type)								\
-		void StreamingAsciiFile::get_vector_and_label(sg_type*& vector, int32_t& len, float64_t& label) \
+		void StreamingAsciiFile::parse_vector_and_label(sg_type*& vector, int32_t& len, float64_t& label) \
 		{																\
 				char *line=NULL;										\
 				SG_SET_LOCALE_C;										\
@@ -395,7 +395,7 @@ GET_STRING_AND_LABEL(get_longreal_string_and_label, atoi, floatmax_t)
 /* Methods for reading a sparse vector from an ascii file */
 
 #define GET_SPARSE_VECTOR(fname, conv, sg_type)							\
-void StreamingAsciiFile::get_sparse_vector(SGSparseVectorEntry<sg_type>*& vector, int32_t& len) \
+void StreamingAsciiFile::parse_sparse_vector(SGSparseVectorEntry<sg_type>*& vector, int32_t& len) \
 {																		\
 		char* buffer = NULL;											\
 		ssize_t bytes_read;												\
@@ -489,7 +489,7 @@ GET_SPARSE_VECTOR(get_longreal_sparse_vector, atoi, floatmax_t)
 /* Methods for reading a sparse vector and a label from an ascii file */
 
 #define GET_SPARSE_VECTOR_AND_LABEL(fname, conv, sg_type)				\
-void StreamingAsciiFile::get_sparse_vector_and_label(SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label) \
+void StreamingAsciiFile::parse_sparse_vector_and_label(SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label) \
 {																		\
 		char* buffer = NULL;											\
 		ssize_t bytes_read;												\
@@ -621,6 +621,93 @@ void StreamingAsciiFile::set_delimiter(char delimiter)
 {
 	m_delimiter = delimiter;
 }
+
+void StreamingAsciiFile::set_cache_file(const char* fname)
+{
+	m_cache = std::make_unique<StreamingCache>(fname);
+	m_cache->start_writing();
+}
+
+bool StreamingAsciiFile::is_seekable()
+{
+	return filename && buf;
+}
+
+void StreamingAsciiFile::reset_stream()
+{
+	require(is_seekable(), "Unable to reset the input stream!");
+
+	if (m_cache && m_cache->is_complete())
+	{
+		m_cache->start_reading();
+		return;
+	}
+
+	buf->reset_file();
+	if (m_cache)
+		m_cache->start_writing();
+}
+
+/* Methods reading from the cache or parsing and writing to the cache */
+
+#define GET_CACHED_VECTOR(sg_type)										\
+void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& len)		\
+{																		\
+	if (m_cache && m_cache->is_reading())								\
+		return m_cache->read(vector, len, NULL);						\
+																		\
+	parse_vector(vector, len);											\
+	if (m_cache)														\
+		m_cache->write(vector, len, NULL);								\
+}																		\
+																		\
+void StreamingAsciiFile::get_vector_and_label(							\
+	sg_type*& vector, int32_t& len, float64_t& label)					\
+{																		\
+	if (m_cache && m_cache->is_reading())								\
+		return m_cache->read(vector, len, &label);						\
+																		\
+	parse_vector_and_label(vector, len, label);							\
+	if (m_cache)														\
+		m_cache->write(vector, len, &label);							\
+}																		\
+																		\
+void StreamingAsciiFile::get_sparse_vector(								\
+	SGSparseVectorEntry<sg_type>*& vector, int32_t& len)				\
+{																		\
+	if (m_cache && m_cache->is_reading())								\
+		return m_cache->read(vector, len, NULL);						\
+																		\
+	parse_sparse_vector(vector, len);									\
+	if (m_cache)														\
+		m_cache->write(vector, len, NULL);								\
+}																		\
+																		\
+void StreamingAsciiFile::get_sparse_vector_and_label(					\
+	SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label) \
+{																		\
+	if (m_cache && m_cache->is_reading())								\
+		return m_cache->read(vector, len, &label);						\
+																		\
+	parse_sparse_vector_and_label(vector, len, label);					\
+	if (m_cache)														\
+		m_cache->write(vector, len, &label);							\
+}
+
+GET_CACHED_VECTOR(bool)
+GET_CACHED_VECTOR(uint8_t)
+GET_CACHED_VECTOR(char)
+GET_CACHED_VECTOR(int32_t)
+GET_CACHED_VECTOR(float32_t)
+GET_CACHED_VECTOR(float64_t)
+GET_CACHED_VECTOR(int16_t)
+GET_CACHED_VECTOR(uint16_t)
+GET_CACHED_VECTOR(int8_t)
+GET_CACHED_VECTOR(uint32_t)
+GET_CACHED_VECTOR(int64_t)
+GET_CACHED_VECTOR(uint64_t)
+GET_CACHED_VECTOR(floatmax_t)
+#undef GET_CACHED_VECTOR
 void StreamingAsciiFile::tokenize(char delim, substring s, v_array<substring>& ret)
 {
 	ret.erase();
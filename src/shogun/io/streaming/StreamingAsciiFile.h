@@ -9,9 +9,12 @@
 
 #include <shogun/lib/config.h>
 
+#include <shogun/io/streaming/StreamingCache.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/lib/v_array.h>
 
+#include <memory>
+
 namespace shogun
 {
 
@@ -51,7 +54,20 @@ public:
 	 */
 	void set_delimiter(char delimiter);
 
+	/** cache the parsed dense and sparse vectors of a pass in a binary
+	 * file, passes after a complete one read the cache instead of parsing
+	 *
+	 * @param fname name of the cache file, removed with this object
+	 */
+	void set_cache_file(const char* fname);
+
 #ifndef SWIG // SWIG should skip this
+	/** @return whether the stream reads from a named file */
+	bool is_seekable() override;
+
+	/** restart at the first vector, from the cache if it is complete */
+	void reset_stream() override;
+
 	/**
 	 * Utility function to convert a string to a boolean value
 	 *
@@ -108,6 +124,32 @@ public:
 	}
 
 private:
+#ifndef SWIG // SWIG should skip this
+#define PARSE_VECTOR_DECL(sg_type)					\
+	void parse_vector(sg_type*& vector, int32_t& len);	\
+	void parse_vector_and_label							\
+		(sg_type*& vector, int32_t& len, float64_t& label);	\
+	void parse_sparse_vector							\
+		(SGSparseVectorEntry<sg_type>*& vector, int32_t& len);	\
+	void parse_sparse_vector_and_label					\
+		(SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label);
+
+	PARSE_VECTOR_DECL(bool)
+	PARSE_VECTOR_DECL(uint8_t)
+	PARSE_VECTOR_DECL(char)
+	PARSE_VECTOR_DECL(int32_t)
+	PARSE_VECTOR_DECL(float32_t)
+	PARSE_VECTOR_DECL(float64_t)
+	PARSE_VECTOR_DECL(int16_t)
+	PARSE_VECTOR_DECL(uint16_t)
+	PARSE_VECTOR_DECL(int8_t)
+	PARSE_VECTOR_DECL(uint32_t)
+	PARSE_VECTOR_DECL(int64_t)
+	PARSE_VECTOR_DECL(uint64_t)
+	PARSE_VECTOR_DECL(floatmax_t)
+#undef PARSE_VECTOR_DECL
+#endif // #ifndef SWIG
+
 	/** helper function to read vectors / matrices
 	 *
 	 * @param items dynamic array of values
@@ -132,6 +174,9 @@ private:
 
 	/** delimiter */
 	char m_delimiter;
+
+	/** cache of the parsed vectors, NULL if not cached */
+	std::unique_ptr<StreamingCache> m_cache;
 };
 }
 #endif //__STREAMING_ASCIIFILE_H__
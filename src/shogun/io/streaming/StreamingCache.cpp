@@ -0,0 +1,126 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/io/streaming/StreamingCache.h>
+#include <shogun/io/SGIO.h>
+
+#include <cstring>
+
+using namespace shogun;
+
+namespace
+{
+	const char cache_magic[8]={'S', 'G', 'C', 'A', 'C', 'H', 'E', '1'};
+	const size_t cache_buffer_size=1<<20;
+}
+
+StreamingCache::StreamingCache(const char* fname)
+{
+	require(fname, "No cache file name provided.");
+
+	m_fname=fname;
+	m_file=NULL;
+	m_complete=false;
+	m_reading=false;
+	m_value_size=0;
+	m_labelled=false;
+}
+
+StreamingCache::~StreamingCache()
+{
+	if (m_file)
+		fclose(m_file);
+	remove(m_fname.c_str());
+}
+
+void StreamingCache::start_writing()
+{
+	if (m_file)
+		fclose(m_file);
+
+	m_file=fopen(m_fname.c_str(), "wb");
+	if (!m_file)
+		error("Could not open cache file '{}'.", m_fname);
+	setvbuf(m_file, NULL, _IOFBF, cache_buffer_size);
+
+	m_complete=false;
+	m_reading=false;
+	m_value_size=0;
+}
+
+void StreamingCache::start_reading()
+{
+	require(m_complete, "Cache file '{}' is incomplete.", m_fname);
+
+	if (m_file)
+		fclose(m_file);
+
+	m_file=fopen(m_fname.c_str(), "rb");
+	if (!m_file)
+		error("Could not open cache file '{}'.", m_fname);
+	setvbuf(m_file, NULL, _IOFBF, cache_buffer_size);
+	m_reading=true;
+
+	char magic[sizeof(cache_magic)];
+	const size_t num_read=fread(magic, 1, sizeof(magic), m_file);
+	if (num_read==0)
+		return;
+
+	uint8_t labelled=0;
+	if (num_read!=sizeof(magic) || memcmp(magic, cache_magic, sizeof(magic)) ||
+			fread(&m_value_size, sizeof(m_value_size), 1, m_file)!=1 ||
+			fread(&labelled, sizeof(labelled), 1, m_file)!=1)
+		error("Cache file '{}' is corrupt.", m_fname);
+	m_labelled=labelled;
+}
+
+void StreamingCache::finish()
+{
+	if (fclose(m_file))
+		error("Could not write cache file '{}'.", m_fname);
+	m_file=NULL;
+	m_complete=true;
+}
+
+void StreamingCache::write_example(
+	const void* vector, int32_t len, size_t size, const float64_t* label)
+{
+	if (m_value_size==0)
+	{
+		m_value_size=size;
+		m_labelled=label!=NULL;
+		const uint8_t labelled=m_labelled;
+		fwrite(cache_magic, 1, sizeof(cache_magic), m_file);
+		fwrite(&m_value_size, sizeof(m_value_size), 1, m_file);
+		fwrite(&labelled, sizeof(labelled), 1, m_file);
+	}
+
+	fwrite(&len, sizeof(len), 1, m_file);
+	if (label)
+		fwrite(label, sizeof(float64_t), 1, m_file);
+	if (fwrite(vector, size, len, m_file)!=size_t(len))
+		error("Could not write cache file '{}'.", m_fname);
+}
+
+int32_t StreamingCache::read_length(size_t size, const float64_t* label)
+{
+	int32_t len;
+	if (!m_file || fread(&len, sizeof(len), 1, m_file)!=1)
+		return -1;
+
+	if (size_t(m_value_size)!=size || m_labelled!=(label!=NULL))
+		error("Cache file '{}' holds other examples than requested.", m_fname);
+
+	return len;
+}
+
+void StreamingCache::read_values(
+	void* vector, int32_t len, size_t size, float64_t* label)
+{
+	if ((label && fread(label, sizeof(float64_t), 1, m_file)!=1) ||
+			fread(vector, size, len, m_file)!=size_t(len))
+		error("Cache file '{}' is truncated.", m_fname);
+}
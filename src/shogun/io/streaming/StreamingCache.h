@@ -0,0 +1,130 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#ifndef __STREAMING_CACHE_H__
+#define __STREAMING_CACHE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/memory.h>
+
+#include <cstdio>
+#include <string>
+
+namespace shogun
+{
+
+/** @brief Binary cache of the examples of one pass over a StreamingFile.
+ *
+ * While writing, every parsed example is appended as its length, its
+ * label and its raw values. Once a pass has ended, the next passes read
+ * the examples back without parsing. A pass that is reset before its end
+ * leaves the cache incomplete, the next pass writes it again.
+ */
+class StreamingCache
+{
+public:
+	/** constructor
+	 *
+	 * @param fname name of the cache file
+	 */
+	StreamingCache(const char* fname);
+
+	/** destructor, removes the cache file */
+	~StreamingCache();
+
+	/** @return whether the cache holds a complete pass */
+	bool is_complete() const { return m_complete; }
+
+	/** @return whether examples are read from the cache */
+	bool is_reading() const { return m_reading; }
+
+	/** start a pass that writes the cache */
+	void start_writing();
+
+	/** start a pass that reads the complete cache */
+	void start_reading();
+
+	/** append an example of the pass that writes the cache, a negative
+	 * length ends the pass
+	 *
+	 * @param vector values
+	 * @param len number of values
+	 * @param label label, NULL if unlabelled
+	 */
+	template <class T>
+	void write(const T* vector, int32_t len, const float64_t* label)
+	{
+		if (!m_file || m_reading)
+			return;
+
+		if (len<0)
+		{
+			finish();
+			return;
+		}
+
+		write_example(vector, len, sizeof(T), label);
+	}
+
+	/** read the next example of the pass that reads the cache, len is -1
+	 * after the last example
+	 *
+	 * @param vector values, grown if shorter than len
+	 * @param len number of values
+	 * @param label label, NULL if unlabelled
+	 */
+	template <class T>
+	void read(T*& vector, int32_t& len, float64_t* label)
+	{
+		const int32_t num=read_length(sizeof(T), label);
+		if (num<0)
+		{
+			vector=NULL;
+			len=-1;
+			return;
+		}
+
+		if (!vector || len<num)
+			vector=SG_REALLOC(T, vector, vector ? len : 0, num);
+		len=num;
+		read_values(vector, num, sizeof(T), label);
+	}
+
+private:
+	/** append an example */
+	void write_example(
+		const void* vector, int32_t len, size_t size, const float64_t* label);
+
+	/** @return length of the next example, -1 after the last */
+	int32_t read_length(size_t size, const float64_t* label);
+
+	/** read the label and values of the example whose length was read */
+	void read_values(void* vector, int32_t len, size_t size, float64_t* label);
+
+	/** close the pass that writes the cache */
+	void finish();
+
+private:
+	/** name of the cache file */
+	std::string m_fname;
+
+	/** open cache file */
+	FILE* m_file;
+
+	/** whether the cache holds a complete pass */
+	bool m_complete;
+
+	/** whether examples are read from the cache */
+	bool m_reading;
+
+	/** size of the cached values, 0 before the first example */
+	int32_t m_value_size;
+	/** whether cached examples have labels */
+	bool m_labelled;
+};
+}
+#endif // __STREAMING_CACHE_H__
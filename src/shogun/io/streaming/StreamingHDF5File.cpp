@@ -0,0 +1,140 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_HDF5
+
+#include <shogun/io/streaming/StreamingHDF5File.h>
+
+#include <shogun/lib/memory.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+StreamingHDF5File::StreamingHDF5File() : StreamingFile()
+{
+	m_block_size=1024;
+	m_block_type=NULL;
+	m_num_feat=0;
+	m_block_start=0;
+	m_block_len=0;
+	m_row=0;
+}
+
+StreamingHDF5File::StreamingHDF5File(
+	std::shared_ptr<HDF5File> file, const char* label_name,
+	int32_t block_size)
+	: StreamingFile()
+{
+	require(file, "No file provided.");
+	require(block_size>0, "Block size must be positive.");
+
+	m_file=std::move(file);
+	if (label_name)
+		m_label_name=label_name;
+	m_block_size=block_size;
+
+	reset_stream();
+}
+
+StreamingHDF5File::~StreamingHDF5File()
+{
+}
+
+void StreamingHDF5File::reset_stream()
+{
+	m_block=nullptr;
+	m_block_type=NULL;
+	m_block_labels=SGVector<float64_t>();
+	m_num_feat=0;
+	m_block_start=0;
+	m_block_len=0;
+	m_row=0;
+}
+
+template <class T>
+bool StreamingHDF5File::read_vector(T*& vector, int32_t& len)
+{
+	if (m_block && m_block_type!=&typeid(T))
+	{
+		/* re-read the current block as T */
+		m_block=nullptr;
+		m_block_start+=m_row;
+		m_block_len=0;
+		m_row=0;
+	}
+
+	if (m_row>=m_block_len)
+	{
+		m_block_start+=m_block_len;
+		m_row=0;
+
+		T* block=NULL;
+		int32_t num_vec=m_block_size;
+		m_file->get_matrix_range(block, m_num_feat, m_block_start, num_vec);
+		m_block.reset(block, [](void* ptr) { SG_FREE(static_cast<T*>(ptr)); });
+		m_block_type=&typeid(T);
+		m_block_len=num_vec;
+
+		if (!m_label_name.empty())
+		{
+			float64_t* labels=NULL;
+			int32_t num_labels=num_vec;
+			m_file->get_vector_range(
+				labels, m_block_start, num_labels, m_label_name.c_str());
+			m_block_labels=SGVector<float64_t>(labels, num_labels);
+			require(num_labels==num_vec, "Only {} labels for {} vectors.",
+				m_block_start+num_labels, m_block_start+num_vec);
+		}
+
+		if (m_block_len==0)
+		{
+			vector=NULL;
+			len=-1;
+			return false;
+		}
+	}
+
+	if (!vector || len<m_num_feat)
+		vector=SG_REALLOC(T, vector, vector ? len : 0, m_num_feat);
+	len=m_num_feat;
+
+	const T* block=static_cast<const T*>(m_block.get());
+	std::copy_n(block+int64_t(m_row)*m_num_feat, m_num_feat, vector);
+	m_row++;
+	return true;
+}
+
+#define GET_VECTOR(sg_type)												\
+void StreamingHDF5File::get_vector(sg_type*& vector, int32_t& len)		\
+{																		\
+	read_vector(vector, len);											\
+}																		\
+																		\
+void StreamingHDF5File::get_vector_and_label(							\
+	sg_type*& vector, int32_t& len, float64_t& label)					\
+{																		\
+	require(!m_label_name.empty(), "No label dataset set.");			\
+	if (read_vector(vector, len))										\
+		label=m_block_labels[m_row-1];									\
+}
+
+GET_VECTOR(uint8_t)
+GET_VECTOR(int32_t)
+GET_VECTOR(float32_t)
+GET_VECTOR(float64_t)
+GET_VECTOR(int16_t)
+GET_VECTOR(uint16_t)
+GET_VECTOR(int8_t)
+GET_VECTOR(uint32_t)
+GET_VECTOR(int64_t)
+GET_VECTOR(uint64_t)
+GET_VECTOR(floatmax_t)
+#undef GET_VECTOR
+
+#endif // HAVE_HDF5
@@ -0,0 +1,123 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#ifndef __STREAMING_HDF5FILE_H__
+#define __STREAMING_HDF5FILE_H__
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_HDF5
+
+#include <shogun/io/HDF5File.h>
+#include <shogun/io/streaming/StreamingFile.h>
+#include <shogun/lib/SGVector.h>
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+
+namespace shogun
+{
+
+/** @brief Class StreamingHDF5File to read vector-by-vector from a matrix
+ * in a HDF5File.
+ *
+ * Vectors are read in blocks with HDF5File::get_matrix_range(), so only
+ * one block of a matrix of any size is held in memory. Labels are read
+ * from a second dataset of the same file.
+ */
+class StreamingHDF5File: public StreamingFile
+{
+public:
+	/** default constructor */
+	StreamingHDF5File();
+
+	/** constructor
+	 *
+	 * @param file the file, its variable name is the matrix to stream
+	 * @param label_name dataset of the labels, NULL if unlabelled
+	 * @param block_size number of vectors read at once
+	 */
+	StreamingHDF5File(
+		std::shared_ptr<HDF5File> file, const char* label_name=NULL,
+		int32_t block_size=1024);
+
+	/** destructor */
+	~StreamingHDF5File() override;
+
+#ifndef SWIG // SWIG should skip this
+	/** @return true, the stream restarts at the first vector */
+	bool is_seekable() override { return true; }
+
+	/** restart at the first vector */
+	void reset_stream() override;
+
+#define GET_VECTOR_DECL(sg_type)					\
+	void get_vector						\
+		(sg_type*& vector, int32_t& len) override;			\
+									\
+	void get_vector_and_label				\
+		(sg_type*& vector, int32_t& len, float64_t& label) override;
+
+	GET_VECTOR_DECL(uint8_t)
+	GET_VECTOR_DECL(int32_t)
+	GET_VECTOR_DECL(float32_t)
+	GET_VECTOR_DECL(float64_t)
+	GET_VECTOR_DECL(int16_t)
+	GET_VECTOR_DECL(uint16_t)
+	GET_VECTOR_DECL(int8_t)
+	GET_VECTOR_DECL(uint32_t)
+	GET_VECTOR_DECL(int64_t)
+	GET_VECTOR_DECL(uint64_t)
+	GET_VECTOR_DECL(floatmax_t)
+#undef GET_VECTOR_DECL
+#endif // #ifndef SWIG
+
+	/** @return object name */
+	const char* get_name() const override { return "StreamingHDF5File"; }
+
+private:
+	/** copy the next vector into vector, reads the next block when the
+	 * current one is exhausted
+	 *
+	 * @return whether there was a vector left
+	 */
+	template <class T>
+	bool read_vector(T*& vector, int32_t& len);
+
+private:
+	/** the streamed file */
+	std::shared_ptr<HDF5File> m_file;
+
+	/** dataset of the labels, empty if unlabelled */
+	std::string m_label_name;
+
+	/** number of vectors read at once */
+	int32_t m_block_size;
+
+	/** current block of vectors */
+	std::shared_ptr<void> m_block;
+
+	/** element type of the current block */
+	const std::type_info* m_block_type;
+
+	/** labels of the current block */
+	SGVector<float64_t> m_block_labels;
+
+	/** number of features */
+	int32_t m_num_feat;
+
+	/** index of the first vector of the block */
+	int32_t m_block_start;
+
+	/** number of vectors in the block */
+	int32_t m_block_len;
+
+	/** index of the current vector in the block */
+	int32_t m_row;
+};
+}
+#endif // HAVE_HDF5
+#endif // __STREAMING_HDF5FILE_H__
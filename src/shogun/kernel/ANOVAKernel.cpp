@@ -7,6 +7,9 @@
 
 #include <shogun/mathematics/Math.h>
 #include <shogun/kernel/ANOVAKernel.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
 
 using namespace shogun;
 
@@ -91,24 +94,24 @@ float64_t ANOVAKernel::compute_rec2(int32_t idx_a, int32_t idx_b)
 
 float64_t ANOVAKernel::compute_recursive1(float64_t* avec, float64_t* bvec, int32_t len)
 {
-	int32_t DP_len=(m_cardinality+1)*(len+1);
+	int32_t d=m_cardinality;
+	// TRAP d>len case
+	if (d>len)
+		return 0.0;
+
+	// DP[k*offs+j] is the sum of the products of all k element subsets
+	// of the first j dimensions
+	int32_t offs=len+1;
+	int32_t DP_len=(m_cardinality+1)*offs;
 	float64_t* DP = SG_MALLOC(float64_t, DP_len);
 
 	ASSERT(DP)
-	int32_t d=m_cardinality;
-	int32_t offs=m_cardinality+1;
-
-	ASSERT(DP_len==(len+1)*offs)
 
 	for (int32_t j=0; j < len+1; j++)
 		DP[j] = 1.0;
 
 	for (int32_t k=1; k < d+1; k++)
 	{
-		// TRAP d>len case
-		if (k-1>=len)
-			return 0.0;
-
 		DP[k*offs+k-1] = 0;
 		for (int32_t j=k; j < len+1; j++)
 			DP[k*offs+j]=DP[k*offs+j-1]+avec[j-1]*bvec[j-1]*DP[(k-1)*offs+j-1];
@@ -166,4 +169,41 @@ float64_t ANOVAKernel::compute_recursive2(float64_t* avec, float64_t* bvec, int3
 	SG_FREE(KD);
 
 	return result;
-}
\ No newline at end of file
+}
+
+bool ANOVAKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	SGMatrix<float64_t> lhs_block, rhs_block;
+	if (!get_dense_block(lhs_idx, rhs_idx, lhs_block, rhs_block))
+		return false;
+
+	// the lhs vectors are rows, so that every step of the recursion is
+	// an operation on contiguous columns
+	const Eigen::ArrayXXd x=Eigen::Map<const Eigen::ArrayXXd>(
+		lhs_block.matrix, lhs_block.num_rows, lhs_block.num_cols).transpose();
+	Eigen::Map<const Eigen::ArrayXXd> y(
+		rhs_block.matrix, rhs_block.num_rows, rhs_block.num_cols);
+	const index_t len=x.cols();
+	const int32_t d=m_cardinality;
+
+	// dp.col(k) is the sum of the products of all k element subsets of
+	// the dimensions seen so far
+	Eigen::ArrayXXd dp(x.rows(), d+1);
+	for (index_t j=0; j<block.num_cols; ++j)
+	{
+		dp.col(0).setOnes();
+		dp.rightCols(d).setZero();
+		for (index_t i=0; i<len; ++i)
+		{
+			const float64_t b=y(i, j);
+			for (int32_t k=std::min<index_t>(d, i+1); k>0; --k)
+				dp.col(k)+=b*x.col(i)*dp.col(k-1);
+		}
+		Eigen::Map<Eigen::ArrayXd>(block.get_column_vector(j), block.num_rows)=
+			dp.col(d);
+	}
+
+	return true;
+}
@@ -95,6 +95,20 @@ private:
 protected:
 	float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+	/** compute a block of kernel values, see Kernel::compute_block()
+	 *
+	 * For dense features the recursion of compute_rec1() runs on all
+	 * lhs vectors at once for every rhs vector.
+	 *
+	 * @param lhs_idx indices of the lhs vectors of the block
+	 * @param rhs_idx indices of the rhs vectors of the block
+	 * @param block preallocated block of the kernel matrix
+	 * @return whether the block was computed
+	 */
+	bool compute_block(
+		const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+		SGMatrix<float64_t>& block) override;
+
 protected:
 	/// degree parameter of kernel
 	int32_t m_cardinality = 1;
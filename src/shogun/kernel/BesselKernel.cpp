@@ -5,6 +5,7 @@
  */
 
 #include <shogun/kernel/BesselKernel.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/Math.h>
 
 #include <utility>
@@ -64,3 +65,15 @@ float64_t BesselKernel::compute(int32_t idx_a, int32_t idx_b)
 	float64_t dist = distance->distance(idx_a, idx_b);
 	return jn(order,dist/width)/Math::pow(dist,-degree*order);
 }
+
+bool BesselKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto dist=distance->get_distance_block(lhs_idx, rhs_idx);
+	simd::pow(dist.matrix, -degree*order, block.matrix, block.size());
+	for (int64_t k=0; k<block.size(); ++k)
+		block.matrix[k]=jn(order, dist.matrix[k]/width)/block.matrix[k];
+
+	return true;
+}
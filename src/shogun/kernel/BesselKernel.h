@@ -166,6 +166,20 @@ class BesselKernel: public DistanceKernel
 	protected:
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute a block of kernel values, see Kernel::compute_block()
+		 *
+		 * The distances are computed with Distance::get_distance_block()
+		 * and the powers in bulk, see simd::pow().
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return whether the block was computed
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 	private:
 		void init();
 
@@ -58,3 +58,14 @@ float64_t CauchyKernel::compute(int32_t idx_a, int32_t idx_b)
 	float64_t dist = m_distance->distance(idx_a, idx_b);
 	return 1.0/(1.0+dist*dist/m_sigma);
 }
+
+bool CauchyKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto dist=m_distance->get_distance_block(lhs_idx, rhs_idx);
+	for (int64_t k=0; k<block.size(); ++k)
+		block.matrix[k]=1.0/(1.0+dist.matrix[k]*dist.matrix[k]/m_sigma);
+
+	return true;
+}
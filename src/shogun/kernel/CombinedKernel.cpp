@@ -15,8 +15,10 @@
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/features/CombinedFeatures.h>
 #include <string.h>
+#include <algorithm>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
 using namespace Eigen;
@@ -173,6 +175,7 @@ bool CombinedKernel::init_with_extracted_subsets(
 
 	init_normalizer();
 	initialized = true;
+	init_subkernel_caches();
 	return true;
 }
 
@@ -255,6 +258,7 @@ bool CombinedKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features>
 void CombinedKernel::remove_lhs()
 {
 	delete_optimization();
+	m_subkernel_caches.clear();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -272,6 +276,7 @@ void CombinedKernel::remove_lhs()
 void CombinedKernel::remove_rhs()
 {
 	delete_optimization();
+	m_subkernel_caches.clear();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -289,6 +294,7 @@ void CombinedKernel::remove_rhs()
 void CombinedKernel::remove_lhs_and_rhs()
 {
 	delete_optimization();
+	m_subkernel_caches.clear();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -315,6 +321,7 @@ void CombinedKernel::cleanup()
 	}
 
 	delete_optimization();
+	m_subkernel_caches.clear();
 
 	Kernel::cleanup();
 
@@ -339,17 +346,161 @@ void CombinedKernel::list_kernels()
 float64_t CombinedKernel::compute(int32_t x, int32_t y)
 {
 	float64_t result=0;
+	const bool cached=m_subkernel_caches.size()==kernel_array.size();
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
 		auto k = get_kernel(k_idx);
-		if (k->get_combined_kernel_weight()!=0)
-			result += k->get_combined_kernel_weight() * k->kernel(x,y);
+		const float64_t weight=k->get_combined_kernel_weight();
+		if (weight==0)
+			continue;
 
+		if (cached && m_subkernel_caches[k_idx])
+			result += weight * get_subkernel_row(k_idx, y)[x];
+		else
+			result += weight * k->kernel(x,y);
 	}
 
 	return result;
 }
 
+bool CombinedKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	const index_t num_kernels=get_num_kernels();
+	std::vector<SGMatrix<float64_t>> blocks(num_kernels);
+
+#pragma omp parallel for schedule(dynamic)
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+	{
+		if (kernel_array[k_idx]->get_combined_kernel_weight()!=0)
+			blocks[k_idx]=compute_subkernel_block(k_idx, lhs_idx, rhs_idx);
+	}
+
+	block.zero();
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+	{
+		const float64_t weight=kernel_array[k_idx]->get_combined_kernel_weight();
+		if (weight!=0)
+			linalg::add(block, blocks[k_idx], block, 1.0, weight);
+	}
+
+	return true;
+}
+
+SGMatrix<float64_t> CombinedKernel::compute_subkernel_block(
+	index_t k_idx, const SGVector<index_t>& lhs_idx,
+	const SGVector<index_t>& rhs_idx)
+{
+	if (m_subkernel_caches.size()!=kernel_array.size() ||
+		!m_subkernel_caches[k_idx])
+		return kernel_array[k_idx]->get_kernel_block(lhs_idx, rhs_idx);
+
+	SGMatrix<float64_t> block(lhs_idx.vlen, rhs_idx.vlen);
+	for (index_t j=0; j<rhs_idx.vlen; ++j)
+	{
+		auto row=get_subkernel_row(k_idx, rhs_idx[j]);
+		for (index_t i=0; i<lhs_idx.vlen; ++i)
+			block(i, j)=row[lhs_idx[i]];
+	}
+
+	return block;
+}
+
+SGVector<float64_t> CombinedKernel::compute_subkernel_quadratic_forms(
+	const SGVector<index_t>& idx, const SGVector<float64_t>& coef)
+{
+	require(idx.vlen==coef.vlen, "Number of vectors ({}) and coefficients "
+		"({}) must match", idx.vlen, coef.vlen);
+
+	const index_t num_kernels=get_num_kernels();
+	const index_t n=idx.vlen;
+
+	// blocks of columns hold about a million kernel values each
+	const index_t block_size=
+		Math::max(index_t(1), Math::min(n, index_t(1<<20)/Math::max(n, index_t(1))));
+	const index_t num_blocks=(n+block_size-1)/block_size;
+	SGVector<float64_t> partial(num_kernels*num_blocks);
+	partial.zero();
+
+#pragma omp parallel for schedule(dynamic)
+	for (index_t task=0; task<num_kernels*num_blocks; task++)
+	{
+		const index_t k_idx=task/num_blocks;
+		const index_t start=(task%num_blocks)*block_size;
+		const index_t len=Math::min(block_size, n-start);
+
+		SGVector<index_t> cols(len);
+		std::copy_n(idx.vector+start, len, cols.vector);
+		auto block=compute_subkernel_block(k_idx, idx, cols);
+
+		float64_t sum=0;
+		for (index_t j=0; j<len; ++j)
+		{
+			float64_t col_sum=0;
+			for (index_t i=0; i<n; ++i)
+				col_sum+=coef[i]*block(i, j);
+			sum+=coef[start+j]*col_sum;
+		}
+		partial[task]=sum;
+	}
+
+	SGVector<float64_t> result(num_kernels);
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+	{
+		result[k_idx]=0;
+		for (index_t b=0; b<num_blocks; b++)
+			result[k_idx]+=partial[k_idx*num_blocks+b];
+	}
+
+	return result;
+}
+
+SGVector<float64_t> CombinedKernel::get_subkernel_row(index_t k_idx, index_t row)
+{
+	const auto& k=kernel_array[k_idx];
+
+	// rows are indexed by the rhs vector and hold all lhs vectors
+	auto compute_row=[&k](index_t idx, float64_t* data) {
+		SGVector<index_t> all_lhs(k->get_num_vec_lhs());
+		all_lhs.range_fill();
+		auto column=k->get_kernel_block(all_lhs, SGVector<index_t>({idx}));
+		std::copy_n(column.matrix, all_lhs.vlen, data);
+	};
+
+	return m_subkernel_caches[k_idx]->get_row(row, compute_row);
+}
+
+void CombinedKernel::set_subkernel_caching(bool caching)
+{
+	m_subkernel_caching=caching;
+	if (initialized && has_features())
+		init_subkernel_caches();
+	else
+		m_subkernel_caches.clear();
+}
+
+void CombinedKernel::init_subkernel_caches()
+{
+	m_subkernel_caches.clear();
+	if (!m_subkernel_caching || num_lhs<=0 || num_rhs<=0)
+		return;
+
+	const index_t num_kernels=get_num_kernels();
+	const int64_t size=std::max<int64_t>(cache_size/std::max(num_kernels, 1), 1);
+	m_subkernel_caches.resize(num_kernels);
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+	{
+		if (kernel_array[k_idx]->get_kernel_type()==K_CUSTOM)
+			continue;
+
+		m_subkernel_caches[k_idx]=std::make_shared<KernelRowCache<float64_t>>(
+			num_rhs, num_lhs, size);
+	}
+
+	SG_DEBUG("Caching rows of {} subkernels with {} MB each", num_kernels, size)
+}
+
 bool CombinedKernel::init_optimization(
 	int32_t count, int32_t *IDX, float64_t *weights)
 {
@@ -716,7 +867,7 @@ bool CombinedKernel::precompute_subkernels()
 
 
 	kernel_array=new_kernel_array;
-
+	m_subkernel_caches.clear();
 
 	return true;
 }
@@ -758,6 +909,10 @@ void CombinedKernel::init()
 	weight_update = false;
 	SG_ADD(&weight_update, "weight_update",
 	    "weight update");
+
+	m_subkernel_caching=false;
+	SG_ADD(&m_subkernel_caching, "subkernel_caching",
+	    "Whether subkernel rows are cached.");
 }
 
 void CombinedKernel::enable_subkernel_weight_learning()
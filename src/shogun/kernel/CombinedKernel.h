@@ -13,10 +13,14 @@
 
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/KernelRowCache.h>
 
 #include <shogun/features/Features.h>
 #include <shogun/features/CombinedFeatures.h>
 
+#include <memory>
+#include <vector>
+
 namespace shogun
 {
 class Features;
@@ -162,6 +166,7 @@ class CombinedKernel : public Kernel
 				unset_property(KP_LINADD);
 
 			kernel_array.insert(kernel_array.begin() + idx, k);
+			m_subkernel_caches.clear();
 			return true;
 		}
 
@@ -206,6 +211,7 @@ class CombinedKernel : public Kernel
 
 			int n = get_num_kernels();
 			kernel_array.push_back(k);
+			m_subkernel_caches.clear();
 
 			if(enable_subkernel_weight_opt && n+1==get_num_kernels())
 				enable_subkernel_weight_learning();
@@ -227,6 +233,7 @@ class CombinedKernel : public Kernel
 			    kernel_array.size());
 
 			kernel_array.erase(kernel_array.begin() + idx);
+			m_subkernel_caches.clear();
 
 			if (get_num_kernels()==0)
 			{
@@ -440,6 +447,40 @@ class CombinedKernel : public Kernel
 		 */
 		virtual void enable_subkernel_weight_learning();
 
+		/** enable or disable caching of subkernel rows
+		 *
+		 * When enabled, every (non custom) subkernel gets its own row cache
+		 * of get_cache_size()/get_num_kernels() megabytes on init(). The
+		 * cached rows hold unweighted subkernel values and thus stay valid
+		 * when the subkernel weights change, e.g. between the outer
+		 * iterations of MKL, so that only the weighted sum has to be
+		 * recomputed.
+		 *
+		 * @param caching whether to cache subkernel rows
+		 */
+		void set_subkernel_caching(bool caching);
+
+		/** @return whether subkernel rows are cached */
+		bool get_subkernel_caching() const
+		{
+			return m_subkernel_caching;
+		}
+
+		/** compute the quadratic forms \f$c^T K_k c\f$ of all (unweighted)
+		 * subkernels \f$K_k\f$ on a set of vectors
+		 *
+		 * The subkernels and blocks of columns are processed in parallel,
+		 * taking the rows from the subkernel row caches if enabled, so that
+		 * no full matrix of the vectors is formed. MKL uses these as the
+		 * squared norms \f$\|w_k\|^2\f$ of the subkernels.
+		 *
+		 * @param idx indices of the vectors, used for lhs and rhs
+		 * @param coef coefficient of each vector
+		 * @return quadratic form of each subkernel
+		 */
+		SGVector<float64_t> compute_subkernel_quadratic_forms(
+			const SGVector<index_t>& idx, const SGVector<float64_t>& coef);
+
 	protected:
 		virtual void init_subkernel_weights();
 
@@ -451,6 +492,22 @@ class CombinedKernel : public Kernel
 		 */
 		float64_t compute(int32_t x, int32_t y) override;
 
+		/** compute a block of the combined kernel, see
+		 * Kernel::compute_block()
+		 *
+		 * The blocks of all subkernels are computed in parallel (or taken
+		 * from the subkernel row caches) and then accumulated with their
+		 * weights.
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return true
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 		/** adjust the variables num_lhs, num_rhs and initialized
 		 * based on the kernel to be appended/inserted
 		 *
@@ -513,6 +570,31 @@ class CombinedKernel : public Kernel
 		    const std::shared_ptr<Features>& lhs, const std::shared_ptr<Features>& rhs, const SGVector<index_t>& lhs_subset,
 		    const SGVector<index_t>& rhs_subset);
 
+		/** create one row cache per subkernel if subkernel caching is
+		 * enabled, otherwise drop all caches
+		 */
+		void init_subkernel_caches();
+
+		/** compute the block of a single subkernel, using its row cache if
+		 * available
+		 *
+		 * @param k_idx index of the subkernel
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @return block of the (unweighted) subkernel
+		 */
+		SGMatrix<float64_t> compute_subkernel_block(
+			index_t k_idx, const SGVector<index_t>& lhs_idx,
+			const SGVector<index_t>& rhs_idx);
+
+		/** get a row of a cached subkernel, computing it on a miss
+		 *
+		 * @param k_idx index of the subkernel, must have a row cache
+		 * @param row index of the rhs vector
+		 * @return (unweighted) subkernel values of all lhs vectors
+		 */
+		SGVector<float64_t> get_subkernel_row(index_t k_idx, index_t row);
+
 	protected:
 		/** list of kernels */
 		std::vector<std::shared_ptr<Kernel>> kernel_array;
@@ -536,6 +618,14 @@ class CombinedKernel : public Kernel
 		bool enable_subkernel_weight_opt;
 		/** update the weight for subkernels */
 		bool weight_update;
+
+		/** whether subkernel rows are cached */
+		bool m_subkernel_caching;
+		/** row caches of the subkernels (by rhs index), nullptr for custom
+		 * kernels
+		 */
+		std::vector<std::shared_ptr<KernelRowCache<float64_t>>>
+			m_subkernel_caches;
 };
 }
 #endif /* _COMBINEDKERNEL_H__ */
@@ -56,12 +56,14 @@ CustomKernel::CustomKernel(const std::shared_ptr<Kernel>& k)
 		auto casted=std::static_pointer_cast<CustomKernel>(k);
 		m_is_symmetric=casted->m_is_symmetric;
 		set_full_kernel_matrix_from_full(casted->get_float32_kernel_matrix());
+		upper_diagonal=casted->upper_diagonal;
+		m_mapped_file=casted->m_mapped_file;
 		m_free_km=false;
 	}
 	else
 	{
 		m_is_symmetric=k->get_lhs_equals_rhs();
-		set_full_kernel_matrix_from_full(k->get_kernel_matrix());
+		set_full_kernel_matrix_from_full(k->get_kernel_matrix<float32_t>());
 	}
 }
 
@@ -83,6 +85,47 @@ CustomKernel::CustomKernel(SGMatrix<float32_t> km)
 	SG_TRACE("Leaving");
 }
 
+CustomKernel::CustomKernel(
+	const char* fname, bool upper_triangular, index_t num_rows)
+: Kernel(10), upper_diagonal(false)
+{
+	SG_TRACE("Entering");
+	init();
+
+	auto file=std::make_shared<MemoryMappedFile<float32_t>>(fname);
+	const int64_t len=file->get_length();
+	require(len>0, "Kernel matrix file {} is empty!", fname);
+
+	index_t rows=0;
+	index_t cols=0;
+	if (upper_triangular)
+	{
+		cols=(index_t)floor(-0.5 + std::sqrt(0.25 + 2.0*len));
+		require(int64_t(cols)*(cols+1)/2==len, "File {} with {} elements does "
+				"not hold an upper triangle!", fname, len);
+		rows=cols;
+	}
+	else
+	{
+		rows=num_rows>0 ? num_rows : (index_t)std::round(std::sqrt(double(len)));
+		require(rows>0 && len%rows==0 && (num_rows>0 || int64_t(rows)*rows==len),
+				"File {} with {} elements does not hold a {} matrix!", fname,
+				len, num_rows>0 ? "full" : "square");
+		cols=len/rows;
+	}
+
+	SG_DEBUG("mapping custom kernel of size {}x{} from {}", rows, cols, fname)
+
+	m_mapped_file=file;
+	kmatrix=SGMatrix<float32_t>(file->get_map(), rows, cols, false);
+	upper_diagonal=upper_triangular;
+	m_is_symmetric=upper_triangular;
+	m_free_km=false;
+	dummy_init(rows, cols);
+
+	SG_TRACE("Leaving");
+}
+
 CustomKernel::~CustomKernel()
 {
 	SG_TRACE("Entering");
@@ -133,6 +176,10 @@ bool CustomKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r
 		add_row_subset(l_idx->get_feature_index());
 		add_col_subset(r_idx->get_feature_index());
 
+		/* keep the index features, so that kernel machines trained on them
+		 * can be applied to other index features */
+		lhs=l;
+		rhs=r;
 		lhs_equals_rhs=m_is_symmetric;
 
 		return true;
@@ -362,11 +409,30 @@ void CustomKernel::cleanup_custom()
 	remove_all_col_subsets();
 
 	kmatrix=SGMatrix<float32_t>();
+	m_mapped_file=nullptr;
 	upper_diagonal=false;
 
 	SG_TRACE("Leaving");
 }
 
+void CustomKernel::prefetch_kernel_col(index_t col) const
+{
+	if (!m_mapped_file)
+		return;
+
+	const int64_t real_col=m_col_subset_stack->subset_idx_conversion(col);
+	if (upper_diagonal)
+	{
+		// entries (col, c) for c>=col are contiguous, the others are spread
+		// over the rows above and left to the page cache
+		const int64_t n=kmatrix.num_cols;
+		m_mapped_file->prefetch(
+			real_col*n - real_col*(real_col+1)/2 + real_col, n-real_col);
+	}
+	else
+		m_mapped_file->prefetch(real_col*kmatrix.num_rows, kmatrix.num_rows);
+}
+
 void CustomKernel::cleanup()
 {
 	cleanup_custom();
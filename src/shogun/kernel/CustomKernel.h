@@ -14,6 +14,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/features/Features.h>
+#include <shogun/io/MemoryMappedFile.h>
 
 namespace shogun
 {
@@ -62,6 +63,24 @@ class CustomKernel: public Kernel
 		 */
 		CustomKernel(SGMatrix<float32_t> km);
 
+		/** constructor
+		 *
+		 * maps a kernel matrix stored as raw single precision floats in a
+		 * file into memory instead of loading it. Only the pages that are
+		 * accessed are read by the operating system, so the matrix may be
+		 * much larger than the available memory.
+		 *
+		 * @param fname name of the file
+		 * @param upper_triangular whether the file holds the row-wise packed
+		 * upper triangle of a symmetric matrix (as stored by
+		 * set_triangle_kernel_matrix_from_triangle()) rather than a full
+		 * column-major matrix
+		 * @param num_rows number of rows of a full matrix, 0 for a square
+		 * matrix
+		 */
+		CustomKernel(
+			const char* fname, bool upper_triangular=false, index_t num_rows=0);
+
 		/**
 		 *
 		 */
@@ -543,6 +562,28 @@ class CustomKernel: public Kernel
 		 *
 		 * @return kernel matrix
 		 */
+		/** hint the operating system to read the values of the given
+		 * kernel column ahead of time. Only has an effect if the kernel
+		 * matrix is memory mapped, see CustomKernel(const char*, bool,
+		 * index_t). Called by get_kernel_col().
+		 *
+		 * works with subset
+		 *
+		 * @param col column
+		 */
+		void prefetch_kernel_col(index_t col) const;
+
+		/** get column j, prefetching it first if the kernel matrix is
+		 * memory mapped
+		 *
+		 * @return the jth column of the kernel matrix
+		 */
+		SGVector<float64_t> get_kernel_col(int32_t j) override
+		{
+			prefetch_kernel_col(j);
+			return Kernel::get_kernel_col(j);
+		}
+
 		SGMatrix<float32_t> get_float32_kernel_matrix()
 		{
 			require(!m_row_subset_stack->has_subsets(), "{}::get_float32_kernel_matrix(): "
@@ -614,6 +655,9 @@ class CustomKernel: public Kernel
 
 		/** indicates whether kernel matrix is to be freed in destructor */
 		bool m_free_km;
+
+		/** file the kernel matrix is mapped from, if any */
+		std::shared_ptr<MemoryMappedFile<float32_t>> m_mapped_file;
 };
 
 }
@@ -6,9 +6,12 @@
  */
 
 #include <shogun/kernel/GaussianARDKernel.h>
+#include <shogun/kernel/normalizer/KernelNormalizer.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 GaussianARDKernel::GaussianARDKernel() : ExponentialARDKernel()
@@ -296,3 +299,74 @@ SGMatrix<float64_t> GaussianARDKernel::get_parameter_gradient(
 		return SGMatrix<float64_t>();
 	}
 }
+
+SGMatrix<float64_t> GaussianARDKernel::get_feature_matrix(
+		const std::shared_ptr<Features>& hs)
+{
+	const int32_t num_vec=hs->get_num_vectors();
+	SGMatrix<float64_t> result;
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		SGVector<float64_t> vec=get_feature_vector(i, hs);
+		if (!result.matrix)
+			result=SGMatrix<float64_t>(vec.vlen, num_vec);
+		std::copy_n(vec.vector, vec.vlen, result.get_column_vector(i));
+	}
+	return result;
+}
+
+std::vector<SGMatrix<float64_t>> GaussianARDKernel::get_parameter_gradients(
+		Parameters::const_reference param, index_t num_elements)
+{
+	if (param.first!="log_weights" || m_ARD_type!=KT_DIAG)
+		return ExponentialARDKernel::get_parameter_gradients(param, num_elements);
+
+	require(lhs, "Left features not set!");
+	require(rhs, "Right features not set!");
+	require(num_elements==m_log_weights.vlen,
+		"Number of elements ({}) must match #dimension of weights ({})",
+		num_elements, m_log_weights.vlen);
+
+	const index_t dim=m_log_weights.vlen;
+	SGVector<float64_t> sq_weights(dim);
+	for (index_t d=0; d<dim; d++)
+		sq_weights[d]=std::exp(2.0*m_log_weights[d]);
+
+	auto lhs_mat=get_feature_matrix(lhs);
+	auto rhs_mat=(lhs==rhs) ? lhs_mat : get_feature_matrix(rhs);
+	require(lhs_mat.num_rows==dim && rhs_mat.num_rows==dim,
+		"Feature dimension ({}) must match #dimension of weights ({})",
+		lhs_mat.num_rows, dim);
+
+	std::vector<SGMatrix<float64_t>> gradients(dim);
+	for (index_t d=0; d<dim; d++)
+		gradients[d]=SGMatrix<float64_t>(num_lhs, num_rhs);
+
+#pragma omp parallel
+	{
+		SGVector<float64_t> sq_diff(dim);
+#pragma omp for
+		for (index_t k=0; k<num_rhs; k++)
+		{
+			const float64_t* bvec=rhs_mat.get_column_vector(k);
+			for (index_t j=0; j<num_lhs; j++)
+			{
+				const float64_t* avec=lhs_mat.get_column_vector(j);
+				float64_t dist=0.0;
+				for (index_t d=0; d<dim; d++)
+				{
+					const float64_t diff=avec[d]-bvec[d];
+					sq_diff[d]=sq_weights[d]*diff*diff;
+					dist+=sq_diff[d];
+				}
+
+				const float64_t kval=
+					normalizer->normalize(std::exp(-0.5*dist), j, k);
+				for (index_t d=0; d<dim; d++)
+					gradients[d](j, k)=-kval*sq_diff[d];
+			}
+		}
+	}
+
+	return gradients;
+}
@@ -142,6 +142,21 @@ public:
 	SGVector<float64_t> get_parameter_gradient_diagonal(
 		Parameters::const_reference param, index_t index=-1) override;
 
+	/** return derivatives with respect to all elements of the specified
+	 * parameter at once
+	 *
+	 * For vector (KT_DIAG) weights the gradients wrt all log_weights are
+	 * computed in a single pass over all pairs of vectors, each pairwise
+	 * difference and kernel value is computed only once.
+	 *
+	 * @param param the parameter
+	 * @param num_elements number of elements of the parameter
+	 *
+	 * @return gradient with respect to every element of the parameter
+	 */
+	std::vector<SGMatrix<float64_t>> get_parameter_gradients(
+		Parameters::const_reference param, index_t num_elements) override;
+
 protected:
 	/** helper function to compute quadratic terms in
 	 * (a-b)^2 (== a^2+b^2-2ab)
@@ -156,6 +171,13 @@ protected:
 	 * */
 	virtual SGVector<float64_t> precompute_squared_helper(std::shared_ptr<DotFeatures> df);
 
+	/** helper function to collect feature vectors as columns of a matrix
+	 *
+	 * @param hs features
+	 * @return matrix of all feature vectors of hs
+	 */
+	SGMatrix<float64_t> get_feature_matrix(const std::shared_ptr<Features>& hs);
+
 	/** squared left-hand side */
 	SGVector<float64_t> m_sq_lhs;
 	/** squared right-hand side */
@@ -112,6 +112,48 @@ float64_t GaussianKernel::compute(int32_t idx_a, int32_t idx_b)
 	return std::exp(-result);
 }
 
+bool GaussianKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	// subclasses like GaussianShiftKernel modify compute()
+	if (get_kernel_type()!=K_GAUSSIAN || m_precomputed_distance)
+		return false;
+
+	auto lhs_dot=std::dynamic_pointer_cast<DotFeatures>(lhs);
+	auto rhs_dot=std::dynamic_pointer_cast<DotFeatures>(rhs);
+	if (!lhs_dot || !rhs_dot)
+		return false;
+
+	// only applicable if the kernel is based on the squared euclidean
+	// distance, and not e.g. on a precomputed CustomDistance
+	auto dist=std::dynamic_pointer_cast<EuclideanDistance>(m_distance);
+	if (!dist || !dist->get_disable_sqrt())
+		return false;
+
+	compute_dot_block(lhs_idx, rhs_idx, block);
+
+	SGVector<float64_t> lhs_sq(lhs_idx.vlen);
+	for (index_t i=0; i<lhs_idx.vlen; ++i)
+		lhs_sq[i]=lhs_dot->dot(lhs_idx[i], lhs_dot, lhs_idx[i]);
+	SGVector<float64_t> rhs_sq(rhs_idx.vlen);
+	for (index_t j=0; j<rhs_idx.vlen; ++j)
+		rhs_sq[j]=rhs_dot->dot(rhs_idx[j], rhs_dot, rhs_idx[j]);
+
+	const float64_t width=get_width();
+	for (index_t j=0; j<block.num_cols; ++j)
+	{
+		for (index_t i=0; i<block.num_rows; ++i)
+		{
+			const float64_t sq_dist=std::max(
+				lhs_sq[i]-2*block(i, j)+rhs_sq[j], 0.0);
+			block(i, j)=std::exp(-sq_dist/width);
+		}
+	}
+
+	return true;
+}
+
 void GaussianKernel::load_serializable_post() noexcept(false)
 {
 	Kernel::load_serializable_post();
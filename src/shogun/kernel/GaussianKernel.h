@@ -155,6 +155,22 @@ protected:
 	 */
 	float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+	/** compute a block of kernel values, see Kernel::compute_block()
+	 *
+	 * For DotFeatures and squared euclidean distance the distances are
+	 * obtained via
+	 * \f$\|{\bf x}\|^2 - 2{\bf x}\cdot{\bf x'} + \|{\bf x'}\|^2\f$ from a
+	 * single block of dot products, see DotFeatures::dot_block().
+	 *
+	 * @param lhs_idx indices of the lhs vectors of the block
+	 * @param rhs_idx indices of the rhs vectors of the block
+	 * @param block preallocated block of the kernel matrix
+	 * @return whether the block was computed
+	 */
+	bool compute_block(
+		const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+		SGMatrix<float64_t>& block) override;
+
 	/** compute the distance between features a and b
 	 * idx_{a,b} denote the index of the feature vectors
 	 * in the corresponding feature object
@@ -4,30 +4,40 @@
  * Authors: Soeren Sonnenburg, Evan Shelhamer, Sergey Lisitsyn, Viktor Gal
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/common.h>
 #include <shogun/kernel/HistogramIntersectionKernel.h>
+#include <shogun/kernel/normalizer/KernelNormalizer.h>
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 using namespace shogun;
 
 HistogramIntersectionKernel::HistogramIntersectionKernel()
-: DotKernel(0), m_beta(1.0)
+: DotKernel(0), m_beta(1.0), m_num_bins(0)
 {
+	properties |= KP_BATCHEVALUATION;
 	register_params();
 }
 
 HistogramIntersectionKernel::HistogramIntersectionKernel(int32_t size)
-: DotKernel(size), m_beta(1.0)
+: DotKernel(size), m_beta(1.0), m_num_bins(0)
 {
+	properties |= KP_BATCHEVALUATION;
 	register_params();
 }
 
 HistogramIntersectionKernel::HistogramIntersectionKernel(
 	const std::shared_ptr<DenseFeatures<float64_t>>& l, const std::shared_ptr<DenseFeatures<float64_t>>& r,
 	float64_t beta, int32_t size)
-: DotKernel(size), m_beta(beta)
+: DotKernel(size), m_beta(beta), m_num_bins(0)
 {
+	properties |= KP_BATCHEVALUATION;
 	init(l,r);
 	register_params();
 }
@@ -76,7 +86,153 @@ float64_t HistogramIntersectionKernel::compute(int32_t idx_a, int32_t idx_b)
 	return result;
 }
 
+void HistogramIntersectionKernel::set_num_bins(int32_t num_bins)
+{
+	require(num_bins>=0, "Number of bins ({}) must not be negative", num_bins);
+	m_num_bins=num_bins;
+}
+
+void HistogramIntersectionKernel::compute_batch(
+	int32_t num_vec, int32_t* vec_idx, float64_t* target,
+	int32_t num_suppvec, int32_t* IDX, float64_t* alphas, float64_t factor)
+{
+	require(lhs && rhs, "Features of the kernel are not initialized");
+	if (num_vec<=0 || num_suppvec<=0)
+		return;
+
+	auto sv_feats=std::static_pointer_cast<DenseFeatures<float64_t>>(lhs);
+	auto feats=std::static_pointer_cast<DenseFeatures<float64_t>>(rhs);
+	const int32_t dim=sv_feats->get_num_features();
+	require(feats->get_num_features()==dim,
+		"Support vectors have {} dimensions, vectors {}", dim,
+		feats->get_num_features());
+
+	const index_t m=num_suppvec;
+	const int32_t num_bins=m_num_bins;
+	const float64_t beta=m_beta;
+	auto transform=[beta](float64_t x) {
+		return beta==1.0 ? x : std::pow(x, beta);
+	};
+
+	// the support vector values, one column per dimension
+	SGMatrix<float64_t> values(m, dim);
+	SGVector<float64_t> weights(m);
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t j=0; j<m; j++)
+	{
+		int32_t len;
+		bool free_vec;
+		float64_t* vec=sv_feats->get_feature_vector(IDX[j], len, free_vec);
+		for (int32_t i=0; i<dim; i++)
+			values(j, i)=transform(vec[i]);
+		sv_feats->free_feature_vector(vec, IDX[j], free_vec);
+		weights[j]=normalizer->normalize_lhs(alphas[j], IDX[j]);
+	}
+
+	/* with the support vector values of dimension i sorted and k of them
+	 * at most t, h_i(t)=value_sums[k]+t*(weight_sums[m]-weight_sums[k]),
+	 * where value_sums are the cumulative sums of alpha*s and weight_sums
+	 * those of alpha. The exact evaluation keeps the sorted values and the
+	 * sums, the lookup tables keep h_i at num_bins+1 points between the
+	 * smallest and the largest value.
+	 */
+	SGMatrix<float64_t> value_sums, weight_sums, table;
+	SGVector<float64_t> lower, upper, total_value, total_weight;
+	if (num_bins==0)
+	{
+		value_sums=SGMatrix<float64_t>(m+1, dim);
+		weight_sums=SGMatrix<float64_t>(m+1, dim);
+	}
+	else
+	{
+		table=SGMatrix<float64_t>(num_bins+1, dim);
+		lower=SGVector<float64_t>(dim);
+		upper=SGVector<float64_t>(dim);
+		total_value=SGVector<float64_t>(dim);
+		total_weight=SGVector<float64_t>(dim);
+	}
+
+	#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<std::pair<float64_t, float64_t>> sorted(m);
+		std::vector<float64_t> sorted_values(m), vsums(m+1), wsums(m+1);
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t i=0; i<dim; i++)
+		{
+			for (index_t j=0; j<m; j++)
+				sorted[j]={values(j, i), weights[j]};
+			std::sort(sorted.begin(), sorted.end());
+
+			vsums[0]=0;
+			wsums[0]=0;
+			for (index_t j=0; j<m; j++)
+			{
+				sorted_values[j]=sorted[j].first;
+				vsums[j+1]=vsums[j]+sorted[j].second*sorted[j].first;
+				wsums[j+1]=wsums[j]+sorted[j].second;
+			}
+
+			if (num_bins==0)
+			{
+				std::copy(sorted_values.begin(), sorted_values.end(), values.get_column_vector(i));
+				std::copy(vsums.begin(), vsums.end(), value_sums.get_column_vector(i));
+				std::copy(wsums.begin(), wsums.end(), weight_sums.get_column_vector(i));
+				continue;
+			}
+
+			lower[i]=sorted_values[0];
+			upper[i]=sorted_values[m-1];
+			total_value[i]=vsums[m];
+			total_weight[i]=wsums[m];
+			for (int32_t b=0; b<=num_bins; b++)
+			{
+				const float64_t t=lower[i]+(upper[i]-lower[i])*b/num_bins;
+				const index_t k=std::upper_bound(
+					sorted_values.begin(), sorted_values.end(), t)-sorted_values.begin();
+				table(b, i)=vsums[k]+t*(wsums[m]-wsums[k]);
+			}
+		}
+	}
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(env()->get_num_threads())
+	for (int32_t v=0; v<num_vec; v++)
+	{
+		int32_t len;
+		bool free_vec;
+		float64_t* vec=feats->get_feature_vector(vec_idx[v], len, free_vec);
+
+		float64_t score=0;
+		for (int32_t i=0; i<dim; i++)
+		{
+			const float64_t t=transform(vec[i]);
+			if (num_bins==0)
+			{
+				const float64_t* sv_values=values.get_column_vector(i);
+				const index_t k=std::upper_bound(sv_values, sv_values+m, t)-sv_values;
+				score+=value_sums(k, i)+t*(weight_sums(m, i)-weight_sums(k, i));
+			}
+			else if (t<=lower[i])
+				score+=t*total_weight[i];
+			else if (t>=upper[i])
+				score+=total_value[i];
+			else
+			{
+				const float64_t pos=(t-lower[i])*num_bins/(upper[i]-lower[i]);
+				const int32_t b=std::min(int32_t(pos), num_bins-1);
+				score+=table(b, i)+(table(b+1, i)-table(b, i))*(pos-b);
+			}
+		}
+		feats->free_feature_vector(vec, vec_idx[v], free_vec);
+
+		target[v]+=factor*normalizer->normalize_rhs(score, vec_idx[v]);
+	}
+}
+
 void HistogramIntersectionKernel::register_params()
 {
 	SG_ADD(&m_beta, "beta", "the beta parameter of the kernel", ParameterProperties::HYPER);
+	SG_ADD(&m_num_bins, "num_bins",
+		"Number of bins of the lookup tables of batch evaluation, 0 for exact.",
+		ParameterProperties::SETTING);
 }
@@ -25,6 +25,18 @@ namespace shogun
  * k({\bf x},{\bf x'})= \sum_{i=0}^{l} \mbox{min}(x^{\beta}_i, x'^{\beta}_i)
  * \f]
  * with \f$\beta=1\f$ by default
+ *
+ * The kernel is additive, so the output of a kernel machine
+ * \f$f({\bf x})=\sum_j \alpha_j k({\bf s}_j,{\bf x})\f$ is a sum of one
+ * dimensional functions \f$h_i(x_i)=\sum_j \alpha_j \mbox{min}(s_{j,i}, x_i)\f$
+ * (Maji, Berg and Malik, "Classification using intersection kernel support
+ * vector machines is efficient", CVPR 2008). compute_batch() sorts the
+ * support vector values of every dimension and evaluates \f$h_i\f$ with a
+ * binary search over cumulative sums, i.e. in \f$O(d \log m)\f$ per
+ * vector for \f$m\f$ support vectors instead of \f$O(d m)\f$. With
+ * set_num_bins(), \f$h_i\f$ is instead interpolated linearly in a table,
+ * which takes \f$O(d)\f$ time per vector and much less memory, but is
+ * only exact below the smallest and above the largest support vector value.
  * */
 class HistogramIntersectionKernel: public DotKernel
 {
@@ -84,11 +96,45 @@ class HistogramIntersectionKernel: public DotKernel
 		 */
 		inline void set_beta(float64_t beta) { m_beta = beta; }
 
+		/** @return number of bins of the lookup tables of compute_batch(),
+		 * 0 for the exact evaluation
+		 */
+		inline int32_t get_num_bins() const { return m_num_bins; }
+
+		/** set the number of bins of the piecewise linear lookup tables
+		 * compute_batch() evaluates the kernel machine with
+		 *
+		 * @param num_bins number of bins per dimension, 0 for the exact
+		 * evaluation
+		 */
+		void set_num_bins(int32_t num_bins);
+
+		/** compute the outputs of a kernel machine for a batch of vectors
+		 * from one dimensional functions of the support vectors, see the
+		 * class description. The outputs are added to target.
+		 *
+		 * @param num_vec number of vectors
+		 * @param vec_idx indices of the vectors (rhs)
+		 * @param target outputs, the scores are added to them
+		 * @param num_suppvec number of support vectors
+		 * @param IDX indices of the support vectors (lhs)
+		 * @param alphas weights of the support vectors
+		 * @param factor factor of the scores, e.g. the weight of the kernel
+		 * in a CombinedKernel
+		 */
+		void compute_batch(
+			int32_t num_vec, int32_t* vec_idx, float64_t* target,
+			int32_t num_suppvec, int32_t* IDX, float64_t* alphas,
+			float64_t factor=1.0) override;
+
 	protected:
 
 		/// beta parameter
 		float64_t m_beta;
 
+		/// number of bins of the lookup tables, 0 for exact evaluation
+		int32_t m_num_bins;
+
 		/** compute kernel function for features a and b
 		 * idx_{a,b} denote the index of the feature vectors
 		 * in the corresponding feature object
@@ -79,6 +79,22 @@ class JensenShannonKernel: public DotKernel
 		 */
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute a block of kernel values, see Kernel::compute_block()
+		 *
+		 * For dense non-negative features the kernel is
+		 * \f$\frac{1}{2\ln 2}\sum_i (a_i+b_i)\ln(a_i+b_i) - a_i\ln a_i - b_i\ln b_i\f$,
+		 * the terms of single vectors are computed once per block and the
+		 * logarithms of the sums in bulk, see simd::log().
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return whether the block was computed
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 };
 }
 #endif /* _JENSENSHANNONKERNEL_H___ */
@@ -11,7 +11,9 @@
 #include <shogun/base/progress.h>
 #include <shogun/io/File.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/StoppableSGObject.h>
 #include <shogun/lib/Time.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
@@ -21,7 +23,10 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/normalizer/KernelNormalizer.h>
 #include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/DotFeatures.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <shogun/classifier/svm/SVM.h>
 
@@ -31,7 +36,10 @@
 #endif
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+#include <chrono>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -169,6 +177,22 @@ void Kernel::cleanup()
 #ifdef USE_SVMLIGHT
 /****************************** Cache handling *******************************/
 
+/** nanoseconds elapsed since a point in time */
+static inline int64_t nanoseconds_since(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now()-start).count();
+}
+
+CacheManager::Statistics Kernel::get_cache_statistics() const
+{
+	CacheManager::Statistics stats;
+	stats.hits=cache_hits.load(std::memory_order_relaxed);
+	stats.misses=cache_misses.load(std::memory_order_relaxed);
+	stats.miss_seconds=cache_miss_nanoseconds.load(std::memory_order_relaxed)*1e-9;
+	return stats;
+}
+
 void Kernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 {
 	int32_t totdoc=get_num_vec_lhs();
@@ -180,14 +204,25 @@ void Kernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 	uint64_t buffer_size=0;
 	int32_t i;
 
-	//in regression the additional constraints are made by doubling the training data
-	if (regression_hack)
-		totdoc*=2;
+	// in regression the additional constraints are made by doubling the
+	// training data, both variables of an example share its cache entries
+	// (see cache_example_index()) so the cache stays indexed by examples
 
 	buffer_size=((uint64_t) buffsize)*1024*1024/sizeof(KERNELCACHE_ELEM);
 	if (buffer_size>((uint64_t) totdoc)*totdoc)
 		buffer_size=((uint64_t) totdoc)*totdoc;
 
+	// the cache manager may grant less under a cache budget, but never
+	// less than the 10MB minimum of resize_kernel_cache()
+	if (!cache_entry)
+	{
+		cache_entry=env()->cache_manager()->add_cache(
+			get_name(), [this]() { return get_cache_statistics(); });
+	}
+	const int64_t demand=buffer_size*sizeof(KERNELCACHE_ELEM);
+	buffer_size=cache_entry->reserve(demand,
+		std::min<int64_t>(demand, int64_t(10)*1024*1024))/sizeof(KERNELCACHE_ELEM);
+
 	io::info("using a kernel cache of size {} MB ({} bytes) for {} Kernel", buffer_size*sizeof(KERNELCACHE_ELEM)/1024/1024, buffer_size*sizeof(KERNELCACHE_ELEM), get_name());
 
 	//make sure it fits in the *signed* KERNELCACHE_IDX type
@@ -229,62 +264,48 @@ void Kernel::kernel_cache_init(int32_t buffsize, bool regression_hack)
 void Kernel::get_kernel_row(
 	int32_t docnum, int32_t *active2dnum, float64_t *buffer, bool full_line)
 {
-	int32_t i,j;
-	KERNELCACHE_IDX start;
+	docnum=cache_example_index(docnum);
+
+	// a full line has one entry per example, otherwise active2dnum lists
+	// the variables and is terminated by -1
+	int32_t num=get_num_vec_lhs();
+	if (!full_line)
+	{
+		for (num=0; active2dnum[num]>=0; num++);
+	}
 
-	int32_t num_vectors = get_num_vec_lhs();
-	if (docnum>=num_vectors)
-		docnum=2*num_vectors-1-docnum;
+	const KERNELCACHE_ELEM* cached=NULL;
 
 	/* is cached? */
 	if(kernel_cache.index[docnum] != -1)
 	{
+		SG_PROFILE_COUNT("Kernel::cache_hits", 1);
+		cache_hits.fetch_add(1, std::memory_order_relaxed);
 		kernel_cache.lru[kernel_cache.index[docnum]]=kernel_cache.time; /* lru */
-		start=((KERNELCACHE_IDX) kernel_cache.activenum)*kernel_cache.index[docnum];
-
-		if (full_line)
-		{
-			for(j=0;j<get_num_vec_lhs();j++)
-			{
-				if(kernel_cache.totdoc2active[j] >= 0)
-					buffer[j]=kernel_cache.buffer[start+kernel_cache.totdoc2active[j]];
-				else
-					buffer[j]=(float64_t) kernel(docnum, j);
-			}
-		}
-		else
-		{
-			for(i=0;(j=active2dnum[i])>=0;i++)
-			{
-				if(kernel_cache.totdoc2active[j] >= 0)
-					buffer[j]=kernel_cache.buffer[start+kernel_cache.totdoc2active[j]];
-				else
-				{
-					int32_t k=j;
-					if (k>=num_vectors)
-						k=2*num_vectors-1-k;
-					buffer[j]=(float64_t) kernel(docnum, k);
-				}
-			}
-		}
+		cached=kernel_cache.buffer+((KERNELCACHE_IDX) kernel_cache.activenum)*kernel_cache.index[docnum];
 	}
 	else
+		SG_PROFILE_COUNT("Kernel::cache_misses", 1);
+
+	const auto start=std::chrono::steady_clock::now();
+
+	#pragma omp parallel for if (num >= 1024) num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num; i++)
 	{
-		if (full_line)
-		{
-			for(j=0;j<get_num_vec_lhs();j++)
-				buffer[j]=(KERNELCACHE_ELEM) kernel(docnum, j);
-		}
+		const int32_t j=full_line ? i : active2dnum[i];
+		const int32_t k=cache_example_index(j);
+		const int32_t active=cached ? kernel_cache.totdoc2active[k] : -1;
+
+		if (active>=0)
+			buffer[j]=cached[active];
 		else
-		{
-			for(i=0;(j=active2dnum[i])>=0;i++)
-			{
-				int32_t k=j;
-				if (k>=num_vectors)
-					k=2*num_vectors-1-k;
-				buffer[j]=(KERNELCACHE_ELEM) kernel(docnum, k);
-			}
-		}
+			buffer[j]=(KERNELCACHE_ELEM) kernel(docnum, k);
+	}
+
+	if (!cached)
+	{
+		cache_misses.fetch_add(1, std::memory_order_relaxed);
+		cache_miss_nanoseconds.fetch_add(nanoseconds_since(start), std::memory_order_relaxed);
 	}
 }
 
@@ -292,40 +313,43 @@ void Kernel::get_kernel_row(
 // Fills cache for the row m
 void Kernel::cache_kernel_row(int32_t m)
 {
-	int32_t j,k,l;
 	KERNELCACHE_ELEM *cache;
 
-	int32_t num_vectors = get_num_vec_lhs();
-
-	if (m>=num_vectors)
-		m=2*num_vectors-1-m;
+	m=cache_example_index(m);
 
 	if(!kernel_cache_check(m))   // not cached yet
 	{
+		SG_PROFILE_COUNT("Kernel::cache_misses", 1);
 		cache = kernel_cache_clean_and_malloc(m);
 		if(cache) {
-			l=kernel_cache.totdoc2active[m];
+			const int32_t l=kernel_cache.totdoc2active[m];
+			const auto start=std::chrono::steady_clock::now();
 
-			for(j=0;j<kernel_cache.activenum;j++)  // fill cache
+			#pragma omp parallel for if (kernel_cache.activenum >= 1024) \
+				num_threads(env()->get_num_threads())
+			for(int32_t j=0;j<kernel_cache.activenum;j++)  // fill cache
 			{
-				k=kernel_cache.active2totdoc[j];
+				const int32_t k=kernel_cache.active2totdoc[j];
 
 				if((kernel_cache.index[k] != -1) && (l != -1) && (k != m)) {
 					cache[j]=kernel_cache.buffer[((KERNELCACHE_IDX) kernel_cache.activenum)
 						*kernel_cache.index[k]+l];
 				}
 				else
-				{
-					if (k>=num_vectors)
-						k=2*num_vectors-1-k;
-
 					cache[j]=kernel(m, k);
-				}
 			}
+
+			cache_misses.fetch_add(1, std::memory_order_relaxed);
+			cache_miss_nanoseconds.fetch_add(nanoseconds_since(start), std::memory_order_relaxed);
 		}
 		else
 			perror("Error: Kernel cache full! => increase cache size");
 	}
+	else
+	{
+		SG_PROFILE_COUNT("Kernel::cache_hits", 1);
+		cache_hits.fetch_add(1, std::memory_order_relaxed);
+	}
 }
 
 
@@ -349,12 +373,7 @@ void* Kernel::cache_multiple_kernel_row_helper(void* p)
 					*params->kernel_cache->index[k]+l];
 			}
 			else
-				{
-					if (k>=params->num_vectors)
-						k=2*params->num_vectors-1-k;
-
-					cache[j]=params->kernel->kernel(m, k);
-				}
+				cache[j]=params->kernel->kernel(m, k);
 		}
 
 		//now line m is cached
@@ -391,13 +410,16 @@ void Kernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 		// allocate cachelines if necessary
 		for (int32_t i=0; i<num_rows; i++)
 		{
-			int32_t idx=rows[i];
-			if (idx>=num_vec)
-				idx=2*num_vec-1-idx;
+			int32_t idx=cache_example_index(rows[i]);
 
 			if (kernel_cache_check(idx))
+			{
+				SG_PROFILE_COUNT("Kernel::cache_hits", 1);
+				cache_hits.fetch_add(1, std::memory_order_relaxed);
 				continue;
+			}
 
+			SG_PROFILE_COUNT("Kernel::cache_misses", 1);
 			needs_computation[idx]=1;
 			uncached_rows[num]=idx;
 			cache[num]= kernel_cache_clean_and_malloc(idx);
@@ -408,6 +430,7 @@ void Kernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 			num++;
 		}
 
+		const auto start=std::chrono::steady_clock::now();
 		if (num>0)
 		{
 			step = num/nthreads;
@@ -452,6 +475,9 @@ void Kernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 
 		cache_multiple_kernel_row_helper(&last_param);
 
+		cache_misses.fetch_add(num, std::memory_order_relaxed);
+		cache_miss_nanoseconds.fetch_add(nanoseconds_since(start), std::memory_order_relaxed);
+
 		SG_FREE(needs_computation);
 		SG_FREE(cache);
 		SG_FREE(uncached_rows);
@@ -468,14 +494,19 @@ void Kernel::kernel_cache_shrink(
 	KERNELCACHE_IDX from=0,to=0;
 	int32_t *keep;
 
-	keep=SG_MALLOC(int32_t, totdoc);
-	for(j=0;j<totdoc;j++) {
+	// the columns belong to examples, in regression an example is kept
+	// while one of its two variables is
+	const int32_t num_examples=get_num_vec_lhs();
+	const bool paired=totdoc>num_examples;
+
+	keep=SG_MALLOC(int32_t, num_examples);
+	for(j=0;j<num_examples;j++) {
 		keep[j]=1;
 	}
 	scount=0;
 	for(jj=0;(jj<kernel_cache.activenum) && (scount<numshrink);jj++) {
 		j=kernel_cache.active2totdoc[jj];
-		if(!after[j]) {
+		if(!after[j] && (!paired || !after[2*num_examples-1-j])) {
 			scount++;
 			keep[j]=0;
 		}
@@ -496,7 +527,7 @@ void Kernel::kernel_cache_shrink(
 	}
 
 	kernel_cache.activenum=0;
-	for(j=0;j<totdoc;j++) {
+	for(j=0;j<num_examples;j++) {
 		if((keep[j]) && (kernel_cache.totdoc2active[j] != -1)) {
 			kernel_cache.active2totdoc[kernel_cache.activenum]=j;
 			kernel_cache.totdoc2active[j]=kernel_cache.activenum;
@@ -507,13 +538,13 @@ void Kernel::kernel_cache_shrink(
 		}
 	}
 
-	kernel_cache.max_elems= (int32_t) kernel_cache.buffsize;
-
+	// the rows are shorter now, so more of them fit into the buffer
+	kernel_cache.max_elems=num_examples;
 	if (kernel_cache.activenum>0)
-		kernel_cache.buffsize/=kernel_cache.activenum;
-
-	if(kernel_cache.max_elems>totdoc)
-		kernel_cache.max_elems=totdoc;
+	{
+		kernel_cache.max_elems=(int32_t) std::min<KERNELCACHE_IDX>(
+			kernel_cache.buffsize/kernel_cache.activenum, num_examples);
+	}
 
 	SG_FREE(keep);
 
@@ -542,6 +573,9 @@ void Kernel::kernel_cache_cleanup()
 	SG_FREE(kernel_cache.totdoc2active);
 	SG_FREE(kernel_cache.buffer);
 	memset(&kernel_cache, 0x0, sizeof(KERNEL_CACHE));
+
+	if (cache_entry)
+		cache_entry->release();
 }
 
 int32_t Kernel::kernel_cache_malloc()
@@ -732,6 +766,7 @@ void Kernel::list_kernel()
 		ENUM_CASE(K_CIRCULAR)
 		ENUM_CASE(K_INVERSEMULTIQUADRIC)
 		ENUM_CASE(K_SPECTRUMMISMATCHRBF)
+		ENUM_CASE(K_MISMATCHSTRING)
 		ENUM_CASE(K_DISTANTSEGMENTS)
 		ENUM_CASE(K_BESSEL)
 		ENUM_CASE(K_JENSENSHANNON)
@@ -768,6 +803,9 @@ void Kernel::list_kernel()
 		ENUM_CASE(C_FACTOR_GRAPH)
 		ENUM_CASE(C_INDEX)
 		ENUM_CASE(C_SUB_SAMPLES_DENSE)
+		ENUM_CASE(C_PQ)
+		ENUM_CASE(C_COMPRESSED_DENSE)
+		ENUM_CASE(C_PACKED_STRING)
 		ENUM_CASE(C_ANY)
 	}
 
@@ -945,6 +983,11 @@ void Kernel::register_params()
 	    (machine_int_t*)&opt_type, "opt_type", "Optimization type.",
 	    ParameterProperties::NONE,
 	    SG_OPTIONS(FASTBUTMEMHUNGRY, SLOWBUTMEMEFFICIENT));
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_precision, "precision",
+	    "Precision of block-wise kernel computations.",
+	    ParameterProperties::NONE,
+	    SG_OPTIONS(PRECISION_FLOAT64, PRECISION_FLOAT32));
 }
 
 
@@ -960,6 +1003,7 @@ void Kernel::init()
 	combined_kernel_weight=1;
 	optimization_initialized=false;
 	opt_type=FASTBUTMEMHUNGRY;
+	m_precision=PRECISION_FLOAT64;
 	properties=KP_NONE;
 	normalizer=NULL;
 
@@ -970,34 +1014,6 @@ void Kernel::init()
 	set_normalizer(std::make_shared<IdentityKernelNormalizer>());
 }
 
-namespace shogun
-{
-/** kernel thread parameters */
-template <class T> struct K_THREAD_PARAM
-{
-	/** kernel */
-	Kernel* kernel;
-	/** start (unit row) */
-	int32_t start;
-	/** end (unit row) */
-	int32_t end;
-	/** start (unit number of elements) */
-	int64_t total_start;
-	/** m */
-	int32_t m;
-	/** n */
-	int32_t n;
-	/** result */
-	T* result;
-	/** kernel matrix k(i,j)=k(j,i) */
-	bool symmetric;
-	/** output progress */
-	bool verbose;
-	/* Progress bar*/
-	PRange<int64_t>* pb;
-};
-}
-
 float64_t Kernel::sum_symmetric_block(index_t block_begin, index_t block_size,
 		bool no_diag)
 {
@@ -1261,119 +1277,195 @@ SGVector<float64_t> Kernel::row_col_wise_sum_block(index_t block_begin_row,
 	return sum;
 }
 
-template <class T> void* Kernel::get_kernel_matrix_helper(void* p)
+SGMatrix<float64_t> Kernel::get_kernel_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx)
 {
-	K_THREAD_PARAM<T>* params= (K_THREAD_PARAM<T>*) p;
-	int32_t i_start=params->start;
-	int32_t i_end=params->end;
-	Kernel* k=params->kernel;
-	T* result=params->result;
-	bool symmetric=params->symmetric;
-	int32_t n=params->n;
-	int32_t m=params->m;
-	bool verbose=params->verbose;
-	int64_t total_start=params->total_start;
-	int64_t total=total_start;
-	PRange<int64_t>* pb = params->pb;
-
-	for (int32_t i=i_start; i<i_end; i++)
+	require(has_features(), "no features assigned to kernel");
+
+	SGMatrix<float64_t> block(lhs_idx.vlen, rhs_idx.vlen);
+	if (compute_block(lhs_idx, rhs_idx, block))
 	{
-		int32_t j_start=0;
+		for (index_t j=0; j<block.num_cols; ++j)
+		{
+			for (index_t i=0; i<block.num_rows; ++i)
+				block(i, j)=normalizer->normalize(
+					block(i, j), lhs_idx[i], rhs_idx[j]);
+		}
+	}
+	else
+	{
+		for (index_t j=0; j<block.num_cols; ++j)
+		{
+			for (index_t i=0; i<block.num_rows; ++i)
+				block(i, j)=kernel(lhs_idx[i], rhs_idx[j]);
+		}
+	}
 
-		if (symmetric)
-			j_start=i;
+	return block;
+}
 
-		for (int32_t j=j_start; j<n; j++)
-		{
-			float64_t v=k->kernel(i,j);
-			result[i+j*m]=v;
+void Kernel::compute_dot_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	if (m_precision==PRECISION_FLOAT32 &&
+		lhs->get_feature_class()==C_DENSE && rhs->get_feature_class()==C_DENSE &&
+		lhs->get_feature_type()==F_DREAL && rhs->get_feature_type()==F_DREAL)
+	{
+		require(
+			block.num_rows==lhs_idx.vlen && block.num_cols==rhs_idx.vlen,
+			"Block ({}x{}) does not match the number of indices ({}x{})!",
+			block.num_rows, block.num_cols, lhs_idx.vlen, rhs_idx.vlen);
+
+		auto lhs_block=lhs->as<DenseFeatures<float64_t>>()
+			->get_feature_matrix_block(lhs_idx);
+		auto rhs_block=rhs->as<DenseFeatures<float64_t>>()
+			->get_feature_matrix_block(rhs_idx);
+
+		SGMatrix<float32_t> lhs_single(lhs_block.num_rows, lhs_block.num_cols);
+		SGMatrix<float32_t> rhs_single(rhs_block.num_rows, rhs_block.num_cols);
+		std::copy_n(lhs_block.data(), lhs_block.size(), lhs_single.data());
+		std::copy_n(rhs_block.data(), rhs_block.size(), rhs_single.data());
+
+		auto dots=linalg::matrix_prod(lhs_single, rhs_single, true, false);
+		std::copy_n(dots.data(), dots.size(), block.data());
+		return;
+	}
 
-			if (symmetric && i!=j)
-				result[j+i*m]=v;
+	lhs->as<DotFeatures>()->dot_block(
+		lhs_idx, rhs->as<DotFeatures>(), rhs_idx, block);
+}
 
-			if (verbose)
-			{
-				total++;
+bool Kernel::get_dense_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& lhs_block, SGMatrix<float64_t>& rhs_block) const
+{
+	if (lhs->get_feature_class()!=C_DENSE || rhs->get_feature_class()!=C_DENSE ||
+		lhs->get_feature_type()!=F_DREAL || rhs->get_feature_type()!=F_DREAL)
+		return false;
+
+	lhs_block=lhs->as<DenseFeatures<float64_t>>()
+		->get_feature_matrix_block(lhs_idx);
+	rhs_block=rhs->as<DenseFeatures<float64_t>>()
+		->get_feature_matrix_block(rhs_idx);
+	return true;
+}
 
-				if (symmetric && i!=j)
-					total++;
+SGMatrix<float64_t> Kernel::compute_weighted_outputs(
+	const SGVector<index_t>& lhs_idx, const SGMatrix<float64_t>& coefficients,
+	const SGVector<index_t>& rhs_idx)
+{
+	require(
+		coefficients.num_rows==lhs_idx.vlen,
+		"Number of coefficient rows ({}) does not match the number of lhs "
+		"indices ({})!", coefficients.num_rows, lhs_idx.vlen);
+
+	const index_t num_lhs=lhs_idx.vlen;
+	const index_t num_rhs=rhs_idx.vlen;
+	const index_t num_outputs=coefficients.num_cols;
+
+	SGMatrix<float64_t> outputs(num_rhs, num_outputs);
+	outputs.zero();
+
+	const index_t num_chunks=
+		(num_rhs+kernel_block_size-1)/kernel_block_size;
+#pragma omp parallel for schedule(dynamic)
+	for (index_t chunk=0; chunk<num_chunks; ++chunk)
+	{
+		const index_t rhs_begin=chunk*kernel_block_size;
+		SGVector<index_t> rhs_chunk(
+			rhs_idx.vector+rhs_begin,
+			std::min(kernel_block_size, num_rhs-rhs_begin), false);
 
-				pb->print_progress();
+		for (index_t lhs_begin=0; lhs_begin<num_lhs;
+			lhs_begin+=kernel_block_size)
+		{
+			SGVector<index_t> lhs_chunk(
+				lhs_idx.vector+lhs_begin,
+				std::min(kernel_block_size, num_lhs-lhs_begin), false);
+			auto block=get_kernel_block(lhs_chunk, rhs_chunk);
 
-				// TODO: replace with the new signal
-				// if (Signal::cancel_computations())
-				//	break;
+			for (index_t c=0; c<num_outputs; ++c)
+			{
+				const float64_t* coef=coefficients.get_column_vector(c)+lhs_begin;
+				for (index_t j=0; j<block.num_cols; ++j)
+				{
+					float64_t sum=0;
+					for (index_t i=0; i<block.num_rows; ++i)
+						sum+=coef[i]*block(i, j);
+					outputs(rhs_begin+j, c)+=sum;
+				}
 			}
 		}
-
 	}
 
-	return NULL;
+	return outputs;
 }
 
 template <class T>
 SGMatrix<T> Kernel::get_kernel_matrix()
 {
-	T* result = NULL;
-
 	require(has_features(), "no features assigned to kernel");
+	SG_PROFILE_SCOPE("Kernel::get_kernel_matrix");
 
 	int32_t m=get_num_vec_lhs();
 	int32_t n=get_num_vec_rhs();
 
-	int64_t total_num = int64_t(m)*n;
-
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
 	bool symmetric= (lhs && lhs==rhs && m==n);
 
 	SG_DEBUG("returning kernel matrix of size {}x{}", m, n)
 
-	result=SG_MALLOC(T, total_num);
+	SGMatrix<T> result(m, n);
 
-	int32_t num_threads=env()->get_num_threads();
-	K_THREAD_PARAM<T> params;
-	int64_t step = total_num/num_threads;
-	index_t t = 0;
-	auto pb = SG_PROGRESS(range(total_num));
-#pragma omp parallel for lastprivate(t) private(params)
-	for (t = 0; t < num_threads; ++t)
+	// the matrix is computed in tiles, for symmetric matrices only the tiles
+	// on and above the diagonal are computed and mirrored afterwards
+	std::vector<std::pair<index_t, index_t>> tiles;
+	for (index_t row=0; row<m; row+=kernel_block_size)
 	{
-		params.kernel = this;
-		params.result = result;
-		params.start = compute_row_start(t*step, n, symmetric);
-		params.end = compute_row_start((t+1)*step, n, symmetric);
-		params.total_start=t*step;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=false;
-		params.pb = &pb;
-		Kernel::get_kernel_matrix_helper<T>((void*)&params);
+		for (index_t col=symmetric ? row : 0; col<n; col+=kernel_block_size)
+			tiles.emplace_back(row, col);
 	}
 
-	if (total_num % num_threads != 0)
+	// a stopped computation skips the remaining tiles, all threads reach
+	// the end of the loop without waiting for the others
+	const auto computation=StoppableSGObject::current_computation();
+
+	auto pb = SG_PROGRESS(range(int64_t(tiles.size())));
+#pragma omp parallel for schedule(dynamic)
+	for (int64_t t=0; t<int64_t(tiles.size()); ++t)
 	{
-		params.kernel = this;
-		params.result = result;
-		params.start = compute_row_start(t*step, n, symmetric);
-		params.end = m;
-		params.total_start=t*step;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=false;
-		params.pb = &pb;
-		Kernel::get_kernel_matrix_helper<T>((void*)&params);
+		if (computation && computation->cancel_computation())
+			continue;
+
+		const index_t row_begin=tiles[t].first;
+		const index_t col_begin=tiles[t].second;
+		SGVector<index_t> rows(std::min(kernel_block_size, m-row_begin));
+		SGVector<index_t> cols(std::min(kernel_block_size, n-col_begin));
+		rows.range_fill(row_begin);
+		cols.range_fill(col_begin);
+		auto block=get_kernel_block(rows, cols);
+
+		for (index_t j=0; j<block.num_cols; ++j)
+		{
+			for (index_t i=0; i<block.num_rows; ++i)
+			{
+				const T v=block(i, j);
+				result(row_begin+i, col_begin+j)=v;
+
+				if (symmetric && row_begin!=col_begin)
+					result(col_begin+j, row_begin+i)=v;
+			}
+		}
+
+		pb.print_progress();
 	}
 
 	pb.complete();
 
-	return SGMatrix<T>(result,m,n,true);
+	return result;
 }
 
 
 template SGMatrix<float64_t> Kernel::get_kernel_matrix<float64_t>();
 template SGMatrix<float32_t> Kernel::get_kernel_matrix<float32_t>();
-
-template void* Kernel::get_kernel_matrix_helper<float64_t>(void* p);
-template void* Kernel::get_kernel_matrix_helper<float32_t>(void* p);
@@ -20,8 +20,11 @@
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/CacheManager.h>
 #include <shogun/features/Features.h>
 
+#include <atomic>
+
 namespace shogun
 {
 	class File;
@@ -47,6 +50,13 @@ enum EOptimizationType
 	SLOWBUTMEMEFFICIENT
 };
 
+/** floating point precision used for block-wise kernel computations */
+enum EKernelPrecision
+{
+	PRECISION_FLOAT64,
+	PRECISION_FLOAT32
+};
+
 /** kernel type */
 enum EKernelType
 {
@@ -72,6 +82,7 @@ enum EKernelType
 	K_COMMULONGSTRING = 121,
 	K_SPECTRUMRBF = 122,
 	K_SPECTRUMMISMATCHRBF = 123,
+	K_MISMATCHSTRING = 124,
 	K_COMBINED = 140,
 	K_AUC = 150,
 	K_CUSTOM = 160,
@@ -112,7 +123,11 @@ enum EKernelType
 	K_GAUSSIANARDSPARSE = 511,
 	K_STREAMING = 520,
 	K_PERIODIC = 530,
-	K_MATERN = 540
+	K_MATERN = 540,
+	K_LOWRANKAPPROX = 550,
+	/** compact kernels of KernelDensity without a Kernel class */
+	K_EPANECHNIKOV = 560,
+	K_TOPHAT = 570
 };
 
 /** kernel property */
@@ -435,6 +450,40 @@ class Kernel : public SGObject
 		 */
 		template <class T> SGMatrix<T> get_kernel_matrix();
 
+		/** get a block of the kernel matrix, i.e. kernel(lhs_idx[i],
+		 * rhs_idx[j]) for all pairs of the given indices
+		 *
+		 * The block is computed with a single call to compute_block() if the
+		 * kernel supports it and element-wise otherwise.
+		 *
+		 * @param lhs_idx indices of the lhs vectors
+		 * @param rhs_idx indices of the rhs vectors
+		 * @return block of size lhs_idx.vlen x rhs_idx.vlen
+		 */
+		SGMatrix<float64_t> get_kernel_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx);
+
+		/** compute weighted sums of kernel values
+		 * \f$o_{jc}=\sum_i \alpha_{ic} k({\bf x}_{l_i}, {\bf x'}_{r_j})\f$
+		 * for all rhs vectors \f$r_j\f$ at once
+		 *
+		 * The kernel matrix is never formed, instead blocks of
+		 * get_kernel_block() are multiplied with the corresponding rows of
+		 * the coefficients. This is what kernel machines evaluate when
+		 * applied to new data.
+		 *
+		 * @param lhs_idx indices \f$l_i\f$ of the lhs vectors (e.g. the
+		 * support vectors)
+		 * @param coefficients coefficients \f$\alpha\f$, one row per lhs
+		 * index and one column per output
+		 * @param rhs_idx indices \f$r_j\f$ of the rhs vectors
+		 * @return outputs of size rhs_idx.vlen x coefficients.num_cols
+		 */
+		SGMatrix<float64_t> compute_weighted_outputs(
+			const SGVector<index_t>& lhs_idx,
+			const SGMatrix<float64_t>& coefficients,
+			const SGVector<index_t>& rhs_idx);
+
 		/** initialize kernel
 		 *  e.g. setup lhs/rhs of kernel, precompute normalization
 		 *  constants etc.
@@ -600,6 +649,14 @@ class Kernel : public SGObject
 		 */
 		inline int32_t get_activenum_cache() { return kernel_cache.activenum; }
 
+		/** get the hits and misses of the kernel cache, which it reports
+		 * to the CacheManager
+		 *
+		 * @return rows found in the cache, computed rows and the seconds
+		 * spent computing them
+		 */
+		CacheManager::Statistics get_cache_statistics() const;
+
 		/** get kernel row
 		 *
 		 * @param docnum docnum
@@ -639,7 +696,8 @@ class Kernel : public SGObject
 		/** resize kernel cache
 		 *
 		 * @param size new size
-		 * @param regression_hack hack for regression
+		 * @param regression_hack the cache is indexed by the 2*num_lhs
+		 * variables of a regression problem, see cache_example_index()
 		 */
 		void resize_kernel_cache(KERNELCACHE_IDX size,
 			bool regression_hack=false);
@@ -660,6 +718,7 @@ class Kernel : public SGObject
 		 */
 		inline int32_t kernel_cache_touch(int32_t cacheidx)
 		{
+			cacheidx=cache_example_index(cacheidx);
 			if(kernel_cache.index[cacheidx] != -1)
 			{
 				kernel_cache.lru[kernel_cache.index[cacheidx]]=kernel_cache.time;
@@ -675,6 +734,7 @@ class Kernel : public SGObject
 		 */
 		inline int32_t kernel_cache_check(int32_t cacheidx)
 		{
+			cacheidx=cache_example_index(cacheidx);
 			return(kernel_cache.index[cacheidx] >= 0);
 		}
 
@@ -690,10 +750,26 @@ class Kernel : public SGObject
 		/** initialize kernel cache
 		 *
 		 * @param size size to initialize to
-		 * @param regression_hack if hack for regression shall be applied
+		 * @param regression_hack if the cache is indexed by the variables
+		 * of a regression problem, which share the rows and columns of
+		 * their examples, see cache_example_index()
 		 */
 		void kernel_cache_init(int32_t size, bool regression_hack=false);
 
+		/** get the example of a variable of the cache. Regression (e.g.
+		 * SVRLight) has two variables i and 2*num_lhs-1-i per example i,
+		 * which differ in sign only. They share a single cache row and a
+		 * single column of every row, so a cache of a given size holds
+		 * twice the rows it would with a separate entry per variable.
+		 *
+		 * @param idx index of a variable
+		 * @return index of its example
+		 */
+		inline int32_t cache_example_index(int32_t idx) const
+		{
+			return idx>=num_lhs ? 2*num_lhs-1-idx : idx;
+		}
+
 		/** cleanup kernel cache */
 		void kernel_cache_cleanup();
 
@@ -736,6 +812,25 @@ class Kernel : public SGObject
 		 */
 		virtual void set_optimization_type(EOptimizationType t) { opt_type=t;}
 
+		/** get precision of block-wise kernel computations
+		 *
+		 * @return precision
+		 */
+		inline EKernelPrecision get_precision() const { return m_precision; }
+
+		/** set precision of block-wise kernel computations
+		 *
+		 * With PRECISION_FLOAT32, dot products between dense double
+		 * precision feature vectors are computed in single precision, which
+		 * halves the memory traffic and doubles the SIMD width of the
+		 * underlying matrix-matrix products. Combine with
+		 * get_kernel_matrix<float32_t>() to also store the result in single
+		 * precision.
+		 *
+		 * @param precision precision to set
+		 */
+		void set_precision(EKernelPrecision precision) { m_precision=precision; }
+
 		/** check if optimization is initialized
 		 *
 		 * @return if optimization is initialized
@@ -858,6 +953,58 @@ class Kernel : public SGObject
 		{
 			return get_parameter_gradient(param,index).get_diagonal_vector();
 		}
+
+		/** return derivatives with respect to all elements of the specified
+		 * parameter at once
+		 *
+		 * Kernels that can share work between the elements of a parameter
+		 * (e.g. the pairwise differences of ARD kernels) override this, the
+		 * default calls get_parameter_gradient() for every element.
+		 *
+		 * @param param the parameter
+		 * @param num_elements number of elements of the parameter
+		 *
+		 * @return gradient with respect to every element of the parameter
+		 */
+		virtual std::vector<SGMatrix<float64_t>> get_parameter_gradients(
+				Parameters::const_reference param, index_t num_elements)
+		{
+			std::vector<SGMatrix<float64_t>> gradients;
+			gradients.reserve(num_elements);
+			if (num_elements==1)
+				gradients.push_back(get_parameter_gradient(param));
+			else
+			{
+				for (index_t i=0; i<num_elements; i++)
+					gradients.push_back(get_parameter_gradient(param, i));
+			}
+			return gradients;
+		}
+
+		/** return diagonal parts of the derivatives with respect to all
+		 * elements of the specified parameter at once, see
+		 * get_parameter_gradients()
+		 *
+		 * @param param the parameter
+		 * @param num_elements number of elements of the parameter
+		 *
+		 * @return diagonal part of the gradient with respect to every
+		 * element of the parameter
+		 */
+		virtual std::vector<SGVector<float64_t>> get_parameter_gradients_diagonal(
+				Parameters::const_reference param, index_t num_elements)
+		{
+			std::vector<SGVector<float64_t>> gradients;
+			gradients.reserve(num_elements);
+			if (num_elements==1)
+				gradients.push_back(get_parameter_gradient_diagonal(param));
+			else
+			{
+				for (index_t i=0; i<num_elements; i++)
+					gradients.push_back(get_parameter_gradient_diagonal(param, i));
+			}
+			return gradients;
+		}
 #endif
 
 		/** Obtains a kernel from a generic SGObject with error checking. Note
@@ -922,11 +1069,56 @@ class Kernel : public SGObject
 			return i_start;
 		}
 
-		/** helper for computing the kernel matrix in a parallel way
+		/** compute a block of the (unnormalized) kernel matrix, i.e.
+		 * compute(lhs_idx[i], rhs_idx[j]) for all entries (i,j) of block.
 		 *
-		 * @param p thread parameters
+		 * Kernels that can compute many kernel values at once (e.g. via a
+		 * matrix-matrix product of the feature vectors) should override
+		 * this, so that get_kernel_block() dispatches once per block instead
+		 * of once per element. The default implementation returns false, in
+		 * which case the block is filled element-wise.
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return whether the block was computed
+		 */
+		virtual bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block)
+		{
+			return false;
+		}
+
+		/** compute a block of dot products between lhs and rhs vectors,
+		 * which have to be DotFeatures, see DotFeatures::dot_block()
+		 *
+		 * Helper for compute_block() of kernels that are functions of dot
+		 * products. Respects the precision set by set_precision().
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of dot products
 		 */
-		template <class T> static void* get_kernel_matrix_helper(void* p);
+		void compute_dot_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block);
+
+		/** get the lhs and rhs vectors of a block as matrices, see
+		 * DenseFeatures::get_feature_matrix_block()
+		 *
+		 * Helper for compute_block() of kernels that transform the
+		 * features elementwise.
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param lhs_block lhs vectors as columns
+		 * @param rhs_block rhs vectors as columns
+		 * @return whether both sides are dense float64 features
+		 */
+		bool get_dense_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& lhs_block, SGMatrix<float64_t>& rhs_block) const;
 
 		/** Can (optionally) be overridden to post-initialize some member
 		 *  variables which are not PARAMETER::ADD'ed.  Make sure that at
@@ -1037,12 +1229,28 @@ class Kernel : public SGObject
 		//@}
 
 	protected:
+		/** number of rows and cols of the tiles get_kernel_matrix() is
+		 * computed in, chosen such that a tile of kernel values and the
+		 * involved feature vectors fit into the L2 cache
+		 */
+		static constexpr index_t kernel_block_size=128;
+
 		/// cache_size in MB
 		int32_t cache_size;
 
 #ifdef USE_SVMLIGHT
 		/// kernel cache
 		KERNEL_CACHE kernel_cache;
+
+		/// registration of the kernel cache at the cache manager, which
+		/// may grant less memory than cache_size
+		std::unique_ptr<CacheManager::Entry> cache_entry;
+		/// rows found in the kernel cache
+		std::atomic<int64_t> cache_hits{0};
+		/// rows computed for the kernel cache
+		std::atomic<int64_t> cache_misses{0};
+		/// time spent computing the rows of the misses
+		std::atomic<int64_t> cache_miss_nanoseconds{0};
 #endif //USE_SVMLIGHT
 
 		/// this *COULD* store the whole kernel matrix
@@ -1072,6 +1280,9 @@ class Kernel : public SGObject
 		 */
 		EOptimizationType opt_type;
 
+		/** precision of block-wise kernel computations */
+		EKernelPrecision m_precision;
+
 		/** kernel properties */
 		uint64_t  properties;
 
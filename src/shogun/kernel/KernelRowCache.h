@@ -0,0 +1,263 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _KERNELROWCACHE_H__
+#define _KERNELROWCACHE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+#include <shogun/io/SGIO.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace shogun
+{
+/** @brief Template class KernelRowCache implements a thread-safe cache of
+ * kernel rows for kernel machine solvers.
+ *
+ * Rows are distributed over a number of shards (row i lives in shard
+ * i % num_shards), each of which is guarded by its own spin lock and evicts
+ * rows using the clock (second chance) algorithm. Solver threads that access
+ * rows of different shards therefore never contend, and a lock is only held
+ * for the lookup/insertion itself - rows are computed outside of any lock.
+ *
+ * Rows are handed out as reference counted SGVector, so a row that is
+ * evicted while another thread still reads it stays valid until that thread
+ * drops its reference.
+ *
+ * Hits and misses are counted with atomic counters and can be queried via
+ * get_num_hits() and get_num_misses().
+ */
+template <class T> class KernelRowCache
+{
+	/** a single shard of the cache */
+	struct Shard
+	{
+		/** lock guarding the shard */
+		Lock lock;
+		/** slot of each row of the shard, -1 if not cached */
+		std::vector<index_t> row_slots;
+		/** row stored in each slot, -1 if the slot is free */
+		std::vector<index_t> slot_rows;
+		/** cached rows */
+		std::vector<SGVector<T>> slot_data;
+		/** reference bits for the clock algorithm */
+		std::vector<bool> referenced;
+		/** clock hand */
+		index_t hand = 0;
+	};
+
+public:
+	/** function computing the kernel row with the given index into the
+	 * provided preallocated memory
+	 */
+	typedef std::function<void(index_t, T*)> RowFunction;
+
+	/** constructor
+	 *
+	 * @param num_rows number of rows that may be requested
+	 * @param row_length number of elements per row
+	 * @param cache_size cache size in megabytes
+	 * @param num_shards number of shards, 0 picks one per thread
+	 */
+	KernelRowCache(
+		index_t num_rows, index_t row_length, int64_t cache_size,
+		index_t num_shards=0)
+		: m_num_rows(num_rows), m_row_length(row_length)
+	{
+		require(num_rows>0, "Number of rows ({}) must be positive!", num_rows);
+		require(row_length>0, "Row length ({}) must be positive!", row_length);
+
+		if (num_shards<=0)
+			num_shards=env()->get_num_threads();
+		num_shards=std::max<index_t>(std::min(num_shards, num_rows), 1);
+
+		int64_t max_rows=cache_size*1024*1024/(int64_t(sizeof(T))*row_length);
+		max_rows=std::min<int64_t>(std::max<int64_t>(max_rows, 2), num_rows);
+
+		// every shard must be able to hold at least one row
+		num_shards=std::min<index_t>(num_shards, max_rows);
+		m_shards.resize(num_shards);
+		for (index_t s=0; s<num_shards; ++s)
+		{
+			auto shard=std::make_unique<Shard>();
+			const index_t shard_rows=(num_rows-s+num_shards-1)/num_shards;
+			const index_t shard_slots=
+				(max_rows-s+num_shards-1)/num_shards;
+			shard->row_slots.resize(shard_rows, -1);
+			shard->slot_rows.resize(shard_slots, -1);
+			shard->slot_data.resize(shard_slots);
+			shard->referenced.resize(shard_slots, false);
+			m_shards[s]=std::move(shard);
+		}
+		m_max_rows=max_rows;
+	}
+
+	/** get a kernel row, computing and caching it on a miss
+	 *
+	 * @param row index of the row
+	 * @param compute_row function computing the row on a miss
+	 * @return the kernel row
+	 */
+	SGVector<T> get_row(index_t row, const RowFunction& compute_row)
+	{
+		require(row>=0 && row<m_num_rows,
+			"Row index {} out of range [0, {})!", row, m_num_rows);
+
+		auto& shard=*m_shards[row%m_shards.size()];
+		const index_t local_row=row/m_shards.size();
+
+		shard.lock.lock();
+		index_t slot=shard.row_slots[local_row];
+		if (slot>=0)
+		{
+			shard.referenced[slot]=true;
+			SGVector<T> result=shard.slot_data[slot];
+			shard.lock.unlock();
+			m_num_hits++;
+			return result;
+		}
+		shard.lock.unlock();
+		m_num_misses++;
+
+		SGVector<T> result(m_row_length);
+		compute_row(row, result.vector);
+
+		shard.lock.lock();
+		slot=shard.row_slots[local_row];
+		if (slot>=0)
+		{
+			// another thread computed the row in the mean time
+			shard.referenced[slot]=true;
+			result=shard.slot_data[slot];
+		}
+		else
+		{
+			slot=evict(shard);
+			shard.row_slots[local_row]=slot;
+			shard.slot_rows[slot]=row;
+			shard.slot_data[slot]=result;
+			shard.referenced[slot]=true;
+		}
+		shard.lock.unlock();
+
+		return result;
+	}
+
+	/** @return whether the given row is currently cached */
+	bool is_cached(index_t row) const
+	{
+		require(row>=0 && row<m_num_rows,
+			"Row index {} out of range [0, {})!", row, m_num_rows);
+
+		auto& shard=*m_shards[row%m_shards.size()];
+		shard.lock.lock();
+		const bool cached=shard.row_slots[row/m_shards.size()]>=0;
+		shard.lock.unlock();
+		return cached;
+	}
+
+	/** remove all rows from the cache and reset the counters */
+	void clear()
+	{
+		for (auto& shard : m_shards)
+		{
+			shard->lock.lock();
+			std::fill(shard->row_slots.begin(), shard->row_slots.end(), -1);
+			std::fill(shard->slot_rows.begin(), shard->slot_rows.end(), -1);
+			std::fill(shard->slot_data.begin(), shard->slot_data.end(), SGVector<T>());
+			std::fill(shard->referenced.begin(), shard->referenced.end(), false);
+			shard->hand=0;
+			shard->lock.unlock();
+		}
+		m_num_hits=0;
+		m_num_misses=0;
+	}
+
+	/** @return number of elements per row */
+	index_t get_row_length() const
+	{
+		return m_row_length;
+	}
+
+	/** @return number of shards */
+	index_t get_num_shards() const
+	{
+		return m_shards.size();
+	}
+
+	/** @return maximum number of rows held in the cache */
+	index_t get_max_rows() const
+	{
+		return m_max_rows;
+	}
+
+	/** @return number of cache hits */
+	int64_t get_num_hits() const
+	{
+		return m_num_hits.load();
+	}
+
+	/** @return number of cache misses */
+	int64_t get_num_misses() const
+	{
+		return m_num_misses.load();
+	}
+
+private:
+	/** find a slot for a new row using the clock algorithm, the shard has
+	 * to be locked
+	 *
+	 * @param shard the shard to evict from
+	 * @return index of the free slot
+	 */
+	index_t evict(Shard& shard)
+	{
+		const index_t num_slots=shard.slot_rows.size();
+		while (true)
+		{
+			const index_t slot=shard.hand;
+			shard.hand=(shard.hand+1)%num_slots;
+
+			if (shard.slot_rows[slot]<0)
+				return slot;
+
+			if (shard.referenced[slot])
+			{
+				shard.referenced[slot]=false;
+				continue;
+			}
+
+			shard.row_slots[shard.slot_rows[slot]/m_shards.size()]=-1;
+			shard.slot_rows[slot]=-1;
+			shard.slot_data[slot]=SGVector<T>();
+			return slot;
+		}
+	}
+
+	/** number of rows */
+	index_t m_num_rows;
+	/** length of each row */
+	index_t m_row_length;
+	/** maximum number of cached rows */
+	index_t m_max_rows;
+	/** shards */
+	std::vector<std::unique_ptr<Shard>> m_shards;
+	/** number of hits */
+	std::atomic<int64_t> m_num_hits{0};
+	/** number of misses */
+	std::atomic<int64_t> m_num_misses{0};
+};
+}
+#endif // _KERNELROWCACHE_H__
@@ -85,6 +85,14 @@ bool LinearKernel::delete_optimization()
 	return true;
 }
 
+bool LinearKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	compute_dot_block(lhs_idx, rhs_idx, block);
+	return true;
+}
+
 float64_t LinearKernel::compute_optimized(int32_t idx)
 {
 	ASSERT(get_is_initialized())
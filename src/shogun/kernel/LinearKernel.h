@@ -130,6 +130,18 @@ class LinearKernel: public DotKernel
 		}
 
 	protected:
+		/** compute a block of kernel values from a single block of dot
+		 * products, see Kernel::compute_block()
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return true
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 		/** normal vector (used in case of optimized kernel) */
 		SGVector<float64_t> normal;
 };
@@ -5,6 +5,7 @@
  */
 
 #include <shogun/kernel/LogKernel.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/Math.h>
 
 #include <utility>
@@ -56,3 +57,18 @@ float64_t LogKernel::compute(int32_t idx_a, int32_t idx_b)
 	temp = log(temp + 1);
 	return -temp;
 }
+
+bool LogKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto dist=m_distance->get_distance_block(lhs_idx, rhs_idx);
+	simd::pow(dist.matrix, m_degree, block.matrix, block.size());
+	for (int64_t k=0; k<block.size(); ++k)
+		block.matrix[k]+=1;
+	simd::log(block.matrix, block.matrix, block.size());
+	for (int64_t k=0; k<block.size(); ++k)
+		block.matrix[k]=-block.matrix[k];
+
+	return true;
+}
@@ -0,0 +1,324 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/kernel/LowRankApproxKernel.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace shogun;
+
+LowRankApproxKernel::LowRankApproxKernel() : RandomMixin<Kernel>()
+{
+	init();
+}
+
+LowRankApproxKernel::LowRankApproxKernel(
+	std::shared_ptr<Kernel> kernel, int32_t num_landmarks,
+	ELandmarkSelection selection)
+	: RandomMixin<Kernel>()
+{
+	init();
+
+	m_kernel=std::move(kernel);
+	m_num_landmarks=num_landmarks;
+	m_landmark_selection=selection;
+}
+
+LowRankApproxKernel::~LowRankApproxKernel()
+{
+	cleanup();
+}
+
+void LowRankApproxKernel::init()
+{
+	m_kernel=nullptr;
+	m_num_landmarks=0;
+	m_landmark_selection=LANDMARKS_UNIFORM;
+	m_landmark_features=nullptr;
+
+	SG_ADD(&m_kernel, "kernel", "Approximated kernel.",
+		ParameterProperties::HYPER);
+	SG_ADD(&m_num_landmarks, "num_landmarks", "Number of landmarks.",
+		ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+		(machine_int_t*)&m_landmark_selection, "landmark_selection",
+		"Landmark selection strategy.", ParameterProperties::NONE,
+		SG_OPTIONS(
+			LANDMARKS_UNIFORM, LANDMARKS_KMEANS_PLUS_PLUS,
+			LANDMARKS_LEVERAGE_SCORE));
+	SG_ADD(&m_landmarks, "landmarks", "Indices of the landmarks.",
+		ParameterProperties::READONLY);
+	SG_ADD(&m_landmark_features, "landmark_features",
+		"Feature vectors of the landmarks.", ParameterProperties::READONLY);
+	SG_ADD(&m_projection, "projection",
+		"Projection onto the approximate eigenspace.",
+		ParameterProperties::READONLY);
+}
+
+void LowRankApproxKernel::fit(const std::shared_ptr<Features>& data)
+{
+	require(m_kernel, "No kernel to approximate provided!");
+	require(data, "No features provided!");
+
+	const index_t num_vectors=data->get_num_vectors();
+	require(m_num_landmarks>0 && m_num_landmarks<=num_vectors,
+		"Number of landmarks ({}) must be in [1, {}]!", m_num_landmarks,
+		num_vectors);
+
+	fit_landmarks(data, select_landmarks(data));
+}
+
+std::shared_ptr<DenseFeatures<float64_t>> LowRankApproxKernel::transform(
+	const std::shared_ptr<Features>& data)
+{
+	require(data, "No features provided!");
+	return std::make_shared<DenseFeatures<float64_t>>(compute_feature_map(data));
+}
+
+bool LowRankApproxKernel::init(
+	std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	Kernel::init(l, r);
+
+	if (!m_landmark_features)
+		fit(l);
+
+	m_lhs_map=compute_feature_map(l);
+	m_rhs_map=(l==r) ? m_lhs_map : compute_feature_map(r);
+
+	return init_normalizer();
+}
+
+void LowRankApproxKernel::cleanup()
+{
+	m_lhs_map=SGMatrix<float64_t>();
+	m_rhs_map=SGMatrix<float64_t>();
+	Kernel::cleanup();
+}
+
+float64_t LowRankApproxKernel::compute(int32_t idx_a, int32_t idx_b)
+{
+	SGVector<float64_t> a(m_lhs_map.get_column_vector(idx_a), get_rank(), false);
+	SGVector<float64_t> b(m_rhs_map.get_column_vector(idx_b), get_rank(), false);
+	return linalg::dot(a, b);
+}
+
+bool LowRankApproxKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	const index_t rank=get_rank();
+	SGMatrix<float64_t> lhs_block(rank, lhs_idx.vlen);
+	SGMatrix<float64_t> rhs_block(rank, rhs_idx.vlen);
+	for (index_t i=0; i<lhs_idx.vlen; ++i)
+	{
+		std::copy_n(m_lhs_map.get_column_vector(lhs_idx[i]), rank,
+			lhs_block.get_column_vector(i));
+	}
+	for (index_t j=0; j<rhs_idx.vlen; ++j)
+	{
+		std::copy_n(m_rhs_map.get_column_vector(rhs_idx[j]), rank,
+			rhs_block.get_column_vector(j));
+	}
+	linalg::matrix_prod(lhs_block, rhs_block, block, true, false);
+
+	return true;
+}
+
+SGVector<index_t> LowRankApproxKernel::select_landmarks(
+	const std::shared_ptr<Features>& data)
+{
+	SGVector<index_t> landmarks;
+	switch (m_landmark_selection)
+	{
+	case LANDMARKS_UNIFORM:
+		landmarks=select_uniform(data->get_num_vectors());
+		break;
+	case LANDMARKS_KMEANS_PLUS_PLUS:
+		landmarks=select_kmeans_plus_plus(data);
+		break;
+	case LANDMARKS_LEVERAGE_SCORE:
+		landmarks=select_leverage_score(data);
+		break;
+	}
+
+	std::sort(landmarks.begin(), landmarks.end());
+	return landmarks;
+}
+
+SGVector<index_t> LowRankApproxKernel::select_uniform(index_t num_vectors)
+{
+	SGVector<index_t> perm(num_vectors);
+	perm.range_fill();
+	random::shuffle(perm, m_prng);
+
+	SGVector<index_t> landmarks(m_num_landmarks);
+	std::copy_n(perm.begin(), m_num_landmarks, landmarks.begin());
+	return landmarks;
+}
+
+SGVector<index_t> LowRankApproxKernel::select_kmeans_plus_plus(
+	const std::shared_ptr<Features>& data)
+{
+	const index_t num_vectors=data->get_num_vectors();
+	m_kernel->init(data, data);
+
+	SGVector<float64_t> diag(num_vectors);
+#pragma omp parallel for
+	for (index_t i=0; i<num_vectors; ++i)
+		diag[i]=m_kernel->kernel(i, i);
+
+	// squared distance in feature space to the closest landmark
+	SGVector<float64_t> min_dist(num_vectors);
+	min_dist.set_const(std::numeric_limits<float64_t>::infinity());
+
+	SGVector<index_t> landmarks(m_num_landmarks);
+	UniformIntDistribution<index_t> uniform(0, num_vectors-1);
+	landmarks[0]=uniform(m_prng);
+
+	for (index_t l=0; l<m_num_landmarks; ++l)
+	{
+		if (l>0)
+			landmarks[l]=sample_weighted(min_dist);
+
+		const index_t c=landmarks[l];
+#pragma omp parallel for
+		for (index_t i=0; i<num_vectors; ++i)
+		{
+			const float64_t dist=diag[i]+diag[c]-2*m_kernel->kernel(i, c);
+			min_dist[i]=std::min(min_dist[i], std::max(dist, 0.0));
+		}
+		// never draw a landmark twice
+		min_dist[c]=0;
+	}
+
+	m_kernel->remove_lhs_and_rhs();
+	return landmarks;
+}
+
+SGVector<index_t> LowRankApproxKernel::select_leverage_score(
+	const std::shared_ptr<Features>& data)
+{
+	const index_t num_vectors=data->get_num_vectors();
+
+	// leverage scores of the uniform Nyström approximation K~=Phi^T Phi are
+	// the diagonal of Phi^T (Phi Phi^T)^+ Phi
+	fit_landmarks(data, select_uniform(num_vectors));
+	auto phi=compute_feature_map(data);
+	auto cov=linalg::matrix_prod(phi, phi, false, true);
+	auto cov_inv=linalg::pinvh(cov);
+	auto projected=linalg::matrix_prod(cov_inv, phi);
+
+	SGVector<float64_t> scores(num_vectors);
+#pragma omp parallel for
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		SGVector<float64_t> a(phi.get_column_vector(i), phi.num_rows, false);
+		SGVector<float64_t> b(
+			projected.get_column_vector(i), projected.num_rows, false);
+		scores[i]=std::max(linalg::dot(a, b), 0.0);
+	}
+
+	SGVector<index_t> landmarks(m_num_landmarks);
+	for (index_t l=0; l<m_num_landmarks; ++l)
+	{
+		landmarks[l]=sample_weighted(scores);
+		scores[landmarks[l]]=0;
+	}
+
+	return landmarks;
+}
+
+index_t LowRankApproxKernel::sample_weighted(const SGVector<float64_t>& weights)
+{
+	float64_t total=0;
+	for (index_t i=0; i<weights.vlen; ++i)
+		total+=weights[i];
+
+	if (total<=0)
+	{
+		UniformIntDistribution<index_t> uniform(0, weights.vlen-1);
+		return uniform(m_prng);
+	}
+
+	UniformRealDistribution<float64_t> uniform(0, total);
+	const float64_t threshold=uniform(m_prng);
+
+	float64_t sum=0;
+	index_t last=0;
+	for (index_t i=0; i<weights.vlen; ++i)
+	{
+		if (weights[i]<=0)
+			continue;
+
+		sum+=weights[i];
+		last=i;
+		if (sum>threshold)
+			return i;
+	}
+
+	// rounding, the threshold is close to the total weight
+	return last;
+}
+
+void LowRankApproxKernel::fit_landmarks(
+	const std::shared_ptr<Features>& data, const SGVector<index_t>& landmarks)
+{
+	m_landmarks=landmarks;
+	m_landmark_features=data->copy_subset(landmarks);
+
+	m_kernel->init(m_landmark_features, m_landmark_features);
+	auto kernel_mm=m_kernel->get_kernel_matrix();
+	m_kernel->remove_lhs_and_rhs();
+
+	const index_t num_landmarks=landmarks.vlen;
+	SGVector<float64_t> eigenvalues(num_landmarks);
+	SGMatrix<float64_t> eigenvectors(num_landmarks, num_landmarks);
+	linalg::eigen_solver_symmetric(kernel_mm, eigenvalues, eigenvectors);
+
+	// drop the numerically zero part of the spectrum, the eigenvalues are
+	// sorted in ascending order
+	const float64_t tolerance=num_landmarks*
+		std::numeric_limits<float64_t>::epsilon()*
+		eigenvalues[num_landmarks-1];
+	index_t first=0;
+	while (first<num_landmarks-1 && eigenvalues[first]<=tolerance)
+		++first;
+
+	m_projection=SGMatrix<float64_t>(num_landmarks, num_landmarks-first);
+	for (index_t k=first; k<num_landmarks; ++k)
+	{
+		const float64_t scale=1.0/std::sqrt(std::max(eigenvalues[k], tolerance));
+		for (index_t i=0; i<num_landmarks; ++i)
+			m_projection(i, k-first)=eigenvectors(i, k)*scale;
+	}
+
+	SG_DEBUG("Nyström approximation with {} landmarks has rank {}",
+		num_landmarks, get_rank());
+}
+
+SGMatrix<float64_t> LowRankApproxKernel::compute_feature_map(
+	const std::shared_ptr<Features>& data)
+{
+	require(m_landmark_features, "Approximation is not fitted, call fit()!");
+
+	SGVector<index_t> landmark_idx(m_landmark_features->get_num_vectors());
+	landmark_idx.range_fill();
+	SGVector<index_t> data_idx(data->get_num_vectors());
+	data_idx.range_fill();
+
+	m_kernel->init(m_landmark_features, data);
+	auto mapped=m_kernel->compute_weighted_outputs(
+		landmark_idx, m_projection, data_idx);
+	m_kernel->remove_lhs_and_rhs();
+
+	return linalg::transpose_matrix(mapped);
+}
@@ -0,0 +1,229 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _LOWRANKAPPROXKERNEL_H__
+#define _LOWRANKAPPROXKERNEL_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+namespace shogun
+{
+/** strategy to select the landmarks of a LowRankApproxKernel */
+enum ELandmarkSelection
+{
+	/** landmarks are drawn uniformly without replacement */
+	LANDMARKS_UNIFORM,
+	/** landmarks are drawn by k-means++ seeding in feature space */
+	LANDMARKS_KMEANS_PLUS_PLUS,
+	/** landmarks are drawn proportional to approximate leverage scores */
+	LANDMARKS_LEVERAGE_SCORE
+};
+
+/** @brief Nyström low-rank approximation of an arbitrary kernel.
+ *
+ * Given \f$m\f$ landmarks \f${\bf z}_1,\dots,{\bf z}_m\f$ selected from the
+ * training data and the eigendecomposition \f$K_{mm}=U\Lambda U^\top\f$ of
+ * the landmark kernel matrix, every vector is mapped to the explicit
+ * features
+ * \f[
+ * \phi({\bf x})=\Lambda^{-\frac{1}{2}}U^\top
+ * (k({\bf z}_1,{\bf x}),\dots,k({\bf z}_m,{\bf x}))^\top
+ * \f]
+ * of rank \f$r\le m\f$ and the kernel is approximated by
+ * \f$k({\bf x},{\bf x'})\approx\phi({\bf x})^\top\phi({\bf x'})\f$.
+ *
+ * fit() selects the landmarks and transform() returns the feature map as
+ * DenseFeatures, which can be used with any linear method (e.g. LibLinear or
+ * a LinearKernel). Only O(nm) memory is required, the full kernel matrix is
+ * never formed. Used as a kernel, init() fits the approximation on the lhs
+ * features (unless fit() was called before) and precomputes the feature map
+ * of lhs and rhs.
+ *
+ * Landmarks are selected uniformly, by k-means++ seeding with the kernel
+ * induced distance, or proportional to leverage scores of a uniform Nyström
+ * approximation of the same rank.
+ */
+class LowRankApproxKernel : public RandomMixin<Kernel>
+{
+public:
+	/** default constructor */
+	LowRankApproxKernel();
+
+	/** constructor
+	 *
+	 * @param kernel kernel to approximate
+	 * @param num_landmarks number of landmarks m
+	 * @param selection landmark selection strategy
+	 */
+	LowRankApproxKernel(
+		std::shared_ptr<Kernel> kernel, int32_t num_landmarks,
+		ELandmarkSelection selection=LANDMARKS_UNIFORM);
+
+	~LowRankApproxKernel() override;
+
+	/** select landmarks among the given data and compute the projection
+	 * onto the approximate eigenspace
+	 *
+	 * @param data training data
+	 */
+	void fit(const std::shared_ptr<Features>& data);
+
+	/** compute the explicit feature map of the given data, requires fit()
+	 *
+	 * @param data data to map
+	 * @return features of dimension get_rank()
+	 */
+	std::shared_ptr<DenseFeatures<float64_t>> transform(
+		const std::shared_ptr<Features>& data);
+
+	/** initialize kernel, fits the approximation on l if fit() was not
+	 * called before
+	 *
+	 * @param l features of left-hand side
+	 * @param r features of right-hand side
+	 * @return if initializing was successful
+	 */
+	bool init(std::shared_ptr<Features> l, std::shared_ptr<Features> r) override;
+
+	/** clean up kernel */
+	void cleanup() override;
+
+	/** @return kernel type */
+	EKernelType get_kernel_type() override
+	{
+		return K_LOWRANKAPPROX;
+	}
+
+	/** @return feature type of the approximated kernel */
+	EFeatureType get_feature_type() override
+	{
+		return m_kernel ? m_kernel->get_feature_type() : F_ANY;
+	}
+
+	/** @return feature class of the approximated kernel */
+	EFeatureClass get_feature_class() override
+	{
+		return m_kernel ? m_kernel->get_feature_class() : C_ANY;
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "LowRankApproxKernel";
+	}
+
+	/** @return indices of the landmarks in the data passed to fit() */
+	SGVector<index_t> get_landmarks() const
+	{
+		return m_landmarks;
+	}
+
+	/** @return rank r of the approximation, at most the number of
+	 * landmarks
+	 */
+	int32_t get_rank() const
+	{
+		return m_projection.num_cols;
+	}
+
+protected:
+	/** compute kernel function as dot product of the feature maps
+	 *
+	 * @param idx_a index a
+	 * @param idx_b index b
+	 * @return computed kernel function at indices a,b
+	 */
+	float64_t compute(int32_t idx_a, int32_t idx_b) override;
+
+	/** compute a block of kernel values with a single matrix-matrix
+	 * product of the feature maps, see Kernel::compute_block()
+	 *
+	 * @param lhs_idx indices of the lhs vectors of the block
+	 * @param rhs_idx indices of the rhs vectors of the block
+	 * @param block preallocated block of the kernel matrix
+	 * @return true
+	 */
+	bool compute_block(
+		const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+		SGMatrix<float64_t>& block) override;
+
+private:
+	void init();
+
+	/** select landmarks according to m_landmark_selection
+	 *
+	 * @param data training data
+	 * @return sorted landmark indices
+	 */
+	SGVector<index_t> select_landmarks(const std::shared_ptr<Features>& data);
+
+	/** @return m_num_landmarks indices drawn uniformly without replacement */
+	SGVector<index_t> select_uniform(index_t num_vectors);
+
+	/** @return landmark indices drawn by k-means++ seeding */
+	SGVector<index_t> select_kmeans_plus_plus(
+		const std::shared_ptr<Features>& data);
+
+	/** @return landmark indices drawn proportional to leverage scores */
+	SGVector<index_t> select_leverage_score(
+		const std::shared_ptr<Features>& data);
+
+	/** draw an index with probability proportional to its weight
+	 *
+	 * @param weights non-negative weights, falls back to a uniform draw
+	 * among all indices if all weights are zero
+	 * @return drawn index
+	 */
+	index_t sample_weighted(const SGVector<float64_t>& weights);
+
+	/** fit the projection onto the approximate eigenspace of the given
+	 * landmarks
+	 *
+	 * @param data training data
+	 * @param landmarks landmark indices into data
+	 */
+	void fit_landmarks(
+		const std::shared_ptr<Features>& data, const SGVector<index_t>& landmarks);
+
+	/** compute the feature map, one column per vector
+	 *
+	 * @param data data to map
+	 * @return matrix of size get_rank() x data->get_num_vectors()
+	 */
+	SGMatrix<float64_t> compute_feature_map(const std::shared_ptr<Features>& data);
+
+protected:
+	/** approximated kernel */
+	std::shared_ptr<Kernel> m_kernel;
+
+	/** number of landmarks */
+	int32_t m_num_landmarks;
+
+	/** landmark selection strategy */
+	ELandmarkSelection m_landmark_selection;
+
+	/** landmark indices into the data passed to fit() */
+	SGVector<index_t> m_landmarks;
+
+	/** landmark feature vectors */
+	std::shared_ptr<Features> m_landmark_features;
+
+	/** projection \f$U\Lambda^{-\frac{1}{2}}\f$ of size m x r */
+	SGMatrix<float64_t> m_projection;
+
+	/** feature map of the lhs, r x num_lhs */
+	SGMatrix<float64_t> m_lhs_map;
+
+	/** feature map of the rhs, r x num_rhs */
+	SGMatrix<float64_t> m_rhs_map;
+};
+}
+#endif /* _LOWRANKAPPROXKERNEL_H__ */
@@ -66,6 +66,22 @@ float64_t PolyKernel::compute(int32_t idx_a, int32_t idx_b)
 	return Math::pow(result, degree);
 }
 
+bool PolyKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	compute_dot_block(lhs_idx, rhs_idx, block);
+
+	const auto gamma = std::get<float64_t>(m_gamma);
+	for (index_t j = 0; j < block.num_cols; ++j)
+	{
+		for (index_t i = 0; i < block.num_rows; ++i)
+			block(i, j) = Math::pow(gamma * block(i, j) + m_c, degree);
+	}
+
+	return true;
+}
+
 void PolyKernel::init()
 {
 	degree = 0;
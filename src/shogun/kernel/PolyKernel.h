@@ -100,6 +100,18 @@ class PolyKernel: public DotKernel
 		 */
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute a block of kernel values from a single block of dot
+		 * products, see Kernel::compute_block()
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return true
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 	private:
 		void init();
 
@@ -5,6 +5,7 @@
  */
 
 #include <shogun/kernel/PowerKernel.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/Math.h>
 
 #include <utility>
@@ -60,3 +61,15 @@ float64_t PowerKernel::compute(int32_t idx_a, int32_t idx_b)
 	float64_t temp = pow(dist, m_degree);
 	return -temp;
 }
+
+bool PowerKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto dist=distance->get_distance_block(lhs_idx, rhs_idx);
+	simd::pow(dist.matrix, m_degree, block.matrix, block.size());
+	for (int64_t k=0; k<block.size(); ++k)
+		block.matrix[k]=-block.matrix[k];
+
+	return true;
+}
@@ -134,13 +134,13 @@ protected:
 	/** Distance instance for the kernel. MUST be initialized by the subclasses */
 	std::shared_ptr<Distance> m_distance;
 
+	/** Precomputed distance instance */
+	std::shared_ptr<CustomDistance> m_precomputed_distance;
+
 private:
 	/** Registers the parameters (serialization support). */
 	void register_params() override;
 
-	/** Precomputed distance instance */
-	std::shared_ptr<CustomDistance> m_precomputed_distance;
-
 	/**
 	 * Method that sets a precomputed distance.
 	 *
@@ -49,3 +49,19 @@ bool SigmoidKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features>
 	DotKernel::init(l, r);
 	return init_normalizer();
 }
+
+bool SigmoidKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	compute_dot_block(lhs_idx, rhs_idx, block);
+
+	const auto gamma = std::get<float64_t>(m_gamma);
+	for (index_t j = 0; j < block.num_cols; ++j)
+	{
+		for (index_t i = 0; i < block.num_rows; ++i)
+			block(i, j) = tanh(gamma * block(i, j) + coef0);
+	}
+
+	return true;
+}
@@ -93,6 +93,18 @@ class SigmoidKernel: public DotKernel
 			return tanh(std::get<float64_t>(m_gamma)*DotKernel::compute(idx_a,idx_b)+coef0);
 		}
 
+		/** compute a block of kernel values from a single block of dot
+		 * products, see Kernel::compute_block()
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return true
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 	protected:
 		/** gamma */
 		AutoValue<float64_t> m_gamma = AutoValueEmpty{};
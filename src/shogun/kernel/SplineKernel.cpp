@@ -10,6 +10,7 @@
 #include <shogun/kernel/SplineKernel.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
 
@@ -65,3 +66,30 @@ float64_t SplineKernel::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+bool SplineKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	SGMatrix<float64_t> lhs_block, rhs_block;
+	if (!get_dense_block(lhs_idx, rhs_idx, lhs_block, rhs_block))
+		return false;
+
+	Eigen::Map<const Eigen::ArrayXXd> x(
+		lhs_block.matrix, lhs_block.num_rows, lhs_block.num_cols);
+	Eigen::Map<const Eigen::ArrayXXd> y(
+		rhs_block.matrix, rhs_block.num_rows, rhs_block.num_cols);
+	Eigen::ArrayXXd xy(x.rows(), x.cols());
+	Eigen::ArrayXXd min(x.rows(), x.cols());
+	for (index_t j=0; j<block.num_cols; ++j)
+	{
+		xy=x.colwise()*y.col(j);
+		min=x.min(y.col(j).replicate(1, x.cols()));
+		const Eigen::ArrayXXd mean=0.5*(x.colwise()+y.col(j));
+		Eigen::Map<Eigen::ArrayXd>(block.get_column_vector(j), block.num_rows)=
+			(1+xy+xy*min-mean*min.square()+min.cube()/3)
+				.colwise().sum().transpose();
+	}
+
+	return true;
+}
@@ -71,6 +71,20 @@ class SplineKernel: public DotKernel
 
 	protected:
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
+
+		/** compute a block of kernel values, see Kernel::compute_block()
+		 *
+		 * For dense features the terms of all dimensions and lhs vectors
+		 * are computed at once for every rhs vector.
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return whether the block was computed
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
 };
 }
 #endif /* _SPLINEKERNEL_H__ */
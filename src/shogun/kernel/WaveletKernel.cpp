@@ -7,6 +7,8 @@
 #include <shogun/lib/common.h>
 #include <shogun/kernel/WaveletKernel.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/lib/simd.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
 
@@ -80,3 +82,33 @@ float64_t WaveletKernel::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+bool WaveletKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	SGMatrix<float64_t> lhs_block, rhs_block;
+	if (!get_dense_block(lhs_idx, rhs_idx, lhs_block, rhs_block))
+		return false;
+
+	if (Wtranslation==0)
+	{
+		block.set_const(1.0);
+		return true;
+	}
+
+	// product of the mother wavelet over the dimensions of every vector
+	auto wavelet_products=[this](const SGMatrix<float64_t>& x) {
+		const Eigen::ArrayXXd h=(Eigen::Map<const Eigen::ArrayXXd>(
+			x.matrix, x.num_rows, x.num_cols)-Wdilation)/Wtranslation;
+		Eigen::ArrayXXd gauss=-0.5*h.square();
+		simd::exp(gauss.data(), gauss.data(), gauss.size());
+		return ((1.75*h).cos()*gauss).colwise().prod().transpose().eval();
+	};
+	const Eigen::ArrayXd lhs_products=wavelet_products(lhs_block);
+	const Eigen::ArrayXd rhs_products=wavelet_products(rhs_block);
+
+	Eigen::Map<Eigen::MatrixXd>(block.matrix, block.num_rows, block.num_cols)=
+		lhs_products.matrix()*rhs_products.matrix().transpose();
+	return true;
+}
@@ -89,6 +89,20 @@ class WaveletKernel: public DotKernel
 		 */
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute a block of kernel values, see Kernel::compute_block()
+		 *
+		 * The kernel is a product of the same function of both vectors, so
+		 * the block is the outer product of one value per vector.
+		 *
+		 * @param lhs_idx indices of the lhs vectors of the block
+		 * @param rhs_idx indices of the rhs vectors of the block
+		 * @param block preallocated block of the kernel matrix
+		 * @return whether the block was computed
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
+
 	protected:
 		/** h(x) is a mother wavelet function */
 		inline float64_t MotherWavelet(float64_t h)
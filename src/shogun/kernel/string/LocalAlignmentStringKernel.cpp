@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <string.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/kernel/string/LocalAlignmentStringKernel.h>
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
@@ -137,14 +138,6 @@ void LocalAlignmentStringKernel::init_logsum(){
 int32_t LocalAlignmentStringKernel::LogSum(int32_t p1, int32_t p2)
 {
 	int32_t diff;
-	static int32_t firsttime=1;
-
-	if (firsttime)
-	{
-		init_logsum();
-		firsttime =0;
-	}
-
 	diff=p1-p2;
 	if (diff>=LOGSUM_TBL)
 		return p1;
@@ -199,6 +192,14 @@ void LocalAlignmentStringKernel::init_static_variables()
 float64_t LocalAlignmentStringKernel::LAkernelcompute(
 	int32_t* aaX, int32_t* aaY, /* the two amino-acid sequences (as sequences of indexes in [0..NAA-1] indicating the position of the amino-acid in the variable 'aaList') */
 	int32_t nX, int32_t nY /* the lengths of both sequences */)
+{
+	std::vector<int32_t> columns;
+	return pair_hmm_score(aaX, aaY, nX, nY, columns);
+}
+
+float64_t LocalAlignmentStringKernel::pair_hmm_score(
+	const int32_t* aaX, const int32_t* aaY, int32_t nX, int32_t nY,
+	std::vector<int32_t>& columns)
 {
 	int32_t
 	i,j,                /* loop indexes */
@@ -212,26 +213,21 @@ float64_t LocalAlignmentStringKernel::LAkernelcompute(
 	*logX2,
 	*logY2;
 
-	int32_t aux, aux2;/* , aux3 , aux4 , aux5;*/
+	int32_t aux, aux2;
 	int32_t cl;/* length of a column for the dynamic programming */
 
-	/*
-	printf("now computing pairHMM between %d and %d:\n",nX,nY);
-	for (i=0;i<nX;printf("%d ",aaX[i++]));
-	printf("\n and \n");
-	for (i=0;i<nY;printf("%d ",aaY[i++]));
-	printf("\n");
-	*/
-
 	/* Initialization of the arrays */
 	/* Each array stores two successive columns of the (nX+1)x(nY+1) table used in dynamic programming */
 	cl=nY+1;           /* each column stores the positions in the aaY sequence, plus a position at zero */
 
-	logM=SG_CALLOC(int32_t, 2*cl);
-	logX=SG_CALLOC(int32_t, 2*cl);
-	logY=SG_CALLOC(int32_t, 2*cl);
-	logX2=SG_CALLOC(int32_t, 2*cl);
-	logY2=SG_CALLOC(int32_t, 2*cl);
+	/* The buffer is reused between calls, it only grows */
+	if (columns.size()<size_t(10*cl))
+		columns.resize(10*cl);
+	logM=columns.data();
+	logX=logM+2*cl;
+	logY=logX+2*cl;
+	logX2=logY+2*cl;
+	logY2=logX2+2*cl;
 
 	/************************************************/
 	/* First iteration : initialization of column 0 */
@@ -266,7 +262,10 @@ float64_t LocalAlignmentStringKernel::LAkernelcompute(
 		logX2[curpos]=LOG0;
 		logY2[curpos]=LOG0;
 
-		/* Secondary loop to vary the position in aaY : j=1..nY */
+		const int32_t aa=aaX[i-1];
+
+		/* The states which emit X, and X and Y, only depend on the previous
+		 * column, so this loop has no dependencies between iterations */
 		for (j=1; j<=nY; j++) {
 
 			curpos=cur*cl+j;            /* index of the state (i,j) */
@@ -278,14 +277,24 @@ float64_t LocalAlignmentStringKernel::LAkernelcompute(
 
 			/* State RX */
 			logX[curpos]=LOGP(-m_opening+logM[frompos], -m_extension+logX[frompos]);
-			/*      printf("%.5f\n",logX[curpos]);*/
-			/*      printf("%.5f\n",logX_B[curpos]);*/
 			/* State RX2 */
 			logX2[curpos]=LOGP(logM[frompos], logX2[frompos]);
 
-			/* Update for states which emit Y only */
-			/***************************************/
+			/* Update for states which emit X and Y */
+			/****************************************/
+
+			frompos=old*cl+j-1;          /* index of the state (i-1,j-1) */
 
+			aux=LOGP(logX[frompos], logY[frompos]);
+			aux2=LOGP(0, logM[frompos]);
+			logM[curpos]=LOGP(aux, aux2)+scaled_blosum[BINDEX(aa, aaY[j-1])];
+		}
+
+		/* The states which emit Y only depend on the state (i,j-1) of the
+		 * same column */
+		for (j=1; j<=nY; j++) {
+
+			curpos=cur*cl+j;            /* index of the state (i,j) */
 			frompos=cur*cl+j-1;          /* index of the state (i,j-1) */
 
 			/* State RY */
@@ -295,20 +304,6 @@ float64_t LocalAlignmentStringKernel::LAkernelcompute(
 			/* State RY2 */
 			aux=LOGP(logM[frompos], logY2[frompos]);
 			logY2[curpos]=LOGP(aux, logX2[frompos]);
-
-			/* Update for states which emit X and Y */
-			/****************************************/
-
-			frompos=old*cl+j-1;          /* index of the state (i-1,j-1) */
-
-			aux=LOGP(logX[frompos], logY[frompos]);
-			aux2=LOGP(0, logM[frompos]);
-			logM[curpos]=LOGP(aux, aux2)+scaled_blosum[BINDEX(aaX[i-1], aaY[j-1])];
-
-			/*
-			printf("i=%d , j=%d\nM=%.5f\nX=%.5f\nY=%.5f\nX2=%.5f\nY2=%.5f\n",i,j,logM[curpos],logX[curpos],logY[curpos],logX2[curpos],logY2[curpos]);
-			*/
-
 		}  /* end of j=1:nY loop */
 
 
@@ -325,19 +320,29 @@ float64_t LocalAlignmentStringKernel::LAkernelcompute(
 	curpos=old*cl+nY;                /* index of the state (nX,nY) */
 	aux=LOGP(logX2[curpos], logY2[curpos]);
 	aux2=LOGP(0, logM[curpos]);
-	/*  kernel_value = LOGP( aux , aux2 );*/
-
-	/* Memory release */
-	SG_FREE(logM);
-	SG_FREE(logX);
-	SG_FREE(logY);
-	SG_FREE(logX2);
-	SG_FREE(logY2);
 
 	/* Return the logarithm of the kernel */
 	return (float32_t)LOGP(aux,aux2)/INTSCALE;
 }
 
+std::vector<int32_t> LocalAlignmentStringKernel::amino_acid_indexes(
+	const SGVector<char>& str) const
+{
+	if (str.vlen<1)
+		error("empty chain");
+
+	/* Extract the characters corresponding to aminoacids and keep their indexes */
+	std::vector<int32_t> aa;
+	aa.reserve(str.vlen);
+	for (auto c : str)
+	{
+		if (isAA[toupper(c)])
+			aa.push_back(aaIndex[toupper(c)-'A']);
+	}
+
+	return aa;
+}
+
 /********************/
 /* Public functions */
 /********************/
@@ -347,48 +352,47 @@ float64_t LocalAlignmentStringKernel::LAkernelcompute(
 /* x and y are strings of aminoacid letters, e.g., "AABRS" */
 float64_t LocalAlignmentStringKernel::compute(int32_t idx_x, int32_t idx_y)
 {
-	int32_t *aax, *aay;  /* to convert x and y into sequences of amino-acid indexes */
-	int32_t lx=0, ly=0;       /* lengths of x and y */
-	int32_t i, j;
-
-	bool free_x, free_y;
-	char* x=std::static_pointer_cast<StringFeatures<char>>(lhs)->get_feature_vector(idx_x, lx, free_x);
-	char* y=std::static_pointer_cast<StringFeatures<char>>(rhs)->get_feature_vector(idx_y, ly, free_y);
-	ASSERT(x && y)
-
-	if ( (lx<1) || (ly<1) )
-		error("empty chain");
-
-	/* Create aax and aay */
-
-	aax = SG_CALLOC(int32_t, lx);
-	aay = SG_CALLOC(int32_t, ly);
-
-	/* Extract the characters corresponding to aminoacids and keep their indexes */
-
-	j=0;
-	for (i=0; i<lx; i++)
-		if (isAA[toupper(x[i])])
-			aax[j++]=aaIndex[toupper(x[i])-'A'];
-	lx=j;
-	j=0;
-	for (i=0; i<ly; i++)
-		if (isAA[toupper(y[i])])
-			aay[j++]=aaIndex[toupper(y[i])-'A'];
-	ly=j;
+	auto x=std::static_pointer_cast<StringFeatures<char>>(lhs)->get_feature_vector(idx_x);
+	auto y=std::static_pointer_cast<StringFeatures<char>>(rhs)->get_feature_vector(idx_y);
 
+	/* Convert x and y into sequences of amino-acid indexes */
+	auto aax=amino_acid_indexes(x);
+	auto aay=amino_acid_indexes(y);
 
 	/* Compute the pair HMM score */
-	float64_t result=LAkernelcompute(aax, aay, lx, ly);
-
-	/* Release memory */
-	SG_FREE(aax);
-	SG_FREE(aay);
+	std::vector<int32_t> columns;
+	return pair_hmm_score(aax.data(), aay.data(), aax.size(), aay.size(), columns);
+}
 
-	std::static_pointer_cast<StringFeatures<char>>(lhs)->free_feature_vector(x, idx_x, free_x);
-	std::static_pointer_cast<StringFeatures<char>>(rhs)->free_feature_vector(y, idx_y, free_y);
+bool LocalAlignmentStringKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	auto sf_l=std::static_pointer_cast<StringFeatures<char>>(lhs);
+	auto sf_r=std::static_pointer_cast<StringFeatures<char>>(rhs);
+
+	std::vector<std::vector<int32_t>> aax(lhs_idx.vlen);
+	for (index_t i=0; i<lhs_idx.vlen; i++)
+		aax[i]=amino_acid_indexes(sf_l->get_feature_vector(lhs_idx[i]));
+	std::vector<std::vector<int32_t>> aay(rhs_idx.vlen);
+	for (index_t j=0; j<rhs_idx.vlen; j++)
+		aay[j]=amino_acid_indexes(sf_r->get_feature_vector(rhs_idx[j]));
+
+	const int64_t total=int64_t(lhs_idx.vlen)*rhs_idx.vlen;
+	#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<int32_t> columns;
+		#pragma omp for schedule(dynamic, 16)
+		for (int64_t k=0; k<total; k++)
+		{
+			const index_t i=k%lhs_idx.vlen;
+			const index_t j=k/lhs_idx.vlen;
+			block(i, j)=pair_hmm_score(aax[i].data(), aay[j].data(),
+				aax[i].size(), aay[j].size(), columns);
+		}
+	}
 
-	return result;
+	return true;
 }
 
 void LocalAlignmentStringKernel::init()
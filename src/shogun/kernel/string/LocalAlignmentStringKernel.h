@@ -12,6 +12,8 @@
 #include <shogun/lib/common.h>
 #include <shogun/kernel/string/StringKernel.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -85,8 +87,27 @@ class LocalAlignmentStringKernel: public StringKernel<char>
 		 */
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute a block of kernel values, the strings of the block are
+		 * converted to amino-acid indexes once and the pairs are scored in
+		 * parallel, see Kernel::compute_block()
+		 */
+		bool compute_block(
+			const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+			SGMatrix<float64_t>& block) override;
 
 	private:
+		/** @return amino-acid indexes of the amino-acid letters of a string,
+		 * other characters are skipped
+		 */
+		std::vector<int32_t> amino_acid_indexes(const SGVector<char>& str) const;
+
+		/** compute the pair HMM score with the given buffer for the dynamic
+		 * programming columns, see LAkernelcompute()
+		 */
+		float64_t pair_hmm_score(
+			const int32_t* aaX, const int32_t* aaY, int32_t nX, int32_t nY,
+			std::vector<int32_t>& columns);
+
 		/** initialize logarithmic sum */
 		void init_logsum();
 
@@ -0,0 +1,331 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/kernel/string/MismatchStringKernel.h>
+
+#include <shogun/base/ShogunEnv.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace shogun;
+
+namespace
+{
+/** @return n choose k, exact as long as the result fits */
+int64_t binomial(int32_t n, int32_t k)
+{
+	if (k<0 || k>n)
+		return 0;
+
+	int64_t result=1;
+	for (int32_t i=0; i<k; i++)
+		result=result*(n-i)/(i+1);
+
+	return result;
+}
+}
+
+MismatchStringKernel::MismatchStringKernel() : StringKernel<char>()
+{
+	init();
+}
+
+MismatchStringKernel::MismatchStringKernel(
+	int32_t degree, int32_t max_mismatch)
+	: StringKernel<char>()
+{
+	init();
+
+	set_degree(degree);
+	set_max_mismatch(max_mismatch);
+}
+
+MismatchStringKernel::MismatchStringKernel(
+	const std::shared_ptr<StringFeatures<char>>& l,
+	const std::shared_ptr<StringFeatures<char>>& r, int32_t degree,
+	int32_t max_mismatch)
+	: StringKernel<char>()
+{
+	init();
+
+	set_degree(degree);
+	set_max_mismatch(max_mismatch);
+	init(l, r);
+}
+
+MismatchStringKernel::~MismatchStringKernel()
+{
+	cleanup();
+}
+
+void MismatchStringKernel::init()
+{
+	m_degree=3;
+	m_max_mismatch=1;
+
+	SG_ADD(&m_degree, "degree", "Length of the k-mers.",
+		ParameterProperties::HYPER);
+	SG_ADD(&m_max_mismatch, "max_mismatch", "Maximum number of mismatches.",
+		ParameterProperties::HYPER);
+}
+
+void MismatchStringKernel::set_degree(int32_t degree)
+{
+	require(degree>0, "Degree ({}) must be positive", degree);
+	m_degree=degree;
+}
+
+void MismatchStringKernel::set_max_mismatch(int32_t max_mismatch)
+{
+	require(max_mismatch>=0,
+		"Maximum number of mismatches ({}) must not be negative",
+		max_mismatch);
+	m_max_mismatch=max_mismatch;
+}
+
+float64_t MismatchStringKernel::neighbourhood_intersection(
+	int32_t distance, int32_t degree, int32_t max_mismatch,
+	int32_t num_symbols)
+{
+	if (distance>2*max_mismatch || distance>degree)
+		return 0;
+
+	// i of the positions where the k-mers agree are changed, at the
+	// positions where they differ x take the symbol of the first k-mer, y
+	// the symbol of the second and z any other symbol
+	float64_t result=0;
+	for (int32_t i=0; i<=degree-distance && i<=max_mismatch; i++)
+	{
+		const float64_t agree=binomial(degree-distance, i)*
+			std::pow(float64_t(num_symbols-1), i);
+		for (int32_t z=0; z<=distance; z++)
+		{
+			for (int32_t x=0; x<=distance-z; x++)
+			{
+				const int32_t y=distance-z-x;
+				if (i+y+z>max_mismatch || i+x+z>max_mismatch)
+					continue;
+
+				result+=agree*binomial(distance, z)*binomial(distance-z, x)*
+					std::pow(float64_t(std::max(num_symbols-2, 0)), z);
+			}
+		}
+	}
+
+	return result;
+}
+
+bool MismatchStringKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	StringKernel<char>::init(l, r);
+
+	m_mask_size.clear();
+	m_masks.clear();
+	m_index.clear();
+	m_distance_weights.clear();
+
+	auto sf_r=r->as<StringFeatures<char>>();
+	auto alphabet=sf_r->get_alphabet();
+	require(l->as<StringFeatures<char>>()->get_alphabet()->get_alphabet()==
+		alphabet->get_alphabet(), "Alphabets of lhs and rhs differ");
+
+	const int32_t bits=alphabet->get_num_bits();
+	require(m_degree*bits<=64,
+		"k-mers of degree {} with {} bits per symbol do not fit into 64 bits",
+		m_degree, bits);
+
+	// one index for every set of at most 2m masked positions
+	const int32_t max_masked=std::min(2*m_max_mismatch, m_degree);
+	const uint64_t symbol_mask=(uint64_t(1)<<bits)-1;
+	for (int32_t s=0; s<=max_masked; s++)
+	{
+		std::vector<bool> masked(m_degree, false);
+		std::fill(masked.begin(), masked.begin()+s, true);
+		do
+		{
+			uint64_t mask=~uint64_t(0);
+			for (int32_t t=0; t<m_degree; t++)
+			{
+				if (masked[t])
+					mask&=~(symbol_mask<<(t*bits));
+			}
+			m_masks.push_back(mask);
+			m_mask_size.push_back(s);
+		} while (std::prev_permutation(masked.begin(), masked.end()));
+
+		m_distance_weights.push_back(neighbourhood_intersection(
+			s, m_degree, m_max_mismatch, alphabet->get_num_symbols()));
+	}
+
+	const int32_t num_rhs=sf_r->get_num_vectors();
+	std::vector<std::vector<KmerCount>> kmers(num_rhs);
+	#pragma omp parallel for num_threads(env()->get_num_threads()) schedule(dynamic, 16)
+	for (int32_t j=0; j<num_rhs; j++)
+		kmers[j]=string_kmers(sf_r, j);
+
+	size_t num_kmers=0;
+	for (const auto& k : kmers)
+		num_kmers+=k.size();
+
+	const int32_t num_masks=m_masks.size();
+	m_index.resize(num_masks);
+	#pragma omp parallel for num_threads(env()->get_num_threads()) schedule(dynamic, 1)
+	for (int32_t p=0; p<num_masks; p++)
+	{
+		auto& index=m_index[p];
+		index.reserve(num_kmers);
+		for (const auto& k : kmers)
+		{
+			for (const auto& kmer : k)
+				index.push_back({kmer.kmer & m_masks[p], kmer.idx, kmer.count});
+		}
+
+		std::sort(index.begin(), index.end(),
+			[](const KmerCount& a, const KmerCount& b) {
+				return a.kmer<b.kmer || (a.kmer==b.kmer && a.idx<b.idx);
+			});
+
+		// k-mers of a string that only differ at masked positions
+		size_t last=0;
+		for (size_t e=1; e<index.size(); e++)
+		{
+			if (index[e].kmer==index[last].kmer && index[e].idx==index[last].idx)
+				index[last].count+=index[e].count;
+			else
+				index[++last]=index[e];
+		}
+		if (!index.empty())
+			index.resize(last+1);
+		index.shrink_to_fit();
+	}
+
+	return init_normalizer();
+}
+
+void MismatchStringKernel::cleanup()
+{
+	m_mask_size.clear();
+	m_masks.clear();
+	m_index.clear();
+	m_distance_weights.clear();
+
+	Kernel::cleanup();
+}
+
+std::vector<MismatchStringKernel::KmerCount> MismatchStringKernel::string_kmers(
+	const std::shared_ptr<StringFeatures<char>>& sf, int32_t idx) const
+{
+	auto alphabet=sf->get_alphabet();
+	const int32_t bits=alphabet->get_num_bits();
+	const uint64_t kmer_mask=m_degree*bits>=64 ? ~uint64_t(0) :
+		(uint64_t(1)<<(m_degree*bits))-1;
+
+	int32_t len=0;
+	bool free_vec;
+	char* vec=sf->get_feature_vector(idx, len, free_vec);
+
+	std::vector<KmerCount> kmers;
+	kmers.reserve(std::max(len-m_degree+1, 0));
+	uint64_t kmer=0;
+	for (int32_t j=0; j<len; j++)
+	{
+		kmer=((kmer<<bits) | alphabet->remap_to_bin(vec[j])) & kmer_mask;
+		if (j>=m_degree-1)
+			kmers.push_back({kmer, idx, 1});
+	}
+	sf->free_feature_vector(vec, idx, free_vec);
+
+	std::sort(kmers.begin(), kmers.end(),
+		[](const KmerCount& a, const KmerCount& b) { return a.kmer<b.kmer; });
+
+	size_t last=0;
+	for (size_t e=1; e<kmers.size(); e++)
+	{
+		if (kmers[e].kmer==kmers[last].kmer)
+			kmers[last].count++;
+		else
+			kmers[++last]=kmers[e];
+	}
+	if (!kmers.empty())
+		kmers.resize(last+1);
+
+	return kmers;
+}
+
+float64_t MismatchStringKernel::compute(int32_t idx_a, int32_t idx_b)
+{
+	SGVector<index_t> lhs_idx(1);
+	SGVector<index_t> rhs_idx(1);
+	lhs_idx[0]=idx_a;
+	rhs_idx[0]=idx_b;
+	SGMatrix<float64_t> block(1, 1);
+	compute_block(lhs_idx, rhs_idx, block);
+
+	return block(0, 0);
+}
+
+bool MismatchStringKernel::compute_block(
+	const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+	SGMatrix<float64_t>& block)
+{
+	require(!m_index.empty(), "Kernel is not initialized");
+	if (lhs_idx.vlen==0 || rhs_idx.vlen==0)
+		return true;
+
+	// the strings of the block are looked up as one range of the index
+	const index_t first=*std::min_element(rhs_idx.begin(), rhs_idx.end());
+	const index_t last=*std::max_element(rhs_idx.begin(), rhs_idx.end());
+	const index_t range=last-first+1;
+
+	const int32_t max_masked=m_mask_size.back();
+	std::vector<int64_t> matches((max_masked+1)*int64_t(range));
+	std::vector<int64_t> pairs(max_masked+1);
+	std::vector<float64_t> row(range);
+
+	auto sf_l=lhs->as<StringFeatures<char>>();
+	for (index_t i=0; i<lhs_idx.vlen; i++)
+	{
+		std::fill(matches.begin(), matches.end(), 0);
+		const auto kmers=string_kmers(sf_l, lhs_idx[i]);
+
+		for (size_t p=0; p<m_masks.size(); p++)
+		{
+			const auto& index=m_index[p];
+			int64_t* masked_matches=&matches[m_mask_size[p]*int64_t(range)];
+			for (const auto& a : kmers)
+			{
+				const KmerCount key={a.kmer & m_masks[p], first, 0};
+				auto it=std::lower_bound(index.begin(), index.end(), key,
+					[](const KmerCount& e, const KmerCount& k) {
+						return e.kmer<k.kmer || (e.kmer==k.kmer && e.idx<k.idx);
+					});
+				for (; it!=index.end() && it->kmer==key.kmer && it->idx<=last; ++it)
+					masked_matches[it->idx-first]+=int64_t(a.count)*it->count;
+			}
+		}
+
+		// a pair of k-mers at distance d agrees outside of
+		// binomial(k-d, s-d) sets of s masked positions
+		for (index_t j=0; j<range; j++)
+		{
+			float64_t value=0;
+			for (int32_t s=0; s<=max_masked; s++)
+			{
+				pairs[s]=matches[s*int64_t(range)+j];
+				for (int32_t d=0; d<s; d++)
+					pairs[s]-=binomial(m_degree-d, s-d)*pairs[d];
+				value+=m_distance_weights[s]*pairs[s];
+			}
+			row[j]=value;
+		}
+
+		for (index_t c=0; c<rhs_idx.vlen; c++)
+			block(i, c)=row[rhs_idx[c]-first];
+	}
+
+	return true;
+}
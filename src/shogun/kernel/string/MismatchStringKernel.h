@@ -0,0 +1,174 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _MISMATCHSTRINGKERNEL_H___
+#define _MISMATCHSTRINGKERNEL_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/StringKernel.h>
+#include <shogun/lib/common.h>
+
+#include <vector>
+
+namespace shogun
+{
+/** @brief (k,m)-mismatch string kernel, the spectrum kernel for m=0.
+ *
+ * Every k-mer \f$a\f$ of a string contributes to the features
+ * \f$\beta\in\Sigma^k\f$ of its mismatch neighbourhood \f$N_m(a)\f$, all
+ * k-mers with at most m mismatches to \f$a\f$, and
+ * \f[
+ * k({\bf x},{\bf x'})=\sum_{a\in{\bf x}}\sum_{b\in{\bf x'}}
+ * |N_m(a)\cap N_m(b)|,
+ * \f]
+ * where the size of the intersection only depends on the Hamming distance
+ * \f$d(a,b)\le 2m\f$. No preprocessing of the strings is required.
+ *
+ * Instead of enumerating the neighbourhoods, init() builds a sorted index
+ * of the k-mers of all rhs strings (a suffix array cut at depth k) for
+ * every set of at most 2m masked positions. Looking up a lhs k-mer with s
+ * masked positions finds all rhs k-mers that agree outside of them, and the
+ * number of pairs at every distance follows from the lookups of all mask
+ * sizes. compute_block() therefore computes kernel rows against a range of
+ * rhs strings in time linear in the number of k-mers and matches, and
+ * get_kernel_matrix() runs it in parallel over the blocks of lhs strings.
+ *
+ * The index needs \f$16\sum_{s\le 2m}{k\choose s}\f$ bytes per distinct
+ * k-mer of every rhs string, the k-mers are packed with
+ * Alphabet::get_num_bits() bits per symbol into 64 bits.
+ */
+class MismatchStringKernel: public StringKernel<char>
+{
+public:
+	/** default constructor */
+	MismatchStringKernel();
+
+	/** constructor
+	 *
+	 * @param degree length k of the k-mers
+	 * @param max_mismatch maximum number of mismatches m
+	 */
+	MismatchStringKernel(int32_t degree, int32_t max_mismatch);
+
+	/** constructor
+	 *
+	 * @param l features of left-hand side
+	 * @param r features of right-hand side
+	 * @param degree length k of the k-mers
+	 * @param max_mismatch maximum number of mismatches m
+	 */
+	MismatchStringKernel(
+		const std::shared_ptr<StringFeatures<char>>& l,
+		const std::shared_ptr<StringFeatures<char>>& r, int32_t degree,
+		int32_t max_mismatch);
+
+	~MismatchStringKernel() override;
+
+	/** initialize kernel and build the k-mer index of the rhs strings
+	 *
+	 * @param l features of left-hand side
+	 * @param r features of right-hand side
+	 * @return if initializing was successful
+	 */
+	bool init(std::shared_ptr<Features> l, std::shared_ptr<Features> r) override;
+
+	/** clean up kernel */
+	void cleanup() override;
+
+	/** @return length k of the k-mers */
+	int32_t get_degree() const
+	{
+		return m_degree;
+	}
+
+	/** @param degree length k of the k-mers, used by the next init() */
+	void set_degree(int32_t degree);
+
+	/** @return maximum number of mismatches */
+	int32_t get_max_mismatch() const
+	{
+		return m_max_mismatch;
+	}
+
+	/** @param max_mismatch maximum number of mismatches, used by the next
+	 * init() */
+	void set_max_mismatch(int32_t max_mismatch);
+
+	/** @return kernel type MISMATCHSTRING */
+	EKernelType get_kernel_type() override
+	{
+		return K_MISMATCHSTRING;
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "MismatchStringKernel";
+	}
+
+	/** @return size of the intersection of the mismatch neighbourhoods of
+	 * two k-mers at the given Hamming distance
+	 *
+	 * @param distance Hamming distance of the k-mers
+	 * @param degree length of the k-mers
+	 * @param max_mismatch maximum number of mismatches
+	 * @param num_symbols size of the alphabet
+	 */
+	static float64_t neighbourhood_intersection(
+		int32_t distance, int32_t degree, int32_t max_mismatch,
+		int32_t num_symbols);
+
+protected:
+	float64_t compute(int32_t idx_a, int32_t idx_b) override;
+
+	/** compute the block of kernel values from the rhs k-mer index, see
+	 * Kernel::compute_block() */
+	bool compute_block(
+		const SGVector<index_t>& lhs_idx, const SGVector<index_t>& rhs_idx,
+		SGMatrix<float64_t>& block) override;
+
+private:
+	void init();
+
+	/** k-mer of a string with the number of occurrences */
+	struct KmerCount
+	{
+		/** packed k-mer, masked for the index */
+		uint64_t kmer;
+		/** index of the string */
+		int32_t idx;
+		/** number of occurrences in the string */
+		int32_t count;
+	};
+
+	/** @return distinct k-mers of a string, sorted */
+	std::vector<KmerCount> string_kmers(
+		const std::shared_ptr<StringFeatures<char>>& sf, int32_t idx) const;
+
+protected:
+	/** length of the k-mers */
+	int32_t m_degree;
+
+	/** maximum number of mismatches */
+	int32_t m_max_mismatch;
+
+	/** number of masked positions of every index */
+	std::vector<int32_t> m_mask_size;
+
+	/** bits kept by every index, the masked positions are cleared */
+	std::vector<uint64_t> m_masks;
+
+	/** k-mers of the rhs strings for every mask, sorted by masked k-mer
+	 * and string */
+	std::vector<std::vector<KmerCount>> m_index;
+
+	/** neighbourhood intersection at every Hamming distance */
+	std::vector<float64_t> m_distance_weights;
+};
+}
+#endif /* _MISMATCHSTRINGKERNEL_H___ */
@@ -17,7 +17,10 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 
+#include <algorithm>
+#include <bitset>
 #include <thread>
+#include <vector>
 
 using namespace shogun;
 
@@ -160,6 +163,16 @@ bool WeightedDegreeStringKernel::init(std::shared_ptr<Features> l, std::shared_p
 
 	init_block_weights();
 
+	m_lhs_packed=SGVector<uint64_t>();
+	m_rhs_packed=SGVector<uint64_t>();
+	m_packed_words=0;
+	if (alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
+	{
+		m_packed_words=(seq_length+31)/32;
+		m_lhs_packed=pack_strings(sf_l);
+		m_rhs_packed=(sf_l==sf_r) ? m_lhs_packed : pack_strings(sf_r);
+	}
+
 	return init_normalizer();
 }
 
@@ -168,6 +181,10 @@ void WeightedDegreeStringKernel::cleanup()
 	SG_DEBUG("deleting WeightedDegreeStringKernel optimization")
 	delete_optimization();
 
+	m_lhs_packed=SGVector<uint64_t>();
+	m_rhs_packed=SGVector<uint64_t>();
+	m_packed_words=0;
+
 	Kernel::cleanup();
 }
 
@@ -181,6 +198,13 @@ bool WeightedDegreeStringKernel::init_optimization(int32_t count, int32_t* IDX,
 	if (tree_num<0)
 		SG_DEBUG("initializing WeightedDegreeStringKernel optimization")
 
+	if (tree_num<0 && max_mismatch==0)
+	{
+		add_examples_to_tree(count, IDX, alphas);
+		set_is_initialized(true);
+		return true;
+	}
+
 	for (auto i : SG_PROGRESS(range(count)))
 	{
 		if (tree_num<0)
@@ -323,8 +347,151 @@ float64_t WeightedDegreeStringKernel::compute_without_mismatch_matrix(
 }
 
 
+SGVector<uint64_t> WeightedDegreeStringKernel::pack_strings(
+	const std::shared_ptr<StringFeatures<char>>& sf)
+{
+	const int32_t num_vectors=sf->get_num_vectors();
+	const auto& alphabet=sf->get_alphabet();
+
+	SGVector<uint64_t> packed(int64_t(num_vectors)*m_packed_words);
+	packed.zero();
+
+#pragma omp parallel for
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int32_t len;
+		bool free_vec;
+		char* vec=sf->get_feature_vector(i, len, free_vec);
+		uint64_t* words=packed.vector+int64_t(i)*m_packed_words;
+
+		for (int32_t j=0; j<len; j++)
+		{
+			const uint64_t symbol=alphabet->remap_to_bin(vec[j]) & 3;
+			words[j/32]|=symbol<<(2*(j%32));
+		}
+		sf->free_feature_vector(vec, i, free_vec);
+	}
+
+	return packed;
+}
+
+bool WeightedDegreeStringKernel::use_packed_computation() const
+{
+	if (!m_packed_words || max_mismatch!=0)
+		return false;
+
+	if (length==0 && block_computation)
+		return true;
+
+	return length==0 && !position_weights.vector;
+}
+
+/** number of trailing zero bits of a non-zero word */
+static inline int32_t count_trailing_zeros(uint64_t x)
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll(x);
+#else
+	int32_t n=0;
+	while (!(x & 1))
+	{
+		x>>=1;
+		n++;
+	}
+	return n;
+#endif
+}
+
+float64_t WeightedDegreeStringKernel::compute_packed(int32_t idx_a, int32_t idx_b)
+{
+	// the lower bit of each two bit lane
+	const uint64_t lane_bits=0x5555555555555555ULL;
+
+	const uint64_t* avec=m_lhs_packed.vector+int64_t(idx_a)*m_packed_words;
+	const uint64_t* bvec=m_rhs_packed.vector+int64_t(idx_b)*m_packed_words;
+
+	// one bit per matching position, the unused lanes of the last word are
+	// cleared
+	uint64_t stack_buffer[16];
+	std::vector<uint64_t> heap_buffer;
+	uint64_t* match=stack_buffer;
+	if (m_packed_words>16)
+	{
+		heap_buffer.resize(m_packed_words);
+		match=heap_buffer.data();
+	}
+
+	for (int32_t w=0; w<m_packed_words; w++)
+	{
+		const uint64_t diff=avec[w]^bvec[w];
+		match[w]=~(diff | (diff>>1)) & lane_bits;
+	}
+	const int32_t tail_lanes=seq_length-32*(m_packed_words-1);
+	if (tail_lanes<32)
+		match[m_packed_words-1]&=(uint64_t(1)<<(2*tail_lanes))-1;
+
+	float64_t sum=0;
+	if (block_computation)
+	{
+		// add the block weight of each run of matches
+		int32_t run=0;
+		for (int32_t w=0; w<m_packed_words; w++)
+		{
+			const int32_t lanes=(w==m_packed_words-1) ? tail_lanes : 32;
+			int32_t lane=0;
+			while (lane<lanes)
+			{
+				const uint64_t mismatches=~(match[w]>>(2*lane)) & lane_bits;
+				const int32_t matches=std::min(
+					mismatches ? count_trailing_zeros(mismatches)/2 : 32-lane,
+					lanes-lane);
+				run+=matches;
+				lane+=matches;
+				if (lane>=lanes)
+					break;
+
+				if (run>0)
+					sum+=block_weights[run-1];
+				run=0;
+
+				// skip to the next match
+				lane++;
+				const uint64_t next=lane<32 ? match[w]>>(2*lane) : 0;
+				lane=next ? lane+count_trailing_zeros(next)/2 : lanes;
+			}
+		}
+		if (run>0)
+			sum+=block_weights[run-1];
+	}
+	else
+	{
+		// match[i] of round j is set if positions i..i+j all match
+		for (int32_t j=0; j<degree; j++)
+		{
+			int64_t num_matches=0;
+			for (int32_t w=0; w<m_packed_words; w++)
+				num_matches+=std::bitset<64>(match[w]).count();
+			if (!num_matches)
+				break;
+
+			sum+=weights[j]*num_matches;
+
+			for (int32_t w=0; w<m_packed_words; w++)
+			{
+				const uint64_t next=w+1<m_packed_words ? match[w+1]<<62 : 0;
+				match[w]&=(match[w]>>2) | next;
+			}
+		}
+	}
+
+	return sum;
+}
+
 float64_t WeightedDegreeStringKernel::compute(int32_t idx_a, int32_t idx_b)
 {
+	if (use_packed_computation())
+		return compute_packed(idx_a, idx_b);
+
 	int32_t alen, blen;
 	bool free_avec, free_bvec;
 	char* avec=lhs->as<StringFeatures<char>>()->get_feature_vector(idx_a, alen, free_avec);
@@ -394,6 +561,38 @@ void WeightedDegreeStringKernel::add_example_to_tree(
 	tree_initialized=true ;
 }
 
+void WeightedDegreeStringKernel::add_examples_to_tree(
+	int32_t count, int32_t* IDX, float64_t* alphas)
+{
+	const auto& alphabet = std::static_pointer_cast<StringFeatures<char>>(lhs)->get_alphabet();
+	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
+	ASSERT(tries)
+
+	std::vector<SGVector<int32_t>> vecs;
+	std::vector<float64_t> normalized_alphas;
+	vecs.reserve(count);
+	normalized_alphas.reserve(count);
+	for (int32_t i=0; i<count; i++)
+	{
+		if (alphas[i]==0.0)
+			continue;
+
+		int32_t len=0;
+		bool free_vec;
+		char* char_vec=lhs->as<StringFeatures<char>>()->get_feature_vector(IDX[i], len, free_vec);
+		SGVector<int32_t> vec(len);
+		for (int32_t j=0; j<len; j++)
+			vec[j]=alphabet->remap_to_bin(char_vec[j]);
+		lhs->as<StringFeatures<char>>()->free_feature_vector(char_vec, IDX[i], free_vec);
+
+		vecs.push_back(vec);
+		normalized_alphas.push_back(normalizer->normalize_lhs(alphas[i], IDX[i]));
+	}
+
+	tries->add_examples_to_trie(vecs, normalized_alphas, weights.matrix, (length!=0));
+	tree_initialized=true;
+}
+
 void WeightedDegreeStringKernel::add_example_to_single_tree(
 	int32_t idx, float64_t alpha, int32_t tree_num)
 {
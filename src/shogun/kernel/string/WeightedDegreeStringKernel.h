@@ -582,6 +582,15 @@ class WeightedDegreeStringKernel: public StringKernel<char>
 		 */
 		void add_example_to_tree(int32_t idx, float64_t weight);
 
+		/** add examples to the trees of all positions, the trees are built
+		 * in parallel over the positions
+		 *
+		 * @param count number of examples
+		 * @param IDX indices of the examples
+		 * @param alphas weights of the examples
+		 */
+		void add_examples_to_tree(int32_t count, int32_t* IDX, float64_t* alphas);
+
 		/** add example to single tree
 		 *
 		 * @param idx index
@@ -668,6 +677,34 @@ class WeightedDegreeStringKernel: public StringKernel<char>
 		float64_t compute_using_block(char* avec, int32_t alen,
 			char* bvec, int32_t blen);
 
+		/** pack strings over a DNA or RNA alphabet into two bits per
+		 * symbol, 32 symbols per word
+		 *
+		 * @param sf string features of the same length seq_length
+		 * @return packed strings, m_packed_words words per string
+		 */
+		SGVector<uint64_t> pack_strings(
+			const std::shared_ptr<StringFeatures<char>>& sf);
+
+		/** whether compute() can use the packed strings, i.e. they are
+		 * available and no mismatches or position dependent weights are
+		 * used
+		 */
+		bool use_packed_computation() const;
+
+		/** compute kernel on the packed two bit representation
+		 *
+		 * All positions are compared 32 at a time by xor-ing the packed
+		 * words. Block weights are then looked up for every run of
+		 * matches, otherwise k-mer matches of all orders are counted with
+		 * popcount on successively and-ed match masks.
+		 *
+		 * @param idx_a index a
+		 * @param idx_b index b
+		 * @return computed value
+		 */
+		float64_t compute_packed(int32_t idx_a, int32_t idx_b);
+
 		/** remove lhs from kernel */
 		void remove_lhs() override;
 
@@ -718,6 +755,13 @@ class WeightedDegreeStringKernel: public StringKernel<char>
 
 		/** if tree is initialized */
 		bool tree_initialized = false;
+
+		/** lhs strings packed to two bits per symbol, see pack_strings() */
+		SGVector<uint64_t> m_lhs_packed;
+		/** rhs strings packed to two bits per symbol, see pack_strings() */
+		SGVector<uint64_t> m_rhs_packed;
+		/** number of words per packed string */
+		int32_t m_packed_words = 0;
 };
 
 }
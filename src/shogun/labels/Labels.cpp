@@ -53,6 +53,11 @@ void Labels::add_subset(SGVector<index_t> subset)
 	m_subset_stack->add_subset(subset);
 }
 
+void Labels::add_subset_range(index_t start, index_t size)
+{
+	m_subset_stack->add_subset_range(start, size);
+}
+
 void Labels::add_subset_in_place(SGVector<index_t> subset)
 {
 	m_subset_stack->add_subset_in_place(subset);
@@ -88,6 +88,15 @@ namespace shogun
 		 * */
 		virtual void add_subset(SGVector<index_t> subset);
 
+		/** Adds the range of indices start, ..., start+size-1 on top of
+		 * the current subsets without storing indices, see
+		 * SubsetStack::add_subset_range()
+		 *
+		 * @param start first index of the range
+		 * @param size number of indices
+		 */
+		virtual void add_subset_range(index_t start, index_t size);
+
 		/** Sets/changes latest added subset. This allows to add multiple
 		 * subsets
 		 * with in-place memory requirements. They cannot be removed one-by-one
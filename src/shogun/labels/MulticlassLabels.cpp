@@ -2,7 +2,12 @@
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/labels/DenseLabels.h>
 #include <shogun/labels/MulticlassLabels.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -41,6 +46,11 @@ MulticlassLabels::MulticlassLabels(const MulticlassLabels& orig)
 {
 	init();
 	m_multiclass_confidences = orig.m_multiclass_confidences;
+	m_confidence_storage = orig.m_confidence_storage;
+	m_top_k = orig.m_top_k;
+	m_num_confidence_classes = orig.m_num_confidence_classes;
+	m_compact_confidences = orig.m_compact_confidences;
+	m_top_k_classes = orig.m_top_k_classes;
 }
 
 MulticlassLabels::~MulticlassLabels()
@@ -50,24 +60,99 @@ MulticlassLabels::~MulticlassLabels()
 void MulticlassLabels::init()
 {
 	m_multiclass_confidences=SGMatrix<float64_t>();
+	m_confidence_storage=CONFIDENCES_FLOAT64;
+	m_top_k=0;
+	m_num_confidence_classes=0;
 	watch_method("num_classes", &MulticlassLabels::get_num_classes);
 }
 
+void MulticlassLabels::set_confidence_storage(
+		EConfidenceStorage storage, int32_t top_k)
+{
+	require(storage!=CONFIDENCES_TOP_K || top_k>0,
+			"{}::set_confidence_storage(): Number of classes to keep ({}) "
+			"must be positive", get_name(), top_k);
+
+	m_confidence_storage=storage;
+	m_top_k=storage==CONFIDENCES_TOP_K ? top_k : 0;
+}
+
+bool MulticlassLabels::has_confidences() const
+{
+	return m_num_confidence_classes!=0;
+}
+
 void MulticlassLabels::set_multiclass_confidences(int32_t i,
 		SGVector<float64_t> confidences)
 {
-	require(confidences.size()==m_multiclass_confidences.num_rows,
+	require(confidences.size()==m_num_confidence_classes,
 			"{}::set_multiclass_confidences(): Length of confidences should "
 			"match size of the matrix", get_name());
 
-	m_multiclass_confidences.set_column(i, confidences);
+	switch (m_confidence_storage)
+	{
+	case CONFIDENCES_FLOAT64:
+		m_multiclass_confidences.set_column(i, confidences);
+		break;
+	case CONFIDENCES_FLOAT32:
+		for (index_t j=0; j<confidences.size(); j++)
+			m_compact_confidences(j,i) = confidences[j];
+		break;
+	case CONFIDENCES_TOP_K:
+	{
+		// most confident first, ties to the lower class
+		int32_t k = m_compact_confidences.num_rows;
+		std::vector<int32_t> classes(confidences.size());
+		std::iota(classes.begin(), classes.end(), 0);
+		std::partial_sort(classes.begin(), classes.begin()+k, classes.end(),
+			[&confidences](int32_t a, int32_t b)
+			{
+				return confidences[a]>confidences[b] ||
+					(confidences[a]==confidences[b] && a<b);
+			});
+		for (index_t j=0; j<k; j++)
+		{
+			m_top_k_classes(j,i) = classes[j];
+			m_compact_confidences(j,i) = confidences[classes[j]];
+		}
+		break;
+	}
+	}
+}
+
+float64_t MulticlassLabels::get_confidence(int32_t c, int32_t i) const
+{
+	switch (m_confidence_storage)
+	{
+	case CONFIDENCES_FLOAT64:
+		return m_multiclass_confidences(c,i);
+	case CONFIDENCES_FLOAT32:
+		return m_compact_confidences(c,i);
+	case CONFIDENCES_TOP_K:
+		for (index_t j=0; j<m_top_k_classes.num_rows; j++)
+		{
+			if (m_top_k_classes(j,i)==c)
+				return m_compact_confidences(j,i);
+		}
+		break;
+	}
+	return -std::numeric_limits<float64_t>::infinity();
 }
 
 SGVector<float64_t> MulticlassLabels::get_multiclass_confidences(int32_t i)
 {
-	SGVector<float64_t> confs(m_multiclass_confidences.num_rows);
-	for (index_t j=0; j<confs.size(); j++)
-		confs[j] = m_multiclass_confidences(j,i);
+	SGVector<float64_t> confs(m_num_confidence_classes);
+	if (m_confidence_storage==CONFIDENCES_TOP_K)
+	{
+		confs.set_const(-std::numeric_limits<float64_t>::infinity());
+		for (index_t j=0; j<m_top_k_classes.num_rows; j++)
+			confs[m_top_k_classes(j,i)] = m_compact_confidences(j,i);
+	}
+	else
+	{
+		for (index_t j=0; j<confs.size(); j++)
+			confs[j] = get_confidence(j,i);
+	}
 
 	return confs;
 }
@@ -78,19 +163,59 @@ void MulticlassLabels::allocate_confidences_for(int32_t n_classes)
 	require(n_labels!=0,"{}::allocate_confidences_for(): There should be "
 			"labels to store confidences", get_name());
 
-	m_multiclass_confidences = SGMatrix<float64_t>(n_classes,n_labels);
+	m_num_confidence_classes = n_classes;
+	m_multiclass_confidences = SGMatrix<float64_t>();
+	m_compact_confidences = SGMatrix<float32_t>();
+	m_top_k_classes = SGMatrix<int32_t>();
+	switch (m_confidence_storage)
+	{
+	case CONFIDENCES_FLOAT64:
+		m_multiclass_confidences = SGMatrix<float64_t>(n_classes,n_labels);
+		break;
+	case CONFIDENCES_FLOAT32:
+		m_compact_confidences = SGMatrix<float32_t>(n_classes,n_labels);
+		break;
+	case CONFIDENCES_TOP_K:
+	{
+		int32_t k = std::min(m_top_k, n_classes);
+		m_compact_confidences = SGMatrix<float32_t>(k,n_labels);
+		m_top_k_classes = SGMatrix<int32_t>(k,n_labels);
+		break;
+	}
+	}
 }
 
 SGVector<float64_t> MulticlassLabels::get_confidences_for_class(int32_t i)
 {
 	require(
-	    (m_multiclass_confidences.num_rows != 0) &&
-	        (m_multiclass_confidences.num_cols != 0),
+	    has_confidences() && m_labels.size() != 0,
 	    "Empty confidences, which need to be allocated before fetching.");
 
-	SGVector<float64_t> confs(m_multiclass_confidences.num_cols);
+	SGVector<float64_t> confs(m_labels.size());
 	for (index_t j = 0; j < confs.size(); j++)
-		confs[j] = m_multiclass_confidences(i, j);
+		confs[j] = get_confidence(i, j);
+
+	return confs;
+}
+
+SGVector<int32_t> MulticlassLabels::get_top_k_classes(int32_t i) const
+{
+	require(m_confidence_storage==CONFIDENCES_TOP_K,
+			"{}::get_top_k_classes(): Confidences are not stored for the "
+			"top k classes", get_name());
+
+	return m_top_k_classes.get_column(i).clone();
+}
+
+SGVector<float64_t> MulticlassLabels::get_top_k_confidences(int32_t i) const
+{
+	require(m_confidence_storage==CONFIDENCES_TOP_K,
+			"{}::get_top_k_confidences(): Confidences are not stored for the "
+			"top k classes", get_name());
+
+	SGVector<float64_t> confs(m_compact_confidences.num_rows);
+	for (index_t j=0; j<confs.size(); j++)
+		confs[j] = m_compact_confidences(j,i);
 
 	return confs;
 }
@@ -129,17 +254,12 @@ std::shared_ptr<BinaryLabels> MulticlassLabels::get_binary_for_class(int32_t i)
 {
 	SGVector<float64_t> binary_labels(get_num_labels());
 
-	bool use_confidences = false;
-	if ((m_multiclass_confidences.num_rows != 0) && (m_multiclass_confidences.num_cols != 0))
-	{
-		use_confidences = true;
-	}
-	if (use_confidences)
+	if (has_confidences())
 	{
 		for (int32_t k=0; k<binary_labels.vlen; k++)
 		{
 			int32_t label = get_int_label(k);
-			float64_t confidence = m_multiclass_confidences(label,k);
+			float64_t confidence = get_confidence(label,k);
 			binary_labels[k] = label == i ? confidence : -confidence;
 		}
 	}
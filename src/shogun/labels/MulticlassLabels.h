@@ -26,9 +26,25 @@ namespace shogun
 	class MulticlassLabels;
 	class DenseLabels;
 
+/** storage of the confidences of multiclass labels */
+enum EConfidenceStorage
+{
+	/// float64 confidences of all classes
+	CONFIDENCES_FLOAT64 = 0,
+	/// float32 confidences of all classes
+	CONFIDENCES_FLOAT32 = 1,
+	/// float32 confidences of the k most confident classes
+	CONFIDENCES_TOP_K = 2
+};
+
 /** @brief Multiclass Labels for multi-class classification
  *
  * valid values for labels are 0...nr_classes-1
+ *
+ * The confidences are stored for all classes in float64 by default. With
+ * many classes they can be stored in float32, or only for the k most
+ * confident classes of every label (see set_confidence_storage()). The
+ * confidences of the other classes are then returned as -infinity.
  */
 class MulticlassLabels : public DenseLabels
 {
@@ -140,6 +156,40 @@ class MulticlassLabels : public DenseLabels
 		*/
 		SGVector<float64_t> get_confidences_for_class(int32_t i);
 
+		/** sets how confidences are stored, takes effect with the next
+		 * call of @ref allocate_confidences_for
+		 *
+		 * @param storage storage of the confidences
+		 * @param top_k number of classes whose confidences are kept with
+		 * CONFIDENCES_TOP_K
+		 */
+		void set_confidence_storage(EConfidenceStorage storage, int32_t top_k=0);
+
+		/** @return storage of the confidences */
+		EConfidenceStorage get_confidence_storage() const
+		{
+			return m_confidence_storage;
+		}
+
+		/** @return whether confidences are allocated */
+		bool has_confidences() const;
+
+		/** returns the most confident classes of a result, requires
+		 * CONFIDENCES_TOP_K storage
+		 *
+		 * @param i index
+		 * @return classes of ith result by decreasing confidence
+		 */
+		SGVector<int32_t> get_top_k_classes(int32_t i) const;
+
+		/** returns the confidences of the most confident classes of a
+		 * result, requires CONFIDENCES_TOP_K storage
+		 *
+		 * @param i index
+		 * @return confidences in the order of @ref get_top_k_classes
+		 */
+		SGVector<float64_t> get_top_k_confidences(int32_t i) const;
+
 		/** @return object name */
 		const char* get_name() const override { return "MulticlassLabels"; }
 #ifndef SWIG // SWIG should skip this part
@@ -156,10 +206,28 @@ class MulticlassLabels : public DenseLabels
 		/** initialises and register parameters */
 		void init();
 
+		/** confidence of a class for the ith result, whatever the storage */
+		float64_t get_confidence(int32_t c, int32_t i) const;
+
 	protected:
 
 		/** multiclass confidences */
 		SGMatrix<float64_t> m_multiclass_confidences;
+
+		/** storage of the confidences */
+		EConfidenceStorage m_confidence_storage;
+
+		/** number of classes kept with CONFIDENCES_TOP_K */
+		int32_t m_top_k;
+
+		/** number of classes of the confidences */
+		int32_t m_num_confidence_classes;
+
+		/** float32 confidences, of all classes or of the top k classes */
+		SGMatrix<float32_t> m_compact_confidences;
+
+		/** classes of the top k confidences */
+		SGMatrix<int32_t> m_top_k_classes;
 };
 
 #ifndef SWIG
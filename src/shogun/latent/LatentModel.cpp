@@ -71,15 +71,35 @@ void LatentModel::argmax_h(const SGVector<float64_t>& w)
 	ASSERT(num == m_labels->get_num_labels())
 
 	// argmax_h only for positive examples
+	std::vector<index_t> positives;
 	for (int32_t i = 0; i < num; ++i)
 	{
 		if (y->get_label(i) == 1)
-		{
-			// infer h and set it for the argmax_h <w,psi(x,h)>
-			auto latent_data = infer_latent_variable(w, i);
-			m_labels->set_latent_label(i, latent_data);
-		}
+			positives.push_back(i);
 	}
+
+	// infer h and set it for the argmax_h <w,psi(x,h)>
+	auto latent_data = infer_latent_variables(w, positives);
+	for (size_t k = 0; k < positives.size(); ++k)
+		m_labels->set_latent_label(positives[k], std::move(latent_data[k]));
+}
+
+std::vector<std::shared_ptr<Data>> LatentModel::infer_latent_variables(
+	const SGVector<float64_t>& w, const std::vector<index_t>& idx)
+{
+	const int64_t num = idx.size();
+	std::vector<std::shared_ptr<Data>> latent_data(num);
+
+	#pragma omp parallel for schedule(dynamic) if (m_parallel_inference)
+	for (int64_t k = 0; k < num; ++k)
+		latent_data[k] = infer_latent_variable(w, idx[k]);
+
+	return latent_data;
+}
+
+void LatentModel::get_psi_feature_vector(index_t idx, SGVector<float64_t> psi)
+{
+	not_implemented(SOURCE_LOCATION);
 }
 
 void LatentModel::register_parameters()
@@ -91,6 +111,9 @@ void LatentModel::register_parameters()
 	SG_ADD(
 	    &m_do_caching, "do_caching",
 	    "Indicate whether or not do PSI vector caching after argmax_h");
+	SG_ADD(
+	    &m_parallel_inference, "parallel_inference",
+	    "Whether latent variables are inferred in parallel");
 }
 
 
@@ -104,10 +127,25 @@ void LatentModel::cache_psi_features()
 {
 	if (m_do_caching)
 	{
-		if (m_cached_psi)
-
-		m_cached_psi = this->get_psi_feature_vectors();
-
+		auto cached = std::dynamic_pointer_cast<DenseFeatures<float64_t>>(m_cached_psi);
+		const int32_t dim = get_dim();
+		const int32_t num = get_num_vectors();
+		if (supports_psi_feature_vector() && cached &&
+			cached->get_num_features() == dim &&
+			cached->get_num_vectors() == num)
+		{
+			// overwrite the PSI vectors of the cached features in place
+			auto psi = cached->get_feature_matrix();
+
+			#pragma omp parallel for schedule(dynamic) if (m_parallel_inference)
+			for (int32_t i = 0; i < num; ++i)
+			{
+				get_psi_feature_vector(
+					i, SGVector<float64_t>(psi.get_column_vector(i), dim, false));
+			}
+		}
+		else
+			m_cached_psi = this->get_psi_feature_vectors();
 	}
 }
 
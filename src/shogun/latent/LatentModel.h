@@ -95,6 +95,35 @@ namespace shogun
 			 */
 			virtual std::shared_ptr<Data> infer_latent_variable(const SGVector<float64_t>& w, index_t idx)=0;
 
+			/** Infers \f$h^{*}\f$ for several examples with infer_latent_variable.
+			 * The examples are processed in parallel if parallel inference is
+			 * enabled, see set_parallel_inference.
+			 *
+			 * @param w weight vector
+			 * @param idx indices of the examples
+			 * @return \f$h^{*}\f$ of the examples, in the order of idx
+			 */
+			std::vector<std::shared_ptr<Data>> infer_latent_variables(
+				const SGVector<float64_t>& w, const std::vector<index_t>& idx);
+
+			/** whether get_psi_feature_vector is implemented, which lets
+			 * cache_psi_features update the cached PSI vectors in place
+			 *
+			 * @return false by default
+			 */
+			virtual bool supports_psi_feature_vector() const
+			{
+				return false;
+			}
+
+			/** Calculate the PSI vector \f$\Psi(\bold{x_i},\bold{h_i})\f$ of a
+			 * single example with its current latent label.
+			 *
+			 * @param idx index of the example
+			 * @param psi vector of length get_dim() to write the PSI vector to
+			 */
+			virtual void get_psi_feature_vector(index_t idx, SGVector<float64_t> psi);
+
 			/** Calculates \f$argmax_{h} \langle \bold{w},\Psi(\bold{x},\bold{h}) \rangle\f$
 			 * The default implementaiton calculates the argmax_h only on the positive examples.
 			 *
@@ -131,6 +160,27 @@ namespace shogun
 				m_do_caching = caching;
 			}
 
+			/** enable parallel inference of the latent variables (and of the
+			 * PSI vectors of single examples). Only enable it if
+			 * infer_latent_variable and get_psi_feature_vector can be called
+			 * concurrently for different examples.
+			 *
+			 * @param parallel whether to infer in parallel
+			 */
+			inline void set_parallel_inference(bool parallel)
+			{
+				m_parallel_inference = parallel;
+			}
+
+			/** get parallel inference
+			 *
+			 * @return whether latent variables are inferred in parallel
+			 */
+			inline bool get_parallel_inference() const
+			{
+				return m_parallel_inference;
+			}
+
 			/** Returns the name of the SGSerializable instance.
 			 *
 			 * @return name of the SGSerializable
@@ -146,6 +196,8 @@ namespace shogun
 			bool m_do_caching;
 			/** cached PSI feature vectors after argmax_h */
 			std::shared_ptr<DotFeatures> m_cached_psi;
+			/** whether latent variables are inferred in parallel */
+			bool m_parallel_inference = false;
 
 		private:
 			/** register the parameters */
@@ -5,8 +5,10 @@
  */
 
 #include <shogun/latent/LatentSVM.h>
+#include <numeric>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include <shogun/classifier/svm/SVMOcas.h>
 #include <shogun/latent/LatentModel.h>
@@ -42,12 +44,11 @@ std::shared_ptr<LatentLabels> LatentSVM::apply_latent()
 	hs->set_labels(ys);
 	m_model->set_labels(hs);
 
-	for (index_t i = 0; i < num_examples; ++i)
-	{
-		/* find h for the example */
-		auto h = m_model->infer_latent_variable(w, i);
+	/* find h for the examples */
+	std::vector<index_t> idx(num_examples);
+	std::iota(idx.begin(), idx.end(), 0);
+	for (auto& h : m_model->infer_latent_variables(w, idx))
 		hs->add_latent_label(h);
-	}
 
 	/* compute the y labels */
 	auto x = m_model->get_psi_feature_vectors();
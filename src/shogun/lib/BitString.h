@@ -58,7 +58,7 @@ class BitString : public SGObject
 
 			single_mask=0;
 			for (int32_t j=0; j<nbits; j++)
-				mask=(mask<<1) | (uint64_t) 1;
+				single_mask=(single_mask<<1) | (uint64_t) 1;
 		}
 
 		/** destructor */
@@ -83,28 +83,30 @@ class BitString : public SGObject
 		void obtain_from_char(char* str, uint64_t len)
 		{
 			cleanup();
-			uint64_t stream_len=len/sizeof(uint64_t)+1;
+			uint64_t w=0;
+			int32_t nbits=alphabet->get_num_bits();
+			uint64_t nfit=8*sizeof(w)/nbits;
+			uint64_t stream_len=len/nfit+1;
 			string=SG_MALLOC(uint64_t, stream_len);
 			length=len;
 
-			uint64_t w=0;
-			int32_t nbits=alphabet->get_num_bits();
 			uint64_t j=0;
-			uint64_t nfit=8*sizeof(w)/nbits;
 			for (uint64_t i=0; i<len; i++)
 			{
-				w= (w << nbits) | alphabet->remap_to_bin((uint8_t) str[j]);
+				w= (w << nbits) | alphabet->remap_to_bin((uint8_t) str[i]);
 
 				if (i % nfit == nfit-1)
 				{
 					string[j]=w;
+					w=0;
 					j++;
 				}
 			}
 
+			// the last word is left aligned like the full ones
 			if (j<stream_len)
 			{
-				string[j]=w;
+				string[j]=w << (8*sizeof(w)-nbits*(len % nfit)) % (8*sizeof(w));
 				j++;
 			}
 
@@ -218,7 +220,7 @@ class BitString : public SGObject
 		void create(uint64_t len)
 		{
 			cleanup();
-			uint64_t stream_len=len/sizeof(uint64_t)+1;
+			uint64_t stream_len=len/(8*sizeof(uint64_t)/alphabet->get_num_bits())+1;
 			string=SG_MALLOC(uint64_t, stream_len);
 			SGVector<uint64_t>::fill_vector(string, (int32_t) stream_len, (uint64_t) 0);
 			length=len;
@@ -278,6 +280,62 @@ class BitString : public SGObject
 			return res;
 		}
 
+		/** extract a block of consecutive words, i.e. the words starting
+		 * at positions start, ..., start+num-1, as obtained by operator[]
+		 *
+		 * The characters are read a machine word at a time and every
+		 * word is derived from the previous one by a shift, so the cost
+		 * per word is constant instead of proportional to the width.
+		 * Requires an alphabet whose characters fill machine words, e.g.
+		 * DNA.
+		 *
+		 * @param start position of the first word
+		 * @param num number of words
+		 * @param words array of num words to write to
+		 */
+		void get_words(uint64_t start, uint64_t num, uint64_t* words) const
+		{
+			if (num==0)
+				return;
+			ASSERT(start+num<=get_length())
+
+			const int32_t ws=8*sizeof(uint64_t);
+			const int32_t nbits=alphabet->get_num_bits();
+			require(ws % nbits==0,
+				"Characters of {} bits do not fill a word of {} bits", nbits, ws);
+			const uint64_t nfit=ws/nbits;
+			const uint64_t word_mask=word_len==ws ?
+				~uint64_t(0) : (uint64_t(1) << word_len)-1;
+
+			// position and remaining characters of the current word
+			uint64_t idx=start/nfit;
+			uint64_t left=nfit-start % nfit;
+			uint64_t cur=string[idx] << (nbits*(start % nfit));
+			auto next_char=[&]()
+			{
+				if (left==0)
+				{
+					cur=string[++idx];
+					left=nfit;
+				}
+				const uint64_t c=cur >> (ws-nbits);
+				cur<<=nbits;
+				left--;
+				return c;
+			};
+
+			const int32_t width=word_len/nbits;
+			uint64_t w=0;
+			for (int32_t k=0; k<width-1; k++)
+				w=(w << nbits) | next_char();
+
+			for (uint64_t i=0; i<num; i++)
+			{
+				w=((w << nbits) | next_char()) & word_mask;
+				words[i]=w;
+			}
+		}
+
 		/** set a binary word
 		 *
 		 * @param word 16 bit word to be set
@@ -0,0 +1,204 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/CacheManager.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+CacheManager::Entry::Entry(
+    std::shared_ptr<CacheManager> manager, std::string name,
+    std::function<Statistics()> statistics)
+    : m_manager(std::move(manager)), m_name(std::move(name)),
+      m_statistics(std::move(statistics))
+{
+}
+
+CacheManager::Entry::~Entry()
+{
+	m_manager->remove_cache(this);
+}
+
+int64_t CacheManager::Entry::reserve(int64_t demand, int64_t minimum)
+{
+	return m_manager->reserve(this, demand, minimum);
+}
+
+void CacheManager::Entry::release()
+{
+	std::lock_guard<std::mutex> lock(m_manager->m_mutex);
+	m_reserved = 0;
+}
+
+int64_t CacheManager::Entry::get_reserved() const
+{
+	std::lock_guard<std::mutex> lock(m_manager->m_mutex);
+	return m_reserved;
+}
+
+int64_t CacheManager::Entry::get_target() const
+{
+	std::lock_guard<std::mutex> lock(m_manager->m_mutex);
+	return m_target;
+}
+
+CacheManager::CacheManager(int64_t budget) : m_budget(std::max<int64_t>(budget, 0))
+{
+}
+
+std::unique_ptr<CacheManager::Entry> CacheManager::add_cache(
+    const std::string& name, std::function<Statistics()> statistics)
+{
+	std::unique_ptr<Entry> entry(
+	    new Entry(shared_from_this(), name, std::move(statistics)));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.push_back(entry.get());
+	return entry;
+}
+
+void CacheManager::remove_cache(Entry* entry)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.erase(
+	    std::remove(m_entries.begin(), m_entries.end(), entry),
+	    m_entries.end());
+	rebalance_locked();
+}
+
+void CacheManager::set_budget(int64_t budget)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_budget = std::max<int64_t>(budget, 0);
+	rebalance_locked();
+}
+
+int64_t CacheManager::get_budget() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_budget;
+}
+
+int64_t CacheManager::get_reserved() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	int64_t reserved = 0;
+	for (const auto* entry : m_entries)
+		reserved += entry->m_reserved;
+	return reserved;
+}
+
+int32_t CacheManager::get_num_caches() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+void CacheManager::rebalance()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	rebalance_locked();
+}
+
+int64_t CacheManager::reserve(Entry* entry, int64_t demand, int64_t minimum)
+{
+	demand = std::max<int64_t>(demand, 0);
+	minimum = std::min(std::max<int64_t>(minimum, 0), demand);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	entry->m_reserved = 0;
+	entry->m_demand = demand;
+	rebalance_locked();
+
+	int64_t granted = entry->m_target;
+	if (m_budget > 0)
+	{
+		// memory held by the other caches is only given back when they
+		// reserve again
+		int64_t reserved = 0;
+		for (const auto* other : m_entries)
+			reserved += other->m_reserved;
+		granted = std::min(granted, std::max<int64_t>(m_budget - reserved, 0));
+	}
+
+	entry->m_reserved = std::max(granted, minimum);
+	return entry->m_reserved;
+}
+
+void CacheManager::rebalance_locked()
+{
+	if (m_budget == 0)
+	{
+		for (auto* entry : m_entries)
+			entry->m_target = entry->m_demand;
+		return;
+	}
+
+	// the benefit of a cache is the time spent on its misses, caches
+	// without misses yet get the mean benefit of the others
+	std::vector<float64_t> weights(m_entries.size(), 0);
+	float64_t total_known = 0;
+	int32_t num_known = 0;
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		const auto stats = m_entries[i]->get_statistics();
+		if (stats.misses > 0 && stats.miss_seconds > 0)
+		{
+			weights[i] = stats.miss_seconds;
+			total_known += weights[i];
+			num_known++;
+		}
+	}
+	const float64_t mean = num_known ? total_known / num_known : 1.0;
+
+	std::vector<size_t> open;
+	for (size_t i = 0; i < m_entries.size(); ++i)
+	{
+		m_entries[i]->m_target = 0;
+		if (m_entries[i]->m_demand > 0)
+		{
+			if (weights[i] == 0)
+				weights[i] = mean;
+			open.push_back(i);
+		}
+	}
+
+	// split the budget in proportion to the benefits, caches whose share
+	// exceeds their demand get their demand and the rest is split again
+	int64_t remaining = m_budget;
+	while (!open.empty())
+	{
+		float64_t total = 0;
+		for (auto i : open)
+			total += weights[i];
+
+		std::vector<size_t> still_open;
+		for (auto i : open)
+		{
+			const float64_t share = remaining * weights[i] / total;
+			if (m_entries[i]->m_demand <= share)
+				m_entries[i]->m_target = m_entries[i]->m_demand;
+			else
+				still_open.push_back(i);
+		}
+
+		if (still_open.size() == open.size())
+		{
+			for (auto i : open)
+				m_entries[i]->m_target =
+				    static_cast<int64_t>(remaining * weights[i] / total);
+			break;
+		}
+
+		for (auto i : open)
+		{
+			if (m_entries[i]->m_target > 0)
+				remaining -= m_entries[i]->m_target;
+		}
+		open.swap(still_open);
+	}
+}
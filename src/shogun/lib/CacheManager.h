@@ -0,0 +1,173 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __CACHEMANAGER_H__
+#define __CACHEMANAGER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+	/** @brief Shares a global memory budget between the caches of the
+	 * library, e.g. the kernel cache of SVMLight and the feature caches of
+	 * DenseFeatures (ConcurrentCache).
+	 *
+	 * Every cache still has its own size setting, which is its demand.
+	 * A cache registers with add_cache() and asks for memory with
+	 * Entry::reserve() whenever it allocates. Without a budget (the
+	 * default) every demand is granted. With a budget, the manager
+	 * computes a target capacity for every cache by splitting the budget
+	 * in proportion to the benefit of the caches, and never grants more
+	 * than is left of the budget. The benefit is the time the cache
+	 * spent recomputing missed objects, which it reports with its hits
+	 * and misses (see Statistics), so caches whose misses are expensive
+	 * get more memory. Caches apply a new target when they allocate the
+	 * next time, e.g. when the kernel cache is reset for training, so
+	 * memory is never taken away from a cache in use.
+	 *
+	 * The global manager is env()->cache_manager(), its budget can be set
+	 * with env()->set_cache_budget() or the environment variable
+	 * SHOGUN_CACHE_BUDGET (in megabytes).
+	 */
+	class CacheManager : public std::enable_shared_from_this<CacheManager>
+	{
+	public:
+		/** usage of a cache since it was registered */
+		struct Statistics
+		{
+			/** number of objects found in the cache */
+			int64_t hits = 0;
+			/** number of objects that had to be computed */
+			int64_t misses = 0;
+			/** seconds spent computing the missed objects */
+			float64_t miss_seconds = 0;
+		};
+
+		/** @brief Registration of a cache, owned by the cache. Destroying
+		 * it releases the memory of the cache and unregisters it.
+		 */
+		class Entry
+		{
+		public:
+			~Entry();
+
+			Entry(const Entry&) = delete;
+			Entry& operator=(const Entry&) = delete;
+
+			/** ask for memory, releasing the memory reserved before
+			 *
+			 * @param demand bytes the cache would like to use
+			 * @param minimum bytes the cache cannot work without, which
+			 * are granted even if the budget is exceeded
+			 * @return bytes the cache may use, at most demand
+			 */
+			int64_t reserve(int64_t demand, int64_t minimum = 0);
+
+			/** release the reserved memory, e.g. when the cache is freed */
+			void release();
+
+			/** @return bytes currently reserved */
+			int64_t get_reserved() const;
+
+			/** @return bytes the manager would grant on the next
+			 * reserve() with the current demand
+			 */
+			int64_t get_target() const;
+
+			/** @return name of the cache */
+			const std::string& get_name() const
+			{
+				return m_name;
+			}
+
+			/** @return usage statistics reported by the cache */
+			Statistics get_statistics() const
+			{
+				return m_statistics ? m_statistics() : Statistics();
+			}
+
+		private:
+			friend class CacheManager;
+
+			Entry(
+			    std::shared_ptr<CacheManager> manager, std::string name,
+			    std::function<Statistics()> statistics);
+
+			std::shared_ptr<CacheManager> m_manager;
+			std::string m_name;
+			std::function<Statistics()> m_statistics;
+			/** last demand, guarded by the lock of the manager */
+			int64_t m_demand = 0;
+			/** reserved bytes, guarded by the lock of the manager */
+			int64_t m_reserved = 0;
+			/** target capacity, guarded by the lock of the manager */
+			int64_t m_target = 0;
+		};
+
+		/** constructor
+		 *
+		 * @param budget bytes all caches may use together, 0 for no limit
+		 */
+		CacheManager(int64_t budget = 0);
+
+		CacheManager(const CacheManager&) = delete;
+		CacheManager& operator=(const CacheManager&) = delete;
+
+		/** register a cache, the manager must be owned by a shared_ptr
+		 *
+		 * @param name name of the cache, e.g. the class that owns it
+		 * @param statistics function returning the usage of the cache,
+		 * may be empty
+		 * @return registration of the cache
+		 */
+		std::unique_ptr<Entry> add_cache(
+		    const std::string& name,
+		    std::function<Statistics()> statistics = nullptr);
+
+		/** set the budget and recompute the targets of the caches, caches
+		 * that use more than their target shrink on their next reserve
+		 *
+		 * @param budget bytes all caches may use together, 0 for no limit
+		 */
+		void set_budget(int64_t budget);
+
+		/** @return bytes all caches may use together, 0 for no limit */
+		int64_t get_budget() const;
+
+		/** @return bytes reserved by all caches */
+		int64_t get_reserved() const;
+
+		/** @return number of registered caches */
+		int32_t get_num_caches() const;
+
+		/** recompute the targets of the caches from their statistics */
+		void rebalance();
+
+	private:
+		/** remove a cache that is destroyed */
+		void remove_cache(Entry* entry);
+
+		/** reserve memory for a cache, see Entry::reserve() */
+		int64_t reserve(Entry* entry, int64_t demand, int64_t minimum);
+
+		/** split the budget between the caches, the lock must be held */
+		void rebalance_locked();
+
+		mutable std::mutex m_mutex;
+		int64_t m_budget;
+		std::vector<Entry*> m_entries;
+	};
+} // namespace shogun
+
+#endif // __CACHEMANAGER_H__
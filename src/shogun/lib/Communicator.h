@@ -0,0 +1,74 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _COMMUNICATOR_H__
+#define _COMMUNICATOR_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+/** @brief Interface of the collective operations used for data-parallel
+ * training on data that is sharded across processes or machines.
+ *
+ * The processes have the ranks 0..get_size()-1. Every collective operation
+ * has to be called by all processes in the same order. An implementation
+ * has to return bitwise identical results on all processes, so that
+ * deterministic learners follow the same path everywhere.
+ *
+ * \sa TCPCommunicator
+ * \sa AllreduceCostFunction
+ */
+class Communicator : public SGObject
+{
+public:
+	~Communicator() override {}
+
+	/** @return rank of this process */
+	virtual int32_t get_rank() const=0;
+
+	/** @return number of processes */
+	virtual int32_t get_size() const=0;
+
+	/** replace the vector of every process by the element-wise sum over
+	 * all processes
+	 *
+	 * @param data vector of the same length on all processes
+	 */
+	virtual void allreduce_sum(SGVector<float64_t>& data)=0;
+
+	/** replace the vector of every process by the one of the root
+	 *
+	 * @param data vector of the same length on all processes
+	 * @param root rank of the process that sends its vector
+	 */
+	virtual void broadcast(SGVector<float64_t>& data, int32_t root=0)=0;
+
+	/** sum a scalar over all processes
+	 *
+	 * @param value value of this process
+	 * @return sum over all processes
+	 */
+	float64_t allreduce_sum(float64_t value)
+	{
+		SGVector<float64_t> data(1);
+		data[0]=value;
+		allreduce_sum(data);
+		return data[0];
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "Communicator";
+	}
+};
+}
+#endif /* _COMMUNICATOR_H__ */
@@ -0,0 +1,334 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _CONCURRENTCACHE_H__
+#define _CONCURRENTCACHE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/CacheManager.h>
+#include <shogun/lib/FlatHashMap.h>
+#include <shogun/lib/common.h>
+#include <shogun/lib/memory.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace shogun
+{
+/** @brief Cache of fixed size objects that can be used from many threads.
+ *
+ * The cache lines are split into shards by the number of the object, each
+ * shard has its own reader-writer lock. Lookups of cached objects only take
+ * the lock of their shard for reading, so threads that hit the cache do not
+ * serialize; inserting takes it for writing. Lines are replaced by the clock
+ * algorithm, which approximates least recently used.
+ *
+ * Cached objects are pinned while in use: lock_entry() pins a filled line,
+ * set_entry() pins a new line for the caller to fill and commit_entry()
+ * makes it visible to the other threads. Pinned lines are never replaced,
+ * unlock_entry() releases the pin. When all lines of a shard are pinned, or
+ * the object is being filled by another thread, both return NULL and the
+ * caller computes the object into its own buffer.
+ *
+ * The memory of the lines is reserved from the global CacheManager, which
+ * may grant less than the requested size when a cache budget is set. The
+ * hits and the time between set_entry() and commit_entry() of the misses
+ * are reported to it.
+ */
+template <class T>
+class ConcurrentCache
+{
+	/** cache line */
+	struct Line
+	{
+		/** number of the cached object, -1 for free lines */
+		int64_t number=-1;
+		/** number of users */
+		std::atomic<int32_t> pins{0};
+		/** whether the object has been filled */
+		std::atomic<bool> ready{false};
+		/** whether the line was used since the clock hand passed it */
+		std::atomic<bool> referenced{false};
+		/** when set_entry() handed out the line */
+		std::chrono::steady_clock::time_point filled_since;
+		/** cached object */
+		T* obj=nullptr;
+	};
+
+	/** lines of the objects whose number maps to the shard */
+	struct Shard
+	{
+		/** lock of the index and the line ownership */
+		std::shared_mutex mutex;
+		/** line of every cached object number */
+		FlatHashMap<int64_t, Line*> index;
+		/** lines of the shard */
+		std::unique_ptr<Line[]> lines;
+		/** number of lines */
+		int64_t num_lines=0;
+		/** position of the clock hand */
+		int64_t hand=0;
+		/** number of lock_entry() calls that found the object */
+		std::atomic<int64_t> hits{0};
+		/** number of committed objects */
+		std::atomic<int64_t> misses{0};
+		/** time between set_entry() and commit_entry() of the misses */
+		std::atomic<int64_t> miss_nanoseconds{0};
+	};
+
+public:
+	/** constructor
+	 *
+	 * @param cache_size cache size in Megabytes
+	 * @param obj_size number of elements of an object
+	 * @param num_entries number of cacheable objects
+	 * @param num_shards number of shards, 0 for four per thread
+	 * @param name name the cache is registered with at the CacheManager
+	 */
+	ConcurrentCache(
+	    int64_t cache_size, int64_t obj_size, int64_t num_entries,
+	    int32_t num_shards=0, const std::string& name="ConcurrentCache")
+	    : m_num_shards(0), m_block(nullptr)
+	{
+		if (cache_size<=0 || obj_size<=0 || num_entries<=0)
+		{
+			SG_DEBUG("doing without cache.");
+			return;
+		}
+
+		const int64_t line_bytes=obj_size*sizeof(T);
+		int64_t num_lines=std::min(
+		    (int64_t)(cache_size*1024*1024/line_bytes), num_entries);
+		if (num_lines<=0)
+			return;
+
+		m_entry=env()->cache_manager()->add_cache(
+		    name, [this]() { return get_statistics(); });
+		num_lines=m_entry->reserve(num_lines*line_bytes)/line_bytes;
+		if (num_lines<=0)
+		{
+			SG_DEBUG("doing without cache, the cache budget is used up.");
+			m_entry->release();
+			return;
+		}
+
+		if (num_shards<=0)
+			num_shards=4*env()->get_num_threads();
+		m_num_shards=std::max<int64_t>(std::min<int64_t>(num_shards, num_lines), 1);
+
+		io::info(
+		    "creating {} cache lines in {} shards (total size: {} byte)",
+		    num_lines, m_num_shards, num_lines*obj_size*sizeof(T));
+		m_block=SG_MALLOC(T, num_lines*obj_size);
+		m_shards.reset(new Shard[m_num_shards]);
+
+		int64_t offset=0;
+		for (int64_t s=0; s<m_num_shards; ++s)
+		{
+			Shard& shard=m_shards[s];
+			shard.num_lines=num_lines/m_num_shards+(s<num_lines%m_num_shards);
+			shard.lines.reset(new Line[shard.num_lines]);
+			shard.index.reserve(shard.num_lines);
+			for (int64_t i=0; i<shard.num_lines; ++i, ++offset)
+				shard.lines[i].obj=&m_block[offset*obj_size];
+		}
+		m_counting.store(true, std::memory_order_release);
+	}
+
+	~ConcurrentCache()
+	{
+		SG_FREE(m_block);
+	}
+
+	ConcurrentCache(const ConcurrentCache&) = delete;
+	ConcurrentCache& operator=(const ConcurrentCache&) = delete;
+
+	/** @return hits and misses of the cache */
+	CacheManager::Statistics get_statistics() const
+	{
+		CacheManager::Statistics stats;
+		if (!m_counting.load(std::memory_order_acquire))
+			return stats;
+
+		int64_t nanoseconds=0;
+		for (int64_t s=0; s<m_num_shards; ++s)
+		{
+			stats.hits+=m_shards[s].hits.load(std::memory_order_relaxed);
+			stats.misses+=m_shards[s].misses.load(std::memory_order_relaxed);
+			nanoseconds+=m_shards[s].miss_nanoseconds.load(std::memory_order_relaxed);
+		}
+		stats.miss_seconds=nanoseconds*1e-9;
+		return stats;
+	}
+
+	/** @return whether the cache has lines */
+	bool is_enabled() const
+	{
+		return m_num_shards>0;
+	}
+
+	/** checks if an object is cached
+	 *
+	 * @param number number of object to check for
+	 * @return if an object is cached and filled
+	 */
+	bool is_cached(int64_t number)
+	{
+		if (!is_enabled())
+			return false;
+
+		Shard& shard=shard_of(number);
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+		auto it=shard.index.find(number);
+		return it!=shard.index.end() &&
+		       it->second->ready.load(std::memory_order_acquire);
+	}
+
+	/** pin and get a filled cache entry
+	 *
+	 * @param number number of object to lock and get
+	 * @return cached object or NULL when not cached
+	 */
+	T* lock_entry(int64_t number)
+	{
+		if (!is_enabled())
+			return nullptr;
+
+		Shard& shard=shard_of(number);
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+		auto it=shard.index.find(number);
+		if (it==shard.index.end())
+			return nullptr;
+
+		Line* line=it->second;
+		if (!line->ready.load(std::memory_order_acquire))
+			return nullptr;
+
+		line->pins.fetch_add(1, std::memory_order_relaxed);
+		line->referenced.store(true, std::memory_order_relaxed);
+		shard.hits.fetch_add(1, std::memory_order_relaxed);
+		return line->obj;
+	}
+
+	/** pin a free line for an object that is not cached yet, the caller
+	 * writes the object to it and calls commit_entry()
+	 *
+	 * @param number number of object
+	 * @return line of obj_size elements or NULL when the object is already
+	 * cached or all lines are pinned
+	 */
+	T* set_entry(int64_t number)
+	{
+		if (!is_enabled())
+			return nullptr;
+
+		Shard& shard=shard_of(number);
+		std::unique_lock<std::shared_mutex> lock(shard.mutex);
+		if (shard.index.count(number))
+			return nullptr;
+
+		/* two rounds of the clock clear all reference bits */
+		Line* victim=nullptr;
+		for (int64_t step=0; step<2*shard.num_lines && !victim; ++step)
+		{
+			Line& line=shard.lines[shard.hand];
+			shard.hand=(shard.hand+1)%shard.num_lines;
+			if (line.pins.load(std::memory_order_acquire)>0)
+				continue;
+			if (line.referenced.exchange(false, std::memory_order_relaxed))
+				continue;
+			victim=&line;
+		}
+		if (!victim)
+			return nullptr;
+
+		if (victim->number>=0)
+			shard.index.erase(victim->number);
+		victim->number=number;
+		victim->ready.store(false, std::memory_order_relaxed);
+		victim->referenced.store(true, std::memory_order_relaxed);
+		victim->pins.store(1, std::memory_order_relaxed);
+		victim->filled_since=std::chrono::steady_clock::now();
+		shard.index.emplace(number, victim);
+		return victim->obj;
+	}
+
+	/** make an object filled after set_entry() available to lock_entry()
+	 *
+	 * @param number number of object
+	 */
+	void commit_entry(int64_t number)
+	{
+		if (Line* line=pinned_line(number))
+		{
+			const auto elapsed=std::chrono::steady_clock::now()-line->filled_since;
+			Shard& shard=shard_of(number);
+			shard.misses.fetch_add(1, std::memory_order_relaxed);
+			shard.miss_nanoseconds.fetch_add(
+			    std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+			    std::memory_order_relaxed);
+			line->ready.store(true, std::memory_order_release);
+		}
+	}
+
+	/** release the pin of a cache entry, does nothing if obj is not the
+	 * cached object, e.g. when it was computed into another buffer
+	 *
+	 * @param number number of object to unlock
+	 * @param obj object returned by lock_entry() or set_entry()
+	 */
+	void unlock_entry(int64_t number, const T* obj)
+	{
+		if (!is_enabled())
+			return;
+
+		Shard& shard=shard_of(number);
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+		auto it=shard.index.find(number);
+		if (it!=shard.index.end() && it->second->obj==obj)
+			it->second->pins.fetch_sub(1, std::memory_order_release);
+	}
+
+private:
+	/** @return shard of object number */
+	Shard& shard_of(int64_t number) const
+	{
+		return m_shards[number%m_num_shards];
+	}
+
+	/** @return line of object number, NULL if not in the cache */
+	Line* pinned_line(int64_t number)
+	{
+		if (!is_enabled())
+			return nullptr;
+
+		Shard& shard=shard_of(number);
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+		auto it=shard.index.find(number);
+		return it!=shard.index.end() ? it->second : nullptr;
+	}
+
+private:
+	/** number of shards */
+	int64_t m_num_shards;
+	/** shards */
+	std::unique_ptr<Shard[]> m_shards;
+	/** memory of all lines */
+	T* m_block;
+	/** whether the shards exist, i.e. get_statistics() may read them */
+	std::atomic<bool> m_counting{false};
+	/** registration at the cache manager, destroyed first */
+	std::unique_ptr<CacheManager::Entry> m_entry;
+};
+} // namespace shogun
+
+#endif // _CONCURRENTCACHE_H__
@@ -96,6 +96,35 @@ index_t DelimiterTokenizer::next_token_idx(index_t& start)
 	return last_idx++;
 }
 
+void DelimiterTokenizer::tokenize(const SGVector<char>& txt,
+	std::vector<std::pair<index_t, index_t>>& tokens)
+{
+	tokens.clear();
+
+	const bool* is_delimiter = delimiters.vector;
+	const uint8_t* str = (const uint8_t*) txt.vector;
+	const index_t len = txt.size();
+	index_t start = 0;
+	while (start<len)
+	{
+		/* a delimiter right after a token or a delimiter starts an empty
+		 * token, unless consecutive delimiters are skipped */
+		if (is_delimiter[str[start]])
+		{
+			if (!skip_consecutive_delimiters)
+				tokens.emplace_back(start, start);
+			start++;
+			continue;
+		}
+
+		index_t end = start+1;
+		while (end<len && !is_delimiter[str[end]])
+			end++;
+		tokens.emplace_back(start, end);
+		start = end+1;
+	}
+}
+
 DelimiterTokenizer* DelimiterTokenizer::get_copy()
 {
 	DelimiterTokenizer* t = new DelimiterTokenizer();
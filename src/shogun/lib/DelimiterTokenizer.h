@@ -78,6 +78,15 @@ public:
 
 	DelimiterTokenizer* get_copy() override;
 
+	/** Finds all tokens of a text in a single scan over the characters,
+	 * see Tokenizer::tokenize()
+	 *
+	 * @param txt the text to tokenize
+	 * @param tokens set to the start and end index of every token
+	 */
+	void tokenize(const SGVector<char>& txt,
+		std::vector<std::pair<index_t, index_t>>& tokens) override;
+
 	/** Resets the delimiters */
 	void clear_delimiters();
 
@@ -0,0 +1,573 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __FLATHASHMAP_H__
+#define __FLATHASHMAP_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace shogun
+{
+/** @brief Hash map with open addressing in a single flat array.
+ *
+ * The elements are stored in one array of slots, next to an array with
+ * one control byte per slot as in Swiss tables: the byte marks a slot as
+ * empty or erased, or holds 7 bits of the hash of the key in the slot.
+ * Lookups compare the bytes of 16 consecutive slots at once (with SSE2)
+ * and only compare the keys of slots whose byte matches, so a lookup
+ * usually touches one cache line of control bytes and one of slots
+ * instead of following the nodes of a std::unordered_map.
+ *
+ * The interface is the part of std::unordered_map shogun uses. Unlike
+ * std::unordered_map, inserting may move the elements and invalidates
+ * references and iterators, erasing does neither. clear() keeps the
+ * memory, reserve() allocates for a number of elements up front.
+ *
+ * The hash is mixed before use, so the identity hash of std::hash for
+ * integers is fine.
+ */
+template <
+    class K, class V, class Hash = std::hash<K>,
+    class KeyEqual = std::equal_to<K>>
+class FlatHashMap
+{
+	/** control bytes of slots without an element, full slots hold the
+	 * lower 7 bits of the hash
+	 */
+	static constexpr int8_t kEmpty = -128;
+	static constexpr int8_t kErased = -2;
+
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<K, V>;
+	using size_type = size_t;
+	using hasher = Hash;
+	using key_equal = KeyEqual;
+
+	/** @brief Iterator over the elements in the order of the slots. */
+	template <bool Const>
+	class Iterator
+	{
+		friend class FlatHashMap;
+		using Map =
+		    std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = FlatHashMap::value_type;
+		using difference_type = std::ptrdiff_t;
+		using reference =
+		    std::conditional_t<Const, const value_type&, value_type&>;
+		using pointer =
+		    std::conditional_t<Const, const value_type*, value_type*>;
+
+		Iterator() = default;
+
+		/** iterators convert to const iterators */
+		template <bool C = Const, std::enable_if_t<C>* = nullptr>
+		Iterator(const Iterator<false>& other)
+		    : m_map(other.m_map), m_slot(other.m_slot)
+		{
+		}
+
+		reference operator*() const
+		{
+			return m_map->m_slots[m_slot];
+		}
+
+		pointer operator->() const
+		{
+			return &m_map->m_slots[m_slot];
+		}
+
+		Iterator& operator++()
+		{
+			m_slot = m_map->next_full(m_slot + 1);
+			return *this;
+		}
+
+		Iterator operator++(int)
+		{
+			auto copy = *this;
+			++*this;
+			return copy;
+		}
+
+		bool operator==(const Iterator& other) const
+		{
+			return m_slot == other.m_slot;
+		}
+
+		bool operator!=(const Iterator& other) const
+		{
+			return m_slot != other.m_slot;
+		}
+
+	private:
+		Iterator(Map* map, size_t slot) : m_map(map), m_slot(slot)
+		{
+		}
+
+		template <bool>
+		friend class Iterator;
+
+		Map* m_map = nullptr;
+		size_t m_slot = 0;
+	};
+
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	FlatHashMap() = default;
+
+	/** constructor
+	 *
+	 * @param num_elements number of elements to reserve memory for
+	 */
+	explicit FlatHashMap(size_t num_elements)
+	{
+		reserve(num_elements);
+	}
+
+	FlatHashMap(const FlatHashMap& other)
+	{
+		reserve(other.size());
+		for (const auto& element : other)
+			insert_unique(element);
+	}
+
+	FlatHashMap(FlatHashMap&& other) noexcept
+	{
+		swap(other);
+	}
+
+	FlatHashMap& operator=(const FlatHashMap& other)
+	{
+		if (this != &other)
+		{
+			FlatHashMap copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+
+	FlatHashMap& operator=(FlatHashMap&& other) noexcept
+	{
+		if (this != &other)
+		{
+			FlatHashMap empty;
+			swap(empty);
+			swap(other);
+		}
+		return *this;
+	}
+
+	~FlatHashMap()
+	{
+		destroy_elements();
+		deallocate();
+	}
+
+	void swap(FlatHashMap& other) noexcept
+	{
+		std::swap(m_ctrl, other.m_ctrl);
+		std::swap(m_slots, other.m_slots);
+		std::swap(m_capacity, other.m_capacity);
+		std::swap(m_size, other.m_size);
+		std::swap(m_erased, other.m_erased);
+	}
+
+	iterator begin()
+	{
+		return iterator(this, next_full(0));
+	}
+
+	iterator end()
+	{
+		return iterator(this, m_capacity);
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, next_full(0));
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, m_capacity);
+	}
+
+	/** @return number of elements */
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	/** @return whether there are no elements */
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	/** @return number of slots */
+	size_t bucket_count() const
+	{
+		return m_capacity;
+	}
+
+	/** allocate slots for a number of elements, so that inserting up to
+	 * that many elements does not rehash
+	 *
+	 * @param num_elements number of elements
+	 */
+	void reserve(size_t num_elements)
+	{
+		size_t capacity = kMinCapacity;
+		while (capacity * kMaxLoadNum < num_elements * kMaxLoadDen)
+			capacity *= 2;
+		if (capacity > m_capacity)
+			rehash(capacity);
+	}
+
+	/** remove all elements, keeping the memory */
+	void clear()
+	{
+		destroy_elements();
+		if (m_capacity)
+			std::memset(m_ctrl, kEmpty, m_capacity + kGroupWidth);
+		m_size = 0;
+		m_erased = 0;
+	}
+
+	iterator find(const K& key)
+	{
+		return iterator(this, find_slot(key));
+	}
+
+	const_iterator find(const K& key) const
+	{
+		return const_iterator(this, find_slot(key));
+	}
+
+	/** @return 1 if the key is in the map, 0 otherwise */
+	size_t count(const K& key) const
+	{
+		return find_slot(key) != m_capacity;
+	}
+
+	/** @return whether the key is in the map */
+	bool contains(const K& key) const
+	{
+		return find_slot(key) != m_capacity;
+	}
+
+	/** insert an element constructed from the arguments if the key is not
+	 * in the map
+	 *
+	 * @param key key
+	 * @param args arguments of the constructor of the value
+	 * @return iterator to the element of the key and whether it was
+	 * inserted
+	 */
+	template <class... Args>
+	std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+	{
+		const size_t hash = mixed_hash(key);
+		size_t slot = find_slot(key, hash);
+		if (slot != m_capacity)
+			return {iterator(this, slot), false};
+
+		slot = prepare_insert(hash);
+		new (&m_slots[slot]) value_type(
+		    std::piecewise_construct, std::forward_as_tuple(key),
+		    std::forward_as_tuple(std::forward<Args>(args)...));
+		return {iterator(this, slot), true};
+	}
+
+	/** insert an element if its key is not in the map
+	 *
+	 * @param key key
+	 * @param value value
+	 * @return iterator to the element of the key and whether it was
+	 * inserted
+	 */
+	template <class T>
+	std::pair<iterator, bool> emplace(const K& key, T&& value)
+	{
+		return try_emplace(key, std::forward<T>(value));
+	}
+
+	std::pair<iterator, bool> insert(const value_type& element)
+	{
+		return try_emplace(element.first, element.second);
+	}
+
+	/** @return value of the key, inserting a default constructed value
+	 * if the key is not in the map
+	 */
+	V& operator[](const K& key)
+	{
+		return try_emplace(key).first->second;
+	}
+
+	/** remove the element of a key
+	 *
+	 * @param key key
+	 * @return number of removed elements
+	 */
+	size_t erase(const K& key)
+	{
+		const size_t slot = find_slot(key);
+		if (slot == m_capacity)
+			return 0;
+		erase_slot(slot);
+		return 1;
+	}
+
+	/** remove an element
+	 *
+	 * @param it iterator to the element
+	 * @return iterator to the next element
+	 */
+	iterator erase(const_iterator it)
+	{
+		erase_slot(it.m_slot);
+		return iterator(this, next_full(it.m_slot + 1));
+	}
+
+private:
+	/** number of control bytes compared at once */
+	static constexpr size_t kGroupWidth = 16;
+	static constexpr size_t kMinCapacity = kGroupWidth;
+	/** maximum load of 7/8, counting erased slots */
+	static constexpr size_t kMaxLoadNum = 7;
+	static constexpr size_t kMaxLoadDen = 8;
+
+	static size_t mixed_hash(const K& key)
+	{
+		// the upper half of a multiplication by 2^64/phi, so that all bits
+		// of the hash reach the bits used for the slot and the tag
+		uint64_t h = static_cast<uint64_t>(Hash()(key));
+		h *= 0x9E3779B97F4A7C15ULL;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+
+	static int8_t tag(size_t hash)
+	{
+		return static_cast<int8_t>(hash & 0x7f);
+	}
+
+	static uint32_t lowest_bit(uint32_t bits)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(bits);
+#else
+		uint32_t i = 0;
+		while (!(bits & 1))
+		{
+			bits >>= 1;
+			i++;
+		}
+		return i;
+#endif
+	}
+
+	/** @return mask of the control bytes of the group starting at a slot
+	 * that are equal to a value
+	 */
+	uint32_t match(size_t pos, int8_t value) const
+	{
+#ifdef __SSE2__
+		const __m128i group =
+		    _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_ctrl + pos));
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value)));
+#else
+		uint32_t bits = 0;
+		for (size_t i = 0; i < kGroupWidth; i++)
+			bits |= uint32_t(m_ctrl[pos + i] == value) << i;
+		return bits;
+#endif
+	}
+
+	/** @return mask of the empty and erased slots of the group starting at
+	 * a slot
+	 */
+	uint32_t match_free(size_t pos) const
+	{
+#ifdef __SSE2__
+		return _mm_movemask_epi8(
+		    _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_ctrl + pos)));
+#else
+		uint32_t bits = 0;
+		for (size_t i = 0; i < kGroupWidth; i++)
+			bits |= uint32_t(m_ctrl[pos + i] < 0) << i;
+		return bits;
+#endif
+	}
+
+	/** set the control byte of a slot, the bytes of the first group are
+	 * repeated after the last slot so that every group can be loaded at
+	 * once
+	 */
+	void set_ctrl(size_t slot, int8_t value)
+	{
+		m_ctrl[slot] = value;
+		if (slot < kGroupWidth)
+			m_ctrl[m_capacity + slot] = value;
+	}
+
+	size_t find_slot(const K& key) const
+	{
+		return find_slot(key, mixed_hash(key));
+	}
+
+	/** @return slot of the key, m_capacity if it is not in the map */
+	size_t find_slot(const K& key, size_t hash) const
+	{
+		if (m_capacity == 0)
+			return m_capacity;
+
+		const size_t mask = m_capacity - 1;
+		const int8_t t = tag(hash);
+		for (size_t pos = (hash >> 7) & mask;; pos = (pos + kGroupWidth) & mask)
+		{
+			for (uint32_t bits = match(pos, t); bits; bits &= bits - 1)
+			{
+				const size_t slot = (pos + lowest_bit(bits)) & mask;
+				if (KeyEqual()(m_slots[slot].first, key))
+					return slot;
+			}
+			if (match(pos, kEmpty))
+				return m_capacity;
+		}
+	}
+
+	/** @return free slot for a new key, growing the table if needed */
+	size_t prepare_insert(size_t hash)
+	{
+		if ((m_size + m_erased + 1) * kMaxLoadDen > m_capacity * kMaxLoadNum)
+		{
+			// mostly erased slots are reused without growing
+			size_t capacity = std::max(m_capacity, kMinCapacity);
+			if ((m_size + 1) * kMaxLoadDen * 2 > capacity * kMaxLoadNum)
+				capacity *= 2;
+			rehash(capacity);
+		}
+
+		const size_t mask = m_capacity - 1;
+		size_t pos = (hash >> 7) & mask;
+		uint32_t bits;
+		while (!(bits = match_free(pos)))
+			pos = (pos + kGroupWidth) & mask;
+		const size_t slot = (pos + lowest_bit(bits)) & mask;
+
+		if (m_ctrl[slot] == kErased)
+			m_erased--;
+		set_ctrl(slot, tag(hash));
+		m_size++;
+		return slot;
+	}
+
+	void insert_unique(const value_type& element)
+	{
+		const size_t slot = prepare_insert(mixed_hash(element.first));
+		new (&m_slots[slot]) value_type(element);
+	}
+
+	void erase_slot(size_t slot)
+	{
+		m_slots[slot].~value_type();
+		set_ctrl(slot, kErased);
+		m_size--;
+		m_erased++;
+	}
+
+	size_t next_full(size_t slot) const
+	{
+		while (slot < m_capacity && m_ctrl[slot] < 0)
+			slot++;
+		return slot;
+	}
+
+	void rehash(size_t capacity)
+	{
+		int8_t* old_ctrl = m_ctrl;
+		value_type* old_slots = m_slots;
+		const size_t old_capacity = m_capacity;
+
+		m_ctrl = new int8_t[capacity + kGroupWidth];
+		std::memset(m_ctrl, kEmpty, capacity + kGroupWidth);
+		m_slots = std::allocator<value_type>().allocate(capacity);
+		m_capacity = capacity;
+		m_size = 0;
+		m_erased = 0;
+
+		for (size_t i = 0; i < old_capacity; i++)
+		{
+			if (old_ctrl[i] < 0)
+				continue;
+			const size_t slot = prepare_insert(mixed_hash(old_slots[i].first));
+			new (&m_slots[slot]) value_type(std::move(old_slots[i]));
+			old_slots[i].~value_type();
+		}
+
+		delete[] old_ctrl;
+		if (old_slots)
+			std::allocator<value_type>().deallocate(old_slots, old_capacity);
+	}
+
+	void destroy_elements()
+	{
+		if (std::is_trivially_destructible<value_type>::value)
+			return;
+		for (size_t i = 0; i < m_capacity; i++)
+		{
+			if (m_ctrl[i] >= 0)
+				m_slots[i].~value_type();
+		}
+	}
+
+	void deallocate()
+	{
+		delete[] m_ctrl;
+		if (m_slots)
+			std::allocator<value_type>().deallocate(m_slots, m_capacity);
+		m_ctrl = nullptr;
+		m_slots = nullptr;
+		m_capacity = 0;
+	}
+
+	/** control byte of every slot */
+	int8_t* m_ctrl = nullptr;
+	/** slots, constructed where the control byte is not negative */
+	value_type* m_slots = nullptr;
+	/** number of slots, a power of two or 0 */
+	size_t m_capacity = 0;
+	/** number of elements */
+	size_t m_size = 0;
+	/** number of erased slots */
+	size_t m_erased = 0;
+};
+} // namespace shogun
+
+#endif // __FLATHASHMAP_H__
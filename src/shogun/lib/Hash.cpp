@@ -345,6 +345,43 @@ uint32_t Hash::MurmurHash3(uint8_t* data, int32_t len, uint32_t seed)
 	return PMurHash32(seed, data, len);
 }
 
+void Hash::MurmurHash3Prefixes(
+		const uint8_t* data, int32_t len, uint32_t seed, uint32_t* hashes)
+{
+	const uint32_t c1=0xcc9e2d51;
+	const uint32_t c2=0x1b873593;
+	auto rotl32=[](uint32_t x, int8_t r) { return (x << r) | (x >> (32 - r)); };
+
+	/* h mixes the complete blocks of four bytes, k holds the bytes of the
+	 * current block (little endian as in PMurHash32) */
+	uint32_t h=seed;
+	uint32_t k=0;
+	for (int32_t i=0; i<len; i++)
+	{
+		k|=uint32_t(data[i]) << (8*(i&3));
+		uint32_t k1=rotl32(k*c1, 15)*c2;
+
+		uint32_t r;
+		if ((i&3)==3)
+		{
+			h=rotl32(h^k1, 13)*5+0xe6546b64;
+			k=0;
+			r=h;
+		}
+		else
+			r=h^k1;
+
+		/* finalization mix of the prefix of length i+1 */
+		r^=uint32_t(i+1);
+		r^=r >> 16;
+		r*=0x85ebca6b;
+		r^=r >> 13;
+		r*=0xc2b2ae35;
+		r^=r >> 16;
+		hashes[i]=r;
+	}
+}
+
 void Hash::IncrementalMurmurHash3(uint32_t *ph1, uint32_t *pcarry, uint8_t* data, int32_t len)
 {
 	PMurHash32_Process(ph1, pcarry, data, len);
@@ -85,6 +85,21 @@ class Hash : public SGObject
 		static uint32_t FinalizeIncrementalMurmurHash3(uint32_t h,
 				uint32_t carry, uint32_t total_length);
 
+		/** Murmur Hash3 of all prefixes of a byte string, i.e.
+		 * hashes[k]=MurmurHash3(data, k+1, seed) for k<len
+		 *
+		 * The hashes are computed in a single pass over the data, which
+		 * makes hashing all k-mers up to order len starting at a position
+		 * as cheap as hashing the longest one.
+		 *
+		 * @param data data to checksum
+		 * @param len length in number of bytes
+		 * @param seed initial seed
+		 * @param hashes array of len hashes
+		 */
+		static void MurmurHash3Prefixes(
+				const uint8_t* data, int32_t len, uint32_t seed, uint32_t* hashes);
+
 		/** Apply Murmur Hash on the non-numeric part of
 		 * a substring.
 		 *
@@ -12,26 +12,24 @@
 
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/common.h>
+#include <shogun/lib/FlatHashMap.h>
 #include <shogun/lib/Hash.h>
 
-#include <cstdio>
-
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Lock.h>
 
+#include <vector>
 
 namespace shogun
 {
 
 #define IGNORE_IN_CLASSLIST
 
-#define MapNode CMapNode<K, T>
-
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 /** hashset node */
 IGNORE_IN_CLASSLIST template<class K, class T> struct CMapNode
 {
-	/** index in hashtable */
+	/** index in the array of nodes, or the next free node if free */
 	int32_t index;
 
 	/** is free? */
@@ -42,47 +40,44 @@ IGNORE_IN_CLASSLIST template<class K, class T> struct CMapNode
 
 	/** data of node */
 	T data;
+};
 
-	/** pointer to left sibling */
-	CMapNode *left;
-
-	/** pointer to right sibling */
-	CMapNode *right;
+/** MurmurHash3 of the bytes of a key */
+IGNORE_IN_CLASSLIST template<class K> struct CMapHash
+{
+	size_t operator()(const K& key) const
+	{
+		return Hash::MurmurHash3((uint8_t*)(&key), sizeof(key), 0xDEADBEEF);
+	}
 };
 #endif
 
 /** @brief the class CMap, a map based on the hash-table.
  * w: http://en.wikipedia.org/wiki/Hash_table
+ *
+ * The nodes are stored in one array and keep their index until they are
+ * removed, the keys are looked up in a FlatHashMap from keys to indices.
  */
 IGNORE_IN_CLASSLIST template<class K, class T> class CMap: public SGObject
 {
 public:
-	/** Custom constructor */
+	/** Custom constructor
+	 *
+	 * @param size number of elements to reserve the hash table for
+	 * @param reserved number of elements to reserve the nodes for
+	 * @param tracable unused, the memory is allocated by std containers
+	 */
 	CMap(int32_t size=41, int32_t reserved=128, bool tracable=true)
+		: index_of_key(size)
 	{
-		hash_size=size;
-		free_index=0;
+		free_index=-1;
 		num_elements=0;
-		use_sg_mallocs=tracable;
-
-		if (use_sg_mallocs)
-			hash_array=SG_CALLOC(MapNode*, size);
-		else
-			hash_array=(CMapNode<K, T>**) calloc(size, sizeof(CMapNode<K, T>*));
-
-		for (int32_t i=0; i<size; i++)
-		{
-			hash_array[i]=NULL;
-		}
-		// can't trace memory allocations when using an std::vector
-		array=new std::vector<CMapNode<K, T>*>();
-		array->reserve(reserved);
+		array.reserve(reserved);
 	}
 
 	/** Default destructor */
 	~CMap() override
 	{
-		destroy_map();
 	}
 
 	/** @return object name */
@@ -92,22 +87,17 @@ public:
 	 *
 	 * @param key key to be added
 	 * @param data data to be added
-	 * @return index of added element
+	 * @return index of added element, -1 if the key is in the map
 	 */
 	int32_t add(const K& key, const T& data)
 	{
-		int32_t index=hash_key(key);
-		if (chain_search(index, key)==NULL)
-		{
-			lock.lock();
-			int32_t added_index=insert_key(index, key, data);
-			num_elements++;
-			lock.unlock();
-
-			return added_index;
-		}
+		lock.lock();
+		int32_t added_index=-1;
+		if (!index_of_key.contains(key))
+			added_index=insert_key(key, data);
+		lock.unlock();
 
-		return -1;
+		return added_index;
 	}
 
 	/** Check an element in the map
@@ -117,11 +107,7 @@ public:
 	 */
 	bool contains(const K& key)
 	{
-		int32_t index=hash_key(key);
-		if (chain_search(index, key)!=NULL)
-			return true;
-
-		return false;
+		return index_of_key.contains(key);
 	}
 
 	/** Remove an element from the set
@@ -130,16 +116,14 @@ public:
 	 */
 	void remove(const K& key)
 	{
-		int32_t index=hash_key(key);
-		CMapNode<K, T>* result=chain_search(index, key);
-
-		if (result!=NULL)
+		lock.lock();
+		auto it=index_of_key.find(key);
+		if (it!=index_of_key.end())
 		{
-			lock.lock();
-			delete_key(index, result);
-			num_elements--;
-			lock.unlock();
+			delete_key(it->second);
+			index_of_key.erase(it);
 		}
+		lock.unlock();
 	}
 
 	/** Index of element in the set
@@ -149,11 +133,9 @@ public:
 	 */
 	int32_t index_of(const K& key)
 	{
-		int32_t index=hash_key(key);
-		CMapNode<K ,T>* result=chain_search(index, key);
-
-		if (result!=NULL)
-			return result->index;
+		auto it=index_of_key.find(key);
+		if (it!=index_of_key.end())
+			return it->second;
 
 		return -1;
 	}
@@ -166,18 +148,11 @@ public:
 	 */
 	T get_element(const K& key)
 	{
-		int32_t index=hash_key(key);
-		CMapNode<K, T>* result=chain_search(index, key);
-
-		if (result!=NULL)
-			return result->data;
-		else
-		{
-			int32_t added_index=add(key, T());
-			result=get_node_ptr(added_index);
+		auto it=index_of_key.find(key);
+		if (it!=index_of_key.end())
+			return array[it->second].data;
 
-			return result->data;
-		}
+		return array[add(key, T())].data;
 	}
 
 	/** Set element by key
@@ -187,16 +162,12 @@ public:
 	 */
 	void set_element(const K& key, const T& data)
 	{
-		int32_t index=hash_key(key);
-		CMapNode<K, T>* result=chain_search(index, key);
-
 		lock.lock();
-
-		if (result!=NULL)
-			result->data=data;
+		auto it=index_of_key.find(key);
+		if (it!=index_of_key.end())
+			array[it->second].data=data;
 		else
-			add(key, data);
-
+			insert_key(key, data);
 		lock.unlock();
 	}
 
@@ -215,7 +186,7 @@ public:
 	 */
 	int32_t get_array_size() const
 	{
-		return array->size();
+		return array.size();
 	}
 
 	/** get element at index as reference
@@ -227,9 +198,8 @@ public:
 	 */
 	T* get_element_ptr(int32_t index)
 	{
-		CMapNode<K, T>* result=array->at(index);
-		if (result!=NULL && !is_free(result))
-			return &(array->at(index)->data);
+		if (!array[index].free)
+			return &(array[index].data);
 		return NULL;
 	}
 
@@ -241,229 +211,107 @@ public:
 	 * @return node at index
 	 */
 	CMapNode<K, T>* get_node_ptr(int32_t index)
-		{
-		return array->at(index);
-		}
-
-	/** @return underlying array of nodes in memory */
-	CMapNode<K, T>** get_array()
-		{
-		return array->get_array();
-		}
-
-	/** assignment operator that copies map */
-	CMap& operator =(const CMap& orig)
 	{
+		return &array[index];
+	}
 
-		destroy_map();
-		use_sg_mallocs = orig.use_sg_mallocs;
-
-		hash_size = orig.hash_size;
-
-		if (use_sg_mallocs)
-			hash_array = SG_CALLOC(MapNode*, hash_size);
-		else
-			hash_array = (CMapNode<K, T>**) calloc(hash_size,
-					sizeof(CMapNode<K, T>*));
-
-		for (int32_t i = 0; i<hash_size; i++)
-		{
-			hash_array[i] = NULL;
-		}
-
-		array = new std::vector<CMapNode<K, T>*>();
-		array->reserve(128);
-
-		for (int i = 0; i < orig.num_elements; i++)
-		{
-			CMapNode<K, T>* node = orig.array->at(i);
-			add(node->key, node->data);
-		}
-
-		return *this;
+	/** @return underlying array of nodes in memory, free nodes included */
+	CMapNode<K, T>* get_array()
+	{
+		return array.data();
 	}
 
-private:
-	/** Returns hash of key
-	 * MurmurHash used
+	/** reserve memory for a number of elements
+	 *
+	 * @param num number of elements
 	 */
-	int32_t hash_key(const K& key)
+	void reserve(int32_t num)
 	{
-		return get_hash_value(key) % hash_size;
+		index_of_key.reserve(num);
+		array.reserve(num);
 	}
 
-	/** is free? */
-	bool is_free(CMapNode<K, T>* node)
+	/** remove all elements, keeping the memory */
+	void clear()
 	{
-		if (node->free==true)
-			return true;
-
-		return false;
+		lock.lock();
+		index_of_key.clear();
+		array.clear();
+		free_index=-1;
+		num_elements=0;
+		lock.unlock();
 	}
 
-	/** Searchs key in list(chain) */
-	CMapNode<K, T>* chain_search(int32_t index, const K& key)
-		{
-		if (hash_array[index]==NULL)
-		{
-			return NULL;
-		}
-		else
+	/** assignment operator that copies map */
+	CMap& operator =(const CMap& orig)
+	{
+		if (this!=&orig)
 		{
-			CMapNode<K, T>* current=hash_array[index];
-			do // iterating all items in the list
+			clear();
+			reserve(orig.num_elements);
+			for (const auto& node : orig.array)
 			{
-				if (current->key==key)
-					return current; // it's a search key
-
-				current=current->right;
-
-			} while (current!=NULL);
-
-			return NULL;
-		}
+				if (!node.free)
+					add(node.key, node.data);
+			}
 		}
 
-	/** Inserts nodes with certain key and data in set */
-	int32_t insert_key(int32_t index, const K& key, const T& data)
+		return *this;
+	}
+
+private:
+	/** Inserts a node with key and data, the lock must be held */
+	int32_t insert_key(const K& key, const T& data)
 	{
 		int32_t new_index;
-		CMapNode<K, T>* new_node;
-
-		if ((free_index>=array->size()) || (array->at(free_index)==NULL))
+		if (free_index<0)
 		{
-			// init new node
-			if (use_sg_mallocs)
-				new_node=SG_CALLOC(MapNode, 1);
-			else
-				new_node=(CMapNode<K, T>*) calloc(1, sizeof(CMapNode<K, T>));
-
-			new (&new_node->key) K();
-			new (&new_node->data) T();
-
-			array->push_back(new_node);
-
-			new_index=free_index;
-			free_index++;
+			new_index=array.size();
+			array.emplace_back();
 		}
 		else
 		{
-			new_node=array->at(free_index);
-			ASSERT(is_free(new_node))
-
 			new_index=free_index;
-			free_index=new_node->index;
-		}
-
-		new_node->index=new_index;
-		new_node->free=false;
-		new_node->key=key;
-		new_node->data=data;
-		new_node->left=NULL;
-		new_node->right=NULL;
-
-		// add new node in start of list
-		if (hash_array[index]==NULL)
-		{
-			hash_array[index]=new_node;
+			ASSERT(array[new_index].free)
+			free_index=array[new_index].index;
 		}
-		else
-		{
-			hash_array[index]->left=new_node;
-			new_node->right=hash_array[index];
 
-			hash_array[index]=new_node;
-		}
+		auto& node=array[new_index];
+		node.index=new_index;
+		node.free=false;
+		node.key=key;
+		node.data=data;
+		index_of_key.emplace(key, new_index);
+		num_elements++;
 
 		return new_index;
 	}
 
-	/** Deletes key from set */
-	void delete_key(int32_t index, CMapNode<K, T>* node)
+	/** Frees the node at an index, the lock must be held */
+	void delete_key(int32_t index)
 	{
-		int32_t temp=0;
-
-		if (node==NULL)
-			return;
-
-		if (node->right!=NULL)
-			node->right->left = node->left;
-
-		if (node->left!=NULL)
-			node->left->right = node->right;
-		else
-			hash_array[index] = node->right;
-
-		temp=node->index;
-
-		node->index=free_index;
-		node->free=true;
-		node->left=NULL;
-		node->right=NULL;
-
-		free_index=temp;
-	}
-
-	/*cleans up map*/
-	void destroy_map()
-	{
-		if (array!=NULL)
-		{
-			for(int32_t i=0; i<array->size(); i++)
-			{
-				CMapNode<K, T>* element = array->at(i);
-				if (element!=NULL)
-				{
-					element->key.~K();
-					element->data.~T();
-
-					if (use_sg_mallocs)
-						SG_FREE(element);
-					else
-						free(element);
-				}
-			}
-			delete array;
-		}
-
-		if (hash_array!=NULL)
-		{
-			if (use_sg_mallocs)
-				SG_FREE(hash_array);
-			else
-				free(hash_array);
-		}
-
+		auto& node=array[index];
+		node.index=free_index;
+		node.free=true;
+		node.key=K();
+		node.data=T();
+		free_index=index;
+		num_elements--;
 	}
 
 protected:
-	/** Get the hash of a given key
-	 * @param key a given key
-	 * @return hash of the key
-	 */
-	virtual uint32_t get_hash_value(const K& key)
-	{
-		return Hash::MurmurHash3((uint8_t*)(&key), sizeof(key), 0xDEADBEEF);
-	}
+	/** index of the node of every key */
+	FlatHashMap<K, int32_t, CMapHash<K>> index_of_key;
 
-	/** whether SG_MALLOC or just malloc etc shall be used */
-	bool use_sg_mallocs;
+	/** nodes, freed nodes are reused */
+	std::vector<CMapNode<K, T>> array;
 
-	/** hashtable size */
-	int32_t hash_size;
-
-	/** next free index for new element */
+	/** first free node, -1 if there is none */
 	int32_t free_index;
 
 	/** number of elements */
 	int32_t num_elements;
 
-	/** array of lists (chains) */
-	CMapNode<K, T>** hash_array;
-
-	/** array for index permission */
-	std::vector<CMapNode<K, T>*>* array;
-
 	/** concurrency lock */
 	Lock lock;
 };
@@ -0,0 +1,75 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/MemoryArena.h>
+
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/memory.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+MemoryArena::MemoryArena(size_t chunk_size)
+    : m_chunk_size(chunk_size), m_chunk(0), m_offset(0), m_bytes_used(0)
+{
+	require(chunk_size>0, "Chunk size must be positive!");
+}
+
+MemoryArena::~MemoryArena()
+{
+	release();
+}
+
+void* MemoryArena::allocate(size_t size, size_t al)
+{
+	require(al && !(al & (al-1)), "Alignment ({}) must be a power of two!", al);
+
+	for (; m_chunk<m_chunks.size(); m_chunk++, m_offset=0)
+	{
+		const Chunk& chunk=m_chunks[m_chunk];
+		const uintptr_t begin=reinterpret_cast<uintptr_t>(chunk.memory)+m_offset;
+		const size_t padding=(al-begin%al)%al;
+		if (m_offset+padding+size<=chunk.size)
+		{
+			m_offset+=padding+size;
+			m_bytes_used+=size;
+			return reinterpret_cast<void*>(begin+padding);
+		}
+	}
+
+	/* no chunk left with enough room */
+	Chunk chunk;
+	chunk.size=std::max(m_chunk_size, size+al);
+	chunk.memory=SG_MALLOC(char, chunk.size);
+	m_chunks.push_back(chunk);
+	m_chunk=m_chunks.size()-1;
+	m_offset=0;
+	return allocate(size, al);
+}
+
+void MemoryArena::reset()
+{
+	m_chunk=0;
+	m_offset=0;
+	m_bytes_used=0;
+}
+
+void MemoryArena::release()
+{
+	for (auto& chunk : m_chunks)
+		SG_FREE(chunk.memory);
+	m_chunks.clear();
+	reset();
+}
+
+size_t MemoryArena::get_bytes_reserved() const
+{
+	size_t bytes=0;
+	for (const auto& chunk : m_chunks)
+		bytes+=chunk.size;
+	return bytes;
+}
@@ -0,0 +1,132 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __MEMORYARENA_H__
+#define __MEMORYARENA_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace shogun
+{
+/** @brief Bump allocator for scratch buffers that are released all at once.
+ *
+ * Blocks are carved from chunks allocated by SG_MALLOC, reset() makes all
+ * blocks available again while keeping the chunks, so a training call that
+ * resets the arena per iteration allocates its buffers only once. Blocks
+ * cannot be freed one by one and must not be passed to SG_FREE, an SGVector
+ * or SGMatrix may view them without reference counting.
+ *
+ * Scope rewinds the arena to its state at construction, for nested scratch
+ * buffers. An arena is not thread-safe, use one per thread.
+ */
+class MemoryArena
+{
+public:
+	/** constructor
+	 *
+	 * @param chunk_size bytes allocated at once
+	 */
+	MemoryArena(size_t chunk_size=size_t(1)<<20);
+
+	~MemoryArena();
+
+	MemoryArena(const MemoryArena&) = delete;
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	/** allocate a block that lives until the next reset
+	 *
+	 * @param size bytes
+	 * @param al alignment, a power of two
+	 * @return block
+	 */
+	void* allocate(size_t size, size_t al=alignof(std::max_align_t));
+
+	/** allocate an uninitialized array
+	 *
+	 * @param len number of elements
+	 * @return array
+	 */
+	template <class T>
+	T* allocate_array(size_t len)
+	{
+		return static_cast<T*>(allocate(sizeof(T)*len, alignof(T)));
+	}
+
+	/** make all blocks available again, keeps the chunks */
+	void reset();
+
+	/** free all chunks */
+	void release();
+
+	/** @return bytes of the blocks allocated since the last reset */
+	size_t get_bytes_used() const
+	{
+		return m_bytes_used;
+	}
+
+	/** @return bytes of all chunks */
+	size_t get_bytes_reserved() const;
+
+	/** @brief Rewinds the arena to its state at construction on
+	 * destruction, freeing the blocks allocated within the scope. */
+	class Scope
+	{
+	public:
+		/** @param arena arena to rewind */
+		Scope(MemoryArena& arena)
+		    : m_arena(arena), m_chunk(arena.m_chunk), m_offset(arena.m_offset),
+		      m_bytes_used(arena.m_bytes_used)
+		{
+		}
+
+		~Scope()
+		{
+			m_arena.m_chunk=m_chunk;
+			m_arena.m_offset=m_offset;
+			m_arena.m_bytes_used=m_bytes_used;
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		MemoryArena& m_arena;
+		size_t m_chunk;
+		size_t m_offset;
+		size_t m_bytes_used;
+	};
+
+private:
+	/** memory of a chunk */
+	struct Chunk
+	{
+		char* memory;
+		size_t size;
+	};
+
+	/** bytes allocated at once */
+	size_t m_chunk_size;
+
+	/** all chunks, the ones after m_chunk are unused */
+	std::vector<Chunk> m_chunks;
+
+	/** chunk that blocks are carved from */
+	size_t m_chunk;
+
+	/** first unused byte of the current chunk */
+	size_t m_offset;
+
+	/** bytes of the blocks allocated since the last reset */
+	size_t m_bytes_used;
+};
+} // namespace shogun
+
+#endif // __MEMORYARENA_H__
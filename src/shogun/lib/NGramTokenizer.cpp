@@ -53,6 +53,14 @@ index_t NGramTokenizer::next_token_idx(index_t& start)
 	return start + n;
 }
 
+void NGramTokenizer::tokenize(const SGVector<char>& txt,
+	std::vector<std::pair<index_t, index_t>>& tokens)
+{
+	tokens.clear();
+	for (index_t start=0; start<=txt.size()-n; start++)
+		tokens.emplace_back(start, start+n);
+}
+
 NGramTokenizer* NGramTokenizer::get_copy()
 {
 	NGramTokenizer* t = new NGramTokenizer(n);
@@ -67,6 +67,14 @@ public:
 
 	NGramTokenizer* get_copy() override;
 
+	/** Finds all n-grams of a text, see Tokenizer::tokenize()
+	 *
+	 * @param txt the text to tokenize
+	 * @param tokens set to the start and end index of every n-gram
+	 */
+	void tokenize(const SGVector<char>& txt,
+		std::vector<std::pair<index_t, index_t>>& tokens) override;
+
 private:
 	void init();
 
@@ -0,0 +1,240 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/Profiler.h>
+#include <shogun/lib/observers/ObservedValueTemplated.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+using namespace shogun;
+
+namespace
+{
+	int64_t steady_nanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           std::chrono::steady_clock::now().time_since_epoch())
+		    .count();
+	}
+
+	std::atomic<int64_t> next_profiler_id{0};
+
+	/** writes a string as JSON string */
+	void write_json_string(std::ostream& stream, const std::string& str)
+	{
+		stream << '"';
+		for (auto c : str)
+		{
+			if (c == '"' || c == '\\')
+				stream << '\\' << c;
+			else if (static_cast<unsigned char>(c) < 0x20)
+				stream << ' ';
+			else
+				stream << c;
+		}
+		stream << '"';
+	}
+} // namespace
+
+Profiler::Profiler()
+    : SGObject(), m_enabled(false), m_tracing(false),
+      m_max_trace_events(int64_t(1) << 22), m_num_trace_events(0),
+      m_origin(steady_nanoseconds()), m_id(next_profiler_id++)
+{
+	watch_method("enabled", &Profiler::is_enabled);
+	watch_method("tracing", &Profiler::is_tracing);
+	watch_method("num_trace_events", &Profiler::get_num_trace_events);
+}
+
+Profiler::~Profiler()
+{
+}
+
+void Profiler::set_enabled(bool enabled)
+{
+	m_enabled.store(enabled);
+	if (!enabled)
+		m_tracing.store(false);
+}
+
+void Profiler::set_tracing(bool tracing)
+{
+	m_tracing.store(tracing);
+	if (tracing)
+		m_enabled.store(true);
+}
+
+void Profiler::set_max_trace_events(int64_t max_events)
+{
+	require(
+	    max_events >= 0, "Maximum number of trace events ({}) must not be "
+	    "negative", max_events);
+	m_max_trace_events.store(max_events);
+}
+
+Profiler::Counter& Profiler::counter(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& counter = m_counters[name];
+	if (!counter)
+		counter = std::make_unique<Counter>(m_enabled);
+	return *counter;
+}
+
+Profiler::Timer& Profiler::timer(const std::string& name)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& timer = m_timers[name];
+	if (!timer)
+		timer = std::make_unique<Timer>(*this, name);
+	return *timer;
+}
+
+std::map<std::string, int64_t> Profiler::get_counters() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::map<std::string, int64_t> result;
+	for (const auto& it : m_counters)
+		result.emplace(it.first, it.second->get());
+	return result;
+}
+
+std::map<std::string, int64_t> Profiler::get_timer_counts() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::map<std::string, int64_t> result;
+	for (const auto& it : m_timers)
+		result.emplace(it.first, it.second->get_count());
+	return result;
+}
+
+std::map<std::string, float64_t> Profiler::get_timer_seconds() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::map<std::string, float64_t> result;
+	for (const auto& it : m_timers)
+		result.emplace(it.first, it.second->get_nanoseconds() * 1e-9);
+	return result;
+}
+
+int64_t Profiler::get_num_trace_events() const
+{
+	return std::min(
+	    m_num_trace_events.load(), m_max_trace_events.load());
+}
+
+void Profiler::reset()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto& it : m_counters)
+		it.second->m_value.store(0);
+	for (auto& it : m_timers)
+	{
+		it.second->m_count.store(0);
+		it.second->m_nanoseconds.store(0);
+	}
+	for (auto& trace : m_thread_traces)
+	{
+		std::lock_guard<std::mutex> trace_lock(trace->mutex);
+		trace->events.clear();
+	}
+	m_num_trace_events.store(0);
+}
+
+void Profiler::observe_counters(int64_t step) const
+{
+	for (const auto& it : get_counters())
+		observe<int64_t>(step, it.first, "Profiling counter", it.second);
+	for (const auto& it : get_timer_seconds())
+	{
+		observe<float64_t>(
+		    step, it.first + ".seconds", "Profiling timer", it.second);
+	}
+}
+
+int64_t Profiler::now() const
+{
+	return steady_nanoseconds() - m_origin;
+}
+
+void Profiler::record(Timer& timer, int64_t start)
+{
+	const auto duration = now() - start;
+	timer.m_count.fetch_add(1, std::memory_order_relaxed);
+	timer.m_nanoseconds.fetch_add(duration, std::memory_order_relaxed);
+
+	if (!is_tracing() ||
+	    m_num_trace_events.fetch_add(1, std::memory_order_relaxed) >=
+	        m_max_trace_events.load(std::memory_order_relaxed))
+		return;
+
+	auto& trace = thread_trace();
+	std::lock_guard<std::mutex> lock(trace.mutex);
+	trace.events.push_back({&timer, start, duration});
+}
+
+Profiler::ThreadTrace& Profiler::thread_trace()
+{
+	// the trace of the calling thread in the last profiler it recorded to,
+	// a thread that alternates between profilers gets a new trace (and
+	// thread id) on every switch, in practice there is only env()->profiler()
+	thread_local int64_t profiler_id = -1;
+	thread_local std::shared_ptr<ThreadTrace> trace;
+	if (profiler_id == m_id)
+		return *trace;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	trace = std::make_shared<ThreadTrace>();
+	trace->thread_id = m_thread_traces.size();
+	m_thread_traces.push_back(trace);
+	profiler_id = m_id;
+	return *trace;
+}
+
+void Profiler::export_trace(std::ostream& stream) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	stream << std::fixed << std::setprecision(3);
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	const char* separator = "\n";
+	for (const auto& trace : m_thread_traces)
+	{
+		std::lock_guard<std::mutex> trace_lock(trace->mutex);
+		for (const auto& event : trace->events)
+		{
+			stream << separator << "{\"name\":";
+			write_json_string(stream, event.timer->m_name);
+			stream << ",\"cat\":\"shogun\",\"ph\":\"X\",\"ts\":"
+			       << event.start * 1e-3 << ",\"dur\":" << event.duration * 1e-3
+			       << ",\"pid\":0,\"tid\":" << trace->thread_id << "}";
+			separator = ",\n";
+		}
+	}
+
+	// counters are shown as tracks with their value at the time of export
+	const auto timestamp = now() * 1e-3;
+	for (const auto& it : m_counters)
+	{
+		stream << separator << "{\"name\":";
+		write_json_string(stream, it.first);
+		stream << ",\"cat\":\"shogun\",\"ph\":\"C\",\"ts\":" << timestamp
+		       << ",\"pid\":0,\"args\":{\"value\":" << it.second->get() << "}}";
+		separator = ",\n";
+	}
+	stream << "\n]}\n";
+}
+
+bool Profiler::export_trace(const std::string& filename) const
+{
+	std::ofstream stream(filename);
+	if (!stream)
+		return false;
+	export_trace(stream);
+	return bool(stream);
+}
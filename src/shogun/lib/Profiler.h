@@ -0,0 +1,296 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/base/ShogunEnv.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+	/** @brief Named counters and scoped timers for the hot paths of the
+	 * library, e.g. kernel cache hits or the time spent in solvers.
+	 *
+	 * Probes are placed with the SG_PROFILE_COUNT and SG_PROFILE_SCOPE
+	 * macros, which are compiled in only if shogun is configured with
+	 * USE_PROFILING, and otherwise cost nothing. A compiled in probe costs
+	 * a relaxed atomic load while profiling is disabled (the default), see
+	 * set_enabled().
+	 *
+	 * The global profiler is env()->profiler(). Its values can be queried
+	 * with get_counters() and get_timer_seconds(), emitted to the
+	 * observers of the profiler (e.g. ParameterObserverTensorBoard) with
+	 * observe_counters(), and, if tracing is enabled, every timed scope
+	 * is recorded and can be exported as Chrome trace JSON with
+	 * export_trace(), which chrome://tracing and Perfetto can open.
+	 *
+	 * Profiling is also enabled by setting the environment variable
+	 * SHOGUN_PROFILING, and tracing by setting SHOGUN_TRACE_FILE to the
+	 * file the trace is written to when the program exits.
+	 */
+	class Profiler : public SGObject
+	{
+	public:
+		/** counter, see SG_PROFILE_COUNT */
+		class Counter
+		{
+		public:
+			Counter(const std::atomic<bool>& enabled) : m_enabled(enabled)
+			{
+			}
+
+			/** adds to the counter if profiling is enabled
+			 * @param n value to add
+			 */
+			void add(int64_t n = 1)
+			{
+				if (m_enabled.load(std::memory_order_relaxed))
+					m_value.fetch_add(n, std::memory_order_relaxed);
+			}
+
+			/** @return value of the counter */
+			int64_t get() const
+			{
+				return m_value.load(std::memory_order_relaxed);
+			}
+
+		private:
+			friend class Profiler;
+
+			const std::atomic<bool>& m_enabled;
+			std::atomic<int64_t> m_value{0};
+		};
+
+		/** timer that accumulates the time of the scopes it measured, see
+		 * SG_PROFILE_SCOPE */
+		class Timer
+		{
+		public:
+			Timer(Profiler& profiler, const std::string& name)
+			    : m_profiler(profiler), m_name(name)
+			{
+			}
+
+			/** @return number of measured scopes */
+			int64_t get_count() const
+			{
+				return m_count.load(std::memory_order_relaxed);
+			}
+
+			/** @return total time of the measured scopes in nanoseconds */
+			int64_t get_nanoseconds() const
+			{
+				return m_nanoseconds.load(std::memory_order_relaxed);
+			}
+
+		private:
+			friend class Profiler;
+
+			Profiler& m_profiler;
+			const std::string m_name;
+			std::atomic<int64_t> m_count{0};
+			std::atomic<int64_t> m_nanoseconds{0};
+		};
+
+		/** measures the time until it is destroyed, if profiling is
+		 * enabled when it is created */
+		class ScopedTimer
+		{
+		public:
+			ScopedTimer(Timer& timer)
+			{
+				if (timer.m_profiler.is_enabled())
+				{
+					m_timer = &timer;
+					m_start = timer.m_profiler.now();
+				}
+			}
+
+			~ScopedTimer()
+			{
+				if (m_timer)
+					m_timer->m_profiler.record(*m_timer, m_start);
+			}
+
+			ScopedTimer(const ScopedTimer&) = delete;
+			ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+		private:
+			Timer* m_timer = nullptr;
+			int64_t m_start = 0;
+		};
+
+		/** constructor */
+		Profiler();
+
+		/** destructor */
+		~Profiler() override;
+
+		/** @return object name */
+		const char* get_name() const override
+		{
+			return "Profiler";
+		}
+
+		/** @param enabled whether probes count and measure */
+		void set_enabled(bool enabled);
+
+		/** @return whether probes count and measure */
+		bool is_enabled() const
+		{
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+
+		/** Enables recording every timed scope for export_trace(), which
+		 * also enables profiling.
+		 *
+		 * @param tracing whether to record timed scopes
+		 */
+		void set_tracing(bool tracing);
+
+		/** @return whether timed scopes are recorded */
+		bool is_tracing() const
+		{
+			return m_tracing.load(std::memory_order_relaxed);
+		}
+
+		/** @param max_events number of recorded scopes after which
+		 * further scopes are only counted, not recorded
+		 */
+		void set_max_trace_events(int64_t max_events);
+
+		/** @param name name
+		 * @return counter of a name, created on first use
+		 */
+		Counter& counter(const std::string& name);
+
+		/** @param name name
+		 * @return timer of a name, created on first use
+		 */
+		Timer& timer(const std::string& name);
+
+		/** @return values of all counters by name */
+		std::map<std::string, int64_t> get_counters() const;
+
+		/** @return number of measured scopes of all timers by name */
+		std::map<std::string, int64_t> get_timer_counts() const;
+
+		/** @return total time of all timers in seconds by name */
+		std::map<std::string, float64_t> get_timer_seconds() const;
+
+		/** @return number of recorded scopes */
+		int64_t get_num_trace_events() const;
+
+		/** sets all counters and timers to zero and discards the
+		 * recorded scopes */
+		void reset();
+
+		/** Emits the value of every counter and the seconds of every timer
+		 * (named "<timer>.seconds") to the observers of the profiler.
+		 *
+		 * @param step step of the observed values
+		 */
+		void observe_counters(int64_t step) const;
+
+		/** Writes the recorded scopes and the current counter values in
+		 * the Chrome trace event format.
+		 *
+		 * @param stream stream to write to
+		 */
+		void export_trace(std::ostream& stream) const;
+
+		/** @param filename file to write the trace to
+		 * @return whether the file could be written
+		 */
+		bool export_trace(const std::string& filename) const;
+
+	private:
+		/** a recorded scope */
+		struct TraceEvent
+		{
+			const Timer* timer;
+			int64_t start;
+			int64_t duration;
+		};
+
+		/** scopes recorded by one thread, so that threads do not contend
+		 * for a lock */
+		struct ThreadTrace
+		{
+			int64_t thread_id;
+			std::mutex mutex;
+			std::vector<TraceEvent> events;
+		};
+
+		/** @return nanoseconds since the profiler was created */
+		int64_t now() const;
+
+		/** accumulates a scope that started at start and records it if
+		 * tracing is enabled */
+		void record(Timer& timer, int64_t start);
+
+		/** @return recorded scopes of the calling thread */
+		ThreadTrace& thread_trace();
+
+		std::atomic<bool> m_enabled;
+		std::atomic<bool> m_tracing;
+		std::atomic<int64_t> m_max_trace_events;
+		std::atomic<int64_t> m_num_trace_events;
+
+		/** creation time, the origin of now() */
+		int64_t m_origin;
+
+		/** unique id among all profilers, to find the thread traces */
+		const int64_t m_id;
+
+		mutable std::mutex m_mutex;
+		std::map<std::string, std::unique_ptr<Counter>> m_counters;
+		std::map<std::string, std::unique_ptr<Timer>> m_timers;
+		std::vector<std::shared_ptr<ThreadTrace>> m_thread_traces;
+	};
+} // namespace shogun
+
+#define SG_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SG_PROFILE_CONCAT(a, b) SG_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef USE_PROFILING
+/** adds N to the counter NAME of the global profiler */
+#define SG_PROFILE_COUNT(NAME, N)                                              \
+	do                                                                         \
+	{                                                                          \
+		static auto& sg_profile_counter =                                      \
+		    shogun::env()->profiler()->counter(NAME);                          \
+		sg_profile_counter.add(N);                                             \
+	} while (0)
+
+/** measures the time until the end of the enclosing scope with the timer
+ * NAME of the global profiler */
+#define SG_PROFILE_SCOPE(NAME)                                                 \
+	static auto& SG_PROFILE_CONCAT(sg_profile_timer_, __LINE__) =              \
+	    shogun::env()->profiler()->timer(NAME);                                \
+	shogun::Profiler::ScopedTimer SG_PROFILE_CONCAT(                           \
+	    sg_profile_scope_, __LINE__)(                                          \
+	    SG_PROFILE_CONCAT(sg_profile_timer_, __LINE__))
+#else
+#define SG_PROFILE_COUNT(NAME, N)                                              \
+	do                                                                         \
+	{                                                                          \
+	} while (0)
+#define SG_PROFILE_SCOPE(NAME)
+#endif
+
+#endif // __PROFILER_H__
@@ -4,6 +4,8 @@
 #include <shogun/lib/config.h>
 #include <shogun/lib/common.h>
 #include <atomic>
+#include <functional>
+#include <utility>
 
 namespace shogun
 {
@@ -19,6 +21,15 @@ public:
 	 */
 	RefCount(int32_t ref_start=0) : rc(ref_start) {};
 
+	/** Constructor for data owned by someone else
+	 *
+	 * @param ref_start starting value for counter
+	 * @param release called instead of freeing the data once the count
+	 * drops to zero, e.g. to drop a reference to the owner
+	 */
+	RefCount(int32_t ref_start, std::function<void()> release)
+		: rc(ref_start), m_release(std::move(release)) {};
+
 	/** Increase ref count
 	 *
 	 * @return the new reference count
@@ -46,9 +57,26 @@ public:
 		return rc.load(std::memory_order_acquire);
 	}
 
+	/** Hand the data back to its owner
+	 *
+	 * @return whether the data is owned by someone else, i.e. whether a
+	 * release function was given, it must not be freed then
+	 */
+	bool release()
+	{
+		if (!m_release)
+			return false;
+
+		m_release();
+		return true;
+	}
+
 private:
 	/** reference count */
     std::atomic<int32_t> rc;
+
+	/** hands the data back to its owner, empty for data that is freed */
+	std::function<void()> m_release;
 };
 }
 
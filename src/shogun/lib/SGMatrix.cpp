@@ -43,6 +43,17 @@ SGMatrix<T>::SGMatrix(T* m, index_t nrows, index_t ncols, bool ref_counting)
 #endif
 }
 
+template <class T>
+SGMatrix<T>::SGMatrix(
+	T* m, index_t nrows, index_t ncols, std::function<void()> release)
+	: SGReferencedData(std::move(release)), matrix(m),
+	num_rows(nrows), num_cols(ncols), gpu_ptr(nullptr)
+{
+#ifdef HAVE_VIENNACL
+    m_on_gpu.store(false, std::memory_order_release);
+#endif
+}
+
 template <class T>
 SGMatrix<T>::SGMatrix(T* m, index_t nrows, index_t ncols, index_t offset)
 	: SGReferencedData(false), matrix(m+offset),
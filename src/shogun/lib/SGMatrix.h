@@ -70,6 +70,19 @@ template<class T> class SGMatrix : public SGReferencedData
 		/** Wraps a matrix around an existing memory segment with an offset */
 		SGMatrix(T* m, index_t nrows, index_t ncols, index_t offset);
 
+		/** Wraps a matrix around column-major memory owned by someone
+		 * else, e.g. a NumPy array, without copying it
+		 *
+		 * The matrix is reference counted as usual, but instead of freeing
+		 * the memory, release is called once the last reference is gone.
+		 *
+		 * @param m data
+		 * @param nrows number of rows
+		 * @param ncols number of columns
+		 * @param release hands the memory back to its owner
+		 */
+		SGMatrix(T* m, index_t nrows, index_t ncols, std::function<void()> release);
+
 		/** Constructor to create new matrix in memory */
 		SGMatrix(index_t nrows, index_t ncols, bool ref_counting=true);
 
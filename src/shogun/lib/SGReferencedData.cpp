@@ -18,6 +18,12 @@ SGReferencedData::SGReferencedData(bool ref_counting) : m_refcount(NULL)
 	ref();
 }
 
+SGReferencedData::SGReferencedData(std::function<void()> release)
+	: m_refcount(new RefCount(0, std::move(release)))
+{
+	ref();
+}
+
 SGReferencedData::SGReferencedData(const SGReferencedData &orig)
 {
 	copy_refcount(orig);
@@ -98,7 +104,10 @@ int32_t SGReferencedData::unref()
 	if (c<=0)
 	{
 		SG_TRACE("unref() refcount {} data {} destroying", c, fmt::ptr(this));
-		free_data();
+		if (m_refcount->release())
+			init_data();
+		else
+			free_data();
 		delete m_refcount;
 		m_refcount=NULL;
 		return 0;
@@ -11,6 +11,8 @@
 
 #include <shogun/lib/common.h>
 
+#include <functional>
+
 namespace shogun
 {
 class RefCount;
@@ -22,6 +24,13 @@ class SGReferencedData
 		/** default constructor */
 		SGReferencedData(bool ref_counting=true);
 
+		/** constructor for data owned by someone else, the data is not
+		 * freed but release is called once the last reference is gone
+		 *
+		 * @param release hands the data back to its owner
+		 */
+		SGReferencedData(std::function<void()> release);
+
 		/** copy constructor */
 		SGReferencedData(const SGReferencedData &orig);
 
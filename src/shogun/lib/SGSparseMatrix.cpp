@@ -1,3 +1,4 @@
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/range.h>
 #include <shogun/io/File.h>
 #include <shogun/io/LibSVMFile.h>
@@ -6,6 +7,9 @@
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace shogun {
 
 template <class T>
@@ -19,14 +23,14 @@ SGSparseMatrix<T>::SGSparseMatrix(SGSparseVector<T>* vecs, index_t num_feat,
 		index_t num_vec, bool ref_counting) :
 	SGReferencedData(ref_counting),
 	num_vectors(num_vec), num_features(num_feat),
-	sparse_matrix(vecs)
+	sparse_matrix(vecs), contiguous_entries(NULL)
 {
 }
 
 template <class T>
 SGSparseMatrix<T>::SGSparseMatrix(index_t num_feat, index_t num_vec, bool ref_counting) :
 	SGReferencedData(ref_counting),
-	num_vectors(num_vec), num_features(num_feat)
+	num_vectors(num_vec), num_features(num_feat), contiguous_entries(NULL)
 {
 	sparse_matrix=SG_MALLOC(SGSparseVector<T>, num_vectors);
 }
@@ -164,6 +168,7 @@ template <class T>
 void SGSparseMatrix<T>::copy_data(const SGReferencedData& orig)
 {
 	sparse_matrix = ((SGSparseMatrix*)(&orig))->sparse_matrix;
+	contiguous_entries = ((SGSparseMatrix*)(&orig))->contiguous_entries;
 	num_vectors = ((SGSparseMatrix*)(&orig))->num_vectors;
 	num_features = ((SGSparseMatrix*)(&orig))->num_features;
 }
@@ -172,6 +177,7 @@ template <class T>
 void SGSparseMatrix<T>::init_data()
 {
 	sparse_matrix = NULL;
+	contiguous_entries = NULL;
 	num_vectors = 0;
 	num_features = 0;
 }
@@ -180,111 +186,157 @@ template <class T>
 void SGSparseMatrix<T>::free_data()
 {
 	SG_FREE(sparse_matrix);
+	SG_FREE(contiguous_entries);
 	num_vectors = 0;
 	num_features = 0;
 }
 
 template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
 {
-	SGSparseMatrix<T> sfm(num_vectors, num_features);
-
-	int32_t* hist=SG_CALLOC(int32_t, num_features);
-
-	// count the lengths of future feature vectors
-	for (int32_t v=0; v<num_vectors; v++)
+	const int32_t num_threads=env()->get_num_threads();
+	int64_t num_entries=0;
+	for (index_t v=0; v<num_vectors; v++)
+		num_entries+=sparse_matrix[v].num_feat_entries;
+
+	// every block of vectors keeps counts of all features, so only use as
+	// many blocks as there are entries to amortize them
+	const int64_t num_blocks=std::max<int64_t>(1, std::min<int64_t>(
+		std::min<int64_t>(num_threads, num_vectors),
+		num_entries/(4*std::max<int64_t>(num_features, 1))));
+	const auto block_begin=[&](int64_t b) {
+		return index_t(b*num_vectors/num_blocks);
+	};
+
+	// count the entries of every future vector in every block
+	std::vector<int64_t> pos(num_blocks*num_features, 0);
+#pragma omp parallel for num_threads(num_threads)
+	for (int64_t b=0; b<num_blocks; b++)
 	{
-		SGSparseVector<T> sv=sparse_matrix[v];
-
-		for (int32_t i=0; i<sv.num_feat_entries; i++)
-			hist[sv.features[i].feat_index]++;
+		int64_t* count=&pos[b*num_features];
+		for (index_t v=block_begin(b); v<block_begin(b+1); v++)
+		{
+			const SGSparseVector<T>& sv=sparse_matrix[v];
+			for (index_t i=0; i<sv.num_feat_entries; i++)
+				count[sv.features[i].feat_index]++;
+		}
 	}
 
-	for (int32_t v=0; v<num_features; v++)
-		sfm[v]=SGSparseVector<T>(hist[v]);
-
-	SG_FREE(hist);
+	// the entries of a future vector are ordered by block, turn the
+	// counts into the position of each block
+	std::vector<int64_t> offsets(num_features+1);
+	int64_t total=0;
+	for (index_t f=0; f<num_features; f++)
+	{
+		offsets[f]=total;
+		for (int64_t b=0; b<num_blocks; b++)
+		{
+			const int64_t count=pos[b*num_features+f];
+			pos[b*num_features+f]=total;
+			total+=count;
+		}
+	}
+	offsets[num_features]=total;
 
-	int32_t* index=SG_CALLOC(int32_t, num_features);
+	SGSparseMatrix<T> sfm;
+	sfm.init_contiguous(num_vectors, num_features, offsets.data());
+	SGSparseVectorEntry<T>* entries=sfm.contiguous_entries;
 
-	// fill future feature vectors with content
-	for (int32_t v=0; v<num_vectors; v++)
+#pragma omp parallel for num_threads(num_threads)
+	for (int64_t b=0; b<num_blocks; b++)
 	{
-		SGSparseVector<T> sv=sparse_matrix[v];
-
-		for (int32_t i=0; i<sv.num_feat_entries; i++)
+		int64_t* next=&pos[b*num_features];
+		for (index_t v=block_begin(b); v<block_begin(b+1); v++)
 		{
-			int32_t vidx=sv.features[i].feat_index;
-			int32_t fidx=v;
-			sfm[vidx].features[index[vidx]].feat_index=fidx;
-			sfm[vidx].features[index[vidx]].entry=sv.features[i].entry;
-			index[vidx]++;
+			const SGSparseVector<T>& sv=sparse_matrix[v];
+			for (index_t i=0; i<sv.num_feat_entries; i++)
+			{
+				SGSparseVectorEntry<T>& entry=
+					entries[next[sv.features[i].feat_index]++];
+				entry.feat_index=v;
+				entry.entry=sv.features[i].entry;
+			}
 		}
 	}
 
-	SG_FREE(index);
 	return sfm;
 }
 
+template <class T>
+void SGSparseMatrix<T>::init_contiguous(
+	index_t num_feat, index_t num_vec, const int64_t* offsets)
+{
+	// detach from the previous data
+	*this=SGSparseMatrix<T>();
+
+	num_features=num_feat;
+	num_vectors=num_vec;
+	sparse_matrix=SG_MALLOC(SGSparseVector<T>, num_vec);
+	contiguous_entries=SG_MALLOC(SGSparseVectorEntry<T>, offsets[num_vec]);
+	for (index_t i=0; i<num_vec; i++)
+	{
+		sparse_matrix[i]=SGSparseVector<T>(
+			contiguous_entries+offsets[i], index_t(offsets[i+1]-offsets[i]),
+			false);
+	}
+}
+
 
 template<class T> void SGSparseMatrix<T>::sort_features()
 {
+	// vectors of contiguous storage cannot be shrunk
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		sparse_matrix[i].sort_features();
+		sparse_matrix[i].sort_features(is_contiguous());
 	}
 }
 
 template<class T> void SGSparseMatrix<T>::from_dense(SGMatrix<T> full)
 {
-	T* src=full.matrix;
-	int32_t num_feat=full.num_rows;
-	int32_t num_vec=full.num_cols;
+	const T* src=full.matrix;
+	const int32_t num_feat=full.num_rows;
+	const int32_t num_vec=full.num_cols;
+	const int32_t num_threads=env()->get_num_threads();
 
 	require(num_vec>0, "Matrix should have > 0 vectors!");
 
 	io::info("converting dense feature matrix to sparse one");
-		int32_t* num_feat_entries=SG_MALLOC(int, num_vec);
-
-
-	int64_t num_total_entries=0;
 
 	// count nr of non sparse features
+	std::vector<int64_t> offsets(num_vec+1, 0);
+#pragma omp parallel for num_threads(num_threads)
 	for (int32_t i=0; i<num_vec; i++)
 	{
-		num_feat_entries[i]=0;
+		const T* col=src+i*int64_t(num_feat);
+		int64_t count=0;
 		for (int32_t j=0; j<num_feat; j++)
-		{
-			if (src[i*((int64_t) num_feat) + j] != static_cast<T>(0))
-				num_feat_entries[i]++;
-		}
+			count+=(col[j]!=static_cast<T>(0));
+		offsets[i+1]=count;
 	}
 
-	num_features=num_feat;
-	num_vectors=num_vec;
-	sparse_matrix=SG_MALLOC(SGSparseVector<T>,num_vec);
+	for (int32_t i=0; i<num_vec; i++)
+		offsets[i+1]+=offsets[i];
+	const int64_t num_total_entries=offsets[num_vec];
 
-	for (int32_t i=0; i< num_vec; i++)
-	{
-		sparse_matrix[i]=SGSparseVector<T>(num_feat_entries[i]);
-		int32_t sparse_feat_idx=0;
+	init_contiguous(num_feat, num_vec, offsets.data());
 
-		for (int32_t j=0; j< num_feat; j++)
+#pragma omp parallel for num_threads(num_threads)
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		const T* col=src+i*int64_t(num_feat);
+		SGSparseVectorEntry<T>* entry=contiguous_entries+offsets[i];
+		for (int32_t j=0; j<num_feat; j++)
 		{
-			int64_t pos= i*num_feat + j;
-
-			if (src[pos] != static_cast<T>(0))
+			if (col[j]!=static_cast<T>(0))
 			{
-				sparse_matrix[i].features[sparse_feat_idx].entry=src[pos];
-				sparse_matrix[i].features[sparse_feat_idx].feat_index=j;
-				sparse_feat_idx++;
-				num_total_entries++;
+				entry->entry=col[j];
+				entry->feat_index=j;
+				entry++;
 			}
 		}
 	}
 
 	io::info("sparse feature matrix has {} entries (full matrix had {}, sparsity {:2.2f}%%)",
 			num_total_entries, int64_t(num_feat)*num_vec, (100.0*num_total_entries)/(int64_t(num_feat)*num_vec));
-	SG_FREE(num_feat_entries);
 }
 
 template <class T>
@@ -16,6 +16,8 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/io/SGIO.h>
 
+#include <algorithm>
+
 namespace shogun
 {
 
@@ -134,12 +136,14 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 				if (i_row==sparse_matrix[i_col].features[i].feat_index)
 					return sparse_matrix[i_col].features[i].entry;
 			}
+			// a new vector, the entries may be part of contiguous_entries
 			index_t j=sparse_matrix[i_col].num_feat_entries;
-			sparse_matrix[i_col].num_feat_entries=j+1;
-			sparse_matrix[i_col].features=SG_REALLOC(SGSparseVectorEntry<T>,
-				sparse_matrix[i_col].features, j, j+1);
-			sparse_matrix[i_col].features[j].feat_index=i_row;
-			sparse_matrix[i_col].features[j].entry=static_cast<T>(0);
+			SGSparseVector<T> vec(j+1);
+			std::copy(sparse_matrix[i_col].features,
+				sparse_matrix[i_col].features+j, vec.features);
+			vec.features[j].feat_index=i_row;
+			vec.features[j].entry=static_cast<T>(0);
+			sparse_matrix[i_col]=vec;
 			return sparse_matrix[i_col].features[j].entry;
 		}
 
@@ -171,15 +175,29 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		 */
 		void save_with_labels(const std::shared_ptr<File>& saver, SGVector<float64_t> labels);
 
-		/** return the transposed of the sparse matrix */
+		/** return the transposed of the sparse matrix
+		 *
+		 * The vectors of the result, i.e. the columns of the features, are
+		 * stored contiguously and have ascending indices. Blocks of vectors
+		 * are counted and scattered in parallel.
+		 */
 		SGSparseMatrix<T> get_transposed();
 
 		/** create a sparse matrix from a dense one
+		 *
+		 * The vectors are stored contiguously and converted in parallel.
 		 *
 		 * @param full the dense matrix to create the sparse one from
 		 */
 		void from_dense(SGMatrix<T> full);
 
+		/** @return whether the entries of all vectors are stored in
+		 * contiguous_entries */
+		bool is_contiguous() const
+		{
+			return contiguous_entries!=NULL;
+		}
+
 		/** sort the indices of the sparse matrix such that they are in ascending order */
 		void sort_features();
 
@@ -206,6 +224,17 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		/** free data */
 		void free_data() override;
 
+	private:
+		/** allocate the vectors in one block of entries
+		 *
+		 * @param num_feat number of features
+		 * @param num_vec number of vectors
+		 * @param offsets first entry of every vector and the total number
+		 * of entries, length num_vec+1
+		 */
+		void init_contiguous(
+			index_t num_feat, index_t num_vec, const int64_t* offsets);
+
 public:
 
 	/// total number of vectors
@@ -217,6 +246,10 @@ public:
 	/// array of sparse vectors of size num_vectors
 	SGSparseVector<T>* sparse_matrix;
 
+	/// entries of all vectors, which do not own them, or NULL if every
+	/// vector owns its entries
+	SGSparseVectorEntry<T>* contiguous_entries;
+
 };
 }
 #endif // __SGSPARSEMATRIX_H__
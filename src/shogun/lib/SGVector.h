@@ -65,6 +65,18 @@ template<class T> class SGVector : public SGReferencedData
 		/** Wraps a vector around an existing memory segment with an offset */
 		SGVector(T* m, index_t len, index_t offset);
 
+		/** Wraps a vector around memory owned by someone else, e.g. a
+		 * NumPy array, without copying it
+		 *
+		 * The vector is reference counted as usual, but instead of freeing
+		 * the memory, release is called once the last reference is gone.
+		 *
+		 * @param v data
+		 * @param len length of the vector
+		 * @param release hands the memory back to its owner
+		 */
+		SGVector(T* v, index_t len, std::function<void()> release);
+
 		/** Constructor to create new vector in memory */
 		SGVector(index_t len, bool ref_counting=true);
 
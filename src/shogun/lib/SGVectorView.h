@@ -0,0 +1,264 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __SGVECTORVIEW_H__
+#define __SGVECTORVIEW_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/common.h>
+
+#include <type_traits>
+
+namespace shogun
+{
+/** @brief Non-owning strided view of the elements of a vector.
+ *
+ * A view is a pointer, a length and a stride, it never touches the
+ * reference count of the storage it looks at, so creating and copying views
+ * in per-vector loops costs no atomic operations. The viewed storage has to
+ * outlive the view. Views of const T are read-only, views of T convert to
+ * them implicitly, as do SGVectors.
+ */
+template <class T>
+class SGVectorView
+{
+public:
+	/** empty view */
+	SGVectorView() : m_data(nullptr), m_size(0), m_stride(1)
+	{
+	}
+
+	/** constructor
+	 *
+	 * @param data first element
+	 * @param size number of elements
+	 * @param stride distance of the elements in memory
+	 */
+	SGVectorView(T* data, index_t size, index_t stride=1)
+	    : m_data(data), m_size(size), m_stride(stride)
+	{
+	}
+
+	/** view of all elements of a vector */
+	template <
+	    class U,
+	    std::enable_if_t<std::is_convertible<U*, T*>::value>* = nullptr>
+	SGVectorView(const SGVector<U>& vec)
+	    : m_data(vec.vector), m_size(vec.vlen), m_stride(1)
+	{
+	}
+
+	/** read-only view of a writable view */
+	template <
+	    class U,
+	    std::enable_if_t<
+	        std::is_convertible<U*, T*>::value &&
+	        !std::is_same<U, T>::value>* = nullptr>
+	SGVectorView(const SGVectorView<U>& other)
+	    : m_data(other.data()), m_size(other.size()), m_stride(other.stride())
+	{
+	}
+
+	/** @return element i */
+	T& operator[](index_t i) const
+	{
+		return m_data[int64_t(i)*m_stride];
+	}
+
+	/** @return first element */
+	T* data() const
+	{
+		return m_data;
+	}
+
+	/** @return number of elements */
+	index_t size() const
+	{
+		return m_size;
+	}
+
+	/** @return distance of the elements in memory */
+	index_t stride() const
+	{
+		return m_stride;
+	}
+
+	/** @return whether the elements are adjacent in memory */
+	bool is_contiguous() const
+	{
+		return m_stride==1 || m_size<=1;
+	}
+
+	/** view of the elements begin to end excluded */
+	SGVectorView slice(index_t begin, index_t end) const
+	{
+		return SGVectorView(m_data+int64_t(begin)*m_stride, end-begin, m_stride);
+	}
+
+	/** @return copy of the elements in a new vector */
+	SGVector<std::remove_const_t<T>> clone() const
+	{
+		SGVector<std::remove_const_t<T>> copy(m_size);
+		for (index_t i=0; i<m_size; ++i)
+			copy[i]=(*this)[i];
+		return copy;
+	}
+
+private:
+	/** first element */
+	T* m_data;
+	/** number of elements */
+	index_t m_size;
+	/** distance of the elements in memory */
+	index_t m_stride;
+};
+
+/** @brief Non-owning view of a column-major block of a matrix.
+ *
+ * Column j of the view starts leading_dimension elements after column j-1,
+ * so views of a range of rows of a matrix address the matrix memory in
+ * place. Like SGVectorView it never touches reference counts.
+ */
+template <class T>
+class SGMatrixView
+{
+public:
+	/** empty view */
+	SGMatrixView()
+	    : m_data(nullptr), m_num_rows(0), m_num_cols(0), m_leading_dimension(0)
+	{
+	}
+
+	/** constructor
+	 *
+	 * @param data first element
+	 * @param num_rows number of rows
+	 * @param num_cols number of columns
+	 * @param leading_dimension distance of the columns in memory, at least
+	 * num_rows
+	 */
+	SGMatrixView(
+	    T* data, index_t num_rows, index_t num_cols, index_t leading_dimension)
+	    : m_data(data), m_num_rows(num_rows), m_num_cols(num_cols),
+	      m_leading_dimension(leading_dimension)
+	{
+	}
+
+	/** view of all elements of a matrix */
+	template <
+	    class U,
+	    std::enable_if_t<std::is_convertible<U*, T*>::value>* = nullptr>
+	SGMatrixView(const SGMatrix<U>& mat)
+	    : m_data(mat.matrix), m_num_rows(mat.num_rows), m_num_cols(mat.num_cols),
+	      m_leading_dimension(mat.num_rows)
+	{
+	}
+
+	/** read-only view of a writable view */
+	template <
+	    class U,
+	    std::enable_if_t<
+	        std::is_convertible<U*, T*>::value &&
+	        !std::is_same<U, T>::value>* = nullptr>
+	SGMatrixView(const SGMatrixView<U>& other)
+	    : m_data(other.data()), m_num_rows(other.num_rows()),
+	      m_num_cols(other.num_cols()),
+	      m_leading_dimension(other.leading_dimension())
+	{
+	}
+
+	/** @return element in row i and column j */
+	T& operator()(index_t i, index_t j) const
+	{
+		return m_data[int64_t(j)*m_leading_dimension+i];
+	}
+
+	/** @return view of column j */
+	SGVectorView<T> col(index_t j) const
+	{
+		return SGVectorView<T>(
+		    m_data+int64_t(j)*m_leading_dimension, m_num_rows, 1);
+	}
+
+	/** @return view of row i */
+	SGVectorView<T> row(index_t i) const
+	{
+		return SGVectorView<T>(m_data+i, m_num_cols, m_leading_dimension);
+	}
+
+	/** view of the columns begin to end excluded */
+	SGMatrixView cols(index_t begin, index_t end) const
+	{
+		return SGMatrixView(
+		    m_data+int64_t(begin)*m_leading_dimension, m_num_rows, end-begin,
+		    m_leading_dimension);
+	}
+
+	/** view of the rows begin to end excluded */
+	SGMatrixView rows(index_t begin, index_t end) const
+	{
+		return SGMatrixView(
+		    m_data+begin, end-begin, m_num_cols, m_leading_dimension);
+	}
+
+	/** @return first element */
+	T* data() const
+	{
+		return m_data;
+	}
+
+	/** @return number of rows */
+	index_t num_rows() const
+	{
+		return m_num_rows;
+	}
+
+	/** @return number of columns */
+	index_t num_cols() const
+	{
+		return m_num_cols;
+	}
+
+	/** @return distance of the columns in memory */
+	index_t leading_dimension() const
+	{
+		return m_leading_dimension;
+	}
+
+	/** @return whether the elements are adjacent in memory */
+	bool is_contiguous() const
+	{
+		return m_leading_dimension==m_num_rows || m_num_cols<=1;
+	}
+
+	/** @return copy of the elements in a new matrix */
+	SGMatrix<std::remove_const_t<T>> clone() const
+	{
+		SGMatrix<std::remove_const_t<T>> copy(m_num_rows, m_num_cols);
+		for (index_t j=0; j<m_num_cols; ++j)
+		{
+			for (index_t i=0; i<m_num_rows; ++i)
+				copy(i, j)=(*this)(i, j);
+		}
+		return copy;
+	}
+
+private:
+	/** first element */
+	T* m_data;
+	/** number of rows */
+	index_t m_num_rows;
+	/** number of columns */
+	index_t m_num_cols;
+	/** distance of the columns in memory */
+	index_t m_leading_dimension;
+};
+} // namespace shogun
+
+#endif // __SGVECTORVIEW_H__
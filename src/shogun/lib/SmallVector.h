@@ -0,0 +1,361 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __SMALLVECTOR_H__
+#define __SMALLVECTOR_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace shogun
+{
+/** @brief Contiguous array that stores up to N elements inside the object.
+ *
+ * Short arrays, e.g. the neighbours of a node or the entries of a hash
+ * bucket, need no allocation and sit next to the other members of their
+ * owner. Longer arrays move to the heap and grow geometrically like a
+ * std::vector. clear() keeps the memory.
+ *
+ * The interface is the part of std::vector shogun uses. Moving a
+ * SmallVector with inline elements moves the elements, so unlike
+ * std::vector it invalidates pointers to them.
+ */
+template <class T, size_t N>
+class SmallVector
+{
+public:
+	using value_type = T;
+	using size_type = size_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+	using reference = T&;
+	using const_reference = const T&;
+
+	SmallVector() = default;
+
+	/** constructor
+	 *
+	 * @param size number of value initialized elements
+	 */
+	explicit SmallVector(size_t size)
+	{
+		resize(size);
+	}
+
+	SmallVector(std::initializer_list<T> elements)
+	{
+		reserve(elements.size());
+		for (const auto& element : elements)
+			push_back(element);
+	}
+
+	SmallVector(const SmallVector& other)
+	{
+		reserve(other.size());
+		std::uninitialized_copy(other.begin(), other.end(), m_data);
+		m_size = other.m_size;
+	}
+
+	SmallVector(SmallVector&& other) noexcept(
+	    std::is_nothrow_move_constructible<T>::value)
+	{
+		take(std::move(other));
+	}
+
+	SmallVector& operator=(const SmallVector& other)
+	{
+		if (this != &other)
+		{
+			clear();
+			reserve(other.size());
+			std::uninitialized_copy(other.begin(), other.end(), m_data);
+			m_size = other.m_size;
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept(
+	    std::is_nothrow_move_constructible<T>::value)
+	{
+		if (this != &other)
+		{
+			clear();
+			release_heap();
+			take(std::move(other));
+		}
+		return *this;
+	}
+
+	~SmallVector()
+	{
+		clear();
+		release_heap();
+	}
+
+	T* data()
+	{
+		return m_data;
+	}
+
+	const T* data() const
+	{
+		return m_data;
+	}
+
+	iterator begin()
+	{
+		return m_data;
+	}
+
+	iterator end()
+	{
+		return m_data + m_size;
+	}
+
+	const_iterator begin() const
+	{
+		return m_data;
+	}
+
+	const_iterator end() const
+	{
+		return m_data + m_size;
+	}
+
+	T& operator[](size_t i)
+	{
+		return m_data[i];
+	}
+
+	const T& operator[](size_t i) const
+	{
+		return m_data[i];
+	}
+
+	T& front()
+	{
+		return m_data[0];
+	}
+
+	const T& front() const
+	{
+		return m_data[0];
+	}
+
+	T& back()
+	{
+		return m_data[m_size - 1];
+	}
+
+	const T& back() const
+	{
+		return m_data[m_size - 1];
+	}
+
+	/** @return number of elements */
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	/** @return whether there are no elements */
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	/** @return number of elements that fit without allocating */
+	size_t capacity() const
+	{
+		return m_capacity;
+	}
+
+	/** @return whether the elements are stored inside the object */
+	bool is_inline() const
+	{
+		return m_data == inline_data();
+	}
+
+	/** allocate memory for a number of elements
+	 *
+	 * @param capacity number of elements
+	 */
+	void reserve(size_t capacity)
+	{
+		if (capacity <= m_capacity)
+			return;
+
+		T* data = std::allocator<T>().allocate(capacity);
+		for (size_t i = 0; i < m_size; i++)
+		{
+			new (data + i) T(std::move_if_noexcept(m_data[i]));
+			m_data[i].~T();
+		}
+		release_heap();
+		m_data = data;
+		m_capacity = capacity;
+	}
+
+	/** change the number of elements, new elements are value
+	 * initialized
+	 *
+	 * @param size number of elements
+	 */
+	void resize(size_t size)
+	{
+		if (size > m_size)
+		{
+			reserve(size);
+			for (size_t i = m_size; i < size; i++)
+				new (m_data + i) T();
+		}
+		else
+		{
+			for (size_t i = size; i < m_size; i++)
+				m_data[i].~T();
+		}
+		m_size = size;
+	}
+
+	/** remove all elements, keeping the memory */
+	void clear()
+	{
+		for (size_t i = 0; i < m_size; i++)
+			m_data[i].~T();
+		m_size = 0;
+	}
+
+	void push_back(const T& element)
+	{
+		emplace_back(element);
+	}
+
+	void push_back(T&& element)
+	{
+		emplace_back(std::move(element));
+	}
+
+	template <class... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity)
+		{
+			// the argument may be an element of the array
+			T element(std::forward<Args>(args)...);
+			reserve(2 * m_capacity);
+			new (m_data + m_size) T(std::move(element));
+		}
+		else
+			new (m_data + m_size) T(std::forward<Args>(args)...);
+		return m_data[m_size++];
+	}
+
+	void pop_back()
+	{
+		m_data[--m_size].~T();
+	}
+
+	/** insert an element
+	 *
+	 * @param pos position to insert at
+	 * @param element element
+	 * @return iterator to the inserted element
+	 */
+	iterator insert(const_iterator pos, const T& element)
+	{
+		const size_t index = pos - m_data;
+		emplace_back(element);
+		std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+		return m_data + index;
+	}
+
+	/** remove an element
+	 *
+	 * @param pos position of the element
+	 * @return iterator to the element after the removed one
+	 */
+	iterator erase(const_iterator pos)
+	{
+		const size_t index = pos - m_data;
+		std::move(m_data + index + 1, m_data + m_size, m_data + index);
+		pop_back();
+		return m_data + index;
+	}
+
+	bool operator==(const SmallVector& other) const
+	{
+		return std::equal(begin(), end(), other.begin(), other.end());
+	}
+
+	bool operator!=(const SmallVector& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+	T* inline_data()
+	{
+		return reinterpret_cast<T*>(&m_inline);
+	}
+
+	const T* inline_data() const
+	{
+		return reinterpret_cast<const T*>(&m_inline);
+	}
+
+	void release_heap()
+	{
+		if (!is_inline())
+		{
+			std::allocator<T>().deallocate(m_data, m_capacity);
+			m_data = inline_data();
+			m_capacity = N;
+		}
+	}
+
+	/** move the elements of other, which is left empty */
+	void take(SmallVector&& other)
+	{
+		if (other.is_inline())
+		{
+			for (size_t i = 0; i < other.m_size; i++)
+				new (m_data + i) T(std::move(other.m_data[i]));
+			m_size = other.m_size;
+			other.clear();
+		}
+		else
+		{
+			m_data = other.m_data;
+			m_capacity = other.m_capacity;
+			m_size = other.m_size;
+			other.m_data = other.inline_data();
+			other.m_capacity = N;
+			other.m_size = 0;
+		}
+	}
+
+	/** storage of the inline elements */
+	typename std::aligned_storage<sizeof(T) * (N ? N : 1), alignof(T)>::type
+	    m_inline;
+	/** inline storage or heap array */
+	T* m_data = inline_data();
+	/** number of elements */
+	size_t m_size = 0;
+	/** number of elements that fit into m_data */
+	size_t m_capacity = N;
+};
+} // namespace shogun
+
+#endif // __SMALLVECTOR_H__
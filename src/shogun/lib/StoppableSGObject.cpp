@@ -12,12 +12,67 @@
 
 using namespace shogun;
 
+namespace
+{
+	/** computation running on this thread */
+	thread_local StoppableSGObject* current = nullptr;
+}
+
+StoppableSGObject::ComputationScope::ComputationScope(StoppableSGObject* object)
+    : m_object(object), m_previous(current)
+{
+	if (!m_object)
+		return;
+
+	if (m_object->m_num_scopes.fetch_add(1) == 0)
+	{
+		m_object->m_parent = m_previous != m_object ? m_previous : nullptr;
+		m_object->m_budget_expired = false;
+		m_object->m_num_iterations = 0;
+		if (m_object->m_time_budget > 0)
+		{
+			m_object->m_deadline =
+			    std::chrono::steady_clock::now() +
+			    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			        std::chrono::duration<float64_t>(m_object->m_time_budget));
+			m_object->m_has_deadline = true;
+		}
+	}
+	current = m_object;
+}
+
+StoppableSGObject::ComputationScope::~ComputationScope()
+{
+	if (!m_object)
+		return;
+
+	current = m_previous;
+	if (m_object->m_num_scopes.fetch_sub(1) == 1)
+	{
+		m_object->m_has_deadline = false;
+		m_object->m_parent = nullptr;
+	}
+}
+
+StoppableSGObject* StoppableSGObject::current_computation()
+{
+	return current;
+}
+
 StoppableSGObject::StoppableSGObject() : SGObject()
 {
 	m_cancel_computation = false;
 	m_pause_computation_flag = false;
 
 	m_callback = nullptr;
+
+	m_time_budget = 0;
+	m_iteration_budget = 0;
+	m_has_deadline = false;
+	m_num_iterations = 0;
+	m_budget_expired = false;
+	m_num_scopes = 0;
+	m_parent = nullptr;
 };
 
 StoppableSGObject::~StoppableSGObject(){};
@@ -41,6 +96,34 @@ void StoppableSGObject::set_callback(std::function<bool()> callback)
 	m_callback = std::move(callback);
 }
 
+void StoppableSGObject::stop_computation()
+{
+	on_next();
+}
+
+void StoppableSGObject::set_time_budget(float64_t seconds)
+{
+	require(
+	    seconds >= 0, "{}::set_time_budget(): Budget ({}) must not be negative",
+	    get_name(), seconds);
+	m_time_budget = seconds;
+}
+
+void StoppableSGObject::set_iteration_budget(int64_t num_iterations)
+{
+	require(
+	    num_iterations >= 0,
+	    "{}::set_iteration_budget(): Budget ({}) must not be negative",
+	    get_name(), num_iterations);
+	m_iteration_budget = num_iterations;
+}
+
+void StoppableSGObject::expire_budget() const
+{
+	m_budget_expired.store(true);
+	m_cancel_computation.store(true);
+}
+
 void StoppableSGObject::reset_computation_variables()
 {
 	m_cancel_computation = false;
@@ -9,6 +9,8 @@
 
 #include <shogun/base/SGObject.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 
@@ -17,14 +19,59 @@ namespace shogun
 #define COMPUTATION_CONTROLLERS                                                \
 	if (this->cancel_computation())                                            \
 		break;                                                                 \
-	this->pause_computation();
+	this->pause_computation();                                                 \
+	this->count_iteration();
 
 	/**
 	 * Class that abstracts all premature stopping code
+	 *
+	 * Besides the signal handler and stop_computation(), a computation is
+	 * stopped when its time or iteration budget expires. The budgets are
+	 * started by a ComputationScope, e.g. in Machine::train(), and checked
+	 * by cancel_computation(), so solvers return what they have computed so
+	 * far. A computation started within another one on the same thread,
+	 * e.g. the training of a sub-machine, is also stopped with it.
 	 */
 	class StoppableSGObject : public SGObject
 	{
 	public:
+#ifndef SWIG
+		/** @brief Runs a computation of an object on the current thread.
+		 *
+		 * The first scope of an object starts its budgets and links it to
+		 * the computation that is current on the thread. Parallel regions
+		 * pass the current_computation() of the calling thread to a scope
+		 * on each worker thread, so computations started there are linked
+		 * as well. Scopes of a NULL object do nothing.
+		 */
+		class ComputationScope
+		{
+		public:
+			/** constructor
+			 *
+			 * @param object object whose computation runs, may be NULL
+			 */
+			explicit ComputationScope(StoppableSGObject* object);
+
+			/** destructor, stops the budgets with the last scope */
+			~ComputationScope();
+
+			ComputationScope(const ComputationScope&) = delete;
+			ComputationScope& operator=(const ComputationScope&) = delete;
+
+		private:
+			/** object whose computation runs */
+			StoppableSGObject* m_object;
+			/** computation that was current on the thread before */
+			StoppableSGObject* m_previous;
+		};
+
+		/** @return the computation running on the current thread, NULL if
+		 * there is none. Code that is not part of a StoppableSGObject, e.g.
+		 * kernels, checks it for cancellation. */
+		static StoppableSGObject* current_computation();
+#endif
+
 		/** constructor */
 		StoppableSGObject();
 
@@ -35,9 +82,32 @@ namespace shogun
 		/** @return whether the algorithm needs to be stopped */
 		SG_FORCED_INLINE bool cancel_computation() const
 		{
+			if (m_cancel_computation.load(std::memory_order_relaxed))
+				return true;
+
+			if (m_has_deadline.load(std::memory_order_relaxed) &&
+			    std::chrono::steady_clock::now() >= m_deadline)
+			{
+				expire_budget();
+				return true;
+			}
+
+			if (m_parent && m_parent->cancel_computation())
+				return true;
+
 			/* Execute the callback, if present*/
-			return (m_callback) ? (m_cancel_computation.load() || m_callback())
-			                    : m_cancel_computation.load();
+			return m_callback && m_callback();
+		}
+
+		/** Count an iteration of the computation against the iteration
+		 * budget. Safe to call from parallel regions. */
+		SG_FORCED_INLINE void count_iteration()
+		{
+			if (m_iteration_budget > 0 &&
+			    m_num_scopes.load(std::memory_order_relaxed) > 0 &&
+			    m_num_iterations.fetch_add(1, std::memory_order_relaxed) + 1 >=
+			        m_iteration_budget)
+				expire_budget();
 		}
 #endif
 
@@ -64,6 +134,12 @@ namespace shogun
 		}
 #endif
 
+		/** Request the current computation to stop, e.g. from another
+		 * thread. Has the same effect as a premature stop from the signal
+		 * handler, the flag is reset when the computation returns.
+		 */
+		void stop_computation();
+
 		/**
 		 * Set an additional stopping condition
 		 * @param callback method that implements an additional stopping
@@ -71,6 +147,41 @@ namespace shogun
 		 */
 		void set_callback(std::function<bool()> callback);
 
+		/** Set the wall time budget of a computation, e.g. train(). When it
+		 * expires, the computation stops and keeps what it has computed so
+		 * far.
+		 *
+		 * @param seconds budget in seconds, 0 for none
+		 */
+		void set_time_budget(float64_t seconds);
+
+		/** @return wall time budget of a computation in seconds */
+		float64_t get_time_budget() const
+		{
+			return m_time_budget;
+		}
+
+		/** Set the iteration budget of a computation, e.g. train(). The
+		 * iterations are the steps of the training loops, e.g. the
+		 * iterations of an IterativeMachine or of the SMO solvers.
+		 *
+		 * @param num_iterations budget in iterations, 0 for none
+		 */
+		void set_iteration_budget(int64_t num_iterations);
+
+		/** @return iteration budget of a computation */
+		int64_t get_iteration_budget() const
+		{
+			return m_iteration_budget;
+		}
+
+		/** @return whether the last computation was stopped because a
+		 * budget expired */
+		bool budget_expired() const
+		{
+			return m_budget_expired.load();
+		}
+
 		const char* get_name() const override
 		{
 			return "StoppableSGObject";
@@ -83,6 +194,9 @@ namespace shogun
 		/** reset the computation variables */
 		void reset_computation_variables();
 
+		/** stops the computation because a budget expired */
+		void expire_budget() const;
+
 		/** sets cancel computation flag */
 		void on_next();
 
@@ -104,7 +218,7 @@ namespace shogun
 
 	protected:
 		/** Cancel computation */
-		std::atomic<bool> m_cancel_computation;
+		mutable std::atomic<bool> m_cancel_computation;
 
 		/** Pause computation flag */
 		std::atomic<bool> m_pause_computation_flag;
@@ -116,6 +230,30 @@ namespace shogun
 		std::mutex m_mutex;
 
 		std::function<bool(void)> m_callback;
+
+		/** Wall time budget in seconds, 0 for none */
+		float64_t m_time_budget;
+
+		/** Iteration budget, 0 for none */
+		int64_t m_iteration_budget;
+
+		/** Deadline of the running computation */
+		std::chrono::steady_clock::time_point m_deadline;
+
+		/** Whether the running computation has a deadline */
+		std::atomic<bool> m_has_deadline;
+
+		/** Iterations of the running computation */
+		std::atomic<int64_t> m_num_iterations;
+
+		/** Whether a budget of the last computation expired */
+		mutable std::atomic<bool> m_budget_expired;
+
+		/** Number of scopes the computation runs in */
+		std::atomic<int32_t> m_num_scopes;
+
+		/** Computation the running one was started in */
+		StoppableSGObject* m_parent;
 	};
 }
 #endif
@@ -0,0 +1,291 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/TCPCommunicator.h>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+using namespace shogun;
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+static void send_all(int socket, const void* buffer, size_t length)
+{
+	const char* data=(const char*)buffer;
+	while (length>0)
+	{
+		const ssize_t sent=::send(socket, data, length, SEND_FLAGS);
+		if (sent<=0)
+			error("Sending to peer failed: {}", strerror(errno));
+		data+=sent;
+		length-=sent;
+	}
+}
+
+static void receive_all(int socket, void* buffer, size_t length)
+{
+	char* data=(char*)buffer;
+	while (length>0)
+	{
+		const ssize_t received=::recv(socket, data, length, 0);
+		if (received<=0)
+			error("Receiving from peer failed: {}",
+				received==0 ? "connection closed" : strerror(errno));
+		data+=received;
+		length-=received;
+	}
+}
+
+TCPCommunicator::TCPCommunicator() : Communicator()
+{
+	init();
+}
+
+TCPCommunicator::TCPCommunicator(
+	int32_t rank, int32_t size, const std::string& host, int32_t port,
+	int32_t timeout)
+	: Communicator()
+{
+	init();
+
+	require(size>0, "Number of processes ({}) must be positive!", size);
+	require(rank>=0 && rank<size, "Rank ({}) must be in [0, {})!", rank,
+		size);
+	require(port>=0 && port<65536, "Invalid port ({})!", port);
+	m_rank=rank;
+	m_size=size;
+	m_host=host;
+	m_port=port;
+	m_timeout=timeout;
+
+	if (m_rank==0 && m_size>1)
+		listen_on_port();
+}
+
+TCPCommunicator::~TCPCommunicator()
+{
+	close_sockets();
+}
+
+void TCPCommunicator::init()
+{
+	m_rank=0;
+	m_size=1;
+	m_port=0;
+	m_timeout=60;
+	m_listen_socket=-1;
+
+	SG_ADD(&m_rank, "rank", "Rank of this process.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_size, "size", "Number of processes.",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_port, "port", "Port of rank 0.", ParameterProperties::SETTING);
+	SG_ADD(&m_timeout, "timeout", "Seconds to retry connecting to rank 0.",
+		ParameterProperties::SETTING);
+}
+
+void TCPCommunicator::listen_on_port()
+{
+	m_listen_socket=::socket(AF_INET, SOCK_STREAM, 0);
+	if (m_listen_socket<0)
+		error("Creating socket failed: {}", strerror(errno));
+
+	int reuse=1;
+	setsockopt(m_listen_socket, SOL_SOCKET, SO_REUSEADDR, &reuse,
+		sizeof(reuse));
+
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family=AF_INET;
+	address.sin_addr.s_addr=htonl(INADDR_ANY);
+	address.sin_port=htons(m_port);
+	if (::bind(m_listen_socket, (sockaddr*)&address, sizeof(address))<0 ||
+		::listen(m_listen_socket, m_size)<0)
+	{
+		close_sockets();
+		error("Listening on port {} failed: {}", m_port, strerror(errno));
+	}
+
+	socklen_t length=sizeof(address);
+	getsockname(m_listen_socket, (sockaddr*)&address, &length);
+	m_port=ntohs(address.sin_port);
+}
+
+void TCPCommunicator::connect()
+{
+	if (m_size==1 || !m_sockets.empty())
+		return;
+
+	int nodelay=1;
+	if (m_rank==0)
+	{
+		m_sockets.assign(m_size-1, -1);
+		for (int32_t i=1; i<m_size; i++)
+		{
+			const int socket=::accept(m_listen_socket, NULL, NULL);
+			if (socket<0)
+				error("Accepting connection failed: {}", strerror(errno));
+
+			int32_t rank;
+			receive_all(socket, &rank, sizeof(rank));
+			if (rank<=0 || rank>=m_size || m_sockets[rank-1]!=-1)
+			{
+				::close(socket);
+				error("Invalid or duplicate rank ({}) connected!", rank);
+			}
+			setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &nodelay,
+				sizeof(nodelay));
+			m_sockets[rank-1]=socket;
+		}
+		return;
+	}
+
+	addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family=AF_UNSPEC;
+	hints.ai_socktype=SOCK_STREAM;
+	addrinfo* addresses=NULL;
+	const std::string port=std::to_string(m_port);
+	if (getaddrinfo(m_host.c_str(), port.c_str(), &hints, &addresses)!=0)
+		error("Cannot resolve host {}!", m_host);
+
+	const auto deadline=std::chrono::steady_clock::now()+
+		std::chrono::seconds(m_timeout);
+	int socket=-1;
+	while (socket<0)
+	{
+		for (addrinfo* a=addresses; a && socket<0; a=a->ai_next)
+		{
+			socket=::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+			if (socket>=0 && ::connect(socket, a->ai_addr, a->ai_addrlen)<0)
+			{
+				::close(socket);
+				socket=-1;
+			}
+		}
+
+		if (socket<0)
+		{
+			if (std::chrono::steady_clock::now()>deadline)
+			{
+				freeaddrinfo(addresses);
+				error("Connecting to {}:{} failed!", m_host, m_port);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+	}
+	freeaddrinfo(addresses);
+
+	setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+	send_all(socket, &m_rank, sizeof(m_rank));
+	m_sockets.push_back(socket);
+}
+
+void TCPCommunicator::close_sockets()
+{
+	for (auto socket : m_sockets)
+	{
+		if (socket>=0)
+			::close(socket);
+	}
+	m_sockets.clear();
+
+	if (m_listen_socket>=0)
+		::close(m_listen_socket);
+	m_listen_socket=-1;
+}
+
+int TCPCommunicator::socket_of(int32_t peer) const
+{
+	return m_rank==0 ? m_sockets[peer-1] : m_sockets[0];
+}
+
+void TCPCommunicator::send_vector(int32_t peer, const SGVector<float64_t>& data)
+{
+	const int socket=socket_of(peer);
+	const int64_t length=data.vlen;
+	send_all(socket, &length, sizeof(length));
+	send_all(socket, data.vector, sizeof(float64_t)*data.vlen);
+}
+
+void TCPCommunicator::receive_vector(int32_t peer, SGVector<float64_t>& data)
+{
+	const int socket=socket_of(peer);
+	int64_t length;
+	receive_all(socket, &length, sizeof(length));
+	require(length==data.vlen,
+		"Length of the vector of rank {} ({}) does not match ({})!", peer,
+		length, data.vlen);
+	receive_all(socket, data.vector, sizeof(float64_t)*data.vlen);
+}
+
+void TCPCommunicator::allreduce_sum(SGVector<float64_t>& data)
+{
+	if (m_size==1)
+		return;
+
+	connect();
+	if (m_rank==0)
+	{
+		SGVector<float64_t> buffer(data.vlen);
+		for (int32_t peer=1; peer<m_size; peer++)
+		{
+			receive_vector(peer, buffer);
+			for (index_t i=0; i<data.vlen; i++)
+				data[i]+=buffer[i];
+		}
+		for (int32_t peer=1; peer<m_size; peer++)
+			send_vector(peer, data);
+	}
+	else
+	{
+		send_vector(0, data);
+		receive_vector(0, data);
+	}
+}
+
+void TCPCommunicator::broadcast(SGVector<float64_t>& data, int32_t root)
+{
+	require(root>=0 && root<m_size, "Root ({}) must be in [0, {})!", root,
+		m_size);
+	if (m_size==1)
+		return;
+
+	connect();
+	// a root other than rank 0 sends its vector to rank 0 first
+	if (root!=0)
+	{
+		if (m_rank==root)
+			send_vector(0, data);
+		else if (m_rank==0)
+			receive_vector(root, data);
+	}
+
+	if (m_rank==0)
+	{
+		for (int32_t peer=1; peer<m_size; peer++)
+		{
+			if (peer!=root)
+				send_vector(peer, data);
+		}
+	}
+	else if (m_rank!=root)
+		receive_vector(0, data);
+}
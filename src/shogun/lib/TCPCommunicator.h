@@ -0,0 +1,126 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _TCPCOMMUNICATOR_H__
+#define _TCPCOMMUNICATOR_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/Communicator.h>
+#include <shogun/lib/common.h>
+
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+/** @brief Communicator over TCP sockets in a star topology.
+ *
+ * The process of rank 0 listens on the given port, all other processes
+ * connect to it. The connections are established on the first collective
+ * operation, a process of rank>0 retries to connect for the given timeout
+ * so the processes can be started in any order.
+ *
+ * allreduce_sum() gathers the vectors on rank 0, sums them in rank order
+ * and sends the sum back, so all processes get identical results. It needs
+ * no MPI installation, which makes it suitable for a handful of machines;
+ * for larger clusters an MPI based Communicator is preferable.
+ */
+class TCPCommunicator : public Communicator
+{
+public:
+	/** default constructor, a single process */
+	TCPCommunicator();
+
+	/** constructor
+	 *
+	 * @param rank rank of this process
+	 * @param size number of processes
+	 * @param host host name or address of the process of rank 0
+	 * @param port port of the process of rank 0, 0 lets rank 0 choose a
+	 * free port, see get_port()
+	 * @param timeout seconds a process of rank>0 tries to connect
+	 */
+	TCPCommunicator(
+		int32_t rank, int32_t size, const std::string& host, int32_t port,
+		int32_t timeout=60);
+
+	~TCPCommunicator() override;
+
+	int32_t get_rank() const override
+	{
+		return m_rank;
+	}
+
+	int32_t get_size() const override
+	{
+		return m_size;
+	}
+
+	/** @return port the process of rank 0 listens on */
+	int32_t get_port() const
+	{
+		return m_port;
+	}
+
+	using Communicator::allreduce_sum;
+
+	void allreduce_sum(SGVector<float64_t>& data) override;
+
+	void broadcast(SGVector<float64_t>& data, int32_t root=0) override;
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "TCPCommunicator";
+	}
+
+private:
+	void init();
+
+	/** bind the listening socket of rank 0 */
+	void listen_on_port();
+
+	/** accept the connections of all other ranks, or connect to rank 0 */
+	void connect();
+
+	/** close all sockets */
+	void close_sockets();
+
+	/** send a vector, preceded by its length */
+	void send_vector(int32_t peer, const SGVector<float64_t>& data);
+
+	/** receive a vector into data, the lengths have to match */
+	void receive_vector(int32_t peer, SGVector<float64_t>& data);
+
+	/** socket of a peer, for rank>0 the only peer is rank 0 */
+	int socket_of(int32_t peer) const;
+
+protected:
+	/** rank of this process */
+	int32_t m_rank;
+
+	/** number of processes */
+	int32_t m_size;
+
+	/** port of rank 0 */
+	int32_t m_port;
+
+	/** seconds to retry connecting to rank 0 */
+	int32_t m_timeout;
+
+private:
+	/** host of rank 0 */
+	std::string m_host;
+
+	/** listening socket of rank 0 */
+	int m_listen_socket;
+
+	/** sockets of ranks 1..size-1 on rank 0, socket of rank 0 otherwise */
+	std::vector<int> m_sockets;
+};
+}
+#endif /* _TCPCOMMUNICATOR_H__ */
@@ -1,5 +1,7 @@
 #include <shogun/lib/Tokenizer.h>
 
+#include <memory>
+
 namespace shogun
 {
 
@@ -18,6 +20,21 @@ void Tokenizer::set_text(SGVector<char> txt)
 	text = txt;
 }
 
+void Tokenizer::tokenize(const SGVector<char>& txt,
+	std::vector<std::pair<index_t, index_t>>& tokens)
+{
+	tokens.clear();
+
+	std::unique_ptr<Tokenizer> local_tokenizer(get_copy());
+	local_tokenizer->set_text(txt);
+	index_t start = 0;
+	while (local_tokenizer->has_next())
+	{
+		index_t end = local_tokenizer->next_token_idx(start);
+		tokens.emplace_back(start, end);
+	}
+}
+
 void Tokenizer::init()
 {
 	SG_ADD(&text, "text", "The text");
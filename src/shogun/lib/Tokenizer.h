@@ -12,6 +12,9 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/SGVector.h>
 
+#include <utility>
+#include <vector>
+
 namespace shogun
 {
 class SGObject;
@@ -19,7 +22,8 @@ template<class T> class SGVector;
 
 /** @brief The class Tokenizer acts as a base class in order
  * to implement tokenizers. Sub-classes must implement
- * the methods has_next(), next_token_idx() and get_copy().
+ * the methods has_next(), next_token_idx() and get_copy(), and should
+ * override tokenize() to find all tokens of a text in one pass.
  */
 class Tokenizer: public SGObject
 {
@@ -60,6 +64,20 @@ public:
 	 */
 	virtual Tokenizer* get_copy()=0;
 
+	/** Finds all tokens of a text at once, the same tokens as
+	 * has_next() and next_token_idx() after set_text(txt).
+	 *
+	 * Does not change the state of the tokenizer, so that many texts can
+	 * be tokenized concurrently with the same instance. The default
+	 * implementation iterates over a copy of the tokenizer.
+	 *
+	 * @param txt the text to tokenize
+	 * @param tokens set to the start and end index of every token, the
+	 * buffer can be reused between texts
+	 */
+	virtual void tokenize(const SGVector<char>& txt,
+		std::vector<std::pair<index_t, index_t>>& tokens);
+
 private:
 	void init();
 
@@ -11,9 +11,14 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/base/ShogunEnv.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace shogun
 {
@@ -248,6 +253,25 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public SGObject
 			int32_t i, int32_t seq_offset, int32_t* vec, float32_t alpha,
 			float64_t *weights, bool degree_times_position_weights);
 
+		/** add examples to the trees of all positions, like add_to_trie()
+		 * for every example and position
+		 *
+		 * the trees are built in parallel, every thread builds the trees of
+		 * its positions in a trie of its own, which is copied into this trie
+		 * afterwards with the children of a node next to each other. The
+		 * trees have to be empty, e.g. after delete_trees().
+		 *
+		 * @param vecs symbols of every example
+		 * @param alphas alpha of every example
+		 * @param weights weights
+		 * @param degree_times_position_weights if degree times position
+		 *                                      weights shall be applied
+		 */
+		void add_examples_to_trie(
+			const std::vector<SGVector<int32_t>>& vecs,
+			const std::vector<float64_t>& alphas, float64_t* weights,
+			bool degree_times_position_weights);
+
 		/** compute absolute weights tree
 		 *
 		 * @param tree tree to compute for
@@ -538,6 +562,18 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public SGObject
 			return weights_in_tree;
 		}
 
+		/** copy a tree of another trie into a node, the nodes of the
+		 * subtree are taken from the reserved tree memory
+		 *
+		 * @param other trie to copy from
+		 * @param other_node node of the tree in other
+		 * @param node node to copy into
+		 * @param depth depth of the node
+		 */
+		void copy_tree(
+			const CTrie & other, int32_t other_node, int32_t node,
+			int32_t depth);
+
 		/** POIMs extract W helper
 		 *
 		 * @param nodeIdx node index
@@ -1665,6 +1701,89 @@ void CTrie<Trie>::add_to_trie(
 	}
 }
 
+	template <class Trie>
+void CTrie<Trie>::add_examples_to_trie(
+	const std::vector<SGVector<int32_t>>& vecs,
+	const std::vector<float64_t>& alphas, float64_t* weights,
+	bool degree_times_position_weights)
+{
+	ASSERT(vecs.size()==alphas.size())
+	const int32_t num_threads=std::min(env()->get_num_threads(), length);
+	if (num_threads<=1)
+	{
+		for (size_t e=0; e<vecs.size(); e++)
+		{
+			for (int32_t i=0; i<length; i++)
+				add_to_trie(i, 0, vecs[e].vector, alphas[e], weights,
+					degree_times_position_weights);
+		}
+		return;
+	}
+
+	#pragma omp parallel num_threads(num_threads)
+	{
+		CTrie<Trie> part(degree, use_compact_terminal_nodes);
+		part.create(length, use_compact_terminal_nodes);
+		part.weights_in_tree=weights_in_tree;
+		part.position_weights=position_weights;
+
+		// the positions are independent, every position gets the examples
+		// in the same order as with add_to_trie()
+		std::vector<int32_t> positions;
+		#pragma omp for schedule(dynamic, 1)
+		for (int32_t i=0; i<length; i++)
+		{
+			for (size_t e=0; e<vecs.size(); e++)
+				part.add_to_trie(i, 0, vecs[e].vector, alphas[e], weights,
+					degree_times_position_weights);
+			positions.push_back(i);
+		}
+
+		#pragma omp critical
+		{
+			const int32_t required=TreeMemPtr+part.TreeMemPtr+10;
+			if (required>=TreeMemPtrMax)
+			{
+				TreeMemPtrMax=required;
+				TreeMem.resize(TreeMemPtrMax);
+			}
+			for (auto i : positions)
+				copy_tree(part, part.trees[i], trees[i], 0);
+		}
+	}
+}
+
+	template <class Trie>
+void CTrie<Trie>::copy_tree(
+	const CTrie & other, int32_t other_node, int32_t node, int32_t depth)
+{
+	TreeMem[node]=other.TreeMem[other_node];
+
+	// the nodes one level below the degree hold child weights
+	if (depth>=degree-1)
+		return;
+
+	for (int32_t q=0; q<4; q++)
+	{
+		const int32_t child=other.TreeMem[other_node].children[q];
+		if (child==NO_CHILD)
+			continue;
+
+		const int32_t copy=TreeMemPtr++;
+		if (child<0)
+		{
+			// compact terminal node
+			TreeMem[copy]=other.TreeMem[-child];
+			TreeMem[node].children[q]=-copy;
+		}
+		else
+		{
+			TreeMem[node].children[q]=copy;
+			copy_tree(other, child, copy, depth+1);
+		}
+	}
+}
+
 	template <class Trie>
 float64_t CTrie<Trie>::compute_by_tree_helper(
 	int32_t* vec, int32_t len, int32_t seq_pos, int32_t tree_pos,
@@ -24,10 +24,12 @@
 #include <vector>
 
 #include <shogun/base/base_types.h>
+#include <shogun/util/clone.h>
 #include <shogun/util/converters.h>
 #include <shogun/util/traits.h>
 namespace shogun
 {
+	class SGReferencedData;
 
 	namespace any_detail
 	{
@@ -200,6 +202,34 @@ namespace shogun
 		virtual void exit_std_vector(size_t* size) = 0;
 		virtual void exit_map(size_t* size) = 0;
 
+		/** Visit the values of a vector or matrix at once rather than
+		 * one by one, for visitors that copy them in bulk.
+		 *
+		 * @param data first value
+		 * @param value_bytes bytes of every value
+		 * @param length number of values
+		 * @return whether the values were visited, they are visited one
+		 * by one otherwise
+		 */
+		virtual bool on_contiguous(void* data, size_t value_bytes, int64_t length)
+		{
+			return false;
+		}
+
+		/** on_contiguous() for plain arithmetic values */
+		template <typename T>
+		bool try_contiguous(T* data, int64_t length)
+		{
+			if constexpr (
+			    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+			    !std::is_same_v<T, floatmax_t>)
+			{
+				if (length > 0)
+					return on_contiguous(data, sizeof(T), length);
+			}
+			return false;
+		}
+
 		template <typename T>
 		void on(std::atomic<T>* val)
 		{
@@ -244,8 +274,11 @@ namespace shogun
 			enter_vector(std::addressof(size));
 			if (size != _v->vlen)
 				_v->resize_vector(size);
-			for (auto&& _value : *_v)
-				on(std::addressof(_value));
+			if (!try_contiguous(_v->vector, size))
+			{
+				for (auto&& _value : *_v)
+					on(std::addressof(_value));
+			}
 			exit_vector(std::addressof(size));
 		}
 
@@ -289,8 +322,11 @@ namespace shogun
 					*_v->ptr() = SG_CALLOC(T, size);
 			}
 			auto ptr = *(_v->ptr());
-			for (S i = 0; i < size; ++i)
-				on(std::addressof(ptr[i]));
+			if (!try_contiguous(ptr, size))
+			{
+				for (S i = 0; i < size; ++i)
+					on(std::addressof(ptr[i]));
+			}
 			exit_vector(std::addressof(size));
 		}
 
@@ -310,8 +346,11 @@ namespace shogun
 					*_v->ptr() = SG_MALLOC(T, length);
 			}
 			auto ptr = *(_v->ptr());
-			for (int64_t i = 0; i < length; ++i)
-				on(std::addressof(ptr[i]));
+			if (!try_contiguous(ptr, length))
+			{
+				for (int64_t i = 0; i < length; ++i)
+					on(std::addressof(ptr[i]));
+			}
 			exit_matrix(shape.first, shape.second);
 		}
 
@@ -323,10 +362,13 @@ namespace shogun
 			enter_matrix(std::addressof(rows), std::addressof(cols));
 			if ((rows != _matrix->num_rows) || (cols != _matrix->num_cols))
 				*_matrix = SGMatrix<T>(rows, cols);
-			for (auto index = 0; index < cols; index++)
+			if (!try_contiguous(_matrix->matrix, int64_t(rows) * cols))
 			{
-				on_matrix_row(
-				    std::addressof(rows), std::addressof(index), _matrix);
+				for (auto index = 0; index < cols; index++)
+				{
+					on_matrix_row(
+					    std::addressof(rows), std::addressof(index), _matrix);
+				}
 			}
 			exit_matrix(std::addressof(rows), std::addressof(cols));
 		}
@@ -584,6 +626,11 @@ namespace shogun
 			}
 			else if constexpr (traits::has_clone<T>::value)
 			{
+				if constexpr (std::is_base_of_v<SGReferencedData, T>)
+				{
+					if (clone_utils::sharing_data())
+						return T(value);
+				}
 				return value.clone();
 			}
 			else if constexpr (traits::is_pair<T>::value)
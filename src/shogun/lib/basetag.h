@@ -53,7 +53,7 @@ namespace shogun
          * @param _name name for tag
          */
         explicit BaseTag(std::string_view _name) : 
-            m_name(_name), m_hash(std::hash<std::string>()(_name.data()))
+            m_name(_name), m_hash(std::hash<std::string_view>()(_name))
         {
         }
 
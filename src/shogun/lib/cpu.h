@@ -56,4 +56,46 @@ SG_FORCED_INLINE static void CpuRelax()
 #endif
 }
 
+/** @return whether the processor supports SSE4.2 */
+SG_FORCED_INLINE static bool CpuHasSSE42()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return __builtin_cpu_supports("sse4.2");
+#else
+	return false;
+#endif
+}
+
+/** @return whether the processor supports AVX2 and FMA */
+SG_FORCED_INLINE static bool CpuHasAVX2()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+	return false;
+#endif
+}
+
+/** @return whether the processor supports AVX-512F */
+SG_FORCED_INLINE static bool CpuHasAVX512F()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return __builtin_cpu_supports("avx512f");
+#else
+	return false;
+#endif
+}
+
+/** @return whether the processor supports Advanced SIMD (NEON) with 64 bit
+ * floats, which every aarch64 processor does
+ */
+SG_FORCED_INLINE static bool CpuHasNEON()
+{
+#if defined(__aarch64__)
+	return true;
+#else
+	return false;
+#endif
+}
+
 #endif /* __CPU_INFO_H__ */
@@ -39,7 +39,9 @@
 #include <shogun/base/progress.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/StoppableSGObject.h>
 #include <shogun/lib/Time.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/external/shogun_libsvm.h>
@@ -54,6 +56,8 @@
 
 #include <rxcpp/rx.hpp>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -67,6 +71,22 @@ template <class S, class T> inline void clone(T*& dst, S* src, int32_t n)
 }
 #define INF HUGE_VAL
 #define TAU 1e-12
+// minimum number of variables for which loops over them are run in parallel
+#define PARALLEL_MIN_SIZE 4096
+
+// split scans over n variables into one chunk per thread, the chunks are
+// merged in order so that ties are broken as in a sequential scan
+static int32_t num_chunks(int32_t n)
+{
+	if (n < PARALLEL_MIN_SIZE)
+		return 1;
+	return Math::max(Math::min(env()->get_num_threads(), n), 1);
+}
+
+static int32_t chunk_begin(int32_t chunk, int32_t chunks, int32_t n)
+{
+	return int64_t(chunk) * n / chunks;
+}
 
 class QMatrix;
 class SVC_QMC;
@@ -145,6 +165,8 @@ int32_t Cache::get_data(const int32_t index, Qfloat **data, int32_t len)
 
 	if(more > 0)
 	{
+		SG_PROFILE_COUNT("libsvm::Cache::misses", 1);
+
 		// free old space
 		while(size < more)
 		{
@@ -161,6 +183,8 @@ int32_t Cache::get_data(const int32_t index, Qfloat **data, int32_t len)
 		size -= more;
 		Math::swap(h->len,len);
 	}
+	else
+		SG_PROFILE_COUNT("libsvm::Cache::hits", 1);
 
 	lru_insert(h);
 	*data = h->data;
@@ -232,7 +256,21 @@ public:
 
 	void compute_Q_parallel(Qfloat* data, float64_t* lab, int32_t i, int32_t start, int32_t len) const
 	{
-		if (lab) // two class
+		if (kernel_rows)
+		{
+			// gather the column from the row of all training vectors
+			const index_t num_vectors = kernel_rows->get_row_length();
+			SGVector<float64_t> row = kernel_rows->get_row(x[i]->index,
+				[this, num_vectors](index_t row_index, float64_t* row_data)
+				{
+					#pragma omp parallel for if (num_vectors >= PARALLEL_MIN_SIZE)
+					for(index_t k=0;k<num_vectors;k++)
+						row_data[k] = kernel->kernel(row_index, k);
+				});
+			for(int32_t j=start;j<len;j++)
+				data[j] = (Qfloat) (lab ? lab[i]*lab[j] : 1.0)*row[x[j]->index];
+		}
+		else if (lab) // two class
 		{
 			#pragma omp parallel for
 			for(int32_t j=start;j<len;j++)
@@ -253,6 +291,7 @@ public:
 
 private:
 	Kernel* kernel;
+	KernelRowCache<float64_t>* kernel_rows;
 	const svm_node **x;
 	float64_t *x_square;
 };
@@ -262,6 +301,7 @@ LibSVMKernel::LibSVMKernel(int32_t l, svm_node * const * x_, const svm_parameter
 	clone(x,x_,l);
 	x_square = 0;
 	kernel=param.kernel;
+	kernel_rows=param.kernel_rows;
 	max_train_time=param.max_train_time;
 }
 
@@ -291,7 +331,9 @@ LibSVMKernel::~LibSVMKernel()
 //
 class Solver {
 public:
-	Solver() : m_cancel_computation(false){};
+	Solver()
+		: m_cancel_computation(false),
+		  m_computation(StoppableSGObject::current_computation()){};
 	virtual ~Solver() {};
 
 	struct SolutionInfo {
@@ -324,6 +366,8 @@ protected:
 	int32_t l;
 	bool unshrink;	// XXX
 	std::atomic<bool> m_cancel_computation;
+	// computation the solver runs in, e.g. the training of a LibSVM
+	StoppableSGObject* m_computation;
 
 	float64_t get_C(int32_t i)
 	{
@@ -353,7 +397,8 @@ protected:
 	/** @return whether the algorithm needs to be stopped */
 	SG_FORCED_INLINE bool cancel_computation() const
 	{
-		return m_cancel_computation.load();
+		return m_cancel_computation.load() ||
+			(m_computation && m_computation->cancel_computation());
 	}
 #endif
 	void on_pause()
@@ -361,7 +406,7 @@ protected:
 	}
 	void on_next()
 	{
-		m_cancel_computation.store(false);
+		m_cancel_computation.store(true);
 	}
 	void on_complete()
 	{
@@ -411,6 +456,7 @@ void Solver::reconstruct_gradient()
 	int32_t i,j;
 	int32_t nr_free = 0;
 
+	#pragma omp parallel for if (l-active_size >= PARALLEL_MIN_SIZE)
 	for(j=active_size;j<l;j++)
 		G[j] = G_bar[j] + p[j];
 
@@ -418,14 +464,19 @@ void Solver::reconstruct_gradient()
 		if(is_free(j))
 			nr_free++;
 
-	if (nr_free*l > 2*active_size*(l-active_size))
+	// the kernel cache is not thread safe, so columns are fetched
+	// sequentially and the loops over their entries run in parallel
+	if ((int64_t) nr_free*l > 2*(int64_t) active_size*(l-active_size))
 	{
 		for(i=active_size;i<l;i++)
 		{
 			const Qfloat *Q_i = Q->get_Q(i,active_size);
+			float64_t G_i = 0;
+			#pragma omp parallel for reduction(+:G_i) if (active_size >= PARALLEL_MIN_SIZE)
 			for(j=0;j<active_size;j++)
 				if(is_free(j))
-					G[i] += alpha[j] * Q_i[j];
+					G_i += alpha[j] * Q_i[j];
+			G[i] += G_i;
 		}
 	}
 	else
@@ -435,6 +486,7 @@ void Solver::reconstruct_gradient()
 			{
 				const Qfloat *Q_i = Q->get_Q(i,l);
 				float64_t alpha_i = alpha[i];
+				#pragma omp parallel for if (l-active_size >= PARALLEL_MIN_SIZE)
 				for(j=active_size;j<l;j++)
 					G[j] += alpha_i * Q_i[j];
 			}
@@ -446,6 +498,7 @@ void Solver::Solve(
 	const schar *p_y, float64_t *p_alpha, float64_t p_Cp, float64_t p_Cn,
 	float64_t p_eps, SolutionInfo* p_si, int32_t shrinking, bool use_bias)
 {
+	SG_PROFILE_SCOPE("libsvm::Solver::Solve");
 	auto sub = connect_to_signal_handler();
 
 	this->l = p_l;
@@ -494,12 +547,15 @@ void Solver::Solve(
 			{
 				const Qfloat *Q_i = Q->get_Q(i,l);
 				float64_t alpha_i = alpha[i];
-				int32_t j;
-				for(j=0;j<l;j++)
+				float64_t C_i = get_C(i);
+				bool upper_bound_i = is_upper_bound(i);
+				#pragma omp parallel for if (l >= PARALLEL_MIN_SIZE)
+				for(int32_t j=0;j<l;j++)
+				{
 					G[j] += alpha_i*Q_i[j];
-				if(is_upper_bound(i))
-					for(j=0;j<l;j++)
-						G_bar[j] += get_C(i) * Q_i[j];
+					if(upper_bound_i)
+						G_bar[j] += C_i * Q_i[j];
+				}
 			}
 			pb.print_progress();
 		}
@@ -544,6 +600,9 @@ void Solver::Solve(
 			gap, -Math::log10(gap), -Math::log10(1), -Math::log10(eps));
 
 		++iter;
+		if (m_computation)
+			m_computation->count_iteration();
+		SG_PROFILE_COUNT("libsvm::Solver::iterations", 1);
 
 		// update alpha[i] and alpha[j], handle bounds carefully
 
@@ -668,6 +727,7 @@ void Solver::Solve(
 		float64_t delta_alpha_i = alpha[i] - old_alpha_i;
 		float64_t delta_alpha_j = alpha[j] - old_alpha_j;
 
+		#pragma omp parallel for if (active_size >= PARALLEL_MIN_SIZE)
 		for(int32_t k=0;k<active_size;k++)
 		{
 			G[k] += Q_i[k]*delta_alpha_i + Q_j[k]*delta_alpha_j;
@@ -680,27 +740,22 @@ void Solver::Solve(
 			bool uj = is_upper_bound(j);
 			update_alpha_status(i);
 			update_alpha_status(j);
-			int32_t k;
 			if(ui != is_upper_bound(i))
 			{
 				Q_i = Q->get_Q(i,l);
-				if(ui)
-					for(k=0;k<l;k++)
-						G_bar[k] -= C_i * Q_i[k];
-				else
-					for(k=0;k<l;k++)
-						G_bar[k] += C_i * Q_i[k];
+				float64_t C = ui ? -C_i : C_i;
+				#pragma omp parallel for if (l >= PARALLEL_MIN_SIZE)
+				for(int32_t k=0;k<l;k++)
+					G_bar[k] += C * Q_i[k];
 			}
 
 			if(uj != is_upper_bound(j))
 			{
 				Q_j = Q->get_Q(j,l);
-				if(uj)
-					for(k=0;k<l;k++)
-						G_bar[k] -= C_j * Q_j[k];
-				else
-					for(k=0;k<l;k++)
-						G_bar[k] += C_j * Q_j[k];
+				float64_t C = uj ? -C_j : C_j;
+				#pragma omp parallel for if (l >= PARALLEL_MIN_SIZE)
+				for(int32_t k=0;k<l;k++)
+					G_bar[k] += C * Q_j[k];
 			}
 		}
 
@@ -777,24 +832,46 @@ int32_t Solver::select_working_set(
 	int32_t Gmin_idx = -1;
 	float64_t obj_diff_min = INF;
 
-	for(int32_t t=0;t<active_size;t++)
-		if(y[t]==+1)
-		{
-			if(!is_upper_bound(t))
-				if(-G[t] >= Gmax)
-				{
-					Gmax = -G[t];
-					Gmax_idx = t;
-				}
-		}
-		else
+	const int32_t chunks = num_chunks(active_size);
+	std::vector<float64_t> chunk_Gmax(chunks);
+	std::vector<float64_t> chunk_Gmax2(chunks);
+	std::vector<float64_t> chunk_obj_diff_min(chunks);
+	std::vector<int32_t> chunk_idx(chunks);
+
+	#pragma omp parallel for if (chunks > 1)
+	for(int32_t c=0;c<chunks;c++)
+	{
+		float64_t local_Gmax = -INF;
+		int32_t local_idx = -1;
+		const int32_t end = chunk_begin(c+1, chunks, active_size);
+		for(int32_t t=chunk_begin(c, chunks, active_size);t<end;t++)
+			if(y[t]==+1)
+			{
+				if(!is_upper_bound(t))
+					if(-G[t] >= local_Gmax)
+					{
+						local_Gmax = -G[t];
+						local_idx = t;
+					}
+			}
+			else
+			{
+				if(!is_lower_bound(t))
+					if(G[t] >= local_Gmax)
+					{
+						local_Gmax = G[t];
+						local_idx = t;
+					}
+			}
+		chunk_Gmax[c] = local_Gmax;
+		chunk_idx[c] = local_idx;
+	}
+
+	for(int32_t c=0;c<chunks;c++)
+		if(chunk_idx[c] != -1 && chunk_Gmax[c] >= Gmax)
 		{
-			if(!is_lower_bound(t))
-				if(G[t] >= Gmax)
-				{
-					Gmax = G[t];
-					Gmax_idx = t;
-				}
+			Gmax = chunk_Gmax[c];
+			Gmax_idx = chunk_idx[c];
 		}
 
 	int32_t i = Gmax_idx;
@@ -802,56 +879,77 @@ int32_t Solver::select_working_set(
 	if(i != -1) // NULL Q_i not accessed: Gmax=-INF if i=-1
 		Q_i = Q->get_Q(i,active_size);
 
-	for(int32_t j=0;j<active_size;j++)
+	#pragma omp parallel for if (chunks > 1)
+	for(int32_t c=0;c<chunks;c++)
 	{
-		if(y[j]==+1)
+		float64_t local_Gmax2 = -INF;
+		float64_t local_obj_diff_min = INF;
+		int32_t local_idx = -1;
+		const int32_t end = chunk_begin(c+1, chunks, active_size);
+		for(int32_t j=chunk_begin(c, chunks, active_size);j<end;j++)
 		{
-			if (!is_lower_bound(j))
+			if(y[j]==+1)
 			{
-				float64_t grad_diff=Gmax+G[j];
-				if (G[j] >= Gmax2)
-					Gmax2 = G[j];
-				if (grad_diff > 0)
+				if (!is_lower_bound(j))
 				{
-					float64_t obj_diff;
-					float64_t quad_coef=Q_i[i]+QD[j]-2.0*y[i]*Q_i[j];
-					if (quad_coef > 0)
-						obj_diff = -(grad_diff*grad_diff)/quad_coef;
-					else
-						obj_diff = -(grad_diff*grad_diff)/TAU;
-
-					if (obj_diff <= obj_diff_min)
+					float64_t grad_diff=Gmax+G[j];
+					if (G[j] >= local_Gmax2)
+						local_Gmax2 = G[j];
+					if (grad_diff > 0)
 					{
-						Gmin_idx=j;
-						obj_diff_min = obj_diff;
+						float64_t obj_diff;
+						float64_t quad_coef=Q_i[i]+QD[j]-2.0*y[i]*Q_i[j];
+						if (quad_coef > 0)
+							obj_diff = -(grad_diff*grad_diff)/quad_coef;
+						else
+							obj_diff = -(grad_diff*grad_diff)/TAU;
+
+						if (obj_diff <= local_obj_diff_min)
+						{
+							local_idx=j;
+							local_obj_diff_min = obj_diff;
+						}
 					}
 				}
 			}
-		}
-		else
-		{
-			if (!is_upper_bound(j))
+			else
 			{
-				float64_t grad_diff= Gmax-G[j];
-				if (-G[j] >= Gmax2)
-					Gmax2 = -G[j];
-				if (grad_diff > 0)
+				if (!is_upper_bound(j))
 				{
-					float64_t obj_diff;
-					float64_t quad_coef=Q_i[i]+QD[j]+2.0*y[i]*Q_i[j];
-					if (quad_coef > 0)
-						obj_diff = -(grad_diff*grad_diff)/quad_coef;
-					else
-						obj_diff = -(grad_diff*grad_diff)/TAU;
-
-					if (obj_diff <= obj_diff_min)
+					float64_t grad_diff= Gmax-G[j];
+					if (-G[j] >= local_Gmax2)
+						local_Gmax2 = -G[j];
+					if (grad_diff > 0)
 					{
-						Gmin_idx=j;
-						obj_diff_min = obj_diff;
+						float64_t obj_diff;
+						float64_t quad_coef=Q_i[i]+QD[j]+2.0*y[i]*Q_i[j];
+						if (quad_coef > 0)
+							obj_diff = -(grad_diff*grad_diff)/quad_coef;
+						else
+							obj_diff = -(grad_diff*grad_diff)/TAU;
+
+						if (obj_diff <= local_obj_diff_min)
+						{
+							local_idx=j;
+							local_obj_diff_min = obj_diff;
+						}
 					}
 				}
 			}
 		}
+		chunk_Gmax2[c] = local_Gmax2;
+		chunk_obj_diff_min[c] = local_obj_diff_min;
+		chunk_idx[c] = local_idx;
+	}
+
+	for(int32_t c=0;c<chunks;c++)
+	{
+		Gmax2 = Math::max(Gmax2, chunk_Gmax2[c]);
+		if(chunk_idx[c] != -1 && chunk_obj_diff_min[c] <= obj_diff_min)
+		{
+			Gmin_idx = chunk_idx[c];
+			obj_diff_min = chunk_obj_diff_min[c];
+		}
 	}
 
 	gap=Gmax+Gmax2;
@@ -1434,12 +1532,19 @@ float64_t Solver_NUMC::compute_primal(const schar* p_y, float64_t* p_alpha, floa
 		float64_t sum_atbound=0;
 		float64_t sum_zero_count=0;
 
+		float64_t quad_i=0;
+		float64_t normwc_i=0;
+		float64_t normwc_const_i=0;
+
 		Qfloat* Q_i = Q->get_Q(i,active_size);
+		SVC_QMC* QMC=(SVC_QMC*) Q;
 		outputs[i]=0;
 
+		#pragma omp parallel for if (active_size >= PARALLEL_MIN_SIZE) \
+			reduction(+:quad_i,sum_free,sum_atbound,sum_zero_count,normwc_i,normwc_const_i)
 		for (int j=0; j<active_size; j++)
 		{
-			quad+= alpha[i]*alpha[j]*Q_i[j];
+			quad_i+= alpha[i]*alpha[j]*Q_i[j];
 			float64_t tmp= alpha[j]*Q_i[j]/mu;
 
 			if(!is_upper_bound(i) && !is_lower_bound(i))
@@ -1450,14 +1555,16 @@ float64_t Solver_NUMC::compute_primal(const schar* p_y, float64_t* p_alpha, floa
 			if (class_count[(int32_t) y[i]] == 0 && y[j]==y[i])
 				sum_zero_count+= tmp;
 
-			SVC_QMC* QMC=(SVC_QMC*) Q;
 			float64_t norm_tmp=alpha[i]*alpha[j]*QMC->get_orig_Qij(Q_i[j], i, j);
 			if (y[i]==y[j])
-				normwcw[(int32_t) y[i]]+=norm_tmp;
+				normwc_i+=norm_tmp;
 
-			normwcw[(int32_t) y[i]]-=2.0/nr_class*norm_tmp;
-			normwc_const+=norm_tmp;
+			normwc_i-=2.0/nr_class*norm_tmp;
+			normwc_const_i+=norm_tmp;
 		}
+		quad+=quad_i;
+		normwcw[(int32_t) y[i]]+=normwc_i;
+		normwc_const+=normwc_const_i;
 
 		if (class_count[(int32_t) y[i]] == 0)
 		{
@@ -1549,75 +1656,148 @@ int32_t Solver_NUMC::select_working_set(
 	int32_t best_out_i=-1;
 	int32_t best_out_j=-1;
 
-	float64_t* Gmaxp = SG_MALLOC(float64_t, nr_class);
-	float64_t* Gmaxp2 = SG_MALLOC(float64_t, nr_class);
-	int32_t* Gmaxp_idx = SG_MALLOC(int32_t, nr_class);
+	// the scans over the variables run in chunks, each with its own
+	// per class maxima, which are merged in order so that ties are broken
+	// as in a sequential scan (the later variable wins)
+	const int32_t chunks = num_chunks(active_size);
+	const int32_t n = nr_class*chunks;
 
-	int32_t* Gmin_idx = SG_MALLOC(int32_t, nr_class);
-	float64_t* obj_diff_min = SG_MALLOC(float64_t, nr_class);
+	float64_t* Gmaxp = SG_MALLOC(float64_t, n);
+	float64_t* Gmaxp2 = SG_MALLOC(float64_t, n);
+	int32_t* Gmaxp_idx = SG_MALLOC(int32_t, n);
 
-	for (int32_t i=0; i<nr_class; i++)
+	int32_t* Gmin_idx = SG_MALLOC(int32_t, n);
+	float64_t* obj_diff_min = SG_MALLOC(float64_t, n);
+	int32_t* last_idx = SG_MALLOC(int32_t, n);
+
+	for (int32_t i=0; i<n; i++)
 	{
 		Gmaxp[i]=-INF;
 		Gmaxp2[i]=-INF;
 		Gmaxp_idx[i]=-1;
 		Gmin_idx[i]=-1;
 		obj_diff_min[i]=INF;
+		last_idx[i]=-1;
 	}
 
-	for(int32_t t=0;t<active_size;t++)
+	#pragma omp parallel for if (chunks > 1)
+	for(int32_t c=0;c<chunks;c++)
 	{
-		int32_t cidx=y[t];
-		if(!is_upper_bound(t))
+		float64_t* Gmaxp_c = Gmaxp+c*nr_class;
+		int32_t* Gmaxp_idx_c = Gmaxp_idx+c*nr_class;
+		const int32_t end = chunk_begin(c+1,chunks,active_size);
+		for(int32_t t=chunk_begin(c,chunks,active_size);t<end;t++)
 		{
-			if(-G[t] >= Gmaxp[cidx])
+			int32_t cidx=y[t];
+			if(!is_upper_bound(t))
 			{
-				Gmaxp[cidx] = -G[t];
-				Gmaxp_idx[cidx] = t;
+				if(-G[t] >= Gmaxp_c[cidx])
+				{
+					Gmaxp_c[cidx] = -G[t];
+					Gmaxp_idx_c[cidx] = t;
+				}
+			}
+		}
+	}
+	for(int32_t c=1;c<chunks;c++)
+	{
+		for(int32_t k=0;k<nr_class;k++)
+		{
+			if(Gmaxp_idx[c*nr_class+k] != -1 &&
+				Gmaxp[c*nr_class+k] >= Gmaxp[k])
+			{
+				Gmaxp[k] = Gmaxp[c*nr_class+k];
+				Gmaxp_idx[k] = Gmaxp_idx[c*nr_class+k];
 			}
 		}
 	}
 
-	for(int32_t j=0;j<active_size;j++)
+	// the columns of the selected i of all classes, copied since the
+	// kernel cache may drop them while fetching the others
+	std::vector<std::vector<Qfloat>> Q_i(nr_class);
+	for(int32_t k=0;k<nr_class;k++)
 	{
-		int32_t cidx=y[j];
-		int32_t ip = Gmaxp_idx[cidx];
-		const Qfloat *Q_ip = NULL;
-		if(ip != -1) // NULL Q_ip not accessed: Gmaxp=-INF if ip=-1
-			Q_ip = Q->get_Q(ip,active_size);
+		int32_t ip = Gmaxp_idx[k];
+		if(ip != -1) // empty Q_i not accessed: Gmaxp=-INF if ip=-1
+		{
+			const Qfloat *Q_ip = Q->get_Q(ip,active_size);
+			Q_i[k].assign(Q_ip, Q_ip+active_size);
+		}
+	}
 
-		if (!is_lower_bound(j))
+	#pragma omp parallel for if (chunks > 1)
+	for(int32_t c=0;c<chunks;c++)
+	{
+		float64_t* Gmaxp2_c = Gmaxp2+c*nr_class;
+		int32_t* Gmin_idx_c = Gmin_idx+c*nr_class;
+		float64_t* obj_diff_min_c = obj_diff_min+c*nr_class;
+		int32_t* last_idx_c = last_idx+c*nr_class;
+		const int32_t end = chunk_begin(c+1,chunks,active_size);
+		for(int32_t j=chunk_begin(c,chunks,active_size);j<end;j++)
 		{
-			float64_t grad_diff=Gmaxp[cidx]+G[j];
-			if (G[j] >= Gmaxp2[cidx])
-				Gmaxp2[cidx] = G[j];
-			if (grad_diff > 0)
-			{
-				float64_t obj_diff;
-				float64_t quad_coef = Q_ip[ip]+QD[j]-2*Q_ip[j];
-				if (quad_coef > 0)
-					obj_diff = -(grad_diff*grad_diff)/quad_coef;
-				else
-					obj_diff = -(grad_diff*grad_diff)/TAU;
+			int32_t cidx=y[j];
+			int32_t ip = Gmaxp_idx[cidx];
+			last_idx_c[cidx] = j;
 
-				if (obj_diff <= obj_diff_min[cidx])
+			if (!is_lower_bound(j))
+			{
+				float64_t grad_diff=Gmaxp[cidx]+G[j];
+				if (G[j] >= Gmaxp2_c[cidx])
+					Gmaxp2_c[cidx] = G[j];
+				if (grad_diff > 0)
 				{
-					Gmin_idx[cidx]=j;
-					obj_diff_min[cidx] = obj_diff;
+					const Qfloat *Q_ip = Q_i[cidx].data();
+					float64_t obj_diff;
+					float64_t quad_coef = Q_ip[ip]+QD[j]-2*Q_ip[j];
+					if (quad_coef > 0)
+						obj_diff = -(grad_diff*grad_diff)/quad_coef;
+					else
+						obj_diff = -(grad_diff*grad_diff)/TAU;
+
+					if (obj_diff <= obj_diff_min_c[cidx])
+					{
+						Gmin_idx_c[cidx]=j;
+						obj_diff_min_c[cidx] = obj_diff;
+					}
 				}
 			}
 		}
-
-		gap=Gmaxp[cidx]+Gmaxp2[cidx];
-		if (gap>=best_gap && Gmin_idx[cidx]>=0 &&
-				Gmaxp_idx[cidx]>=0 && Gmin_idx[cidx]<active_size)
+	}
+	for(int32_t c=1;c<chunks;c++)
+	{
+		for(int32_t k=0;k<nr_class;k++)
 		{
-			out_i = Gmaxp_idx[cidx];
-			out_j = Gmin_idx[cidx];
+			const int32_t ck = c*nr_class+k;
+			if (Gmaxp2[ck] >= Gmaxp2[k])
+				Gmaxp2[k] = Gmaxp2[ck];
+			if (Gmin_idx[ck] != -1 && obj_diff_min[ck] <= obj_diff_min[k])
+			{
+				Gmin_idx[k] = Gmin_idx[ck];
+				obj_diff_min[k] = obj_diff_min[ck];
+			}
+			if (last_idx[ck] != -1)
+				last_idx[k] = last_idx[ck];
+		}
+	}
+
+	// the gap of a class only grows over its variables, the sequential
+	// scan thus ends up with the class of the largest gap, of those the
+	// one whose last variable comes last
+	int32_t best_last=-1;
+	for(int32_t k=0;k<nr_class;k++)
+	{
+		if (last_idx[k] == -1)
+			continue;
 
+		gap=Gmaxp[k]+Gmaxp2[k];
+		if (gap>=best_gap && Gmin_idx[k]>=0 && Gmaxp_idx[k]>=0 &&
+				Gmin_idx[k]<active_size &&
+				(gap>best_gap || best_out_i == -1 || last_idx[k]>best_last))
+		{
 			best_gap=gap;
-			best_out_i=out_i;
-			best_out_j=out_j;
+			best_out_i=Gmaxp_idx[k];
+			best_out_j=Gmin_idx[k];
+			best_last=last_idx[k];
 		}
 	}
 
@@ -1636,6 +1816,7 @@ int32_t Solver_NUMC::select_working_set(
 	SG_FREE(Gmaxp_idx);
 	SG_FREE(Gmin_idx);
 	SG_FREE(obj_diff_min);
+	SG_FREE(last_idx);
 
 	return retval;
 }
@@ -1792,10 +1973,12 @@ public:
 		if(cache->get_data(real_i,&data,l) < l)
 			compute_Q_parallel(data, NULL, real_i, 0, l);
 
-		// reorder and copy
+		// reorder and copy, the column of an example is cached once for
+		// both of its variables
 		Qfloat *buf = buffer[next_buffer];
 		next_buffer = 1 - next_buffer;
 		schar si = sign[i];
+		#pragma omp parallel for if (len >= PARALLEL_MIN_SIZE)
 		for(int32_t j=0;j<len;j++)
 			buf[j] = si * sign[j] * data[index[j]];
 		return buf;
@@ -1829,6 +2012,36 @@ private:
 //
 // construct and solve various formulations
 //
+// seed alpha with the initial alphas of the problem, clipped to the bounds
+// and, with bias, rescaled such that y^T alpha = 0 holds
+static void init_alpha(
+	const svm_problem *prob, const schar *y, float64_t *alpha,
+	float64_t Cp, float64_t Cn, bool use_bias)
+{
+	int32_t l = prob->l;
+	float64_t sum_pos = 0;
+	float64_t sum_neg = 0;
+
+	for(int32_t i=0;i<l;i++)
+	{
+		float64_t C = y[i] > 0 ? Cp : Cn;
+		alpha[i] = Math::min(fabs(prob->alpha_init[prob->x[i]->index]), C);
+		if(y[i] > 0)
+			sum_pos += alpha[i];
+		else
+			sum_neg += alpha[i];
+	}
+
+	if (!use_bias || sum_pos == sum_neg)
+		return;
+
+	// shrinking the larger side keeps alpha within the bounds
+	float64_t scale_pos = sum_pos > sum_neg ? sum_neg/sum_pos : 1;
+	float64_t scale_neg = sum_neg > sum_pos ? sum_pos/sum_neg : 1;
+	for(int32_t i=0;i<l;i++)
+		alpha[i] *= y[i] > 0 ? scale_pos : scale_neg;
+}
+
 static void solve_c_svc(
 	const svm_problem *prob, const svm_parameter* param,
 	float64_t *alpha, Solver::SolutionInfo* si, float64_t Cp, float64_t Cn)
@@ -1844,6 +2057,9 @@ static void solve_c_svc(
 		if(prob->y[i] > 0) y[i] = +1; else y[i]=-1;
 	}
 
+	if (prob->alpha_init)
+		init_alpha(prob, y, alpha, Cp, Cn, param->use_bias);
+
 	Solver s;
 	s.Solve(l, SVC_Q(*prob,*param,y), prob->pv, y,
 		alpha, Cp, Cn, param->eps, si, param->shrinking, param->use_bias);
@@ -2296,6 +2512,11 @@ void svm_group_classes(
 //
 svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 {
+	// the shared kernel rows are only set up below
+	svm_parameter train_param = *param;
+	train_param.kernel_rows = NULL;
+	param = &train_param;
+
 	svm_model *model = SG_MALLOC(svm_model,1);
 	model->param = *param;
 	model->free_sv = 0;	// XXX
@@ -2396,57 +2617,132 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 		bool *nonzero = SG_MALLOC(bool,l);
 		for(i=0;i<l;i++)
 			nonzero[i] = false;
-		decision_function *f = SG_MALLOC(decision_function,nr_class*(nr_class-1)/2);
+		const int32_t num_pairs = nr_class*(nr_class-1)/2;
+		decision_function *f = SG_MALLOC(decision_function,num_pairs);
 
-		int32_t p = 0;
+		std::vector<std::pair<int32_t,int32_t>> pairs;
 		for(i=0;i<nr_class;i++)
 			for(int32_t j=i+1;j<nr_class;j++)
-			{
-				svm_problem sub_prob;
-				int32_t si = start[i], sj = start[j];
-				int32_t ci = count[i], cj = count[j];
-				sub_prob.l = ci+cj;
-				sub_prob.x = SG_MALLOC(svm_node *,sub_prob.l);
-				sub_prob.y = SG_MALLOC(float64_t,sub_prob.l+1); //dirty hack to surpress valgrind err
-				sub_prob.C = SG_MALLOC(float64_t,sub_prob.l+1);
-				sub_prob.pv = SG_MALLOC(float64_t,sub_prob.l+1);
+				pairs.emplace_back(i,j);
+
+		// the pairs are trained concurrently, largest first, and take the
+		// kernel rows from one cache over all training vectors so that the
+		// pairs of a class reuse them, half of the cache size goes to it
+		// and the other half to the caches of the pairs in training
+		svm_parameter pair_param = *param;
+		std::unique_ptr<KernelRowCache<float64_t>> kernel_rows;
+		const int32_t num_threads = env()->get_num_threads();
+		if (num_pairs > 1)
+		{
+			int32_t num_vectors = 0;
+			for(i=0;i<l;i++)
+				num_vectors = Math::max(num_vectors, x[i]->index+1);
+			kernel_rows = std::make_unique<KernelRowCache<float64_t>>(
+				num_vectors, num_vectors,
+				Math::max<int64_t>(param->cache_size/2, 1));
+			pair_param.kernel_rows = kernel_rows.get();
+			pair_param.cache_size =
+				param->cache_size/(2*Math::min(num_pairs, num_threads));
+		}
 
-				int32_t k;
-				for(k=0;k<ci;k++)
-				{
-					sub_prob.x[k] = x[si+k];
-					sub_prob.y[k] = +1;
-                    sub_prob.C[k] = C[si+k];
-                    sub_prob.pv[k] = pv[si+k];
+		std::vector<int32_t> order(num_pairs);
+		for(int32_t p=0;p<num_pairs;p++)
+			order[p] = p;
+		std::stable_sort(order.begin(), order.end(),
+			[&](int32_t a, int32_t b)
+			{
+				return count[pairs[a].first]+count[pairs[a].second] >
+					count[pairs[b].first]+count[pairs[b].second];
+			});
+
+		// the solvers of all pairs run in the computation of the caller
+		const auto computation = StoppableSGObject::current_computation();
+		std::exception_ptr exception;
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads) if (num_pairs > 1)
+		for(int32_t o=0;o<num_pairs;o++)
+		{
+			StoppableSGObject::ComputationScope scope(computation);
+			const int32_t p = order[o];
+			const int32_t i = pairs[p].first, j = pairs[p].second;
+			svm_problem sub_prob;
+			int32_t si = start[i], sj = start[j];
+			int32_t ci = count[i], cj = count[j];
+			sub_prob.l = ci+cj;
+			sub_prob.x = SG_MALLOC(svm_node *,sub_prob.l);
+			sub_prob.y = SG_MALLOC(float64_t,sub_prob.l+1); //dirty hack to surpress valgrind err
+			sub_prob.C = SG_MALLOC(float64_t,sub_prob.l+1);
+			sub_prob.pv = SG_MALLOC(float64_t,sub_prob.l+1);
+			sub_prob.alpha_init = prob->alpha_init;
 
-				}
-				for(k=0;k<cj;k++)
-				{
-					sub_prob.x[ci+k] = x[sj+k];
-					sub_prob.y[ci+k] = -1;
-                    sub_prob.C[ci+k] = C[sj+k];
-                    sub_prob.pv[ci+k] = pv[sj+k];
-				}
-				sub_prob.y[sub_prob.l]=-1; //dirty hack to surpress valgrind err
-				sub_prob.C[sub_prob.l]=-1;
-				sub_prob.pv[sub_prob.l]=-1;
+			int32_t k;
+			for(k=0;k<ci;k++)
+			{
+				sub_prob.x[k] = x[si+k];
+				sub_prob.y[k] = +1;
+				sub_prob.C[k] = C[si+k];
+				sub_prob.pv[k] = pv[si+k];
+			}
+			for(k=0;k<cj;k++)
+			{
+				sub_prob.x[ci+k] = x[sj+k];
+				sub_prob.y[ci+k] = -1;
+				sub_prob.C[ci+k] = C[sj+k];
+				sub_prob.pv[ci+k] = pv[sj+k];
+			}
+			sub_prob.y[sub_prob.l]=-1; //dirty hack to surpress valgrind err
+			sub_prob.C[sub_prob.l]=-1;
+			sub_prob.pv[sub_prob.l]=-1;
 
-				f[p] = svm_train_one(&sub_prob,param,weighted_C[i],weighted_C[j]);
-				for(k=0;k<ci;k++)
-					if(!nonzero[si+k] && fabs(f[p].alpha[k]) > 0)
-						nonzero[si+k] = true;
-				for(k=0;k<cj;k++)
-					if(!nonzero[sj+k] && fabs(f[p].alpha[ci+k]) > 0)
-						nonzero[sj+k] = true;
-				SG_FREE(sub_prob.x);
-				SG_FREE(sub_prob.y);
-				SG_FREE(sub_prob.C);
-				SG_FREE(sub_prob.pv);
-				++p;
+			try
+			{
+				if (num_pairs > 1)
+					env()->limit_nested_threads();
+				f[p] = svm_train_one(&sub_prob,&pair_param,weighted_C[i],weighted_C[j]);
 			}
+			catch (...)
+			{
+				f[p].alpha = NULL;
+				#pragma omp critical
+				exception = std::current_exception();
+			}
+			SG_FREE(sub_prob.x);
+			SG_FREE(sub_prob.y);
+			SG_FREE(sub_prob.C);
+			SG_FREE(sub_prob.pv);
+		}
+		if (exception)
+		{
+			for(int32_t p=0;p<num_pairs;p++)
+				SG_FREE(f[p].alpha);
+			SG_FREE(f);
+			SG_FREE(nonzero);
+			SG_FREE(x);
+			SG_FREE(C);
+			SG_FREE(pv);
+			SG_FREE(perm);
+			SG_FREE(label);
+			SG_FREE(start);
+			SG_FREE(count);
+			SG_FREE(weighted_C);
+			SG_FREE(model);
+			std::rethrow_exception(exception);
+		}
+
+		for(int32_t p=0;p<num_pairs;p++)
+		{
+			const int32_t si = start[pairs[p].first], sj = start[pairs[p].second];
+			const int32_t ci = count[pairs[p].first], cj = count[pairs[p].second];
+			for(int32_t k=0;k<ci;k++)
+				if(!nonzero[si+k] && fabs(f[p].alpha[k]) > 0)
+					nonzero[si+k] = true;
+			for(int32_t k=0;k<cj;k++)
+				if(!nonzero[sj+k] && fabs(f[p].alpha[ci+k]) > 0)
+					nonzero[sj+k] = true;
+		}
 
 		// build output
 
+		int32_t p;
 		model->objective = f[0].objective;
 		model->nr_class = nr_class;
 
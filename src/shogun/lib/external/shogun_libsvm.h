@@ -41,6 +41,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/KernelRowCache.h>
 
 namespace shogun
 {
@@ -64,6 +65,7 @@ public:
 		x = NULL;
 		C = NULL;
 		pv = NULL;
+		alpha_init = NULL;
 	}
 
 
@@ -77,6 +79,10 @@ public:
     float64_t *C;
     /** precomputed p */
 	float64_t *pv;
+	/** initial alphas (C_SVC only), indexed by the index of the nodes in
+	 * x, NULL to start from zero
+	 */
+	float64_t *alpha_init;
 
 };
 
@@ -124,6 +130,9 @@ struct svm_parameter
 	int32_t shrinking;
 	/** compute bias */
 	bool use_bias;
+	/** kernel rows of all training vectors shared by the sub-problems,
+	 * set by svm_train */
+	KernelRowCache<float64_t>* kernel_rows;
 };
 
 /** svm_model */
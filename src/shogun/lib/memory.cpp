@@ -14,7 +14,14 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <mutex>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #ifdef USE_JEMALLOC
 #include <jemalloc/jemalloc.h>
@@ -107,99 +114,525 @@ void operator delete[](void *p, std::align_val_t al)
 
 #endif // USE_JEMALLOC
 
-namespace shogun
+namespace
 {
-void* sg_malloc(size_t size)
+/* backends */
+
+void* backend_malloc(size_t size)
 {
 #if defined(USE_JEMALLOC)
-	void* p=je_malloc(size);
+	return je_malloc(size);
 #elif defined(USE_TCMALLOC)
-	void *p=tc_malloc(size);
+	return tc_malloc(size);
 #else
-	void* p=std::malloc(size);
+	return std::malloc(size);
 #endif
-	if (!p)
-		allocation_error(p, size, "malloc");
+}
 
-	return p;
+void* backend_calloc(size_t num, size_t size)
+{
+#if defined(USE_JEMALLOC)
+	return je_calloc(num, size);
+#elif defined(USE_TCMALLOC)
+	return tc_calloc(num, size);
+#else
+	return calloc(num, size);
+#endif
+}
+
+void* backend_realloc(void* ptr, size_t size)
+{
+#if defined(USE_JEMALLOC)
+	return je_realloc(ptr, size);
+#elif defined(USE_TCMALLOC)
+	return tc_realloc(ptr, size);
+#else
+	return realloc(ptr, size);
+#endif
+}
+
+void backend_free(void* ptr)
+{
+#if defined(USE_JEMALLOC)
+	je_free(ptr);
+#elif defined(USE_TCMALLOC)
+	tc_free(ptr);
+#else
+	free(ptr);
+#endif
 }
 
 #ifdef HAVE_ALIGNED_MALLOC
-void* sg_aligned_malloc(size_t size, size_t al)
+/* size has to be a multiple of al */
+void* backend_aligned_malloc(size_t size, size_t al)
 {
-	/* the value of size shall be an integral multiple of alignment.  */
-	if (std::size_t rem = size & (al - 1))
-		size += al - rem;
 #if defined(USE_JEMALLOC)
-	void* p = je_aligned_alloc(al, size);
+	return je_aligned_alloc(al, size);
 #elif defined(USE_TCMALLOC)
-	void *p = tc_memalign(al, size);
+	return tc_memalign(al, size);
 #else
 
 #ifdef HAVE_STD_ALIGNED_ALLOC
-	void* p = std::aligned_alloc(al, size);
+	return std::aligned_alloc(al, size);
 #else
 
 #ifdef _MSC_VER
-	void* p = _aligned_malloc(size, al);
+	return _aligned_malloc(size, al);
 #elif defined(HAVE_POSIX_MEMALIGN)
 	void* p = nullptr;
 	int r = posix_memalign(&p, al, size);
 	if (r)
 		p = nullptr;
+	return p;
 #else
 	#error "HAVE_ALIGNED_MALLOC but dont have a method for it!"
 #endif
 #endif // HAVE_STD_ALIGNED_ALLOC
 #endif // USE_JEMALLOC || USE_TCMALLOC
+}
+#endif // HAVE_ALIGNED_MALLOC
+
+/* statistics */
+
+std::atomic<bool> statistics_enabled{false};
+std::atomic<uint64_t> stat_allocations{0};
+std::atomic<uint64_t> stat_frees{0};
+std::atomic<uint64_t> stat_pool_allocations{0};
+std::atomic<uint64_t> stat_huge_page_allocations{0};
+std::atomic<uint64_t> stat_bytes{0};
+
+SG_FORCED_INLINE void count_allocation(size_t size, std::atomic<uint64_t>* path=nullptr)
+{
+	if (!statistics_enabled.load(std::memory_order_relaxed))
+		return;
+
+	stat_allocations.fetch_add(1, std::memory_order_relaxed);
+	stat_bytes.fetch_add(size, std::memory_order_relaxed);
+	if (path)
+		path->fetch_add(1, std::memory_order_relaxed);
+}
+
+SG_FORCED_INLINE void count_free()
+{
+	if (statistics_enabled.load(std::memory_order_relaxed))
+		stat_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* small block pool
+ *
+ * Slabs are aligned to their size and start with a header holding the size
+ * of their blocks. A two level map of the slab addresses tells sg_free()
+ * whether a pointer belongs to the pool without touching the pointer's
+ * memory, the map entries are never removed.
+ */
+
+constexpr size_t pool_slab_size=size_t(1)<<16;
+constexpr size_t pool_slab_header=64;
+constexpr size_t pool_max_block=512;
+constexpr int32_t pool_num_classes=10;
+constexpr size_t pool_class_size[pool_num_classes]={
+	16, 32, 48, 64, 96, 128, 192, 256, 384, 512};
+constexpr int32_t pool_cache_limit=1024;
+constexpr int32_t pool_refill_batch=256;
+
+struct PoolBlock
+{
+	PoolBlock* next;
+};
+
+struct PoolSlab
+{
+	int32_t size_class;
+};
+
+/* thread-local free lists, trivially destructible so they stay accessible
+ * while other thread-local objects are destroyed */
+struct PoolCache
+{
+	PoolBlock* free_list[pool_num_classes];
+	int32_t num_free[pool_num_classes];
+	bool flushed;
+};
+
+constexpr int32_t pool_map_bits=16;
+std::atomic<uint8_t*> pool_map[size_t(1)<<pool_map_bits];
+
+std::atomic<bool> pool_enabled{false};
+std::mutex pool_mutex;
+PoolBlock* pool_global_free[pool_num_classes];
+
+thread_local PoolCache pool_cache;
+
+SG_FORCED_INLINE int32_t pool_size_class(size_t size)
+{
+	int32_t c=0;
+	while (pool_class_size[c]<size)
+		c++;
+	return c;
+}
+
+SG_FORCED_INLINE bool pool_owns(const void* ptr)
+{
+	const uintptr_t a=reinterpret_cast<uintptr_t>(ptr);
+	if (a>>(32+pool_map_bits))
+		return false;
+
+	const uint8_t* leaf=pool_map[(a>>32) & ((1<<pool_map_bits)-1)].load(
+		std::memory_order_acquire);
+	return leaf && leaf[(a>>pool_map_bits) & ((1<<pool_map_bits)-1)];
+}
+
+SG_FORCED_INLINE PoolSlab* pool_slab(const void* ptr)
+{
+	return reinterpret_cast<PoolSlab*>(
+		reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t(pool_slab_size)-1));
+}
+
+/* move the free lists of the exiting thread to the global lists */
+void pool_flush_cache()
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	for (int32_t c=0; c<pool_num_classes; c++)
+	{
+		while (PoolBlock* b=pool_cache.free_list[c])
+		{
+			pool_cache.free_list[c]=b->next;
+			b->next=pool_global_free[c];
+			pool_global_free[c]=b;
+		}
+		pool_cache.num_free[c]=0;
+	}
+	pool_cache.flushed=true;
+}
+
+struct PoolCacheFlush
+{
+	~PoolCacheFlush()
+	{
+		pool_flush_cache();
+	}
+};
+
+thread_local PoolCacheFlush pool_cache_flush;
+
+/* new slab of size class c, called with pool_mutex held */
+bool pool_add_slab(int32_t c)
+{
+#ifdef HAVE_ALIGNED_MALLOC
+	auto* slab=(PoolSlab*) backend_aligned_malloc(pool_slab_size, pool_slab_size);
+	if (!slab)
+		return false;
+
+	const uintptr_t a=reinterpret_cast<uintptr_t>(slab);
+	if (a>>(32+pool_map_bits))
+	{
+		backend_free(slab);
+		return false;
+	}
+
+	auto& leaf=pool_map[(a>>32) & ((1<<pool_map_bits)-1)];
+	uint8_t* entries=leaf.load(std::memory_order_relaxed);
+	if (!entries)
+	{
+		entries=(uint8_t*) backend_calloc(size_t(1)<<pool_map_bits, 1);
+		if (!entries)
+		{
+			backend_free(slab);
+			return false;
+		}
+		leaf.store(entries, std::memory_order_release);
+	}
+
+	slab->size_class=c;
+	const size_t block_size=pool_class_size[c];
+	char* first=reinterpret_cast<char*>(slab)+pool_slab_header;
+	const size_t num_blocks=(pool_slab_size-pool_slab_header)/block_size;
+	for (size_t i=num_blocks; i-->0;)
+	{
+		auto* b=reinterpret_cast<PoolBlock*>(first+i*block_size);
+		b->next=pool_global_free[c];
+		pool_global_free[c]=b;
+	}
+
+	std::atomic_thread_fence(std::memory_order_release);
+	entries[(a>>pool_map_bits) & ((1<<pool_map_bits)-1)]=1;
+	return true;
+#else
+	return false;
+#endif
+}
+
+/* move up to pool_refill_batch blocks of the global list to the thread */
+bool pool_refill(int32_t c)
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	if (!pool_global_free[c] && !pool_add_slab(c))
+		return false;
+
+	for (int32_t i=0; i<pool_refill_batch && pool_global_free[c]; i++)
+	{
+		PoolBlock* b=pool_global_free[c];
+		pool_global_free[c]=b->next;
+		b->next=pool_cache.free_list[c];
+		pool_cache.free_list[c]=b;
+		pool_cache.num_free[c]++;
+	}
+	return true;
+}
+
+/* block of the pool, nullptr if the pool cannot serve it */
+void* pool_malloc(size_t size)
+{
+	if (pool_cache.flushed)
+		return nullptr;
+
+	const int32_t c=pool_size_class(size);
+	if (!pool_cache.free_list[c])
+	{
+		/* register the flush of the free lists at thread exit */
+		(void) &pool_cache_flush;
+		if (!pool_refill(c))
+			return nullptr;
+	}
+
+	PoolBlock* b=pool_cache.free_list[c];
+	pool_cache.free_list[c]=b->next;
+	pool_cache.num_free[c]--;
+	return b;
+}
+
+void pool_free(void* ptr)
+{
+	const int32_t c=pool_slab(ptr)->size_class;
+	auto* b=static_cast<PoolBlock*>(ptr);
+	if (pool_cache.flushed || pool_cache.num_free[c]>=pool_cache_limit)
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex);
+		b->next=pool_global_free[c];
+		pool_global_free[c]=b;
+		return;
+	}
+
+	b->next=pool_cache.free_list[c];
+	pool_cache.free_list[c]=b;
+	pool_cache.num_free[c]++;
+}
+
+/* huge pages */
+
+std::atomic<size_t> huge_page_threshold{0};
+constexpr size_t huge_page_size=size_t(1)<<21;
+
+SG_FORCED_INLINE bool use_huge_pages(size_t size)
+{
+	const size_t threshold=huge_page_threshold.load(std::memory_order_relaxed);
+	return threshold && size>=threshold;
+}
+
+/* block on a huge page boundary, nullptr if not available */
+void* huge_page_malloc(size_t size)
+{
+#if defined(HAVE_ALIGNED_MALLOC) && defined(__linux__)
+	if (std::size_t rem = size & (huge_page_size - 1))
+		size += huge_page_size - rem;
+	void* p=backend_aligned_malloc(size, huge_page_size);
+#ifdef MADV_HUGEPAGE
+	if (p)
+		madvise(p, size, MADV_HUGEPAGE);
+#endif
+	return p;
+#else
+	return nullptr;
+#endif
+}
+} // namespace
+
+namespace shogun
+{
+void* sg_malloc(size_t size)
+{
+	if (size<=pool_max_block && pool_enabled.load(std::memory_order_relaxed))
+	{
+		if (void* p=pool_malloc(size))
+		{
+			count_allocation(size, &stat_pool_allocations);
+			return p;
+		}
+	}
+	else if (use_huge_pages(size))
+	{
+		if (void* p=huge_page_malloc(size))
+		{
+			count_allocation(size, &stat_huge_page_allocations);
+			return p;
+		}
+	}
+
+	void* p=backend_malloc(size);
+	if (!p)
+		allocation_error(p, size, "malloc");
+
+	count_allocation(size);
+	return p;
+}
+
+#ifdef HAVE_ALIGNED_MALLOC
+void* sg_aligned_malloc(size_t size, size_t al)
+{
+	/* pool blocks are aligned to 16 bytes */
+	if (al<=16 && size<=pool_max_block &&
+		pool_enabled.load(std::memory_order_relaxed))
+	{
+		if (void* p=pool_malloc(size))
+		{
+			count_allocation(size, &stat_pool_allocations);
+			return p;
+		}
+	}
+	else if (al<=huge_page_size && use_huge_pages(size))
+	{
+		if (void* p=huge_page_malloc(size))
+		{
+			count_allocation(size, &stat_huge_page_allocations);
+			return p;
+		}
+	}
+
+	const size_t requested=size;
+	/* the value of size shall be an integral multiple of alignment.  */
+	if (std::size_t rem = size & (al - 1))
+		size += al - rem;
+	void* p=backend_aligned_malloc(size, al);
 	if (!p)
 		allocation_error(p, size, "aligned_malloc");
 
+	count_allocation(requested);
 	return p;
 }
 #endif // HAVE_ALIGNED_MALLOC
 
 void* sg_calloc(size_t num, size_t size)
 {
-#if defined(USE_JEMALLOC)
-	void* p=je_calloc(num, size);
-#elif defined(USE_TCMALLOC)
-	void* p=tc_calloc(num, size);
-#else
-	void* p=calloc(num, size);
-#endif
+	if (size && num>SIZE_MAX/size)
+		allocation_error(nullptr, size, "calloc");
 
+	const size_t total=num*size;
+	if (total<=pool_max_block && pool_enabled.load(std::memory_order_relaxed))
+	{
+		if (void* p=pool_malloc(total))
+		{
+			memset(p, 0, total);
+			count_allocation(total, &stat_pool_allocations);
+			return p;
+		}
+	}
+	else if (use_huge_pages(total))
+	{
+		if (void* p=huge_page_malloc(total))
+		{
+			memset(p, 0, total);
+			count_allocation(total, &stat_huge_page_allocations);
+			return p;
+		}
+	}
+
+	void* p=backend_calloc(num, size);
 	if (!p)
 		allocation_error(p, size, "calloc");
+
+	count_allocation(total);
 	return p;
 }
 
 void  sg_free(void* ptr)
 {
-#if defined(USE_JEMALLOC)
-	je_free(ptr);
-#elif defined(USE_TCMALLOC)
-	tc_free(ptr);
-#else
-	free(ptr);
-#endif
+	if (!ptr)
+		return;
+
+	count_free();
+	if (pool_owns(ptr))
+		pool_free(ptr);
+	else
+		backend_free(ptr);
 }
 
 void* sg_realloc(void* ptr, size_t size)
 {
-#if defined(USE_JEMALLOC)
-	void* p=je_realloc(ptr, size);
-#elif defined(USE_TCMALLOC)
-	void* p=tc_realloc(ptr, size);
-#else
-	void* p=realloc(ptr, size);
-#endif
+	if (!ptr)
+		return sg_malloc(size);
+
+	if (pool_owns(ptr))
+	{
+		const size_t block_size=pool_class_size[pool_slab(ptr)->size_class];
+		if (!size)
+		{
+			sg_free(ptr);
+			return nullptr;
+		}
+		if (size<=block_size)
+			return ptr;
+
+		void* p=sg_malloc(size);
+		sg_memcpy(p, ptr, block_size);
+		sg_free(ptr);
+		return p;
+	}
 
-	if (!p && (size || !ptr))
+	void* p=backend_realloc(ptr, size);
+	if (!p && size)
 		allocation_error(p, size, "realloc");
 
 	return p;
 }
+
+void set_small_block_pool_enabled(bool enabled)
+{
+#ifdef HAVE_ALIGNED_MALLOC
+	pool_enabled.store(enabled);
+#endif
+}
+
+bool get_small_block_pool_enabled()
+{
+	return pool_enabled.load();
+}
+
+void set_huge_page_threshold(size_t threshold)
+{
+#if defined(HAVE_ALIGNED_MALLOC) && defined(__linux__)
+	huge_page_threshold.store(threshold);
+#endif
+}
+
+size_t get_huge_page_threshold()
+{
+	return huge_page_threshold.load();
+}
+
+void set_memory_statistics_enabled(bool enabled)
+{
+	statistics_enabled.store(enabled);
+}
+
+MemoryStatistics get_memory_statistics()
+{
+	MemoryStatistics stats;
+	stats.num_allocations=stat_allocations.load();
+	stats.num_frees=stat_frees.load();
+	stats.num_pool_allocations=stat_pool_allocations.load();
+	stats.num_huge_page_allocations=stat_huge_page_allocations.load();
+	stats.bytes_allocated=stat_bytes.load();
+	return stats;
+}
+
+void reset_memory_statistics()
+{
+	stat_allocations.store(0);
+	stat_frees.store(0);
+	stat_pool_allocations.store(0);
+	stat_huge_page_allocations.store(0);
+	stat_bytes.store(0);
+}
 }
 
 void* shogun::get_copy(void* src, size_t len)
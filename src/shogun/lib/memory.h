@@ -143,6 +143,59 @@ namespace alignment
 	static constexpr index_t container_alignment = 16;
 }
 
+/** counters of the allocations through SG_MALLOC, SG_CALLOC, SG_REALLOC and
+ * SG_ALIGNED_MALLOC since the last reset_memory_statistics(), only counted
+ * while set_memory_statistics_enabled() */
+struct MemoryStatistics
+{
+	/** number of allocated blocks */
+	uint64_t num_allocations;
+	/** number of freed blocks */
+	uint64_t num_frees;
+	/** number of blocks served by the small block pool */
+	uint64_t num_pool_allocations;
+	/** number of blocks allocated on huge page boundaries */
+	uint64_t num_huge_page_allocations;
+	/** number of requested bytes */
+	uint64_t bytes_allocated;
+};
+
+/** serve blocks of up to 512 bytes from thread-local free lists of size
+ * classes instead of the system allocator
+ *
+ * The free lists are filled from 64KiB slabs that are kept for the lifetime
+ * of the process, blocks freed by another thread go to its free list. Blocks
+ * allocated while the pool was enabled may be freed after disabling it.
+ * Requires aligned malloc, otherwise the pool stays disabled.
+ *
+ * @param enabled whether small blocks are pooled
+ */
+void set_small_block_pool_enabled(bool enabled);
+
+/** @return whether small blocks are pooled */
+bool get_small_block_pool_enabled();
+
+/** allocate blocks of at least threshold bytes on 2MiB boundaries and
+ * advise the kernel to back them by transparent huge pages
+ *
+ * Only available on Linux with aligned malloc.
+ *
+ * @param threshold smallest size of huge page blocks in bytes, 0 disables
+ */
+void set_huge_page_threshold(size_t threshold);
+
+/** @return smallest size of huge page blocks in bytes, 0 if disabled */
+size_t get_huge_page_threshold();
+
+/** @param enabled whether allocations are counted, see get_memory_statistics() */
+void set_memory_statistics_enabled(bool enabled);
+
+/** @return counters of the allocations */
+MemoryStatistics get_memory_statistics();
+
+/** set all counters of the allocations to zero */
+void reset_memory_statistics();
+
 void* get_copy(void* src, size_t len);
 char* get_strdup(const char* str);
 }
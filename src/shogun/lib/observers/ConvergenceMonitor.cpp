@@ -0,0 +1,144 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/observers/ConvergenceMonitor.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace shogun;
+
+ConvergenceMonitor::ConvergenceMonitor() : SGObject()
+{
+	init();
+}
+
+ConvergenceMonitor::ConvergenceMonitor(
+    int32_t capacity, int32_t sampling_interval)
+    : SGObject()
+{
+	init();
+	require(capacity > 0, "Capacity ({}) must be positive", capacity);
+	m_capacity = capacity;
+	set_sampling_interval(sampling_interval);
+}
+
+ConvergenceMonitor::~ConvergenceMonitor()
+{
+}
+
+void ConvergenceMonitor::init()
+{
+	m_capacity = 1024;
+	m_sampling_interval = 1;
+	m_stopping_channel = -1;
+	m_patience = 0;
+	m_maximize = false;
+	m_min_delta = 0.0;
+	m_best_value = 0.0;
+	m_best_step = -1;
+	m_num_bad_values = 0;
+
+	SG_ADD(&m_capacity, "capacity", "Number of values kept per channel");
+	SG_ADD(
+	    &m_sampling_interval, "sampling_interval",
+	    "Record every sampling_interval-th step");
+	SG_ADD(
+	    &m_patience, "patience",
+	    "Number of values without improvement before stopping");
+	SG_ADD(
+	    &m_maximize, "maximize",
+	    "Whether larger values of the early stopping channel are better");
+	SG_ADD(&m_min_delta, "min_delta", "Minimal change counted as improvement");
+}
+
+index_t ConvergenceMonitor::add_channel(std::string_view name)
+{
+	index_t index = get_channel(name);
+	if (index >= 0)
+		return index;
+
+	m_names.emplace_back(name);
+	m_channels.emplace_back(m_capacity);
+	return m_channels.size() - 1;
+}
+
+index_t ConvergenceMonitor::get_channel(std::string_view name) const
+{
+	auto it = std::find(m_names.begin(), m_names.end(), name);
+	return it == m_names.end() ? -1 : std::distance(m_names.begin(), it);
+}
+
+void ConvergenceMonitor::set_early_stopping(
+    std::string_view name, int32_t patience, bool maximize, float64_t min_delta)
+{
+	require(patience > 0, "Patience ({}) must be positive", patience);
+	require(min_delta >= 0, "Minimal delta ({}) must not be negative", min_delta);
+
+	m_stopping_channel = add_channel(name);
+	m_patience = patience;
+	m_maximize = maximize;
+	m_min_delta = min_delta;
+	m_best_step = -1;
+	m_num_bad_values = 0;
+}
+
+void ConvergenceMonitor::update_early_stopping(int64_t step, float64_t value)
+{
+	const bool improved = m_best_step < 0 ||
+	                      (m_maximize ? value > m_best_value + m_min_delta
+	                                  : value < m_best_value - m_min_delta);
+	if (improved)
+	{
+		m_best_value = value;
+		m_best_step = step;
+		m_num_bad_values = 0;
+	}
+	else
+		m_num_bad_values++;
+}
+
+const ScalarRingBuffer<float64_t>&
+ConvergenceMonitor::channel(std::string_view name) const
+{
+	index_t index = get_channel(name);
+	require(index >= 0, "{} has no channel {}", get_name(), name);
+	return m_channels[index];
+}
+
+SGVector<float64_t> ConvergenceMonitor::get_values(std::string_view name) const
+{
+	const auto& buffer = channel(name);
+	SGVector<float64_t> values(buffer.size());
+	for (index_t i = 0; i < buffer.size(); i++)
+		values[i] = buffer.value(i);
+	return values;
+}
+
+SGVector<int64_t> ConvergenceMonitor::get_steps(std::string_view name) const
+{
+	const auto& buffer = channel(name);
+	SGVector<int64_t> steps(buffer.size());
+	for (index_t i = 0; i < buffer.size(); i++)
+		steps[i] = buffer.step(i);
+	return steps;
+}
+
+void ConvergenceMonitor::reset()
+{
+	for (auto& buffer : m_channels)
+		buffer.clear();
+	m_best_step = -1;
+	m_num_bad_values = 0;
+}
+
+void ConvergenceMonitor::set_sampling_interval(int32_t sampling_interval)
+{
+	require(
+	    sampling_interval > 0, "Sampling interval ({}) must be positive",
+	    sampling_interval);
+	m_sampling_interval = sampling_interval;
+}
@@ -0,0 +1,185 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SHOGUN_CONVERGENCEMONITOR_H
+#define SHOGUN_CONVERGENCEMONITOR_H
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/observers/ScalarRingBuffer.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace shogun
+{
+
+	/**
+	 * Low overhead recorder of scalar training curves, with validation
+	 * based early stopping.
+	 *
+	 * Unlike ParameterObserver, values are not wrapped into ObservedValue
+	 * instances and sent through the observable of an SGObject. Each named
+	 * channel is a preallocated ScalarRingBuffer, so recording a value does
+	 * not allocate memory, and a sampling interval lets the caller skip
+	 * computing values on most iterations.
+	 *
+	 * If early stopping is enabled on a channel, the monitor tracks the best
+	 * value of that channel and should_stop() returns true once it has not
+	 * improved by more than the minimum delta for the given number of
+	 * recorded values (the patience).
+	 */
+	class ConvergenceMonitor : public SGObject
+	{
+	public:
+		ConvergenceMonitor();
+
+		/**
+		 * @param capacity number of values kept per channel
+		 * @param sampling_interval record every sampling_interval-th step
+		 */
+		ConvergenceMonitor(int32_t capacity, int32_t sampling_interval = 1);
+
+		~ConvergenceMonitor() override;
+
+		/**
+		 * Add a channel, or return the index of an existing one.
+		 * @param name channel name
+		 * @return channel index to be passed to record()
+		 */
+		index_t add_channel(std::string_view name);
+
+		/**
+		 * @param name channel name
+		 * @return channel index, or -1 if there is no such channel
+		 */
+		index_t get_channel(std::string_view name) const;
+
+		/**
+		 * Whether values should be recorded at a step.
+		 * @param step current step
+		 * @return true every sampling_interval-th step
+		 */
+		bool should_sample(int64_t step) const
+		{
+			return step % m_sampling_interval == 0;
+		}
+
+		/**
+		 * Record a value. Does not allocate memory.
+		 * @param channel channel index, as returned by add_channel()
+		 * @param step current step
+		 * @param value value to be recorded
+		 */
+		void record(index_t channel, int64_t step, float64_t value)
+		{
+			m_channels[channel].push(step, value);
+			if (channel == m_stopping_channel)
+				update_early_stopping(step, value);
+		}
+
+		/**
+		 * Enable early stopping on a channel, which is added if needed.
+		 * @param name channel name, eg a validation error
+		 * @param patience number of recorded values without improvement
+		 * after which training should stop
+		 * @param maximize whether larger values are better
+		 * @param min_delta minimal change counted as an improvement
+		 */
+		void set_early_stopping(
+		    std::string_view name, int32_t patience, bool maximize = false,
+		    float64_t min_delta = 0.0);
+
+		/** @return whether training should stop */
+		bool should_stop() const
+		{
+			return m_stopping_channel >= 0 && m_num_bad_values >= m_patience;
+		}
+
+		/** @return best value of the early stopping channel */
+		float64_t get_best_value() const
+		{
+			return m_best_value;
+		}
+
+		/** @return step of the best value of the early stopping channel */
+		int64_t get_best_step() const
+		{
+			return m_best_step;
+		}
+
+		/**
+		 * @param name channel name
+		 * @return recorded values, oldest first
+		 */
+		SGVector<float64_t> get_values(std::string_view name) const;
+
+		/**
+		 * @param name channel name
+		 * @return steps of the recorded values, oldest first
+		 */
+		SGVector<int64_t> get_steps(std::string_view name) const;
+
+		/** Clear all channels and the early stopping state */
+		void reset();
+
+		/** @param sampling_interval record every sampling_interval-th step */
+		void set_sampling_interval(int32_t sampling_interval);
+
+		/** @return sampling interval */
+		int32_t get_sampling_interval() const
+		{
+			return m_sampling_interval;
+		}
+
+		const char* get_name() const override
+		{
+			return "ConvergenceMonitor";
+		}
+
+	private:
+		void init();
+
+		void update_early_stopping(int64_t step, float64_t value);
+
+		const ScalarRingBuffer<float64_t>& channel(std::string_view name) const;
+
+		/** number of values kept per channel */
+		int32_t m_capacity;
+
+		/** record every m_sampling_interval-th step */
+		int32_t m_sampling_interval;
+
+		/** channel names */
+		std::vector<std::string> m_names;
+
+		/** channel histories */
+		std::vector<ScalarRingBuffer<float64_t>> m_channels;
+
+		/** index of the early stopping channel, -1 if disabled */
+		index_t m_stopping_channel;
+
+		/** number of values without improvement before stopping */
+		int32_t m_patience;
+
+		/** whether larger values of the early stopping channel are better */
+		bool m_maximize;
+
+		/** minimal change counted as an improvement */
+		float64_t m_min_delta;
+
+		/** best value of the early stopping channel */
+		float64_t m_best_value;
+
+		/** step of the best value */
+		int64_t m_best_step;
+
+		/** number of values recorded since the best value */
+		int32_t m_num_bad_values;
+	};
+} // namespace shogun
+
+#endif // SHOGUN_CONVERGENCEMONITOR_H
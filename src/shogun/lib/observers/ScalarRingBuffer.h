@@ -0,0 +1,114 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SHOGUN_SCALARRINGBUFFER_H
+#define SHOGUN_SCALARRINGBUFFER_H
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+
+	/**
+	 * Fixed capacity history of (step, value) pairs of a scalar.
+	 *
+	 * All memory is allocated by the constructor, so recording a value is a
+	 * couple of stores. Once the buffer is full, the oldest entry is
+	 * overwritten.
+	 *
+	 * @tparam T type of the scalar
+	 */
+	template <class T>
+	class ScalarRingBuffer
+	{
+	public:
+		/**
+		 * @param capacity maximum number of entries kept
+		 */
+		explicit ScalarRingBuffer(index_t capacity = 0)
+		    : m_steps(capacity), m_values(capacity), m_begin(0), m_size(0)
+		{
+		}
+
+		/**
+		 * Append an entry, overwriting the oldest one if the buffer is full.
+		 * Does nothing if the capacity is zero.
+		 * @param step step at which the value was recorded
+		 * @param value recorded value
+		 */
+		void push(int64_t step, T value)
+		{
+			const index_t cap = capacity();
+			if (cap == 0)
+				return;
+
+			index_t pos = m_begin + m_size;
+			if (pos >= cap)
+				pos -= cap;
+
+			m_steps[pos] = step;
+			m_values[pos] = value;
+
+			if (m_size < cap)
+				m_size++;
+			else if (++m_begin == cap)
+				m_begin = 0;
+		}
+
+		/** @return step of the i-th oldest entry */
+		int64_t step(index_t i) const
+		{
+			return m_steps[position(i)];
+		}
+
+		/** @return value of the i-th oldest entry */
+		T value(index_t i) const
+		{
+			return m_values[position(i)];
+		}
+
+		/** @return number of entries */
+		index_t size() const
+		{
+			return m_size;
+		}
+
+		/** @return maximum number of entries */
+		index_t capacity() const
+		{
+			return m_values.vlen;
+		}
+
+		/** @return whether there are no entries */
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		/** Remove all entries, keeping the memory */
+		void clear()
+		{
+			m_begin = 0;
+			m_size = 0;
+		}
+
+	private:
+		index_t position(index_t i) const
+		{
+			ASSERT(i >= 0 && i < m_size);
+			index_t pos = m_begin + i;
+			return pos >= capacity() ? pos - capacity() : pos;
+		}
+
+		SGVector<int64_t> m_steps;
+		SGVector<T> m_values;
+		index_t m_begin;
+		index_t m_size;
+	};
+} // namespace shogun
+
+#endif // SHOGUN_SCALARRINGBUFFER_H
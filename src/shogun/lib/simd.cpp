@@ -0,0 +1,778 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/cpu.h>
+#include <shogun/lib/simd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define SG_SIMD_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define SG_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace shogun
+{
+namespace simd
+{
+namespace
+{
+	template <class T>
+	struct Kernels
+	{
+		float64_t (*dot)(const T* x, const float64_t* w, index_t n);
+		void (*axpy)(float64_t alpha, const T* x, float64_t* y, index_t n);
+	};
+
+	struct MathKernels
+	{
+		void (*exp)(const float64_t* x, float64_t* y, index_t n);
+		void (*log)(const float64_t* x, float64_t* y, index_t n);
+	};
+
+	/* the loops of the generic dot and axpy, which are specialized here */
+	template <class T>
+	float64_t dot_generic(const T* x, const float64_t* w, index_t n)
+	{
+		float64_t result=0;
+		for (index_t i=0; i<n; i++)
+			result+=float64_t(x[i])*w[i];
+		return result;
+	}
+
+	template <class T>
+	void axpy_generic(float64_t alpha, const T* x, float64_t* y, index_t n)
+	{
+		for (index_t i=0; i<n; i++)
+			y[i]+=alpha*float64_t(x[i]);
+	}
+
+	void exp_generic(const float64_t* x, float64_t* y, index_t n)
+	{
+		for (index_t i=0; i<n; i++)
+			y[i]=std::exp(x[i]);
+	}
+
+	void log_generic(const float64_t* x, float64_t* y, index_t n)
+	{
+		for (index_t i=0; i<n; i++)
+			y[i]=std::log(x[i]);
+	}
+
+	/* the coefficients of exp.c and log.c of Cephes (Moshier), exp reduces
+	 * x to r=x-n*log(2) with |r|<=log(2)/2 and log to x=m*2^e with
+	 * sqrt(1/2)<=m<sqrt(2)
+	 */
+	constexpr float64_t EXP_BOUND=708.0;
+	constexpr float64_t EXP_LOG2E=1.4426950408889634073599;
+	constexpr float64_t EXP_C1=6.93145751953125E-1;
+	constexpr float64_t EXP_C2=1.42860682030941723212E-6;
+	constexpr float64_t EXP_P[]={
+		1.26177193074810590878E-4, 3.02994407707441961300E-2,
+		9.99999999999999999910E-1};
+	constexpr float64_t EXP_Q[]={
+		3.00198505138664455042E-6, 2.52448340349684104192E-3,
+		2.27265548208155028766E-1, 2.00000000000000000009E0};
+	constexpr float64_t LOG_SQRTH=0.70710678118654752440;
+	constexpr float64_t LOG_P[]={
+		1.01875663804580931796E-4, 4.97494994976747001425E-1,
+		4.70579119878881725854E0, 1.44989225341610930846E1,
+		1.79368678507819816313E1, 7.70838733755885391666E0};
+	/* the leading coefficient 1 is implicit */
+	constexpr float64_t LOG_Q[]={
+		1.12873587189167450590E1, 4.52279145837532221105E1,
+		8.29875266912776603211E1, 7.11544750618563894466E1,
+		2.31251620126765340583E1};
+	constexpr float64_t LOG_C1=2.121944400546905827679E-4;
+	constexpr float64_t LOG_C2=0.693359375;
+	/* 2^52 and 2^52+2^51, adding a small integer valued float to them puts
+	 * the integer into the low bits of the mantissa
+	 */
+	constexpr float64_t TWO52=4503599627370496.0;
+	constexpr float64_t ROUND_MAGIC=6755399441055744.0;
+	constexpr int64_t MANTISSA_MASK=0x000fffffffffffffLL;
+	constexpr int64_t HALF_EXPONENT=0x3fe0000000000000LL;
+
+#ifdef SG_SIMD_X86
+#define SG_SSE42 __attribute__((target("sse4.2")))
+#define SG_AVX2 __attribute__((target("avx2,fma")))
+#define SG_AVX512 __attribute__((target("avx512f")))
+
+	/* two elements converted to 64 bit floats */
+	SG_SSE42 inline __m128d load2(const float64_t* x)
+	{
+		return _mm_loadu_pd(x);
+	}
+
+	SG_SSE42 inline __m128d load2(const float32_t* x)
+	{
+		return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*) x)));
+	}
+
+	SG_SSE42 inline __m128d load2(const int8_t* x)
+	{
+		int16_t bytes;
+		std::memcpy(&bytes, x, sizeof(bytes));
+		return _mm_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(uint16_t(bytes))));
+	}
+
+	SG_SSE42 inline __m128d load2(const uint8_t* x)
+	{
+		int16_t bytes;
+		std::memcpy(&bytes, x, sizeof(bytes));
+		return _mm_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(uint16_t(bytes))));
+	}
+
+	/* four elements converted to 64 bit floats */
+	SG_AVX2 inline __m256d load4(const float64_t* x)
+	{
+		return _mm256_loadu_pd(x);
+	}
+
+	SG_AVX2 inline __m256d load4(const float32_t* x)
+	{
+		return _mm256_cvtps_pd(_mm_loadu_ps(x));
+	}
+
+	SG_AVX2 inline __m256d load4(const int8_t* x)
+	{
+		int32_t bytes;
+		std::memcpy(&bytes, x, sizeof(bytes));
+		return _mm256_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(bytes)));
+	}
+
+	SG_AVX2 inline __m256d load4(const uint8_t* x)
+	{
+		int32_t bytes;
+		std::memcpy(&bytes, x, sizeof(bytes));
+		return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes)));
+	}
+
+	/* eight elements converted to 64 bit floats */
+	SG_AVX512 inline __m512d load8(const float64_t* x)
+	{
+		return _mm512_loadu_pd(x);
+	}
+
+	SG_AVX512 inline __m512d load8(const float32_t* x)
+	{
+		return _mm512_cvtps_pd(_mm256_loadu_ps(x));
+	}
+
+	SG_AVX512 inline __m512d load8(const int8_t* x)
+	{
+		return _mm512_cvtepi32_pd(
+			_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*) x)));
+	}
+
+	SG_AVX512 inline __m512d load8(const uint8_t* x)
+	{
+		return _mm512_cvtepi32_pd(
+			_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) x)));
+	}
+
+	template <class T>
+	SG_SSE42 float64_t dot_sse42(const T* x, const float64_t* w, index_t n)
+	{
+		__m128d sum0=_mm_setzero_pd();
+		__m128d sum1=_mm_setzero_pd();
+		index_t i=0;
+		for (; i+4<=n; i+=4)
+		{
+			sum0=_mm_add_pd(sum0, _mm_mul_pd(load2(x+i), _mm_loadu_pd(w+i)));
+			sum1=_mm_add_pd(sum1, _mm_mul_pd(load2(x+i+2), _mm_loadu_pd(w+i+2)));
+		}
+
+		__m128d sum=_mm_add_pd(sum0, sum1);
+		sum=_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+
+		float64_t result=_mm_cvtsd_f64(sum);
+		for (; i<n; i++)
+			result+=float64_t(x[i])*w[i];
+		return result;
+	}
+
+	template <class T>
+	SG_SSE42 void axpy_sse42(float64_t alpha, const T* x, float64_t* y, index_t n)
+	{
+		const __m128d a=_mm_set1_pd(alpha);
+		index_t i=0;
+		for (; i+2<=n; i+=2)
+			_mm_storeu_pd(y+i, _mm_add_pd(_mm_loadu_pd(y+i), _mm_mul_pd(a, load2(x+i))));
+		for (; i<n; i++)
+			y[i]+=alpha*float64_t(x[i]);
+	}
+
+	template <class T>
+	SG_AVX2 float64_t dot_avx2(const T* x, const float64_t* w, index_t n)
+	{
+		// two accumulators hide the latency of the fused multiply-add
+		__m256d sum0=_mm256_setzero_pd();
+		__m256d sum1=_mm256_setzero_pd();
+		index_t i=0;
+		for (; i+8<=n; i+=8)
+		{
+			sum0=_mm256_fmadd_pd(load4(x+i), _mm256_loadu_pd(w+i), sum0);
+			sum1=_mm256_fmadd_pd(load4(x+i+4), _mm256_loadu_pd(w+i+4), sum1);
+		}
+		if (i+4<=n)
+		{
+			sum0=_mm256_fmadd_pd(load4(x+i), _mm256_loadu_pd(w+i), sum0);
+			i+=4;
+		}
+
+		sum0=_mm256_add_pd(sum0, sum1);
+		__m128d sum=_mm_add_pd(
+			_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+		sum=_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum));
+
+		float64_t result=_mm_cvtsd_f64(sum);
+		for (; i<n; i++)
+			result+=float64_t(x[i])*w[i];
+		return result;
+	}
+
+	template <class T>
+	SG_AVX2 void axpy_avx2(float64_t alpha, const T* x, float64_t* y, index_t n)
+	{
+		const __m256d a=_mm256_set1_pd(alpha);
+		index_t i=0;
+		for (; i+4<=n; i+=4)
+			_mm256_storeu_pd(y+i, _mm256_fmadd_pd(a, load4(x+i), _mm256_loadu_pd(y+i)));
+		for (; i<n; i++)
+			y[i]+=alpha*float64_t(x[i]);
+	}
+
+	template <class T>
+	SG_AVX512 float64_t dot_avx512(const T* x, const float64_t* w, index_t n)
+	{
+		__m512d sum0=_mm512_setzero_pd();
+		__m512d sum1=_mm512_setzero_pd();
+		index_t i=0;
+		for (; i+16<=n; i+=16)
+		{
+			sum0=_mm512_fmadd_pd(load8(x+i), _mm512_loadu_pd(w+i), sum0);
+			sum1=_mm512_fmadd_pd(load8(x+i+8), _mm512_loadu_pd(w+i+8), sum1);
+		}
+		if (i+8<=n)
+		{
+			sum0=_mm512_fmadd_pd(load8(x+i), _mm512_loadu_pd(w+i), sum0);
+			i+=8;
+		}
+
+		float64_t result=_mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1));
+		for (; i<n; i++)
+			result+=float64_t(x[i])*w[i];
+		return result;
+	}
+
+	template <class T>
+	SG_AVX512 void axpy_avx512(float64_t alpha, const T* x, float64_t* y, index_t n)
+	{
+		const __m512d a=_mm512_set1_pd(alpha);
+		index_t i=0;
+		for (; i+8<=n; i+=8)
+			_mm512_storeu_pd(y+i, _mm512_fmadd_pd(a, load8(x+i), _mm512_loadu_pd(y+i)));
+		for (; i<n; i++)
+			y[i]+=alpha*float64_t(x[i]);
+	}
+
+	SG_AVX2 inline __m256d exp4(__m256d x)
+	{
+		const __m256d n=_mm256_round_pd(
+			_mm256_mul_pd(x, _mm256_set1_pd(EXP_LOG2E)),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		x=_mm256_fnmadd_pd(n, _mm256_set1_pd(EXP_C1), x);
+		x=_mm256_fnmadd_pd(n, _mm256_set1_pd(EXP_C2), x);
+
+		// exp(r)=1+2*r*P(r^2)/(Q(r^2)-r*P(r^2))
+		const __m256d xx=_mm256_mul_pd(x, x);
+		__m256d px=_mm256_fmadd_pd(_mm256_set1_pd(EXP_P[0]), xx, _mm256_set1_pd(EXP_P[1]));
+		px=_mm256_mul_pd(_mm256_fmadd_pd(px, xx, _mm256_set1_pd(EXP_P[2])), x);
+		__m256d qx=_mm256_fmadd_pd(_mm256_set1_pd(EXP_Q[0]), xx, _mm256_set1_pd(EXP_Q[1]));
+		qx=_mm256_fmadd_pd(qx, xx, _mm256_set1_pd(EXP_Q[2]));
+		qx=_mm256_fmadd_pd(qx, xx, _mm256_set1_pd(EXP_Q[3]));
+		const __m256d r=_mm256_fmadd_pd(
+			_mm256_set1_pd(2.0), _mm256_div_pd(px, _mm256_sub_pd(qx, px)),
+			_mm256_set1_pd(1.0));
+
+		// 2^n built from its exponent bits
+		const __m256d magic=_mm256_set1_pd(ROUND_MAGIC);
+		const __m256i k=_mm256_sub_epi64(
+			_mm256_castpd_si256(_mm256_add_pd(n, magic)),
+			_mm256_castpd_si256(magic));
+		const __m256i scale=_mm256_slli_epi64(
+			_mm256_add_epi64(k, _mm256_set1_epi64x(1023)), 52);
+		return _mm256_mul_pd(r, _mm256_castsi256_pd(scale));
+	}
+
+	SG_AVX2 inline __m256d log4(__m256d x)
+	{
+		const __m256i bits=_mm256_castpd_si256(x);
+		const __m256d two52=_mm256_set1_pd(TWO52);
+		const __m256d one=_mm256_set1_pd(1.0);
+
+		// x=m*2^e with 1/2<=m<1
+		__m256d e=_mm256_castsi256_pd(_mm256_or_si256(
+			_mm256_srli_epi64(bits, 52), _mm256_castpd_si256(two52)));
+		e=_mm256_sub_pd(e, _mm256_set1_pd(TWO52+1022));
+		__m256d m=_mm256_castsi256_pd(_mm256_or_si256(
+			_mm256_and_si256(bits, _mm256_set1_epi64x(MANTISSA_MASK)),
+			_mm256_set1_epi64x(HALF_EXPONENT)));
+
+		// m<sqrt(1/2): e=e-1 and m=2m-1, otherwise m=m-1
+		const __m256d small=_mm256_cmp_pd(m, _mm256_set1_pd(LOG_SQRTH), _CMP_LT_OQ);
+		e=_mm256_sub_pd(e, _mm256_and_pd(small, one));
+		m=_mm256_sub_pd(_mm256_add_pd(m, _mm256_and_pd(small, m)), one);
+
+		const __m256d z=_mm256_mul_pd(m, m);
+		__m256d p=_mm256_set1_pd(LOG_P[0]);
+		for (auto c : {LOG_P[1], LOG_P[2], LOG_P[3], LOG_P[4], LOG_P[5]})
+			p=_mm256_fmadd_pd(p, m, _mm256_set1_pd(c));
+		__m256d q=_mm256_add_pd(m, _mm256_set1_pd(LOG_Q[0]));
+		for (auto c : {LOG_Q[1], LOG_Q[2], LOG_Q[3], LOG_Q[4]})
+			q=_mm256_fmadd_pd(q, m, _mm256_set1_pd(c));
+
+		__m256d y=_mm256_mul_pd(m, _mm256_div_pd(_mm256_mul_pd(z, p), q));
+		y=_mm256_fnmadd_pd(e, _mm256_set1_pd(LOG_C1), y);
+		y=_mm256_fnmadd_pd(_mm256_set1_pd(0.5), z, y);
+		return _mm256_fmadd_pd(e, _mm256_set1_pd(LOG_C2), _mm256_add_pd(m, y));
+	}
+
+	SG_AVX2 void exp_avx2(const float64_t* x, float64_t* y, index_t n)
+	{
+		const __m256d bound=_mm256_set1_pd(EXP_BOUND);
+		const __m256d sign=_mm256_set1_pd(-0.0);
+		index_t i=0;
+		for (; i+4<=n; i+=4)
+		{
+			const __m256d v=_mm256_loadu_pd(x+i);
+			const int outside=_mm256_movemask_pd(
+				_mm256_cmp_pd(_mm256_andnot_pd(sign, v), bound, _CMP_NLE_UQ));
+			if (!outside)
+			{
+				_mm256_storeu_pd(y+i, exp4(v));
+				continue;
+			}
+
+			// x and y may alias
+			alignas(32) float64_t in[4];
+			_mm256_store_pd(in, v);
+			_mm256_storeu_pd(y+i, exp4(v));
+			for (int32_t k=0; k<4; k++)
+			{
+				if (outside & (1<<k))
+					y[i+k]=std::exp(in[k]);
+			}
+		}
+		for (; i<n; i++)
+			y[i]=std::exp(x[i]);
+	}
+
+	SG_AVX2 void log_avx2(const float64_t* x, float64_t* y, index_t n)
+	{
+		const __m256d lower=_mm256_set1_pd(std::numeric_limits<float64_t>::min());
+		const __m256d upper=_mm256_set1_pd(std::numeric_limits<float64_t>::max());
+		index_t i=0;
+		for (; i+4<=n; i+=4)
+		{
+			const __m256d v=_mm256_loadu_pd(x+i);
+			const int outside=_mm256_movemask_pd(_mm256_or_pd(
+				_mm256_cmp_pd(v, lower, _CMP_NGE_UQ),
+				_mm256_cmp_pd(v, upper, _CMP_NLE_UQ)));
+			if (!outside)
+			{
+				_mm256_storeu_pd(y+i, log4(v));
+				continue;
+			}
+
+			alignas(32) float64_t in[4];
+			_mm256_store_pd(in, v);
+			_mm256_storeu_pd(y+i, log4(v));
+			for (int32_t k=0; k<4; k++)
+			{
+				if (outside & (1<<k))
+					y[i+k]=std::log(in[k]);
+			}
+		}
+		for (; i<n; i++)
+			y[i]=std::log(x[i]);
+	}
+
+	SG_AVX512 inline __m512d exp8(__m512d x)
+	{
+		const __m512d n=_mm512_roundscale_pd(
+			_mm512_mul_pd(x, _mm512_set1_pd(EXP_LOG2E)),
+			_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		x=_mm512_fnmadd_pd(n, _mm512_set1_pd(EXP_C1), x);
+		x=_mm512_fnmadd_pd(n, _mm512_set1_pd(EXP_C2), x);
+
+		const __m512d xx=_mm512_mul_pd(x, x);
+		__m512d px=_mm512_fmadd_pd(_mm512_set1_pd(EXP_P[0]), xx, _mm512_set1_pd(EXP_P[1]));
+		px=_mm512_mul_pd(_mm512_fmadd_pd(px, xx, _mm512_set1_pd(EXP_P[2])), x);
+		__m512d qx=_mm512_fmadd_pd(_mm512_set1_pd(EXP_Q[0]), xx, _mm512_set1_pd(EXP_Q[1]));
+		qx=_mm512_fmadd_pd(qx, xx, _mm512_set1_pd(EXP_Q[2]));
+		qx=_mm512_fmadd_pd(qx, xx, _mm512_set1_pd(EXP_Q[3]));
+		const __m512d r=_mm512_fmadd_pd(
+			_mm512_set1_pd(2.0), _mm512_div_pd(px, _mm512_sub_pd(qx, px)),
+			_mm512_set1_pd(1.0));
+
+		const __m512d magic=_mm512_set1_pd(ROUND_MAGIC);
+		const __m512i k=_mm512_sub_epi64(
+			_mm512_castpd_si512(_mm512_add_pd(n, magic)),
+			_mm512_castpd_si512(magic));
+		const __m512i scale=_mm512_slli_epi64(
+			_mm512_add_epi64(k, _mm512_set1_epi64(1023)), 52);
+		return _mm512_mul_pd(r, _mm512_castsi512_pd(scale));
+	}
+
+	SG_AVX512 inline __m512d log8(__m512d x)
+	{
+		const __m512i bits=_mm512_castpd_si512(x);
+		const __m512d two52=_mm512_set1_pd(TWO52);
+		const __m512d one=_mm512_set1_pd(1.0);
+
+		__m512d e=_mm512_castsi512_pd(_mm512_or_si512(
+			_mm512_srli_epi64(bits, 52), _mm512_castpd_si512(two52)));
+		e=_mm512_sub_pd(e, _mm512_set1_pd(TWO52+1022));
+		__m512d m=_mm512_castsi512_pd(_mm512_or_si512(
+			_mm512_and_si512(bits, _mm512_set1_epi64(MANTISSA_MASK)),
+			_mm512_set1_epi64(HALF_EXPONENT)));
+
+		const __mmask8 small=_mm512_cmp_pd_mask(m, _mm512_set1_pd(LOG_SQRTH), _CMP_LT_OQ);
+		e=_mm512_mask_sub_pd(e, small, e, one);
+		m=_mm512_sub_pd(_mm512_mask_add_pd(m, small, m, m), one);
+
+		const __m512d z=_mm512_mul_pd(m, m);
+		__m512d p=_mm512_set1_pd(LOG_P[0]);
+		for (auto c : {LOG_P[1], LOG_P[2], LOG_P[3], LOG_P[4], LOG_P[5]})
+			p=_mm512_fmadd_pd(p, m, _mm512_set1_pd(c));
+		__m512d q=_mm512_add_pd(m, _mm512_set1_pd(LOG_Q[0]));
+		for (auto c : {LOG_Q[1], LOG_Q[2], LOG_Q[3], LOG_Q[4]})
+			q=_mm512_fmadd_pd(q, m, _mm512_set1_pd(c));
+
+		__m512d y=_mm512_mul_pd(m, _mm512_div_pd(_mm512_mul_pd(z, p), q));
+		y=_mm512_fnmadd_pd(e, _mm512_set1_pd(LOG_C1), y);
+		y=_mm512_fnmadd_pd(_mm512_set1_pd(0.5), z, y);
+		return _mm512_fmadd_pd(e, _mm512_set1_pd(LOG_C2), _mm512_add_pd(m, y));
+	}
+
+	SG_AVX512 void exp_avx512(const float64_t* x, float64_t* y, index_t n)
+	{
+		const __m512d bound=_mm512_set1_pd(EXP_BOUND);
+		index_t i=0;
+		for (; i+8<=n; i+=8)
+		{
+			const __m512d v=_mm512_loadu_pd(x+i);
+			const __mmask8 outside=_mm512_cmp_pd_mask(
+				_mm512_abs_pd(v), bound, _CMP_NLE_UQ);
+			if (!outside)
+			{
+				_mm512_storeu_pd(y+i, exp8(v));
+				continue;
+			}
+
+			alignas(64) float64_t in[8];
+			_mm512_store_pd(in, v);
+			_mm512_storeu_pd(y+i, exp8(v));
+			for (int32_t k=0; k<8; k++)
+			{
+				if (outside & (1<<k))
+					y[i+k]=std::exp(in[k]);
+			}
+		}
+		for (; i<n; i++)
+			y[i]=std::exp(x[i]);
+	}
+
+	SG_AVX512 void log_avx512(const float64_t* x, float64_t* y, index_t n)
+	{
+		const __m512d lower=_mm512_set1_pd(std::numeric_limits<float64_t>::min());
+		const __m512d upper=_mm512_set1_pd(std::numeric_limits<float64_t>::max());
+		index_t i=0;
+		for (; i+8<=n; i+=8)
+		{
+			const __m512d v=_mm512_loadu_pd(x+i);
+			const __mmask8 outside=
+				_mm512_cmp_pd_mask(v, lower, _CMP_NGE_UQ) |
+				_mm512_cmp_pd_mask(v, upper, _CMP_NLE_UQ);
+			if (!outside)
+			{
+				_mm512_storeu_pd(y+i, log8(v));
+				continue;
+			}
+
+			alignas(64) float64_t in[8];
+			_mm512_store_pd(in, v);
+			_mm512_storeu_pd(y+i, log8(v));
+			for (int32_t k=0; k<8; k++)
+			{
+				if (outside & (1<<k))
+					y[i+k]=std::log(in[k]);
+			}
+		}
+		for (; i<n; i++)
+			y[i]=std::log(x[i]);
+	}
+#endif // SG_SIMD_X86
+
+#ifdef SG_SIMD_NEON
+	/* two elements converted to 64 bit floats */
+	inline float64x2_t load2(const float64_t* x)
+	{
+		return vld1q_f64(x);
+	}
+
+	inline float64x2_t load2(const float32_t* x)
+	{
+		return vcvt_f64_f32(vld1_f32(x));
+	}
+
+	template <class T>
+	float64_t dot_neon(const T* x, const float64_t* w, index_t n)
+	{
+		float64x2_t sum0=vdupq_n_f64(0);
+		float64x2_t sum1=vdupq_n_f64(0);
+		index_t i=0;
+		for (; i+4<=n; i+=4)
+		{
+			sum0=vfmaq_f64(sum0, load2(x+i), vld1q_f64(w+i));
+			sum1=vfmaq_f64(sum1, load2(x+i+2), vld1q_f64(w+i+2));
+		}
+
+		float64_t result=vaddvq_f64(vaddq_f64(sum0, sum1));
+		for (; i<n; i++)
+			result+=float64_t(x[i])*w[i];
+		return result;
+	}
+
+	template <class T>
+	void axpy_neon(float64_t alpha, const T* x, float64_t* y, index_t n)
+	{
+		index_t i=0;
+		for (; i+2<=n; i+=2)
+			vst1q_f64(y+i, vfmaq_n_f64(vld1q_f64(y+i), load2(x+i), alpha));
+		for (; i<n; i++)
+			y[i]+=alpha*float64_t(x[i]);
+	}
+#endif // SG_SIMD_NEON
+
+	ISA detect()
+	{
+		if (CpuHasNEON())
+			return ISA::NEON;
+		if (CpuHasAVX512F())
+			return ISA::AVX512F;
+		if (CpuHasAVX2())
+			return ISA::AVX2;
+		if (CpuHasSSE42())
+			return ISA::SSE42;
+		return ISA::GENERIC;
+	}
+
+	bool supported(ISA isa)
+	{
+		const ISA detected=detected_isa();
+		if (isa==ISA::GENERIC || isa==detected)
+			return true;
+		// the x86 instruction sets include their predecessors
+		return detected!=ISA::NEON && isa!=ISA::NEON && isa<detected;
+	}
+
+	/* the instruction set of the kernels, the best one at startup */
+	std::atomic<ISA>& active()
+	{
+		static std::atomic<ISA> isa{detected_isa()};
+		return isa;
+	}
+
+	template <class T>
+	Kernels<T> kernels_for(ISA isa)
+	{
+		switch (isa)
+		{
+#ifdef SG_SIMD_X86
+		case ISA::AVX512F:
+			return {dot_avx512<T>, axpy_avx512<T>};
+		case ISA::AVX2:
+			return {dot_avx2<T>, axpy_avx2<T>};
+		case ISA::SSE42:
+			return {dot_sse42<T>, axpy_sse42<T>};
+#endif
+#ifdef SG_SIMD_NEON
+		case ISA::NEON:
+			if constexpr (
+				std::is_same<T, float64_t>::value ||
+				std::is_same<T, float32_t>::value)
+			{
+				return {dot_neon<T>, axpy_neon<T>};
+			}
+			break;
+#endif
+		default:
+			break;
+		}
+		return {dot_generic<T>, axpy_generic<T>};
+	}
+
+	/* the kernels of every instruction set, built once per type, so
+	 * switching the instruction set is a single atomic store
+	 */
+	template <class T>
+	const Kernels<T>& kernels()
+	{
+		static const Kernels<T> table[]={
+			kernels_for<T>(ISA::GENERIC), kernels_for<T>(ISA::SSE42),
+			kernels_for<T>(ISA::AVX2), kernels_for<T>(ISA::AVX512F),
+			kernels_for<T>(ISA::NEON)};
+		return table[int(active().load(std::memory_order_relaxed))];
+	}
+
+	/* SSE4.2 and NEON have no fused multiply-add or too few lanes to gain
+	 * on the libm versions
+	 */
+	MathKernels math_kernels_for(ISA isa)
+	{
+		switch (isa)
+		{
+#ifdef SG_SIMD_X86
+		case ISA::AVX512F:
+			return {exp_avx512, log_avx512};
+		case ISA::AVX2:
+			return {exp_avx2, log_avx2};
+#endif
+		default:
+			break;
+		}
+		return {exp_generic, log_generic};
+	}
+
+	const MathKernels& math_kernels()
+	{
+		static const MathKernels table[]={
+			math_kernels_for(ISA::GENERIC), math_kernels_for(ISA::SSE42),
+			math_kernels_for(ISA::AVX2), math_kernels_for(ISA::AVX512F),
+			math_kernels_for(ISA::NEON)};
+		return table[int(active().load(std::memory_order_relaxed))];
+	}
+} // namespace
+
+ISA detected_isa()
+{
+	static const ISA detected=detect();
+	return detected;
+}
+
+ISA selected_isa()
+{
+	return active().load();
+}
+
+bool select_isa(ISA isa)
+{
+	if (!supported(isa))
+		return false;
+
+	active().store(isa);
+	return true;
+}
+
+const char* isa_name(ISA isa)
+{
+	switch (isa)
+	{
+	case ISA::SSE42:
+		return "sse4.2";
+	case ISA::AVX2:
+		return "avx2";
+	case ISA::AVX512F:
+		return "avx512f";
+	case ISA::NEON:
+		return "neon";
+	default:
+		return "generic";
+	}
+}
+
+bool parse_isa(const char* name, ISA& isa)
+{
+	for (auto candidate : {ISA::GENERIC, ISA::SSE42, ISA::AVX2, ISA::AVX512F,
+	                       ISA::NEON})
+	{
+		if (std::strcmp(name, isa_name(candidate))==0)
+		{
+			isa=candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+#define SIMD_KERNELS(T)                                                        \
+	template <>                                                                \
+	float64_t dot<T>(const T* x, const float64_t* w, index_t n)                \
+	{                                                                          \
+		return kernels<T>().dot(x, w, n);                                      \
+	}                                                                          \
+	template <>                                                                \
+	void axpy<T>(float64_t alpha, const T* x, float64_t* y, index_t n)         \
+	{                                                                          \
+		kernels<T>().axpy(alpha, x, y, n);                                     \
+	}
+SIMD_KERNELS(float64_t)
+SIMD_KERNELS(float32_t)
+SIMD_KERNELS(int8_t)
+SIMD_KERNELS(uint8_t)
+#undef SIMD_KERNELS
+
+void exp(const float64_t* x, float64_t* y, index_t n)
+{
+	math_kernels().exp(x, y, n);
+}
+
+void log(const float64_t* x, float64_t* y, index_t n)
+{
+	math_kernels().log(x, y, n);
+}
+
+void pow(const float64_t* x, float64_t e, float64_t* y, index_t n)
+{
+	if (e==0)
+	{
+		std::fill_n(y, n, 1.0);
+		return;
+	}
+
+	// exp(e*log(x)) for positive x in chunks, the chunk of x is kept
+	// since y may be the same array
+	constexpr index_t chunk_size=256;
+	float64_t chunk[chunk_size];
+	for (index_t begin=0; begin<n; begin+=chunk_size)
+	{
+		const index_t len=std::min(chunk_size, n-begin);
+		std::memcpy(chunk, x+begin, len*sizeof(float64_t));
+		float64_t* out=y+begin;
+		log(chunk, out, len);
+		for (index_t i=0; i<len; i++)
+			out[i]*=e;
+		exp(out, out, len);
+		for (index_t i=0; i<len; i++)
+		{
+			if (!(chunk[i]>0))
+				out[i]=std::pow(chunk[i], e);
+		}
+	}
+}
+} // namespace simd
+} // namespace shogun
@@ -0,0 +1,133 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __SG_SIMD_H__
+#define __SG_SIMD_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+/** Vectorized kernels of the inner loops of DotFeatures and of the float64
+ * dot products of linalg, and bulk versions of exp and log.
+ *
+ * The vectors x are converted to 64 bit floats on the fly, so mixed dots such
+ * as of 8 bit features and float64 weights do not materialize a converted
+ * copy. float64, float32, int8 and uint8 have explicitly vectorized versions
+ * for several instruction sets, all other types use the plain loops below.
+ *
+ * Every version is compiled into the library regardless of the target of the
+ * build. The best instruction set the processor supports is selected once at
+ * startup and can be lowered with select_isa or with the environment variable
+ * SHOGUN_SIMD_ISA (see ShogunEnv), e.g. to compare results across a fleet.
+ */
+namespace simd
+{
+	/** instruction sets the kernels are compiled for */
+	enum class ISA
+	{
+		/** plain loops, vectorized by the compiler for the build target */
+		GENERIC = 0,
+		/** x86 SSE4.2, two float64 per instruction */
+		SSE42 = 1,
+		/** x86 AVX2 with FMA, four float64 per instruction */
+		AVX2 = 2,
+		/** x86 AVX-512F, eight float64 per instruction */
+		AVX512F = 3,
+		/** aarch64 Advanced SIMD, two float64 per instruction */
+		NEON = 4
+	};
+
+	/** @return the best instruction set of the processor which the kernels
+	 * are compiled for
+	 */
+	ISA detected_isa();
+
+	/** @return the instruction set the kernels use */
+	ISA selected_isa();
+
+	/** Selects the instruction set the kernels use. Instruction sets the
+	 * processor does not support are refused.
+	 *
+	 * @param isa instruction set to use
+	 * @return whether the instruction set is selected
+	 */
+	bool select_isa(ISA isa);
+
+	/** @return name of the instruction set, e.g. "avx2" */
+	const char* isa_name(ISA isa);
+
+	/** @param name name of an instruction set as returned by isa_name
+	 * @param isa the instruction set, unchanged if the name is unknown
+	 * @return whether the name is known
+	 */
+	bool parse_isa(const char* name, ISA& isa);
+
+	/** @return \f$\sum_i x_i w_i\f$ */
+	template <class T>
+	float64_t dot(const T* x, const float64_t* w, index_t n)
+	{
+		float64_t result=0;
+		for (index_t i=0; i<n; i++)
+			result+=float64_t(x[i])*w[i];
+		return result;
+	}
+
+	/** \f$y \leftarrow \alpha x + y\f$ */
+	template <class T>
+	void axpy(float64_t alpha, const T* x, float64_t* y, index_t n)
+	{
+		for (index_t i=0; i<n; i++)
+			y[i]+=alpha*float64_t(x[i]);
+	}
+
+	template <>
+	float64_t dot<float64_t>(const float64_t* x, const float64_t* w, index_t n);
+	template <>
+	float64_t dot<float32_t>(const float32_t* x, const float64_t* w, index_t n);
+	template <>
+	float64_t dot<int8_t>(const int8_t* x, const float64_t* w, index_t n);
+	template <>
+	float64_t dot<uint8_t>(const uint8_t* x, const float64_t* w, index_t n);
+
+	template <>
+	void axpy<float64_t>(float64_t alpha, const float64_t* x, float64_t* y, index_t n);
+	template <>
+	void axpy<float32_t>(float64_t alpha, const float32_t* x, float64_t* y, index_t n);
+	template <>
+	void axpy<int8_t>(float64_t alpha, const int8_t* x, float64_t* y, index_t n);
+	template <>
+	void axpy<uint8_t>(float64_t alpha, const uint8_t* x, float64_t* y, index_t n);
+
+	/** \f$y_i \leftarrow \exp(x_i)\f$, x and y may be the same array.
+	 *
+	 * The AVX2 and AVX-512 versions use the rational approximation of
+	 * Cephes, which is within two ulp of std::exp. Arguments beyond
+	 * \f$\pm 708\f$ and NaN are passed to std::exp.
+	 */
+	void exp(const float64_t* x, float64_t* y, index_t n);
+
+	/** \f$y_i \leftarrow \log(x_i)\f$, x and y may be the same array.
+	 *
+	 * The AVX2 and AVX-512 versions use the rational approximation of
+	 * Cephes, which is within two ulp of std::log. Zero, negative,
+	 * subnormal and non-finite arguments are passed to std::log.
+	 */
+	void log(const float64_t* x, float64_t* y, index_t n);
+
+	/** \f$y_i \leftarrow x_i^e\f$, x and y may be the same array.
+	 *
+	 * Computed as \f$\exp(e\log(x_i))\f$ with the versions above for
+	 * positive x, which loses about \f$|e\log(x_i)|\f$ ulp, all other
+	 * arguments are passed to std::pow.
+	 */
+	void pow(const float64_t* x, float64_t e, float64_t* y, index_t n);
+} // namespace simd
+} // namespace shogun
+
+#endif /* __SG_SIMD_H__ */
@@ -12,6 +12,8 @@
 #include <shogun/lib/tapkee/stichwort/keywords.hpp>
 /* End of Tapkee includes */
 
+#include <vector>
+
 namespace tapkee
 {
 	namespace {
@@ -140,6 +142,20 @@ namespace tapkee
 		const stichwort::ParameterKeyword<IndexType>
 			diffusion_map_timesteps("diffusion map timesteps", 3);
 
+		/** The keyword for the value that indicates whether the
+		 * diffusion map kernel is restricted to the neighborhood
+		 * graph, which gives a sparse eigenproblem instead of a
+		 * dense one.
+		 *
+		 * Used by @ref tapkee::DiffusionMap.
+		 *
+		 * Default value is false.
+		 *
+		 * The corresponding value should be of type bool.
+		 */
+		const stichwort::ParameterKeyword<bool>
+			diffusion_map_sparse("diffusion map sparse", false);
+
 		/** The keyword for the value that stores the width of
 		 * the gaussian kernel.
 		 *
@@ -353,6 +369,19 @@ namespace tapkee
 		 */
 		const stichwort::ParameterKeyword<ScalarType> sne_theta("SNE theta", 0.5);
 
+		/** The keyword for the value that indicates whether the
+		 * repulsive forces of the t-SNE algorithm are interpolated
+		 * on a grid and computed with the FFT instead of the
+		 * Barnes-Hut tree. Only used for two-dimensional embeddings.
+		 *
+		 * Used by @ref tapkee::tDistributedStochasticNeighborEmbedding.
+		 *
+		 * Default value is false.
+		 *
+		 * The corresponding value should be of type bool.
+		 */
+		const stichwort::ParameterKeyword<bool> sne_interpolation("SNE interpolation", false);
+
 		/** The keyword for the value that stores the squishingRate
 		 * parameter of the Manifold Sculpting algorithm.
 		 *
@@ -363,6 +392,22 @@ namespace tapkee
 		 * The corresponding value should have type @ref tapkee::ScalarType.
 		 */
 		const stichwort::ParameterKeyword<ScalarType> squishing_rate("squishing rate", 0.99);
+
+		/** The keyword for the value that stores a pointer
+		 * to precomputed neighbors, one list of at least
+		 * @ref tapkee::keywords::num_neighbors indices per vector,
+		 * closest first. If it is set the neighbors are not searched.
+		 *
+		 * Used by all the methods that use
+		 * @ref tapkee::keywords::num_neighbors.
+		 *
+		 * Default is NULL.
+		 *
+		 * The corresponding value should have type
+		 * @code const std::vector<std::vector<IndexType> >* @endcode
+		 */
+		const stichwort::ParameterKeyword<const std::vector<std::vector<IndexType> >*>
+			precomputed_neighbors("precomputed neighbors", NULL);
 	}
 }
 
@@ -34,6 +34,7 @@
 #include <stdio.h>
 #include <algorithm>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 
 #ifndef QUADTREE_H
@@ -72,9 +73,6 @@ class QuadTree
 	static const int QT_NO_DIMS = 2;
 	static const int QT_NODE_CAPACITY = 1;
 
-	// A buffer we use when doing force computations
-	ScalarType buff[QT_NO_DIMS];
-
 	// Properties of this node in the tree
 	QuadTree* parent;
 	bool is_leaf;
@@ -314,14 +312,16 @@ public:
 		                             southEast->getDepth()));
 	}
 
-	// Compute non-edge forces using Barnes-Hut algorithm
-	void computeNonEdgeForces(int point_index, ScalarType theta, ScalarType neg_f[], ScalarType* sum_Q)
+	// Compute non-edge forces using Barnes-Hut algorithm, may be called
+	// concurrently for different points
+	void computeNonEdgeForces(int point_index, ScalarType theta, ScalarType neg_f[], ScalarType* sum_Q) const
 	{
 
 		// Make sure that we spend no time on empty nodes or self-interactions
 		if(cum_size == 0 || (is_leaf && size == 1 && index[0] == point_index)) return;
 
 		// Compute distance between point and center-of-mass
+		ScalarType buff[QT_NO_DIMS];
 		ScalarType D = .0;
 		int ind = point_index * QT_NO_DIMS;
 		for(int d = 0; d < QT_NO_DIMS; d++) buff[d]  = data[ind + d];
@@ -347,21 +347,21 @@ public:
 		}
 	}
 
-	// Computes edge forces
-	void computeEdgeForces(int* row_P, int* col_P, ScalarType* val_P, int N, ScalarType* pos_f)
+	// Computes edge forces of the points Y, these do not need the tree
+	static void computeEdgeForces(const ScalarType* Y, int* row_P, int* col_P, ScalarType* val_P, int N, ScalarType* pos_f)
 	{
-		// Loop over all edges in the graph
-		int ind1, ind2;
-		ScalarType D;
+		// Loop over all edges in the graph, every point only writes its own forces
+#pragma omp parallel for num_threads(shogun::env()->get_num_threads())
 		for(int n = 0; n < N; n++) {
-			ind1 = n * QT_NO_DIMS;
+			ScalarType buff[QT_NO_DIMS];
+			int ind1 = n * QT_NO_DIMS;
 			for(int i = row_P[n]; i < row_P[n + 1]; i++) {
 
 				// Compute pairwise distance and Q-value
-				D = .0;
-				ind2 = col_P[i] * QT_NO_DIMS;
-				for(int d = 0; d < QT_NO_DIMS; d++) buff[d]  = data[ind1 + d];
-				for(int d = 0; d < QT_NO_DIMS; d++) buff[d] -= data[ind2 + d];
+				ScalarType D = .0;
+				int ind2 = col_P[i] * QT_NO_DIMS;
+				for(int d = 0; d < QT_NO_DIMS; d++) buff[d]  = Y[ind1 + d];
+				for(int d = 0; d < QT_NO_DIMS; d++) buff[d] -= Y[ind2 + d];
 				for(int d = 0; d < QT_NO_DIMS; d++) D += buff[d] * buff[d];
 				D = val_P[i] / (1.0 + D);
 
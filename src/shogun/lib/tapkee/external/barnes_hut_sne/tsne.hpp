@@ -44,7 +44,12 @@
 #include <stdio.h>
 #include <cstring>
 #include <time.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 
 //! Namespace containing implementation of t-SNE algorithm
@@ -58,12 +63,16 @@ static inline ScalarType sign(ScalarType x) { return (x == .0 ? .0 : (x < .0 ? -
 class TSNE
 {
 public:
-	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta)
+	void run(tapkee::DenseMatrix& X, int N, int D, ScalarType* Y, int no_dims, ScalarType perplexity, ScalarType theta, bool interpolation = false)
 	{
-		// Determine whether we are using an exact algorithm
-		bool exact = (theta == .0) ? true : false;
+		// Determine whether we are using an exact algorithm, the interpolation
+		// scheme is only available for two-dimensional embeddings
+		bool interpolate = interpolation && no_dims == 2;
+		bool exact = (theta == .0) && !interpolate;
 		if (exact)
 			tapkee::LoggingSingleton::instance().message_info("Using exact t-SNE algorithm");
+		else if (interpolate)
+			tapkee::LoggingSingleton::instance().message_info("Using interpolation-based t-SNE algorithm");
 		else
 			tapkee::LoggingSingleton::instance().message_info("Using Barnes-Hut-SNE algorithm");
 
@@ -134,7 +143,7 @@ public:
 
 				// Compute (approximate) gradient
 				if(exact) computeExactGradient(P.data(), Y, N, no_dims, dY.data());
-				else computeGradient(P.data(), row_P, col_P, val_P, Y, N, no_dims, dY.data(), theta);
+				else computeGradient(P.data(), row_P, col_P, val_P, Y, N, no_dims, dY.data(), theta, interpolate);
 
 				// Update gains
 				for(int i = 0; i < N * no_dims; i++) gains.data()[i] = (sign(dY.data()[i]) != sign(uY.data()[i])) ? (gains.data()[i] + .2) : (gains.data()[i] * .8);
@@ -162,7 +171,7 @@ public:
 				if((iter > 0) && ((iter % 50 == 0) || (iter == max_iter - 1))) {
 					ScalarType C = .0;
 					if(exact) C = evaluateError(P.data(), Y, N);
-					else      C = evaluateError(row_P, col_P, val_P, Y, N, theta);  // doing approximate computation here!
+					else      C = evaluateError(row_P, col_P, val_P, Y, N, theta, interpolate);  // doing approximate computation here!
 					tapkee::LoggingSingleton::instance().message_info(
 							formatting::format("Iteration {}: error is {}\n", iter, C));
 				}
@@ -265,18 +274,16 @@ public:
 
 private:
 
-	void computeGradient(ScalarType* /*P*/, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC, ScalarType theta)
+	void computeGradient(ScalarType* /*P*/, int* inp_row_P, int* inp_col_P, ScalarType* inp_val_P, ScalarType* Y, int N, int D, ScalarType* dC, ScalarType theta, bool interpolate)
 	{
-		// Construct quadtree on current map
-		QuadTree* tree = new QuadTree(Y, N);
-
 		// Compute all terms required for t-SNE gradient
 		ScalarType sum_Q = .0;
 		ScalarType* pos_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
 		ScalarType* neg_f = (ScalarType*) calloc(N * D, sizeof(ScalarType));
 		if(pos_f == NULL || neg_f == NULL) { printf("Memory allocation failed!\n"); exit(1); }
-		tree->computeEdgeForces(inp_row_P, inp_col_P, inp_val_P, N, pos_f);
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, neg_f + n * D, &sum_Q);
+		QuadTree::computeEdgeForces(Y, inp_row_P, inp_col_P, inp_val_P, N, pos_f);
+		if(interpolate) computeInterpolatedNonEdgeForces(Y, N, neg_f, &sum_Q);
+		else computeNonEdgeForces(Y, N, D, theta, neg_f, &sum_Q);
 
 		// Compute final t-SNE gradient
 		for(int i = 0; i < N * D; i++) {
@@ -284,9 +291,182 @@ private:
 		}
 		free(pos_f);
 		free(neg_f);
+	}
+
+	void computeNonEdgeForces(ScalarType* Y, int N, int D, ScalarType theta, ScalarType* neg_f, ScalarType* sum_Q)
+	{
+		// Construct quadtree on current map
+		QuadTree* tree = new QuadTree(Y, N);
+
+		// The tree is only read, points are traversed in parallel
+		ScalarType Q = .0;
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:Q) num_threads(shogun::env()->get_num_threads())
+		for(int n = 0; n < N; n++) {
+			ScalarType point_Q = .0;
+			tree->computeNonEdgeForces(n, theta, neg_f + n * D, &point_Q);
+			Q += point_Q;
+		}
+		*sum_Q += Q;
 		delete tree;
 	}
 
+	// Computes the repulsive forces and the normalization term by interpolating
+	// the kernel on an equispaced grid (Linderman et al., FIt-SNE). Values of
+	// the squared Cauchy kernel are convolved with the charges 1, y and |y|^2
+	// using the FFT, which gives both quantities as
+	//   neg_f_i = y_i sum_j K_ij^2 - sum_j K_ij^2 y_j
+	//   sum_Q   = sum_i sum_j K_ij^2 (1 + |y_i - y_j|^2) - N
+	void computeInterpolatedNonEdgeForces(ScalarType* Y, int N, ScalarType* neg_f, ScalarType* sum_Q)
+	{
+		const int no_dims = 2;
+		const int n_interp = 3;
+		const int n_terms = 4;
+
+		// Square domain covering the map, split into boxes of about unit width
+		ScalarType min_y = Y[0], max_y = Y[0];
+		for(int i = 1; i < N * no_dims; i++) {
+			min_y = std::min(min_y, Y[i]);
+			max_y = std::max(max_y, Y[i]);
+		}
+		ScalarType width = std::max(max_y - min_y, ScalarType(1e-6));
+		int n_boxes = std::min(std::max((int) std::ceil(width), 50), 100);
+		ScalarType box_width = width / n_boxes;
+		ScalarType h = box_width / n_interp;
+		int n_grid = n_boxes * n_interp;
+
+		// Boxes and Lagrange weights of the interpolation nodes of every point
+		std::vector<int> box(N * no_dims);
+		std::vector<ScalarType> weights(N * no_dims * n_interp);
+#pragma omp parallel for num_threads(shogun::env()->get_num_threads())
+		for(int i = 0; i < N * no_dims; i++) {
+			int b = std::min((int) ((Y[i] - min_y) / box_width), n_boxes - 1);
+			// position relative to the nodes of the box, which are at 0, 1, 2
+			ScalarType t = (Y[i] - min_y - b * box_width) / h - .5;
+			box[i] = b;
+			weights[i * n_interp + 0] = (t - 1) * (t - 2) / 2;
+			weights[i * n_interp + 1] = -t * (t - 2);
+			weights[i * n_interp + 2] = t * (t - 1) / 2;
+		}
+
+		// Spread the charges of the points to the grid nodes
+		std::vector<ScalarType> charges(n_terms * n_grid * n_grid, .0);
+#pragma omp parallel num_threads(shogun::env()->get_num_threads())
+		{
+			std::vector<ScalarType> local(n_terms * n_grid * n_grid, .0);
+#pragma omp for
+			for(int n = 0; n < N; n++) {
+				ScalarType q[n_terms] = {1.0, Y[n * no_dims], Y[n * no_dims + 1],
+				                         Y[n * no_dims] * Y[n * no_dims] + Y[n * no_dims + 1] * Y[n * no_dims + 1]};
+				for(int a = 0; a < n_interp; a++) {
+					int gx = box[n * no_dims] * n_interp + a;
+					for(int b = 0; b < n_interp; b++) {
+						int gy = box[n * no_dims + 1] * n_interp + b;
+						ScalarType w = weights[n * no_dims * n_interp + a] * weights[(n * no_dims + 1) * n_interp + b];
+						for(int c = 0; c < n_terms; c++)
+							local[(c * n_grid + gx) * n_grid + gy] += w * q[c];
+					}
+				}
+			}
+#pragma omp critical
+			for(size_t i = 0; i < charges.size(); i++) charges[i] += local[i];
+		}
+
+		// Convolve the charges with the kernel, the Toeplitz structure of the
+		// kernel on the grid is embedded in a circulant of twice the size
+		int n_fft = 1;
+		while(n_fft < 2 * n_grid) n_fft *= 2;
+		std::vector<std::complex<ScalarType>> kernel(n_fft * n_fft, .0);
+		for(int i = 0; i < n_fft; i++) {
+			int di = (i < n_grid) ? i : ((i > n_fft - n_grid) ? i - n_fft : n_grid);
+			if(di == n_grid) continue;
+			for(int j = 0; j < n_fft; j++) {
+				int dj = (j < n_grid) ? j : ((j > n_fft - n_grid) ? j - n_fft : n_grid);
+				if(dj == n_grid) continue;
+				ScalarType k = 1.0 / (1.0 + h * h * (di * di + dj * dj));
+				kernel[i * n_fft + j] = k * k;
+			}
+		}
+		fft2(kernel.data(), n_fft, false);
+
+		std::vector<ScalarType> potentials(n_terms * n_grid * n_grid);
+		std::vector<std::complex<ScalarType>> signal(n_fft * n_fft);
+		for(int c = 0; c < n_terms; c++) {
+			std::fill(signal.begin(), signal.end(), std::complex<ScalarType>(.0));
+			for(int i = 0; i < n_grid; i++)
+				for(int j = 0; j < n_grid; j++)
+					signal[i * n_fft + j] = charges[(c * n_grid + i) * n_grid + j];
+			fft2(signal.data(), n_fft, false);
+			for(size_t i = 0; i < signal.size(); i++) signal[i] *= kernel[i];
+			fft2(signal.data(), n_fft, true);
+			for(int i = 0; i < n_grid; i++)
+				for(int j = 0; j < n_grid; j++)
+					potentials[(c * n_grid + i) * n_grid + j] = signal[i * n_fft + j].real() / (n_fft * n_fft);
+		}
+
+		// Interpolate the potentials back to the points
+		ScalarType Q = .0;
+#pragma omp parallel for reduction(+:Q) num_threads(shogun::env()->get_num_threads())
+		for(int n = 0; n < N; n++) {
+			ScalarType phi[n_terms] = {.0, .0, .0, .0};
+			for(int a = 0; a < n_interp; a++) {
+				int gx = box[n * no_dims] * n_interp + a;
+				for(int b = 0; b < n_interp; b++) {
+					int gy = box[n * no_dims + 1] * n_interp + b;
+					ScalarType w = weights[n * no_dims * n_interp + a] * weights[(n * no_dims + 1) * n_interp + b];
+					for(int c = 0; c < n_terms; c++)
+						phi[c] += w * potentials[(c * n_grid + gx) * n_grid + gy];
+				}
+			}
+			ScalarType y1 = Y[n * no_dims], y2 = Y[n * no_dims + 1];
+			neg_f[n * no_dims]     = y1 * phi[0] - phi[1];
+			neg_f[n * no_dims + 1] = y2 * phi[0] - phi[2];
+			Q += (1.0 + y1 * y1 + y2 * y2) * phi[0] - 2.0 * (y1 * phi[1] + y2 * phi[2]) + phi[3];
+		}
+		*sum_Q += Q - N;
+	}
+
+	// In-place radix-2 FFT of n (a power of two) values, not normalized
+	static void fft(std::complex<ScalarType>* a, int n, bool inverse)
+	{
+		for(int i = 1, j = 0; i < n; i++) {
+			int bit = n >> 1;
+			for(; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if(i < j) std::swap(a[i], a[j]);
+		}
+		for(int len = 2; len <= n; len <<= 1) {
+			ScalarType angle = 2 * M_PI / len * (inverse ? 1 : -1);
+			std::complex<ScalarType> wlen(std::cos(angle), std::sin(angle));
+			for(int i = 0; i < n; i += len) {
+				std::complex<ScalarType> w(1.0);
+				for(int j = 0; j < len / 2; j++) {
+					std::complex<ScalarType> u = a[i + j], v = a[i + j + len / 2] * w;
+					a[i + j] = u + v;
+					a[i + j + len / 2] = u - v;
+					w *= wlen;
+				}
+			}
+		}
+	}
+
+	// In-place two-dimensional FFT of a row-major n x n array
+	static void fft2(std::complex<ScalarType>* a, int n, bool inverse)
+	{
+#pragma omp parallel num_threads(shogun::env()->get_num_threads())
+		{
+#pragma omp for
+			for(int i = 0; i < n; i++) fft(a + i * n, n, inverse);
+
+			std::vector<std::complex<ScalarType>> column(n);
+#pragma omp for
+			for(int j = 0; j < n; j++) {
+				for(int i = 0; i < n; i++) column[i] = a[i * n + j];
+				fft(column.data(), n, inverse);
+				for(int i = 0; i < n; i++) a[i * n + j] = column[i];
+			}
+		}
+	}
+
 	void computeExactGradient(ScalarType* P, ScalarType* Y, int N, int D, ScalarType* dC)
 	{
 		// Make sure the current gradient contains zeros
@@ -362,14 +542,17 @@ private:
 		return C;
 	}
 
-	ScalarType evaluateError(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType theta)
+	ScalarType evaluateError(int* row_P, int* col_P, ScalarType* val_P, ScalarType* Y, int N, ScalarType theta, bool interpolate)
 	{
 		// Get estimate of normalization term
 		const int QT_NO_DIMS = 2;
-		QuadTree* tree = new QuadTree(Y, N);
 		ScalarType buff[QT_NO_DIMS] = {.0, .0};
 		ScalarType sum_Q = .0;
-		for(int n = 0; n < N; n++) tree->computeNonEdgeForces(n, theta, buff, &sum_Q);
+		ScalarType* neg_f = (ScalarType*) calloc(N * QT_NO_DIMS, sizeof(ScalarType));
+		if(neg_f == NULL) { printf("Memory allocation failed!\n"); exit(1); }
+		if(interpolate) computeInterpolatedNonEdgeForces(Y, N, neg_f, &sum_Q);
+		else computeNonEdgeForces(Y, N, QT_NO_DIMS, theta, neg_f, &sum_Q);
+		free(neg_f);
 
 		// Loop over all edges to compute t-SNE error
 		int ind1, ind2;
@@ -491,8 +674,6 @@ private:
 		int* row_P = *_row_P;
 		int* col_P = *_col_P;
 		ScalarType* val_P = *_val_P;
-		ScalarType* cur_P = (ScalarType*) malloc((N - 1) * sizeof(ScalarType));
-		if(cur_P == NULL) { printf("Memory allocation failed!\n"); exit(1); }
 		row_P[0] = 0;
 		for(int n = 0; n < N; n++) row_P[n + 1] = row_P[n] + K;
 
@@ -502,18 +683,24 @@ private:
 		for(int n = 0; n < N; n++) obj_X[n] = DataPoint(D, n, X + n * D);
 		tree->create(obj_X);
 
-		// Loop over all points to find nearest neighbors
+		// Loop over all points to find nearest neighbors, searches of the
+		// tree are independent and every point fills its own row of P
 		//printf("Building tree...\n");
+#pragma omp parallel num_threads(shogun::env()->get_num_threads())
+		{
 		std::vector<DataPoint> indices;
 		std::vector<ScalarType> distances;
+		std::vector<ScalarType> cur_P(K);
+#pragma omp for schedule(dynamic, 64)
 		for(int n = 0; n < N; n++) {
 
 			//if(n % 10000 == 0) printf(" - point %d of %d\n", n, N);
 
-			// Find nearest neighbors
+			// Find nearest neighbors, the kernel uses squared distances
 			indices.clear();
 			distances.clear();
 			tree->search(obj_X[n], K + 1, &indices, &distances);
+			for(size_t m = 0; m < distances.size(); m++) distances[m] *= distances[m];
 
 			// Initialize some variables for binary search
 			bool found = false;
@@ -569,10 +756,10 @@ private:
 				val_P[row_P[n] + m] = cur_P[m];
 			}
 		}
+		}
 
 		// Clean up memory
 		obj_X.clear();
-		free(cur_P);
 		delete tree;
 	}
 
@@ -755,7 +942,7 @@ private:
 		}
 		Eigen::Map<tapkee::DenseMatrix> DD_map(DD,N,N);
 		Eigen::Map<tapkee::DenseMatrix> X_map(X,D,N);
-		DD_map.noalias() = -2.0*X_map.transpose()*X_map;
+		DD_map.noalias() += -2.0*X_map.transpose()*X_map;
 
 		//cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, N, N, D, -2.0, X, D, X, D, 1.0, DD, N);
 		free(dataSums); dataSums = NULL;
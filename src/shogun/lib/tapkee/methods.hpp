@@ -108,10 +108,10 @@ public:
 		kernel_distance(KernelDistance<RandomAccessIterator,KernelCallback>(kernel)),
 		begin(b), end(e), p_computation_strategy(),
 		p_eigen_method(), p_neighbors_method(), p_eigenshift(), p_traceshift(),
-		p_check_connectivity(), p_n_neighbors(), p_width(), p_timesteps(),
+		p_check_connectivity(), p_n_neighbors(), p_width(), p_timesteps(), p_sparse_diffusion(),
 		p_ratio(), p_max_iteration(), p_tolerance(), p_n_updates(), p_perplexity(),
-		p_theta(), p_squishing_rate(), p_global_strategy(), p_epsilon(), p_target_dimension(),
-		n_vectors(0), current_dimension(0)
+		p_theta(), p_interpolation(), p_squishing_rate(), p_global_strategy(), p_epsilon(), p_target_dimension(),
+		p_precomputed_neighbors(), n_vectors(0), current_dimension(0)
 	{
 		n_vectors = (end-begin);
 
@@ -133,12 +133,15 @@ public:
 		p_check_connectivity = parameters[check_connectivity];
 		p_width = parameters[gaussian_kernel_width].checked().satisfies(Positivity<ScalarType>());
 		p_timesteps = parameters[diffusion_map_timesteps].checked().satisfies(Positivity<IndexType>());
+		p_sparse_diffusion = parameters[diffusion_map_sparse];
 		p_eigenshift = parameters[nullspace_shift];
 		p_traceshift = parameters[klle_shift];
 		p_max_iteration = parameters[max_iteration];
 		p_tolerance = parameters[spe_tolerance].checked().satisfies(Positivity<ScalarType>());
 		p_n_updates = parameters[spe_num_updates].checked().satisfies(Positivity<IndexType>());
 		p_theta = parameters[sne_theta].checked().satisfies(NonNegativity<ScalarType>());
+		p_interpolation = parameters[sne_interpolation];
+		p_precomputed_neighbors = parameters[precomputed_neighbors];
 		p_squishing_rate = parameters[squishing_rate];
 		p_global_strategy = parameters[spe_global_strategy];
 		p_epsilon = parameters[fa_epsilon].checked().satisfies(NonNegativity<ScalarType>());
@@ -221,16 +224,19 @@ private:
 	Parameter p_n_neighbors;
 	Parameter p_width;
 	Parameter p_timesteps;
+	Parameter p_sparse_diffusion;
 	Parameter p_ratio;
 	Parameter p_max_iteration;
 	Parameter p_tolerance;
 	Parameter p_n_updates;
 	Parameter p_perplexity;
 	Parameter p_theta;
+	Parameter p_interpolation;
 	Parameter p_squishing_rate;
 	Parameter p_global_strategy;
 	Parameter p_epsilon;
 	Parameter p_target_dimension;
+	Parameter p_precomputed_neighbors;
 
 	IndexType n_vectors;
 	IndexType current_dimension;
@@ -238,9 +244,28 @@ private:
 	template<class Distance>
 	Neighbors findNeighborsWith(Distance d)
 	{
+		const Neighbors* precomputed = p_precomputed_neighbors;
+		if (precomputed)
+			return precomputedNeighbors(*precomputed);
 		return find_neighbors(p_neighbors_method,begin,end,d,p_n_neighbors,p_check_connectivity);
 	}
 
+	Neighbors precomputedNeighbors(const Neighbors& precomputed)
+	{
+		IndexType k = p_n_neighbors;
+		if (precomputed.size() != static_cast<size_t>(n_vectors))
+			throw wrong_parameter_error("Number of precomputed neighbor lists does not match number of vectors");
+
+		Neighbors neighbors(n_vectors);
+		for (IndexType i=0; i<n_vectors; i++)
+		{
+			if (precomputed[i].size() < static_cast<size_t>(k))
+				throw wrong_parameter_error("Less precomputed neighbors than number of neighbors");
+			neighbors[i].assign(precomputed[i].begin(),precomputed[i].begin()+k);
+		}
+		return neighbors;
+	}
+
 	static tapkee::ProjectingFunction unimplementedProjectingFunction()
 	{
 		return tapkee::ProjectingFunction();
@@ -279,6 +304,24 @@ private:
 	TapkeeOutput embedDiffusionMap()
 	{
 		IndexType target_dimension = static_cast<IndexType>(p_target_dimension);
+		if (p_sparse_diffusion)
+		{
+			Neighbors neighbors = findNeighborsWith(plain_distance);
+			Laplacian diffusion = compute_sparse_diffusion_matrix(begin,end,neighbors,distance,p_width);
+			// the trivial constant eigenvector is skipped
+			EigendecompositionResult decomposition_result = generalized_eigendecomposition(p_eigen_method,
+					p_computation_strategy,SmallestEigenvalues,diffusion.first,diffusion.second,target_dimension);
+			// eigenvectors are D-normalized, the scaling and the order of
+			// increasing diffusion eigenvalues match the dense variant
+			const ScalarType scale = sqrt(diffusion.second.diagonal().sum());
+			DenseMatrix embedding(n_vectors,target_dimension);
+			for (IndexType i=0; i<target_dimension; i++)
+			{
+				embedding.col(target_dimension-1-i) = decomposition_result.first.col(i)*scale*
+					pow(1.0 - decomposition_result.second(i), static_cast<IndexType>(p_timesteps));
+			}
+			return TapkeeOutput(embedding, unimplementedProjectingFunction());
+		}
 		Parameter target_dimension_add = Parameter::create("target_dimension", target_dimension + 1);
 		DenseSymmetricMatrix diffusion_matrix =
 			compute_diffusion_matrix(begin,end,distance,p_width);
@@ -355,37 +398,30 @@ private:
 		Neighbors neighbors = findNeighborsWith(plain_distance);
 		Landmarks landmarks =
 			select_landmarks_random(begin,end,p_ratio);
+		// geodesic distances from the landmarks only, landmarks x vectors
 		DenseMatrix distance_matrix =
 			compute_shortest_distances_matrix(begin,end,landmarks,neighbors,distance);
 		distance_matrix = distance_matrix.array().square();
 
-		DenseVector col_means = distance_matrix.colwise().mean();
-		DenseVector row_means = distance_matrix.rowwise().mean();
-		ScalarType grand_mean = distance_matrix.mean();
-		distance_matrix.array() += grand_mean;
-		distance_matrix.colwise() -= row_means;
-		distance_matrix.rowwise() -= col_means.transpose();
-		distance_matrix.array() *= -0.5;
-
-		EigendecompositionResult landmarks_embedding;
-
-		if (p_eigen_method.is(Dense))
-		{
-			DenseMatrix distance_matrix_sym = distance_matrix*distance_matrix.transpose();
-			landmarks_embedding = eigendecomposition(p_eigen_method,p_computation_strategy,
-					LargestEigenvalues,distance_matrix_sym,p_target_dimension);
-		}
-		else
-		{
-			landmarks_embedding = eigendecomposition(p_eigen_method,p_computation_strategy,
-					SquaredLargestEigenvalues,distance_matrix,p_target_dimension);
-		}
-
-		DenseMatrix embedding = distance_matrix.transpose()*landmarks_embedding.first;
-
+		// classical scaling of the landmarks, the neighborhood graph is
+		// directed so their distances are symmetrized
+		const IndexType n_landmarks = landmarks.size();
+		DenseSymmetricMatrix landmark_distances(n_landmarks,n_landmarks);
+		for (IndexType i=0; i<n_landmarks; i++)
+			landmark_distances.col(i) = distance_matrix.col(landmarks[i]);
+		landmark_distances = 0.5*(landmark_distances + landmark_distances.transpose()).eval();
+		DenseVector landmark_distances_squared = landmark_distances.colwise().mean();
+		centerMatrix(landmark_distances);
+		landmark_distances.array() *= -0.5;
+		EigendecompositionResult landmarks_embedding =
+			eigendecomposition(p_eigen_method,p_computation_strategy,LargestEigenvalues,
+					landmark_distances,p_target_dimension);
 		for (IndexType i=0; i<static_cast<IndexType>(p_target_dimension); i++)
-			embedding.col(i).array() /= sqrt(sqrt(landmarks_embedding.second(i)));
-		return TapkeeOutput(embedding,unimplementedProjectingFunction());
+			landmarks_embedding.first.col(i).array() *= sqrt(landmarks_embedding.second(i));
+
+		// Nystrom extension to the other vectors
+		return TapkeeOutput(triangulate(distance_matrix,landmarks,landmark_distances_squared,
+			landmarks_embedding,p_target_dimension),unimplementedProjectingFunction());
 	}
 
 	TapkeeOutput embedNeighborhoodPreservingEmbedding()
@@ -530,7 +566,7 @@ private:
 
 		DenseMatrix embedding(static_cast<IndexType>(p_target_dimension),n_vectors);
 		tsne::TSNE tsne;
-		tsne.run(data,data.cols(),data.rows(),embedding.data(),p_target_dimension,p_perplexity,p_theta);
+		tsne.run(data,data.cols(),data.rows(),embedding.data(),p_target_dimension,p_perplexity,p_theta,p_interpolation);
 
 		return TapkeeOutput(embedding.transpose(), unimplementedProjectingFunction());
 	}
@@ -33,7 +33,10 @@ const stichwort::ParametersSet defaults = (
 	tapkee::cancel_function = stichwort::by_default,
 	tapkee::sne_perplexity = stichwort::by_default,
 	tapkee::squishing_rate = stichwort::by_default,
-	tapkee::sne_theta = stichwort::by_default);
+	tapkee::sne_theta = stichwort::by_default,
+	tapkee::diffusion_map_sparse = stichwort::by_default,
+	tapkee::sne_interpolation = stichwort::by_default,
+	tapkee::precomputed_neighbors = stichwort::by_default);
 }
 
 }
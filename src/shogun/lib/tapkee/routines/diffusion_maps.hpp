@@ -85,6 +85,61 @@ DenseSymmetricMatrix compute_diffusion_matrix(RandomAccessIterator begin, Random
 	return diffusion_matrix;
 }
 
+//! Computes the diffusion process on the neighborhood graph only. The gaussian
+//! kernel \f$ K \f$ of the neighbors is normalized with
+//! \f$ K_{i,j} = K_{i,j} / (p_i p_j) \f$ as in @ref compute_diffusion_matrix,
+//! and the returned pair is \f$ (D - K, D) \f$ with \f$ D \f$ the row sums of
+//! \f$ K \f$. The right eigenvectors of the diffusion operator \f$ D^{-1} K \f$
+//! with eigenvalues \f$ 1 - \lambda \f$ solve \f$ (D - K) v = \lambda D v \f$,
+//! so the smallest eigenvalues of the sparse pair give the diffusion map.
+//!
+//! @param begin begin data iterator
+//! @param end end data iterator
+//! @param neighbors neighbors of each vector
+//! @param callback distance callback
+//! @param width width \f$ w \f$ of the gaussian kernel
+//!
+template <class RandomAccessIterator, class DistanceCallback>
+Laplacian compute_sparse_diffusion_matrix(RandomAccessIterator begin, RandomAccessIterator end,
+                                          const Neighbors& neighbors, DistanceCallback callback,
+                                          const ScalarType width)
+{
+	timed_context context("Sparse diffusion map matrix computation");
+
+	const IndexType n_vectors = end-begin;
+	const IndexType k = neighbors[0].size();
+	SparseTriplets sparse_triplets;
+	sparse_triplets.reserve((2*k+1)*n_vectors);
+
+	// gaussian kernel on the symmetrized neighborhood graph
+	for (IndexType i=0; i<n_vectors; ++i)
+	{
+		sparse_triplets.push_back(SparseTriplet(i,i,1.0));
+		for (IndexType j=0; j<k; ++j)
+		{
+			const IndexType neighbor = neighbors[i][j];
+			ScalarType distance = callback.distance(begin[i],begin[neighbor]);
+			ScalarType heat = exp(-distance*distance/width);
+			sparse_triplets.push_back(SparseTriplet(i,neighbor,heat));
+			sparse_triplets.push_back(SparseTriplet(neighbor,i,heat));
+		}
+	}
+	SparseWeightMatrix kernel(n_vectors,n_vectors);
+	// mutual neighbors have the same weight twice
+	kernel.setFromTriplets(sparse_triplets.begin(),sparse_triplets.end(),
+	                       [](const ScalarType& a, const ScalarType&) { return a; });
+
+	DenseVector p_inverse = (kernel*DenseVector::Ones(n_vectors)).cwiseInverse();
+	kernel = p_inverse.asDiagonal()*kernel*p_inverse.asDiagonal();
+	DenseVector q = kernel*DenseVector::Ones(n_vectors);
+
+	SparseWeightMatrix diffusion_laplacian = -kernel;
+	for (IndexType i=0; i<n_vectors; i++)
+		diffusion_laplacian.coeffRef(i,i) += q(i);
+
+	return Laplacian(diffusion_laplacian,DenseDiagonalMatrix(q));
+}
+
 } // End of namespace tapkee_internal
 } // End of namespace tapkee
 
@@ -76,6 +76,75 @@ EigendecompositionResult generalized_eigendecomposition_impl_dense(const LMatrix
 	return EigendecompositionResult();
 }
 
+//! Shift-and-invert subspace iteration for the smallest eigenvalues of a sparse
+//! generalized eigenproblem with a diagonal right-hand side matrix, such as
+//! \f$ L v = \lambda D v \f$ of a graph Laplacian. Only the sparse factorization
+//! of \f$ L + \mu D \f$ and a block of vectors are stored, so memory is linear
+//! in the number of vectors for sparse neighborhood graphs.
+inline EigendecompositionResult generalized_eigendecomposition_impl_subspace_iteration(const SparseWeightMatrix& lhs,
+		const DenseDiagonalMatrix& rhs, IndexType target_dimension, unsigned int skip)
+{
+	timed_context context("Subspace iteration generalized eigendecomposition");
+
+	const IndexType n = lhs.rows();
+	const IndexType n_wanted = target_dimension+skip;
+	const IndexType block_size = std::min(n, n_wanted + std::max(n_wanted, static_cast<IndexType>(8)));
+	const IndexType max_iteration = 1000;
+	const ScalarType tolerance = 1e-12;
+
+	DenseVector d = rhs.diagonal();
+	if ((d.array() <= 0).any())
+		throw eigendecomposition_error("right-hand side matrix is not positive definite");
+	DenseVector d_sqrt = d.cwiseSqrt();
+
+	// the shift keeps the factorized matrix positive definite when lhs is singular,
+	// it is relative to the spectrum so that the solves stay well conditioned
+	const ScalarType shift = 1e-8*(lhs.diagonal().array()/d.array()).abs().maxCoeff();
+
+	SparseWeightMatrix shifted = lhs;
+	for (IndexType i=0; i<n; ++i)
+		shifted.coeffRef(i,i) += shift*d(i);
+	SparseSolver solver;
+	solver.compute(shifted);
+	if (solver.info() != Eigen::Success)
+		throw eigendecomposition_error("factorization failed");
+
+	DenseMatrix X(n,block_size);
+	for (IndexType i=0; i<n; ++i)
+		for (IndexType j=0; j<block_size; ++j)
+			X(i,j) = tapkee::gaussian_random();
+
+	DenseSelfAdjointEigenSolver ritz;
+	DenseVector previous = DenseVector::Constant(n_wanted, std::numeric_limits<ScalarType>::max());
+	IndexType iteration = 0;
+	for (; iteration<max_iteration; ++iteration)
+	{
+		// the solve would alias X if it were given rhs*X directly
+		DenseMatrix B = rhs*X;
+		X = solver.solve(B);
+
+		// D-orthonormalize the block, then Rayleigh-Ritz on its span
+		DenseMatrix Q = (d_sqrt.asDiagonal()*X).householderQr().householderQ()*DenseMatrix::Identity(n,block_size);
+		X = d_sqrt.cwiseInverse().asDiagonal()*Q;
+		DenseMatrix projected = X.transpose()*(lhs*X);
+		ritz.compute(projected);
+		if (ritz.info() != Eigen::Success)
+			throw eigendecomposition_error("eigendecomposition failed");
+		X = X*ritz.eigenvectors();
+
+		DenseVector current = ritz.eigenvalues().head(n_wanted);
+		bool converged = ((current-previous).array().abs() <=
+		                  tolerance*(1.0+current.array().abs())).all();
+		previous = current;
+		if (converged)
+			break;
+	}
+	LoggingSingleton::instance().message_info(formatting::format("Took {} iterations.", iteration+1));
+
+	DenseMatrix selected_eigenvectors = X.leftCols(n_wanted).rightCols(target_dimension);
+	return EigendecompositionResult(selected_eigenvectors,previous.tail(target_dimension));
+}
+
 template <typename LMatrixType, typename RMatrixType>
 struct generalized_eigendecomposition_impl
 {
@@ -89,6 +158,10 @@ struct generalized_eigendecomposition_impl
                                    const ComputationStrategy& strategy,
                                    const EigendecompositionStrategy& eigen_strategy,
                                    IndexType target_dimension);
+	EigendecompositionResult randomized(const LMatrixType& lhs, const RMatrixType& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension);
 };
 
 template <>
@@ -128,6 +201,21 @@ struct generalized_eigendecomposition_impl<SparseWeightMatrix, DenseDiagonalMatr
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult randomized(const SparseWeightMatrix& lhs, const DenseDiagonalMatrix& rhs,
+                                        const ComputationStrategy& strategy,
+                                        const EigendecompositionStrategy& eigen_strategy,
+                                        IndexType target_dimension)
+	{
+		if (strategy.is(HomogeneousCPUStrategy))
+		{
+			if (eigen_strategy.is(SmallestEigenvalues))
+				return generalized_eigendecomposition_impl_subspace_iteration
+					(lhs,rhs,target_dimension,eigen_strategy.skip());
+			unsupported();
+		}
+		unsupported();
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -171,6 +259,14 @@ struct generalized_eigendecomposition_impl<DenseMatrix, DenseMatrix>
 		unsupported();
 		return EigendecompositionResult();
 	}
+	EigendecompositionResult randomized(const DenseMatrix&, const DenseMatrix&,
+                                        const ComputationStrategy&,
+                                        const EigendecompositionStrategy&,
+                                        IndexType)
+	{
+		throw unsupported_method_error("Randomized method is not supported for dense generalized eigenproblems");
+		return EigendecompositionResult();
+	}
 	inline void unsupported() const
 	{
 		throw unsupported_method_error("Unsupported method");
@@ -193,7 +289,8 @@ EigendecompositionResult generalized_eigendecomposition(const EigenMethod& metho
 		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
 			.dense(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	if (method.is(Randomized))
-		throw unsupported_method_error("Randomized method is not supported for generalized eigenproblems");
+		return generalized_eigendecomposition_impl<LMatrixType, RMatrixType>()
+			.randomized(lhs, rhs, strategy, eigen_strategy, target_dimension);
 	return EigendecompositionResult();
 }
 
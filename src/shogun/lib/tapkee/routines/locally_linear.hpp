@@ -83,12 +83,12 @@ SparseWeightMatrix tangent_weight_matrix(RandomAccessIterator begin, RandomAcces
 					local_triplets.push_back(tangent_triplet);
 				}
 			}
-#pragma omp critical
-			{
-				copy(local_triplets.begin(),local_triplets.end(),std::back_inserter(sparse_triplets));
-			}
+		}
 
-			local_triplets.clear();
+		// triplets are merged once per thread rather than once per vector
+#pragma omp critical
+		{
+			copy(local_triplets.begin(),local_triplets.end(),std::back_inserter(sparse_triplets));
 		}
 	}
 
@@ -156,13 +156,12 @@ SparseWeightMatrix linear_weight_matrix(const RandomAccessIterator& begin, const
 					local_triplets.push_back(cross_triplet);
 				}
 			}
+		}
 
+		// triplets are merged once per thread rather than once per vector
 #pragma omp critical
-			{
-				copy(local_triplets.begin(),local_triplets.end(),std::back_inserter(sparse_triplets));
-			}
-
-			local_triplets.clear();
+		{
+			copy(local_triplets.begin(),local_triplets.end(),std::back_inserter(sparse_triplets));
 		}
 		//UNRESTRICT_ALLOC;
 	}
@@ -257,13 +256,12 @@ SparseWeightMatrix hessian_weight_matrix(RandomAccessIterator begin, RandomAcces
 					local_triplets.push_back(hessian_triplet);
 				}
 			}
+		}
 
-			#pragma omp critical
-			{
-				copy(local_triplets.begin(),local_triplets.end(),std::back_inserter(sparse_triplets));
-			}
-
-			local_triplets.clear();
+		// triplets are merged once per thread rather than once per vector
+#pragma omp critical
+		{
+			copy(local_triplets.begin(),local_triplets.end(),std::back_inserter(sparse_triplets));
 		}
 	}
 
@@ -116,6 +116,46 @@ DenseMatrix triangulate(RandomAccessIterator begin, RandomAccessIterator end, Pa
 	return embedding;
 }
 
+//! Places all vectors relative to the embedded landmarks given their squared
+//! distances to the landmarks, as in the landmark triangulation above. This is
+//! the Nystrom extension of classical scaling used by landmark Isomap where the
+//! geodesic distances to the landmarks are computed beforehand.
+//!
+//! @param distances_to_landmarks squared distances, landmarks x vectors
+//! @param landmarks indices of landmarks
+//! @param landmark_distances_squared mean squared distances between landmarks
+//! @param landmarks_embedding scaled eigenvectors and eigenvalues of the landmarks
+//! @param target_dimension dimension of the embedding
+//!
+inline DenseMatrix triangulate(const DenseMatrix& distances_to_landmarks, const Landmarks& landmarks,
+                               const DenseVector& landmark_distances_squared,
+                               EigendecompositionResult& landmarks_embedding, IndexType target_dimension)
+{
+	timed_context context("Landmark triangulation");
+
+	const IndexType n_vectors = distances_to_landmarks.cols();
+	const IndexType n_landmarks = landmarks.size();
+
+	DenseMatrix embedding(n_vectors,target_dimension);
+	for (IndexType i=0; i<target_dimension; ++i)
+		landmarks_embedding.first.col(i).array() /= landmarks_embedding.second(i);
+
+#pragma omp parallel for
+	for (IndexType index_iter=0; index_iter<n_vectors; ++index_iter)
+	{
+		DenseVector centered = distances_to_landmarks.col(index_iter) - landmark_distances_squared;
+		embedding.row(index_iter).noalias() = -0.5*landmarks_embedding.first.transpose()*centered;
+	}
+
+	// landmarks keep their own coordinates
+	for (IndexType i=0; i<target_dimension; ++i)
+		landmarks_embedding.first.col(i).array() *= landmarks_embedding.second(i);
+	for (IndexType index_iter=0; index_iter<n_landmarks; ++index_iter)
+		embedding.row(landmarks[index_iter]).noalias() = landmarks_embedding.first.row(index_iter);
+
+	return embedding;
+}
+
 template <class RandomAccessIterator, class PairwiseCallback>
 DenseSymmetricMatrix compute_distance_matrix(RandomAccessIterator begin, RandomAccessIterator end,
                                              PairwiseCallback callback)
@@ -157,17 +157,40 @@ std::shared_ptr<DenseFeatures<float64_t>> shogun::tapkee_embed(const shogun::TAP
 			N = parameters.features->get_num_vectors();
 			break;
 	}
+#ifndef HAVE_ARPACK
+	// sparse problems are solved by subspace iteration rather than densified
+	if (method == tapkee::LaplacianEigenmaps ||
+	    (method == tapkee::DiffusionMap && parameters.diffusion_map_sparse))
+		eigen_method = tapkee::Randomized;
+#endif
 
 	std::vector<int32_t> indices(N);
 	for (size_t i=0; i<N; i++)
 		indices[i] = i;
 
+	std::vector<std::vector<tapkee::IndexType> > precomputed_neighbors;
+	if (parameters.neighbors)
+	{
+		const SGMatrix<index_t> graph =
+			parameters.neighbors->get_neighbors(parameters.n_neighbors);
+		require(graph.num_cols == (index_t)N,
+			"Neighbor graph of {} vectors does not match {} vectors to embed",
+			graph.num_cols, N);
+		precomputed_neighbors.resize(N);
+		for (size_t i=0; i<N; i++)
+		{
+			const index_t* neighbors = graph.get_column_vector(i);
+			precomputed_neighbors[i].assign(neighbors, neighbors+graph.num_rows);
+		}
+	}
+
 	tapkee::ParametersSet parameters_set =
 		(tapkee::method=method,
 		 tapkee::eigen_method=eigen_method,
 		 tapkee::neighbors_method=neighbors_method,
 		 tapkee::num_neighbors=parameters.n_neighbors,
 		 tapkee::diffusion_map_timesteps = parameters.n_timesteps,
+		 tapkee::diffusion_map_sparse = parameters.diffusion_map_sparse,
 		 tapkee::target_dimension = parameters.target_dimension,
 		 tapkee::spe_num_updates = parameters.spe_num_updates,
 		 tapkee::nullspace_shift = parameters.eigenshift,
@@ -179,7 +202,9 @@ std::shared_ptr<DenseFeatures<float64_t>> shogun::tapkee_embed(const shogun::TAP
 		 tapkee::fa_epsilon = parameters.fa_epsilon,
 		 tapkee::sne_perplexity = parameters.sne_perplexity,
 		 tapkee::sne_theta = parameters.sne_theta,
-		 tapkee::squishing_rate = parameters.squishing_rate
+		 tapkee::sne_interpolation = parameters.sne_interpolation,
+		 tapkee::squishing_rate = parameters.squishing_rate,
+		 tapkee::precomputed_neighbors = parameters.neighbors ? &precomputed_neighbors : NULL
 		 );
 
 	tapkee::TapkeeOutput output = tapkee::embed(indices.begin(),indices.end(),
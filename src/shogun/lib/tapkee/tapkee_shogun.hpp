@@ -12,6 +12,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/distance/NeighborGraph.h>
 #include <shogun/features/DenseFeatures.h>
 
 using namespace shogun;
@@ -50,8 +51,9 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 		gaussian_kernel_width(1.0), spe_tolerance(1e-5),
 		spe_global_strategy(false), max_iteration(100),
 		fa_epsilon(1e-5), sne_theta(0.5),
-		sne_perplexity(30.0), squishing_rate(0.99),
-		kernel(NULL), distance(NULL), features(NULL)
+		sne_perplexity(30.0), sne_interpolation(false), squishing_rate(0.99),
+		diffusion_map_sparse(false),
+		kernel(NULL), distance(NULL), features(NULL), neighbors(NULL)
 	{
 	}
 	TAPKEE_METHODS_FOR_SHOGUN method;
@@ -68,10 +70,15 @@ struct TAPKEE_PARAMETERS_FOR_SHOGUN
 	float64_t fa_epsilon;
 	float64_t sne_theta;
 	float64_t sne_perplexity;
+	bool sne_interpolation;
 	float64_t squishing_rate;
+	/** diffusion map on the neighbors only */
+	bool diffusion_map_sparse;
 	Kernel* kernel;
 	Distance* distance;
 	DotFeatures* features;
+	/** precomputed neighbors, searched if NULL */
+	NeighborGraph* neighbors;
 };
 
 std::shared_ptr<DenseFeatures<float64_t>> tapkee_embed(const TAPKEE_PARAMETERS_FOR_SHOGUN& parameters);
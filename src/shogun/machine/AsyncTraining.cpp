@@ -0,0 +1,68 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/machine/AsyncTraining.h>
+
+#include <shogun/features/Features.h>
+#include <shogun/machine/Machine.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace shogun;
+
+AsyncTraining::AsyncTraining(
+    std::shared_ptr<Machine> machine, std::shared_ptr<Features> data)
+    : m_machine(std::move(machine))
+{
+	require(m_machine, "No machine to train given");
+
+	// a detached thread with a promise instead of std::async, the future
+	// of which would block in the destructor of the last handle
+	std::promise<bool> promise;
+	m_result = promise.get_future().share();
+	std::thread(
+	    [machine = m_machine, data = std::move(data),
+	     promise = std::move(promise)]() mutable {
+		    try
+		    {
+			    promise.set_value(machine->train(data));
+		    }
+		    catch (...)
+		    {
+			    promise.set_exception(std::current_exception());
+		    }
+	    })
+	    .detach();
+}
+
+bool AsyncTraining::is_done() const
+{
+	return wait_for(0);
+}
+
+void AsyncTraining::wait() const
+{
+	m_result.wait();
+}
+
+bool AsyncTraining::wait_for(float64_t seconds) const
+{
+	return m_result.wait_for(std::chrono::duration<float64_t>(seconds)) ==
+	       std::future_status::ready;
+}
+
+bool AsyncTraining::get() const
+{
+	return m_result.get();
+}
+
+void AsyncTraining::cancel()
+{
+	// the flag would otherwise stop the next training right away
+	if (!is_done())
+		m_machine->stop_computation();
+}
@@ -0,0 +1,84 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _ASYNCTRAINING_H__
+#define _ASYNCTRAINING_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <future>
+#include <memory>
+
+namespace shogun
+{
+class Features;
+class Machine;
+
+/** @brief Handle of a machine trained on a separate thread, see
+ * Machine::train_async().
+ *
+ * The training thread keeps the machine and the data alive, dropping the
+ * handle neither waits for nor stops it. cancel() stops the training
+ * through StoppableSGObject::stop_computation(), like a premature stop
+ * from the signal handler, so machines that check
+ * StoppableSGObject::cancel_computation() return early with what they
+ * have trained so far.
+ *
+ * None of the methods hold the Python GIL while waiting, a Python event
+ * loop therefore either polls is_done() or waits for get() in an executor.
+ */
+class AsyncTraining
+{
+public:
+	/** start training
+	 *
+	 * @param machine machine to train
+	 * @param data training data, see Machine::train()
+	 */
+	AsyncTraining(
+	    std::shared_ptr<Machine> machine, std::shared_ptr<Features> data);
+
+	/** @return whether training has finished, successfully or not */
+	bool is_done() const;
+
+	/** wait until training has finished */
+	void wait() const;
+
+	/** wait until training has finished or the timeout has passed
+	 *
+	 * @param seconds timeout in seconds
+	 * @return whether training has finished
+	 */
+	bool wait_for(float64_t seconds) const;
+
+	/** wait until training has finished
+	 *
+	 * throws the error of a failed training
+	 *
+	 * @return result of Machine::train()
+	 */
+	bool get() const;
+
+	/** request training to stop, has no effect once it has finished */
+	void cancel();
+
+	/** @return trained machine */
+	std::shared_ptr<Machine> get_machine() const
+	{
+		return m_machine;
+	}
+
+private:
+	/** machine being trained */
+	std::shared_ptr<Machine> m_machine;
+
+	/** result of the training thread */
+	std::shared_future<bool> m_result;
+};
+}
+#endif /* _ASYNCTRAINING_H__ */
@@ -13,8 +13,12 @@
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/evaluation/Evaluation.h>
+#include <shogun/lib/observers/ObservedValueTemplated.h>
 
+#include <algorithm>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -107,9 +111,11 @@ BaggingMachine::apply_outputs_without_combination(std::shared_ptr<Features> data
 	SGMatrix<float64_t> output(data->get_num_vectors(), m_num_bags);
 	output.zero();
 
-#pragma omp parallel for
+	const int32_t num_threads = std::min(m_num_bags, env()->get_num_threads());
+#pragma omp parallel for num_threads(num_threads)
 	for (int32_t i = 0; i < m_num_bags; ++i)
 	{
+		env()->limit_nested_threads();
 		auto m = m_bags.at(i);
 		auto l = m->apply(data);
 		SGVector<float64_t> lv;
@@ -125,6 +131,34 @@ BaggingMachine::apply_outputs_without_combination(std::shared_ptr<Features> data
 	return output;
 }
 
+/* distinct indices of a bag in increasing order and the number of times
+ * each was drawn */
+static std::pair<SGVector<index_t>, SGVector<float64_t>>
+count_bag(const SGVector<index_t>& idx)
+{
+	SGVector<index_t> sorted = idx.clone();
+	std::sort(sorted.begin(), sorted.end());
+
+	std::vector<index_t> distinct;
+	std::vector<float64_t> counts;
+	for (auto j : sorted)
+	{
+		if (!distinct.empty() && distinct.back() == j)
+			counts.back() += 1;
+		else
+		{
+			distinct.push_back(j);
+			counts.push_back(1);
+		}
+	}
+
+	SGVector<index_t> distinct_idx(distinct.size());
+	SGVector<float64_t> distinct_counts(counts.size());
+	std::copy(distinct.begin(), distinct.end(), distinct_idx.begin());
+	std::copy(counts.begin(), counts.end(), distinct_counts.begin());
+	return std::make_pair(distinct_idx, distinct_counts);
+}
+
 bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 {
 	require(m_machine != NULL, "Machine is not set!");
@@ -143,6 +177,7 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 
 	// clear the array, if previously trained
 	m_bags.clear();
+	m_bags.resize(m_num_bags);
 
 	// reset the oob index vector
 	m_all_oob_idx = SGVector<bool>(m_features->get_num_vectors());
@@ -150,23 +185,41 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 
 
 	m_oob_indices.clear();
+	m_oob_indices.resize(m_num_bags);
+
+	// in-bag entries are NAN, which combination rules skip, or 0 for
+	// regression
+	m_oob_outputs = SGMatrix<float64_t>(m_features->get_num_vectors(), m_num_bags);
+	if (m_labels->get_label_type() == LT_REGRESSION)
+		m_oob_outputs.zero();
+	else
+		m_oob_outputs.set_const(NAN);
 
 	SGMatrix<index_t> rnd_indicies(m_bag_size, m_num_bags);
 	random::fill_array(rnd_indicies, 0, m_bag_size - 1, m_prng);
 
 	auto pb = SG_PROGRESS(range(m_num_bags));
-#pragma omp parallel for
+	const int32_t num_threads = std::min(m_num_bags, env()->get_num_threads());
+	// the bags are trained in the computation of this machine and stop
+	// with it
+	const auto computation = current_computation();
+#pragma omp parallel for num_threads(num_threads)
 	for (int32_t i = 0; i < m_num_bags; ++i)
 	{
+		ComputationScope scope(computation);
+		env()->limit_nested_threads();
 		auto c=std::dynamic_pointer_cast<Machine>(m_machine->clone());
 		ASSERT(c != NULL);
 		SGVector<index_t> idx(
 		    rnd_indicies.get_column_vector(i), m_bag_size, false);
+		SGVector<float64_t> counts;
+		if (supports_bag_weights())
+			std::tie(idx, counts) = count_bag(idx);
 
 		std::shared_ptr<Features> features;
 		std::shared_ptr<Labels> labels;
 
-		if (env()->get_num_threads() == 1)
+		if (num_threads == 1)
 		{
 			features = m_features;
 			labels = m_labels;
@@ -195,30 +248,51 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 		}
 		*/
 		features->add_subset(idx);
-		set_machine_parameters(c, idx);
+		set_machine_parameters(c, idx, counts);
 		c->set_labels(labels);
 		c->train(features);
 		features->remove_subset();
 		labels->remove_subset();
 
+		std::vector<index_t> oob;
+		const index_t bag = i;
 #pragma omp critical
 		{
 		// get out of bag indexes
-		auto oob = get_oob_indices(idx);
-		m_oob_indices.push_back(oob);
+		oob = get_oob_indices(idx);
+		}
+
+		// every bag keeps its position, so the model does not depend on
+		// the number of threads or the order in which the bags finish
+		m_oob_indices[bag] = oob;
+		m_bags[bag] = c;
 
-		// add trained machine to bag array
-		m_bags.push_back(c);
+		// predict the out-of-bag vectors while the bag is at hand, every
+		// bag writes its own column
+		if (!oob.empty())
+		{
+			SGVector<index_t> oob_idx(oob.data(), oob.size(), false);
+			features->add_subset(oob_idx);
+			auto l = c->apply(features);
+			features->remove_subset();
+			if (l == NULL)
+				error("NULL returned by apply method");
+
+			auto lv = l->as<DenseLabels>()->get_labels();
+			for (index_t j = 0; j < oob_idx.vlen; j++)
+				m_oob_outputs(oob_idx[j], bag) = lv[j];
 		}
 
 		pb.print_progress();
 	}
 	pb.complete();
 
+	observe_oob_curve();
 	return true;
 }
 
-void BaggingMachine::set_machine_parameters(std::shared_ptr<Machine> m, SGVector<index_t> idx)
+void BaggingMachine::set_machine_parameters(
+    std::shared_ptr<Machine> m, SGVector<index_t> idx, SGVector<float64_t> counts)
 {
 }
 
@@ -301,6 +375,12 @@ float64_t BaggingMachine::get_oob_error() const
 	require(m_combination_rule, "Combination rule is not set!");
 	require(m_bags.size() > 0, "BaggingMachine is not trained!");
 
+	if (m_oob_outputs.num_rows == m_features->get_num_vectors() &&
+	    m_oob_outputs.num_cols == m_bags.size())
+		return evaluate_oob(m_oob_outputs, m_all_oob_idx);
+
+	// the outputs were not stored in training, e.g. for a deserialized
+	// machine
 	SGMatrix<float64_t> output(
 	    m_features->get_num_vectors(), m_bags.size());
 	if (m_labels->get_label_type() == LT_REGRESSION)
@@ -308,10 +388,6 @@ float64_t BaggingMachine::get_oob_error() const
 	else
 		output.set_const(NAN);
 
-	/* TODO: add parallel support of applying the OOBs
-	  only possible when add_subset is thread-safe
-	#pragma omp parallel for num_threads(env()->get_num_threads())
-	*/
 	for (index_t i = 0; i < m_bags.size(); i++)
 	{
 		auto m = m_bags.at(i);
@@ -332,19 +408,22 @@ float64_t BaggingMachine::get_oob_error() const
 			output(oob[j], i) = lv[j];
 
 		m_features->remove_subset();
-
-
-
 	}
 
+	return evaluate_oob(output, m_all_oob_idx);
+}
+
+float64_t BaggingMachine::evaluate_oob(
+    const SGMatrix<float64_t>& outputs, const SGVector<bool>& is_oob) const
+{
 	std::vector<index_t> idx;
-	for (index_t i = 0; i < m_features->get_num_vectors(); i++)
+	for (index_t i = 0; i < is_oob.vlen; i++)
 	{
-		if (m_all_oob_idx[i])
+		if (is_oob[i])
 			idx.push_back(i);
 	}
 
-	SGVector<float64_t> combined = m_combination_rule->combine(output);
+	SGVector<float64_t> combined = m_combination_rule->combine(outputs);
 	SGVector<float64_t> lab(idx.size());
 	for (int32_t i = 0; i < lab.vlen; i++)
 		lab[i] = combined[idx[i]];
@@ -376,6 +455,28 @@ float64_t BaggingMachine::get_oob_error() const
 	return res;
 }
 
+void BaggingMachine::observe_oob_curve() const
+{
+	if (get_num_subscriptions() == 0 || !m_oob_evaluation_metric ||
+	    !m_combination_rule)
+		return;
+
+	SGVector<bool> is_oob(m_features->get_num_vectors());
+	is_oob.zero();
+	for (index_t k = 0; k < m_bags.size(); k++)
+	{
+		for (auto i : m_oob_indices[k])
+			is_oob[i] = true;
+
+		// the outputs of the first k+1 bags are the first columns
+		SGMatrix<float64_t> outputs(
+		    m_oob_outputs.matrix, m_oob_outputs.num_rows, k + 1, false);
+		observe<float64_t>(
+		    k, kOobError, "Out-of-bag error of the first bags",
+		    evaluate_oob(outputs, is_oob));
+	}
+}
+
 std::vector<index_t> BaggingMachine::get_oob_indices(const SGVector<index_t>& in_bag)
 {
 	SGVector<bool> out_of_bag(m_features->get_num_vectors());
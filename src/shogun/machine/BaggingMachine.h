@@ -115,7 +115,11 @@ namespace shogun
 		/** get out-of-bag error
 		 * CombinationRule is used for combining the predictions.
 		 *
-		 * @param eval Evaluation method to use for calculating the error
+		 * Every bag predicts its out-of-bag vectors right after it is
+		 * trained, so this only combines the stored predictions. If
+		 * observers are attached, the out-of-bag error of the first k bags
+		 * is emitted as "oob_error" at step k-1 after training.
+		 *
 		 * @return out-of-bag error.
 		 */
 		float64_t get_oob_error() const;
@@ -134,8 +138,24 @@ namespace shogun
 		 *
 		 * @param m machine
 		 * @param idx indices of training vectors chosen in current bag
+		 * @param counts number of times each vector of idx was drawn,
+		 * empty if idx repeats the vectors, see supports_bag_weights()
+		 */
+		virtual void set_machine_parameters(
+			std::shared_ptr<Machine> m, SGVector<index_t> idx,
+			SGVector<float64_t> counts);
+
+		/** whether the machines train on every drawn vector once, weighted
+		 * by the number of times it was drawn. The bag then holds only the
+		 * distinct vectors and set_machine_parameters() gets the counts,
+		 * which has to apply them as weights.
+		 *
+		 * @return false by default
 		 */
-		virtual void set_machine_parameters(std::shared_ptr<Machine> m, SGVector<index_t> idx);
+		virtual bool supports_bag_weights() const
+		{
+			return false;
+		}
 
 		/** helper function for the apply_{regression,..} functions that
 		 * computes the output
@@ -151,7 +171,7 @@ namespace shogun
 		 * @param data the data to compute the output for
 		 * @return predictions
 		 */
-		SGMatrix<float64_t>
+		virtual SGMatrix<float64_t>
 			apply_outputs_without_combination(std::shared_ptr<Features> data);
 
 		/** Register paramaters */
@@ -170,6 +190,19 @@ namespace shogun
 		std::vector<index_t>
 		get_oob_indices(const SGVector<index_t>& in_bag);
 
+		/** out-of-bag error of combined outputs
+		 *
+		 * @param outputs outputs of the bags, one column per bag
+		 * @param is_oob whether a vector is out of bag of any of the bags
+		 * @return out-of-bag error
+		 */
+		float64_t evaluate_oob(
+			const SGMatrix<float64_t>& outputs,
+			const SGVector<bool>& is_oob) const;
+
+		/** emit the out-of-bag error of the first k bags for all k */
+		void observe_oob_curve() const;
+
 	protected:
 		/** bags array */
 		std::vector<std::shared_ptr<Machine>> m_bags;
@@ -195,6 +228,10 @@ namespace shogun
 		/** array of oob indices */
 		std::vector<std::vector<index_t>> m_oob_indices;
 
+		/** outputs of every bag for its out-of-bag vectors, one column per
+		 * bag, NAN or 0 for regression elsewhere */
+		SGMatrix<float64_t> m_oob_outputs;
+
 		/** metric to calculate the oob error */
 		std::shared_ptr<Evaluation> m_oob_evaluation_metric;
 
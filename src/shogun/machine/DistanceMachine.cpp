@@ -8,11 +8,8 @@
 #include <shogun/machine/DistanceMachine.h>
 #include <shogun/distance/Distance.h>
 
-#ifdef HAVE_OPENMP
-#include <omp.h>
-
+#include <algorithm>
 #include <utility>
-#endif
 
 using namespace shogun;
 
@@ -35,66 +32,22 @@ void DistanceMachine::init()
 
 void DistanceMachine::distances_lhs(SGVector<float64_t>& result, index_t idx_a1, index_t idx_a2, index_t idx_b)
 {
-    int32_t num_threads;
-    int32_t num_vec;
-    int32_t step;
-
-    ASSERT(result)
-
-    #pragma omp parallel shared(num_threads, step)
-    {
-#ifdef HAVE_OPENMP
-        #pragma omp single
-        {
-            num_threads=omp_get_num_threads();
-            num_vec=idx_a2-idx_a1+1;
-            step=num_vec/num_threads;
-        }
-        int32_t thread_num=omp_get_thread_num();
-
-        index_t idx_r_start = thread_num * step;
-        index_t idx_start = (thread_num * step) + idx_a1;
-        index_t idx_stop = (thread_num==(num_threads - 1)) ? (idx_a2 + 1) : ((thread_num + 1) * step) + idx_a1;
-        distance->run_distance_lhs(result, idx_r_start, idx_start, idx_stop, idx_b);
-#else
-        index_t idx_r_start = idx_a1;
-        index_t idx_start = idx_a1;
-        index_t idx_stop = idx_a2  + 1;
-        distance->run_distance_lhs(result, idx_r_start, idx_start, idx_stop, idx_b);
-#endif
-    }
+	ASSERT(result)
+
+	SGVector<index_t> lhs_idx(idx_a2-idx_a1+1);
+	lhs_idx.range_fill(idx_a1);
+	auto block=distance->get_distance_block(lhs_idx, SGVector<index_t>({idx_b}));
+	std::copy_n(block.matrix, lhs_idx.vlen, result.vector);
 }
 
 void DistanceMachine::distances_rhs(SGVector<float64_t>& result, index_t idx_b1, index_t idx_b2, index_t idx_a)
 {
-    int32_t num_threads;
-    int32_t num_vec;
-    int32_t step;
-
-    ASSERT(result)
-
-    #pragma omp parallel shared(num_threads, step)
-    {
-#ifdef HAVE_OPENMP
-        #pragma omp single
-        {
-            num_threads=omp_get_num_threads();
-            num_vec=idx_b2-idx_b1+1;
-            step=num_vec/num_threads;
-        }
-        int32_t thread_num=omp_get_thread_num();
-
-        index_t idx_r_start = thread_num * step;
-        index_t idx_start = (thread_num * step) + idx_b1;
-        index_t idx_stop = (thread_num==(num_threads - 1)) ? (idx_b2 + 1) : ((thread_num + 1) * step) + idx_b1;
-        distance->run_distance_rhs(result, idx_r_start, idx_start, idx_stop, idx_a);
-#else
-        index_t idx_r_start = idx_b1;
-        index_t idx_start = idx_b1;
-        index_t idx_stop = idx_b2  + 1;
-        distance->run_distance_rhs(result, idx_r_start, idx_start, idx_stop, idx_a);
-#endif
-    }
+	ASSERT(result)
+
+	SGVector<index_t> rhs_idx(idx_b2-idx_b1+1);
+	rhs_idx.range_fill(idx_b1);
+	auto block=distance->get_distance_block(SGVector<index_t>({idx_a}), rhs_idx);
+	std::copy_n(block.matrix, rhs_idx.vlen, result.vector);
 }
 
 std::shared_ptr<MulticlassLabels> DistanceMachine::apply_multiclass(std::shared_ptr<Features> data)
@@ -105,10 +58,33 @@ std::shared_ptr<MulticlassLabels> DistanceMachine::apply_multiclass(std::shared_
 		auto lhs=distance->get_lhs();
 		distance->init(lhs, data);
 
-		/* build result labels and classify all elements of procedure */
-		auto result=std::make_shared<MulticlassLabels>(data->get_num_vectors());
-		for (index_t i=0; i<data->get_num_vectors(); ++i)
-			result->set_label(i, apply_one(i));
+		/* build result labels and classify all elements of procedure,
+		 * distances to all cluster centers are computed block-wise */
+		const index_t num_vectors=data->get_num_vectors();
+		const index_t num_clusters=lhs->get_num_vectors();
+		const index_t block_size=128;
+		auto result=std::make_shared<MulticlassLabels>(num_vectors);
+
+		SGVector<index_t> cluster_idx(num_clusters);
+		cluster_idx.range_fill();
+		for (index_t begin=0; begin<num_vectors; begin+=block_size)
+		{
+			const index_t len=std::min(block_size, num_vectors-begin);
+			SGVector<index_t> vec_idx(len);
+			vec_idx.range_fill(begin);
+			auto dists=distance->get_distance_block(cluster_idx, vec_idx);
+
+			for (index_t j=0; j<len; ++j)
+			{
+				index_t best_index=0;
+				for (index_t i=1; i<num_clusters; ++i)
+				{
+					if (dists(i, j)<dists(best_index, j))
+						best_index=i;
+				}
+				result->set_label(begin+j, best_index);
+			}
+		}
 		return result;
 	}
 	else
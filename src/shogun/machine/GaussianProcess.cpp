@@ -13,6 +13,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/config.h>
 #include <shogun/machine/GaussianProcess.h>
+#include <shogun/machine/gp/IterativeExactInferenceMethod.h>
 #include <shogun/machine/gp/LikelihoodModel.h>
 #include <shogun/machine/gp/SingleFITCInference.h>
 #include <shogun/mathematics/Math.h>
@@ -67,11 +68,13 @@ GaussianProcess::get_posterior_means(const std::shared_ptr<Features>& data)
 	std::shared_ptr<Features> feat;
 
 	auto sparse_method =
-	    std::dynamic_pointer_cast<SingleSparseInference>(m_method);
+	    std::dynamic_pointer_cast<SparseInference>(m_method);
 	// use inducing features for sparse inference method
 	if (sparse_method)
 	{
-		sparse_method->optimize_inducing_features();
+		if (auto single_sparse_method =
+		        std::dynamic_pointer_cast<SingleSparseInference>(m_method))
+			single_sparse_method->optimize_inducing_features();
 		feat = sparse_method->get_inducing_features();
 	}
 	else
@@ -79,7 +82,8 @@ GaussianProcess::get_posterior_means(const std::shared_ptr<Features>& data)
 
 	// get kernel and compute kernel matrix: K(feat, data)*scale^2
 	auto training_kernel = m_method->get_kernel();
-	auto kernel = std::dynamic_pointer_cast<Kernel>(training_kernel->clone());
+	auto kernel = make_clone(
+		training_kernel, ParameterProperties::ALL, true);
 
 	kernel->init(feat, data);
 
@@ -125,11 +129,13 @@ GaussianProcess::get_posterior_variances(const std::shared_ptr<Features>& data)
 
 	bool is_sparse = false;
 	auto sparse_method =
-	    std::dynamic_pointer_cast<SingleSparseInference>(m_method);
+	    std::dynamic_pointer_cast<SparseInference>(m_method);
 	// use inducing features for sparse inference method
 	if (sparse_method)
 	{
-		sparse_method->optimize_inducing_features();
+		if (auto single_sparse_method =
+		        std::dynamic_pointer_cast<SingleSparseInference>(m_method))
+			single_sparse_method->optimize_inducing_features();
 		feat = sparse_method->get_inducing_features();
 		is_sparse = true;
 	}
@@ -138,7 +144,8 @@ GaussianProcess::get_posterior_variances(const std::shared_ptr<Features>& data)
 
 	// get kernel and compute kernel matrix: K(data, data)*scale^2
 	auto training_kernel = m_method->get_kernel();
-	auto kernel = std::dynamic_pointer_cast<Kernel>(training_kernel->clone());
+	auto kernel = make_clone(
+		training_kernel, ParameterProperties::ALL, true);
 
 	kernel->init(data, data);
 
@@ -159,6 +166,21 @@ GaussianProcess::get_posterior_variances(const std::shared_ptr<Features>& data)
 	// compute Ks=Ks*scale^2
 	eigen_Ks *= Math::sq(m_method->get_scale());
 
+	// the iterative method has no cholesky, instead solve K*V = Ks and
+	// compute s2 = Kss - sum(Ks .* V)
+	auto iterative_method =
+	    std::dynamic_pointer_cast<IterativeExactInferenceMethod>(m_method);
+	if (iterative_method)
+	{
+		SGMatrix<float64_t> V = iterative_method->solve(k_trts);
+		Map<MatrixXd> eigen_V(V.matrix, V.num_rows, V.num_cols);
+
+		SGVector<float64_t> s2(k_tsts.vlen);
+		Map<VectorXd>(s2.vector, s2.vlen) =
+		    eigen_Kss_diag - eigen_Ks.cwiseProduct(eigen_V).colwise().sum().adjoint();
+		return s2;
+	}
+
 	// get shogun representation of cholesky and create eigen representation
 	SGMatrix<float64_t> L = m_method->get_cholesky();
 	Map<MatrixXd> eigen_L(L.matrix, L.num_rows, L.num_cols);
@@ -10,8 +10,11 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/base/progress.h>
+#include <shogun/evaluation/Evaluation.h>
+#include <shogun/lib/Profiler.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/common.h>
+#include <shogun/lib/observers/ConvergenceMonitor.h>
 #include <shogun/machine/LinearMachine.h>
 
 namespace shogun
@@ -33,6 +36,11 @@ namespace shogun
 			m_current_iteration = 0;
 			m_complete = false;
 			m_continue_features = nullptr;
+			m_observation_interval = 1;
+			m_monitor = nullptr;
+			m_validation_features = nullptr;
+			m_validation_labels = nullptr;
+			m_validation_evaluation = nullptr;
 
 			SG_ADD(
 			    &m_current_iteration, "current_iteration",
@@ -44,6 +52,13 @@ namespace shogun
 			    &m_complete, "complete", "Convergence status");
 			SG_ADD(
 			    &m_continue_features, "continue_features", "Continue Features");
+			SG_ADD(
+			    &m_observation_interval, "observation_interval",
+			    "Emit observed parameters every observation_interval-th "
+			    "iteration");
+			SG_ADD(
+			    (std::shared_ptr<SGObject>*)&m_monitor, "monitor",
+			    "Convergence monitor");
 		}
 		~IterativeMachine() override
 		{
@@ -56,22 +71,100 @@ namespace shogun
 			return m_complete;
 		}
 
+		/** Set the interval at which parameters are emitted to attached
+		 * parameter observers.
+		 * @param interval emit every interval-th iteration
+		 */
+		void set_observation_interval(int32_t interval)
+		{
+			require(
+			    interval > 0, "Observation interval ({}) must be positive",
+			    interval);
+			m_observation_interval = interval;
+		}
+
+		/** Attach a convergence monitor. On the iterations it samples,
+		 * the validation score (if validation data is set) is recorded in
+		 * its "validation" channel, and training stops once the monitor
+		 * requests it.
+		 * @param monitor convergence monitor, nullptr to detach
+		 */
+		void set_convergence_monitor(std::shared_ptr<ConvergenceMonitor> monitor)
+		{
+			m_monitor = std::move(monitor);
+		}
+
+		/** @return attached convergence monitor */
+		std::shared_ptr<ConvergenceMonitor> get_convergence_monitor() const
+		{
+			return m_monitor;
+		}
+
+		/** Set held out data to be scored on the iterations sampled by the
+		 * convergence monitor. Early stopping on the score is enabled with
+		 * ConvergenceMonitor::set_early_stopping("validation", ...).
+		 * @param features validation features
+		 * @param labels validation labels
+		 * @param evaluation evaluation criterion
+		 */
+		void set_validation_data(
+		    std::shared_ptr<Features> features, std::shared_ptr<Labels> labels,
+		    std::shared_ptr<Evaluation> evaluation)
+		{
+			require(
+			    features && labels && evaluation,
+			    "Validation features, labels and evaluation must be set");
+			m_validation_features = std::move(features);
+			m_validation_labels = std::move(labels);
+			m_validation_evaluation = std::move(evaluation);
+		}
+
 		bool continue_train() override
 		{
 			this->reset_computation_variables();
 			//this->put("features", m_continue_features);
 
+			index_t validation_channel = -1;
+			if (m_monitor && m_validation_features)
+				validation_channel = m_monitor->add_channel("validation");
+
+			bool stopped_early = false;
 			auto pb = SG_PROGRESS(range(m_max_iterations));
 			while (m_current_iteration < m_max_iterations && !m_complete)
 			{
 				COMPUTATION_CONTROLLERS
-				iteration();
+				{
+					SG_PROFILE_SCOPE("IterativeMachine::iteration");
+					iteration();
+				}
+				if (m_monitor &&
+				    m_monitor->should_sample(m_current_iteration))
+				{
+					if (validation_channel >= 0)
+						m_monitor->record(
+						    validation_channel, m_current_iteration,
+						    validation_score());
+					stopped_early = m_monitor->should_stop();
+				}
 				m_current_iteration++;
 				pb.print_progress();
+				if (stopped_early)
+					break;
 			}
 			pb.complete();
 
-			if (m_complete)
+			if (stopped_early)
+			{
+				io::info(
+				    "{} stopped early after {} iterations, best score {} at "
+				    "iteration {}.",
+				    this->get_name(), m_current_iteration,
+				    m_monitor->get_best_value(), m_monitor->get_best_step());
+				m_complete = true;
+
+				this->end_training();
+			}
+			else if (m_complete)
 			{
 				io::info(
 				    "{} converged after {} iterations.", this->get_name(),
@@ -88,6 +181,15 @@ namespace shogun
 
 				this->end_training();
 			}
+			else if (this->cancel_computation())
+			{
+				io::warn(
+				    "{} was stopped after {} iterations, keeping the model "
+				    "trained so far.",
+				    this->get_name(), m_current_iteration);
+
+				this->end_training();
+			}
 			return m_complete;
 		}
 
@@ -122,6 +224,24 @@ namespace shogun
 		{
 		}
 
+		/** Whether parameters should be emitted to parameter observers in
+		 * the current iteration. Avoids building observed values when no
+		 * observer is attached, and thins them out otherwise.
+		 */
+		bool observes_iteration() const
+		{
+			return this->get_num_subscriptions() > 0 &&
+			       m_current_iteration % m_observation_interval == 0;
+		}
+
+		/** @return score of the current model on the validation data */
+		float64_t validation_score()
+		{
+			auto predictions = this->apply(m_validation_features);
+			return m_validation_evaluation->evaluate(
+			    predictions, m_validation_labels);
+		}
+
 		/** Stores features to continue training */
 		std::shared_ptr<Features> m_continue_features;
 		/** Maximum Iterations */
@@ -130,6 +250,17 @@ namespace shogun
 		int32_t m_current_iteration;
 		/** Completion status */
 		bool m_complete;
+		/** Emit observed parameters every m_observation_interval-th
+		 * iteration */
+		int32_t m_observation_interval;
+		/** Convergence monitor */
+		std::shared_ptr<ConvergenceMonitor> m_monitor;
+		/** Validation features */
+		std::shared_ptr<Features> m_validation_features;
+		/** Validation labels */
+		std::shared_ptr<Labels> m_validation_labels;
+		/** Validation criterion */
+		std::shared_ptr<Evaluation> m_validation_evaluation;
 	};
 }
 #endif
@@ -7,14 +7,26 @@
  */
 
 #include <rxcpp/rx-lite.hpp>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/CustomKernel.h>
+#include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/labels/RegressionLabels.h>
+#include <shogun/lib/FlatHashMap.h>
+#include <shogun/lib/Hash.h>
+#include <shogun/lib/SmallVector.h>
 #include <shogun/machine/KernelMachine.h>
+#include <shogun/mathematics/eigen3.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <utility>
+#include <vector>
 
 #ifdef HAVE_OPENMP
 #include <omp.h>
@@ -206,6 +218,53 @@ bool KernelMachine::create_new_model(int32_t num)
         return true;
 }
 
+bool KernelMachine::train(
+	std::shared_ptr<Features> data,
+	const std::shared_ptr<KernelMachine>& previous)
+{
+	require(previous, "No previous machine provided.");
+	require(m_labels, "No labels given.");
+
+	const int32_t num_vectors=m_labels->get_num_labels();
+	auto svs=previous->get_support_vectors();
+	auto alphas=previous->get_alphas();
+
+	std::vector<int32_t> kept;
+	for (int32_t i=0; i<svs.vlen; i++)
+	{
+		if (svs[i]>=0 && svs[i]<num_vectors)
+			kept.push_back(i);
+	}
+	if (kept.size()<(size_t) svs.vlen)
+	{
+		io::info("Dropping {} support vectors beyond the training data",
+			svs.vlen-(int32_t) kept.size());
+	}
+
+	create_new_model(kept.size());
+	for (int32_t i=0; i<(int32_t) kept.size(); i++)
+	{
+		set_support_vector(i, svs[kept[i]]);
+		set_alpha(i, alphas[kept[i]]);
+	}
+	set_bias(previous->get_bias());
+
+	m_warm_start=true;
+	bool result=false;
+	try
+	{
+		result=train(std::move(data));
+	}
+	catch (...)
+	{
+		m_warm_start=false;
+		throw;
+	}
+	m_warm_start=false;
+
+	return result;
+}
+
 bool KernelMachine::init_kernel_optimization()
 {
 	int32_t num_sv=get_num_support_vectors();
@@ -249,6 +308,48 @@ std::shared_ptr<BinaryLabels> KernelMachine::apply_binary(std::shared_ptr<Featur
 	return std::make_shared<BinaryLabels>(outputs);
 }
 
+std::shared_ptr<Labels> KernelMachine::predict(
+	const std::shared_ptr<Features>& data) const
+{
+	require(kernel, "{}::predict(): No kernel assigned!", get_name());
+	require(data, "{}::predict(): No features provided!", get_name());
+	auto lhs=kernel->get_lhs();
+	require(lhs && lhs->get_num_vectors(),
+		"{}::predict(): No vectors on left hand side", get_name());
+
+	// the kernel of the machine keeps its features, the test data go to a
+	// scratch copy that shares the storage of the feature vectors
+	auto scratch=make_clone(kernel, ParameterProperties::ALL, true);
+	scratch->init(lhs, data);
+
+	const int32_t num_vectors=data->get_num_vectors();
+	const int32_t num_svs=m_svs.vlen;
+	SGMatrix<float64_t> alphas(m_alpha.vector, num_svs, 1, false);
+	SGVector<index_t> sv_idx(m_svs.vector, num_svs, false);
+	SGVector<index_t> vec_idx(num_vectors);
+	vec_idx.range_fill();
+
+	SGVector<float64_t> outputs(num_vectors);
+	outputs.set_const(m_bias);
+	if (num_svs>0 && num_vectors>0)
+	{
+		auto scores=scratch->compute_weighted_outputs(sv_idx, alphas, vec_idx);
+		for (int32_t i=0; i<num_vectors; i++)
+			outputs[i]+=scores[i];
+	}
+
+	switch (get_machine_problem_type())
+	{
+		case PT_BINARY:
+			return std::make_shared<BinaryLabels>(outputs);
+		case PT_REGRESSION:
+			return std::make_shared<RegressionLabels>(outputs);
+		default:
+			error("{} does not support predict()", get_name());
+	}
+	return nullptr;
+}
+
 SGVector<float64_t> KernelMachine::apply_get_outputs(const std::shared_ptr<Features>& data)
 {
 	SG_TRACE("entering {}::apply_get_outputs({} at {})",
@@ -327,7 +428,8 @@ SGVector<float64_t> KernelMachine::apply_get_outputs(const std::shared_ptr<Featu
 				output[i] = get_bias() + output[i];
 
 		}
-		else
+		else if (kernel->has_property(KP_LINADD) &&
+		         kernel->get_is_initialized())
 		{
 			auto pb = SG_PROGRESS(range(num_vectors));
 			int32_t num_threads;
@@ -358,21 +460,58 @@ SGVector<float64_t> KernelMachine::apply_get_outputs(const std::shared_ptr<Featu
 					COMPUTATION_CONTROLLERS
 					pb.print_progress();
 
-					ASSERT(kernel)
-					if (kernel->has_property(KP_LINADD) &&
-					    (kernel->get_is_initialized()))
-					{
-						float64_t score = kernel->compute_optimized(vec);
-						output[vec] = score + get_bias();
-					}
-					else
+					float64_t score = kernel->compute_optimized(vec);
+					output[vec] = score + get_bias();
+				}
+			}
+			pb.complete();
+		}
+		else
+		{
+			// kernel values are computed block-wise between the support
+			// vectors and chunks of the test vectors
+			const int32_t chunk_size = 128;
+			const int32_t num_svs = get_num_support_vectors();
+			SGMatrix<float64_t> alphas(m_alpha.vector, num_svs, 1, false);
+			SGVector<index_t> sv_idx(m_svs.vector, num_svs, false);
+
+			auto pb = SG_PROGRESS(range(num_vectors));
+			int32_t num_threads;
+			int64_t step;
+#pragma omp parallel shared(num_threads, step)
+			{
+
+#ifdef HAVE_OPENMP
+#pragma omp single
+				{
+					num_threads = omp_get_num_threads();
+					step = num_vectors / num_threads;
+					num_threads--;
+				}
+				int32_t thread_num = omp_get_thread_num();
+#else
+				num_threads = 0;
+				step = num_vectors;
+				int32_t thread_num = 0;
+#endif
+				int32_t start = thread_num * step;
+				int32_t end = (thread_num == num_threads)
+				                  ? num_vectors
+				                  : (thread_num + 1) * step;
+
+				for (int32_t vec = start; vec < end; vec += chunk_size)
+				{
+					COMPUTATION_CONTROLLERS
+
+					SGVector<index_t> vec_idx(std::min(chunk_size, end - vec));
+					vec_idx.range_fill(vec);
+					auto scores =
+					    kernel->compute_weighted_outputs(sv_idx, alphas, vec_idx);
+
+					for (index_t i = 0; i < vec_idx.vlen; i++)
 					{
-						float64_t score = 0;
-						for (int32_t i = 0; i < get_num_support_vectors(); i++)
-							score +=
-							    kernel->kernel(get_support_vector(i), vec) *
-							    get_alpha(i);
-						output[vec] = score + get_bias();
+						pb.print_progress();
+						output[vec + i] = scores[i] + get_bias();
 					}
 				}
 			}
@@ -408,6 +547,294 @@ void KernelMachine::store_model_features()
 	m_svs.range_fill();
 }
 
+namespace
+{
+	/** set the support vectors and alphas of a compacted model, the
+	 * linadd optimization of the kernel was built for the old ones
+	 */
+	void set_compacted_model(
+		KernelMachine& machine, const std::vector<int32_t>& svs,
+		const std::vector<float64_t>& alphas)
+	{
+		auto kernel=machine.get_kernel();
+		if (kernel->get_is_initialized())
+			kernel->delete_optimization();
+
+		machine.set_support_vectors(SGVector<int32_t>(svs.begin(), svs.end()));
+		machine.set_alphas(SGVector<float64_t>(alphas.begin(), alphas.end()));
+	}
+} // namespace
+
+int32_t KernelMachine::merge_support_vectors()
+{
+	require(kernel, "{}::merge_support_vectors(): No kernel assigned!", get_name());
+	auto lhs=kernel->get_lhs();
+	std::shared_ptr<DenseFeatures<float64_t>> dense;
+	if (lhs && lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL)
+		dense=lhs->as<DenseFeatures<float64_t>>();
+
+	std::vector<int32_t> svs;
+	std::vector<float64_t> alphas;
+	FlatHashMap<int32_t, int32_t> slot_of_index;
+	FlatHashMap<uint32_t, SmallVector<int32_t, 2>> slots_of_hash;
+	for (index_t j=0; j<m_svs.vlen; j++)
+	{
+		const int32_t idx=m_svs[j];
+		auto found=slot_of_index.find(idx);
+		if (found!=slot_of_index.end())
+		{
+			alphas[found->second]+=m_alpha[j];
+			continue;
+		}
+
+		int32_t slot=-1;
+		if (dense)
+		{
+			auto vec=dense->get_feature_vector(idx);
+			const uint32_t hash=Hash::MurmurHash3(
+				(uint8_t*) vec.vector, vec.vlen*sizeof(float64_t), 0);
+			auto& candidates=slots_of_hash[hash];
+			for (auto candidate : candidates)
+			{
+				auto other=dense->get_feature_vector(svs[candidate]);
+				if (std::equal(vec.begin(), vec.end(), other.begin()))
+				{
+					slot=candidate;
+					break;
+				}
+			}
+			if (slot<0)
+				candidates.push_back(svs.size());
+		}
+
+		if (slot<0)
+		{
+			slot=svs.size();
+			svs.push_back(idx);
+			alphas.push_back(0);
+		}
+		slot_of_index.emplace(idx, slot);
+		alphas[slot]+=m_alpha[j];
+	}
+
+	std::vector<int32_t> merged_svs;
+	std::vector<float64_t> merged_alphas;
+	for (size_t k=0; k<svs.size(); k++)
+	{
+		if (alphas[k]!=0)
+		{
+			merged_svs.push_back(svs[k]);
+			merged_alphas.push_back(alphas[k]);
+		}
+	}
+
+	const int32_t num_removed=m_svs.vlen-merged_svs.size();
+	set_compacted_model(*this, merged_svs, merged_alphas);
+	return num_removed;
+}
+
+float64_t KernelMachine::prune_support_vectors(float64_t max_error)
+{
+	require(kernel, "{}::prune_support_vectors(): No kernel assigned!", get_name());
+	require(max_error>=0, "{}::prune_support_vectors(): Maximum error ({}) "
+		"must not be negative", get_name(), max_error);
+	auto lhs=kernel->get_lhs();
+	require(lhs, "{}::prune_support_vectors(): No left hand side specified",
+		get_name());
+
+	// the kernel of the machine keeps its features, the norms of the
+	// support vectors are computed with a scratch copy
+	auto scratch=make_clone(kernel, ParameterProperties::ALL, true);
+	scratch->init(lhs, lhs);
+
+	const int32_t num_svs=m_svs.vlen;
+	std::vector<float64_t> bounds(num_svs);
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t j=0; j<num_svs; j++)
+	{
+		const float64_t norm=std::sqrt(
+			std::max(scratch->kernel(m_svs[j], m_svs[j]), 0.0));
+		bounds[j]=std::abs(m_alpha[j])*norm;
+	}
+
+	std::vector<int32_t> order(num_svs);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&bounds](int32_t a, int32_t b) {
+		return bounds[a]<bounds[b];
+	});
+
+	float64_t removed=0;
+	std::vector<bool> keep(num_svs, true);
+	for (auto j : order)
+	{
+		if (removed+bounds[j]>max_error)
+			break;
+		removed+=bounds[j];
+		keep[j]=false;
+	}
+
+	std::vector<int32_t> svs;
+	std::vector<float64_t> alphas;
+	for (int32_t j=0; j<num_svs; j++)
+	{
+		if (keep[j])
+		{
+			svs.push_back(m_svs[j]);
+			alphas.push_back(m_alpha[j]);
+		}
+	}
+	set_compacted_model(*this, svs, alphas);
+	return removed;
+}
+
+float64_t KernelMachine::reduce_support_vectors(
+	int32_t num_vectors, int32_t max_iterations)
+{
+	require(kernel && kernel->get_kernel_type()==K_GAUSSIAN,
+		"{}::reduce_support_vectors(): Only the Gaussian kernel is supported",
+		get_name());
+	require(std::dynamic_pointer_cast<IdentityKernelNormalizer>(kernel->get_normalizer()),
+		"{}::reduce_support_vectors(): Kernel normalizers are not supported",
+		get_name());
+	auto lhs=kernel->get_lhs();
+	require(lhs && lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL,
+		"{}::reduce_support_vectors(): Dense float64 features are required",
+		get_name());
+	require(num_vectors>0, "{}::reduce_support_vectors(): Number of vectors "
+		"({}) must be positive", get_name(), num_vectors);
+	require(max_iterations>0, "{}::reduce_support_vectors(): Number of "
+		"iterations ({}) must be positive", get_name(), max_iterations);
+
+	const int32_t num_svs=m_svs.vlen;
+	if (num_vectors>=num_svs)
+		return 0;
+
+	auto dense=lhs->as<DenseFeatures<float64_t>>();
+	const int32_t dim=dense->get_num_features();
+	const float64_t width=kernel->as<GaussianKernel>()->get_width();
+
+	Eigen::MatrixXd X(dim, num_svs);
+	for (int32_t j=0; j<num_svs; j++)
+	{
+		auto vec=dense->get_feature_vector(m_svs[j]);
+		X.col(j)=Eigen::Map<Eigen::VectorXd>(vec.vector, vec.vlen);
+	}
+	const Eigen::Map<Eigen::VectorXd> alpha(m_alpha.vector, num_svs);
+	const Eigen::VectorXd x_norms=X.colwise().squaredNorm().transpose();
+
+	// Gaussian kernel between the columns of points and z
+	auto kernel_column=[width](
+		const Eigen::Ref<const Eigen::MatrixXd>& points,
+		const Eigen::Ref<const Eigen::VectorXd>& norms,
+		const Eigen::VectorXd& z) -> Eigen::VectorXd {
+		const Eigen::ArrayXd sq_dist=
+			(norms.array()+z.squaredNorm()-2.0*(points.transpose()*z).array()).max(0.0);
+		return (-sq_dist/width).exp().matrix();
+	};
+
+	// outputs of the expansion on the support vectors, f_sv=K_xx alpha,
+	// computed in blocks of support vectors
+	const int32_t block_size=256;
+	const int32_t num_blocks=(num_svs+block_size-1)/block_size;
+	Eigen::VectorXd f_sv(num_svs);
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		const int32_t begin=b*block_size;
+		const int32_t len=std::min(block_size, num_svs-begin);
+		Eigen::ArrayXXd sq_dist=-2.0*(X.transpose()*X.middleCols(begin, len)).array();
+		sq_dist.colwise()+=x_norms.array();
+		sq_dist.rowwise()+=x_norms.segment(begin, len).array().transpose();
+		const Eigen::MatrixXd block=(-sq_dist.max(0.0)/width).exp().matrix();
+		f_sv.segment(begin, len)=block.transpose()*alpha;
+	}
+	const float64_t psi_norm2=alpha.dot(f_sv);
+
+	Eigen::MatrixXd Z(dim, num_vectors);
+	Eigen::VectorXd z_norms(num_vectors);
+	Eigen::MatrixXd K_zx(num_vectors, num_svs);
+	Eigen::MatrixXd K_zz(num_vectors, num_vectors);
+	Eigen::VectorXd beta;
+	std::vector<bool> tried(num_svs, false);
+	for (int32_t r=0; r<num_vectors; r++)
+	{
+		// the remaining difference of the expansions has the coefficients
+		// alpha on X and -beta on Z, the search starts at the support
+		// vector where it is largest
+		Eigen::VectorXd residual=f_sv;
+		if (r>0)
+			residual-=K_zx.topRows(r).transpose()*beta;
+		int32_t start=-1;
+		for (int32_t j=0; j<num_svs; j++)
+		{
+			if (!tried[j] && (start<0 || std::abs(residual[j])>std::abs(residual[start])))
+				start=j;
+		}
+		tried[start]=true;
+
+		// fixed point of the projection of the difference onto Phi(z)
+		auto projection_weights=[&](const Eigen::VectorXd& z,
+			Eigen::VectorXd& wx, Eigen::VectorXd& wz) {
+			wx=alpha.cwiseProduct(kernel_column(X, x_norms, z));
+			wz=Eigen::VectorXd::Zero(r);
+			if (r>0)
+				wz=-beta.cwiseProduct(kernel_column(Z.leftCols(r), z_norms.head(r), z));
+			return wx.sum()+wz.sum();
+		};
+
+		Eigen::VectorXd z=X.col(start);
+		Eigen::VectorXd wx, wz;
+		for (int32_t it=0; it<max_iterations; it++)
+		{
+			const float64_t projection=projection_weights(z, wx, wz);
+			if (std::abs(projection)<1e-12)
+				break;
+
+			Eigen::VectorXd next=X*wx;
+			if (r>0)
+				next+=Z.leftCols(r)*wz;
+			next/=projection;
+
+			const float64_t change=(next-z).squaredNorm();
+			z=next;
+			if (change<1e-12*width)
+				break;
+		}
+		// the iteration can run off when the difference changes its sign,
+		// then the start is kept
+		if (std::abs(projection_weights(z, wx, wz))<std::abs(residual[start]))
+			z=X.col(start);
+
+		Z.col(r)=z;
+		z_norms[r]=z.squaredNorm();
+		K_zx.row(r)=kernel_column(X, x_norms, z).transpose();
+		const Eigen::VectorXd k_z=kernel_column(Z.leftCols(r+1), z_norms.head(r+1), z);
+		K_zz.block(0, r, r+1, 1)=k_z;
+		K_zz.block(r, 0, 1, r+1)=k_z.transpose();
+
+		// least squares weights of all vectors, a small ridge keeps
+		// coinciding vectors solvable
+		Eigen::MatrixXd gram=K_zz.topLeftCorner(r+1, r+1);
+		gram.diagonal().array()+=1e-10;
+		beta=gram.ldlt().solve(K_zx.topRows(r+1)*alpha);
+	}
+
+	const float64_t error2=psi_norm2-2.0*beta.dot(K_zx*alpha)+beta.dot(K_zz*beta);
+	const float64_t relative_error=psi_norm2>0
+		? std::sqrt(std::max(error2, 0.0)/psi_norm2) : 0.0;
+
+	SGMatrix<float64_t> reduced(dim, num_vectors);
+	Eigen::Map<Eigen::MatrixXd>(reduced.matrix, dim, num_vectors)=Z;
+	auto reduced_features=std::make_shared<DenseFeatures<float64_t>>(reduced);
+	auto rhs=kernel->get_rhs();
+	kernel->init(reduced_features, rhs ? rhs : reduced_features);
+
+	std::vector<int32_t> svs(num_vectors);
+	std::iota(svs.begin(), svs.end(), 0);
+	set_compacted_model(*this, svs, std::vector<float64_t>(beta.data(), beta.data()+num_vectors));
+	return relative_error;
+}
+
 float64_t KernelMachine::apply_one(int32_t num)
 {
 	ASSERT(kernel)
@@ -434,6 +861,7 @@ void KernelMachine::init()
 	use_batch_computation=true;
 	use_linadd=true;
 	use_bias=true;
+	m_warm_start=false;
 
 	SG_ADD(&kernel, "kernel", "", ParameterProperties::HYPER);
 	SG_ADD(&use_batch_computation, "use_batch_computation",
@@ -198,6 +198,27 @@ class KernelMachine : public Machine
 		 */
 		bool init_kernel_optimization();
 
+		using Machine::train;
+
+		/** train the machine starting from the solution of a previous
+		 * machine, e.g. to retrain on the previous data plus a few new
+		 * vectors
+		 *
+		 * The support vectors of the previous machine have to index the
+		 * new training data, as is the case when new vectors are appended
+		 * to the previous training data. Support vectors beyond the
+		 * training data are dropped. Solvers that support warm starts seed
+		 * their dual variables (and so their gradient) with the alphas of
+		 * the previous machine, all others train from scratch.
+		 *
+		 * @param data training data
+		 * @param previous previously trained machine
+		 * @return whether training was successful
+		 */
+		bool train(
+			std::shared_ptr<Features> data,
+			const std::shared_ptr<KernelMachine>& previous);
+
 		/** apply kernel machine to data
 		 * for regression task
 		 *
@@ -214,6 +235,20 @@ class KernelMachine : public Machine
 		 */
 		std::shared_ptr<BinaryLabels> apply_binary(std::shared_ptr<Features> data=NULL) override;
 
+		/** apply kernel machine to data without modifying it, see
+		 * Machine::predict()
+		 *
+		 * The kernel values are computed block-wise with a copy of the
+		 * kernel that shares the storage of the features, so kernels whose
+		 * init() modifies the features themselves are not safe to use
+		 * concurrently.
+		 *
+		 * @param data (test)data to be classified
+		 * @return binary or regression labels
+		 */
+		std::shared_ptr<Labels> predict(
+			const std::shared_ptr<Features>& data) const override;
+
 		/** apply kernel machine to one example
 		 *
 		 * @param num which example to apply to
@@ -229,6 +264,56 @@ class KernelMachine : public Machine
 		 */
 		virtual void store_model_features();
 
+		/** Merge support vectors with the same index, and with identical
+		 * feature vectors if the left hand side of the kernel are dense
+		 * float64 features, by adding their alphas. Support vectors whose
+		 * alphas add up to zero are removed. The outputs do not change.
+		 *
+		 * @return number of removed support vectors
+		 */
+		int32_t merge_support_vectors();
+
+		/** Remove the support vectors that contribute least to the
+		 * outputs, with a bound on the change of the outputs. The
+		 * contribution of support vector \f$x_j\f$ to the output of any
+		 * \f$x\f$ is at most \f$|\alpha_j| \sqrt{k(x_j,x_j)}
+		 * \sqrt{k(x,x)}\f$, the support vectors with the smallest bounds
+		 * are removed as long as the sum of their bounds is at most
+		 * max_error.
+		 *
+		 * @param max_error bound on \f$|f(x)-f'(x)|/\sqrt{k(x,x)}\f$,
+		 * i.e. on the change of the outputs for normalized kernels such
+		 * as the Gaussian kernel
+		 * @return the bound of the removed support vectors, at most
+		 * max_error
+		 */
+		float64_t prune_support_vectors(float64_t max_error);
+
+		/** Replace the support vectors by a smaller reduced set of
+		 * synthetic vectors, for the Gaussian kernel on dense float64
+		 * features (Schoelkopf et al., "Input space versus feature space
+		 * in kernel-based methods", IEEE TNN 1999).
+		 *
+		 * The vectors are added greedily. Every new vector maximizes the
+		 * projection of the remaining difference of the expansions in
+		 * feature space by a fixed point iteration started at the
+		 * support vector where the remaining difference of the outputs is
+		 * largest, then all weights are fit by least squares. The support
+		 * vectors become the left hand side of the kernel.
+		 *
+		 * The returned error is measured exactly in feature space and
+		 * bounds the change of every output:
+		 * \f$|f(x)-f'(x)| \leq \|\Psi-\Psi'\|\f$. Computing it takes
+		 * \f$O(m^2 d)\f$ time for m support vectors of dimension d.
+		 *
+		 * @param num_vectors number of vectors of the reduced set
+		 * @param max_iterations iterations of the fixed point search
+		 * @return relative error \f$\|\Psi-\Psi'\|/\|\Psi\|\f$ of the
+		 * expansion \f$\Psi=\sum_j \alpha_j \Phi(x_j)\f$
+		 */
+		float64_t reduce_support_vectors(
+			int32_t num_vectors, int32_t max_iterations=100);
+
 	protected:
 
 		/** apply get outputs
@@ -264,6 +349,11 @@ class KernelMachine : public Machine
 
 		/** array of ``support vectors'' (indices of feature objects) */
 		SGVector<int32_t> m_svs;
+
+		/** whether the current training starts from the alphas and
+		 * support vectors of the model
+		 */
+		bool m_warm_start;
 };
 }
 #endif /* _KERNEL_MACHINE_H__ */
@@ -34,6 +34,7 @@ LinearMachine::LinearMachine(const std::shared_ptr<LinearMachine>& machine) : Ma
 void LinearMachine::init()
 {
 	bias = 0;
+	m_warm_start = false;
 	features = NULL;
 
 	SG_ADD(&m_w, "w", "Parameter vector w.", ParameterProperties::MODEL);
@@ -48,6 +49,31 @@ LinearMachine::~LinearMachine()
 
 }
 
+bool LinearMachine::train(
+	std::shared_ptr<Features> data,
+	const std::shared_ptr<LinearMachine>& previous)
+{
+	require(previous, "No previous machine provided.");
+
+	set_w(previous->get_w().clone());
+	set_bias(previous->get_bias());
+
+	m_warm_start = true;
+	bool result = false;
+	try
+	{
+		result = train(std::move(data));
+	}
+	catch (...)
+	{
+		m_warm_start = false;
+		throw;
+	}
+	m_warm_start = false;
+
+	return result;
+}
+
 float64_t LinearMachine::apply_one(int32_t vec_idx)
 {
 	return features->dot(vec_idx, m_w) + bias;
@@ -78,14 +104,40 @@ SGVector<float64_t> LinearMachine::apply_get_outputs(std::shared_ptr<Features> d
 	if (!features)
 		return SGVector<float64_t>();
 
-	int32_t num=features->get_num_vectors();
+	return compute_outputs(features);
+}
+
+SGVector<float64_t> LinearMachine::compute_outputs(
+	const std::shared_ptr<DotFeatures>& data) const
+{
+	int32_t num=data->get_num_vectors();
 	ASSERT(num>0)
-	ASSERT(m_w.vlen==features->get_dim_feature_space())
+	ASSERT(m_w.vlen==data->get_dim_feature_space())
 	SGVector<float64_t> out(num);
-	features->dense_dot_range(out.vector, 0, num, NULL, m_w.vector, m_w.vlen, bias);
+	data->dense_dot_range(out.vector, 0, num, NULL, m_w.vector, m_w.vlen, bias);
 	return out;
 }
 
+std::shared_ptr<Labels> LinearMachine::predict(
+	const std::shared_ptr<Features>& data) const
+{
+	require(data, "No features provided.");
+	require(data->has_property(FP_DOT),
+		"Specified features are not of type CDotFeatures");
+
+	auto outputs=compute_outputs(std::static_pointer_cast<DotFeatures>(data));
+	switch (get_machine_problem_type())
+	{
+		case PT_BINARY:
+			return std::make_shared<BinaryLabels>(outputs);
+		case PT_REGRESSION:
+			return std::make_shared<RegressionLabels>(outputs);
+		default:
+			error("{} does not support predict()", get_name());
+	}
+	return nullptr;
+}
+
 SGVector<float64_t> LinearMachine::get_w() const
 {
 	return m_w;
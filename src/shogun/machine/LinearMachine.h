@@ -101,6 +101,23 @@ class LinearMachine : public Machine
 		 */
 		virtual void set_features(std::shared_ptr<DotFeatures> feat);
 
+		using Machine::train;
+
+		/** train the machine starting from the solution of a previous
+		 * machine, e.g. to retrain on the previous data plus a few new
+		 * vectors
+		 *
+		 * Solvers that support warm starts start from the w and bias of
+		 * the previous machine, all others train from scratch.
+		 *
+		 * @param data training data
+		 * @param previous previously trained machine of the same dimension
+		 * @return whether training was successful
+		 */
+		bool train(
+			std::shared_ptr<Features> data,
+			const std::shared_ptr<LinearMachine>& previous);
+
 		/** apply linear machine to data
 		 * for binary classification problem
 		 *
@@ -117,6 +134,15 @@ class LinearMachine : public Machine
 		 */
 		std::shared_ptr<RegressionLabels> apply_regression(std::shared_ptr<Features> data=NULL) override;
 
+		/** apply linear machine to data without modifying it, the outputs
+		 * are computed on data directly, see Machine::predict()
+		 *
+		 * @param data (test)data to be classified
+		 * @return binary or regression labels
+		 */
+		std::shared_ptr<Labels> predict(
+			const std::shared_ptr<Features>& data) const override;
+
 		/** applies to one vector */
 		float64_t apply_one(int32_t vec_idx) override;
 
@@ -142,6 +168,14 @@ class LinearMachine : public Machine
 		 */
 		virtual SGVector<float64_t> apply_get_outputs(std::shared_ptr<Features> data);
 
+		/** compute outputs \f$w^\top x+b\f$
+		 *
+		 * @param data features to compute outputs on
+		 * @return outputs
+		 */
+		SGVector<float64_t> compute_outputs(
+			const std::shared_ptr<DotFeatures>& data) const;
+
 	private:
 
 		void init();
@@ -153,6 +187,9 @@ class LinearMachine : public Machine
 		/** bias */
 		float64_t bias;
 
+		/** whether the current training starts from w and bias */
+		bool m_warm_start;
+
 		/** features */
 		std::shared_ptr<DotFeatures> features;
 };
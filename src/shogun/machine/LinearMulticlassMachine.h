@@ -134,6 +134,33 @@ class LinearMulticlassMachine : public MulticlassMachine
 			return m_features->get_num_vectors();
 		}
 
+		/** linear machines only read the shared features */
+		bool supports_parallel_submachines() const override
+		{
+			return true;
+		}
+
+		/** clone the base machine without its features, one-vs-one
+		 * sub-problems get a copy of their vectors */
+		std::shared_ptr<Machine> get_machine_for_subproblem(
+			SGVector<index_t> subset, std::shared_ptr<BinaryLabels> labels) override
+		{
+			auto linear_machine=m_machine->as<LinearMachine>();
+			auto features=linear_machine->get_features();
+			linear_machine->set_features(NULL);
+			auto machine=m_machine->clone()->as<LinearMachine>();
+			linear_machine->set_features(features);
+
+			machine->set_labels(labels);
+			if (subset.vlen)
+				machine->set_features(
+					m_features->copy_subset(subset)->as<DotFeatures>());
+			else
+				machine->set_features(m_features);
+
+			return machine;
+		}
+
 		/** set subset to the features of the machine, deletes old one
 		 *
 		 * @param subset subset instance to set
@@ -58,11 +58,11 @@ std::shared_ptr<StructuredLabels> LinearStructuredOutputMachine::apply_structure
 	std::shared_ptr<StructuredLabels> out;
 	out = m_model->structured_labels_factory(num_input_vectors);
 
-	for ( int32_t i = 0 ; i < num_input_vectors ; ++i )
-	{
-		auto result = m_model->argmax(m_w, i, false);
-		out->add_label(result->argmax);
-	}
+	m_model->for_each_argmax(m_w, false,
+		[&out](int32_t, const std::shared_ptr<ResultSet>& result)
+		{
+			out->add_label(result->argmax);
+		});
 
 	io::info("{}", out->to_string());
 
@@ -8,6 +8,7 @@
 
 #include <rxcpp/rx-lite.hpp>
 #include <shogun/lib/Signal.h>
+#include <shogun/machine/AsyncTraining.h>
 #include <shogun/machine/Machine.h>
 
 using namespace shogun;
@@ -42,6 +43,7 @@ bool Machine::train(std::shared_ptr<Features> data)
 	}
 
 	auto sub = connect_to_signal_handler();
+	ComputationScope scope(this);
 	bool result = false;
 
 	if (support_feature_dispatching())
@@ -71,6 +73,12 @@ bool Machine::train(std::shared_ptr<Features> data)
 	return result;
 }
 
+std::shared_ptr<AsyncTraining>
+Machine::train_async(std::shared_ptr<Features> data)
+{
+	return std::make_shared<AsyncTraining>(as<Machine>(), std::move(data));
+}
+
 void Machine::set_labels(std::shared_ptr<Labels> lab)
 {
     if (lab != NULL)
@@ -147,6 +155,14 @@ std::shared_ptr<Labels> Machine::apply(std::shared_ptr<Features> data)
 	return result;
 }
 
+std::shared_ptr<Labels> Machine::predict(
+	const std::shared_ptr<Features>& data) const
+{
+	error("{} does not support predict(), use apply() on a clone per thread "
+		"instead", get_name());
+	return nullptr;
+}
+
 std::shared_ptr<BinaryLabels> Machine::apply_binary(std::shared_ptr<Features> data)
 {
 	error("This machine does not support apply_binary()");
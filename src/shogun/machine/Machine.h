@@ -25,6 +25,7 @@
 namespace shogun
 {
 
+class AsyncTraining;
 class Features;
 class Labels;
 
@@ -154,6 +155,18 @@ class Machine : public StoppableSGObject
 		 */
 		virtual bool train(std::shared_ptr<Features> data=NULL);
 
+		/** train machine on a separate thread
+		 *
+		 * Returns immediately, the returned handle is polled, waited for
+		 * or cancelled, see AsyncTraining. The machine must not be used
+		 * otherwise until training has finished.
+		 *
+		 * @param data training data, see train()
+		 * @return handle of the running training
+		 */
+		std::shared_ptr<AsyncTraining> train_async(
+		    std::shared_ptr<Features> data=NULL);
+
 		/** apply machine to data
 		 * if data is not specified apply to the current features
 		 *
@@ -173,6 +186,23 @@ class Machine : public StoppableSGObject
 		/** apply machine to data in means of latent problem */
 		virtual std::shared_ptr<LatentLabels> apply_latent(std::shared_ptr<Features> data=NULL);
 
+		/** apply the trained machine to data without modifying it
+		 *
+		 * Unlike apply(), which sets the data on the kernel or distance of
+		 * the machine and keeps them there, the data only go to per call
+		 * scratch state. Concurrent calls on one trained machine are
+		 * therefore safe, as long as the machine is not modified or
+		 * trained meanwhile, so that one model can serve requests from
+		 * many threads without a clone per thread.
+		 *
+		 * Not all machines support this, the default throws.
+		 *
+		 * @param data (test)data to be classified
+		 * @return labels of the problem type of the machine
+		 */
+		virtual std::shared_ptr<Labels> predict(
+			const std::shared_ptr<Features>& data) const;
+
 		/** set labels
 		 *
 		 * @param lab labels
@@ -0,0 +1,128 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _MACHINE_BENCHMARK_H_
+#define _MACHINE_BENCHMARK_H_
+
+#include <benchmark/benchmark.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/range.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+namespace shogun
+{
+
+/** Fixture for end-to-end benchmarks of machines.
+ *
+ * state.range(0) is the number of training (and test) vectors and
+ * state.range(1) the number of threads. The data are kNumClasses gaussian
+ * blobs in kNumDims dimensions, with multiclass labels, binary labels that
+ * join every other blob (so the classes are not linearly separable) and
+ * regression labels that are a noisy non-linear function of the inputs.
+ * Test data are drawn from the same distribution.
+ */
+class MachineFixture : public benchmark::Fixture
+{
+public:
+	static constexpr index_t kNumDims = 16;
+	static constexpr index_t kNumClasses = 4;
+
+	void SetUp(const ::benchmark::State& st) override
+	{
+		m_num_threads = env()->get_num_threads();
+		env()->set_num_threads(st.range(1));
+
+		num_vecs = st.range(0);
+		std::mt19937_64 prng(17);
+		generate(prng, features_train, multiclass_labels, binary_labels,
+			regression_labels);
+		std::shared_ptr<MulticlassLabels> unused_multiclass;
+		std::shared_ptr<BinaryLabels> unused_binary;
+		std::shared_ptr<RegressionLabels> unused_regression;
+		generate(prng, features_test, unused_multiclass, unused_binary,
+			unused_regression);
+	}
+
+	void TearDown(const ::benchmark::State&) override
+	{
+		env()->set_num_threads(m_num_threads);
+	}
+
+	/** reports the number of threads and the number of vectors that were
+	 * processed per second */
+	void set_counters(benchmark::State& state) const
+	{
+		state.SetItemsProcessed(state.iterations() * num_vecs);
+		state.counters["threads"] = env()->get_num_threads();
+	}
+
+	index_t num_vecs;
+	std::shared_ptr<DenseFeatures<float64_t>> features_train;
+	std::shared_ptr<DenseFeatures<float64_t>> features_test;
+	std::shared_ptr<MulticlassLabels> multiclass_labels;
+	std::shared_ptr<BinaryLabels> binary_labels;
+	std::shared_ptr<RegressionLabels> regression_labels;
+
+private:
+	template <typename PRNG>
+	void generate(
+		PRNG& prng, std::shared_ptr<DenseFeatures<float64_t>>& features,
+		std::shared_ptr<MulticlassLabels>& mc,
+		std::shared_ptr<BinaryLabels>& bin,
+		std::shared_ptr<RegressionLabels>& reg) const
+	{
+		NormalDistribution<float64_t> normal;
+		SGMatrix<float64_t> mat(kNumDims, num_vecs);
+		SGVector<float64_t> mc_labels(num_vecs);
+		SGVector<float64_t> bin_labels(num_vecs);
+		SGVector<float64_t> reg_labels(num_vecs);
+
+		for (auto i : range(num_vecs))
+		{
+			const auto c = i % kNumClasses;
+			float64_t sum = 0;
+			for (auto j : range(kNumDims))
+			{
+				mat(j, i) = normal(prng) + (j % kNumClasses == c ? 2.0 : 0.0);
+				sum += mat(j, i);
+			}
+			mc_labels[i] = c;
+			bin_labels[i] = c % 2 ? 1 : -1;
+			reg_labels[i] = std::sin(sum) + 0.1 * normal(prng);
+		}
+
+		features = std::make_shared<DenseFeatures<float64_t>>(mat);
+		mc = std::make_shared<MulticlassLabels>(mc_labels);
+		bin = std::make_shared<BinaryLabels>(bin_labels);
+		reg = std::make_shared<RegressionLabels>(reg_labels);
+	}
+
+	int32_t m_num_threads;
+};
+
+/** registers a benchmark of MachineFixture for MIN_VECS to MAX_VECS vectors
+ * (in steps of 10x) and 1 to MAX_THREADS threads (in steps of 2x)
+ *
+ * Real time is measured, as CPU time adds up the time of all threads.
+ */
+#define MACHINE_BENCHMARK_ARGS(WHAT, MIN_VECS, MAX_VECS, MAX_THREADS)          \
+	WHAT->ArgNames({"vectors", "threads"})                                     \
+	    ->ArgsProduct(                                                         \
+	        {benchmark::CreateRange(MIN_VECS, MAX_VECS, 10),                   \
+	         benchmark::CreateRange(1, MAX_THREADS, 2)})                       \
+	    ->UseRealTime()                                                        \
+	    ->Unit(benchmark::kMillisecond)
+
+} // namespace shogun
+
+#endif /* _MACHINE_BENCHMARK_H_ */
@@ -6,6 +6,8 @@
  *          Evan Shelhamer, Shell Hu, Thoralf Klein, Viktor Gal
  */
 
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/Calibration.h>
 #include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/KernelMachine.h>
@@ -14,13 +16,17 @@
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/labels/MultilabelLabels.h>
 
+#include <algorithm>
+#include <exception>
+#include <numeric>
 #include <utility>
 
 using namespace shogun;
 
 MulticlassMachine::MulticlassMachine()
 : BaseMulticlassMachine(), m_multiclass_strategy(std::make_shared<MulticlassOneVsRestStrategy>()),
-	m_machine(NULL)
+	m_machine(NULL), m_confidence_storage(CONFIDENCES_FLOAT64),
+	m_confidence_top_k(0)
 {
 	register_parameters();
 }
@@ -28,7 +34,8 @@ MulticlassMachine::MulticlassMachine()
 MulticlassMachine::MulticlassMachine(
 		std::shared_ptr<MulticlassStrategy >strategy,
 		std::shared_ptr<Machine> machine, std::shared_ptr<Labels> labs)
-: BaseMulticlassMachine(), m_multiclass_strategy(std::move(strategy))
+: BaseMulticlassMachine(), m_multiclass_strategy(std::move(strategy)),
+	m_confidence_storage(CONFIDENCES_FLOAT64), m_confidence_top_k(0)
 {
 	set_labels(std::move(labs));
 
@@ -49,6 +56,26 @@ void MulticlassMachine::register_parameters()
 {
 	SG_ADD(&m_multiclass_strategy,"multiclass_strategy", "Multiclass strategy");
 	SG_ADD(&m_machine, "machine", "The base machine");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_confidence_storage, "confidence_storage",
+	    "Storage of the confidences of applied labels",
+	    ParameterProperties::NONE,
+	    SG_OPTIONS(CONFIDENCES_FLOAT64, CONFIDENCES_FLOAT32, CONFIDENCES_TOP_K));
+	SG_ADD(&m_confidence_top_k, "confidence_top_k",
+	    "Number of classes whose confidences are kept");
+	SG_ADD(&m_calibration, "calibration",
+	    "Calibration of the outputs of the sub-machines");
+}
+
+void MulticlassMachine::set_confidence_storage(
+		EConfidenceStorage storage, int32_t top_k)
+{
+	require(storage!=CONFIDENCES_TOP_K || top_k>0,
+			"{}::set_confidence_storage(): Number of classes to keep ({}) "
+			"must be positive", get_name(), top_k);
+
+	m_confidence_storage=storage;
+	m_confidence_top_k=top_k;
 }
 
 void MulticlassMachine::init_strategy()
@@ -94,11 +121,25 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 			error("num_machines = {}, did you train your machine?", num_machines);
 
 		auto result=std::make_shared<MulticlassLabels>(num_vectors);
+		result->set_confidence_storage(m_confidence_storage, m_confidence_top_k);
 
 		// if outputs are prob, only one confidence for each class
 		int32_t num_classes=m_multiclass_strategy->get_num_classes();
 		EProbHeuristicType heuris = get_prob_heuris();
 
+		if (m_calibration)
+		{
+			require(heuris==PROB_HEURIS_NONE &&
+					std::dynamic_pointer_cast<MulticlassOneVsRestStrategy>(
+						m_multiclass_strategy),
+					"{}::apply_multiclass(): Calibration needs a one-vs-rest "
+					"strategy without probability heuristic", get_name());
+			require(m_calibration->get_num_calibrated_classes()==num_machines,
+					"{}::apply_multiclass(): Calibration is fitted for {} "
+					"classes, there are {} sub-machines", get_name(),
+					m_calibration->get_num_calibrated_classes(), num_machines);
+		}
+
 		if (heuris!=PROB_HEURIS_NONE)
 			result->allocate_confidences_for(num_classes);
 		else
@@ -108,8 +149,12 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 		SGVector<float64_t> As(num_machines);
 		SGVector<float64_t> Bs(num_machines);
 
+		#pragma omp parallel for schedule(dynamic) \
+			if (supports_parallel_submachines()) \
+			num_threads(std::min(num_machines, env()->get_num_threads()))
 		for (int32_t i=0; i<num_machines; ++i)
 		{
+			env()->limit_nested_threads();
 			outputs[i] = get_submachine_outputs(i);
 
 			if (heuris==OVA_SOFTMAX)
@@ -123,22 +168,60 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 				outputs[i]->scores_to_probabilities(0,0);
 		}
 
-		SGVector<float64_t> output_for_i(num_machines);
-		SGVector<float64_t> r_output_for_i(num_machines);
-		if (heuris!=PROB_HEURIS_NONE)
-			r_output_for_i.resize_vector(num_classes);
-
-		for (int32_t i=0; i<num_vectors; i++)
+		if (m_calibration)
+		{
+			// calibrate the outputs of each vector as they are gathered
+			std::exception_ptr exception;
+			#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				try
+				{
+					SGVector<float64_t> probabilities(num_machines);
+					for (int32_t j=0; j<num_machines; j++)
+						probabilities[j] = outputs[j]->get_value(i);
+
+					m_calibration->calibrate_multiclass_outputs(probabilities);
+					result->set_label(i,
+						m_multiclass_strategy->decide_label(probabilities));
+					result->set_multiclass_confidences(i, probabilities);
+				}
+				catch (...)
+				{
+					#pragma omp critical
+					exception=std::current_exception();
+				}
+			}
+			if (exception)
+				std::rethrow_exception(exception);
+		}
+		else if (heuris==PROB_HEURIS_NONE)
 		{
+			// decide all labels in one batch of the strategy
+			SGMatrix<float64_t> all_outputs(num_machines, num_vectors);
 			for (int32_t j=0; j<num_machines; j++)
-				output_for_i[j] = outputs[j]->get_value(i);
+			{
+				for (int32_t i=0; i<num_vectors; i++)
+					all_outputs(j, i) = outputs[j]->get_value(i);
+			}
 
-			if (heuris==PROB_HEURIS_NONE)
+			SGVector<int32_t> labels = m_multiclass_strategy->decide_labels(all_outputs);
+			for (int32_t i=0; i<num_vectors; i++)
 			{
-				r_output_for_i = output_for_i;
+				result->set_label(i, labels[i]);
+				result->set_multiclass_confidences(i, all_outputs.get_column(i));
 			}
-			else
+		}
+		else
+		{
+			SGVector<float64_t> output_for_i(num_machines);
+			SGVector<float64_t> r_output_for_i(num_classes);
+
+			for (int32_t i=0; i<num_vectors; i++)
 			{
+				for (int32_t j=0; j<num_machines; j++)
+					output_for_i[j] = outputs[j]->get_value(i);
+
 				if (heuris==OVA_SOFTMAX)
 					m_multiclass_strategy->rescale_outputs(output_for_i,As,Bs);
 				else
@@ -150,11 +233,11 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 
 				SG_DEBUG("{}::apply_multiclass(): sum(r_output_for_i) = {}",
 					get_name(), SGVector<float64_t>::sum(r_output_for_i.vector,num_classes));
-			}
 
-			// use rescaled outputs for label decision
-			result->set_label(i, m_multiclass_strategy->decide_label(r_output_for_i));
-			result->set_multiclass_confidences(i, r_output_for_i);
+				// use rescaled outputs for label decision
+				result->set_label(i, m_multiclass_strategy->decide_label(r_output_for_i));
+				result->set_multiclass_confidences(i, r_output_for_i);
+			}
 		}
 		outputs.clear();
 
@@ -169,6 +252,38 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 	return return_labels;
 }
 
+void MulticlassMachine::apply_multiclass_blockwise(
+	std::shared_ptr<Features> data, int32_t block_size,
+	const std::function<void(index_t, std::shared_ptr<MulticlassLabels>)>& consume)
+{
+	require(data, "{}::apply_multiclass_blockwise(): No features provided",
+			get_name());
+	require(block_size>0, "{}::apply_multiclass_blockwise(): Block size ({}) "
+			"must be positive", get_name(), block_size);
+
+	int32_t num_vectors=data->get_num_vectors();
+	for (index_t start=0; start<num_vectors; start+=block_size)
+	{
+		SGVector<index_t> block(std::min(block_size, num_vectors-start));
+		block.range_fill(start);
+
+		data->add_subset(block);
+		std::shared_ptr<MulticlassLabels> labels;
+		try
+		{
+			labels=apply_multiclass(data);
+		}
+		catch (...)
+		{
+			data->remove_subset();
+			throw;
+		}
+		data->remove_subset();
+
+		consume(start, labels);
+	}
+}
+
 std::shared_ptr<MultilabelLabels> MulticlassMachine::apply_multilabel_output(std::shared_ptr<Features> data, int32_t n_outputs)
 {
 	std::shared_ptr<MultilabelLabels> return_labels=NULL;
@@ -192,8 +307,14 @@ std::shared_ptr<MultilabelLabels> MulticlassMachine::apply_multilabel_output(std
 		auto result=std::make_shared<MultilabelLabels>(num_vectors, n_outputs);
 		std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
 
+		#pragma omp parallel for schedule(dynamic) \
+			if (supports_parallel_submachines()) \
+			num_threads(std::min(num_machines, env()->get_num_threads()))
 		for (int32_t i=0; i < num_machines; ++i)
+		{
+			env()->limit_nested_threads();
 			outputs[i] = get_submachine_outputs(i);
+		}
 
 		SGVector<float64_t> output_for_i(num_machines);
 		for (int32_t i=0; i<num_vectors; i++)
@@ -231,6 +352,9 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 
 	m_multiclass_strategy->train_start(
 	    multiclass_labels(m_labels), train_labels);
+	if (env()->get_num_threads()>1 && supports_parallel_submachines())
+		train_submachines_parallel(train_labels);
+
 	while (m_multiclass_strategy->train_has_more())
 	{
 		SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
@@ -256,6 +380,70 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+void MulticlassMachine::train_submachines_parallel(
+	std::shared_ptr<BinaryLabels> train_labels)
+{
+	const int32_t num_threads=env()->get_num_threads();
+	// sub-problems are prepared in batches to bound the memory of the copies
+	const size_t batch_size=4*num_threads;
+
+	while (m_multiclass_strategy->train_has_more())
+	{
+		std::vector<std::shared_ptr<Machine>> machines;
+		std::vector<index_t> sizes;
+		while (machines.size()<batch_size &&
+			m_multiclass_strategy->train_has_more())
+		{
+			SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
+			std::shared_ptr<BinaryLabels> labels;
+			if (subset.vlen)
+			{
+				labels=std::make_shared<BinaryLabels>(subset.vlen);
+				for (index_t k=0; k<subset.vlen; k++)
+					labels->set_label(k, train_labels->get_label(subset[k]));
+			}
+			else
+				labels=std::make_shared<BinaryLabels>(
+					train_labels->get_labels().clone());
+
+			sizes.push_back(labels->get_num_labels());
+			machines.push_back(get_machine_for_subproblem(subset, labels));
+		}
+
+		/* largest sub-problems first, which balances the uneven sizes of
+		 * the one-vs-one pairs over the threads */
+		std::vector<index_t> order(machines.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(),
+			[&sizes](index_t a, index_t b) { return sizes[a]>sizes[b]; });
+
+		// the sub-machines are trained in the computation of this machine
+		// and stop with it
+		const auto computation=current_computation();
+		std::exception_ptr exception;
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+		for (index_t k=0; k<(index_t)order.size(); k++)
+		{
+			ComputationScope scope(computation);
+			try
+			{
+				env()->limit_nested_threads();
+				machines[order[k]]->train();
+			}
+			catch (...)
+			{
+				#pragma omp critical
+				exception=std::current_exception();
+			}
+		}
+		if (exception)
+			std::rethrow_exception(exception);
+
+		for (const auto& machine : machines)
+			m_machines.push_back(get_machine_from_trained(machine));
+	}
+}
+
 float64_t MulticlassMachine::apply_one(int32_t vec_idx)
 {
 	init_machines_for_apply(NULL);
@@ -11,14 +11,18 @@
 
 #include <shogun/lib/config.h>
 
+#include <shogun/labels/MulticlassLabels.h>
 #include <shogun/machine/BaseMulticlassMachine.h>
 #include <shogun/multiclass/MulticlassStrategy.h>
 
 #include <shogun/util/converters.h>
 
+#include <functional>
+
 namespace shogun
 {
 
+class Calibration;
 class Features;
 class Labels;
 class MulticlassLabels;
@@ -92,6 +96,55 @@ class MulticlassMachine : public BaseMulticlassMachine
 		 */
 		std::shared_ptr<MulticlassLabels> apply_multiclass(std::shared_ptr<Features> data=NULL) override;
 
+		/** classify the examples in blocks, so that the outputs of the
+		 * sub-machines and the confidences are only held for one block at a
+		 * time
+		 *
+		 * @param data features to classify
+		 * @param block_size number of vectors per block
+		 * @param consume called in order with the index of the first
+		 * vector of every block and its labels
+		 */
+		void apply_multiclass_blockwise(
+			std::shared_ptr<Features> data, int32_t block_size,
+			const std::function<void(index_t, std::shared_ptr<MulticlassLabels>)>& consume);
+
+		/** set how the confidences of the labels returned by
+		 * apply_multiclass() are stored
+		 *
+		 * @param storage storage of the confidences
+		 * @param top_k number of classes whose confidences are kept with
+		 * CONFIDENCES_TOP_K
+		 */
+		void set_confidence_storage(EConfidenceStorage storage, int32_t top_k=0);
+
+		/** @return storage of the confidences of the applied labels */
+		EConfidenceStorage get_confidence_storage() const
+		{
+			return m_confidence_storage;
+		}
+
+		/** set the calibration of the outputs of the sub-machines
+		 *
+		 * apply_multiclass() then returns calibrated probabilities as
+		 * confidences, computed for each vector right from the outputs.
+		 * Fit the calibration on the confidences returned without it, only
+		 * one-vs-rest strategies without a probability heuristic are
+		 * supported.
+		 *
+		 * @param calibration fitted calibration, NULL to return the outputs
+		 */
+		void set_calibration(std::shared_ptr<Calibration> calibration)
+		{
+			m_calibration=std::move(calibration);
+		}
+
+		/** @return calibration of the outputs of the sub-machines */
+		std::shared_ptr<Calibration> get_calibration() const
+		{
+			return m_calibration;
+		}
+
 		/** classify all examples with multiple output
 		 *
 		 * @return resulting labels
@@ -186,6 +239,31 @@ class MulticlassMachine : public BaseMulticlassMachine
 		/** deletes any subset set to the features of the machine */
 		virtual void remove_machine_subset() = 0;
 
+		/** whether the sub-machines can be trained and applied concurrently,
+		 * training then uses get_machine_for_subproblem()
+		 *
+		 * @return false, sub-machines are trained one after another
+		 */
+		virtual bool supports_parallel_submachines() const
+		{
+			return false;
+		}
+
+		/** get an untrained copy of the base machine for one sub-problem,
+		 * with its own data so that it can be trained concurrently with the
+		 * other sub-problems
+		 *
+		 * @param subset vectors of the sub-problem, empty for all vectors
+		 * @param labels binary labels of the vectors of the sub-problem
+		 * @return machine to train
+		 */
+		virtual std::shared_ptr<Machine> get_machine_for_subproblem(
+			SGVector<index_t> subset, std::shared_ptr<BinaryLabels> labels)
+		{
+			not_implemented(SOURCE_LOCATION);
+			return NULL;
+		}
+
 		/** whether the machine is acceptable in set_machine */
 		virtual bool is_acceptable_machine(std::shared_ptr<Machine >machine)
 		{
@@ -197,12 +275,28 @@ class MulticlassMachine : public BaseMulticlassMachine
 		/** register parameters */
 		void register_parameters();
 
+		/** train the remaining sub-problems of the strategy concurrently
+		 *
+		 * @param train_labels labels the strategy writes the sub-problems to
+		 */
+		void train_submachines_parallel(std::shared_ptr<BinaryLabels> train_labels);
+
 	protected:
 		/** type of multiclass strategy */
 		std::shared_ptr<MulticlassStrategy >m_multiclass_strategy;
 
 		/** machine */
 		std::shared_ptr<Machine> m_machine;
+
+		/** storage of the confidences of the applied labels */
+		EConfidenceStorage m_confidence_storage;
+
+		/** number of classes whose confidences are kept with
+		 * CONFIDENCES_TOP_K */
+		int32_t m_confidence_top_k;
+
+		/** calibration of the outputs of the sub-machines */
+		std::shared_ptr<Calibration> m_calibration;
 };
 }
 #endif
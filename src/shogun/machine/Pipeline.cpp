@@ -4,8 +4,10 @@
  * Authors: Wuwei Lin
  */
 
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/exception/InvalidStateException.h>
 #include <shogun/machine/Pipeline.h>
+#include <shogun/preprocessor/DensePreprocessor.h>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -120,11 +122,20 @@ namespace shogun
 			require(m_labels, "No labels given.");
 		}
 		auto current_data = data;
+		size_t key = m_cache ? TransformerCache::input_key(data) : 0;
 		for (auto&& stage : m_stages)
 		{
 			if (holds_alternative<std::shared_ptr<Transformer>>(stage.second))
 			{
 				auto transformer = shogun::get<std::shared_ptr<Transformer>>(stage.second);
+				if (m_cache)
+				{
+					current_data = m_cache->fit_transform(
+					    transformer, current_data, m_labels, key);
+					stage.second = transformer;
+					continue;
+				}
+
 				transformer->train_require_labels()
 				    ? transformer->fit(current_data, m_labels)
 				    : transformer->fit(current_data);
@@ -145,21 +156,56 @@ namespace shogun
 	std::shared_ptr<Labels> Pipeline::apply(std::shared_ptr<Features> data)
 	{
 		auto current_data = data;
-		for (auto&& stage : m_stages)
+		const auto num_transformers = m_stages.size() - 1;
+		for (size_t i = 0; i < num_transformers;)
 		{
-			if (holds_alternative<std::shared_ptr<Transformer>>(stage.second))
-			{
-				auto transformer = shogun::get<std::shared_ptr<Transformer>>(stage.second);
-				current_data = transformer->transform(current_data);
-			}
-			else
+			if (auto num_fused = apply_fused(i, num_transformers, current_data))
 			{
-				auto machine = shogun::get<std::shared_ptr<Machine>>(stage.second);
-				return machine->apply(current_data);
+				i += num_fused;
+				continue;
 			}
+
+			auto transformer =
+			    shogun::get<std::shared_ptr<Transformer>>(m_stages[i].second);
+			current_data = transformer->transform(current_data);
+			i++;
 		}
 
-		return nullptr; // unreachable
+		return get_machine()->apply(current_data);
+	}
+
+	size_t Pipeline::apply_fused(
+	    size_t begin, size_t end, std::shared_ptr<Features>& data) const
+	{
+		if (!data || data->get_feature_class() != C_DENSE ||
+		    data->get_feature_type() != F_DREAL)
+			return 0;
+
+		std::vector<std::shared_ptr<DensePreprocessor<float64_t>>> preprocessors;
+		for (auto i = begin; i < end; i++)
+		{
+			auto preprocessor =
+			    std::dynamic_pointer_cast<DensePreprocessor<float64_t>>(
+			        shogun::get<std::shared_ptr<Transformer>>(m_stages[i].second));
+			if (!preprocessor || !preprocessor->supports_in_place() ||
+			    !preprocessor->is_fitted())
+				break;
+			preprocessors.push_back(preprocessor);
+		}
+
+		// a single stage is applied by itself
+		if (preprocessors.size() < 2)
+			return 0;
+
+		// the input is only read, the subset is applied by copying
+		auto result = std::make_shared<DenseFeatures<float64_t>>(
+		    data->as<DenseFeatures<float64_t>>()->get_feature_matrix());
+		for (const auto& preprocessor : preprocessors)
+			result->add_preprocessor(preprocessor);
+		result->apply_preprocessors();
+
+		data = result;
+		return preprocessors.size();
 	}
 
 	bool Pipeline::train_require_labels() const
@@ -209,6 +255,19 @@ namespace shogun
 		return nullptr;
 	}
 
+	std::vector<std::shared_ptr<Transformer>> Pipeline::get_transformers() const
+	{
+		std::vector<std::shared_ptr<Transformer>> transformers;
+		for (auto&& stage : m_stages)
+		{
+			if (holds_alternative<std::shared_ptr<Transformer>>(stage.second))
+				transformers.push_back(
+				    shogun::get<std::shared_ptr<Transformer>>(stage.second));
+		}
+
+		return transformers;
+	}
+
 	std::shared_ptr<Machine> Pipeline::get_machine() const
 	{
 		return shogun::get<std::shared_ptr<Machine>>(m_stages.back().second);
@@ -217,6 +276,7 @@ namespace shogun
 	std::shared_ptr<SGObject> Pipeline::clone(ParameterProperties pp) const
 	{
 		auto result = Machine::clone()->as<Pipeline>();
+		result->m_cache = m_cache;
 		for (auto&& stage : m_stages)
 		{
 			visit(
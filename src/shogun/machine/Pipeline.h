@@ -10,6 +10,7 @@
 #include <shogun/base/variant.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/transformer/Transformer.h>
+#include <shogun/transformer/TransformerCache.h>
 #include <utility>
 
 namespace shogun
@@ -85,6 +86,17 @@ namespace shogun
 	 * consists of a sequence of transformers as intermediate stages of training
 	 * or testing and a machine as the final stage. Features are transformed by
 	 * transformers and fed into the next stage sequentially.
+	 *
+	 * With a TransformerCache, see set_cache(), training takes fitted
+	 * transformers and their outputs from the cache if the same stages were
+	 * trained on the same data before, e.g. by another clone in a
+	 * cross-validation or hyperparameter search. The transformers of the
+	 * pipeline are then replaced by copies of the cached ones.
+	 *
+	 * When applied to dense real-valued features, consecutive
+	 * DensePreprocessor stages that work in place on single vectors are
+	 * applied in one pass over the data, see
+	 * DenseFeatures::apply_preprocessors().
 	 */
 	class Pipeline : public Machine
 	{
@@ -110,11 +122,31 @@ namespace shogun
 		 */
 		std::shared_ptr<Transformer> get_transformer(const std::string& name) const;
 
+		/** Get all transformers in the pipeline.
+		 * @return the transformers in the order they are applied
+		 */
+		std::vector<std::shared_ptr<Transformer>> get_transformers() const;
+
 		/** Get machine in the pipeline
 		 * @return the machine
 		 */
 		std::shared_ptr<Machine> get_machine() const;
 
+		/** Set the cache of fitted transformers, which is shared with the
+		 * clones of the pipeline.
+		 * @param cache cache, nullptr to disable caching
+		 */
+		void set_cache(std::shared_ptr<TransformerCache> cache)
+		{
+			m_cache = std::move(cache);
+		}
+
+		/** @return cache of fitted transformers */
+		std::shared_ptr<TransformerCache> get_cache() const
+		{
+			return m_cache;
+		}
+
 		std::shared_ptr<SGObject> clone(ParameterProperties pp = ParameterProperties::ALL) const override;
 
 		EProblemType get_machine_problem_type() const override;
@@ -125,6 +157,21 @@ namespace shogun
 		std::vector<std::pair<std::string, variant<std::shared_ptr<Transformer>, std::shared_ptr<Machine>>>>
 		    m_stages;
 		bool train_require_labels() const override;
+
+	private:
+		/** Apply the transformers of the stages [begin, end) that can be
+		 * fused, starting at begin.
+		 * @param begin first stage
+		 * @param end end of the transformer stages
+		 * @param data features to transform
+		 * @return number of stages applied, 0 if begin cannot be fused
+		 */
+		size_t apply_fused(
+		    size_t begin, size_t end, std::shared_ptr<Features>& data) const;
+
+		/** cache of fitted transformers, not a parameter so that clones
+		 * share it */
+		std::shared_ptr<TransformerCache> m_cache;
 	};
 }
 
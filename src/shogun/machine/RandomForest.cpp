@@ -138,7 +138,20 @@ int32_t RandomForest::get_num_random_features() const
 	return m_machine->as<RandomCARTree>()->get_feature_subset_size();
 }
 
-void RandomForest::set_machine_parameters(std::shared_ptr<Machine> m, SGVector<index_t> idx)
+void RandomForest::set_num_bins(int32_t num_bins)
+{
+	require(m_machine,"m_machine is NULL. It is expected to be RandomCARTree");
+	m_machine->as<RandomCARTree>()->set_num_bins(num_bins);
+}
+
+int32_t RandomForest::get_num_bins() const
+{
+	require(m_machine,"m_machine is NULL. It is expected to be RandomCARTree");
+	return m_machine->as<RandomCARTree>()->get_num_bins();
+}
+
+void RandomForest::set_machine_parameters(
+    std::shared_ptr<Machine> m, SGVector<index_t> idx, SGVector<float64_t> counts)
 {
 	require(m,"Machine supplied is NULL");
 	require(m_machine,"Reference Machine is NULL");
@@ -157,8 +170,18 @@ void RandomForest::set_machine_parameters(std::shared_ptr<Machine> m, SGVector<i
 			weights[i]=m_weights[idx[i]];
 	}
 
+	// a vector drawn several times is trained on once with its count
+	if (counts.vlen)
+	{
+		for (int32_t i=0;i<idx.vlen;i++)
+			weights[i]*=counts[i];
+	}
+
 	tree->set_weights(weights);
-	tree->set_sorted_features(m_sorted_transposed_feats, m_sorted_indices);
+	if (tree->get_num_bins()>0)
+		tree->set_quantized_features(m_binned_feats, m_bin_thresholds);
+	else
+		tree->set_sorted_features(m_sorted_transposed_feats, m_sorted_indices);
 	// equate the machine problem types - cloning does not do this
 	tree->set_machine_problem_type(m_machine->as<RandomCARTree>()->get_machine_problem_type());
 }
@@ -172,9 +195,58 @@ bool RandomForest::train_machine(std::shared_ptr<Features> data)
 	
 	require(m_features, "Training features not set!");
 
-	m_machine->as<RandomCARTree>()->pre_sort_features(m_features, m_sorted_transposed_feats, m_sorted_indices);
+	auto tree=m_machine->as<RandomCARTree>();
+	if (tree->get_num_bins()>0)
+		tree->quantize_features(m_features, m_binned_feats, m_bin_thresholds);
+	else
+		tree->pre_sort_features(m_features, m_sorted_transposed_feats, m_sorted_indices);
+
+	if (!BaggingMachine::train_machine())
+		return false;
+
+	compile();
+	return true;
+}
+
+void RandomForest::compile()
+{
+	m_flat_forest.clear();
+	for (const auto& bag : m_bags)
+	{
+		auto tree=bag->as<RandomCARTree>();
+		m_flat_forest.add_tree(
+			tree->get_root()->as<FlatTreeEnsemble::bnode_t>(),
+			tree->get_feature_types());
+	}
+}
+
+SGMatrix<float64_t> RandomForest::get_shap_values(
+    const std::shared_ptr<Features>& data, const std::shared_ptr<Features>& background)
+{
+	require(!m_bags.empty(), "Forest is not trained");
+	require(data, "No data provided");
+	if (m_flat_forest.get_num_trees()!=m_num_bags)
+		compile();
+
+	SGVector<float64_t> tree_weights(m_num_bags);
+	tree_weights.set_const(1.0/m_num_bags);
+	SGMatrix<float64_t> background_mat;
+	if (background)
+		background_mat=background->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+
+	return m_flat_forest.shap_values(
+		data->as<DenseFeatures<float64_t>>()->get_feature_matrix(),
+		tree_weights, 1, background_mat);
+}
+
+SGMatrix<float64_t>
+RandomForest::apply_outputs_without_combination(std::shared_ptr<Features> data)
+{
+	auto dense=std::dynamic_pointer_cast<DenseFeatures<float64_t>>(data);
+	if (!dense || m_flat_forest.get_num_trees()!=m_num_bags)
+		return BaggingMachine::apply_outputs_without_combination(data);
 
-	return BaggingMachine::train_machine();
+	return m_flat_forest.apply(dense->get_feature_matrix());
 }
 
 SGVector<float64_t> RandomForest::get_feature_importances() const
@@ -33,6 +33,7 @@
 
 #include <shogun/lib/config.h>
 #include <shogun/machine/BaggingMachine.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
 
 namespace shogun
 {
@@ -137,6 +138,21 @@ public:
 	 * @return number of randomly chosen features during each node split
 	 */
 	int32_t get_num_random_features() const;
+
+	/** set number of bins of histogram split finding in the trees, the
+	 * features are quantized once for all trees, see
+	 * CARTree::set_num_bins()
+	 *
+	 * @param num_bins number of bins in [2, 255], 0 for exact splits
+	 */
+	void set_num_bins(int32_t num_bins);
+
+	/** get number of bins of histogram split finding in the trees
+	 *
+	 * @return number of bins, 0 for exact splits
+	 */
+	int32_t get_num_bins() const;
+
 	/** get feature importances of previous trained, use Mean Decrease
 	 * Impurity(MDI)
 	 *
@@ -144,6 +160,26 @@ public:
 	 */
 	SGVector<float64_t> get_feature_importances() const;
 
+	/** flattens the trained trees into one node table, which apply()
+	 * walks instead of the trees. Training compiles the forest.
+	 */
+	void compile();
+
+	/** SHAP values of the mean output of the trees, see
+	 * FlatTreeEnsemble::shap_values(). Meaningful for regression forests
+	 * and binary forests with labels -1 and 1.
+	 *
+	 * @param data vectors to explain
+	 * @param background background vectors of interventional SHAP,
+	 * nullptr to integrate the features out by the training weights of the
+	 * nodes
+	 * @return one column per vector with the SHAP value of every feature,
+	 * followed by the expected output
+	 */
+	SGMatrix<float64_t> get_shap_values(
+		const std::shared_ptr<Features>& data,
+		const std::shared_ptr<Features>& background=nullptr);
+
 protected:
 
 	bool train_machine(std::shared_ptr<Features> data=NULL) override;
@@ -151,8 +187,26 @@ protected:
 	 *
 	 * @param m machine
 	 * @param idx indices of training vectors chosen in current bag
+	 * @param counts number of times each vector of idx was drawn
+	 */
+	void set_machine_parameters(
+		std::shared_ptr<Machine> m, SGVector<index_t> idx,
+		SGVector<float64_t> counts) override;
+
+	/** @return true, the trees weight the vectors by their bootstrap counts */
+	bool supports_bag_weights() const override
+	{
+		return true;
+	}
+
+	/** outputs of all trees, from the compiled forest if dense features
+	 * are supplied
+	 *
+	 * @param data the data to compute the output for
+	 * @return outputs, one column per tree
 	 */
-	void set_machine_parameters(std::shared_ptr<Machine> m, SGVector<index_t> idx) override;
+	SGMatrix<float64_t>
+		apply_outputs_without_combination(std::shared_ptr<Features> data) override;
 
 private:
 	/** initialize parameters */
@@ -167,6 +221,15 @@ private:
 
 	/** Indices of pre-sorted features */
 	SGMatrix<index_t> m_sorted_indices;
+
+	/** Quantized features for histogram split finding */
+	SGMatrix<uint8_t> m_binned_feats;
+
+	/** Largest values of the bins of the quantized features */
+	SGMatrix<float64_t> m_bin_thresholds;
+
+	/** node tables of the trained trees */
+	FlatTreeEnsemble m_flat_forest;
 #ifndef SWIG
 public:
 	static constexpr std::string_view kWeights = "weights";
@@ -0,0 +1,47 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/ensemble/MajorityVote.h>
+#include <shogun/machine/Machine_benchmark.h>
+#include <shogun/machine/RandomForest.h>
+
+namespace shogun
+{
+
+std::shared_ptr<RandomForest> make_random_forest(const MachineFixture& fixture)
+{
+	auto forest = std::make_shared<RandomForest>(4, 50);
+	SGVector<bool> feature_types(MachineFixture::kNumDims);
+	feature_types.set_const(false);
+	forest->set_feature_types(feature_types);
+	forest->set_combination_rule(std::make_shared<MajorityVote>());
+	forest->set_labels(fixture.multiclass_labels);
+	forest->put("seed", 17);
+	return forest;
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, RandomForest_Train)(benchmark::State& state)
+{
+	for (auto _ : state)
+		make_random_forest(*this)->train(features_train);
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, RandomForest_Apply)(benchmark::State& state)
+{
+	auto forest = make_random_forest(*this);
+	forest->train(features_train);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(forest->apply_multiclass(features_test));
+	set_counters(state);
+}
+
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, RandomForest_Train), 1000, 10000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, RandomForest_Apply), 1000, 10000, 8);
+
+} // namespace shogun
@@ -30,11 +30,16 @@
 
 #include <shogun/base/progress.h>
 #include <shogun/lib/View.h>
+#include <shogun/lib/observers/ObservedValueTemplated.h>
 #include <shogun/machine/StochasticGBMachine.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/multiclass/tree/CARTree.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace shogun;
 
 StochasticGBMachine::StochasticGBMachine(const std::shared_ptr<Machine>& machine, const std::shared_ptr<LossFunction>& loss, int32_t num_iterations,
@@ -134,14 +139,63 @@ float64_t StochasticGBMachine::get_learning_rate() const
 	return m_learning_rate;
 }
 
+void StochasticGBMachine::set_second_order(bool second_order)
+{
+	m_second_order=second_order;
+}
+
+bool StochasticGBMachine::get_second_order() const
+{
+	return m_second_order;
+}
+
+void StochasticGBMachine::set_validation_data(
+    std::shared_ptr<Features> features, std::shared_ptr<Labels> labels)
+{
+	require((features==nullptr)==(labels==nullptr),
+		"Validation features and labels have to be given together");
+	if (features)
+	{
+		require(features->get_num_vectors()==labels->get_num_labels(),
+			"Number of validation vectors ({}) does not match number of labels ({})",
+			features->get_num_vectors(), labels->get_num_labels());
+	}
+	m_validation_features=std::move(features);
+	m_validation_labels=std::move(labels);
+}
+
+void StochasticGBMachine::set_early_stopping_rounds(int32_t rounds)
+{
+	require(rounds>=0, "Early stopping rounds ({}) should not be negative", rounds);
+	m_early_stopping_rounds=rounds;
+}
+
+int32_t StochasticGBMachine::get_early_stopping_rounds() const
+{
+	return m_early_stopping_rounds;
+}
+
+int32_t StochasticGBMachine::get_num_weak_learners() const
+{
+	return m_weak_learners.size();
+}
+
 std::shared_ptr<RegressionLabels> StochasticGBMachine::apply_regression(std::shared_ptr<Features> data)
 {
 	require(data,"test data supplied is NULL");
 	auto feats=data->as<DenseFeatures<float64_t>>();
 
+	const int32_t num_learners=m_weak_learners.size();
+	if (num_learners>0 && m_flat_learners.get_num_trees()==num_learners)
+	{
+		SGVector<float64_t> gamma(m_gamma.data(), m_gamma.size(), false);
+		return std::make_shared<RegressionLabels>(m_flat_learners.apply_sum(
+			feats->get_feature_matrix(), gamma, m_learning_rate));
+	}
+
 	SGVector<float64_t> retlabs(feats->get_num_vectors());
 	retlabs.fill_vector(retlabs.vector,retlabs.vlen,0);
-	for (int32_t i=0;i<m_num_iter;i++)
+	for (int32_t i=0;i<num_learners;i++)
 	{
 		float64_t gamma=m_gamma[i];
 
@@ -173,11 +227,38 @@ bool StochasticGBMachine::train_machine(std::shared_ptr<Features> data)
 	// initialize weak learners array and gamma array
 	initialize_learners();
 
-	// cache predicted labels for intermediate models
-	auto interf=std::make_shared<RegressionLabels>(feats->get_num_vectors());
+	m_binned_features=SGMatrix<uint8_t>();
+	m_bin_thresholds=SGMatrix<float64_t>();
+	if (m_second_order)
+	{
+		auto tree=std::dynamic_pointer_cast<CARTree>(m_machine);
+		require(tree, "Second-order boosting needs a CARTree as machine");
 
-	for (int32_t i=0;i<interf->get_num_labels();i++)
-		interf->set_label(i,0);
+		// the rows of the quantized features are the indices of the
+		// vectors in their storage, which subsets of subsets do not keep
+		if (tree->get_num_bins()>0 && !feats->get_subset_stack()->has_subsets())
+			tree->quantize_features(feats, m_binned_features, m_bin_thresholds);
+	}
+
+	// outputs on the validation data, updated by every learner
+	std::shared_ptr<DenseFeatures<float64_t>> valid_feats;
+	SGVector<float64_t> valid_labels;
+	SGVector<float64_t> valid_f;
+	if (m_validation_features)
+	{
+		valid_feats=m_validation_features->as<DenseFeatures<float64_t>>();
+		valid_labels=m_validation_labels->as<DenseLabels>()->get_labels();
+		valid_f=SGVector<float64_t>(valid_labels.vlen);
+		valid_f.zero();
+	}
+	float64_t best_loss=std::numeric_limits<float64_t>::infinity();
+	int32_t best_iter=-1;
+
+	// cache predicted labels for intermediate models, every iteration only
+	// adds the outputs of its learner
+	auto interf=std::make_shared<RegressionLabels>(feats->get_num_vectors());
+	SGVector<float64_t> fvals=interf->get_labels();
+	fvals.zero();
 
 	for (auto i : SG_PROGRESS(range(m_num_iter)))
 	{
@@ -186,35 +267,89 @@ bool StochasticGBMachine::train_machine(std::shared_ptr<Features> data)
 		const auto& interf_iter = std::get<1>(result);
 		const auto& labels_iter = std::get<2>(result);
 
-		// compute pseudo-residuals
-		auto pres =
-		    compute_pseudo_residuals(interf_iter, labels_iter);
-
-		// fit learner
-		auto wlearner = fit_model(feats_iter, pres);
-		m_weak_learners.push_back(wlearner);
+		std::shared_ptr<Machine> wlearner;
+		std::shared_ptr<RegressionLabels> hm;
+		float64_t gamma;
+		if (m_second_order)
+		{
+			// the leaves are Newton steps already
+			wlearner = fit_newton_tree(feats_iter, interf_iter, labels_iter);
+			gamma = 1.0;
+		}
+		else
+		{
+			// compute pseudo-residuals
+			auto pres =
+			    compute_pseudo_residuals(interf_iter, labels_iter);
 
-		// compute multiplier
-		auto hm = wlearner->apply_regression(feats_iter);
+			// fit learner
+			wlearner = fit_model(feats_iter, pres);
 
-		float64_t gamma = compute_multiplier(interf_iter, hm, labels_iter);
+			// compute multiplier
+			hm = wlearner->apply_regression(feats_iter);
+			gamma = compute_multiplier(interf_iter, hm, labels_iter);
+		}
+		m_weak_learners.push_back(wlearner);
 		m_gamma.push_back(gamma);
 
-		// update intermediate function value
-		auto dlabels=wlearner->apply_regression(feats);
-		SGVector<float64_t> delta=dlabels->get_labels();
-		for (int32_t j=0;j<interf->get_num_labels();j++)
-			interf->set_label(j,interf->get_label(j)+delta[j]*gamma*m_learning_rate);
-
-
-
+		// update intermediate function value, the outputs of the multiplier
+		// are reused if the learner was fitted on all vectors
+		if (!hm || feats_iter!=feats)
+			hm = wlearner->apply_regression(feats);
+		SGVector<float64_t> delta=hm->get_labels();
+		for (int32_t j=0;j<fvals.vlen;j++)
+			fvals[j]+=delta[j]*gamma*m_learning_rate;
 
+		if (valid_feats)
+		{
+			delta=wlearner->apply_regression(valid_feats)->get_labels();
+			float64_t valid_loss=0;
+			for (int32_t j=0;j<valid_f.vlen;j++)
+			{
+				valid_f[j]+=delta[j]*gamma*m_learning_rate;
+				valid_loss+=m_loss->loss(valid_f[j], valid_labels[j]);
+			}
+			valid_loss/=valid_f.vlen;
+			observe<float64_t>(i, "validation_loss", "Loss on the validation data", valid_loss);
+
+			if (valid_loss<best_loss)
+			{
+				best_loss=valid_loss;
+				best_iter=i;
+			}
+			else if (m_early_stopping_rounds>0 && i-best_iter>=m_early_stopping_rounds)
+				break;
+		}
 	}
 
+	// keep the ensemble with the smallest validation loss
+	if (m_early_stopping_rounds>0 && best_iter>=0)
+	{
+		m_weak_learners.resize(best_iter+1);
+		m_gamma.resize(best_iter+1);
+	}
 
+	compile();
 	return true;
 }
 
+void StochasticGBMachine::compile()
+{
+	m_flat_learners.clear();
+	for (const auto& learner : m_weak_learners)
+	{
+		auto tree=std::dynamic_pointer_cast<CARTree>(learner);
+		if (!tree || !tree->get_root())
+		{
+			m_flat_learners.clear();
+			return;
+		}
+		m_flat_learners.add_tree(
+			tree->get_root()->as<FlatTreeEnsemble::bnode_t>(),
+			tree->get_feature_types());
+	}
+}
+
 float64_t StochasticGBMachine::compute_multiplier(
     const std::shared_ptr<RegressionLabels>& f, const std::shared_ptr<RegressionLabels>& hm, const std::shared_ptr<Labels>& labs)
 {
@@ -243,6 +378,35 @@ std::shared_ptr<Machine> StochasticGBMachine::fit_model(const std::shared_ptr<De
 	return c;
 }
 
+std::shared_ptr<Machine> StochasticGBMachine::fit_newton_tree(
+    const std::shared_ptr<DenseFeatures<float64_t>>& feats,
+    const std::shared_ptr<RegressionLabels>& f, const std::shared_ptr<Labels>& labs)
+{
+	auto labels=labs->as<DenseLabels>()->get_labels();
+	SGVector<float64_t> fv=f->get_labels();
+
+	// weighted least squares on -g/h with weights h has the second-order
+	// gain as split criterion and -G/H as leaf values
+	SGVector<float64_t> targets(fv.vlen);
+	SGVector<float64_t> hessians(fv.vlen);
+	for (int32_t i=0;i<fv.vlen;i++)
+	{
+		hessians[i]=std::max(m_loss->second_derivative(fv[i],labels[i]), min_hessian);
+		targets[i]=-m_loss->first_derivative(fv[i],labels[i])/hessians[i];
+	}
+
+	auto tree=m_machine->clone()->as<CARTree>();
+	// cloning does not keep the problem type
+	tree->set_machine_problem_type(PT_REGRESSION);
+	tree->set_weights(hessians);
+	if (m_binned_features.num_rows>0)
+		tree->set_quantized_features(m_binned_features, m_bin_thresholds);
+	tree->set_labels(std::make_shared<RegressionLabels>(targets));
+	tree->train(feats);
+
+	return tree;
+}
+
 std::shared_ptr<RegressionLabels> StochasticGBMachine::compute_pseudo_residuals(
     const std::shared_ptr<RegressionLabels>& inter_f, const std::shared_ptr<Labels>& labs)
 {
@@ -376,6 +540,8 @@ void StochasticGBMachine::init()
 
 	m_weak_learners.clear();
 	m_gamma.clear();
+	m_second_order=false;
+	m_early_stopping_rounds=0;
 
 	SG_ADD(&m_machine, kMachine, "machine");
 	SG_ADD(&m_loss, kLoss, "loss function");
@@ -384,4 +550,11 @@ void StochasticGBMachine::init()
 	SG_ADD(&m_learning_rate, kLearningRate, "learning rate");
 	SG_ADD(&m_weak_learners, kWeakLearners, "array of weak learners");
 	SG_ADD(&m_gamma, kGamma, "array of learner weights");
+	SG_ADD(&m_second_order, kSecondOrder, "whether trees are grown by Newton steps",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_validation_features, kValidationFeatures, "validation features");
+	SG_ADD(&m_validation_labels, kValidationLabels, "validation labels");
+	SG_ADD(&m_early_stopping_rounds, kEarlyStoppingRounds,
+		"iterations without improvement of the validation loss before stopping",
+		ParameterProperties::SETTING);
 }
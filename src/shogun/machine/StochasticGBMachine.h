@@ -38,6 +38,7 @@
 #include <shogun/loss/LossFunction.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/mathematics/RandomMixin.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
 
 #include <tuple>
 
@@ -51,6 +52,23 @@ namespace shogun
  * For one dimensional optimization, this class uses the backtracking linesearch accessed via Shogun's L-BFGS class.
  * A concise description of the algorithm implemented can be found in the following link :
  * http://en.wikipedia.org/wiki/Gradient_boosting#Algorithm
+ *
+ * With set_second_order(), the ensemble is grown from regression CARTree
+ * learners by Newton steps instead. Every tree is fit to \f$-g_i/h_i\f$
+ * with weights \f$h_i\f$, the gradient and hessian of the loss at the
+ * current outputs. Its splits then maximize the second-order gain
+ * \f$G_L^2/H_L+G_R^2/H_R-G^2/H\f$ and its leaves are the Newton values
+ * \f$-G/H\f$, so no line search is needed. If the tree uses histogram
+ * splits, see CARTree::set_num_bins(), the training data is quantized
+ * once for all trees. A RandomCARTree samples the features of every node.
+ *
+ * With set_validation_data(), the loss on the validation data is observed
+ * as "validation_loss" after every iteration, and set_early_stopping_rounds()
+ * stops training when it has not improved for the given number of
+ * iterations. The ensemble is then cut back to the best iteration.
+ *
+ * The outputs of the ensemble on the training and validation data are
+ * cached during training, every iteration only applies its own learner.
  */
 class StochasticGBMachine : public RandomMixin<Machine>
 {
@@ -142,6 +160,43 @@ public:
 	 */
 	std::shared_ptr<RegressionLabels> apply_regression(std::shared_ptr<Features> data=NULL) override;
 
+	/** set whether trees are grown by Newton steps, which needs a
+	 * regression CARTree as machine
+	 *
+	 * @param second_order whether to use second-order boosting
+	 */
+	void set_second_order(bool second_order);
+
+	/** @return whether trees are grown by Newton steps */
+	bool get_second_order() const;
+
+	/** set data to monitor the loss on during training
+	 *
+	 * @param features validation features
+	 * @param labels validation labels
+	 */
+	void set_validation_data(
+		std::shared_ptr<Features> features, std::shared_ptr<Labels> labels);
+
+	/** set number of iterations without improvement of the validation loss
+	 * after which training stops
+	 *
+	 * @param rounds number of iterations, 0 to disable early stopping
+	 */
+	void set_early_stopping_rounds(int32_t rounds);
+
+	/** @return number of iterations without improvement before stopping */
+	int32_t get_early_stopping_rounds() const;
+
+	/** @return number of trained weak learners */
+	int32_t get_num_weak_learners() const;
+
+	/** flattens the weak learners into one node table, which
+	 * apply_regression() walks instead of the learners. Only ensembles of
+	 * CARTree learners are compiled, training compiles them.
+	 */
+	void compile();
+
 protected:
 	/** train machine
 	 *
@@ -169,6 +224,18 @@ protected:
 	 */
 	std::shared_ptr<Machine> fit_model(const std::shared_ptr<DenseFeatures<float64_t>>& feats, const std::shared_ptr<RegressionLabels>& labels);
 
+	/** train a tree by a Newton step of the loss
+	 *
+	 * @param feats training data
+	 * @param f intermediate boosted model labels for training data
+	 * @param labs training labels
+	 * @return trained tree
+	 */
+	std::shared_ptr<Machine> fit_newton_tree(
+		const std::shared_ptr<DenseFeatures<float64_t>>& feats,
+		const std::shared_ptr<RegressionLabels>& f,
+		const std::shared_ptr<Labels>& labs);
+
 	/** compute pseudo_residuals
 	 *
 	 * @param inter_f intermediate boosted model labels for training data
@@ -231,6 +298,31 @@ protected:
 
 	/** gamma - weak learner weights */
 	std::vector<float64_t> m_gamma;
+
+	/** node tables of the weak learners, empty if they are not trees */
+	FlatTreeEnsemble m_flat_learners;
+
+	/** whether trees are grown by Newton steps */
+	bool m_second_order;
+
+	/** validation features */
+	std::shared_ptr<Features> m_validation_features;
+
+	/** validation labels */
+	std::shared_ptr<Labels> m_validation_labels;
+
+	/** iterations without improvement before stopping, 0 to disable */
+	int32_t m_early_stopping_rounds;
+
+	/** training data quantized for the histogram splits of all trees */
+	SGMatrix<uint8_t> m_binned_features;
+
+	/** largest value of every bin of m_binned_features */
+	SGMatrix<float64_t> m_bin_thresholds;
+
+private:
+	/** smallest hessian a Newton step divides by */
+	static constexpr float64_t min_hessian=1e-6;
 #ifndef SWIG
 public:
 	static constexpr std::string_view kMachine = "machine";
@@ -240,6 +332,10 @@ public:
 	static constexpr std::string_view kLearningRate = "learning_rate";
 	static constexpr std::string_view kWeakLearners = "weak_learners";
 	static constexpr std::string_view kGamma = "gamma";
+	static constexpr std::string_view kSecondOrder = "second_order";
+	static constexpr std::string_view kValidationFeatures = "validation_features";
+	static constexpr std::string_view kValidationLabels = "validation_labels";
+	static constexpr std::string_view kEarlyStoppingRounds = "early_stopping_rounds";
 #endif
 };
 }/* shogun */
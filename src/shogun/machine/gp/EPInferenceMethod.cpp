@@ -88,6 +88,19 @@ void EPInferenceMethod::init()
 	m_min_sweep=2;
 	m_tol=1e-4;
 	m_fail_on_non_convergence=true;
+	m_parallel_updates=false;
+	m_damping=1.0;
+
+	SG_ADD(&m_parallel_updates, "parallel_updates",
+		"Whether all sites of a sweep are updated in parallel");
+	SG_ADD(&m_damping, "damping", "Damping of the site updates");
+}
+
+void EPInferenceMethod::set_damping(const float64_t damping)
+{
+	require(damping>0 && damping<=1, "Damping ({}) has to be in (0, 1]",
+		damping);
+	m_damping=damping;
 }
 
 std::shared_ptr<EPInferenceMethod> EPInferenceMethod::obtain_from_generic(
@@ -208,7 +221,7 @@ void EPInferenceMethod::update()
 		// copy data manually, since we don't have appropriate method
 		for (index_t i=0; i<m_ktrtr.num_rows; i++)
 			for (index_t j=0; j<m_ktrtr.num_cols; j++)
-				m_Sigma(i, j) = m_ktrtr(i, j) * std::exp(m_log_scale);
+				m_Sigma(i, j) = m_ktrtr(i, j) * std::exp(m_log_scale * 2.0);
 
 		CREATE_SGVECTOR(m_mu, n, float64_t);
 		m_mu.zero();
@@ -238,52 +251,84 @@ void EPInferenceMethod::update()
 		nlZ_old=m_nlZ;
 		sweep++;
 
-		// shuffle random permutation
-		random::shuffle(v, m_prng);
-
-		for (index_t j=0; j<n; j++)
+		if (m_parallel_updates)
 		{
-			index_t i=v[j];
+			// all cavities are taken from the current posterior
+			#pragma omp parallel for
+			for (index_t i=0; i<n; i++)
+			{
+				tau_n[i]=1.0/m_Sigma(i,i)-m_ttau[i];
+				nu_n[i]=m_mu[i]/m_Sigma(i,i)+mean[i]*tau_n[i]-m_tnu[i];
+				mu_n[i]=nu_n[i]/tau_n[i];
+				s2_n[i]=1.0/tau_n[i];
+			}
+
+			SGVector<float64_t> mu=m_model->get_first_moments(mu_n, s2_n,
+					m_labels);
+			SGVector<float64_t> s2=m_model->get_second_moments(mu_n, s2_n,
+					m_labels);
+
+			// update all sites, the posterior is refactorized below
+			#pragma omp parallel for
+			for (index_t i=0; i<n; i++)
+			{
+				float64_t ttau=Math::max(1.0/s2[i]-tau_n[i], 0.0);
+				float64_t tnu=mu[i]/s2[i]-nu_n[i];
+				m_ttau[i]=m_damping*ttau+(1.0-m_damping)*m_ttau[i];
+				m_tnu[i]=m_damping*tnu+(1.0-m_damping)*m_tnu[i];
+				m_sttau[i]=std::sqrt(m_ttau[i]);
+			}
+		}
+		else
+		{
+			// shuffle random permutation
+			random::shuffle(v, m_prng);
+
+			for (index_t j=0; j<n; j++)
+			{
+				index_t i=v[j];
 
-			// find cavity paramters
-			tau_n[i]=1.0/m_Sigma(i,i)-m_ttau[i];
-			nu_n[i]=m_mu[i]/m_Sigma(i,i)+mean[i]*tau_n[i]-m_tnu[i];
+				// find cavity paramters
+				tau_n[i]=1.0/m_Sigma(i,i)-m_ttau[i];
+				nu_n[i]=m_mu[i]/m_Sigma(i,i)+mean[i]*tau_n[i]-m_tnu[i];
 
-			// compute cavity mean and variance
-			mu_n[i]=nu_n[i]/tau_n[i];
-			s2_n[i]=1.0/tau_n[i];
+				// compute cavity mean and variance
+				mu_n[i]=nu_n[i]/tau_n[i];
+				s2_n[i]=1.0/tau_n[i];
 
-			// get moments
-			float64_t mu=m_model->get_first_moment(mu_n, s2_n, m_labels, i);
-			float64_t s2=m_model->get_second_moment(mu_n, s2_n, m_labels, i);
+				// get moments
+				float64_t mu=m_model->get_first_moment(mu_n, s2_n, m_labels, i);
+				float64_t s2=m_model->get_second_moment(mu_n, s2_n, m_labels, i);
 
-			// save old value of ttau
-			float64_t ttau_old=m_ttau[i];
+				// save old value of ttau
+				float64_t ttau_old=m_ttau[i];
 
-			// compute ttau and sqrt(ttau)
-			m_ttau[i]=Math::max(1.0/s2-tau_n[i], 0.0);
-			m_sttau[i] = std::sqrt(m_ttau[i]);
+				// compute ttau and sqrt(ttau)
+				m_ttau[i]=m_damping*Math::max(1.0/s2-tau_n[i], 0.0)+
+					(1.0-m_damping)*ttau_old;
+				m_sttau[i] = std::sqrt(m_ttau[i]);
 
-			// compute tnu
-			m_tnu[i]=mu/s2-nu_n[i];
+				// compute tnu
+				m_tnu[i]=m_damping*(mu/s2-nu_n[i])+(1.0-m_damping)*m_tnu[i];
 
-			// compute difference ds2=ttau_new-ttau_old
-			float64_t ds2=m_ttau[i]-ttau_old;
+				// compute difference ds2=ttau_new-ttau_old
+				float64_t ds2=m_ttau[i]-ttau_old;
 
-			// create eigen representation of Sigma, tnu and mu
-			Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m_Sigma.num_rows,
-					m_Sigma.num_cols);
-			Map<VectorXd> eigen_tnu(m_tnu.vector, m_tnu.vlen);
-			Map<VectorXd> eigen_mu(m_mu.vector, m_mu.vlen);
+				// create eigen representation of Sigma, tnu and mu
+				Map<MatrixXd> eigen_Sigma(m_Sigma.matrix, m_Sigma.num_rows,
+						m_Sigma.num_cols);
+				Map<VectorXd> eigen_tnu(m_tnu.vector, m_tnu.vlen);
+				Map<VectorXd> eigen_mu(m_mu.vector, m_mu.vlen);
 
-			VectorXd eigen_si=eigen_Sigma.col(i);
+				VectorXd eigen_si=eigen_Sigma.col(i);
 
-			// rank-1 update Sigma
-			eigen_Sigma=eigen_Sigma-ds2/(1.0+ds2*eigen_si(i))*eigen_si*
-				eigen_si.adjoint();
+				// rank-1 update Sigma
+				eigen_Sigma=eigen_Sigma-ds2/(1.0+ds2*eigen_si(i))*eigen_si*
+					eigen_si.adjoint();
 
-			// update mu
-			eigen_mu=eigen_Sigma*eigen_tnu;
+				// update mu
+				eigen_mu=eigen_Sigma*eigen_tnu;
+			}
 		}
 
 		// update upper triangular factor (L^T) of Cholesky decomposition of
@@ -46,6 +46,13 @@ namespace shogun
 /** @brief Class of the Expectation Propagation (EP) posterior approximation
  * inference method.
  *
+ * By default the sites are updated one after another in random order, each
+ * followed by a rank-one update of the posterior covariance. With parallel
+ * updates, all sites of a sweep are updated from the same posterior, which
+ * is refactorized once per sweep. The latter replaces the \f$O(n^2)\f$ work
+ * per site by one Cholesky factorization per sweep, but may need damping to
+ * converge, see set_damping().
+ *
  * For more details, see: Minka, T. P. (2001). A Family of Algorithms for
  * Approximate Bayesian Inference. PhD thesis, Massachusetts Institute of
  * Technology
@@ -233,6 +240,35 @@ public:
 	 */
 	virtual void set_max_sweep(const uint32_t max_sweep) { m_max_sweep=max_sweep; }
 
+	/** returns whether all sites of a sweep are updated in parallel
+	 *
+	 * @return whether updates are parallel
+	 */
+	virtual bool get_parallel_updates() const { return m_parallel_updates; }
+
+	/** sets whether all sites of a sweep are updated in parallel from the
+	 * same posterior instead of one after another
+	 *
+	 * @param parallel_updates whether updates are parallel
+	 */
+	virtual void set_parallel_updates(const bool parallel_updates)
+	{
+		m_parallel_updates=parallel_updates;
+	}
+
+	/** returns damping of the site updates
+	 *
+	 * @return damping
+	 */
+	virtual float64_t get_damping() const { return m_damping; }
+
+	/** sets damping of the site updates, the new site parameters are
+	 * \f$d\f$ times the updated plus \f$1-d\f$ times the old ones
+	 *
+	 * @param damping damping in (0, 1], 1 for undamped updates
+	 */
+	virtual void set_damping(const float64_t damping);
+
 	/**
 	 * @return whether combination of Laplace approximation inference method and
 	 * given likelihood function supports binary classification
@@ -362,6 +398,12 @@ private:
 	/** flag whether to show error or warning when not-converging */
 	bool m_fail_on_non_convergence;
 
+	/** whether all sites of a sweep are updated in parallel */
+	bool m_parallel_updates;
+
+	/** damping of the site updates */
+	float64_t m_damping;
+
 	SGMatrix<float64_t> m_F;
 };
 }
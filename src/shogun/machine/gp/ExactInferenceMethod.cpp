@@ -38,8 +38,11 @@
 #include <shogun/machine/visitors/ShapeVisitor.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 using namespace Eigen;
@@ -71,7 +74,9 @@ void ExactInferenceMethod::compute_gradient()
 	{
 		update_deriv();
 		update_mean();
-		update_cov();
+		// the posterior covariance is not needed for the gradients, it is
+		// only computed once requested
+		m_Sigma=SGMatrix<float64_t>();
 		m_gradient_update=true;
 		update_parameter_hash();
 	}
@@ -90,6 +95,157 @@ void ExactInferenceMethod::update()
 	SG_TRACE("leaving");
 }
 
+void ExactInferenceMethod::add_observations(
+	std::shared_ptr<Features> features, std::shared_ptr<Labels> labels)
+{
+	require(features, "Features should not be NULL");
+	require(labels, "Labels should not be NULL");
+	require(labels->get_label_type()==LT_REGRESSION,
+		"Labels must be type of CRegressionLabels");
+	require(features->get_num_vectors()==labels->get_num_labels(),
+		"Number of new vectors ({}) must match number of new labels ({})",
+		features->get_num_vectors(), labels->get_num_labels());
+
+	if (parameter_hash_changed())
+		update();
+
+	const index_t n=m_ktrtr.num_rows;
+	const index_t m=features->get_num_vectors();
+	if (m==0)
+		return;
+
+	// kernel between the old and the new observations and among the new ones
+	m_kernel->init(m_features, features);
+	SGMatrix<float64_t> kernel_ab=m_kernel->get_kernel_matrix();
+	m_kernel->init(features, features);
+	SGMatrix<float64_t> kernel_bb=m_kernel->get_kernel_matrix();
+
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	const float64_t scale=std::exp(m_log_scale*2.0)/Math::sq(sigma);
+
+	Map<MatrixXd> K_ab(kernel_ab.matrix, n, m);
+	Map<MatrixXd> K_bb(kernel_bb.matrix, m, m);
+	Map<MatrixXd> L_old(m_L.matrix, n, n);
+
+	// blocks of the new upper triangular factor
+	MatrixXd L_12=L_old.triangularView<Upper>().adjoint().solve(K_ab*scale);
+	MatrixXd S=K_bb*scale+MatrixXd::Identity(m, m)-L_12.adjoint()*L_12;
+	LLT<MatrixXd> llt(S);
+	require(llt.info()==Success,
+		"Covariance of the new observations is not positive definite");
+
+	SGMatrix<float64_t> L(n+m, n+m);
+	Map<MatrixXd> eigen_L(L.matrix, n+m, n+m);
+	eigen_L.topLeftCorner(n, n)=L_old;
+	eigen_L.topRightCorner(n, m)=L_12;
+	eigen_L.bottomLeftCorner(m, n).setZero();
+	eigen_L.bottomRightCorner(m, m)=llt.matrixU();
+	m_L=L;
+
+	SGMatrix<float64_t> ktrtr(n+m, n+m);
+	Map<MatrixXd> K(ktrtr.matrix, n+m, n+m);
+	K.topLeftCorner(n, n)=Map<MatrixXd>(m_ktrtr.matrix, n, n);
+	K.topRightCorner(n, m)=K_ab;
+	K.bottomLeftCorner(m, n)=K_ab.adjoint();
+	K.bottomRightCorner(m, m)=K_bb;
+	m_ktrtr=ktrtr;
+
+	SGVector<float64_t> y_old=regression_labels(m_labels)->get_labels();
+	SGVector<float64_t> y_new=regression_labels(labels)->get_labels();
+	SGVector<float64_t> y(n+m);
+	std::copy(y_old.vector, y_old.vector+n, y.vector);
+	std::copy(y_new.vector, y_new.vector+m, y.vector+n);
+
+	m_features=m_features->create_merged_copy(features);
+	m_labels=std::make_shared<RegressionLabels>(y);
+	m_kernel->init(m_features, m_features);
+
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+}
+
+void ExactInferenceMethod::remove_observations(SGVector<index_t> indices)
+{
+	if (parameter_hash_changed())
+		update();
+
+	const index_t n=m_ktrtr.num_rows;
+	SGVector<bool> removed(n);
+	removed.zero();
+	for (index_t i=0; i<indices.vlen; ++i)
+	{
+		require(indices[i]>=0 && indices[i]<n,
+			"Index ({}) out of range [0, {})", indices[i], n);
+		removed[indices[i]]=true;
+	}
+
+	std::vector<index_t> kept;
+	for (index_t i=0; i<n; ++i)
+	{
+		if (!removed[i])
+			kept.push_back(i);
+	}
+	require(!kept.empty(), "Can not remove all observations");
+	if ((index_t)kept.size()==n)
+		return;
+
+	// removing observation k leaves the factor of the observations after k
+	// with the rank one update L_33^T L_33 + l_23 l_23^T, where l_23 is the
+	// part of the k-th row after the diagonal, so the observations are
+	// removed from the last to the first one
+	MatrixXd L=Map<MatrixXd>(m_L.matrix, n, n);
+	for (index_t k=n-1; k>=0; --k)
+	{
+		if (!removed[k])
+			continue;
+
+		const index_t size=L.rows();
+		const index_t tail=size-k-1;
+		SGMatrix<float64_t> L_33(tail, tail);
+		SGVector<float64_t> l_23(tail);
+		Map<MatrixXd>(L_33.matrix, tail, tail)=L.bottomRightCorner(tail, tail);
+		Map<VectorXd>(l_23.vector, tail)=L.row(k).tail(tail).transpose();
+		if (tail>0)
+			linalg::cholesky_rank_update(L_33, l_23, 1.0, false);
+
+		MatrixXd reduced(size-1, size-1);
+		reduced.topLeftCorner(k, k)=L.topLeftCorner(k, k);
+		reduced.topRightCorner(k, tail)=L.topRightCorner(k, tail);
+		reduced.bottomLeftCorner(tail, k).setZero();
+		reduced.bottomRightCorner(tail, tail)=
+			Map<MatrixXd>(L_33.matrix, tail, tail);
+		L=std::move(reduced);
+	}
+
+	const index_t num_kept=kept.size();
+	SGVector<index_t> kept_indices(num_kept);
+	std::copy(kept.begin(), kept.end(), kept_indices.vector);
+
+	m_L=SGMatrix<float64_t>(num_kept, num_kept);
+	Map<MatrixXd>(m_L.matrix, num_kept, num_kept)=L;
+
+	SGVector<float64_t> y_old=regression_labels(m_labels)->get_labels();
+	SGVector<float64_t> y(num_kept);
+	SGMatrix<float64_t> ktrtr(num_kept, num_kept);
+	for (index_t j=0; j<num_kept; ++j)
+	{
+		y[j]=y_old[kept[j]];
+		for (index_t i=0; i<num_kept; ++i)
+			ktrtr(i, j)=m_ktrtr(kept[i], kept[j]);
+	}
+	m_ktrtr=ktrtr;
+
+	m_features=m_features->copy_subset(kept_indices);
+	m_labels=std::make_shared<RegressionLabels>(y);
+	m_kernel->init(m_features, m_features);
+
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+}
+
 void ExactInferenceMethod::check_members() const
 {
 	Inference::check_members();
@@ -171,6 +327,8 @@ SGVector<float64_t> ExactInferenceMethod::get_posterior_mean()
 SGMatrix<float64_t> ExactInferenceMethod::get_posterior_covariance()
 {
 	compute_gradient();
+	if (!m_Sigma.matrix)
+		update_cov();
 
 	return SGMatrix<float64_t>(m_Sigma);
 }
@@ -272,13 +430,14 @@ void ExactInferenceMethod::update_deriv()
 	m_Q=SGMatrix<float64_t>(m_L.num_rows, m_L.num_cols);
 	Map<MatrixXd> eigen_Q(m_Q.matrix, m_Q.num_rows, m_Q.num_cols);
 
-	// solve L * L' * Q = I
-	eigen_Q=eigen_L.triangularView<Upper>().adjoint().solve(
-		MatrixXd::Identity(m_L.num_rows, m_L.num_cols));
-	eigen_Q=eigen_L.triangularView<Upper>().solve(eigen_Q);
-
-	// divide Q by sigma^2
-	eigen_Q/=Math::sq(sigma);
+	// solve L * L' * Q = I by V = L^(-1) and Q = V' * V, of which only the
+	// lower triangle is computed
+	MatrixXd eigen_V=MatrixXd::Identity(m_L.num_rows, m_L.num_cols);
+	eigen_L.triangularView<Upper>().adjoint().solveInPlace(eigen_V);
+	eigen_Q.setZero();
+	eigen_Q.selfadjointView<Lower>().rankUpdate(eigen_V.adjoint(),
+		1.0/Math::sq(sigma));
+	eigen_Q.triangularView<StrictlyUpper>()=eigen_Q.adjoint();
 
 	// create eigen representation of alpha and compute Q=Q-alpha*alpha'
 	eigen_Q-=eigen_alpha*eigen_alpha.transpose();
@@ -350,15 +509,12 @@ SGVector<float64_t> ExactInferenceMethod::get_derivative_wrt_kernel(
 	int64_t len= visitor->get_size();
 	result=SGVector<float64_t>(len);
 
+	// the traces of the elements are independent
+	auto gradients=m_kernel->get_parameter_gradients(param, result.vlen);
+	#pragma omp parallel for
 	for (index_t i=0; i<result.vlen; i++)
 	{
-		SGMatrix<float64_t> dK;
-
-		if (result.vlen==1)
-			dK=m_kernel->get_parameter_gradient(param);
-		else
-			dK=m_kernel->get_parameter_gradient(param, i);
-
+		SGMatrix<float64_t> dK=gradients[i];
 		Map<MatrixXd> eigen_dK(dK.matrix, dK.num_rows, dK.num_cols);
 
 		// compute derivative wrt kernel parameter: dnlZ=sum(Q.*dK*scale)/2.0
@@ -187,6 +187,33 @@ public:
 	/** update matrices except gradients*/
 	void update() override;
 
+	/** add observations to the training data, updating the Cholesky factor
+	 * and alpha of the current hyperparameters in \f$O(n^2 m + m^3)\f$
+	 * instead of refactorizing the \f$(n+m) \times (n+m)\f$ matrix:
+	 *
+	 * \f[
+	 * L = \left[\begin{array}{cc} L_{11} & L_{11}^{-T} B\\
+	 * 0 & Cholesky(C - B^T L_{11}^{-1} L_{11}^{-T} B)\end{array}\right]
+	 * \f]
+	 *
+	 * where \f$B\f$ and \f$C\f$ are the scaled blocks of the kernel between
+	 * the old and the new observations and among the new observations.
+	 *
+	 * @param features features of the new observations, which can be
+	 * merged with the training features
+	 * @param labels regression labels of the new observations
+	 */
+	void add_observations(
+		std::shared_ptr<Features> features, std::shared_ptr<Labels> labels);
+
+	/** remove observations from the training data, updating the Cholesky
+	 * factor and alpha of the current hyperparameters with one rank one
+	 * update of \f$O(n^2)\f$ per removed observation
+	 *
+	 * @param indices indices of the observations to remove
+	 */
+	void remove_observations(SGVector<index_t> indices);
+
         /** Set a minimizer
          *
          * @param minimizer minimizer used in inference method
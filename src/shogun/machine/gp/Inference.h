@@ -54,6 +54,7 @@ enum EInferenceType
 {
 	INF_NONE=0,
 	INF_EXACT=10,
+	INF_EXACT_ITERATIVE=11,
 	INF_SPARSE=20,
 	INF_FITC_REGRESSION=21,
 	INF_FITC_LAPLACE_SINGLE=22,
@@ -66,7 +67,8 @@ enum EInferenceType
 	INF_KL_CHOLESKY=52,
 	INF_KL_COVARIANCE=53,
 	INF_KL_DUAL=54,
-	INF_KL_SPARSE_REGRESSION=55
+	INF_KL_SPARSE_REGRESSION=55,
+	INF_KL_SPARSE_STOCHASTIC=56
 };
 
 /** @brief The Inference Method base class.
@@ -0,0 +1,585 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/machine/gp/IterativeExactInferenceMethod.h>
+
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/visitors/ShapeVisitor.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+#include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+	/** \f$scale^2 K+\sigma^2 I\f$ with the kernel evaluated in blocks */
+	class KernelMatrixOperator : public LinearOperator<float64_t>
+	{
+	public:
+		KernelMatrixOperator(
+			std::shared_ptr<Kernel> kernel, float64_t scale, float64_t shift)
+			: LinearOperator<float64_t>(kernel->get_num_vec_lhs()),
+			  m_kernel(std::move(kernel)), m_scale(scale), m_shift(shift),
+			  m_indices(m_dimension)
+		{
+			m_indices.range_fill();
+		}
+
+		SGVector<float64_t> apply(SGVector<float64_t> b) const override
+		{
+			SGMatrix<float64_t> B(b.vector, b.vlen, 1, false);
+			SGMatrix<float64_t> result=apply_block(B);
+
+			SGVector<float64_t> r(b.vlen);
+			Map<VectorXd>(r.vector, r.vlen)=
+				Map<VectorXd>(result.matrix, result.num_rows);
+			return r;
+		}
+
+		SGMatrix<float64_t> apply_block(SGMatrix<float64_t> B) const override
+		{
+			// symmetric kernel, so the weighted outputs are K*B
+			SGMatrix<float64_t> result=
+				m_kernel->compute_weighted_outputs(m_indices, B, m_indices);
+
+			Map<MatrixXd> R(result.matrix, result.num_rows, result.num_cols);
+			R=R*m_scale+Map<MatrixXd>(B.matrix, B.num_rows, B.num_cols)*m_shift;
+			return result;
+		}
+
+		const char* get_name() const override
+		{
+			return "KernelMatrixOperator";
+		}
+
+	private:
+		std::shared_ptr<Kernel> m_kernel;
+		float64_t m_scale;
+		float64_t m_shift;
+		SGVector<index_t> m_indices;
+	};
+
+	/** \f$(LL^T+\sigma^2 I)^{-1}\f$ by the Woodbury identity */
+	class WoodburyPreconditioner : public LinearOperator<float64_t>
+	{
+	public:
+		WoodburyPreconditioner(const SGMatrix<float64_t>& L, float64_t shift)
+			: LinearOperator<float64_t>(L.num_rows),
+			  m_L(L.matrix, L.num_rows, L.num_cols), m_shift(shift),
+			  m_llt(
+				  MatrixXd::Identity(L.num_cols, L.num_cols)*shift+
+				  m_L.transpose()*m_L)
+		{
+		}
+
+		SGVector<float64_t> apply(SGVector<float64_t> b) const override
+		{
+			SGVector<float64_t> r(b.vlen);
+			Map<VectorXd> x(b.vector, b.vlen);
+			Map<VectorXd>(r.vector, r.vlen)=
+				(x-m_L*m_llt.solve(m_L.transpose()*x))/m_shift;
+			return r;
+		}
+
+		SGMatrix<float64_t> apply_block(SGMatrix<float64_t> B) const override
+		{
+			SGMatrix<float64_t> result(B.num_rows, B.num_cols);
+			Map<MatrixXd> X(B.matrix, B.num_rows, B.num_cols);
+			Map<MatrixXd>(result.matrix, B.num_rows, B.num_cols)=
+				(X-m_L*m_llt.solve(m_L.transpose()*X))/m_shift;
+			return result;
+		}
+
+		const char* get_name() const override
+		{
+			return "WoodburyPreconditioner";
+		}
+
+	private:
+		Map<const MatrixXd> m_L;
+		float64_t m_shift;
+		LLT<MatrixXd> m_llt;
+	};
+
+	MatrixXd apply_block(
+		const std::shared_ptr<LinearOperator<float64_t>>& op, const MatrixXd& X)
+	{
+		SGMatrix<float64_t> x(X.rows(), X.cols());
+		Map<MatrixXd>(x.matrix, x.num_rows, x.num_cols)=X;
+
+		SGMatrix<float64_t> ax=op->apply_block(x);
+		return Map<MatrixXd>(ax.matrix, ax.num_rows, ax.num_cols);
+	}
+}
+
+IterativeExactInferenceMethod::IterativeExactInferenceMethod()
+	: RandomMixin<Inference>()
+{
+	init();
+}
+
+IterativeExactInferenceMethod::IterativeExactInferenceMethod(
+	std::shared_ptr<Kernel> kern, std::shared_ptr<Features> feat,
+	std::shared_ptr<MeanFunction> m, std::shared_ptr<Labels> lab,
+	std::shared_ptr<LikelihoodModel> mod)
+	: RandomMixin<Inference>(
+		  std::move(kern), std::move(feat), std::move(m), std::move(lab),
+		  std::move(mod))
+{
+	init();
+}
+
+void IterativeExactInferenceMethod::init()
+{
+	m_preconditioner_rank=20;
+	m_num_probe_vectors=10;
+	m_num_lanczos_steps=30;
+	m_tolerance=1E-8;
+	m_max_iterations=1000;
+	m_log_det=0;
+
+	SG_ADD(&m_preconditioner_rank, "preconditioner_rank",
+		"Rank of the pivoted Cholesky preconditioner",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_num_probe_vectors, "num_probe_vectors",
+		"Number of probe vectors of the trace estimates",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_num_lanczos_steps, "num_lanczos_steps",
+		"Maximum number of Lanczos steps", ParameterProperties::SETTING);
+	SG_ADD(&m_tolerance, "tolerance",
+		"Relative residual tolerance of conjugate gradients",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_max_iterations, "max_iterations",
+		"Maximum number of conjugate gradient iterations",
+		ParameterProperties::SETTING);
+	SG_ADD(&m_preconditioner_factor, "preconditioner_factor",
+		"Pivoted Cholesky factor of the scaled kernel matrix");
+	SG_ADD(&m_log_det, "log_det", "Estimate of the log-determinant");
+}
+
+IterativeExactInferenceMethod::~IterativeExactInferenceMethod()
+{
+}
+
+void IterativeExactInferenceMethod::register_minimizer(
+	std::shared_ptr<Minimizer> minimizer)
+{
+	io::warn("The method does not require a minimizer. The provided minimizer will not be used.");
+}
+
+void IterativeExactInferenceMethod::check_members() const
+{
+	Inference::check_members();
+
+	require(m_model->get_model_type()==LT_GAUSSIAN,
+		"Iterative exact inference method can only use Gaussian likelihood "
+		"function");
+	require(m_labels->get_label_type()==LT_REGRESSION,
+		"Labels must be type of CRegressionLabels");
+}
+
+float64_t IterativeExactInferenceMethod::get_noise_variance() const
+{
+	return Math::sq(m_model->as<GaussianLikelihood>()->get_sigma());
+}
+
+std::shared_ptr<LinearOperator<float64_t>>
+IterativeExactInferenceMethod::get_kernel_operator() const
+{
+	return std::make_shared<KernelMatrixOperator>(
+		m_kernel, std::exp(m_log_scale*2.0), get_noise_variance());
+}
+
+std::shared_ptr<LinearOperator<float64_t>>
+IterativeExactInferenceMethod::get_preconditioner() const
+{
+	if (m_preconditioner_factor.num_cols==0)
+		return nullptr;
+
+	return std::make_shared<WoodburyPreconditioner>(
+		m_preconditioner_factor, get_noise_variance());
+}
+
+void IterativeExactInferenceMethod::update()
+{
+	SG_TRACE("entering");
+
+	// unlike Inference::update(), the kernel matrix is not computed
+	check_members();
+	m_kernel->init(m_features, m_features);
+
+	update_chol();
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+
+	SG_TRACE("leaving");
+}
+
+SGMatrix<float64_t> IterativeExactInferenceMethod::solve(
+	const SGMatrix<float64_t>& B)
+{
+	if (parameter_hash_changed())
+		update();
+
+	auto solver=std::make_shared<ConjugateGradientSolver>();
+	solver->set_iteration_limit(m_max_iterations);
+	solver->set_relative_tolerence(m_tolerance);
+	solver->set_absolute_tolerence(0);
+	solver->set_preconditioner(get_preconditioner());
+
+	return solver->solve_block(get_kernel_operator(), B);
+}
+
+void IterativeExactInferenceMethod::update_chol()
+{
+	const index_t n=m_features->get_num_vectors();
+	const float64_t scale=std::exp(m_log_scale*2.0);
+	const float64_t noise=get_noise_variance();
+
+	// pivoted Cholesky factor of the scaled kernel matrix, each column
+	// needs one kernel row
+	const index_t rank=std::min<index_t>(m_preconditioner_rank, n);
+	SGVector<float64_t> diagonal=m_kernel->get_kernel_diagonal();
+	VectorXd d=Map<VectorXd>(diagonal.vector, n)*scale;
+	const float64_t trace=d.sum();
+
+	MatrixXd L(n, rank);
+	SGVector<index_t> all(n);
+	all.range_fill();
+	index_t k=0;
+	for (; k<rank; ++k)
+	{
+		index_t pivot;
+		const float64_t max_d=d.maxCoeff(&pivot);
+		if (max_d<=trace*std::numeric_limits<float64_t>::epsilon())
+			break;
+
+		SGVector<index_t> row_idx(1);
+		row_idx[0]=pivot;
+		SGMatrix<float64_t> row=m_kernel->get_kernel_block(row_idx, all);
+		Map<RowVectorXd> eigen_row(row.matrix, n);
+
+		L.col(k)=(eigen_row.transpose()*scale-
+			L.leftCols(k)*L.row(pivot).head(k).transpose())/std::sqrt(max_d);
+		d-=L.col(k).cwiseProduct(L.col(k));
+		d[pivot]=0;
+	}
+
+	m_preconditioner_factor=SGMatrix<float64_t>(n, k);
+	Map<MatrixXd> L_k(m_preconditioner_factor.matrix, n, k);
+	L_k=L.leftCols(k);
+
+	// log|P|=(n-k)log(sigma^2)+log|sigma^2 I+L_k^T L_k|
+	LLT<MatrixXd> llt(MatrixXd::Identity(k, k)*noise+L_k.transpose()*L_k);
+	m_log_det=(n-k)*std::log(noise)+
+		2.0*llt.matrixLLT().diagonal().array().log().sum();
+
+	// stochastic Lanczos quadrature of tr(log(P^{-1}K)), Lanczos runs on
+	// P^{-1}K, which is self-adjoint in the inner product of P, started
+	// from w=P^{-1}z with z~N(0,P)
+	auto op=get_kernel_operator();
+	auto preconditioner=get_preconditioner();
+	auto apply_P=[&](const MatrixXd& X) -> MatrixXd
+	{
+		return L_k*(L_k.transpose()*X)+X*noise;
+	};
+	auto apply_P_inv=[&](const MatrixXd& X) -> MatrixXd
+	{
+		return preconditioner ? apply_block(preconditioner, X) : X/noise;
+	};
+
+	const index_t num_probes=m_num_probe_vectors;
+	MatrixXd G(n+k, num_probes);
+	random::fill_array(
+		G.data(), G.data()+G.size(), NormalDistribution<float64_t>(), m_prng);
+	MatrixXd Z=L_k*G.bottomRows(k)+G.topRows(n)*std::sqrt(noise);
+
+	MatrixXd Q=apply_P_inv(Z);
+	VectorXd norms2=Z.cwiseProduct(Q).colwise().sum().transpose();
+	for (index_t j=0; j<num_probes; ++j)
+		Q.col(j)/=std::sqrt(norms2[j]);
+
+	MatrixXd Q_prev=MatrixXd::Zero(n, num_probes);
+	std::vector<std::vector<float64_t>> alphas(num_probes), betas(num_probes);
+	std::vector<index_t> active(num_probes);
+	for (index_t j=0; j<num_probes; ++j)
+		active[j]=j;
+
+	for (index_t step=0; step<m_num_lanczos_steps && !active.empty(); ++step)
+	{
+		MatrixXd Q_active(n, active.size());
+		for (index_t i=0; i<(index_t)active.size(); ++i)
+			Q_active.col(i)=Q.col(active[i]);
+
+		MatrixXd KQ=apply_block(op, Q_active);
+		MatrixXd V=apply_P_inv(KQ);
+
+		std::vector<index_t> still_active;
+		for (index_t i=0; i<(index_t)active.size(); ++i)
+		{
+			const index_t j=active[i];
+			const float64_t alpha=Q_active.col(i).dot(KQ.col(i));
+			alphas[j].push_back(alpha);
+
+			V.col(i)-=alpha*Q.col(j);
+			if (!betas[j].empty())
+				V.col(i)-=betas[j].back()*Q_prev.col(j);
+
+			const float64_t beta=std::sqrt(
+				std::max(V.col(i).dot(apply_P(V.col(i)).col(0)), 0.0));
+			if (beta<=1E-10*std::abs(alpha) || step+1==m_num_lanczos_steps)
+				continue;
+
+			betas[j].push_back(beta);
+			Q_prev.col(j)=Q.col(j);
+			Q.col(j)=V.col(i)/beta;
+			still_active.push_back(j);
+		}
+		active=std::move(still_active);
+	}
+
+	float64_t quadrature=0;
+	for (index_t j=0; j<num_probes; ++j)
+	{
+		const index_t size=alphas[j].size();
+		MatrixXd T=MatrixXd::Zero(size, size);
+		for (index_t i=0; i<size; ++i)
+		{
+			T(i, i)=alphas[j][i];
+			if (i+1<size)
+				T(i, i+1)=T(i+1, i)=betas[j][i];
+		}
+
+		SelfAdjointEigenSolver<MatrixXd> es(T);
+		quadrature+=norms2[j]*(es.eigenvectors().row(0).transpose().array().square()*
+			es.eigenvalues().array().log()).sum();
+	}
+	m_log_det+=quadrature/num_probes;
+}
+
+void IterativeExactInferenceMethod::update_alpha()
+{
+	SGVector<float64_t> y=regression_labels(m_labels)->get_labels();
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+
+	SGMatrix<float64_t> residual(y.vlen, 1);
+	Map<VectorXd>(residual.matrix, y.vlen)=
+		Map<VectorXd>(y.vector, y.vlen)-Map<VectorXd>(m.vector, m.vlen);
+
+	auto solver=std::make_shared<ConjugateGradientSolver>();
+	solver->set_iteration_limit(m_max_iterations);
+	solver->set_relative_tolerence(m_tolerance);
+	solver->set_absolute_tolerence(0);
+	solver->set_preconditioner(get_preconditioner());
+	SGMatrix<float64_t> alpha=
+		solver->solve_block(get_kernel_operator(), residual);
+
+	m_alpha=SGVector<float64_t>(y.vlen);
+	Map<VectorXd>(m_alpha.vector, m_alpha.vlen)=
+		Map<VectorXd>(alpha.matrix, y.vlen);
+}
+
+float64_t IterativeExactInferenceMethod::get_negative_log_marginal_likelihood()
+{
+	if (parameter_hash_changed())
+		update();
+
+	SGVector<float64_t> y=regression_labels(m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	// nlZ=(y-m)'*alpha/2+log|K|/2+n*log(2*pi)/2
+	return (eigen_y-eigen_m).dot(eigen_alpha)/2.0+m_log_det/2.0+
+		y.vlen*std::log(2*Math::PI)/2.0;
+}
+
+SGVector<float64_t> IterativeExactInferenceMethod::get_alpha()
+{
+	if (parameter_hash_changed())
+		update();
+
+	return SGVector<float64_t>(m_alpha);
+}
+
+SGMatrix<float64_t> IterativeExactInferenceMethod::get_cholesky()
+{
+	error("{} does not factorize the kernel matrix, use solve()", get_name());
+	return SGMatrix<float64_t>();
+}
+
+SGVector<float64_t> IterativeExactInferenceMethod::get_diagonal_vector()
+{
+	if (parameter_hash_changed())
+		update();
+
+	SGVector<float64_t> result(m_features->get_num_vectors());
+	result.set_const(1.0/std::sqrt(get_noise_variance()));
+
+	return result;
+}
+
+SGVector<float64_t> IterativeExactInferenceMethod::get_posterior_mean()
+{
+	if (parameter_hash_changed())
+		update();
+
+	// mu=K*scale^2*alpha=(K*scale^2+sigma^2*I)*alpha-sigma^2*alpha
+	SGVector<float64_t> result=get_kernel_operator()->apply(m_alpha);
+	Map<VectorXd>(result.vector, result.vlen)-=
+		Map<VectorXd>(m_alpha.vector, m_alpha.vlen)*get_noise_variance();
+
+	return result;
+}
+
+SGMatrix<float64_t> IterativeExactInferenceMethod::get_posterior_covariance()
+{
+	error("{} does not compute the dense posterior covariance", get_name());
+	return SGMatrix<float64_t>();
+}
+
+void IterativeExactInferenceMethod::compute_gradient()
+{
+	Inference::compute_gradient();
+
+	if (!m_gradient_update)
+	{
+		update_deriv();
+		m_gradient_update=true;
+		update_parameter_hash();
+	}
+}
+
+void IterativeExactInferenceMethod::update_deriv()
+{
+	const index_t n=m_features->get_num_vectors();
+
+	m_probes=SGMatrix<float64_t>(n, m_num_probe_vectors);
+	random::fill_array(m_probes, NormalDistribution<float64_t>(), m_prng);
+	m_probe_solutions=solve(m_probes);
+}
+
+SGVector<float64_t>
+IterativeExactInferenceMethod::get_derivative_wrt_inference_method(
+	Parameters::const_reference param)
+{
+	require(param.first == "log_scale", "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt {}.{} parameter",
+			get_name(), param.first);
+
+	const index_t n=m_alpha.vlen;
+	const float64_t noise=get_noise_variance();
+	Map<VectorXd> eigen_alpha(m_alpha.vector, n);
+	Map<MatrixXd> Z(m_probes.matrix, n, m_probes.num_cols);
+	Map<MatrixXd> W(m_probe_solutions.matrix, n, m_probe_solutions.num_cols);
+
+	SGVector<float64_t> y=regression_labels(m_labels)->get_labels();
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+
+	// dnlZ=tr(inv(K)*K*scale^2)-alpha'*K*scale^2*alpha
+	// =n-sigma^2*tr(inv(K))-alpha'*(y-m)+sigma^2*alpha'*alpha
+	const float64_t trace=Z.cwiseProduct(W).sum()/Z.cols();
+	SGVector<float64_t> result(1);
+	result[0]=n-noise*trace-eigen_alpha.dot(eigen_y-eigen_m)+
+		noise*eigen_alpha.squaredNorm();
+
+	return result;
+}
+
+SGVector<float64_t>
+IterativeExactInferenceMethod::get_derivative_wrt_likelihood_model(
+	Parameters::const_reference param)
+{
+	require(param.first == "log_sigma", "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt {}.{} parameter",
+			m_model->get_name(), param.first);
+
+	const index_t n=m_alpha.vlen;
+	Map<VectorXd> eigen_alpha(m_alpha.vector, n);
+	Map<MatrixXd> Z(m_probes.matrix, n, m_probes.num_cols);
+	Map<MatrixXd> W(m_probe_solutions.matrix, n, m_probe_solutions.num_cols);
+
+	// dnlZ=sigma^2*(tr(inv(K))-alpha'*alpha)
+	const float64_t trace=Z.cwiseProduct(W).sum()/Z.cols();
+	SGVector<float64_t> result(1);
+	result[0]=get_noise_variance()*(trace-eigen_alpha.squaredNorm());
+
+	return result;
+}
+
+SGVector<float64_t> IterativeExactInferenceMethod::get_derivative_wrt_kernel(
+	Parameters::const_reference param)
+{
+	const index_t n=m_alpha.vlen;
+	Map<VectorXd> eigen_alpha(m_alpha.vector, n);
+	Map<MatrixXd> Z(m_probes.matrix, n, m_probes.num_cols);
+	Map<MatrixXd> W(m_probe_solutions.matrix, n, m_probe_solutions.num_cols);
+
+	SGVector<float64_t> result;
+	auto visitor = std::make_unique<ShapeVisitor>();
+	param.second->get_value().visit(visitor.get());
+	int64_t len= visitor->get_size();
+	result=SGVector<float64_t>(len);
+
+	// the traces of the elements are independent
+	auto gradients=m_kernel->get_parameter_gradients(param, result.vlen);
+	#pragma omp parallel for
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		SGMatrix<float64_t> dK=gradients[i];
+		Map<MatrixXd> eigen_dK(dK.matrix, dK.num_rows, dK.num_cols);
+
+		// dnlZ=(tr(inv(K)*dK)-alpha'*dK*alpha)*scale^2/2
+		const float64_t trace=W.cwiseProduct(eigen_dK*Z).sum()/Z.cols();
+		result[i]=trace-eigen_alpha.dot(eigen_dK*eigen_alpha);
+		result[i]*=std::exp(m_log_scale*2.0)/2.0;
+	}
+
+	return result;
+}
+
+SGVector<float64_t> IterativeExactInferenceMethod::get_derivative_wrt_mean(
+	Parameters::const_reference param)
+{
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	SGVector<float64_t> result;
+	auto visitor = std::make_unique<ShapeVisitor>();
+	param.second->get_value().visit(visitor.get());
+	int64_t len= visitor->get_size();
+	result=SGVector<float64_t>(len);
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		SGVector<float64_t> dmu;
+
+		if (result.vlen==1)
+			dmu=m_mean->get_parameter_derivative(m_features, param);
+		else
+			dmu=m_mean->get_parameter_derivative(m_features, param, i);
+
+		Map<VectorXd> eigen_dmu(dmu.vector, dmu.vlen);
+
+		// compute derivative wrt mean parameter: dnlZ=-dmu'*alpha
+		result[i]=-eigen_dmu.dot(eigen_alpha);
+	}
+
+	return result;
+}
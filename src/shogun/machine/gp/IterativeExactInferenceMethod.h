@@ -0,0 +1,260 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef ITERATIVEEXACTINFERENCEMETHOD_H_
+#define ITERATIVEEXACTINFERENCEMETHOD_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/machine/gp/Inference.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+namespace shogun
+{
+template <class T> class LinearOperator;
+
+/** @brief Exact inference for GP regression with a Gaussian likelihood that
+ * never forms the kernel matrix, in the spirit of blackbox matrix-matrix
+ * inference (BBMM).
+ *
+ * All computations only apply \f$\hat{K}=K\cdot scale^2+\sigma^2 I\f$ to
+ * blocks of vectors, evaluating the kernel on the fly in blocks through
+ * Kernel::compute_weighted_outputs. Memory is linear in the number of
+ * training vectors.
+ *
+ * - \f$\alpha=\hat{K}^{-1}(y-m)\f$ is solved with preconditioned conjugate
+ *   gradients. The preconditioner is \f$P=L_kL_k^T+\sigma^2 I\f$, where
+ *   \f$L_k\f$ is the rank k pivoted Cholesky factor of the scaled kernel
+ *   matrix, applied with the Woodbury identity.
+ * - \f$\log|\hat{K}|=\log|P|+\mathrm{tr}\log(P^{-1}\hat{K})\f$, where the
+ *   trace is estimated by stochastic Lanczos quadrature with probe vectors
+ *   \f$z\sim\mathcal{N}(0,P)\f$ in the inner product of \f$P\f$.
+ * - The traces of the derivatives are estimated with the same number of
+ *   Gaussian probe vectors, whose systems are solved at once.
+ *
+ * The posterior covariance and the Cholesky factor are not available,
+ * GaussianProcessRegression computes predictive variances with solve().
+ * Derivatives wrt kernel parameters use the kernel's gradient matrices and
+ * thus quadratic memory.
+ *
+ * Reference: J. R. Gardner, G. Pleiss, D. Bindel, K. Q. Weinberger,
+ * A. G. Wilson, "GPyTorch: Blackbox Matrix-Matrix Gaussian Process Inference
+ * with GPU Acceleration", NeurIPS 2018.
+ */
+class IterativeExactInferenceMethod : public RandomMixin<Inference>
+{
+public:
+	/** default constructor */
+	IterativeExactInferenceMethod();
+
+	/** constructor
+	 *
+	 * @param kernel covariance function
+	 * @param features features to use in inference
+	 * @param mean mean function to use
+	 * @param labels labels of the features
+	 * @param model likelihood model to use
+	 */
+	IterativeExactInferenceMethod(
+		std::shared_ptr<Kernel> kernel, std::shared_ptr<Features> features,
+		std::shared_ptr<MeanFunction> mean, std::shared_ptr<Labels> labels,
+		std::shared_ptr<LikelihoodModel> model);
+
+	~IterativeExactInferenceMethod() override;
+
+	/** return what type of inference we are
+	 *
+	 * @return inference type EXACT_ITERATIVE
+	 */
+	EInferenceType get_inference_type() const override
+	{
+		return INF_EXACT_ITERATIVE;
+	}
+
+	/** returns the name of the inference method
+	 *
+	 * @return name IterativeExactInferenceMethod
+	 */
+	const char* get_name() const override
+	{
+		return "IterativeExactInferenceMethod";
+	}
+
+	/** get negative log marginal likelihood, with the log-determinant
+	 * estimated by stochastic Lanczos quadrature
+	 *
+	 * @return the negative log of the marginal likelihood function:
+	 *
+	 * \f[
+	 * -log(p(y|X, \theta))
+	 * \f]
+	 */
+	float64_t get_negative_log_marginal_likelihood() override;
+
+	/** get alpha vector
+	 *
+	 * @return vector to compute posterior mean of Gaussian Process:
+	 *
+	 * \f[
+	 * \mu = K\alpha
+	 * \f]
+	 */
+	SGVector<float64_t> get_alpha() override;
+
+	/** not available, the kernel matrix is never factorized */
+	SGMatrix<float64_t> get_cholesky() override;
+
+	/** get diagonal vector
+	 *
+	 * @return vector of \f$1/\sigma\f$
+	 */
+	SGVector<float64_t> get_diagonal_vector() override;
+
+	/** returns mean vector \f$\mu\f$ of the posterior Gaussian distribution
+	 *
+	 * @return mean vector
+	 */
+	SGVector<float64_t> get_posterior_mean() override;
+
+	/** not available, the posterior covariance is a dense matrix */
+	SGMatrix<float64_t> get_posterior_covariance() override;
+
+	/** solve \f$\hat{K}X=B\f$ with preconditioned conjugate gradients,
+	 * one system per column
+	 *
+	 * @param B right hand sides
+	 * @return solutions
+	 */
+	SGMatrix<float64_t> solve(const SGMatrix<float64_t>& B);
+
+	/**
+	 * @return whether combination of the inference method and given
+	 * likelihood function supports regression
+	 */
+	bool supports_regression() const override
+	{
+		check_members();
+		return m_model->supports_regression();
+	}
+
+	/** update alpha and the log-determinant, except gradients */
+	void update() override;
+
+	/** Set a minimizer
+	 *
+	 * @param minimizer minimizer used in inference method
+	 */
+	void register_minimizer(std::shared_ptr<Minimizer> minimizer) override;
+
+	/** @param rank rank of the pivoted Cholesky preconditioner, 0 for none */
+	void set_preconditioner_rank(int32_t rank)
+	{
+		m_preconditioner_rank=rank;
+	}
+
+	/** @param num_probe_vectors number of probe vectors of the stochastic
+	 * trace estimates
+	 */
+	void set_num_probe_vectors(int32_t num_probe_vectors)
+	{
+		m_num_probe_vectors=num_probe_vectors;
+	}
+
+	/** @param num_lanczos_steps maximum number of Lanczos steps of the
+	 * log-determinant estimate
+	 */
+	void set_num_lanczos_steps(int32_t num_lanczos_steps)
+	{
+		m_num_lanczos_steps=num_lanczos_steps;
+	}
+
+	/** @param tolerance relative residual tolerance of conjugate gradients */
+	void set_tolerance(float64_t tolerance)
+	{
+		m_tolerance=tolerance;
+	}
+
+	/** @param max_iterations maximum number of conjugate gradient
+	 * iterations
+	 */
+	void set_max_iterations(int32_t max_iterations)
+	{
+		m_max_iterations=max_iterations;
+	}
+
+protected:
+	/** check if members of object are valid for inference */
+	void check_members() const override;
+
+	/** update alpha vector */
+	void update_alpha() override;
+
+	/** update the preconditioner and the log-determinant, which replace the
+	 * Cholesky factor
+	 */
+	void update_chol() override;
+
+	/** update the probe vectors and their solutions which estimate the
+	 * traces of the derivatives
+	 */
+	void update_deriv() override;
+
+	SGVector<float64_t> get_derivative_wrt_inference_method(
+		Parameters::const_reference param) override;
+
+	SGVector<float64_t> get_derivative_wrt_likelihood_model(
+		Parameters::const_reference param) override;
+
+	SGVector<float64_t> get_derivative_wrt_kernel(
+		Parameters::const_reference param) override;
+
+	SGVector<float64_t> get_derivative_wrt_mean(
+		Parameters::const_reference param) override;
+
+	/** update gradients */
+	void compute_gradient() override;
+
+private:
+	void init();
+
+	/** @return operator \f$\hat{K}\f$ on the training features */
+	std::shared_ptr<LinearOperator<float64_t>> get_kernel_operator() const;
+
+	/** @return preconditioner \f$P^{-1}\f$, nullptr for rank 0 */
+	std::shared_ptr<LinearOperator<float64_t>> get_preconditioner() const;
+
+	/** @return noise variance \f$\sigma^2\f$ of the Gaussian likelihood */
+	float64_t get_noise_variance() const;
+
+	/** rank of the pivoted Cholesky preconditioner */
+	int32_t m_preconditioner_rank;
+
+	/** number of probe vectors of the trace estimates */
+	int32_t m_num_probe_vectors;
+
+	/** maximum number of Lanczos steps */
+	int32_t m_num_lanczos_steps;
+
+	/** relative residual tolerance of conjugate gradients */
+	float64_t m_tolerance;
+
+	/** maximum number of conjugate gradient iterations */
+	int32_t m_max_iterations;
+
+	/** pivoted Cholesky factor \f$L_k\f$ of the scaled kernel matrix */
+	SGMatrix<float64_t> m_preconditioner_factor;
+
+	/** estimate of \f$\log|\hat{K}|\f$ */
+	float64_t m_log_det;
+
+	/** probe vectors of the derivatives, one per column */
+	SGMatrix<float64_t> m_probes;
+
+	/** \f$\hat{K}^{-1}\f$ applied to the probe vectors */
+	SGMatrix<float64_t> m_probe_solutions;
+};
+}
+#endif /* ITERATIVEEXACTINFERENCEMETHOD_H_ */
@@ -63,8 +63,7 @@ namespace shogun
 class CMultiPsiLine : public func_base
 {
 public:
-	float64_t log_scale;
-	MatrixXd K;
+	const MatrixXd* K;
 	VectorXd dalpha;
 	VectorXd start_alpha;
 	Map<VectorXd>* alpha;
@@ -81,17 +80,15 @@ public:
 		Map<VectorXd> eigen_f(f->vector, f->vlen);
 		Map<VectorXd> eigen_m(m->vector, m->vlen);
 
-		// compute alpha=alpha+x*dalpha and f=K*alpha+m
+		// compute alpha=alpha+x*dalpha and f=K*alpha+m, with the blocks of
+		// all classes as columns of one matrix
 		(*alpha)=start_alpha+x*dalpha;
+		Map<MatrixXd> alpha_matrix(alpha->data(), n, C);
+		Map<MatrixXd> f_matrix(eigen_f.data(), n, C);
+		f_matrix.noalias()=(*K)*alpha_matrix;
 
-		float64_t result=0;
-		for(index_t bl=0; bl<C; bl++)
-		{
-			eigen_f.block(bl * n, 0, n, 1) =
-				K * alpha->block(bl * n, 0, n, 1) * std::exp(log_scale * 2.0);
-			result+=alpha->block(bl*n,0,n,1).dot(eigen_f.block(bl*n,0,n,1))/2.0;
-			eigen_f.block(bl*n,0,n,1)+=eigen_m;
-		}
+		float64_t result=alpha->dot(eigen_f)/2.0;
+		f_matrix.colwise()+=eigen_m;
 
 		// get first and second derivatives of log likelihood
 		(*dlp)=lik->get_log_probability_derivative_f(lab, (*f), 1);
@@ -309,6 +306,10 @@ void MultiLaplaceInferenceMethod::update_alpha()
 	index_t iter=0;
 	Map<MatrixXd> & eigen_M=eigen_L;
 
+	// scaled kernel matrix used in all Newton steps
+	const MatrixXd eigen_K=eigen_ktrtr*std::exp(m_log_scale*2.0);
+	SGVector<float64_t> log_det(C);
+
 	while (Psi_Old-Psi_New>m_tolerance && iter<m_iter)
 	{
 		Map<VectorXd> eigen_dlp(m_dlp.vector, m_dlp.vlen);
@@ -322,24 +323,32 @@ void MultiLaplaceInferenceMethod::update_alpha()
 
 		m_nlz=0;
 
+		// the classes are independent given pi, so their factorizations
+		// E_c = sD_c * (I + sD_c * K * sD_c)^{-1} * sD_c run in parallel
+		#pragma omp parallel for
 		for(index_t bl=0; bl<C; bl++)
 		{
 			VectorXd eigen_sD=eigen_dpi.block(bl*n,0,n,1).cwiseSqrt();
-			LLT<MatrixXd> chol_tmp(
-				(eigen_sD * eigen_sD.transpose())
-				    .cwiseProduct(eigen_ktrtr * std::exp(m_log_scale * 2.0)) +
-				MatrixXd::Identity(m_ktrtr.num_rows, m_ktrtr.num_cols));
-			MatrixXd eigen_L_tmp=chol_tmp.matrixU();
-			MatrixXd eigen_E_bl=eigen_L_tmp.triangularView<Upper>().adjoint().solve(MatrixXd(eigen_sD.asDiagonal()));
-			eigen_E_bl=eigen_E_bl.transpose()*eigen_E_bl;
-			eigen_E.block(0,bl*n,n,n)=eigen_E_bl;
-			if (bl==0)
-				eigen_M=eigen_E_bl;
-			else
-				eigen_M+=eigen_E_bl;
-			m_nlz+=eigen_L_tmp.diagonal().array().log().sum();
+			MatrixXd eigen_B=eigen_sD.asDiagonal()*eigen_K*eigen_sD.asDiagonal();
+			eigen_B.diagonal().array()+=1.0;
+			LLT<Ref<MatrixXd>> chol_tmp(eigen_B);
+
+			// V = L^{-1} * sD and E_c = V' * V, of which only the lower
+			// triangle is computed
+			MatrixXd eigen_V=eigen_sD.asDiagonal();
+			chol_tmp.matrixL().solveInPlace(eigen_V);
+			auto eigen_E_bl=eigen_E.block(0,bl*n,n,n);
+			eigen_E_bl.setZero();
+			eigen_E_bl.selfadjointView<Lower>().rankUpdate(eigen_V.adjoint());
+			eigen_E_bl.triangularView<StrictlyUpper>()=eigen_E_bl.adjoint();
+			log_det[bl]=chol_tmp.matrixLLT().diagonal().array().log().sum();
 		}
 
+		eigen_M=eigen_E.block(0,0,n,n);
+		for(index_t bl=1; bl<C; bl++)
+			eigen_M+=eigen_E.block(0,bl*n,n,n);
+		m_nlz+=SGVector<float64_t>::sum(log_det);
+
 		LLT<MatrixXd> chol_tmp(eigen_M);
 		eigen_M = chol_tmp.matrixU();
 		m_nlz+=eigen_M.diagonal().array().log().sum();
@@ -354,11 +363,12 @@ void MultiLaplaceInferenceMethod::update_alpha()
 			eigen_b.block(bl*n,0,n,1)+=eigen_dpi.block(bl*n,0,n,1).cwiseProduct(eigen_mu.block(bl*n,0,n,1)-eigen_mean_bl-tmp2);
 
 		Map<VectorXd> &eigen_c=eigen_W;
+		Map<MatrixXd> b_tmp(eigen_b.data(),n,C);
+		MatrixXd Kb=eigen_K*b_tmp;
+		#pragma omp parallel for
 		for(index_t bl=0; bl<C; bl++)
-			eigen_c.block(bl * n, 0, n, 1) =
-				eigen_E.block(0, bl * n, n, n) *
-				(eigen_ktrtr * std::exp(m_log_scale * 2.0) *
-				 eigen_b.block(bl * n, 0, n, 1));
+			eigen_c.block(bl * n, 0, n, 1).noalias() =
+				eigen_E.block(0, bl * n, n, n) * Kb.col(bl);
 
 		Map<MatrixXd> c_tmp(eigen_c.data(),n,C);
 
@@ -371,8 +381,7 @@ void MultiLaplaceInferenceMethod::update_alpha()
 		// perform Brent's optimization
 		CMultiPsiLine func;
 
-		func.log_scale=m_log_scale;
-		func.K=eigen_ktrtr;
+		func.K=&eigen_K;
 		func.dalpha=eigen_dalpha;
 		func.start_alpha=eigen_alpha;
 		func.alpha=&eigen_alpha;
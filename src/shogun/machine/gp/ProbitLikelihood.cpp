@@ -32,6 +32,7 @@
 
 
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Statistics.h>
 
@@ -91,16 +92,13 @@ SGVector<float64_t> ProbitLikelihood::get_log_probability_f(std::shared_ptr<cons
 
 	Map<VectorXd> eigen_f(func.vector, func.vlen);
 
-	SGVector<float64_t> r(func.vlen);
-	Map<VectorXd> eigen_r(r.vector, r.vlen);
+	SGVector<float64_t> yf(func.vlen);
+	Map<VectorXd> eigen_yf(yf.vector, yf.vlen);
 
 	// compute log pobability: log(normal_cdf(f.*y))
-	eigen_r=eigen_y.cwiseProduct(eigen_f);
-
-	for (index_t i=0; i<eigen_r.size(); i++)
-		eigen_r[i]=Statistics::lnormal_cdf(eigen_r[i]);
+	eigen_yf=eigen_y.cwiseProduct(eigen_f);
 
-	return r;
+	return Statistics::lnormal_cdf(yf);
 }
 
 SGVector<float64_t> ProbitLikelihood::get_log_probability_derivative_f(
@@ -122,7 +120,16 @@ SGVector<float64_t> ProbitLikelihood::get_log_probability_derivative_f(
 	SGVector<float64_t> dlp(func.vlen);
 	Map<VectorXd> eigen_dlp(dlp.vector, dlp.vlen);
 
-	VectorXd eigen_yf=eigen_y.cwiseProduct(eigen_f);
+	SGVector<float64_t> yf(func.vlen);
+	Map<VectorXd> eigen_yf(yf.vector, yf.vlen);
+	eigen_yf=eigen_y.cwiseProduct(eigen_f);
+
+	//dlp(~id2) = exp(-z(~id2).*z(~id2)/2-lp(~id2))/sqrt(2*pi); % safe computation
+	SGVector<float64_t> lp=Statistics::lnormal_cdf(yf);
+	Map<VectorXd> eigen_lp(lp.vector, lp.vlen);
+	eigen_dlp.array()=-eigen_yf.array().square()/2.0-eigen_lp.array();
+	simd::exp(dlp.vector, dlp.vector, dlp.vlen);
+	eigen_dlp/=std::sqrt(2.0*Math::PI);
 
 	for (index_t j=0; j<eigen_yf.size(); j++)
 	{
@@ -133,13 +140,6 @@ SGVector<float64_t> ProbitLikelihood::get_log_probability_derivative_f(
 			eigen_dlp[j] = std::sqrt(2.0 / Math::PI) /
 			               Math::abs(Statistics::erfc8_weighted_sum(v));
 		}
-		else
-		{
-			//dlp(~id2) = exp(-z(~id2).*z(~id2)/2-lp(~id2))/sqrt(2*pi); % safe computation
-			eigen_dlp[j] =
-			    std::exp(-v * v / 2.0 - Statistics::lnormal_cdf(v)) /
-			    std::sqrt(2.0 * Math::PI);
-		}
 	}
 
 	SGVector<float64_t> r(func.vlen);
@@ -197,16 +197,13 @@ SGVector<float64_t> ProbitLikelihood::get_log_zeroth_moments(
 	Map<VectorXd> eigen_mu(mu.vector, mu.vlen);
 	Map<VectorXd> eigen_s2(s2.vector, s2.vlen);
 
-	SGVector<float64_t> r(y.vlen);
-	Map<VectorXd> eigen_r(r.vector, r.vlen);
+	SGVector<float64_t> z(y.vlen);
+	Map<VectorXd> eigen_z(z.vector, z.vlen);
 
 	// compute: lp=log(normal_cdf((mu.*y)./sqrt(1+sigma^2)))
-	eigen_r=eigen_mu.array()*eigen_y.array()/((1.0+eigen_s2.array()).sqrt());
-
-	for (index_t i=0; i<eigen_r.size(); i++)
-		eigen_r[i]=Statistics::lnormal_cdf(eigen_r[i]);
+	eigen_z=eigen_mu.array()*eigen_y.array()/((1.0+eigen_s2.array()).sqrt());
 
-	return r;
+	return Statistics::lnormal_cdf(z);
 }
 
 float64_t ProbitLikelihood::get_first_moment(SGVector<float64_t> mu,
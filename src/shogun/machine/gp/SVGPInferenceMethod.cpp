@@ -0,0 +1,525 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/machine/gp/SVGPInferenceMethod.h>
+
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/optimization/AdamUpdater.h>
+#include <shogun/optimization/FirstOrderStochasticCostFunction.h>
+#include <shogun/optimization/SGDMinimizer.h>
+
+#include <utility>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+	/** @return number of variational parameters for m inducing features */
+	index_t num_variational(index_t m)
+	{
+		return m + m * (m + 1) / 2;
+	}
+
+	/** @return lower triangular matrix from its packed columns */
+	MatrixXd unpack_lower(const float64_t* packed, index_t m)
+	{
+		MatrixXd L = MatrixXd::Zero(m, m);
+		for (index_t j = 0; j < m; j++)
+		{
+			L.col(j).tail(m - j) = Map<const VectorXd>(packed, m - j);
+			packed += m - j;
+		}
+		return L;
+	}
+
+	/** pack the columns of the lower triangle of a matrix */
+	void pack_lower(const MatrixXd& L, float64_t* packed)
+	{
+		const index_t m = L.rows();
+		for (index_t j = 0; j < m; j++)
+		{
+			Map<VectorXd>(packed, m - j) = L.col(j).tail(m - j);
+			packed += m - j;
+		}
+	}
+} // namespace
+
+namespace shogun
+{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** the negative evidence lower bound as a sum over minibatches, every
+ * sample of the stochastic cost function is one minibatch */
+class SVGPInferenceCostFunction: public FirstOrderStochasticCostFunction
+{
+public:
+	SVGPInferenceCostFunction():FirstOrderStochasticCostFunction() { init(); }
+	~SVGPInferenceCostFunction() override { }
+
+	void set_target(const std::shared_ptr<SVGPInferenceMethod>& obj)
+	{
+		require(obj, "Obj must set");
+		m_obj=obj;
+	}
+
+	void begin_sample() override
+	{
+		require(m_obj, "Object not set");
+		m_order=SGVector<index_t>(m_obj->m_features->get_num_vectors());
+		m_order.range_fill();
+		random::parallel_shuffle(m_order, m_obj->m_prng);
+		m_position=0;
+	}
+
+	bool next_sample() override
+	{
+		require(m_obj, "Object not set");
+		if (m_position>=m_order.vlen)
+			return false;
+
+		const index_t size=std::min<index_t>(
+			m_obj->m_minibatch_size, m_order.vlen-m_position);
+		m_minibatch=SGVector<index_t>(size);
+		sg_memcpy(m_minibatch.vector, m_order.vector+m_position,
+			size*sizeof(index_t));
+		m_position+=size;
+		return true;
+	}
+
+	SGVector<float64_t> obtain_variable_reference() override
+	{
+		require(m_obj, "Object not set");
+		return m_obj->m_variational;
+	}
+
+	SGVector<float64_t> get_gradient() override
+	{
+		require(m_obj, "Object not set");
+		SGVector<float64_t> gradient(m_obj->m_variational.vlen);
+		m_obj->get_minibatch_bound(m_minibatch, gradient);
+		return gradient;
+	}
+
+	/** estimate of the negative bound from the current minibatch */
+	float64_t get_cost() override
+	{
+		require(m_obj, "Object not set");
+		if (!m_minibatch.vlen)
+		{
+			begin_sample();
+			next_sample();
+		}
+		return -m_obj->m_features->get_num_vectors()*
+			m_obj->get_minibatch_bound(m_minibatch, SGVector<float64_t>());
+	}
+
+	const char* get_name() const override { return "SVGPInferenceCostFunction"; }
+
+private:
+	void init()
+	{
+		m_obj=NULL;
+		m_position=0;
+		SG_ADD((std::shared_ptr<SGObject>*)&m_obj, "SVGPInferenceCostFunction__m_obj",
+			"obj in SVGPInferenceCostFunction");
+	}
+
+	std::shared_ptr<SVGPInferenceMethod> m_obj;
+	/** random order of the training vectors of the current pass */
+	SGVector<index_t> m_order;
+	/** position of the next minibatch in m_order */
+	index_t m_position;
+	/** indices of the current minibatch */
+	SGVector<index_t> m_minibatch;
+};
+#endif //DOXYGEN_SHOULD_SKIP_THIS
+
+}
+
+SVGPInferenceMethod::SVGPInferenceMethod() : RandomMixin<SparseInference>()
+{
+	init();
+}
+
+SVGPInferenceMethod::SVGPInferenceMethod(std::shared_ptr<Kernel> kern, std::shared_ptr<Features> feat,
+		std::shared_ptr<MeanFunction> m, std::shared_ptr<Labels> lab, std::shared_ptr<LikelihoodModel> mod,
+		std::shared_ptr<Features> lat)
+		: RandomMixin<SparseInference>(std::move(kern), std::move(feat), std::move(m), std::move(lab), std::move(mod), std::move(lat))
+{
+	init();
+	get_variational_likelihood();
+}
+
+void SVGPInferenceMethod::init()
+{
+	m_minibatch_size=256;
+	m_variational=SGVector<float64_t>();
+	m_chol_kuu=SGMatrix<float64_t>();
+
+	SG_ADD(&m_minibatch_size, "minibatch_size",
+		"Number of training vectors per step", ParameterProperties::SETTING);
+	SG_ADD(&m_variational, "variational_parameters",
+		"Mean and Cholesky factor of the whitened variational distribution",
+		ParameterProperties::MODEL);
+	SG_ADD(&m_chol_kuu, "chol_kuu",
+		"Cholesky factor of the kernel matrix of inducing features");
+
+	auto minimizer=std::make_shared<SGDMinimizer>();
+	minimizer->set_gradient_updater(
+		std::make_shared<AdamUpdater>(0.01, 1e-8, 0.9, 0.999));
+	minimizer->set_number_passes(10);
+	register_minimizer(minimizer);
+}
+
+SVGPInferenceMethod::~SVGPInferenceMethod()
+{
+}
+
+std::shared_ptr<SVGPInferenceMethod> SVGPInferenceMethod::obtain_from_generic(
+		const std::shared_ptr<Inference>& inference)
+{
+	if (inference==NULL)
+		return NULL;
+
+	if (inference->get_inference_type()!=INF_KL_SPARSE_STOCHASTIC)
+		error("Provided inference is not of type SVGPInferenceMethod!");
+
+	return inference->as<SVGPInferenceMethod>();
+}
+
+void SVGPInferenceMethod::set_minibatch_size(int32_t minibatch_size)
+{
+	require(minibatch_size>0, "The minibatch size ({}) must be positive",
+		minibatch_size);
+	m_minibatch_size=minibatch_size;
+}
+
+void SVGPInferenceMethod::set_model(std::shared_ptr<LikelihoodModel> mod)
+{
+	require(std::dynamic_pointer_cast<VariationalGaussianLikelihood>(mod),
+		"{} requires a variational Gaussian likelihood, not {}", get_name(),
+		mod ? mod->get_name() : "NULL");
+	Inference::set_model(std::move(mod));
+}
+
+void SVGPInferenceMethod::register_minimizer(std::shared_ptr<Minimizer> minimizer)
+{
+	require(std::dynamic_pointer_cast<FirstOrderStochasticMinimizer>(minimizer),
+		"FirstOrderStochasticMinimizer is required");
+	Inference::register_minimizer(minimizer);
+}
+
+std::shared_ptr<VariationalGaussianLikelihood> SVGPInferenceMethod::get_variational_likelihood() const
+{
+	auto lik=std::dynamic_pointer_cast<VariationalGaussianLikelihood>(m_model);
+	require(lik, "{} requires a variational Gaussian likelihood, not {}",
+		get_name(), m_model ? m_model->get_name() : "NULL");
+	return lik;
+}
+
+void SVGPInferenceMethod::check_members() const
+{
+	SparseInference::check_members();
+
+	get_variational_likelihood();
+	require(m_model->supports_regression() || m_model->supports_binary(),
+		"{} supports regression and binary classification only", get_name());
+}
+
+void SVGPInferenceMethod::update_train_kernel()
+{
+	check_features();
+	convert_features();
+
+	// the kernels of the training vectors are computed per minibatch
+	auto inducing_features=get_inducing_features();
+	m_kernel->init(inducing_features, inducing_features);
+	m_kuu=m_kernel->get_kernel_matrix();
+}
+
+void SVGPInferenceMethod::update()
+{
+	SG_TRACE("entering");
+
+	Inference::update();
+	update_chol();
+	optimize_variational_parameters();
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+
+	SG_TRACE("leaving");
+}
+
+void SVGPInferenceMethod::update_chol()
+{
+	// Luu = chol(Kuu*scale^2 + noise*I)
+	Map<MatrixXd> eigen_kuu(m_kuu.matrix, m_kuu.num_rows, m_kuu.num_cols);
+	MatrixXd kuu=eigen_kuu*std::exp(m_log_scale*2.0);
+	kuu.diagonal().array()+=std::exp(m_log_ind_noise);
+
+	LLT<MatrixXd> llt(kuu);
+	require(llt.info()==Eigen::Success, "The kernel matrix of the inducing "
+		"features is not positive definite, increase the inducing noise");
+
+	m_chol_kuu=SGMatrix<float64_t>(kuu.rows(), kuu.cols());
+	Map<MatrixXd>(m_chol_kuu.matrix, kuu.rows(), kuu.cols())=llt.matrixL();
+
+	// start from the prior q(v)=N(0,I) unless the inducing features are the
+	// same as in the previous training
+	const index_t m=m_chol_kuu.num_rows;
+	if (m_variational.vlen!=num_variational(m))
+	{
+		m_variational=SGVector<float64_t>(num_variational(m));
+		m_variational.zero();
+		pack_lower(MatrixXd::Identity(m, m), m_variational.vector+m);
+	}
+}
+
+void SVGPInferenceMethod::optimize_variational_parameters()
+{
+	auto cost_fun=std::make_shared<SVGPInferenceCostFunction>();
+	cost_fun->set_target(shared_from_this()->as<SVGPInferenceMethod>());
+
+	auto opt=std::dynamic_pointer_cast<FirstOrderStochasticMinimizer>(m_minimizer);
+	require(opt, "FirstOrderStochasticMinimizer is required");
+	opt->set_cost_function(cost_fun);
+	opt->minimize();
+	opt->unset_cost_function(false);
+}
+
+void SVGPInferenceMethod::update_alpha()
+{
+	const index_t m=m_chol_kuu.num_rows;
+	Map<MatrixXd> eigen_Luu(m_chol_kuu.matrix, m, m);
+	Map<VectorXd> eigen_m(m_variational.vector, m);
+	MatrixXd eigen_L=unpack_lower(m_variational.vector+m, m);
+
+	// the predictive mean is mean(x)+Ks'*alpha with alpha=Luu'\m
+	m_alpha=SGVector<float64_t>(m);
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m);
+	eigen_alpha=eigen_Luu.triangularView<Lower>().adjoint().solve(eigen_m);
+
+	// the predictive variance is Kss+Ks'*B*Ks with B=Luu'\(L*L'-I)/Luu
+	MatrixXd S=eigen_L*eigen_L.adjoint();
+	S.diagonal().array()-=1.0;
+	MatrixXd tmp=eigen_Luu.triangularView<Lower>().adjoint().solve(S);
+	m_L=SGMatrix<float64_t>(m, m);
+	Map<MatrixXd> eigen_B(m_L.matrix, m, m);
+	eigen_B=eigen_Luu.triangularView<Lower>().adjoint().solve(tmp.adjoint());
+}
+
+void SVGPInferenceMethod::update_deriv()
+{
+}
+
+float64_t SVGPInferenceMethod::get_minibatch_bound(
+	SGVector<index_t> indices, SGVector<float64_t> gradient)
+{
+	const index_t m=m_chol_kuu.num_rows;
+	const index_t b=indices.vlen;
+	const float64_t n=m_features->get_num_vectors();
+	const float64_t scale2=std::exp(m_log_scale*2.0);
+
+	Map<MatrixXd> eigen_Luu(m_chol_kuu.matrix, m, m);
+	Map<VectorXd> eigen_m(m_variational.vector, m);
+	MatrixXd eigen_L=unpack_lower(m_variational.vector+m, m);
+
+	// kernels and prior means of the minibatch only
+	m_features->add_subset(indices);
+	m_labels->add_subset(indices);
+
+	m_kernel->init(get_inducing_features(), m_features);
+	SGMatrix<float64_t> kuf=m_kernel->get_kernel_matrix();
+	m_kernel->init(m_features, m_features);
+	SGVector<float64_t> kff=m_kernel->get_kernel_diagonal();
+	SGVector<float64_t> mean=m_mean->get_mean_vector(m_features);
+
+	// q(f_i) = N(mean_i+a_i'*m, kff_i*scale^2-a_i'*a_i+a_i'*L*L'*a_i) with
+	// A = Luu\Kuf*scale^2
+	Map<MatrixXd> eigen_kuf(kuf.matrix, kuf.num_rows, kuf.num_cols);
+	MatrixXd A=eigen_Luu.triangularView<Lower>().solve(eigen_kuf*scale2);
+	MatrixXd LtA=eigen_L.triangularView<Lower>().adjoint()*A;
+
+	SGVector<float64_t> mu(b);
+	Map<VectorXd> eigen_mu(mu.vector, b);
+	eigen_mu=Map<VectorXd>(mean.vector, b)+A.adjoint()*eigen_m;
+
+	SGVector<float64_t> s2(b);
+	Map<VectorXd> eigen_s2(s2.vector, b);
+	eigen_s2=Map<VectorXd>(kff.vector, b)*scale2-
+		A.colwise().squaredNorm().adjoint()+
+		LtA.colwise().squaredNorm().adjoint();
+
+	auto lik=get_variational_likelihood();
+	const bool status=lik->set_variational_distribution(mu, s2, m_labels);
+
+	m_labels->remove_subset();
+	m_features->remove_subset();
+	require(status, "The variances of the variational distribution are not "
+		"positive, increase the inducing noise");
+
+	// KL(N(m,LL')||N(0,I)) = (tr(LL')+m'm-M)/2-log|L|
+	float64_t kl=(eigen_L.squaredNorm()+eigen_m.squaredNorm()-m)/2.0;
+	for (index_t i=0; i<m; i++)
+		kl-=std::log(std::abs(eigen_L(i,i)));
+
+	SGVector<float64_t> ell=lik->get_variational_expection();
+	const float64_t bound=Map<VectorXd>(ell.vector, b).sum()/b-kl/n;
+
+	if (gradient.vlen)
+	{
+		require(gradient.vlen==m_variational.vlen,
+			"The length of gradients ({}) should the same as the length of "
+			"parameters ({})", gradient.vlen, m_variational.vlen);
+
+		auto params=lik->get_params();
+		require(params.count("mu"), "Could not find mu parameter in {}",
+			lik->get_name());
+		require(params.count("sigma2"), "Could not find sigma2 parameter "
+			"in {}", lik->get_name());
+		SGVector<float64_t> dmu=
+			lik->get_variational_first_derivative(*params.find("mu"));
+		SGVector<float64_t> ds2=
+			lik->get_variational_first_derivative(*params.find("sigma2"));
+		Map<VectorXd> eigen_dmu(dmu.vector, b);
+		Map<VectorXd> eigen_ds2(ds2.vector, b);
+
+		// the negative gradient of the bound, m'*m/2 and tr(LL')/2-log|L|
+		// of the KL divergence give m and L-diag(1/diag(L))
+		Map<VectorXd> eigen_grad_m(gradient.vector, m);
+		eigen_grad_m=eigen_m/n-A*eigen_dmu/b;
+
+		MatrixXd grad_L=eigen_L/n-
+			2.0*(A*eigen_ds2.asDiagonal()*LtA.adjoint())/b;
+		grad_L.diagonal().array()-=eigen_L.diagonal().array().inverse()/n;
+		pack_lower(grad_L, gradient.vector+m);
+	}
+
+	return bound;
+}
+
+float64_t SVGPInferenceMethod::get_negative_log_marginal_likelihood()
+{
+	if (parameter_hash_changed())
+		update();
+
+	const index_t n=m_features->get_num_vectors();
+	float64_t nlml=0;
+	for (index_t start=0; start<n; start+=m_minibatch_size)
+	{
+		SGVector<index_t> indices(std::min<index_t>(m_minibatch_size, n-start));
+		indices.range_fill(start);
+		nlml-=get_minibatch_bound(indices, SGVector<float64_t>())*indices.vlen;
+	}
+
+	// each minibatch bound includes the share of the KL divergence of its
+	// vectors
+	return nlml;
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_posterior_mean()
+{
+	if (parameter_hash_changed())
+		update();
+
+	const index_t n=m_features->get_num_vectors();
+	const index_t m=m_chol_kuu.num_rows;
+	Map<VectorXd> eigen_m(m_variational.vector, m);
+	Map<MatrixXd> eigen_Luu(m_chol_kuu.matrix, m, m);
+	const float64_t scale2=std::exp(m_log_scale*2.0);
+
+	m_mu=SGVector<float64_t>(n);
+	for (index_t start=0; start<n; start+=m_minibatch_size)
+	{
+		SGVector<index_t> indices(std::min<index_t>(m_minibatch_size, n-start));
+		indices.range_fill(start);
+
+		m_features->add_subset(indices);
+		m_kernel->init(get_inducing_features(), m_features);
+		SGMatrix<float64_t> kuf=m_kernel->get_kernel_matrix();
+		SGVector<float64_t> mean=m_mean->get_mean_vector(m_features);
+		m_features->remove_subset();
+
+		Map<MatrixXd> eigen_kuf(kuf.matrix, kuf.num_rows, kuf.num_cols);
+		Map<VectorXd>(m_mu.vector+start, indices.vlen)=
+			Map<VectorXd>(mean.vector, indices.vlen)+
+			(eigen_Luu.triangularView<Lower>().solve(eigen_kuf*scale2)).adjoint()*eigen_m;
+	}
+
+	return SGVector<float64_t>(m_mu);
+}
+
+SGMatrix<float64_t> SVGPInferenceMethod::get_posterior_covariance()
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGMatrix<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_diagonal_vector()
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_variational_mean() const
+{
+	const index_t m=m_chol_kuu.num_rows;
+	return SGVector<float64_t>(m_variational.vector, m, false).clone();
+}
+
+SGMatrix<float64_t> SVGPInferenceMethod::get_variational_cholesky() const
+{
+	const index_t m=m_chol_kuu.num_rows;
+	SGMatrix<float64_t> L(m, m);
+	Map<MatrixXd>(L.matrix, m, m)=unpack_lower(m_variational.vector+m, m);
+	return L;
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_derivative_wrt_inference_method(
+		Parameters::const_reference param)
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_derivative_wrt_likelihood_model(
+		Parameters::const_reference param)
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_derivative_wrt_kernel(
+		Parameters::const_reference param)
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_derivative_wrt_mean(
+		Parameters::const_reference param)
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_derivative_wrt_inducing_noise(
+		Parameters::const_reference param)
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
+
+SGVector<float64_t> SVGPInferenceMethod::get_derivative_wrt_inducing_features(
+		Parameters::const_reference param)
+{
+	not_implemented(SOURCE_LOCATION);
+	return SGVector<float64_t>();
+}
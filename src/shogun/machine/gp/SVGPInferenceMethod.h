@@ -0,0 +1,243 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SVGPINFERENCEMETHOD_H
+#define SVGPINFERENCEMETHOD_H
+
+#include <shogun/lib/config.h>
+
+#include <shogun/machine/gp/SparseInference.h>
+#include <shogun/machine/gp/VariationalGaussianLikelihood.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+namespace shogun
+{
+class SVGPInferenceCostFunction;
+
+/** @brief Stochastic variational inference for sparse Gaussian processes
+ * (SVGP).
+ *
+ * The posterior of the latent values \f$u\f$ at the inducing features is
+ * approximated by a Gaussian \f$q(u)\f$, in the whitened parametrization
+ * \f$u=\mu_u+L_{uu}v\f$ with \f$q(v)=N(m, LL^T)\f$ and
+ * \f$L_{uu}L_{uu}^T=K_{uu}\f$. The evidence lower bound
+ *
+ * \f[
+ * \sum_{i=1}^n E_{q(f_i)}[\log p(y_i|f_i)] - KL(q(v)||N(0,I))
+ * \f]
+ *
+ * separates over the training vectors, so \f$m\f$ and \f$L\f$ are fitted by
+ * a FirstOrderStochasticMinimizer on unbiased estimates from minibatches of
+ * vectors. Every step only needs the kernel between the minibatch and the
+ * inducing features, so neither the \f$n\times m\f$ cross kernel nor full
+ * batch gradients are formed. The expectations of the log likelihood are
+ * computed by a VariationalGaussianLikelihood, which makes any of those
+ * usable for regression or binary classification.
+ *
+ * The hyperparameters (kernel, mean, likelihood and inducing features) are
+ * kept fixed, derivatives with respect to them are not implemented.
+ *
+ * The default minimizer is an SGDMinimizer with Adam updates running ten
+ * passes over the data, see register_minimizer() for others. Training again
+ * starts from the current variational parameters.
+ *
+ * For more details, see
+ * Hensman, James, Nicolo Fusi, and Neil D. Lawrence.
+ * "Gaussian processes for big data."
+ * Uncertainty in Artificial Intelligence. 2013.
+ * and
+ * Hensman, James, Alexander Matthews, and Zoubin Ghahramani.
+ * "Scalable variational Gaussian process classification."
+ * Artificial Intelligence and Statistics. 2015.
+ */
+class SVGPInferenceMethod: public RandomMixin<SparseInference>
+{
+friend class SVGPInferenceCostFunction;
+public:
+	/** default constructor */
+	SVGPInferenceMethod();
+
+	/** constructor
+	 *
+	 * @param kernel covariance function
+	 * @param features features to use in inference
+	 * @param mean mean function
+	 * @param labels labels of the features
+	 * @param model variational Gaussian likelihood
+	 * @param inducing_features features to use
+	 */
+	SVGPInferenceMethod(std::shared_ptr<Kernel> kernel, std::shared_ptr<Features> features,
+			std::shared_ptr<MeanFunction> mean, std::shared_ptr<Labels> labels, std::shared_ptr<LikelihoodModel> model,
+			std::shared_ptr<Features> inducing_features);
+
+	~SVGPInferenceMethod() override;
+
+	/** return what type of inference we are
+	 *
+	 * @return inference type KL_SPARSE_STOCHASTIC
+	 */
+	EInferenceType get_inference_type() const override { return INF_KL_SPARSE_STOCHASTIC; }
+
+	/** returns the name of the inference method
+	 *
+	 * @return name SVGPInferenceMethod
+	 */
+	const char* get_name() const override { return "SVGPInferenceMethod"; }
+
+	/** helper method used to specialize a base class instance
+	 *
+	 * @param inference inference method
+	 * @return casted SVGPInferenceMethod object
+	 */
+	static std::shared_ptr<SVGPInferenceMethod> obtain_from_generic(const std::shared_ptr<Inference>& inference);
+
+	/** get negative log marginal likelihood
+	 *
+	 * @return the negative of the evidence lower bound, which is evaluated
+	 * minibatch by minibatch over all training vectors
+	 */
+	float64_t get_negative_log_marginal_likelihood() override;
+
+	/** returns the means of the approximate posterior marginals of the
+	 * latent function at the training features
+	 *
+	 * @return posterior mean
+	 */
+	SGVector<float64_t> get_posterior_mean() override;
+
+	/** not implemented, the covariance of all training vectors is not
+	 * formed
+	 */
+	SGMatrix<float64_t> get_posterior_covariance() override;
+
+	/** not implemented */
+	SGVector<float64_t> get_diagonal_vector() override;
+
+	/**
+	 * @return whether combination of inference method and given likelihood
+	 * function supports regression
+	 */
+	bool supports_regression() const override
+	{
+		check_members();
+		return m_model->supports_regression();
+	}
+
+	/**
+	 * @return whether combination of inference method and given likelihood
+	 * function supports binary classification
+	 */
+	bool supports_binary() const override
+	{
+		check_members();
+		return m_model->supports_binary();
+	}
+
+	/** set variational likelihood model
+	 *
+	 * @param mod model to set
+	 */
+	void set_model(std::shared_ptr<LikelihoodModel> mod) override;
+
+	/** set a FirstOrderStochasticMinimizer to fit the variational parameters
+	 *
+	 * @param minimizer minimizer used in inference
+	 */
+	void register_minimizer(std::shared_ptr<Minimizer> minimizer) override;
+
+	/** update all matrices and fit the variational parameters */
+	void update() override;
+
+	/** set the number of training vectors per step
+	 *
+	 * @param minibatch_size number of vectors per minibatch
+	 */
+	virtual void set_minibatch_size(int32_t minibatch_size);
+
+	/** @return number of training vectors per step */
+	virtual int32_t get_minibatch_size() const { return m_minibatch_size; }
+
+	/** @return mean \f$m\f$ of the whitened variational distribution */
+	virtual SGVector<float64_t> get_variational_mean() const;
+
+	/** @return lower triangular Cholesky factor \f$L\f$ of the covariance of
+	 * the whitened variational distribution */
+	virtual SGMatrix<float64_t> get_variational_cholesky() const;
+
+protected:
+	/** check if members of object are valid for inference */
+	void check_members() const override;
+
+	/** update the kernel matrix of the inducing features only */
+	void update_train_kernel() override;
+
+	/** update alpha vector \f$L_{uu}^{-T}m\f$ */
+	void update_alpha() override;
+
+	/** update the Cholesky factor of the inducing kernel and the matrix
+	 * \f$L_{uu}^{-T}(LL^T-I)L_{uu}^{-1}\f$ used in predictions */
+	void update_chol() override;
+
+	/** does nothing, there are no derivatives wrt hyperparameters */
+	void update_deriv() override;
+
+	/** fit the variational parameters with the registered minimizer */
+	virtual void optimize_variational_parameters();
+
+	/** compute the evidence lower bound on a minibatch, scaled by the
+	 * number of training vectors, and optionally its gradient
+	 *
+	 * @param indices indices of the training vectors of the minibatch
+	 * @param gradient negative gradient wrt the variational parameters,
+	 * not computed if empty
+	 * @return mean expected log likelihood of the minibatch minus the KL
+	 * divergence divided by the number of training vectors
+	 */
+	virtual float64_t get_minibatch_bound(
+	    SGVector<index_t> indices, SGVector<float64_t> gradient);
+
+	/** not implemented */
+	SGVector<float64_t> get_derivative_wrt_inference_method(
+			Parameters::const_reference param) override;
+
+	/** not implemented */
+	SGVector<float64_t> get_derivative_wrt_likelihood_model(
+			Parameters::const_reference param) override;
+
+	/** not implemented */
+	SGVector<float64_t> get_derivative_wrt_kernel(
+			Parameters::const_reference param) override;
+
+	/** not implemented */
+	SGVector<float64_t> get_derivative_wrt_mean(
+			Parameters::const_reference param) override;
+
+	/** not implemented */
+	SGVector<float64_t> get_derivative_wrt_inducing_noise(
+			Parameters::const_reference param) override;
+
+	/** not implemented */
+	SGVector<float64_t> get_derivative_wrt_inducing_features(
+			Parameters::const_reference param) override;
+
+	/** @return the likelihood model as variational Gaussian likelihood */
+	virtual std::shared_ptr<VariationalGaussianLikelihood> get_variational_likelihood() const;
+
+	/** number of training vectors per step */
+	int32_t m_minibatch_size;
+
+	/** variational parameters, the mean \f$m\f$ followed by the columns of
+	 * the lower triangle of \f$L\f$ */
+	SGVector<float64_t> m_variational;
+
+	/** Cholesky factor of the (scaled) kernel matrix of inducing features */
+	SGMatrix<float64_t> m_chol_kuu;
+
+private:
+	void init();
+};
+}
+#endif /* SVGPINFERENCEMETHOD_H */
@@ -30,8 +30,7 @@ namespace shogun
 class PsiLine : public func_base
 {
 public:
-	float64_t log_scale;
-	MatrixXd K;
+	const MatrixXd* K;
 	VectorXd dalpha;
 	VectorXd start_alpha;
 	Map<VectorXd>* alpha;
@@ -49,7 +48,7 @@ public:
 
 		// compute alpha=alpha+x*dalpha and f=K*alpha+m
 		(*alpha)=start_alpha+x*dalpha;
-		eigen_f = K * (*alpha) * std::exp(log_scale * 2.0) + eigen_m;
+		eigen_f = (*K) * (*alpha) + eigen_m;
 
 		// get first and second derivatives of log likelihood
 		(*dlp)=lik->get_log_probability_derivative_f(lab, (*f), 1);
@@ -182,6 +181,13 @@ float64_t SingleLaplaceNewtonOptimizer::minimize()
 	m_obj->m_sW=SGVector<float64_t>((m_obj->m_W).vlen);
 	Map<VectorXd> eigen_sW((m_obj->m_sW).vector, (m_obj->m_sW).vlen);
 
+	// the scaled kernel matrix, B and its Cholesky factor are allocated once
+	// for all Newton steps
+	const MatrixXd eigen_K=
+		eigen_ktrtr*std::exp((m_obj->m_log_scale)*2.0);
+	MatrixXd B(eigen_K.rows(), eigen_K.cols());
+	LLT<MatrixXd> L(eigen_K.rows());
+
 	index_t iter=0;
 
 	while (Psi_Old-Psi_New>m_tolerance && iter<m_iter)
@@ -213,29 +219,23 @@ float64_t SingleLaplaceNewtonOptimizer::minimize()
 		// compute sW = sqrt(W)
 		eigen_sW=eigen_W.cwiseSqrt();
 
-		LLT<MatrixXd> L(
-			(eigen_sW * eigen_sW.transpose())
-			    .cwiseProduct(
-			        eigen_ktrtr * std::exp((m_obj->m_log_scale) * 2.0)) +
-			MatrixXd::Identity(
-			    (m_obj->m_ktrtr).num_rows, (m_obj->m_ktrtr).num_cols));
+		// B = I + sW * K * sW, factorized in a blocked Cholesky decomposition
+		B.noalias()=eigen_sW.asDiagonal()*eigen_K*eigen_sW.asDiagonal();
+		B.diagonal().array()+=1.0;
+		L.compute(B);
 
 		VectorXd b=eigen_W.cwiseProduct(eigen_mu - eigen_mean)+eigen_dlp;
 
 		VectorXd dalpha = b -
 			              eigen_sW.cwiseProduct(
-			                  L.solve(
-			                      eigen_sW.cwiseProduct(
-			                          eigen_ktrtr * b *
-			                          std::exp((m_obj->m_log_scale) * 2.0)))) -
+			                  L.solve(eigen_sW.cwiseProduct(eigen_K * b))) -
 			              eigen_alpha;
 
 #ifdef USE_GPL_SHOGUN
 		// perform Brent's optimization
 		PsiLine func;
 
-		func.log_scale=m_obj->m_log_scale;
-		func.K=eigen_ktrtr;
+		func.K=&eigen_K;
 		func.dalpha=dalpha;
 		func.start_alpha=eigen_alpha;
 		func.alpha=&eigen_alpha;
@@ -238,24 +238,25 @@ SGVector<float64_t> SingleSparseInference::get_derivative_wrt_kernel(
 	result=SGVector<float64_t>(len);
 
 	auto inducing_features=get_inducing_features();
+
+	m_lock.lock();
+	m_kernel->init(m_features, m_features);
+	//to reduce the time complexity
+	//the kernel object only computes diagonal elements of gradients wrt hyper-parameter
+	auto derivs_trtr=m_kernel->get_parameter_gradients_diagonal(param, result.vlen);
+
+	m_kernel->init(inducing_features, inducing_features);
+	auto derivs_uu=m_kernel->get_parameter_gradients(param, result.vlen);
+
+	m_kernel->init(inducing_features, m_features);
+	auto derivs_tru=m_kernel->get_parameter_gradients(param, result.vlen);
+	m_lock.unlock();
+
 	for (index_t i=0; i<result.vlen; i++)
 	{
-		SGVector<float64_t> deriv_trtr;
-		SGMatrix<float64_t> deriv_uu;
-		SGMatrix<float64_t> deriv_tru;
-
-		m_lock.lock();
-		m_kernel->init(m_features, m_features);
-		//to reduce the time complexity
-		//the kernel object only computes diagonal elements of gradients wrt hyper-parameter
-		deriv_trtr=m_kernel->get_parameter_gradient_diagonal(param, i);
-
-		m_kernel->init(inducing_features, inducing_features);
-		deriv_uu=m_kernel->get_parameter_gradient(param, i);
-
-		m_kernel->init(inducing_features, m_features);
-		deriv_tru=m_kernel->get_parameter_gradient(param, i);
-		m_lock.unlock();
+		SGVector<float64_t> deriv_trtr=derivs_trtr[i];
+		SGMatrix<float64_t> deriv_uu=derivs_uu[i];
+		SGMatrix<float64_t> deriv_tru=derivs_tru[i];
 
 		// create eigen representation of derivatives
 		Map<VectorXd> ddiagKi(deriv_trtr.vector, deriv_trtr.vlen);
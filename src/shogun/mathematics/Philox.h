@@ -0,0 +1,265 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __PHILOX_H__
+#define __PHILOX_H__
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/config.h>
+
+#include <array>
+#include <limits>
+#include <type_traits>
+
+namespace shogun
+{
+	/** @brief Philox4x32-10 counter-based pseudo random number generator.
+	 *
+	 * Salmon, Moraes, Dror and Shaw, "Parallel random numbers: as easy as
+	 * 1, 2, 3", SC 2011
+	 *
+	 * The generator encrypts a 128 bit counter under a 64 bit key with ten
+	 * rounds of multiplications. The upper half of the counter is a stream
+	 * id and the lower half the position within the stream, so every
+	 * (key, stream) pair is an independent sequence of 2^65 values. Any
+	 * position can be reached in constant time (discard()), and blocks of
+	 * values are computed independently of each other (generate()).
+	 *
+	 * It satisfies the UniformRandomBitGenerator requirements with 64 bit
+	 * results like std::mt19937_64, so it can be used with all shogun
+	 * distributions and as the PRNG of RandomMixin.
+	 */
+	class Philox4x32
+	{
+	public:
+		using result_type = uint64_t;
+		/** number of 32 bit words a std::seed_seq generates to seed */
+		static constexpr size_t state_size = 4;
+
+		/** constructor
+		 *
+		 * @param key key, e.g. a seed
+		 * @param stream id of the stream
+		 */
+		explicit Philox4x32(uint64_t key = 0, uint64_t stream = 0)
+		{
+			seed(key, stream);
+		}
+
+		/** constructor from a seed sequence, which generates the key and
+		 * the stream id
+		 *
+		 * @param seq seed sequence, e.g. std::seed_seq
+		 */
+		template <
+		    typename SeedSeq,
+		    std::enable_if_t<!std::is_arithmetic_v<SeedSeq>>* = nullptr>
+		explicit Philox4x32(SeedSeq& seq)
+		{
+			std::array<uint32_t, state_size> words;
+			seq.generate(words.begin(), words.end());
+			seed(
+			    (uint64_t(words[1]) << 32) | words[0],
+			    (uint64_t(words[3]) << 32) | words[2]);
+		}
+
+		/** restart the generator at the beginning of a stream
+		 *
+		 * @param key key, e.g. a seed
+		 * @param stream id of the stream
+		 */
+		void seed(uint64_t key, uint64_t stream = 0)
+		{
+			m_key = {uint32_t(key), uint32_t(key >> 32)};
+			m_counter = {0, 0, uint32_t(stream), uint32_t(stream >> 32)};
+			m_index = kValuesPerBlock;
+		}
+
+		static constexpr result_type min()
+		{
+			return 0;
+		}
+
+		static constexpr result_type max()
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		/** @return next value of the stream */
+		result_type operator()()
+		{
+			if (m_index == kValuesPerBlock)
+			{
+				m_block = next_block();
+				m_index = 0;
+			}
+			const auto value = (uint64_t(m_block[2 * m_index + 1]) << 32) |
+			                   m_block[2 * m_index];
+			++m_index;
+			return value;
+		}
+
+		/** fill a range with the next values of the stream, whole blocks
+		 * are written without buffering
+		 *
+		 * @param first pointer to the first value
+		 * @param last pointer past the last value
+		 */
+		void generate(result_type* first, result_type* last)
+		{
+			while (first != last && m_index != kValuesPerBlock)
+				*first++ = (*this)();
+
+			for (; last - first >= kValuesPerBlock; first += kValuesPerBlock)
+			{
+				const auto block = next_block();
+				first[0] = (uint64_t(block[1]) << 32) | block[0];
+				first[1] = (uint64_t(block[3]) << 32) | block[2];
+			}
+
+			while (first != last)
+				*first++ = (*this)();
+		}
+
+		/** skip values of the stream in constant time
+		 *
+		 * @param n number of values to skip
+		 */
+		void discard(uint64_t n)
+		{
+			const uint64_t buffered = kValuesPerBlock - m_index;
+			if (n <= buffered)
+			{
+				m_index += n;
+				return;
+			}
+			n -= buffered;
+			add_to_position(n / kValuesPerBlock);
+			m_index = kValuesPerBlock;
+			if (n % kValuesPerBlock)
+			{
+				m_block = next_block();
+				m_index = n % kValuesPerBlock;
+			}
+		}
+
+		bool operator==(const Philox4x32& other) const
+		{
+			return m_key == other.m_key && m_counter == other.m_counter &&
+			       m_index == other.m_index &&
+			       (m_index == kValuesPerBlock || m_block == other.m_block);
+		}
+
+		bool operator!=(const Philox4x32& other) const
+		{
+			return !(*this == other);
+		}
+
+		/** encrypt a counter, i.e. compute a block of random bits
+		 *
+		 * @param counter counter
+		 * @param key key
+		 * @return four random words
+		 */
+		static std::array<uint32_t, 4> encrypt(
+		    std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+		{
+			for (int32_t r = 0; r < kNumRounds; ++r)
+			{
+				if (r > 0)
+				{
+					key[0] += kWeyl0;
+					key[1] += kWeyl1;
+				}
+				const uint64_t p0 = uint64_t(kMultiplier0) * counter[0];
+				const uint64_t p1 = uint64_t(kMultiplier1) * counter[2];
+				counter = {uint32_t(p1 >> 32) ^ counter[1] ^ key[0],
+				           uint32_t(p1), uint32_t(p0 >> 32) ^ counter[3] ^ key[1],
+				           uint32_t(p0)};
+			}
+			return counter;
+		}
+
+	private:
+		std::array<uint32_t, 4> next_block()
+		{
+			const auto block = encrypt(m_counter, m_key);
+			add_to_position(1);
+			return block;
+		}
+
+		void add_to_position(uint64_t n)
+		{
+			const uint64_t position =
+			    ((uint64_t(m_counter[1]) << 32) | m_counter[0]) + n;
+			m_counter[0] = uint32_t(position);
+			m_counter[1] = uint32_t(position >> 32);
+		}
+
+		static constexpr int32_t kNumRounds = 10;
+		static constexpr uint32_t kMultiplier0 = 0xD2511F53;
+		static constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+		static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+		static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+		static constexpr int64_t kValuesPerBlock = 2;
+
+		std::array<uint32_t, 2> m_key;
+		/** position in the lower and stream id in the upper two words */
+		std::array<uint32_t, 4> m_counter;
+		/** current block and the number of its values already returned */
+		std::array<uint32_t, 4> m_block;
+		int64_t m_index;
+	};
+
+	namespace random
+	{
+		/** @brief Independent random streams for the tasks of a parallel
+		 * loop.
+		 *
+		 * Task t draws from the stream t of a Philox4x32 generator with a
+		 * common key. When the tasks are numbered independently of the
+		 * threads that run them (e.g. bag, tree, chunk or sample index),
+		 * the results are bit-identical for any number of threads and any
+		 * scheduling, and no generator is shared between threads.
+		 *
+		 * The key is usually drawn from the sequential generator of an
+		 * object, see RandomMixin::make_streams(), so consecutive parallel
+		 * loops use different streams and everything is determined by the
+		 * seed of the object.
+		 */
+		class RandomStreams
+		{
+		public:
+			/** constructor
+			 *
+			 * @param key key shared by all streams
+			 */
+			explicit RandomStreams(uint64_t key) : m_key(key)
+			{
+			}
+
+			/** @return generator of the stream of a task
+			 *
+			 * @param task task id
+			 */
+			Philox4x32 operator()(uint64_t task) const
+			{
+				return Philox4x32(m_key, task);
+			}
+
+			/** @return key shared by all streams */
+			uint64_t get_key() const
+			{
+				return m_key;
+			}
+
+		private:
+			uint64_t m_key;
+		};
+	} // namespace random
+} // namespace shogun
+
+#endif // __PHILOX_H__
@@ -3,6 +3,7 @@
 
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/config.h>
+#include <shogun/mathematics/Philox.h>
 #include <shogun/mathematics/Seedable.h>
 
 #include <iterator>
@@ -101,6 +102,15 @@ namespace shogun
 			random::seed(object, m_prng);
 		}
 
+		/** Draws a key from m_prng for independent random streams of the
+		 * tasks of a parallel loop, see random::RandomStreams
+		 */
+		inline random::RandomStreams make_streams() const
+		{
+			return random::RandomStreams(
+			    (uint64_t(m_prng()) << 32) ^ uint64_t(m_prng()));
+		}
+
 		mutable PRNG m_prng;
 	};
 
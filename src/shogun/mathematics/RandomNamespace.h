@@ -2,15 +2,19 @@
 #define __RANDOM_NAMESPACE_H__
 
 #include <shogun/base/SGObject.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
+#include <shogun/mathematics/Philox.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
 
 #include <algorithm>
 #include <iterator>
 #include <random>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace shogun
 {
@@ -45,6 +49,117 @@ namespace shogun
 			    std::forward<PRNG>(prng));
 		}
 
+		/** Reorders the elements in [first, last) randomly using all
+		 * threads.
+		 *
+		 * Every element is sent to one of up to 256 buckets at random and
+		 * the buckets are shuffled independently, which gives a uniformly
+		 * random permutation. Blocks of the input and the buckets use
+		 * their own generators, seeded from prng in a fixed order, so the
+		 * result only depends on prng and not on the number of threads.
+		 * Small ranges are shuffled sequentially.
+		 *
+		 * @param first an iterator to the first element in the range
+		 * @param last an iterator to the last element in the range
+		 * @param prng pseudo number generator object
+		 */
+		template <typename RandomIt, typename PRNG>
+		static inline void
+		parallel_shuffle(RandomIt first, RandomIt last, PRNG&& prng)
+		{
+			using diff_t =
+			    typename std::iterator_traits<RandomIt>::difference_type;
+			using value_t =
+			    typename std::iterator_traits<RandomIt>::value_type;
+			using engine_t = std::decay_t<PRNG>;
+			constexpr diff_t kMinBucketSize = 1 << 16;
+			constexpr diff_t kMaxBuckets = 256;
+
+			const diff_t n = last - first;
+			const diff_t num_buckets =
+			    std::min(kMaxBuckets, n / kMinBucketSize);
+			if (num_buckets < 2)
+			{
+				random::shuffle(first, last, std::forward<PRNG>(prng));
+				return;
+			}
+			// as many input blocks as buckets
+			const diff_t num_blocks = num_buckets;
+			auto block_begin = [&](diff_t b) { return b * n / num_blocks; };
+
+			std::vector<engine_t> block_prngs;
+			std::vector<engine_t> bucket_prngs;
+			for (diff_t b = 0; b < num_blocks; ++b)
+				block_prngs.emplace_back(prng());
+			for (diff_t k = 0; k < num_buckets; ++k)
+				bucket_prngs.emplace_back(prng());
+
+			// bucket of every element and number of elements per block and
+			// bucket
+			std::vector<uint8_t> buckets(n);
+			std::vector<diff_t> offsets(num_blocks * num_buckets, 0);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (diff_t b = 0; b < num_blocks; ++b)
+			{
+				UniformIntDistribution<diff_t> dist(0, num_buckets - 1);
+				auto* counts = offsets.data() + b * num_buckets;
+				for (auto i = block_begin(b); i < block_begin(b + 1); ++i)
+				{
+					buckets[i] = dist(block_prngs[b]);
+					++counts[buckets[i]];
+				}
+			}
+
+			// each bucket is contiguous, within it the blocks are in order
+			std::vector<diff_t> bucket_begin(num_buckets + 1, 0);
+			for (diff_t k = 0; k < num_buckets; ++k)
+			{
+				auto offset = bucket_begin[k];
+				for (diff_t b = 0; b < num_blocks; ++b)
+				{
+					const auto count = offsets[b * num_buckets + k];
+					offsets[b * num_buckets + k] = offset;
+					offset += count;
+				}
+				bucket_begin[k + 1] = offset;
+			}
+
+			std::vector<value_t> buffer(n);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (diff_t b = 0; b < num_blocks; ++b)
+			{
+				auto* positions = offsets.data() + b * num_buckets;
+				for (auto i = block_begin(b); i < block_begin(b + 1); ++i)
+					buffer[positions[buckets[i]]++] = std::move(first[i]);
+			}
+
+#pragma omp parallel for schedule(dynamic) \
+    num_threads(env()->get_num_threads())
+			for (diff_t k = 0; k < num_buckets; ++k)
+			{
+				random::shuffle(
+				    buffer.begin() + bucket_begin[k],
+				    buffer.begin() + bucket_begin[k + 1], bucket_prngs[k]);
+				std::move(
+				    buffer.begin() + bucket_begin[k],
+				    buffer.begin() + bucket_begin[k + 1],
+				    first + bucket_begin[k]);
+			}
+		}
+
+		/** Reorders a container of elements randomly using all threads
+		 *
+		 * @param container the container holding the elements
+		 * @param prng pseudo number generator object
+		 */
+		template <typename Container, typename PRNG>
+		static inline void parallel_shuffle(Container& container, PRNG&& prng)
+		{
+			random::parallel_shuffle(
+			    std::begin(container), std::end(container),
+			    std::forward<PRNG>(prng));
+		}
+
 		/** Fills an array with random numbers generated from a given
 		 * distribution
 		 *
@@ -105,6 +220,57 @@ namespace shogun
 		{
 			fill_array(container.begin(), container.end(), min, max, prng);
 		}
+
+		/** Fills an array with random numbers generated from a given
+		 * distribution using all threads.
+		 *
+		 * The array is split into chunks of fixed size, chunk c is filled
+		 * from stream c of the given streams with its own copy of the
+		 * distribution. The result only depends on the key of the streams
+		 * and not on the number of threads.
+		 *
+		 * @param first an iterator to the first element in the range
+		 * @param last an iterator to the last element in the range
+		 * @param dist random number distribution
+		 * @param streams random streams, see RandomMixin::make_streams()
+		 */
+		template <typename RandomIt, typename Distribution>
+		static inline void parallel_fill_array(
+		    RandomIt first, RandomIt last, const Distribution& dist,
+		    const RandomStreams& streams)
+		{
+			using diff_t =
+			    typename std::iterator_traits<RandomIt>::difference_type;
+			constexpr diff_t kChunkSize = 1 << 12;
+
+			const diff_t n = last - first;
+			const diff_t num_chunks = (n + kChunkSize - 1) / kChunkSize;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (diff_t c = 0; c < num_chunks; ++c)
+			{
+				auto prng = streams(c);
+				auto chunk_dist = dist;
+				const diff_t end = std::min(n, (c + 1) * kChunkSize);
+				for (diff_t i = c * kChunkSize; i < end; ++i)
+					first[i] = chunk_dist(prng);
+			}
+		}
+
+		/** Fills a container with random numbers generated from a given
+		 * distribution using all threads, see parallel_fill_array()
+		 *
+		 * @param container the container to be filled
+		 * @param dist random number distribution
+		 * @param streams random streams, see RandomMixin::make_streams()
+		 */
+		template <typename Container, typename Distribution>
+		static inline void parallel_fill_array(
+		    Container& container, const Distribution& dist,
+		    const RandomStreams& streams)
+		{
+			parallel_fill_array(
+			    std::begin(container), std::end(container), dist, streams);
+		}
 	} // namespace random
 } // namespace shogun
 
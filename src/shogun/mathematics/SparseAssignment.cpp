@@ -0,0 +1,207 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/range.h>
+#include <shogun/mathematics/SparseAssignment.h>
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+using namespace shogun;
+
+namespace
+{
+	constexpr auto kInfinity = std::numeric_limits<int64_t>::max();
+}
+
+SparseAssignment::SparseAssignment(index_t num_rows, index_t num_cols)
+	: m_num_rows(num_rows), m_num_cols(num_cols), m_total_weight(0)
+{
+	require(
+		num_rows >= 0 && num_cols >= 0, "Invalid size {}x{}", num_rows,
+		num_cols);
+}
+
+void SparseAssignment::add_edge(index_t row, index_t col, int64_t weight)
+{
+	require(
+		row >= 0 && row < m_num_rows && col >= 0 && col < m_num_cols,
+		"Edge ({}, {}) out of range {}x{}", row, col, m_num_rows, m_num_cols);
+	require(weight > 0, "Weight ({}) must be positive", weight);
+
+	m_edge_rows.push_back(row);
+	m_edge_cols.push_back(col);
+	// the solver minimizes costs
+	m_edge_costs.push_back(-weight);
+}
+
+SGVector<index_t> SparseAssignment::solve()
+{
+	const auto num_edges = m_edge_rows.size();
+
+	// order the edges by row
+	m_row_begin.assign(m_num_rows + 1, 0);
+	for (auto row : m_edge_rows)
+		m_row_begin[row + 1]++;
+	for (auto row : range(m_num_rows))
+		m_row_begin[row + 1] += m_row_begin[row];
+
+	std::vector<index_t> cols(num_edges);
+	std::vector<int64_t> costs(num_edges);
+	std::vector<index_t> position(m_row_begin.begin(), m_row_begin.end() - 1);
+	for (size_t e = 0; e < num_edges; e++)
+	{
+		const auto p = position[m_edge_rows[e]]++;
+		cols[p] = m_edge_cols[e];
+		costs[p] = m_edge_costs[e];
+	}
+	m_edge_cols = std::move(cols);
+	m_edge_costs = std::move(costs);
+	m_edge_rows.clear();
+
+	// every row has a private column of cost zero that leaves it unassigned
+	const index_t num_all_cols = m_num_cols + m_num_rows;
+	m_row_potential.assign(m_num_rows, 0);
+	m_col_potential.assign(num_all_cols, 0);
+	m_row_match.assign(m_num_rows, -1);
+	m_col_match.assign(num_all_cols, -1);
+	m_dist.assign(num_all_cols, kInfinity);
+	m_pred.assign(num_all_cols, -1);
+	m_scanned.assign(num_all_cols, false);
+
+	// the potential of a row is its cheapest cost, which makes all reduced
+	// costs non-negative, and its cheapest column is taken if it is free
+	std::vector<index_t> unassigned;
+	for (auto row : range(m_num_rows))
+	{
+		index_t best = m_num_cols + row;
+		for (auto e = m_row_begin[row]; e < m_row_begin[row + 1]; e++)
+		{
+			if (m_edge_costs[e] < m_row_potential[row])
+			{
+				m_row_potential[row] = m_edge_costs[e];
+				best = m_edge_cols[e];
+			}
+		}
+
+		if (m_col_match[best] < 0)
+		{
+			m_row_match[row] = best;
+			m_col_match[best] = row;
+		}
+		else
+			unassigned.push_back(row);
+	}
+
+	for (auto row : unassigned)
+		augment(row);
+
+	SGVector<index_t> assignment(m_num_rows);
+	m_total_weight = 0;
+	for (auto row : range(m_num_rows))
+	{
+		const auto col = m_row_match[row];
+		assignment[row] = col < m_num_cols ? col : -1;
+		if (col < m_num_cols)
+		{
+			for (auto e = m_row_begin[row]; e < m_row_begin[row + 1]; e++)
+			{
+				if (m_edge_cols[e] == col)
+					m_total_weight -= m_edge_costs[e];
+			}
+		}
+	}
+
+	return assignment;
+}
+
+void SparseAssignment::augment(index_t source)
+{
+	auto& dist = m_dist;
+	auto& pred = m_pred;
+	auto& scanned = m_scanned;
+	std::vector<index_t> reached_cols;
+	std::vector<index_t> scanned_cols;
+
+	using Item = std::pair<int64_t, index_t>;
+	std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+
+	// relaxes the edges of a row reached at the given distance
+	auto relax = [&](index_t row, int64_t row_dist) {
+		auto relax_col = [&](index_t col, int64_t cost) {
+			if (scanned[col])
+				return;
+			const auto d = row_dist + cost - m_row_potential[row] -
+			               m_col_potential[col];
+			if (d < dist[col])
+			{
+				if (dist[col] == kInfinity)
+					reached_cols.push_back(col);
+				dist[col] = d;
+				pred[col] = row;
+				queue.emplace(d, col);
+			}
+		};
+
+		for (auto e = m_row_begin[row]; e < m_row_begin[row + 1]; e++)
+			relax_col(m_edge_cols[e], m_edge_costs[e]);
+		relax_col(m_num_cols + row, 0);
+	};
+
+	relax(source, 0);
+
+	// the private column of the source row is free, so a free column is
+	// always found
+	index_t target = -1;
+	int64_t target_dist = 0;
+	while (target < 0)
+	{
+		const auto [d, col] = queue.top();
+		queue.pop();
+		if (scanned[col] || d > dist[col])
+			continue;
+
+		scanned[col] = true;
+		if (m_col_match[col] < 0)
+		{
+			target = col;
+			target_dist = d;
+		}
+		else
+		{
+			scanned_cols.push_back(col);
+			relax(m_col_match[col], d);
+		}
+	}
+
+	// keep reduced costs non-negative and make the path tight
+	m_row_potential[source] += target_dist;
+	for (auto col : scanned_cols)
+	{
+		const auto delta = target_dist - dist[col];
+		m_col_potential[col] -= delta;
+		m_row_potential[m_col_match[col]] += delta;
+	}
+
+	for (auto col = target;;)
+	{
+		const auto row = pred[col];
+		const auto next = m_row_match[row];
+		m_row_match[row] = col;
+		m_col_match[col] = row;
+		if (row == source)
+			break;
+		col = next;
+	}
+
+	for (auto col : reached_cols)
+	{
+		dist[col] = kInfinity;
+		scanned[col] = false;
+	}
+}
@@ -0,0 +1,100 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef _SPARSEASSIGNMENT_H_
+#define _SPARSEASSIGNMENT_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Maximum weight assignment of rows to columns on a sparse
+ * bipartite graph.
+ *
+ * Every row is assigned to at most one column and vice versa, such that the
+ * sum of the weights of the assigned edges is maximal. Pairs without an edge
+ * have weight zero and are left unassigned.
+ *
+ * The problem is solved by shortest augmenting paths with dual potentials,
+ * as in the Jonker-Volgenant algorithm for sparse cost matrices: every row
+ * is first assigned greedily to its heaviest edge if that column is free,
+ * the remaining rows are then added one by one along a shortest path found
+ * by Dijkstra's algorithm on the edges only. Memory is linear in the number
+ * of edges, and unlike Munkres, which needs a dense \f$k\times k\f$ matrix
+ * and \f$O(k^3)\f$ time, rows that are resolved by the greedy pass cost
+ * nothing, which for nearly diagonal problems such as matching clusters
+ * to classes are most of them.
+ *
+ * Weights are integers, e.g. counts, so the result is exact.
+ */
+class SparseAssignment
+{
+public:
+	/** constructor
+	 * @param num_rows number of rows
+	 * @param num_cols number of columns
+	 */
+	SparseAssignment(index_t num_rows, index_t num_cols);
+
+	/** add an edge, edges must be unique
+	 * @param row row
+	 * @param col column
+	 * @param weight positive weight
+	 */
+	void add_edge(index_t row, index_t col, int64_t weight);
+
+	/** solve the assignment
+	 * @return column of every row, -1 for unassigned rows
+	 */
+	SGVector<index_t> solve();
+
+	/** @return sum of the weights of the assigned edges */
+	int64_t get_total_weight() const
+	{
+		return m_total_weight;
+	}
+
+private:
+	/** assign a free row along a shortest augmenting path */
+	void augment(index_t row);
+
+	index_t m_num_rows;
+	index_t m_num_cols;
+
+	/** edges in compressed row format, ordered by row after solve() */
+	std::vector<index_t> m_edge_rows;
+	std::vector<index_t> m_edge_cols;
+	std::vector<int64_t> m_edge_costs;
+	std::vector<index_t> m_row_begin;
+
+	/** dual potentials of rows and columns */
+	std::vector<int64_t> m_row_potential;
+	std::vector<int64_t> m_col_potential;
+
+	/** assigned column of every row and row of every column, -1 if
+	 * free. Column num_cols + i is the private column of row i that
+	 * stands for leaving it unassigned. */
+	std::vector<index_t> m_row_match;
+	std::vector<index_t> m_col_match;
+
+	/** distances, predecessor rows and state of the columns in augment(),
+	 * kept between calls and reset for the columns that were reached */
+	std::vector<int64_t> m_dist;
+	std::vector<index_t> m_pred;
+	std::vector<bool> m_scanned;
+
+	int64_t m_total_weight;
+};
+
+} // namespace shogun
+
+#endif /* _SPARSEASSIGNMENT_H_ */
@@ -7,11 +7,13 @@
  */
 
 #include <algorithm>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/external/cdflib.hpp>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/mathematics/eigen3.h>
@@ -30,6 +32,31 @@ using namespace shogun;
 #define M_SQRT1_2 0.707106781186547524401
 #endif
 
+namespace
+{
+	/** number of arguments of the bulk functions a thread evaluates at
+	 * once, small enough for the scratch arrays to stay in the L1 cache
+	 */
+	const index_t BULK_CHUNK=1024;
+
+	/** evaluate f(x, y, n) on chunks of x in parallel */
+	template <typename F>
+	SGVector<float64_t> evaluate_parallel(const SGVector<float64_t>& x, F f)
+	{
+		SGVector<float64_t> y(x.vlen);
+		const index_t num_chunks=(x.vlen+BULK_CHUNK-1)/BULK_CHUNK;
+
+		#pragma omp parallel for num_threads(env()->get_num_threads()) if (num_chunks>1)
+		for (index_t c=0; c<num_chunks; ++c)
+		{
+			const index_t begin=c*BULK_CHUNK;
+			f(x.vector+begin, y.vector+begin,
+			  std::min(BULK_CHUNK, x.vlen-begin));
+		}
+		return y;
+	}
+} // namespace
+
 float64_t Statistics::variance(SGVector<float64_t> values)
 {
 	require(values.vlen>1, "Number of observations ({}) needs to be at least 1.",
@@ -377,6 +404,15 @@ float64_t Statistics::inverse_normal_cdf(float64_t p, float64_t mean,
 	// double *sd, int *status, double *bound )
 }
 
+SGVector<float64_t> Statistics::inverse_normal_cdf(
+		const SGVector<float64_t>& y, float64_t mean, float64_t std_dev)
+{
+	SGVector<float64_t> x(y.vlen);
+	for (index_t i=0; i<y.vlen; i++)
+		x[i]=inverse_normal_cdf(y[i], mean, std_dev);
+	return x;
+}
+
 float64_t Statistics::chi2_cdf(float64_t x, float64_t k)
 {
 	require(x>=0, "x ({}) has to be greater or equal to 0.", x);
@@ -398,6 +434,15 @@ float64_t Statistics::chi2_cdf(float64_t x, float64_t k)
 	return output_p;
 }
 
+SGVector<float64_t> Statistics::chi2_cdf(
+		const SGVector<float64_t>& x, float64_t k)
+{
+	SGVector<float64_t> p(x.vlen);
+	for (index_t i=0; i<x.vlen; i++)
+		p[i]=chi2_cdf(x[i], k);
+	return p;
+}
+
 float64_t Statistics::gamma_cdf(float64_t x, float64_t a, float64_t b)
 {
 	require(x>=0, "x ({}) has to be greater or equal to 0.", x);
@@ -467,6 +512,39 @@ float64_t Statistics::lnormal_cdf(float64_t x)
 	return std::log(normal_cdf(x));
 }
 
+SGVector<float64_t> Statistics::lnormal_cdf(const SGVector<float64_t>& x)
+{
+	constexpr float64_t log_of_2=0.69314718055994528623;
+
+	return evaluate_parallel(x, [](const float64_t* x, float64_t* y, index_t n) {
+		// lnormal_cdf(x)=log(y)+offset, the logarithms of the chunk are
+		// computed at once
+		float64_t offset[BULK_CHUNK];
+		for (index_t i=0; i<n; i++)
+		{
+			if (x[i]*x[i]<ERFC_CASE1)
+			{
+				y[i]=1.0;
+				offset[i]=lnormal_cdf(x[i]);
+			}
+			else if (x[i]<ERFC_CASE2)
+			{
+				y[i]=erfc8_weighted_sum(x[i]);
+				offset[i]=-log_of_2-x[i]*x[i]*0.5;
+			}
+			else
+			{
+				y[i]=normal_cdf(x[i]);
+				offset[i]=0.0;
+			}
+		}
+
+		simd::log(y, y, n);
+		for (index_t i=0; i<n; i++)
+			y[i]+=offset[i];
+	});
+}
+
 float64_t Statistics::erfc8_weighted_sum(float64_t x)
 {
 	/* This is based on index 5725 in Hart et al */
@@ -516,6 +594,32 @@ float64_t Statistics::normal_cdf(float64_t x, float64_t std_dev)
 	return 0.5*(erfc(-x*M_SQRT1_2/std_dev));
 }
 
+SGVector<float64_t> Statistics::normal_cdf(
+		const SGVector<float64_t>& x, float64_t std_dev)
+{
+	return evaluate_parallel(x, [std_dev](const float64_t* x, float64_t* y, index_t n) {
+		for (index_t i=0; i<n; i++)
+			y[i]=normal_cdf(x[i], std_dev);
+	});
+}
+
+SGVector<float64_t> Statistics::lgamma(const SGVector<float64_t>& x)
+{
+#ifdef __GLIBC__
+	return evaluate_parallel(x, [](const float64_t* x, float64_t* y, index_t n) {
+		int sign;
+		for (index_t i=0; i<n; i++)
+			y[i]=::lgamma_r(x[i], &sign);
+	});
+#else
+	// lgamma writes the sign to the global signgam
+	SGVector<float64_t> y(x.vlen);
+	for (index_t i=0; i<x.vlen; i++)
+		y[i]=lgamma(x[i]);
+	return y;
+#endif
+}
+
 float64_t Statistics::gamma_inverse_cdf(float64_t p, float64_t a,
 		float64_t b)
 {
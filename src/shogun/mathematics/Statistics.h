@@ -128,6 +128,14 @@ public:
 		return ::lgamma((double) x);
 	}
 
+	/** Elementwise \f$\log(\Gamma(x_i))\f$, evaluated in parallel where
+	 * the C library provides the reentrant lgamma_r.
+	 *
+	 * @param x arguments
+	 * @return log gamma of every argument
+	 */
+	static SGVector<float64_t> lgamma(const SGVector<float64_t>& x);
+
 	/** @return natural logarithm of the gamma function of input for large
 	 * numbers */
 	static inline floatmax_t lgammal(floatmax_t x)
@@ -188,6 +196,15 @@ public:
 	 */
 	static float64_t normal_cdf(float64_t x, float64_t std_dev=1);
 
+	/** Elementwise normal_cdf, evaluated in parallel
+	 *
+	 * @param x arguments
+	 * @param std_dev Standard deviation \f$\sigma\f$. Default value is 1.
+	 * @return Normal CDF of every argument
+	 */
+	static SGVector<float64_t> normal_cdf(
+			const SGVector<float64_t>& x, float64_t std_dev=1);
+
 	/** Inverse of Normal cumulative distribution function with mean \f$\mu\f$ and
 	 * standard deviation \f$\sigma\f$, given by
 	 *
@@ -205,6 +222,18 @@ public:
 	static float64_t inverse_normal_cdf(float64_t y0, float64_t mean=0,
 			float64_t std_dev=1);
 
+	/** Elementwise inverse_normal_cdf. The arguments are checked first and
+	 * evaluated sequentially, cdflib is not reentrant.
+	 *
+	 * @param y CDF values
+	 * @param mean Mean \f$\mu\f$. Default value is 0.
+	 * @param std_dev Standard deviation \f$\sigma\f$. Default value is 1.
+	 * @return Arguments that produce the CDF values
+	 */
+	static SGVector<float64_t> inverse_normal_cdf(
+			const SGVector<float64_t>& y, float64_t mean=0,
+			float64_t std_dev=1);
+
 	/** Returns logarithm of the cumulative distribution function
 	 * (CDF) of Gaussian distribution \f$N(0, 1)\f$:
 	 *
@@ -218,6 +247,14 @@ public:
 	 */
 	static float64_t lnormal_cdf(float64_t x);
 
+	/** Elementwise lnormal_cdf, evaluated in parallel with the logarithms
+	 * computed by simd::log
+	 *
+	 * @param x arguments
+	 * @return \f$log(\text{normal\_cdf}(x_i))\f$
+	 */
+	static SGVector<float64_t> lnormal_cdf(const SGVector<float64_t>& x);
+
 	/** Evaluates the CDF of the chi square distribution with
 	 * parameter k at \f$x\f$.
 	 *
@@ -227,6 +264,16 @@ public:
 	 */
 	static float64_t chi2_cdf(float64_t x, float64_t k);
 
+	/** Elementwise chi2_cdf. The arguments are checked first and evaluated
+	 * sequentially, cdflib is not reentrant.
+	 *
+	 * @param x positions to evaluate
+	 * @param k parameter
+	 * @return chi square CDF at every position
+	 */
+	static SGVector<float64_t> chi2_cdf(
+			const SGVector<float64_t>& x, float64_t k);
+
 	/** Evaluates the CDF of the F-distribution with parameters
 	 * \f$d1,d2\f$ at \f$x\f$. Based on Wikipedia definition.
 	 *
@@ -0,0 +1,266 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/features/streaming/StreamingSparseFeatures.h>
+#include <shogun/mathematics/SummaryStatistics.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+SummaryStatistics::SummaryStatistics(index_t num_features)
+    : m_num_vectors(0), m_count(num_features), m_mean(num_features),
+      m_m2(num_features), m_min(num_features), m_max(num_features)
+{
+	m_count.zero();
+	m_mean.zero();
+	m_m2.zero();
+	m_min.set_const(std::numeric_limits<float64_t>::infinity());
+	m_max.set_const(-std::numeric_limits<float64_t>::infinity());
+}
+
+namespace
+{
+	/** compute the statistics of num_vectors vectors, add(idx) adds the
+	 * vector idx to the given statistics. Every thread summarizes a
+	 * contiguous range of vectors, the ranges are merged in order so the
+	 * result does not depend on the scheduling.
+	 */
+	template <typename AddVector>
+	SummaryStatistics compute_parallel(
+	    index_t num_features, index_t num_vectors, AddVector add)
+	{
+		const index_t num_threads = std::max<index_t>(
+		    1, std::min<index_t>(env()->get_num_threads(), num_vectors));
+
+		std::vector<SummaryStatistics> partial;
+		partial.reserve(num_threads);
+		for (index_t t = 0; t < num_threads; ++t)
+			partial.emplace_back(num_features);
+
+		#pragma omp parallel for num_threads(num_threads)
+		for (index_t t = 0; t < num_threads; ++t)
+		{
+			const index_t begin = int64_t(num_vectors) * t / num_threads;
+			const index_t end = int64_t(num_vectors) * (t + 1) / num_threads;
+			for (index_t i = begin; i < end; ++i)
+				add(partial[t], i);
+		}
+
+		for (index_t t = 1; t < num_threads; ++t)
+			partial[0].merge(partial[t]);
+		return partial[0];
+	}
+} // namespace
+
+SummaryStatistics SummaryStatistics::compute(const SGMatrix<float64_t>& matrix)
+{
+	return compute_parallel(
+	    matrix.num_rows, matrix.num_cols,
+	    [&matrix](SummaryStatistics& stats, index_t i) {
+		    stats.add(matrix.get_column_vector(i));
+	    });
+}
+
+SummaryStatistics
+SummaryStatistics::compute(const std::shared_ptr<Features>& features)
+{
+	require(features, "No features provided");
+	require(
+	    features->get_feature_type() == F_DREAL,
+	    "Only real valued features are supported, got {}",
+	    features->get_name());
+
+	switch (features->get_feature_class())
+	{
+	case C_DENSE:
+		return compute(
+		    features->as<DenseFeatures<float64_t>>()->get_feature_matrix());
+	case C_SPARSE:
+	{
+		auto sparse = features->as<SparseFeatures<float64_t>>();
+		return compute_parallel(
+		    sparse->get_num_features(), sparse->get_num_vectors(),
+		    [&sparse](SummaryStatistics& stats, index_t i) {
+			    stats.add(sparse->get_sparse_feature_vector(i));
+		    });
+	}
+	case C_STREAMING_DENSE:
+	{
+		auto streaming = features->as<StreamingDenseFeatures<float64_t>>();
+		SummaryStatistics stats(streaming->get_dim_feature_space());
+		streaming->start_parser();
+		while (streaming->get_next_example())
+		{
+			stats.add(streaming->get_vector());
+			streaming->release_example();
+		}
+		streaming->end_parser();
+		return stats;
+	}
+	case C_STREAMING_SPARSE:
+	{
+		auto streaming = features->as<StreamingSparseFeatures<float64_t>>();
+		SummaryStatistics stats(streaming->get_dim_feature_space());
+		streaming->start_parser();
+		while (streaming->get_next_example())
+		{
+			stats.add(streaming->get_vector());
+			streaming->release_example();
+		}
+		streaming->end_parser();
+		return stats;
+	}
+	default:
+		error(
+		    "Features {} of class {} are not supported", features->get_name(),
+		    (int32_t)features->get_feature_class());
+	}
+	return SummaryStatistics();
+}
+
+void SummaryStatistics::add(const SGVector<float64_t>& vec)
+{
+	require(
+	    vec.vlen == get_num_features(),
+	    "Vector has {} features, expected {}", vec.vlen, get_num_features());
+	add(vec.vector);
+}
+
+void SummaryStatistics::add(const float64_t* vec)
+{
+	const index_t n = get_num_features();
+	Map<const ArrayXd> x(vec, n);
+	Map<ArrayXd> count(m_count.vector, n);
+	Map<ArrayXd> mean(m_mean.vector, n);
+	Map<ArrayXd> m2(m_m2.vector, n);
+	Map<ArrayXd> min(m_min.vector, n);
+	Map<ArrayXd> max(m_max.vector, n);
+
+	// Welford's update, vectorized over the features
+	count += 1;
+	const ArrayXd delta = x - mean;
+	mean += delta / count;
+	m2 += delta * (x - mean);
+	min = min.min(x);
+	max = max.max(x);
+	m_num_vectors++;
+}
+
+void SummaryStatistics::add(const SGSparseVector<float64_t>& vec)
+{
+	for (auto k : range(vec.num_feat_entries))
+	{
+		const index_t j = vec.features[k].feat_index;
+		const float64_t x = vec.features[k].entry;
+		require(
+		    j >= 0 && j < get_num_features(),
+		    "Feature index {} out of range, expected {} features", j,
+		    get_num_features());
+
+		m_count[j] += 1;
+		const float64_t delta = x - m_mean[j];
+		m_mean[j] += delta / m_count[j];
+		m_m2[j] += delta * (x - m_mean[j]);
+		m_min[j] = std::min(m_min[j], x);
+		m_max[j] = std::max(m_max[j], x);
+	}
+	m_num_vectors++;
+}
+
+void SummaryStatistics::merge(const SummaryStatistics& other)
+{
+	require(
+	    other.get_num_features() == get_num_features(),
+	    "Statistics of {} features cannot be merged into statistics of {} "
+	    "features", other.get_num_features(), get_num_features());
+
+	for (auto j : range(get_num_features()))
+	{
+		const float64_t n_b = other.m_count[j];
+		if (n_b == 0)
+			continue;
+
+		const float64_t n_a = m_count[j];
+		const float64_t n = n_a + n_b;
+		const float64_t delta = other.m_mean[j] - m_mean[j];
+		m_mean[j] += delta * n_b / n;
+		m_m2[j] += other.m_m2[j] + delta * delta * n_a * n_b / n;
+		m_count[j] = n;
+		m_min[j] = std::min(m_min[j], other.m_min[j]);
+		m_max[j] = std::max(m_max[j], other.m_max[j]);
+	}
+	m_num_vectors += other.m_num_vectors;
+}
+
+SummaryStatistics SummaryStatistics::with_implicit_zeros() const
+{
+	SummaryStatistics result(get_num_features());
+	result.merge(*this);
+
+	// the features missing from sparse vectors are a block of zeros
+	for (auto j : range(get_num_features()))
+	{
+		const float64_t n_b = m_num_vectors - m_count[j];
+		if (n_b <= 0)
+			continue;
+
+		const float64_t n_a = result.m_count[j];
+		const float64_t n = n_a + n_b;
+		const float64_t delta = -result.m_mean[j];
+		result.m_mean[j] += delta * n_b / n;
+		result.m_m2[j] += delta * delta * n_a * n_b / n;
+		result.m_count[j] = n;
+		result.m_min[j] = std::min(result.m_min[j], 0.0);
+		result.m_max[j] = std::max(result.m_max[j], 0.0);
+	}
+	return result;
+}
+
+SGVector<float64_t> SummaryStatistics::get_mean() const
+{
+	return with_implicit_zeros().m_mean;
+}
+
+SGVector<float64_t> SummaryStatistics::get_variance(bool unbiased) const
+{
+	const int64_t dof = m_num_vectors - (unbiased ? 1 : 0);
+	require(
+	    dof > 0, "The variance of {} vectors is not defined",
+	    m_num_vectors);
+
+	auto var = with_implicit_zeros().m_m2;
+	for (auto j : range(var.vlen))
+		var[j] = std::max(var[j], 0.0) / dof;
+	return var;
+}
+
+SGVector<float64_t> SummaryStatistics::get_std_dev(bool unbiased) const
+{
+	auto std_dev = get_variance(unbiased);
+	for (auto j : range(std_dev.vlen))
+		std_dev[j] = std::sqrt(std_dev[j]);
+	return std_dev;
+}
+
+SGVector<float64_t> SummaryStatistics::get_min() const
+{
+	return with_implicit_zeros().m_min;
+}
+
+SGVector<float64_t> SummaryStatistics::get_max() const
+{
+	return with_implicit_zeros().m_max;
+}
@@ -0,0 +1,147 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SUMMARY_STATISTICS_H_
+#define SUMMARY_STATISTICS_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+
+#include <memory>
+
+namespace shogun
+{
+class Features;
+
+/** @brief Per-feature summary statistics (mean, variance, min and max) of a
+ * set of feature vectors, computed in a single pass.
+ *
+ * Every feature keeps the number of explicitly seen values with their mean,
+ * sum of squared deviations from the mean, minimum and maximum, updated with
+ * Welford's method. Statistics of disjoint sets of vectors are combined by
+ * merge(), see
+ *
+ * Chan, Golub and LeVeque, "Updating formulae and a pairwise algorithm for
+ * computing sample variances", 1979
+ *
+ * which is how the computation over a matrix is split over threads, and how
+ * shards or streams of vectors can be summarized independently. Entries
+ * missing from sparse vectors count as zeros, they are folded into the
+ * statistics when those are queried.
+ */
+class SummaryStatistics
+{
+public:
+	/** constructor
+	 *
+	 * @param num_features number of features of the vectors
+	 */
+	SummaryStatistics(index_t num_features = 0);
+
+	/** compute the statistics of the columns of a matrix, in parallel
+	 *
+	 * @param matrix one vector per column
+	 * @return statistics of the columns
+	 */
+	static SummaryStatistics compute(const SGMatrix<float64_t>& matrix);
+
+	/** compute the statistics of dense or sparse real valued features, in
+	 * parallel, or of streaming dense or sparse real valued features,
+	 * which are read until the stream ends
+	 *
+	 * @param features features to summarize
+	 * @return statistics of the feature vectors
+	 */
+	static SummaryStatistics compute(const std::shared_ptr<Features>& features);
+
+	/** add a dense vector
+	 *
+	 * @param vec vector of length get_num_features()
+	 */
+	void add(const SGVector<float64_t>& vec);
+
+	/** add a dense vector
+	 *
+	 * @param vec pointer to get_num_features() values
+	 */
+	void add(const float64_t* vec);
+
+	/** add a sparse vector, features without entries are zero
+	 *
+	 * @param vec sparse vector with indices below get_num_features()
+	 */
+	void add(const SGSparseVector<float64_t>& vec);
+
+	/** merge the statistics of a disjoint set of vectors
+	 *
+	 * @param other statistics with the same number of features
+	 */
+	void merge(const SummaryStatistics& other);
+
+	/** @return number of features */
+	index_t get_num_features() const
+	{
+		return m_count.vlen;
+	}
+
+	/** @return number of added vectors */
+	int64_t get_num_vectors() const
+	{
+		return m_num_vectors;
+	}
+
+	/** @return mean of every feature */
+	SGVector<float64_t> get_mean() const;
+
+	/** get the variance of every feature
+	 *
+	 * @param unbiased divide by the number of vectors minus one instead of
+	 * the number of vectors
+	 * @return variance of every feature
+	 */
+	SGVector<float64_t> get_variance(bool unbiased = false) const;
+
+	/** get the standard deviation of every feature
+	 *
+	 * @param unbiased whether to use the unbiased variance
+	 * @return standard deviation of every feature
+	 */
+	SGVector<float64_t> get_std_dev(bool unbiased = false) const;
+
+	/** @return minimum of every feature */
+	SGVector<float64_t> get_min() const;
+
+	/** @return maximum of every feature */
+	SGVector<float64_t> get_max() const;
+
+private:
+	/** @return the statistics with the implicit zeros of sparse vectors */
+	SummaryStatistics with_implicit_zeros() const;
+
+	/** number of added vectors */
+	int64_t m_num_vectors;
+
+	/** number of explicitly seen values per feature */
+	SGVector<float64_t> m_count;
+
+	/** mean of the seen values per feature */
+	SGVector<float64_t> m_mean;
+
+	/** sum of squared deviations from the mean per feature */
+	SGVector<float64_t> m_m2;
+
+	/** minimum of the seen values per feature */
+	SGVector<float64_t> m_min;
+
+	/** maximum of the seen values per feature */
+	SGVector<float64_t> m_max;
+};
+} // namespace shogun
+
+#endif // SUMMARY_STATISTICS_H_
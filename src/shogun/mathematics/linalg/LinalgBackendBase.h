@@ -36,6 +36,8 @@
 #include <memory>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGMatrixList.h>
+#include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
@@ -150,6 +152,55 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_ADD_SCALAR, SGMatrix)
 #undef BACKEND_GENERIC_ADD_SCALAR
 
+/**
+ * Wrapper method of batched Cholesky decomposition.
+ *
+ * @see linalg::batch_cholesky_factor
+ */
+#define BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR(Type, Container)                 \
+	virtual Container<Type> batch_cholesky_factor(                             \
+	    const Container<Type>& A, const bool lower) const                      \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                                    \
+		return Container<Type>();                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR
+
+/**
+ * Wrapper method of batched solver with Cholesky decompositions.
+ *
+ * @see linalg::batch_cholesky_solver
+ */
+#define BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER(Type, Container)                 \
+	virtual Container<Type> batch_cholesky_solver(                             \
+	    const Container<Type>& L, const Container<Type>& B, const bool lower)  \
+	    const                                                                  \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                                    \
+		return Container<Type>();                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER
+
+/**
+ * Wrapper method of batched matrix product.
+ *
+ * @see linalg::batch_matrix_prod
+ */
+#define BACKEND_GENERIC_BATCH_MATRIX_PROD(Type, Container)                     \
+	virtual void batch_matrix_prod(                                            \
+	    const Container<Type>& A, const Container<Type>& B,                    \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const     \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                                    \
+	}
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_BATCH_MATRIX_PROD, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_MATRIX_PROD
+
 /**
  * Wrapper method of center matrix operation.
  *
@@ -635,6 +686,37 @@ namespace shogun
 		    BACKEND_GENERIC_MULTIPLY_BY_RECTIFIED_LINEAR_DERIV, SGMatrix)
 #undef BACKEND_GENERIC_MULTIPLY_BY_RECTIFIED_LINEAR_DERIV
 
+/**
+ * Wrapper method of k smallest elements of each column.
+ *
+ * @see linalg::colwise_k_smallest
+ */
+#define BACKEND_GENERIC_COLWISE_K_SMALLEST(Type, Container)                    \
+	virtual void colwise_k_smallest(                                           \
+	    const Container<Type>& a, SGMatrix<index_t>& result) const             \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                                    \
+	}
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_COLWISE_K_SMALLEST, SGMatrix)
+#undef BACKEND_GENERIC_COLWISE_K_SMALLEST
+
+/**
+ * Wrapper method of pairwise distances of the columns of two matrices.
+ *
+ * @see linalg::pairwise_distance
+ */
+#define BACKEND_GENERIC_PAIRWISE_DISTANCE(Type, Container)                     \
+	virtual void pairwise_distance(                                            \
+	    const Container<Type>& a, const Container<Type>& b,                    \
+	    Container<Type>& result, linalg::DistanceMetric metric) const          \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                                    \
+	}
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_PAIRWISE_DISTANCE, SGMatrix)
+#undef BACKEND_GENERIC_PAIRWISE_DISTANCE
+
 /**
  * Wrapper method that range fills a vector of matrix.
  *
@@ -897,6 +979,24 @@ namespace shogun
 		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SVD, SGMatrix)
 #undef BACKEND_GENERIC_SVD
 
+/**
+ * Wrapper method of randomized svd computation.
+ *
+ * @see linalg::randomized_svd
+ */
+#define BACKEND_GENERIC_RANDOMIZED_SVD(Type, Container)                        \
+	virtual void randomized_svd(                                               \
+	    const Container<Type>& A, const SGMatrix<Type>& omega,                 \
+	    SGVector<Type>& s, SGMatrix<Type>& U, SGMatrix<Type>& V,               \
+	    index_t num_power_iterations) const                                    \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                                    \
+	}
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_RANDOMIZED_SVD, SGMatrix)
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_RANDOMIZED_SVD, SGSparseMatrix)
+#undef BACKEND_GENERIC_RANDOMIZED_SVD
+
 /**
  * Wrapper method of trace computation.
  *
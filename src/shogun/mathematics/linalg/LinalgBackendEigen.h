@@ -97,6 +97,32 @@ namespace shogun
 		DEFINE_FOR_NUMERIC_PTYPE(BACKEND_GENERIC_ADD_SCALAR, SGMatrix)
 #undef BACKEND_GENERIC_ADD_SCALAR
 
+/** Implementation of @see LinalgBackendBase::batch_cholesky_factor */
+#define BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR(Type, Container)                 \
+	virtual Container<Type> batch_cholesky_factor(                             \
+	    const Container<Type>& A, const bool lower) const;
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR
+
+/** Implementation of @see LinalgBackendBase::batch_cholesky_solver */
+#define BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER(Type, Container)                 \
+	virtual Container<Type> batch_cholesky_solver(                             \
+	    const Container<Type>& L, const Container<Type>& B, const bool lower)  \
+	    const;
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER
+
+/** Implementation of @see LinalgBackendBase::batch_matrix_prod */
+#define BACKEND_GENERIC_BATCH_MATRIX_PROD(Type, Container)                     \
+	virtual void batch_matrix_prod(                                            \
+	    const Container<Type>& A, const Container<Type>& B,                    \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const;
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_BATCH_MATRIX_PROD, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_MATRIX_PROD
+
 /** Implementation of @see LinalgBackendBase::center_matrix */
 #define BACKEND_GENERIC_CENTER_MATRIX(Type, Container)                         \
 	virtual void center_matrix(Container<Type>& A) const;
@@ -345,6 +371,15 @@ namespace shogun
 		    BACKEND_GENERIC_MULTIPLY_BY_RECTIFIED_LINEAR_DERIV, SGMatrix)
 #undef BACKEND_GENERIC_MULTIPLY_BY_RECTIFIED_LINEAR_DERIV
 
+/** Implementation of @see linalg::pairwise_distance */
+#define BACKEND_GENERIC_PAIRWISE_DISTANCE(Type, Container)                     \
+	virtual void pairwise_distance(                                            \
+	    const Container<Type>& a, const Container<Type>& b,                    \
+	    Container<Type>& result, linalg::DistanceMetric metric) const;
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_PAIRWISE_DISTANCE, SGMatrix)
+#undef BACKEND_GENERIC_PAIRWISE_DISTANCE
+
 /** Implementation of @see LinalgBackendBase::qr_solver */
 #define BACKEND_GENERIC_QR_SOLVER(Type, Container)                             \
 	virtual Container<Type> qr_solver(                                         \
@@ -439,6 +474,14 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_SYMMETRIC_BLOCK_SUM, SGMatrix)
 #undef BACKEND_GENERIC_SYMMETRIC_BLOCK_SUM
 
+/** Implementation of @see linalg::colwise_k_smallest */
+#define BACKEND_GENERIC_COLWISE_K_SMALLEST(Type, Container)                    \
+	virtual void colwise_k_smallest(                                           \
+	    const Container<Type>& a, SGMatrix<index_t>& result) const;
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_COLWISE_K_SMALLEST, SGMatrix)
+#undef BACKEND_GENERIC_COLWISE_K_SMALLEST
+
 /** Implementation of @see LinalgBackendBase::colwise_sum */
 #define BACKEND_GENERIC_COLWISE_SUM(Type, Container)                           \
 	virtual SGVector<Type> colwise_sum(const Container<Type>& a, bool no_diag) \
@@ -475,6 +518,17 @@ namespace shogun
 		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SVD, SGMatrix)
 #undef BACKEND_GENERIC_SVD
 
+/** Implementation of @see LinalgBackendBase::randomized_svd */
+#define BACKEND_GENERIC_RANDOMIZED_SVD(Type, Container)                        \
+	virtual void randomized_svd(                                               \
+	    const Container<Type>& A, const SGMatrix<Type>& omega,                 \
+	    SGVector<Type>& s, SGMatrix<Type>& U, SGMatrix<Type>& V,               \
+	    index_t num_power_iterations) const;
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_RANDOMIZED_SVD, SGMatrix)
+		DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
+		    BACKEND_GENERIC_RANDOMIZED_SVD, SGSparseMatrix)
+#undef BACKEND_GENERIC_RANDOMIZED_SVD
+
 /** Implementation of @see LinalgBackendBase::trace */
 #define BACKEND_GENERIC_TRACE(Type, Container)                                 \
 	virtual Type trace(const Container<Type>& A) const;
@@ -559,6 +613,23 @@ namespace shogun
 		template <typename T>
 		void add_scalar_impl(SGMatrix<T>& a, T b) const;
 
+		/** Eigen3 batched Cholesky decomposition */
+		template <typename T>
+		SGMatrixList<T> batch_cholesky_factor_impl(
+		    const SGMatrixList<T>& A, const bool lower) const;
+
+		/** Eigen3 batched solver with Cholesky decompositions */
+		template <typename T>
+		SGMatrixList<T> batch_cholesky_solver_impl(
+		    const SGMatrixList<T>& L, const SGMatrixList<T>& B,
+		    const bool lower) const;
+
+		/** Eigen3 batched matrix product */
+		template <typename T>
+		void batch_matrix_prod_impl(
+		    const SGMatrixList<T>& A, const SGMatrixList<T>& B,
+		    SGMatrixList<T>& result, bool transpose_A, bool transpose_B) const;
+
 		/** Eigen3 center matrix method */
 		template <typename T>
 		void center_matrix_impl(SGMatrix<T>& A) const;
@@ -817,6 +888,13 @@ namespace shogun
 		void multiply_by_rectified_linear_derivative_impl(
 		    const SGMatrix<T>& a, SGMatrix<T>& result) const;
 
+		/** Eigen3 pairwise distances of the columns of a and b,
+		 * Euclidean and cosine distances use a single matrix product */
+		template <typename T>
+		void pairwise_distance_impl(
+		    const SGMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
+		    linalg::DistanceMetric metric) const;
+
 		/** Eigen3 vector QR solver. */
 		template <typename T>
 		SGVector<T>
@@ -901,6 +979,12 @@ namespace shogun
 		T sum_symmetric_impl(
 		    const linalg::Block<SGMatrix<T>>& mat, bool no_diag = false) const;
 
+		/** Row indices of the result.num_rows smallest elements of each
+		 * column, in ascending order */
+		template <typename T>
+		void colwise_k_smallest_impl(
+		    const SGMatrix<T>& a, SGMatrix<index_t>& result) const;
+
 		/** Eigen3 matrix colwise sum method */
 		template <typename T>
 		SGVector<T>
@@ -927,6 +1011,20 @@ namespace shogun
 		    const SGMatrix<T>& A, SGVector<T>& s, SGMatrix<T>& U, bool thin_U,
 		    linalg::SVDAlgorithm alg) const;
 
+		/** Eigen3 randomized svd method for dense matrices */
+		template <typename T>
+		void randomized_svd_impl(
+		    const SGMatrix<T>& A, const SGMatrix<T>& omega, SGVector<T>& s,
+		    SGMatrix<T>& U, SGMatrix<T>& V,
+		    index_t num_power_iterations) const;
+
+		/** Eigen3 randomized svd method for sparse matrices */
+		template <typename T>
+		void randomized_svd_impl(
+		    const SGSparseMatrix<T>& A, const SGMatrix<T>& omega,
+		    SGVector<T>& s, SGMatrix<T>& U, SGMatrix<T>& V,
+		    index_t num_power_iterations) const;
+
 		/** Eigen3 compute trace method */
 		template <typename T>
 		T trace_impl(const SGMatrix<T>& A) const;
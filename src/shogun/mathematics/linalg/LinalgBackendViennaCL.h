@@ -38,12 +38,17 @@
 
 #ifdef HAVE_VIENNACL
 
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/GPUMemoryViennaCL.h>
+#include <viennacl/linalg/direct_solve.hpp>
 #include <viennacl/linalg/inner_prod.hpp>
 #include <viennacl/linalg/prod.hpp>
 #include <viennacl/matrix.hpp>
+#include <viennacl/matrix_proxy.hpp>
 #include <viennacl/vector.hpp>
 
+#include <algorithm>
+
 #if VIENNACL_VERSION >= 10700
 #include <viennacl/linalg/sum.hpp>
 #endif
@@ -260,6 +265,124 @@ namespace shogun
 	DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_ROWWISE_SUM, SGMatrix)
 	#undef BACKEND_GENERIC_ROWWISE_SUM
 
+	/** Implementation of @see linalg::colwise_k_smallest */
+	#define BACKEND_GENERIC_COLWISE_K_SMALLEST(Type, Container) \
+	virtual void colwise_k_smallest(const Container<Type>& a, \
+		SGMatrix<index_t>& result) const \
+	{  \
+		colwise_k_smallest_impl(a, result); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_COLWISE_K_SMALLEST, SGMatrix)
+	#undef BACKEND_GENERIC_COLWISE_K_SMALLEST
+
+	/** Implementation of @see linalg::pairwise_distance */
+	#define BACKEND_GENERIC_PAIRWISE_DISTANCE(Type, Container) \
+	virtual void pairwise_distance(const Container<Type>& a, \
+		const Container<Type>& b, Container<Type>& result, \
+		linalg::DistanceMetric metric) const \
+	{  \
+		pairwise_distance_impl(a, b, result, metric); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_PAIRWISE_DISTANCE, SGMatrix)
+	#undef BACKEND_GENERIC_PAIRWISE_DISTANCE
+
+	/** Implementation of @see LinalgBackendBase::cholesky_factor */
+	#define BACKEND_GENERIC_CHOLESKY_FACTOR(Type, Container) \
+	virtual Container<Type> cholesky_factor(const Container<Type>& A, \
+		const bool lower) const \
+	{  \
+		return cholesky_factor_impl(A, lower); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_CHOLESKY_FACTOR, SGMatrix)
+	#undef BACKEND_GENERIC_CHOLESKY_FACTOR
+
+	/** Implementation of @see LinalgBackendBase::cholesky_solver */
+	#define BACKEND_GENERIC_CHOLESKY_SOLVER(Type, Container) \
+	virtual SGVector<Type> cholesky_solver(const Container<Type>& L, \
+		const SGVector<Type>& b, const bool lower) const \
+	{  \
+		return cholesky_solver_impl(L, b, lower); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_CHOLESKY_SOLVER, SGMatrix)
+	#undef BACKEND_GENERIC_CHOLESKY_SOLVER
+
+	/** Implementation of @see LinalgBackendBase::triangular_solver */
+	#define BACKEND_GENERIC_TRIANGULAR_SOLVER(Type, Container) \
+	virtual Container<Type> triangular_solver(const SGMatrix<Type>& L, \
+		const Container<Type>& b, const bool lower = true) const \
+	{  \
+		return triangular_solver_impl(L, b, lower); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_TRIANGULAR_SOLVER, SGVector)
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_TRIANGULAR_SOLVER, SGMatrix)
+	#undef BACKEND_GENERIC_TRIANGULAR_SOLVER
+
+	/** Implementation of @see LinalgBackendBase::transpose_matrix */
+	#define BACKEND_GENERIC_TRANSPOSE_MATRIX(Type, Container) \
+	virtual Container<Type> transpose_matrix(const Container<Type>& A) const \
+	{  \
+		return transpose_matrix_impl(A); \
+	}
+	DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_TRANSPOSE_MATRIX, SGMatrix)
+	#undef BACKEND_GENERIC_TRANSPOSE_MATRIX
+
+	/** Implementation of @see LinalgBackendBase::element_prod */
+	#define BACKEND_GENERIC_IN_PLACE_VECTOR_ELEMENT_PROD(Type, Container) \
+	virtual void element_prod(const Container<Type>& a, const Container<Type>& b,\
+		Container<Type>& result) const \
+	{  \
+		element_prod_impl(a, b, result); \
+	}
+	DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_VECTOR_ELEMENT_PROD, SGVector)
+	#undef BACKEND_GENERIC_IN_PLACE_VECTOR_ELEMENT_PROD
+
+	/** Implementation of @see LinalgBackendBase::element_div */
+	#define BACKEND_GENERIC_IN_PLACE_ELEMENT_DIV(Type, Container) \
+	virtual void element_div(const Container<Type>& a, const Container<Type>& b,\
+		Container<Type>& result) const \
+	{  \
+		element_div_impl(a, b, result); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_IN_PLACE_ELEMENT_DIV, SGVector)
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_IN_PLACE_ELEMENT_DIV, SGMatrix)
+	#undef BACKEND_GENERIC_IN_PLACE_ELEMENT_DIV
+
+	/** Implementation of the elementwise functions of @see LinalgBackendBase */
+	#define BACKEND_GENERIC_ELEMENTWISE_FUNCTION(Type, Container) \
+	virtual void exponent(const Container<Type>& a, Container<Type>& result) const \
+	{  \
+		exponent_impl(a, result); \
+	} \
+	virtual void log(const Container<Type>& a, Container<Type>& result) const \
+	{  \
+		log_impl(a, result); \
+	} \
+	virtual void sin(const Container<Type>& a, Container<Type>& result) const \
+	{  \
+		sin_impl(a, result); \
+	} \
+	virtual void cos(const Container<Type>& a, Container<Type>& result) const \
+	{  \
+		cos_impl(a, result); \
+	} \
+	virtual void sqrt(const Container<Type>& a, Container<Type>& result) const \
+	{  \
+		sqrt_impl(a, result); \
+	}
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_ELEMENTWISE_FUNCTION, SGVector)
+	DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_ELEMENTWISE_FUNCTION, SGMatrix)
+	#undef BACKEND_GENERIC_ELEMENTWISE_FUNCTION
+
+	/** Implementation of @see LinalgBackendBase::zero */
+	#define BACKEND_GENERIC_ZERO(Type, Container) \
+	virtual void zero(Container<Type>& a) const \
+	{  \
+		set_const_impl(a, Type(0)); \
+	}
+	DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_ZERO, SGVector)
+	DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_ZERO, SGMatrix)
+	#undef BACKEND_GENERIC_ZERO
+
 	/** Implementation of @see LinalgBackendBase::to_gpu */
 	#define BACKEND_GENERIC_TO_GPU(Type, Container) \
 	virtual GPUMemoryBase<Type>* to_gpu(const Container<Type>& a) const \
@@ -803,6 +926,344 @@ namespace shogun
 			return SGVector<T>(result_gpu, mat.num_rows);
 		}
 
+		/** ViennaCL colwise k smallest method, only the indices are
+		 * written to the result */
+		template <typename T>
+		void colwise_k_smallest_impl(
+		    const SGMatrix<T>& a, SGMatrix<index_t>& result) const
+		{
+			GPUMemoryViennaCL<T>* a_gpu = cast_to_viennacl(a);
+			GPUMemoryViennaCL<index_t>* result_gpu = cast_to_viennacl(result);
+
+			viennacl::ocl::kernel& kernel =
+			    generate_colwise_k_smallest_kernel<T>(result.num_rows);
+			kernel.global_work_size(
+			    0,
+			    linalg::implementation::ocl::align_to_multiple_1d(a.num_cols));
+
+			viennacl::ocl::enqueue(
+			    kernel(
+			        a_gpu->data_matrix(a.num_rows, a.num_cols),
+			        cl_int(a.num_rows), cl_int(a.num_cols),
+			        cl_int(a_gpu->m_offset),
+			        result_gpu->data_vector(result.size()),
+			        cl_int(result_gpu->m_offset)));
+		}
+
+		/** ViennaCL colwise squared norms of a matrix */
+		template <typename T>
+		SGVector<T> colwise_squared_norm(const SGMatrix<T>& mat) const
+		{
+			GPUMemoryViennaCL<T>* mat_gpu = cast_to_viennacl(mat);
+			GPUMemoryViennaCL<T>* result_gpu =
+			    new GPUMemoryViennaCL<T>(mat.num_cols);
+
+			viennacl::ocl::kernel& kernel =
+			    generate_colwise_squared_norm_kernel<T>();
+			kernel.global_work_size(
+			    0, linalg::implementation::ocl::align_to_multiple_1d(
+			           mat.num_cols));
+
+			viennacl::ocl::enqueue(
+			    kernel(
+			        mat_gpu->data_matrix(mat.num_rows, mat.num_cols),
+			        cl_int(mat.num_rows), cl_int(mat.num_cols),
+			        cl_int(mat_gpu->m_offset),
+			        result_gpu->data_vector(mat.num_cols),
+			        cl_int(result_gpu->m_offset)));
+
+			return SGVector<T>(result_gpu, mat.num_cols);
+		}
+
+		/** ViennaCL pairwise distance method, Euclidean and cosine distances
+		 * are computed from a single matrix product */
+		template <typename T>
+		void pairwise_distance_impl(
+		    const SGMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
+		    linalg::DistanceMetric metric) const
+		{
+			GPUMemoryViennaCL<T>* a_gpu = cast_to_viennacl(a);
+			GPUMemoryViennaCL<T>* b_gpu = cast_to_viennacl(b);
+			GPUMemoryViennaCL<T>* result_gpu = cast_to_viennacl(result);
+			const index_t size = result.num_rows * result.num_cols;
+
+			if (metric == linalg::DistanceMetric::Manhattan)
+			{
+				viennacl::ocl::kernel& kernel =
+				    generate_manhattan_distance_kernel<T>();
+				kernel.global_work_size(
+				    0, linalg::implementation::ocl::align_to_multiple_1d(size));
+
+				viennacl::ocl::enqueue(
+				    kernel(
+				        a_gpu->data_matrix(a.num_rows, a.num_cols),
+				        cl_int(a_gpu->m_offset),
+				        b_gpu->data_matrix(b.num_rows, b.num_cols),
+				        cl_int(b_gpu->m_offset), cl_int(a.num_rows),
+				        result_gpu->data_matrix(result.num_rows, result.num_cols),
+				        cl_int(result.num_rows), cl_int(result.num_cols),
+				        cl_int(result_gpu->m_offset)));
+				return;
+			}
+
+			result_gpu->data_matrix(result.num_rows, result.num_cols) =
+			    viennacl::linalg::prod(
+			        viennacl::trans(a_gpu->data_matrix(a.num_rows, a.num_cols)),
+			        b_gpu->data_matrix(b.num_rows, b.num_cols));
+
+			auto a_norms = colwise_squared_norm(a);
+			auto b_norms = colwise_squared_norm(b);
+			GPUMemoryViennaCL<T>* a_norms_gpu = cast_to_viennacl(a_norms);
+			GPUMemoryViennaCL<T>* b_norms_gpu = cast_to_viennacl(b_norms);
+
+			viennacl::ocl::kernel& kernel =
+			    generate_dot_to_distance_kernel<T>(metric);
+			kernel.global_work_size(
+			    0, linalg::implementation::ocl::align_to_multiple_1d(size));
+
+			viennacl::ocl::enqueue(
+			    kernel(
+			        result_gpu->data_matrix(result.num_rows, result.num_cols),
+			        cl_int(result.num_rows), cl_int(result.num_cols),
+			        cl_int(result_gpu->m_offset),
+			        a_norms_gpu->data_vector(a.num_cols),
+			        cl_int(a_norms_gpu->m_offset),
+			        b_norms_gpu->data_vector(b.num_cols),
+			        cl_int(b_norms_gpu->m_offset)));
+		}
+
+		/** Allocates the result vector on the GPU unless it is there */
+		template <typename T>
+		void gpu_result(const SGVector<T>& a, SGVector<T>& result) const
+		{
+			if (!result.on_gpu())
+				result = SGVector<T>(new GPUMemoryViennaCL<T>(a.vlen), a.vlen);
+		}
+
+		/** Allocates the result matrix on the GPU unless it is there */
+		template <typename T>
+		void gpu_result(const SGMatrix<T>& a, SGMatrix<T>& result) const
+		{
+			if (!result.on_gpu())
+				result = SGMatrix<T>(
+				    new GPUMemoryViennaCL<T>(a.num_rows * a.num_cols),
+				    a.num_rows, a.num_cols);
+		}
+
+		/** ViennaCL Cholesky decomposition method.
+		 * Blocked right-looking factorization \f$A = U^{T} U\f$: the small
+		 * diagonal blocks are factored on the host, the panel solves and
+		 * the trailing updates, which hold almost all of the work, run on
+		 * the GPU. The matrix stays on the GPU throughout.
+		 */
+		template <typename T>
+		SGMatrix<T>
+		cholesky_factor_impl(const SGMatrix<T>& A, const bool lower) const
+		{
+			typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixXt;
+			typedef typename GPUMemoryViennaCL<T>::VCLMatrixBase VCLMatrixBase;
+			const index_t block_size = 256;
+			const index_t n = A.num_rows;
+
+			GPUMemoryViennaCL<T>* A_gpu = cast_to_viennacl(A);
+			GPUMemoryViennaCL<T>* U_gpu = static_cast<GPUMemoryViennaCL<T>*>(
+			    A_gpu->clone_vector(A_gpu, n * n));
+			SGMatrix<T> result(U_gpu, n, n);
+			VCLMatrixBase U = U_gpu->data_matrix(n, n);
+
+			MatrixXt block;
+			for (index_t k = 0; k < n; k += block_size)
+			{
+				const index_t b = std::min(block_size, n - k);
+
+				block.resize(b, b);
+				for (index_t j = 0; j < b; ++j)
+					viennacl::backend::memory_read(
+					    *(U_gpu->m_data), (k + (k + j) * n) * sizeof(T),
+					    b * sizeof(T), block.col(j).data());
+
+				Eigen::LLT<MatrixXt, Eigen::Upper> llt(block);
+				require(
+				    llt.info() != Eigen::NumericalIssue,
+				    "Matrix is not Hermitian positive definite!");
+				block = llt.matrixU();
+
+				for (index_t j = 0; j < b; ++j)
+					viennacl::backend::memory_write(
+					    *(U_gpu->m_data), (k + (k + j) * n) * sizeof(T),
+					    b * sizeof(T), block.col(j).data());
+
+				if (k + b == n)
+					break;
+
+				viennacl::range diag(k, k + b), rest(k + b, n);
+				auto U11 = viennacl::project(U, diag, diag);
+				auto U12 = viennacl::project(U, diag, rest);
+				auto U21 = viennacl::project(U, rest, diag);
+				auto U22 = viennacl::project(U, rest, rest);
+
+				viennacl::linalg::inplace_solve(
+				    viennacl::trans(U11), U12, viennacl::linalg::lower_tag());
+				U22 -= viennacl::linalg::prod(viennacl::trans(U12), U12);
+				U21 *= T(0);
+			}
+
+			if (!lower)
+				return result;
+
+			return transpose_matrix_impl(result);
+		}
+
+		/** ViennaCL triangular solver method with the Cholesky factor */
+		template <typename T>
+		SGVector<T> cholesky_solver_impl(
+		    const SGMatrix<T>& L, const SGVector<T>& b, const bool lower) const
+		{
+			GPUMemoryViennaCL<T>* L_gpu = cast_to_viennacl(L);
+			GPUMemoryViennaCL<T>* b_gpu = cast_to_viennacl(b);
+			GPUMemoryViennaCL<T>* x_gpu = new GPUMemoryViennaCL<T>(b.vlen);
+			SGVector<T> result(x_gpu, b.vlen);
+
+			typename GPUMemoryViennaCL<T>::VCLMatrixBase L_vcl =
+			    L_gpu->data_matrix(L.num_rows, L.num_cols);
+			typename GPUMemoryViennaCL<T>::VCLVectorBase x =
+			    x_gpu->data_vector(b.vlen);
+			x = b_gpu->data_vector(b.vlen);
+
+			if (lower)
+			{
+				viennacl::linalg::inplace_solve(
+				    L_vcl, x, viennacl::linalg::lower_tag());
+				viennacl::linalg::inplace_solve(
+				    viennacl::trans(L_vcl), x, viennacl::linalg::upper_tag());
+			}
+			else
+			{
+				viennacl::linalg::inplace_solve(
+				    viennacl::trans(L_vcl), x, viennacl::linalg::lower_tag());
+				viennacl::linalg::inplace_solve(
+				    L_vcl, x, viennacl::linalg::upper_tag());
+			}
+
+			return result;
+		}
+
+		/** ViennaCL triangular solver method for a vector */
+		template <typename T>
+		SGVector<T> triangular_solver_impl(
+		    const SGMatrix<T>& L, const SGVector<T>& b, const bool lower) const
+		{
+			GPUMemoryViennaCL<T>* L_gpu = cast_to_viennacl(L);
+			GPUMemoryViennaCL<T>* b_gpu = cast_to_viennacl(b);
+			GPUMemoryViennaCL<T>* x_gpu = new GPUMemoryViennaCL<T>(b.vlen);
+			SGVector<T> result(x_gpu, b.vlen);
+
+			typename GPUMemoryViennaCL<T>::VCLVectorBase x =
+			    x_gpu->data_vector(b.vlen);
+			x = b_gpu->data_vector(b.vlen);
+
+			if (lower)
+				viennacl::linalg::inplace_solve(
+				    L_gpu->data_matrix(L.num_rows, L.num_cols), x,
+				    viennacl::linalg::lower_tag());
+			else
+				viennacl::linalg::inplace_solve(
+				    L_gpu->data_matrix(L.num_rows, L.num_cols), x,
+				    viennacl::linalg::upper_tag());
+
+			return result;
+		}
+
+		/** ViennaCL triangular solver method for a matrix */
+		template <typename T>
+		SGMatrix<T> triangular_solver_impl(
+		    const SGMatrix<T>& L, const SGMatrix<T>& b, const bool lower) const
+		{
+			GPUMemoryViennaCL<T>* L_gpu = cast_to_viennacl(L);
+			GPUMemoryViennaCL<T>* b_gpu = cast_to_viennacl(b);
+			GPUMemoryViennaCL<T>* x_gpu =
+			    new GPUMemoryViennaCL<T>(b.num_rows * b.num_cols);
+			SGMatrix<T> result(x_gpu, b.num_rows, b.num_cols);
+
+			typename GPUMemoryViennaCL<T>::VCLMatrixBase x =
+			    x_gpu->data_matrix(b.num_rows, b.num_cols);
+			x = b_gpu->data_matrix(b.num_rows, b.num_cols);
+
+			if (lower)
+				viennacl::linalg::inplace_solve(
+				    L_gpu->data_matrix(L.num_rows, L.num_cols), x,
+				    viennacl::linalg::lower_tag());
+			else
+				viennacl::linalg::inplace_solve(
+				    L_gpu->data_matrix(L.num_rows, L.num_cols), x,
+				    viennacl::linalg::upper_tag());
+
+			return result;
+		}
+
+		/** ViennaCL matrix transpose method */
+		template <typename T>
+		SGMatrix<T> transpose_matrix_impl(const SGMatrix<T>& A) const
+		{
+			GPUMemoryViennaCL<T>* A_gpu = cast_to_viennacl(A);
+			GPUMemoryViennaCL<T>* result_gpu =
+			    new GPUMemoryViennaCL<T>(A.num_rows * A.num_cols);
+
+			result_gpu->data_matrix(A.num_cols, A.num_rows) =
+			    viennacl::trans(A_gpu->data_matrix(A.num_rows, A.num_cols));
+
+			return SGMatrix<T>(result_gpu, A.num_cols, A.num_rows);
+		}
+
+		/** ViennaCL vector in-place elementwise product method */
+		template <typename T>
+		void element_prod_impl(
+		    const SGVector<T>& a, const SGVector<T>& b,
+		    SGVector<T>& result) const
+		{
+			GPUMemoryViennaCL<T>* a_gpu = cast_to_viennacl(a);
+			GPUMemoryViennaCL<T>* b_gpu = cast_to_viennacl(b);
+			gpu_result(a, result);
+			GPUMemoryViennaCL<T>* result_gpu = cast_to_viennacl(result);
+
+			result_gpu->data_vector(a.size()) = viennacl::linalg::element_prod(
+			    a_gpu->data_vector(a.size()), b_gpu->data_vector(b.size()));
+		}
+
+		/** ViennaCL in-place elementwise division method */
+		template <typename T, template <typename> class Container>
+		void element_div_impl(
+		    const Container<T>& a, const Container<T>& b,
+		    Container<T>& result) const
+		{
+			GPUMemoryViennaCL<T>* a_gpu = cast_to_viennacl(a);
+			GPUMemoryViennaCL<T>* b_gpu = cast_to_viennacl(b);
+			gpu_result(a, result);
+			GPUMemoryViennaCL<T>* result_gpu = cast_to_viennacl(result);
+
+			result_gpu->data_vector(a.size()) = viennacl::linalg::element_div(
+			    a_gpu->data_vector(a.size()), b_gpu->data_vector(b.size()));
+		}
+
+/** Elementwise function of a vector or matrix, as a vector of its elements */
+#define VIENNACL_ELEMENTWISE_FUNCTION(name, function)                          \
+	template <typename T, template <typename> class Container>                 \
+	void name##_impl(const Container<T>& a, Container<T>& result) const        \
+	{                                                                          \
+		GPUMemoryViennaCL<T>* a_gpu = cast_to_viennacl(a);                     \
+		gpu_result(a, result);                                                 \
+		GPUMemoryViennaCL<T>* result_gpu = cast_to_viennacl(result);           \
+                                                                               \
+		result_gpu->data_vector(a.size()) =                                    \
+		    viennacl::linalg::function(a_gpu->data_vector(a.size()));          \
+	}
+		VIENNACL_ELEMENTWISE_FUNCTION(exponent, element_exp)
+		VIENNACL_ELEMENTWISE_FUNCTION(log, element_log)
+		VIENNACL_ELEMENTWISE_FUNCTION(sin, element_sin)
+		VIENNACL_ELEMENTWISE_FUNCTION(cos, element_cos)
+		VIENNACL_ELEMENTWISE_FUNCTION(sqrt, element_sqrt)
+#undef VIENNACL_ELEMENTWISE_FUNCTION
+
 		/** Transfer data to GPU with ViennaCL method. */
 		template <typename T, template <typename> class Container>
 		GPUMemoryBase<T>* to_gpu_impl(const Container<T>& a) const
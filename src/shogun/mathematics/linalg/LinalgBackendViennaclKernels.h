@@ -34,9 +34,11 @@
 #define LINALG_BACKEND_VIENNACL_KERNELS_H__
 
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/linalg/LinalgEnums.h>
 
 #ifdef HAVE_VIENNACL
 #include <memory>
+#include <string>
 #include <shogun/mathematics/linalg/internal/opencl_util.h>
 
 namespace shogun
@@ -432,6 +434,232 @@ namespace shogun
 
 		return kernel;
 	}
+
+	/** Generates the colwise squared norm computation kernel
+	 * The OpenCL kernel that computes the squared norm of each column of a
+	 * SGMatrix
+	 */
+	template <class T>
+	static viennacl::ocl::kernel& generate_colwise_squared_norm_kernel()
+	{
+		std::string kernel_name = "colwise_squared_norm_" +
+		                          linalg::implementation::ocl::get_type_string<T>();
+
+		if (linalg::implementation::ocl::kernel_exists(kernel_name))
+			return linalg::implementation::ocl::get_kernel(kernel_name);
+
+		std::string source =
+		    linalg::implementation::ocl::generate_kernel_preamble<T>(
+		        kernel_name);
+
+		source.append(
+		    R"(
+				__kernel void KERNEL_NAME(
+					__global DATATYPE* mat, int nrows, int ncols, int offset,
+					__global DATATYPE* result, int result_offset)
+				{
+					int j = get_global_id(0);
+
+					if (j>=ncols)
+						return;
+
+					DATATYPE sum = 0;
+					for (int i=0; i<nrows; i++)
+						sum += pown(mat[offset+i+j*nrows], 2);
+
+					result[j+result_offset] = sum;
+				}
+			)");
+
+		viennacl::ocl::kernel& kernel =
+		    linalg::implementation::ocl::compile_kernel(kernel_name, source);
+
+		kernel.local_work_size(0, OCL_WORK_GROUP_SIZE_1D);
+
+		return kernel;
+	}
+
+	/** Generates the kernel that turns a matrix of dot products into
+	 * Euclidean or cosine distances, given the squared norms of the columns
+	 *
+	 * @param metric Euclidean, SquaredEuclidean or Cosine
+	 */
+	template <class T>
+	static viennacl::ocl::kernel&
+	generate_dot_to_distance_kernel(linalg::DistanceMetric metric)
+	{
+		std::string kernel_name =
+		    "dot_to_distance_" + linalg::implementation::ocl::get_type_string<T>();
+		if (metric == linalg::DistanceMetric::Euclidean)
+			kernel_name.append("_euclidean");
+		else if (metric == linalg::DistanceMetric::Cosine)
+			kernel_name.append("_cosine");
+
+		if (linalg::implementation::ocl::kernel_exists(kernel_name))
+			return linalg::implementation::ocl::get_kernel(kernel_name);
+
+		std::string source =
+		    linalg::implementation::ocl::generate_kernel_preamble<T>(
+		        kernel_name);
+		if (metric == linalg::DistanceMetric::Euclidean)
+			source.append("#define TAKE_SQRT\n");
+		else if (metric == linalg::DistanceMetric::Cosine)
+			source.append("#define COSINE\n");
+
+		source.append(
+		    R"(
+				__kernel void KERNEL_NAME(
+					__global DATATYPE* dots, int nrows, int ncols, int offset,
+					__global DATATYPE* a_norms, int a_offset,
+					__global DATATYPE* b_norms, int b_offset)
+				{
+					int idx = get_global_id(0);
+
+					if (idx>=nrows*ncols)
+						return;
+
+					int i = idx%nrows;
+					int j = idx/nrows;
+					DATATYPE dot = dots[offset+idx];
+
+				#ifdef COSINE
+					DATATYPE norms = sqrt(a_norms[a_offset+i]*b_norms[b_offset+j]);
+					DATATYPE result = norms==0 ? 0 : fmax(1-dot/norms, (DATATYPE)0);
+				#else
+					DATATYPE result = fmax(
+						a_norms[a_offset+i]+b_norms[b_offset+j]-2*dot, (DATATYPE)0);
+				#ifdef TAKE_SQRT
+					result = sqrt(result);
+				#endif
+				#endif
+
+					dots[offset+idx] = result;
+				}
+			)");
+
+		viennacl::ocl::kernel& kernel =
+		    linalg::implementation::ocl::compile_kernel(kernel_name, source);
+
+		kernel.local_work_size(0, OCL_WORK_GROUP_SIZE_1D);
+
+		return kernel;
+	}
+
+	/** Generates the Manhattan distance computation kernel
+	 * The OpenCL kernel that computes the Manhattan distances between the
+	 * columns of two SGMatrices, one work item per pair
+	 */
+	template <class T>
+	static viennacl::ocl::kernel& generate_manhattan_distance_kernel()
+	{
+		std::string kernel_name = "manhattan_distance_" +
+		                          linalg::implementation::ocl::get_type_string<T>();
+
+		if (linalg::implementation::ocl::kernel_exists(kernel_name))
+			return linalg::implementation::ocl::get_kernel(kernel_name);
+
+		std::string source =
+		    linalg::implementation::ocl::generate_kernel_preamble<T>(
+		        kernel_name);
+
+		source.append(
+		    R"(
+				__kernel void KERNEL_NAME(
+					__global DATATYPE* a, int a_offset,
+					__global DATATYPE* b, int b_offset, int dim,
+					__global DATATYPE* result, int nrows, int ncols,
+					int result_offset)
+				{
+					int idx = get_global_id(0);
+
+					if (idx>=nrows*ncols)
+						return;
+
+					int i = idx%nrows;
+					int j = idx/nrows;
+
+					DATATYPE sum = 0;
+					for (int d=0; d<dim; d++)
+						sum += fabs(a[a_offset+d+i*dim]-b[b_offset+d+j*dim]);
+
+					result[result_offset+idx] = sum;
+				}
+			)");
+
+		viennacl::ocl::kernel& kernel =
+		    linalg::implementation::ocl::compile_kernel(kernel_name, source);
+
+		kernel.local_work_size(0, OCL_WORK_GROUP_SIZE_1D);
+
+		return kernel;
+	}
+
+	/** Generates the colwise k smallest selection kernel
+	 * The OpenCL kernel that finds the row indices of the k smallest elements
+	 * of each column of a SGMatrix by insertion into a private list, one work
+	 * item per column
+	 *
+	 * @param k number of elements per column
+	 */
+	template <class T>
+	static viennacl::ocl::kernel& generate_colwise_k_smallest_kernel(index_t k)
+	{
+		std::string kernel_name = "colwise_k_smallest_" +
+		                          linalg::implementation::ocl::get_type_string<T>() +
+		                          "_" + std::to_string(k);
+
+		if (linalg::implementation::ocl::kernel_exists(kernel_name))
+			return linalg::implementation::ocl::get_kernel(kernel_name);
+
+		std::string source =
+		    linalg::implementation::ocl::generate_kernel_preamble<T>(
+		        kernel_name);
+		source.append("#define K " + std::to_string(k) + "\n");
+
+		source.append(
+		    R"(
+				__kernel void KERNEL_NAME(
+					__global DATATYPE* mat, int nrows, int ncols, int offset,
+					__global int* result, int result_offset)
+				{
+					int j = get_global_id(0);
+
+					if (j>=ncols)
+						return;
+
+					DATATYPE best_value[K];
+					int best_index[K];
+					int num_best = 0;
+
+					for (int i=0; i<nrows; i++)
+					{
+						DATATYPE value = mat[offset+i+j*nrows];
+						if (num_best==K && !(value<best_value[K-1]))
+							continue;
+
+						int p = num_best<K ? num_best++ : K-1;
+						while (p>0 && value<best_value[p-1])
+						{
+							best_value[p] = best_value[p-1];
+							best_index[p] = best_index[p-1];
+							p--;
+						}
+						best_value[p] = value;
+						best_index[p] = i;
+					}
+
+					for (int l=0; l<K; l++)
+						result[result_offset+l+j*K] = best_index[l];
+				}
+			)");
+
+		viennacl::ocl::kernel& kernel =
+		    linalg::implementation::ocl::compile_kernel(kernel_name, source);
+
+		kernel.local_work_size(0, OCL_WORK_GROUP_SIZE_1D);
+
+		return kernel;
+	}
 }
 #endif // HAVE_VIENNACL
 
@@ -73,6 +73,19 @@ namespace shogun
 			BidiagonalDivideConquer,
 			Jacobi
 		};
+
+		/**
+		 * Enum for choosing the metric of linalg::pairwise_distance.
+		 * Cosine is the cosine distance \f$1-\cos(x,y)\f$, clamped at zero and
+		 * zero if one of the vectors is zero.
+		 */
+		enum class DistanceMetric
+		{
+			Euclidean,
+			SquaredEuclidean,
+			Cosine,
+			Manhattan
+		};
 	}
 }
 
@@ -34,6 +34,9 @@
 #define LINALG_NAMESPACE_H_
 
 #include <shogun/base/ShogunEnv.h>
+#include <shogun/lib/SGVectorView.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgBackendBase.h>
 #include <shogun/mathematics/linalg/LinalgEnums.h>
 #include <shogun/mathematics/linalg/SGLinalg.h>
@@ -777,6 +780,124 @@ namespace shogun
 			    ->cholesky_solver(L, b, lower);
 		}
 
+		/**
+		 * Compute the Cholesky decompositions of a batch of matrices,
+		 * see cholesky_factor(). The batch is dispatched once and its
+		 * matrices are factored in parallel, which pays off for many small
+		 * matrices.
+		 *
+		 * @param A Hermitian positive definite matrices on CPU
+		 * @param lower Whether to compute the upper or lower triangular
+		 *  Cholesky factorizations (default:lower)
+		 * @return The triangular Cholesky factorizations
+		 */
+		template <typename T>
+		SGMatrixList<T>
+		batch_cholesky_factor(const SGMatrixList<T>& A, const bool lower = true)
+		{
+			for (index_t i = 0; i < A.num_matrices; ++i)
+			{
+				const auto& a = A.matrix_list[i];
+				require(
+				    a.num_rows == a.num_cols,
+				    "Matrix {} dimensions ({}x{}) are not square", i,
+				    a.num_rows, a.num_cols);
+				require(
+				    !a.on_gpu(), "Batched operations run on CPU only.");
+			}
+			return env()->linalg()->get_cpu_backend()->batch_cholesky_factor(
+			    A, lower);
+		}
+
+		/**
+		 * Solve the linear equations \f$A_i X_i=B_i\f$ of a batch, given
+		 * the Cholesky factorizations of the \f$A_i\f$, see
+		 * cholesky_solver(). The systems are solved in parallel.
+		 *
+		 * @param L Triangular matrices, Cholesky factorizations on CPU
+		 * @param B Right-hand sides, one matrix per system
+		 * @param lower Whether to use L as the upper or lower triangular
+		 *  Cholesky factorizations (default:lower)
+		 * @return The solutions \f$X_i\f$
+		 */
+		template <typename T>
+		SGMatrixList<T> batch_cholesky_solver(
+		    const SGMatrixList<T>& L, const SGMatrixList<T>& B,
+		    const bool lower = true)
+		{
+			require(
+			    L.num_matrices == B.num_matrices,
+			    "Number of factorizations ({}) must match number of "
+			    "right-hand sides ({})",
+			    L.num_matrices, B.num_matrices);
+			for (index_t i = 0; i < L.num_matrices; ++i)
+			{
+				const auto& l = L.matrix_list[i];
+				const auto& b = B.matrix_list[i];
+				require(
+				    l.num_rows == l.num_cols,
+				    "Matrix {} dimensions ({}x{}) are not square", i,
+				    l.num_rows, l.num_cols);
+				require(
+				    l.num_rows == b.num_rows,
+				    "Right-hand side {} rows ({}) must match matrix size "
+				    "({}x{})",
+				    i, b.num_rows, l.num_rows, l.num_cols);
+				require(
+				    !l.on_gpu() && !b.on_gpu(),
+				    "Batched operations run on CPU only.");
+			}
+			return env()->linalg()->get_cpu_backend()->batch_cholesky_solver(
+			    L, B, lower);
+		}
+
+		/**
+		 * Performs the operation \f$C_i = A_i * B_i\f$ for a batch of
+		 * matrices, see matrix_prod(). The products are computed in
+		 * parallel.
+		 *
+		 * @param A First matrices on CPU
+		 * @param B Second matrices on CPU
+		 * @param transpose_A Whether to transpose the matrices A_i
+		 * @param transpose_B Whether to transpose the matrices B_i
+		 * @return The products
+		 */
+		template <typename T>
+		SGMatrixList<T> batch_matrix_prod(
+		    const SGMatrixList<T>& A, const SGMatrixList<T>& B,
+		    bool transpose_A = false, bool transpose_B = false)
+		{
+			require(
+			    A.num_matrices == B.num_matrices,
+			    "Number of matrices in A ({}) must match B ({})",
+			    A.num_matrices, B.num_matrices);
+
+			SGMatrixList<T> result(A.num_matrices);
+			for (index_t i = 0; i < A.num_matrices; ++i)
+			{
+				const auto& a = A.matrix_list[i];
+				const auto& b = B.matrix_list[i];
+				const auto inner_a = transpose_A ? a.num_rows : a.num_cols;
+				const auto inner_b = transpose_B ? b.num_cols : b.num_rows;
+				require(
+				    inner_a == inner_b,
+				    "Matrices {} have mismatching inner dimensions ({} vs {})",
+				    i, inner_a, inner_b);
+				require(
+				    !a.on_gpu() && !b.on_gpu(),
+				    "Batched operations run on CPU only.");
+
+				result.set_matrix(
+				    i, SGMatrix<T>(
+				           transpose_A ? a.num_cols : a.num_rows,
+				           transpose_B ? b.num_rows : b.num_cols));
+			}
+
+			env()->linalg()->get_cpu_backend()->batch_matrix_prod(
+			    A, B, result, transpose_A, transpose_B);
+			return result;
+		}
+
 		/**
 		 * Compute the LDLT cholesky decomposition \f$A = P^{T} L D L^{*} P\f$
 		 * or \f$A = P^{T} U^{*} D U P\f$
@@ -884,6 +1005,63 @@ namespace shogun
 			return infer_backend(a, b)->dot(a, b);
 		}
 
+		/**
+		 * Vector dot-product of non-owning, possibly strided views,
+		 * computed on the CPU without touching reference counts.
+		 *
+		 * @param a First vector
+		 * @param b Second vector
+		 * @return The dot product of \f$\mathbf{a}\f$ and \f$\mathbf{b}\f$
+		 */
+		template <
+		    typename T, typename U,
+		    typename TU = typename promote<
+		        std::remove_const_t<T>, std::remove_const_t<U>>::type>
+		TU dot(const SGVectorView<T>& a, const SGVectorView<U>& b)
+		{
+			require(
+			    a.size() == b.size(),
+			    "Length of vector a ({}) doesn't match vector b ({}).",
+			    a.size(), b.size());
+
+			TU result = 0;
+			if (a.is_contiguous() && b.is_contiguous())
+			{
+				const T* pa = a.data();
+				const U* pb = b.data();
+				for (index_t i = 0; i < a.size(); ++i)
+					result += pa[i] * pb[i];
+			}
+			else
+			{
+				for (index_t i = 0; i < a.size(); ++i)
+					result += a[i] * b[i];
+			}
+			return result;
+		}
+
+		/**
+		 * Performs the operation \f$y\leftarrow\alpha x+y\f$ on
+		 * non-owning, possibly strided views.
+		 *
+		 * @param alpha Factor of x
+		 * @param x Vector to add
+		 * @param y Vector added to, in place
+		 */
+		template <typename T, typename U>
+		void axpy(
+		    std::remove_const_t<U> alpha, const SGVectorView<T>& x,
+		    const SGVectorView<U>& y)
+		{
+			require(
+			    x.size() == y.size(),
+			    "Length of vector x ({}) doesn't match vector y ({}).",
+			    x.size(), y.size());
+
+			for (index_t i = 0; i < x.size(); ++i)
+				y[i] += alpha * x[i];
+		}
+
 		/**
 		 * Compute the eigenvalues and eigenvectors of a matrix.
 		 * Note that the type of the computed values is the same
@@ -2166,6 +2344,77 @@ namespace shogun
 			infer_backend(A)->svd(A, s, U, thin_U, alg);
 		}
 
+		/**
+		 * Compute the leading k singular triplets \f$A \approx U S V^{T}\f$
+		 * of a dense or sparse matrix with the randomized algorithm of
+		 * Halko, Martinsson and Tropp. A Gaussian test matrix with
+		 * \f$l=k+p\f$ columns samples the range of A, power iterations
+		 * sharpen it for slowly decaying spectra, and only the small
+		 * \f$l \times n\f$ projection of A is decomposed exactly.
+		 * A is accessed only through products with \f$n \times l\f$ and
+		 * \f$m \times l\f$ blocks.
+		 *
+		 * For a sparse matrix, row i of A is the sparse vector i, i.e.
+		 * A has num_vectors rows and num_features columns.
+		 *
+		 * @param A The \f$m \times n\f$ matrix to decompose
+		 * @param k Number of singular triplets
+		 * @param s Resulting k largest singular values, descending
+		 * @param U Resulting \f$m \times k\f$ left singular vectors
+		 * @param V Resulting \f$n \times k\f$ right singular vectors
+		 * @param prng Random generator for the test matrix
+		 * @param num_oversamples Additional samples p of the range
+		 * (default: 10)
+		 * @param num_power_iterations Number of power iterations
+		 * (default: 2)
+		 */
+		template <typename T, template <typename> class Container, typename PRNG>
+		void randomized_svd(
+		    const Container<T>& A, index_t k, SGVector<T>& s, SGMatrix<T>& U,
+		    SGMatrix<T>& V, PRNG& prng, index_t num_oversamples = 10,
+		    index_t num_power_iterations = 2)
+		{
+			constexpr bool is_sparse =
+			    std::is_same<Container<T>, SGSparseMatrix<T>>::value;
+			index_t num_rows, num_cols;
+			if constexpr (is_sparse)
+			{
+				num_rows = A.num_vectors;
+				num_cols = A.num_features;
+			}
+			else
+			{
+				num_rows = A.num_rows;
+				num_cols = A.num_cols;
+			}
+
+			const auto r = Math::min(num_rows, num_cols);
+			require(
+			    k > 0 && k <= r,
+			    "Number of singular values ({}) must be in [1, {}].", k, r);
+			require(
+			    num_oversamples >= 0 && num_power_iterations >= 0,
+			    "Number of oversamples ({}) and power iterations ({}) must "
+			    "not be negative.",
+			    num_oversamples, num_power_iterations);
+
+			SGMatrix<T> omega(num_cols, Math::min(k + num_oversamples, r));
+			NormalDistribution<float64_t> normal_dist;
+			for (auto& x : omega)
+				x = static_cast<T>(normal_dist(prng));
+
+			s = SGVector<T>(k);
+			U = SGMatrix<T>(num_rows, k);
+			V = SGMatrix<T>(num_cols, k);
+
+			if constexpr (is_sparse)
+				env()->linalg()->get_cpu_backend()->randomized_svd(
+				    A, omega, s, U, V, num_power_iterations);
+			else
+				infer_backend(A)->randomized_svd(
+				    A, omega, s, U, V, num_power_iterations);
+		}
+
 		/**
 		 * Method that computes the trace of square matrix.
 		 *
@@ -2232,6 +2481,293 @@ namespace shogun
 		{
 			infer_backend(a)->zero(a);
 		}
+
+		/** @brief Lazy elementwise expression over CPU vectors and matrices.
+		 *
+		 * Created with lazy(). The arithmetic operators and the lazy
+		 * overloads of exponent(), log(), sqrt(), sin() and cos() only
+		 * record the chain as an Eigen array expression, nothing is
+		 * allocated or computed. eval() and the reductions sum(), max() and
+		 * dot() then compute the whole chain in a single pass over the
+		 * operands, without the temporaries of the eager operations.
+		 *
+		 * Operators are elementwise, also for matrices. The wrapped vectors
+		 * and matrices must outlive the expression.
+		 */
+		template <typename E>
+		class LazyExpression
+		{
+		public:
+			/** scalar type of the expression */
+			typedef typename E::Scalar Scalar;
+
+			/** constructor
+			 *
+			 * @param expr Eigen array expression
+			 */
+			explicit LazyExpression(const E& expr) : m_expr(expr)
+			{
+			}
+
+			/** @return the Eigen array expression */
+			const E& expression() const
+			{
+				return m_expr;
+			}
+
+			/** @return number of rows */
+			index_t rows() const
+			{
+				return m_expr.rows();
+			}
+
+			/** @return number of columns */
+			index_t cols() const
+			{
+				return m_expr.cols();
+			}
+
+		private:
+			/** Eigen array expression */
+			E m_expr;
+		};
+
+		/** Wraps an Eigen array expression into a LazyExpression.
+		 *
+		 * @param expr Eigen array expression
+		 * @return The lazy expression
+		 */
+		template <typename E>
+		LazyExpression<E> make_lazy(const E& expr)
+		{
+			return LazyExpression<E>(expr);
+		}
+
+		/** Starts a lazy expression on a vector, see LazyExpression.
+		 *
+		 * @param a Vector on CPU
+		 * @return The lazy expression
+		 */
+		template <typename T>
+		auto lazy(const SGVector<T>& a)
+		{
+			require(
+			    !a.on_gpu(), "Lazy expressions are evaluated on CPU only.");
+			typedef Eigen::Array<T, Eigen::Dynamic, 1> ArrayXt;
+			return make_lazy(Eigen::Map<const ArrayXt>(a.vector, a.vlen));
+		}
+
+		/** Starts a lazy expression on a matrix, see LazyExpression.
+		 *
+		 * @param a Matrix on CPU
+		 * @return The lazy expression
+		 */
+		template <typename T>
+		auto lazy(const SGMatrix<T>& a)
+		{
+			require(
+			    !a.on_gpu(), "Lazy expressions are evaluated on CPU only.");
+			typedef Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic> ArrayXXt;
+			return make_lazy(
+			    Eigen::Map<const ArrayXXt>(a.matrix, a.num_rows, a.num_cols));
+		}
+
+#define SG_LAZY_BINARY_OPERATOR(op)                                            \
+	template <typename E1, typename E2>                                        \
+	auto operator op(                                                          \
+	    const LazyExpression<E1>& a, const LazyExpression<E2>& b)              \
+	{                                                                          \
+		require(                                                               \
+		    a.rows() == b.rows() && a.cols() == b.cols(),                      \
+		    "Dimension mismatch! A({}x{}) vs B({}x{})", a.rows(), a.cols(),    \
+		    b.rows(), b.cols());                                               \
+		return make_lazy(a.expression() op b.expression());                    \
+	}                                                                          \
+                                                                               \
+	template <typename E>                                                      \
+	auto operator op(const LazyExpression<E>& a, typename E::Scalar b)         \
+	{                                                                          \
+		return make_lazy(a.expression() op b);                                 \
+	}
+
+		SG_LAZY_BINARY_OPERATOR(+)
+		SG_LAZY_BINARY_OPERATOR(-)
+		SG_LAZY_BINARY_OPERATOR(*)
+		SG_LAZY_BINARY_OPERATOR(/)
+#undef SG_LAZY_BINARY_OPERATOR
+
+		/** Lazy operation B = alpha + A */
+		template <typename E>
+		auto operator+(typename E::Scalar alpha, const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression() + alpha);
+		}
+
+		/** Lazy operation B = alpha - A */
+		template <typename E>
+		auto operator-(typename E::Scalar alpha, const LazyExpression<E>& a)
+		{
+			return make_lazy(alpha - a.expression());
+		}
+
+		/** Lazy operation B = alpha * A */
+		template <typename E>
+		auto operator*(typename E::Scalar alpha, const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression() * alpha);
+		}
+
+		/** Lazy operation B = -A */
+		template <typename E>
+		auto operator-(const LazyExpression<E>& a)
+		{
+			return make_lazy(-a.expression());
+		}
+
+		/** Lazy operation B = exp(A) */
+		template <typename E>
+		auto exponent(const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression().exp());
+		}
+
+		/** Lazy operation B = log(A) */
+		template <typename E>
+		auto log(const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression().log());
+		}
+
+		/** Lazy operation B = sqrt(A) */
+		template <typename E>
+		auto sqrt(const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression().sqrt());
+		}
+
+		/** Lazy operation B = sin(A) */
+		template <typename E>
+		auto sin(const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression().sin());
+		}
+
+		/** Lazy operation B = cos(A) */
+		template <typename E>
+		auto cos(const LazyExpression<E>& a)
+		{
+			return make_lazy(a.expression().cos());
+		}
+
+		/** Evaluates a lazy expression in one pass into an existing vector.
+		 *
+		 * The result may be one of the operands of the expression.
+		 *
+		 * @param a Lazy expression with a single column
+		 * @param result Vector of matching length
+		 */
+		template <typename E>
+		void eval(const LazyExpression<E>& a, SGVector<typename E::Scalar>& result)
+		{
+			typedef Eigen::Array<typename E::Scalar, Eigen::Dynamic, 1> ArrayXt;
+			require(
+			    a.cols() == 1, "Expression is a {}x{} matrix, not a vector.",
+			    a.rows(), a.cols());
+			require(
+			    a.rows() == result.vlen,
+			    "Dimension mismatch! A({}) vs result({})", a.rows(),
+			    result.vlen);
+			require(
+			    !result.on_gpu(), "Lazy expressions are evaluated on CPU only.");
+
+			Eigen::Map<ArrayXt>(result.vector, result.vlen) = a.expression();
+		}
+
+		/** Evaluates a lazy expression in one pass into an existing matrix.
+		 *
+		 * The result may be one of the operands of the expression.
+		 *
+		 * @param a Lazy expression
+		 * @param result Matrix of matching dimensions
+		 */
+		template <typename E>
+		void eval(const LazyExpression<E>& a, SGMatrix<typename E::Scalar>& result)
+		{
+			typedef Eigen::Array<typename E::Scalar, Eigen::Dynamic,
+			                     Eigen::Dynamic>
+			    ArrayXXt;
+			require(
+			    a.rows() == result.num_rows && a.cols() == result.num_cols,
+			    "Dimension mismatch! A({}x{}) vs result({}x{})", a.rows(),
+			    a.cols(), result.num_rows, result.num_cols);
+			require(
+			    !result.on_gpu(), "Lazy expressions are evaluated on CPU only.");
+
+			Eigen::Map<ArrayXXt>(result.matrix, result.num_rows,
+			                     result.num_cols) = a.expression();
+		}
+
+		/** Evaluates a lazy expression in one pass.
+		 *
+		 * This version returns the result in a newly created vector, or
+		 * matrix if the expression was started on a matrix.
+		 *
+		 * @param a Lazy expression
+		 * @return The result of the expression
+		 */
+		template <typename E>
+		auto eval(const LazyExpression<E>& a)
+		{
+			typedef typename E::Scalar T;
+			if constexpr (E::ColsAtCompileTime == 1)
+			{
+				SGVector<T> result(a.rows());
+				eval(a, result);
+				return result;
+			}
+			else
+			{
+				SGMatrix<T> result(a.rows(), a.cols());
+				eval(a, result);
+				return result;
+			}
+		}
+
+		/** Sums all elements of a lazy expression in one pass.
+		 *
+		 * @param a Lazy expression
+		 * @return The sum
+		 */
+		template <typename E>
+		typename E::Scalar sum(const LazyExpression<E>& a)
+		{
+			return a.expression().sum();
+		}
+
+		/** Maximum element of a lazy expression, computed in one pass.
+		 *
+		 * @param a Lazy expression
+		 * @return The maximum
+		 */
+		template <typename E>
+		typename E::Scalar max(const LazyExpression<E>& a)
+		{
+			require(a.rows() * a.cols() > 0, "Expression is empty.");
+			return a.expression().maxCoeff();
+		}
+
+		/** Dot product of two lazy expressions, computed in one pass.
+		 *
+		 * @param a First lazy expression
+		 * @param b Second lazy expression
+		 * @return The sum of the elementwise product
+		 */
+		template <typename E1, typename E2>
+		typename E1::Scalar
+		dot(const LazyExpression<E1>& a, const LazyExpression<E2>& b)
+		{
+			return sum(a * b);
+		}
 	} // namespace linalg
 } // namespace shogun
 
@@ -197,6 +197,81 @@ namespace shogun
 
 			return infer_backend(p, q)->squared_error(p, q);
 		}
+
+		/** Computes the distances between the columns of a and b,
+		 * \f$ R[i,j] = d(a_{:,i}, b_{:,j}) \f$.
+		 * This method returns the result in-place.
+		 *
+		 * If a and b are on the GPU, the result stays on the GPU, so
+		 * selections like colwise_k_smallest() can run on the device as well.
+		 *
+		 * @param a Input matrix, one vector per column
+		 * @param b Input matrix, one vector per column
+		 * @param result Output matrix of size a.num_cols x b.num_cols
+		 * @param metric The distance metric
+		 */
+		template <typename T>
+		void pairwise_distance(
+		    const SGMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
+		    DistanceMetric metric)
+		{
+			require(
+			    (a.num_rows == b.num_rows),
+			    "Number of rows of matrix a ({}) must match matrix b ({}).",
+			    a.num_rows, b.num_rows);
+			require(
+			    (result.num_rows == a.num_cols &&
+			     result.num_cols == b.num_cols),
+			    "Result matrix ({}x{}) must be of size {}x{}.",
+			    result.num_rows, result.num_cols, a.num_cols, b.num_cols);
+
+			infer_backend(a, b)->pairwise_distance(a, b, result, metric);
+		}
+
+		/** Computes the distances between the columns of a and b,
+		 * \f$ R[i,j] = d(a_{:,i}, b_{:,j}) \f$.
+		 * The result is on the GPU if a is.
+		 *
+		 * @param a Input matrix, one vector per column
+		 * @param b Input matrix, one vector per column
+		 * @param metric The distance metric
+		 * @return Matrix of size a.num_cols x b.num_cols
+		 */
+		template <typename T>
+		SGMatrix<T> pairwise_distance(
+		    const SGMatrix<T>& a, const SGMatrix<T>& b, DistanceMetric metric)
+		{
+			SGMatrix<T> result(a.num_cols, b.num_cols);
+			if (a.on_gpu())
+				to_gpu(result);
+
+			pairwise_distance(a, b, result, metric);
+			return result;
+		}
+
+		/** Finds the row indices of the k smallest elements of each column,
+		 * sorted in ascending order of the elements, ties go to the smaller
+		 * index. The result is on the GPU if a is, so only k indices per
+		 * column have to be transferred back to the host.
+		 *
+		 * @param a Input matrix
+		 * @param k Number of elements per column, at most a.num_rows
+		 * @return Matrix of size k x a.num_cols
+		 */
+		template <typename T>
+		SGMatrix<index_t> colwise_k_smallest(const SGMatrix<T>& a, index_t k)
+		{
+			require(
+			    (k > 0 && k <= a.num_rows),
+			    "Number of elements ({}) must be in [1, {}].", k, a.num_rows);
+
+			SGMatrix<index_t> result(k, a.num_cols);
+			if (a.on_gpu())
+				to_gpu(result);
+
+			infer_backend(a)->colwise_k_smallest(a, result);
+			return result;
+		}
 	}
 }
 
@@ -31,6 +31,7 @@
  */
 
 #include <shogun/base/range.h>
+#include <shogun/lib/simd.h>
 #include <shogun/mathematics/linalg/LinalgBackendEigen.h>
 #include <shogun/mathematics/linalg/LinalgMacros.h>
 
@@ -433,6 +434,18 @@ void LinalgBackendEigen::add_scalar_impl(SGMatrix<T>& a, T b) const
 template <typename T, typename U, typename TU>
 TU LinalgBackendEigen::dot_impl(const SGVector<T>& a, const SGVector<U>& b) const
 {
+	// float64 dots with the types of the vectorized kernels are dispatched
+	// to the instruction set of the processor
+	if constexpr (
+	    std::is_same<T, float64_t>::value &&
+	    std::is_same<TU, float64_t>::value &&
+	    (std::is_same<U, float64_t>::value ||
+	     std::is_same<U, float32_t>::value || std::is_same<U, int8_t>::value ||
+	     std::is_same<U, uint8_t>::value))
+	{
+		return simd::dot(b.vector, a.vector, a.vlen);
+	}
+
 	typename SGVector<T>::EigenVectorXtMap a_eig = a;
 	typename SGVector<U>::EigenVectorXtMap b_eig = b;
 
@@ -0,0 +1,156 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/mathematics/linalg/LinalgBackendEigen.h>
+#include <shogun/mathematics/linalg/LinalgMacros.h>
+
+using namespace shogun;
+
+#define BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR(Type, Container)                 \
+	Container<Type> LinalgBackendEigen::batch_cholesky_factor(                 \
+	    const Container<Type>& A, const bool lower) const                      \
+	{                                                                          \
+		return batch_cholesky_factor_impl(A, lower);                           \
+	}
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_CHOLESKY_FACTOR
+
+#define BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER(Type, Container)                 \
+	Container<Type> LinalgBackendEigen::batch_cholesky_solver(                 \
+	    const Container<Type>& L, const Container<Type>& B, const bool lower)  \
+	    const                                                                  \
+	{                                                                          \
+		return batch_cholesky_solver_impl(L, B, lower);                        \
+	}
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_CHOLESKY_SOLVER
+
+#define BACKEND_GENERIC_BATCH_MATRIX_PROD(Type, Container)                     \
+	void LinalgBackendEigen::batch_matrix_prod(                                \
+	    const Container<Type>& A, const Container<Type>& B,                    \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const     \
+	{                                                                          \
+		batch_matrix_prod_impl(A, B, result, transpose_A, transpose_B);        \
+	}
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_BATCH_MATRIX_PROD, SGMatrixList)
+#undef BACKEND_GENERIC_BATCH_MATRIX_PROD
+
+#undef DEFINE_FOR_ALL_PTYPE
+#undef DEFINE_FOR_NON_COMPLEX_PTYPE
+#undef DEFINE_FOR_NON_INTEGER_PTYPE
+#undef DEFINE_FOR_NUMERIC_PTYPE
+#undef DEFINE_FOR_ALL_PTYPE_EXCEPT_FLOAT64
+
+/* The batched methods dispatch once for the whole batch and spread the
+ * matrices over the threads. Every thread keeps its own decomposition, so
+ * matrices of equal size reuse its memory instead of allocating per call.
+ * Errors are counted inside the parallel region and raised after it.
+ */
+
+template <typename T>
+SGMatrixList<T> LinalgBackendEigen::batch_cholesky_factor_impl(
+    const SGMatrixList<T>& A, const bool lower) const
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixXt;
+
+	SGMatrixList<T> result(A.num_matrices);
+	for (index_t i = 0; i < A.num_matrices; ++i)
+		result.set_matrix(
+		    i, SGMatrix<T>(
+		           A.matrix_list[i].num_rows, A.matrix_list[i].num_cols));
+
+	index_t num_failed = 0;
+#pragma omp parallel reduction(+ : num_failed)
+	{
+		Eigen::LLT<MatrixXt> llt;
+#pragma omp for schedule(dynamic)
+		for (index_t i = 0; i < A.num_matrices; ++i)
+		{
+			typename SGMatrix<T>::EigenMatrixXtMap A_eig = A.matrix_list[i];
+			typename SGMatrix<T>::EigenMatrixXtMap c_eig =
+			    result.matrix_list[i];
+
+			llt.compute(A_eig);
+			if (llt.info() == Eigen::NumericalIssue)
+			{
+				num_failed++;
+				continue;
+			}
+
+			if (lower == false)
+				c_eig = llt.matrixU();
+			else
+				c_eig = llt.matrixL();
+		}
+	}
+
+	require(
+	    num_failed == 0,
+	    "{} of {} matrices are not Hermitian positive definite!", num_failed,
+	    A.num_matrices);
+
+	return result;
+}
+
+template <typename T>
+SGMatrixList<T> LinalgBackendEigen::batch_cholesky_solver_impl(
+    const SGMatrixList<T>& L, const SGMatrixList<T>& B, const bool lower) const
+{
+	SGMatrixList<T> result(B.num_matrices);
+	for (index_t i = 0; i < B.num_matrices; ++i)
+		result.set_matrix(i, B.matrix_list[i].clone());
+
+#pragma omp parallel for schedule(dynamic)
+	for (index_t i = 0; i < L.num_matrices; ++i)
+	{
+		typename SGMatrix<T>::EigenMatrixXtMap L_eig = L.matrix_list[i];
+		typename SGMatrix<T>::EigenMatrixXtMap x_eig = result.matrix_list[i];
+
+		if (lower == false)
+		{
+			L_eig.template triangularView<Eigen::Upper>()
+			    .transpose()
+			    .solveInPlace(x_eig);
+			L_eig.template triangularView<Eigen::Upper>().solveInPlace(x_eig);
+		}
+		else
+		{
+			L_eig.template triangularView<Eigen::Lower>().solveInPlace(x_eig);
+			L_eig.template triangularView<Eigen::Lower>()
+			    .transpose()
+			    .solveInPlace(x_eig);
+		}
+	}
+
+	return result;
+}
+
+template <typename T>
+void LinalgBackendEigen::batch_matrix_prod_impl(
+    const SGMatrixList<T>& A, const SGMatrixList<T>& B,
+    SGMatrixList<T>& result, bool transpose_A, bool transpose_B) const
+{
+#pragma omp parallel for schedule(dynamic)
+	for (index_t i = 0; i < A.num_matrices; ++i)
+	{
+		typename SGMatrix<T>::EigenMatrixXtMap a_eig = A.matrix_list[i];
+		typename SGMatrix<T>::EigenMatrixXtMap b_eig = B.matrix_list[i];
+		typename SGMatrix<T>::EigenMatrixXtMap result_eig =
+		    result.matrix_list[i];
+
+		if (transpose_A && transpose_B)
+			result_eig.noalias() = a_eig.transpose() * b_eig.transpose();
+
+		else if (transpose_A)
+			result_eig.noalias() = a_eig.transpose() * b_eig;
+
+		else if (transpose_B)
+			result_eig.noalias() = a_eig * b_eig.transpose();
+
+		else
+			result_eig.noalias() = a_eig * b_eig;
+	}
+}
@@ -30,6 +30,7 @@
  * Authors: 2016 Pan Deng, Soumyajit De, Heiko Strathmann, Viktor Gal
  */
 
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/linalg/LinalgBackendEigen.h>
 #include <shogun/mathematics/linalg/LinalgEnums.h>
 #include <shogun/mathematics/linalg/LinalgMacros.h>
@@ -75,6 +76,18 @@ DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_LDLT_FACTOR, SGMatrix)
 DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SVD, SGMatrix)
 #undef BACKEND_GENERIC_SVD
 
+#define BACKEND_GENERIC_RANDOMIZED_SVD(Type, Container)                        \
+	void LinalgBackendEigen::randomized_svd(                                   \
+	    const Container<Type>& A, const SGMatrix<Type>& omega,                 \
+	    SGVector<Type>& s, SGMatrix<Type>& U, SGMatrix<Type>& V,               \
+	    index_t num_power_iterations) const                                    \
+	{                                                                          \
+		randomized_svd_impl(A, omega, s, U, V, num_power_iterations);          \
+	}
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_RANDOMIZED_SVD, SGMatrix)
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_RANDOMIZED_SVD, SGSparseMatrix)
+#undef BACKEND_GENERIC_RANDOMIZED_SVD
+
 #undef DEFINE_FOR_ALL_PTYPE
 #undef DEFINE_FOR_NON_COMPLEX_PTYPE
 #undef DEFINE_FOR_NON_INTEGER_PTYPE
@@ -200,3 +213,112 @@ void LinalgBackendEigen::svd_impl(
 	}
 	}
 }
+
+namespace
+{
+	/** Orthonormal basis of the columns of Y, through a thin QR */
+	template <typename MatrixXt>
+	MatrixXt orthonormal_basis(const MatrixXt& Y)
+	{
+		Eigen::HouseholderQR<MatrixXt> qr(Y);
+		return qr.householderQ() * MatrixXt::Identity(Y.rows(), Y.cols());
+	}
+
+	/** Randomized svd of Halko, Martinsson and Tropp, "Finding structure
+	 * with randomness", SIAM Review 53(2), 2011 (algorithms 4.4 and 5.1).
+	 * The matrix is only accessed through its products with blocks,
+	 * A_times computes \f$AX\f$ and At_times computes \f$A^{T}X\f$.
+	 */
+	template <typename T, typename Prod, typename ProdT>
+	void randomized_svd_blocks(
+	    Prod A_times, ProdT At_times, const SGMatrix<T>& omega,
+	    SGVector<T>& s, SGMatrix<T>& U, SGMatrix<T>& V,
+	    index_t num_power_iterations)
+	{
+		typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixXt;
+
+		typename SGMatrix<T>::EigenMatrixXtMap omega_eig = omega;
+
+		// range of A, refined by power iterations that are
+		// re-orthonormalized after every product for stability
+		MatrixXt Q = orthonormal_basis<MatrixXt>(A_times(omega_eig));
+		for (index_t i = 0; i < num_power_iterations; ++i)
+		{
+			MatrixXt Z = orthonormal_basis<MatrixXt>(At_times(Q));
+			Q = orthonormal_basis<MatrixXt>(A_times(Z));
+		}
+
+		// B = Q^T A is small, its svd gives the one of A
+		MatrixXt Bt = At_times(Q);
+		Eigen::JacobiSVD<MatrixXt> svd_eig(
+		    Bt, Eigen::ComputeThinU | Eigen::ComputeThinV);
+
+		const index_t k = s.vlen;
+		typename SGVector<T>::EigenVectorXtMap s_eig = s;
+		typename SGMatrix<T>::EigenMatrixXtMap U_eig = U;
+		typename SGMatrix<T>::EigenMatrixXtMap V_eig = V;
+		s_eig = svd_eig.singularValues().head(k);
+		U_eig = Q * svd_eig.matrixV().leftCols(k);
+		V_eig = svd_eig.matrixU().leftCols(k);
+	}
+} // namespace
+
+template <typename T>
+void LinalgBackendEigen::randomized_svd_impl(
+    const SGMatrix<T>& A, const SGMatrix<T>& omega, SGVector<T>& s,
+    SGMatrix<T>& U, SGMatrix<T>& V, index_t num_power_iterations) const
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixXt;
+
+	typename SGMatrix<T>::EigenMatrixXtMap A_eig = A;
+	randomized_svd_blocks<T>(
+	    [&A_eig](const auto& X) -> MatrixXt { return A_eig * X; },
+	    [&A_eig](const auto& X) -> MatrixXt { return A_eig.transpose() * X; },
+	    omega, s, U, V, num_power_iterations);
+}
+
+template <typename T>
+void LinalgBackendEigen::randomized_svd_impl(
+    const SGSparseMatrix<T>& A, const SGMatrix<T>& omega, SGVector<T>& s,
+    SGMatrix<T>& U, SGMatrix<T>& V, index_t num_power_iterations) const
+{
+	typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixXt;
+
+	// row i of A is the sparse vector i. Both products work on transposed
+	// blocks, so that every entry touches one contiguous column.
+	auto A_times = [&A](const auto& X) -> MatrixXt {
+		MatrixXt Xt = X.transpose();
+		MatrixXt Yt(Xt.rows(), A.num_vectors);
+#pragma omp parallel for schedule(dynamic, 64)
+		for (index_t i = 0; i < A.num_vectors; ++i)
+		{
+			Yt.col(i).setZero();
+			for (index_t j = 0; j < A[i].num_feat_entries; ++j)
+				Yt.col(i) += A[i].features[j].entry *
+				             Xt.col(A[i].features[j].feat_index);
+		}
+		return Yt.transpose();
+	};
+
+	auto At_times = [&A](const auto& X) -> MatrixXt {
+		MatrixXt Xt = X.transpose();
+		MatrixXt Zt = MatrixXt::Zero(Xt.rows(), A.num_features);
+#pragma omp parallel
+		{
+			MatrixXt Zt_local = MatrixXt::Zero(Xt.rows(), A.num_features);
+#pragma omp for schedule(dynamic, 64) nowait
+			for (index_t i = 0; i < A.num_vectors; ++i)
+			{
+				for (index_t j = 0; j < A[i].num_feat_entries; ++j)
+					Zt_local.col(A[i].features[j].feat_index) +=
+					    A[i].features[j].entry * Xt.col(i);
+			}
+#pragma omp critical
+			Zt += Zt_local;
+		}
+		return Zt.transpose();
+	};
+
+	randomized_svd_blocks<T>(
+	    A_times, At_times, omega, s, U, V, num_power_iterations);
+}
@@ -33,8 +33,21 @@
 #include <shogun/mathematics/linalg/LinalgBackendEigen.h>
 #include <shogun/mathematics/linalg/LinalgMacros.h>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 using namespace shogun;
 
+#define BACKEND_GENERIC_COLWISE_K_SMALLEST(Type, Container)                    \
+	void LinalgBackendEigen::colwise_k_smallest(                               \
+	    const Container<Type>& a, SGMatrix<index_t>& result) const             \
+	{                                                                          \
+		colwise_k_smallest_impl(a, result);                                    \
+	}
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_COLWISE_K_SMALLEST, SGMatrix)
+#undef BACKEND_GENERIC_COLWISE_K_SMALLEST
+
 #define BACKEND_GENERIC_CROSS_ENTROPY(Type, Container)                         \
 	Type LinalgBackendEigen::cross_entropy(                                    \
 	    const Container<Type>& P, const Container<Type>& Q) const              \
@@ -72,6 +85,16 @@ DEFINE_FOR_NON_INTEGER_REAL_PTYPE(
     BACKEND_GENERIC_MULTIPLY_BY_RECTIFIED_LINEAR_DERIV, SGMatrix)
 #undef BACKEND_GENERIC_MULTIPLY_BY_RECTIFIED_LINEAR_DERIV
 
+#define BACKEND_GENERIC_PAIRWISE_DISTANCE(Type, Container)                     \
+	void LinalgBackendEigen::pairwise_distance(                                \
+	    const Container<Type>& a, const Container<Type>& b,                    \
+	    Container<Type>& result, linalg::DistanceMetric metric) const          \
+	{                                                                          \
+		pairwise_distance_impl(a, b, result, metric);                          \
+	}
+DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_PAIRWISE_DISTANCE, SGMatrix)
+#undef BACKEND_GENERIC_PAIRWISE_DISTANCE
+
 #define BACKEND_GENERIC_RECTIFIED_LINEAR(Type, Container)                      \
 	void LinalgBackendEigen::rectified_linear(                                 \
 	    const Container<Type>& a, Container<Type>& result) const               \
@@ -104,6 +127,30 @@ DEFINE_FOR_NON_INTEGER_REAL_PTYPE(BACKEND_GENERIC_SQUARED_ERROR, SGMatrix)
 #undef DEFINE_FOR_NUMERIC_PTYPE
 #undef DEFINE_FOR_ALL_PTYPE_EXCEPT_FLOAT64
 
+template <typename T>
+void LinalgBackendEigen::colwise_k_smallest_impl(
+    const SGMatrix<T>& a, SGMatrix<index_t>& result) const
+{
+	const index_t k = result.num_rows;
+
+#pragma omp parallel
+	{
+		std::vector<index_t> idx(a.num_rows);
+#pragma omp for
+		for (index_t j = 0; j < a.num_cols; ++j)
+		{
+			const T* col = a.get_column_vector(j);
+			std::iota(idx.begin(), idx.end(), 0);
+			std::partial_sort(
+			    idx.begin(), idx.begin() + k, idx.end(),
+			    [col](index_t x, index_t y) {
+				    return col[x] < col[y] || (col[x] == col[y] && x < y);
+			    });
+			std::copy_n(idx.begin(), k, result.get_column_vector(j));
+		}
+	}
+}
+
 template <typename T>
 T LinalgBackendEigen::cross_entropy_impl(
     const SGMatrix<T>& p, const SGMatrix<T>& q) const
@@ -146,6 +193,60 @@ void LinalgBackendEigen::multiply_by_rectified_linear_derivative_impl(
 			result_eig(i) = 0;
 }
 
+template <typename T>
+void LinalgBackendEigen::pairwise_distance_impl(
+    const SGMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
+    linalg::DistanceMetric metric) const
+{
+	typename SGMatrix<T>::EigenMatrixXtMap a_eig = a;
+	typename SGMatrix<T>::EigenMatrixXtMap b_eig = b;
+	typename SGMatrix<T>::EigenMatrixXtMap result_eig = result;
+
+	switch (metric)
+	{
+	case linalg::DistanceMetric::Euclidean:
+	case linalg::DistanceMetric::SquaredEuclidean:
+	{
+		// the expansion may become slightly negative for close vectors
+		result_eig.noalias() = -2 * a_eig.transpose() * b_eig;
+		result_eig.colwise() += a_eig.colwise().squaredNorm().transpose();
+		result_eig.rowwise() += b_eig.colwise().squaredNorm();
+		result_eig = result_eig.cwiseMax((T)0);
+		if (metric == linalg::DistanceMetric::Euclidean)
+			result_eig = result_eig.cwiseSqrt();
+		break;
+	}
+	case linalg::DistanceMetric::Cosine:
+	{
+		result_eig.noalias() = a_eig.transpose() * b_eig;
+		auto a_norms = a_eig.colwise().norm().transpose().eval();
+		auto b_norms = b_eig.colwise().norm().eval();
+		for (index_t j = 0; j < result.num_cols; ++j)
+		{
+			for (index_t i = 0; i < result.num_rows; ++i)
+			{
+				// zero vectors have distance zero to everything
+				const T norms = a_norms(i) * b_norms(j);
+				result_eig(i, j) =
+				    norms == 0 ? (T)0
+				               : std::max((T)1 - result_eig(i, j) / norms, (T)0);
+			}
+		}
+		break;
+	}
+	case linalg::DistanceMetric::Manhattan:
+	{
+#pragma omp parallel for
+		for (index_t j = 0; j < b.num_cols; ++j)
+		{
+			for (index_t i = 0; i < a.num_cols; ++i)
+				result_eig(i, j) = (a_eig.col(i) - b_eig.col(j)).cwiseAbs().sum();
+		}
+		break;
+	}
+	}
+}
+
 template <typename T>
 void LinalgBackendEigen::rectified_linear_impl(
     const SGMatrix<T>& a, SGMatrix<T>& result) const
@@ -0,0 +1,231 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/lib/common.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/eigsolver/LOBPCGEigenSolver.h>
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace Eigen;
+
+namespace shogun
+{
+
+namespace
+{
+	/** applies the operator to the columns of X */
+	MatrixXd apply_block(
+		const std::shared_ptr<LinearOperator<float64_t>>& op, const MatrixXd& X)
+	{
+		SGMatrix<float64_t> x(X.rows(), X.cols());
+		Map<MatrixXd>(x.matrix, x.num_rows, x.num_cols)=X;
+
+		SGMatrix<float64_t> ax=op->apply_block(x);
+		return Map<MatrixXd>(ax.matrix, ax.num_rows, ax.num_cols);
+	}
+
+	/** orthonormalizes the columns of S by an eigen decomposition of their
+	 * Gram matrix and applies the same transformation to AS. Directions
+	 * that are numerically linearly dependent are dropped.
+	 */
+	void orthonormalize(MatrixXd& S, MatrixXd& AS)
+	{
+		const float64_t eps=std::numeric_limits<float64_t>::epsilon();
+
+		// twice, since a single pass loses orthogonality for ill
+		// conditioned blocks
+		for (index_t pass=0; pass<2; ++pass)
+		{
+			VectorXd scale=S.colwise().norm().transpose();
+			for (index_t i=0; i<scale.size(); ++i)
+				scale[i]=scale[i]>0 ? 1.0/scale[i] : 0.0;
+
+			MatrixXd G=scale.asDiagonal()*(S.transpose()*S)*scale.asDiagonal();
+			SelfAdjointEigenSolver<MatrixXd> es(G);
+
+			const VectorXd& lambda=es.eigenvalues();
+			const float64_t threshold=lambda.maxCoeff()*S.cols()*eps*100;
+			index_t first=0;
+			while (first<lambda.size() && lambda[first]<=threshold)
+				first++;
+
+			const index_t rank=lambda.size()-first;
+			MatrixXd T=scale.asDiagonal()*es.eigenvectors().rightCols(rank)*
+				lambda.tail(rank).cwiseSqrt().cwiseInverse().asDiagonal();
+
+			S=S*T;
+			AS=AS*T;
+		}
+	}
+}
+
+LOBPCGEigenSolver::LOBPCGEigenSolver()
+	: RandomMixin<EigenSolver>()
+{
+	init();
+}
+
+LOBPCGEigenSolver::LOBPCGEigenSolver(
+	std::shared_ptr<LinearOperator<float64_t>> linear_operator,
+	int32_t num_eigenpairs)
+	: RandomMixin<EigenSolver>(std::move(linear_operator))
+{
+	init();
+
+	m_num_eigenpairs=num_eigenpairs;
+}
+
+void LOBPCGEigenSolver::init()
+{
+	m_num_eigenpairs=1;
+	m_block_size=0;
+	m_largest=false;
+	m_max_iteration_limit=1000;
+	m_tolerance=1E-8;
+	m_num_iterations=0;
+
+	SG_ADD(&m_num_eigenpairs, "num_eigenpairs",
+		"Number of eigenpairs to compute");
+
+	SG_ADD(&m_block_size, "block_size",
+		"Number of vectors iterated, 0 for the number of eigenpairs");
+
+	SG_ADD(&m_largest, "largest",
+		"Whether to compute the largest instead of the smallest eigenpairs");
+
+	SG_ADD(&m_max_iteration_limit, "max_iteration_limit",
+		"Maximum number of iteration for the solver");
+
+	SG_ADD(&m_tolerance, "tolerance",
+		"Relative residual tolerance of the solver");
+
+	SG_ADD(&m_eigenvalues, "eigenvalues", "Computed eigenvalues");
+
+	SG_ADD(&m_eigenvectors, "eigenvectors", "Computed eigenvectors");
+}
+
+LOBPCGEigenSolver::~LOBPCGEigenSolver()
+{
+}
+
+void LOBPCGEigenSolver::compute()
+{
+	SG_TRACE("Entering");
+
+	require(m_linear_operator, "Operator is NULL!");
+
+	const index_t n=m_linear_operator->get_dimension();
+	const index_t k=m_num_eigenpairs;
+	const index_t m=std::max(k, index_t(m_block_size));
+
+	require(k>0, "Number of eigenpairs ({}) must be positive!", k);
+	require(m<=n, "Block size ({}) must not exceed the dimension ({})!", m, n);
+
+	// random initial block
+	MatrixXd X(n, m);
+	random::fill_array(
+		X.data(), X.data()+X.size(), NormalDistribution<float64_t>(), m_prng);
+	MatrixXd AX=apply_block(m_linear_operator, X);
+	orthonormalize(X, AX);
+
+	// previous search directions, none before the first iteration
+	MatrixXd P(n, 0), AP(n, 0);
+
+	// orthonormal directions orthogonal to X, the Rayleigh-Ritz problem
+	// is solved on the span of X and W
+	MatrixXd W(n, 0), AW(n, 0);
+
+	VectorXd theta;
+	bool converged=false;
+	for (m_num_iterations=0; m_num_iterations<m_max_iteration_limit;
+		++m_num_iterations)
+	{
+		MatrixXd S(n, X.cols()+W.cols()), AS(n, S.cols());
+		S << X, W;
+		AS << AX, AW;
+
+		MatrixXd H=S.transpose()*AS;
+		H=(H+H.transpose())/2;
+		SelfAdjointEigenSolver<MatrixXd> es(H);
+		require(es.info()==Success, "Rayleigh-Ritz problem failed!");
+
+		MatrixXd C;
+		if (m_largest)
+		{
+			C=es.eigenvectors().rightCols(m).rowwise().reverse();
+			theta=es.eigenvalues().tail(m).reverse();
+		}
+		else
+		{
+			C=es.eigenvectors().leftCols(m);
+			theta=es.eigenvalues().head(m);
+		}
+
+		// the new search directions are the contributions of W
+		P=W*C.bottomRows(W.cols());
+		AP=AW*C.bottomRows(W.cols());
+		X=S*C;
+		AX=AS*C;
+
+		MatrixXd R=AX-X*theta.asDiagonal();
+		const float64_t scale=std::max(theta.cwiseAbs().maxCoeff(), 1.0);
+		const float64_t residual_norm=R.leftCols(k).colwise().norm().maxCoeff();
+
+		SG_DEBUG("LOBPCG iteration {}, residual norm {}",
+			m_num_iterations, residual_norm);
+
+		if (residual_norm<=m_tolerance*scale)
+		{
+			converged=true;
+			break;
+		}
+
+		W.resize(n, R.cols()+P.cols());
+		W << R, P;
+		AW.resize(n, W.cols());
+		AW << apply_block(m_linear_operator, R), AP;
+
+		// remove the components along X, twice for numerical stability
+		for (index_t pass=0; pass<2; ++pass)
+		{
+			MatrixXd XtW=X.transpose()*W;
+			W-=X*XtW;
+			AW-=AX*XtW;
+		}
+		orthonormalize(W, AW);
+	}
+
+	if (converged)
+	{
+		io::info("LOBPCG took {} iterations for {} eigenpairs",
+			m_num_iterations, k);
+	}
+	else
+	{
+		io::warn("LOBPCG did not converge within {} iterations!",
+			m_max_iteration_limit);
+	}
+
+	m_eigenvalues=SGVector<float64_t>(k);
+	Map<VectorXd>(m_eigenvalues.vector, k)=theta.head(k);
+	m_eigenvectors=SGMatrix<float64_t>(n, k);
+	Map<MatrixXd>(m_eigenvectors.matrix, n, k)=X.leftCols(k);
+
+	if (m_largest)
+		set_max_eigenvalue(theta[0]);
+	else
+		set_min_eigenvalue(theta[0]);
+
+	SG_TRACE("Leaving");
+}
+
+}
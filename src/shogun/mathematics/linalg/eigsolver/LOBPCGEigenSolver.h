@@ -0,0 +1,186 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef LOBPCG_EIGEN_SOLVER_H_
+#define LOBPCG_EIGEN_SOLVER_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/RandomMixin.h>
+#include <shogun/mathematics/linalg/eigsolver/EigenSolver.h>
+
+namespace shogun
+{
+template<class T> class LinearOperator;
+
+/** @brief Class that computes the k smallest or largest eigenpairs of a
+ * real valued, self-adjoint linear operator using the locally optimal block
+ * preconditioned conjugate gradient method (LOBPCG) without preconditioner.
+ *
+ * Every iteration applies the operator to one block of vectors through
+ * LinearOperator::apply_block and solves the Rayleigh-Ritz problem on the
+ * span of the current approximations, their residuals and the previous
+ * search directions. Only the operator products touch vectors of the full
+ * dimension, so operators with millions of rows can be handled.
+ *
+ * Reference: A. V. Knyazev, "Toward the optimal preconditioned eigensolver:
+ * locally optimal block preconditioned conjugate gradient method",
+ * SIAM J. Sci. Comput. 23(2), 2001.
+ */
+class LOBPCGEigenSolver : public RandomMixin<EigenSolver>
+{
+public:
+	/** default constructor */
+	LOBPCGEigenSolver();
+
+	/**
+	 * constructor
+	 *
+	 * @param linear_operator self-adjoint linear operator whose eigenpairs
+	 * are to be found
+	 * @param num_eigenpairs number of eigenpairs to compute
+	 */
+	LOBPCGEigenSolver(
+		std::shared_ptr<LinearOperator<float64_t>> linear_operator,
+		int32_t num_eigenpairs=1);
+
+	/** destructor */
+	~LOBPCGEigenSolver() override;
+
+	/**
+	 * compute method for computing the eigenpairs of a real valued linear
+	 * operator, also sets the min or max eigenvalue
+	 */
+	void compute() override;
+
+	/** @param num_eigenpairs number of eigenpairs to compute */
+	void set_num_eigenpairs(int32_t num_eigenpairs)
+	{
+		m_num_eigenpairs=num_eigenpairs;
+	}
+
+	/** @return number of eigenpairs to compute */
+	int32_t get_num_eigenpairs() const
+	{
+		return m_num_eigenpairs;
+	}
+
+	/** @param block_size number of vectors iterated, at least the number of
+	 * eigenpairs, 0 to iterate exactly those. Additional vectors speed up
+	 * the convergence of the last eigenpairs.
+	 */
+	void set_block_size(int32_t block_size)
+	{
+		m_block_size=block_size;
+	}
+
+	/** @return number of vectors iterated, 0 for the number of eigenpairs */
+	int32_t get_block_size() const
+	{
+		return m_block_size;
+	}
+
+	/** @param largest whether to compute the largest instead of the smallest
+	 * eigenpairs
+	 */
+	void set_largest(bool largest)
+	{
+		m_largest=largest;
+	}
+
+	/** @return whether the largest eigenpairs are computed */
+	bool get_largest() const
+	{
+		return m_largest;
+	}
+
+	/** @param max_iteration_limit to be set */
+	void set_max_iteration_limit(int64_t max_iteration_limit)
+	{
+		m_max_iteration_limit=max_iteration_limit;
+	}
+
+	/** @return max iteration limit */
+	int64_t get_max_iteration_limit() const
+	{
+		return m_max_iteration_limit;
+	}
+
+	/** @param tolerance residual norm relative to the largest magnitude of
+	 * the approximated eigenvalues, below which an eigenpair is converged
+	 */
+	void set_tolerance(float64_t tolerance)
+	{
+		m_tolerance=tolerance;
+	}
+
+	/** @return tolerance */
+	float64_t get_tolerance() const
+	{
+		return m_tolerance;
+	}
+
+	/** @return eigenvalues, ascending for the smallest and descending for
+	 * the largest eigenpairs
+	 */
+	SGVector<float64_t> get_eigenvalues() const
+	{
+		return m_eigenvalues;
+	}
+
+	/** @return eigenvectors, one column per eigenvalue */
+	SGMatrix<float64_t> get_eigenvectors() const
+	{
+		return m_eigenvectors;
+	}
+
+	/** @return number of iterations the last computation took */
+	int64_t get_num_iterations() const
+	{
+		return m_num_iterations;
+	}
+
+	/** @return object name */
+	const char* get_name() const override
+	{
+		return "LOBPCGEigenSolver";
+	}
+
+private:
+	/** register params and initialize with default values */
+	void init();
+
+private:
+	/** number of eigenpairs to compute */
+	int32_t m_num_eigenpairs;
+
+	/** number of vectors iterated, 0 for the number of eigenpairs */
+	int32_t m_block_size;
+
+	/** whether to compute the largest eigenpairs */
+	bool m_largest;
+
+	/** maximum iteration limit */
+	int64_t m_max_iteration_limit;
+
+	/** relative residual tolerance */
+	float64_t m_tolerance;
+
+	/** number of iterations of the last computation */
+	int64_t m_num_iterations;
+
+	/** computed eigenvalues */
+	SGVector<float64_t> m_eigenvalues;
+
+	/** computed eigenvectors */
+	SGMatrix<float64_t> m_eigenvectors;
+};
+
+}
+
+#endif // LOBPCG_EIGEN_SOLVER_H_
@@ -4,8 +4,12 @@
  * Authors: Soumyajit De, Sunil Mahendrakar, Bjoern Esser
  */
 
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/linalg/linop/LinearOperator.h>
 
+#include <algorithm>
+
 namespace shogun
 {
 
@@ -34,6 +38,27 @@ const index_t LinearOperator<T>::get_dimension() const
 	return m_dimension;
 }
 
+template<class T>
+SGMatrix<T> LinearOperator<T>::apply_block(SGMatrix<T> B) const
+{
+	require(m_dimension==B.num_rows,
+		"Number of rows of matrix must be equal to the "
+		"number of cols of the operator!");
+
+	SGMatrix<T> result;
+	for (index_t j=0; j<B.num_cols; ++j)
+	{
+		SGVector<T> b(B.get_column_vector(j), B.num_rows, false);
+		SGVector<T> col=apply(b);
+
+		if (j==0)
+			result=SGMatrix<T>(col.vlen, B.num_cols);
+		std::copy(col.vector, col.vector+col.vlen, result.get_column_vector(j));
+	}
+
+	return result;
+}
+
 template<class T>
 void LinearOperator<T>::init()
 {
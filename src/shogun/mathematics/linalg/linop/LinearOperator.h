@@ -44,6 +44,16 @@ public:
 	 */
 	virtual SGVector<T> apply(SGVector<T> b) const=0;
 
+	/**
+	 * method that applies the linear operator to all columns of a matrix,
+	 * block methods use it for their products. The default applies the
+	 * operator column by column.
+	 *
+	 * @param B the matrix whose columns the linear operator applies to
+	 * @return the matrix of results, one column per column of B
+	 */
+	virtual SGMatrix<T> apply_block(SGMatrix<T> B) const;
+
 	/** @return object name */
 	const char* get_name() const override
 	{
@@ -5,12 +5,15 @@
  */
 
 #include <shogun/lib/config.h>
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 #include <shogun/mathematics/eigen3.h>
 
+#include <algorithm>
+
 namespace shogun
 {
 
@@ -190,12 +193,13 @@ void SparseMatrixOperator<T>::set_diagonal(SGVector<T> diag)
 			// we create a new entry if the diagonal element for this row doesn't exist
 			if (!inserted)
 			{
+				// a new row, the entries may be stored contiguously
 				index_t j=m_operator[i].num_feat_entries;
-				m_operator[i].num_feat_entries=j+1;
-				m_operator[i].features=SG_REALLOC(SGSparseVectorEntry<T>,
-					m_operator[i].features, j, j+1);
-				m_operator[i].features[j].feat_index=i;
-				m_operator[i].features[j].entry=diag[i];
+				SGSparseVector<T> row(j+1);
+				std::copy(current_row, current_row+j, row.features);
+				row.features[j].feat_index=i;
+				row.features[j].entry=diag[i];
+				m_operator[i]=row;
 				need_sorting=true;
 			}
 		}
@@ -213,7 +217,38 @@ SGVector<T> SparseMatrixOperator<T>::apply(SGVector<T> b) const
 			"number of cols of the operator!");
 
 		SGVector<T> result(m_operator.num_vectors);
-		result=m_operator*b;
+#pragma omp parallel for schedule(static)
+		for (index_t i=0; i<m_operator.num_vectors; ++i)
+			result[i]=m_operator.sparse_matrix[i].dense_dot(1.0, b.vector, b.vlen, 0.0);
+
+		return result;
+	}
+
+template<class T>
+SGMatrix<T> SparseMatrixOperator<T>::apply_block(SGMatrix<T> B) const
+	{
+		require(m_operator.sparse_matrix, "Operator not initialized!");
+		require(this->get_dimension()==B.num_rows,
+			"Number of rows of matrix must be equal to the "
+			"number of cols of the operator!");
+
+		const index_t num_rows=m_operator.num_vectors;
+		SGMatrix<T> result(num_rows, B.num_cols);
+		result.zero();
+
+#pragma omp parallel for schedule(static)
+		for (index_t i=0; i<num_rows; ++i)
+		{
+			const SGSparseVectorEntry<T>* row=m_operator[i].features;
+			for (index_t k=0; k<m_operator[i].num_feat_entries; ++k)
+			{
+				const T entry=row[k].entry;
+				const T* b=B.matrix+row[k].feat_index;
+				T* r=result.matrix+i;
+				for (index_t j=0; j<B.num_cols; ++j)
+					r[int64_t(j)*num_rows]+=entry*b[int64_t(j)*B.num_rows];
+			}
+		}
 
 		return result;
 	}
@@ -224,6 +259,13 @@ SGVector<type> SparseMatrixOperator<type>::apply(SGVector<type> b) const \
 	{	\
 		error("Not supported for {}", #type);\
 		return b; \
+	} \
+\
+template<> \
+SGMatrix<type> SparseMatrixOperator<type>::apply_block(SGMatrix<type> B) const \
+	{	\
+		error("Not supported for {}", #type);\
+		return B; \
 	}
 
 UNDEFINED(bool)
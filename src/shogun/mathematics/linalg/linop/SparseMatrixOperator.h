@@ -126,6 +126,16 @@ public:
 	 */
 	SGVector<T> apply(SGVector<T> b) const override;
 
+	/**
+	 * method that applies the sparse-matrix linear operator to all columns
+	 * of a matrix. The rows are distributed over the threads and each row
+	 * is read once for all columns.
+	 *
+	 * @param B the matrix whose columns the linear operator applies to
+	 * @return the result matrix
+	 */
+	SGMatrix<T> apply_block(SGMatrix<T> B) const override;
+
 	/**
 	 * method that sets the main diagonal of the matrix
 	 *
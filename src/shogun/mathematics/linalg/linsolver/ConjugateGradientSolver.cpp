@@ -7,6 +7,7 @@
 #include <shogun/lib/common.h>
 
 
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Time.h>
@@ -15,11 +16,30 @@
 #include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
 #include <shogun/mathematics/linalg/linsolver/IterativeSolverIterator.h>
 
+#include <vector>
+
 using namespace Eigen;
 
 namespace shogun
 {
 
+namespace
+{
+	/** applies the preconditioner to the columns of R, if there is one */
+	MatrixXd precondition(
+		const std::shared_ptr<LinearOperator<float64_t>>& M, const MatrixXd& R)
+	{
+		if (!M)
+			return R;
+
+		SGMatrix<float64_t> r(R.rows(), R.cols());
+		Map<MatrixXd>(r.matrix, r.num_rows, r.num_cols)=R;
+
+		SGMatrix<float64_t> z=M->apply_block(r);
+		return Map<MatrixXd>(z.matrix, z.num_rows, z.num_cols);
+	}
+}
+
 ConjugateGradientSolver::ConjugateGradientSolver()
 	: IterativeLinearSolver<float64_t>()
 {
@@ -61,15 +81,16 @@ SGVector<float64_t> ConjugateGradientSolver::solve(
 	// residual r_i=b-Ax_i, here x_0=[0], so r_0=b
 	VectorXd r=b_map;
 
-	// initial direction is same as residual
-	p=r;
+	// preconditioned residual, the initial direction
+	VectorXd z=precondition(m_preconditioner, r);
+	p=z;
 
 	// the iterator for this iterative solver
 	IterativeSolverIterator<float64_t> it(b_map, m_max_iteration_limit,
 		m_relative_tolerence, m_absolute_tolerence);
 
 	// CG iteration begins
-	float64_t r_norm2=r.dot(r);
+	float64_t r_dot_z=r.dot(z);
 
 	// start the timer
 	Time time;
@@ -101,7 +122,7 @@ SGVector<float64_t> ConjugateGradientSolver::solve(
 			break;
 
 		// compute the alpha parameter of CG
-		float64_t alpha=r_norm2/p_dot_Ap;
+		float64_t alpha=r_dot_z/p_dot_Ap;
 
 		// update the solution vector and residual
 		// x_{i}=x_{i-1}+\alpha_{i}p
@@ -116,11 +137,13 @@ SGVector<float64_t> ConjugateGradientSolver::solve(
 			break;
 
 		// compute the beta parameter of CG
-		float64_t beta=r_norm2_i/r_norm2;
+		z=precondition(m_preconditioner, r);
+		float64_t r_dot_z_i=r.dot(z);
+		float64_t beta=r_dot_z_i/r_dot_z;
 
-		// update direction, and ||r||_{2}
-		r_norm2=r_norm2_i;
-		p=r+beta*p;
+		// update direction, and r^{T}z
+		r_dot_z=r_dot_z_i;
+		p=z+beta*p;
 	}
 
 	float64_t elapsed=time.cur_time_diff();
@@ -135,4 +158,128 @@ SGVector<float64_t> ConjugateGradientSolver::solve(
 	return result;
 }
 
+SGMatrix<float64_t> ConjugateGradientSolver::solve_block(
+	std::shared_ptr<LinearOperator<float64_t>> A, SGMatrix<float64_t> B)
+{
+	SG_TRACE("Entering..");
+
+	// sanity check
+	require(A, "Operator is NULL!");
+	require(A->get_dimension()==B.num_rows, "Dimension mismatch!");
+
+	const index_t num_rows=B.num_rows;
+	const index_t num_rhs=B.num_cols;
+
+	// the final solution vectors, initial guess is 0
+	SGMatrix<float64_t> result(num_rows, num_rhs);
+	result.zero();
+	Map<MatrixXd> X(result.matrix, num_rows, num_rhs);
+	Map<MatrixXd> B_map(B.matrix, num_rows, num_rhs);
+
+	// residuals R_0=B, since X_0=[0], directions start as the
+	// preconditioned residuals
+	MatrixXd R=B_map;
+	MatrixXd P=precondition(m_preconditioner, R);
+	VectorXd r_dot_z=R.cwiseProduct(P).colwise().sum().transpose();
+
+	// per column tolerence, see IterativeSolverIterator
+	VectorXd tolerence=(m_relative_tolerence*B_map.colwise().norm()).array()
+		+m_absolute_tolerence;
+	VectorXd r_norm2=R.colwise().squaredNorm();
+
+	// columns that did not converge yet, and those that broke down
+	std::vector<index_t> active;
+	std::vector<char> failed(num_rhs, false);
+	for (index_t j=0; j<num_rhs; ++j)
+	{
+		if (std::sqrt(r_norm2[j])>=tolerence[j])
+			active.push_back(j);
+	}
+
+	// start the timer
+	Time time;
+	time.start();
+
+	// set the residuals to zero
+	if (m_store_residuals)
+		m_residuals.set_const(0.0);
+
+	index_t iteration=0;
+	for (; !active.empty() && iteration<m_max_iteration_limit; ++iteration)
+	{
+		const float64_t max_norm=std::sqrt(r_norm2.maxCoeff());
+		SG_DEBUG("Block CG iteration {}, {} active systems, residual norm {}",
+			iteration, active.size(), max_norm);
+
+		if (m_store_residuals)
+			m_residuals[iteration]=max_norm;
+
+		// apply linear operator to all active directions at once
+		SGMatrix<float64_t> P_active(num_rows, active.size());
+		for (index_t k=0; k<(index_t)active.size(); ++k)
+		{
+			Map<VectorXd>(P_active.get_column_vector(k), num_rows)
+				=P.col(active[k]);
+		}
+		SGMatrix<float64_t> AP_=A->apply_block(P_active);
+		Map<MatrixXd> AP(AP_.matrix, AP_.num_rows, AP_.num_cols);
+
+#pragma omp parallel for schedule(static)
+		for (index_t k=0; k<(index_t)active.size(); ++k)
+		{
+			const index_t j=active[k];
+
+			// compute p^{T}Ap, if zero, failure
+			const float64_t p_dot_Ap=P.col(j).dot(AP.col(k));
+			if (p_dot_Ap==0.0)
+			{
+				failed[j]=true;
+				continue;
+			}
+
+			// x_{i}=x_{i-1}+\alpha_{i}p, r_{i}=r_{i-1}-\alpha_{i}Ap
+			const float64_t alpha=r_dot_z[j]/p_dot_Ap;
+			X.col(j)+=alpha*P.col(j);
+			R.col(j)-=alpha*AP.col(k);
+			r_norm2[j]=R.col(j).squaredNorm();
+		}
+
+		std::vector<index_t> still_active;
+		for (auto j : active)
+		{
+			if (!failed[j] && r_norm2[j]>0.0 && std::sqrt(r_norm2[j])>=tolerence[j])
+				still_active.push_back(j);
+		}
+		active=std::move(still_active);
+
+		// precondition the residuals of the remaining systems at once
+		MatrixXd R_active(num_rows, active.size());
+		for (index_t k=0; k<(index_t)active.size(); ++k)
+			R_active.col(k)=R.col(active[k]);
+		MatrixXd Z=precondition(m_preconditioner, R_active);
+
+#pragma omp parallel for schedule(static)
+		for (index_t k=0; k<(index_t)active.size(); ++k)
+		{
+			const index_t j=active[k];
+
+			// update direction, and r^{T}z
+			const float64_t r_dot_z_i=R.col(j).dot(Z.col(k));
+			P.col(j)=Z.col(k)+(r_dot_z_i/r_dot_z[j])*P.col(j);
+			r_dot_z[j]=r_dot_z_i;
+		}
+	}
+
+	float64_t elapsed=time.cur_time_diff();
+
+	if (!active.empty())
+		io::warn("{} of {} systems did not converge!", active.size(), num_rhs);
+
+	io::info("Iteration took {} times, residual norm={:.20f}, time elapsed={}",
+		iteration, std::sqrt(r_norm2.maxCoeff()), elapsed);
+
+	SG_TRACE("Leaving..");
+	return result;
+}
+
 }
@@ -15,6 +15,7 @@ namespace shogun
 {
 template<class T> class LinearOperator;
 template<class T> class SGVector;
+template<class T> class SGMatrix;
 
 /**
  * @brief class that uses conjugate gradient method of solving a linear system
@@ -44,12 +45,49 @@ public:
 	SGVector<float64_t> solve(std::shared_ptr<LinearOperator<float64_t>> A,
 		SGVector<float64_t> b) override;
 
+	/**
+	 * solve method for several real linear systems with the same operator.
+	 * Every column runs its own conjugate gradient iteration, but the
+	 * operator is applied to all active directions at once through
+	 * LinearOperator::apply_block. Converged columns are not updated
+	 * anymore.
+	 *
+	 * @param A the linear operator of the systems
+	 * @param B the right hand sides of the systems, one per column
+	 * @return the solution vectors, one per column
+	 */
+	SGMatrix<float64_t> solve_block(
+		std::shared_ptr<LinearOperator<float64_t>> A, SGMatrix<float64_t> B);
+
+	/**
+	 * set a preconditioner, a self-adjoint positive definite operator
+	 * \f$M\approx A^{-1}\f$ that is applied to the residuals. A good
+	 * preconditioner clusters the spectrum of \f$MA\f$ and reduces the
+	 * number of iterations.
+	 *
+	 * @param preconditioner the preconditioner, nullptr for none
+	 */
+	void set_preconditioner(
+		std::shared_ptr<LinearOperator<float64_t>> preconditioner)
+	{
+		m_preconditioner=std::move(preconditioner);
+	}
+
+	/** @return the preconditioner, nullptr if there is none */
+	std::shared_ptr<LinearOperator<float64_t>> get_preconditioner() const
+	{
+		return m_preconditioner;
+	}
+
 	/** @return object name */
 	const char* get_name() const override
 	{
 		return "ConjugateGradientSolver";
 	}
 
+private:
+	/** preconditioner applied to the residuals */
+	std::shared_ptr<LinearOperator<float64_t>> m_preconditioner;
 };
 
 }
@@ -110,40 +110,14 @@ SGVector<float64_t> LogDetEstimator::sample(index_t num_estimates)
 	SG_TRACE("Entering");
 	io::info("Computing {} log-det estimates", num_estimates);
 
-	require(m_operator_log, "Operator function is NULL");
-	// call the precompute of operator function to compute the prerequisites
-	m_operator_log->precompute();
-
-	require(m_trace_sampler, "Trace sampler is NULL");
-	// call the precompute of the sampler
-	m_trace_sampler->precompute();
-
-	require(m_operator_log->get_operator()->get_dimension()\
-		==m_trace_sampler->get_dimension(),
-		"Mismatch in dimensions of the operator and trace-sampler, {} vs {}!",
-		m_operator_log->get_operator()->get_dimension(),
-		m_trace_sampler->get_dimension());
-
-	index_t num_trace_samples=m_trace_sampler->get_num_samples();
+	// every estimate is the sum of its trace samples
+	SGMatrix<float64_t> trace_samples=sample_without_averaging(num_estimates);
 	SGVector<float64_t> samples(num_estimates);
-	samples.zero();
-	float64_t result = 0.0;
-
-#pragma omp parallel for reduction(+ : result)
 	for (index_t i = 0; i < num_estimates; ++i)
 	{
-		result = 0.0;
-		for (index_t j = 0; j < num_trace_samples; ++j)
-		{
-			io::info(
-				"Computing log-determinant trace sample {}/{}", j,
-				num_trace_samples);
-			// get the trace sampler vector
-			SGVector<float64_t> s = m_trace_sampler->sample(j);
-			// calculate the result for sample s and add it to previous
-			result += m_operator_log->compute(s);
-		}
-		samples[i] = result;
+		samples[i] = 0.0;
+		for (index_t j = 0; j < trace_samples.num_rows; ++j)
+			samples[i] += trace_samples(j, i);
 	}
 
 	io::info("Finished computing {} log-det estimates", num_estimates);
@@ -168,7 +142,9 @@ SGMatrix<float64_t> LogDetEstimator::sample_without_averaging(
 	index_t num_trace_samples = m_trace_sampler->get_num_samples();
 	SGMatrix<float64_t> samples(num_trace_samples, num_estimates);
 
-#pragma omp parallel for
+	// all trace samples of all estimates are independent, scheduling them
+	// as one loop keeps the threads busy even for a single estimate
+#pragma omp parallel for collapse(2) schedule(dynamic)
 	for (index_t i = 0; i < num_estimates; ++i)
 	{
 		for (index_t j = 0; j < num_trace_samples; ++j)
@@ -176,13 +152,13 @@ SGMatrix<float64_t> LogDetEstimator::sample_without_averaging(
 			io::info(
 				"Computing log-determinant trace sample {}/{}", j,
 				num_trace_samples);
-			// get the trace sampler vector
-			SGVector<float64_t> s = m_trace_sampler->sample(j);
+			// get the trace sampler vector, samplers may share their
+			// random generator between the threads
+			SGVector<float64_t> s;
+#pragma omp critical(LogDetEstimator_sample)
+			s = m_trace_sampler->sample(j);
 			// solve the result for s
-			float64_t result = m_operator_log->compute(s);
-			{
-				samples(i, j) = result;
-			}
+			samples(j, i) = m_operator_log->compute(s);
 		}
 	}
 
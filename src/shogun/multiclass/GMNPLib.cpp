@@ -4,6 +4,7 @@
  * Authors: Giovanni De Toni, Soeren Sonnenburg, Sergey Lisitsyn
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/multiclass/GMNPLib.h>
@@ -18,19 +19,35 @@ using namespace shogun;
 #define MINUS_INF INT_MIN
 #define PLUS_INF  INT_MAX
 
+/* minimum number of variables for which loops over them run in parallel */
+#define PARALLEL_MIN_SIZE 4096
+
 #define INDEX(ROW,COL,DIM) ((COL*DIM)+ROW)
 #define KDELTA(A,B) (A==B)
 #define KDELTA4(A1,A2,A3,A4) ((A1==A2)||(A1==A3)||(A1==A4)||(A2==A3)||(A2==A4)||(A3==A4))
 
+/* ------------------------------------------------------------
+  Scans over n variables are split into one chunk per thread,
+  the chunks are merged in order so that ties are broken as in
+  a sequential scan.
+------------------------------------------------------------ */
+static int32_t num_chunks( int32_t n )
+{
+  if( n < PARALLEL_MIN_SIZE )
+    return 1;
+  return Math::max(Math::min(env()->get_num_threads(), n), 1);
+}
+
+static int32_t chunk_begin( int32_t chunk, int32_t chunks, int32_t n )
+{
+  return int64_t(chunk) * n / chunks;
+}
+
 GMNPLib::GMNPLib()
 {
 	unstable(SOURCE_LOCATION);
 
 	diag_H = NULL;
-	kernel_columns = NULL;
-	cache_index = NULL;
-	first_kernel_inx = 0;
-	Cache_Size = 0;
 	m_num_data = 0;
 	m_reg_const = 0;
 	m_vector_y = 0;
@@ -54,22 +71,11 @@ GMNPLib::GMNPLib(
   m_vector_y = vector_y;
   m_kernel = kernel;
 
-  Cache_Size = ((int64_t) kernel->get_cache_size())*1024*1024/(sizeof(float64_t)*num_data);
-  Cache_Size = Math::min(Cache_Size, (int64_t) num_data);
-
-  io::info("using {} kernel cache lines", Cache_Size);
-  ASSERT(Cache_Size>=2)
-
   /* allocates memory for kernel cache */
-  kernel_columns = SG_MALLOC(float64_t*, Cache_Size);
-  cache_index = SG_MALLOC(float64_t, Cache_Size);
+  m_kernel_cache = std::make_unique<KernelRowCache<float64_t>>(
+    num_data, num_data, kernel->get_cache_size());
 
-  for(int32_t i = 0; i < Cache_Size; i++ )
-  {
-    kernel_columns[i] = SG_MALLOC(float64_t, num_data);
-    cache_index[i] = -2;
-  }
-  first_kernel_inx = 0;
+  io::info("using {} kernel cache lines", m_kernel_cache->get_max_rows());
 
 
 
@@ -87,49 +93,25 @@ GMNPLib::GMNPLib(
 
 GMNPLib::~GMNPLib()
 {
-	for(int32_t i = 0; i < Cache_Size; i++ )
-		SG_FREE(kernel_columns[i]);
-
 	for(int32_t i = 0; i < 3; i++ )
 		SG_FREE(virt_columns[i]);
 
-	SG_FREE(cache_index);
-	SG_FREE(kernel_columns);
-
 	SG_FREE(diag_H);
 }
 
 /* ------------------------------------------------------------
   Returns pointer at a-th column of the kernel matrix.
-  This function maintains FIFO cache of kernel columns.
+  Kernel columns are kept in a KernelRowCache.
 ------------------------------------------------------------ */
 float64_t* GMNPLib::get_kernel_col( int32_t a )
 {
-  float64_t *col_ptr;
-  int32_t i;
-  int32_t inx;
-
-  inx = -1;
-  for( i=0; i < Cache_Size; i++ ) {
-    if( cache_index[i] == a ) { inx = i; break; }
-  }
-
-  if( inx != -1 ) {
-    col_ptr = kernel_columns[inx];
-    return( col_ptr );
-  }
-
-  col_ptr = kernel_columns[first_kernel_inx];
-  cache_index[first_kernel_inx] = a;
-
-  first_kernel_inx++;
-  if( first_kernel_inx >= Cache_Size ) first_kernel_inx = 0;
-
-  for( i=0; i < m_num_data; i++ ) {
-    col_ptr[i] = m_kernel->kernel(i,a);
-  }
+  m_kernel_col = m_kernel_cache->get_row(a, [this](index_t col, float64_t* col_ptr) {
+    #pragma omp parallel for if (m_num_data >= PARALLEL_MIN_SIZE)
+    for( int32_t i=0; i < m_num_data; i++ )
+      col_ptr[i] = m_kernel->kernel(i,col);
+  });
 
-  return( col_ptr );
+  return( m_kernel_col.vector );
 }
 
 /* ------------------------------------------------------------
@@ -156,11 +138,9 @@ void GMNPLib::get_indices2( int32_t *index, int32_t *c, int32_t i )
 ------------------------------------------------------------ */
 float64_t* GMNPLib::get_col( int32_t a, int32_t b )
 {
-  int32_t i;
   float64_t *col_ptr;
   float64_t *ker_ptr;
-  float64_t value;
-  int32_t i1,c1,i2,c2;
+  int32_t i1,c1;
 
   col_ptr = virt_columns[first_virt_inx++];
   if( first_virt_inx >= 3 ) first_virt_inx = 0;
@@ -168,7 +148,10 @@ float64_t* GMNPLib::get_col( int32_t a, int32_t b )
   get_indices2( &i1, &c1, a );
   ker_ptr = (float64_t*) get_kernel_col( i1 );
 
-  for( i=0; i < m_num_virt_data; i++ ) {
+  #pragma omp parallel for if (m_num_virt_data >= PARALLEL_MIN_SIZE)
+  for( int32_t i=0; i < m_num_virt_data; i++ ) {
+    float64_t value;
+    int32_t i2,c2;
     get_indices2( &i2, &c2, i );
 
     if( KDELTA4(m_vector_y[i1],m_vector_y[i2],c1,c2) ) {
@@ -219,7 +202,10 @@ int8_t GMNPLib::gmnp_imdm(float64_t *vector_c,
   float64_t tmp, tmp1;
   float64_t Huu, Huv, Hvv;
   float64_t min_beta, beta;
-  float64_t max_improv, improv;
+  float64_t max_improv;
+  float64_t *chunk_best;
+  int32_t *chunk_idx;
+  int32_t chunks, c;
   float64_t lambda;
   float64_t *History;
   float64_t *Ha;
@@ -240,6 +226,11 @@ int8_t GMNPLib::gmnp_imdm(float64_t *vector_c,
   Ha = SG_MALLOC(float64_t, dim);
   if( Ha == NULL ) error("Not enough memory.");
 
+  /* best value and its index of every chunk of the scans */
+  chunks = num_chunks( dim );
+  chunk_best = SG_MALLOC(float64_t, chunks);
+  chunk_idx = SG_MALLOC(int32_t, chunks);
+
   History_size = (tmax < HISTORY_BUF ) ? tmax+1 : HISTORY_BUF;
   History = SG_MALLOC(float64_t, History_size*2);
   if( History == NULL ) error("Not enough memory.");
@@ -321,16 +312,31 @@ int8_t GMNPLib::gmnp_imdm(float64_t *vector_c,
     UB = 0.5*aHa + ac;
 
 /*    max_beta = MINUS_INF;*/
-    for( min_beta = PLUS_INF, i = 0; i < dim; i++ )
+    #pragma omp parallel for if (chunks > 1)
+    for( c = 0; c < chunks; c++ )
     {
-       Ha[i] = Ha[i] + lambda*tmp*(col_u[i] - col_v[i]);
+       int32_t end = chunk_begin( c+1, chunks, dim );
+       chunk_best[c] = PLUS_INF;
+       chunk_idx[c] = -1;
+       for( int32_t j = chunk_begin( c, chunks, dim ); j < end; j++ )
+       {
+         Ha[j] = Ha[j] + lambda*tmp*(col_u[j] - col_v[j]);
 
-       beta = Ha[i]+ vector_c[i];
+         float64_t beta_j = Ha[j]+ vector_c[j];
 
-       if( beta < min_beta )
+         if( beta_j < chunk_best[c] )
+         {
+           chunk_idx[c] = j;
+           chunk_best[c] = beta_j;
+         }
+       }
+    }
+    for( min_beta = PLUS_INF, c = 0; c < chunks; c++ )
+    {
+       if( chunk_idx[c] != -1 && chunk_best[c] < min_beta )
        {
-         new_u = i;
-         min_beta = beta;
+         new_u = chunk_idx[c];
+         min_beta = chunk_best[c];
        }
     }
 
@@ -339,25 +345,37 @@ int8_t GMNPLib::gmnp_imdm(float64_t *vector_c,
     col_u = (float64_t*)get_col(u,-1);
 
     /* search for optimal v while u is fixed */
-    for( max_improv =  MINUS_INF, i = 0; i < dim; i++ ) {
-
-      if( alpha[i] != 0 ) {
-        beta = Ha[i] + vector_c[i];
-
-        if( beta >= min_beta ) {
-
-          tmp = diag_H[u] - 2*col_u[i] + diag_H[i];
-          if( tmp != 0 ) {
-            improv = (0.5*(beta-min_beta)*(beta-min_beta))/tmp;
-
-            if( improv > max_improv ) {
-              max_improv = improv;
-              v = i;
+    #pragma omp parallel for if (chunks > 1)
+    for( c = 0; c < chunks; c++ ) {
+      int32_t end = chunk_begin( c+1, chunks, dim );
+      chunk_best[c] = MINUS_INF;
+      chunk_idx[c] = -1;
+      for( int32_t j = chunk_begin( c, chunks, dim ); j < end; j++ ) {
+
+        if( alpha[j] != 0 ) {
+          float64_t beta_j = Ha[j] + vector_c[j];
+
+          if( beta_j >= min_beta ) {
+
+            float64_t tmp_j = diag_H[u] - 2*col_u[j] + diag_H[j];
+            if( tmp_j != 0 ) {
+              float64_t improv_j = (0.5*(beta_j-min_beta)*(beta_j-min_beta))/tmp_j;
+
+              if( improv_j > chunk_best[c] ) {
+                chunk_best[c] = improv_j;
+                chunk_idx[c] = j;
+              }
             }
           }
         }
       }
     }
+    for( max_improv = MINUS_INF, c = 0; c < chunks; c++ ) {
+      if( chunk_idx[c] != -1 && chunk_best[c] > max_improv ) {
+        max_improv = chunk_best[c];
+        v = chunk_idx[c];
+      }
+    }
 
     /* Stopping conditions */
     if( UB-LB <= tolabs ) exitflag = 1;
@@ -418,6 +436,8 @@ int8_t GMNPLib::gmnp_imdm(float64_t *vector_c,
 
   /* Free memory */
   SG_FREE(Ha);
+  SG_FREE(chunk_best);
+  SG_FREE(chunk_idx);
 
   return( exitflag );
 }
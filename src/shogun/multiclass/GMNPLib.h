@@ -12,6 +12,9 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/common.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/KernelRowCache.h>
+
+#include <memory>
 
 namespace shogun
 {
@@ -132,14 +135,11 @@ tmax, tolabs, tolrel, th, &alpha, &t, &History );
 	protected:
 		/** diag H */
 		float64_t* diag_H;
-		/** kernel columns */
-		float64_t** kernel_columns;
-		/** cache index */
-		float64_t* cache_index;
-		/** first kernel inx */
-		int32_t first_kernel_inx;
-		/** cache size */
-		int64_t Cache_Size;
+		/** kernel column cache */
+		std::unique_ptr<KernelRowCache<float64_t>> m_kernel_cache;
+		/** last column returned by get_kernel_col, keeps it alive while
+		 * in use by the caller */
+		SGVector<float64_t> m_kernel_col;
 		/** num data */
 		int32_t m_num_data;
 		/** reg const */
@@ -16,7 +16,19 @@
 
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <limits>
+
 using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+/* number of vectors classified at once */
+const index_t block_size = 1024;
+}
 
 GaussianNaiveBayes::GaussianNaiveBayes() : NativeMulticlassMachine(), m_features(NULL),
 	m_min_label(0), m_num_classes(0), m_dim(0), m_means(), m_variances(),
@@ -162,17 +174,100 @@ std::shared_ptr<MulticlassLabels> GaussianNaiveBayes::apply_multiclass(std::shar
 		set_features(data);
 
 	ASSERT(m_features)
+	require(
+	    m_features->get_dim_feature_space() == m_dim,
+	    "Features have {} dimensions but the model has {}",
+	    m_features->get_dim_feature_space(), m_dim);
+
+	// the log-likelihood of every class is a quadratic polynomial in the
+	// features, log p(x|c) = offset_c + (x-s)^T a_c + ((x-s).^2)^T b_c, the
+	// features are shifted by the mean over the classes to keep the
+	// expansion accurate
+	VectorXd shift = VectorXd::Zero(m_dim);
+	int32_t num_present = 0;
+	for (auto i : range(m_num_classes))
+	{
+		if (m_label_prob[i] > 0)
+		{
+			shift += Map<VectorXd>(m_means.get_column_vector(i), m_dim);
+			num_present++;
+		}
+	}
+	shift /= std::max(num_present, 1);
+
+	MatrixXd linear = MatrixXd::Zero(m_dim, m_num_classes);
+	MatrixXd quadratic = MatrixXd::Zero(m_dim, m_num_classes);
+	VectorXd offset(m_num_classes);
+	for (auto i : range(m_num_classes))
+	{
+		// classes without training vectors are never predicted
+		if (m_label_prob[i] == 0.0)
+		{
+			offset[i] = -std::numeric_limits<float64_t>::infinity();
+			continue;
+		}
 
-	// init number of vectors
-	int32_t num_vectors = m_features->get_num_vectors();
+		offset[i] = std::log(m_label_prob[i]);
+		for (auto k : range(m_dim))
+		{
+			const float64_t variance = m_variances(k, i);
+			if (variance == 0.0)
+				continue;
+
+			const float64_t mean = m_means(k, i) - shift[k];
+			linear(k, i) = mean / variance;
+			quadratic(k, i) = -0.5 / variance;
+			offset[i] += std::log(0.39894228 / std::sqrt(variance)) -
+			             0.5 * mean * mean / variance;
+		}
+	}
+
+	// blocks of vectors are rated in one product, the posterior of every
+	// class is the normalized exponential of its rate
+	const int32_t num_vectors = m_features->get_num_vectors();
+	SGVector<float64_t> labels(num_vectors);
+	SGMatrix<float64_t> posteriors(m_num_classes, num_vectors);
+	const index_t num_blocks = (num_vectors + block_size - 1) / block_size;
+	auto pb = SG_PROGRESS(range(num_blocks));
+#pragma omp parallel for
+	for (index_t b = 0; b < num_blocks; b++)
+	{
+		const index_t begin = b * block_size;
+		const index_t len = std::min(block_size, num_vectors - begin);
+		MatrixXd X(m_dim, len);
+		for (index_t i = 0; i < len; i++)
+		{
+			auto vec = m_features->get_computed_dot_feature_vector(begin + i);
+			X.col(i) = Map<VectorXd>(vec.vector, m_dim) - shift;
+		}
 
-	// init result labels
-	auto result = std::make_shared<MulticlassLabels>(num_vectors);
+		MatrixXd rates = linear.transpose() * X +
+		                 quadratic.transpose() * X.cwiseAbs2();
+		rates.colwise() += offset;
+
+		Map<MatrixXd> posterior(
+		    posteriors.matrix + int64_t(begin) * m_num_classes,
+		    m_num_classes, len);
+		for (index_t i = 0; i < len; i++)
+		{
+			index_t max_label_idx;
+			const float64_t max_rate = rates.col(i).maxCoeff(&max_label_idx);
+			labels[begin + i] = max_label_idx + m_min_label;
+
+			posterior.col(i) = (rates.col(i).array() - max_rate).exp();
+			posterior.col(i) /= posterior.col(i).sum();
+		}
+		pb.print_progress();
+	}
+	pb.complete();
 
-	// classify each example of data
-	for (auto i : SG_PROGRESS(range(num_vectors)))
+	auto result = std::make_shared<MulticlassLabels>(labels);
+	result->allocate_confidences_for(m_num_classes);
+	for (auto i : range(num_vectors))
 	{
-		result->set_label(i,apply_one(i));
+		result->set_multiclass_confidences(
+		    i, SGVector<float64_t>(posteriors.get_column_vector(i),
+		                           m_num_classes, false));
 	}
 
 	return result;
@@ -0,0 +1,474 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/progress.h>
+#include <shogun/lib/Signal.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/multiclass/HNSWKNNSolver.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+using namespace shogun;
+
+HNSWKNNSolver::HNSWKNNSolver() : KNNSolver()
+{
+	init();
+}
+
+HNSWKNNSolver::HNSWKNNSolver(
+	const int32_t k, const float64_t q, const int32_t num_classes,
+	const int32_t min_label, const SGVector<int32_t> train_labels,
+	const int32_t max_connections, const int32_t ef_construction,
+	const int32_t ef)
+	: KNNSolver(k, q, num_classes, min_label, train_labels)
+{
+	init();
+
+	require(max_connections>1, "Maximum number of connections ({}) must be larger than 1!", max_connections);
+	require(ef_construction>0, "ef_construction ({}) must be positive!", ef_construction);
+	m_max_connections=max_connections;
+	m_ef_construction=ef_construction;
+	set_ef(ef);
+}
+
+HNSWKNNSolver::~HNSWKNNSolver()
+{
+}
+
+void HNSWKNNSolver::init()
+{
+	m_max_connections=16;
+	m_ef_construction=200;
+	m_ef=50;
+	m_seed=1;
+	m_entry_point=-1;
+	m_max_level=-1;
+
+	SG_ADD(&m_max_connections, "max_connections",
+		"Maximum number of links per node on layers above 0.");
+	SG_ADD(&m_ef_construction, "ef_construction",
+		"Size of the candidate list during construction.");
+	SG_ADD(&m_ef, "ef", "Size of the candidate list of queries.");
+	SG_ADD(&m_seed, "seed", "Seed for drawing the layers of the points.");
+	SG_ADD(&m_points, "points", "Indexed points.");
+	SG_ADD(&m_levels, "levels", "Top layer of each point.");
+	SG_ADD(&m_base_links, "base_links", "Links on layer 0.");
+	SG_ADD(&m_upper_offsets, "upper_offsets",
+		"Offsets of the links on layers above 0.");
+	SG_ADD(&m_upper_links, "upper_links", "Links on layers above 0.");
+	SG_ADD(&m_entry_point, "entry_point", "Entry point of queries.");
+	SG_ADD(&m_max_level, "max_level", "Top layer of the graph.");
+}
+
+void HNSWKNNSolver::set_knn_parameters(
+	const int32_t k, const float64_t q, const int32_t num_classes,
+	const int32_t min_label, const SGVector<int32_t> train_labels)
+{
+	m_k=k;
+	m_q=q;
+	m_num_classes=num_classes;
+	m_min_label=min_label;
+	m_train_labels=train_labels;
+}
+
+void HNSWKNNSolver::build(const std::shared_ptr<DenseFeatures<float64_t>>& data)
+{
+	m_points=SGMatrix<float64_t>();
+	m_levels=SGVector<int32_t>();
+	m_base_links=SGVector<index_t>();
+	m_upper_offsets=SGVector<index_t>();
+	m_upper_links=SGVector<index_t>();
+	m_entry_point=-1;
+	m_max_level=-1;
+
+	add_points(data);
+}
+
+void HNSWKNNSolver::add_points(const std::shared_ptr<DenseFeatures<float64_t>>& data)
+{
+	require(data, "No features provided!");
+
+	const index_t num_old=get_num_points();
+	const index_t num_new=data->get_num_vectors();
+	const index_t num_points=num_old+num_new;
+	const index_t dim=data->get_num_features();
+	require(num_old==0 || dim==m_points.num_rows,
+		"Dimension of the points ({}) does not match the index ({})!", dim,
+		m_points.num_rows);
+
+	if (num_new==0)
+		return;
+
+	// grow the storage, the graph is only modified by insert() afterwards
+	SGMatrix<float64_t> points(dim, num_points);
+	if (num_old)
+		std::copy_n(m_points.matrix, int64_t(dim)*num_old, points.matrix);
+	for (index_t i=0; i<num_new; i++)
+	{
+		auto vec=data->get_feature_vector(i);
+		std::copy_n(vec.vector, dim, points.get_column_vector(num_old+i));
+		data->free_feature_vector(vec, i);
+	}
+
+	SGVector<int32_t> levels(num_points);
+	SGVector<index_t> upper_offsets(num_points);
+	index_t num_upper=m_upper_links.vlen;
+	for (index_t i=0; i<num_points; i++)
+	{
+		if (i<num_old)
+		{
+			levels[i]=m_levels[i];
+			upper_offsets[i]=m_upper_offsets[i];
+			continue;
+		}
+
+		levels[i]=draw_level(i);
+		upper_offsets[i]=levels[i]>0 ? num_upper : -1;
+		num_upper+=levels[i]*(m_max_connections+1);
+	}
+
+	const index_t base_size=get_capacity(0)+1;
+	SGVector<index_t> base_links(num_points*base_size);
+	base_links.zero();
+	if (num_old)
+		std::copy_n(m_base_links.vector, m_base_links.vlen, base_links.vector);
+
+	SGVector<index_t> upper_links(num_upper);
+	upper_links.zero();
+	if (m_upper_links.vlen)
+		std::copy_n(m_upper_links.vector, m_upper_links.vlen, upper_links.vector);
+
+	m_points=points;
+	m_levels=levels;
+	m_upper_offsets=upper_offsets;
+	m_base_links=base_links;
+	m_upper_links=upper_links;
+	m_locks=std::vector<Lock>(num_points);
+
+	index_t begin=num_old;
+	if (m_entry_point<0)
+	{
+		m_entry_point=begin;
+		m_max_level=m_levels[begin];
+		begin++;
+	}
+
+#pragma omp parallel for schedule(dynamic, 64)
+	for (index_t i=begin; i<num_points; i++)
+		insert(i);
+
+	SG_DEBUG("HNSW index of {} points with {} layers", num_points, m_max_level+1)
+}
+
+SGMatrix<index_t> HNSWKNNSolver::query_knn(
+	const std::shared_ptr<DenseFeatures<float64_t>>& query, int32_t k) const
+{
+	require(query, "No query features provided!");
+	require(get_num_points()>0, "Index is empty, call build() first!");
+	require(k>0 && k<=get_num_points(),
+		"k ({}) must be in [1, {}]!", k, get_num_points());
+	require(query->get_num_features()==m_points.num_rows,
+		"Dimension of the queries ({}) does not match the index ({})!",
+		query->get_num_features(), m_points.num_rows);
+
+	index_t entry=m_entry_point;
+	const int32_t max_level=m_max_level;
+	const index_t num_queries=query->get_num_vectors();
+	const int32_t ef=std::max(m_ef, k);
+
+	SGMatrix<index_t> NN(k, num_queries);
+#pragma omp parallel for schedule(dynamic, 16)
+	for (index_t i=0; i<num_queries; i++)
+	{
+		auto vec=query->get_feature_vector(i);
+
+		index_t closest=entry;
+		for (int32_t level=max_level; level>0; --level)
+			closest=search_greedy(vec.vector, closest, level);
+
+		auto candidates=search_layer(vec.vector, closest, ef, 0);
+		for (int32_t j=0; j<k; j++)
+			NN(j, i)=candidates[j].second;
+
+		query->free_feature_vector(vec, i);
+	}
+
+	return NN;
+}
+
+std::shared_ptr<MulticlassLabels> HNSWKNNSolver::classify_objects(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const
+{
+	auto output=std::make_shared<MulticlassLabels>(num_lab);
+	SGMatrix<index_t> NN=nearest_neighbors(knn_distance);
+
+	for (auto i : SG_PROGRESS(range(num_lab)))
+	{
+		if (cancel_computation())
+			break;
+		//write the labels of the k nearest neighbors from theirs indices
+		for (index_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		//get the index of the 'nearest' class
+		index_t out_idx = choose_class(classes.vector, train_lab.vector);
+		//write the label of 'nearest' in the output
+		output->set_label(i, out_idx + m_min_label);
+	}
+
+	return output;
+}
+
+SGVector<int32_t> HNSWKNNSolver::classify_objects_k(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const
+{
+	SGVector<int32_t> output(m_k*num_lab);
+	SGMatrix<index_t> NN=nearest_neighbors(knn_distance);
+
+	for (index_t i = 0; i < num_lab && (!cancel_computation()); i++)
+	{
+		//write the labels of the k nearest neighbors from theirs indices,
+		//they are already ordered by distance
+		for (index_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		choose_class_for_multiple_k(output.vector+i, classes.vector, train_lab.vector, num_lab);
+	}
+
+	return output;
+}
+
+SGMatrix<index_t> HNSWKNNSolver::nearest_neighbors(
+	const std::shared_ptr<Distance>& knn_distance) const
+{
+	auto rhs=knn_distance->get_rhs();
+	require(rhs->get_feature_class()==C_DENSE && rhs->get_feature_type()==F_DREAL,
+		"HNSW solver requires dense real valued features!");
+
+	return query_knn(rhs->as<DenseFeatures<float64_t>>(), m_k);
+}
+
+int32_t HNSWKNNSolver::draw_level(index_t node) const
+{
+	std::mt19937_64 prng(int64_t(m_seed)*1000003+node);
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	const float64_t u=std::max(uniform(prng), std::numeric_limits<float64_t>::min());
+
+	// P(level>=l)=M^-l
+	return int32_t(-std::log(u)/std::log(float64_t(m_max_connections)));
+}
+
+index_t* HNSWKNNSolver::get_links(index_t node, int32_t level) const
+{
+	if (level==0)
+		return m_base_links.vector+int64_t(node)*(get_capacity(0)+1);
+
+	return m_upper_links.vector+m_upper_offsets[node]+
+		(level-1)*(m_max_connections+1);
+}
+
+void HNSWKNNSolver::copy_links(
+	index_t node, int32_t level, std::vector<index_t>& links) const
+{
+	m_locks[node].lock();
+	const index_t* node_links=get_links(node, level);
+	links.assign(node_links+1, node_links+1+node_links[0]);
+	m_locks[node].unlock();
+}
+
+float64_t HNSWKNNSolver::sq_distance(const float64_t* point, index_t node) const
+{
+	const float64_t* other=m_points.get_column_vector(node);
+	float64_t result=0;
+	for (index_t i=0; i<m_points.num_rows; i++)
+	{
+		const float64_t diff=point[i]-other[i];
+		result+=diff*diff;
+	}
+	return result;
+}
+
+index_t HNSWKNNSolver::search_greedy(
+	const float64_t* point, index_t entry, int32_t level) const
+{
+	std::vector<index_t> links;
+	index_t closest=entry;
+	float64_t closest_dist=sq_distance(point, closest);
+
+	bool changed=true;
+	while (changed)
+	{
+		changed=false;
+		copy_links(closest, level, links);
+		for (auto neighbor : links)
+		{
+			const float64_t dist=sq_distance(point, neighbor);
+			if (dist<closest_dist)
+			{
+				closest_dist=dist;
+				closest=neighbor;
+				changed=true;
+			}
+		}
+	}
+
+	return closest;
+}
+
+std::vector<HNSWKNNSolver::Candidate> HNSWKNNSolver::search_layer(
+	const float64_t* point, index_t entry, int32_t ef, int32_t level) const
+{
+	std::unordered_set<index_t> visited;
+	visited.insert(entry);
+
+	// closest candidate to expand first, furthest result on top
+	std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>>
+		candidates;
+	std::priority_queue<Candidate> results;
+
+	const float64_t entry_dist=sq_distance(point, entry);
+	candidates.emplace(entry_dist, entry);
+	results.emplace(entry_dist, entry);
+
+	std::vector<index_t> links;
+	while (!candidates.empty())
+	{
+		const Candidate current=candidates.top();
+		if (current.first>results.top().first)
+			break;
+		candidates.pop();
+
+		copy_links(current.second, level, links);
+		for (auto neighbor : links)
+		{
+			if (!visited.insert(neighbor).second)
+				continue;
+
+			const float64_t dist=sq_distance(point, neighbor);
+			if (index_t(results.size())<ef || dist<results.top().first)
+			{
+				candidates.emplace(dist, neighbor);
+				results.emplace(dist, neighbor);
+				if (index_t(results.size())>ef)
+					results.pop();
+			}
+		}
+	}
+
+	std::vector<Candidate> sorted(results.size());
+	for (auto it=sorted.rbegin(); it!=sorted.rend(); ++it)
+	{
+		*it=results.top();
+		results.pop();
+	}
+	return sorted;
+}
+
+void HNSWKNNSolver::select_neighbors(
+	std::vector<Candidate>& candidates, int32_t max_neighbors) const
+{
+	std::vector<Candidate> selected;
+	selected.reserve(max_neighbors);
+	for (const auto& candidate : candidates)
+	{
+		if (index_t(selected.size())>=max_neighbors)
+			break;
+
+		const float64_t* point=m_points.get_column_vector(candidate.second);
+		bool keep=true;
+		for (const auto& other : selected)
+		{
+			if (sq_distance(point, other.second)<candidate.first)
+			{
+				keep=false;
+				break;
+			}
+		}
+
+		if (keep)
+			selected.push_back(candidate);
+	}
+	candidates.swap(selected);
+}
+
+void HNSWKNNSolver::insert(index_t node)
+{
+	const float64_t* point=m_points.get_column_vector(node);
+	const int32_t level=m_levels[node];
+
+	m_entry_lock.lock();
+	index_t entry=m_entry_point;
+	const int32_t max_level=m_max_level;
+	m_entry_lock.unlock();
+
+	for (int32_t l=max_level; l>level; --l)
+		entry=search_greedy(point, entry, l);
+
+	for (int32_t l=std::min(level, max_level); l>=0; --l)
+	{
+		auto candidates=search_layer(point, entry, m_ef_construction, l);
+		entry=candidates.front().second;
+
+		candidates.erase(
+			std::remove_if(candidates.begin(), candidates.end(),
+				[node](const Candidate& c) { return c.second==node; }),
+			candidates.end());
+		select_neighbors(candidates, m_max_connections);
+
+		m_locks[node].lock();
+		index_t* links=get_links(node, l);
+		links[0]=candidates.size();
+		for (size_t i=0; i<candidates.size(); i++)
+			links[i+1]=candidates[i].second;
+		m_locks[node].unlock();
+
+		for (const auto& neighbor : candidates)
+			connect(neighbor.second, node, l);
+	}
+
+	if (level>max_level)
+	{
+		m_entry_lock.lock();
+		if (level>m_max_level)
+		{
+			m_max_level=level;
+			m_entry_point=node;
+		}
+		m_entry_lock.unlock();
+	}
+}
+
+void HNSWKNNSolver::connect(index_t node, index_t neighbor, int32_t level)
+{
+	const int32_t capacity=get_capacity(level);
+	const float64_t* point=m_points.get_column_vector(node);
+
+	m_locks[node].lock();
+	index_t* links=get_links(node, level);
+	if (links[0]<capacity)
+	{
+		links[1+links[0]]=neighbor;
+		links[0]++;
+	}
+	else
+	{
+		std::vector<Candidate> candidates;
+		candidates.reserve(capacity+1);
+		for (index_t i=0; i<links[0]; i++)
+			candidates.emplace_back(sq_distance(point, links[i+1]), links[i+1]);
+		candidates.emplace_back(sq_distance(point, neighbor), neighbor);
+		std::sort(candidates.begin(), candidates.end());
+
+		select_neighbors(candidates, capacity);
+		links[0]=candidates.size();
+		for (size_t i=0; i<candidates.size(); i++)
+			links[i+1]=candidates[i].second;
+	}
+	m_locks[node].unlock();
+}
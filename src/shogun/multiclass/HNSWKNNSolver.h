@@ -0,0 +1,235 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef HNSWSOLVER_H__
+#define HNSWSOLVER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/Lock.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/multiclass/KNNSolver.h>
+
+#include <utility>
+#include <vector>
+
+namespace shogun
+{
+
+/**
+ * HNSW solver. It uses a hierarchical navigable small world graph to do
+ * approximate nearest neighbour computation with the Euclidean distance,
+ * see Malkov and Yashunin, "Efficient and robust approximate nearest
+ * neighbor search using Hierarchical Navigable Small World graphs".
+ *
+ * Every point is inserted into the layers 0..l of the graph, where l is
+ * drawn from a geometric distribution, and is connected to (at most)
+ * max_connections neighbours per layer (twice as many on layer 0). Queries
+ * descend greedily from the sparse top layer and finish with a best-first
+ * search over ef candidates on layer 0, a larger ef trades speed for recall.
+ *
+ * The index is built once by build() and can be extended by add_points().
+ * Points are inserted in parallel, each node of the graph is guarded by its
+ * own spin lock. The graph is stored in flat arrays which are registered as
+ * parameters, so a built index can be serialized with any Serializer.
+ */
+class HNSWKNNSolver : public KNNSolver
+{
+	public:
+		/** default constructor */
+		HNSWKNNSolver();
+
+		/** deconstructor */
+		~HNSWKNNSolver() override;
+
+		/** constructor
+		 *
+		 * @param k k
+		 * @param q m_q
+		 * @param num_classes m_num_classes
+		 * @param min_label m_min_label
+		 * @param train_labels m_train_labels
+		 * @param max_connections m_max_connections
+		 * @param ef_construction m_ef_construction
+		 * @param ef m_ef
+		 */
+		HNSWKNNSolver(
+			const int32_t k, const float64_t q, const int32_t num_classes,
+			const int32_t min_label, const SGVector<int32_t> train_labels,
+			const int32_t max_connections=16, const int32_t ef_construction=200,
+			const int32_t ef=50);
+
+		/** update the parameters of the KNN classification without
+		 * rebuilding the index
+		 *
+		 * @param k k
+		 * @param q m_q
+		 * @param num_classes m_num_classes
+		 * @param min_label m_min_label
+		 * @param train_labels m_train_labels
+		 */
+		void set_knn_parameters(
+			const int32_t k, const float64_t q, const int32_t num_classes,
+			const int32_t min_label, const SGVector<int32_t> train_labels);
+
+		/** build the index from scratch
+		 *
+		 * @param data points to index
+		 */
+		void build(const std::shared_ptr<DenseFeatures<float64_t>>& data);
+
+		/** insert more points into the index, the new points get the
+		 * indices get_num_points()..get_num_points()+n-1
+		 *
+		 * @param data points to insert
+		 */
+		void add_points(const std::shared_ptr<DenseFeatures<float64_t>>& data);
+
+		/** find the (approximate) k nearest neighbours of each query
+		 *
+		 * @param query query points
+		 * @param k number of neighbours
+		 * @return matrix of k rows and one column per query, closest first
+		 */
+		SGMatrix<index_t> query_knn(
+			const std::shared_ptr<DenseFeatures<float64_t>>& query,
+			int32_t k) const;
+
+		/** @return number of indexed points */
+		index_t get_num_points() const
+		{
+			return m_points.num_cols;
+		}
+
+		/** @param ef size of the candidate list of queries */
+		void set_ef(int32_t ef)
+		{
+			require(ef>0, "ef ({}) must be positive!", ef);
+			m_ef=ef;
+		}
+
+		/** @return size of the candidate list of queries */
+		int32_t get_ef() const
+		{
+			return m_ef;
+		}
+
+		std::shared_ptr<MulticlassLabels> classify_objects(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const override;
+
+		SGVector<int32_t> classify_objects_k(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const override;
+
+		/** @return object name */
+		const char* get_name() const override { return "HNSWKNNSolver"; }
+
+	private:
+		void init();
+
+		/** candidate, i.e. squared distance and index of a point */
+		typedef std::pair<float64_t, index_t> Candidate;
+
+		/** draw the top layer of a point, depends on the seed and the
+		 * index of the point only
+		 */
+		int32_t draw_level(index_t node) const;
+
+		/** @return maximum number of links per node on the given layer */
+		int32_t get_capacity(int32_t level) const
+		{
+			return level==0 ? 2*m_max_connections : m_max_connections;
+		}
+
+		/** @return links of a node on a layer, the first element is the
+		 * number of links followed by the linked nodes
+		 */
+		index_t* get_links(index_t node, int32_t level) const;
+
+		/** copy the links of a node on a layer while holding its lock */
+		void copy_links(
+			index_t node, int32_t level, std::vector<index_t>& links) const;
+
+		/** @return squared distance of a point to an indexed point */
+		float64_t sq_distance(const float64_t* point, index_t node) const;
+
+		/** greedily walk to the closest node on a layer */
+		index_t search_greedy(
+			const float64_t* point, index_t entry, int32_t level) const;
+
+		/** best-first search on a layer
+		 *
+		 * @return up to ef closest nodes found, sorted by distance
+		 */
+		std::vector<Candidate> search_layer(
+			const float64_t* point, index_t entry, int32_t ef,
+			int32_t level) const;
+
+		/** keep at most max_neighbors of the sorted candidates, preferring
+		 * candidates that are closer to the base point than to any already
+		 * selected candidate
+		 */
+		void select_neighbors(
+			std::vector<Candidate>& candidates, int32_t max_neighbors) const;
+
+		/** insert an indexed point into the graph */
+		void insert(index_t node);
+
+		/** add a link from node to neighbor on a layer, pruning the links
+		 * of node if they exceed the capacity
+		 */
+		void connect(index_t node, index_t neighbor, int32_t level);
+
+		/** @return the nearest neighbours of the distance rhs */
+		SGMatrix<index_t> nearest_neighbors(
+			const std::shared_ptr<Distance>& knn_distance) const;
+
+	protected:
+		/** maximum number of links per node on layers above 0 */
+		int32_t m_max_connections;
+
+		/** size of the candidate list during construction */
+		int32_t m_ef_construction;
+
+		/** size of the candidate list of queries */
+		int32_t m_ef;
+
+		/** seed for drawing the layers of the points */
+		int32_t m_seed;
+
+		/** indexed points, one per column */
+		SGMatrix<float64_t> m_points;
+
+		/** top layer of each point */
+		SGVector<int32_t> m_levels;
+
+		/** links on layer 0, 2*m_max_connections+1 entries per point */
+		SGVector<index_t> m_base_links;
+
+		/** offset of the links of each point in m_upper_links, -1 for
+		 * points on layer 0 only
+		 */
+		SGVector<index_t> m_upper_offsets;
+
+		/** links on layers above 0, m_max_connections+1 entries per point
+		 * and layer
+		 */
+		SGVector<index_t> m_upper_links;
+
+		/** entry point of queries, a node on the top layer */
+		index_t m_entry_point;
+
+		/** top layer of the graph */
+		int32_t m_max_level;
+
+	private:
+		/** one lock per node */
+		mutable std::vector<Lock> m_locks;
+
+		/** lock guarding the entry point */
+		Lock m_entry_lock;
+};
+}
+
+#endif
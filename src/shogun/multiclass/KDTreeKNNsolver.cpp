@@ -45,9 +45,6 @@ SGVector<int32_t> KDTREEKNNSolver::classify_objects_k(std::shared_ptr<Distance>
 {
 	SGVector<int32_t> output(m_k*num_lab);
 
-	//allocation for distances to nearest neighbors
-	SGVector<float64_t> dists(m_k);
-
 	auto lhs = knn_distance->get_lhs();
 	auto kd_tree = std::make_shared<KDTree>(m_leaf_size);
 	kd_tree->build_tree(lhs->as<DenseFeatures<float64_t>>());
@@ -57,13 +54,10 @@ SGVector<int32_t> KDTREEKNNSolver::classify_objects_k(std::shared_ptr<Distance>
 	SGMatrix<index_t> NN = kd_tree->get_knn_indices();
 	for (index_t i = 0; i < num_lab && (!cancel_computation()); i++)
 	{
-		//write the labels of the k nearest neighbors from theirs indices
+		//write the labels of the k nearest neighbors from theirs indices,
+		//they are already ordered by distance
 		for (index_t j=0; j<m_k; j++)
-		{
 			train_lab[j] = m_train_labels[ NN(j,i) ];
-			dists[j] = knn_distance->distance(NN(j,i), i);
-		}
-		Math::qsort_index(dists.vector, train_lab.vector, m_k);
 
 		choose_class_for_multiple_k(output.vector+i, classes.vector, train_lab.vector, num_lab);
 	}
@@ -14,7 +14,9 @@
 #include <shogun/multiclass/KNN.h>
 
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/LinalgSpecialPurposes.h>
 
+#include <algorithm>
 #include <utility>
 
 //#define DEBUG_KNN
@@ -53,17 +55,31 @@ void KNN::init()
 	solver=NULL;
 	m_lsh_l = 0;
 	m_lsh_t = 0;
+	m_hnsw_max_connections = 16;
+	m_hnsw_ef_construction = 200;
+	m_hnsw_ef = 50;
+	m_hnsw_solver = nullptr;
+	m_neighbor_cache = nullptr;
 
 	/* use the method classify_multiply_k to experiment with different values
 	 * of k */
-	SG_ADD(&m_k, "k", "Parameter k");
+	SG_ADD(&m_k, "k", "Parameter k", ParameterProperties::HYPER);
 	SG_ADD(&m_q, "q", "Parameter q", ParameterProperties::HYPER);
 	SG_ADD(&m_num_classes, "num_classes", "Number of classes");
 	SG_ADD(&m_leaf_size, "leaf_size", "Leaf size for KDTree");
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_knn_solver, "knn_solver", "Algorithm to solve knn",
 	    ParameterProperties::NONE,
-	    SG_OPTIONS(KNN_BRUTE, KNN_KDTREE, KNN_COVER_TREE, KNN_LSH));
+	    SG_OPTIONS(KNN_BRUTE, KNN_KDTREE, KNN_COVER_TREE, KNN_LSH, KNN_HNSW));
+	SG_ADD(&m_hnsw_max_connections, "hnsw_max_connections",
+	    "Maximum number of links per node for HNSW");
+	SG_ADD(&m_hnsw_ef_construction, "hnsw_ef_construction",
+	    "Size of the candidate list during construction for HNSW");
+	SG_ADD(&m_hnsw_ef, "hnsw_ef",
+	    "Size of the candidate list of queries for HNSW");
+	SG_ADD(&m_neighbor_cache, "neighbor_cache",
+	    "Cache of the neighbour graphs of the brute force solver",
+	    ParameterProperties::SETTING);
 	watch_method("nearest_neighbors", &KNN::nearest_neighbors);
 	watch_method("classify_for_multiple_k", &KNN::classify_for_multiple_k);
 }
@@ -90,6 +106,7 @@ bool KNN::train_machine(std::shared_ptr<Features> data)
 	SGVector<int32_t> lab=multiclass_labels(m_labels)->get_int_labels();
 	m_train_labels=lab.clone();
 	require(m_train_labels.vlen > 0, "Provided training labels are empty");
+	m_hnsw_solver = nullptr;
 
 	// find minimal and maximal class
 	auto min_class = Math::min(m_train_labels.vector, m_train_labels.vlen);
@@ -115,43 +132,87 @@ SGMatrix<index_t> KNN::nearest_neighbors()
 	    n >= m_k,
 	    "K ({}) must not be larger than the number of examples ({}).", m_k, n);
 
-	//distances to train data
-	SGVector<float64_t> dists(m_train_labels.vlen);
-	//indices to train data
-	SGVector<index_t> train_idxs(m_train_labels.vlen);
+	//the cached graph holds the neighbors for all k up to its max_k
+	if (m_neighbor_cache)
+		return m_neighbor_cache->get_graph(distance, m_k)->get_neighbors(m_k);
+
+	return compute_nearest_neighbors(distance);
+}
+
+SGMatrix<index_t> KNN::compute_nearest_neighbors(
+	const std::shared_ptr<Distance>& knn_distance) const
+{
+	const int32_t n=knn_distance->get_num_vec_rhs();
+
 	//pre-allocation of the nearest neighbors
 	SGMatrix<index_t> NN(m_k, n);
 
-	distance->precompute_lhs();
-	distance->precompute_rhs();
-
-	//for each test example
-	for (auto i : SG_PROGRESS(range(n)))
+	knn_distance->precompute_lhs();
+	knn_distance->precompute_rhs();
+
+	SGVector<index_t> all_train_idxs(m_train_labels.vlen);
+	all_train_idxs.range_fill();
+	const index_t block_size=128;
+	const index_t num_blocks=(n+block_size-1)/block_size;
+
+	//on the GPU backend the train examples are transferred once, the
+	//distances and the selection stay on the device and only the indices of
+	//the nearest neighbors come back
+	auto is_dense_real=[](const std::shared_ptr<Features>& f) {
+		return f->get_feature_class()==C_DENSE && f->get_feature_type()==F_DREAL;
+	};
+	auto lhs=knn_distance->get_lhs();
+	auto rhs=knn_distance->get_rhs();
+	linalg::DistanceMetric metric;
+	const bool use_gpu=env()->linalg()->get_gpu_backend() &&
+		knn_distance->get_pairwise_metric(metric) && is_dense_real(lhs) &&
+		is_dense_real(rhs);
+	SGMatrix<float64_t> train_gpu;
+	if (use_gpu)
 	{
-		COMPUTATION_CONTROLLERS
-		//lhs idx 0..num train examples-1 (i.e., all train examples) and rhs idx i
-		distances_lhs(dists,0,m_train_labels.vlen-1,i);
-
-		//fill in an array with 0..num train examples-1
-		for (int32_t j=0; j<m_train_labels.vlen; j++)
-			train_idxs[j]=j;
+		linalg::to_gpu(lhs->copy_subset(all_train_idxs)
+			->as<DenseFeatures<float64_t>>()->get_feature_matrix(), train_gpu);
+	}
 
-		//sort the distance vector between test example i and all train examples
-		Math::qsort_index(dists.vector, train_idxs.vector, m_train_labels.vlen);
+	//for each block of test examples
+	for (auto b : SG_PROGRESS(range(num_blocks)))
+	{
+		if (cancel_computation())
+			break;
+		const index_t begin=b*block_size;
+		SGVector<index_t> test_idxs(std::min(block_size, n-begin));
+		test_idxs.range_fill(begin);
+
+		//indices of the k closest train examples of each test example
+		SGMatrix<index_t> block_nn;
+		if (use_gpu)
+		{
+			SGMatrix<float64_t> test_gpu;
+			linalg::to_gpu(rhs->copy_subset(test_idxs)
+				->as<DenseFeatures<float64_t>>()->get_feature_matrix(), test_gpu);
+			auto block_nn_gpu=linalg::colwise_k_smallest(
+				linalg::pairwise_distance(train_gpu, test_gpu, metric), m_k);
+			linalg::from_gpu(block_nn_gpu, block_nn);
+		}
+		else
+		{
+			block_nn=linalg::colwise_k_smallest(
+				knn_distance->get_distance_block(all_train_idxs, test_idxs), m_k);
+		}
 
 #ifdef DEBUG_KNN
-		io::print("\nQuick sort query {}\n", i);
+		io::print("\nNearest neighbors of block {}\n", b);
 		for (int32_t j=0; j<m_k; j++)
-			io::print("{} ", train_idxs[j]);
+			io::print("{} ", block_nn(j, 0));
 		io::print("\n");
 #endif
 
 		//fill in the output the indices of the nearest neighbors
-		for (int32_t j=0; j<m_k; j++)
-			NN(j,i) = train_idxs[j];
+		std::copy_n(block_nn.matrix, int64_t(m_k)*test_idxs.vlen,
+			NN.get_column_vector(begin));
 	}
 
-	distance->reset_precompute();
+	knn_distance->reset_precompute();
 
 	return NN;
 }
@@ -161,8 +222,9 @@ std::shared_ptr<MulticlassLabels> KNN::apply_multiclass(std::shared_ptr<Features
 	if (data)
 		init_distance(data);
 
-	//redirecting to fast (without sorting) classify if k==1
-	if (m_k == 1)
+	//redirecting to fast (without sorting) classify if k==1, unless the
+	//neighbors are cached anyway
+	if (m_k == 1 && !m_neighbor_cache)
 		return classify_NN();
 
 	require(m_num_classes > 0, "Machine not trained.");
@@ -185,6 +247,44 @@ std::shared_ptr<MulticlassLabels> KNN::apply_multiclass(std::shared_ptr<Features
 	return solver->classify_objects(distance, num_lab, train_lab, classes);
 }
 
+std::shared_ptr<Labels> KNN::predict(
+	const std::shared_ptr<Features>& data) const
+{
+	require(m_num_classes > 0, "Machine not trained.");
+	require(distance, "Distance not set.");
+	require(data, "No features provided.");
+	auto lhs=distance->get_lhs();
+	require(lhs && lhs->get_num_vectors(), "No vectors on left hand side");
+	require(
+	    m_k <= lhs->get_num_vectors(),
+	    "K ({}) must not be larger than the number of training examples ({}).",
+	    m_k, lhs->get_num_vectors());
+
+	// the distance of the machine keeps the training data, the test data go
+	// to a scratch copy that shares the storage of the feature vectors
+	auto knn_distance=make_clone(distance, ParameterProperties::ALL, true);
+	knn_distance->init(lhs, data);
+
+	std::shared_ptr<KNNSolver> knn_solver;
+	if (m_knn_solver == KNN_HNSW)
+	{
+		require(
+		    m_hnsw_solver,
+		    "The HNSW index is built by the first apply(), call it before "
+		    "predict().");
+		knn_solver=m_hnsw_solver;
+	}
+	else
+		knn_solver=make_solver(m_knn_solver, knn_distance);
+
+	const int32_t num_lab=data->get_num_vectors();
+	SGVector<int32_t> train_lab(m_k);
+	SGVector<float64_t> classes(m_num_classes);
+
+	return knn_solver->classify_objects(
+	    knn_distance, num_lab, train_lab, classes);
+}
+
 std::shared_ptr<MulticlassLabels> KNN::classify_NN()
 {
 	require(distance, "Distance not set.");
@@ -200,12 +300,26 @@ std::shared_ptr<MulticlassLabels> KNN::classify_NN()
 
 	distance->precompute_lhs();
 
+	SGVector<index_t> all_train_idxs(m_train_labels.vlen);
+	all_train_idxs.range_fill();
+	// distances to a block of test examples
+	SGMatrix<float64_t> block_dists;
+	const index_t block_size=128;
+
 	// for each test example
 	for (auto i : SG_PROGRESS(range(num_lab)))
 	{
 		COMPUTATION_CONTROLLERS
-		// get distances from i-th test example to 0..num_m_train_labels-1 train examples
-		distances_lhs(distances,0,m_train_labels.vlen-1,i);
+		// get distances from i-th test example to 0..num_m_train_labels-1 train
+		// examples, computed for a whole block of test examples at once
+		if (i%block_size==0)
+		{
+			SGVector<index_t> test_idxs(std::min(block_size, num_lab-i));
+			test_idxs.range_fill(i);
+			block_dists=distance->get_distance_block(all_train_idxs, test_idxs);
+		}
+		std::copy_n(block_dists.get_column_vector(i%block_size),
+			m_train_labels.vlen, distances.vector);
 		int32_t j;
 
 		// assuming 0th train examples as nearest to i-th test example
@@ -289,32 +403,72 @@ void KNN::init_solver(KNN_SOLVER knn_solver)
 	{
 	case KNN_BRUTE:
 	{
+		// the neighbors come from the cache if there is one
 		SGMatrix<index_t> NN = nearest_neighbors();
 		solver = std::make_shared<BruteKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, NN);
 
 		break;
 	}
-	case KNN_KDTREE:
+	case KNN_HNSW:
 	{
-		solver = std::make_shared<KDTREEKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_leaf_size);
+		if (!m_hnsw_solver)
+		{
+			require(
+			    distance->get_distance_type() == D_EUCLIDEAN,
+			    "HNSW solver requires a Euclidean distance!");
+			auto lhs = distance->get_lhs();
+			require(
+			    lhs->get_feature_class() == C_DENSE &&
+			        lhs->get_feature_type() == F_DREAL,
+			    "HNSW solver requires dense real valued features!");
+
+			m_hnsw_solver = std::make_shared<HNSWKNNSolver>(
+			    m_k, m_q, m_num_classes, m_min_label, m_train_labels,
+			    m_hnsw_max_connections, m_hnsw_ef_construction, m_hnsw_ef);
+			m_hnsw_solver->build(lhs->as<DenseFeatures<float64_t>>());
+		}
+		else
+			m_hnsw_solver->set_knn_parameters(
+			    m_k, m_q, m_num_classes, m_min_label, m_train_labels);
+
+		solver = m_hnsw_solver;
 
 		break;
 	}
+	default:
+		solver = make_solver(knn_solver, distance);
+	}
+}
+
+std::shared_ptr<KNNSolver> KNN::make_solver(
+	KNN_SOLVER knn_solver, const std::shared_ptr<Distance>& knn_distance) const
+{
+	switch (knn_solver)
+	{
+	case KNN_BRUTE:
+	{
+		SGMatrix<index_t> NN = compute_nearest_neighbors(knn_distance);
+		return std::make_shared<BruteKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, NN);
+	}
+	case KNN_KDTREE:
+	{
+		return std::make_shared<KDTREEKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_leaf_size);
+	}
 	case KNN_COVER_TREE:
 	{
 #ifdef USE_GPL_SHOGUN
-		solver = std::make_shared<CoverTreeKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels);
-
-		break;
+		return std::make_shared<CoverTreeKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels);
 #else
 		gpl_only(SOURCE_LOCATION);
+		break;
 #endif // USE_GPL_SHOGUN
 	}
 	case KNN_LSH:
 	{
-		solver = std::make_shared<LSHKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_lsh_l, m_lsh_t);
-
-		break;
+		return std::make_shared<LSHKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_lsh_l, m_lsh_t);
 	}
+	case KNN_HNSW:
+		error("The HNSW solver is built with init_solver()");
 	}
+	return nullptr;
 }
@@ -15,6 +15,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/features/Features.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/distance/NeighborGraphCache.h>
 #include <shogun/machine/DistanceMachine.h>
 #include <shogun/multiclass/KNNSolver.h>
 #include <shogun/labels/MulticlassLabels.h>
@@ -24,6 +25,7 @@
 #include <shogun/multiclass/CoverTreeKNNSolver.h>
 #endif
 #include <shogun/multiclass/LSHKNNSolver.h>
+#include <shogun/multiclass/HNSWKNNSolver.h>
 
 namespace shogun
 {
@@ -32,7 +34,8 @@ namespace shogun
 		KNN_BRUTE,
 		KNN_KDTREE,
 		KNN_COVER_TREE,
-		KNN_LSH
+		KNN_LSH,
+		KNN_HNSW
 	};
 
 class DistanceMachine;
@@ -65,6 +68,12 @@ class DistanceMachine;
  * dramatically with the number of examples. Also note that k-NN is capable of
  * multi-class-classification. And finally, in case of k=1 classification will
  * take less time with an special optimization provided.
+ *
+ * With the brute force solver, a registered GPU linalg backend and a
+ * distance that has a linalg::pairwise_distance() metric (Euclidean, cosine
+ * or Manhattan on dense real features), the distances to a block of test
+ * examples and the selection of the k nearest neighbors are computed on the
+ * GPU, only the k indices per test example are transferred back.
  */
 class KNN : public DistanceMachine
 {
@@ -108,6 +117,19 @@ class KNN : public DistanceMachine
 		 */
 		std::shared_ptr<MulticlassLabels> apply_multiclass(std::shared_ptr<Features> data=NULL) override;
 
+		/** classify objects without modifying the machine, see
+		 * Machine::predict()
+		 *
+		 * The test data go to a copy of the distance that shares the
+		 * storage of the features. The neighbor cache is not used, and the
+		 * HNSW solver needs the index built by a previous apply().
+		 *
+		 * @param data (test)data to be classified
+		 * @return classified labels
+		 */
+		std::shared_ptr<Labels> predict(
+			const std::shared_ptr<Features>& data) const override;
+
 		/// get output for example "vec_idx"
 		float64_t apply_one(int32_t vec_idx) override
 		{
@@ -210,6 +232,43 @@ class KNN : public DistanceMachine
 			m_lsh_t = t;
 		}
 
+		/** set parameters for HNSW solver, the index is rebuilt on the next
+		  * apply
+		  * @param max_connections maximum number of links per node on layers
+		  * above 0
+		  * @param ef_construction size of the candidate list during
+		  * construction
+		  * @param ef size of the candidate list of queries
+		  */
+		inline void set_hnsw_parameters(
+			int32_t max_connections, int32_t ef_construction, int32_t ef)
+		{
+			m_hnsw_max_connections = max_connections;
+			m_hnsw_ef_construction = ef_construction;
+			m_hnsw_ef = ef;
+			m_hnsw_solver = nullptr;
+		}
+
+		/** set a cache of neighbour graphs for the brute force solver
+		 *
+		 * The neighbours of the test examples are then searched once per
+		 * train/test split for all k up to the max_k of the cache. Clones of
+		 * the machine share the cache, so the folds of a cross-validation
+		 * over different k reuse their graphs, see NeighborGraphCache.
+		 *
+		 * @param cache cache, nullptr disables caching
+		 */
+		inline void set_neighbor_cache(std::shared_ptr<NeighborGraphCache> cache)
+		{
+			m_neighbor_cache = std::move(cache);
+		}
+
+		/** @return cache of neighbour graphs */
+		inline std::shared_ptr<NeighborGraphCache> get_neighbor_cache() const
+		{
+			return m_neighbor_cache;
+		}
+
 	protected:
 		/** classify all examples with nearest neighbor (k=1)
 		 * @return classified labels
@@ -267,6 +326,27 @@ class KNN : public DistanceMachine
 		 */
 		void init_solver(KNN_SOLVER knn_solver);
 
+		/** create a solver for the distance, the HNSW solver excluded
+		 *
+		 * @param knn_solver type of the solver
+		 * @param knn_distance distance between the training (lhs) and test
+		 * (rhs) examples
+		 * @return solver
+		 */
+		std::shared_ptr<KNNSolver> make_solver(
+			KNN_SOLVER knn_solver,
+			const std::shared_ptr<Distance>& knn_distance) const;
+
+		/** compute the k nearest neighbors among the lhs features of
+		 * every rhs feature vector of a distance, see nearest_neighbors()
+		 *
+		 * @param knn_distance distance between the training (lhs) and test
+		 * (rhs) examples
+		 * @return matrix with indices to the nearest neighbors
+		 */
+		SGMatrix<index_t> compute_nearest_neighbors(
+			const std::shared_ptr<Distance>& knn_distance) const;
+
 	protected:
 		/// the k parameter in KNN
 		int32_t m_k;
@@ -295,6 +375,21 @@ class KNN : public DistanceMachine
 
 		/* Number of probes per query for LSH */
 		int32_t m_lsh_t;
+
+		/* Maximum number of links per node for HNSW */
+		int32_t m_hnsw_max_connections;
+
+		/* Size of the candidate list during construction for HNSW */
+		int32_t m_hnsw_ef_construction;
+
+		/* Size of the candidate list of queries for HNSW */
+		int32_t m_hnsw_ef;
+
+		/* HNSW index of the training data, built on the first apply */
+		std::shared_ptr<HNSWKNNSolver> m_hnsw_solver;
+
+		/* Cache of the neighbour graphs of the brute force solver */
+		std::shared_ptr<NeighborGraphCache> m_neighbor_cache;
 };
 
 }
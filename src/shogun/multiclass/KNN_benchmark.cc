@@ -0,0 +1,56 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/machine/Machine_benchmark.h>
+#include <shogun/multiclass/KNN.h>
+
+namespace shogun
+{
+
+/** state.range(2) is the KNN_SOLVER */
+std::shared_ptr<KNN>
+make_knn(const MachineFixture& fixture, const benchmark::State& state)
+{
+	return std::make_shared<KNN>(
+		5, std::make_shared<EuclideanDistance>(), fixture.multiclass_labels,
+		static_cast<KNN_SOLVER>(state.range(2)));
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, KNN_Train)(benchmark::State& state)
+{
+	for (auto _ : state)
+		make_knn(*this, state)->train(features_train);
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, KNN_Apply)(benchmark::State& state)
+{
+	auto knn = make_knn(*this, state);
+	knn->train(features_train);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(knn->apply_multiclass(features_test));
+	set_counters(state);
+}
+
+#ifdef USE_GPL_SHOGUN
+#define KNN_SOLVERS {KNN_BRUTE, KNN_KDTREE, KNN_COVER_TREE, KNN_LSH, KNN_HNSW}
+#else
+#define KNN_SOLVERS {KNN_BRUTE, KNN_KDTREE, KNN_LSH, KNN_HNSW}
+#endif
+
+#define ADD_KNN_ARGS(WHAT)                                                     \
+	WHAT->ArgNames({"vectors", "threads", "solver"})                           \
+	    ->ArgsProduct(                                                         \
+	        {benchmark::CreateRange(1000, 10000, 10),                          \
+	         benchmark::CreateRange(1, 8, 2), KNN_SOLVERS})                    \
+	    ->UseRealTime()                                                        \
+	    ->Unit(benchmark::kMillisecond)
+
+ADD_KNN_ARGS(BENCHMARK_REGISTER_F(MachineFixture, KNN_Train));
+ADD_KNN_ARGS(BENCHMARK_REGISTER_F(MachineFixture, KNN_Apply));
+
+} // namespace shogun
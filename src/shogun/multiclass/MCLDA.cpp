@@ -17,11 +17,18 @@
 
 #include <shogun/mathematics/eigen3.h>
 
+#include <algorithm>
 #include <utility>
 
 using namespace shogun;
 using namespace Eigen;
 
+namespace
+{
+/* number of vectors classified at once */
+const index_t block_size = 1024;
+}
+
 MCLDA::MCLDA(float64_t tolerance, bool store_cov)
 : NativeMulticlassMachine()
 {
@@ -94,59 +101,42 @@ std::shared_ptr<MulticlassLabels> MCLDA::apply_multiclass(std::shared_ptr<Featur
 	ASSERT(num_vecs > 0)
 	ASSERT( m_dim == m_features->get_dim_feature_space() );
 
-	// collect features into a matrix
 	auto rf = m_features->as<DenseFeatures<float64_t>>();
 
-	MatrixXd X(num_vecs, m_dim);
-
-	int32_t vlen;
-	bool vfree;
-	float64_t* vec;
-	Map< VectorXd > Em_xbar(m_xbar, m_dim);
-	for (int i = 0; i < num_vecs; i++)
+	// the decision function of the centered and scaled data is linear in
+	// the data, d = coef*scalings^T*(x - xbar) + intercept
+	Map<MatrixXd> Em_scalings(m_scalings.matrix, m_dim, m_rank);
+	Map<MatrixXd> Em_coef(m_coef.matrix, m_num_classes, m_rank);
+	Map<VectorXd> Em_intercept(m_intercept.vector, m_num_classes);
+	Map<VectorXd> Em_xbar(m_xbar.vector, m_dim);
+	const MatrixXd W = Em_coef * Em_scalings.transpose();
+	const VectorXd bias = Em_intercept - W * Em_xbar;
+
+	SGVector<float64_t> labels(num_vecs);
+	const index_t num_blocks = (num_vecs + block_size - 1) / block_size;
+#pragma omp parallel for
+	for (index_t b = 0; b < num_blocks; b++)
 	{
-		vec = rf->get_feature_vector(i, vlen, vfree);
-		ASSERT(vec)
-
-		Map< VectorXd > Evec(vec, vlen);
-
-		X.row(i) = Evec - Em_xbar;
+		const index_t begin = b * block_size;
+		const index_t len = std::min(block_size, num_vecs - begin);
+		MatrixXd X(m_dim, len);
+		for (index_t i = 0; i < len; i++)
+		{
+			auto vec = rf->get_feature_vector(begin + i);
+			X.col(i) = Map<VectorXd>(vec.vector, m_dim);
+			rf->free_feature_vector(vec, begin + i);
+		}
 
-		rf->free_feature_vector(vec, i, vfree);
+		MatrixXd d = (W * X).colwise() + bias;
+		for (index_t i = 0; i < len; i++)
+		{
+			index_t max_class;
+			d.col(i).maxCoeff(&max_class);
+			labels[begin + i] = max_class;
+		}
 	}
 
-#ifdef DEBUG_MCLDA
-	io::print("\n>>> Displaying X ...\n");
-	SGMatrix< float64_t >::display_matrix(X.data(), num_vecs, m_dim);
-#endif
-
-	// center and scale data
-	MatrixXd Xs(num_vecs, m_rank);
-	Map< MatrixXd > Em_scalings(m_scalings.matrix, m_dim, m_rank);
-	Xs = X*Em_scalings;
-
-#ifdef DEBUG_MCLDA
-	io::print("\n>>> Displaying Xs ...\n");
-	SGMatrix< float64_t >::display_matrix(Xs.data(), num_vecs, m_rank);
-#endif
-
-	// decision function
-	MatrixXd d(num_vecs, m_num_classes);
-	Map< MatrixXd > Em_coef(m_coef.matrix, m_num_classes, m_rank);
-	Map< VectorXd > Em_intercept(m_intercept.vector, m_num_classes);
-	d = (Xs*Em_coef.transpose()).rowwise() + Em_intercept.transpose();
-
-#ifdef DEBUG_MCLDA
-	io::print("\n>>> Displaying d ...\n");
-	SGMatrix< float64_t >::display_matrix(d.data(), num_vecs, m_num_classes);
-#endif
-
-	// argmax to apply labels
-	auto out = std::make_shared<MulticlassLabels>(num_vecs);
-	for (int i = 0; i < num_vecs; i++)
-		out->set_label(i, Math::arg_max(d.data()+i, num_vecs, m_num_classes));
-
-	return out;
+	return std::make_shared<MulticlassLabels>(labels);
 }
 
 bool MCLDA::train_machine(std::shared_ptr<Features> data)
@@ -6,6 +6,7 @@
 
 #include <shogun/multiclass/MulticlassOCAS.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -15,6 +16,9 @@
 
 using namespace shogun;
 
+/* minimum number of examples per thread when accumulating a cut */
+#define OCAS_MIN_BLOCK_SIZE 1024
+
 struct mocas_data
 {
 	std::shared_ptr<DotFeatures> features;
@@ -22,7 +26,6 @@ struct mocas_data
 	float64_t* oldW;
 	float64_t* full_A;
 	float64_t* data_y;
-	float64_t* output_values;
 	uint32_t nY;
 	uint32_t nData;
 	uint32_t nDim;
@@ -96,7 +99,6 @@ bool MulticlassOCAS::train_machine(std::shared_ptr<Features> data)
 	user_data.oldW = SG_CALLOC(float64_t, (int64_t)num_features*num_classes);
 	user_data.new_a = SG_CALLOC(float64_t, (int64_t)num_features*num_classes);
 	user_data.full_A = SG_CALLOC(float64_t, (int64_t)num_features*num_classes*m_buf_size);
-	user_data.output_values = SG_CALLOC(float64_t, num_vectors);
 	user_data.data_y = labels.vector;
 	user_data.nY = num_classes;
 	user_data.nDim = num_features;
@@ -142,7 +144,6 @@ bool MulticlassOCAS::train_machine(std::shared_ptr<Features> data)
 	SG_FREE(user_data.oldW);
 	SG_FREE(user_data.new_a);
 	SG_FREE(user_data.full_A);
-	SG_FREE(user_data.output_values);
 
 	return true;
 }
@@ -207,14 +208,44 @@ int MulticlassOCAS::msvm_full_add_new_cut(float64_t *new_col_H, uint32_t *new_cu
 
 	linalg::zero(new_a);
 
-	for(i=0; i < nData; i++)
+	/* every block of examples is accumulated into its own vector, the first
+	 * one into new_a, and the vectors are summed afterwards */
+	const int32_t num_blocks=Math::max(1, Math::min(
+		env()->get_num_threads(), int32_t(nData/OCAS_MIN_BLOCK_SIZE)));
+	SGMatrix<float64_t> local_a;
+	if (num_blocks>1)
+		local_a=SGMatrix<float64_t>(nDim*nY, num_blocks-1);
+#pragma omp parallel for num_threads(num_blocks) private(i, y, y2)
+	for (int32_t b=0; b<num_blocks; b++)
 	{
-		y = (uint32_t)(data_y[i]);
-		y2 = (uint32_t)new_cut[i];
-		if(y2 != y)
+		float64_t* a=new_a.vector;
+		if (b>0)
+		{
+			a=local_a.get_column_vector(b-1);
+			memset(a, 0, sizeof(float64_t)*nDim*nY);
+		}
+
+		const uint32_t begin=int64_t(b)*nData/num_blocks;
+		const uint32_t end=int64_t(b+1)*nData/num_blocks;
+		for(i=begin; i < end; i++)
 		{
-			features->add_to_dense_vec(1.0,i,&new_a[nDim*y],nDim);
-			features->add_to_dense_vec(-1.0,i,&new_a[nDim*y2],nDim);
+			y = (uint32_t)(data_y[i]);
+			y2 = (uint32_t)new_cut[i];
+			if(y2 != y)
+			{
+				features->add_to_dense_vec(1.0,i,&a[nDim*y],nDim);
+				features->add_to_dense_vec(-1.0,i,&a[nDim*y2],nDim);
+			}
+		}
+	}
+
+	if (num_blocks>1)
+	{
+#pragma omp parallel for
+		for (int64_t k=0; k<int64_t(nDim)*nY; k++)
+		{
+			for (int32_t b=1; b<num_blocks; b++)
+				new_a[k]+=local_a(k, b-1);
 		}
 	}
 
@@ -224,6 +255,7 @@ int MulticlassOCAS::msvm_full_add_new_cut(float64_t *new_col_H, uint32_t *new_cu
 		full_A[LIBOCAS_INDEX(j,nSel,nDim*nY)] = new_a[j];
 
 	new_col_H[nSel] = sq_norm_a;
+#pragma omp parallel for private(j)
 	for(i=0; i < nSel; i++)
 	{
 		float64_t tmp = 0;
@@ -243,16 +275,19 @@ int MulticlassOCAS::msvm_full_compute_output(float64_t *output, void* user_data)
 	uint32_t nY = ((mocas_data*)user_data)->nY;
 	uint32_t nDim = ((mocas_data*)user_data)->nDim;
 	uint32_t nData = ((mocas_data*)user_data)->nData;
-	float64_t* output_values = ((mocas_data*)user_data)->output_values;
 	auto features = ((mocas_data*)user_data)->features;
 
 	uint32_t i, y;
 
-	for(y=0; y<nY; y++)
+	/* one pass over the data computing the outputs of all classes */
+#pragma omp parallel for private(y)
+	for (i=0; i<nData; i++)
 	{
-		features->dense_dot_range(output_values,0,nData,NULL,&W[nDim*y],nDim,0.0);
-		for (i=0; i<nData; i++)
-			output[LIBOCAS_INDEX(y,i,nY)] = output_values[i];
+		for(y=0; y<nY; y++)
+		{
+			output[LIBOCAS_INDEX(y,i,nY)] = features->dot(
+				i, SGVector<float64_t>(&W[nDim*y], nDim, false));
+		}
 	}
 
 	return 0;
@@ -70,3 +70,12 @@ void MulticlassStrategy::train_stop()
     m_train_labels = NULL;
     m_orig_labels = NULL;
 }
+
+SGVector<int32_t> MulticlassStrategy::decide_labels(SGMatrix<float64_t> outputs)
+{
+	SGVector<int32_t> labels(outputs.num_cols);
+	for (index_t i=0; i<outputs.num_cols; i++)
+		labels[i] = decide_label(outputs.get_column(i));
+
+	return labels;
+}
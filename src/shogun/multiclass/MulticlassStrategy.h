@@ -108,6 +108,14 @@ public:
 	 */
 	virtual int32_t decide_label(SGVector<float64_t> outputs)=0;
 
+	/** decide the final labels of many samples, by default one by one
+	 * with decide_label().
+	 * @param outputs outputs from each machine (in that order), one
+	 * sample per column
+	 * @return one label per sample
+	 */
+	virtual SGVector<int32_t> decide_labels(SGMatrix<float64_t> outputs);
+
 	/** decide the final label.
 	 * @param outputs a vector of output from each machine (in that order)
 	 * @param n_outputs number of outputs
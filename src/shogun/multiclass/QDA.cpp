@@ -18,11 +18,18 @@
 
 #include <shogun/mathematics/eigen3.h>
 
+#include <algorithm>
 #include <utility>
 
 using namespace shogun;
 using namespace Eigen;
 
+namespace
+{
+/* number of vectors classified at once */
+const index_t block_size = 1024;
+}
+
 QDA::QDA() : NativeMulticlassMachine(), m_num_classes(0), m_dim(0)
 {
 	init();
@@ -123,51 +130,48 @@ std::shared_ptr<MulticlassLabels> QDA::apply_multiclass(std::shared_ptr<Features
 	ASSERT( m_dim == m_features->get_dim_feature_space() )
 
 	auto rf = m_features->as<DenseFeatures<float64_t>>();
+	SGVector<float64_t> labels(num_vecs);
 
-	MatrixXd X(num_vecs, m_dim);
-	MatrixXd A(num_vecs, m_dim);
-	VectorXd norm2(num_vecs*m_num_classes);
-	norm2.setZero();
-
-	SGVector<float64_t> vec;
-	for (int k = 0; k < m_num_classes; k++)
+	// blocks of vectors are whitened by every class in one product
+	const index_t num_blocks = (num_vecs + block_size - 1) / block_size;
+#pragma omp parallel for
+	for (index_t b = 0; b < num_blocks; b++)
 	{
-		// X = features - means
-		for (int i = 0; i < num_vecs; i++)
+		const index_t begin = b * block_size;
+		const index_t len = std::min(block_size, num_vecs - begin);
+		MatrixXd X(m_dim, len);
+		for (index_t i = 0; i < len; i++)
 		{
-			vec = rf->get_feature_vector(i);
-			ASSERT(vec.vector)
-
-			SGVector<float64_t>::EigenVectorXtMap Evec = vec;
-			Map< VectorXd > Em_means_col(m_means.get_column_vector(k), m_dim);
-
-			X.row(i) = Evec - Em_means_col;
-
-			rf->free_feature_vector(vec, i);
+			auto vec = rf->get_feature_vector(begin + i);
+			X.col(i) = Map<VectorXd>(vec.vector, m_dim);
+			rf->free_feature_vector(vec, begin + i);
 		}
 
-		SGMatrix<float64_t>::EigenMatrixXtMap Em_M = m_M.slice(m_dim * k, m_dim * (k + 1));
-		A = X*Em_M;
-
-		for (int i = 0; i < num_vecs; i++)
-			norm2(i + k*num_vecs) = A.row(i).array().square().sum();
-
-	}
-
-	for (int i = 0; i < num_vecs; i++)
-		for (int k = 0; k < m_num_classes; k++)
+		// minus half of the squared Mahalanobis distance to the mean and
+		// of the log determinant of the covariance of every class
+		MatrixXd scores(m_num_classes, len);
+		for (int32_t k = 0; k < m_num_classes; k++)
 		{
-			norm2[i + k*num_vecs] += m_slog[k];
-			norm2[i + k*num_vecs] *= -0.5;
+			Map<const MatrixXd> Em_M(
+			    m_M.matrix + int64_t(k) * m_dim * m_dim, m_dim, m_dim);
+			Map<const VectorXd> Em_means_col(m_means.get_column_vector(k), m_dim);
+			scores.row(k) =
+			    -0.5 * ((Em_M.transpose() * (X.colwise() - Em_means_col))
+			                .colwise()
+			                .squaredNorm()
+			                .array() +
+			            m_slog[k]);
 		}
 
+		for (index_t i = 0; i < len; i++)
+		{
+			index_t max_class;
+			scores.col(i).maxCoeff(&max_class);
+			labels[begin + i] = max_class;
+		}
+	}
 
-	auto out = std::make_shared<MulticlassLabels>(num_vecs);
-
-	for (int i = 0 ; i < num_vecs; i++)
-		out->set_label(i, Math::arg_max(norm2.data()+i, num_vecs, m_num_classes));
-
-	return out;
+	return std::make_shared<MulticlassLabels>(labels);
 }
 
 bool QDA::train_machine(std::shared_ptr<Features> data)
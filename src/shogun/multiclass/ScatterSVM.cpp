@@ -391,15 +391,24 @@ void ScatterSVM::compute_norm_wc()
 		auto svm=get_svm(c);
 		int32_t num_sv = svm->get_num_support_vectors();
 
+		// rows are summed in parallel and added up in order, so the norm
+		// does not depend on the number of threads
+		SGVector<float64_t> row_sums(num_sv);
+		#pragma omp parallel for schedule(dynamic, 16) num_threads(env()->get_num_threads())
 		for (int32_t i=0; i<num_sv; i++)
 		{
 			int32_t ii=svm->get_support_vector(i);
+			float64_t sum=0;
 			for (int32_t j=0; j<num_sv; j++)
 			{
 				int32_t jj=svm->get_support_vector(j);
-				norm_wc[c]+=svm->get_alpha(i)*m_kernel->kernel(ii,jj)*svm->get_alpha(j);
+				sum+=svm->get_alpha(i)*m_kernel->kernel(ii,jj)*svm->get_alpha(j);
 			}
+			row_sums[i]=sum;
 		}
+
+		for (int32_t i=0; i<num_sv; i++)
+			norm_wc[c]+=row_sums[i];
 	}
 
 	for (size_t i=0; i<m_machines.size(); i++)
@@ -6,7 +6,9 @@
  */
 
 #include <algorithm>
+#include <vector>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/features/DenseSubsetFeatures.h>
 #include <shogun/labels/RegressionLabels.h>
@@ -60,6 +62,18 @@ bool ShareBoost::train_machine(std::shared_ptr<Features> data)
 				m_nonzero_feas, fea->get_num_features());
 
 	m_fea = fea->get_feature_matrix();
+	// every round scans the features, which are contiguous in the
+	// transposed copy
+	m_fea_t = SGMatrix<float64_t>(m_fea.num_cols, m_fea.num_rows);
+	for (int32_t ii=0; ii < m_fea.num_cols; ++ii)
+	{
+		for (int32_t j=0; j < m_fea.num_rows; ++j)
+			m_fea_t(ii, j) = m_fea(j, ii);
+	}
+	auto lab = multiclass_labels(m_labels);
+	m_int_labels = SGVector<int32_t>(m_fea.num_cols);
+	for (int32_t ii=0; ii < m_fea.num_cols; ++ii)
+		m_int_labels[ii] = lab->get_int_label(ii);
 	m_rho = SGMatrix<float64_t>(m_multiclass_strategy->get_num_classes(), m_fea.num_cols);
 	m_rho_norm = SGVector<float64_t>(m_fea.num_cols);
 	m_pred = SGMatrix<float64_t>(m_fea.num_cols, m_multiclass_strategy->get_num_classes());
@@ -99,6 +113,8 @@ bool ShareBoost::train_machine(std::shared_ptr<Features> data)
 
 	// release memory
 	m_fea = SGMatrix<float64_t>();
+	m_fea_t = SGMatrix<float64_t>();
+	m_int_labels = SGVector<int32_t>();
 	m_rho = SGMatrix<float64_t>();
 	m_rho_norm = SGVector<float64_t>();
 	m_pred = SGMatrix<float64_t>();
@@ -138,13 +154,11 @@ void ShareBoost::compute_pred(const float64_t *W)
 
 void ShareBoost::compute_rho()
 {
-	auto lab = multiclass_labels(m_labels);
-
 	for (int32_t i=0; i < m_rho.num_rows; ++i)
 	{ // i loop classes
 		for (int32_t j=0; j < m_rho.num_cols; ++j)
 		{ // j loop samples
-			int32_t label = lab->get_int_label(j);
+			int32_t label = m_int_labels[j];
 
 			m_rho(i, j) =
 			    std::exp((label == i) - m_pred(j, label) + m_pred(j, i));
@@ -162,29 +176,52 @@ void ShareBoost::compute_rho()
 
 int32_t ShareBoost::choose_feature()
 {
+	const int32_t num_classes = m_multiclass_strategy->get_num_classes();
+	const int32_t num_vecs = m_fea.num_cols;
+
+	// normalized rho is shared by all features
+	SGMatrix<float64_t> rho_normalized(num_classes, num_vecs);
+	for (int32_t ii=0; ii < num_vecs; ++ii)
+	{
+		for (int32_t k=0; k < num_classes; ++k)
+			rho_normalized(k, ii) = m_rho(k, ii)/m_rho_norm[ii];
+	}
+
+	SGVector<bool> active(m_fea.num_rows);
+	active.zero();
+	for (int32_t i=0; i < m_activeset.vlen; ++i)
+		active[m_activeset[i]] = true;
+
+	// the features are scored in parallel, each in one pass over its
+	// values with an accumulator per class
 	SGVector<float64_t> l1norm(m_fea.num_rows);
-	auto lab = multiclass_labels(m_labels);
-	for (int32_t j=0; j < m_fea.num_rows; ++j)
+	#pragma omp parallel num_threads(env()->get_num_threads())
 	{
-		if (std::find(&m_activeset[0], &m_activeset[m_activeset.vlen], j) !=
-				&m_activeset[m_activeset.vlen])
-		{
-			l1norm[j] = 0;
-		}
-		else
+		std::vector<float64_t> abssum(num_classes);
+
+		#pragma omp for schedule(dynamic, 16)
+		for (int32_t j=0; j < m_fea.num_rows; ++j)
 		{
 			l1norm[j] = 0;
-			for (int32_t k=0; k < m_multiclass_strategy->get_num_classes(); ++k)
+			if (active[j])
+				continue;
+
+			std::fill(abssum.begin(), abssum.end(), 0.0);
+			const float64_t* x = m_fea_t.get_column_vector(j);
+			for (int32_t ii=0; ii < num_vecs; ++ii)
 			{
-				float64_t abssum = 0;
-				for (int32_t ii=0; ii < m_fea.num_cols; ++ii)
-				{
-					abssum += m_fea(j, ii)*(m_rho(k, ii)/m_rho_norm[ii] -
-							(j == lab->get_int_label(ii)));
-				}
-				l1norm[j] += Math::abs(abssum);
+				if (x[ii] == 0)
+					continue;
+
+				const float64_t* rho = rho_normalized.get_column_vector(ii);
+				const float64_t indicator = (j == m_int_labels[ii]);
+				for (int32_t k=0; k < num_classes; ++k)
+					abssum[k] += x[ii]*(rho[k] - indicator);
 			}
-			l1norm[j] /= m_fea.num_cols;
+
+			for (int32_t k=0; k < num_classes; ++k)
+				l1norm[j] += Math::abs(abssum[k]);
+			l1norm[j] /= num_vecs;
 		}
 	}
 
@@ -71,6 +71,8 @@ private:
 	SGVector<int32_t> m_activeset; ///< selected features
 
 	SGMatrix<float64_t> m_fea; ///< feature matrix used during training
+	SGMatrix<float64_t> m_fea_t; ///< transposed feature matrix, one column per feature
+	SGVector<int32_t> m_int_labels; ///< class of every training vector
 	SGMatrix<float64_t> m_rho; ///< cache_matrix for rho
 	SGVector<float64_t> m_rho_norm; ///< column sum of m_rho
 	SGMatrix<float64_t> m_pred; ///< predictions, used in training
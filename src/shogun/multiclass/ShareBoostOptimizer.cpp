@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 #include <shogun/multiclass/ShareBoostOptimizer.h>
@@ -50,32 +51,36 @@ float64_t ShareBoostOptimizer::lbfgs_evaluate(void *userdata, const float64_t *W
 	int32_t m = optimizer->m_sb->m_activeset.vlen;
 	int32_t k = optimizer->m_sb->m_multiclass_strategy->get_num_classes();
 
-	SGMatrix<float64_t> fea = optimizer->m_sb->m_fea;
-	auto lab = multiclass_labels(optimizer->m_sb->m_labels);
+	SGMatrix<float64_t> fea_t = optimizer->m_sb->m_fea_t;
+	const SGVector<int32_t>& labels = optimizer->m_sb->m_int_labels;
+	const SGMatrix<float64_t>& rho = optimizer->m_sb->m_rho;
+	const SGVector<float64_t>& rho_norm = optimizer->m_sb->m_rho_norm;
+	const int32_t num_vecs = fea_t.num_rows;
 
-	// compute gradient
+	// compute gradient, the active features are contiguous columns of the
+	// transposed features
+	#pragma omp parallel for collapse(2) num_threads(env()->get_num_threads())
 	for (int32_t i=0; i < m; ++i)
 	{
 		for (int32_t j=0; j < k; ++j)
 		{
 			int32_t idx = j*m + i;
+			const float64_t* x = fea_t.get_column_vector(optimizer->m_sb->m_activeset[i]);
 			float64_t g=0;
-			for (int32_t ii=0; ii < fea.num_cols; ++ii)
-				g += fea(optimizer->m_sb->m_activeset[i], ii) *
-					(optimizer->m_sb->m_rho(j,ii)/optimizer->m_sb->m_rho_norm[ii] -
-					 (j == lab->get_int_label(ii)));
-			g /= fea.num_cols;
+			for (int32_t ii=0; ii < num_vecs; ++ii)
+				g += x[ii] * (rho(j,ii)/rho_norm[ii] - (j == labels[ii]));
+			g /= num_vecs;
 			grad[idx] = g;
 		}
 	}
 
 	// compute objective function
 	float64_t objval = 0;
-	for (int32_t ii=0; ii < fea.num_cols; ++ii)
+	for (int32_t ii=0; ii < num_vecs; ++ii)
 	{
 		objval += std::log(optimizer->m_sb->m_rho_norm[ii]);
 	}
-	objval /= fea.num_cols;
+	objval /= num_vecs;
 
 	return objval;
 }
@@ -49,6 +49,11 @@ protected:
             dist += (outputs[i]-code[i])*(outputs[i]-code[i]) * Math::abs(code[i]);
 		return std::sqrt(dist);
 	}
+
+    /** compute the distances of many samples to all codes, from
+     * |b_i|^T q^2 - 2 q^T b_i + ||b_i||_1 with two matrix products, as the
+     * codes are -1, 0 or +1 */
+    SGMatrix<float64_t> compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
 };
 
 } /* shogun */
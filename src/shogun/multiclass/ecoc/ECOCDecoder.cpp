@@ -4,6 +4,7 @@
  * Authors: Chiyuan Zhang, Soeren Sonnenburg
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/multiclass/ecoc/ECOCDecoder.h>
 
@@ -23,3 +24,13 @@ SGVector<float64_t> ECOCDecoder::binarize(const SGVector<float64_t> query)
     return bquery;
 }
 
+SGVector<int32_t> ECOCDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGVector<int32_t> labels(outputs.num_cols);
+
+    #pragma omp parallel for num_threads(env()->get_num_threads())
+    for (index_t i=0; i < outputs.num_cols; ++i)
+        labels[i] = decide_label(outputs.get_column(i), codebook);
+
+    return labels;
+}
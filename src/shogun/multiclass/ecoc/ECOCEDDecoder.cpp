@@ -0,0 +1,39 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/multiclass/ecoc/ECOCEDDecoder.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace shogun;
+
+SGMatrix<float64_t> ECOCEDDecoder::compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGMatrix<float64_t> distances = code_products(outputs, codebook);
+
+    SGVector<float64_t> code_norms(codebook.num_cols);
+    for (index_t j=0; j < codebook.num_cols; ++j)
+    {
+        code_norms[j] = 0;
+        for (index_t k=0; k < codebook.num_rows; ++k)
+            code_norms[j] += codebook(k, j)*codebook(k, j);
+    }
+
+    #pragma omp parallel for num_threads(env()->get_num_threads())
+    for (index_t i=0; i < outputs.num_cols; ++i)
+    {
+        float64_t output_norm = 0;
+        for (index_t k=0; k < outputs.num_rows; ++k)
+            output_norm += outputs(k, i)*outputs(k, i);
+
+        for (index_t j=0; j < codebook.num_cols; ++j)
+            distances(j, i) = std::sqrt(std::max(output_norm - 2*distances(j, i) + code_norms[j], 0.0));
+    }
+
+    return distances;
+}
@@ -49,6 +49,10 @@ protected:
             dist += (outputs[i]-code[i])*(outputs[i]-code[i]);
 		return std::sqrt(dist);
 	}
+
+    /** compute the distances of many samples to all codes, from
+     * ||q||^2 - 2 q^T b_i + ||b_i||^2 with one matrix product */
+    SGMatrix<float64_t> compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
 };
 
 } /* shogun */
@@ -43,6 +43,13 @@ protected:
     {
         return ECOCUtil::hamming_distance(outputs.vector, code, outputs.vlen);
     }
+
+    /** compute the distances of many samples to all codes with bitsets,
+     * see ECOCUtil::hamming_distances() */
+    SGMatrix<float64_t> compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook) override
+    {
+        return ECOCUtil::hamming_distances(outputs, codebook);
+    }
 };
 
 }
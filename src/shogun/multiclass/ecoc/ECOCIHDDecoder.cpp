@@ -8,6 +8,7 @@
 
 #ifdef HAVE_LAPACK
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/multiclass/ecoc/ECOCIHDDecoder.h>
 #include <shogun/multiclass/ecoc/ECOCUtil.h>
 #include <shogun/mathematics/Math.h>
@@ -17,20 +18,29 @@ using namespace shogun;
 
 
 int32_t ECOCIHDDecoder::decide_label(const SGVector<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    // decoded as a batch of one, so the labels do not depend on the batch
+    SGMatrix<float64_t> query(outputs.vector, outputs.vlen, 1, false);
+    return decide_labels(query, codebook)[0];
+}
+
+SGVector<int32_t> ECOCIHDDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
 {
     update_delta_cache(codebook);
 
-    SGVector<float64_t> query = binarize(outputs);
-    SGVector<float64_t> L(codebook.num_cols);
-    for (int32_t i=0; i < codebook.num_cols; ++i)
-        L[i] = ECOCUtil::hamming_distance(query.vector, codebook.get_column_vector(i), query.vlen);
+    SGMatrix<float64_t> L = ECOCUtil::hamming_distances(outputs, codebook);
 
-    SGVector<float64_t> res(codebook.num_cols);
-    res.zero();
     // res = m_delta * L
-    cblas_dgemv(CblasColMajor, CblasNoTrans, m_delta.num_cols, m_delta.num_cols,
-            1, m_delta.matrix, m_delta.num_cols, L.vector, 1, 1, res.vector, 1);
-    return Math::arg_max(res.vector, 1, res.vlen);
+    SGMatrix<float64_t> res(codebook.num_cols, outputs.num_cols);
+    cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m_delta.num_rows, L.num_cols, m_delta.num_cols,
+            1, m_delta.matrix, m_delta.num_rows, L.matrix, L.num_rows, 0, res.matrix, res.num_rows);
+
+    SGVector<int32_t> labels(outputs.num_cols);
+    #pragma omp parallel for num_threads(env()->get_num_threads())
+    for (index_t i=0; i < outputs.num_cols; ++i)
+        labels[i] = Math::arg_max(res.get_column_vector(i), 1, res.num_rows);
+
+    return labels;
 }
 
 void ECOCIHDDecoder::update_delta_cache(const SGMatrix<int32_t> codebook)
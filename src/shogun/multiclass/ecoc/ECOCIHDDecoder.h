@@ -47,6 +47,15 @@ public:
      */
     int32_t decide_label(const SGVector<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
 
+    /** decide the labels of many samples, with the hamming distances of
+     * ECOCUtil::hamming_distances() and one matrix product with the
+     * inverse of the code distances.
+     * @param outputs outputs by classifiers, one sample per column
+     * @param codebook ECOC codebook
+     * @return one label per sample
+     */
+    SGVector<int32_t> decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
+
 protected:
     /** update delta cache */
     void update_delta_cache(const SGMatrix<int32_t> codebook);
@@ -9,3 +9,11 @@ float64_t ECOCLLBDecoder::compute_distance(SGVector<float64_t> outputs, const in
         loss += outputs[i]*code[i];
     return -loss;
 }
+
+SGMatrix<float64_t> ECOCLLBDecoder::compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGMatrix<float64_t> distances = code_products(outputs, codebook);
+    for (index_t i=0; i < distances.num_rows*distances.num_cols; ++i)
+        distances.matrix[i] = -distances.matrix[i];
+    return distances;
+}
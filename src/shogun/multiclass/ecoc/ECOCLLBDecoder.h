@@ -36,6 +36,10 @@ protected:
 
     /** compute distance */
     float64_t compute_distance(SGVector<float64_t> outputs, const int32_t *code) override;
+
+    /** compute the distances of many samples to all codes, one matrix
+     * product of the outputs and the codebook */
+    SGMatrix<float64_t> compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
 };
 
 } /* shogun */
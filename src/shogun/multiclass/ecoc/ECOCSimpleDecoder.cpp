@@ -4,22 +4,81 @@
  * Authors: Soeren Sonnenburg, Sanuj Sharma, Chiyuan Zhang
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/multiclass/ecoc/ECOCSimpleDecoder.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
 
 using namespace shogun;
+using namespace Eigen;
 
 int32_t ECOCSimpleDecoder::decide_label(const SGVector<float64_t> outputs, const SGMatrix<int32_t> codebook)
 {
-    SGVector<float64_t> query=outputs;
+    // decoded as a batch of one, so the labels do not depend on the batch
+    SGMatrix<float64_t> query(outputs.vector, outputs.vlen, 1, false);
+    return decide_labels(query, codebook)[0];
+}
+
+SGVector<int32_t> ECOCSimpleDecoder::decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGMatrix<float64_t> distances = compute_distances(outputs, codebook);
+
+    SGVector<int32_t> labels(outputs.num_cols);
+    #pragma omp parallel for num_threads(env()->get_num_threads())
+    for (index_t i=0; i < outputs.num_cols; ++i)
+        labels[i] = Math::arg_min(distances.get_column_vector(i), 1, distances.num_rows);
+
+    return labels;
+}
+
+SGMatrix<float64_t> ECOCSimpleDecoder::compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+    SGMatrix<float64_t> distances(codebook.num_cols, outputs.num_cols);
+
+    #pragma omp parallel for num_threads(env()->get_num_threads())
+    for (index_t i=0; i < outputs.num_cols; ++i)
+    {
+        SGVector<float64_t> query = outputs.get_column(i);
+        if (binary_decoding())
+            query = binarize(query);
+
+        for (index_t j=0; j < codebook.num_cols; ++j)
+            distances(j, i) = compute_distance(query, codebook.get_column_vector(j));
+    }
+
+    return distances;
+}
+
+SGMatrix<float64_t> ECOCSimpleDecoder::code_products(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook,
+        bool absolute_codes, bool squared_outputs)
+{
+    require(outputs.num_rows == codebook.num_rows,
+            "Outputs of {} classifiers do not match codes of length {}",
+            outputs.num_rows, codebook.num_rows);
+
+    MatrixXd codes = Map<const MatrixXi>(codebook.matrix, codebook.num_rows, codebook.num_cols).cast<float64_t>();
+    if (absolute_codes)
+        codes = codes.cwiseAbs();
+
+    SGMatrix<float64_t> products(codebook.num_cols, outputs.num_cols);
+    Map<const MatrixXd> O(outputs.matrix, outputs.num_rows, outputs.num_cols);
+    Map<MatrixXd> P(products.matrix, products.num_rows, products.num_cols);
 
-    if (binary_decoding())
-        query = binarize(outputs);
+    const index_t block_size = 256;
+    const index_t num_blocks = (outputs.num_cols + block_size - 1) / block_size;
 
-    SGVector<float64_t> distances(codebook.num_cols);
-    for (int32_t i=0; i < distances.vlen; ++i)
-        distances[i] = compute_distance(query, codebook.get_column_vector(i));
+    #pragma omp parallel for num_threads(env()->get_num_threads())
+    for (index_t b=0; b < num_blocks; ++b)
+    {
+        const index_t begin = b * block_size;
+        const index_t len = std::min(block_size, outputs.num_cols - begin);
+        if (squared_outputs)
+            P.middleCols(begin, len).noalias() = codes.transpose() * O.middleCols(begin, len).cwiseAbs2();
+        else
+            P.middleCols(begin, len).noalias() = codes.transpose() * O.middleCols(begin, len);
+    }
 
-    int32_t result = Math::arg_min(distances.vector, 1, distances.vlen);
-    return result;
+    return products;
 }
@@ -37,12 +37,44 @@ public:
      */
     int32_t decide_label(const SGVector<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
 
+    /** decide the labels of many samples, the codes with the smallest
+     * distances returned by compute_distances().
+     * @param outputs outputs by classifiers, one sample per column
+     * @param codebook ECOC codebook
+     * @return one label per sample
+     */
+    SGVector<int32_t> decide_labels(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook) override;
+
 protected:
     /** whether to turn the output into binary before decoding */
     virtual bool binary_decoding()=0;
 
     /** compute distance */
     virtual float64_t compute_distance(SGVector<float64_t> outputs, const int32_t *code)=0;
+
+    /** compute the distances of many samples to all codes, by default
+     * with compute_distance() in parallel over the samples. Subclasses
+     * override this with a computation for the whole batch.
+     * @param outputs outputs by classifiers, one sample per column, not
+     * binarized
+     * @param codebook ECOC codebook
+     * @return distances, one column of codebook.num_cols distances per
+     * sample
+     */
+    virtual SGMatrix<float64_t> compute_distances(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
+
+    /** compute the inner products of the (elementwise transformed)
+     * outputs with all codes, in parallel over blocks of samples with one
+     * matrix product per block.
+     * @param outputs outputs by classifiers, one sample per column
+     * @param codebook ECOC codebook
+     * @param absolute_codes use the absolute values of the codes
+     * @param squared_outputs use the squares of the outputs
+     * @return inner products, one column of codebook.num_cols values per
+     * sample
+     */
+    static SGMatrix<float64_t> code_products(const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook,
+            bool absolute_codes=false, bool squared_outputs=false);
 };
 
 } /* shogun */
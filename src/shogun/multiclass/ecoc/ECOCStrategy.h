@@ -51,6 +51,13 @@ public:
      */
     int32_t decide_label(SGVector<float64_t> outputs) override;
 
+    /** decide the final labels of many samples in one batch of the
+     * decoder.
+     * @param outputs outputs from each machine (in that order), one
+     * sample per column
+     */
+    SGVector<int32_t> decide_labels(SGMatrix<float64_t> outputs) override;
+
     /** get number of machines used in this strategy.
      */
     int32_t get_num_machines() override;
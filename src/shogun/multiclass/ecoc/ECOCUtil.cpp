@@ -0,0 +1,88 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/range.h>
+#include <shogun/multiclass/ecoc/ECOCUtil.h>
+
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+	constexpr index_t kBitsPerWord = 64;
+
+	int32_t popcount(uint64_t word)
+	{
+		return __builtin_popcountll(word);
+	}
+} // namespace
+
+SGMatrix<float64_t> ECOCUtil::hamming_distances(
+    const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook)
+{
+	require(
+	    outputs.num_rows == codebook.num_rows,
+	    "Outputs of {} classifiers do not match codes of length {}",
+	    outputs.num_rows, codebook.num_rows);
+
+	const index_t len = codebook.num_rows;
+	const index_t num_codes = codebook.num_cols;
+	const index_t num_vectors = outputs.num_cols;
+	const index_t num_words = (len + kBitsPerWord - 1) / kBitsPerWord;
+
+	// code c occupies the words [c*num_words, (c+1)*num_words)
+	std::vector<uint64_t> code_signs(num_words * num_codes, 0);
+	std::vector<uint64_t> code_nonzeros(num_words * num_codes, 0);
+	std::vector<int32_t> num_zeros(num_codes, 0);
+	for (auto c : range(num_codes))
+	{
+		for (auto i : range(len))
+		{
+			const uint64_t bit = uint64_t(1) << (i % kBitsPerWord);
+			const index_t w = c * num_words + i / kBitsPerWord;
+			if (codebook(i, c) > 0)
+				code_signs[w] |= bit;
+			if (codebook(i, c) != 0)
+				code_nonzeros[w] |= bit;
+			else
+				num_zeros[c]++;
+		}
+	}
+
+	SGMatrix<float64_t> distances(num_codes, num_vectors);
+
+	#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<uint64_t> signs(num_words);
+
+		#pragma omp for schedule(static)
+		for (index_t j = 0; j < num_vectors; ++j)
+		{
+			std::fill(signs.begin(), signs.end(), 0);
+			for (auto i : range(len))
+			{
+				if (outputs(i, j) >= 0)
+					signs[i / kBitsPerWord] |= uint64_t(1) << (i % kBitsPerWord);
+			}
+
+			for (auto c : range(num_codes))
+			{
+				const uint64_t* code_sign = code_signs.data() + c * num_words;
+				const uint64_t* code_nonzero =
+				    code_nonzeros.data() + c * num_words;
+				int32_t num_disagree = 0;
+				for (auto w : range(num_words))
+					num_disagree +=
+					    popcount(code_nonzero[w] & (signs[w] ^ code_sign[w]));
+				distances(c, j) = (2 * num_disagree + num_zeros[c]) / 2;
+			}
+		}
+	}
+
+	return distances;
+}
@@ -9,6 +9,7 @@
 
 #include <shogun/lib/config.h>
 
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/Math.h>
 
 namespace shogun
@@ -31,6 +32,24 @@ public:
                 dist += static_cast<int32_t>(Math::abs((c1[i]-c2[i])));
             return dist/2;
         }
+
+    /** compute the hamming distances of the binarized outputs of many
+     * samples to all codes, see hamming_distance().
+     *
+     * The signs of the outputs and codes are packed into bitsets, 64 code
+     * positions per word, and the codes also get a bitset of their nonzero
+     * positions. A sample then disagrees with a code at
+     * popcount(nonzero & (sign ^ code_sign)) positions and every zero
+     * position adds a half, so a distance costs a few word operations per
+     * 64 classifiers. The samples are decoded in parallel.
+     *
+     * @param outputs outputs of the classifiers, one sample per column
+     * @param codebook codes, one per column
+     * @return distances, one column of codebook.num_cols distances per
+     * sample
+     */
+    static SGMatrix<float64_t> hamming_distances(
+        const SGMatrix<float64_t> outputs, const SGMatrix<int32_t> codebook);
 };
 
 } /* shogun */
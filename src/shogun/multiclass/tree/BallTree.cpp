@@ -48,28 +48,15 @@ float64_t BallTree::min_dist(std::shared_ptr<bnode_t> node,float64_t* feat, int3
 	return Math::max(0.0,dist-node->data.radius);
 }
 
-float64_t BallTree::min_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder)
+float64_t BallTree::min_dist_flat(index_t node, const float64_t* feat, int32_t dim) const
 {
+	const float64_t* center=m_flat_center.get_column_vector(node);
 	float64_t dist=0;
-	SGVector<float64_t> center1=nodeq->data.center;
-	SGVector<float64_t> center2=noder->data.center;
-	for (int32_t i=0;i<center1.vlen;i++)
-		dist+=add_dim_dist(center1[i]-center2[i]);
-
-	dist=actual_dists(dist);
-	return Math::max(0.0,dist-nodeq->data.radius-noder->data.radius);
-}
-
-float64_t BallTree::max_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder)
-{
-	float64_t dist=0;
-	SGVector<float64_t> center1=nodeq->data.center;
-	SGVector<float64_t> center2=noder->data.center;
-	for (int32_t i=0;i<center1.vlen;i++)
-		dist+=add_dim_dist(center1[i]-center2[i]);
+	for (int32_t i=0;i<dim;i++)
+		dist+=add_dim_dist(center[i]-feat[i]);
 
 	dist=actual_dists(dist);
-	return (dist+nodeq->data.radius+noder->data.radius);
+	return Math::max(0.0,dist-m_flat_radius[node]);
 }
 
 void BallTree::min_max_dist(float64_t* pt, std::shared_ptr<bnode_t> node, float64_t &lower,float64_t &upper, int32_t dim)
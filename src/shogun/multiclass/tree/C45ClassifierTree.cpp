@@ -28,13 +28,18 @@
  * either expressed or implied, of the Shogun Development Team.
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/MulticlassAccuracy.h>
 #include <shogun/lib/View.h>
 #include <shogun/mathematics/Math.h>
-#include <shogun/mathematics/Statistics.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/tree/C45ClassifierTree.h>
 #include <shogun/multiclass/tree/FeatureImportanceTree.h>
+#include <shogun/multiclass/tree/SplitStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 using namespace shogun;
 
@@ -235,68 +240,61 @@ std::shared_ptr<TreeMachineNode<C45TreeNodeData>> C45ClassifierTree::C45train(co
 		return node;
 
 	// else get the feature with the highest informational gain. threshold is used for continuous features only.
+	// the features are evaluated in parallel and compared in order
+	const int32_t num_feats=feats->get_num_features();
+	SGMatrix<float64_t> feat_mat=feats->get_feature_matrix();
+	SGVector<float64_t> label_values=class_labels->get_labels();
+	SGVector<float64_t> gains(num_feats);
+	SGVector<float64_t> thresholds(num_feats);
+	SGVector<float64_t> impurities(num_feats);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num_feats; i++)
+	{
+		SGVector<float64_t> feature_values(num_vecs);
+		for (int32_t k=0; k<num_vecs; k++)
+			feature_values[k]=feat_mat(i,k);
+
+		if (m_nominal[feature_id_vector[i]])
+		{
+			gains[i]=informational_gain_attribute(
+			    feature_values, weights, label_values, impurities[i]);
+			thresholds[i]=0.;
+		}
+		else
+		{
+			gains[i]=continuous_informational_gain(
+			    feature_values, weights, label_values, thresholds[i], impurities[i]);
+		}
+	}
+
 	float64_t max=0;
-	float64_t impurity = 0.0;
 	float64_t max_impurity = 0.0;
 	int32_t best_feature_index=-1;
 	float64_t threshold=0.;
-	for (int32_t i=0; i<feats->get_num_features(); i++)
+	for (int32_t i=0; i<num_feats; i++)
 	{
+		max_impurity = std::max(max_impurity, impurities[i]);
 		if (m_nominal[feature_id_vector[i]])
 		{
-			float64_t gain = informational_gain_attribute(
-			    i, feats, weights, class_labels, impurity);
-			max_impurity = std::max(max_impurity, impurity);
-			if (gain>=max)
+			if (gains[i]>=max)
 			{
-				max=gain;
+				max=gains[i];
 				best_feature_index=i;
 			}
 		}
-		else
+		else if (!std::isnan(thresholds[i]) && gains[i]>max)
 		{
-			SGVector<float64_t> feature_values(num_vecs);
-			float64_t max_value=Math::MIN_REAL_NUMBER;
-			for (int32_t k=0; k<num_vecs; k++)
-			{
-				feature_values[k]=(feats->get_feature_vector(k))[i];
-
-				if (!Math::fequals(feature_values[k],MISSING,0) && feature_values[k]>max_value)
-					max_value=feature_values[k];
-			}
-
-			for (int32_t k=0;k<num_vecs;k++)
-			{
-				if (feature_values[k]!=max_value && !Math::fequals(feature_values[k],MISSING,0))
-				{
-					// form temporary dense features to calculate gain (continuous->nominal conversion)
-					float64_t z=feature_values[k];
-					SGMatrix<float64_t> temp_feat_mat=SGMatrix<float64_t>(1,num_vecs);
-					for (int32_t l=0;l<num_vecs;l++)
-					{
-						if (Math::fequals(feature_values[l],MISSING,0))
-							temp_feat_mat(0,l)=MISSING;
-						else if (feature_values[l]<=z)
-							temp_feat_mat(0,l)=0.;
-						else
-							temp_feat_mat(0,l)=1.;
-					}
-
-					auto temp_feats=std::make_shared<DenseFeatures<float64_t>>(temp_feat_mat);
-					float64_t gain = informational_gain_attribute(
-					    0, temp_feats, weights, class_labels, impurity);
-					max_impurity = std::max(max_impurity, impurity);
-					if (gain>max)
-					{
-						threshold=z;
-						max=gain;
-						best_feature_index=i;
-					}
-				}
-			}
+			threshold=thresholds[i];
+			max=gains[i];
+			best_feature_index=i;
 		}
 	}
 
+	// rounding may leave all gains slightly below zero
+	if (best_feature_index==-1)
+		return node;
+
 	// feature cache for data restoration if feature is continuous
 	SGVector<float64_t> feature_cache(num_vecs);
 
@@ -557,128 +555,150 @@ void C45ClassifierTree::prune_tree_from_current_node(const std::shared_ptr<Dense
 }
 
 float64_t C45ClassifierTree::informational_gain_attribute(
-    int32_t attr_no, const std::shared_ptr<Features>& data,
-    SGVector<float64_t> weights,
-    const std::shared_ptr<MulticlassLabels>& class_labels, float64_t& impurity)
+    const SGVector<float64_t>& attribute_values, const SGVector<float64_t>& weights,
+    const SGVector<float64_t>& labels, float64_t& impurity)
 {
-	require(data,"Data required for information gain calculation");
-	require(data->get_feature_class()==C_DENSE,
-		"Dense data required for information gain calculation");
-
-	float64_t gain=0;
-	auto feats=data->as<DenseFeatures<float64_t>>();
-	int32_t num_vecs=feats->get_num_vectors();
-	SGVector<float64_t> gain_attribute_values;
-	SGVector<float64_t> gain_weights=weights;
-	auto gain_labels=class_labels;
-
+	const int32_t num_vecs=attribute_values.vlen;
 	int32_t num_missing=0;
 	for (int32_t i=0;i<num_vecs;i++)
 	{
-		if (Math::fequals((feats->get_feature_vector(i))[attr_no],MISSING,0))
+		if (std::isnan(attribute_values[i]))
 			num_missing++;
 	}
 
-	if (num_missing==0)
-	{
-		gain_attribute_values=SGVector<float64_t>(num_vecs);
-		for (int32_t i=0; i<num_vecs; i++)
-			gain_attribute_values[i]=(feats->get_feature_vector(i))[attr_no];
-	}
-	else
+	SGVector<float64_t> gain_attribute_values=attribute_values;
+	SGVector<float64_t> gain_weights=weights;
+	SGVector<float64_t> gain_labels=labels;
+	if (num_missing!=0)
 	{
 		gain_attribute_values=SGVector<float64_t>(num_vecs-num_missing);
 		gain_weights=SGVector<float64_t>(num_vecs-num_missing);
-		SGVector<float64_t> label_vector(num_vecs-num_missing);
+		gain_labels=SGVector<float64_t>(num_vecs-num_missing);
 		int32_t index=0;
 		for (int32_t i=0; i<num_vecs; i++)
 		{
-			if (!Math::fequals((feats->get_feature_vector(i))[attr_no],MISSING,0))
+			if (!std::isnan(attribute_values[i]))
 			{
-				gain_attribute_values[index]=(feats->get_feature_vector(i))[attr_no];
+				gain_attribute_values[index]=attribute_values[i];
 				gain_weights[index]=weights[i];
-				label_vector[index++]=class_labels->get_label(i);
+				gain_labels[index++]=labels[i];
 			}
 		}
-
-		num_vecs-=num_missing;
-		gain_labels=std::make_shared<MulticlassLabels>(label_vector);
 	}
 
-	float64_t total_weight=gain_weights.sum(gain_weights.vector,gain_weights.vlen);
-
-	SGVector<float64_t> attr_val_unique=gain_attribute_values.clone();
-	int32_t uniques_num=attr_val_unique.unique(attr_val_unique.vector,attr_val_unique.vlen);
-
-	for (int32_t i=0; i<uniques_num; i++)
-	{
-		//calculate class entropy for the specific attribute_value
-		int32_t attr_count=0;
-		float64_t weight_count=0.;
+	SGMatrix<int32_t> counts;
+	SGMatrix<float64_t> weight_table;
+	SplitStatistics::contingency_table(
+	    gain_attribute_values, gain_labels, gain_weights, counts, weight_table);
 
-		for (int32_t j=0; j<num_vecs; j++)
-		{
-			if (gain_attribute_values[j]==attr_val_unique[i])
-			{
-				weight_count+=gain_weights[j];
-				attr_count++;
-			}
-		}
-
-		SGVector<float64_t> sub_class(attr_count);
-		SGVector<float64_t> sub_weights(attr_count);
-		int32_t count=0;
-
-		for (int32_t j=0; j<num_vecs; j++)
-		{
-			if (gain_attribute_values[j]==attr_val_unique[i])
-			{
-				sub_weights[count]=gain_weights[j];
-				sub_class[count++]=gain_labels->get_label(j);
-			}
-		}
-
-		auto sub_labels=std::make_shared<MulticlassLabels>(sub_class);
-		float64_t sub_entropy=entropy(sub_labels,sub_weights);
-		gain += sub_entropy*weight_count/total_weight;
+	impurity=SplitStatistics::conditional_entropy(weight_table);
+	float64_t gain=SplitStatistics::class_entropy(weight_table)-impurity;
 
+	if (num_missing!=0)
+		gain*=(num_vecs-num_missing-0.f)/(num_vecs-0.f);
 
-	}
+	return gain;
+}
 
-	float64_t data_entropy=entropy(gain_labels,gain_weights);
-	impurity = gain;
-	gain = data_entropy-gain;
+float64_t C45ClassifierTree::continuous_informational_gain(
+    const SGVector<float64_t>& feature_values, const SGVector<float64_t>& weights,
+    const SGVector<float64_t>& labels, float64_t& threshold, float64_t& impurity)
+{
+	const int32_t num_vecs=feature_values.vlen;
+	threshold=Math::NOT_A_NUMBER;
+	impurity=0.;
 
-	if (num_missing!=0)
+	std::vector<int32_t> order;
+	float64_t max_value=Math::MIN_REAL_NUMBER;
+	for (int32_t k=0; k<num_vecs; k++)
 	{
-		gain*=(num_vecs-0.f)/(num_vecs+num_missing-0.f);
+		if (std::isnan(feature_values[k]))
+			continue;
 
+		order.push_back(k);
+		max_value=std::max(max_value, feature_values[k]);
 	}
+	if (order.empty())
+		return 0.;
+
+	std::stable_sort(order.begin(), order.end(),
+		[&feature_values](int32_t a, int32_t b) {
+			return feature_values[a]<feature_values[b];
+		});
+
+	// classes of the vectors with values
+	SGVector<float64_t> present_labels(order.size());
+	for (size_t k=0; k<order.size(); k++)
+		present_labels[k]=labels[order[k]];
+	auto classes=SplitStatistics::distinct_values(present_labels);
+	auto class_index=SplitStatistics::value_indices(present_labels, classes);
+	const index_t num_classes=classes.vlen;
+
+	SGVector<float64_t> total(num_classes);
+	total.zero();
+	for (size_t k=0; k<order.size(); k++)
+		total[class_index[k]]+=weights[order[k]];
+	float64_t total_weight=0.;
+	for (index_t c=0; c<num_classes; c++)
+		total_weight+=total[c];
+
+	const float64_t data_entropy=SplitStatistics::entropy(total.vector, num_classes);
+	const float64_t scale=(order.size()-0.f)/(num_vecs-0.f);
+
+	// sweep the thresholds in ascending order, the vectors up to the
+	// threshold go left. Ties are broken by the first occurrence of the
+	// threshold in the data.
+	SGVector<float64_t> left(num_classes);
+	left.zero();
+	float64_t max_gain=0.;
+	int32_t first_best=num_vecs;
+	for (size_t k=0; k<order.size();)
+	{
+		const float64_t z=feature_values[order[k]];
+		int32_t first=num_vecs;
+		for (; k<order.size() && feature_values[order[k]]==z; k++)
+		{
+			left[class_index[k]]+=weights[order[k]];
+			first=std::min(first, order[k]);
+		}
 
-	return gain;
-}
+		if (z==max_value)
+			continue;
 
-float64_t C45ClassifierTree::entropy(const std::shared_ptr<MulticlassLabels>& labels, SGVector<float64_t> weights)
-{
-	auto unique_labels = labels->get_unique_labels();
-	auto labels_vector = labels->get_labels();
-	SGVector<float64_t> log_ratios(unique_labels.size());
-	float64_t total_weight=weights.sum(weights.vector,weights.vlen);
+		// nothing goes right if no value exceeds max_value
+		if (k==order.size())
+		{
+			impurity=std::max(impurity, data_entropy);
+			continue;
+		}
 
-	for (int32_t i = 0; i < unique_labels.size(); i++)
-	{
-		float64_t weight_count=0.;
-		for (int32_t j = 0; j < labels_vector.vlen; j++)
+		float64_t left_weight=0.;
+		float64_t left_sum=0.;
+		float64_t right_sum=0.;
+		for (index_t c=0; c<num_classes; c++)
 		{
-			if (unique_labels[i] == labels_vector[j])
-			{
-				weight_count+=weights[j];
-			}
+			left_weight+=left[c];
+			left_sum+=SplitStatistics::xlogx(left[c]);
+			right_sum+=SplitStatistics::xlogx(total[c]-left[c]);
+		}
+		const float64_t right_weight=total_weight-left_weight;
+		const float64_t cond_entropy=
+			(std::max(SplitStatistics::xlogx(left_weight)-left_sum, 0.0)+
+			 std::max(SplitStatistics::xlogx(right_weight)-right_sum, 0.0))/
+			total_weight;
+		impurity=std::max(impurity, cond_entropy);
+
+		const float64_t gain=(data_entropy-cond_entropy)*scale;
+		if (std::isnan(threshold) || gain>max_gain ||
+			(gain==max_gain && first<first_best))
+		{
+			threshold=z;
+			max_gain=gain;
+			first_best=first;
 		}
-		log_ratios[i] = std::log(weight_count / total_weight);
 	}
 
-	return Statistics::entropy(log_ratios.vector,log_ratios.vlen);
+	return max_gain;
 }
 
 std::shared_ptr<MulticlassLabels> C45ClassifierTree::apply_multiclass_from_current_node(const std::shared_ptr<DenseFeatures<float64_t>>& feats,
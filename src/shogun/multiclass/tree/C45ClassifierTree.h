@@ -184,25 +184,33 @@ private:
 
 	/** informational gain attribute for selecting best feature at each node of C4.5 Tree
 	 *
-	 * @param attr_no index to the chosen feature in data matrix supplied
-	 * @param data data matrix
+	 * @param attribute_values values of the chosen feature
 	 * @param weights weights of data points in data matrix
-	 * @param class_labels classes to which corresponding data vectors belong
+	 * @param labels classes to which corresponding data vectors belong
+	 * @param impurity entropy of the classes within the values of the
+	 * feature
 	 * @return informational gain of the chosen feature
 	 */
 	float64_t informational_gain_attribute(
-		int32_t attr_no, const std::shared_ptr<Features>& data,
-		SGVector<float64_t> weights,
-		const std::shared_ptr<MulticlassLabels>& class_labels,
+		const SGVector<float64_t>& attribute_values,
+		const SGVector<float64_t>& weights, const SGVector<float64_t>& labels,
 		float64_t& impurity);
 
-	/** computes entropy (aka randomness) in data
+	/** best informational gain of the binary splits of a continuous
+	 * feature, found in one pass over the sorted values
 	 *
-	 * @param labels labels of parameters chosen
-	 * @param weights weights associated with each of the labels
-	 * @return entropy
-	 */
-	float64_t entropy(const std::shared_ptr<MulticlassLabels>& labels, SGVector<float64_t> weights);
+	 * @param feature_values values of the chosen feature
+	 * @param weights weights of data points in data matrix
+	 * @param labels classes to which corresponding data vectors belong
+	 * @param threshold threshold of the best split, NaN if the feature
+	 * can not be split
+	 * @param impurity largest entropy of the classes within the splits
+	 * @return informational gain of the best split
+	 */
+	float64_t continuous_informational_gain(
+		const SGVector<float64_t>& feature_values,
+		const SGVector<float64_t>& weights, const SGVector<float64_t>& labels,
+		float64_t& threshold, float64_t& impurity);
 
 	/** uses current subtree to classify data
 	 *
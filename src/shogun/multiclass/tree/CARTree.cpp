@@ -30,6 +30,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <numeric>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/View.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
@@ -174,6 +176,37 @@ void CARTree::prune_using_test_dataset(const std::shared_ptr<DenseFeatures<float
 	if (root == nullptr)
 		error("{} element is NULL",min_index);
 	this->set_root(root);
+	compile();
+}
+
+void CARTree::compile()
+{
+	m_flat_tree.clear();
+	m_flat_root=nullptr;
+	if (!m_root)
+		return;
+
+	m_flat_root=m_root->as<bnode_t>();
+	m_flat_tree.add_tree(m_flat_root, m_nominal);
+}
+
+SGMatrix<float64_t> CARTree::get_shap_values(
+    const std::shared_ptr<Features>& data, const std::shared_ptr<Features>& background)
+{
+	require(m_root, "Tree is not trained");
+	require(data, "No data provided");
+	if (m_flat_root!=m_root)
+		compile();
+
+	SGVector<float64_t> tree_weights(1);
+	tree_weights[0]=1;
+	SGMatrix<float64_t> background_mat;
+	if (background)
+		background_mat=background->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+
+	return m_flat_tree.shap_values(
+		data->as<DenseFeatures<float64_t>>()->get_feature_matrix(),
+		tree_weights, 1, background_mat);
 }
 
 void CARTree::set_weights(SGVector<float64_t> w)
@@ -245,6 +278,19 @@ void CARTree::set_label_epsilon(float64_t ep)
 	m_label_epsilon=ep;
 }
 
+int32_t CARTree::get_num_bins() const
+{
+	return m_num_bins;
+}
+
+void CARTree::set_num_bins(int32_t num_bins)
+{
+	require(num_bins==0 || (num_bins>1 && num_bins<256),
+		"Number of bins should be 0 or in [2, 255]. Supplied value is {}",
+		num_bins);
+	m_num_bins=num_bins;
+}
+
 bool CARTree::types_set()
 {
 	return m_nominal.size() != 0;
@@ -293,7 +339,38 @@ bool CARTree::train_machine(std::shared_ptr<Features> data)
 	}
 
 	auto dense_labels = m_labels->as<DenseLabels>();
-	set_root(CARTtrain(dense_features,m_weights,dense_labels,0));
+	if (m_num_bins>0)
+	{
+		if (!m_quantized)
+		{
+			// the rows of the quantized features must be the indices of
+			// the vectors in their storage
+			if (dense_features->get_subset_stack()->has_subsets())
+				dense_features=std::make_shared<DenseFeatures<float64_t>>(
+					dense_features->get_feature_matrix());
+			quantize_features(dense_features, m_binned_features, m_bin_thresholds);
+		}
+		require(m_binned_features.num_cols==num_features &&
+			m_bin_thresholds.num_rows==m_num_bins,
+			"Quantized features do not match the data and number of bins");
+
+		if (m_mode==PT_MULTICLASS)
+		{
+			index_t num_classes;
+			auto classes=get_unique_labels(dense_labels->get_labels(), num_classes);
+			m_histogram_classes=SGVector<float64_t>(num_classes);
+			sg_memcpy(m_histogram_classes.vector, classes.vector,
+				num_classes*sizeof(float64_t));
+		}
+	}
+
+	// the children of large nodes are grown as tasks of one team, the
+	// region is inactive if the tree is trained by a parallel ensemble
+	std::shared_ptr<bnode_t> root;
+	#pragma omp parallel num_threads(env()->get_num_threads())
+	#pragma omp single
+	root=CARTtrain(dense_features,m_weights,dense_labels,0);
+	set_root(root);
 
 	if (m_apply_cv_pruning)
 	{
@@ -304,6 +381,13 @@ bool CARTree::train_machine(std::shared_ptr<Features> data)
 	{
 		compute_feature_importance(num_features, m_root);
 	}
+	compile();
+
+	if (!m_quantized)
+	{
+		m_binned_features=SGMatrix<uint8_t>();
+		m_bin_thresholds=SGMatrix<float64_t>();
+	}
 	return true;
 }
 
@@ -342,16 +426,88 @@ void CARTree::pre_sort_features(const std::shared_ptr<Features>& data, SGMatrix<
 
 }
 
-std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::shared_ptr<DenseFeatures<float64_t>> data, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels, int32_t level)
+void CARTree::set_quantized_features(SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_thresholds)
+{
+	m_quantized=true;
+	m_binned_features=binned_feats;
+	m_bin_thresholds=bin_thresholds;
+}
+
+void CARTree::quantize_features(const std::shared_ptr<Features>& data, SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_thresholds) const
+{
+	require(m_num_bins>0, "Number of bins has to be set to quantize features");
+	SGMatrix<float64_t> mat=(data)->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	binned_feats=SGMatrix<uint8_t>(mat.num_cols, mat.num_rows);
+	bin_thresholds=SGMatrix<float64_t>(m_num_bins, mat.num_rows);
+	bin_thresholds.set_const(MISSING);
+	index_t nominal_overflow=-1;
+
+	#pragma omp parallel for
+	for (index_t i=0; i<mat.num_rows; i++)
+	{
+		std::vector<float64_t> values;
+		values.reserve(mat.num_cols);
+		for (index_t j=0; j<mat.num_cols; j++)
+		{
+			if (mat(i,j)!=MISSING)
+				values.push_back(mat(i,j));
+		}
+		std::sort(values.begin(), values.end());
+
+		std::vector<float64_t> distinct(values.begin(), values.end());
+		distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+		std::vector<float64_t> thresholds;
+		if ((index_t)distinct.size()<=m_num_bins)
+			thresholds=distinct;
+		else
+		{
+			if (m_nominal.vlen && m_nominal[i])
+			{
+				#pragma omp critical
+				nominal_overflow=i;
+			}
+
+			// quantiles, so that the bins hold about the same number of vectors
+			for (index_t b=1; b<=m_num_bins; b++)
+			{
+				const float64_t t=values[(int64_t)b*values.size()/m_num_bins-1];
+				if (thresholds.empty() || t>thresholds.back())
+					thresholds.push_back(t);
+			}
+		}
+		std::copy(thresholds.begin(), thresholds.end(), bin_thresholds.get_column_vector(i));
+
+		// smallest bin whose largest value is not below the value
+		uint8_t* bins=binned_feats.get_column_vector(i);
+		for (index_t j=0; j<mat.num_cols; j++)
+		{
+			if (mat(i,j)==MISSING)
+				bins[j]=m_num_bins;
+			else
+				bins[j]=std::lower_bound(thresholds.begin(), thresholds.end(), mat(i,j))-thresholds.begin();
+		}
+	}
+
+	require(nominal_overflow==-1,
+		"Nominal feature {} has more values than the number of bins ({})",
+		nominal_overflow, m_num_bins);
+}
+
+std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::shared_ptr<DenseFeatures<float64_t>> data, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels, int32_t level, SGVector<float64_t> node_histogram)
 {
 	require(labels,"labels have to be supplied");
 	require(data,"data matrix has to be supplied");
 
 	auto node=std::make_shared<bnode_t>();
 	auto labels_vec = labels->get_labels();
-	auto mat = data->get_feature_matrix();
-	auto num_feats=mat.num_rows;
-	auto num_vecs=mat.num_cols;
+	auto num_feats=data->get_num_features();
+	auto num_vecs=data->get_num_vectors();
+	// histogram and pre-sorted split finding need the vectors only for
+	// surrogate splits
+	SGMatrix<float64_t> mat;
+	if (m_num_bins==0 && !m_pre_sort)
+		mat=data->get_feature_matrix();
 
 	// calculate node label
 	switch(m_mode)
@@ -413,6 +569,16 @@ std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::
 	}
 	float64_t node_impurity = 0.0;
 	// check stopping rules
+	// case 0 : training was stopped, e.g. its budget expired, the nodes
+	// grown so far are kept as leaves
+	if (cancel_computation())
+	{
+		node->data.num_leaves=1;
+		node->data.weight_minus_branch=node->data.weight_minus_node;
+		node->data.impurity = node_impurity;
+		return node;
+	}
+
 	// case 1 : max tree depth reached if max_depth set
 	if ((m_max_depth>0) && (level==m_max_depth))
 	{
@@ -444,17 +610,24 @@ std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::
 	int32_t best_attribute;
 
 	SGVector<index_t> indices(num_vecs);
-	if (m_pre_sort)
+	if (m_pre_sort || m_num_bins>0)
 	{
 		auto subset_stack = data->get_subset_stack();
 		if (subset_stack->has_subsets())
 			indices=(subset_stack->get_last_subset())->get_subset_idx();
 		else
 			linalg::range_fill(indices);
+	}
+
+	if (m_num_bins>0)
+		best_attribute = compute_best_histogram_attribute(
+		    weights, labels, left, right, left_final, num_missing_final,
+		    c_left, c_right, node_impurity, node_histogram,
+		    get_random_subset_size(num_feats), indices);
+	else if (m_pre_sort)
 		best_attribute = compute_best_attribute(
 		    m_sorted_features, weights, labels, left, right, left_final,
 		    num_missing_final, c_left, c_right, node_impurity, 0, indices);
-	}
 	else
 		best_attribute = compute_best_attribute(
 		    mat, weights, labels, left, right, left_final, num_missing_final,
@@ -475,6 +648,9 @@ std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::
 
 	if (num_missing_final>0)
 	{
+		if (!mat.matrix)
+			mat=data->get_feature_matrix();
+
 		SGVector<bool> is_left_final(num_vecs-num_missing_final);
 		int32_t ilf=0;
 		for (int32_t i=0;i<num_vecs;++i)
@@ -508,17 +684,53 @@ std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::
 		}
 	}
 
+	// histograms of the smaller child, the larger child's are the difference
+	SGVector<float64_t> histogram_left;
+	SGVector<float64_t> histogram_right;
+	if (node_histogram.vlen)
+	{
+		const auto& subset_small=(l<=r) ? subsetl : subsetr;
+		SGVector<index_t> rows(subset_small.vlen);
+		SGVector<float64_t> weights_small(subset_small.vlen);
+		SGVector<float64_t> labels_small(subset_small.vlen);
+		for (index_t k=0; k<subset_small.vlen; ++k)
+		{
+			rows[k]=indices[subset_small[k]];
+			weights_small[k]=weights[subset_small[k]];
+			labels_small[k]=labels_vec[subset_small[k]];
+		}
+		SGVector<index_t> all_feats(num_feats);
+		linalg::range_fill(all_feats);
+
+		auto histogram_small=build_histogram(rows, weights_small, labels_small, all_feats);
+		for (index_t k=0; k<node_histogram.vlen; ++k)
+			node_histogram[k]-=histogram_small[k];
+
+		histogram_left=(l<=r) ? histogram_small : node_histogram;
+		histogram_right=(l<=r) ? node_histogram : histogram_small;
+	}
+
+	// the children only read the shared training state, so the left child
+	// of a large node is grown as a task while this thread grows the right
+	// one. Random feature subsets draw from the shared PRNG and are grown
+	// one after the other to stay reproducible.
+	const bool grow_as_task=num_vecs>=task_threshold &&
+		get_random_subset_size(num_feats)==0;
+
 	// left child
-	auto feats_train = view(data, subsetl);
-	auto labels_train = view(labels, subsetl);
-	auto left_child =
-	    CARTtrain(feats_train, weightsl, labels_train, level + 1);
+	auto feats_left = view(data, subsetl);
+	auto labels_left = view(labels, subsetl);
+	std::shared_ptr<bnode_t> left_child;
+	#pragma omp task shared(left_child) if(grow_as_task)
+	left_child=CARTtrain(
+	    feats_left, weightsl, labels_left, level + 1, histogram_left);
 
 	// right child
-	feats_train = view(data, subsetr);
-	labels_train = view(labels, subsetr);
-	auto right_child =
-	    CARTtrain(feats_train, weightsr, labels_train, level + 1);
+	auto feats_train = view(data, subsetr);
+	auto labels_train = view(labels, subsetr);
+	auto right_child = CARTtrain(
+	    feats_train, weightsr, labels_train, level + 1, histogram_right);
+	#pragma omp taskwait
 
 	// set node parameters
 	node->data.attribute_id=best_attribute;
@@ -564,6 +776,15 @@ index_t CARTree::compute_best_attribute(
     float64_t& impurity, index_t subset_size,
     const SGVector<index_t>& active_indices)
 {
+	if (m_num_bins>0)
+	{
+		SGVector<float64_t> node_histogram;
+		return compute_best_histogram_attribute(
+		    weights, labels, left, right, is_left_final, num_missing_final,
+		    count_left, count_right, impurity, node_histogram, subset_size,
+		    active_indices);
+	}
+
 	auto labels_vec=labels->get_labels();
 	auto num_vecs=labels->get_num_labels();
 	auto num_feats = (m_pre_sort) ? mat.num_cols : mat.num_rows;
@@ -604,10 +825,6 @@ index_t CARTree::compute_best_attribute(
 		random::shuffle(idx, m_prng);
 	}
 
-	float64_t max_gain=MIN_SPLIT_GAIN;
-	float64_t max_impurity = MIN_SPLIT_GAIN;
-	index_t best_attribute=-1;
-	float64_t best_threshold=0;
 
 	SGVector<int64_t> indices_mask;
 	SGVector<index_t> count_indices(mat.num_rows);
@@ -628,8 +845,27 @@ index_t CARTree::compute_best_attribute(
 		}
 	}
 
+	// best split of every attribute, the attributes are evaluated
+	// concurrently and the best split is chosen in attribute order
+	SGVector<float64_t> gains(num_feats);
+	SGVector<float64_t> impurities(num_feats);
+	SGVector<float64_t> thresholds(num_feats);
+	SGVector<index_t> num_missing(num_feats);
+	std::vector<SGVector<bool>> nominal_left(num_feats);
+	std::vector<std::vector<float64_t>> transit_left(num_feats);
+	std::vector<std::vector<float64_t>> transit_right(num_feats);
+	linalg::set_const(gains, MIN_SPLIT_GAIN);
+	impurities.zero();
+
+	if (m_mode!=PT_MULTICLASS && m_mode!=PT_REGRESSION)
+		error("Undefined problem statement");
+
+	#pragma omp taskloop
 	for (index_t i=0;i<num_feats;++i)
 	{
+		// weights excluding the vectors with missing values of attribute i
+		SGVector<float64_t> wclasses=total_wclasses.clone();
+		float64_t max_impurity=MIN_SPLIT_GAIN;
 		SGVector<float64_t> feats(num_vecs);
 		SGVector<index_t> sorted_args(num_vecs);
 		SGVector<index_t> temp_count_indices(count_indices.size());
@@ -670,7 +906,7 @@ index_t CARTree::compute_best_attribute(
 		// number of non-missing vecs
 		while (feats[n_nm_vecs-1] == MISSING)
 		{
-			total_wclasses[simple_labels[sorted_args[n_nm_vecs-1]]]-=weights[sorted_args[n_nm_vecs-1]];
+			wclasses[simple_labels[sorted_args[n_nm_vecs-1]]]-=weights[sorted_args[n_nm_vecs-1]];
 			--n_nm_vecs;
 		}
 
@@ -745,39 +981,33 @@ index_t CARTree::compute_best_attribute(
 				switch(m_mode)
 				{
 					case PT_MULTICLASS:
-					    g = gain(wleft, wright, total_wclasses, max_impurity);
-					    impurity = std::max(max_impurity, impurity);
+					    g = gain(wleft, wright, wclasses, max_impurity);
+					    impurities[i] = std::max(max_impurity, impurities[i]);
 					    break;
 				    case PT_REGRESSION:
 					    g = gain(
-					        wleft, wright, total_wclasses, ulabels,
+					        wleft, wright, wclasses, ulabels,
 					        max_impurity);
-					    impurity = std::max(max_impurity, impurity);
+					    impurities[i] = std::max(max_impurity, impurities[i]);
 					    break;
 				    default:
 					    error("Undefined problem statement");
 				}
 
-				if (g>max_gain)
+				if (g>gains[i])
 				{
-					best_attribute=idx[i];
-					max_gain=g;
-					sg_memcpy(is_left_final.vector,is_left.vector,is_left.vlen*sizeof(bool));
-					num_missing_final=num_vecs-n_nm_vecs;
-
-					count_left = std::count(feats_left.begin(), feats_left.end(), true);
-					count_right = c+1-count_left;
-
-					index_t l=0;
-					index_t r=0;
-					if (right.vlen < count_right)
-						right.resize_vector(count_right);
+					gains[i]=g;
+					nominal_left[i]=is_left.clone();
+					num_missing[i]=num_vecs-n_nm_vecs;
+
+					transit_left[i].clear();
+					transit_right[i].clear();
 					for (index_t w = 0; w < feats_left.vlen; ++w)
 					{
 						if (feats_left[w])
-							left[l++]=ufeats[w];
+							transit_left[i].push_back(ufeats[w]);
 						else
-							right[r++]=ufeats[w];
+							transit_right[i].push_back(ufeats[w]);
 					}
 				}
 			}
@@ -785,7 +1015,7 @@ index_t CARTree::compute_best_attribute(
 		else
 		{
 			// O(N)
-			SGVector<float64_t> right_wclasses=total_wclasses.clone();
+			SGVector<float64_t> right_wclasses=wclasses.clone();
 			SGVector<float64_t> left_wclasses(n_ulabels);
 			linalg::zero(left_wclasses);
 
@@ -807,26 +1037,25 @@ index_t CARTree::compute_best_attribute(
 				if (m_mode == PT_MULTICLASS)
 				{
 					g = gain(
-					    left_wclasses, right_wclasses, total_wclasses,
+					    left_wclasses, right_wclasses, wclasses,
 					    max_impurity);
-					impurity = std::max(max_impurity, impurity);
+					impurities[i] = std::max(max_impurity, impurities[i]);
 				}
 				else if (m_mode == PT_REGRESSION)
 				{
 					g = gain(
-					    left_wclasses, right_wclasses, total_wclasses, ulabels,
+					    left_wclasses, right_wclasses, wclasses, ulabels,
 					    max_impurity);
-					impurity = std::max(max_impurity, impurity);
+					impurities[i] = std::max(max_impurity, impurities[i]);
 				}
 				else
 					error("Undefined problem statement");
 
-				if (g>max_gain)
+				if (g>gains[i])
 				{
-					max_gain=g;
-					best_attribute=idx[i];
-					best_threshold=z;
-					num_missing_final=num_vecs-n_nm_vecs;
+					gains[i]=g;
+					thresholds[i]=z;
+					num_missing[i]=num_vecs-n_nm_vecs;
 				}
 
 				z=feats[j];
@@ -836,12 +1065,32 @@ index_t CARTree::compute_best_attribute(
 				left_wclasses[simple_labels[sorted_args[j]]]+=weights[sorted_args[j]];
 			}
 		}
+	}
 
-		// restore total_wclasses
-		while (n_nm_vecs<feats.vlen)
+	float64_t max_gain=MIN_SPLIT_GAIN;
+	index_t best_attribute=-1;
+	float64_t best_threshold=0;
+	for (index_t i=0;i<num_feats;++i)
+	{
+		impurity=std::max(impurities[i], impurity);
+		if (gains[i]>max_gain)
 		{
-			total_wclasses[simple_labels[sorted_args[n_nm_vecs-1]]]+=weights[sorted_args[n_nm_vecs-1]];
-			++n_nm_vecs;
+			max_gain=gains[i];
+			best_attribute=idx[i];
+			best_threshold=thresholds[i];
+			num_missing_final=num_missing[i];
+			if (m_nominal[idx[i]])
+			{
+				sg_memcpy(is_left_final.vector, nominal_left[i].vector, nominal_left[i].vlen*sizeof(bool));
+				count_left=transit_left[i].size();
+				count_right=transit_right[i].size();
+				if (left.vlen < count_left)
+					left.resize_vector(count_left);
+				if (right.vlen < count_right)
+					right.resize_vector(count_right);
+				std::copy(transit_left[i].begin(), transit_left[i].end(), left.vector);
+				std::copy(transit_right[i].begin(), transit_right[i].end(), right.vector);
+			}
 		}
 	}
 
@@ -886,6 +1135,313 @@ index_t CARTree::compute_best_attribute(
 	return best_attribute;
 }
 
+index_t CARTree::histogram_width() const
+{
+	return (m_mode==PT_REGRESSION) ? 3 : m_histogram_classes.vlen;
+}
+
+SGVector<float64_t> CARTree::build_histogram(
+    const SGVector<index_t>& rows, const SGVector<float64_t>& weights,
+    const SGVector<float64_t>& labels, const SGVector<index_t>& features) const
+{
+	const index_t width=histogram_width();
+	const index_t stride=(m_num_bins+1)*width;
+	SGVector<float64_t> histogram(features.vlen*stride);
+	histogram.zero();
+
+	SGVector<index_t> classes;
+	if (m_mode!=PT_REGRESSION)
+	{
+		classes=SGVector<index_t>(rows.vlen);
+		for (index_t j=0; j<rows.vlen; ++j)
+		{
+			classes[j]=std::lower_bound(m_histogram_classes.begin(),
+				m_histogram_classes.end(), labels[j])-m_histogram_classes.begin();
+		}
+	}
+
+	#pragma omp taskloop
+	for (index_t i=0; i<features.vlen; ++i)
+	{
+		const uint8_t* bins=m_binned_features.get_column_vector(features[i]);
+		float64_t* h=histogram.vector+i*stride;
+		if (m_mode==PT_REGRESSION)
+		{
+			for (index_t j=0; j<rows.vlen; ++j)
+			{
+				float64_t* moments=h+bins[rows[j]]*width;
+				moments[0]+=weights[j];
+				moments[1]+=weights[j]*labels[j];
+				moments[2]+=weights[j]*labels[j]*labels[j];
+			}
+		}
+		else
+		{
+			for (index_t j=0; j<rows.vlen; ++j)
+				h[bins[rows[j]]*width+classes[j]]+=weights[j];
+		}
+	}
+
+	return histogram;
+}
+
+/* gini index of class weights or variance of label moments, the weight is
+ * returned in total_weight */
+static float64_t histogram_impurity(
+    const float64_t* h, index_t width, bool regression, float64_t& total_weight)
+{
+	if (regression)
+	{
+		total_weight=h[0];
+		if (total_weight<=0)
+			return 0;
+		const float64_t mean=h[1]/total_weight;
+		return std::max(h[2]/total_weight-mean*mean, 0.0);
+	}
+
+	total_weight=0;
+	float64_t sq_sum=0;
+	for (index_t k=0; k<width; ++k)
+	{
+		total_weight+=h[k];
+		sq_sum+=h[k]*h[k];
+	}
+	if (total_weight<=0)
+		return 0;
+	return 1.0-sq_sum/(total_weight*total_weight);
+}
+
+/* gain of splitting the weights total into left and total-left */
+static float64_t histogram_gain(
+    const float64_t* left, const float64_t* total, float64_t node_impurity,
+    float64_t total_weight, index_t width, bool regression)
+{
+	std::vector<float64_t> right(width);
+	for (index_t k=0; k<width; ++k)
+		right[k]=total[k]-left[k];
+
+	float64_t left_weight;
+	float64_t right_weight;
+	const float64_t left_impurity=histogram_impurity(left, width, regression, left_weight);
+	const float64_t right_impurity=histogram_impurity(right.data(), width, regression, right_weight);
+	return node_impurity-left_impurity*(left_weight/total_weight)-right_impurity*(right_weight/total_weight);
+}
+
+index_t CARTree::compute_best_histogram_attribute(
+    const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels,
+    SGVector<float64_t>& left, SGVector<float64_t>& right,
+    SGVector<bool>& is_left_final, index_t& num_missing_final,
+    index_t& count_left, index_t& count_right, float64_t& impurity,
+    SGVector<float64_t>& node_histogram, index_t subset_size,
+    const SGVector<index_t>& active_indices)
+{
+	auto labels_vec=labels->get_labels();
+	auto num_vecs=labels->get_num_labels();
+	auto num_feats=m_binned_features.num_cols;
+
+	index_t n_ulabels;
+	get_unique_labels(labels_vec, n_ulabels);
+
+	// if all labels same early stop
+	if (n_ulabels==1)
+		return -1;
+
+	SGVector<index_t> idx(num_feats);
+	linalg::range_fill(idx);
+	if (subset_size)
+	{
+		num_feats=subset_size;
+		random::shuffle(idx, m_prng);
+	}
+
+	// histograms of all features are kept for the children, histograms of
+	// a random subset of the features are computed for this node only
+	const index_t width=histogram_width();
+	const index_t stride=(m_num_bins+1)*width;
+	const bool regression=(m_mode==PT_REGRESSION);
+	auto histogram=node_histogram;
+	bool partial=false;
+	if (!histogram.vlen)
+	{
+		if (subset_size)
+		{
+			SGVector<index_t> feats(num_feats);
+			sg_memcpy(feats.vector, idx.vector, num_feats*sizeof(index_t));
+			histogram=build_histogram(active_indices, weights, labels_vec, feats);
+			partial=true;
+		}
+		else
+		{
+			histogram=build_histogram(active_indices, weights, labels_vec, idx);
+			node_histogram=histogram;
+		}
+	}
+
+	SGVector<float64_t> gains(num_feats);
+	SGVector<float64_t> node_impurities(num_feats);
+	SGVector<index_t> split_bins(num_feats);
+	SGMatrix<bool> left_bins(m_num_bins, num_feats);
+	node_impurities.zero();
+	linalg::set_const(split_bins, index_t(-1));
+	index_t nominal_overflow=-1;
+
+	#pragma omp taskloop
+	for (index_t i=0; i<num_feats; ++i)
+	{
+		const float64_t* h=histogram.vector+(partial ? i : idx[i])*stride;
+		gains[i]=MIN_SPLIT_GAIN;
+
+		// weights of the vectors with non-missing values
+		std::vector<float64_t> total(width, 0.0);
+		std::vector<index_t> present;
+		for (index_t b=0; b<m_num_bins; ++b)
+		{
+			float64_t bin_weight=0;
+			for (index_t k=0; k<width; ++k)
+				total[k]+=h[b*width+k];
+			if (regression)
+				bin_weight=h[b*width];
+			else
+				bin_weight=std::accumulate(h+b*width, h+(b+1)*width, 0.0);
+			if (bin_weight>0)
+				present.push_back(b);
+		}
+
+		// if only one unique value - it cannot be used to split
+		if (present.size()<2)
+			continue;
+
+		float64_t total_weight;
+		node_impurities[i]=histogram_impurity(total.data(), width, regression, total_weight);
+
+		std::vector<float64_t> wleft(width);
+		if (m_nominal[idx[i]])
+		{
+			// test all 2^(I-1)-1 possible divisions of the values, the
+			// last value always goes right
+			const index_t c=present.size()-1;
+			if (c>=31)
+			{
+				#pragma omp critical
+				nominal_overflow=idx[i];
+				continue;
+			}
+			for (index_t k=1; k<(index_t(1)<<c); ++k)
+			{
+				std::fill(wleft.begin(), wleft.end(), 0.0);
+				for (index_t p=0; p<c; ++p)
+				{
+					if ((k>>p)&1)
+					{
+						for (index_t q=0; q<width; ++q)
+							wleft[q]+=h[present[p]*width+q];
+					}
+				}
+
+				const float64_t g=histogram_gain(wleft.data(), total.data(),
+					node_impurities[i], total_weight, width, regression);
+				if (g>gains[i])
+				{
+					gains[i]=g;
+					split_bins[i]=k;
+					for (index_t b=0; b<m_num_bins; ++b)
+						left_bins(b,i)=false;
+					for (index_t p=0; p<c; ++p)
+						left_bins(present[p],i)=(k>>p)&1;
+				}
+			}
+		}
+		else
+		{
+			// bins up to split_bins[i] go left
+			std::fill(wleft.begin(), wleft.end(), 0.0);
+			for (size_t p=0; p+1<present.size(); ++p)
+			{
+				for (index_t q=0; q<width; ++q)
+					wleft[q]+=h[present[p]*width+q];
+
+				const float64_t g=histogram_gain(wleft.data(), total.data(),
+					node_impurities[i], total_weight, width, regression);
+				if (g>gains[i])
+				{
+					gains[i]=g;
+					split_bins[i]=present[p];
+				}
+			}
+		}
+	}
+
+	require(nominal_overflow==-1,
+		"Nominal feature {} has too many values in a node to test all divisions",
+		nominal_overflow);
+
+	float64_t max_gain=MIN_SPLIT_GAIN;
+	index_t best=-1;
+	for (index_t i=0; i<num_feats; ++i)
+	{
+		impurity=std::max(impurity, node_impurities[i]);
+		if (split_bins[i]>=0 && gains[i]>max_gain)
+		{
+			max_gain=gains[i];
+			best=i;
+		}
+	}
+
+	if (best==-1)
+		return -1;
+
+	const index_t best_attribute=idx[best];
+	const uint8_t* bins=m_binned_features.get_column_vector(best_attribute);
+	num_missing_final=0;
+	for (index_t j=0; j<num_vecs; ++j)
+	{
+		const uint8_t bin=bins[active_indices[j]];
+		if (bin==m_num_bins)
+		{
+			is_left_final[j]=false;
+			++num_missing_final;
+		}
+		else if (m_nominal[best_attribute])
+			is_left_final[j]=left_bins(bin,best);
+		else
+			is_left_final[j]=(bin<=split_bins[best]);
+	}
+
+	if (m_nominal[best_attribute])
+	{
+		const float64_t* h=histogram.vector+(partial ? best : best_attribute)*stride;
+		std::vector<float64_t> values_left;
+		std::vector<float64_t> values_right;
+		for (index_t b=0; b<m_num_bins; ++b)
+		{
+			if (std::accumulate(h+b*width, h+(b+1)*width, 0.0)<=0)
+				continue;
+			if (left_bins(b,best))
+				values_left.push_back(m_bin_thresholds(b,best_attribute));
+			else
+				values_right.push_back(m_bin_thresholds(b,best_attribute));
+		}
+
+		count_left=values_left.size();
+		count_right=values_right.size();
+		if (left.vlen<count_left)
+			left.resize_vector(count_left);
+		if (right.vlen<count_right)
+			right.resize_vector(count_right);
+		std::copy(values_left.begin(), values_left.end(), left.vector);
+		std::copy(values_right.begin(), values_right.end(), right.vector);
+	}
+	else
+	{
+		left[0]=m_bin_thresholds(split_bins[best],best_attribute);
+		right[0]=left[0];
+		count_left=1;
+		count_right=1;
+	}
+
+	return best_attribute;
+}
+
 SGVector<bool> CARTree::surrogate_split(SGMatrix<float64_t> m,SGVector<float64_t> weights, SGVector<bool> nm_left, int32_t attr) const
 {
 	// return vector - left/right belongingness
@@ -1146,62 +1702,70 @@ std::shared_ptr<Labels> CARTree::apply_from_current_node(const std::shared_ptr<D
 	require(num_vecs>0, "No data provided in apply");
 
 	SGVector<float64_t> labels(num_vecs);
-	for (index_t i=0;i<num_vecs;++i)
+	if (current==m_flat_root && m_flat_tree.get_num_trees())
 	{
-		auto sample=feats->get_feature_vector(i);
-		auto node=current;
-
-
-		// until leaf is reached
-		while(node->data.num_leaves!=1)
+		auto flat_labels=m_flat_tree.apply(feats->get_feature_matrix());
+		sg_memcpy(labels.vector, flat_labels.matrix, num_vecs*sizeof(float64_t));
+	}
+	else
+	{
+		for (index_t i=0;i<num_vecs;++i)
 		{
-			auto leftchild=node->left();
+			auto sample=feats->get_feature_vector(i);
+			auto node=current;
+
 
-			if (m_nominal[node->data.attribute_id])
+			// until leaf is reached
+			while(node->data.num_leaves!=1)
 			{
-				SGVector<float64_t> comp=leftchild->data.transit_into_values;
-				bool flag=false;
-				for (index_t k=0;k<comp.vlen;++k)
+				auto leftchild=node->left();
+
+				if (m_nominal[node->data.attribute_id])
 				{
-					if (comp[k]==sample[node->data.attribute_id])
+					SGVector<float64_t> comp=leftchild->data.transit_into_values;
+					bool flag=false;
+					for (index_t k=0;k<comp.vlen;++k)
 					{
-						flag=true;
-						break;
+						if (comp[k]==sample[node->data.attribute_id])
+						{
+							flag=true;
+							break;
+						}
 					}
-				}
 
-				if (flag)
-				{
+					if (flag)
+					{
 
-					node=leftchild;
+						node=leftchild;
 
+					}
+					else
+					{
+
+						node=node->right();
+					}
 				}
 				else
 				{
+					if (sample[node->data.attribute_id]<=leftchild->data.transit_into_values[0])
+					{
 
-					node=node->right();
-				}
-			}
-			else
-			{
-				if (sample[node->data.attribute_id]<=leftchild->data.transit_into_values[0])
-				{
+						node=leftchild;
 
-					node=leftchild;
+					}
+					else
+					{
 
+						node=node->right();
+					}
 				}
-				else
-				{
 
-					node=node->right();
-				}
+
 			}
 
+			labels[i]=node->data.node_label;
 
 		}
-
-		labels[i]=node->data.node_label;
-
 	}
 
 	switch(m_mode)
@@ -1263,7 +1827,10 @@ void CARTree::prune_by_cross_validation(const std::shared_ptr<DenseFeatures<floa
 			subset_weights[j]=m_weights[train_indices.at(j)];
 
 		// train with training subset
-		auto root = CARTtrain(feats_train, subset_weights, labels_train, 0);
+		std::shared_ptr<bnode_t> root;
+		#pragma omp parallel num_threads(env()->get_num_threads())
+		#pragma omp single
+		root=CARTtrain(feats_train, subset_weights, labels_train, 0);
 
 		// prune trained tree
 		auto tmax=std::make_shared<TreeMachine<CARTreeNodeData>>();
@@ -1500,6 +2067,8 @@ void CARTree::init()
 	m_weights=SGVector<float64_t>();
 	m_mode=PT_MULTICLASS;
 	m_pre_sort=false;
+	m_num_bins=0;
+	m_quantized=false;
 	m_apply_cv_pruning=false;
 	m_folds=5;
 
@@ -1516,6 +2085,7 @@ void CARTree::init()
 	SG_ADD(&m_pre_sort, "pre_sort", "presort");
 	SG_ADD(&m_sorted_features, "sorted_features", "sorted feats");
 	SG_ADD(&m_sorted_indices, "sorted_indices", "sorted indices");
+	SG_ADD(&m_num_bins, "num_bins", "number of bins of histogram split finding");
 	SG_ADD(&m_nominal, "nominal", "feature types");
 	SG_ADD(&m_weights, "weights", "weights");
 	SG_ADD(
@@ -40,6 +40,7 @@
 #include <shogun/mathematics/RandomMixin.h>
 #include <shogun/multiclass/tree/CARTreeNodeData.h>
 #include <shogun/multiclass/tree/FeatureImportanceTree.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
 #include <shogun/multiclass/tree/TreeMachine.h>
 
 #include <vector>
@@ -143,6 +144,28 @@ public:
 	 */
 	std::shared_ptr<RegressionLabels> apply_regression(std::shared_ptr<Features> data=NULL) override;
 
+	/** flattens the current tree into a node table, which apply() walks
+	 * instead of the nodes. Training and pruning compile the tree, it has
+	 * to be compiled again only after its nodes are modified in place.
+	 * A new root falls back to walking the nodes until it is compiled.
+	 */
+	void compile();
+
+	/** SHAP values of the outputs of the tree, see
+	 * FlatTreeEnsemble::shap_values(). Meaningful for regression trees and
+	 * binary trees with labels -1 and 1.
+	 *
+	 * @param data vectors to explain
+	 * @param background background vectors of interventional SHAP,
+	 * nullptr to integrate the features out by the training weights of the
+	 * nodes
+	 * @return one column per vector with the SHAP value of every feature,
+	 * followed by the expected output
+	 */
+	SGMatrix<float64_t> get_shap_values(
+		const std::shared_ptr<Features>& data,
+		const std::shared_ptr<Features>& background=nullptr);
+
 	/** uses test dataset to choose best pruned subtree
 	 *
 	 * @param feats test data to be used
@@ -238,6 +261,44 @@ public:
 
 	void set_sorted_features(SGMatrix<float64_t>& sorted_feats, SGMatrix<index_t>& sorted_indices);
 
+	/** get number of bins of histogram split finding
+	 *
+	 * @return number of bins, 0 if all thresholds are evaluated
+	 */
+	int32_t get_num_bins() const;
+
+	/** set number of bins of histogram split finding
+	 *
+	 * With num_bins>0 every feature is quantized once into at most
+	 * num_bins bins, and the splits are searched on per-node histograms
+	 * of the bins instead of on sorted feature values. The histograms of
+	 * one child are the difference of the parent's and its sibling's, so
+	 * only the smaller child is scanned. Nominal features may have at most
+	 * num_bins distinct values.
+	 *
+	 * @param num_bins number of bins in [2, 255], 0 for exact splits
+	 */
+	void set_num_bins(int32_t num_bins);
+
+	/** quantize features for histogram split finding, see set_num_bins()
+	 *
+	 * @param data training data
+	 * @param binned_feats bin of every vector, one column per feature,
+	 * num_bins for missing values
+	 * @param bin_thresholds largest value of every bin, one column per
+	 * feature
+	 */
+	void quantize_features(const std::shared_ptr<Features>& data, SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_thresholds) const;
+
+	/** set features quantized by quantize_features(), so that they are not
+	 * quantized again in train
+	 *
+	 * @param binned_feats bin of every vector, one column per feature
+	 * @param bin_thresholds largest value of every bin, one column per
+	 * feature
+	 */
+	void set_quantized_features(SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_thresholds);
+
 	/**return feature importance
 	 * this way is the same as sklearn
 	 */
@@ -256,9 +317,11 @@ protected:
 	 * @param weights vector of weights of data points
 	 * @param labels labels of data points
 	 * @param level current tree depth
+	 * @param node_histogram histograms of the node derived from the
+	 * parent's, empty if they have to be built
 	 * @return pointer to the root of the CART subtree
 	 */
-	virtual std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTtrain(std::shared_ptr<DenseFeatures<float64_t>> data, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels, int32_t level);
+	virtual std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTtrain(std::shared_ptr<DenseFeatures<float64_t>> data, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels, int32_t level, SGVector<float64_t> node_histogram=SGVector<float64_t>());
 
 	/** modify labels for compute_best_attribute
 	 *
@@ -290,6 +353,65 @@ protected:
 		float64_t& impurity, index_t subset_size = 0,
 		const SGVector<index_t>& active_indices = SGVector<index_t>());
 
+	/** number of randomly chosen attributes to evaluate at every node
+	 *
+	 * @param num_feats number of attributes
+	 * @return size of the random subset, 0 to evaluate all attributes
+	 */
+	virtual index_t get_random_subset_size(index_t num_feats)
+	{
+		return 0;
+	}
+
+	/** computes best attribute from the histograms of the node, used by
+	 * compute_best_attribute() when histogram split finding is enabled
+	 *
+	 * @param weights weights of the vectors of the node
+	 * @param labels labels of the vectors of the node
+	 * @param left stores the left transit values
+	 * @param right stores the right transit values
+	 * @param is_left_final stores whether vectors go left
+	 * @param num_missing number of vectors with missing best attribute
+	 * @param count_left number of left transit values
+	 * @param count_right number of right transit values
+	 * @param impurity impurity of the node
+	 * @param node_histogram histograms of the node, built and stored if
+	 * empty and all attributes are evaluated
+	 * @param subset_size number of randomly chosen attributes, 0 for all
+	 * @param active_indices rows of the vectors of the node in the
+	 * quantized features
+	 * @return index of the best attribute, -1 if there is no split
+	 */
+	index_t compute_best_histogram_attribute(
+		const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels,
+		SGVector<float64_t>& left, SGVector<float64_t>& right,
+		SGVector<bool>& is_left_final, index_t& num_missing,
+		index_t& count_left, index_t& count_right, float64_t& impurity,
+		SGVector<float64_t>& node_histogram, index_t subset_size,
+		const SGVector<index_t>& active_indices);
+
+	/** histograms of the given vectors over the bins of the given
+	 * features, stored feature by feature with histogram_width() entries
+	 * per bin
+	 *
+	 * @param rows rows of the vectors in the quantized features
+	 * @param weights weights of the vectors
+	 * @param labels labels of the vectors
+	 * @param features features to compute histograms of
+	 * @return histograms
+	 */
+	SGVector<float64_t> build_histogram(
+		const SGVector<index_t>& rows, const SGVector<float64_t>& weights,
+		const SGVector<float64_t>& labels, const SGVector<index_t>& features) const;
+
+	/** entries per bin of a histogram, the weight of each class for
+	 * classification, weight, weighted sum and weighted sum of squares of
+	 * the labels for regression
+	 *
+	 * @return number of entries per bin
+	 */
+	index_t histogram_width() const;
+
 	/** handles missing values through surrogate splits
 	 *
 	 * @param data training data matrix
@@ -466,6 +588,27 @@ protected:
 	/** If pre sorted features are used in train */
 	bool m_pre_sort;
 
+	/** number of bins of histogram split finding, 0 for exact splits */
+	int32_t m_num_bins;
+
+	/** If quantized features are set instead of computed in train */
+	bool m_quantized;
+
+	/** bins of the training vectors, one column per feature */
+	SGMatrix<uint8_t> m_binned_features;
+
+	/** largest value of every bin, one column per feature */
+	SGMatrix<float64_t> m_bin_thresholds;
+
+	/** sorted class labels, the columns of classification histograms */
+	SGVector<float64_t> m_histogram_classes;
+
+	/** node table of m_flat_root used by apply */
+	FlatTreeEnsemble m_flat_tree;
+
+	/** root the node table was compiled from */
+	std::shared_ptr<bnode_t> m_flat_root;
+
 	/** flag indicating whether cross validation pruning has to be applied or not - false by default **/
 	bool m_apply_cv_pruning;
 
@@ -483,6 +626,12 @@ protected:
 
 	/** minimum number of feature vectors required in a node **/
 	int32_t m_min_node_size;
+
+private:
+	/** minimum number of vectors in a node for its left child to be grown
+	 * as a separate task
+	 */
+	static constexpr index_t task_threshold=1024;
 };
 } /* namespace shogun */
 
@@ -28,10 +28,12 @@
  * either expressed or implied, of the Shogun Development Team.
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/View.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/multiclass/tree/CHAIDTree.h>
+#include <shogun/multiclass/tree/SplitStatistics.h>
 
 using namespace shogun;
 
@@ -302,30 +304,39 @@ std::shared_ptr<TreeMachineNode<CHAIDTreeNodeData>> CHAIDTree::CHAIDtrain(const
 			return node;
 	}
 
-	// choose best attribute for splitting
-	float64_t min_pv=Math::MAX_REAL_NUMBER;
-	SGVector<int32_t> cat_min;
-	int32_t attr_min=-1;
+	// choose best attribute for splitting, the attributes are merged in
+	// parallel and compared in order
+	for (int32_t i=0;i<num_feats;i++)
+	{
+		if (m_feature_types[i]!=0 && m_feature_types[i]!=1)
+			error("feature type supported are 0(nominal) and 1(ordinal). m_feature_types[{}] is set {}",i,m_feature_types[i]);
+	}
+
+	SGVector<float64_t> pvs(num_feats);
+	std::vector<SGVector<int32_t>> cats(num_feats);
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
 	for (int32_t i=0;i<num_feats;i++)
 	{
 		SGVector<float64_t> feats(num_vecs);
 		for (int32_t j=0;j<num_vecs;j++)
 			feats[j]=mat(i,j);
 
-		float64_t pv=0;
-		SGVector<int32_t> cat;
 		if (m_feature_types[i]==0)
-			cat=merge_categories_nominal(feats,labels_vec,weights,pv);
-		else if (m_feature_types[i]==1)
-			cat=merge_categories_ordinal(feats,labels_vec,weights,pv);
+			cats[i]=merge_categories_nominal(feats,labels_vec,weights,pvs[i]);
 		else
-			error("feature type supported are 0(nominal) and 1(ordinal). m_feature_types[{}] is set {}",i,m_feature_types[i]);
+			cats[i]=merge_categories_ordinal(feats,labels_vec,weights,pvs[i]);
+	}
 
-		if (pv<min_pv)
+	float64_t min_pv=Math::MAX_REAL_NUMBER;
+	SGVector<int32_t> cat_min;
+	int32_t attr_min=-1;
+	for (int32_t i=0;i<num_feats;i++)
+	{
+		if (pvs[i]<min_pv)
 		{
-			min_pv=pv;
+			min_pv=pvs[i];
 			attr_min=i;
-			cat_min=cat;
+			cat_min=cats[i];
 		}
 	}
 
@@ -428,6 +439,10 @@ SGVector<int32_t> CHAIDTree::merge_categories_ordinal(SGVector<float64_t> feats,
 
 	int32_t fnum_cat=inum_cat;
 
+	// initial category of every vector, inum_cat for MISSING
+	SGVector<index_t> feat_ucat=SplitStatistics::value_indices(
+		feats, SGVector<float64_t>(ufeats.vector, inum_cat+(missing ? 1 : 0), false));
+
 	// if chosen attribute (MISSING excluded) has 1 category only
 	if (inum_cat==1)
 	{
@@ -455,21 +470,19 @@ SGVector<int32_t> CHAIDTree::merge_categories_ordinal(SGVector<float64_t> feats,
 			std::vector<int32_t> feat_cat;
 			for (int32_t j=0;j<feats.vlen;j++)
 			{
-				for (int32_t k=0;k<inum_cat;k++)
+				const index_t k=feat_ucat[j];
+				if (k>=inum_cat)
+					continue;
+
+				if (cat[k]==cat[cat_index])
 				{
-					if (feats[j]==ufeats[k])
-					{
-						if (cat[k]==cat[cat_index])
-						{
-							feat_index.push_back(j);
-							feat_cat.push_back(cat[cat_index]);
-						}
-						else if (cat[k]==cat[cat_index+1])
-						{
-							feat_index.push_back(j);
-							feat_cat.push_back(cat[cat_index+1]);
-						}
-					}
+					feat_index.push_back(j);
+					feat_cat.push_back(cat[cat_index]);
+				}
+				else if (cat[k]==cat[cat_index+1])
+				{
+					feat_index.push_back(j);
+					feat_cat.push_back(cat[cat_index+1]);
 				}
 			}
 
@@ -518,16 +531,9 @@ SGVector<int32_t> CHAIDTree::merge_categories_ordinal(SGVector<float64_t> feats,
 	for (int32_t i=0;i<feats.vlen;i++)
 	{
 		if (feats[i]==MISSING)
-		{
 			feats_cat[i]=MISSING;
-			continue;
-		}
-
-		for (int32_t j=0;j<inum_cat;j++)
-		{
-			if (feats[i]==ufeats[j])
-				feats_cat[i]=cat[j];
-		}
+		else
+			feats_cat[i]=cat[feat_ucat[i]];
 	}
 
 	if (missing)
@@ -556,6 +562,10 @@ SGVector<int32_t> CHAIDTree::merge_categories_nominal(SGVector<float64_t> feats,
 	SGVector<int32_t> cat(inum_cat);
 	cat.range_fill(0);
 
+	// initial category of every vector
+	SGVector<index_t> feat_ucat=SplitStatistics::value_indices(
+		feats, SGVector<float64_t>(ufeats.vector, inum_cat, false));
+
 	// if chosen attribute X(feats here) has 1 category only
 	if (inum_cat==1)
 	{
@@ -588,21 +598,16 @@ SGVector<int32_t> CHAIDTree::merge_categories_nominal(SGVector<float64_t> feats,
 				std::vector<int32_t> feat_cat;
 				for (int32_t k=0;k<feats.vlen;k++)
 				{
-					for (int32_t l=0;l<inum_cat;l++)
+					const index_t l=feat_ucat[k];
+					if (cat[l]==leftcat[i])
 					{
-						if (feats[k]==ufeats[l])
-						{
-							if (cat[l]==leftcat[i])
-							{
-								feat_index.push_back(k);
-								feat_cat.push_back(leftcat[i]);
-							}
-							else if (cat[l]==leftcat[j])
-							{
-								feat_index.push_back(k);
-								feat_cat.push_back(leftcat[j]);
-							}
-						}
+						feat_index.push_back(k);
+						feat_cat.push_back(leftcat[i]);
+					}
+					else if (cat[l]==leftcat[j])
+					{
+						feat_index.push_back(k);
+						feat_cat.push_back(leftcat[j]);
 					}
 				}
 
@@ -650,13 +655,7 @@ SGVector<int32_t> CHAIDTree::merge_categories_nominal(SGVector<float64_t> feats,
 
 	SGVector<float64_t> feats_cat(feats.vlen);
 	for (int32_t i=0;i<feats.vlen;i++)
-	{
-		for (int32_t j=0;j<inum_cat;j++)
-		{
-			if (feats[i]==ufeats[j])
-				feats_cat[i]=cat[j];
-		}
-	}
+		feats_cat[i]=cat[feat_ucat[i]];
 
 	pv=adjusted_p_value(p_value(feats_cat,labels,weights),inum_cat,fnum_cat,0,false);
 	return cat;
@@ -895,8 +894,9 @@ float64_t CHAIDTree::anova_f_statistic(SGVector<float64_t> feat, SGVector<float6
 
 	y_bar/=weights.sum(weights);
 
-	SGVector<float64_t> ufeat=feat.clone();
-	r=ufeat.unique(ufeat.vector,ufeat.vlen);
+	SGVector<float64_t> ufeat=SplitStatistics::distinct_values(feat);
+	SGVector<index_t> feat_ucat=SplitStatistics::value_indices(feat,ufeat);
+	r=ufeat.vlen;
 
 	// compute y_i_bar
 	SGVector<float64_t> numer(r);
@@ -905,30 +905,28 @@ float64_t CHAIDTree::anova_f_statistic(SGVector<float64_t> feat, SGVector<float6
 	denom.zero();
 	for (int32_t n=0;n<feat.vlen;n++)
 	{
-		for (int32_t i=0;i<r;i++)
-		{
-			if (feat[n]==ufeat[i])
-			{
-				numer[i]+=weights[n]*labels[n];
-				denom[i]+=weights[n];
-				break;
-			}
-		}
+		numer[feat_ucat[n]]+=weights[n]*labels[n];
+		denom[feat_ucat[n]]+=weights[n];
 	}
 
 	// compute f statistic
+	SGVector<float64_t> nus(r);
+	SGVector<float64_t> des(r);
+	nus.zero();
+	des.zero();
+	for (int32_t n=0;n<feat.vlen;n++)
+	{
+		const index_t i=feat_ucat[n];
+		nus[i]+=weights[n]*Math::pow(((numer[i]/denom[i])-y_bar),2);
+		des[i]+=weights[n]*Math::pow((labels[n]-(numer[i]/denom[i])),2);
+	}
+
 	float64_t nu=0.;
 	float64_t de=0.;
 	for (int32_t i=0;i<r;i++)
 	{
-		for (int32_t n=0;n<feat.vlen;n++)
-		{
-			if (feat[n]==ufeat[i])
-			{
-				nu+=weights[n]*Math::pow(((numer[i]/denom[i])-y_bar),2);
-				de+=weights[n]*Math::pow((labels[n]-(numer[i]/denom[i])),2);
-			}
-		}
+		nu+=nus[i];
+		de+=des[i];
 	}
 
 	nu/=(r-1.0);
@@ -942,43 +940,12 @@ float64_t CHAIDTree::anova_f_statistic(SGVector<float64_t> feat, SGVector<float6
 float64_t CHAIDTree::likelihood_ratio_statistic(SGVector<float64_t> feat, SGVector<float64_t> labels,
 						SGVector<float64_t> weights, int32_t &r, int32_t &c)
 {
-	SGVector<float64_t> ufeat=feat.clone();
-	SGVector<float64_t> ulabels=labels.clone();
-	r=ufeat.unique(ufeat.vector,ufeat.vlen);
-	c=ulabels.unique(ulabels.vector,ulabels.vlen);
-
 	// contingency table, weight table
-	SGMatrix<int32_t> ct(r,c);
-	ct.zero();
-	SGMatrix<float64_t> wt(r,c);
-	wt.zero();
-	for (int32_t i=0;i<feat.vlen;i++)
-	{
-		// calculate row
-		int32_t row=-1;
-		for (int32_t j=0;j<r;j++)
-		{
-			if (feat[i]==ufeat[j])
-			{
-				row=j;
-				break;
-			}
-		}
-
-		// calculate col
-		int32_t col=-1;
-		for (int32_t j=0;j<c;j++)
-		{
-			if (labels[i]==ulabels[j])
-			{
-				col=j;
-				break;
-			}
-		}
-
-		ct(row,col)++;
-		wt(row,col)+=weights[i];
-	}
+	SGMatrix<int32_t> ct;
+	SGMatrix<float64_t> wt;
+	SplitStatistics::contingency_table(feat,labels,weights,ct,wt);
+	r=ct.num_rows;
+	c=ct.num_cols;
 
 	SGMatrix<float64_t> expmat_indep=expected_cf_indep_model(ct,wt);
 
@@ -1000,43 +967,12 @@ float64_t CHAIDTree::likelihood_ratio_statistic(SGVector<float64_t> feat, SGVect
 float64_t CHAIDTree::pchi2_statistic(SGVector<float64_t> feat, SGVector<float64_t> labels, SGVector<float64_t> weights,
 												int32_t &r, int32_t &c)
 {
-	SGVector<float64_t> ufeat=feat.clone();
-	SGVector<float64_t> ulabels=labels.clone();
-	r=ufeat.unique(ufeat.vector,ufeat.vlen);
-	c=ulabels.unique(ulabels.vector,ulabels.vlen);
-
 	// contingency table, weight table
-	SGMatrix<int32_t> ct(r,c);
-	ct.zero();
-	SGMatrix<float64_t> wt(r,c);
-	wt.zero();
-	for (int32_t i=0;i<feat.vlen;i++)
-	{
-		// calculate row
-		int32_t row=-1;
-		for (int32_t j=0;j<r;j++)
-		{
-			if (feat[i]==ufeat[j])
-			{
-				row=j;
-				break;
-			}
-		}
-
-		// calculate col
-		int32_t col=-1;
-		for (int32_t j=0;j<c;j++)
-		{
-			if (labels[i]==ulabels[j])
-			{
-				col=j;
-				break;
-			}
-		}
-
-		ct(row,col)++;
-		wt(row,col)+=weights[i];
-	}
+	SGMatrix<int32_t> ct;
+	SGMatrix<float64_t> wt;
+	SplitStatistics::contingency_table(feat,labels,weights,ct,wt);
+	r=ct.num_rows;
+	c=ct.num_cols;
 
 	SGMatrix<float64_t> expected_cf=expected_cf_indep_model(ct,wt);
 
@@ -5,9 +5,11 @@
  *          Viktor Gal
  */
 
+#include <queue>
+#include <utility>
 #include <vector>
-#include <stack>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/multiclass/tree/ConditionalProbabilityTree.h>
 #include <shogun/classifier/svm/OnlineLibLinear.h>
 #include <shogun/mathematics/Math.h>
@@ -15,6 +17,10 @@
 using namespace shogun;
 using namespace std;
 
+// number of examples that are read from the stream before they are
+// processed in parallel
+static const size_t BATCH_SIZE = 1024;
+
 std::shared_ptr<MulticlassLabels> ConditionalProbabilityTree::apply_multiclass(std::shared_ptr<Features> data)
 {
 	if (data)
@@ -27,15 +33,40 @@ std::shared_ptr<MulticlassLabels> ConditionalProbabilityTree::apply_multiclass(s
 		set_features(data->as<StreamingDenseFeatures<float32_t>>());
 	}
 
+	const auto nodes = flatten_tree();
+	const int32_t num_classes = get_num_leaf_classes();
+
 	vector<int32_t> predicts;
+	vector<SGVector<float32_t>> batch;
+
+	// predict a batch of examples from the stream in parallel
+	auto predict_batch = [&]() {
+		const size_t offset = predicts.size();
+		predicts.resize(offset + batch.size());
+
+		#pragma omp parallel num_threads(env()->get_num_threads())
+		{
+			SGVector<float64_t> node_probs(nodes.size());
+			SGVector<float64_t> probs(num_classes);
+
+			#pragma omp for schedule(static)
+			for (int64_t i = 0; i < (int64_t)batch.size(); ++i)
+				predicts[offset + i] = predict_example(nodes, batch[i], node_probs, probs);
+		}
+		batch.clear();
+	};
 
 	m_feats->start_parser();
 	while (m_feats->get_next_example())
 	{
-		predicts.push_back(apply_multiclass_example(m_feats->get_vector()));
+		batch.push_back(m_feats->get_vector().clone());
 		m_feats->release_example();
+
+		if (batch.size() >= BATCH_SIZE)
+			predict_batch();
 	}
 	m_feats->end_parser();
+	predict_batch();
 
 	auto labels = std::make_shared<MulticlassLabels>(predicts.size());
 	for (size_t i=0; i < predicts.size(); ++i)
@@ -45,51 +76,73 @@ std::shared_ptr<MulticlassLabels> ConditionalProbabilityTree::apply_multiclass(s
 
 int32_t ConditionalProbabilityTree::apply_multiclass_example(SGVector<float32_t> ex)
 {
-	compute_conditional_probabilities(ex);
-	SGVector<float64_t> probs(m_leaves.size());
-	for (auto it = m_leaves.begin(); it != m_leaves.end(); ++it)
-	{
-		probs[it->first] = accumulate_conditional_probability(it->second);
-	}
-	return Math::arg_max(probs.vector, 1, probs.vlen);
+	const auto nodes = flatten_tree();
+	SGVector<float64_t> node_probs(nodes.size());
+	SGVector<float64_t> probs(get_num_leaf_classes());
+	return predict_example(nodes, ex, node_probs, probs);
 }
 
-void ConditionalProbabilityTree::compute_conditional_probabilities(const SGVector<float32_t>& ex)
+vector<ConditionalProbabilityTree::FlatNode> ConditionalProbabilityTree::flatten_tree() const
 {
-	stack<std::shared_ptr<bnode_t>> nodes;
-	nodes.push(m_root->as<bnode_t>());
+	require(m_root, "The tree has not been trained");
+
+	vector<FlatNode> nodes(1);
+	queue<pair<std::shared_ptr<bnode_t>, int32_t>> to_visit;
+	to_visit.emplace(m_root->as<bnode_t>(), 0);
 
-	while (!nodes.empty())
+	// breadth first, so the children are stored after their parent
+	while (!to_visit.empty())
 	{
-		auto node = nodes.top();
-		nodes.pop();
+		auto node = to_visit.front().first;
+		const int32_t idx = to_visit.front().second;
+		to_visit.pop();
+
+		nodes[idx].machine = m_machines.at(node->machine())->as<OnlineLibLinear>();
+		nodes[idx].label = node->data.label;
+		nodes[idx].left = -1;
+		nodes[idx].right = -1;
 		if (node->left())
 		{
-			nodes.push(node->left());
-			nodes.push(node->right());
+			nodes[idx].left = nodes.size();
+			to_visit.emplace(node->left(), nodes.size());
+			nodes.emplace_back();
 
-			// don't calculate for leaf
-			node->data.p_right = predict_node(ex, node);
+			nodes[idx].right = nodes.size();
+			to_visit.emplace(node->right(), nodes.size());
+			nodes.emplace_back();
 		}
 	}
+
+	return nodes;
 }
 
-float64_t ConditionalProbabilityTree::accumulate_conditional_probability(std::shared_ptr<bnode_t> leaf)
+int32_t ConditionalProbabilityTree::predict_example(const vector<FlatNode>& nodes, const SGVector<float32_t>& ex,
+		SGVector<float64_t>& node_probs, SGVector<float64_t>& probs)
 {
-	float64_t prob = 1;
-	auto par = leaf->parent()->as<bnode_t>();
-	while (par != NULL)
+	probs.zero();
+	node_probs[0] = 1;
+	for (size_t i = 0; i < nodes.size(); ++i)
 	{
-		if (leaf == par->left())
-			prob *= (1-par->data.p_right);
-		else
-			prob *= par->data.p_right;
+		const auto& node = nodes[i];
+		if (node.left < 0)
+		{
+			probs[node.label] = node_probs[i];
+			continue;
+		}
 
-		leaf = par;
-		par = leaf->parent()->as<bnode_t>();
+		// use sigmoid function to turn the decision value into valid probability
+		const float64_t pred = node.machine->apply_one(ex.vector, ex.vlen);
+		const float64_t p_right = 1.0 / (1 + std::exp(-pred));
+		node_probs[node.left] = node_probs[i] * (1 - p_right);
+		node_probs[node.right] = node_probs[i] * p_right;
 	}
 
-	return prob;
+	return Math::arg_max(probs.vector, 1, probs.vlen);
+}
+
+int32_t ConditionalProbabilityTree::get_num_leaf_classes() const
+{
+	return m_leaves.empty() ? 0 : m_leaves.rbegin()->first + 1;
 }
 
 bool ConditionalProbabilityTree::train_machine(std::shared_ptr<Features> data)
@@ -114,14 +167,39 @@ bool ConditionalProbabilityTree::train_machine(std::shared_ptr<Features> data)
 
 	m_leaves.clear();
 
+	// examples of known classes only update the machines on the path of
+	// their leaf, they are batched and trained in parallel. A new class
+	// changes the tree with the current machines, so it flushes the batch.
+	vector<SGVector<float32_t>> batch;
+	vector<std::shared_ptr<bnode_t>> batch_leaves;
+	auto train_batch = [&]() {
+		train_paths(batch, batch_leaves);
+		batch.clear();
+		batch_leaves.clear();
+	};
+
 	m_feats->start_parser();
 	for (int32_t ipass=0; ipass < m_num_passes; ++ipass)
 	{
 		while (m_feats->get_next_example())
 		{
-			train_example(m_feats, static_cast<int32_t>(m_feats->get_label()));
+			const int32_t label = static_cast<int32_t>(m_feats->get_label());
+			auto leaf = m_leaves.find(label);
+			if (leaf != m_leaves.end())
+			{
+				batch.push_back(m_feats->get_vector().clone());
+				batch_leaves.push_back(leaf->second);
+				if (batch.size() >= BATCH_SIZE)
+					train_batch();
+			}
+			else
+			{
+				train_batch();
+				train_example(m_feats, label);
+			}
 			m_feats->release_example();
 		}
+		train_batch();
 
 		if (ipass < m_num_passes-1)
 			m_feats->reset_stream();
@@ -214,6 +292,44 @@ void ConditionalProbabilityTree::train_path(const std::shared_ptr<StreamingDense
 	}
 }
 
+void ConditionalProbabilityTree::train_paths(const vector<SGVector<float32_t>>& examples, const vector<std::shared_ptr<bnode_t>>& leaves)
+{
+	if (examples.empty())
+		return;
+
+	// the updates of every machine in the order of the examples
+	vector<vector<pair<int32_t, float64_t>>> updates(m_machines.size());
+	vector<int32_t> touched;
+	for (size_t i = 0; i < examples.size(); ++i)
+	{
+		auto node = leaves[i];
+		float64_t node_label = 0;
+		while (node != NULL)
+		{
+			auto& machine_updates = updates[node->machine()];
+			if (machine_updates.empty())
+				touched.push_back(node->machine());
+			machine_updates.emplace_back(i, node_label);
+
+			auto par = node->parent();
+			if (par == NULL)
+				break;
+
+			auto bpar = par->as<bnode_t>();
+			node_label = bpar->left() == node ? 0 : 1;
+			node = bpar;
+		}
+	}
+
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int64_t t = 0; t < (int64_t)touched.size(); ++t)
+	{
+		auto mch = m_machines[touched[t]]->as<OnlineLibLinear>();
+		for (const auto& update : updates[touched[t]])
+			mch->train_one(examples[update.first], update.second);
+	}
+}
+
 void ConditionalProbabilityTree::train_node(const std::shared_ptr<StreamingDenseFeatures<float32_t>>& ex, float64_t label, const std::shared_ptr<bnode_t>& node)
 {
 	require(node, "Node must not be NULL");
@@ -9,6 +9,7 @@
 #define CONDITIONALPROBABILITYTREE_H__
 
 #include <map>
+#include <vector>
 
 #include <shogun/lib/config.h>
 
@@ -18,6 +19,7 @@
 
 namespace shogun
 {
+class OnlineLibLinear;
 
 /**
  * Conditional Probability Tree.
@@ -96,6 +98,16 @@ protected:
 	 */
 	void train_path(const std::shared_ptr<StreamingDenseFeatures<float32_t>>& ex, std::shared_ptr<bnode_t> node);
 
+	/** train on the paths from the leaves of a batch of examples up to the
+	 * root, i.e. train_path() for every example. Every machine is updated
+	 * with its examples in the order of the batch, so the result is the
+	 * same as training one example after the other, but the machines are
+	 * updated in parallel.
+	 * @param examples the examples
+	 * @param leaves the leaf node of the class of every example
+	 */
+	void train_paths(const std::vector<SGVector<float32_t>>& examples, const std::vector<std::shared_ptr<bnode_t>>& leaves);
+
 	/** train a single node
 	 * @param ex the example being trained
 	 * @param label label
@@ -121,13 +133,40 @@ protected:
 	 */
 	virtual bool which_subtree(std::shared_ptr<bnode_t> node, SGVector<float32_t> ex)=0;
 
-	/** compute conditional probabilities for ex along the whole tree for predicting */
-	void compute_conditional_probabilities(const SGVector<float32_t>& ex);
-
-	/** accumulate along the path to the root the conditional probability for a
-	 * particular leaf node.
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	/** node of the tree in contiguous storage, the children are stored
+	 * after their parent */
+	struct FlatNode
+	{
+		/** machine of the node */
+		std::shared_ptr<OnlineLibLinear> machine;
+		/** index of the left child, -1 for a leaf */
+		int32_t left;
+		/** index of the right child, -1 for a leaf */
+		int32_t right;
+		/** class of a leaf */
+		int32_t label;
+	};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+	/** @return the nodes of the tree in contiguous storage, for
+	 * predicting without following pointers */
+	std::vector<FlatNode> flatten_tree() const;
+
+	/** predict the class of an example, the probability of a leaf is
+	 * the product of the conditional probabilities of the branches on its
+	 * path, which are computed top down
+	 * @param nodes the flattened tree
+	 * @param ex the example
+	 * @param node_probs buffer of one probability per node
+	 * @param probs buffer of one probability per class
+	 * @return the most probable class
 	 */
-	float64_t accumulate_conditional_probability(std::shared_ptr<bnode_t> leaf);
+	static int32_t predict_example(const std::vector<FlatNode>& nodes, const SGVector<float32_t>& ex,
+			SGVector<float64_t>& node_probs, SGVector<float64_t>& probs);
+
+	/** @return the number of classes, i.e. the largest class plus one */
+	int32_t get_num_leaf_classes() const;
 
 	int32_t m_num_passes; ///< number of passes for online training
 	std::map<int32_t, std::shared_ptr<bnode_t>> m_leaves; ///< class => leaf mapping
@@ -0,0 +1,421 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace shogun;
+
+FlatTreeEnsemble::FlatTreeEnsemble()
+{
+	clear();
+}
+
+void FlatTreeEnsemble::clear()
+{
+	m_roots.clear();
+	m_attribute.clear();
+	m_threshold.clear();
+	m_right.clear();
+	m_label.clear();
+	m_cover.clear();
+	m_nominal_begin.clear();
+	m_nominal_end.clear();
+	m_nominal_values.clear();
+	m_max_attribute=-1;
+	m_max_depth=0;
+}
+
+void FlatTreeEnsemble::add_tree(
+    const std::shared_ptr<bnode_t>& root, const SGVector<bool>& nominal)
+{
+	require(root, "Tree is not trained");
+	m_roots.push_back(add_node(root, nominal, 0));
+}
+
+index_t FlatTreeEnsemble::add_node(
+    const std::shared_ptr<bnode_t>& node, const SGVector<bool>& nominal,
+    int32_t depth)
+{
+	const index_t n=m_attribute.size();
+	m_attribute.push_back(-1);
+	m_threshold.push_back(0);
+	m_right.push_back(-1);
+	m_label.push_back(node->data.node_label);
+	m_cover.push_back(node->data.total_weight);
+	m_nominal_begin.push_back(-1);
+	m_nominal_end.push_back(-1);
+	if (node->data.num_leaves==1)
+	{
+		m_max_depth=std::max(m_max_depth, depth);
+		return n;
+	}
+
+	const int32_t attribute=node->data.attribute_id;
+	require(attribute>=0 && attribute<nominal.vlen,
+		"Split attribute {} of node {} is not a feature", attribute, n);
+	m_attribute[n]=attribute;
+	m_max_attribute=std::max(m_max_attribute, attribute);
+
+	auto left=node->left();
+	const auto& transit=left->data.transit_into_values;
+	if (nominal[attribute])
+	{
+		m_nominal_begin[n]=m_nominal_values.size();
+		m_nominal_values.insert(m_nominal_values.end(), transit.begin(), transit.end());
+		m_nominal_end[n]=m_nominal_values.size();
+	}
+	else
+		m_threshold[n]=transit[0];
+
+	add_node(left, nominal, depth+1);
+	m_right[n]=add_node(node->right(), nominal, depth+1);
+	return n;
+}
+
+index_t FlatTreeEnsemble::child(index_t n, const float64_t* x) const
+{
+	const float64_t value=x[m_attribute[n]];
+	bool left;
+	if (m_nominal_begin[n]<0)
+		left=value<=m_threshold[n];
+	else
+	{
+		const float64_t* begin=m_nominal_values.data()+m_nominal_begin[n];
+		const float64_t* end=m_nominal_values.data()+m_nominal_end[n];
+		left=std::find(begin, end, value)!=end;
+	}
+	return left ? n+1 : m_right[n];
+}
+
+index_t FlatTreeEnsemble::find_leaf(index_t tree, const float64_t* x) const
+{
+	index_t n=m_roots[tree];
+	while (m_attribute[n]>=0)
+		n=child(n, x);
+	return n;
+}
+
+void FlatTreeEnsemble::check_data(const SGMatrix<float64_t>& data) const
+{
+	require(data.num_cols>0, "No data provided in apply");
+	require(m_max_attribute<data.num_rows,
+		"Trees split on feature {} but the data has {} features",
+		m_max_attribute, data.num_rows);
+}
+
+SGMatrix<float64_t> FlatTreeEnsemble::apply(const SGMatrix<float64_t>& data) const
+{
+	check_data(data);
+	const index_t num_vecs=data.num_cols;
+	const index_t num_trees=get_num_trees();
+	SGMatrix<float64_t> labels(num_vecs, num_trees);
+
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t begin=0; begin<num_vecs; begin+=block_size)
+	{
+		const index_t end=std::min(begin+block_size, num_vecs);
+		for (index_t t=0; t<num_trees; ++t)
+		{
+			float64_t* tree_labels=labels.get_column_vector(t);
+			for (index_t i=begin; i<end; ++i)
+				tree_labels[i]=m_label[find_leaf(t, data.get_column_vector(i))];
+		}
+	}
+
+	return labels;
+}
+
+SGVector<float64_t> FlatTreeEnsemble::apply_sum(
+    const SGMatrix<float64_t>& data, const SGVector<float64_t>& tree_weights,
+    float64_t scale) const
+{
+	check_data(data);
+	require(tree_weights.vlen==get_num_trees(),
+		"Number of weights ({}) does not match number of trees ({})",
+		tree_weights.vlen, get_num_trees());
+	const index_t num_vecs=data.num_cols;
+	SGVector<float64_t> sums(num_vecs);
+	sums.zero();
+
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t begin=0; begin<num_vecs; begin+=block_size)
+	{
+		const index_t end=std::min(begin+block_size, num_vecs);
+		for (index_t t=0; t<get_num_trees(); ++t)
+		{
+			for (index_t i=begin; i<end; ++i)
+				sums[i]+=m_label[find_leaf(t, data.get_column_vector(i))]*tree_weights[t]*scale;
+		}
+	}
+
+	return sums;
+}
+
+SGMatrix<float64_t> FlatTreeEnsemble::shap_values(
+    const SGMatrix<float64_t>& data, const SGVector<float64_t>& tree_weights,
+    float64_t scale, const SGMatrix<float64_t>& background) const
+{
+	check_data(data);
+	require(tree_weights.vlen==get_num_trees(),
+		"Number of weights ({}) does not match number of trees ({})",
+		tree_weights.vlen, get_num_trees());
+	const bool interventional=background.num_cols>0;
+	if (interventional)
+	{
+		require(background.num_rows==data.num_rows,
+			"Background vectors have {} features but the data has {}",
+			background.num_rows, data.num_rows);
+	}
+	const index_t num_vecs=data.num_cols;
+	const index_t num_feats=data.num_rows;
+	const index_t num_trees=get_num_trees();
+	SGMatrix<float64_t> phi(num_feats+1, num_vecs);
+	phi.zero();
+
+	// expected output, the last row of every column
+	float64_t expected=0;
+	if (interventional)
+	{
+		auto background_sums=apply_sum(background, tree_weights, scale);
+		for (index_t j=0; j<background.num_cols; ++j)
+			expected+=background_sums[j];
+		expected/=background.num_cols;
+	}
+	else
+	{
+		for (index_t t=0; t<num_trees; ++t)
+			expected+=expected_label(t)*tree_weights[t]*scale;
+	}
+
+	// Shapley weight a!b!/(a+b+1)! of reaching a leaf with a+1 features
+	// that follow x and b that follow z, or vice versa
+	const index_t width=m_max_depth+1;
+	std::vector<float64_t> subset_weights(width*width);
+	for (index_t a=0; a<width; ++a)
+	{
+		for (index_t b=0; b<width; ++b)
+			subset_weights[a*width+b]=std::exp(
+				std::lgamma(a+1.0)+std::lgamma(b+1.0)-std::lgamma(a+b+2.0));
+	}
+
+	#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		std::vector<PathElement> path((m_max_depth+2)*(m_max_depth+3)/2);
+		std::vector<int8_t> state(num_feats, 0);
+		std::vector<int32_t> x_features;
+		std::vector<int32_t> z_features;
+
+		#pragma omp for schedule(dynamic)
+		for (index_t i=0; i<num_vecs; ++i)
+		{
+			const float64_t* x=data.get_column_vector(i);
+			float64_t* phi_i=phi.get_column_vector(i);
+			for (index_t t=0; t<num_trees; ++t)
+			{
+				const float64_t value_scale=tree_weights[t]*scale;
+				if (!interventional)
+				{
+					tree_shap(
+						m_roots[t], x, value_scale, phi_i, path.data(), 0, 1,
+						1, -1);
+					continue;
+				}
+
+				for (index_t j=0; j<background.num_cols; ++j)
+				{
+					interventional_shap(
+						m_roots[t], x, background.get_column_vector(j),
+						value_scale/background.num_cols, phi_i, state,
+						x_features, z_features, subset_weights);
+				}
+			}
+			phi_i[num_feats]=expected;
+		}
+	}
+
+	return phi;
+}
+
+float64_t FlatTreeEnsemble::expected_label(index_t tree) const
+{
+	const index_t begin=m_roots[tree];
+	const index_t end=tree+1<get_num_trees() ? m_roots[tree+1] : get_num_nodes();
+	if (m_cover[begin]<=0)
+		return m_label[begin];
+
+	float64_t expected=0;
+	for (index_t n=begin; n<end; ++n)
+	{
+		if (m_attribute[n]<0)
+			expected+=m_label[n]*m_cover[n];
+	}
+	return expected/m_cover[begin];
+}
+
+void FlatTreeEnsemble::extend_path(
+    PathElement* path, index_t depth, float64_t zero_fraction,
+    float64_t one_fraction, int32_t feature)
+{
+	path[depth].feature=feature;
+	path[depth].zero_fraction=zero_fraction;
+	path[depth].one_fraction=one_fraction;
+	path[depth].weight=depth==0 ? 1 : 0;
+	for (index_t i=depth-1; i>=0; --i)
+	{
+		path[i+1].weight+=one_fraction*path[i].weight*(i+1)/(depth+1);
+		path[i].weight=zero_fraction*path[i].weight*(depth-i)/(depth+1);
+	}
+}
+
+void FlatTreeEnsemble::unwind_path(PathElement* path, index_t depth, index_t index)
+{
+	const float64_t one_fraction=path[index].one_fraction;
+	const float64_t zero_fraction=path[index].zero_fraction;
+	float64_t next_one_portion=path[depth].weight;
+	for (index_t i=depth-1; i>=0; --i)
+	{
+		if (one_fraction!=0)
+		{
+			const float64_t weight=path[i].weight;
+			path[i].weight=next_one_portion*(depth+1)/((i+1)*one_fraction);
+			next_one_portion=weight-path[i].weight*zero_fraction*(depth-i)/(depth+1);
+		}
+		else
+			path[i].weight=path[i].weight*(depth+1)/(zero_fraction*(depth-i));
+	}
+
+	for (index_t i=index; i<depth; ++i)
+	{
+		path[i].feature=path[i+1].feature;
+		path[i].zero_fraction=path[i+1].zero_fraction;
+		path[i].one_fraction=path[i+1].one_fraction;
+	}
+}
+
+float64_t FlatTreeEnsemble::unwound_path_sum(
+    const PathElement* path, index_t depth, index_t index)
+{
+	const float64_t one_fraction=path[index].one_fraction;
+	const float64_t zero_fraction=path[index].zero_fraction;
+	float64_t next_one_portion=path[depth].weight;
+	float64_t total=0;
+	for (index_t i=depth-1; i>=0; --i)
+	{
+		if (one_fraction!=0)
+		{
+			const float64_t weight=next_one_portion*(depth+1)/((i+1)*one_fraction);
+			total+=weight;
+			next_one_portion=path[i].weight-weight*zero_fraction*(depth-i)/(depth+1);
+		}
+		else
+			total+=path[i].weight/zero_fraction*(depth+1)/(depth-i);
+	}
+	return total;
+}
+
+void FlatTreeEnsemble::tree_shap(
+    index_t n, const float64_t* x, float64_t value_scale, float64_t* phi,
+    PathElement* parent_path, index_t depth, float64_t zero_fraction,
+    float64_t one_fraction, int32_t feature) const
+{
+	// every level works on its own copy of the path
+	PathElement* path=parent_path+depth+1;
+	std::copy(parent_path, parent_path+depth+1, path);
+	extend_path(path, depth, zero_fraction, one_fraction, feature);
+
+	if (m_attribute[n]<0)
+	{
+		for (index_t i=1; i<=depth; ++i)
+		{
+			const float64_t weight=unwound_path_sum(path, depth, i);
+			phi[path[i].feature]+=weight*
+				(path[i].one_fraction-path[i].zero_fraction)*m_label[n]*value_scale;
+		}
+		return;
+	}
+
+	const int32_t split=m_attribute[n];
+	const index_t hot=child(n, x);
+	const index_t cold=hot==n+1 ? m_right[n] : n+1;
+	const float64_t cover=m_cover[n];
+	const float64_t hot_fraction=cover>0 ? m_cover[hot]/cover : 0.5;
+	const float64_t cold_fraction=cover>0 ? m_cover[cold]/cover : 0.5;
+
+	// a feature that is split on again is only counted once on the path
+	float64_t incoming_zero_fraction=1;
+	float64_t incoming_one_fraction=1;
+	index_t index=1;
+	while (index<=depth && path[index].feature!=split)
+		++index;
+	if (index<=depth)
+	{
+		incoming_zero_fraction=path[index].zero_fraction;
+		incoming_one_fraction=path[index].one_fraction;
+		unwind_path(path, depth, index);
+		--depth;
+	}
+
+	tree_shap(
+		hot, x, value_scale, phi, path, depth+1,
+		hot_fraction*incoming_zero_fraction, incoming_one_fraction, split);
+	tree_shap(
+		cold, x, value_scale, phi, path, depth+1,
+		cold_fraction*incoming_zero_fraction, 0, split);
+}
+
+void FlatTreeEnsemble::interventional_shap(
+    index_t n, const float64_t* x, const float64_t* z, float64_t value_scale,
+    float64_t* phi, std::vector<int8_t>& state, std::vector<int32_t>& x_features,
+    std::vector<int32_t>& z_features, const std::vector<float64_t>& subset_weights) const
+{
+	if (m_attribute[n]<0)
+	{
+		// a feature of x_features gains the label when it joins the
+		// others of x_features, one of z_features loses it
+		const index_t width=m_max_depth+1;
+		const index_t a=x_features.size();
+		const index_t b=z_features.size();
+		const float64_t value=m_label[n]*value_scale;
+		for (auto f : x_features)
+			phi[f]+=value*subset_weights[(a-1)*width+b];
+		for (auto f : z_features)
+			phi[f]-=value*subset_weights[a*width+b-1];
+		return;
+	}
+
+	const int32_t split=m_attribute[n];
+	const index_t x_child=child(n, x);
+	const index_t z_child=child(n, z);
+	if (x_child==z_child || state[split]==1)
+		interventional_shap(
+			x_child, x, z, value_scale, phi, state, x_features, z_features,
+			subset_weights);
+	else if (state[split]==2)
+		interventional_shap(
+			z_child, x, z, value_scale, phi, state, x_features, z_features,
+			subset_weights);
+	else
+	{
+		state[split]=1;
+		x_features.push_back(split);
+		interventional_shap(
+			x_child, x, z, value_scale, phi, state, x_features, z_features,
+			subset_weights);
+		x_features.pop_back();
+
+		state[split]=2;
+		z_features.push_back(split);
+		interventional_shap(
+			z_child, x, z, value_scale, phi, state, x_features, z_features,
+			subset_weights);
+		z_features.pop_back();
+		state[split]=0;
+	}
+}
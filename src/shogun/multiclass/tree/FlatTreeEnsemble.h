@@ -0,0 +1,221 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef FLATTREEENSEMBLE_H__
+#define FLATTREEENSEMBLE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/multiclass/tree/BinaryTreeMachineNode.h>
+#include <shogun/multiclass/tree/CARTreeNodeData.h>
+
+#include <memory>
+#include <vector>
+
+namespace shogun
+{
+/** @brief Trees of CART nodes compiled into flat node tables for
+ * prediction.
+ *
+ * The nodes of all trees are stored in pre-order in contiguous arrays: the
+ * split attribute (-1 for leaves), the threshold, the offset of the right
+ * child and the label of the node. The left child of a node directly
+ * follows it. Nominal splits keep the values that go left in a separate
+ * array.
+ *
+ * apply() walks blocks of vectors through one tree at a time, so the nodes
+ * of a tree stay in cache for the whole block. The blocks are processed in
+ * parallel.
+ *
+ * shap_values() explains the weighted sum of the trees by exact TreeSHAP,
+ * Lundberg et al., "Consistent Individualized Feature Attribution for Tree
+ * Ensembles", 2018. The path-dependent variant integrates the features out
+ * of a tree by the training weights of its nodes, the interventional
+ * variant by a background sample. The vectors are explained in parallel.
+ */
+class FlatTreeEnsemble
+{
+public:
+	/** CART node type */
+	typedef BinaryTreeMachineNode<CARTreeNodeData> bnode_t;
+
+	/** constructor */
+	FlatTreeEnsemble();
+
+	/** remove all trees */
+	void clear();
+
+	/** append a trained tree
+	 *
+	 * @param root root of the tree
+	 * @param nominal whether the attributes are nominal
+	 */
+	void add_tree(
+		const std::shared_ptr<bnode_t>& root, const SGVector<bool>& nominal);
+
+	/** @return number of trees */
+	index_t get_num_trees() const
+	{
+		return m_roots.size();
+	}
+
+	/** @return number of nodes of all trees */
+	index_t get_num_nodes() const
+	{
+		return m_attribute.size();
+	}
+
+	/** labels of the vectors in all trees
+	 *
+	 * @param data vectors, one per column
+	 * @return labels, one column per tree
+	 */
+	SGMatrix<float64_t> apply(const SGMatrix<float64_t>& data) const;
+
+	/** weighted sum of the labels of the vectors over all trees, the
+	 * trees are added in order
+	 *
+	 * @param data vectors, one per column
+	 * @param tree_weights weight of every tree
+	 * @param scale factor of all weights
+	 * @return sum of the weighted labels of every vector
+	 */
+	SGVector<float64_t> apply_sum(
+		const SGMatrix<float64_t>& data,
+		const SGVector<float64_t>& tree_weights, float64_t scale=1) const;
+
+	/** SHAP values of the weighted sum of the labels of the trees, see
+	 * apply_sum()
+	 *
+	 * Without background the features are integrated out by the training
+	 * weights of the nodes (path-dependent TreeSHAP), otherwise the labels
+	 * are averaged over the background vectors (interventional TreeSHAP).
+	 *
+	 * @param data vectors, one per column
+	 * @param tree_weights weight of every tree
+	 * @param scale factor of all weights
+	 * @param background background vectors, one per column, may be empty
+	 * @return one column per vector with the SHAP value of every feature,
+	 * followed by the expected output; each column sums to the output
+	 */
+	SGMatrix<float64_t> shap_values(
+		const SGMatrix<float64_t>& data,
+		const SGVector<float64_t>& tree_weights, float64_t scale=1,
+		const SGMatrix<float64_t>& background=SGMatrix<float64_t>()) const;
+
+private:
+	/** append the subtree in pre-order
+	 *
+	 * @param depth depth of the node
+	 * @return index of the node
+	 */
+	index_t add_node(
+		const std::shared_ptr<bnode_t>& node, const SGVector<bool>& nominal,
+		int32_t depth);
+
+	/** @return leaf of tree that vector x reaches */
+	index_t find_leaf(index_t tree, const float64_t* x) const;
+
+	/** @return child of split node n that vector x goes to */
+	index_t child(index_t n, const float64_t* x) const;
+
+	/** element of the unique feature path of TreeSHAP */
+	struct PathElement
+	{
+		/** split feature, -1 for the root */
+		int32_t feature;
+		/** fraction of the paths that go on if the feature is unknown */
+		float64_t zero_fraction;
+		/** fraction of the paths that go on if the feature is known */
+		float64_t one_fraction;
+		/** weight of the subsets of the path of each size */
+		float64_t weight;
+	};
+
+	/** add feature to the path of the given depth */
+	static void extend_path(
+		PathElement* path, index_t depth, float64_t zero_fraction,
+		float64_t one_fraction, int32_t feature);
+
+	/** remove element index from the path of the given depth */
+	static void unwind_path(PathElement* path, index_t depth, index_t index);
+
+	/** @return total weight of the path without element index */
+	static float64_t unwound_path_sum(
+		const PathElement* path, index_t depth, index_t index);
+
+	/** path-dependent TreeSHAP of the subtree of node n, adds the SHAP
+	 * values of x scaled by value_scale to phi */
+	void tree_shap(
+		index_t n, const float64_t* x, float64_t value_scale, float64_t* phi,
+		PathElement* parent_path, index_t depth, float64_t zero_fraction,
+		float64_t one_fraction, int32_t feature) const;
+
+	/** interventional TreeSHAP of the subtree of node n against the
+	 * background vector z, adds the SHAP values of x scaled by value_scale
+	 * to phi
+	 *
+	 * @param state 1 for the features that follow x, 2 for those that
+	 * follow z, 0 otherwise
+	 * @param x_features features that follow x
+	 * @param z_features features that follow z
+	 * @param subset_weights Shapley weights of the subsets, see shap_values()
+	 */
+	void interventional_shap(
+		index_t n, const float64_t* x, const float64_t* z,
+		float64_t value_scale, float64_t* phi, std::vector<int8_t>& state,
+		std::vector<int32_t>& x_features, std::vector<int32_t>& z_features,
+		const std::vector<float64_t>& subset_weights) const;
+
+	/** @return output of a tree with the features integrated out by the
+	 * training weights of its nodes */
+	float64_t expected_label(index_t tree) const;
+
+	/** require data to have all attributes of the trees */
+	void check_data(const SGMatrix<float64_t>& data) const;
+
+private:
+	/** number of vectors walked through a tree at once */
+	static constexpr index_t block_size=64;
+
+	/** first node of every tree */
+	std::vector<index_t> m_roots;
+
+	/** split attribute of every node, -1 for leaves */
+	std::vector<int32_t> m_attribute;
+
+	/** vectors with attribute values up to the threshold go left */
+	std::vector<float64_t> m_threshold;
+
+	/** index of the right child of every node */
+	std::vector<index_t> m_right;
+
+	/** label of every node */
+	std::vector<float64_t> m_label;
+
+	/** training weight of the vectors of every node */
+	std::vector<float64_t> m_cover;
+
+	/** first value going left of nominal splits, -1 for continuous */
+	std::vector<index_t> m_nominal_begin;
+
+	/** one past the last value going left of nominal splits */
+	std::vector<index_t> m_nominal_end;
+
+	/** values going left of all nominal splits */
+	std::vector<float64_t> m_nominal_values;
+
+	/** largest split attribute of all trees */
+	int32_t m_max_attribute;
+
+	/** largest depth of a leaf of all trees */
+	int32_t m_max_depth;
+};
+} /* namespace shogun */
+
+#endif /* FLATTREEENSEMBLE_H__ */
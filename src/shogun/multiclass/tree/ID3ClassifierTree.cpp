@@ -28,14 +28,15 @@
  * either expressed or implied, of the Shogun Development Team.
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/MulticlassAccuracy.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/View.h>
 #include <shogun/mathematics/Math.h>
-#include <shogun/mathematics/Statistics.h>
 #include <shogun/multiclass/tree/FeatureImportanceTree.h>
 #include <shogun/multiclass/tree/ID3ClassifierTree.h>
+#include <shogun/multiclass/tree/SplitStatistics.h>
 
 #include <utility>
 
@@ -136,21 +137,33 @@ std::shared_ptr<TreeMachineNode<id3TreeNodeData>> ID3ClassifierTree::id3train(co
 	if (feature_id_vector.vlen == 0)
 		return node;
 
-	// else get the feature with the highest informational gain
+	// else get the feature with the highest informational gain, the
+	// features are evaluated in parallel and compared in order
+	const int32_t num_feats = feats->get_num_features();
+	SGMatrix<float64_t> mat = feats->get_feature_matrix();
+	SGVector<float64_t> label_values = class_labels->get_labels();
+	SGVector<float64_t> gains(num_feats);
+	SGVector<float64_t> impurities(num_feats);
+
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num_feats; i++)
+		gains[i] = informational_gain_attribute(i, mat, label_values, impurities[i]);
+
 	float64_t max = 0;
 	int32_t best_feature_index = -1;
-	float64_t impurity = 0.0, max_impurity = 0.0;
-	for (int32_t i=0; i<feats->get_num_features(); i++)
+	for (int32_t i=0; i<num_feats; i++)
 	{
-		float64_t gain =
-		    informational_gain_attribute(i, feats, class_labels, impurity);
-		max_impurity = std::max(impurity, max_impurity);
-		if (gain >= max)
+		if (gains[i] >= max)
 		{
-			max = gain;
+			max = gains[i];
 			best_feature_index = i;
 		}
 	}
+	float64_t impurity = impurities[num_feats-1];
+
+	// rounding may leave all gains slightly below zero
+	if (best_feature_index == -1)
+		return node;
 
 	// get feature values for the best feature chosen
 	SGVector<float64_t> best_feature_values = SGVector<float64_t>(num_vecs);
@@ -223,84 +236,20 @@ std::shared_ptr<TreeMachineNode<id3TreeNodeData>> ID3ClassifierTree::id3train(co
 }
 
 float64_t ID3ClassifierTree::informational_gain_attribute(
-    int32_t attr_no, const std::shared_ptr<Features>& data,
-    const std::shared_ptr<MulticlassLabels>& class_labels, float64_t& impurity)
-{
-	require(data,"Data required for information gain calculation");
-	require(data->get_feature_class()==C_DENSE,
-		"Dense data required for information gain calculation");
-
-	float64_t gain = 0;
-	auto feats = data->as<DenseFeatures<float64_t>>();
-	int32_t num_vecs = feats->get_num_vectors();
-
-	// get attribute values for attribute
-	SGVector<float64_t> attribute_values = SGVector<float64_t>(num_vecs);
-
-	for (int32_t i=0; i<num_vecs; i++)
-		attribute_values[i] = (feats->get_feature_vector(i))[attr_no];
-
-	auto attribute_labels = std::make_shared<MulticlassLabels>(attribute_values);
-	SGVector<float64_t> attr_val_unique = attribute_labels->get_unique_labels();
-
-	for (int32_t i=0; i<attr_val_unique.vlen; i++)
-	{
-		// calculate class entropy for the specific attribute_value
-		int32_t attr_count=0;
-
-		for (int32_t j=0; j<num_vecs; j++)
-		{
-			if (attribute_values[j] == attr_val_unique[i])
-				attr_count++;
-		}
-
-		SGVector<float64_t> sub_class = SGVector<float64_t>(attr_count);
-		int32_t count = 0;
-
-		for (int32_t j=0; j<num_vecs; j++)
-		{
-			if (attribute_values[j] == attr_val_unique[i])
-				sub_class[count++] = class_labels->get_label(j);
-		}
-
-		auto sub_labels = std::make_shared<MulticlassLabels>(sub_class);
-		float64_t sub_entropy = entropy(sub_labels);
-		gain += sub_entropy*(attr_count-0.f)/(num_vecs-0.f);
-
-
-	}
-
-	float64_t data_entropy = entropy(class_labels);
-	impurity = gain;
-	gain = data_entropy-gain;
-
-
-
-	return gain;
-}
-
-float64_t ID3ClassifierTree::entropy(const std::shared_ptr<MulticlassLabels>& labels)
+    int32_t attr_no, const SGMatrix<float64_t>& mat,
+    const SGVector<float64_t>& labels, float64_t& impurity)
 {
-	SGVector<float64_t> log_ratios = SGVector<float64_t>
-			(labels->get_unique_labels().size());
-
-	for (int32_t i=0;i<labels->get_unique_labels().size();i++)
-	{
-		int32_t count = 0;
+	SGVector<float64_t> attribute_values(mat.num_cols);
+	for (int32_t i=0; i<mat.num_cols; i++)
+		attribute_values[i] = mat(attr_no, i);
 
-		for (int32_t j=0;j<labels->get_num_labels();j++)
-		{
-			if (labels->get_unique_labels()[i] == labels->get_label(j))
-					count++;
-		}
-
-		log_ratios[i] = (count-0.f)/(labels->get_num_labels()-0.f);
-
-		if (log_ratios[i] != 0)
-			log_ratios[i] = std::log(log_ratios[i]);
-	}
+	SGMatrix<int32_t> counts;
+	SGMatrix<float64_t> weight_table;
+	SplitStatistics::contingency_table(
+	    attribute_values, labels, SGVector<float64_t>(), counts, weight_table);
 
-	return Statistics::entropy(log_ratios.vector, log_ratios.vlen);
+	impurity = SplitStatistics::conditional_entropy(weight_table);
+	return SplitStatistics::class_entropy(weight_table)-impurity;
 }
 
 void ID3ClassifierTree::prune_tree_machine(const std::shared_ptr<DenseFeatures<float64_t>>& feats,
@@ -137,21 +137,15 @@ private:
 	/** informational gain attribute for selecting best feature at each node of ID3 Tree
 	 *
 	 * @param attr_no index to the chosen feature in data matrix supplied
-	 * @param data data matrix
-	 * @param class_labels classes to which corresponding data vectors belong
+	 * @param mat data matrix
+	 * @param labels classes to which corresponding data vectors belong
+	 * @param impurity entropy of the classes within the values of the
+	 * feature
 	 * @return informational gain of the chosen feature
 	 */
 	float64_t informational_gain_attribute(
-		int32_t attr_no, const std::shared_ptr<Features>& data,
-		const std::shared_ptr<MulticlassLabels>& class_labels,
-		float64_t& impurity);
-
-	/** computes entropy (aka randomness) in data
-	 *
-	 * @param labels labels of parameters chosen
-	 * @return entropy
-	 */
-	float64_t entropy(const std::shared_ptr<MulticlassLabels>& labels);
+		int32_t attr_no, const SGMatrix<float64_t>& mat,
+		const SGVector<float64_t>& labels, float64_t& impurity);
 
 	/** recursive tree pruning method - called within prune_tree method
 	 *
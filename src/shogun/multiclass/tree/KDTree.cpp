@@ -54,35 +54,16 @@ float64_t KDTree::min_dist(std::shared_ptr<bnode_t> node,float64_t* feat, int32_
 	return actual_dists(dist);
 }
 
-float64_t KDTree::min_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder)
+float64_t KDTree::min_dist_flat(index_t node, const float64_t* feat, int32_t dim) const
 {
-	SGVector<float64_t> nodeq_lower=nodeq->data.bbox_lower;
-	SGVector<float64_t> nodeq_upper=nodeq->data.bbox_upper;
-	SGVector<float64_t> noder_lower=noder->data.bbox_lower;
-	SGVector<float64_t> noder_upper=noder->data.bbox_upper;
+	const float64_t* lower=m_flat_lower.get_column_vector(node);
+	const float64_t* upper=m_flat_upper.get_column_vector(node);
 	float64_t dist=0;
-	for(int32_t i=0;i<noder_lower.vlen;i++)
-	{
-		float64_t d1=nodeq_lower[i]-noder_upper[i];
-		float64_t d2=noder_lower[i]-nodeq_upper[i];
-		dist+=add_dim_dist(0.5*(d1+Math::abs(d1)+d2+Math::abs(d2)));
-	}
-
-	return actual_dists(dist);
-}
-
-float64_t KDTree::max_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder)
-{
-	SGVector<float64_t> nodeq_lower=nodeq->data.bbox_lower;
-	SGVector<float64_t> nodeq_upper=nodeq->data.bbox_upper;
-	SGVector<float64_t> noder_lower=noder->data.bbox_lower;
-	SGVector<float64_t> noder_upper=noder->data.bbox_upper;
-	float64_t dist=0;
-	for(int32_t i=0;i<noder_lower.vlen;i++)
+	for (int32_t i=0;i<dim;i++)
 	{
-		float64_t d1=Math::abs(nodeq_lower[i]-noder_upper[i]);
-		float64_t d2=Math::abs(noder_lower[i]-nodeq_upper[i]);
-		dist+=add_dim_dist(Math::max(d1,d2));
+		float64_t dim_dist=(lower[i]-feat[i])+Math::abs(feat[i]-lower[i]);
+		dim_dist+=(feat[i]-upper[i])+Math::abs(feat[i]-upper[i]);
+		dist+=add_dim_dist(0.5*dim_dist);
 	}
 
 	return actual_dists(dist);
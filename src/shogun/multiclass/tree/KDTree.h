@@ -70,21 +70,15 @@ private:
 	 */
 	float64_t min_dist(std::shared_ptr<bnode_t> node,float64_t* feat, int32_t dim) override;
 
-	/** find minimum distance between 2 nodes
+	/** find minimum distance between a node of the flattened tree and a
+	 * query vector
 	 *
-	 * @param nodeq node containing active query vectors
-	 * @param noder node containing active training vectors
-	 * @return min distance between 2 nodes
-	 */
-	float64_t min_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder) override;
-
-	/** find max distance between 2 nodes
-	 *
-	 * @param nodeq node containing active query vectors
-	 * @param noder node containing active training vectors
-	 * @return max distance between 2 nodes
+	 * @param node index of the node in m_flat_nodes
+	 * @param feat query vector
+	 * @param dim dimensions of query vector
+	 * @return min distance
 	 */
-	float64_t max_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder) override;
+	float64_t min_dist_flat(index_t node, const float64_t* feat, int32_t dim) const override;
 
 	/** get min as well as max distance of a node from a point
 	 *
@@ -48,6 +48,16 @@ KNNHeap::KNNHeap(int32_t k)
 	}
 }
 
+void KNNHeap::reset()
+{
+	m_sorted=false;
+	for (int32_t i=0;i<m_capacity;i++)
+	{
+		m_dists[i]=Math::MAX_REAL_NUMBER;
+		m_inds[i]=0;
+	}
+}
+
 void KNNHeap::push(index_t index, float64_t dist)
 {
 	if (dist>m_dists[0])
@@ -63,6 +63,9 @@ public:
 	 */
 	void push(index_t index, float64_t dist);
 
+	/** forget all pushed values, keeps the capacity */
+	void reset();
+
 	/** max distance
 	 *
 	 * @return max distance value stored in the heap
@@ -31,6 +31,8 @@
 #include <shogun/multiclass/tree/NbodyTree.h>
 #include <shogun/distributions/KernelDensity.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 CNbodyTree::CNbodyTree(int32_t leaf_size, EDistanceType d)
@@ -53,7 +55,13 @@ void CNbodyTree::build_tree(const std::shared_ptr<DenseFeatures<float64_t>>& dat
 	m_vec_id=SGVector<index_t>(m_data.num_cols);
 	m_vec_id.range_fill(0);
 
-	set_root(recursive_build(0,m_data.num_cols-1));
+	std::shared_ptr<bnode_t> root;
+#pragma omp parallel
+#pragma omp single
+	root=recursive_build(0,m_data.num_cols-1);
+
+	set_root(root);
+	flatten_tree();
 }
 
 void CNbodyTree::query_knn(const std::shared_ptr<DenseFeatures<float64_t>>& data, int32_t k)
@@ -61,23 +69,34 @@ void CNbodyTree::query_knn(const std::shared_ptr<DenseFeatures<float64_t>>& data
 	require(data,"Query data not supplied");
 	require(data->get_num_features()==m_data.num_rows,"query data dimension should be same as training data dimension");
 
+	// the tree was loaded rather than built
+	if (m_flat_nodes.empty())
+		flatten_tree();
+	require(!m_flat_nodes.empty(),"tree has not been built yet");
+
 	m_knn_done=true;
 	SGMatrix<float64_t> qfeats=data->get_feature_matrix();
 	m_knn_dists=SGMatrix<float64_t>(k,qfeats.num_cols);
 	m_knn_indices=SGMatrix<index_t>(k,qfeats.num_cols);
 	int32_t dim=qfeats.num_rows;
 
-	for (int32_t i=0;i<qfeats.num_cols;i++)
+	const index_t num_queries=qfeats.num_cols;
+	const index_t num_blocks=(num_queries+query_block_size-1)/query_block_size;
+#pragma omp parallel for schedule(dynamic)
+	for (index_t b=0;b<num_blocks;b++)
 	{
-		auto heap=std::make_shared<KNNHeap>(k);
-		std::shared_ptr<bnode_t> root;
-		if (m_root)
-			root=m_root->as<bnode_t>();
-
-		float64_t mdist=min_dist(root,qfeats.matrix+i*dim,dim);
-		query_knn_single(heap,mdist,root,qfeats.matrix+i*dim,dim);
-		sg_memcpy(m_knn_dists.matrix+i*k,heap->get_dists(),k*sizeof(float64_t));
-		sg_memcpy(m_knn_indices.matrix+i*k,heap->get_indices(),k*sizeof(index_t));
+		KNNHeap heap(k);
+		const index_t end=std::min(num_queries,(b+1)*query_block_size);
+		for (index_t i=b*query_block_size;i<end;i++)
+		{
+			const float64_t* query=qfeats.get_column_vector(i);
+			heap.reset();
+
+			float64_t mdist=min_dist_flat(0,query,dim);
+			query_knn_single(heap,mdist,0,query,dim);
+			sg_memcpy(m_knn_dists.get_column_vector(i),heap.get_dists(),k*sizeof(float64_t));
+			sg_memcpy(m_knn_indices.get_column_vector(i),heap.get_indices(),k*sizeof(index_t));
+		}
 	}
 }
 
@@ -90,12 +109,13 @@ SGVector<float64_t> CNbodyTree::log_kernel_density(SGMatrix<float64_t> test, EKe
 	float64_t log_rtol = std::log(rtol);
 	float64_t log_kernel_norm=KernelDensity::log_norm(kernel,h,dim);
 	SGVector<float64_t> log_density(test.num_cols);
+	std::shared_ptr<bnode_t> root;
+	if (m_root)
+		root=m_root->as<bnode_t>();
+
+#pragma omp parallel for schedule(dynamic,query_block_size)
 	for (int32_t i=0;i<test.num_cols;i++)
 	{
-		std::shared_ptr<bnode_t> root;
-		if (m_root)
-			root=m_root->as<bnode_t>();
-
 		float64_t lower_dist=0;
 		float64_t upper_dist=0;
 		min_max_dist(test.matrix+i*dim,root,lower_dist,upper_dist,dim);
@@ -114,36 +134,55 @@ SGVector<float64_t> CNbodyTree::log_kernel_density(SGMatrix<float64_t> test, EKe
 	return log_density;
 }
 
-SGVector<float64_t> CNbodyTree::log_kernel_density_dual(SGMatrix<float64_t> test, SGVector<index_t> qid, const std::shared_ptr<bnode_t>& qroot, EKernelType kernel, float64_t h, float64_t atol, float64_t rtol)
+SGVector<float64_t> CNbodyTree::log_kernel_density_dual(const std::shared_ptr<CNbodyTree>& query_tree, EKernelType kernel, float64_t h, float64_t atol, float64_t rtol)
 {
+	require(query_tree,"Query tree not supplied");
 	int32_t dim=m_data.num_rows;
-	require(test.num_rows==dim,"dimensions of training data and test data should be the same");
-
-	float64_t log_atol = std::log(atol * m_data.num_cols * test.num_cols);
-	float64_t log_rtol = std::log(rtol);
-	float64_t log_kernel_norm=KernelDensity::log_norm(kernel,h,dim);
-	SGVector<float64_t> log_density(test.num_cols);
-	log_density.fill_vector(log_density.vector,log_density.vlen,-Math::INFTY);
-
-	std::shared_ptr<bnode_t> rroot;
-	if (m_root)
-		rroot=m_root->as<bnode_t>();
+	require(query_tree->m_data.num_rows==dim,"dimensions of training data and test data should be the same");
+	require(query_tree->m_dist==m_dist,"query tree and reference tree should use the same distance metric");
+
+	// the trees were loaded rather than built
+	if (m_flat_nodes.empty())
+		flatten_tree();
+	if (query_tree->m_flat_nodes.empty())
+		query_tree->flatten_tree();
+	require(!m_flat_nodes.empty() && !query_tree->m_flat_nodes.empty(),"trees have not been built yet");
+
+	const KDEParams params={kernel,h,std::log(atol),std::log(rtol),KernelDensity::log_norm(kernel,h,dim)};
+	const index_t num_queries=query_tree->m_data.num_cols;
+	SGVector<float64_t> log_density(num_queries);
+	log_density.set_const(-Math::INFTY);
+
+	// query subtrees own disjoint ranges of the query points, so they are
+	// traversed against the reference tree independently
+	const index_t task_size=std::max(query_block_size,num_queries/256);
+	std::vector<index_t> tasks;
+	std::vector<index_t> stack(1,0);
+	while (!stack.empty())
+	{
+		const FlatNode& node=query_tree->m_flat_nodes[stack.back()];
+		if (node.left<0 || node.end_idx-node.start_idx+1<=task_size)
+		{
+			tasks.push_back(stack.back());
+			stack.pop_back();
+			continue;
+		}
 
-	float64_t upper_dist=max_dist_dual(rroot,qroot);
-	float64_t lower_dist=min_dist_dual(rroot,qroot);
-	float64_t min_bound = std::log(test.num_cols) + std::log(m_data.num_cols) +
-	                      KernelDensity::log_kernel(kernel, upper_dist, h);
-	float64_t max_bound = std::log(test.num_cols) + std::log(m_data.num_cols) +
-	                      KernelDensity::log_kernel(kernel, lower_dist, h);
-	float64_t spread=logdiffexp(max_bound,min_bound);
+		stack.back()=node.right;
+		stack.push_back(node.left);
+	}
 
-	kde_dual(rroot,qroot,qid,test,log_density,kernel,h,log_atol,log_rtol,log_kernel_norm,min_bound,spread,min_bound,spread);
+	const index_t num_tasks=tasks.size();
+#pragma omp parallel for schedule(dynamic)
+	for (index_t t=0;t<num_tasks;t++)
+		kde_dual(*query_tree,tasks[t],0,params,log_density.vector);
 
-	float64_t log_n = std::log(m_data.num_cols);
-	for (int32_t i=0;i<test.num_cols;i++)
-		log_density[i]=log_density[i]+log_kernel_norm-log_n;
+	SGVector<float64_t> ret(num_queries);
+	const float64_t log_n=std::log(m_data.num_cols);
+	for (index_t i=0;i<num_queries;i++)
+		ret[query_tree->m_vec_id[i]]=log_density[i]+params.log_norm-log_n;
 
-	return log_density;
+	return ret;
 }
 
 SGMatrix<float64_t> CNbodyTree::get_knn_dists()
@@ -164,27 +203,25 @@ SGMatrix<index_t> CNbodyTree::get_knn_indices()
 	return SGMatrix<index_t>();
 }
 
-void CNbodyTree::query_knn_single(const std::shared_ptr<KNNHeap>& heap, float64_t mdist, const std::shared_ptr<bnode_t>& node, float64_t* arr, int32_t dim)
+void CNbodyTree::query_knn_single(KNNHeap& heap, float64_t mdist, index_t node, const float64_t* arr, int32_t dim) const
 {
-	if (mdist>heap->get_max_dist())
+	if (mdist>heap.get_max_dist())
 		return;
 
-	if (node->data.is_leaf)
+	const FlatNode& current=m_flat_nodes[node];
+	if (current.left<0)
 	{
-		index_t start=node->data.start_idx;
-		index_t end=node->data.end_idx;
-
-		for (int32_t i=start;i<=end;i++)
-			heap->push(m_vec_id[i],distance(m_vec_id[i],arr,dim));
+		for (index_t i=current.start_idx;i<=current.end_idx;i++)
+			heap.push(m_vec_id[i],distance(m_vec_id[i],arr,dim));
 
 		return;
 	}
 
-	auto cleft=node->left();
-	auto cright=node->right();
+	index_t cleft=current.left;
+	index_t cright=current.right;
 
-	float64_t min_dist_left=min_dist(cleft,arr,dim);
-	float64_t min_dist_right=min_dist(cright,arr,dim);
+	float64_t min_dist_left=min_dist_flat(cleft,arr,dim);
+	float64_t min_dist_right=min_dist_flat(cright,arr,dim);
 
 	if (min_dist_left<=min_dist_right)
 	{
@@ -196,12 +233,54 @@ void CNbodyTree::query_knn_single(const std::shared_ptr<KNNHeap>& heap, float64_
 		query_knn_single(heap,min_dist_right,cright,arr,dim);
 		query_knn_single(heap,min_dist_left,cleft,arr,dim);
 	}
+}
+
+void CNbodyTree::flatten_tree()
+{
+	m_flat_nodes.clear();
+	if (!m_root)
+		return;
 
+	std::vector<bnode_t*> tree_nodes;
+	flatten_node(m_root->as<bnode_t>(),m_flat_nodes,tree_nodes);
 
+	const index_t num_nodes=m_flat_nodes.size();
+	const index_t dim=m_data.num_rows;
+	const bool has_center=tree_nodes[0]->data.center.vlen>0;
+	m_flat_lower=SGMatrix<float64_t>(dim,num_nodes);
+	m_flat_upper=SGMatrix<float64_t>(dim,num_nodes);
+	m_flat_center=has_center ? SGMatrix<float64_t>(dim,num_nodes) : SGMatrix<float64_t>();
+	m_flat_radius=SGVector<float64_t>(num_nodes);
 
+	for (index_t i=0;i<num_nodes;i++)
+	{
+		const NbodyTreeNodeData& data=tree_nodes[i]->data;
+		std::copy_n(data.bbox_lower.vector,dim,m_flat_lower.get_column_vector(i));
+		std::copy_n(data.bbox_upper.vector,dim,m_flat_upper.get_column_vector(i));
+		if (has_center)
+			std::copy_n(data.center.vector,dim,m_flat_center.get_column_vector(i));
+		m_flat_radius[i]=data.radius;
+	}
 }
 
-float64_t CNbodyTree::distance(index_t vec, float64_t* arr, int32_t dim)
+index_t CNbodyTree::flatten_node(const std::shared_ptr<bnode_t>& node, std::vector<FlatNode>& nodes, std::vector<bnode_t*>& tree_nodes)
+{
+	const index_t idx=nodes.size();
+	nodes.push_back({node->data.start_idx,node->data.end_idx,-1,-1});
+	tree_nodes.push_back(node.get());
+
+	if (!node->data.is_leaf)
+	{
+		index_t left=flatten_node(node->left(),nodes,tree_nodes);
+		index_t right=flatten_node(node->right(),nodes,tree_nodes);
+		nodes[idx].left=left;
+		nodes[idx].right=right;
+	}
+
+	return idx;
+}
+
+float64_t CNbodyTree::distance(index_t vec, const float64_t* arr, int32_t dim) const
 {
 	float64_t ret=0;
 	for (int32_t i=0;i<dim;i++)
@@ -227,8 +306,14 @@ std::shared_ptr<BinaryTreeMachineNode<NbodyTreeNodeData>> CNbodyTree::recursive_
 	index_t mid=(end+start)/2;
 	partition(dim,start,end,mid);
 
-	auto child_left=recursive_build(start,mid);
+	// partitioning only moves the vector ids between start and end, so both
+	// halves can be built concurrently
+	std::shared_ptr<bnode_t> child_left;
+#pragma omp task shared(child_left) if(mid-start+1>=task_threshold)
+	child_left=recursive_build(start,mid);
+
 	auto child_right=recursive_build(mid+1,end);
+#pragma omp taskwait
 
 	node->left(child_left);
 	node->right(child_right);
@@ -299,230 +384,111 @@ void CNbodyTree::get_kde_single(const std::shared_ptr<bnode_t>& node,float64_t*
 
 }
 
-void CNbodyTree::kde_dual(const std::shared_ptr<bnode_t>& refnode, const std::shared_ptr<bnode_t>& querynode, SGVector<index_t> qid, SGMatrix<float64_t> qdata, SGVector<float64_t> log_density, EKernelType kernel_type, float64_t h, float64_t log_atol, float64_t log_rtol, float64_t log_norm, float64_t min_bound_node, float64_t spread_node, float64_t &min_bound_global, float64_t &spread_global)
+void CNbodyTree::min_max_dist_dual_flat(const CNbodyTree& query, index_t qnode, index_t rnode, float64_t& lower, float64_t& upper) const
 {
-	int32_t dim=m_data.num_rows;
-	float64_t n_node =
-	    std::log(refnode->data.end_idx - refnode->data.start_idx + 1) +
-	    std::log(querynode->data.end_idx - querynode->data.start_idx + 1);
-	float64_t n_total = std::log(m_data.num_cols * qdata.num_cols);
+	const int32_t dim=m_data.num_rows;
+	const float64_t* qlower=query.m_flat_lower.get_column_vector(qnode);
+	const float64_t* qupper=query.m_flat_upper.get_column_vector(qnode);
+	const float64_t* rlower=m_flat_lower.get_column_vector(rnode);
+	const float64_t* rupper=m_flat_upper.get_column_vector(rnode);
+
+	lower=0;
+	upper=0;
+	for (int32_t i=0;i<dim;i++)
+	{
+		float64_t gap=Math::max(0.0,Math::max(qlower[i]-rupper[i],rlower[i]-qupper[i]));
+		float64_t span=Math::max(qupper[i]-rlower[i],rupper[i]-qlower[i]);
+		lower+=add_dim_dist(gap);
+		upper+=add_dim_dist(span);
+	}
 
-	bool global_criterion=(log_norm+spread_global)<=logsumexp(log_atol,log_rtol+log_norm+min_bound_global);
-	bool local_criterion=(log_norm+spread_node+n_total-n_node)<=logsumexp(log_atol,log_rtol+log_norm+min_bound_node);
+	lower=actual_dists(lower);
+	upper=actual_dists(upper);
 
-	// global bound criterion met || local bound criterion met
-	if (global_criterion || local_criterion)
+	// balls of ball trees can be tighter than the boxes
+	if (m_flat_center.num_cols>0 && query.m_flat_center.num_cols>0)
 	{
-		// log density of all query points in the node is increased by K(mean + spread/2)
-		float64_t center_density =
-		    logsumexp(min_bound_node, spread_node - std::log(2)) -
-		    std::log(querynode->data.end_idx - querynode->data.start_idx + 1);
-		for (int32_t i=querynode->data.start_idx;i<=querynode->data.end_idx;i++)
-			log_density[qid[i]]=logsumexp(log_density[qid[i]],center_density);
-
-		return;
+		const float64_t* qcenter=query.m_flat_center.get_column_vector(qnode);
+		const float64_t* rcenter=m_flat_center.get_column_vector(rnode);
+		float64_t dist=0;
+		for (int32_t i=0;i<dim;i++)
+			dist+=add_dim_dist(qcenter[i]-rcenter[i]);
+
+		dist=actual_dists(dist);
+		const float64_t radii=query.m_flat_radius[qnode]+m_flat_radius[rnode];
+		lower=Math::max(lower,dist-radii);
+		upper=Math::min(upper,dist+radii);
 	}
+}
 
-	// both are leaves
-	if (refnode->data.is_leaf && querynode->data.is_leaf)
-	{
-		min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-		spread_global=logdiffexp(spread_global,spread_node);
+void CNbodyTree::kde_dual(const CNbodyTree& query, index_t qnode, index_t rnode, const KDEParams& params, float64_t* log_density) const
+{
+	const FlatNode& qcurrent=query.m_flat_nodes[qnode];
+	const FlatNode& rcurrent=m_flat_nodes[rnode];
+	const index_t query_n=qcurrent.end_idx-qcurrent.start_idx+1;
+	const index_t ref_n=rcurrent.end_idx-rcurrent.start_idx+1;
 
-		// point by point evavuation of density
-		for (int32_t i=querynode->data.start_idx;i<=querynode->data.end_idx;i++)
-		{
-			float64_t q=-Math::INFTY;
-			for (int32_t j=refnode->data.start_idx;j<=refnode->data.end_idx;j++)
-			{
-				float64_t pt_eval=KernelDensity::log_kernel(kernel_type,distance(m_vec_id[j],qdata.matrix+dim*qid[i],dim),h);
-				q=logsumexp(q,pt_eval);
-			}
+	float64_t lower_dist=0;
+	float64_t upper_dist=0;
+	min_max_dist_dual_flat(query,qnode,rnode,lower_dist,upper_dist);
+	const float64_t max_kernel=KernelDensity::log_kernel(params.kernel,lower_dist,params.h);
+	const float64_t min_kernel=KernelDensity::log_kernel(params.kernel,upper_dist,params.h);
+
+	// approximating every kernel value by the midpoint of the bounds makes
+	// an error of at most half their spread, pairs beyond the support of
+	// compact kernels have no spread and are pruned exactly
+	const float64_t spread=logdiffexp(max_kernel,min_kernel)-std::log(2);
+	if (params.log_norm+spread<=logsumexp(params.log_atol,params.log_rtol+params.log_norm+min_kernel))
+	{
+		const float64_t contribution=std::log(ref_n)+logsumexp(max_kernel,min_kernel)-std::log(2);
+		if (contribution==-Math::INFTY)
+			return;
 
-			min_bound_global=logsumexp(min_bound_global,q);
-			log_density[qid[i]]=logsumexp(log_density[qid[i]],q);
-		}
+		for (index_t i=qcurrent.start_idx;i<=qcurrent.end_idx;i++)
+			log_density[i]=logsumexp(log_density[i],contribution);
 
 		return;
 	}
 
-	// if query node is leaf - just recurse on the reference tree
-	if (querynode->data.is_leaf)
+	// both are leaves, point by point evaluation of density
+	if (qcurrent.left<0 && rcurrent.left<0)
 	{
-		auto lchild=refnode->left();
-		auto rchild=refnode->right();
-		int32_t queryn=querynode->data.end_idx-querynode->data.start_idx+1;
-
-		// compute bounds for query node and left child of ref node
-		float64_t lower_dist=min_dist_dual(querynode,lchild);
-		float64_t upper_dist=max_dist_dual(querynode,lchild);
-		int32_t refn_l=lchild->data.end_idx-lchild->data.start_idx+1;
-		float64_t lower_bound_childl =
-		    std::log(queryn) + std::log(refn_l) +
-		    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childl = logdiffexp(
-		    std::log(queryn) + std::log(refn_l) +
-		        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childl);
-
-		// compute bounds for query node and right child of ref node
-		lower_dist=min_dist_dual(querynode,rchild);
-		upper_dist=max_dist_dual(querynode,rchild);
-		int32_t refn_r=rchild->data.end_idx-rchild->data.start_idx+1;
-		float64_t lower_bound_childr =
-		    std::log(queryn) + std::log(refn_r) +
-		    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childr = logdiffexp(
-		    std::log(queryn) + std::log(refn_r) +
-		        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childr);
-
-		// update global bounds
-		min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childl);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childr);
-
-		spread_global=logdiffexp(spread_global,spread_node);
-		spread_global=logsumexp(spread_global,spread_childl);
-		spread_global=logsumexp(spread_global,spread_childr);
+		const int32_t dim=m_data.num_rows;
+		std::vector<float64_t> pt_eval(ref_n);
+		for (index_t i=qcurrent.start_idx;i<=qcurrent.end_idx;i++)
+		{
+			const float64_t* arr=query.m_data.get_column_vector(query.m_vec_id[i]);
+			float64_t max_eval=-Math::INFTY;
+			for (index_t j=0;j<ref_n;j++)
+			{
+				pt_eval[j]=KernelDensity::log_kernel(params.kernel,distance(m_vec_id[rcurrent.start_idx+j],arr,dim),params.h);
+				max_eval=Math::max(max_eval,pt_eval[j]);
+			}
 
-		kde_dual(lchild,querynode,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childl,spread_childl, min_bound_global,spread_global);
-		kde_dual(rchild,querynode,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childr,spread_childr, min_bound_global,spread_global);
+			if (max_eval==-Math::INFTY)
+				continue;
 
+			float64_t sum=0;
+			for (index_t j=0;j<ref_n;j++)
+				sum+=std::exp(pt_eval[j]-max_eval);
 
+			log_density[i]=logsumexp(log_density[i],max_eval+std::log(sum));
+		}
 
 		return;
 	}
 
-	// if reference node is leaf - just recurse on the query tree
-	if (refnode->data.is_leaf)
+	// split the larger node, the query node stays within its subtree
+	if (rcurrent.left<0 || (qcurrent.left>=0 && query_n>=ref_n))
 	{
-		int32_t ref_n=refnode->data.end_idx-refnode->data.start_idx+1;
-		auto lchild=querynode->left();
-		auto rchild=querynode->right();
-
-		int32_t query_nl=lchild->data.end_idx-lchild->data.start_idx+1;
-		int32_t query_nr=rchild->data.end_idx-rchild->data.start_idx+1;
-
-		// compute bounds for left child of query node and ref node
-		float64_t lower_dist=min_dist_dual(refnode,lchild);
-		float64_t upper_dist=max_dist_dual(refnode,lchild);
-		float64_t lower_bound_childl =
-		    std::log(query_nl) + std::log(ref_n) +
-		    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childl = logdiffexp(
-		    std::log(query_nl) + std::log(ref_n) +
-		        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childl);
-
-		// compute bounds for right child of query node and ref node
-		lower_dist=min_dist_dual(querynode,rchild);
-		upper_dist=max_dist_dual(querynode,rchild);
-		float64_t lower_bound_childr =
-		    std::log(query_nr) + std::log(ref_n) +
-		    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-		float64_t spread_childr = logdiffexp(
-		    std::log(query_nr) + std::log(ref_n) +
-		        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-		    lower_bound_childr);
-
-		// update global bounds
-		min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childl);
-		min_bound_global=logsumexp(min_bound_global,lower_bound_childr);
-
-		spread_global=logdiffexp(spread_global,spread_node);
-		spread_global=logsumexp(spread_global,spread_childl);
-		spread_global=logsumexp(spread_global,spread_childr);
-
-		kde_dual(refnode,lchild,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childl,spread_childl,min_bound_global,spread_global);
-		kde_dual(refnode,rchild,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_childr,spread_childr,min_bound_global,spread_global);
-
-
-
-		return;
+		kde_dual(query,qcurrent.left,rnode,params,log_density);
+		kde_dual(query,qcurrent.right,rnode,params,log_density);
+	}
+	else
+	{
+		kde_dual(query,qnode,rcurrent.left,params,log_density);
+		kde_dual(query,qnode,rcurrent.right,params,log_density);
 	}
-
-	// if none of above -  apply 4 way recursion in both trees: left-left, left-right, right-left, right-right
-	auto refchildl=refnode->left();
-	auto refchildr=refnode->right();
-	auto querychildl=querynode->left();
-	auto querychildr=querynode->right();
-
-	float64_t refn_l=refchildl->data.end_idx-refchildl->data.start_idx+1;
-	float64_t refn_r=refchildr->data.end_idx-refchildr->data.start_idx+1;
-	float64_t queryn_l=querychildl->data.end_idx-querychildl->data.start_idx+1;
-	float64_t queryn_r=querychildr->data.end_idx-querychildr->data.start_idx+1;
-
-	// left child-left child bounds
-	float64_t lower_dist=min_dist_dual(querychildl,refchildl);
-	float64_t upper_dist=max_dist_dual(querychildl,refchildl);
-	float64_t lower_bound_ll =
-	    std::log(queryn_l) + std::log(refn_l) +
-	    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_ll = logdiffexp(
-	    std::log(queryn_l) + std::log(refn_l) +
-	        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_ll);
-
-	// left-right bounds
-	lower_dist=min_dist_dual(querychildl,refchildr);
-	upper_dist=max_dist_dual(querychildl,refchildr);
-	float64_t lower_bound_lr =
-	    std::log(queryn_l) + std::log(refn_r) +
-	    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_lr = logdiffexp(
-	    std::log(queryn_l) + std::log(refn_r) +
-	        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_lr);
-
-	// right-left bounds
-	lower_dist=min_dist_dual(querychildr,refchildl);
-	upper_dist=max_dist_dual(querychildr,refchildl);
-	float64_t lower_bound_rl =
-	    std::log(queryn_r) + std::log(refn_l) +
-	    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_rl = logdiffexp(
-	    std::log(queryn_r) + std::log(refn_l) +
-	        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_rl);
-
-	// right-right bounds
-	lower_dist=min_dist_dual(querychildr,refchildr);
-	upper_dist=max_dist_dual(querychildr,refchildr);
-	float64_t lower_bound_rr =
-	    std::log(queryn_r) + std::log(refn_r) +
-	    KernelDensity::log_kernel(kernel_type, upper_dist, h);
-	float64_t spread_rr = logdiffexp(
-	    std::log(queryn_r) + std::log(refn_r) +
-	        KernelDensity::log_kernel(kernel_type, lower_dist, h),
-	    lower_bound_rr);
-
-	// update global bound and spread
-	min_bound_global=logdiffexp(min_bound_global,min_bound_node);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_ll);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_lr);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_rl);
-	min_bound_global=logsumexp(min_bound_global,lower_bound_rr);
-
-	spread_global=logdiffexp(spread_global,spread_node);
-	spread_global=logsumexp(spread_global,spread_ll);
-	spread_global=logsumexp(spread_global,spread_lr);
-	spread_global=logsumexp(spread_global,spread_rl);
-	spread_global=logsumexp(spread_global,spread_rr);
-
-	// left-left and left-right recursions
-	kde_dual(refchildl,querychildl,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_ll,spread_ll, min_bound_global,spread_global);
-	kde_dual(refchildr,querychildl,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_lr,spread_lr, min_bound_global,spread_global);
-
-	// right-left and right-right recursions
-	kde_dual(refchildl,querychildr,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_rl,spread_rl, min_bound_global,spread_global);
-	kde_dual(refchildr,querychildr,qid,qdata,log_density,kernel_type,h,log_atol,log_rtol,log_norm,lower_bound_rr,spread_rr, min_bound_global, spread_global);
-
-
-
-
-
 }
 
 void CNbodyTree::partition(index_t dim, index_t start, index_t end, index_t mid)
@@ -41,6 +41,8 @@
 #include <shogun/multiclass/tree/KNNHeap.h>
 #include <shogun/features/DenseFeatures.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -49,6 +51,25 @@ namespace shogun
  */
 class CNbodyTree : public TreeMachine<NbodyTreeNodeData>
 {
+protected:
+	/** node of the flattened tree, children are indices into m_flat_nodes
+	 * and -1 for leaves
+	 */
+	struct FlatNode
+	{
+		/** start index */
+		index_t start_idx;
+
+		/** end index */
+		index_t end_idx;
+
+		/** left child */
+		index_t left;
+
+		/** right child */
+		index_t right;
+	};
+
 public:
 
 	/** constructor
@@ -71,13 +92,14 @@ public:
 	 */
 	SGVector<index_t> get_rearranged_vector_ids() const { return m_vec_id; }
 
-	/** build tree
+	/** build tree, subtrees are built in parallel as OpenMP tasks
 	 *
 	 * @param data data for tree formation
 	 */
 	void build_tree(const std::shared_ptr<DenseFeatures<float64_t>>& data);
 
-	/** apply knn
+	/** apply knn, blocks of query vectors are processed in parallel on a
+	 * flattened copy of the tree
 	 *
 	 * @param data vectors whose KNNs are required
 	 * @param k K value in KNN
@@ -95,18 +117,26 @@ public:
 	 */
 	SGVector<float64_t> log_kernel_density(SGMatrix<float64_t> test, EKernelType kernel, float64_t h, float64_t atol, float64_t rtol);
 
-	/** get log of kernel density at query points
+	/** get log of kernel density at query points with a dual-tree
+	 * traversal
 	 *
-	 * @param test query points at which kernel density is to be calculated
-	 * @param qid id vector of the query tree
-	 * @param qroot root of the query tree
+	 * Every pair of a query and a reference node is pruned with the
+	 * midpoint of the kernel bounds from the minimum and maximum distance
+	 * between the nodes if the error is within the tolerance, so that the
+	 * error of every density is at most atol+rtol*density. Compact
+	 * kernels prune pairs of nodes farther apart than the bandwidth
+	 * exactly. Query subtrees are evaluated in parallel.
+	 *
+	 * @param query_tree tree built on the query points, of the same
+	 * distance metric
 	 * @param kernel kernel type
 	 * @param h width of kernel
 	 * @param atol absolute tolerance
 	 * @param rtol relative tolerance
-	 * @return log kernel density
+	 * @return log kernel density at the query points, in their original
+	 * order
 	 */
-	SGVector<float64_t> log_kernel_density_dual(SGMatrix<float64_t> test, SGVector<index_t> qid, const std::shared_ptr<bnode_t>& qroot, EKernelType kernel, float64_t h, float64_t atol, float64_t rtol);
+	SGVector<float64_t> log_kernel_density_dual(const std::shared_ptr<CNbodyTree>& query_tree, EKernelType kernel, float64_t h, float64_t atol, float64_t rtol);
 
 	/** distance b/w KNN vectors and query vectors
 	 *
@@ -130,21 +160,15 @@ protected:
 	 */
 	virtual float64_t min_dist(std::shared_ptr<bnode_t> node,float64_t* feat, int32_t dim)=0;
 
-	/** find minimum distance between 2 nodes
+	/** find minimum distance between a node of the flattened tree and a
+	 * query vector
 	 *
-	 * @param nodeq node containing active query vectors
-	 * @param noder node containing active training vectors
-	 * @return min distance between 2 nodes
-	 */
-	virtual float64_t min_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder)=0;
-
-	/** find max distance between 2 nodes
-	 *
-	 * @param nodeq node containing active query vectors
-	 * @param noder node containing active training vectors
-	 * @return max distance between 2 nodes
+	 * @param node index of the node in m_flat_nodes
+	 * @param feat query vector
+	 * @param dim dimensions of query vector
+	 * @return min distance
 	 */
-	virtual float64_t max_dist_dual(std::shared_ptr<bnode_t> nodeq, std::shared_ptr<bnode_t> noder)=0;
+	virtual float64_t min_dist_flat(index_t node, const float64_t* feat, int32_t dim) const=0;
 
 	/** initialize node
 	 *
@@ -169,7 +193,7 @@ protected:
 	 * @param dists distance value
 	 * @return actual distance
 	 */
-	inline float64_t actual_dists(float64_t dists)
+	inline float64_t actual_dists(float64_t dists) const
 	{
 		if (m_dist==D_MANHATTAN)
 			return dists;
@@ -184,14 +208,14 @@ protected:
 	 * @param dim dimension of query vector
 	 * @return distance b/w vectors
 	 */
-	float64_t distance(index_t vec, float64_t* arr, int32_t dim);
+	float64_t distance(index_t vec, const float64_t* arr, int32_t dim) const;
 
 	/** compute distance component contributed by present dimension
 	 *
 	 * @param d displacement component at chosen dimension
 	 * @return distance component
 	 */
-	inline float64_t add_dim_dist(float64_t d)
+	inline float64_t add_dim_dist(float64_t d) const
 	{
 		if (m_dist==D_EUCLIDEAN)
 			return d*d;
@@ -209,11 +233,25 @@ private:
 	 *
 	 * @param heap heap to store kNN distances and indices of corresponding vectors
 	 * @param min_dist minimum distance b/ query point and the current node
-	 * @param node current node
+	 * @param node index of the current node in m_flat_nodes
 	 * @param arr current query vector
 	 * @param dim dimension of query vector
 	 */
-	void query_knn_single(const std::shared_ptr<KNNHeap>& heap, float64_t min_dist, const std::shared_ptr<bnode_t>& node, float64_t* arr, int32_t dim);
+	void query_knn_single(KNNHeap& heap, float64_t min_dist, index_t node, const float64_t* arr, int32_t dim) const;
+
+	/** copy the tree rooted at m_root into m_flat_nodes and the node
+	 * bound matrices, nodes are stored in depth-first order
+	 */
+	void flatten_tree();
+
+	/** append a subtree to the flattened tree
+	 *
+	 * @param node root of the subtree
+	 * @param nodes flattened nodes
+	 * @param tree_nodes original nodes, in the same order as nodes
+	 * @return index of node in nodes
+	 */
+	index_t flatten_node(const std::shared_ptr<bnode_t>& node, std::vector<FlatNode>& nodes, std::vector<bnode_t*>& tree_nodes);
 
 	/** find kde at each query point
 	 *
@@ -232,26 +270,48 @@ private:
 	void get_kde_single(const std::shared_ptr<bnode_t>& node,float64_t* data, EKernelType kernel, float64_t h, float64_t log_atol, float64_t log_rtol,
 	float64_t log_norm, float64_t min_bound_node, float64_t spread_node, float64_t &min_bound_global, float64_t &spread_global);
 
-	/** depth-first traversal in dual trees for KDE
+	/** parameters of a dual-tree kernel density evaluation */
+	struct KDEParams
+	{
+		/** kernel type */
+		EKernelType kernel;
+
+		/** kernel bandwidth */
+		float64_t h;
+
+		/** log of absolute tolerance */
+		float64_t log_atol;
+
+		/** log of relative tolerance */
+		float64_t log_rtol;
+
+		/** log of kernel norm */
+		float64_t log_norm;
+	};
+
+	/** find min as well as max distance between a node of a query tree
+	 * and a node of this tree, both flattened, from their bounding boxes
+	 * and, for ball trees, from their balls
 	 *
-	 * @param refnode current node from reference tree
-	 * @param querynode current node from query tree
-	 * @param qid id vector of query tree
-	 * @param qdata query data matrix
-	 * @param log_density stores log of kernel density at each query point
-	 * @param kernel_type kernel type used
-	 * @param h kernel bandwidth
-	 * @param log_atol log absolute tolerance
-	 * @param log_rtol log relative tolerance
-	 * @param log_norm log of kernel norm
-	 * @param min_bound_node min evaluated kernel in node
-	 * @param spread_node spread of kernel values in node
-	 * @param min_bound_global stores the globally calculated min kernel density for all query points
-	 * @param spread_global spread of kernel values accross entire reference tree for all query points in query tree
+	 * @param query query tree
+	 * @param qnode index of the node in the flattened query tree
+	 * @param rnode index of the node in m_flat_nodes
+	 * @param lower lower bound of distance
+	 * @param upper upper bound of distance
 	 */
-	void kde_dual(const std::shared_ptr<bnode_t>& refnode, const std::shared_ptr<bnode_t>& querynode, SGVector<index_t> qid, SGMatrix<float64_t> qdata, SGVector<float64_t> log_density,
-	EKernelType kernel_type, float64_t h, float64_t log_atol, float64_t log_rtol, float64_t log_norm, float64_t min_bound_node,
-	float64_t spread_node, float64_t &min_bound_global, float64_t &spread_global);
+	void min_max_dist_dual_flat(const CNbodyTree& query, index_t qnode, index_t rnode, float64_t& lower, float64_t& upper) const;
+
+	/** depth-first traversal in dual trees for KDE, the larger of the two
+	 * nodes is split until the pair can be pruned or both are leaves
+	 *
+	 * @param query query tree
+	 * @param qnode index of the node in the flattened query tree
+	 * @param rnode index of the node in m_flat_nodes
+	 * @param params kernel and tolerances
+	 * @param log_density log of the unnormalized kernel sums of the query
+	 * points, in the order of the query tree
+	 */
+	void kde_dual(const CNbodyTree& query, index_t qnode, index_t rnode, const KDEParams& params, float64_t* log_density) const;
 
 	/** recursive build
 	 *
@@ -283,7 +343,7 @@ private:
 	 * @param y number 2
 	 * @return log of sum of exp of numbers
 	 */
-	inline float64_t logsumexp(float64_t x, float64_t y)
+	static inline float64_t logsumexp(float64_t x, float64_t y)
 	{
 		float64_t a=Math::max(x,y);
 		if (a==-Math::INFTY)
@@ -298,7 +358,7 @@ private:
 	 * @param y number 2
 	 * @return log of difference of exp of numbers
 	 */
-	inline float64_t logdiffexp(float64_t x, float64_t y)
+	static inline float64_t logdiffexp(float64_t x, float64_t y)
 	{
 		if (x<=y)
 			return -Math::INFTY;
@@ -316,7 +376,30 @@ protected:
 	/** vector id */
 	SGVector<index_t> m_vec_id;
 
+	/** nodes of the flattened tree */
+	std::vector<FlatNode> m_flat_nodes;
+
+	/** bounding box lower bounds of the flattened nodes, one per column */
+	SGMatrix<float64_t> m_flat_lower;
+
+	/** bounding box upper bounds of the flattened nodes, one per column */
+	SGMatrix<float64_t> m_flat_upper;
+
+	/** centers of the flattened nodes, one per column (ball tree only) */
+	SGMatrix<float64_t> m_flat_center;
+
+	/** radius of the flattened nodes */
+	SGVector<float64_t> m_flat_radius;
+
 private:
+	/** minimum number of vectors in a subtree for it to be built as a
+	 * separate task
+	 */
+	static constexpr index_t task_threshold=4096;
+
+	/** number of query vectors processed by a thread at once */
+	static constexpr index_t query_block_size=64;
+
 	/** leaf size */
 	int32_t m_leaf_size;
 
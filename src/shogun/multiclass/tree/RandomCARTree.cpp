@@ -49,6 +49,17 @@ void RandomCARTree::set_feature_subset_size(index_t size)
 	m_randsubset_size=size;
 }
 
+index_t RandomCARTree::get_random_subset_size(index_t num_feats)
+{
+	// if subset size is not set choose sqrt(num_feats) by default
+	if (m_randsubset_size==0)
+		m_randsubset_size = std::sqrt((float64_t)num_feats);
+
+	require(m_randsubset_size<=num_feats, "The Feature subset size(set {}) should be less than"
+	" or equal to the total number of features({} here).",m_randsubset_size,num_feats);
+	return m_randsubset_size;
+}
+
 index_t RandomCARTree::compute_best_attribute(
     const SGMatrix<float64_t>& mat, const SGVector<float64_t>& weights,
     std::shared_ptr<DenseLabels> labels, SGVector<float64_t>& left,
@@ -58,18 +69,16 @@ index_t RandomCARTree::compute_best_attribute(
     const SGVector<index_t>& active_indices)
 
 {
-	auto num_feats = (m_pre_sort) ? mat.num_cols : mat.num_rows;
-
-	// if subset size is not set choose sqrt(num_feats) by default
-	if (m_randsubset_size==0)
-		m_randsubset_size = std::sqrt((float64_t)num_feats);
-	subset_size=m_randsubset_size;
+	index_t num_feats;
+	if (m_num_bins>0)
+		num_feats = m_binned_features.num_cols;
+	else
+		num_feats = (m_pre_sort) ? mat.num_cols : mat.num_rows;
 
-	require(subset_size<=num_feats, "The Feature subset size(set {}) should be less than"
-	" or equal to the total number of features({} here).",subset_size,num_feats);
 	return CARTree::compute_best_attribute(
 	    mat, weights, labels, left, right, is_left_final, num_missing_final,
-	    count_left, count_right, impurity, subset_size, active_indices);
+	    count_left, count_right, impurity, get_random_subset_size(num_feats),
+	    active_indices);
 }
 
 void RandomCARTree::init()
@@ -72,6 +72,14 @@ public:
 	index_t get_feature_subset_size() const { return m_randsubset_size; }
 
 protected:
+	/** number of randomly chosen attributes to evaluate at every node,
+	 * sqrt(num_feats) if the subset size is not set
+	 *
+	 * @param num_feats number of attributes
+	 * @return size of the random subset
+	 */
+	index_t get_random_subset_size(index_t num_feats) override;
+
 	/** computes best attribute for CARTtrain
 	 *
 	 * @param mat data matrix
@@ -0,0 +1,137 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/multiclass/tree/SplitStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace shogun;
+
+SGVector<float64_t> SplitStatistics::distinct_values(const SGVector<float64_t>& values)
+{
+	std::vector<float64_t> sorted(values.begin(), values.end());
+	std::sort(sorted.begin(), sorted.end());
+	sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+	SGVector<float64_t> distinct(sorted.size());
+	std::copy(sorted.begin(), sorted.end(), distinct.begin());
+	return distinct;
+}
+
+SGVector<index_t> SplitStatistics::value_indices(
+    const SGVector<float64_t>& values, const SGVector<float64_t>& distinct)
+{
+	SGVector<index_t> indices(values.vlen);
+	for (index_t i=0; i<values.vlen; ++i)
+	{
+		indices[i]=std::lower_bound(distinct.begin(), distinct.end(), values[i])-
+			distinct.begin();
+	}
+
+	return indices;
+}
+
+void SplitStatistics::contingency_table(
+    const SGVector<float64_t>& values, const SGVector<float64_t>& labels,
+    const SGVector<float64_t>& weights, SGMatrix<int32_t>& counts,
+    SGMatrix<float64_t>& weight_table)
+{
+	require(values.vlen==labels.vlen,
+		"Number of values ({}) does not match number of labels ({})",
+		values.vlen, labels.vlen);
+	require(weights.vlen==0 || weights.vlen==values.vlen,
+		"Number of weights ({}) does not match number of values ({})",
+		weights.vlen, values.vlen);
+
+	auto distinct=distinct_values(values);
+	auto rows=value_indices(values, distinct);
+	auto distinct_labels=distinct_values(labels);
+	auto cols=value_indices(labels, distinct_labels);
+
+	counts=SGMatrix<int32_t>(distinct.vlen, distinct_labels.vlen);
+	counts.zero();
+	weight_table=SGMatrix<float64_t>(distinct.vlen, distinct_labels.vlen);
+	weight_table.zero();
+	for (index_t i=0; i<values.vlen; ++i)
+	{
+		counts(rows[i], cols[i])++;
+		weight_table(rows[i], cols[i])+=weights.vlen ? weights[i] : 1.0;
+	}
+}
+
+float64_t SplitStatistics::xlogx(float64_t x)
+{
+	static const std::vector<float64_t> table=[]() {
+		std::vector<float64_t> t(xlogx_table_size);
+		t[0]=0;
+		for (index_t i=1; i<xlogx_table_size; ++i)
+			t[i]=i*std::log(float64_t(i));
+		return t;
+	}();
+
+	if (x>=0 && x<xlogx_table_size)
+	{
+		const index_t n=x;
+		if (n==x)
+			return table[n];
+	}
+
+	return x>0 ? x*std::log(x) : 0;
+}
+
+float64_t SplitStatistics::entropy(const float64_t* weights, index_t num, index_t stride)
+{
+	float64_t total=0;
+	float64_t sum=0;
+	for (index_t i=0; i<num; ++i)
+	{
+		total+=weights[i*stride];
+		sum+=xlogx(weights[i*stride]);
+	}
+
+	if (total<=0)
+		return 0;
+
+	return std::max(xlogx(total)-sum, 0.0)/total;
+}
+
+float64_t SplitStatistics::conditional_entropy(const SGMatrix<float64_t>& weight_table)
+{
+	float64_t total=0;
+	float64_t sum=0;
+	for (index_t i=0; i<weight_table.num_rows; ++i)
+	{
+		float64_t row_total=0;
+		float64_t row_sum=0;
+		for (index_t j=0; j<weight_table.num_cols; ++j)
+		{
+			row_total+=weight_table(i, j);
+			row_sum+=xlogx(weight_table(i, j));
+		}
+		total+=row_total;
+		sum+=std::max(xlogx(row_total)-row_sum, 0.0);
+	}
+
+	if (total<=0)
+		return 0;
+
+	return sum/total;
+}
+
+float64_t SplitStatistics::class_entropy(const SGMatrix<float64_t>& weight_table)
+{
+	SGVector<float64_t> class_weights(weight_table.num_cols);
+	class_weights.zero();
+	for (index_t j=0; j<weight_table.num_cols; ++j)
+	{
+		for (index_t i=0; i<weight_table.num_rows; ++i)
+			class_weights[j]+=weight_table(i, j);
+	}
+
+	return entropy(class_weights.vector, class_weights.vlen);
+}
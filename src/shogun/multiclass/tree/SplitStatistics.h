@@ -0,0 +1,99 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SPLITSTATISTICS_H__
+#define SPLITSTATISTICS_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+/** @brief Statistics of splits on categorical attributes, shared by
+ * ID3ClassifierTree, C45ClassifierTree and CHAIDTree.
+ *
+ * contingency_table() counts the vectors of every pair of attribute value
+ * and class in one pass over the attribute, the values and classes are
+ * found by binary search in their sorted distinct values. The entropies are
+ * computed from the weights of the table as
+ * \f[
+ * H=\frac{1}{W}\left(W\log W-\sum_i w_i\log w_i\right)
+ * \f]
+ * where \f$x\log x\f$ is looked up in a precomputed table for integer
+ * weights, which are the counts of unweighted data.
+ */
+class SplitStatistics
+{
+public:
+	/** sorted distinct values
+	 *
+	 * @param values values
+	 * @return distinct values in ascending order
+	 */
+	static SGVector<float64_t> distinct_values(const SGVector<float64_t>& values);
+
+	/** index of every value in the distinct values
+	 *
+	 * @param values values
+	 * @param distinct sorted distinct values, containing all values
+	 * @return position of every value in distinct
+	 */
+	static SGVector<index_t> value_indices(
+		const SGVector<float64_t>& values, const SGVector<float64_t>& distinct);
+
+	/** count the vectors of every attribute value and class
+	 *
+	 * @param values attribute value of every vector
+	 * @param labels class of every vector
+	 * @param weights weight of every vector, empty for weights of 1
+	 * @param counts number of vectors, one row per distinct value and one
+	 * column per distinct class
+	 * @param weight_table total weight of the vectors of every entry of
+	 * counts
+	 */
+	static void contingency_table(
+		const SGVector<float64_t>& values, const SGVector<float64_t>& labels,
+		const SGVector<float64_t>& weights, SGMatrix<int32_t>& counts,
+		SGMatrix<float64_t>& weight_table);
+
+	/** @return \f$x\log x\f$, 0 for x=0 */
+	static float64_t xlogx(float64_t x);
+
+	/** entropy of a distribution given by unnormalized weights
+	 *
+	 * @param weights weights of the outcomes
+	 * @param num number of outcomes
+	 * @param stride distance of the weights in memory
+	 * @return entropy in nats
+	 */
+	static float64_t entropy(const float64_t* weights, index_t num, index_t stride=1);
+
+	/** entropy of the classes within the attribute values, weighted by the
+	 * total weight of the values
+	 *
+	 * @param weight_table weights of the vectors, one row per attribute
+	 * value and one column per class
+	 * @return conditional entropy of the classes in nats
+	 */
+	static float64_t conditional_entropy(const SGMatrix<float64_t>& weight_table);
+
+	/** entropy of the classes of the vectors of a table
+	 *
+	 * @param weight_table weights of the vectors, one row per attribute
+	 * value and one column per class
+	 * @return entropy of the classes in nats
+	 */
+	static float64_t class_entropy(const SGMatrix<float64_t>& weight_table);
+
+private:
+	/** number of integers in the \f$x\log x\f$ table */
+	static constexpr index_t xlogx_table_size=16384;
+};
+} /* namespace shogun */
+
+#endif /* SPLITSTATISTICS_H__ */
@@ -36,8 +36,10 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
+using namespace Eigen;
 
 CConvolutionalFeatureMap::CConvolutionalFeatureMap(
 	int32_t input_width, int32_t input_height,
@@ -45,13 +47,15 @@ CConvolutionalFeatureMap::CConvolutionalFeatureMap(
 	int32_t stride_x, int32_t stride_y,
 	int32_t index,
 	EConvMapActivationFunction function,
-	ENLAutoencoderPosition autoencoder_position) :
+	ENLAutoencoderPosition autoencoder_position,
+	ENLPrecision precision) :
 		m_input_width(input_width), m_input_height(input_height),
 		m_radius_x(radius_x), m_radius_y(radius_y),
 		m_stride_x(stride_x), m_stride_y(stride_y),
 		m_index(index),
 		m_activation_function(function),
-		m_autoencoder_position(autoencoder_position)
+		m_autoencoder_position(autoencoder_position),
+		m_precision(precision)
 {
 	if (m_autoencoder_position == NLAP_NONE)
 	{
@@ -64,6 +68,19 @@ CConvolutionalFeatureMap::CConvolutionalFeatureMap(
 		m_output_height = m_input_height;
 	}
 
+	// the filter is applied at every stride-th pixel. Without autoencoder
+	// the outputs are packed, with autoencoder they stay at the pixel.
+	if (m_autoencoder_position == NLAP_NONE)
+	{
+		m_num_positions_x = m_output_width;
+		m_num_positions_y = m_output_height;
+	}
+	else
+	{
+		m_num_positions_x = (m_input_width+m_stride_x-1)/m_stride_x;
+		m_num_positions_y = (m_input_height+m_stride_y-1)/m_stride_y;
+	}
+
 	m_input_num_neurons = m_input_width*m_input_height;
 	m_output_num_neurons = m_output_width*m_output_height;
 
@@ -77,53 +94,74 @@ void CConvolutionalFeatureMap::compute_activations(
 	SGVector< float64_t > parameters,
 	const std::vector<std::shared_ptr<NeuralLayer>>& layers,
 	SGVector< int32_t > input_indices,
-	SGMatrix<float64_t> activations)
+	SGMatrix<float64_t> activations,
+	int32_t num_maps)
 {
 	int32_t batch_size = activations.num_cols;
+	int32_t num_positions = get_num_positions();
+	int32_t num_weights = m_filter_height*m_filter_width;
+	int32_t num_parameters_per_map = parameters.vlen/num_maps;
 
-	float64_t bias = parameters[0];
-	for (int32_t i=0; i<m_output_num_neurons; i++)
-	{
-		for (int32_t j=0; j<batch_size; j++)
-		{
-			activations(i+m_row_offset,j) = bias;
-		}
-	}
+	// column k holds the parameters of the k-th map
+	Map<MatrixXd> P(parameters.vector, num_parameters_per_map, num_maps);
+
+	// pre-activations of all maps, one row per map, one column per
+	// position and image
+	MatrixXd Z = MatrixXd::Zero(num_maps, num_positions*batch_size);
 
 	int32_t weights_index_offset = 1;
 	for (int32_t l=0; l<input_indices.vlen; l++)
 	{
 		auto& layer = layers[input_indices[l]];
 
-		int32_t num_maps = layer->get_num_neurons()/m_input_num_neurons;
+		int32_t num_channels = layer->get_num_neurons()/m_input_num_neurons;
 
-		for (int32_t m=0; m<num_maps; m++)
+		for (int32_t c=0; c<num_channels; c++)
 		{
-			SGMatrix<float64_t> weights_matrix(parameters.vector+weights_index_offset,
-				m_filter_height, m_filter_width, false);
-			weights_index_offset += m_filter_height*m_filter_width;
+			SGMatrix<float64_t> columns = unfold_inputs(
+				layer->get_activations(), c*m_input_num_neurons);
 
-			convolve(layer->get_activations(), weights_matrix, activations,
-				false, false, m*m_input_num_neurons, m_row_offset);
+			// convolution flips the filter relative to the unfolded taps
+			MatrixXd W = P.block(weights_index_offset, 0, num_weights, num_maps)
+				.colwise().reverse().transpose();
+			weights_index_offset += num_weights;
+
+			add_product(Z, W, Map<MatrixXd>(columns.matrix,
+				columns.num_rows, columns.num_cols), m_precision);
 		}
+	}
 
+	for (int32_t k=0; k<num_maps; k++)
+	{
+		int32_t row_offset = m_row_offset+k*m_output_num_neurons;
+		float64_t bias = P(0,k);
+
+		for (int32_t j=0; j<batch_size; j++)
+		{
+			float64_t* result = activations.matrix+j*activations.num_rows
+				+ row_offset;
 
+			// outputs that the filter is not applied at only hold the bias
+			for (int32_t i=0; i<m_output_num_neurons; i++)
+				result[i] = bias;
+
+			for (int32_t p=0; p<num_positions; p++)
+				result[get_output_row(p)] += Z(k, p+j*num_positions);
+		}
 	}
 
+	Map<MatrixXd> A(activations.matrix, activations.num_rows, batch_size);
+	auto maps_activations =
+		A.middleRows(m_row_offset, num_maps*m_output_num_neurons);
+
 	if (m_activation_function==CMAF_LOGISTIC)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
-			for (int32_t j=0; j<batch_size; j++)
-				activations(i + m_row_offset, j) =
-				    1.0 /
-				    (1.0 + std::exp(-1.0 * activations(i + m_row_offset, j)));
+		maps_activations =
+			(1.0+(-maps_activations.array()).exp()).inverse().matrix();
 	}
 	else if (m_activation_function==CMAF_RECTIFIED_LINEAR)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
-			for (int32_t j=0; j<batch_size; j++)
-				activations(i+m_row_offset,j) =
-					Math::max<float64_t>(0, activations(i+m_row_offset,j));
+		maps_activations = maps_activations.cwiseMax(0.0);
 	}
 }
 
@@ -134,62 +172,82 @@ void CConvolutionalFeatureMap::compute_gradients(
 	SGMatrix< float64_t > activation_gradients,
 	const std::vector<std::shared_ptr<NeuralLayer>>& layers,
 	SGVector< int32_t > input_indices,
-	SGVector< float64_t > parameter_gradients)
+	SGVector< float64_t > parameter_gradients,
+	int32_t num_maps)
 {
 	int32_t batch_size = activation_gradients.num_cols;
+	int32_t num_positions = get_num_positions();
+	int32_t num_weights = m_filter_height*m_filter_width;
+	int32_t num_parameters_per_map = parameters.vlen/num_maps;
+	int32_t num_rows = num_maps*m_output_num_neurons;
+
+	Map<MatrixXd> A(activations.matrix, activations.num_rows, batch_size);
+	Map<MatrixXd> AG(activation_gradients.matrix,
+		activation_gradients.num_rows, batch_size);
+	auto maps_activations = A.middleRows(m_row_offset, num_rows);
+	auto maps_gradients = AG.middleRows(m_row_offset, num_rows);
 
 	if (m_activation_function==CMAF_LOGISTIC)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
-		{
-			for (int32_t j=0; j<batch_size; j++)
-			{
-				activation_gradients(i+m_row_offset,j) *=
-					activation_gradients(i+m_row_offset,j) *
-					(1.0-activation_gradients(i+m_row_offset,j));
-			}
-		}
+		maps_gradients = (maps_gradients.array()*maps_gradients.array()*
+			(1.0-maps_gradients.array())).matrix();
 	}
 	else if (m_activation_function==CMAF_RECTIFIED_LINEAR)
 	{
-		for (int32_t i=0; i<m_output_num_neurons; i++)
-			for (int32_t j=0; j<batch_size; j++)
-				if (activations(i+m_row_offset,j)==0)
-					activation_gradients(i+m_row_offset,j) = 0;
+		maps_gradients = (maps_activations.array()==0)
+			.select(0.0, maps_gradients.array()).matrix();
 	}
 
-	float64_t bias_gradient = 0;
-	for (int32_t i=0; i<m_output_num_neurons; i++)
-		for (int32_t j=0; j<batch_size; j++)
-			bias_gradient += activation_gradients(i+m_row_offset,j);
+	Map<MatrixXd> P(parameters.vector, num_parameters_per_map, num_maps);
+	Map<MatrixXd> PG(parameter_gradients.vector,
+		num_parameters_per_map, num_maps);
+
+	// gradients at the positions of all maps, laid out like the
+	// pre-activations in compute_activations
+	MatrixXd G(num_maps, num_positions*batch_size);
+	for (int32_t k=0; k<num_maps; k++)
+	{
+		int32_t row_offset = m_row_offset+k*m_output_num_neurons;
+
+		PG(0,k) = AG.middleRows(row_offset, m_output_num_neurons).sum();
 
-	parameter_gradients[0] = bias_gradient;
+		for (int32_t j=0; j<batch_size; j++)
+			for (int32_t p=0; p<num_positions; p++)
+				G(k, p+j*num_positions) =
+					AG(row_offset+get_output_row(p), j);
+	}
 
 	int32_t weights_index_offset = 1;
 	for (int32_t l=0; l<input_indices.vlen; l++)
 	{
-		auto layer = layers[input_indices[l]];
+		auto& layer = layers[input_indices[l]];
 
-		int32_t num_maps = layer->get_num_neurons()/m_input_num_neurons;
+		int32_t num_channels = layer->get_num_neurons()/m_input_num_neurons;
 
-		for (int32_t m=0; m<num_maps; m++)
+		for (int32_t c=0; c<num_channels; c++)
 		{
-			SGMatrix<float64_t> W(parameters.vector+weights_index_offset,
-				m_filter_height, m_filter_width, false);
-			SGMatrix<float64_t> WG(parameter_gradients.vector+weights_index_offset,
-				m_filter_height, m_filter_width, false);
-			weights_index_offset += m_filter_height*m_filter_width;
+			SGMatrix<float64_t> columns = unfold_inputs(
+				layer->get_activations(), c*m_input_num_neurons);
+			Map<MatrixXd> C(columns.matrix, columns.num_rows, columns.num_cols);
 
-			compute_weight_gradients(layer->get_activations(),
-				activation_gradients, WG, m*m_input_num_neurons, m_row_offset);
+			MatrixXd WG = MatrixXd::Zero(num_weights, num_maps);
+			add_product(WG, C, G.transpose(), m_precision);
+			PG.block(weights_index_offset, 0, num_weights, num_maps) =
+				WG.colwise().reverse();
 
 			if (!layer->is_input())
-				convolve(activation_gradients, W,
-					layer->get_activation_gradients(), true, false,
-					m_row_offset, m*m_input_num_neurons);
-		}
+			{
+				MatrixXd W = P.block(weights_index_offset, 0,
+					num_weights, num_maps).colwise().reverse();
 
+				C.setZero();
+				add_product(C, W, G, m_precision);
+				fold_inputs(columns, layer->get_activation_gradients(),
+					c*m_input_num_neurons);
+			}
 
+			weights_index_offset += num_weights;
+		}
 	}
 }
 
@@ -210,145 +268,132 @@ void CConvolutionalFeatureMap::pool_activations(
 		result_height /= pooling_height;
 	}
 
+	// regions that do not fit into the output are dropped
+	int32_t num_regions_x = m_output_width/pooling_width;
+	int32_t num_regions_y = m_output_height/pooling_height;
+
 	for (int32_t i=0; i<pooled_activations.num_cols; i++)
 	{
-		SGMatrix<float64_t> image(
+		Map<MatrixXd> image(
 			activations.matrix+i*activations.num_rows + m_row_offset,
-			m_output_height, m_output_width, false);
+			m_output_height, m_output_width);
 
-		SGMatrix<float64_t> result(
+		Map<MatrixXd> result(
 			pooled_activations.matrix+i*pooled_activations.num_rows + result_row_offset,
-			result_height, result_width, false);
+			result_height, result_width);
 
-		SGMatrix<float64_t> indices(
+		Map<MatrixXd> indices(
 			max_indices.matrix+i*max_indices.num_rows + result_row_offset,
-			result_height, result_width, false);
+			result_height, result_width);
 
 		if (m_autoencoder_position != NLAP_NONE)
 		{
-			result.zero();
-			indices.set_const(-1.0);
+			result.setZero();
+			indices.setConstant(-1.0);
 		}
 
-		for (int32_t x=0; x<m_output_width; x+=pooling_width)
+		for (int32_t rx=0; rx<num_regions_x; rx++)
 		{
-			for (int32_t y=0; y<m_output_height; y+=pooling_height)
+			for (int32_t ry=0; ry<num_regions_y; ry++)
 			{
-				float64_t max = image(y,x);
-				int32_t max_index = m_row_offset+y+x*image.num_rows;
-
-				for (int32_t x1=x; x1<x+pooling_width; x1++)
-				{
-					for (int32_t y1=y; y1<y+pooling_height; y1++)
-					{
-						if (image(y1,x1) > max)
-						{
-							max = image(y1,x1);
-							max_index = m_row_offset+y1+x1*image.num_rows;
-						}
-					}
-				}
-				if (m_autoencoder_position == NLAP_NONE)
-				{
-					result(y/pooling_height, x/pooling_width) = max;
-					indices(y/pooling_height, x/pooling_width) = max_index;
-				}
-				else
-				{
-					result(y, x) = max;
-					indices(y, x) = max_index;
-				}
+				int32_t x = rx*pooling_width;
+				int32_t y = ry*pooling_height;
+
+				// the first maximum in column major order, like the scan
+				// over the region
+				index_t max_y, max_x;
+				float64_t max = image.block(y, x, pooling_height, pooling_width)
+					.maxCoeff(&max_y, &max_x);
+				int32_t max_index =
+					m_row_offset+y+max_y+(x+max_x)*m_output_height;
+
+				int32_t res_x = m_autoencoder_position == NLAP_NONE ? rx : x;
+				int32_t res_y = m_autoencoder_position == NLAP_NONE ? ry : y;
+				result(res_y, res_x) = max;
+				indices(res_y, res_x) = max_index;
 			}
 		}
 	}
 }
 
-void CConvolutionalFeatureMap::convolve(
-	SGMatrix< float64_t > inputs,
-	SGMatrix< float64_t > weights,
-	SGMatrix< float64_t > outputs,
-	bool flip,
-	bool reset_output,
-	int32_t inputs_row_offset,
- 	int32_t outputs_row_offset)
+SGMatrix<float64_t> CConvolutionalFeatureMap::unfold_inputs(
+	SGMatrix<float64_t> inputs, int32_t inputs_row_offset) const
 {
-	for (int32_t i=0; i<outputs.num_cols; i++)
-	{
-		SGMatrix<float64_t> image(
-			inputs.matrix+i*inputs.num_rows + inputs_row_offset,
-			m_input_height, m_input_width, false);
+	int32_t num_positions = get_num_positions();
+	SGMatrix<float64_t> columns(
+		m_filter_height*m_filter_width, num_positions*inputs.num_cols);
 
-		SGMatrix<float64_t> result(
-			outputs.matrix+i*outputs.num_rows + outputs_row_offset,
-			m_output_height, m_output_width, false);
+	for (int32_t i=0; i<inputs.num_cols; i++)
+	{
+		const float64_t* image =
+			inputs.matrix+i*inputs.num_rows + inputs_row_offset;
 
-		for (int32_t x=0; x<m_input_width; x+=m_stride_x)
+		for (int32_t px=0; px<m_num_positions_x; px++)
 		{
-			for (int32_t y=0; y<m_input_height; y+=m_stride_y)
+			for (int32_t py=0; py<m_num_positions_y; py++)
 			{
-				int32_t res_x = m_autoencoder_position == NLAP_NONE ? x/m_stride_x : x;
-				int32_t res_y = m_autoencoder_position == NLAP_NONE ? y/m_stride_y : y;
+				int32_t x = px*m_stride_x;
+				int32_t y = py*m_stride_y;
+
+				float64_t* column = columns.matrix + columns.num_rows*
+					(i*num_positions + py + px*m_num_positions_y);
 
-				float64_t sum = reset_output ? 0 : result(res_y,res_x);
 				for (int32_t x1=x-m_radius_x; x1<=x+m_radius_x; x1++)
 				{
+					bool inside_x = x1>=0 && x1<m_input_width;
 					for (int32_t y1=y-m_radius_y; y1<=y+m_radius_y; y1++)
 					{
-						if (x1>=0 && y1>=0 && x1<image.num_cols && y1<image.num_rows)
-						{
-							if (flip)
-								sum +=
-									weights(y1-y+m_radius_y,x1-x+m_radius_x)*image(y1,x1);
-							else
-								sum +=
-									weights(m_radius_y-y1+y,m_radius_x-x1+x)*image(y1,x1);
-						}
+						*column++ = inside_x && y1>=0 && y1<m_input_height ?
+							image[y1+x1*m_input_height] : 0;
 					}
 				}
-				result(res_y,res_x) = sum;
 			}
 		}
 	}
+
+	return columns;
 }
 
-void CConvolutionalFeatureMap::compute_weight_gradients(
-	SGMatrix< float64_t > inputs,
-	SGMatrix< float64_t > local_gradients,
-	SGMatrix< float64_t > weight_gradients,
-	int32_t inputs_row_offset,
- 	int32_t local_gradients_row_offset)
+void CConvolutionalFeatureMap::fold_inputs(SGMatrix<float64_t> columns,
+	SGMatrix<float64_t> inputs, int32_t inputs_row_offset) const
 {
-	weight_gradients.zero();
-	for (int32_t i=0; i<local_gradients.num_cols; i++)
-	{
-		SGMatrix<float64_t> image(
-			inputs.matrix+i*inputs.num_rows + inputs_row_offset,
-			m_input_height, m_input_width, false);
+	int32_t num_positions = get_num_positions();
 
-		SGMatrix<float64_t> LG_image(
-			local_gradients.matrix+i*local_gradients.num_rows
-			+ local_gradients_row_offset, m_output_height, m_output_width, false);
+	for (int32_t i=0; i<inputs.num_cols; i++)
+	{
+		float64_t* image = inputs.matrix+i*inputs.num_rows + inputs_row_offset;
 
-		for (int32_t x=0; x<m_input_width; x+=m_stride_x)
+		for (int32_t px=0; px<m_num_positions_x; px++)
 		{
-			for (int32_t y=0; y<m_input_height; y+=m_stride_y)
+			for (int32_t py=0; py<m_num_positions_y; py++)
 			{
+				int32_t x = px*m_stride_x;
+				int32_t y = py*m_stride_y;
+
+				const float64_t* column = columns.matrix + columns.num_rows*
+					(i*num_positions + py + px*m_num_positions_y);
+
 				for (int32_t x1=x-m_radius_x; x1<=x+m_radius_x; x1++)
 				{
-					for (int32_t y1=y-m_radius_y; y1<=y+m_radius_y; y1++)
+					bool inside_x = x1>=0 && x1<m_input_width;
+					for (int32_t y1=y-m_radius_y; y1<=y+m_radius_y; y1++, column++)
 					{
-						if (x1>=0 && y1>=0 && x1<image.num_cols && y1<image.num_rows)
-						{
-							if (m_autoencoder_position == NLAP_NONE)
-								weight_gradients(m_radius_y-y1+y,m_radius_x-x1+x) +=
-									LG_image(y/m_stride_y,x/m_stride_x)*image(y1,x1);
-							else
-								weight_gradients(m_radius_y-y1+y,m_radius_x-x1+x) +=
-									LG_image(y,x)*image(y1,x1);
-						}
+						if (inside_x && y1>=0 && y1<m_input_height)
+							image[y1+x1*m_input_height] += *column;
 					}
 				}
 			}
 		}
 	}
 }
+
+int32_t CConvolutionalFeatureMap::get_output_row(int32_t position) const
+{
+	int32_t px = position/m_num_positions_y;
+	int32_t py = position%m_num_positions_y;
+
+	if (m_autoencoder_position == NLAP_NONE)
+		return py+px*m_output_height;
+
+	return py*m_stride_y+px*m_stride_x*m_output_height;
+}
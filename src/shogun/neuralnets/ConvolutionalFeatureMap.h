@@ -77,13 +77,15 @@ public:
 	 * its outputs in.
 	 * @param function Activation function
 	 * @param autoencoder_position Autoencoder position
+	 * @param precision Precision of the matrix products
 	 */
 	CConvolutionalFeatureMap(int32_t input_width, int32_t input_height,
 			int32_t radius_x, int32_t radius_y,
 			int32_t stride_x=1, int32_t stride_y=1,
 			int32_t index=0,
 			EConvMapActivationFunction function = CMAF_IDENTITY,
-			ENLAutoencoderPosition autoencoder_position = NLAP_NONE);
+			ENLAutoencoderPosition autoencoder_position = NLAP_NONE,
+			ENLPrecision precision = NLP_DOUBLE);
 
 	/** Computes the activations of the feature map
 	 *
@@ -94,11 +96,16 @@ public:
 	 * @param input_indices Indices of the layers that are connected to the map
 	 * as input
 	 * @param activations Matrix in which the activations are to be stored
+	 * @param num_maps Number of consecutive maps, starting at this map's
+	 * index, that are computed at once. Their parameters follow each other in
+	 * parameters. The convolutions of all maps and images are performed as
+	 * one matrix product per input channel.
 	 */
 	void compute_activations(SGVector<float64_t> parameters,
 			const std::vector<std::shared_ptr<NeuralLayer>>& layers,
 			SGVector<int32_t> input_indices,
-			SGMatrix<float64_t> activations);
+			SGMatrix<float64_t> activations,
+			int32_t num_maps=1);
 
 	/** Computes the gradients with respect to the parameters and the inputs to
 	 * the map
@@ -111,13 +118,16 @@ public:
 	 * @param layers The layers array that forms the network in which the map is being used
 	 * @param input_indices Indices of the layers that are connected to the map as input
 	 * @param parameter_gradients Vector in which the parameters gradients are to be stored
+	 * @param num_maps Number of consecutive maps, starting at this map's
+	 * index, whose gradients are computed at once
 	 */
 	void compute_gradients(SGVector<float64_t> parameters,
 			SGMatrix<float64_t> activations,
 			SGMatrix<float64_t> activation_gradients,
 			const std::vector<std::shared_ptr<NeuralLayer>>& layers,
 			SGVector<int32_t> input_indices,
-			SGVector<float64_t> parameter_gradients);
+			SGVector<float64_t> parameter_gradients,
+			int32_t num_maps=1);
 
 	/** Applies max pooling to the activations
 
@@ -133,42 +143,43 @@ public:
 			SGMatrix<float64_t> pooled_activations,
 			SGMatrix<float64_t> max_indices);
 
-protected:
-	/** Perfoms convolution
+	/** @return Number of positions the filter is applied at in each image */
+	int32_t get_num_positions() const
+	{
+		return m_num_positions_x*m_num_positions_y;
+	}
+
+	/** Unfolds the receptive fields of one input channel into the columns
+	 * of a matrix (im2col), which turns the convolution into a matrix
+	 * product with the flattened filter
 	 *
 	 * @param inputs Inputs matrix. Each column in the matrix is treated as an
 	 * image in column major format
-	 * @param weights Convolution filter
-	 * @param outputs Output matrix
-	 * @param flip If true the weights are flipped, performing cross-correlation
-	 * instead of convolution
-	 * @param reset_output true the output is reset to zero before performing
-	 * convolution
 	 * @param inputs_row_offset Index of the row at which the input image starts
-	 * @param outputs_row_offset Index of the row at which the output image starts
+	 * @return Matrix with (2*radius_y+1)*(2*radius_x+1) rows and one column
+	 * per position and image, the positions of an image being contiguous.
+	 * Row t holds the input at offset (t%filter_height-radius_y,
+	 * t/filter_height-radius_x) from the position, zero outside the image.
 	 */
-	void convolve(SGMatrix<float64_t> inputs,
-			SGMatrix<float64_t> weights,
-			SGMatrix<float64_t> outputs,
-			bool flip,
-			bool reset_output,
-			int32_t inputs_row_offset,
- 			int32_t outputs_row_offset);
-
-	/** Computes the gradients of the error with respect to the weights, for a
-	 * particular input matrix
+	SGMatrix<float64_t> unfold_inputs(SGMatrix<float64_t> inputs,
+			int32_t inputs_row_offset) const;
+
+	/** Adds the columns of an unfolded matrix to the images they were taken
+	 * from (col2im), the adjoint of unfold_inputs()
 	 *
-	 * @param inputs Inputs matrix
-	 * @param local_gradients Gradients with respect the map's pre-activations
-	 * @param weight_gradients Matrix to store the gradients in
-	 * @param inputs_row_offset Offset for accessing the rows of the inputs matrix
-	 * @param local_gradients_row_offset Offset for accessing the rows of the local gradients matrix
+	 * @param columns Unfolded matrix
+	 * @param inputs Inputs matrix to add to
+	 * @param inputs_row_offset Index of the row at which the input image starts
 	 */
-	void compute_weight_gradients(SGMatrix<float64_t> inputs,
-			SGMatrix<float64_t> local_gradients,
-			SGMatrix<float64_t> weight_gradients,
-			int32_t inputs_row_offset,
- 			int32_t local_gradients_row_offset);
+	void fold_inputs(SGMatrix<float64_t> columns,
+			SGMatrix<float64_t> inputs,
+			int32_t inputs_row_offset) const;
+
+	/** @param position Index of a position of the filter
+	 * @return Row of the output at that position, relative to the map's
+	 * first row
+	 */
+	int32_t get_output_row(int32_t position) const;
 
 protected:
 	/** Width of the input */
@@ -209,6 +220,12 @@ protected:
 	/** Number of neurons in the output */
 	int32_t m_output_num_neurons;
 
+	/** Number of positions of the filter along the x axis */
+	int32_t m_num_positions_x;
+
+	/** Number of positions of the filter along the y axis */
+	int32_t m_num_positions_y;
+
 	/** Row offset for accessing the activations */
 	int32_t m_row_offset;
 
@@ -222,6 +239,9 @@ protected:
 	 * i.e an encoding layer or a decoding layer. Default value is NLAP_NONE
 	 */
 	ENLAutoencoderPosition m_autoencoder_position;
+
+	/** Precision of the matrix products */
+	ENLPrecision m_precision;
 };
 
 }
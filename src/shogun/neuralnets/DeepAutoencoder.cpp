@@ -39,6 +39,7 @@
 #include <shogun/neuralnets/NeuralRectifiedLinearLayer.h>
 #include <shogun/neuralnets/NeuralConvolutionalLayer.h>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -106,7 +107,10 @@ void DeepAutoencoder::pre_train(std::shared_ptr<Features> data)
 		initialize_neural_network(m_sigma);
 	}
 
-	SGMatrix<float64_t> data_matrix = features_to_matrix(std::move(data));
+	// the training data of an autoencoder is computed from the training
+	// data of the previous one, so only one of them is kept at a time
+	SGMatrix<float64_t> ae_input_matrix =
+		propagate_layer(features_to_matrix(std::move(data)), 0);
 
 	int32_t num_encoding_layers = (m_num_layers-1)/2;
 	for (int32_t i=1; i<=num_encoding_layers; i++)
@@ -149,17 +153,9 @@ void DeepAutoencoder::pre_train(std::shared_ptr<Features> data)
 		ae->set_gd_momentum(pt_gd_momentum[i-1]);
 		ae->set_gd_mini_batch_size(pt_gd_mini_batch_size[i-1]);
 		ae->set_gd_error_damping_coeff(pt_gd_error_damping_coeff[i-1]);
+		ae->set_shard_size(get_shard_size());
 
-		// forward propagate the data to obtain the training data for the
-		// current autoencoder
-		for (int32_t j=0; j<i; j++)
-			get_layer(j)->set_batch_size(data_matrix.num_cols);
-		SGMatrix<float64_t> ae_input_matrix = forward_propagate(data_matrix, i-1);
-		auto ae_input_features = std::make_shared<DenseFeatures<float64_t>>(ae_input_matrix);
-		for (int32_t j=0; j<i-1; j++)
-			get_layer(j)->set_batch_size(1);
-
-		ae->train(ae_input_features);
+		ae->train(std::make_shared<DenseFeatures<float64_t>>(ae_input_matrix));
 
 		SGVector<float64_t> ae_params = ae->get_parameters();
 		SGVector<float64_t> encoding_layer_params = get_section(m_params, i);
@@ -172,11 +168,60 @@ void DeepAutoencoder::pre_train(std::shared_ptr<Features> data)
 			else
 				decoding_layer_params[j-encoding_layer_params.vlen] = ae_params[j];
 		}
+
+		if (i<num_encoding_layers)
+			ae_input_matrix = propagate_layer(ae_input_matrix, i);
 	}
 
 	set_batch_size(1);
 }
 
+SGMatrix<float64_t> DeepAutoencoder::propagate_layer(
+	SGMatrix<float64_t> inputs, int32_t i)
+{
+	const int32_t block_size = 1024;
+
+	auto layer = get_layer(i);
+	std::shared_ptr<NeuralLayer> input_layer = i>0 ? get_layer(i-1) : nullptr;
+	require(!input_layer || inputs.num_rows==input_layer->get_num_neurons(),
+		"Number of input rows ({}) must match the number of neurons of "
+		"layer {} ({})", inputs.num_rows, i-1,
+		input_layer ? input_layer->get_num_neurons() : 0);
+
+	int32_t num_vectors = inputs.num_cols;
+	SGMatrix<float64_t> outputs(layer->get_num_neurons(), num_vectors);
+	for (int32_t begin=0; begin<num_vectors; begin+=block_size)
+	{
+		int32_t size = std::min(block_size, num_vectors-begin);
+		SGMatrix<float64_t> block(inputs.matrix+int64_t(begin)*inputs.num_rows,
+			inputs.num_rows, size, false);
+
+		if (layer->get_activations().num_cols!=size)
+			layer->set_batch_size(size);
+		if (input_layer && input_layer->get_activations().num_cols!=size)
+			input_layer->set_batch_size(size);
+		layer->precision = m_precision;
+
+		if (input_layer)
+		{
+			sg_memcpy(input_layer->get_activations().matrix, block.matrix,
+				sizeof(float64_t)*block.num_rows*size);
+			layer->compute_activations(get_section(m_params, i), m_layers);
+		}
+		else
+			layer->compute_activations(block);
+		layer->dropout_activations();
+
+		sg_memcpy(outputs.matrix+int64_t(begin)*outputs.num_rows,
+			layer->get_activations().matrix,
+			sizeof(float64_t)*outputs.num_rows*size);
+	}
+
+	return outputs;
+}
+
+
+
 std::shared_ptr<DenseFeatures< float64_t >> DeepAutoencoder::transform(
 	std::shared_ptr<DenseFeatures< float64_t >> data)
 {
@@ -130,6 +130,11 @@ public:
 	 * the parameter can be set for all autoencoders using the
 	 * SGVector::set_const() method.
 	 *
+	 * The training data of each autoencoder is computed from that of the
+	 * previous one in blocks of vectors, so only one of them is held at a
+	 * time. The autoencoders use the shard size of the deep autoencoder
+	 * (see set_shard_size()).
+	 *
 	 * @param data Training examples
 	 */
 	virtual void pre_train(std::shared_ptr<Features> data);
@@ -202,6 +207,16 @@ private:
 	template<class T>
 	SGVector<T> get_section(SGVector<T> v, int32_t i);
 
+	/** Computes the activations of layer i for all vectors, in blocks of
+	 * vectors so that no layer holds the activations of all of them
+	 *
+	 * @param inputs activations of layer i-1, or the input features if i
+	 * is 0
+	 * @param i index of the layer
+	 * @return activations of layer i
+	 */
+	SGMatrix<float64_t> propagate_layer(SGMatrix<float64_t> inputs, int32_t i);
+
 public:
 	/** Autoencoder::noise_type for pre-training each encoding layer
 	 * Default value is AENT_NONE for all layers
@@ -43,7 +43,7 @@
 #include <shogun/neuralnets/NeuralLogisticLayer.h>
 #include <shogun/neuralnets/NeuralNetwork.h>
 #include <shogun/mathematics/NormalDistribution.h>
-#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
 
 using namespace shogun;
 
@@ -363,9 +363,10 @@ void DeepBeliefNetwork::reset_chain()
 {
 	SGMatrix<float64_t> s = m_states[m_num_layers-2];
 
-	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
-	for (int32_t i=0; i<s.num_rows*s.num_cols; i++)
-		s[i] = uniform_real_dist(m_prng) > 0.5;
+	random::fill_array(s, 0.0, 1.0, m_prng);
+
+	Eigen::Map<Eigen::ArrayXXd> S(s.matrix, s.num_rows, s.num_cols);
+	S = (S > 0.5).cast<float64_t>();
 }
 
 std::shared_ptr<NeuralNetwork> DeepBeliefNetwork::convert_to_neural_network(
@@ -422,11 +423,7 @@ void DeepBeliefNetwork::down_step(int32_t index, SGVector< float64_t > params,
 	}
 
 	if (index > 0 || (index==0 && m_visible_units_type==RBMVUT_BINARY))
-	{
-		int32_t len = m_layer_sizes[index] * m_batch_size;
-		for (int32_t i=0; i<len; i++)
-			result[i] = 1.0 / (1.0 + std::exp(-1.0 * result[i]));
-	}
+		Out.array() = 1.0/(1.0+(-Out.array()).exp());
 
 	if (index == 0 && m_visible_units_type==RBMVUT_SOFTMAX)
 	{
@@ -445,12 +442,7 @@ void DeepBeliefNetwork::down_step(int32_t index, SGVector< float64_t > params,
 	}
 
 	if (sample_states && index>0)
-	{
-		UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
-		int32_t len = m_layer_sizes[index] * m_batch_size;
-		for (int32_t i=0; i<len; i++)
-			result[i] = uniform_real_dist(m_prng) < result[i];
-	}
+		RBM::sample_bernoulli(result, result, m_prng);
 }
 
 void DeepBeliefNetwork::up_step(int32_t index, SGVector< float64_t > params,
@@ -472,16 +464,10 @@ void DeepBeliefNetwork::up_step(int32_t index, SGVector< float64_t > params,
 		Out += W*In;
 	}
 
-	int32_t len = result.num_rows*result.num_cols;
-	for (int32_t i=0; i<len; i++)
-		result[i] = 1.0 / (1.0 + std::exp(-1.0 * result[i]));
+	Out.array() = 1.0/(1.0+(-Out.array()).exp());
 
 	if (sample_states && index>0)
-	{
-		UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
-		for (int32_t i=0; i<len; i++)
-			result[i] = uniform_real_dist(m_prng) < result[i];
-	}
+		RBM::sample_bernoulli(result, result, m_prng);
 }
 
 void DeepBeliefNetwork::wake_sleep(SGMatrix< float64_t > data, std::shared_ptr<RBM> top_rbm,
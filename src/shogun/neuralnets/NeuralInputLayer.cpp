@@ -32,6 +32,7 @@
  */
 
 #include <shogun/neuralnets/NeuralInputLayer.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
@@ -73,10 +74,15 @@ void NeuralInputLayer::compute_activations(SGMatrix< float64_t > inputs)
 	}
 	if (gaussian_noise > 0)
 	{
+		// the noise is drawn for the whole batch and added to the inputs
 		int32_t len = m_num_neurons*m_batch_size;
+		SGVector<float64_t> noise(len);
 		random::fill_array(
-			m_activations.matrix, m_activations.matrix+len,
+			noise.vector, noise.vector+len,
 			NormalDistribution<float64_t>(0.0, gaussian_noise), m_prng);
+
+		Eigen::Map<Eigen::ArrayXd>(m_activations.matrix, len) +=
+			Eigen::Map<const Eigen::ArrayXd>(noise.vector, len);
 	}
 }
 
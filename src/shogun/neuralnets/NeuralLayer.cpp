@@ -34,7 +34,9 @@
 #include <shogun/neuralnets/NeuralLayer.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
 
@@ -81,9 +83,24 @@ void NeuralLayer::set_batch_size(int32_t batch_size)
 
 	if (!is_input())
 	{
-		m_activation_gradients =
+		int64_t length = int64_t(m_num_neurons)*m_batch_size;
+		require(m_activation_gradients_buffer.vlen==0 ||
+			m_activation_gradients_buffer.vlen>=length,
+			"Activation gradients buffer ({}) is smaller than {}",
+			m_activation_gradients_buffer.vlen, length);
+		require(m_local_gradients_buffer.vlen==0 ||
+			m_local_gradients_buffer.vlen>=length,
+			"Local gradients buffer ({}) is smaller than {}",
+			m_local_gradients_buffer.vlen, length);
+
+		m_activation_gradients = m_activation_gradients_buffer.vlen ?
+			SGMatrix<float64_t>(m_activation_gradients_buffer.vector,
+				m_num_neurons, m_batch_size, false) :
+			SGMatrix<float64_t>(m_num_neurons, m_batch_size);
+		m_local_gradients = m_local_gradients_buffer.vlen ?
+			SGMatrix<float64_t>(m_local_gradients_buffer.vector,
+				m_num_neurons, m_batch_size, false) :
 			SGMatrix<float64_t>(m_num_neurons, m_batch_size);
-		m_local_gradients = SGMatrix<float64_t>(m_num_neurons, m_batch_size);
 	}
 }
 
@@ -91,23 +108,23 @@ void NeuralLayer::dropout_activations()
 {
 	if (dropout_prop==0.0) return;
 
+	int32_t len = m_num_neurons*m_batch_size;
+	Eigen::Map<Eigen::ArrayXd> activations(m_activations.matrix, len);
 	if (is_training)
 	{
-		UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
-
-		int32_t len = m_num_neurons*m_batch_size;
-		for (int32_t i=0; i<len; i++)
-		{
-			m_dropout_mask[i] = uniform_real_dist(m_prng) >= dropout_prop;
-			m_activations[i] *= m_dropout_mask[i];
-		}
+		SGVector<float64_t> uniforms(len);
+		random::fill_array(
+			uniforms.vector, uniforms.vector+len,
+			UniformRealDistribution<float64_t>(0.0, 1.0), m_prng);
+
+		Eigen::Map<Eigen::Array<bool, Eigen::Dynamic, 1>> mask(
+			m_dropout_mask.matrix, len);
+		mask = Eigen::Map<const Eigen::ArrayXd>(uniforms.vector, len) >=
+			dropout_prop;
+		activations *= mask.cast<float64_t>();
 	}
 	else
-	{
-		int32_t len = m_num_neurons*m_batch_size;
-		for (int32_t i=0; i<len; i++)
-			m_activations[i] *= (1.0-dropout_prop);
-	}
+		activations *= (1.0-dropout_prop);
 }
 
 void NeuralLayer::init()
@@ -121,6 +138,7 @@ void NeuralLayer::init()
 	contraction_coefficient = 0.0;
 	is_training = false;
 	autoencoder_position = NLAP_NONE;
+	precision = NLP_DOUBLE;
 
 	SG_ADD(&m_num_neurons, "num_neurons", "Number of Neurons");
 	SG_ADD(&m_width, "width", "Width");
@@ -144,4 +162,8 @@ void NeuralLayer::init()
 	    (machine_int_t*)&autoencoder_position, "autoencoder_position",
 	    "Autoencoder Position", ParameterProperties::NONE,
 	    SG_OPTIONS(NLAP_NONE, NLAP_ENCODING, NLAP_DECODING));
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&precision, "precision",
+	    "Precision of the matrix products", ParameterProperties::NONE,
+	    SG_OPTIONS(NLP_DOUBLE, NLP_SINGLE));
 }
@@ -56,6 +56,37 @@ enum ENLAutoencoderPosition
 	NLAP_DECODING=2
 };
 
+/** Precision of the matrix products of forward and backward propagation */
+enum ENLPrecision
+{
+	/** Products in double precision */
+	NLP_DOUBLE=0,
+	/** Products in single precision, the operands are rounded to float32.
+	 * Activations and parameters are still stored in double precision.
+	 */
+	NLP_SINGLE=1
+};
+
+/** Adds the product of two Eigen expressions to a destination,
+ * \f$ C \mathrel{+}= AB \f$, in the given precision
+ *
+ * @param C Destination
+ * @param A Left factor
+ * @param B Right factor
+ * @param precision Precision of the product
+ */
+template <class Dest, class Lhs, class Rhs>
+void add_product(Dest&& C, const Lhs& A, const Rhs& B, ENLPrecision precision)
+{
+	if (precision==NLP_SINGLE)
+	{
+		C += (A.template cast<float32_t>()*B.template cast<float32_t>())
+			.template cast<float64_t>();
+	}
+	else
+		C.noalias() += A*B;
+}
+
 template <class T> class SGVector;
 
 /** @brief Base class for neural network layers
@@ -119,6 +150,23 @@ public:
 	 */
 	virtual void set_batch_size(int32_t batch_size);
 
+	/** Makes set_batch_size() take the activation gradients and the local
+	 * gradients from the given memory instead of allocating their own. A
+	 * network uses this to share the memory between layers whose gradients
+	 * are not alive at the same time during backpropagation.
+	 *
+	 * @param activation_gradients memory of at least
+	 * num_neurons*batch_size values, empty to allocate
+	 * @param local_gradients memory of at least num_neurons*batch_size
+	 * values, empty to allocate
+	 */
+	void set_gradient_buffers(SGVector<float64_t> activation_gradients,
+		SGVector<float64_t> local_gradients)
+	{
+		m_activation_gradients_buffer = activation_gradients;
+		m_local_gradients_buffer = local_gradients;
+	}
+
 	/** returns true if the layer is an input layer. Input layers are the root
 	 * layers of a network, that is, they don't receive signals from other
 	 * layers, they receive signals from the inputs features to the network.
@@ -344,6 +392,11 @@ public:
 	 */
 	ENLAutoencoderPosition autoencoder_position;
 
+	/** Precision of the matrix products of forward and backward
+	 * propagation. Default value is NLP_DOUBLE
+	 */
+	ENLPrecision precision;
+
 protected:
 	/** Number of neurons in this layer */
 	int32_t m_num_neurons;
@@ -393,6 +446,12 @@ protected:
 	 * size num_neurons * batch_size
 	 */
 	SGMatrix<bool> m_dropout_mask;
+
+	/** memory of the activation gradients, shared with other layers */
+	SGVector<float64_t> m_activation_gradients_buffer;
+
+	/** memory of the local gradients, shared with other layers */
+	SGVector<float64_t> m_local_gradients_buffer;
 };
 
 }
@@ -101,7 +101,7 @@ void NeuralLinearLayer::compute_activations(
 		EMappedMatrix X(layer->get_activations().matrix,
 				layer->get_num_neurons(), m_batch_size);
 
-		A += W*X;
+		add_product(A, W, X, precision);
 
 	}
 }
@@ -152,11 +152,12 @@ void NeuralLinearLayer::compute_gradients(
 				layer->get_num_neurons(), m_batch_size);
 
 		// compute weight gradients
-		WG = LG*X.transpose();
+		WG.setZero();
+		add_product(WG, LG, X.transpose(), precision);
 
 		// compute input gradients
 		if (!layer->is_input())
-			IG += W.transpose()*LG;
+			add_product(IG, W.transpose(), LG, precision);
 
 	}
 
@@ -221,17 +222,21 @@ void NeuralLinearLayer::enforce_max_norm(SGVector<float64_t> parameters,
 
 float64_t NeuralLinearLayer::compute_contraction_term(SGVector<float64_t> parameters)
 {
-	float64_t contraction_term = 0;
-	for (int32_t i=m_num_neurons; i<parameters.vlen; i++)
-		contraction_term += parameters[i]*parameters[i];
+	Eigen::Map<const Eigen::VectorXd> W(parameters.vector+m_num_neurons,
+		parameters.vlen-m_num_neurons);
 
-	return contraction_coefficient*contraction_term;
+	return contraction_coefficient*W.squaredNorm();
 }
 
 void NeuralLinearLayer::compute_contraction_term_gradients(
 	SGVector< float64_t > parameters, SGVector< float64_t > gradients)
 {
-	for (int32_t i=m_num_neurons; i<parameters.vlen; i++)
-			gradients[i] += 2*contraction_coefficient*parameters[i];
+	int32_t num_weights = parameters.vlen-m_num_neurons;
+	Eigen::Map<const Eigen::VectorXd> W(parameters.vector+m_num_neurons,
+		num_weights);
+	Eigen::Map<Eigen::VectorXd> WG(gradients.vector+m_num_neurons,
+		num_weights);
+
+	WG += 2*contraction_coefficient*W;
 }
 
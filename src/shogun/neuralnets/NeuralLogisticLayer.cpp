@@ -32,6 +32,7 @@
  */
 
 #include <shogun/neuralnets/NeuralLogisticLayer.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/SGVector.h>
 
@@ -63,22 +64,15 @@ float64_t NeuralLogisticLayer::compute_contraction_term(
 {
 	int32_t num_inputs = SGVector<int32_t>::sum(m_input_sizes.vector, m_input_sizes.vlen);
 
-	SGMatrix<float64_t> W(parameters.vector+m_num_neurons,
-		m_num_neurons, num_inputs, false);
+	Eigen::Map<const Eigen::MatrixXd> W(parameters.vector+m_num_neurons,
+		m_num_neurons, num_inputs);
+	Eigen::Map<const Eigen::ArrayXXd> H(m_activations.matrix,
+		m_num_neurons, m_batch_size);
 
-	float64_t contraction_term = 0;
-	for (int32_t i=0; i<m_num_neurons; i++)
-	{
-		float64_t sum_j = 0;
-		for (int32_t j=0; j<num_inputs; j++)
-			sum_j += W(i,j)*W(i,j);
-
-		for (int32_t k=0; k<m_batch_size; k++)
-		{
-			float64_t h_ = m_activations(i,k)*(1-m_activations(i,k));
-			contraction_term += h_*h_*sum_j;
-		}
-	}
+	// sum_i ||W(i,:)||^2 sum_k (h_ik(1-h_ik))^2
+	Eigen::ArrayXd slopes = (H*(1-H)).square().rowwise().sum();
+	float64_t contraction_term =
+		(W.rowwise().squaredNorm().array()*slopes).sum();
 
 	return (contraction_coefficient/m_batch_size) * contraction_term;
 }
@@ -88,27 +82,22 @@ void NeuralLogisticLayer::compute_contraction_term_gradients(
 {
 	int32_t num_inputs = SGVector<int32_t>::sum(m_input_sizes.vector, m_input_sizes.vlen);
 
-	SGMatrix<float64_t> W(parameters.vector+m_num_neurons,
-		m_num_neurons, num_inputs, false);
-	SGMatrix<float64_t> WG(gradients.vector+m_num_neurons,
-		m_num_neurons, num_inputs, false);
-
-	for (int32_t k = 0; k<m_batch_size; k++)
-	{
-		for (int32_t i=0; i<m_num_neurons; i++)
-		{
-			for (int32_t j=0; j<num_inputs; j++)
-			{
-				float64_t h = m_activations(i,k);
-				float64_t w = W(i,j);
-				float64_t h_ = w*h*(1-h);
-
-				float64_t g = 2*w*(h-1)*h*(h*(2*w*h_-1)-w*h_+h*h);
-
-				WG(i,j) += (contraction_coefficient/m_batch_size)*g;
-			}
-		}
-	}
+	Eigen::Map<const Eigen::ArrayXXd> W(parameters.vector+m_num_neurons,
+		m_num_neurons, num_inputs);
+	Eigen::Map<Eigen::ArrayXXd> WG(gradients.vector+m_num_neurons,
+		m_num_neurons, num_inputs);
+	Eigen::Map<const Eigen::ArrayXXd> H(m_activations.matrix,
+		m_num_neurons, m_batch_size);
+
+	// the gradient of a weight is a sum over the cases of
+	// 2*w*s^2*(1-w^2*(2h-1)) with s=h(1-h), the sums over the cases of s^2
+	// and s^2*(2h-1) are the same for all weights of a neuron
+	Eigen::ArrayXXd S2 = (H*(1-H)).square();
+	Eigen::ArrayXd a = S2.rowwise().sum();
+	Eigen::ArrayXd b = (S2*(2*H-1)).rowwise().sum();
+
+	WG += (2*contraction_coefficient/m_batch_size)*W*
+		(a.replicate(1, num_inputs)-W.square()*b.replicate(1, num_inputs));
 }
 
 
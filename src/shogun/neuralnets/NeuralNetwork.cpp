@@ -31,15 +31,24 @@
  * Written (W) 2014 Khaled Nasr
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/neuralnets/NeuralInputLayer.h>
 #include <shogun/neuralnets/NeuralLayer.h>
+#include <shogun/neuralnets/NeuralLeakyRectifiedLinearLayer.h>
 #include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/neuralnets/NeuralNetworkPredictor.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 
+#include <algorithm>
+#include <future>
+
 using namespace shogun;
 
 NeuralNetwork::NeuralNetwork()
@@ -59,6 +68,7 @@ void NeuralNetwork::set_layers(
     const std::vector<std::shared_ptr<NeuralLayer>>& layers)
 {
 	m_layers = layers;
+	m_shard_layers.clear();
 	init_adj_matrix();
 }
 
@@ -102,6 +112,7 @@ void NeuralNetwork::disconnect_all()
 void NeuralNetwork::initialize_neural_network(float64_t sigma)
 {
 	m_sigma = sigma;
+	m_shard_layers.clear();
 	for (int32_t j=0; j<m_num_layers; j++)
 	{
 		if (!get_layer(j)->is_input())
@@ -150,9 +161,9 @@ void NeuralNetwork::initialize_neural_network(float64_t sigma)
 
 		get_layer(i)->initialize_parameters(layer_param,
 			layer_param_regularizable, m_sigma);
-
-		get_layer(i)->set_batch_size(m_batch_size);
 	}
+
+	m_gradient_buffers = plan_batch_size(m_layers, m_batch_size);
 }
 
 NeuralNetwork::~NeuralNetwork()
@@ -242,7 +253,19 @@ bool NeuralNetwork::train_machine(std::shared_ptr<Features> data)
 	require(m_max_num_epochs>=0,
 		"Maximum number of epochs ({}) must be >= 0", m_max_num_epochs);
 
-	SGMatrix<float64_t> inputs = features_to_matrix(data);
+	require(data != NULL, "Invalid (NULL) feature pointer");
+	const bool streaming = data->get_feature_class() == C_STREAMING_DENSE;
+	if (streaming)
+	{
+		require(data->get_feature_type() == F_DREAL,
+			"Feature type must be F_DREAL");
+		require(m_optimization_method==NNOM_GRADIENT_DESCENT,
+			"Streaming features can only be trained with gradient descent");
+	}
+
+	SGMatrix<float64_t> inputs;
+	if (!streaming)
+		inputs = features_to_matrix(data);
 	SGMatrix<float64_t> targets = labels_to_matrix(m_labels);
 
 	for (int32_t i=0; i<m_num_layers-1; i++)
@@ -257,7 +280,10 @@ bool NeuralNetwork::train_machine(std::shared_ptr<Features> data)
 		get_layer(i)->is_training = true;
 
 	bool result = false;
-	if (m_optimization_method==NNOM_GRADIENT_DESCENT)
+	if (streaming)
+		result = train_streaming_gradient_descent(
+			data->as<StreamingDenseFeatures<float64_t>>(), targets);
+	else if (m_optimization_method==NNOM_GRADIENT_DESCENT)
 		result = train_gradient_descent(inputs, targets);
 	else if (m_optimization_method==NNOM_LBFGS)
 		result = train_lbfgs(inputs, targets);
@@ -313,37 +339,176 @@ bool NeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> inputs_batch(inputs.matrix+j*m_num_inputs,
 				m_num_inputs, m_gd_mini_batch_size, false);
 
-			for (int32_t k=0; k<n_param; k++)
-				m_params[k] += m_gd_momentum*param_updates[k];
+			float64_t e = gradient_descent_step(inputs_batch, targets_batch,
+				gradients, param_updates, alpha);
+
+			// filter the errors
+			if (error==-1.0)
+				error = e;
+			else
+				error = (1.0-c) * error + c*e;
+
+			if (error_last_time!=-1.0)
+			{
+				float64_t error_change = (error_last_time-error)/error;
+				if (error_change< m_epsilon && error_change>=0)
+				{
+					io::info("Gradient Descent Optimization Converged");
+					continue_training = false;
+					break;
+				}
+
+				io::info("Epoch {}: Error = {}",i, error);
+			}
+			error_last_time = error;
+		}
+	}
+
+	return true;
+}
+
+bool NeuralNetwork::train_streaming_gradient_descent(
+		std::shared_ptr<StreamingDenseFeatures<float64_t>> features,
+		SGMatrix<float64_t> targets)
+{
+	require(m_gd_learning_rate>0,
+		"Gradient descent learning rate ({}) must be > 0", m_gd_learning_rate);
+	require(m_gd_momentum>=0,
+		"Gradient descent momentum ({}) must be >= 0", m_gd_momentum);
+	require(m_shuffle_buffer_size>0,
+		"Shuffle buffer size ({}) must be > 0", m_shuffle_buffer_size);
+
+	// the stream is as long as the labels
+	int32_t training_set_size = targets.num_cols;
+	int32_t batch_size = m_gd_mini_batch_size>0 ?
+		m_gd_mini_batch_size : training_set_size;
+	int32_t num_outputs = get_num_outputs();
+
+	int32_t n_param = get_num_parameters();
+	SGVector<float64_t> gradients(n_param);
 
-			float64_t e = compute_gradients(inputs_batch, targets_batch, gradients);
+	// needed for momentum
+	SGVector<float64_t> param_updates(n_param);
+	param_updates.zero();
 
+	float64_t error_last_time = -1.0, error = -1.0;
 
-			for (int32_t k=0; k<m_num_layers; k++)
+	float64_t c = m_gd_error_damping_coeff;
+	if (c==-1.0)
+		c = 0.99*(float64_t)batch_size/training_set_size + 1e-2;
+
+	// examples waiting to be drawn, with their positions in the stream
+	SGMatrix<float64_t> buffer(m_num_inputs, m_shuffle_buffer_size);
+	SGVector<index_t> buffer_positions(m_shuffle_buffer_size);
+	int32_t num_buffered = 0;
+	int32_t num_streamed = 0;
+	bool exhausted = false;
+
+	// two minibatches, one is filled while the other one is trained on
+	SGMatrix<float64_t> inputs_batches[2] = {
+		SGMatrix<float64_t>(m_num_inputs, batch_size),
+		SGMatrix<float64_t>(m_num_inputs, batch_size)};
+	SGMatrix<float64_t> targets_batches[2] = {
+		SGMatrix<float64_t>(num_outputs, batch_size),
+		SGMatrix<float64_t>(num_outputs, batch_size)};
+
+	// the layers may use m_prng while a minibatch is filled
+	prng_type prng(m_prng());
+	UniformIntDistribution<int32_t> uniform_int;
+
+	auto fill_batch = [&](int32_t b)
+	{
+		int32_t n = 0;
+		while (n<batch_size)
+		{
+			while (!exhausted && num_buffered<m_shuffle_buffer_size)
 			{
-				SGVector<float64_t> layer_gradients = get_section(gradients, k);
-				if (layer_gradients.vlen > 0)
+				if (!features->get_next_example())
 				{
-					io::info("Layer {} ({}), Max Gradient: {:g}, Mean Gradient: {:g}.", k,get_layer(k)->get_name(),
-						Math::max(layer_gradients.vector, layer_gradients.vlen),
-						SGVector<float64_t>::sum(layer_gradients.vector, layer_gradients.vlen)/layer_gradients.vlen);
+					exhausted = true;
+					break;
 				}
+
+				SGVector<float64_t> vec = features->get_vector();
+				require(vec.vlen==m_num_inputs,
+					"Number of features ({}) must match the network's number "
+					"of inputs ({})", vec.vlen, m_num_inputs);
+				require(num_streamed<training_set_size,
+					"Number of streamed vectors exceeds the number of labels "
+					"({})", training_set_size);
+
+				sg_memcpy(buffer.get_column_vector(num_buffered), vec.vector,
+					sizeof(float64_t)*m_num_inputs);
+				buffer_positions[num_buffered++] = num_streamed++;
+				features->release_example();
 			}
 
+			if (num_buffered==0)
+				break;
+
+			int32_t r = uniform_int(prng, {0, num_buffered-1});
+			sg_memcpy(inputs_batches[b].get_column_vector(n),
+				buffer.get_column_vector(r), sizeof(float64_t)*m_num_inputs);
+			sg_memcpy(targets_batches[b].get_column_vector(n),
+				targets.get_column_vector(buffer_positions[r]),
+				sizeof(float64_t)*num_outputs);
+			n++;
+
+			num_buffered--;
+			sg_memcpy(buffer.get_column_vector(r),
+				buffer.get_column_vector(num_buffered),
+				sizeof(float64_t)*m_num_inputs);
+			buffer_positions[r] = buffer_positions[num_buffered];
+		}
+		return n;
+	};
+
+	bool continue_training = true;
+	float64_t alpha = m_gd_learning_rate;
+
+	features->start_parser();
+	for (auto i : SG_PROGRESS(
+	         range(0, m_max_num_epochs), [&] { return continue_training; }))
+	{
+		if (i>0)
+		{
+			if (!features->is_seekable())
+			{
+				io::warn("Stream is not seekable, training stops after one "
+					"epoch");
+				break;
+			}
+			features->reset_stream();
+			num_streamed = 0;
+			exhausted = false;
+		}
+
+		auto next = std::async(std::launch::async, fill_batch, 0);
+		for (int32_t b=0; ; b=1-b)
+		{
+			int32_t n = next.get();
+			if (n==0)
+				break;
+			if (n==batch_size)
+				next = std::async(std::launch::async, fill_batch, 1-b);
+
+			alpha = m_gd_learning_rate_decay*alpha;
+
+			set_batch_size(n);
+			SGMatrix<float64_t> inputs_batch(inputs_batches[b].matrix,
+				m_num_inputs, n, false);
+			SGMatrix<float64_t> targets_batch(targets_batches[b].matrix,
+				num_outputs, n, false);
+
+			float64_t e = gradient_descent_step(inputs_batch, targets_batch,
+				gradients, param_updates, alpha);
+
 			// filter the errors
 			if (error==-1.0)
 				error = e;
 			else
 				error = (1.0-c) * error + c*e;
 
-			for (int32_t k=0; k<n_param; k++)
-			{
-				param_updates[k] = m_gd_momentum*param_updates[k]
-						-alpha*gradients[k];
-
-				m_params[k] -= alpha*gradients[k];
-			}
-
 			if (error_last_time!=-1.0)
 			{
 				float64_t error_change = (error_last_time-error)/error;
@@ -357,12 +522,59 @@ bool NeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
 				io::info("Epoch {}: Error = {}",i, error);
 			}
 			error_last_time = error;
+
+			if (n<batch_size)
+				break;
+		}
+
+		// wait for a minibatch that is still being filled
+		if (next.valid())
+			next.wait();
+
+		if (num_streamed==0)
+		{
+			io::warn("No vectors were streamed in epoch {}", i);
+			break;
 		}
 	}
+	features->end_parser();
 
 	return true;
 }
 
+float64_t NeuralNetwork::gradient_descent_step(SGMatrix<float64_t> inputs,
+		SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+		SGVector<float64_t> param_updates, float64_t alpha)
+{
+	int32_t n_param = get_num_parameters();
+
+	for (int32_t k=0; k<n_param; k++)
+		m_params[k] += m_gd_momentum*param_updates[k];
+
+	float64_t e = compute_gradients(inputs, targets, gradients);
+
+	for (int32_t k=0; k<m_num_layers; k++)
+	{
+		SGVector<float64_t> layer_gradients = get_section(gradients, k);
+		if (layer_gradients.vlen > 0)
+		{
+			io::info("Layer {} ({}), Max Gradient: {:g}, Mean Gradient: {:g}.", k,get_layer(k)->get_name(),
+				Math::max(layer_gradients.vector, layer_gradients.vlen),
+				SGVector<float64_t>::sum(layer_gradients.vector, layer_gradients.vlen)/layer_gradients.vlen);
+		}
+	}
+
+	for (int32_t k=0; k<n_param; k++)
+	{
+		param_updates[k] = m_gd_momentum*param_updates[k]
+				-alpha*gradients[k];
+
+		m_params[k] -= alpha*gradients[k];
+	}
+
+	return e;
+}
+
 bool NeuralNetwork::train_lbfgs(SGMatrix<float64_t> inputs,
 		const SGMatrix<float64_t> targets)
 {
@@ -461,6 +673,7 @@ SGMatrix<float64_t> NeuralNetwork::forward_propagate(
 	for (int32_t i=0; i<=j; i++)
 	{
 		auto layer = get_layer(i);
+		layer->precision = m_precision;
 
 		if (layer->is_input())
 			layer->compute_activations(inputs);
@@ -476,22 +689,18 @@ SGMatrix<float64_t> NeuralNetwork::forward_propagate(
 float64_t NeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 		SGMatrix<float64_t> targets, SGVector<float64_t> gradients)
 {
-	forward_propagate(inputs);
+	int32_t num_shards = get_num_shards(inputs.num_cols);
 
-	for (int32_t i=0; i<m_num_layers; i++)
+	float64_t shards_error = 0;
+	if (num_shards>1)
 	{
-		if (!get_layer(i)->is_input())
-			get_layer(i)->get_activation_gradients().zero();
+		shards_error =
+			compute_shard_gradients(inputs, targets, gradients, num_shards);
 	}
-
-	for (int32_t i=m_num_layers-1; i>=0; i--)
+	else
 	{
-		if (i==m_num_layers-1)
-			get_layer(i)->compute_gradients(get_section(m_params,i), targets,
-				m_layers, get_section(gradients,i));
-		else
-			get_layer(i)->compute_gradients(get_section(m_params,i),
-				SGMatrix<float64_t>(), m_layers, get_section(gradients,i));
+		forward_propagate(inputs);
+		backpropagate(m_layers, targets, gradients);
 	}
 
 	// L2 regularization
@@ -525,12 +734,249 @@ float64_t NeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 		}
 	}
 
+	if (num_shards>1)
+		return shards_error+compute_regularization_error();
+
 	return compute_error(targets);
 }
 
+int32_t NeuralNetwork::get_num_shards(int32_t batch_size) const
+{
+	if (m_shard_size<=0)
+		return 1;
+
+	return std::min(64, batch_size/m_shard_size);
+}
+
+float64_t NeuralNetwork::compute_shard_gradients(SGMatrix<float64_t> inputs,
+		SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+		int32_t num_shards)
+{
+	int32_t batch_size = inputs.num_cols;
+	auto shard_begin = [&](int32_t s)
+	{
+		return int32_t((int64_t)batch_size*s/num_shards);
+	};
+
+	// copies of the layers, each with its own random stream for dropout
+	bool rebuild = int32_t(m_shard_layers.size())!=num_shards;
+	for (int32_t s=0; s<num_shards && !rebuild; s++)
+	{
+		rebuild = m_shard_layers[s].size()!=m_layers.size() ||
+			m_shard_layers[s][0]->get_activations().num_cols!=
+			shard_begin(s+1)-shard_begin(s);
+	}
+	if (rebuild)
+	{
+		m_shard_layers.assign(num_shards, {});
+		m_shard_gradient_buffers.assign(num_shards, {});
+		for (int32_t s=0; s<num_shards; s++)
+		{
+			for (int32_t i=0; i<m_num_layers; i++)
+			{
+				auto layer = get_layer(i)->clone()->as<NeuralLayer>();
+				random::seed(layer, m_prng);
+				m_shard_layers[s].push_back(layer);
+			}
+			m_shard_gradient_buffers[s] = plan_batch_size(
+				m_shard_layers[s], shard_begin(s+1)-shard_begin(s));
+		}
+	}
+
+	std::vector<SGVector<float64_t>> shard_gradients(num_shards);
+	std::vector<float64_t> shard_errors(num_shards);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int32_t s=0; s<num_shards; s++)
+	{
+		auto& layers = m_shard_layers[s];
+		int32_t begin = shard_begin(s);
+		int32_t size = shard_begin(s+1)-begin;
+
+		SGMatrix<float64_t> shard_inputs(inputs.matrix+begin*inputs.num_rows,
+			inputs.num_rows, size, false);
+		SGMatrix<float64_t> shard_targets(targets.matrix+begin*targets.num_rows,
+			targets.num_rows, size, false);
+
+		for (int32_t i=0; i<m_num_layers; i++)
+		{
+			auto original = get_layer(i);
+			auto& layer = layers[i];
+			layer->dropout_prop = original->dropout_prop;
+			layer->is_training = original->is_training;
+			layer->contraction_coefficient = original->contraction_coefficient;
+			layer->precision = m_precision;
+			if (layer->is_input())
+			{
+				std::static_pointer_cast<NeuralInputLayer>(layer)->gaussian_noise =
+					std::static_pointer_cast<NeuralInputLayer>(original)->gaussian_noise;
+			}
+
+			if (layer->is_input())
+				layer->compute_activations(shard_inputs);
+			else
+				layer->compute_activations(get_section(m_params, i), layers);
+
+			layer->dropout_activations();
+		}
+
+		SGVector<float64_t> shard_gradient(m_total_num_parameters);
+		backpropagate(layers, shard_targets, shard_gradient);
+
+		shard_gradients[s] = shard_gradient;
+		shard_errors[s] = layers[m_num_layers-1]->compute_error(shard_targets);
+
+		// contraction terms of autoencoders are means over the cases too
+		for (int32_t i=0; i<m_num_layers; i++)
+		{
+			if (layers[i]->contraction_coefficient != 0.0)
+			{
+				shard_errors[s] += layers[i]->compute_contraction_term(
+					get_section(m_params, i));
+			}
+		}
+	}
+
+	// the errors and gradients of the layers are means over the cases
+	float64_t error = 0;
+	gradients.zero();
+	for (int32_t s=0; s<num_shards; s++)
+	{
+		float64_t weight =
+			float64_t(shard_begin(s+1)-shard_begin(s))/batch_size;
+		for (int32_t i=0; i<m_total_num_parameters; i++)
+			gradients[i] += weight*shard_gradients[s][i];
+		error += weight*shard_errors[s];
+	}
+
+	return error;
+}
+
+void NeuralNetwork::backpropagate(
+		const std::vector<std::shared_ptr<NeuralLayer>>& layers,
+		SGMatrix<float64_t> targets, SGVector<float64_t> gradients)
+{
+	std::vector<int32_t> last_consumers = get_last_consumers(layers);
+
+	for (int32_t i=m_num_layers-1; i>=0; i--)
+	{
+		// the activation gradients of a layer come alive at the last layer
+		// that adds to them, their memory may have been used before
+		for (int32_t k=0; k<=i; k++)
+		{
+			if (last_consumers[k]==i && !layers[k]->is_input())
+				layers[k]->get_activation_gradients().zero();
+		}
+
+		layers[i]->compute_gradients(get_section(m_params,i),
+			i==m_num_layers-1 ? targets : SGMatrix<float64_t>(),
+			layers, get_section(gradients,i));
+	}
+}
+
+std::vector<int32_t> NeuralNetwork::get_last_consumers(
+		const std::vector<std::shared_ptr<NeuralLayer>>& layers)
+{
+	int32_t num_layers = layers.size();
+
+	std::vector<int32_t> last_consumers(num_layers);
+	for (int32_t i=0; i<num_layers; i++)
+		last_consumers[i] = i;
+
+	for (int32_t j=0; j<num_layers; j++)
+	{
+		SGVector<int32_t> input_indices = layers[j]->get_input_indices();
+		for (int32_t k=0; k<input_indices.vlen; k++)
+		{
+			last_consumers[input_indices[k]] =
+				std::max(last_consumers[input_indices[k]], j);
+		}
+	}
+
+	return last_consumers;
+}
+
+std::vector<SGVector<float64_t>> NeuralNetwork::plan_batch_size(
+		const std::vector<std::shared_ptr<NeuralLayer>>& layers,
+		int32_t batch_size)
+{
+	int32_t num_layers = layers.size();
+	std::vector<int32_t> last_consumers = get_last_consumers(layers);
+
+	// During backpropagation the activation gradients of layer i are alive
+	// from the step of its last consumer down to step i. Layers are given
+	// buffers in the order their gradients come alive, a buffer is free
+	// once the step of its previous layer has passed.
+	std::vector<int32_t> order;
+	for (int32_t i=num_layers-1; i>=0; i--)
+	{
+		if (!layers[i]->is_input())
+			order.push_back(i);
+	}
+	std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b)
+	{
+		return last_consumers[a]>last_consumers[b];
+	});
+
+	std::vector<int32_t> buffer_of(num_layers, -1);
+	std::vector<int32_t> buffer_last_layer;
+	std::vector<int64_t> buffer_length;
+	int64_t max_length = 0;
+	for (auto i : order)
+	{
+		int64_t length = int64_t(layers[i]->get_num_neurons())*batch_size;
+		max_length = std::max(max_length, length);
+
+		int32_t b = 0;
+		while (b<int32_t(buffer_last_layer.size()) &&
+			buffer_last_layer[b]<=last_consumers[i])
+			b++;
+
+		if (b==int32_t(buffer_last_layer.size()))
+		{
+			buffer_last_layer.push_back(i);
+			buffer_length.push_back(length);
+		}
+		else
+		{
+			buffer_last_layer[b] = i;
+			buffer_length[b] = std::max(buffer_length[b], length);
+		}
+		buffer_of[i] = b;
+	}
+
+	std::vector<SGVector<float64_t>> buffers;
+	for (auto length : buffer_length)
+		buffers.push_back(SGVector<float64_t>(length));
+
+	// local gradients only live during the backpropagation step of their
+	// layer, all layers share them
+	SGVector<float64_t> local_gradients;
+	if (max_length>0)
+	{
+		local_gradients = SGVector<float64_t>(max_length);
+		buffers.push_back(local_gradients);
+	}
+
+	for (int32_t i=0; i<num_layers; i++)
+	{
+		if (buffer_of[i]>=0)
+			layers[i]->set_gradient_buffers(buffers[buffer_of[i]], local_gradients);
+		layers[i]->set_batch_size(batch_size);
+	}
+
+	return buffers;
+}
+
 float64_t NeuralNetwork::compute_error(SGMatrix<float64_t> targets)
 {
-	float64_t error = get_layer(m_num_layers-1)->compute_error(targets);
+	return get_layer(m_num_layers-1)->compute_error(targets)+
+		compute_regularization_error();
+}
+
+float64_t NeuralNetwork::compute_regularization_error()
+{
+	float64_t error = 0;
 
 	// L2 regularization
 	if (m_l2_coefficient != 0.0)
@@ -616,8 +1062,7 @@ void NeuralNetwork::set_batch_size(int32_t batch_size)
 	if (batch_size!=m_batch_size)
 	{
 		m_batch_size = batch_size;
-		for (int32_t i=0; i<m_num_layers; i++)
-			get_layer(i)->set_batch_size(m_batch_size);
+		m_gradient_buffers = plan_batch_size(m_layers, m_batch_size);
 	}
 }
 
@@ -761,11 +1206,77 @@ const std::vector<std::shared_ptr<NeuralLayer>>& NeuralNetwork::get_layers() con
 	return m_layers;
 }
 
+std::shared_ptr<NeuralNetworkPredictor> NeuralNetwork::compile_for_inference(
+	bool quantize) const
+{
+	require(m_num_layers>1, "The network must have at least two layers");
+
+	auto input = get_layer(0);
+	require(input->is_input() &&
+		input->as<NeuralInputLayer>()->get_start_index()==0 &&
+		input->get_num_neurons()==m_num_inputs,
+		"The first layer must be the only input layer of the network");
+	require(get_layer(m_num_layers-1)->dropout_prop==0.0,
+		"The output layer must not use dropout");
+
+	std::vector<NeuralNetworkPredictor::Layer> compiled;
+	for (int32_t i=1; i<m_num_layers; i++)
+	{
+		auto layer = get_layer(i);
+		auto previous = get_layer(i-1);
+
+		SGVector<int32_t> input_indices = layer->get_input_indices();
+		require(input_indices.vlen==1 && input_indices[0]==i-1,
+			"Layer {} ({}) must be connected only to layer {}", i,
+			layer->get_name(), i-1);
+
+		NeuralNetworkPredictor::Layer c;
+		c.alpha = 0;
+
+		const std::string name = layer->get_name();
+		if (name=="NeuralLinearLayer")
+			c.activation = NNPA_LINEAR;
+		else if (name=="NeuralLogisticLayer")
+			c.activation = NNPA_LOGISTIC;
+		else if (name=="NeuralRectifiedLinearLayer")
+			c.activation = NNPA_RECTIFIED_LINEAR;
+		else if (name=="NeuralLeakyRectifiedLinearLayer")
+		{
+			c.activation = NNPA_LEAKY_RECTIFIED_LINEAR;
+			c.alpha = layer->as<NeuralLeakyRectifiedLinearLayer>()->get_alpha();
+		}
+		else if (name=="NeuralSoftmaxLayer")
+			c.activation = NNPA_SOFTMAX;
+		else
+			error("Layer {} ({}) can not be compiled for inference", i, name);
+
+		const int32_t num_neurons = layer->get_num_neurons();
+		const int32_t num_inputs = previous->get_num_neurons();
+		SGVector<float64_t> params = get_section(m_params, i);
+
+		c.biases = SGVector<float64_t>(num_neurons);
+		sg_memcpy(c.biases.vector, params.vector,
+			sizeof(float64_t)*num_neurons);
+
+		// the activations of the previous layer are scaled by 1-p at
+		// inference, see NeuralLayer::dropout_activations()
+		c.weights = SGMatrix<float64_t>(num_neurons, num_inputs);
+		const float64_t scale = 1.0-previous->dropout_prop;
+		for (int32_t k=0; k<num_neurons*num_inputs; k++)
+			c.weights[k] = scale*params[num_neurons+k];
+
+		compiled.push_back(c);
+	}
+
+	return std::make_shared<NeuralNetworkPredictor>(compiled, quantize);
+}
+
 void NeuralNetwork::init()
 {
 	m_optimization_method = NNOM_LBFGS;
 	m_dropout_hidden = 0.0;
 	m_dropout_input = 0.0;
+	m_precision = NLP_DOUBLE;
 	m_max_norm = -1.0;
 	m_l2_coefficient = 0.0;
 	m_l1_coefficient = 0.0;
@@ -775,6 +1286,8 @@ void NeuralNetwork::init()
 	m_gd_learning_rate_decay = 1.0;
 	m_gd_momentum = 0.9;
 	m_gd_error_damping_coeff = -1.0;
+	m_shard_size = 64;
+	m_shuffle_buffer_size = 1024;
 	m_epsilon = 1.0e-5;
 	m_num_inputs = 0;
 	m_num_layers = 0;
@@ -817,6 +1330,16 @@ void NeuralNetwork::init()
 	    "Hidden neuron dropout probability");
 	SG_ADD(
 	    &m_dropout_input, "dropout_input", "Input neuron dropout probability");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_precision, "precision",
+	    "Precision of the matrix products", ParameterProperties::NONE,
+	    SG_OPTIONS(NLP_DOUBLE, NLP_SINGLE));
+	SG_ADD(
+	    &m_shard_size, "shard_size",
+	    "Minimum number of training cases per shard");
+	SG_ADD(
+	    &m_shuffle_buffer_size, "shuffle_buffer_size",
+	    "Number of examples in the shuffle buffer of streaming training");
 	SG_ADD(&m_max_norm, "max_norm", "Max Norm");
 	SG_ADD(
 	    &m_total_num_parameters, "total_num_parameters",
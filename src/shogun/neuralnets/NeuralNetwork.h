@@ -39,11 +39,14 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/RandomMixin.h>
+#include <shogun/neuralnets/NeuralLayer.h>
 
 namespace shogun
 {
 template<class T> class DenseFeatures;
 class NeuralLayer;
+class NeuralNetworkPredictor;
+template <class T> class StreamingDenseFeatures;
 
 /** optimization method for neural networks */
 enum ENNOptimizationMethod
@@ -240,6 +243,20 @@ public:
 	/** Returns an array holding the network's layers */
 	const std::vector<std::shared_ptr<NeuralLayer>>& get_layers() const;
 
+	/** Builds a frozen predictor for inference from the current parameters.
+	 * The network must be sequential: a single input layer followed by
+	 * NeuralLinearLayer, NeuralLogisticLayer, NeuralRectifiedLinearLayer,
+	 * NeuralLeakyRectifiedLinearLayer or NeuralSoftmaxLayer layers, each
+	 * connected only to the previous one. The inference scaling of dropout is
+	 * folded into the weights. The predictor does not change when the network
+	 * is trained further.
+	 *
+	 * @param quantize whether the weights are quantized to 8 bit integers
+	 * @return predictor computing the outputs of the network
+	 */
+	std::shared_ptr<NeuralNetworkPredictor> compile_for_inference(
+		bool quantize=false) const;
+
 	const char* get_name() const override { return "NeuralNetwork";}
 
 	/** Sets optimization method
@@ -325,6 +342,25 @@ public:
 		return m_dropout_input;
 	}
 
+	/** Sets the precision of the matrix products of forward and backward
+	 * propagation in all layers. Single precision roughly doubles their
+	 * throughput, activations and parameters are still stored in double
+	 * precision.
+	 * default value NLP_DOUBLE
+	 *
+	 * @param precision precision of the matrix products
+	 */
+	void set_precision(ENLPrecision precision)
+	{
+		m_precision = precision;
+	}
+
+	/** Returns the precision of the matrix products */
+	ENLPrecision get_precision() const
+	{
+		return m_precision;
+	}
+
 	/** Sets maximum allowable L2 norm for a neurons weights
 	 * When using this, a good value might be 15
 	 * default value -1 (max-norm regularization disabled)
@@ -467,6 +503,45 @@ public:
 		return m_gd_error_damping_coeff;
 	}
 
+	/** Sets the minimum number of training cases per shard. Batches of at
+	 * least twice this size are split into shards, whose gradients are
+	 * computed in parallel on copies of the layers and then averaged. The
+	 * shards depend only on the batch size, not on the number of threads.
+	 *
+	 * default value 64, 0 disables sharding
+	 *
+	 * @param shard_size minimum number of training cases per shard
+	 */
+	void set_shard_size(int32_t shard_size)
+	{
+		m_shard_size = shard_size;
+	}
+
+	/** Returns the minimum number of training cases per shard */
+	int32_t get_shard_size() const
+	{
+		return m_shard_size;
+	}
+
+	/** Sets the number of examples held in the shuffle buffer when training
+	 * on StreamingDenseFeatures. Each minibatch example is drawn uniformly
+	 * from the buffer, which is then refilled from the stream.
+	 *
+	 * default value 1024
+	 *
+	 * @param shuffle_buffer_size number of buffered examples
+	 */
+	void set_shuffle_buffer_size(int32_t shuffle_buffer_size)
+	{
+		m_shuffle_buffer_size = shuffle_buffer_size;
+	}
+
+	/** Returns the number of examples held in the shuffle buffer */
+	int32_t get_shuffle_buffer_size() const
+	{
+		return m_shuffle_buffer_size;
+	}
+
 protected:
 	/** trains the network */
 	bool train_machine(std::shared_ptr<Features> data=NULL) override;
@@ -475,6 +550,18 @@ protected:
 	virtual bool train_gradient_descent(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> targets);
 
+	/** trains the network using gradient descent on minibatches drawn
+	 * through a shuffle buffer from a stream, which is reset for every epoch.
+	 * The next minibatch is assembled while the gradients of the current one
+	 * are computed. Streams that are not seekable are trained for one epoch.
+	 *
+	 * @param features streamed inputs
+	 * @param targets targets of the examples in the order of the stream
+	 */
+	virtual bool train_streaming_gradient_descent(
+			std::shared_ptr<StreamingDenseFeatures<float64_t>> features,
+			SGMatrix<float64_t> targets);
+
 	/** trains the network using L-BFGS*/
 	virtual bool train_lbfgs(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> targets);
@@ -672,6 +759,9 @@ protected:
 	 */
 	float64_t m_dropout_input;
 
+	/** precision of the matrix products in all layers */
+	ENLPrecision m_precision;
+
 	/** Maximum allowable L2 norm for a neurons weights
 	 *When using this, a good value might be 15
 	 *
@@ -731,7 +821,76 @@ protected:
 	 */
 	float64_t m_gd_error_damping_coeff;
 
+	/** minimum number of training cases per shard, 0 disables sharding */
+	int32_t m_shard_size;
+
+	/** number of examples in the shuffle buffer of streaming training */
+	int32_t m_shuffle_buffer_size;
+
 private:
+	/** Applies one gradient descent step with momentum on a minibatch
+	 *
+	 * @param inputs inputs of the minibatch
+	 * @param targets targets of the minibatch
+	 * @param gradients vector to be filled with the parameter gradients
+	 * @param param_updates momentum of the parameter updates
+	 * @param alpha learning rate
+	 * @return error of the minibatch
+	 */
+	float64_t gradient_descent_step(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+			SGVector<float64_t> param_updates, float64_t alpha);
+
+	/** @return number of shards a batch is split into, 1 for none */
+	int32_t get_num_shards(int32_t batch_size) const;
+
+	/** Computes the gradients and the error of the output layer, without
+	 * regularization, on shards of the batch in parallel
+	 *
+	 * @return error between the targets and the activations of the last layer
+	 */
+	float64_t compute_shard_gradients(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+			int32_t num_shards);
+
+	/** @return L1 and L2 regularization terms of the error */
+	float64_t compute_regularization_error();
+
+	/** Backpropagates through forward propagated layers
+	 *
+	 * @param layers layers of the network or of a shard
+	 * @param targets desired activations of the last layer
+	 * @param gradients vector to be filled with the parameter gradients
+	 */
+	void backpropagate(const std::vector<std::shared_ptr<NeuralLayer>>& layers,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients);
+
+	/** @return for each layer the index of the last layer that takes it as
+	 * input, the layer itself if there is none
+	 */
+	static std::vector<int32_t> get_last_consumers(
+			const std::vector<std::shared_ptr<NeuralLayer>>& layers);
+
+	/** Sets the batch size of the layers, which share the memory of
+	 * gradients that are not alive at the same time during backpropagation
+	 *
+	 * @param layers layers of the network or of a shard
+	 * @param batch_size batch size
+	 * @return the shared memory
+	 */
+	static std::vector<SGVector<float64_t>> plan_batch_size(
+			const std::vector<std::shared_ptr<NeuralLayer>>& layers,
+			int32_t batch_size);
+
+	/** copies of the layers for each shard */
+	std::vector<std::vector<std::shared_ptr<NeuralLayer>>> m_shard_layers;
+
+	/** gradient memory shared by the layers */
+	std::vector<SGVector<float64_t>> m_gradient_buffers;
+
+	/** gradient memory shared by the layers of each shard */
+	std::vector<std::vector<SGVector<float64_t>>> m_shard_gradient_buffers;
+
 	/** temperary pointers to the training data, used to pass the data to L-BFGS
 	 * routines
 	 */
@@ -0,0 +1,201 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/neuralnets/NeuralNetworkPredictor.h>
+
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace shogun;
+using namespace Eigen;
+
+NeuralNetworkPredictor::NeuralNetworkPredictor(
+	std::vector<Layer> layers, bool quantize)
+	: m_layers(std::move(layers)), m_quantized(quantize), m_max_width(0),
+	  m_capacity(0)
+{
+	require(!m_layers.empty(), "A predictor needs at least one layer");
+
+	int32_t max_inputs = 0;
+	for (size_t i=0; i<m_layers.size(); i++)
+	{
+		const Layer& layer = m_layers[i];
+		require(layer.biases.vlen==layer.weights.num_rows,
+			"Number of biases ({}) of layer {} must match its number of "
+			"neurons ({})", layer.biases.vlen, i, layer.weights.num_rows);
+		if (i>0)
+		{
+			require(layer.weights.num_cols==m_layers[i-1].weights.num_rows,
+				"Number of inputs ({}) of layer {} must match the number of "
+				"neurons ({}) of layer {}", layer.weights.num_cols, i,
+				m_layers[i-1].weights.num_rows, i-1);
+		}
+
+		m_max_width = std::max(m_max_width, layer.weights.num_rows);
+		max_inputs = std::max(max_inputs, layer.weights.num_cols);
+	}
+
+	if (!m_quantized)
+		return;
+
+	m_quantized_inputs = SGVector<int8_t>(max_inputs);
+	for (const auto& layer : m_layers)
+	{
+		const int32_t num_outputs = layer.weights.num_rows;
+		const int32_t num_inputs = layer.weights.num_cols;
+
+		Map<MatrixXd> W(layer.weights.matrix, num_outputs, num_inputs);
+		SGVector<float64_t> scales(num_outputs);
+		SGMatrix<int8_t> quantized(num_inputs, num_outputs);
+		for (int32_t r=0; r<num_outputs; r++)
+		{
+			float64_t max_abs = W.row(r).cwiseAbs().maxCoeff();
+			scales[r] = max_abs>0 ? max_abs/127.0 : 1.0;
+
+			for (int32_t c=0; c<num_inputs; c++)
+				quantized(c, r) = std::lround(W(r, c)/scales[r]);
+		}
+
+		m_quantized_weights.push_back(quantized);
+		m_weight_scales.push_back(scales);
+	}
+}
+
+SGMatrix<float64_t> NeuralNetworkPredictor::predict(SGMatrix<float64_t> inputs)
+{
+	require(inputs.num_rows==get_num_inputs(),
+		"Number of inputs ({}) must match the predictor's number of inputs "
+		"({})", inputs.num_rows, get_num_inputs());
+
+	SGMatrix<float64_t> outputs(get_num_outputs(), inputs.num_cols);
+	if (inputs.num_cols>0)
+		forward(inputs.matrix, inputs.num_cols, outputs.matrix);
+	return outputs;
+}
+
+void NeuralNetworkPredictor::predict(const float64_t* input, float64_t* output)
+{
+	forward(input, 1, output);
+}
+
+int32_t NeuralNetworkPredictor::get_num_inputs() const
+{
+	return m_layers.front().weights.num_cols;
+}
+
+int32_t NeuralNetworkPredictor::get_num_outputs() const
+{
+	return m_layers.back().weights.num_rows;
+}
+
+void NeuralNetworkPredictor::forward(const float64_t* inputs,
+	int32_t batch_size, float64_t* output)
+{
+	if (batch_size>m_capacity)
+	{
+		m_capacity = batch_size;
+		if (m_layers.size()>1)
+		{
+			m_buffers[0] = SGVector<float64_t>(m_max_width*m_capacity);
+			m_buffers[1] = SGVector<float64_t>(m_max_width*m_capacity);
+		}
+	}
+
+	const float64_t* layer_inputs = inputs;
+	for (size_t i=0; i<m_layers.size(); i++)
+	{
+		const Layer& layer = m_layers[i];
+		const int32_t num_outputs = layer.weights.num_rows;
+		const int32_t num_inputs = layer.weights.num_cols;
+
+		float64_t* result =
+			i+1==m_layers.size() ? output : m_buffers[i%2].vector;
+
+		if (m_quantized)
+			quantized_product(i, layer_inputs, batch_size, result);
+		else
+		{
+			Map<const MatrixXd> X(layer_inputs, num_inputs, batch_size);
+			Map<const MatrixXd> W(layer.weights.matrix, num_outputs, num_inputs);
+			Map<const VectorXd> B(layer.biases.vector, num_outputs);
+			Map<MatrixXd> Y(result, num_outputs, batch_size);
+
+			Y.noalias() = W*X;
+			Y.colwise() += B;
+		}
+
+		activate(layer, result, batch_size);
+		layer_inputs = result;
+	}
+}
+
+void NeuralNetworkPredictor::quantized_product(int32_t i,
+	const float64_t* inputs, int32_t batch_size, float64_t* result)
+{
+	const Layer& layer = m_layers[i];
+	const int32_t num_outputs = layer.weights.num_rows;
+	const int32_t num_inputs = layer.weights.num_cols;
+	const SGMatrix<int8_t>& weights = m_quantized_weights[i];
+	const SGVector<float64_t>& scales = m_weight_scales[i];
+	int8_t* x = m_quantized_inputs.vector;
+
+	for (int32_t j=0; j<batch_size; j++)
+	{
+		const float64_t* case_inputs = inputs+j*num_inputs;
+
+		float64_t max_abs = 0;
+		for (int32_t k=0; k<num_inputs; k++)
+			max_abs = std::max(max_abs, std::abs(case_inputs[k]));
+		const float64_t input_scale = max_abs>0 ? max_abs/127.0 : 1.0;
+
+		for (int32_t k=0; k<num_inputs; k++)
+			x[k] = std::lround(case_inputs[k]/input_scale);
+
+		for (int32_t r=0; r<num_outputs; r++)
+		{
+			const int8_t* w = weights.matrix+r*num_inputs;
+
+			int32_t sum = 0;
+			for (int32_t k=0; k<num_inputs; k++)
+				sum += int32_t(w[k])*int32_t(x[k]);
+
+			result[r+j*num_outputs] =
+				input_scale*scales[r]*sum + layer.biases[r];
+		}
+	}
+}
+
+void NeuralNetworkPredictor::activate(const Layer& layer, float64_t* result,
+	int32_t batch_size)
+{
+	Map<ArrayXXd> Y(result, layer.weights.num_rows, batch_size);
+
+	switch (layer.activation)
+	{
+	case NNPA_LINEAR:
+		break;
+	case NNPA_LOGISTIC:
+		Y = 1.0/(1.0+(-Y).exp());
+		break;
+	case NNPA_RECTIFIED_LINEAR:
+		Y = Y.max(0.0);
+		break;
+	case NNPA_LEAKY_RECTIFIED_LINEAR:
+		Y = Y.max(layer.alpha*Y);
+		break;
+	case NNPA_SOFTMAX:
+		// to avoid exponentiating large numbers, the maximum activation of
+		// each case is subtracted from its activations
+		Y.rowwise() -= Y.colwise().maxCoeff().eval();
+		Y = Y.exp();
+		Y.rowwise() /= Y.colwise().sum().eval();
+		break;
+	}
+}
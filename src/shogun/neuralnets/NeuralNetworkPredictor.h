@@ -0,0 +1,137 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef __NEURALNETWORKPREDICTOR_H__
+#define __NEURALNETWORKPREDICTOR_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** activation functions of the layers of a NeuralNetworkPredictor */
+enum ENNPredictorActivation
+{
+	NNPA_LINEAR=0,
+	NNPA_LOGISTIC=1,
+	NNPA_RECTIFIED_LINEAR=2,
+	NNPA_LEAKY_RECTIFIED_LINEAR=3,
+	NNPA_SOFTMAX=4
+};
+
+/** @brief Frozen, inference only version of a sequential NeuralNetwork, as
+ * created by NeuralNetwork::compile_for_inference().
+ *
+ * Each layer is a single affine map followed by its activation function,
+ * which is applied in place. Dropout scaling of the inputs of a layer is
+ * folded into its weights. Activations are not stored per layer: the
+ * predictor alternates between two preallocated buffers, so predicting a
+ * batch that is not larger than the previous one does not allocate memory.
+ *
+ * Optionally, the weights are quantized after training to 8 bit integers
+ * with one scale per neuron, stored neuron by neuron so that each output is
+ * a contiguous integer dot product. The inputs of each layer are then
+ * quantized with one scale per case, and biases and activations stay in
+ * double precision.
+ *
+ * The predictor keeps its own buffers and must not be used from several
+ * threads at once.
+ */
+class NeuralNetworkPredictor
+{
+public:
+	/** a compiled layer */
+	struct Layer
+	{
+		/** activation function */
+		ENNPredictorActivation activation;
+
+		/** slope of the negative part for NNPA_LEAKY_RECTIFIED_LINEAR */
+		float64_t alpha;
+
+		/** weights, num_outputs*num_inputs */
+		SGMatrix<float64_t> weights;
+
+		/** biases, one per output */
+		SGVector<float64_t> biases;
+	};
+
+	/** constructor
+	 *
+	 * @param layers layers applied in order, each one takes the outputs of
+	 * the previous one
+	 * @param quantize whether the weights are quantized to 8 bit integers
+	 */
+	NeuralNetworkPredictor(std::vector<Layer> layers, bool quantize=false);
+
+	/** computes the outputs of the network
+	 *
+	 * @param inputs inputs, one case per column
+	 * @return outputs, one case per column
+	 */
+	SGMatrix<float64_t> predict(SGMatrix<float64_t> inputs);
+
+	/** computes the outputs of the network for a single case without
+	 * allocating memory
+	 *
+	 * @param input get_num_inputs() inputs
+	 * @param output array to be filled with get_num_outputs() outputs
+	 */
+	void predict(const float64_t* input, float64_t* output);
+
+	/** @return number of inputs */
+	int32_t get_num_inputs() const;
+
+	/** @return number of outputs */
+	int32_t get_num_outputs() const;
+
+	/** @return whether the weights are quantized */
+	bool is_quantized() const { return m_quantized; }
+
+private:
+	/** computes the outputs of a batch into output */
+	void forward(const float64_t* inputs, int32_t batch_size,
+		float64_t* output);
+
+	/** applies the affine map of layer i with quantized weights */
+	void quantized_product(int32_t i, const float64_t* inputs,
+		int32_t batch_size, float64_t* result);
+
+	/** applies the activation function of a layer in place */
+	static void activate(const Layer& layer, float64_t* result,
+		int32_t batch_size);
+
+	/** layers */
+	std::vector<Layer> m_layers;
+
+	/** whether the weights are quantized */
+	bool m_quantized;
+
+	/** quantized weights of each layer, num_inputs*num_outputs */
+	std::vector<SGMatrix<int8_t>> m_quantized_weights;
+
+	/** scale of the quantized weights of each neuron of each layer */
+	std::vector<SGVector<float64_t>> m_weight_scales;
+
+	/** quantized inputs of one case */
+	SGVector<int8_t> m_quantized_inputs;
+
+	/** largest number of neurons of a layer */
+	int32_t m_max_width;
+
+	/** number of cases the buffers can hold */
+	int32_t m_capacity;
+
+	/** ping-pong activation buffers */
+	SGVector<float64_t> m_buffers[2];
+};
+}
+#endif /* __NEURALNETWORKPREDICTOR_H__ */
@@ -0,0 +1,57 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/machine/Machine_benchmark.h>
+#include <shogun/neuralnets/NeuralInputLayer.h>
+#include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/neuralnets/NeuralRectifiedLinearLayer.h>
+#include <shogun/neuralnets/NeuralSoftmaxLayer.h>
+
+namespace shogun
+{
+
+std::shared_ptr<NeuralNetwork> make_network(const MachineFixture& fixture)
+{
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(
+		std::make_shared<NeuralInputLayer>(MachineFixture::kNumDims));
+	layers.push_back(std::make_shared<NeuralRectifiedLinearLayer>(64));
+	layers.push_back(std::make_shared<NeuralRectifiedLinearLayer>(64));
+	layers.push_back(
+		std::make_shared<NeuralSoftmaxLayer>(MachineFixture::kNumClasses));
+
+	auto network = std::make_shared<NeuralNetwork>(layers);
+	network->put("seed", 17);
+	network->set_max_num_epochs(10);
+	network->set_labels(fixture.multiclass_labels);
+	return network;
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, NeuralNetwork_Train)
+(benchmark::State& state)
+{
+	for (auto _ : state)
+		make_network(*this)->train(features_train);
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, NeuralNetwork_Apply)
+(benchmark::State& state)
+{
+	auto network = make_network(*this);
+	network->train(features_train);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(network->apply_multiclass(features_test));
+	set_counters(state);
+}
+
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, NeuralNetwork_Train), 1000, 10000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, NeuralNetwork_Apply), 1000, 100000,
+	8);
+
+} // namespace shogun
@@ -33,12 +33,14 @@
 
 #include <shogun/neuralnets/RBM.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/NormalDistribution.h>
 
+#include <algorithm>
 #include <utility>
 
 using namespace shogun;
@@ -267,9 +269,11 @@ std::shared_ptr<DenseFeatures< float64_t >> RBM::sample_group_with_evidence(int3
 
 void RBM::reset_chain()
 {
-	for (int32_t i=0; i<m_num_visible; i++)
-		for (int32_t j=0; j<m_batch_size; j++)
-			visible_state(i,j) = m_uniform_prob(m_prng) > 0.5;
+	random::fill_array(visible_state, 0.0, 1.0, m_prng);
+
+	Eigen::Map<Eigen::ArrayXXd> V(
+		visible_state.matrix, m_num_visible, m_batch_size);
+	V = (V > 0.5).cast<float64_t>();
 }
 
 float64_t RBM::free_energy(SGMatrix< float64_t > visible, SGMatrix< float64_t > buffer)
@@ -461,9 +465,7 @@ void RBM::mean_hidden(SGMatrix< float64_t > visible, SGMatrix< float64_t > resul
 	H.colwise() = C;
 	H += W*V;
 
-	int32_t len = result.num_rows*result.num_cols;
-	for (int32_t i=0; i<len; i++)
-		result[i] = 1.0 / (1.0 + std::exp(-1.0 * result[i]));
+	H.array() = 1.0/(1.0+(-H.array()).exp());
 }
 
 void RBM::mean_visible(SGMatrix< float64_t > hidden, SGMatrix< float64_t > result)
@@ -483,46 +485,25 @@ void RBM::mean_visible(SGMatrix< float64_t > hidden, SGMatrix< float64_t > resul
 	{
 		int32_t offset = m_visible_state_offsets[k];
 
+		auto group = V.middleRows(offset, m_visible_group_sizes[k]).array();
+
 		if (m_visible_group_types[k] == RBMVUT_BINARY)
-		{
-			for (int32_t i = 0; i < m_visible_group_sizes[k]; i++)
-				for (int32_t j=0; j<m_batch_size; j++)
-					result(i + offset, j) =
-					    1.0 / (1.0 + std::exp(-1.0 * result(i + offset, j)));
-		}
+			group = 1.0/(1.0+(-group).exp());
+
 		if (m_visible_group_types[k] == RBMVUT_SOFTMAX)
 		{
-			// to avoid exponentiating large numbers, the maximum activation is
-			// subtracted from all the activations and the computations are done
-			// in thelog domain
-
-			float64_t max = result(offset,0);
-			for (int32_t i = 0; i < m_visible_group_sizes[k]; i++)
-				for (int32_t j=0; j<m_batch_size; j++)
-					if (result(i+offset,j) > max)
-						max = result(i+offset,j);
-
-			for (int32_t j=0; j<m_batch_size; j++)
-			{
-				float64_t sum = 0;
-				for (int32_t i = 0; i < m_visible_group_sizes[k]; i++)
-					sum += std::exp(result(i + offset, j) - max);
-
-				float64_t normalizer = std::log(sum);
-
-				for (int32_t i = 0; i < m_visible_group_sizes[k]; i++)
-					result(i + offset, j) =
-					    std::exp(result(i + offset, j) - max - normalizer);
-			}
+			// to avoid exponentiating large numbers, the maximum activation of
+			// each case is subtracted from its activations
+			group.rowwise() -= group.colwise().maxCoeff().eval();
+			group = group.exp();
+			group.rowwise() /= group.colwise().sum().eval();
 		}
 	}
 }
 
 void RBM::sample_hidden(SGMatrix< float64_t > mean, SGMatrix< float64_t > result)
 {
-	int32_t length = result.num_rows*result.num_cols;
-	for (int32_t i=0; i<length; i++)
-		result[i] = m_uniform_prob(m_prng) < mean[i];
+	sample_bernoulli(mean, result, m_prng);
 }
 
 void RBM::sample_visible(SGMatrix< float64_t > mean, SGMatrix< float64_t > result)
@@ -539,33 +520,78 @@ void RBM::sample_visible(int32_t index,
 	int32_t offset = m_visible_state_offsets[index];
 
 	if (m_visible_group_types[index] == RBMVUT_BINARY)
-	{
-		for (int32_t i = 0; i < m_visible_group_sizes[index]; i++)
-			for (int32_t j=0; j<m_batch_size; j++)
-				result(i+offset,j) = m_uniform_prob(m_prng) < mean(i+offset,j);
-	}
+		sample_bernoulli(mean, result, m_prng, offset,
+			m_visible_group_sizes[index]);
 
 	if (m_visible_group_types[index] == RBMVUT_SOFTMAX)
 	{
-		for (int32_t i = 0; i < m_visible_group_sizes[index]; i++)
-			for (int32_t j=0; j<m_batch_size; j++)
-				result(i+offset,j) = 0;
+		SGVector<float64_t> r(m_batch_size);
+		random::fill_array(r, 0.0, 1.0, m_prng);
 
-		UniformIntDistribution<int32_t> uniform_int_dist(0, 1);
 		for (int32_t j=0; j<m_batch_size; j++)
 		{
-			int32_t r = uniform_int_dist(m_prng);
+			// the last unit takes the rounding errors of the probabilities
+			int32_t sampled = m_visible_group_sizes[index]-1;
 			float64_t sum = 0;
-			for (int32_t i = 0; i < m_visible_group_sizes[index]; i++)
+			for (int32_t i = 0; i < m_visible_group_sizes[index]-1; i++)
 			{
 				sum += mean(i+offset,j);
-				if (r<=sum)
+				if (r[j]<sum)
 				{
-					result(i+offset,j) = 1;
+					sampled = i;
 					break;
 				}
 			}
+
+			for (int32_t i = 0; i < m_visible_group_sizes[index]; i++)
+				result(i+offset,j) = i==sampled;
+		}
+	}
+}
+
+void RBM::sample_bernoulli(SGMatrix<float64_t> mean,
+	SGMatrix<float64_t> result, prng_type& prng, index_t first_row,
+	index_t num_rows)
+{
+	typedef Eigen::Map<Eigen::ArrayXXd, 0, Eigen::OuterStride<>> EArray;
+
+	if (num_rows<0)
+		num_rows = result.num_rows-first_row;
+
+	const index_t num_chains = result.num_cols;
+	const index_t length = num_rows*num_chains;
+	if (length==0)
+		return;
+
+	// each block holds at least 16384 states, the first one is sampled
+	// directly from prng
+	const index_t num_blocks =
+		std::max<index_t>(1, std::min<index_t>({64, num_chains, length/16384}));
+	SGVector<uint64_t> seeds(num_blocks);
+	for (index_t b=1; b<num_blocks; b++)
+		seeds[b] = prng();
+
+	#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		const index_t first = num_chains*b/num_blocks;
+		const index_t last = num_chains*(b+1)/num_blocks;
+
+		SGMatrix<float64_t> uniform(num_rows, last-first);
+		if (b==0)
+			random::fill_array(uniform, 0.0, 1.0, prng);
+		else
+		{
+			prng_type block_prng(seeds[b]);
+			random::fill_array(uniform, 0.0, 1.0, block_prng);
 		}
+
+		Eigen::Map<Eigen::ArrayXXd> U(uniform.matrix, num_rows, last-first);
+		EArray M(mean.matrix+first*mean.num_rows+first_row, num_rows,
+			last-first, Eigen::OuterStride<>(mean.num_rows));
+		EArray R(result.matrix+first*result.num_rows+first_row, num_rows,
+			last-first, Eigen::OuterStride<>(result.num_rows));
+		R = (U < M).cast<float64_t>();
 	}
 }
 
@@ -626,8 +652,6 @@ void RBM::init()
 	m_num_params = 0;
 	m_batch_size = 0;
 
-	m_uniform_prob.param({0.0, 1.0});
-
 	SG_ADD(&cd_num_steps, "cd_num_steps", "Number of CD Steps");
 	SG_ADD(&cd_persistent, "cd_persistent", "Whether to use PCD");
 	SG_ADD(
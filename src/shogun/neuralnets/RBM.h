@@ -42,7 +42,6 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/RandomMixin.h>
-#include <shogun/mathematics/UniformRealDistribution.h>
 
 namespace shogun
 {
@@ -344,6 +343,21 @@ public:
 	/** Returns the number of parameters */
 	virtual int32_t get_num_parameters() { return m_num_params; }
 
+	/** Samples binary states from their probabilities, in place if mean and
+	 * result are the same matrix. Uniform random numbers are generated in
+	 * bulk for blocks of columns (chains), which are sampled in parallel from
+	 * seeds drawn from prng. The blocks only depend on the matrix size.
+	 *
+	 * @param mean probabilities of the states being 1
+	 * @param result matrix to be filled with the states
+	 * @param prng random number generator
+	 * @param first_row first row to sample
+	 * @param num_rows number of rows to sample, -1 for all rows from first_row
+	 */
+	static void sample_bernoulli(SGMatrix<float64_t> mean,
+		SGMatrix<float64_t> result, prng_type& prng, index_t first_row=0,
+		index_t num_rows=-1);
+
 	const char* get_name() const override { return "RBM"; }
 
 protected:
@@ -460,9 +474,6 @@ protected:
 
 	/** Parameters */
 	SGVector<float64_t> m_params;
-
-private:
-	UniformRealDistribution<float64_t> m_uniform_prob;
 };
 
 }
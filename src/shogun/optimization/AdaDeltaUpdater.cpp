@@ -32,6 +32,7 @@
 #include <shogun/optimization/AdaDeltaUpdater.h>
 #include <shogun/optimization/MomentumCorrection.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
 
@@ -114,6 +115,34 @@ float64_t AdaDeltaUpdater::get_negative_descend_direction(float64_t variable,
 
 }
 
+void AdaDeltaUpdater::compute_negative_descend_directions(
+	SGVector<float64_t> variable_reference,
+	SGVector<float64_t> raw_negative_descend_direction,
+	float64_t learning_rate, SGVector<float64_t> directions)
+{
+	require(m_gradient_accuracy.vlen==variable_reference.vlen,
+		"The length of variable_reference ({}) and the length of the updater state ({}) do not match",
+		variable_reference.vlen, m_gradient_accuracy.vlen);
+
+	const float64_t* gradient=raw_negative_descend_direction.vector;
+	float64_t* accuracy=m_gradient_accuracy.vector;
+	float64_t* delta_accuracy=m_gradient_delta_accuracy.vector;
+	const float64_t decay_factor=m_decay_factor;
+	const float64_t build_in_learning_rate=m_build_in_learning_rate;
+	const float64_t epsilon=m_epsilon;
+
+	for_each_variable(variable_reference, directions, [=](index_t idx) {
+		float64_t scale=decay_factor*accuracy[idx]+
+			(1.0-decay_factor)*gradient[idx]*gradient[idx];
+		accuracy[idx]=scale;
+		float64_t res=build_in_learning_rate*gradient[idx]*
+			std::sqrt(delta_accuracy[idx]+epsilon)/std::sqrt(scale+epsilon);
+		delta_accuracy[idx]=decay_factor*delta_accuracy[idx]+
+			(1.0-decay_factor)*res*res;
+		return res;
+	});
+}
+
 void AdaDeltaUpdater::update_variable(SGVector<float64_t> variable_reference,
 	SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
 {
@@ -138,18 +167,31 @@ void AdaDeltaUpdater::update_variable(SGVector<float64_t> variable_reference,
 				momentum_correction->initialize_previous_direction(variable_reference.vlen);
 		}
 
-		for(index_t idx=0; idx<variable_reference.vlen; idx++)
+		if(m_directions.vlen!=variable_reference.vlen)
 		{
-			float64_t neg_des_dir=get_negative_descend_direction(
-				variable_reference[idx], raw_negative_descend_direction[idx], idx, learning_rate);
-
-			DescendPair pair=m_correction->get_corrected_descend_direction(
-				neg_des_dir, idx);
-			float64_t delta=pair.delta;
-			variable_reference[idx]+=pair.descend_direction;
-			m_gradient_delta_accuracy[idx]+=
-				(1.0-m_decay_factor)*(delta*delta-neg_des_dir*neg_des_dir);
+			m_directions=SGVector<float64_t>(variable_reference.vlen);
+			m_negative_directions=SGVector<float64_t>(variable_reference.vlen);
+			m_deltas=SGVector<float64_t>(variable_reference.vlen);
 		}
+
+		compute_negative_descend_directions(variable_reference,
+			raw_negative_descend_direction, learning_rate, m_directions);
+		sg_memcpy(m_negative_directions.vector, m_directions.vector,
+			sizeof(float64_t)*m_directions.vlen);
+		m_correction->correct_descend_directions(m_directions, m_deltas);
+
+		typedef Eigen::Map<Eigen::ArrayXd> EArray;
+		EArray variable(variable_reference.vector, variable_reference.vlen);
+		EArray descend_directions(m_directions.vector, m_directions.vlen);
+		EArray negative_directions(m_negative_directions.vector,
+			m_negative_directions.vlen);
+		EArray deltas(m_deltas.vector, m_deltas.vlen);
+		EArray delta_accuracy(m_gradient_delta_accuracy.vector,
+			m_gradient_delta_accuracy.vlen);
+
+		variable+=descend_directions;
+		delta_accuracy+=(1.0-m_decay_factor)*
+			(deltas.square()-negative_directions.square());
 	}
 	else
 	{
@@ -125,6 +125,14 @@ protected:
 	float64_t get_negative_descend_direction(float64_t variable,
 		float64_t gradient, index_t idx, float64_t learning_rate) override;
 
+	/** Updates both moving averages and computes the step of every variable
+	 * in one pass
+	 */
+	void compute_negative_descend_directions(
+		SGVector<float64_t> variable_reference,
+		SGVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate, SGVector<float64_t> directions) override;
+
 	/** learning_rate \f$ \alpha \f$ at iteration */
 	float64_t m_build_in_learning_rate;
 
@@ -139,6 +147,12 @@ protected:
 
 	/** \f$ s_\theta \f$ */
 	SGVector<float64_t> m_gradient_delta_accuracy;
+
+	/** negative descend directions before they are corrected */
+	SGVector<float64_t> m_negative_directions;
+
+	/** changes to correct the descend directions */
+	SGVector<float64_t> m_deltas;
 private:
 	/**  Init */
 	void init();
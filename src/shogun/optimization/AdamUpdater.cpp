@@ -133,6 +133,35 @@ float64_t AdamUpdater::get_negative_descend_direction(float64_t variable,
 	return res;
 }
 
+void AdamUpdater::compute_negative_descend_directions(
+	SGVector<float64_t> variable_reference,
+	SGVector<float64_t> raw_negative_descend_direction,
+	float64_t learning_rate, SGVector<float64_t> directions)
+{
+	require(m_gradient_first_moment.vlen==variable_reference.vlen,
+		"The length of variable_reference ({}) and the length of the updater state ({}) do not match",
+		variable_reference.vlen, m_gradient_first_moment.vlen);
+
+	const float64_t* gradient=raw_negative_descend_direction.vector;
+	float64_t* first_moment=m_gradient_first_moment.vector;
+	float64_t* second_moment=m_gradient_second_moment.vector;
+	const float64_t decay_first=m_decay_factor_first_moment;
+	const float64_t decay_second=m_decay_factor_second_moment;
+	const float64_t epsilon=m_epsilon;
+	const float64_t scale=std::exp(m_log_scale_pre_iteration);
+
+	for_each_variable(variable_reference, directions, [=](index_t idx) {
+		float64_t scale_first_moment=decay_first*first_moment[idx]+
+			(1.0-decay_first)*gradient[idx];
+		first_moment[idx]=scale_first_moment;
+		float64_t scale_second_moment=decay_second*second_moment[idx]+
+			(1.0-decay_second)*gradient[idx]*gradient[idx];
+		second_moment[idx]=scale_second_moment;
+		return scale*scale_first_moment/
+			(std::sqrt(scale_second_moment)+epsilon);
+	});
+}
+
 void AdamUpdater::update_variable(SGVector<float64_t> variable_reference,
 	SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
 {
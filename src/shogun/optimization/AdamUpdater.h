@@ -118,6 +118,14 @@ protected:
 	float64_t get_negative_descend_direction(float64_t variable,
 		float64_t gradient, index_t idx, float64_t learning_rate) override;
 
+	/** Updates both moment estimates and computes the bias corrected step of
+	 * every variable in one pass
+	 */
+	void compute_negative_descend_directions(
+		SGVector<float64_t> variable_reference,
+		SGVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate, SGVector<float64_t> directions) override;
+
 	/* learning_rate at iteration */
 	float64_t m_log_learning_rate;
 
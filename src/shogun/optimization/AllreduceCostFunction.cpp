@@ -0,0 +1,63 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/optimization/AllreduceCostFunction.h>
+
+using namespace shogun;
+
+AllreduceCostFunction::AllreduceCostFunction() : FirstOrderCostFunction()
+{
+	init();
+}
+
+AllreduceCostFunction::AllreduceCostFunction(
+	std::shared_ptr<FirstOrderCostFunction> fun,
+	std::shared_ptr<Communicator> communicator)
+	: FirstOrderCostFunction()
+{
+	init();
+
+	require(fun, "No cost function provided!");
+	require(communicator, "No communicator provided!");
+	m_fun=std::move(fun);
+	m_communicator=std::move(communicator);
+}
+
+AllreduceCostFunction::~AllreduceCostFunction()
+{
+}
+
+void AllreduceCostFunction::init()
+{
+	SG_ADD(&m_fun, "cost_function", "Cost function of the local shard.");
+	SG_ADD(&m_communicator, "communicator",
+		"Communicator of the processes.");
+}
+
+float64_t AllreduceCostFunction::get_cost()
+{
+	return m_communicator->allreduce_sum(m_fun->get_cost());
+}
+
+SGVector<float64_t> AllreduceCostFunction::obtain_variable_reference()
+{
+	auto variables=m_fun->obtain_variable_reference();
+	m_communicator->broadcast(variables);
+	return variables;
+}
+
+SGVector<float64_t> AllreduceCostFunction::get_gradient()
+{
+	auto gradient=m_fun->get_gradient();
+	m_communicator->allreduce_sum(gradient);
+	return gradient;
+}
+
+void AllreduceCostFunction::broadcast_variables()
+{
+	auto variables=m_fun->obtain_variable_reference();
+	m_communicator->broadcast(variables);
+}
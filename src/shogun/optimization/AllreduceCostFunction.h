@@ -0,0 +1,78 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef ALLREDUCECOSTFUNCTION_H
+#define ALLREDUCECOSTFUNCTION_H
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/Communicator.h>
+#include <shogun/optimization/FirstOrderCostFunction.h>
+
+namespace shogun
+{
+/** @brief Cost function that sums a cost function over data shards.
+ *
+ * Every process wraps the cost function of its local shard, i.e.
+ * \f$f(w)=\sum_s f_s(w)\f$ where \f$f_s\f$ is the cost of shard s. Costs
+ * and gradients are summed over all processes by the Communicator, so any
+ * deterministic FirstOrderMinimizer, e.g. LBFGSMinimizer, takes identical
+ * steps on all processes. The variables of rank 0 are broadcast when the
+ * minimizer obtains them, and broadcast_variables() can be called after
+ * the minimization to make sure all processes end with the same model.
+ *
+ * Terms that are not sums over the data, like a regularizer, must be
+ * added by one process only or divided by the number of processes.
+ */
+class AllreduceCostFunction : public FirstOrderCostFunction
+{
+public:
+	/** default constructor */
+	AllreduceCostFunction();
+
+	/** constructor
+	 *
+	 * @param fun cost function of the local shard
+	 * @param communicator communicator of the processes
+	 */
+	AllreduceCostFunction(
+		std::shared_ptr<FirstOrderCostFunction> fun,
+		std::shared_ptr<Communicator> communicator);
+
+	~AllreduceCostFunction() override;
+
+	/** @return cost summed over all processes */
+	float64_t get_cost() override;
+
+	/** @return variables of the local cost function, after replacing
+	 * them by the ones of rank 0
+	 */
+	SGVector<float64_t> obtain_variable_reference() override;
+
+	/** @return gradient summed over all processes */
+	SGVector<float64_t> get_gradient() override;
+
+	/** replace the variables of all processes by the ones of rank 0 */
+	void broadcast_variables();
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "AllreduceCostFunction";
+	}
+
+private:
+	void init();
+
+protected:
+	/** cost function of the local shard */
+	std::shared_ptr<FirstOrderCostFunction> m_fun;
+
+	/** communicator of the processes */
+	std::shared_ptr<Communicator> m_communicator;
+};
+}
+#endif
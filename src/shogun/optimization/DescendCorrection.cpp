@@ -39,6 +39,18 @@ void DescendCorrection::set_correction_weight(float64_t weight)
 	m_weight=weight;
 }
 
+void DescendCorrection::correct_descend_directions(
+	SGVector<float64_t> directions, SGVector<float64_t> deltas)
+{
+	for (index_t idx=0; idx<directions.vlen; idx++)
+	{
+		DescendPair pair=get_corrected_descend_direction(directions[idx], idx);
+		directions[idx]=pair.descend_direction;
+		if (deltas.vlen)
+			deltas[idx]=pair.delta;
+	}
+}
+
 void DescendCorrection::init()
 {
 	m_weight=0.0;
@@ -32,6 +32,7 @@
 #ifndef DESCENDCORRECTION_H
 #define DESCENDCORRECTION_H
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/SGVector.h>
 namespace shogun
 {
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -79,6 +80,18 @@ public:
 	virtual DescendPair get_corrected_descend_direction(float64_t negative_descend_direction,
 		index_t idx)=0;
 
+	/** Correct the negative descend directions of all variables in place
+	 *
+	 * The default calls get_corrected_descend_direction() for each variable.
+	 *
+	 * @param directions the negative descend directions, replaced by the
+	 * corrected descend directions
+	 * @param deltas vector to be filled with the changes to correct the
+	 * descend directions, or empty
+	 */
+	virtual void correct_descend_directions(SGVector<float64_t> directions,
+		SGVector<float64_t> deltas);
+
 protected:
 	/**  weight of correction */
 	float64_t m_weight;
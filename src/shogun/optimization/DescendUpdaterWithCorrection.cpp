@@ -31,6 +31,7 @@
 
 #include <shogun/optimization/DescendUpdaterWithCorrection.h>
 #include <shogun/optimization/MomentumCorrection.h>
+#include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
 
@@ -66,20 +67,43 @@ void DescendUpdaterWithCorrection::update_variable(SGVector<float64_t> variable_
 		}
 	}
 
+	if(m_correction)
+	{
+		if(m_directions.vlen!=variable_reference.vlen)
+			m_directions=SGVector<float64_t>(variable_reference.vlen);
+
+		compute_negative_descend_directions(variable_reference,
+			raw_negative_descend_direction, learning_rate, m_directions);
+		m_correction->correct_descend_directions(m_directions,
+			SGVector<float64_t>());
+
+		Eigen::Map<Eigen::VectorXd> variable(variable_reference.vector,
+			variable_reference.vlen);
+		Eigen::Map<Eigen::VectorXd> directions(m_directions.vector,
+			m_directions.vlen);
+		variable+=directions;
+	}
+	else
+	{
+		compute_negative_descend_directions(variable_reference,
+			raw_negative_descend_direction, learning_rate,
+			SGVector<float64_t>());
+	}
+}
+
+void DescendUpdaterWithCorrection::compute_negative_descend_directions(
+	SGVector<float64_t> variable_reference,
+	SGVector<float64_t> raw_negative_descend_direction,
+	float64_t learning_rate, SGVector<float64_t> directions)
+{
 	for(index_t idx=0; idx<variable_reference.vlen; idx++)
 	{
 		float64_t negative_descend_direction=get_negative_descend_direction(
 			variable_reference[idx], raw_negative_descend_direction[idx], idx, learning_rate);
-		if(m_correction)
-		{
-			DescendPair pair=m_correction->get_corrected_descend_direction(
-				negative_descend_direction, idx);
-			variable_reference[idx]+=pair.descend_direction;
-		}
+		if(directions.vlen)
+			directions[idx]=negative_descend_direction;
 		else
-		{
 			variable_reference[idx]-=negative_descend_direction;
-		}
 	}
 }
 
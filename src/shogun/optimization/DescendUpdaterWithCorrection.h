@@ -32,6 +32,7 @@
 #ifndef DESCENDUPDATERWITHCORRECTION_H
 #define DESCENDUPDATERWITHCORRECTION_H
 #include <shogun/lib/config.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/optimization/DescendUpdater.h>
 #include <shogun/optimization/DescendCorrection.h>
 namespace shogun
@@ -95,9 +96,62 @@ protected:
 	virtual float64_t get_negative_descend_direction(float64_t variable,
 		float64_t raw_negative_descend_direction, index_t idx, float64_t learning_rate)=0;
 
+	/** Get the negative descend directions of all variables in one pass
+	 *
+	 * If directions is empty, the negative descend directions are subtracted
+	 * from the variables in place instead of being stored.
+	 * The default calls get_negative_descend_direction() for each variable,
+	 * subclasses override it with fused kernels, see for_each_variable().
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the raw negative descend direction
+	 * @param learning_rate learning rate
+	 * @param directions vector to be filled with the negative descend
+	 * directions, or empty
+	 */
+	virtual void compute_negative_descend_directions(
+		SGVector<float64_t> variable_reference,
+		SGVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate, SGVector<float64_t> directions);
+
+	/** Applies a kernel, which returns the negative descend direction of the
+	 * variable with the given index, to all variables. Long vectors are
+	 * processed in parallel.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param directions vector to be filled with the negative descend
+	 * directions, or empty to subtract them from the variables
+	 * @param kernel function of the index
+	 */
+	template <class Kernel>
+	static void for_each_variable(SGVector<float64_t> variable_reference,
+		SGVector<float64_t> directions, Kernel kernel)
+	{
+		float64_t* variable=variable_reference.vector;
+		float64_t* result=directions.vector;
+		const index_t len=variable_reference.vlen;
+		const bool parallel=len>=65536;
+
+		if (result)
+		{
+			#pragma omp parallel for if(parallel) num_threads(env()->get_num_threads())
+			for (index_t idx=0; idx<len; idx++)
+				result[idx]=kernel(idx);
+		}
+		else
+		{
+			#pragma omp parallel for if(parallel) num_threads(env()->get_num_threads())
+			for (index_t idx=0; idx<len; idx++)
+				variable[idx]-=kernel(idx);
+		}
+	}
+
 	/** descend correction object */
 	std::shared_ptr<DescendCorrection> m_correction;
 
+	/** negative descend directions before they are corrected */
+	SGVector<float64_t> m_directions;
+
 private:
 	/**  Init */
 	void init();
@@ -69,6 +69,12 @@ public:
 	 * */
 	virtual void set_l1_ratio(float64_t ratio);
 
+	/** get l1_ratio
+	 *
+	 * @return ratio of the L1 penalty
+	 * */
+	virtual float64_t get_l1_ratio() const { return m_l1_ratio; }
+
 	/** Given the value of a target variable,
 	 * this method returns the penalty of the variable 
 	 *
@@ -0,0 +1,74 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef FIRSTORDERSPARSESAGCOSTFUNCTION_H
+#define FIRSTORDERSPARSESAGCOSTFUNCTION_H
+#include <shogun/lib/config.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/optimization/FirstOrderSAGCostFunction.h>
+namespace shogun
+{
+/** @brief Stochastic average cost function of a linear model on sparse
+ * samples.
+ *
+ * The sample cost must depend on the variables through \f$w^T x_i\f$ only,
+ * i.e. \f$f_i(w)=\phi_i(w^T x_i)\f$, so the sample gradient
+ * \f$\phi_i'(w^T x_i) x_i\f$ has the sparsity of \f$x_i\f$. A bias can be
+ * modelled as a feature of constant value.
+ *
+ * Minimizers like SVRGMinimizer and SAGAMinimizer use this to update only
+ * the non-zero coordinates of each sample and to apply the steps of the
+ * other coordinates lazily, see LazyUpdate.
+ */
+class FirstOrderSparseSAGCostFunction
+	: public FirstOrderSAGCostFunction
+{
+public:
+	~FirstOrderSparseSAGCostFunction() override {};
+
+	/** Get the index of the current sample
+	 *
+	 * @return index in [0, get_sample_size()) of the sample obtained by
+	 * next_sample()
+	 */
+	virtual index_t get_sample_index()=0;
+
+	/** Get the features of the current sample
+	 *
+	 * @return sparse features \f$x_i\f$ of the sample obtained by
+	 * next_sample()
+	 */
+	virtual SGSparseVector<float64_t> get_sample_features()=0;
+
+	/** Get the derivative of the current sample cost
+	 *
+	 * @param prediction value of \f$w^T x_i\f$
+	 * @return \f$\phi_i'(w^T x_i)\f$
+	 */
+	virtual float64_t get_sample_derivative(float64_t prediction)=0;
+
+	/** Get the SAMPLE gradient value wrt target variables
+	 *
+	 * @return \f$\phi_i'(w^T x_i) x_i\f$ as a dense vector
+	 */
+	SGVector<float64_t> get_gradient() override
+	{
+		SGVector<float64_t> variable=obtain_variable_reference();
+		SGSparseVector<float64_t> x=get_sample_features();
+		const float64_t derivative=get_sample_derivative(
+			x.dense_dot(1.0, variable.vector, variable.vlen, 0.0));
+
+		SGVector<float64_t> gradient(variable.vlen);
+		gradient.zero();
+		for (index_t k=0; k<x.num_feat_entries; k++)
+			gradient[x.features[k].feat_index]+=derivative*x.features[k].entry;
+		return gradient;
+	}
+};
+
+}
+
+#endif
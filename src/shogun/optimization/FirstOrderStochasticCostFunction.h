@@ -79,6 +79,40 @@ public:
 	 */
 	SGVector<float64_t> get_gradient() override =0;
 
+	/** Get the index of the current sample
+	 *
+	 * Only needed by minimizers running in minibatch mode
+	 * (eg, FirstOrderStochasticMinimizer::set_minibatch_size() ),
+	 * which collect the indices of a minibatch and compute their gradients
+	 * with get_sample_gradient().
+	 *
+	 * @return index of the sample obtained by next_sample()
+	 */
+	virtual index_t get_sample_index()
+	{
+		not_implemented(SOURCE_LOCATION);
+		return -1;
+	}
+
+	/** Get the SAMPLE gradient of a given sample at given target variables
+	 *
+	 * Unlike get_gradient(), the sample and the target variables are passed
+	 * explicitly and the method must not change the state of the cost
+	 * function, so that the gradients of a minibatch can be computed
+	 * concurrently while the target variables are being updated.
+	 *
+	 * @param idx index of the sample, as returned by get_sample_index()
+	 * @param variable target variables \f$w\f$ at which the gradient is
+	 * computed
+	 * @return sample gradient \f$ \frac{\partial f_{idx}(w) }{\partial w} \f$
+	 */
+	virtual SGVector<float64_t> get_sample_gradient(
+		index_t idx, SGVector<float64_t> variable)
+	{
+		not_implemented(SOURCE_LOCATION);
+		return SGVector<float64_t>();
+	}
+
 	/** Get the cost given current target variables 
 	 *
 	 * For least squares, that is the value of \f$f(w)\f$.
@@ -32,8 +32,14 @@
 #include <shogun/optimization/FirstOrderStochasticMinimizer.h>
 #include <shogun/optimization/SparsePenalty.h>
 #include <shogun/optimization/ProximalPenalty.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
 
 using namespace shogun;
+using namespace Eigen;
 
 void FirstOrderStochasticMinimizer::set_gradient_updater(std::shared_ptr<DescendUpdater> gradient_updater)
 {
@@ -68,6 +74,96 @@ void FirstOrderStochasticMinimizer::set_learning_rate(std::shared_ptr<LearningRa
 	}
 }
 
+void FirstOrderStochasticMinimizer::set_minibatch_size(int32_t minibatch_size)
+{
+	require(minibatch_size>0, "The minibatch size ({}) must be positive", minibatch_size);
+	m_minibatch_size=minibatch_size;
+}
+
+void FirstOrderStochasticMinimizer::set_asynchronous(bool asynchronous)
+{
+	m_asynchronous=asynchronous;
+}
+
+bool FirstOrderStochasticMinimizer::next_gradient(
+	std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+	SGVector<float64_t> variable_reference, SGVector<float64_t>& gradient)
+{
+	if(m_minibatch_size<=1)
+	{
+		if(!fun->next_sample())
+			return false;
+		gradient=fun->get_gradient();
+		return true;
+	}
+
+	if(m_next_gradient.valid())
+		gradient=m_next_gradient.get();
+	else
+	{
+		SGVector<index_t> indices=next_minibatch(fun);
+		if(indices.vlen==0)
+			return false;
+		gradient=compute_minibatch_gradient(fun, indices, variable_reference);
+	}
+
+	if(m_asynchronous)
+	{
+		// the gradient of the next minibatch is computed at the current
+		// variables while the caller applies this update
+		SGVector<index_t> indices=next_minibatch(fun);
+		if(indices.vlen>0)
+		{
+			m_next_gradient=std::async(std::launch::async,
+				compute_minibatch_gradient, fun, indices,
+				variable_reference.clone());
+		}
+	}
+	return true;
+}
+
+SGVector<index_t> FirstOrderStochasticMinimizer::next_minibatch(
+	std::shared_ptr<FirstOrderStochasticCostFunction> fun)
+{
+	SGVector<index_t> indices(m_minibatch_size);
+	index_t num_samples=0;
+	while(num_samples<m_minibatch_size && fun->next_sample())
+		indices[num_samples++]=fun->get_sample_index();
+	indices.resize_vector(num_samples);
+	return indices;
+}
+
+SGVector<float64_t> FirstOrderStochasticMinimizer::compute_minibatch_gradient(
+	std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+	SGVector<index_t> indices, SGVector<float64_t> variable)
+{
+	const index_t num_samples=indices.vlen;
+	const index_t num_workers=std::min<index_t>(env()->get_num_threads(), num_samples);
+
+	// each worker sums the gradients of a contiguous shard of the minibatch,
+	// the shards are reduced in a fixed order afterwards
+	SGMatrix<float64_t> partial_sums(variable.vlen, num_workers);
+	#pragma omp parallel for num_threads(num_workers)
+	for(index_t worker=0; worker<num_workers; worker++)
+	{
+		Map<VectorXd> sum(partial_sums.get_column_vector(worker), variable.vlen);
+		sum.setZero();
+		const index_t begin=worker*num_samples/num_workers;
+		const index_t end=(worker+1)*num_samples/num_workers;
+		for(index_t i=begin; i<end; i++)
+		{
+			SGVector<float64_t> grad=fun->get_sample_gradient(indices[i], variable);
+			sum+=Map<VectorXd>(grad.vector, grad.vlen);
+		}
+	}
+
+	SGVector<float64_t> gradient(variable.vlen);
+	Map<VectorXd> mean(gradient.vector, gradient.vlen);
+	Map<MatrixXd> sums(partial_sums.matrix, variable.vlen, num_workers);
+	mean=sums.rowwise().sum()/num_samples;
+	return gradient;
+}
+
 void FirstOrderStochasticMinimizer::do_proximal_operation(SGVector<float64_t>variable_reference)
 {
 	auto proximal_penalty=std::dynamic_pointer_cast<ProximalPenalty>(m_penalty_type);
@@ -90,6 +186,10 @@ void FirstOrderStochasticMinimizer::init_minimization()
 	require(m_gradient_updater,"Descend updater must set");
 	require(m_num_passes>0, "The number to go through data must set");
 	m_cur_passes=0;
+	// drop a pending minibatch of an interrupted minimization
+	if(m_next_gradient.valid())
+		m_next_gradient.wait();
+	m_next_gradient=std::future<SGVector<float64_t>>();
 }
 
 void FirstOrderStochasticMinimizer::init()
@@ -99,6 +199,8 @@ void FirstOrderStochasticMinimizer::init()
 	m_num_passes=0;
 	m_cur_passes=0;
 	m_iter_counter=0;
+	m_minibatch_size=1;
+	m_asynchronous=false;
 
 	SG_ADD((std::shared_ptr<SGObject>*)&m_learning_rate, "FirstOrderMinimizer__m_learning_rate",
 		"learning_rate in FirstOrderStochasticMinimizer");
@@ -110,4 +212,8 @@ void FirstOrderStochasticMinimizer::init()
 		"cur_passes in FirstOrderStochasticMinimizer");
 	SG_ADD(&m_iter_counter, "FirstOrderMinimizer__m_iter_counter",
 		"m_iter_counter in FirstOrderStochasticMinimizer");
+	SG_ADD(&m_minibatch_size, "FirstOrderMinimizer__m_minibatch_size",
+		"minibatch_size in FirstOrderStochasticMinimizer");
+	SG_ADD(&m_asynchronous, "FirstOrderMinimizer__m_asynchronous",
+		"asynchronous in FirstOrderStochasticMinimizer");
 }
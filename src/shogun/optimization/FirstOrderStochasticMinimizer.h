@@ -34,6 +34,8 @@
 #include <shogun/optimization/FirstOrderStochasticCostFunction.h>
 #include <shogun/optimization/DescendUpdater.h>
 #include <shogun/optimization/LearningRate.h>
+
+#include <future>
 namespace shogun
 {
 
@@ -135,6 +137,37 @@ public:
 	 */
 	virtual int32_t get_iteration_counter() {return m_iter_counter;}
 
+	/** Set the number of samples per update
+	 *
+	 * With a minibatch size larger than one, the minimizer collects that
+	 * many samples from the cost function, computes their gradients
+	 * concurrently on env()->get_num_threads() workers and uses the mean
+	 * gradient for one step of the gradient updater. The cost function has
+	 * to implement FirstOrderStochasticCostFunction::get_sample_index() and
+	 * FirstOrderStochasticCostFunction::get_sample_gradient().
+	 *
+	 * @param minibatch_size number of samples per update (default 1)
+	 */
+	virtual void set_minibatch_size(int32_t minibatch_size);
+
+	/** @return number of samples per update */
+	virtual int32_t get_minibatch_size() const {return m_minibatch_size;}
+
+	/** Enable asynchronous minibatch updates
+	 *
+	 * In asynchronous mode the gradient of the next minibatch is computed
+	 * while the current one is applied, at the target variables before that
+	 * update. Gradients are therefore one update stale, in exchange for
+	 * overlapping gradient computation and updates. Only used when the
+	 * minibatch size is larger than one.
+	 *
+	 * @param asynchronous whether minibatch gradients may be one update stale
+	 */
+	virtual void set_asynchronous(bool asynchronous);
+
+	/** @return whether minibatch gradients may be one update stale */
+	virtual bool get_asynchronous() const {return m_asynchronous;}
+
 protected:
 	/** Do proximal update in place 
 	 *
@@ -146,6 +179,21 @@ protected:
 	/** init the minimization process*/
 	virtual void init_minimization();
 
+	/** Get the gradient for the next update
+	 *
+	 * This is the sample gradient of the next sample, or the mean sample
+	 * gradient of the next minibatch if the minibatch size is larger than
+	 * one.
+	 *
+	 * @param fun stochastic cost function
+	 * @param variable_reference current target variables
+	 * @param gradient the gradient for the next update
+	 * @return false if reach the end of the sample sequence
+	 */
+	virtual bool next_gradient(
+		std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+		SGVector<float64_t> variable_reference, SGVector<float64_t>& gradient);
+
 	/** the gradient update step */
 	std::shared_ptr<DescendUpdater> m_gradient_updater;
 
@@ -160,10 +208,39 @@ protected:
 
 	/** learning_rate object */
 	std::shared_ptr<LearningRate> m_learning_rate;
-	
+
+	/** number of samples per update */
+	int32_t m_minibatch_size;
+
+	/** whether minibatch gradients may be one update stale */
+	bool m_asynchronous;
+
 private:
 	/** Init */
 	void init();
+
+	/** Collect the indices of the next minibatch
+	 *
+	 * @param fun stochastic cost function
+	 * @return indices of the samples, empty if reach the end of the sample
+	 * sequence
+	 */
+	SGVector<index_t> next_minibatch(
+		std::shared_ptr<FirstOrderStochasticCostFunction> fun);
+
+	/** Compute the mean sample gradient of a minibatch
+	 *
+	 * @param fun stochastic cost function
+	 * @param indices indices of the samples
+	 * @param variable target variables at which the gradients are computed
+	 * @return mean sample gradient
+	 */
+	static SGVector<float64_t> compute_minibatch_gradient(
+		std::shared_ptr<FirstOrderStochasticCostFunction> fun,
+		SGVector<index_t> indices, SGVector<float64_t> variable);
+
+	/** gradient of the next minibatch in asynchronous mode */
+	std::future<SGVector<float64_t>> m_next_gradient;
 };
 
 }
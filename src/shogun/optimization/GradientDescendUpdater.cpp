@@ -52,3 +52,14 @@ float64_t GradientDescendUpdater::get_negative_descend_direction(float64_t varia
 {
 	return learning_rate*gradient;
 }
+
+void GradientDescendUpdater::compute_negative_descend_directions(
+	SGVector<float64_t> variable_reference,
+	SGVector<float64_t> raw_negative_descend_direction,
+	float64_t learning_rate, SGVector<float64_t> directions)
+{
+	const float64_t* gradient=raw_negative_descend_direction.vector;
+	for_each_variable(variable_reference, directions, [=](index_t idx) {
+		return learning_rate*gradient[idx];
+	});
+}
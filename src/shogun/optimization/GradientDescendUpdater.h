@@ -74,6 +74,12 @@ protected:
 	float64_t get_negative_descend_direction(float64_t variable,
 		float64_t gradient, index_t idx, float64_t learning_rate) override;
 
+	/** Scales the gradients of all variables by the learning rate in one pass */
+	void compute_negative_descend_directions(
+		SGVector<float64_t> variable_reference,
+		SGVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate, SGVector<float64_t> directions) override;
+
 private:
 	/*  Init */
 	void init();
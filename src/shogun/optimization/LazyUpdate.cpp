@@ -0,0 +1,141 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/mathematics/Math.h>
+#include <shogun/optimization/ConstLearningRate.h>
+#include <shogun/optimization/ElasticNetPenalty.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/L1Penalty.h>
+#include <shogun/optimization/L2Penalty.h>
+#include <shogun/optimization/LazyUpdate.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+std::shared_ptr<LazyUpdate> LazyUpdate::create(
+	const std::shared_ptr<DescendUpdater>& updater,
+	const std::shared_ptr<LearningRate>& learning_rate,
+	const std::shared_ptr<Penalty>& penalty, float64_t penalty_weight,
+	index_t dim)
+{
+	auto descend=std::dynamic_pointer_cast<GradientDescendUpdater>(updater);
+	if (!descend || descend->enables_descend_correction())
+		return NULL;
+
+	float64_t eta=1.0;
+	if (learning_rate)
+	{
+		if (!std::dynamic_pointer_cast<ConstLearningRate>(learning_rate))
+			return NULL;
+		eta=learning_rate->get_learning_rate(0);
+	}
+
+	float64_t l1_ratio=0;
+	if (penalty)
+	{
+		if (auto elastic_net=std::dynamic_pointer_cast<ElasticNetPenalty>(penalty))
+			l1_ratio=elastic_net->get_l1_ratio();
+		else if (std::dynamic_pointer_cast<L1Penalty>(penalty))
+			l1_ratio=1;
+		else if (!std::dynamic_pointer_cast<L2Penalty>(penalty))
+			return NULL;
+	}
+	else
+		penalty_weight=0;
+
+	const float64_t l2_weight=penalty_weight*(1-l1_ratio);
+	// the iterates are monotone only if the L2 part does not flip signs
+	if (eta*l2_weight>=1)
+		return NULL;
+
+	return std::make_shared<LazyUpdate>(
+		eta, l2_weight, penalty_weight*l1_ratio, dim);
+}
+
+LazyUpdate::LazyUpdate(
+	float64_t learning_rate, float64_t l2_weight, float64_t l1_weight,
+	index_t dim)
+{
+	m_learning_rate=learning_rate;
+	m_decay=1-learning_rate*l2_weight;
+	m_threshold=learning_rate*l1_weight;
+	m_last_step=SGVector<int64_t>(dim);
+	reset();
+}
+
+void LazyUpdate::reset()
+{
+	m_step=0;
+	m_last_step.zero();
+}
+
+void LazyUpdate::catch_up_all(
+	SGVector<float64_t>& variable, const SGVector<float64_t>& average_gradient)
+{
+	for (index_t j=0; j<variable.vlen; j++)
+		catch_up(variable, average_gradient, j);
+}
+
+void LazyUpdate::step(
+	SGVector<float64_t>& variable, const SGVector<float64_t>& average_gradient,
+	const SGSparseVector<float64_t>& x, float64_t scale)
+{
+	for (index_t k=0; k<x.num_feat_entries; k++)
+	{
+		const index_t j=x.features[k].feat_index;
+		const float64_t v=m_decay*variable[j]-
+			m_learning_rate*(scale*x.features[k].entry+average_gradient[j]);
+		variable[j]=Math::sign(v)*Math::max(Math::abs(v)-m_threshold, 0.0);
+		m_last_step[j]=m_step+1;
+	}
+}
+
+float64_t LazyUpdate::apply(float64_t w, float64_t mu, int64_t k) const
+{
+	const float64_t c=m_learning_rate*mu;
+	while (k>0)
+	{
+		// w <- a*w-shift while the result keeps its sign
+		const float64_t v=m_decay*w-c;
+		const bool positive=v>m_threshold;
+		if (!positive && v>=-m_threshold)
+		{
+			w=0;
+			k--;
+			// zero is a fixed point
+			if (Math::abs(c)<=m_threshold)
+				break;
+			continue;
+		}
+
+		const float64_t shift=positive ? c+m_threshold : c-m_threshold;
+		auto affine=[&](int64_t m) {
+			if (m_decay==1)
+				return w-m*shift;
+			const float64_t decay=std::pow(m_decay, m);
+			return decay*w-shift*(1-decay)/(1-m_decay);
+		};
+		if (m_threshold==0)
+			return affine(k);
+
+		// the iterates are monotone, search the last step in the regime
+		int64_t low=1, high=k;
+		while (low<high)
+		{
+			const int64_t mid=low+(high-low+1)/2;
+			const float64_t u=m_decay*affine(mid-1)-c;
+			if (positive ? u>m_threshold : u<-m_threshold)
+				low=mid;
+			else
+				high=mid-1;
+		}
+		w=affine(low);
+		k-=low;
+	}
+
+	return w;
+}
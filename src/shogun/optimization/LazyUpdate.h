@@ -0,0 +1,143 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef LAZYUPDATE_H
+#define LAZYUPDATE_H
+#include <shogun/lib/config.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/optimization/DescendUpdater.h>
+#include <shogun/optimization/LearningRate.h>
+#include <shogun/optimization/Penalty.h>
+namespace shogun
+{
+/** @brief Just-in-time updates of variance reduced minimizers on sparse
+ * samples.
+ *
+ * A step of SVRG or SAGA with gradient descent, a constant learning rate
+ * \f$\eta\f$ and penalty weight \f$\lambda\f$ updates every coordinate by
+ * \f[
+ * w_j\leftarrow S_{\eta\lambda r}((1-\eta\lambda(1-r))w_j-\eta(g_j+\mu_j))
+ * \f]
+ * where \f$g\f$ is the sparse part of the gradient, \f$\mu\f$ the average
+ * gradient, \f$S\f$ soft thresholding and r the ratio of the L1 penalty (0
+ * for L2Penalty, 1 for L1Penalty, the l1_ratio for ElasticNetPenalty).
+ *
+ * Coordinates with \f$g_j=0\f$ follow the same map as long as \f$\mu_j\f$
+ * does not change. The class stores the step up to which each coordinate
+ * is updated and applies the missed steps of a coordinate only when it is
+ * touched. The map is affine as long as the sign of the result does not
+ * change and the iterates are monotone, so k steps are applied in
+ * O(log k) for any penalty.
+ */
+class LazyUpdate
+{
+public:
+	/** create the updates for a minimizer
+	 *
+	 * @param updater gradient updater of the minimizer
+	 * @param learning_rate learning rate of the minimizer, may be NULL
+	 * @param penalty penalty of the minimizer, may be NULL
+	 * @param penalty_weight weight of the penalty
+	 * @param dim number of variables
+	 * @return lazy updates, NULL if the steps of the minimizer cannot be
+	 * applied lazily, e.g. for momentum or adaptive learning rates
+	 */
+	static std::shared_ptr<LazyUpdate> create(
+		const std::shared_ptr<DescendUpdater>& updater,
+		const std::shared_ptr<LearningRate>& learning_rate,
+		const std::shared_ptr<Penalty>& penalty, float64_t penalty_weight,
+		index_t dim);
+
+	/** constructor
+	 *
+	 * @param learning_rate constant learning rate \f$\eta\f$
+	 * @param l2_weight \f$\lambda(1-r)\f$
+	 * @param l1_weight \f$\lambda r\f$
+	 * @param dim number of variables
+	 */
+	LazyUpdate(
+		float64_t learning_rate, float64_t l2_weight, float64_t l1_weight,
+		index_t dim);
+
+	/** start counting the steps at zero, all coordinates are up to date */
+	void reset();
+
+	/** apply the missed steps of a coordinate
+	 *
+	 * @param variable variables
+	 * @param average_gradient \f$\mu\f$ of the missed steps
+	 * @param j coordinate
+	 */
+	void catch_up(
+		SGVector<float64_t>& variable,
+		const SGVector<float64_t>& average_gradient, index_t j)
+	{
+		const int64_t missed=m_step-m_last_step[j];
+		if (missed>0)
+		{
+			variable[j]=apply(variable[j], average_gradient[j], missed);
+			m_last_step[j]=m_step;
+		}
+	}
+
+	/** apply the missed steps of the non-zero coordinates of a sample */
+	void catch_up(
+		SGVector<float64_t>& variable,
+		const SGVector<float64_t>& average_gradient,
+		const SGSparseVector<float64_t>& x)
+	{
+		for (index_t k=0; k<x.num_feat_entries; k++)
+			catch_up(variable, average_gradient, x.features[k].feat_index);
+	}
+
+	/** apply the missed steps of all coordinates */
+	void catch_up_all(
+		SGVector<float64_t>& variable,
+		const SGVector<float64_t>& average_gradient);
+
+	/** do the current step on the non-zero coordinates of a sample, the
+	 * coordinates have to be up to date
+	 *
+	 * @param variable variables
+	 * @param average_gradient \f$\mu\f$ of the step
+	 * @param x sparse sample
+	 * @param scale the sparse gradient is scale*x
+	 */
+	void step(
+		SGVector<float64_t>& variable,
+		const SGVector<float64_t>& average_gradient,
+		const SGSparseVector<float64_t>& x, float64_t scale);
+
+	/** finish the current step, the other coordinates miss it */
+	void next_step()
+	{
+		m_step++;
+	}
+
+private:
+	/** apply k steps to a coordinate with average gradient mu */
+	float64_t apply(float64_t w, float64_t mu, int64_t k) const;
+
+	/** constant learning rate */
+	float64_t m_learning_rate;
+
+	/** factor of the L2 part, \f$1-\eta\lambda(1-r)\f$ */
+	float64_t m_decay;
+
+	/** threshold of the L1 part, \f$\eta\lambda r\f$ */
+	float64_t m_threshold;
+
+	/** number of steps so far */
+	int64_t m_step;
+
+	/** step up to which each coordinate is updated */
+	SGVector<int64_t> m_last_step;
+};
+
+}
+
+#endif
@@ -30,6 +30,7 @@
  */
 
 #include <shogun/optimization/NesterovMomentumCorrection.h>
+#include <shogun/base/ShogunEnv.h>
 
 using namespace shogun;
 
@@ -45,6 +46,30 @@ DescendPair NesterovMomentumCorrection::get_corrected_descend_direction(float64_
 	return pair;
 }
 
+void NesterovMomentumCorrection::correct_descend_directions(
+	SGVector<float64_t> directions, SGVector<float64_t> deltas)
+{
+	require(directions.vlen==m_previous_descend_direction.vlen,
+		"The length of directions ({}) and the length of previous directions ({}) do not match",
+		directions.vlen, m_previous_descend_direction.vlen);
+
+	float64_t* previous=m_previous_descend_direction.vector;
+	float64_t* direction=directions.vector;
+	float64_t* delta=deltas.vector;
+	const float64_t weight=m_weight;
+	const index_t len=directions.vlen;
+
+	#pragma omp parallel for if(len>=65536) num_threads(env()->get_num_threads())
+	for (index_t idx=0; idx<len; idx++)
+	{
+		float64_t tmp=weight*previous[idx];
+		previous[idx]=tmp-direction[idx];
+		direction[idx]=(1.0+weight)*previous[idx]-tmp;
+		if (delta)
+			delta[idx]=previous[idx];
+	}
+}
+
 void NesterovMomentumCorrection::init()
 {
 	m_weight=0.9;
@@ -0,0 +1,99 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/optimization/ParallelCostFunction.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace shogun;
+
+#define PARALLEL_COST_MAX_BLOCKS 64
+
+ParallelCostFunction::ParallelCostFunction() : FirstOrderCostFunction()
+{
+	init();
+}
+
+ParallelCostFunction::~ParallelCostFunction()
+{
+}
+
+void ParallelCostFunction::init()
+{
+	m_block_size=1024;
+	m_cost=0;
+
+	SG_ADD(&m_block_size, "block_size", "Minimum number of samples per block.",
+		ParameterProperties::SETTING);
+}
+
+void ParallelCostFunction::set_block_size(index_t block_size)
+{
+	require(block_size>0, "Block size ({}) must be positive!", block_size);
+	m_block_size=block_size;
+}
+
+float64_t ParallelCostFunction::get_cost()
+{
+	evaluate();
+	return m_cost;
+}
+
+SGVector<float64_t> ParallelCostFunction::get_gradient()
+{
+	auto variables=obtain_variable_reference();
+	if (m_evaluated_variables.vlen!=variables.vlen ||
+		!std::equal(variables.vector, variables.vector+variables.vlen,
+			m_evaluated_variables.vector))
+		evaluate();
+
+	return m_gradient.clone();
+}
+
+void ParallelCostFunction::evaluate()
+{
+	auto variables=obtain_variable_reference();
+	const index_t dim=variables.vlen;
+	const index_t num_samples=get_num_samples();
+	const index_t num_blocks=std::min<index_t>(PARALLEL_COST_MAX_BLOCKS,
+		(num_samples+m_block_size-1)/m_block_size);
+
+	std::vector<SGVector<float64_t>> gradients(std::max<index_t>(num_blocks, 1));
+	for (auto& gradient : gradients)
+	{
+		gradient=SGVector<float64_t>(dim);
+		gradient.zero();
+	}
+	std::vector<float64_t> costs(gradients.size(), 0.0);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		const index_t begin=(int64_t)num_samples*b/num_blocks;
+		const index_t end=(int64_t)num_samples*(b+1)/num_blocks;
+		costs[b]=get_block_cost(begin, end, gradients[b]);
+	}
+
+	// pairwise sums in a fixed order, independent of the number of threads
+	for (index_t stride=1; stride<num_blocks; stride*=2)
+	{
+		#pragma omp parallel for num_threads(env()->get_num_threads())
+		for (index_t b=0; b<num_blocks-stride; b+=2*stride)
+		{
+			float64_t* target=gradients[b].vector;
+			const float64_t* source=gradients[b+stride].vector;
+			for (index_t j=0; j<dim; j++)
+				target[j]+=source[j];
+			costs[b]+=costs[b+stride];
+		}
+	}
+
+	m_gradient=gradients[0];
+	m_cost=costs[0]+get_regularization(m_gradient);
+	m_evaluated_variables=variables.clone();
+}
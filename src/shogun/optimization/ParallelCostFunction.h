@@ -0,0 +1,116 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef PARALLELCOSTFUNCTION_H
+#define PARALLELCOSTFUNCTION_H
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGVector.h>
+#include <shogun/optimization/FirstOrderCostFunction.h>
+
+namespace shogun
+{
+/** @brief Cost function that is a sum over samples, evaluated in parallel.
+ *
+ * The cost has the form
+ * \f[
+ * f(w)=r(w)+\sum_i \ell_i(w)
+ * \f]
+ * The samples are split into contiguous blocks. Every block computes its
+ * cost and gradient on its own, see get_block_cost(), using all threads of
+ * env()->get_num_threads(). The results of the blocks are then added up
+ * in a tree. The sample-independent term \f$r\f$ is added by
+ * get_regularization().
+ *
+ * The blocks depend only on the number of samples and the block size,
+ * not on the number of threads. So the results are the same for any
+ * number of threads. There are at most 64 blocks, which bounds the
+ * memory for the partial gradients.
+ *
+ * get_cost() computes the cost and the gradient in one pass. If the
+ * variables have not changed since then, get_gradient() returns the
+ * cached gradient. This fits LBFGSMinimizer, which asks for both at
+ * every point.
+ */
+class ParallelCostFunction : public FirstOrderCostFunction
+{
+public:
+	/** default constructor */
+	ParallelCostFunction();
+
+	~ParallelCostFunction() override;
+
+	/** @return cost at the current variables */
+	float64_t get_cost() override;
+
+	/** @return gradient at the current variables */
+	SGVector<float64_t> get_gradient() override;
+
+	/** @param block_size minimum number of samples per block */
+	void set_block_size(index_t block_size);
+
+	/** @return minimum number of samples per block */
+	index_t get_block_size() const
+	{
+		return m_block_size;
+	}
+
+	/** @return name of the SGSerializable */
+	const char* get_name() const override
+	{
+		return "ParallelCostFunction";
+	}
+
+protected:
+	/** @return number of samples the cost sums over */
+	virtual index_t get_num_samples()=0;
+
+	/** cost of the samples [begin, end)
+	 *
+	 * Blocks are evaluated concurrently, so this must not modify any state
+	 * that other blocks use.
+	 *
+	 * @param begin first sample of the block
+	 * @param end one past the last sample of the block
+	 * @param gradient zero vector to add the gradient of the block to
+	 * @return cost of the block
+	 */
+	virtual float64_t get_block_cost(
+		index_t begin, index_t end, SGVector<float64_t> gradient)=0;
+
+	/** cost of the terms not summed over samples, e.g. a regularizer
+	 *
+	 * @param gradient vector to add the gradient of these terms to
+	 * @return cost of these terms, 0 by default
+	 */
+	virtual float64_t get_regularization(SGVector<float64_t> gradient)
+	{
+		return 0;
+	}
+
+private:
+	void init();
+
+	/** compute m_cost and m_gradient at the current variables */
+	void evaluate();
+
+protected:
+	/** minimum number of samples per block */
+	index_t m_block_size;
+
+private:
+	/** cost at m_evaluated_variables */
+	float64_t m_cost;
+
+	/** gradient at m_evaluated_variables */
+	SGVector<float64_t> m_gradient;
+
+	/** variables of the last evaluation */
+	SGVector<float64_t> m_evaluated_variables;
+};
+}
+#endif
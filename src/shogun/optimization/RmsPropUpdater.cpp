@@ -103,6 +103,29 @@ float64_t RmsPropUpdater::get_negative_descend_direction(float64_t variable,
 	return res;
 }
 
+void RmsPropUpdater::compute_negative_descend_directions(
+	SGVector<float64_t> variable_reference,
+	SGVector<float64_t> raw_negative_descend_direction,
+	float64_t learning_rate, SGVector<float64_t> directions)
+{
+	require(m_gradient_accuracy.vlen==variable_reference.vlen,
+		"The length of variable_reference ({}) and the length of the updater state ({}) do not match",
+		variable_reference.vlen, m_gradient_accuracy.vlen);
+
+	const float64_t* gradient=raw_negative_descend_direction.vector;
+	float64_t* accuracy=m_gradient_accuracy.vector;
+	const float64_t decay_factor=m_decay_factor;
+	const float64_t build_in_learning_rate=m_build_in_learning_rate;
+	const float64_t epsilon=m_epsilon;
+
+	for_each_variable(variable_reference, directions, [=](index_t idx) {
+		float64_t scale=decay_factor*accuracy[idx]+
+			(1.0-decay_factor)*gradient[idx]*gradient[idx];
+		accuracy[idx]=scale;
+		return build_in_learning_rate*gradient[idx]/std::sqrt(scale+epsilon);
+	});
+}
+
 void RmsPropUpdater::update_variable(SGVector<float64_t> variable_reference,
 	SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
 {
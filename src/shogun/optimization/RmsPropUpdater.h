@@ -121,6 +121,14 @@ protected:
 	float64_t get_negative_descend_direction(float64_t variable,
 		float64_t gradient, index_t idx, float64_t learning_rate) override;
 
+	/** Updates the moving average of the squared gradients and computes the
+	 * scaled step of every variable in one pass
+	 */
+	void compute_negative_descend_directions(
+		SGVector<float64_t> variable_reference,
+		SGVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate, SGVector<float64_t> directions) override;
+
 	/** learning_rate \f$\alpha\f$ at iteration */
 	float64_t m_build_in_learning_rate;
 
@@ -0,0 +1,105 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/optimization/SAGAMinimizer.h>
+using namespace shogun;
+
+SAGAMinimizer::SAGAMinimizer()
+	:FirstOrderStochasticMinimizer()
+{
+	init();
+}
+
+SAGAMinimizer::~SAGAMinimizer()
+{
+}
+
+SAGAMinimizer::SAGAMinimizer(const std::shared_ptr<FirstOrderSparseSAGCostFunction>& fun)
+	:FirstOrderStochasticMinimizer(fun)
+{
+	init();
+}
+
+void SAGAMinimizer::init()
+{
+	SG_ADD(&m_sample_derivatives, "SAGAMinimizer__m_sample_derivatives",
+		"sample_derivatives in SAGAMinimizer");
+	SG_ADD(&m_average_gradient, "SAGAMinimizer__m_average_gradient",
+		"average_gradient in SAGAMinimizer");
+}
+
+void SAGAMinimizer::init_minimization()
+{
+	FirstOrderStochasticMinimizer::init_minimization();
+	auto fun=std::dynamic_pointer_cast<FirstOrderSparseSAGCostFunction>(m_fun);
+	require(fun,"the cost function must be a sparse stochastic average gradient cost function");
+
+	m_sample_derivatives=SGVector<float64_t>(fun->get_sample_size());
+	m_sample_derivatives.zero();
+	m_average_gradient=SGVector<float64_t>(fun->obtain_variable_reference().vlen);
+	m_average_gradient.zero();
+}
+
+float64_t SAGAMinimizer::minimize()
+{
+	init_minimization();
+
+	auto fun=std::dynamic_pointer_cast<FirstOrderSparseSAGCostFunction>(m_fun);
+	SGVector<float64_t> variable_reference=fun->obtain_variable_reference();
+	const index_t dim=variable_reference.vlen;
+	const float64_t num_samples=m_sample_derivatives.vlen;
+
+	auto lazy=LazyUpdate::create(m_gradient_updater, m_learning_rate,
+		m_penalty_type, m_penalty_weight, dim);
+	for(;m_cur_passes<m_num_passes;m_cur_passes++)
+	{
+		fun->begin_sample();
+		while(fun->next_sample())
+		{
+			m_iter_counter++;
+			const index_t idx=fun->get_sample_index();
+			SGSparseVector<float64_t> x=fun->get_sample_features();
+			if (lazy)
+				lazy->catch_up(variable_reference, m_average_gradient, x);
+
+			const float64_t derivative=fun->get_sample_derivative(
+				x.dense_dot(1.0, variable_reference.vector, dim, 0.0));
+			const float64_t scale=derivative-m_sample_derivatives[idx];
+
+			if (lazy)
+			{
+				lazy->step(variable_reference, m_average_gradient, x, scale);
+				lazy->next_step();
+			}
+			else
+			{
+				float64_t learning_rate=1.0;
+				if(m_learning_rate)
+					learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+
+				SGVector<float64_t> grad=m_average_gradient.clone();
+				for (index_t k=0; k<x.num_feat_entries; k++)
+					grad[x.features[k].feat_index]+=scale*x.features[k].entry;
+
+				update_gradient(grad,variable_reference);
+				m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
+				do_proximal_operation(variable_reference);
+			}
+
+			// the average changes on the non-zero coordinates of the sample only
+			for (index_t k=0; k<x.num_feat_entries; k++)
+			{
+				m_average_gradient[x.features[k].feat_index]+=
+					scale*x.features[k].entry/num_samples;
+			}
+			m_sample_derivatives[idx]=derivative;
+		}
+		if (lazy)
+			lazy->catch_up_all(variable_reference, m_average_gradient);
+	}
+	float64_t cost=m_fun->get_cost();
+	return cost+get_penalty(variable_reference);
+}
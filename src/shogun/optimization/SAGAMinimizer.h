@@ -0,0 +1,76 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SAGAMINIMIZER_H
+#define SAGAMINIMIZER_H
+#include <shogun/optimization/FirstOrderStochasticMinimizer.h>
+#include <shogun/optimization/FirstOrderSparseSAGCostFunction.h>
+#include <shogun/optimization/LazyUpdate.h>
+namespace shogun
+{
+
+/** @brief The class implements the SAGA minimizer for linear models on
+ * sparse samples.
+ *
+ * SAGA stores the derivative \f$\phi_i'\f$ of the last visit of every
+ * sample, for a linear model a single scalar per sample, and steps along
+ * \f$(\phi_i'(w^T x_i)-\alpha_i)x_i+\mu\f$, where \f$\alpha_i\f$ is the
+ * stored derivative and \f$\mu\f$ the average of the stored gradients. The
+ * table starts at zero.
+ *
+ * With plain gradient descent and a constant learning rate the steps are
+ * sparse and the other coordinates are updated just in time, see
+ * LazyUpdate, so a step costs O(nnz) of the sample. L1Penalty and
+ * ElasticNetPenalty are applied as proximal steps in both cases.
+ *
+ * Reference:
+ * Defazio, Aaron, Francis Bach, and Simon Lacoste-Julien.
+ * "SAGA: A fast incremental gradient method with support for non-strongly
+ * convex composite objectives."
+ * Advances in Neural Information Processing Systems. 2014.
+ */
+class SAGAMinimizer: public FirstOrderStochasticMinimizer
+{
+public:
+	/** Default constructor */
+	SAGAMinimizer();
+
+	/** Constructor
+	 * @param fun sparse stochastic average cost function
+	 */
+	SAGAMinimizer(const std::shared_ptr<FirstOrderSparseSAGCostFunction>& fun);
+
+	/** Destructor */
+	~SAGAMinimizer() override;
+
+	/** Do minimization and get the optimal value
+	 *
+	 * @return optimal value
+	 */
+	float64_t minimize() override;
+
+	/** returns the name of the class
+	 *
+	 * @return name SAGAMinimizer
+	 */
+	const char* get_name() const override { return "SAGAMinimizer"; }
+
+protected:
+	/**  init the minimization process */
+	void init_minimization() override;
+
+	/**  stored derivative of every sample */
+	SGVector<float64_t> m_sample_derivatives;
+
+	/**  average of the stored sample gradients */
+	SGVector<float64_t> m_average_gradient;
+private:
+	/** Init */
+	void init();
+};
+
+}
+#endif /* SAGAMINIMIZER_H */
@@ -61,14 +61,14 @@ float64_t SMDMinimizer::minimize()
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
 		fun->begin_sample();
-		while(fun->next_sample())
+		SGVector<float64_t> grad;
+		while(next_gradient(fun, variable_reference, grad))
 		{
 			m_iter_counter++;
 			float64_t learning_rate=1.0;
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
 
-			SGVector<float64_t> grad=m_fun->get_gradient();
 			update_gradient(grad,variable_reference);
 			m_gradient_updater->update_variable(dual_variable,grad,learning_rate);
 			m_mapping_fun->update_variable(variable_reference,dual_variable);
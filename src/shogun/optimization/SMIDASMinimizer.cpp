@@ -75,12 +75,12 @@ float64_t SMIDASMinimizer::minimize()
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
 		fun->begin_sample();
-		while(fun->next_sample())
+		SGVector<float64_t> grad;
+		while(next_gradient(fun, variable_reference, grad))
 		{
 			m_iter_counter++;
 			float64_t learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
 
-			SGVector<float64_t> grad=m_fun->get_gradient();
 			m_gradient_updater->update_variable(m_dual_variable,grad, learning_rate);
 			penalty_type->update_variable_for_proximity(m_dual_variable, m_penalty_weight*learning_rate);
 			m_mapping_fun->update_variable(variable_reference, m_dual_variable);
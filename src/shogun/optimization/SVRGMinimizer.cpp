@@ -93,6 +93,19 @@ float64_t SVRGMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	auto fun=m_fun->as<FirstOrderSAGCostFunction>();
 	require(fun,"the cost function must be a stochastic average gradient cost function");
+
+	auto sparse_fun=std::dynamic_pointer_cast<FirstOrderSparseSAGCostFunction>(m_fun);
+	if (sparse_fun)
+	{
+		auto lazy=LazyUpdate::create(m_gradient_updater, m_learning_rate,
+			m_penalty_type, m_penalty_weight, variable_reference.vlen);
+		if (lazy)
+		{
+			minimize_lazily(sparse_fun, lazy);
+			return m_fun->get_cost()+get_penalty(variable_reference);
+		}
+	}
+
 	for(;m_cur_passes<(m_num_passes-m_num_sgd_passes);m_cur_passes++)
 	{
 		if(m_cur_passes%m_svrg_interval==0)
@@ -131,3 +144,39 @@ float64_t SVRGMinimizer::minimize()
 	float64_t cost=m_fun->get_cost();
 	return cost+get_penalty(variable_reference);
 }
+
+void SVRGMinimizer::minimize_lazily(
+	const std::shared_ptr<FirstOrderSparseSAGCostFunction>& fun,
+	const std::shared_ptr<LazyUpdate>& lazy)
+{
+	SGVector<float64_t> variable_reference=fun->obtain_variable_reference();
+	const index_t dim=variable_reference.vlen;
+	for(;m_cur_passes<(m_num_passes-m_num_sgd_passes);m_cur_passes++)
+	{
+		if(m_cur_passes%m_svrg_interval==0)
+		{
+			if(m_previous_variable.vlen==0)
+				m_previous_variable=SGVector<float64_t>(dim);
+
+			std::copy(variable_reference.vector, variable_reference.vector+dim, m_previous_variable.vector);
+			m_average_gradient=fun->get_average_gradient();
+		}
+		fun->begin_sample();
+		while(fun->next_sample())
+		{
+			m_iter_counter++;
+			SGSparseVector<float64_t> x=fun->get_sample_features();
+			lazy->catch_up(variable_reference, m_average_gradient, x);
+
+			const float64_t derivative_new=fun->get_sample_derivative(
+				x.dense_dot(1.0, variable_reference.vector, dim, 0.0));
+			const float64_t derivative_old=fun->get_sample_derivative(
+				x.dense_dot(1.0, m_previous_variable.vector, dim, 0.0));
+			lazy->step(variable_reference, m_average_gradient, x,
+				derivative_new-derivative_old);
+			lazy->next_step();
+		}
+		// the average gradient may change with the next pass
+		lazy->catch_up_all(variable_reference, m_average_gradient);
+	}
+}
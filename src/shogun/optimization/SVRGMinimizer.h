@@ -33,6 +33,8 @@
 #define SVRGMINIMIZER_H
 #include <shogun/optimization/FirstOrderStochasticMinimizer.h>
 #include <shogun/optimization/FirstOrderSAGCostFunction.h>
+#include <shogun/optimization/FirstOrderSparseSAGCostFunction.h>
+#include <shogun/optimization/LazyUpdate.h>
 namespace shogun
 {
 
@@ -42,6 +44,12 @@ namespace shogun
  * Johnson, Rie, and Tong Zhang.
  * "Accelerating stochastic gradient descent using predictive variance reduction."
  * Advances in Neural Information Processing Systems. 2013.
+ *
+ * If the cost function is a FirstOrderSparseSAGCostFunction and the
+ * minimizer uses plain gradient descent with a constant learning rate, a
+ * step costs O(nnz) of the sample instead of O(d): only the non-zero
+ * coordinates of a sample are updated and the steps of the other
+ * coordinates are applied just in time, see LazyUpdate.
  */
 
 class SVRGMinimizer: public FirstOrderStochasticMinimizer
@@ -116,6 +124,11 @@ protected:
 	/**  init the minimization process */
 	void init_minimization() override;
 
+	/** SVRG passes with sparse steps and lazy updates */
+	void minimize_lazily(
+		const std::shared_ptr<FirstOrderSparseSAGCostFunction>& fun,
+		const std::shared_ptr<LazyUpdate>& lazy);
+
 	/** the number to go through data  using SGD before SVRG update */
 	int32_t m_num_sgd_passes;
 
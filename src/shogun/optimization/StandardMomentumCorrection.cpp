@@ -30,6 +30,7 @@
  */
 
 #include <shogun/optimization/StandardMomentumCorrection.h>
+#include <shogun/base/ShogunEnv.h>
 using namespace shogun;
 
 DescendPair StandardMomentumCorrection::get_corrected_descend_direction(float64_t negative_descend_direction,
@@ -44,6 +45,29 @@ DescendPair StandardMomentumCorrection::get_corrected_descend_direction(float64_
 	return pair;
 }
 
+void StandardMomentumCorrection::correct_descend_directions(
+	SGVector<float64_t> directions, SGVector<float64_t> deltas)
+{
+	require(directions.vlen==m_previous_descend_direction.vlen,
+		"The length of directions ({}) and the length of previous directions ({}) do not match",
+		directions.vlen, m_previous_descend_direction.vlen);
+
+	float64_t* previous=m_previous_descend_direction.vector;
+	float64_t* direction=directions.vector;
+	float64_t* delta=deltas.vector;
+	const float64_t weight=m_weight;
+	const index_t len=directions.vlen;
+
+	#pragma omp parallel for if(len>=65536) num_threads(env()->get_num_threads())
+	for (index_t idx=0; idx<len; idx++)
+	{
+		previous[idx]=weight*previous[idx]-direction[idx];
+		direction[idx]=previous[idx];
+		if (delta)
+			delta[idx]=previous[idx];
+	}
+}
+
 void StandardMomentumCorrection::init()
 {
 	m_weight=0.9;
@@ -85,6 +85,17 @@ public:
 	*/
 	DescendPair get_corrected_descend_direction(float64_t negative_descend_direction,
 		index_t idx) override;
+
+	/** Correct the negative descend directions of all variables in place in
+	 * one pass, in parallel for long vectors
+	 *
+	 * @param directions the negative descend directions, replaced by the
+	 * corrected descend directions
+	 * @param deltas vector to be filled with the changes to correct the
+	 * descend directions, or empty
+	 */
+	void correct_descend_directions(SGVector<float64_t> directions,
+		SGVector<float64_t> deltas) override;
 private:
 	/*  Init */
 	void init();
@@ -11,6 +11,8 @@
 #include <shogun/mathematics/lapack.h>
 #include <shogun/optimization/liblinear/tron.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 double tron_ddot(const int N, const double *X, const int incX, const double *Y, const int incY)
@@ -89,14 +91,25 @@ void Tron::tron(float64_t *w, float64_t max_train_time)
 	double *w_new = SG_MALLOC(double, n);
 	double *g = SG_MALLOC(double, n);
 
-	for (i=0; i<n; i++)
-		w[i] = 0;
+	// the stopping criterion is relative to the gradient at w=0, so that a
+	// warm start does not make it stricter
+	const bool warm_start =
+		std::any_of(w, w+n, [](float64_t w_i) { return w_i != 0; });
+	float64_t gnorm1 = 0;
+	if (warm_start)
+	{
+		std::fill_n(w_new, n, 0.0);
+		fun_obj->fun(w_new);
+		fun_obj->grad(w_new, g);
+		gnorm1 = tron_dnrm2(n, g, inc);
+	}
 
 	f = fun_obj->fun(w);
 	fun_obj->grad(w, g);
 	delta = tron_dnrm2(n, g, inc);
-	float64_t gnorm1 = delta;
-	float64_t gnorm = gnorm1;
+	if (!warm_start)
+		gnorm1 = delta;
+	float64_t gnorm = delta;
 
 	if (gnorm <= eps*gnorm1)
 		search = 0;
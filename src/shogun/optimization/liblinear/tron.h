@@ -68,7 +68,7 @@ public:
 
 	/** tron
 	 *
-	 * @param w w
+	 * @param w initial solution, overwritten by the solution
 	 * @param max_train_time maximum training time
 	 */
 	void tron(float64_t *w, float64_t max_train_time);
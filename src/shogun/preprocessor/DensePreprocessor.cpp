@@ -131,6 +131,14 @@ void DensePreprocessor<ST>::fit(std::shared_ptr<Features> f)
 	m_fitted.store(true);
 }
 
+template <class ST>
+int32_t DensePreprocessor<ST>::apply_in_place(ST* vector, int32_t len)
+{
+	not_implemented(SOURCE_LOCATION);;
+
+	return len;
+}
+
 template <class ST>
 SGMatrix<ST>
 DensePreprocessor<ST>::inverse_apply_to_matrix(SGMatrix<ST> matrix)
@@ -54,6 +54,26 @@ template <class ST> class DensePreprocessor : public Preprocessor
 		/// result in feature matrix
 		virtual SGVector<ST> apply_to_feature_vector(SGVector<ST> vector) = 0;
 
+		/** @return whether apply_in_place() is implemented, i.e. every
+		 * vector is mapped on its own to at most as many elements */
+		virtual bool supports_in_place() const
+		{
+			return false;
+		}
+
+		/** apply preproc on single feature vector in place, without
+		 * allocating, see supports_in_place()
+		 *
+		 * DenseFeatures applies a chain of such preprocessors on access in
+		 * one buffer, see DenseFeatures::get_feature_vector(). May be called
+		 * from several threads at once.
+		 *
+		 * @param vector feature vector, overwritten by the result
+		 * @param len length of vector
+		 * @return length of the result
+		 */
+		virtual int32_t apply_in_place(ST* vector, int32_t len);
+
 		/// return that we are dense features (just fixed size matrices)
 		EFeatureClass get_feature_class() override;
 		/// return feature type
@@ -10,6 +10,9 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/preprocessor/HomogeneousKernelMap.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace shogun;
 
 HomogeneousKernelMap::HomogeneousKernelMap()
@@ -152,13 +155,15 @@ HomogeneousKernelMap::apply_to_matrix(SGMatrix<float64_t> matrix)
 {
 	auto num_vectors = matrix.num_cols;
 	auto num_features = matrix.num_rows;
+	auto out_dim = num_features*(2*m_order+1);
 
-	SGMatrix<float64_t> feature_matrix(num_features*(2*m_order+1),num_vectors);
-	for (auto i : range(num_vectors))
+	SGMatrix<float64_t> feature_matrix(out_dim, num_vectors);
+	#pragma omp parallel for
+	for (index_t i = 0; i < num_vectors; ++i)
 	{
-		SGVector<float64_t> transformed = apply_to_vector(matrix.get_column(i));
-		for (auto j : range(transformed.vlen))
-			feature_matrix(j,i) = transformed[j];
+		apply_to_vector(
+			matrix.get_column_vector(i), num_features,
+			feature_matrix.get_column_vector(i));
 	}
 
 	return feature_matrix;
@@ -290,14 +295,21 @@ SGVector<float64_t> HomogeneousKernelMap::apply_to_vector(const SGVector<float64
 	ASSERT (in_v.vlen > 0)
 	ASSERT (in_v.vector != NULL)
 
+	SGVector<float64_t> out_v((2*m_order+1)*in_v.vlen);
+	apply_to_vector(in_v.vector, in_v.vlen, out_v.vector);
+	return out_v;
+}
+
+void HomogeneousKernelMap::apply_to_vector(
+	const float64_t* in_v, index_t len, float64_t* out_v) const
+{
 	uint64_t featureDimension = 2*m_order+1;
 
-	SGVector<float64_t> out_v(featureDimension*in_v.vlen);
+	for (index_t k = 0; k < len; ++k) {
+		float64_t* out = out_v + k*featureDimension;
 
-	for (int k = 0; k < in_v.vlen; ++k) {
 		/* break value into exponent and mantissa */
 		int exponent;
-		int unsigned j;
 		float64_t mantissa = std::frexp (in_v[k], &exponent);
 		float64_t sign = (mantissa >= 0.0) ? +1.0 : -1.0;
 		mantissa *= 2*sign;
@@ -307,33 +319,26 @@ SGVector<float64_t> HomogeneousKernelMap::apply_to_vector(const SGVector<float64
 				exponent <= m_minExponent ||
 				exponent >= m_maxExponent)
 		{
-			for (j = 0 ; j <= m_order ; ++j) {
-				out_v[k*featureDimension+j] = 0.0;
-			}
+			std::fill_n(out, featureDimension, 0.0);
 			continue;
 		}
 
-		//uint64_t featureDimension = 2*m_order+1;
-		float64_t const * v1 = m_table.vector +
-			(exponent - m_minExponent) * m_numSubdivisions * featureDimension;
-		float64_t const * v2;
-		float64_t f1, f2;
-
+		/* the mantissa is in [1, 2), look up the subdivision it falls in
+		 * directly and interpolate between its two table rows */
 		mantissa -= 1.0;
-		while (mantissa >= m_subdivision) {
-			mantissa -= m_subdivision;
-			v1 += featureDimension;
-		}
+		uint64_t subdivision = std::min<uint64_t>(
+			m_numSubdivisions - 1, mantissa * m_numSubdivisions);
+		mantissa -= subdivision * m_subdivision;
 
-		v2 = v1 + featureDimension;
-		for (j = 0 ; j < featureDimension ; ++j) {
-			f1 = *v1++;
-			f2 = *v2++;
+		float64_t const * v1 = m_table.vector +
+			((exponent - m_minExponent) * m_numSubdivisions + subdivision) *
+			featureDimension;
+		float64_t const * v2 = v1 + featureDimension;
+		float64_t const weight = m_numSubdivisions * mantissa;
 
-			out_v[k*featureDimension+j] = sign * ((f2 - f1) * (m_numSubdivisions * mantissa) + f1);
-		}
+		for (uint64_t j = 0 ; j < featureDimension ; ++j)
+			out[j] = sign * ((v2[j] - v1[j]) * weight + v1[j]);
 	}
-	return out_v;
 }
 
 void HomogeneousKernelMap::register_params()
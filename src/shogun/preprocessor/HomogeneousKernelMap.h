@@ -46,7 +46,10 @@ namespace shogun
 	 *
 	 * The implementation is unsafe to work with negative feature values.
 	 *
-	 * Implementation is based on the vlfeat library.
+	 * Implementation is based on the vlfeat library. Every value is mapped
+	 * by a direct lookup of its exponent and mantissa subdivision in a
+	 * precomputed table and a linear interpolation between two table rows.
+	 * The vectors of a feature matrix are mapped in parallel.
 	 *
 	 */
 	class HomogeneousKernelMap : public DensePreprocessor<float64_t>
@@ -137,6 +140,7 @@ namespace shogun
 			inline float64_t sinc (float64_t x) const;
 			inline float64_t get_spectrum (float64_t omega) const;
 			SGVector<float64_t> apply_to_vector(const SGVector<float64_t>& in_v) const;
+			void apply_to_vector(const float64_t* in_v, index_t len, float64_t* out_v) const;
 
 		private:
 			HomogeneousKernelType m_kernel;
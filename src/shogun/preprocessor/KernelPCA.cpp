@@ -9,6 +9,7 @@
 #include <shogun/lib/config.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
 #include <limits>
 #include <stdlib.h>
 #include <string.h>
@@ -22,12 +23,12 @@
 
 using namespace shogun;
 
-KernelPCA::KernelPCA() : Preprocessor()
+KernelPCA::KernelPCA() : RandomMixin<Preprocessor>()
 {
 	init();
 }
 
-KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : Preprocessor()
+KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : RandomMixin<Preprocessor>()
 {
 	init();
 	set_kernel(std::move(k));
@@ -40,6 +41,10 @@ void KernelPCA::init()
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
 	m_kernel = NULL;
+	m_method = KPCA_EXACT;
+	m_num_landmarks = 1000;
+	m_landmark_selection = LANDMARKS_UNIFORM;
+	m_low_rank_kernel = NULL;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data");
@@ -49,6 +54,24 @@ void KernelPCA::init()
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_method, "method",
+	    "method to compute the principal components",
+	    ParameterProperties::NONE, SG_OPTIONS(KPCA_EXACT, KPCA_NYSTROM));
+	SG_ADD(
+	    &m_num_landmarks, "num_landmarks",
+	    "number of landmarks of the Nystrom method",
+	    ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_landmark_selection, "landmark_selection",
+	    "landmark selection strategy of the Nystrom method",
+	    ParameterProperties::NONE,
+	    SG_OPTIONS(
+	        LANDMARKS_UNIFORM, LANDMARKS_KMEANS_PLUS_PLUS,
+	        LANDMARKS_LEVERAGE_SCORE));
+	SG_ADD(
+	    &m_low_rank_kernel, "low_rank_kernel",
+	    "Nystrom approximation of the kernel", ParameterProperties::READONLY);
 }
 
 KernelPCA::~KernelPCA()
@@ -59,8 +82,41 @@ KernelPCA::~KernelPCA()
 void KernelPCA::fit(std::shared_ptr<Features> features)
 {
 	require(m_kernel, "Kernel not set");
+	require(features, "No features provided");
+
+	switch (m_method)
+	{
+	case KPCA_EXACT:
+		fit_exact(features);
+		break;
+	case KPCA_NYSTROM:
+		fit_nystrom(features);
+		break;
+	default:
+		error("Unknown method {}", (int32_t)m_method);
+	}
 
+	m_fitted.store(true);
+	io::info("Done");
+}
+
+void KernelPCA::check_target_dim(int32_t max_dim)
+{
+	if (m_target_dim > max_dim)
+	{
+		io::warn(
+		    "Target dimension ({}) is not a valid value, it must be"
+		    "less or equal than the number of vectors."
+		    "Setting it to maximum allowed size ({}).",
+		    m_target_dim, max_dim);
+		m_target_dim = max_dim;
+	}
+}
+
+void KernelPCA::fit_exact(const std::shared_ptr<Features>& features)
+{
 	m_init_features = features;
+	m_low_rank_kernel = NULL;
 
 	m_kernel->init(features, features);
 	SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
@@ -68,15 +124,7 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 	int32_t n = kernel_matrix.num_cols;
 	int32_t m = kernel_matrix.num_rows;
 	ASSERT(n == m)
-	if (m_target_dim > n)
-	{
-		io::warn(
-		    "Target dimension ({}) is not a valid value, it must be"
-		    "less or equal than the number of vectors."
-		    "Setting it to maximum allowed size ({}).",
-		    m_target_dim, n);
-		m_target_dim = n;
-	}
+	check_target_dim(n);
 
 	auto bias_tmp = linalg::rowwise_sum(kernel_matrix);
 	linalg::scale(bias_tmp, bias_tmp, -1.0 / n);
@@ -105,9 +153,45 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 
 	m_bias_vector = SGVector<float64_t>(m_target_dim);
 	linalg::matrix_prod(m_transformation_matrix, bias_tmp, m_bias_vector, true);
+}
 
-	m_fitted.store(true);
-	io::info("Done");
+void KernelPCA::fit_nystrom(const std::shared_ptr<Features>& features)
+{
+	require(
+	    m_num_landmarks > 0, "Number of landmarks ({}) must be positive",
+	    m_num_landmarks);
+
+	const int32_t n = features->get_num_vectors();
+	m_init_features = NULL;
+	m_low_rank_kernel = std::make_shared<LowRankApproxKernel>(
+	    m_kernel, std::min(m_num_landmarks, n), m_landmark_selection);
+	random::seed(m_low_rank_kernel, m_prng);
+	m_low_rank_kernel->fit(features);
+
+	// the centered Nystrom features span the approximate centered kernel,
+	// its eigenvectors are given by a linear PCA of the features
+	auto phi = m_low_rank_kernel->transform(features)->get_feature_matrix();
+	check_target_dim(phi.num_rows);
+
+	auto mean = linalg::rowwise_sum(phi);
+	linalg::scale(mean, mean, 1.0 / n);
+	linalg::add_vector(phi, mean, phi, 1.0, -1.0);
+	auto covariance = linalg::matrix_prod(phi, phi, false, true);
+
+	SGVector<float64_t> eigenvalues(m_target_dim);
+	SGMatrix<float64_t> eigenvectors(covariance.num_rows, m_target_dim);
+	linalg::eigen_solver_symmetric(
+	    covariance, eigenvalues, eigenvectors, m_target_dim);
+
+	m_transformation_matrix =
+	    SGMatrix<float64_t>(covariance.num_rows, m_target_dim);
+	// eigenvalues are in increasing order
+	for (int32_t i = 0; i < m_target_dim; i++)
+		m_transformation_matrix.set_column(
+		    i, eigenvectors.get_column(m_target_dim - i - 1));
+
+	m_bias_vector = linalg::matrix_prod(m_transformation_matrix, mean, true);
+	linalg::scale(m_bias_vector, m_bias_vector, -1.0);
 }
 
 std::shared_ptr<Features> KernelPCA::transform(std::shared_ptr<Features> features, bool inplace)
@@ -129,24 +213,61 @@ std::shared_ptr<Features> KernelPCA::transform(std::shared_ptr<Features> feature
 	return NULL;
 }
 
-SGMatrix<float64_t> KernelPCA::apply_to_feature_matrix(std::shared_ptr<Features> features)
+SGMatrix<float64_t> KernelPCA::project(const std::shared_ptr<Features>& features)
 {
 	assert_fitted();
-	int32_t n = m_init_features->get_num_vectors();
 
-	m_kernel->init(std::move(features), m_init_features);
-	auto kernel_matrix = m_kernel->get_kernel_matrix();
+	if (m_low_rank_kernel)
+	{
+		auto phi =
+		    m_low_rank_kernel->transform(features)->get_feature_matrix();
+		auto result =
+		    linalg::matrix_prod(m_transformation_matrix, phi, true, false);
+		linalg::add_vector(result, m_bias_vector, result);
+		return result;
+	}
 
-	auto rows_sum = linalg::rowwise_sum(kernel_matrix);
-	linalg::add_vector(kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	const index_t n = m_init_features->get_num_vectors();
+	const index_t dim = m_transformation_matrix.num_cols;
 
-	SGMatrix<float64_t> new_feature_matrix =
-	    linalg::matrix_prod(m_transformation_matrix, kernel_matrix, true, true);
+	// the last column computes the mean kernel value of every vector with
+	// the training vectors, which centers the kernel
+	SGMatrix<float64_t> coefficients(n, dim + 1);
+	for (index_t k = 0; k < dim; ++k)
+	{
+		std::copy_n(
+		    m_transformation_matrix.get_column_vector(k), n,
+		    coefficients.get_column_vector(k));
+	}
+	std::fill_n(coefficients.get_column_vector(dim), n, 1.0 / n);
+	auto column_sums = linalg::colwise_sum(m_transformation_matrix);
 
-	linalg::add_vector(new_feature_matrix, m_bias_vector, new_feature_matrix);
+	SGVector<index_t> train_idx(n);
+	train_idx.range_fill();
+	SGVector<index_t> vec_idx(features->get_num_vectors());
+	vec_idx.range_fill();
 
+	m_kernel->init(m_init_features, features);
+	auto outputs =
+	    m_kernel->compute_weighted_outputs(train_idx, coefficients, vec_idx);
 	m_kernel->cleanup();
-	return new_feature_matrix;
+
+	SGMatrix<float64_t> result(dim, vec_idx.vlen);
+	for (index_t i = 0; i < vec_idx.vlen; ++i)
+	{
+		for (index_t k = 0; k < dim; ++k)
+		{
+			result(k, i) = outputs(i, k) - outputs(i, dim) * column_sums[k] +
+			               m_bias_vector[k];
+		}
+	}
+
+	return result;
+}
+
+SGMatrix<float64_t> KernelPCA::apply_to_feature_matrix(std::shared_ptr<Features> features)
+{
+	return project(features);
 }
 
 SGVector<float64_t> KernelPCA::apply_to_feature_vector(SGVector<float64_t> vector)
@@ -165,33 +286,7 @@ SGVector<float64_t> KernelPCA::apply_to_feature_vector(SGVector<float64_t> vecto
 
 std::shared_ptr<DenseFeatures<float64_t>> KernelPCA::apply_to_string_features(std::shared_ptr<Features> features)
 {
-	assert_fitted();
-
-	int32_t num_vectors = features->get_num_vectors();
-	int32_t i,j,k;
-	int32_t n = m_transformation_matrix.num_cols;
-
-	m_kernel->init(features,m_init_features);
-
-	SGMatrix<float64_t> new_feature_matrix(m_target_dim * num_vectors);
-
-	for (i=0; i<num_vectors; i++)
-	{
-		for (j=0; j<m_target_dim; j++)
-			new_feature_matrix[i*m_target_dim+j] = m_bias_vector.vector[j];
-
-		for (j=0; j<n; j++)
-		{
-			float64_t kij = m_kernel->kernel(i,j);
-
-			for (k=0; k<m_target_dim; k++)
-				new_feature_matrix[k+i*m_target_dim] += kij*m_transformation_matrix.matrix[(n-k-1)*n+j];
-		}
-	}
-
-	m_kernel->cleanup();
-
-	return std::make_shared<DenseFeatures<float64_t>>(SGMatrix<float64_t>(new_feature_matrix,m_target_dim,num_vectors));
+	return std::make_shared<DenseFeatures<float64_t>>(project(features));
 }
 
 EFeatureClass KernelPCA::get_feature_class()
@@ -227,3 +322,36 @@ std::shared_ptr<Kernel> KernelPCA::get_kernel() const
 
 	return m_kernel;
 }
+
+void KernelPCA::set_method(EKernelPCAMethod method)
+{
+	m_method = method;
+}
+
+EKernelPCAMethod KernelPCA::get_method() const
+{
+	return m_method;
+}
+
+void KernelPCA::set_num_landmarks(int32_t num_landmarks)
+{
+	require(
+	    num_landmarks > 0, "Number of landmarks ({}) must be positive",
+	    num_landmarks);
+	m_num_landmarks = num_landmarks;
+}
+
+int32_t KernelPCA::get_num_landmarks() const
+{
+	return m_num_landmarks;
+}
+
+void KernelPCA::set_landmark_selection(ELandmarkSelection selection)
+{
+	m_landmark_selection = selection;
+}
+
+ELandmarkSelection KernelPCA::get_landmark_selection() const
+{
+	return m_landmark_selection;
+}
@@ -11,7 +11,9 @@
 
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/LowRankApproxKernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -20,6 +22,19 @@ namespace shogun
 class Features;
 class Kernel;
 
+/** how KernelPCA computes the principal components */
+enum EKernelPCAMethod
+{
+	/** eigendecomposition of the full centered kernel matrix, requires
+	 * O(n^2) memory and O(n^3) time
+	 */
+	KPCA_EXACT = 10,
+	/** PCA of the Nyström features of m landmarks, requires O(nm) memory
+	 * and O(nm^2) time
+	 */
+	KPCA_NYSTROM = 20
+};
+
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
  * Schoelkopf, B., Smola, A. J., & Mueller, K. R. (1999).
@@ -27,8 +42,19 @@ class Kernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * The exact method forms and decomposes the full n x n kernel matrix, which
+ * limits it to a few ten thousand training vectors. The Nyström method
+ * approximates the kernel with m landmarks, see LowRankApproxKernel, and
+ * performs a linear PCA of the m dimensional Nyström features of the
+ * training data. The full kernel matrix is never formed, and transforming
+ * a vector only requires its kernel with the landmarks. With all training
+ * vectors as landmarks both methods agree.
+ *
+ * Vectors are transformed in blocks of kernel values multiplied with the
+ * transformation matrix, the kernel matrix of the transformed vectors and
+ * the basis vectors is not stored either.
  */
-class KernelPCA : public Preprocessor
+class KernelPCA : public RandomMixin<Preprocessor>
 {
 public:
 		/** default constructor
@@ -108,17 +134,72 @@ public:
 		 */
 		std::shared_ptr<Kernel> get_kernel() const;
 
+		/** setter for the method
+		 * @param method how to compute the principal components
+		 */
+		void set_method(EKernelPCAMethod method);
+
+		/** getter for the method
+		 * @return method
+		 */
+		EKernelPCAMethod get_method() const;
+
+		/** setter for the number of landmarks of the Nyström method
+		 * @param num_landmarks number of landmarks, at most the number of
+		 * training vectors are used
+		 */
+		void set_num_landmarks(int32_t num_landmarks);
+
+		/** getter for the number of landmarks of the Nyström method
+		 * @return number of landmarks
+		 */
+		int32_t get_num_landmarks() const;
+
+		/** setter for the landmark selection of the Nyström method
+		 * @param selection landmark selection strategy
+		 */
+		void set_landmark_selection(ELandmarkSelection selection);
+
+		/** getter for the landmark selection of the Nyström method
+		 * @return landmark selection strategy
+		 */
+		ELandmarkSelection get_landmark_selection() const;
+
 	protected:
 
 		/** default init */
 		void init();
 
+		/** fit on the full centered kernel matrix
+		 * @param features training features
+		 */
+		void fit_exact(const std::shared_ptr<Features>& features);
+
+		/** fit on the Nyström features of the training data
+		 * @param features training features
+		 */
+		void fit_nystrom(const std::shared_ptr<Features>& features);
+
+		/** warn and reduce the target dimension if it exceeds the given
+		 * maximum
+		 * @param max_dim largest valid target dimension
+		 */
+		void check_target_dim(int32_t max_dim);
+
+		/** project features on the principal components
+		 * @param features features to project
+		 * @return matrix of size target dimension x number of vectors
+		 */
+		SGMatrix<float64_t> project(const std::shared_ptr<Features>& features);
+
 	protected:
 
 		/** features used by init. needed for apply */
 		std::shared_ptr<Features> m_init_features;
 
-		/** transformation matrix */
+		/** transformation matrix, acts on the kernel with the training
+		 * vectors (exact method) or on the Nyström features (Nyström method)
+		 */
 		SGMatrix<float64_t> m_transformation_matrix;
 
 		/** bias vector */
@@ -129,6 +210,18 @@ public:
 
 		/** kernel to be used */
 		std::shared_ptr<Kernel> m_kernel;
+
+		/** method to compute the principal components */
+		EKernelPCAMethod m_method;
+
+		/** number of landmarks of the Nyström method */
+		int32_t m_num_landmarks;
+
+		/** landmark selection strategy of the Nyström method */
+		ELandmarkSelection m_landmark_selection;
+
+		/** Nyström approximation of the kernel fitted by the Nyström method */
+		std::shared_ptr<LowRankApproxKernel> m_low_rank_kernel;
 };
 }
 #endif
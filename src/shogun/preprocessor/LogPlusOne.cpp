@@ -58,3 +58,11 @@ SGVector<float64_t> LogPlusOne::apply_to_feature_vector(SGVector<float64_t> vect
 
 	return log_vec;
 }
+
+int32_t LogPlusOne::apply_in_place(float64_t* vector, int32_t len)
+{
+	for (int32_t i=0; i<len; i++)
+		vector[i] = std::log(vector[i] + 1.0);
+
+	return len;
+}
@@ -9,7 +9,6 @@
 #include <shogun/features/Features.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
-#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/NormOne.h>
 
@@ -42,7 +41,8 @@ bool NormOne::save(FILE* f)
 
 SGMatrix<float64_t> NormOne::apply_to_matrix(SGMatrix<float64_t> matrix)
 {
-	for (auto i : range(matrix.num_cols))
+	#pragma omp parallel for
+	for (index_t i = 0; i < matrix.num_cols; ++i)
 	{
 		auto vec = matrix.get_column(i);
 		auto norm = linalg::norm(vec);
@@ -57,3 +57,16 @@ SGVector<float64_t> NormOne::apply_to_feature_vector(SGVector<float64_t> vector)
 {
 	return linalg::scale(vector, 1.0 / linalg::norm(vector));
 }
+
+int32_t NormOne::apply_in_place(float64_t* vector, int32_t len)
+{
+	float64_t sq=0;
+	for (int32_t i=0; i<len; i++)
+		sq+=vector[i]*vector[i];
+
+	const float64_t scale=1.0/std::sqrt(sq);
+	for (int32_t i=0; i<len; i++)
+		vector[i]*=scale;
+
+	return len;
+}
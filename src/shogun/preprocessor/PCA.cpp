@@ -7,9 +7,11 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/features/Features.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PCA.h>
 
@@ -19,7 +21,7 @@ using namespace Eigen;
 PCA::PCA(
     bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method,
     EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -30,7 +32,7 @@ PCA::PCA(
 }
 
 PCA::PCA(EPCAMethod method, bool do_whitening, EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -51,6 +53,10 @@ void PCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance = 1e-15;
 	m_target_dim = 1;
+	m_num_oversamples = 10;
+	m_num_power_iterations = 2;
+	m_chunk_size = 10000;
+	m_num_seen = 0;
 
 	SG_ADD(
 	    &m_transformation_matrix, "transformation_matrix",
@@ -83,13 +89,167 @@ void PCA::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_method, "method",
 	    "Method used for PCA calculation", ParameterProperties::NONE,
-	    SG_OPTIONS(AUTO, SVD, EVD));
+	    SG_OPTIONS(AUTO, SVD, EVD, RANDOMIZED));
+	SG_ADD(
+	    &m_num_oversamples, "num_oversamples",
+	    "Number of additional samples of the randomized SVD",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_num_power_iterations, "num_power_iterations",
+	    "Number of power iterations of the randomized SVD",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_chunk_size, "chunk_size",
+	    "Number of vectors read at once from streaming features",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_num_seen, "num_seen",
+	    "Number of vectors fitted incrementally so far");
+	SG_ADD(
+	    &m_singular_values, "singular_values",
+	    "Singular values of the incrementally fitted components");
+	SG_ADD(
+	    &m_components, "components",
+	    "Incrementally fitted components, without whitening");
 }
 
 PCA::~PCA()
 {
 }
 
+void PCA::fit(std::shared_ptr<Features> features)
+{
+	require(features, "No features provided");
+
+	if (features->get_feature_class() != C_STREAMING_DENSE)
+	{
+		RandomMixin<DensePreprocessor<float64_t>>::fit(features);
+		return;
+	}
+
+	require(m_chunk_size > 0, "Chunk size ({}) must be positive", m_chunk_size);
+	auto streaming = features->as<StreamingDenseFeatures<float64_t>>();
+
+	m_num_seen = 0;
+	streaming->start_parser();
+	while (true)
+	{
+		auto chunk = streaming->get_streamed_features(m_chunk_size)
+		                 ->as<DenseFeatures<float64_t>>()
+		                 ->get_feature_matrix();
+		if (chunk.num_cols > 0)
+			partial_fit(chunk);
+		if (chunk.num_cols < m_chunk_size)
+			break;
+	}
+	streaming->end_parser();
+
+	require(m_num_seen > 0, "No vectors were streamed");
+}
+
+void PCA::partial_fit(const SGMatrix<float64_t>& chunk)
+{
+	require(
+	    m_mode == FIXED_NUMBER,
+	    "Incremental PCA only computes a fixed number of components.");
+
+	const int32_t num_features = chunk.num_rows;
+	const int32_t num_vectors = chunk.num_cols;
+	require(num_vectors > 0, "Chunk must contain vectors");
+
+	if (m_num_seen == 0)
+	{
+		require(
+		    m_target_dim <= num_features,
+		    "Target dimension ({}) must not exceed the number of features "
+		    "({})",
+		    m_target_dim, num_features);
+		m_mean_vector = SGVector<float64_t>(num_features);
+		m_mean_vector.zero();
+		m_singular_values = SGVector<float64_t>();
+		m_components = SGMatrix<float64_t>(num_features, 0);
+	}
+	require(
+	    m_mean_vector.vlen == num_features,
+	    "Chunk has {} features, previous chunks had {}", num_features,
+	    m_mean_vector.vlen);
+
+	Map<MatrixXd> X(chunk.matrix, num_features, num_vectors);
+	Map<VectorXd> mean(m_mean_vector.vector, num_features);
+	Map<VectorXd> s_old(m_singular_values.vector, m_singular_values.vlen);
+	Map<MatrixXd> V_old(
+	    m_components.matrix, num_features, m_components.num_cols);
+
+	const int64_t num_old = m_num_seen;
+	const int64_t num_total = num_old + num_vectors;
+	VectorXd chunk_mean = X.rowwise().mean();
+
+	// the transpose of the matrix to decompose: the previous components
+	// weighted by their singular values, the centered chunk and the
+	// correction for the shift of the mean
+	const index_t num_old_cols = V_old.cols();
+	const index_t num_cols =
+	    num_old_cols + num_vectors + (num_old > 0 ? 1 : 0);
+	SGMatrix<float64_t> stacked(num_features, num_cols);
+	Map<MatrixXd> M(stacked.matrix, num_features, num_cols);
+	M.leftCols(num_old_cols) = V_old * s_old.asDiagonal();
+#pragma omp parallel for
+	for (index_t i = 0; i < num_vectors; ++i)
+		M.col(num_old_cols + i) = X.col(i) - chunk_mean;
+	if (num_old > 0)
+	{
+		M.col(num_cols - 1) =
+		    std::sqrt(float64_t(num_old) * num_vectors / num_total) *
+		    (mean - chunk_mean);
+	}
+
+	// left singular vectors of the transpose span the feature space
+	const index_t rank = std::min<index_t>(num_features, num_cols);
+	SGVector<float64_t> s(rank);
+	SGMatrix<float64_t> U(num_features, rank);
+	linalg::svd(stacked, s, U);
+
+	const index_t k = std::min<index_t>(m_target_dim, rank);
+	m_singular_values = SGVector<float64_t>(k);
+	m_components = SGMatrix<float64_t>(num_features, k);
+	Map<VectorXd>(m_singular_values.vector, k) =
+	    Map<VectorXd>(s.vector, rank).head(k);
+	Map<MatrixXd>(m_components.matrix, num_features, k) =
+	    Map<MatrixXd>(U.matrix, num_features, rank).leftCols(k);
+
+	mean = (float64_t(num_old) * mean + float64_t(num_vectors) * chunk_mean) /
+	       float64_t(num_total);
+	m_num_seen = num_total;
+
+	// transformation of the data seen so far
+	num_dim = k;
+	num_old_dim = num_features;
+	m_eigenvalues_vector = SGVector<float64_t>(k);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, k);
+	Map<VectorXd> sv(m_singular_values.vector, k);
+	eigenValues = sv.cwiseProduct(sv) / std::max<float64_t>(num_total - 1, 1);
+
+	m_transformation_matrix = m_components.clone();
+	Map<MatrixXd> transformMatrix(
+	    m_transformation_matrix.matrix, num_features, k);
+	if (m_whitening)
+	{
+		for (int32_t i = 0; i < k; i++)
+		{
+			if (Math::fequals_abs<float64_t>(
+			        0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
+			{
+				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
+				continue;
+			}
+
+			transformMatrix.col(i) /= sv[i];
+		}
+	}
+
+	m_fitted.store(true);
+}
+
 void PCA::fit_impl(const SGMatrix<float64_t>& feature_matrix)
 {
 
@@ -100,6 +260,7 @@ void PCA::fit_impl(const SGMatrix<float64_t>& feature_matrix)
 	// max target dim allowed
 	auto max_dim_allowed = std::min(num_vectors, num_features);
 	num_dim = 0;
+	m_num_seen = 0;
 
 	require(
 	    m_target_dim <= max_dim_allowed,
@@ -120,6 +281,8 @@ void PCA::fit_impl(const SGMatrix<float64_t>& feature_matrix)
 
 	if (m_method == EVD)
 		init_with_evd(feature_matrix, max_dim_allowed);
+	else if (m_method == RANDOMIZED)
+		init_with_randomized_svd(feature_matrix);
 	else
 		init_with_svd(feature_matrix, max_dim_allowed);
 
@@ -284,6 +447,55 @@ void PCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_d
 	}
 }
 
+void PCA::init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix)
+{
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+
+	require(
+	    m_mode == FIXED_NUMBER,
+	    "Randomized PCA only computes a fixed number of components.");
+	num_dim = m_target_dim;
+
+	// left singular vectors of the centered data are the eigenvectors of
+	// its covariance
+	SGVector<float64_t> singular_values;
+	SGMatrix<float64_t> U, V;
+	linalg::randomized_svd(
+	    feature_matrix, num_dim, singular_values, U, V, m_prng,
+	    m_num_oversamples, m_num_power_iterations);
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	Map<VectorXd> s(singular_values.vector, num_dim);
+	eigenValues = s.cwiseProduct(s) / (num_vectors - 1);
+	io::info("Reducing from {} to {} features...", num_features, num_dim);
+
+	m_transformation_matrix = U;
+	Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix, num_features, num_dim);
+	num_old_dim = num_features;
+
+	if (m_whitening)
+	{
+		for (int32_t i = 0; i < num_dim; i++)
+		{
+			if (Math::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
+			{
+				io::warn("Covariance matrix has almost zero Eigenvalue (ie "
+					"Eigenvalue within a tolerance of {:E} around 0) at "
+					"dimension {}. Consider reducing its dimension.",
+					m_eigenvalue_zero_tolerance, i + 1);
+
+				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
+				continue;
+			}
+
+			transformMatrix.col(i) /=
+			    std::sqrt(eigenValues[i] * (num_vectors - 1));
+		}
+	}
+}
+
 SGMatrix<float64_t> PCA::apply_to_matrix(SGMatrix<float64_t> matrix)
 {
 	assert_fitted();
@@ -12,6 +12,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/lib/common.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
@@ -29,7 +30,12 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized SVD of the feature matrix, computes only the target
+	 * dimension many components and requires FIXED_NUMBER mode.
+	 * Time complexity ~DN(T+p)(2q+2) for p oversamples and q power iterations
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -83,6 +89,16 @@ enum EPCAMemoryMode
  * using the formula \f$e_i = \frac{\sqrt{d_i}}{N-1}\f$.
  * The time complexity of this method is \f$~14DN^2\f$ and should be used when N < D.
  *
+ * <em>RANDOMIZED</em> : Randomized SVD of the feature matrix X (Halko,
+ * Martinsson and Tropp). Only the T leading components are computed from
+ * products of X with a few Gaussian vectors, so it is suited to large D and N
+ * when T is small. It is only available in FIXED_NUMBER mode. The number of
+ * oversamples and power iterations trade time for accuracy.
+ *
+ * Data that does not fit in memory can be fitted incrementally from
+ * StreamingDenseFeatures or with partial_fit on chunks of vectors, which
+ * keeps only the mean and the T leading components (FIXED_NUMBER mode).
+ *
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
@@ -104,7 +120,7 @@ enum EPCAMemoryMode
  *
  * Note that vectors/matrices don't have to have zero mean as it is substracted within the class.
  */
-class PCA : public DensePreprocessor<float64_t>
+class PCA : public RandomMixin<DensePreprocessor<float64_t>>
 {
 	public:
 
@@ -113,7 +129,8 @@ class PCA : public DensePreprocessor<float64_t>
 		 * @param do_whitening normalize columns(eigenvectors) in transformation matrix
 		 * @param mode mode of pca : FIXED_NUMBER/VARIANCE_EXPLAINED/THRESHOLD
 		 * @param thresh threshold value for VARIANCE_EXPLAINED or THRESHOLD mode
-		 * @param method Matrix decomposition method used : SVD/EVD/AUTO[default]
+		 * @param method Matrix decomposition method used :
+		 * SVD/EVD/RANDOMIZED/AUTO[default]
 		 * @param mem_mode memory usage mode of PCA : MEM_REALLOCATE/MEM_IN_PLACE
 		 */
 		PCA(bool do_whitening=false, EPCAMode mode=FIXED_NUMBER, float64_t thresh=1e-6,
@@ -121,7 +138,8 @@ class PCA : public DensePreprocessor<float64_t>
 
 		/** special constructor for FIXED_NUMBER mode
 		 *
-		 * @param method Matrix decomposition method used : SVD/EVD/AUTO[default]
+		 * @param method Matrix decomposition method used :
+		 * SVD/EVD/RANDOMIZED/AUTO[default]
 		 * @param do_whitening normalize columns(eigenvectors) in transformation matrix
 		 * @param mem memory usage mode of PCA : MEM_REALLOCATE/MEM_IN_PLACE
 		 */
@@ -130,6 +148,26 @@ class PCA : public DensePreprocessor<float64_t>
 		/** destructor */
 		~PCA() override;
 
+		/** fit the preprocessor. StreamingDenseFeatures are read in chunks
+		 * of chunk_size vectors and fitted incrementally with partial_fit,
+		 * so the data never has to fit in memory.
+		 *
+		 * @param features DenseFeatures or StreamingDenseFeatures
+		 */
+		void fit(std::shared_ptr<Features> features) override;
+
+		/** update the mean and the target dimension many leading components
+		 * with a chunk of vectors, as in Ross et al., "Incremental Learning
+		 * for Robust Visual Tracking", IJCV 77, 2008. The previous
+		 * components, weighted by their singular values, are decomposed
+		 * together with the centered chunk and a mean correction, so only
+		 * a low rank basis is kept between the chunks. Requires
+		 * FIXED_NUMBER mode.
+		 *
+		 * @param chunk feature vectors of the chunk, one per column
+		 */
+		void partial_fit(const SGMatrix<float64_t>& chunk);
+
 		/** apply preprocessor to feature vector
 		 * @param vector feature vector
 		 * @return processed feature vector
@@ -222,11 +260,31 @@ class PCA : public DensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** number of additional samples of the randomized SVD */
+		int32_t m_num_oversamples;
+
+		/** number of power iterations of the randomized SVD */
+		int32_t m_num_power_iterations;
+
+		/** number of vectors read at once from streaming features */
+		int32_t m_chunk_size;
+
+		/** number of vectors fitted incrementally so far */
+		int64_t m_num_seen;
+
+		/** singular values of the incrementally fitted components */
+		SGVector<float64_t> m_singular_values;
+
+		/** incrementally fitted components, without whitening */
+		SGMatrix<float64_t> m_components;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized svd */
+		void init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix);
 };
 }
 #endif // PCA_H_
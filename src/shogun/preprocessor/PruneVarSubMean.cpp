@@ -8,6 +8,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/SummaryStatistics.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PruneVarSubMean.h>
@@ -30,36 +31,21 @@ PruneVarSubMean::~PruneVarSubMean()
 void PruneVarSubMean::fit_impl(const SGMatrix<float64_t>& feature_matrix)
 {
 
-	auto num_examples = feature_matrix.num_cols;
 	auto num_features = feature_matrix.num_rows;
 
 	m_idx = SGVector<int32_t>();
 	m_std = SGVector<float64_t>();
 
-	SGVector<float64_t> var(num_features);
-
-	// compute mean
-	m_mean = linalg::rowwise_sum(feature_matrix);
-	linalg::scale(m_mean, m_mean, 1.0 / num_examples);
-
-	// compute var
-	for (auto i : range(num_examples))
-	{
-		for (auto j : range(num_features))
-		{
-			auto diff =
-			    linalg::add(m_mean, feature_matrix.get_column(i), 1.0, -1.0);
-			var[j] += linalg::dot(diff, diff);
-		}
-	}
+	// mean and variance in a single parallel pass
+	auto stats = SummaryStatistics::compute(feature_matrix);
+	m_mean = stats.get_mean();
+	auto var = stats.get_variance();
 
 	int32_t num_ok = 0;
 	auto idx_ok = SGVector<int32_t>(num_features);
 
 	for (auto j : range(num_features))
 	{
-		var[j] /= num_examples;
-
 		if (var[j] >= 1e-14)
 		{
 			idx_ok[num_ok] = j;
@@ -131,6 +117,22 @@ SGVector<float64_t> PruneVarSubMean::apply_to_feature_vector(SGVector<float64_t>
 	return out;
 }
 
+int32_t PruneVarSubMean::apply_in_place(float64_t* vector, int32_t len)
+{
+	assert_fitted();
+
+	// the kept features are ascending, so no element is read after it has
+	// been overwritten
+	for (auto i : range(m_num_idx))
+	{
+		vector[i] = vector[m_idx[i]] - m_mean[i];
+		if (m_divide_by_std)
+			vector[i] /= m_std[i];
+	}
+
+	return m_num_idx;
+}
+
 void PruneVarSubMean::init()
 {
 	m_divide_by_std = false;
@@ -40,6 +40,10 @@ class PruneVarSubMean : public DensePreprocessor<float64_t>
 		/// result in feature matrix
 		SGVector<float64_t> apply_to_feature_vector(SGVector<float64_t> vector) override;
 
+		bool supports_in_place() const override { return true; }
+
+		int32_t apply_in_place(float64_t* vector, int32_t len) override;
+
 		/** @return object name */
 		const char* get_name() const override { return "PruneVarSubMean"; }
 
@@ -82,14 +82,11 @@ SGMatrix<float64_t> RFFPreprocessor::sample_spectral_density(int32_t dim_input_s
 
 	if (auto kernel = std::dynamic_pointer_cast<GaussianKernel>(m_kernel))
 	{
-		NormalDistribution<float64_t> normal_dist;
 		const auto width = kernel->get_width();
 		const auto std_dev = std::sqrt(2.0 / width);
-		std::generate(
-		    sampled_kernel.begin(), sampled_kernel.end(),
-		    [this, &normal_dist, &std_dev]() {
-			    return std_dev * normal_dist(m_prng);
-		    });
+		random::parallel_fill_array(
+		    sampled_kernel, NormalDistribution<float64_t>(0.0, std_dev),
+		    make_streams());
 	}
 	else
 	{
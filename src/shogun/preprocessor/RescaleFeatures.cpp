@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <shogun/base/range.h>
+#include <shogun/mathematics/SummaryStatistics.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/RescaleFeatures.h>
 
@@ -30,26 +31,21 @@ void RescaleFeatures::fit_impl(const SGMatrix<float64_t>& feature_matrix)
 
 	io::info("Extracting min and range values for each feature");
 
+	// min and max of all features in a single parallel pass over the
+	// columns
+	auto stats = SummaryStatistics::compute(feature_matrix);
+	auto cur_min = stats.get_min();
+	auto cur_max = stats.get_max();
+
 	m_min = SGVector<float64_t>(num_features);
 	m_range = SGVector<float64_t>(num_features);
 	for (index_t i = 0; i < num_features; i++)
 	{
-		SGVector<float64_t> vec = feature_matrix.get_row_vector(i);
-		float64_t cur_min = vec[0];
-		float64_t cur_max = vec[0];
-
-		/* find the max and min values in one loop */
-		for (index_t j = 1; j < vec.vlen; j++)
-		{
-			cur_min = std::min(vec[j], cur_min);
-			cur_max = std::max(vec[j], cur_max);
-		}
-
 		/* only rescale if range > 0 */
-		if ((cur_max - cur_min) > 0)
+		if ((cur_max[i] - cur_min[i]) > 0)
 		{
-			m_min[i] = cur_min;
-			m_range[i] = 1.0 / (cur_max - cur_min);
+			m_min[i] = cur_min[i];
+			m_range[i] = 1.0 / (cur_max[i] - cur_min[i]);
 		}
 		else
 		{
@@ -91,6 +87,17 @@ SGVector<float64_t> RescaleFeatures::apply_to_feature_vector(SGVector<float64_t>
 	return ret;
 }
 
+int32_t RescaleFeatures::apply_in_place(float64_t* vector, int32_t len)
+{
+	assert_fitted();
+	ASSERT(m_min.vlen == len);
+
+	for (index_t i = 0; i < len; i++)
+		vector[i] = (vector[i] - m_min[i]) * m_range[i];
+
+	return len;
+}
+
 void RescaleFeatures::register_parameters()
 {
 	SG_ADD(&m_min, "min", "minimum values of each feature");
@@ -0,0 +1,344 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/progress.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/regression/ElasticNetPath.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace Eigen;
+using namespace shogun;
+
+namespace
+{
+	/** cyclic coordinate descent on the working set of coefficients
+	 *
+	 * @param X centered data, one column per feature
+	 * @param norms mean squared norms of the features
+	 * @param residual residual of the labels, updated along with beta
+	 * @param tolerance stop once no update decreases the loss by more
+	 * @return whether the tolerance was reached
+	 */
+	template <typename ST>
+	bool coordinate_descent(
+	    const Map<Matrix<ST, Dynamic, Dynamic>>& X,
+	    const Matrix<ST, Dynamic, 1>& norms, const std::vector<index_t>& working,
+	    ST l1, ST l2, ST tolerance, int32_t max_iterations,
+	    Matrix<ST, Dynamic, 1>& beta, Matrix<ST, Dynamic, 1>& residual)
+	{
+		const ST n_vec = X.rows();
+		for (auto iteration : range(max_iterations))
+		{
+			ST max_change = 0;
+			for (auto j : working)
+			{
+				if (norms[j] == 0)
+					continue;
+
+				// minimize over beta_j with the others fixed
+				const ST beta_old = beta[j];
+				const ST z = X.col(j).dot(residual) / n_vec + norms[j] * beta_old;
+				const ST beta_new =
+				    Math::sign(z) * std::max<ST>(std::abs(z) - l1, 0) /
+				    (norms[j] + l2);
+				if (beta_new == beta_old)
+					continue;
+
+				const ST delta = beta_new - beta_old;
+				residual -= delta * X.col(j);
+				beta[j] = beta_new;
+				max_change = std::max(max_change, norms[j] * delta * delta);
+			}
+			if (max_change < tolerance)
+				return true;
+		}
+		return false;
+	}
+} // namespace
+
+ElasticNetPath::ElasticNetPath()
+    : DenseRealDispatch<ElasticNetPath, LinearMachine>()
+{
+	init();
+}
+
+ElasticNetPath::ElasticNetPath(float64_t l1_ratio)
+    : DenseRealDispatch<ElasticNetPath, LinearMachine>()
+{
+	init();
+
+	m_l1_ratio = l1_ratio;
+}
+
+ElasticNetPath::~ElasticNetPath()
+{
+}
+
+void ElasticNetPath::init()
+{
+	m_l1_ratio = 1.0;
+	m_num_lambdas = 100;
+	m_lambda_min_ratio = 1e-3;
+	m_max_iterations = 1000;
+	m_tolerance = 1e-7;
+	m_max_nonz = 0;
+	m_strong_rules = true;
+	m_use_bias = true;
+
+	SG_ADD(
+	    &m_l1_ratio, "l1_ratio", "Weight of the l1 penalty",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_num_lambdas, "num_lambdas", "Number of regularization constants",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_lambda_min_ratio, "lambda_min_ratio",
+	    "Smallest over largest regularization constant",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_lambdas, "lambdas", "Decreasing regularization constants",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_max_iterations, "max_iterations",
+	    "Max number of sweeps per regularization constant",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_tolerance, "tolerance", "Convergence tolerance",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_max_nonz, "max_nonz", "Max number of non-zero variables",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_strong_rules, "strong_rules",
+	    "Whether to discard variables by the strong rules",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_use_bias, "use_bias", "Whether or not to fit an offset term",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_path_lambdas, "path_lambdas",
+	    "Regularization constants of the path", ParameterProperties::MODEL);
+	SG_ADD(
+	    &m_path_w, "path_w", "Estimators of the path",
+	    ParameterProperties::MODEL);
+	SG_ADD(
+	    &m_path_bias, "path_bias", "Biases of the path",
+	    ParameterProperties::MODEL);
+	watch_method("path_size", &ElasticNetPath::get_path_size);
+}
+
+SGVector<float64_t> ElasticNetPath::get_w_for_lambda(int32_t index) const
+{
+	require(
+	    index >= 0 && index < get_path_size(),
+	    "Index {} is not on the path of {} estimators", index,
+	    get_path_size());
+	return SGVector<float64_t>(
+	    m_path_w.get_column_vector(index), m_path_w.num_rows, false)
+	    .clone();
+}
+
+float64_t ElasticNetPath::get_bias_for_lambda(int32_t index) const
+{
+	require(
+	    index >= 0 && index < get_path_size(),
+	    "Index {} is not on the path of {} estimators", index,
+	    get_path_size());
+	return m_path_bias[index];
+}
+
+void ElasticNetPath::switch_w(int32_t index)
+{
+	set_w(get_w_for_lambda(index));
+	set_bias(get_bias_for_lambda(index));
+}
+
+template <typename ST, typename U>
+bool ElasticNetPath::train_machine_templated(
+    const std::shared_ptr<DenseFeatures<ST>>& data)
+{
+	typedef Matrix<ST, Dynamic, 1> VectorXt;
+
+	require(
+	    m_l1_ratio > 0 && m_l1_ratio <= 1,
+	    "The l1 ratio ({}) has to be in (0, 1]", m_l1_ratio);
+	require(
+	    m_lambdas.vlen > 0 || (m_num_lambdas > 0 && m_lambda_min_ratio > 0 &&
+	                           m_lambda_min_ratio <= 1),
+	    "Either lambdas or num_lambdas > 0 and lambda_min_ratio in (0, 1] "
+	    "have to be set");
+	for (auto i : range(m_lambdas.vlen))
+		require(
+		    m_lambdas[i] >= 0 && (i == 0 || m_lambdas[i] <= m_lambdas[i - 1]),
+		    "The regularization constants have to be non-negative and "
+		    "decreasing");
+
+	const int32_t n_fea = data->get_num_features();
+	const int32_t n_vec = data->get_num_vectors();
+	SGVector<ST> y = regression_labels(m_labels)->template get_labels_t<ST>();
+	require(
+	    y.vlen == n_vec, "Number of labels ({}) does not match number of "
+	    "vectors ({})", y.vlen, n_vec);
+
+	// the coordinates are updated feature by feature, so each column holds
+	// the data of one feature
+	SGMatrix<ST> X(n_vec, n_fea);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr = data->get_feature_matrix();
+	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, n_vec, n_fea);
+	map_X = map_Xr.transpose();
+
+	VectorXt residual = typename SGVector<ST>::EigenVectorXtMap(y.vector, n_vec);
+	VectorXt x_mean = VectorXt::Zero(n_fea);
+	ST y_mean = 0;
+	if (m_use_bias)
+	{
+		x_mean = map_X.colwise().mean().transpose();
+		map_X.rowwise() -= x_mean.transpose();
+		y_mean = residual.mean();
+		residual.array() -= y_mean;
+	}
+
+	const VectorXt norms = map_X.colwise().squaredNorm().transpose() / n_vec;
+	const ST tolerance =
+	    std::max<ST>(m_tolerance * residual.squaredNorm() / n_vec,
+	                 std::numeric_limits<ST>::min());
+
+	// correlations of the features with the residual, the optimality
+	// conditions of the zero coefficients and the strong rules depend
+	// on them only
+	VectorXt corr(n_fea);
+	auto update_corr = [&]() {
+		#pragma omp parallel for
+		for (index_t j = 0; j < n_fea; ++j)
+			corr[j] = map_X.col(j).dot(residual) / n_vec;
+	};
+	update_corr();
+
+	// all coefficients vanish from the largest correlation on
+	const ST alpha = m_l1_ratio;
+	const ST lambda_max = n_fea > 0 ? corr.cwiseAbs().maxCoeff() / alpha : 0;
+	SGVector<float64_t> lambdas = m_lambdas;
+	if (lambdas.vlen == 0)
+	{
+		lambdas = SGVector<float64_t>(m_num_lambdas);
+		for (auto k : range(m_num_lambdas))
+			lambdas[k] = lambda_max *
+			             std::pow(m_lambda_min_ratio,
+			                      m_num_lambdas > 1
+			                          ? float64_t(k) / (m_num_lambdas - 1)
+			                          : 0.0);
+	}
+
+	VectorXt beta = VectorXt::Zero(n_fea);
+	std::vector<bool> ever_active(n_fea, false);
+	std::vector<bool> in_working(n_fea);
+	std::vector<index_t> working;
+
+	m_path_w = SGMatrix<float64_t>(n_fea, lambdas.vlen);
+	m_path_bias = SGVector<float64_t>(lambdas.vlen);
+	int32_t path_size = 0;
+	ST lambda_prev = std::max<ST>(lambda_max, lambdas[0]);
+	bool converged = true;
+
+	auto pb = SG_PROGRESS(range(lambdas.vlen));
+	for (auto k : range(lambdas.vlen))
+	{
+		COMPUTATION_CONTROLLERS
+
+		const ST lambda = lambdas[k];
+		const ST l1 = alpha * lambda;
+		const ST l2 = (1 - alpha) * lambda;
+
+		// sequential strong rule: coefficients with correlations below
+		// alpha * (2 lambda - lambda_prev) at the previous estimator are
+		// most likely zero at lambda
+		const ST threshold = alpha * (2 * lambda - lambda_prev);
+		working.clear();
+		for (auto j : range(n_fea))
+		{
+			in_working[j] = !m_strong_rules || ever_active[j] ||
+			                std::abs(corr[j]) >= threshold;
+			if (in_working[j])
+				working.push_back(j);
+		}
+
+		while (true)
+		{
+			converged &= coordinate_descent<ST>(
+			    map_X, norms, working, l1, l2, tolerance, m_max_iterations,
+			    beta, residual);
+			if (!m_strong_rules)
+				break;
+
+			// the discarded coefficients are optimal at zero as long as
+			// their correlations stay within the l1 penalty
+			update_corr();
+			bool violated = false;
+			for (auto j : range(n_fea))
+			{
+				if (!in_working[j] && std::abs(corr[j]) > l1)
+				{
+					in_working[j] = true;
+					working.push_back(j);
+					violated = true;
+				}
+			}
+			if (!violated)
+				break;
+		}
+
+		int32_t nonz = 0;
+		for (auto j : range(n_fea))
+		{
+			m_path_w(j, k) = beta[j];
+			ever_active[j] = ever_active[j] || beta[j] != 0;
+			nonz += beta[j] != 0;
+		}
+		m_path_bias[k] = y_mean - beta.dot(x_mean);
+		path_size = k + 1;
+		lambda_prev = lambda;
+		pb.print_progress();
+
+		// early stopping with max number of non-zero variables
+		if (m_max_nonz > 0 && nonz >= m_max_nonz)
+			break;
+	}
+	pb.complete();
+
+	if (!converged)
+		io::warn(
+		    "Coordinate descent did not converge within {} iterations for "
+		    "all regularization constants.",
+		    m_max_iterations);
+
+	m_path_lambdas = SGVector<float64_t>(lambdas.vector, path_size, false).clone();
+	if (path_size < lambdas.vlen)
+	{
+		SGMatrix<float64_t> path_w(n_fea, path_size);
+		sg_memcpy(
+		    path_w.matrix, m_path_w.matrix,
+		    sizeof(float64_t) * n_fea * path_size);
+		m_path_w = path_w;
+		m_path_bias =
+		    SGVector<float64_t>(m_path_bias.vector, path_size, false).clone();
+	}
+
+	require(path_size > 0, "No estimator was computed");
+	switch_w(path_size - 1);
+
+	return true;
+}
+
+template bool ElasticNetPath::train_machine_templated<float32_t>(
+    const std::shared_ptr<DenseFeatures<float32_t>>& data);
+template bool ElasticNetPath::train_machine_templated<float64_t>(
+    const std::shared_ptr<DenseFeatures<float64_t>>& data);
+template bool ElasticNetPath::train_machine_templated<floatmax_t>(
+    const std::shared_ptr<DenseFeatures<floatmax_t>>& data);
@@ -0,0 +1,167 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef ELASTICNETPATH_H__
+#define ELASTICNETPATH_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/machine/FeatureDispatchCRTP.h>
+#include <shogun/machine/LinearMachine.h>
+
+namespace shogun
+{
+
+/** @brief Computes the LASSO or elastic net estimators along a decreasing
+ * path of regularization constants by cyclic coordinate descent.
+ *
+ * For every \f$\lambda\f$ of the path the estimator minimizes
+ *
+ * \f[
+ * \frac{1}{2N}\|y - X^T\beta - b\|^2 + \lambda\left(\alpha\|\beta\|_1 +
+ * \frac{1-\alpha}{2}\|\beta\|^2\right)
+ * \f]
+ *
+ * where \f$\alpha\f$ is the l1_ratio, \f$\alpha=1\f$ is the LASSO. Unless
+ * given, the path consists of num_lambdas constants spaced evenly on a log
+ * scale from the smallest \f$\lambda\f$ for which all coefficients vanish
+ * down to lambda_min_ratio times it.
+ *
+ * Every estimator starts from the previous one of the path. The sequential
+ * strong rules only update the coefficients that are likely to be non-zero,
+ * after which the optimality conditions of all others are checked in
+ * parallel and violators are added, see
+ *
+ * @code
+ * @article{tibshirani2012strong,
+ *   title={Strong rules for discarding predictors in lasso-type problems},
+ *   author={Tibshirani, R. and Bien, J. and Friedman, J. and Hastie, T. and
+ *           Simon, N. and Taylor, J. and Tibshirani, R. J.},
+ *   journal={Journal of the Royal Statistical Society: Series B},
+ *   volume={74},
+ *   number={2},
+ *   pages={245--266},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * The features are not standardized, the bias is fitted by centering. After
+ * training, the estimator of the last constant of the path is used, see
+ * switch_w to pick another one.
+ */
+class ElasticNetPath
+    : public DenseRealDispatch<ElasticNetPath, LinearMachine>
+{
+	friend class DenseRealDispatch<ElasticNetPath, LinearMachine>;
+
+public:
+	/** problem type */
+	MACHINE_PROBLEM_TYPE(PT_REGRESSION);
+
+	/** default constructor, computes the LASSO path */
+	ElasticNetPath();
+
+	/** constructor
+	 *
+	 * @param l1_ratio weight of the l1 penalty in (0, 1], 1 for the LASSO
+	 */
+	ElasticNetPath(float64_t l1_ratio);
+
+	~ElasticNetPath() override;
+
+	/** @return the regularization constants of the trained path */
+	SGVector<float64_t> get_lambdas() const
+	{
+		return m_path_lambdas;
+	}
+
+	/** @return the number of estimators on the trained path */
+	int32_t get_path_size() const
+	{
+		return m_path_lambdas.vlen;
+	}
+
+	/** get the estimator of a regularization constant of the path
+	 *
+	 * @param index index of the constant in get_lambdas()
+	 * @return the weights of the estimator
+	 */
+	SGVector<float64_t> get_w_for_lambda(int32_t index) const;
+
+	/** get the bias of a regularization constant of the path
+	 *
+	 * @param index index of the constant in get_lambdas()
+	 * @return the bias of the estimator
+	 */
+	float64_t get_bias_for_lambda(int32_t index) const;
+
+	/** switch to the estimator of a regularization constant of the path
+	 *
+	 * @param index index of the constant in get_lambdas()
+	 */
+	void switch_w(int32_t index);
+
+	/** @return object name */
+	const char* get_name() const override
+	{
+		return "ElasticNetPath";
+	}
+
+protected:
+	/**
+	 * A templated specialization of the train_machine method
+	 * @param data training data
+	 * @see train_machine
+	 */
+	template <typename ST, typename U = typename std::enable_if_t<
+	                           std::is_floating_point<ST>::value>>
+	bool train_machine_templated(const std::shared_ptr<DenseFeatures<ST>>& data);
+
+private:
+	/** Initialize and register parameters */
+	void init();
+
+	/** weight of the l1 penalty */
+	float64_t m_l1_ratio;
+
+	/** number of regularization constants of the computed path */
+	int32_t m_num_lambdas;
+
+	/** smallest over largest regularization constant of the computed path */
+	float64_t m_lambda_min_ratio;
+
+	/** decreasing regularization constants, the path is computed if empty */
+	SGVector<float64_t> m_lambdas;
+
+	/** max number of coordinate descent sweeps per constant */
+	int32_t m_max_iterations;
+
+	/** convergence tolerance relative to the variance of the labels */
+	float64_t m_tolerance;
+
+	/** max number of non-zero coefficients for early stopping */
+	int32_t m_max_nonz;
+
+	/** whether to discard coefficients by the sequential strong rules */
+	bool m_strong_rules;
+
+	/** whether or not to fit an offset term */
+	bool m_use_bias;
+
+	/** regularization constants of the trained path */
+	SGVector<float64_t> m_path_lambdas;
+
+	/** estimators of the trained path, one column per constant */
+	SGMatrix<float64_t> m_path_w;
+
+	/** biases of the trained path */
+	SGVector<float64_t> m_path_bias;
+};
+
+} // namespace shogun
+
+#endif // ELASTICNETPATH_H__
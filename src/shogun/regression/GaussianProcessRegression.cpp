@@ -86,8 +86,8 @@ bool GaussianProcessRegression::train_machine(std::shared_ptr<Features> data)
 	}
 	if (m_inducing_features)
 	{
-		auto fitc_method = m_method->as<FITCInferenceMethod>();
-		fitc_method->set_inducing_features(m_inducing_features);
+		auto sparse_method = m_method->as<SparseInference>();
+		sparse_method->set_inducing_features(m_inducing_features);
 	}
 
 	auto lik = m_method->get_model();
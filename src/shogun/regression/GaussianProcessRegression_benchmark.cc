@@ -0,0 +1,53 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/machine/Machine_benchmark.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/gp/ZeroMean.h>
+#include <shogun/regression/GaussianProcessRegression.h>
+
+namespace shogun
+{
+
+std::shared_ptr<GaussianProcessRegression>
+make_gpr(const MachineFixture& fixture)
+{
+	auto inference = std::make_shared<ExactInferenceMethod>(
+		std::make_shared<GaussianKernel>(2.0 * MachineFixture::kNumDims),
+		fixture.features_train, std::make_shared<ZeroMean>(),
+		fixture.regression_labels, std::make_shared<GaussianLikelihood>());
+	return std::make_shared<GaussianProcessRegression>(inference);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, GaussianProcessRegression_Train)
+(benchmark::State& state)
+{
+	for (auto _ : state)
+		make_gpr(*this)->train();
+	set_counters(state);
+}
+
+BENCHMARK_DEFINE_F(MachineFixture, GaussianProcessRegression_Apply)
+(benchmark::State& state)
+{
+	auto gpr = make_gpr(*this);
+	gpr->train();
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gpr->apply_regression(features_test));
+	set_counters(state);
+}
+
+// exact inference is cubic in the number of vectors
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, GaussianProcessRegression_Train), 100,
+	1000, 8);
+MACHINE_BENCHMARK_ARGS(
+	BENCHMARK_REGISTER_F(MachineFixture, GaussianProcessRegression_Apply), 100,
+	1000, 8);
+
+} // namespace shogun
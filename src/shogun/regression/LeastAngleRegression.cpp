@@ -44,10 +44,16 @@ void LeastAngleRegression::init()
 	m_max_nonz = 0;
 	m_max_l1_norm = 0;
 	m_epsilon = Math::MACHINE_EPSILON;
+	m_gram_mode = LARS_GRAM_AUTO;
 	SG_ADD(&m_epsilon, "epsilon", "Epsilon for early stopping", ParameterProperties::HYPER);
 	SG_ADD(&m_max_nonz, "max_nonz", "Max number of non-zero variables", ParameterProperties::HYPER);
 	SG_ADD(&m_max_l1_norm, "max_l1_norm", "Max l1-norm of estimator", ParameterProperties::HYPER);
 	SG_ADD(&m_lasso, "lasso", "Max l1-norm of estimator", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_gram_mode, "gram_mode",
+	    "How correlations with the equiangular direction are computed",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(LARS_GRAM_AUTO, LARS_GRAM_PRECOMPUTE, LARS_GRAM_NEVER));
 	watch_method("path_size", &LeastAngleRegression::get_path_size);
 }
 
@@ -116,6 +122,7 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 
 	// init facilities
 	m_beta_idx.clear();
+	m_beta_path.clear();
 	m_beta_path_t.clear();
 	m_num_active = 0;
 	m_active_set.clear();
@@ -125,33 +132,54 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 	SGVector<ST> y = regression_labels(m_labels)->template get_labels_t<ST>();
 	typename SGVector<ST>::EigenVectorXtMap map_y(y.vector, y.size());
 
+	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr = data->get_feature_matrix();
+
+	// with many more vectors than features, all products of features are
+	// computed once, otherwise the correlations are computed from the data
+	const bool use_gram = m_gram_mode == LARS_GRAM_PRECOMPUTE ||
+	                      (m_gram_mode == LARS_GRAM_AUTO && n_vec > n_fea);
+
 	// transpose(X) is more convenient to work with since we care
 	// about features here. After transpose, each row will be a data
 	// point while each column corresponds to a feature
-	SGMatrix<ST> X (n_vec, n_fea);
-	typename SGMatrix<ST>::EigenMatrixXtMap map_Xr = data->get_feature_matrix();
-	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, n_vec, n_fea);
-	map_X = map_Xr.transpose();
-
-	SGMatrix<ST> X_active(n_vec, n_fea);
+	SGMatrix<ST> X;
+	SGMatrix<ST> gram;
+	if (use_gram)
+	{
+		gram = SGMatrix<ST>(n_fea, n_fea);
+		typename SGMatrix<ST>::EigenMatrixXtMap map_gram(
+		    gram.matrix, n_fea, n_fea);
+		map_gram.noalias() = map_Xr * map_Xr.transpose();
+	}
+	else
+	{
+		X = SGMatrix<ST>(n_vec, n_fea);
+		typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, n_vec, n_fea);
+		map_X = map_Xr.transpose();
+	}
+	typename SGMatrix<ST>::EigenMatrixXtMap map_X(X.matrix, X.num_rows, X.num_cols);
+	typename SGMatrix<ST>::EigenMatrixXtMap map_gram(
+	    gram.matrix, gram.num_rows, gram.num_cols);
 
 	// beta is the estimator
 	SGVector<ST> beta(n_fea);
 	beta.set_const(0);
 
-	vector<ST> Xy(n_fea);
-	typename SGVector<ST>::EigenVectorXtMap map_Xy(&Xy[0], n_fea);
-	// Xy = X' * y
-	map_Xy=map_Xr*map_y;
-
-	// mu is the prediction
-	vector<ST> mu(n_vec);
-
-	// correlation
+	// correlation, corr = X' * (y-mu) starts at X' * y and is updated
+	// along with the prediction mu
 	vector<ST> corr(n_fea);
+	typename SGVector<ST>::EigenVectorXtMap map_corr(&corr[0], n_fea);
+	map_corr = map_Xr*map_y;
 	// sign of correlation
 	vector<ST> corr_sign(n_fea);
 
+	// correlation of the features with the equiangular direction
+	vector<ST> dir_corr(n_fea);
+	typename SGVector<ST>::EigenVectorXtMap map_dir_corr(&dir_corr[0], n_fea);
+	// equiangular direction (unit vector)
+	vector<ST> u(use_gram ? 0 : n_vec);
+	typename SGVector<ST>::EigenVectorXtMap map_u(u.data(), u.size());
+
 	// Cholesky factorization R'R = X'X, R is upper triangular
 	SGMatrix<ST> R;
 
@@ -164,6 +192,8 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 
 	//maximum allowed active variables at a time
 	int32_t max_active_allowed = Math::min(n_vec-1, n_fea);
+	if (m_max_nonz > 0)
+		max_active_allowed = Math::min(max_active_allowed, m_max_nonz);
 
 	//========================================
 	// main loop
@@ -175,12 +205,6 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 	{
 		COMPUTATION_CONTROLLERS
 
-		// corr = X' * (y-mu) = - X'*mu + Xy
-		typename SGVector<ST>::EigenVectorXtMap map_corr(&corr[0], n_fea);
-		typename SGVector<ST>::EigenVectorXtMap map_mu(&mu[0], n_vec);
-
-		map_corr = map_Xy - (map_Xr*map_mu);
-
 		// corr_sign = sign(corr)
 		for (size_t i=0; i < corr.size(); ++i)
 			corr_sign[i] = Math::sign(corr[i]);
@@ -190,24 +214,34 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 
 		if (!lasso_cond)
 		{
+			// products of the new feature with itself and the active ones
+			ST diag_k;
+			SGVector<ST> col_k(m_num_active);
+			if (use_gram)
+			{
+				diag_k = map_gram(i_max_corr, i_max_corr);
+				for (index_t i=0; i < m_num_active; ++i)
+					col_k[i] = map_gram(m_active_set[i], i_max_corr);
+			}
+			else
+			{
+				diag_k = map_X.col(i_max_corr).squaredNorm();
+				for (index_t i=0; i < m_num_active; ++i)
+					col_k[i] = map_X.col(m_active_set[i]).dot(map_X.col(i_max_corr));
+			}
+
 			// update Cholesky factorization matrix
 			if (m_num_active == 0)
 			{
 				// R isn't allocated yet
 				R=SGMatrix<ST>(1,1);
-				ST diag_k = map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
 				R(0, 0) = std::sqrt(diag_k);
 			}
 			else
-				R=cholesky_insert(X, X_active, R, i_max_corr, m_num_active);
+				R=cholesky_insert(R, col_k, diag_k);
 			activate_variable(i_max_corr);
 		}
 
-		// Active variables
-		typename SGMatrix<ST>::EigenMatrixXtMap map_Xa(X_active.matrix, n_vec, m_num_active);
-		if (!lasso_cond)
-			map_Xa.col(m_num_active-1)=map_X.col(i_max_corr);
-
 		SGVector<ST> corr_sign_a(m_num_active);
 		for (index_t i=0; i < m_num_active; ++i)
 			corr_sign_a[i] = corr_sign[m_active_set[i]];
@@ -224,33 +258,39 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 
 		typename SGVector<ST>::EigenVectorXt wA = AA*GA1;
 
-		// equiangular direction (unit vector)
-		vector<ST> u(n_vec);
-		typename SGVector<ST>::EigenVectorXtMap map_u(&u[0], n_vec);
+		// dir_corr = X' * u with u = X_active * wA
+		if (use_gram)
+		{
+			map_dir_corr.setZero();
+			for (index_t i=0; i < m_num_active; ++i)
+				map_dir_corr += wA(i) * map_gram.col(m_active_set[i]);
+		}
+		else
+		{
+			map_u.setZero();
+			for (index_t i=0; i < m_num_active; ++i)
+				map_u += wA(i) * map_X.col(m_active_set[i]);
 
-		map_u = map_Xa*wA;
+			#pragma omp parallel for
+			for (index_t i=0; i < n_fea; ++i)
+				dir_corr[i] = map_u.dot(map_X.col(i));
+		}
 
 		ST gamma = max_corr / AA;
 		if (m_num_active < n_fea)
 		{
-			#pragma omp parallel for shared(gamma)
+			#pragma omp parallel for reduction(min:gamma)
 			for (index_t i=0; i < n_fea; ++i)
 			{
 				if (m_is_active[i])
 					continue;
 
-				// correlation between X[:,i] and u
-				ST dir_corr = map_u.dot(map_X.col(i));
-
-				ST tmp1 = (max_corr-corr[i])/(AA-dir_corr);
-				ST tmp2 = (max_corr+corr[i])/(AA+dir_corr);
-				#pragma omp critical
-				{
+				ST tmp1 = (max_corr-corr[i])/(AA-dir_corr[i]);
+				ST tmp2 = (max_corr+corr[i])/(AA+dir_corr[i]);
 				if (tmp1 > Math::MACHINE_EPSILON && tmp1 < gamma)
 					gamma = tmp1;
 				if (tmp2 > Math::MACHINE_EPSILON && tmp2 < gamma)
 					gamma = tmp2;
-				}
 			}
 		}
 
@@ -280,8 +320,8 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 			}
 		}
 
-		// update prediction: mu = mu + gamma * u
-		map_mu += gamma*map_u;
+		// update correlation for mu = mu + gamma * u
+		map_corr -= gamma*map_dir_corr;
 
 		// update estimator
 		for (index_t i=0; i < m_num_active; ++i)
@@ -314,13 +354,6 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 			beta[i_change] = 0;
 			R=cholesky_delete(R, i_kick);
 			deactivate_variable(i_kick);
-
-			// Remove column from active set
-			int32_t numRows = map_Xa.rows();
-			int32_t numCols = map_Xa.cols()-1;
-			if( i_kick < numCols )
-				map_Xa.block(0, i_kick, numRows, numCols-i_kick) =
-					map_Xa.block(0, i_kick+1, numRows, numCols-i_kick).eval();
 		}
 
 		nloop++;
@@ -356,7 +389,7 @@ bool LeastAngleRegression::train_machine_templated(const std::shared_ptr<DenseFe
 	set_w(SGVector<float64_t>(n_fea));
 	switch_w(get_path_size()-1);
 
-	if (max_corr / n_vec > m_epsilon)
+	if (!stop_cond && max_corr / n_vec > m_epsilon)
 	{
 		io::warn(
 		    "Convergence level ({}) not below tolerance ({}) after {} "
@@ -376,11 +409,23 @@ SGMatrix<ST> LeastAngleRegression::cholesky_insert(const SGMatrix<ST>& X,
 	ST diag_k = map_X.col(i_max_corr).dot(map_X.col(i_max_corr));
 
 	// col_k is the k-th column of (X'X)
-	typename SGVector<ST>::EigenVectorXtMap map_i_max(X.get_column_vector(i_max_corr), X.num_rows);
-	typename SGVector<ST>::EigenVectorXt R_k = map_X_active.transpose()*map_i_max;
+	SGVector<ST> col_k(num_active);
+	typename SGVector<ST>::EigenVectorXtMap map_col_k(col_k.vector, num_active);
+	map_col_k = map_X_active.transpose()*map_X.col(i_max_corr);
+
+	return cholesky_insert(R, col_k, diag_k);
+}
+
+template <typename ST>
+SGMatrix<ST> LeastAngleRegression::cholesky_insert(
+    const SGMatrix<ST>& R, const SGVector<ST>& col_k, ST diag_k)
+{
+	const int32_t num_active = col_k.vlen;
 	typename SGMatrix<ST>::EigenMatrixXtMap map_R(R.matrix, R.num_rows, R.num_cols);
 
 	// R' * R_k = (X' * X)_k = col_k, solving to get R_k
+	typename SGVector<ST>::EigenVectorXt R_k =
+	    typename SGVector<ST>::EigenVectorXtMap(col_k.vector, num_active);
 	map_R.transpose().template triangularView<Lower>().template solveInPlace<OnTheLeft>(R_k);
 	ST R_kk = std::sqrt(diag_k - R_k.dot(R_k));
 
@@ -435,3 +480,6 @@ template bool LeastAngleRegression::train_machine_templated<float32_t>(const std
 template SGMatrix<float32_t> LeastAngleRegression::cholesky_insert(const SGMatrix<float32_t>& X, const SGMatrix<float32_t>& X_active, SGMatrix<float32_t>& R, int32_t i_max_corr, int32_t num_active);
 template SGMatrix<float64_t> LeastAngleRegression::cholesky_insert(const SGMatrix<float64_t>& X, const SGMatrix<float64_t>& X_active, SGMatrix<float64_t>& R, int32_t i_max_corr, int32_t num_active);
 template SGMatrix<floatmax_t> LeastAngleRegression::cholesky_insert(const SGMatrix<floatmax_t>& X, const SGMatrix<floatmax_t>& X_active, SGMatrix<floatmax_t>& R, int32_t i_max_corr, int32_t num_active);
+template SGMatrix<float32_t> LeastAngleRegression::cholesky_insert(const SGMatrix<float32_t>& R, const SGVector<float32_t>& col_k, float32_t diag_k);
+template SGMatrix<float64_t> LeastAngleRegression::cholesky_insert(const SGMatrix<float64_t>& R, const SGVector<float64_t>& col_k, float64_t diag_k);
+template SGMatrix<floatmax_t> LeastAngleRegression::cholesky_insert(const SGMatrix<floatmax_t>& R, const SGVector<floatmax_t>& col_k, floatmax_t diag_k);
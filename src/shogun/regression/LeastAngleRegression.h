@@ -20,6 +20,20 @@ namespace shogun
 
 class Features;
 
+/** how LeastAngleRegression computes the correlations of the features with
+ * the equiangular direction */
+enum ELARSGramMode
+{
+	/** precompute the Gram matrix when there are more vectors than features */
+	LARS_GRAM_AUTO = 0,
+	/** precompute the Gram matrix \f$XX^T\f$ of the features once, which
+	 * pays off for many more vectors than features */
+	LARS_GRAM_PRECOMPUTE = 1,
+	/** correlate the direction with the data of every feature in parallel,
+	 * which avoids the quadratic memory for many features */
+	LARS_GRAM_NEVER = 2
+};
+
 /** @brief Class for Least Angle Regression, can be used to solve LASSO.
  *
  * LASSO is basically L1 regulairzed least square regression
@@ -53,6 +67,11 @@ class Features;
  *
  * When no constraints is provided, the full path is generated.
  *
+ * The correlations of the features with the residual are updated along the
+ * path rather than recomputed from the data, and the correlations with the
+ * equiangular direction are either read from a precomputed Gram matrix or
+ * computed in parallel over the features, see ELARSGramMode.
+ *
  * Please see the following paper for more details.
  *
  * @code
@@ -153,6 +172,17 @@ protected:
 	SGMatrix<ST> cholesky_insert(const SGMatrix<ST>& X,
 			const SGMatrix<ST>& X_active, SGMatrix<ST>& R, int32_t i_max_corr, int32_t num_active);
 
+	/** extend the Cholesky factor of the active features by one feature
+	 *
+	 * @param R upper triangular factor of the products of the active features
+	 * @param col_k products of the new feature with the active features
+	 * @param diag_k product of the new feature with itself
+	 * @return the extended factor
+	 */
+	template <typename ST>
+	static SGMatrix<ST> cholesky_insert(
+	    const SGMatrix<ST>& R, const SGVector<ST>& col_k, ST diag_k);
+
 	template <typename ST>
 	SGMatrix<ST> cholesky_delete(SGMatrix<ST>& R, int32_t i_kick);
 
@@ -204,6 +234,9 @@ private:
 	std::vector<bool> m_is_active;
 	int32_t m_num_active;
 	float64_t m_epsilon;
+
+	/** how the correlations with the equiangular direction are computed */
+	ELARSGramMode m_gram_mode;
 }; // class LARS
 
 } // namespace shogun
@@ -30,26 +30,10 @@ extern "C" {
 
 #include <shogun/base/Parallel.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-
 #include <utility>
-#endif
 
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct S_THREAD_PARAM_SVRLIGHT
-{
-	float64_t* lin;
-	int32_t start, end;
-	int32_t* active2dnum;
-	int32_t* docs;
-	std::shared_ptr<Kernel> kernel;
-    int32_t num_vectors;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
-
 SVRLight::SVRLight(float64_t C, float64_t eps, std::shared_ptr<Kernel> k, std::shared_ptr<Labels> lab)
 : SVMLight(C, std::move(k), std::move(lab))
 {
@@ -360,18 +344,6 @@ float64_t SVRLight::compute_objective_function(
   return(criterion);
 }
 
-void* SVRLight::update_linear_component_linadd_helper(void *params_)
-{
-	S_THREAD_PARAM_SVRLIGHT * params = (S_THREAD_PARAM_SVRLIGHT*) params_ ;
-
-	int32_t jj=0, j=0 ;
-
-	for(jj=params->start;(jj<params->end) && (j=params->active2dnum[jj])>=0;jj++)
-		params->lin[j]+=params->kernel->compute_optimized(SVRLight::regression_fix_index2(params->docs[j], params->num_vectors));
-
-	return NULL ;
-}
-
 int32_t SVRLight::regression_fix_index(int32_t i)
 {
 	if (i>=num_vectors)
@@ -428,56 +400,16 @@ void SVRLight::update_linear_component(
 
 			if (num_working>0)
 			{
-			// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-				int32_t num_threads=env()->get_num_threads();
-#else
-				int32_t num_threads=1;
-#endif
-				if (num_threads < 2)
-				{
-					for(jj=0;(j=active2dnum[jj])>=0;jj++) {
-						lin[j]+=kernel->compute_optimized(regression_fix_index(docs[j]));
-					}
-				}
-#ifdef HAVE_PTHREAD
-				else
+				int32_t num_elem=0;
+				while (active2dnum[num_elem]>=0)
+					num_elem++;
+
+				#pragma omp parallel for num_threads(env()->get_num_threads())
+				for (int32_t k=0; k<num_elem; k++)
 				{
-					int32_t num_elem = 0 ;
-					for(jj=0;(j=active2dnum[jj])>=0;jj++) num_elem++ ;
-
-					pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-					S_THREAD_PARAM_SVRLIGHT* params = SG_MALLOC(S_THREAD_PARAM_SVRLIGHT, num_threads-1);
-					int32_t start = 0 ;
-					int32_t step = num_elem/num_threads ;
-					int32_t end = step ;
-
-					for (int32_t t=0; t<num_threads-1; t++)
-					{
-						params[t].kernel = kernel ;
-						params[t].lin = lin ;
-						params[t].docs = docs ;
-						params[t].active2dnum=active2dnum ;
-						params[t].start = start ;
-						params[t].end = end ;
-						params[t].num_vectors=num_vectors ;
-
-						start=end ;
-						end+=step ;
-						pthread_create(&threads[t], NULL, update_linear_component_linadd_helper, (void*)&params[t]) ;
-					}
-
-					for(jj=params[num_threads-2].end;(j=active2dnum[jj])>=0;jj++) {
-						lin[j]+=kernel->compute_optimized(regression_fix_index(docs[j]));
-					}
-					void* ret;
-					for (int32_t t=0; t<num_threads-1; t++)
-						pthread_join(threads[t], &ret) ;
-
-					SG_FREE(params);
-					SG_FREE(threads);
+					const int32_t idx=active2dnum[k];
+					lin[idx]+=kernel->compute_optimized(regression_fix_index(docs[idx]));
 				}
-#endif
 			}
 		}
 	}
@@ -697,11 +629,12 @@ void SVRLight::reactivate_inactive_examples(
 
 	  if (num_modified>0)
 	  {
-		  for(i=0;i<totdoc;i++) {
-			  if(!shrink_state->active[i]) {
-				  lin[i]=shrink_state->last_lin[i]+kernel->compute_optimized(regression_fix_index(docs[i]));
+		  #pragma omp parallel for num_threads(env()->get_num_threads())
+		  for(int32_t k=0;k<totdoc;k++) {
+			  if(!shrink_state->active[k]) {
+				  lin[k]=shrink_state->last_lin[k]+kernel->compute_optimized(regression_fix_index(docs[k]));
 			  }
-			  shrink_state->last_lin[i]=lin[i];
+			  shrink_state->last_lin[k]=lin[k];
 		  }
 	  }
   }
@@ -190,12 +190,6 @@ class SVRLight: public SVMLight
 		const char* get_name() const override { return "SVRLight"; }
 
 	protected:
-		/** thread helper for update linear component linadd
-		 *
-		 * @param params
-		 */
-		static void* update_linear_component_linadd_helper(void *params);
-
 		/** regression fix index
 		 *
 		 * @param i i
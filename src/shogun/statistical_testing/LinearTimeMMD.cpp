@@ -77,6 +77,12 @@ const std::function<float32_t(SGMatrix<float32_t>)> LinearTimeMMD::get_direct_es
 	return mmd::WithinBlockDirect();
 }
 
+const StreamingMMD::gpu_operation LinearTimeMMD::get_direct_estimation_gpu_method() const
+{
+	using namespace std::placeholders;
+	return std::bind(&mmd::WithinBlockDirect::compute_using_gpu, mmd::WithinBlockDirect(), _1, _2);
+}
+
 float64_t LinearTimeMMD::normalize_statistic(float64_t statistic) const
 {
 	const DataManager& data_mgr = get_data_mgr();
@@ -52,6 +52,7 @@ public:
 	const char* get_name() const override;
 private:
 	const operation get_direct_estimation_method() const override;
+	const gpu_operation get_direct_estimation_gpu_method() const override;
 	float64_t normalize_statistic(float64_t statistic) const override;
 	const float64_t normalize_variance(float64_t variance) const override;
 	const float64_t gaussian_variance(float64_t variance) const;
@@ -331,7 +331,7 @@ float64_t QuadraticTimeMMD::compute_statistic()
 		auto kernel=get_kernel();
 		if (kernel->get_kernel_type()==K_CUSTOM)
 			io::info("Precompute is turned off, but provided kernel is already precomputed!");
-		auto kernel_functor=internal::Kernel(kernel);
+		auto kernel_functor=BlockedKernel(kernel);
 		statistic=self->statistic_job(kernel_functor);
 	}
 
@@ -359,7 +359,7 @@ SGVector<float64_t> QuadraticTimeMMD::Self::sample_null_permutation()
 		auto kernel=owner.get_kernel();
 		if (kernel->get_kernel_type()==K_CUSTOM)
 			io::info("Precompute is turned off, but provided kernel is already precomputed!");
-		auto kernel_functor=internal::Kernel(kernel);
+		auto kernel_functor=BlockedKernel(kernel);
 		result=permutation_job(kernel_functor, prng);
 	}
 
@@ -501,12 +501,22 @@ SGVector<float64_t> QuadraticTimeMMD::Self::gamma_fit_null()
 float64_t QuadraticTimeMMD::compute_variance_h0()
 {
 	require(get_kernel(), "Kernel is not set!");
-	require(self->precompute,
-		"Computing variance estimate is not possible without precomputing the kernel matrix!");
-
 	self->init_kernel();
-	SGMatrix<float32_t> kernel_matrix=self->get_kernel_matrix();
-	return self->variance_h0_job(kernel_matrix);
+	float64_t variance_estimate=0;
+	if (self->precompute)
+	{
+		SGMatrix<float32_t> kernel_matrix=self->get_kernel_matrix();
+		variance_estimate=self->variance_h0_job(kernel_matrix);
+	}
+	else
+	{
+		auto kernel=get_kernel();
+		if (kernel->get_kernel_type()==K_CUSTOM)
+			io::info("Precompute is turned off, but provided kernel is already precomputed!");
+		auto kernel_functor=BlockedKernel(kernel);
+		variance_estimate=self->variance_h0_job(kernel_functor);
+	}
+	return variance_estimate;
 }
 
 float64_t QuadraticTimeMMD::compute_variance_h1()
@@ -525,7 +535,7 @@ float64_t QuadraticTimeMMD::compute_variance_h1()
 		auto kernel=get_kernel();
 		if (kernel->get_kernel_type()==K_CUSTOM)
 			io::info("Precompute is turned off, but provided kernel is already precomputed!");
-		auto kernel_functor=internal::Kernel(kernel);
+		auto kernel_functor=BlockedKernel(kernel);
 		variance_estimate=self->variance_h1_job(kernel_functor);
 	}
 	return variance_estimate;
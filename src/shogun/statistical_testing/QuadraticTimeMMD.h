@@ -76,12 +76,16 @@ template <typename> class SGVector;
  * backup (or, simply replace that if a new kernel is provided) and then
  * pre-computes that in the next run.
  *
- * It is possible to turn off the above feature by turning it off. However,
- * it will affect the performance of the algorithms, since they are optimzied
- * for pre-computed kernel matrices. Therefore, this should only be turned off
- * if the storage of the kernel is a major concern. Please note that only
- * the lower triangular part of the Gram matrix is stored, in order to exploit
- * the symmetry.
+ * It is possible to turn off the above feature by turning it off. Then the
+ * statistic, the variance estimates and the permutation null samples are
+ * computed from blocks of the Gram matrix that are computed on the fly, in
+ * parallel, and discarded after use, so that the memory needed only grows
+ * linearly with the number of samples. Since every computation evaluates the
+ * kernel again, this should only be turned off if the storage of the kernel
+ * is a major concern. The spectrum and gamma null approximations always need
+ * the pre-computed kernel matrix. Please note that only the lower triangular
+ * part of the pre-computed Gram matrix is stored, in order to exploit the
+ * symmetry.
  *
  * Since the methods modifies the object's state, using the methods of this
  * class from multiple threads may result in undesired/incorrect results/behavior.
@@ -232,8 +236,9 @@ public:
 
 	/**
 	 * Use this method when pre-computation of the kernel matrix is NOT desired. By default
-	 * this class always precomputes the Gram matrix. Please note that the performance will
-	 * be slow if this option is turned off.
+	 * this class always precomputes the Gram matrix. If this option is turned off, the
+	 * Gram matrix is computed block by block whenever it is needed, which takes memory
+	 * linear in the number of samples but repeats the kernel evaluations.
 	 *
 	 * @param precompute Flag to whether pre-compute the kernel matrix internally or not.
 	 * If false, the kernel matrix is NOT pre-computed, otherwise it is. Default is true.
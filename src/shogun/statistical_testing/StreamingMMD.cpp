@@ -49,7 +49,9 @@
 #include <shogun/statistical_testing/internals/mmd/WithinBlockDirect.h>
 #include <shogun/statistical_testing/internals/mmd/WithinBlockPermutation.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/Math.h>
 
+#include <cmath>
 #include <functional>
 
 using namespace shogun;
@@ -73,6 +75,9 @@ struct StreamingMMD::Self
 	std::pair<SGVector<float64_t>, SGMatrix<float64_t>> compute_statistic_and_Q(const KernelManager&);
 	SGVector<float64_t> sample_null();
 
+	void update_online(const std::shared_ptr<Features>&, const std::shared_ptr<Features>&);
+	void reset_online();
+
 	StreamingMMD& owner;
 
 	bool use_gpu;
@@ -86,6 +91,17 @@ struct StreamingMMD::Self
 	std::function<float32_t(const SGMatrix<float32_t>&)> permutation_job;
 	std::function<float32_t(const SGMatrix<float32_t>&)> variance_job;
 
+	/** running estimates of the online mode */
+	index_t online_num_blocks;
+	float64_t online_mean;
+	float64_t online_sum_sq_deviations;
+	float64_t online_sum;
+	float64_t online_p_value;
+	float64_t online_mixture_blocks;
+
+	ComputationManager::gpu_job_type statistic_gpu_job;
+	ComputationManager::gpu_job_type variance_gpu_job;
+
 	StreamingMMD::prng_type& prng;
 };
 
@@ -95,8 +111,61 @@ StreamingMMD::Self::Self(StreamingMMD& cmmd, StreamingMMD::prng_type& _prng) : o
 	variance_estimation_method(VEM_DIRECT),
 	null_approximation_method(NAM_MMD1_GAUSSIAN),
 	statistic_job(nullptr), variance_job(nullptr),
+	online_mixture_blocks(100),
 	prng(_prng)
 {
+	reset_online();
+}
+
+void StreamingMMD::Self::reset_online()
+{
+	online_num_blocks=0;
+	online_mean=0;
+	online_sum_sq_deviations=0;
+	online_sum=0;
+	online_p_value=1;
+}
+
+void StreamingMMD::Self::update_online(const std::shared_ptr<Features>& samples_p,
+	const std::shared_ptr<Features>& samples_q)
+{
+	require(samples_p && samples_q, "Samples from both the distributions have to be provided!");
+	const KernelManager& kernel_mgr=owner.get_kernel_mgr();
+	auto kernel=kernel_mgr.kernel_at(0);
+	require(kernel != nullptr, "Kernel is not set!");
+	require(kernel->get_kernel_type()!=K_CUSTOM, "Underlying kernel cannot be custom!");
+
+	auto mmd=mmd::ComputeMMD();
+	mmd.m_n_x=samples_p->get_num_vectors();
+	mmd.m_n_y=samples_q->get_num_vectors();
+	mmd.m_stype=statistic_type;
+	require(mmd.m_n_x>0 && mmd.m_n_y>0, "Blocks of samples cannot be empty!");
+
+	auto samples=samples_p->create_merged_copy(samples_q);
+	auto kernel_clone=kernel->clone()->as<Kernel>();
+	kernel_clone->init(samples, samples);
+	const float64_t statistic=mmd(kernel_clone->get_kernel_matrix<float32_t>());
+	kernel_clone->remove_lhs_and_rhs();
+
+	online_num_blocks++;
+	online_sum+=statistic;
+	auto delta=statistic-online_mean;
+	online_mean+=delta/online_num_blocks;
+	online_sum_sq_deviations+=delta*(statistic-online_mean);
+
+	// the normal mixture martingale of the standardized sum of the block
+	// statistics, with the variance estimated from the blocks so far
+	if (online_num_blocks>1 && online_sum>0)
+	{
+		const float64_t variance=online_sum_sq_deviations/(online_num_blocks-1);
+		if (variance>0)
+		{
+			const float64_t t=online_num_blocks+online_mixture_blocks;
+			const float64_t log_martingale=0.5*std::log(online_mixture_blocks/t)+
+				Math::sq(online_sum)/variance/(2*t);
+			online_p_value=std::min(online_p_value, std::exp(-log_martingale));
+		}
+	}
 }
 
 void StreamingMMD::Self::create_computation_jobs()
@@ -121,6 +190,10 @@ void StreamingMMD::Self::create_statistic_job()
 	mmd.m_stype=statistic_type;
 
 	statistic_job=mmd;
+	statistic_gpu_job=[mmd](const SGMatrix<float32_t>& km, const SGMatrix<float32_t>& device_km)
+	{
+		return mmd.compute_using_gpu(km, device_km);
+	};
 
 	using namespace std::placeholders;
 	permutation_job=std::bind(mmd::WithinBlockPermutation(Bx, By, statistic_type), _1, prng);
@@ -132,9 +205,11 @@ void StreamingMMD::Self::create_variance_job()
 	{
 		case VEM_DIRECT:
 			variance_job=owner.get_direct_estimation_method();
+			variance_gpu_job=owner.get_direct_estimation_gpu_method();
 			break;
 		case VEM_PERMUTATION:
 			variance_job=permutation_job;
+			variance_gpu_job=nullptr;
 			break;
 		default : break;
 	};
@@ -202,8 +277,8 @@ std::pair<float64_t, float64_t> StreamingMMD::Self::compute_statistic_variance()
 	{
 		ComputationManager cm;
 		create_computation_jobs();
-		cm.enqueue_job(statistic_job);
-		cm.enqueue_job(variance_job);
+		cm.enqueue_job(statistic_job, statistic_gpu_job);
+		cm.enqueue_job(variance_job, variance_gpu_job);
 
 		FeatureVector blocks;
 
@@ -281,7 +356,7 @@ std::pair<SGVector<float64_t>, SGMatrix<float64_t> > StreamingMMD::Self::compute
 	DataManager& data_mgr=owner.get_data_mgr();
 	ComputationManager cm;
 	create_computation_jobs();
-	cm.enqueue_job(statistic_job);
+	cm.enqueue_job(statistic_job, statistic_gpu_job);
 
 	data_mgr.start();
 	auto next_burst=data_mgr.next();
@@ -450,6 +525,57 @@ bool StreamingMMD::use_gpu() const
 	return self->use_gpu;
 }
 
+const StreamingMMD::gpu_operation StreamingMMD::get_direct_estimation_gpu_method() const
+{
+	return nullptr;
+}
+
+void StreamingMMD::update_online(const std::shared_ptr<Features>& samples_p,
+	const std::shared_ptr<Features>& samples_q)
+{
+	self->update_online(samples_p, samples_q);
+}
+
+void StreamingMMD::reset_online()
+{
+	self->reset_online();
+}
+
+index_t StreamingMMD::get_online_num_blocks() const
+{
+	return self->online_num_blocks;
+}
+
+float64_t StreamingMMD::get_online_statistic() const
+{
+	return self->online_mean;
+}
+
+float64_t StreamingMMD::get_online_variance() const
+{
+	if (self->online_num_blocks<2)
+		return 0;
+	return self->online_sum_sq_deviations/(self->online_num_blocks-1);
+}
+
+float64_t StreamingMMD::get_online_p_value() const
+{
+	require(self->statistic_type!=ST_BIASED_FULL,
+		"Sequential testing requires an unbiased statistic type!");
+	return self->online_p_value;
+}
+
+void StreamingMMD::set_online_mixture_blocks(float64_t num_blocks)
+{
+	require(num_blocks>0, "Variance of the mixture ({}) has to be positive!", num_blocks);
+	self->online_mixture_blocks=num_blocks;
+}
+
+float64_t StreamingMMD::get_online_mixture_blocks() const
+{
+	return self->online_mixture_blocks;
+}
+
 void StreamingMMD::cleanup()
 {
 	for (auto i=0; i<get_kernel_mgr().num_kernels(); ++i)
@@ -42,6 +42,7 @@ namespace shogun
 {
 
 /** forward declarations */
+class Features;
 class Kernel;
 class KernelSelectionStrategy;
 template <typename> class SGVector;
@@ -65,6 +66,7 @@ class StreamingMMD : public MMD
 	friend class internal::MaxCrossValidation;
 public:
 	typedef std::function<float32_t(SGMatrix<float32_t>)> operation;
+	typedef std::function<float32_t(const SGMatrix<float32_t>&, const SGMatrix<float32_t>&)> gpu_operation;
 
 	StreamingMMD();
 	~StreamingMMD() override;
@@ -91,9 +93,69 @@ public:
 	void set_null_approximation_method(ENullApproximationMethod nmethod);
 	const ENullApproximationMethod get_null_approximation_method() const;
 
+	/**
+	 * Online mode, for monitoring a stream without restarting the test.
+	 * Computes the statistic of one block of samples from p and q with
+	 * the kernel, and adds it to the running estimates and to the
+	 * evidence of the sequential test, see get_online_p_value(). The cost
+	 * of an update depends only on the size of the block.
+	 *
+	 * @param samples_p block of samples from p
+	 * @param samples_q block of samples from q
+	 */
+	void update_online(const std::shared_ptr<Features>& samples_p,
+		const std::shared_ptr<Features>& samples_q);
+
+	/** discards everything added with update_online() */
+	void reset_online();
+
+	/** @return number of blocks added with update_online() */
+	index_t get_online_num_blocks() const;
+
+	/** @return mean of the (not normalized) statistics of the blocks
+	 * added with update_online() */
+	float64_t get_online_statistic() const;
+
+	/** @return sample variance of the statistics of the blocks added with
+	 * update_online(), 0 for less than two blocks */
+	float64_t get_online_variance() const;
+
+	/**
+	 * Returns an anytime-valid p-value of the blocks added so far, i.e.
+	 * the probability of it ever falling below alpha under the null
+	 * hypothesis is at most alpha, so it can be checked after every block
+	 * without correcting for multiple testing.
+	 *
+	 * The p-value is the inverse of the running maximum of a normal
+	 * mixture martingale (Robbins) over the sum of the block statistics,
+	 * standardized with their sample variance. It is valid asymptotically
+	 * (in the block size and the number of blocks) and requires an
+	 * unbiased statistic type. Only positive sums, i.e. evidence that p
+	 * and q differ, decrease it.
+	 *
+	 * @return anytime-valid p-value, 1 for less than two blocks
+	 */
+	float64_t get_online_p_value() const;
+
+	/**
+	 * @param num_blocks variance of the mixture in units of the variance
+	 * of a block statistic, the boundary of the test is tightest around
+	 * that number of blocks (default 100)
+	 */
+	void set_online_mixture_blocks(float64_t num_blocks);
+
+	/** @return variance of the mixture of the sequential test */
+	float64_t get_online_mixture_blocks() const;
+
 	const char* get_name() const override;
 protected:
 	virtual const operation get_direct_estimation_method() const=0;
+	/**
+	 * @return variant of the direct estimation method which computes with
+	 * the kernel matrix in GPU memory, used if GPU is enabled, nullptr if
+	 * there is none
+	 */
+	virtual const gpu_operation get_direct_estimation_gpu_method() const;
 	float64_t normalize_statistic(float64_t statistic) const override =0;
 	virtual const float64_t normalize_variance(float64_t variance) const=0;
 	bool use_gpu() const;
@@ -29,6 +29,7 @@
  */
 
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/statistical_testing/internals/ComputationManager.h>
 
 #include <utility>
@@ -36,7 +37,7 @@
 using namespace shogun;
 using namespace internal;
 
-ComputationManager::ComputationManager()
+ComputationManager::ComputationManager() : gpu(false)
 {
 }
 
@@ -57,6 +58,13 @@ SGMatrix<float32_t>& ComputationManager::data(index_t i)
 void ComputationManager::enqueue_job(std::function<float32_t(SGMatrix<float32_t>)> job)
 {
 	job_array.push_back(std::move(job));
+	gpu_job_array.push_back(nullptr);
+}
+
+void ComputationManager::enqueue_job(std::function<float32_t(SGMatrix<float32_t>)> job, gpu_job_type gpu_job)
+{
+	job_array.push_back(std::move(job));
+	gpu_job_array.push_back(std::move(gpu_job));
 }
 
 void ComputationManager::compute_data_parallel_jobs()
@@ -67,10 +75,9 @@ void ComputationManager::compute_data_parallel_jobs()
 	for (size_t j=0; j<job_array.size(); ++j)
 		result_array[j].resize(data_array.size());
 
-	if (gpu)
-	{
-		// TODO current_job_results = compute_job.compute_using_gpu(data_array);
-	}
+	// without a GPU backend the jobs are computed on the CPU
+	if (gpu && env()->linalg()->get_gpu_backend())
+		compute_gpu_jobs();
 	else
 	{
 #pragma omp parallel for
@@ -102,10 +109,9 @@ void ComputationManager::compute_task_parallel_jobs()
 	for (size_t j=0; j<job_array.size(); ++j)
 		result_array[j].resize(data_array.size());
 
-	if (gpu)
-	{
-		// TODO current_job_results = compute_job.compute_using_gpu(data_array);
-	}
+	// without a GPU backend the jobs are computed on the CPU
+	if (gpu && env()->linalg()->get_gpu_backend())
+		compute_gpu_jobs();
 	else
 	{
 		// TODO figure out other ways to deal with the parallelization in presence of
@@ -121,9 +127,29 @@ void ComputationManager::compute_task_parallel_jobs()
 	}
 }
 
+void ComputationManager::compute_gpu_jobs()
+{
+	// the blocks are processed one after another, each of them is transferred
+	// once and all the jobs are computed with it before the next one is
+	// transferred, jobs without a GPU variant use the block in host memory
+	for (size_t i=0; i<data_array.size(); ++i)
+	{
+		SGMatrix<float32_t> device_data;
+		linalg::to_gpu(data_array[i], device_data);
+		for (size_t j=0; j<job_array.size(); ++j)
+		{
+			if (gpu_job_array[j])
+				result_array[j][i]=gpu_job_array[j](data_array[i], device_data);
+			else
+				result_array[j][i]=job_array[j](data_array[i]);
+		}
+	}
+}
+
 void ComputationManager::done()
 {
 	job_array.resize(0);
+	gpu_job_array.resize(0);
 	result_array.resize(0);
 }
 
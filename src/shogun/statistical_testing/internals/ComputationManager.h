@@ -52,7 +52,17 @@ public:
 	void num_data(index_t n);
 	SGMatrix<float32_t>& data(index_t i);
 
+	typedef std::function<float32_t(const SGMatrix<float32_t>&)> job_type;
+	typedef std::function<float32_t(const SGMatrix<float32_t>&, const SGMatrix<float32_t>&)> gpu_job_type;
+
 	void enqueue_job(std::function<float32_t(SGMatrix<float32_t>)> job);
+	/**
+	 * Enqueues a job along with a variant of it which computes on the GPU.
+	 * The variant is called with the data block in host memory and the same
+	 * block in GPU memory, which is shared by all the jobs, so that every
+	 * block is transferred only once.
+	 */
+	void enqueue_job(std::function<float32_t(SGMatrix<float32_t>)> job, gpu_job_type gpu_job);
 	void compute_data_parallel_jobs();
 	void compute_task_parallel_jobs();
 	void done();
@@ -61,9 +71,12 @@ public:
 	ComputationManager& use_cpu();
 	ComputationManager& use_gpu();
 private:
+	void compute_gpu_jobs();
+
 	bool gpu;
 	std::vector<SGMatrix<float32_t> > data_array;
-	std::vector<std::function<float32_t(const SGMatrix<float32_t>&)> > job_array;
+	std::vector<job_type> job_array;
+	std::vector<gpu_job_type> gpu_job_array;
 	std::vector<std::vector<float32_t> > result_array;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
@@ -31,6 +31,10 @@
 #include <shogun/lib/common.h>
 #include <shogun/kernel/Kernel.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #ifndef KERNEL_FUNCTOR_H__
 #define KERNEL_FUNCTOR_H__
 
@@ -100,6 +104,53 @@ private:
 	SGVector<float32_t> m_self_adjoint_kernel_matrix;
 	index_t m_num_feat_vec;
 };
+
+/**
+ * Kernel whose matrix is computed on the fly in blocks, see
+ * shogun::Kernel::get_kernel_block(), so that computations over the whole
+ * kernel matrix can be done block by block without ever storing it. For
+ * kernels that support it, e.g. GaussianKernel on DenseFeatures, a block is
+ * computed with a single matrix-matrix product of the feature vectors.
+ */
+class BlockedKernel
+{
+public:
+	explicit BlockedKernel(std::shared_ptr<shogun::Kernel> kernel, index_t block_size=DEFAULT_BLOCK_SIZE)
+	: m_kernel(kernel), m_block_size(block_size)
+	{
+		require(m_kernel, "Kernel instance cannot be NULL!");
+		require(m_block_size>0, "Block size ({}) has to be > 0!", m_block_size);
+	}
+	inline float32_t operator()(int32_t i, int32_t j) const
+	{
+		return m_kernel->kernel(i, j);
+	}
+	/** @return block of rows [row_begin, row_end) and columns [col_begin, col_end) */
+	SGMatrix<float64_t> block(index_t row_begin, index_t row_end, index_t col_begin, index_t col_end) const
+	{
+		SGVector<index_t> rows(row_end-row_begin);
+		SGVector<index_t> cols(col_end-col_begin);
+		rows.range_fill(row_begin);
+		cols.range_fill(col_begin);
+		return m_kernel->get_kernel_block(rows, cols);
+	}
+	/** @return [begin, end) split into consecutive ranges of at most the block size */
+	std::vector<std::pair<index_t, index_t>> ranges(index_t begin, index_t end) const
+	{
+		std::vector<std::pair<index_t, index_t>> result;
+		for (auto first=begin; first<end; first+=m_block_size)
+			result.emplace_back(first, std::min(first+m_block_size, end));
+		return result;
+	}
+	index_t num_vectors() const
+	{
+		return m_kernel->get_num_vec_lhs();
+	}
+	static constexpr index_t DEFAULT_BLOCK_SIZE=256;
+private:
+	std::shared_ptr<shogun::Kernel> m_kernel;
+	index_t m_block_size;
+};
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
 
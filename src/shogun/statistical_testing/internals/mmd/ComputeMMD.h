@@ -37,11 +37,14 @@
 #include <shogun/lib/config.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/statistical_testing/MMD.h>
 #include <shogun/statistical_testing/TestEnums.h>
+#include <shogun/statistical_testing/internals/Kernel.h>
 #include <shogun/statistical_testing/internals/KernelManager.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/io/SGIO.h>
 
 namespace shogun
@@ -120,30 +123,156 @@ struct ComputeMMD
 		return compute(terms);
 	}
 
-	SGVector<float64_t> operator()(const KernelManager& kernel_mgr) const
+	/**
+	 * Computes the statistic with the kernel matrix in GPU memory. The sums
+	 * of the within and cross terms are obtained from the products of the
+	 * matrix with the indicator vectors of the samples from p and q, only
+	 * the diagonals are read from the copy of the matrix in host memory.
+	 *
+	 * @param kernel_matrix the kernel matrix in host memory
+	 * @param device_kernel_matrix the same matrix in GPU memory
+	 */
+	float32_t compute_using_gpu(const SGMatrix<float32_t>& kernel_matrix,
+		const SGMatrix<float32_t>& device_kernel_matrix) const
 	{
 		ASSERT(m_n_x>0 && m_n_y>0);
-		std::vector<terms_t> terms(kernel_mgr.num_kernels());
 		const index_t size=m_n_x+m_n_y;
-		for (auto j=0; j<size; ++j)
+		require(
+			kernel_matrix.num_rows == size && kernel_matrix.num_cols == size,
+			"Size of kernel matrix ({}x{}) did not match the total "
+			"number of samples from both distribution ({})",
+			kernel_matrix.num_rows, kernel_matrix.num_cols, size);
+
+		SGVector<float32_t> ones_x(size);
+		SGVector<float32_t> ones_y(size);
+		std::fill(ones_x.data(), ones_x.data()+m_n_x, 1);
+		std::fill(ones_x.data()+m_n_x, ones_x.data()+size, 0);
+		std::fill(ones_y.data(), ones_y.data()+m_n_x, 0);
+		std::fill(ones_y.data()+m_n_x, ones_y.data()+size, 1);
+		if (device_kernel_matrix.on_gpu())
 		{
-			for (auto i=j; i<size; ++i)
+			linalg::to_gpu(ones_x);
+			linalg::to_gpu(ones_y);
+		}
+
+		auto k_x=linalg::matrix_prod(device_kernel_matrix, ones_x);
+		auto k_y=linalg::matrix_prod(device_kernel_matrix, ones_y);
+
+		terms_t terms;
+		for (index_t i=0; i<m_n_x; ++i)
+			terms.diag[0]+=kernel_matrix(i, i);
+		for (index_t i=m_n_x; i<size; ++i)
+			terms.diag[1]+=kernel_matrix(i, i);
+		for (index_t i=0; i<std::min(m_n_x, m_n_y); ++i)
+			terms.diag[2]+=kernel_matrix(m_n_x+i, i);
+
+		terms.term[0]=(linalg::dot(ones_x, k_x)-terms.diag[0])/2+terms.diag[0];
+		terms.term[1]=(linalg::dot(ones_y, k_y)-terms.diag[1])/2+terms.diag[1];
+		terms.term[2]=linalg::dot(ones_y, k_x);
+
+		return compute(terms);
+	}
+
+	/**
+	 * Computes the statistic from blocks of the kernel matrix that are
+	 * computed on the fly, in parallel over the rows of blocks. The blocks
+	 * do not cross the boundary between the samples from p and q, so every
+	 * block contributes to one of the terms only.
+	 *
+	 * @param kernel the kernel whose matrix is computed block by block
+	 */
+	float32_t operator()(const BlockedKernel& kernel) const
+	{
+		ASSERT(m_n_x>0 && m_n_y>0);
+		const index_t size=m_n_x+m_n_y;
+		auto ranges=kernel.ranges(0, m_n_x);
+		auto ranges_y=kernel.ranges(m_n_x, size);
+		ranges.insert(ranges.end(), ranges_y.begin(), ranges_y.end());
+		const index_t num_ranges=ranges.size();
+
+		// terms of every row of blocks, added up in order for reproducibility
+		std::vector<terms_t> row_terms(num_ranges);
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (index_t r=0; r<num_ranges; ++r)
+		{
+			const auto& rows=ranges[r];
+			auto& terms=row_terms[r];
+			for (auto c=r; c<num_ranges; ++c)
 			{
-				for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
+				const auto& cols=ranges[c];
+				auto block=kernel.block(rows.first, rows.second, cols.first, cols.second);
+				index_t term=2;
+				if (cols.second<=m_n_x)
+					term=0;
+				else if (rows.first>=m_n_x)
+					term=1;
+
+				float64_t sum=0;
+				float64_t diag=0;
+				for (index_t j=0; j<block.num_cols; ++j)
 				{
-					auto kernel=kernel_mgr.kernel_at(k)->kernel(i, j);
-					add_term_lower(terms[k], kernel, i, j);
+					const auto col=cols.first+j;
+					for (index_t i=0; i<block.num_rows; ++i)
+					{
+						const auto row=rows.first+i;
+						if (term==2)
+						{
+							sum+=block(i, j);
+							if (col-m_n_x==row)
+								diag+=block(i, j);
+						}
+						else if (row<=col)
+						{
+							sum+=block(i, j);
+							if (row==col)
+								diag+=block(i, j);
+						}
+					}
 				}
+				terms.term[term]+=sum;
+				terms.diag[term]+=diag;
 			}
 		}
 
-		SGVector<float64_t> result(kernel_mgr.num_kernels());
-		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
+		terms_t terms;
+		for (const auto& partial : row_terms)
 		{
-			result[k]=compute(terms[k]);
-			SG_DEBUG("result[{}] = {}!", k, result[k]);
+			for (auto k=0; k<3; ++k)
+			{
+				terms.term[k]+=partial.term[k];
+				terms.diag[k]+=partial.diag[k];
+			}
+		}
+		return compute(terms);
+	}
+
+	/**
+	 * Computes the statistic for every kernel, in parallel over the kernels,
+	 * which usually share a precomputed distance.
+	 *
+	 * @param kernel_mgr the kernels
+	 */
+	SGVector<float64_t> operator()(const KernelManager& kernel_mgr) const
+	{
+		ASSERT(m_n_x>0 && m_n_y>0);
+		const index_t num_kernels=kernel_mgr.num_kernels();
+		const index_t size=m_n_x+m_n_y;
+		SGVector<float64_t> result(num_kernels);
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (index_t k=0; k<num_kernels; ++k)
+		{
+			auto kernel=kernel_mgr.kernel_at(k);
+			terms_t terms;
+			for (auto j=0; j<size; ++j)
+			{
+				for (auto i=j; i<size; ++i)
+					add_term_lower(terms, kernel->kernel(i, j), i, j);
+			}
+			result[k]=compute(terms);
 		}
-		terms.resize(0);
+
+		for (auto k=0; k<num_kernels; ++k)
+			SG_DEBUG("result[{}] = {}!", k, result[k]);
 		return result;
 	}
 
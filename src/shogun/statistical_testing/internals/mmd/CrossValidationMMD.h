@@ -91,7 +91,8 @@ struct CrossValidationMMD : PermutationMMD
 		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
 		{
 			auto kernel=kernel_mgr.kernel_at(k);
-			for (auto i=0; i<size; ++i)
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+			for (index_t i=0; i<size; ++i)
 			{
 				for (auto j=i; j<size; ++j)
 				{
@@ -34,6 +34,8 @@
 
 #include <algorithm>
 #include <numeric>
+#include <vector>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/Math.h>
@@ -51,6 +53,12 @@ namespace mmd
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 struct PermutationMMD : ComputeMMD
 {
+	/** number of permutations that are processed at once */
+	static constexpr index_t kBatchSize=64;
+
+	/** number of rows and columns of the tiles of the kernel matrix */
+	static constexpr index_t kTileSize=256;
+
 	PermutationMMD() : m_save_inds(false)
 	{
 	}
@@ -62,28 +70,8 @@ struct PermutationMMD : ComputeMMD
 		ASSERT(m_num_null_samples>0);
 		precompute_permutation_inds(prng);
 
-		const index_t size=m_n_x+m_n_y;
 		SGVector<float32_t> null_samples(m_num_null_samples);
-#pragma omp parallel for
-		for (auto n=0; n<m_num_null_samples; ++n)
-		{
-			terms_t terms;
-			for (auto j=0; j<size; ++j)
-			{
-				auto inverted_col=m_inverted_permuted_inds(j, n);
-				for (auto i=j; i<size; ++i)
-				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-
-					if (inverted_row>=inverted_col)
-						add_term_lower(terms, kernel(i, j), inverted_row, inverted_col);
-					else
-						add_term_lower(terms, kernel(i, j), inverted_col, inverted_row);
-				}
-			}
-			null_samples[n]=compute(terms);
-			SG_DEBUG("null_samples[{}] = {}!", n, null_samples[n]);
-		}
+		compute_null_samples(kernel, null_samples.vector);
 		return null_samples;
 	}
 
@@ -96,41 +84,11 @@ struct PermutationMMD : ComputeMMD
 
 		const index_t size=m_n_x+m_n_y;
 		SGMatrix<float32_t> null_samples(m_num_null_samples, kernel_mgr.num_kernels());
-		SGVector<float32_t> km(size*(size+1)/2);
+		SGVector<float32_t> km(int64_t(size)*(size+1)/2);
 		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
 		{
-			auto kernel=kernel_mgr.kernel_at(k);
-			terms_t terms;
-			for (auto i=0; i<size; ++i)
-			{
-				for (auto j=i; j<size; ++j)
-				{
-					auto index=i*size-i*(i+1)/2+j;
-					km[index]=kernel->kernel(i, j);
-				}
-			}
-
-#pragma omp parallel for
-			for (auto n=0; n<m_num_null_samples; ++n)
-			{
-				terms_t null_terms;
-				for (auto i=0; i<size; ++i)
-				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-					auto index_base=i*size-i*(i+1)/2;
-					for (auto j=i; j<size; ++j)
-					{
-						auto index=index_base+j;
-						auto inverted_col=m_inverted_permuted_inds(j, n);
-
-						if (inverted_row<=inverted_col)
-							add_term_upper(null_terms, km[index], inverted_row, inverted_col);
-						else
-							add_term_upper(null_terms, km[index], inverted_col, inverted_row);
-					}
-				}
-				null_samples(n, k)=compute(null_terms);
-			}
+			precompute_upper_kernel_matrix(*kernel_mgr.kernel_at(k), km);
+			compute_null_samples(packed_kernel(km, size), null_samples.get_column_vector(k));
 		}
 		return null_samples;
 	}
@@ -154,49 +112,164 @@ struct PermutationMMD : ComputeMMD
 		SGVector<float32_t> null_samples(m_num_null_samples);
 		SGVector<float64_t> result(kernel_mgr.num_kernels());
 
-		SGVector<float32_t> km(size*(size+1)/2);
+		SGVector<float32_t> km(int64_t(size)*(size+1)/2);
 		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
 		{
-			auto kernel=kernel_mgr.kernel_at(k);
-			terms_t terms;
-			for (auto i=0; i<size; ++i)
+			precompute_upper_kernel_matrix(*kernel_mgr.kernel_at(k), km);
+			auto kernel=packed_kernel(km, size);
+			float32_t statistic=ComputeMMD::operator()(kernel);
+			SG_DEBUG("Kernel({}): statistic={}", k, statistic);
+
+			compute_null_samples(kernel, null_samples.vector);
+			result[k]=compute_p_value(null_samples, statistic);
+			SG_DEBUG("Kernel({}): p_value={}", k, result[k]);
+		}
+
+		return result;
+	}
+
+	/**
+	 * Computes the statistic for all precomputed permutations, a batch of
+	 * permutations at a time.
+	 *
+	 * The sums of the kernel values only depend on which samples are
+	 * permuted into p. With Z the indicators of these samples for every
+	 * permutation of a batch, the sums of all permutations are obtained
+	 * from the product K*Z, which is computed with vectorized matrix
+	 * products of cache sized tiles of K, in parallel over the rows. With a
+	 * BlockedKernel, the tiles are computed on the fly and K is never
+	 * stored.
+	 *
+	 * @param kernel kernel function, K(i, j)=kernel(i, j)
+	 * @param null_samples the m_num_null_samples results
+	 */
+	template <class Kernel>
+	void compute_null_samples(const Kernel& kernel, float32_t* null_samples) const
+	{
+		const index_t size=m_n_x+m_n_y;
+		const index_t num_tiles=(size+kTileSize-1)/kTileSize;
+		const auto num_threads=env()->get_num_threads();
+
+		SGVector<float64_t> diag(size);
+		for (auto i=0; i<size; ++i)
+			diag[i]=kernel(i, i);
+
+		// the last column of ones gives the row sums of K
+		Eigen::MatrixXd Z(size, kBatchSize+1);
+		Eigen::MatrixXd KZ(size, kBatchSize+1);
+		Z.col(kBatchSize).setOnes();
+
+		for (index_t first=0; first<m_num_null_samples; first+=kBatchSize)
+		{
+			const index_t batch_size=std::min(kBatchSize, m_num_null_samples-first);
+
+#pragma omp parallel for num_threads(num_threads)
+			for (index_t b=0; b<kBatchSize; ++b)
 			{
-				for (auto j=i; j<size; ++j)
+				for (index_t i=0; i<size; ++i)
 				{
-					auto index=i*size-i*(i+1)/2+j;
-					km[index]=kernel->kernel(i, j);
-					add_term_upper(terms, km[index], i, j);
+					Z(i, b)=b<batch_size &&
+						m_inverted_permuted_inds(i, first+b)<m_n_x;
 				}
 			}
-			float32_t statistic=compute(terms);
-			SG_DEBUG("Kernel({}): statistic={}", k, statistic);
 
-#pragma omp parallel for
-			for (auto n=0; n<m_num_null_samples; ++n)
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+			for (index_t t=0; t<num_tiles; ++t)
 			{
-				terms_t null_terms;
-				for (auto i=0; i<size; ++i)
+				const index_t row_begin=t*kTileSize;
+				const index_t num_rows=std::min(kTileSize, size-row_begin);
+				Eigen::MatrixXd tile(num_rows, kTileSize);
+				auto KZ_rows=KZ.middleRows(row_begin, num_rows);
+				KZ_rows.setZero();
+				for (index_t col_begin=0; col_begin<size; col_begin+=kTileSize)
 				{
-					auto inverted_row=m_inverted_permuted_inds(i, n);
-					auto index_base=i*size-i*(i+1)/2;
-					for (auto j=i; j<size; ++j)
-					{
-						auto index=index_base+j;
-						auto inverted_col=m_inverted_permuted_inds(j, n);
+					const index_t num_cols=std::min(kTileSize, size-col_begin);
+					fill_tile(kernel, row_begin, col_begin, num_cols, tile);
+					KZ_rows.noalias()+=tile.leftCols(num_cols)*
+						Z.middleRows(col_begin, num_cols);
+				}
+			}
 
-						if (inverted_row<=inverted_col)
-							add_term_upper(null_terms, km[index], inverted_row, inverted_col);
-						else
-							add_term_upper(null_terms, km[index], inverted_col, inverted_row);
+#pragma omp parallel for num_threads(num_threads)
+			for (index_t b=0; b<batch_size; ++b)
+			{
+				terms_t terms;
+				float64_t sum_xx=0, sum_yy=0;
+				for (index_t i=0; i<size; ++i)
+				{
+					if (Z(i, b)!=0)
+					{
+						sum_xx+=KZ(i, b);
+						terms.diag[0]+=diag[i];
+					}
+					else
+					{
+						terms.term[2]+=KZ(i, b);
+						sum_yy+=KZ(i, kBatchSize)-KZ(i, b);
+						terms.diag[1]+=diag[i];
 					}
 				}
-				null_samples[n]=compute(null_terms);
+				// sums of the upper triangles, diagonal included
+				terms.term[0]=(sum_xx-terms.diag[0])/2+terms.diag[0];
+				terms.term[1]=(sum_yy-terms.diag[1])/2+terms.diag[1];
+
+				if (m_stype==ST_UNBIASED_INCOMPLETE)
+				{
+					std::vector<index_t> permuted_inds(size);
+					for (index_t i=0; i<size; ++i)
+						permuted_inds[m_inverted_permuted_inds(i, first+b)]=i;
+					for (index_t i=0; i<m_n_x && i+m_n_x<size; ++i)
+						terms.diag[2]+=kernel(permuted_inds[i], permuted_inds[i+m_n_x]);
+				}
+
+				null_samples[first+b]=compute(terms);
+				SG_DEBUG("null_samples[{}] = {}!", first+b, null_samples[first+b]);
 			}
-			result[k]=compute_p_value(null_samples, statistic);
-			SG_DEBUG("Kernel({}): p_value={}", k, result[k]);
 		}
+	}
 
-		return result;
+	/** fills the first num_cols columns of the tile with the kernel values
+	 * of its rows from row_begin and columns from col_begin */
+	template <class Kernel>
+	static void fill_tile(const Kernel& kernel, index_t row_begin, index_t col_begin,
+		index_t num_cols, Eigen::MatrixXd& tile)
+	{
+		for (index_t j=0; j<num_cols; ++j)
+		{
+			for (index_t i=0; i<tile.rows(); ++i)
+				tile(i, j)=kernel(row_begin+i, col_begin+j);
+		}
+	}
+
+	static void fill_tile(const BlockedKernel& kernel, index_t row_begin, index_t col_begin,
+		index_t num_cols, Eigen::MatrixXd& tile)
+	{
+		auto block=kernel.block(row_begin, row_begin+tile.rows(), col_begin, col_begin+num_cols);
+		tile.leftCols(num_cols)=Eigen::Map<Eigen::MatrixXd>(block.matrix, block.num_rows, block.num_cols);
+	}
+
+	/** @return kernel function of an upper triangular kernel matrix that
+	 * is packed row by row */
+	static auto packed_kernel(const SGVector<float32_t>& km, index_t size)
+	{
+		return [&km, size](index_t i, index_t j) {
+			if (i>j)
+				std::swap(i, j);
+			return km[int64_t(i)*size-int64_t(i)*(i+1)/2+j];
+		};
+	}
+
+	/** packs the upper triangle of the kernel matrix row by row */
+	inline void precompute_upper_kernel_matrix(shogun::Kernel& kernel, SGVector<float32_t>& km) const
+	{
+		const index_t size=m_n_x+m_n_y;
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (auto i=0; i<size; ++i)
+		{
+			auto index_base=int64_t(i)*size-int64_t(i)*(i+1)/2;
+			for (auto j=i; j<size; ++j)
+				km[index_base+j]=kernel.kernel(i, j);
+		}
 	}
 
 	template <class PRNG>
@@ -32,10 +32,14 @@
 #ifndef VARIANCE_H0__H_
 #define VARIANCE_H0__H_
 
+#include <algorithm>
+#include <vector>
 #include <shogun/lib/common.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/statistical_testing/internals/Kernel.h>
 
 namespace shogun
 {
@@ -71,6 +75,69 @@ struct VarianceH0
 		auto variance_estimate=2*(term_1+term_2-2*term_3);
 		return variance_estimate;
 	}
+
+	/**
+	 * Computes the estimate from blocks of the kernel matrix that are
+	 * computed on the fly, in parallel over the columns of blocks.
+	 *
+	 * @param kernel the kernel whose matrix is computed block by block
+	 */
+	float64_t operator()(const BlockedKernel& kernel)
+	{
+		const index_t B=kernel.num_vectors();
+		auto ranges=kernel.ranges(0, B);
+		const index_t num_ranges=ranges.size();
+
+		// off-diagonal sums per column and per column of blocks
+		SGVector<float64_t> col_sums(B);
+		std::vector<float64_t> sums(num_ranges);
+		std::vector<float64_t> sq_sums(num_ranges);
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (index_t c=0; c<num_ranges; ++c)
+		{
+			const auto& cols=ranges[c];
+			float64_t sum=0;
+			float64_t sq_sum=0;
+			std::fill(col_sums.vector+cols.first, col_sums.vector+cols.second, 0);
+			for (const auto& rows : ranges)
+			{
+				auto block=kernel.block(rows.first, rows.second, cols.first, cols.second);
+				for (index_t j=0; j<block.num_cols; ++j)
+				{
+					float64_t col_sum=0;
+					for (index_t i=0; i<block.num_rows; ++i)
+					{
+						if (rows.first+i==cols.first+j)
+							continue;
+						col_sum+=block(i, j);
+						sq_sum+=block(i, j)*block(i, j);
+					}
+					col_sums[cols.first+j]+=col_sum;
+					sum+=col_sum;
+				}
+			}
+			sums[c]=sum;
+			sq_sums[c]=sq_sum;
+		}
+
+		float64_t sum=0;
+		float64_t sq_sum=0;
+		for (auto c=0; c<num_ranges; ++c)
+		{
+			sum+=sums[c];
+			sq_sum+=sq_sums[c];
+		}
+		float64_t sq_col_sums=0;
+		for (auto i=0; i<B; ++i)
+			sq_col_sums+=Math::sq(col_sums[i]/(B-1));
+
+		auto term_1=Math::sq(sum/B/(B-1));
+		auto term_2=sq_sum/B/(B-1);
+		auto term_3=sq_col_sums/B;
+
+		auto variance_estimate=2*(term_1+term_2-2*term_3);
+		return variance_estimate;
+	}
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
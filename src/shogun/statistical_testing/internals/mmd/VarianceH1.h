@@ -32,7 +32,9 @@
 #ifndef VARIANCE_H1__H_
 #define VARIANCE_H1__H_
 
+#include <array>
 #include <vector>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/common.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/SGVector.h>
@@ -130,6 +132,11 @@ struct VarianceH1
 	}
 
 	float64_t compute_variance_estimate()
+	{
+		return compute_variance_estimate(m_second_order_terms.array().square().sum());
+	}
+
+	float64_t compute_variance_estimate(float64_t sum_sq_second_order_terms)
 	{
 		Eigen::Map<Eigen::VectorXd> map_sum_colwise_x(m_sum_colwise_x.data(), m_sum_colwise_x.size());
 		Eigen::Map<Eigen::VectorXd> map_sum_colwise_y(m_sum_colwise_y.data(), m_sum_colwise_y.size());
@@ -155,7 +162,7 @@ struct VarianceH1
 		auto var_first=(t_0-t_1)-t_2+t_3+(t_4-t_5)-t_6+t_7+(t_8-t_9+t_10);
 		var_first*=4.0*(m_n_x-2)/m_n_x/(m_n_x-1);
 
-		auto var_second=2.0/m_n_x/m_n_y/(m_n_x-1)/(m_n_y-1)*m_second_order_terms.array().square().sum();
+		auto var_second=2.0/m_n_x/m_n_y/(m_n_x-1)/(m_n_y-1)*sum_sq_second_order_terms;
 
 		auto variance_estimate=var_first+var_second;
 		if (variance_estimate<0)
@@ -181,31 +188,100 @@ struct VarianceH1
 		return variance_estimate;
 	}
 
-	SGVector<float64_t> operator()(const KernelManager& kernel_mgr)
+	/**
+	 * Computes the estimate from blocks of the kernel matrix that are
+	 * computed on the fly, in parallel over the columns of blocks, without
+	 * storing the kernel matrix or the second order terms.
+	 *
+	 * For the blocks I and J of the samples from p (and q), the blocks
+	 * K_xx(I, J), K_yy(I, J), K_xy(I, J) and K_xy(J, I)' are computed, so
+	 * that all column sums of the terms of J are owned by one thread.
+	 *
+	 * @param kernel the kernel whose matrix is computed block by block
+	 */
+	float64_t operator()(const BlockedKernel& kernel)
 	{
 		ASSERT(m_n_x>0 && m_n_y>0);
 		ASSERT(m_n_x==m_n_y);
-		ASSERT(kernel_mgr.num_kernels()>0);
-
-		const index_t size=m_n_x+m_n_y;
-		SGVector<float64_t> result(kernel_mgr.num_kernels());
-		SelfAdjointPrecomputedKernel kernel_functor(SGVector<float32_t>(size*(size+1)/2));
-		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
+		const index_t n=m_n_x;
+		auto ranges=kernel.ranges(0, n);
+		const index_t num_ranges=ranges.size();
+
+		m_sum_colwise_x.assign(n, 0);
+		m_sum_colwise_y.assign(n, 0);
+		m_sum_rowwise_xy.assign(n, 0);
+		m_sum_colwise_xy.assign(n, 0);
+
+		// sum_x, sum_y, sum_xy, sum_sq_x, sum_sq_y, sum_sq_xy and the sum of
+		// the squared second order terms of every column of blocks
+		std::vector<std::array<float64_t, 7>> partial_sums(num_ranges);
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (index_t c=0; c<num_ranges; ++c)
 		{
-			auto kernel=kernel_mgr.kernel_at(k);
-			ASSERT(kernel);
-			kernel_functor.precompute(kernel);
-			init_terms();
-			for (auto i=0; i<size; ++i)
+			const auto& cols=ranges[c];
+			std::array<float64_t, 7> sums{};
+			for (const auto& rows : ranges)
 			{
-				for (auto j=i+1; j<size; ++j)
-					add_terms(kernel_functor(i, j), i, j);
+				auto k_xx=kernel.block(rows.first, rows.second, cols.first, cols.second);
+				auto k_yy=kernel.block(n+rows.first, n+rows.second, n+cols.first, n+cols.second);
+				auto k_xy=kernel.block(rows.first, rows.second, n+cols.first, n+cols.second);
+				auto k_yx=kernel.block(n+rows.first, n+rows.second, cols.first, cols.second);
+				for (index_t j=0; j<k_xx.num_cols; ++j)
+				{
+					const auto col=cols.first+j;
+					for (index_t i=0; i<k_xx.num_rows; ++i)
+					{
+						const auto xy=k_xy(i, j);
+						sums[2]+=xy;
+						sums[5]+=xy*xy;
+						m_sum_colwise_xy[col]+=xy;
+						m_sum_rowwise_xy[col]+=k_yx(i, j);
+						if (rows.first+i==col)
+							continue;
+
+						const auto xx=k_xx(i, j);
+						const auto yy=k_yy(i, j);
+						sums[0]+=xx;
+						sums[1]+=yy;
+						sums[3]+=xx*xx;
+						sums[4]+=yy*yy;
+						m_sum_colwise_x[col]+=xx;
+						m_sum_colwise_y[col]+=yy;
+						sums[6]+=Math::sq(xx+yy-xy-k_yx(i, j));
+					}
+				}
 			}
-			result[k]=compute_variance_estimate();
+			partial_sums[c]=sums;
 		}
 
+		std::array<float64_t, 7> sums{};
+		for (const auto& partial : partial_sums)
+		{
+			for (auto k=0; k<7; ++k)
+				sums[k]+=partial[k];
+		}
+		m_sum_x=sums[0];
+		m_sum_y=sums[1];
+		m_sum_xy=sums[2];
+		m_sum_sq_x=sums[3];
+		m_sum_sq_y=sums[4];
+		m_sum_sq_xy=sums[5];
+
+		auto variance_estimate=compute_variance_estimate(sums[6]);
 		free_terms();
-		return result;
+		return variance_estimate;
+	}
+
+	SGVector<float64_t> operator()(const KernelManager& kernel_mgr)
+	{
+		ASSERT(m_n_x>0 && m_n_y>0);
+		ASSERT(m_n_x==m_n_y);
+		ASSERT(kernel_mgr.num_kernels()>0);
+
+		return compute_per_kernel(kernel_mgr, [](VarianceH1& job, const SelfAdjointPrecomputedKernel&)
+		{
+			return job.compute_variance_estimate();
+		});
 	}
 
 	SGVector<float64_t> test_power(const KernelManager& kernel_mgr)
@@ -218,26 +294,51 @@ struct VarianceH1
 		compute_mmd_job.m_n_y=m_n_y;
 		compute_mmd_job.m_stype=ST_UNBIASED_FULL;
 
+		return compute_per_kernel(kernel_mgr, [&compute_mmd_job](VarianceH1& job, const SelfAdjointPrecomputedKernel& kernel_functor)
+		{
+			auto var_est=job.compute_variance_estimate();
+			auto mmd_est=compute_mmd_job(kernel_functor);
+			return mmd_est / std::sqrt(var_est + job.m_lambda);
+		});
+	}
+
+	/**
+	 * Computes a measure for every kernel, in parallel over the kernels. Every
+	 * thread accumulates the terms in its own job and precomputes the kernel
+	 * matrix into its own buffer.
+	 *
+	 * @param kernel_mgr the kernels
+	 * @param measure computes the measure from the job with the accumulated
+	 * terms and the precomputed kernel
+	 */
+	template <typename Measure>
+	SGVector<float64_t> compute_per_kernel(const KernelManager& kernel_mgr, const Measure& measure) const
+	{
 		const index_t size=m_n_x+m_n_y;
-		SGVector<float64_t> result(kernel_mgr.num_kernels());
-		SelfAdjointPrecomputedKernel kernel_functor(SGVector<float32_t>(size*(size+1)/2));
-		for (auto k=0; k<kernel_mgr.num_kernels(); ++k)
+		const index_t num_kernels=kernel_mgr.num_kernels();
+		SGVector<float64_t> result(num_kernels);
+#pragma omp parallel num_threads(env()->get_num_threads())
 		{
-			auto kernel=kernel_mgr.kernel_at(k);
-			ASSERT(kernel);
-			kernel_functor.precompute(kernel);
-			init_terms();
-			for (auto i=0; i<size; ++i)
+			VarianceH1 job;
+			job.m_n_x=m_n_x;
+			job.m_n_y=m_n_y;
+			job.m_lambda=m_lambda;
+			SelfAdjointPrecomputedKernel kernel_functor(SGVector<float32_t>(size*(size+1)/2));
+#pragma omp for schedule(dynamic)
+			for (index_t k=0; k<num_kernels; ++k)
 			{
-				for (auto j=i+1; j<size; ++j)
-					add_terms(kernel_functor(i, j), i, j);
+				auto kernel=kernel_mgr.kernel_at(k);
+				ASSERT(kernel);
+				kernel_functor.precompute(kernel);
+				job.init_terms();
+				for (auto i=0; i<size; ++i)
+				{
+					for (auto j=i+1; j<size; ++j)
+						job.add_terms(kernel_functor(i, j), i, j);
+				}
+				result[k]=measure(job, kernel_functor);
 			}
-			auto var_est=compute_variance_estimate();
-			auto mmd_est=compute_mmd_job(kernel_functor);
-			result[k] = mmd_est / std::sqrt(var_est + m_lambda);
 		}
-
-		free_terms();
 		return result;
 	}
 
@@ -33,6 +33,7 @@
 #include <shogun/lib/GPUMatrix.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/statistical_testing/internals/mmd/WithinBlockDirect.h>
 
 using namespace shogun;
@@ -56,3 +57,40 @@ float32_t WithinBlockDirect::operator()(const SGMatrix<float32_t>& km)
 	auto variance_estimate=2*(term_1+term_2/(B-1)/(B-2)-2*term_3/(B-2))/B/(B-3);
 	return variance_estimate;
 }
+
+float32_t WithinBlockDirect::compute_using_gpu(const SGMatrix<float32_t>& km,
+	const SGMatrix<float32_t>& device_km)
+{
+	index_t B=km.num_rows;
+
+	SGVector<float32_t> ones(B);
+	ones.set_const(1);
+	if (device_km.on_gpu())
+		linalg::to_gpu(ones);
+
+	// with K0 being the kernel matrix with zero diagonal, the sum of K0*K0 is
+	// the squared norm of the row sums of K0, since K0 is symmetric
+	auto row_sums=linalg::matrix_prod(device_km, ones);
+	auto sum_squares=linalg::sum(linalg::element_prod(device_km, device_km));
+	SGVector<float32_t> host_row_sums;
+	if (row_sums.on_gpu())
+		linalg::from_gpu(row_sums, host_row_sums);
+	else
+		host_row_sums=row_sums;
+
+	float64_t term_1=sum_squares;
+	float64_t sum=0;
+	float64_t term_3=0;
+	for (index_t i=0; i<B; ++i)
+	{
+		auto diag=km(i, i);
+		auto row_sum=host_row_sums[i]-diag;
+		term_1-=diag*diag;
+		sum+=row_sum;
+		term_3+=row_sum*row_sum;
+	}
+	auto term_2=Math::sq(sum);
+
+	auto variance_estimate=2*(term_1+term_2/(B-1)/(B-2)-2*term_3/(B-2))/B/(B-3);
+	return variance_estimate;
+}
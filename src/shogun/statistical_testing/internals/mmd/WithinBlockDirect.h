@@ -50,7 +50,16 @@ struct WithinBlockDirect
 {
 	typedef float32_t return_type;
 	return_type operator()(const SGMatrix<return_type>& kernel_matrix);
-//	return_type operator()(const CGPUMatrix<return_type>& kernel_matrix);
+	/**
+	 * Computes the estimate with the kernel matrix in GPU memory, using the
+	 * sum of its squares and its row sums, only the diagonal is read from
+	 * the copy in host memory.
+	 *
+	 * @param kernel_matrix the kernel matrix in host memory
+	 * @param device_kernel_matrix the same matrix in GPU memory
+	 */
+	return_type compute_using_gpu(const SGMatrix<return_type>& kernel_matrix,
+		const SGMatrix<return_type>& device_kernel_matrix);
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
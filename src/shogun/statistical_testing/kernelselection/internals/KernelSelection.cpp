@@ -30,6 +30,7 @@
  */
 
 #include <shogun/io/SGIO.h>
+#include <shogun/lib/SGVector.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/ShiftInvariantKernel.h>
@@ -37,7 +38,9 @@
 #include <shogun/statistical_testing/internals/KernelManager.h>
 #include <shogun/statistical_testing/kernelselection/internals/KernelSelection.h>
 
+#include <map>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 using namespace internal;
@@ -51,3 +54,43 @@ KernelSelection::KernelSelection(KernelManager& km, std::shared_ptr<MMD> est) :
 KernelSelection::~KernelSelection()
 {
 }
+
+void KernelSelection::compute_grouped_by_distance(SGVector<float64_t>& measures,
+	const std::function<SGVector<float64_t>(const KernelManager&)>& shared_measure,
+	const std::function<float64_t(const std::shared_ptr<shogun::Kernel>&)>& single_measure) const
+{
+	const auto num_kernels=kernel_mgr.num_kernels();
+	ASSERT(measures.size()==num_kernels);
+
+	// only the distances that KernelManager can instantiate are shared
+	std::map<EDistanceType, std::vector<index_t>> groups;
+	for (auto i=0; i<num_kernels; ++i)
+	{
+		auto kernel=std::dynamic_pointer_cast<ShiftInvariantKernel>(kernel_mgr.kernel_at(i));
+		auto distance_type=kernel ? kernel->get_distance_type() : D_UNKNOWN;
+		if (distance_type!=D_EUCLIDEAN && distance_type!=D_MANHATTAN)
+			distance_type=D_UNKNOWN;
+		groups[distance_type].push_back(i);
+	}
+
+	for (const auto& group : groups)
+	{
+		const auto& indices=group.second;
+		if (group.first==D_UNKNOWN)
+		{
+			for (auto i : indices)
+				measures[i]=single_measure(kernel_mgr.kernel_at(i));
+		}
+		else
+		{
+			SG_DEBUG("Computing the measures of {} kernels from one precomputed distance!", indices.size());
+			KernelManager group_mgr;
+			for (auto i : indices)
+				group_mgr.push_back(kernel_mgr.kernel_at(i));
+			auto group_measures=shared_measure(group_mgr);
+			ASSERT(group_measures.size()==(index_t)indices.size());
+			for (size_t i=0; i<indices.size(); ++i)
+				measures[indices[i]]=group_measures[i];
+		}
+	}
+}
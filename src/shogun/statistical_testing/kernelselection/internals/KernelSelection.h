@@ -33,6 +33,7 @@
 #define KERNEL_SELECTION_H__
 
 #include <shogun/lib/common.h>
+#include <functional>
 #include <memory>
 
 namespace shogun
@@ -63,6 +64,21 @@ protected:
 	std::shared_ptr<MMD> estimator;
 	virtual void init_measures()=0;
 	virtual void compute_measures()=0;
+
+	/**
+	 * Computes the measures of all the kernels. The shift invariant kernels
+	 * are grouped by the distance they are computed from and the measures
+	 * of a group are computed from one precomputed distance, see
+	 * MultiKernelQuadraticTimeMMD, the other kernels are evaluated one
+	 * after another.
+	 *
+	 * @param measures the vector to write the measures to
+	 * @param shared_measure computes the measures of a group of kernels
+	 * @param single_measure computes the measure of a single kernel
+	 */
+	void compute_grouped_by_distance(SGVector<float64_t>& measures,
+		const std::function<SGVector<float64_t>(const KernelManager&)>& shared_measure,
+		const std::function<float64_t(const std::shared_ptr<shogun::Kernel>&)>& single_measure) const;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
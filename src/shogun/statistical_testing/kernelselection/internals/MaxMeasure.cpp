@@ -74,24 +74,32 @@ void MaxMeasure::init_measures()
 void MaxMeasure::compute_measures()
 {
 	require(estimator!=nullptr, "Estimator is not set!");
+	init_measures();
+	auto existing_kernel=estimator->get_kernel();
+	auto single_measure=[this](const std::shared_ptr<shogun::Kernel>& kernel)
+	{
+		estimator->set_kernel(kernel);
+		auto statistic=estimator->compute_statistic();
+		estimator->cleanup();
+		return statistic;
+	};
+
 	auto mmd=std::dynamic_pointer_cast<QuadraticTimeMMD>(estimator);
-	if (mmd!=nullptr && kernel_mgr.same_distance_type())
-		measures=mmd->multikernel()->statistic(kernel_mgr);
+	if (mmd!=nullptr)
+	{
+		compute_grouped_by_distance(measures, [&mmd](const KernelManager& group_mgr)
+		{
+			return mmd->multikernel()->statistic(group_mgr);
+		}, single_measure);
+	}
 	else
 	{
-		init_measures();
-		auto existing_kernel=estimator->get_kernel();
 		const auto num_kernels=kernel_mgr.num_kernels();
 		for (auto i=0; i<num_kernels; ++i)
-		{
-			auto kernel=kernel_mgr.kernel_at(i);
-			estimator->set_kernel(kernel);
-			measures[i]=estimator->compute_statistic();
-			estimator->cleanup();
-		}
-		if (existing_kernel)
-			estimator->set_kernel(existing_kernel);
+			measures[i]=single_measure(kernel_mgr.kernel_at(i));
 	}
+	if (existing_kernel)
+		estimator->set_kernel(existing_kernel);
 }
 
 std::shared_ptr<shogun::Kernel> MaxMeasure::select_kernel()
@@ -36,6 +36,7 @@
 #include <shogun/statistical_testing/MultiKernelQuadraticTimeMMD.h>
 #include <shogun/statistical_testing/QuadraticTimeMMD.h>
 #include <shogun/statistical_testing/StreamingMMD.h>
+#include <shogun/statistical_testing/TestEnums.h>
 #include <shogun/statistical_testing/internals/KernelManager.h>
 #include <shogun/statistical_testing/kernelselection/internals/MaxTestPower.h>
 #include <utility>
@@ -77,7 +78,18 @@ void MaxTestPower::compute_measures()
 	{
 		auto quadratictime_mmd=std::dynamic_pointer_cast<QuadraticTimeMMD>(estimator);
 		ASSERT(quadratictime_mmd);
-		measures=quadratictime_mmd->multikernel()->test_power(kernel_mgr);
+		require(estimator->get_statistic_type()==ST_UNBIASED_FULL, "Only possible with UNBIASED_FULL!");
+		compute_grouped_by_distance(measures, [&quadratictime_mmd](const KernelManager& group_mgr)
+		{
+			return quadratictime_mmd->multikernel()->test_power(group_mgr);
+		}, [&](const std::shared_ptr<shogun::Kernel>& kernel)
+		{
+			estimator->set_kernel(kernel);
+			auto mmd_est=estimator->compute_statistic()*(m+n)/m/n;
+			auto var_est=quadratictime_mmd->compute_variance_h1();
+			estimator->cleanup();
+			return mmd_est/std::sqrt(var_est+lambda);
+		});
 	}
 	if (existing_kernel)
 		estimator->set_kernel(existing_kernel);
@@ -82,7 +82,8 @@ void MedianHeuristic::compute_measures()
 		for (auto i=j+1; i<n; ++i)
 			measures[write_idx++]=distance->distance(i, j);
 	}
-	std::sort(measures.data(), measures.data()+measures.size());
+	// only the median is used, see select_kernel()
+	std::nth_element(measures.data(), measures.data()+measures.size()/2, measures.data()+measures.size());
 }
 
 SGVector<float64_t> MedianHeuristic::get_measure_vector()
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <queue>
 #include <shogun/io/SGIO.h>
 #include <shogun/structure/BeliefPropagation.h>
 #include <stack>
@@ -76,7 +77,7 @@ TreeMaxProduct::TreeMaxProduct(std::shared_ptr<FactorGraph> fg)
 			// <fac_id, msg_id>
 			m_msg_map_fac[m_msg_order[mi]->child] = mi;
 			// collect incoming msgs for each var_id
-			m_msgset_map_var[m_msg_order[mi]->parent].insert(mi);
+			m_msgset_map_var[m_msg_order[mi]->parent].push_back(mi);
 		}
 	}
 
@@ -253,10 +254,10 @@ void TreeMaxProduct::bottom_up_pass()
 		if (m_msg_order[mi]->mtype == VAR_TO_FAC) // var -> factor
 		{
 			uint32_t var_id = m_msg_order[mi]->child;
-			const std::set<uint32_t>& msgset_var = m_msgset_map_var[var_id];
+			const msgset_map_type::mapped_type& msgset_var = m_msgset_map_var[var_id];
 
 			// q_v2f = sum(r_f2v), i.e. sum all incoming f2v msgs
-			for (std::set<uint32_t>::const_iterator cit = msgset_var.begin(); cit != msgset_var.end(); cit++)
+			for (msgset_map_type::mapped_type::const_iterator cit = msgset_var.begin(); cit != msgset_var.end(); cit++)
 			{
 				std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
 					m_fw_msgs[mi].begin(),
@@ -324,9 +325,9 @@ void TreeMaxProduct::bottom_up_pass()
 		if (!m_is_root[ri])
 			continue;
 
-		const std::set<uint32_t>& msgset_rt = m_msgset_map_var[ri];
+		const msgset_map_type::mapped_type& msgset_rt = m_msgset_map_var[ri];
 		std::vector<float64_t> rmarg(cards[ri], 0);
-		for (std::set<uint32_t>::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
+		for (msgset_map_type::mapped_type::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
 		{
 			std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
 				rmarg.begin(),
@@ -366,9 +367,9 @@ void TreeMaxProduct::top_down_pass()
 		if (!m_is_root[ri])
 			continue;
 
-		const std::set<uint32_t>& msgset_rt = m_msgset_map_var[ri];
+		const msgset_map_type::mapped_type& msgset_rt = m_msgset_map_var[ri];
 		std::vector<float64_t> rmarg(cards[ri], 0);
-		for (std::set<uint32_t>::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
+		for (msgset_map_type::mapped_type::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
 		{
 			// rmarg += m_fw_msgs[*cit]
 			std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
@@ -424,8 +425,8 @@ void TreeMaxProduct::top_down_pass()
 			}
 
 			// siblings: sum_{child!=f} r_fw_child2v
-			const std::set<uint32_t>& msgset_var = m_msgset_map_var[var_id];
-			for (std::set<uint32_t>::const_iterator cit = msgset_var.begin();
+			const msgset_map_type::mapped_type& msgset_var = m_msgset_map_var[var_id];
+			for (msgset_map_type::mapped_type::const_iterator cit = msgset_var.begin();
 				cit != msgset_var.end(); cit++)
 			{
 				if (m_msg_order[*cit]->child == fac_id)
@@ -550,3 +551,419 @@ void TreeMaxProduct::top_down_pass()
 	SG_DEBUG("***leave top_down_pass().");
 }
 
+// -----------------------------------------------------------------
+
+namespace
+{
+	/** log(exp(a)+exp(b)) */
+	float64_t log_add(float64_t a, float64_t b)
+	{
+		if (a == -std::numeric_limits<float64_t>::infinity())
+			return b;
+		if (b == -std::numeric_limits<float64_t>::infinity())
+			return a;
+		return std::max(a, b) + std::log1p(std::exp(-std::abs(a - b)));
+	}
+}
+
+LoopyMaxProduct::LoopyMaxProduct()
+	: BeliefPropagation()
+{
+	unstable(SOURCE_LOCATION);
+
+	init();
+}
+
+LoopyMaxProduct::LoopyMaxProduct(std::shared_ptr<FactorGraph> fg)
+	: BeliefPropagation(std::move(fg))
+{
+	ASSERT(m_fg != NULL);
+
+	init();
+
+	m_cards = m_fg->get_cardinalities();
+	auto facs = m_fg->get_factors();
+	int32_t num_vars = m_cards.size();
+
+	// one edge for each variable of each factor, numbered factor by factor
+	m_fac_edges.resize(facs.size() + 1, 0);
+	m_msg_offset.push_back(0);
+	for (uint32_t fi = 0; fi < facs.size(); ++fi)
+	{
+		SGVector<int32_t> fvars = facs[fi]->get_variables();
+		for (int32_t vi = 0; vi < fvars.size(); ++vi)
+		{
+			m_edge_var.push_back(fvars[vi]);
+			m_edge_fac.push_back(fi);
+			m_msg_offset.push_back(m_msg_offset.back() + m_cards[fvars[vi]]);
+		}
+		m_fac_edges[fi + 1] = m_edge_var.size();
+	}
+
+	// edges of each variable
+	m_var_edges.resize(num_vars + 1, 0);
+	for (auto var : m_edge_var)
+		++m_var_edges[var + 1];
+	std::partial_sum(m_var_edges.begin(), m_var_edges.end(), m_var_edges.begin());
+	m_var_edge_list.resize(m_edge_var.size());
+	std::vector<int32_t> next(m_var_edges.begin(), m_var_edges.end() - 1);
+	for (uint32_t ei = 0; ei < m_edge_var.size(); ++ei)
+		m_var_edge_list[next[m_edge_var[ei]]++] = ei;
+}
+
+LoopyMaxProduct::~LoopyMaxProduct()
+{
+}
+
+void LoopyMaxProduct::init()
+{
+	SG_ADD(&m_max_iter, "max_iter", "Maximum number of sweeps");
+	SG_ADD(&m_tolerance, "tolerance", "Convergence tolerance of the messages");
+	SG_ADD(&m_damping, "damping", "Weight of the previous message");
+
+	m_max_iter = 100;
+	m_tolerance = 1e-6;
+	m_damping = 0.5;
+	m_schedule = BP_SYNCHRONOUS;
+	m_message_type = BP_MAX_PRODUCT;
+	m_num_updates = 0;
+	m_converged = false;
+}
+
+void LoopyMaxProduct::set_max_iter(int32_t max_iter)
+{
+	require(max_iter > 0, "{}::set_max_iter(): max_iter ({}) must be positive!",
+		get_name(), max_iter);
+	m_max_iter = max_iter;
+}
+
+int32_t LoopyMaxProduct::get_max_iter() const
+{
+	return m_max_iter;
+}
+
+void LoopyMaxProduct::set_tolerance(float64_t tolerance)
+{
+	require(tolerance >= 0, "{}::set_tolerance(): tolerance ({}) must not be negative!",
+		get_name(), tolerance);
+	m_tolerance = tolerance;
+}
+
+float64_t LoopyMaxProduct::get_tolerance() const
+{
+	return m_tolerance;
+}
+
+void LoopyMaxProduct::set_damping(float64_t damping)
+{
+	require(damping >= 0 && damping < 1,
+		"{}::set_damping(): damping ({}) must be in [0, 1)!", get_name(), damping);
+	m_damping = damping;
+}
+
+float64_t LoopyMaxProduct::get_damping() const
+{
+	return m_damping;
+}
+
+void LoopyMaxProduct::set_schedule(EBPSchedule schedule)
+{
+	m_schedule = schedule;
+}
+
+EBPSchedule LoopyMaxProduct::get_schedule() const
+{
+	return m_schedule;
+}
+
+void LoopyMaxProduct::set_message_type(EBPMessageType message_type)
+{
+	m_message_type = message_type;
+}
+
+EBPMessageType LoopyMaxProduct::get_message_type() const
+{
+	return m_message_type;
+}
+
+int64_t LoopyMaxProduct::get_num_updates() const
+{
+	return m_num_updates;
+}
+
+bool LoopyMaxProduct::is_converged() const
+{
+	return m_converged;
+}
+
+float64_t LoopyMaxProduct::inference(SGVector<int32_t> assignment)
+{
+	require(m_fg != NULL, "{}::inference(): no factor graph!", get_name());
+	require(assignment.size() == m_cards.size(),
+		"{}::inference(): the output assignment should be prepared as"
+		"the same size as variables!", get_name());
+
+	auto facs = m_fg->get_factors();
+	m_energies.resize(facs.size());
+	for (uint32_t fi = 0; fi < facs.size(); ++fi)
+	{
+		int32_t num_assignments = 1;
+		for (int32_t ei = m_fac_edges[fi]; ei < m_fac_edges[fi + 1]; ++ei)
+			num_assignments *= m_cards[m_edge_var[ei]];
+
+		m_energies[fi] = facs[fi]->get_energies();
+		require(m_energies[fi].size() == num_assignments,
+			"{}::inference(): energies of factor {} have not been computed!",
+			get_name(), fi);
+	}
+
+	// all messages start uniform
+	m_fac_msgs.assign(m_msg_offset.back(), 0);
+	m_var_msgs.assign(m_msg_offset.back(), 0);
+	m_new_msgs.assign(m_msg_offset.back(), 0);
+	m_num_updates = 0;
+	m_converged = false;
+
+	if (m_schedule == BP_RESIDUAL)
+		residual_updates();
+	else
+		synchronous_sweeps();
+
+	if (!m_converged)
+		io::warn("{}::inference(): messages did not converge in {} updates",
+			get_name(), m_num_updates);
+
+	// decode the variables from their beliefs
+	for (int32_t vi = 0; vi < assignment.size(); ++vi)
+	{
+		std::vector<float64_t> belief(m_cards[vi], 0);
+		for (int32_t k = m_var_edges[vi]; k < m_var_edges[vi + 1]; ++k)
+		{
+			const float64_t* msg = &m_fac_msgs[m_msg_offset[m_var_edge_list[k]]];
+			for (int32_t si = 0; si < m_cards[vi]; ++si)
+				belief[si] += msg[si];
+		}
+
+		assignment[vi] = static_cast<int32_t>(
+			std::max_element(belief.begin(), belief.end()) - belief.begin());
+	}
+
+	m_energies.clear();
+
+	return m_fg->evaluate_energy(assignment);
+}
+
+void LoopyMaxProduct::synchronous_sweeps()
+{
+	int32_t num_facs = m_fac_edges.size() - 1;
+	int32_t num_vars = m_cards.size();
+
+	for (int32_t iter = 0; iter < m_max_iter; ++iter)
+	{
+		float64_t max_residual = 0;
+
+		// static schedules hand contiguous blocks of factors and variables
+		// to each thread, which partitions graphs built in scan order
+		#pragma omp parallel num_threads(env()->get_num_threads())
+		{
+			std::vector<int32_t> states;
+
+			#pragma omp for schedule(static) reduction(max:max_residual)
+			for (int32_t fi = 0; fi < num_facs; ++fi)
+			{
+				compute_factor_messages(fi, states);
+				for (int32_t ei = m_fac_edges[fi]; ei < m_fac_edges[fi + 1]; ++ei)
+				{
+					max_residual = std::max(max_residual, residual(ei));
+					send_message(ei);
+				}
+			}
+
+			#pragma omp for schedule(static)
+			for (int32_t vi = 0; vi < num_vars; ++vi)
+				update_variable_messages(vi);
+		}
+
+		m_num_updates += m_edge_var.size();
+		SG_DEBUG("{}: sweep {}, residual {}", get_name(), iter, max_residual);
+
+		if (max_residual <= m_tolerance)
+		{
+			m_converged = true;
+			break;
+		}
+	}
+}
+
+void LoopyMaxProduct::residual_updates()
+{
+	typedef std::pair<float64_t, int32_t> entry_type;
+
+	int32_t num_facs = m_fac_edges.size() - 1;
+	int64_t max_updates = int64_t(m_max_iter) * m_edge_var.size();
+	std::vector<int32_t> states;
+	std::vector<float64_t> residuals(m_edge_var.size());
+	std::priority_queue<entry_type> queue;
+
+	for (int32_t fi = 0; fi < num_facs; ++fi)
+	{
+		compute_factor_messages(fi, states);
+		for (int32_t ei = m_fac_edges[fi]; ei < m_fac_edges[fi + 1]; ++ei)
+		{
+			residuals[ei] = residual(ei);
+			queue.emplace(residuals[ei], ei);
+		}
+	}
+
+	// entries are not removed from the queue when a residual changes, so
+	// those that do not match the current residual are stale
+	m_converged = true;
+	while (!queue.empty())
+	{
+		entry_type top = queue.top();
+		queue.pop();
+
+		int32_t ei = top.second;
+		if (top.first != residuals[ei])
+			continue;
+		if (top.first <= m_tolerance)
+			break;
+		if (m_num_updates >= max_updates)
+		{
+			m_converged = false;
+			break;
+		}
+
+		send_message(ei);
+		++m_num_updates;
+		residuals[ei] = residual(ei);
+		if (residuals[ei] > m_tolerance)
+			queue.emplace(residuals[ei], ei);
+
+		// the variable informs its other factors, whose messages to
+		// their other variables change
+		int32_t vi = m_edge_var[ei];
+		update_variable_messages(vi);
+		for (int32_t k = m_var_edges[vi]; k < m_var_edges[vi + 1]; ++k)
+		{
+			int32_t ej = m_var_edge_list[k];
+			if (ej == ei)
+				continue;
+
+			int32_t fj = m_edge_fac[ej];
+			compute_factor_messages(fj, states);
+			for (int32_t ek = m_fac_edges[fj]; ek < m_fac_edges[fj + 1]; ++ek)
+			{
+				if (ek == ej)
+					continue;
+
+				residuals[ek] = residual(ek);
+				queue.emplace(residuals[ek], ek);
+			}
+		}
+	}
+}
+
+void LoopyMaxProduct::compute_factor_messages(int32_t fi, std::vector<int32_t>& states)
+{
+	const SGVector<float64_t>& fenrgs = m_energies[fi];
+	int32_t begin = m_fac_edges[fi];
+	int32_t num_fvars = m_fac_edges[fi + 1] - begin;
+	bool max_product = m_message_type == BP_MAX_PRODUCT;
+
+	float64_t* out = &m_new_msgs[m_msg_offset[begin]];
+	std::fill(out, &m_new_msgs[m_msg_offset[begin + num_fvars]],
+		-std::numeric_limits<float64_t>::infinity());
+
+	// run over the factor table, the state of the first variable changing
+	// fastest as in TableFactorType
+	states.assign(num_fvars, 0);
+	for (int32_t ei = 0; ei < fenrgs.size(); ++ei)
+	{
+		for (int32_t vi = 0; vi < num_fvars; ++vi)
+		{
+			// -E(x_f) + sum_{j!=v} q_j2f(x_j)
+			float64_t value = -fenrgs[ei];
+			for (int32_t vj = 0; vj < num_fvars; ++vj)
+			{
+				if (vj != vi)
+					value += m_var_msgs[m_msg_offset[begin + vj] + states[vj]];
+			}
+
+			float64_t& r = m_new_msgs[m_msg_offset[begin + vi] + states[vi]];
+			r = max_product ? std::max(r, value) : log_add(r, value);
+		}
+
+		for (int32_t vi = 0; vi < num_fvars; ++vi)
+		{
+			if (++states[vi] < m_cards[m_edge_var[begin + vi]])
+				break;
+			states[vi] = 0;
+		}
+	}
+
+	for (int32_t ei = begin; ei < begin + num_fvars; ++ei)
+		normalize(&m_new_msgs[m_msg_offset[ei]], m_msg_offset[ei + 1] - m_msg_offset[ei]);
+}
+
+float64_t LoopyMaxProduct::residual(int32_t ei) const
+{
+	float64_t res = 0;
+	for (int32_t i = m_msg_offset[ei]; i < m_msg_offset[ei + 1]; ++i)
+	{
+		// equal infinite entries have not changed
+		if (m_new_msgs[i] != m_fac_msgs[i])
+			res = std::max(res, std::abs(m_new_msgs[i] - m_fac_msgs[i]));
+	}
+	return res;
+}
+
+void LoopyMaxProduct::send_message(int32_t ei)
+{
+	for (int32_t i = m_msg_offset[ei]; i < m_msg_offset[ei + 1]; ++i)
+	{
+		if (m_damping > 0 && std::isfinite(m_fac_msgs[i]) && std::isfinite(m_new_msgs[i]))
+			m_fac_msgs[i] = (1 - m_damping) * m_new_msgs[i] + m_damping * m_fac_msgs[i];
+		else
+			m_fac_msgs[i] = m_new_msgs[i];
+	}
+}
+
+void LoopyMaxProduct::update_variable_messages(int32_t vi)
+{
+	int32_t begin = m_var_edges[vi];
+	int32_t end = m_var_edges[vi + 1];
+
+	// q_v2f = sum_{g!=f} r_g2v
+	for (int32_t k = begin; k < end; ++k)
+	{
+		float64_t* q = &m_var_msgs[m_msg_offset[m_var_edge_list[k]]];
+		std::fill(q, q + m_cards[vi], 0);
+
+		for (int32_t l = begin; l < end; ++l)
+		{
+			if (l == k)
+				continue;
+
+			const float64_t* r = &m_fac_msgs[m_msg_offset[m_var_edge_list[l]]];
+			for (int32_t si = 0; si < m_cards[vi]; ++si)
+				q[si] += r[si];
+		}
+
+		normalize(q, m_cards[vi]);
+	}
+}
+
+void LoopyMaxProduct::normalize(float64_t* msg, int32_t len) const
+{
+	float64_t norm = *std::max_element(msg, msg + len);
+	if (m_message_type == BP_SUM_PRODUCT)
+		norm = std::accumulate(msg, msg + len,
+			-std::numeric_limits<float64_t>::infinity(), log_add);
+
+	if (!std::isfinite(norm))
+		return;
+
+	for (int32_t i = 0; i < len; ++i)
+		msg[i] -= norm;
+}
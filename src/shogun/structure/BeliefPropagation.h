@@ -9,12 +9,13 @@
 
 #include <shogun/lib/config.h>
 
+#include <shogun/lib/FlatHashMap.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/SmallVector.h>
 #include <shogun/structure/FactorGraph.h>
 #include <shogun/structure/MAPInference.h>
 
 #include <vector>
-#include <set>
 
 #include <unordered_map>
 
@@ -36,6 +37,24 @@ enum EEdgeType
 	FAC_TO_VAR = 1
 };
 
+/** message update of LoopyMaxProduct */
+enum EBPMessageType
+{
+	/** max-product messages in the log domain, i.e. max-sum */
+	BP_MAX_PRODUCT = 0,
+	/** sum-product messages in the log domain, decoded from the marginals */
+	BP_SUM_PRODUCT = 1
+};
+
+/** message schedule of LoopyMaxProduct */
+enum EBPSchedule
+{
+	/** all messages are updated at once in each sweep, in parallel */
+	BP_SYNCHRONOUS = 0,
+	/** the message with the largest residual is sent first */
+	BP_RESIDUAL = 1
+};
+
 struct GraphNode
 {
 	int32_t node_id;
@@ -97,8 +116,9 @@ protected:
  */
 IGNORE_IN_CLASSLIST class TreeMaxProduct : public BeliefPropagation
 {
-	typedef std::unordered_map<uint32_t, uint32_t> msg_map_type;
-	typedef std::unordered_map<uint32_t, std::set<uint32_t> > msgset_map_type;
+	typedef FlatHashMap<uint32_t, uint32_t> msg_map_type;
+	/** incoming messages of a variable, in ascending order */
+	typedef FlatHashMap<uint32_t, SmallVector<uint32_t, 4> > msgset_map_type;
 	typedef std::unordered_multimap<int32_t, int32_t> var_factor_map_type;
 
 public:
@@ -132,6 +152,128 @@ private:
 	msgset_map_type m_msgset_map_var;
 };
 
+/** loopy belief propagation for factor graphs with cycles, e.g. grids
+ *
+ * There is one edge for each variable of each factor, the messages of all
+ * edges are stored contiguously in the log domain, and those of a factor
+ * are next to each other. A synchronous sweep first updates the messages of
+ * all factors and then those of all variables, each in parallel over
+ * contiguous blocks of the graph. Residual scheduling [1] instead always
+ * sends the factor to variable message that would change the most, which
+ * usually converges in far fewer updates but is sequential. Variables are
+ * decoded from their beliefs (the max-marginals for max-product).
+ *
+ * [1] Gal Elidan, Ian McGraw and Daphne Koller,
+ * Residual Belief Propagation: Informed Scheduling for Asynchronous
+ * Message Passing, UAI 2006.
+ */
+IGNORE_IN_CLASSLIST class LoopyMaxProduct : public BeliefPropagation
+{
+public:
+	LoopyMaxProduct();
+	LoopyMaxProduct(std::shared_ptr<FactorGraph> fg);
+
+	~LoopyMaxProduct() override;
+
+	/** @return class name */
+	const char* get_name() const override { return "LoopyMaxProduct"; }
+
+	float64_t inference(SGVector<int32_t> assignment) override;
+
+	/** @param max_iter maximum number of sweeps, for residual scheduling
+	 * the number of messages sent is bounded by as many times the number
+	 * of edges
+	 */
+	void set_max_iter(int32_t max_iter);
+
+	/** @return maximum number of sweeps */
+	int32_t get_max_iter() const;
+
+	/** @param tolerance messages changing less than this have converged */
+	void set_tolerance(float64_t tolerance);
+
+	/** @return convergence tolerance */
+	float64_t get_tolerance() const;
+
+	/** @param damping weight of the previous message in [0, 1) */
+	void set_damping(float64_t damping);
+
+	/** @return damping */
+	float64_t get_damping() const;
+
+	/** @param schedule message schedule */
+	void set_schedule(EBPSchedule schedule);
+
+	/** @return message schedule */
+	EBPSchedule get_schedule() const;
+
+	/** @param message_type max-product or sum-product messages */
+	void set_message_type(EBPMessageType message_type);
+
+	/** @return message type */
+	EBPMessageType get_message_type() const;
+
+	/** @return number of factor to variable messages sent by the last inference */
+	int64_t get_num_updates() const;
+
+	/** @return whether the messages converged in the last inference */
+	bool is_converged() const;
+
+protected:
+	/** update all messages in parallel until convergence */
+	void synchronous_sweeps();
+
+	/** send the message with the largest residual until convergence */
+	void residual_updates();
+
+	/** compute the new messages of a factor to all its variables
+	 *
+	 * @param fi factor index
+	 * @param states scratch buffer for the states of the factor variables
+	 */
+	void compute_factor_messages(int32_t fi, std::vector<int32_t>& states);
+
+	/** @return largest change between the new and the current message */
+	float64_t residual(int32_t ei) const;
+
+	/** replace the current message of an edge by the (damped) new one */
+	void send_message(int32_t ei);
+
+	/** update the messages of a variable to all its factors */
+	void update_variable_messages(int32_t vi);
+
+	/** normalize a message to a maximum (or log-sum) of zero */
+	void normalize(float64_t* msg, int32_t len) const;
+
+private:
+	void init();
+
+private:
+	int32_t m_max_iter;
+	float64_t m_tolerance;
+	float64_t m_damping;
+	EBPSchedule m_schedule;
+	EBPMessageType m_message_type;
+	int64_t m_num_updates;
+	bool m_converged;
+
+	SGVector<int32_t> m_cards;
+	/** factor energies of the current inference */
+	std::vector<SGVector<float64_t>> m_energies;
+	/** edges of factor fi are m_fac_edges[fi] to m_fac_edges[fi+1]-1 */
+	std::vector<int32_t> m_fac_edges;
+	/** edges of variable vi are listed from m_var_edges[vi] to m_var_edges[vi+1]-1 */
+	std::vector<int32_t> m_var_edges;
+	std::vector<int32_t> m_var_edge_list;
+	std::vector<int32_t> m_edge_var;
+	std::vector<int32_t> m_edge_fac;
+	/** message of edge ei is stored from m_msg_offset[ei] to m_msg_offset[ei+1]-1 */
+	std::vector<int32_t> m_msg_offset;
+	std::vector<float64_t> m_fac_msgs;
+	std::vector<float64_t> m_var_msgs;
+	std::vector<float64_t> m_new_msgs;
+};
+
 }
 
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -530,9 +530,9 @@ SGSparseVector<float64_t> CCSOSVM::find_cutting_plane(float64_t* margin)
 	/* find cutting plane */
 	*margin = 0;
 	new_constraint.zero();
-	for (index_t i = 0; i < num_samples; i++)
+	m_model->for_each_argmax(m_w, true,
+		[&](int32_t, const std::shared_ptr<ResultSet>& result)
 	{
-		auto result = m_model->argmax(m_w, i);
 		if (result->psi_computed)
 		{
 			linalg::add(new_constraint, result->psi_truth, new_constraint);
@@ -557,8 +557,7 @@ SGSparseVector<float64_t> CCSOSVM::find_cutting_plane(float64_t* margin)
 				Math::dot(result->psi_pred.vector, result->psi_pred.vector, result->psi_pred.vlen));
 		*/
 		*margin += result->delta;
-
-	}
+	});
 	/* scaling */
 	float64_t scale = 1/(float64_t)num_samples;
 	new_constraint.scale(scale);
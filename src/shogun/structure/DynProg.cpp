@@ -22,6 +22,11 @@
 #include <limits.h>
 
 #include <utility>
+#include <vector>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
 
 using namespace shogun;
 
@@ -1113,12 +1118,6 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		long_transition_content_end_position.set_const(0) ;
 #endif
 
-		svm_value = SG_MALLOC(float64_t , m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs);
-		{ // initialize svm_svalue
-			for (int32_t s=0; s<m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs; s++)
-				svm_value[s]=0 ;
-		}
-
 		DynamicArray<int32_t> look_back(m_N,m_N) ; // 2d
 		//DynamicArray<int32_t> look_back_orig(m_N,m_N) ;
 
@@ -1269,11 +1268,6 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 	    DynamicArray<int16_t> ktable_end(nbest);
 	    // ktable_end.set_const(0) ;
 
-	    float64_t* fixedtempvv = SG_MALLOC(float64_t, look_back_buflen);
-	    memset(fixedtempvv, 0, look_back_buflen * sizeof(float64_t));
-	    int32_t* fixedtempii = SG_MALLOC(int32_t, look_back_buflen);
-	    memset(fixedtempii, 0, look_back_buflen * sizeof(int32_t));
-
 	    DynamicArray<float64_t> oldtempvv(look_back_buflen);
 
 	    DynamicArray<float64_t> oldtempvv2(look_back_buflen);
@@ -1391,12 +1385,49 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 			}
 		}
 
+		// penalties of transitions that do not use content svm values only
+		// depend on the segment length, tabulate them for all lengths up to
+		// the look back instead of evaluating the plifs in the recursion
+		const int32_t max_segment_len=m_pos[m_seq_len-1]-m_pos[0] ;
+		std::vector<SGVector<float64_t>> penalty_table(m_N*m_N) ;
+		for (int32_t j=0; j<m_N; j++)
+		{
+			const T_STATES num_elem   = trans_list_forward_cnt[j] ;
+			const T_STATES *elem_list = trans_list_forward[j] ;
+
+			for (int32_t i=0; i<num_elem; i++)
+			{
+				T_STATES ii = elem_list[i] ;
+				const auto& penalty = PEN[index_N(j,ii)] ;
+				if (!penalty || penalty->uses_svm_values())
+					continue ;
+
+				auto& table = penalty_table[index_N(j,ii)] ;
+				table = SGVector<float64_t>(Math::min(look_back.element(j, ii), max_segment_len)+1) ;
+				for (int32_t len=0; len<table.vlen; len++)
+					table[len] = penalty->lookup_penalty(len, NULL) ;
+			}
+		}
+
 		SG_DEBUG("START_RECURSION ")
 
+		// the scores of all states at a position only depend on the scores
+		// at previous positions, so the states are distributed over the threads
+#if !defined(DYNPROG_TIMING) && !defined(DYNPROG_TIMING_DETAIL)
+#pragma omp parallel num_threads(env()->get_num_threads())
+#endif
+		{
+		SGVector<float64_t> svm_value_buffer(m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs) ;
+		svm_value_buffer.zero() ;
+		float64_t* svm_value = svm_value_buffer.vector ;
+		SGVector<float64_t> fixedtempvv(nbest) ;
+		SGVector<int32_t> fixedtempii(nbest) ;
+
 		// recursion
 		for (int32_t t=1; t<m_seq_len; t++)
 		{
-			for (T_STATES j=0; j<m_N; j++)
+#pragma omp for schedule(dynamic)
+			for (int32_t j=0; j<m_N; j++)
 			{
 				if (seq.element(j,t)<=-1e20)
 				{ // if we cannot observe the symbol here, then we can omit the rest
@@ -1425,7 +1456,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 					{
 						T_STATES ii = elem_list[i] ;
 
-						const auto penalty = PEN[index_N(j,ii)]->as<PlifBase>() ;
+						const auto& penalty = PEN[index_N(j,ii)] ;
 
 						/*int32_t look_back = max_look_back ;
 						  if (0)
@@ -1460,127 +1491,165 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 						MyTime3.start() ;
 #endif
 						int32_t num_ok_pos = 0 ;
+						const auto& table = penalty_table[index_N(j,ii)] ;
 
-						for (int32_t ts=t-1; ts>=0 && m_pos[t]-m_pos[ts]<=look_back_; ts--)
+						if (nbest==1 && orf_target==-1 && !with_loss && (!penalty || table.vlen))
 						{
-							bool ok ;
-							//int32_t plen=t-ts;
-
-							/*for (int32_t s=0; s<m_num_svms; s++)
-							  if ((fabs(svs.svm_values[s*svs.seqlen+plen]-svs2.svm_values[s*svs.seqlen+plen])>1e-6) ||
-							  (fabs(svs.svm_values[s*svs.seqlen+plen]-svs3.svm_values[s*svs.seqlen+plen])>1e-6))
-							  {
-							  SG_DEBUG("s={}, t={}, ts={}, %1.5e, %1.5e, %1.5e", s, t, ts, svs.svm_values[s*svs.seqlen+plen], svs2.svm_values[s*svs.seqlen+plen], svs3.svm_values[s*svs.seqlen+plen])
-							  }*/
-
-							if (orf_target==-1)
-								ok=true ;
-							else if (m_pos[ts]!=-1 && (m_pos[t]-m_pos[ts])%3==orf_target)
-								ok=(!use_orf) || extend_orf(orf_from, orf_to, m_pos[ts], orf_last_pos, m_pos[t]) ;
-							else
-								ok=false ;
-
-							if (ok)
+							// the segment score only depends on the segment length, the
+							// best predecessor is a max over the previous positions
+							int32_t ts_start = t ;
+							while (ts_start>0 && m_pos[t]-m_pos[ts_start-1]<=look_back_)
+								ts_start-- ;
+
+							const float64_t* delta_ii = &delta.element(delta_array, 0, ii, 0, m_seq_len, m_N) ;
+							float64_t best_val = -Math::INFTY ;
+							int32_t best_ts = -1 ;
+							// ties go to the closest position, as in the general loop
+							for (int32_t ts=ts_start; ts<t; ts++)
 							{
-
-								float64_t segment_loss = 0.0 ;
-								if (with_loss)
+								float64_t val = delta_ii[ts] ;
+								if (table.vlen)
+									val += table[m_pos[t]-m_pos[ts]] ;
+								if (val>=best_val)
 								{
-									segment_loss = m_seg_loss_obj->get_segment_loss(ts, t, elem_id[i]);
-									//if (segment_loss!=segment_loss2)
-										//io::print("segment_loss:{} segment_loss2:{}\n", segment_loss, segment_loss2);
+									best_val = val ;
+									best_ts = ts ;
 								}
-								////////////////////////////////////////////////////////
-								// BEST_PATH_TRANS
-								////////////////////////////////////////////////////////
+							}
 
-								int32_t frame = orf_from;//m_orf_info.element(ii,0);
-								lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
+							float64_t mval = -(elem_val[i] + best_val) ;
+							if (best_ts>=0 && mval<fixedtempvv_)
+							{
+								fixedtempvv_ = mval ;
+								fixedtempii_ = ii + best_ts*m_N;
+								fixed_list_len = 1 ;
+								fixedtemplong = false ;
+							}
+						}
+						else
+						{
+							for (int32_t ts=t-1; ts>=0 && m_pos[t]-m_pos[ts]<=look_back_; ts--)
+							{
+								bool ok ;
+								//int32_t plen=t-ts;
 
-								float64_t pen_val = 0.0 ;
-								if (penalty)
+								/*for (int32_t s=0; s<m_num_svms; s++)
+								  if ((fabs(svs.svm_values[s*svs.seqlen+plen]-svs2.svm_values[s*svs.seqlen+plen])>1e-6) ||
+								  (fabs(svs.svm_values[s*svs.seqlen+plen]-svs3.svm_values[s*svs.seqlen+plen])>1e-6))
+								  {
+								  SG_DEBUG("s={}, t={}, ts={}, %1.5e, %1.5e, %1.5e", s, t, ts, svs.svm_values[s*svs.seqlen+plen], svs2.svm_values[s*svs.seqlen+plen], svs3.svm_values[s*svs.seqlen+plen])
+								  }*/
+
+								if (orf_target==-1)
+									ok=true ;
+								else if (m_pos[ts]!=-1 && (m_pos[t]-m_pos[ts])%3==orf_target)
+									ok=(!use_orf) || extend_orf(orf_from, orf_to, m_pos[ts], orf_last_pos, m_pos[t]) ;
+								else
+									ok=false ;
+
+								if (ok)
 								{
+
+									float64_t segment_loss = 0.0 ;
+									if (with_loss)
+									{
+										segment_loss = m_seg_loss_obj->get_segment_loss(ts, t, elem_id[i]);
+										//if (segment_loss!=segment_loss2)
+											//io::print("segment_loss:{} segment_loss2:{}\n", segment_loss, segment_loss2);
+									}
+									////////////////////////////////////////////////////////
+									// BEST_PATH_TRANS
+									////////////////////////////////////////////////////////
+
+									float64_t pen_val = 0.0 ;
+									if (table.vlen)
+										pen_val = table[m_pos[t]-m_pos[ts]] ;
+									else if (penalty)
+									{
+										int32_t frame = orf_from;//m_orf_info.element(ii,0);
+										lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
 #ifdef DYNPROG_TIMING_DETAIL
-									MyTime.start() ;
+										MyTime.start() ;
 #endif
-									pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+										pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
 
 #ifdef DYNPROG_TIMING_DETAIL
-									MyTime.stop() ;
-									content_plifs_time += MyTime.time_diff_sec() ;
+										MyTime.stop() ;
+										content_plifs_time += MyTime.time_diff_sec() ;
 #endif
-								}
+									}
 
 #ifdef DYNPROG_TIMING_DETAIL
-								MyTime.start() ;
+									MyTime.start() ;
 #endif
-								num_ok_pos++ ;
+									num_ok_pos++ ;
 
-								if (nbest==1)
-								{
-									float64_t  val        = elem_val[i] + pen_val ;
-									if (with_loss)
-										val              += segment_loss ;
+									if (nbest==1)
+									{
+										float64_t  val        = elem_val[i] + pen_val ;
+										if (with_loss)
+											val              += segment_loss ;
 
-									float64_t mval = -(val + delta.element(delta_array, ts, ii, 0, m_seq_len, m_N)) ;
+										float64_t mval = -(val + delta.element(delta_array, ts, ii, 0, m_seq_len, m_N)) ;
 
-									if (mval<fixedtempvv_)
-									{
-										fixedtempvv_ = mval ;
-										fixedtempii_ = ii + ts*m_N;
-										fixed_list_len = 1 ;
-										fixedtemplong = false ;
+										if (mval<fixedtempvv_)
+										{
+											fixedtempvv_ = mval ;
+											fixedtempii_ = ii + ts*m_N;
+											fixed_list_len = 1 ;
+											fixedtemplong = false ;
+										}
 									}
-								}
-								else
-								{
-									for (int16_t diff=0; diff<nbest; diff++)
+									else
 									{
-										float64_t  val        = elem_val[i]  ;
-										val                  += pen_val ;
-										if (with_loss)
-											val              += segment_loss ;
+										for (int16_t diff=0; diff<nbest; diff++)
+										{
+											float64_t  val        = elem_val[i]  ;
+											val                  += pen_val ;
+											if (with_loss)
+												val              += segment_loss ;
 
-										float64_t mval = -(val + delta.element(delta_array, ts, ii, diff, m_seq_len, m_N)) ;
+											float64_t mval = -(val + delta.element(delta_array, ts, ii, diff, m_seq_len, m_N)) ;
 
-										/* only place -val in fixedtempvv if it is one of the nbest lowest values in there */
-										/* fixedtempvv[i], i=0:nbest-1, is sorted so that fixedtempvv[0] <= fixedtempvv[1] <= ...*/
-										/* fixed_list_len has the number of elements in fixedtempvv */
+											/* only place -val in fixedtempvv if it is one of the nbest lowest values in there */
+											/* fixedtempvv[i], i=0:nbest-1, is sorted so that fixedtempvv[0] <= fixedtempvv[1] <= ...*/
+											/* fixed_list_len has the number of elements in fixedtempvv */
 
-										if ((fixed_list_len < nbest) || ((0==fixed_list_len) || (mval < fixedtempvv[fixed_list_len-1])))
-										{
-											if ( (fixed_list_len<nbest) && ((0==fixed_list_len) || (mval>fixedtempvv[fixed_list_len-1])) )
+											if ((fixed_list_len < nbest) || ((0==fixed_list_len) || (mval < fixedtempvv[fixed_list_len-1])))
 											{
-												fixedtempvv[fixed_list_len] = mval ;
-												fixedtempii[fixed_list_len] = ii + diff*m_N + ts*m_N*nbest;
-												fixed_list_len++ ;
-											}
-											else  // must have mval < fixedtempvv[fixed_list_len-1]
-											{
-												int32_t addhere = fixed_list_len;
-												while ((addhere > 0) && (mval < fixedtempvv[addhere-1]))
-													addhere--;
-
-												// move everything from addhere+1 one forward
-												for (int32_t jj=fixed_list_len-1; jj>addhere; jj--)
+												if ( (fixed_list_len<nbest) && ((0==fixed_list_len) || (mval>fixedtempvv[fixed_list_len-1])) )
 												{
-													fixedtempvv[jj] = fixedtempvv[jj-1];
-													fixedtempii[jj] = fixedtempii[jj-1];
+													fixedtempvv[fixed_list_len] = mval ;
+													fixedtempii[fixed_list_len] = ii + diff*m_N + ts*m_N*nbest;
+													fixed_list_len++ ;
+												}
+												else  // must have mval < fixedtempvv[fixed_list_len-1]
+												{
+													int32_t addhere = fixed_list_len;
+													while ((addhere > 0) && (mval < fixedtempvv[addhere-1]))
+														addhere--;
+
+													// move everything from addhere+1 one forward
+													for (int32_t jj=fixed_list_len-1; jj>addhere; jj--)
+													{
+														fixedtempvv[jj] = fixedtempvv[jj-1];
+														fixedtempii[jj] = fixedtempii[jj-1];
+													}
+
+													fixedtempvv[addhere] = mval;
+													fixedtempii[addhere] = ii + diff*m_N + ts*m_N*nbest;
+
+													if (fixed_list_len < nbest)
+														fixed_list_len++;
 												}
-
-												fixedtempvv[addhere] = mval;
-												fixedtempii[addhere] = ii + diff*m_N + ts*m_N*nbest;
-
-												if (fixed_list_len < nbest)
-													fixed_list_len++;
 											}
 										}
 									}
-								}
 #ifdef DYNPROG_TIMING_DETAIL
-								MyTime.stop() ;
-								inner_loop_max_time += MyTime.time_diff_sec() ;
+									MyTime.stop() ;
+									inner_loop_max_time += MyTime.time_diff_sec() ;
 #endif
+								}
 							}
 						}
 #ifdef DYNPROG_TIMING
@@ -1592,7 +1661,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 					{
 						T_STATES ii = elem_list[i] ;
 
-						const auto penalty = PEN[index_N(j,ii)]->as<PlifBase>() ;
+						const auto& penalty = PEN[index_N(j,ii)] ;
 
 						/*int32_t look_back = max_look_back ;
 						  if (0)
@@ -1881,6 +1950,8 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 				}
 			}
 		}
+		} // parallel region
+
 		{ //termination
 			int32_t list_len = 0 ;
 			for (int16_t diff=0; diff<nbest; diff++)
@@ -1953,9 +2024,6 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		//if (is_big)
 		io::print("Timing:  orf={:1.2f} s \n Segment_init={:1.2f} s Segment_pos={:1.2f} s  Segment_extend={:1.2f} s Segment_clean={:1.2f} s\nsvm_init={:1.2f} s  svm_pos={:1.2f}  svm_clean={:1.2f}\n  content_svm_values_time={:1.2f}  content_plifs_time={:1.2f}\ninner_loop_max_time={:1.2f} inner_loop={:1.2f} long_transition_time={:1.2f}\n total={:1.2f}\n", orf_time, segment_init_time, segment_pos_time, segment_extend_time, segment_clean_time, svm_init_time, svm_pos_time, svm_clean_time, content_svm_values_time, content_plifs_time, inner_loop_max_time, inner_loop_time, long_transition_time, MyTime2.time_diff_sec());
 #endif
-
-		SG_FREE(fixedtempvv);
-		SG_FREE(fixedtempii);
 	}
 
 
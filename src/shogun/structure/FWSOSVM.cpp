@@ -104,11 +104,11 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 		w_s.zero();
 		ell_s = 0;
 
-		for (int32_t si = 0; si < N; ++si)
+		// 1) solve the loss-augmented inference for all points, w is fixed
+		// during the pass so the points are solved in batches
+		m_model->for_each_argmax(m_w, true,
+			[&](int32_t, const std::shared_ptr<ResultSet>& result)
 		{
-			// 1) solve the loss-augmented inference for point si
-			auto result = m_model->argmax(m_w, si);
-
 			// 2) get the subgradient
 			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
 			SGVector<float64_t> psi_i(M);
@@ -137,10 +137,7 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 			// 4) update w_s and ell_s
 			linalg::add(w_s, psi_i, w_s);
 			ell_s += loss_i;
-
-
-
-		} // end si
+		}); // end si
 
 		w_s.scale(1.0 / (N*m_lambda));
 		ell_s /= N;
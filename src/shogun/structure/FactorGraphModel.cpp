@@ -332,11 +332,11 @@ std::shared_ptr<ResultSet> FactorGraphModel::argmax(SGVector<float64_t> w, int32
 		}
 	}
 
-	MAPInference infer_met(fg, m_inf_type);
-	infer_met.inference();
+	auto infer_met = get_inference(feat_idx, fg);
+	infer_met->inference();
 
 	// y_star
-	auto y_star = infer_met.get_structured_outputs();
+	auto y_star = infer_met->get_structured_outputs();
 	SGVector<int32_t> states_star = y_star->get_data();
 
 	io::info("Argmax: ", y_star->to_string());
@@ -372,6 +372,37 @@ std::shared_ptr<ResultSet> FactorGraphModel::argmax(SGVector<float64_t> w, int32
 	return ret;
 }
 
+std::vector<std::shared_ptr<ResultSet>> FactorGraphModel::argmax_batch(
+		SGVector<float64_t> w, SGVector<int32_t> feat_idx, bool const training)
+{
+	if (m_verbose)
+		return StructuredModel::argmax_batch(w, feat_idx, training);
+
+	// with the parameters and the inference cache in place, argmax only
+	// modifies the factor graph and the inference of its example
+	w_to_fparams(w);
+	m_inference_cache.resize(m_features->get_num_vectors());
+	return parallel_argmax(feat_idx, [&](int32_t idx) { return argmax(w, idx, training); });
+}
+
+std::shared_ptr<MAPInference> FactorGraphModel::get_inference(
+		int32_t feat_idx, const std::shared_ptr<FactorGraph>& fg)
+{
+	if (m_inf_type != GRAPH_CUT)
+		return std::make_shared<MAPInference>(fg, m_inf_type);
+
+	// graph cuts continue from the flow of the previous inference on the
+	// same factor graph, whose energies only change with w
+	if (m_inference_cache.size() != (size_t)m_features->get_num_vectors())
+		m_inference_cache.resize(m_features->get_num_vectors());
+
+	auto& cached = m_inference_cache[feat_idx];
+	if (cached.first != fg)
+		cached = std::make_pair(fg, std::make_shared<MAPInference>(fg, m_inf_type));
+
+	return cached.second;
+}
+
 float64_t FactorGraphModel::delta_loss(std::shared_ptr<StructuredData> y1, std::shared_ptr<StructuredData> y2)
 {
 	auto y_truth = y1->as<FactorGraphObservation>();
@@ -13,6 +13,9 @@
 #include <shogun/structure/FactorType.h>
 #include <shogun/structure/MAPInference.h>
 
+#include <utility>
+#include <vector>
+
 namespace shogun
 {
 
@@ -116,6 +119,21 @@ public:
 	 */
 	std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) override;
 
+	/**
+	 * obtains the argmax of several examples. The factor parameters are
+	 * set once, then the examples, which have their own factor graphs,
+	 * are solved in parallel (one after the other if verbose).
+	 *
+	 * @param w weight vector
+	 * @param feat_idx indices of the features, which have to be distinct
+	 * @param training see argmax()
+	 *
+	 * @return results in the order of feat_idx
+	 */
+	std::vector<std::shared_ptr<ResultSet>> argmax_batch(
+			SGVector< float64_t > w, SGVector< int32_t > feat_idx,
+			bool const training = true) override;
+
 	/** computes \f$ \Delta(y_{1}, y_{2}) \f$
 	 *
 	 * @param y1 an instance of structured data
@@ -164,6 +182,13 @@ private:
 	 */ 
 	void add_map(const std::shared_ptr<FactorType>& ftype);
 
+	/** @return MAP inference for the factor graph of an example, which is
+	 * kept across calls for inference types that reuse their previous
+	 * solution
+	 */
+	std::shared_ptr<MAPInference> get_inference(
+		int32_t feat_idx, const std::shared_ptr<FactorGraph>& fg);
+
 protected:
 	/** array of factor types */
 	std::vector<std::shared_ptr<FactorType>> m_factor_types;
@@ -179,6 +204,10 @@ protected:
 
 	/** whether print verbose information */
 	bool m_verbose;
+
+	/** MAP inference of each example with the factor graph it was built for */
+	std::vector<std::pair<std::shared_ptr<FactorGraph>,
+		std::shared_ptr<MAPInference>>> m_inference_cache;
 };
 
 }
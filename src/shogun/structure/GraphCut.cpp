@@ -60,11 +60,19 @@ void GraphCut::init()
 	m_active_last[1] = NULL;
 	m_orphan_first = NULL;
 	m_orphan_last = NULL;
+	m_orphan_arena.clear();
+	m_orphan_free = NULL;
 
 	m_timestamp = 0;
 	m_flow = 0;
 	m_map_energy = 0;
 
+	m_maxflow_computed = false;
+	m_updating = false;
+	m_factor_tweights.clear();
+	m_factor_caps.clear();
+	m_num_factor_edges = 0;
+
 	if (m_fg == NULL)
 		return;
 
@@ -104,6 +112,7 @@ void GraphCut::init()
 
 	// build s-t graph
 	build_st_graph(m_num_nodes, max_num_edges);
+	m_factor_tweights.assign(m_num_nodes, 0);
 
 	for (int32_t j = 0; j < m_fg->get_num_factors(); j++)
 	{
@@ -129,10 +138,14 @@ void GraphCut::build_st_graph(int32_t num_nodes, int32_t num_edges)
 		m_nodes[i].id = i;
 		m_nodes[i].tree_cap = 0;
 		m_nodes[i].first = NULL;
+		m_nodes[i].parent = NULL;
+		m_nodes[i].next = NULL;
+		m_nodes[i].is_marked = false;
 	}
 
 	m_num_edges = 0; // m_num_edges will be counted in add_edge()
 	m_flow = 0;
+	m_maxflow_computed = false;
 
 	m_active_first[0] = NULL;
 	m_active_last[0] = NULL;
@@ -161,6 +174,7 @@ void GraphCut::init_maxflow()
 	{
 		node_i = m_nodes + i;
 		node_i->next = NULL;
+		node_i->is_marked = false;
 		node_i->timestamp = m_timestamp;
 
 		if (node_i->tree_cap > 0)
@@ -192,9 +206,16 @@ float64_t GraphCut::inference(SGVector<int32_t> assignment)
 	        "{}::inference(): the output assignment should be prepared as"
 	        "the same size as variables!", get_name());
 
-	// compute max flow
-	init_maxflow();
-	compute_maxflow();
+	// compute max flow, from the previous one if only the energies changed
+	if (m_maxflow_computed && update_energies())
+	{
+		compute_maxflow(true);
+	}
+	else
+	{
+		init_maxflow();
+		compute_maxflow();
+	}
 
 	for (int32_t vi = 0; vi < assignment.size(); vi++)
 	{
@@ -234,11 +255,11 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 
 		if (v0 < v1)
 		{
-			add_tweights(var, v1 - v0, 0);
+			add_factor_tweights(var, v1 - v0, 0);
 		}
 		else
 		{
-			add_tweights(var, 0, v0 - v1);
+			add_factor_tweights(var, 0, v0 - v1);
 		}
 	}
 	break;
@@ -268,20 +289,20 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 		// first variabe
 		if (C > A)
 		{
-			add_tweights(var0, C - A, 0);
+			add_factor_tweights(var0, C - A, 0);
 		}
 		else
 		{
-			add_tweights(var0, 0, A - C);
+			add_factor_tweights(var0, 0, A - C);
 		}
 		// second varibale
 		if (D > C)
 		{
-			add_tweights(var1, D - C, 0);
+			add_factor_tweights(var1, D - C, 0);
 		}
 		else
 		{
-			add_tweights(var1, 0, C - D);
+			add_factor_tweights(var1, 0, C - D);
 		}
 
 		// submodular term
@@ -294,7 +315,7 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 			error("\nRegularity condition is not satisfied");
 		}
 
-		add_edge(var0, var1, term, 0);
+		add_factor_edge(var0, var1, term, 0);
 	}
 	break;
 	case 3:
@@ -320,77 +341,77 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 		{
 			if (F - B >= 0)
 			{
-				add_tweights(var0, F - B, 0);
+				add_factor_tweights(var0, F - B, 0);
 			}
 			else
 			{
-				add_tweights(var0, 0, B - F);
+				add_factor_tweights(var0, 0, B - F);
 			}
 
 			if (G - E >= 0)
 			{
-				add_tweights(var1, G - E, 0);
+				add_factor_tweights(var1, G - E, 0);
 			}
 			else
 			{
-				add_tweights(var1, 0, E - G);
+				add_factor_tweights(var1, 0, E - G);
 			}
 
 			if (D - C >= 0)
 			{
-				add_tweights(var2, D - C, 0);
+				add_factor_tweights(var2, D - C, 0);
 			}
 			else
 			{
-				add_tweights(var2, 0, C - D);
+				add_factor_tweights(var2, 0, C - D);
 			}
 
-			add_edge(var1, var2, B + C - A - D, 0);
-			add_edge(var2, var0, B + E - A - F, 0);
-			add_edge(var0, var1, C + E - A - G, 0);
+			add_factor_edge(var1, var2, B + C - A - D, 0);
+			add_factor_edge(var2, var0, B + E - A - F, 0);
+			add_factor_edge(var0, var1, C + E - A - G, 0);
 
-			add_edge(var0, id, P, 0);
-			add_edge(var1, id, P, 0);
-			add_edge(var2, id, P, 0);
-			add_edge(id, 1, P, 0);
+			add_factor_edge(var0, id, P, 0);
+			add_factor_edge(var1, id, P, 0);
+			add_factor_edge(var2, id, P, 0);
+			add_factor_edge(id, 1, P, 0);
 		}
 		else
 		{
 			if (C - G >= 0)
 			{
-				add_tweights(var0, 0, C - G);
+				add_factor_tweights(var0, 0, C - G);
 			}
 			else
 			{
-				add_tweights(var0, G - C, 0);
+				add_factor_tweights(var0, G - C, 0);
 			}
 
 			if (B - D >= 0)
 			{
-				add_tweights(var1, 0, B - D);
+				add_factor_tweights(var1, 0, B - D);
 			}
 			else
 			{
-				add_tweights(var1, D - B, 0);
+				add_factor_tweights(var1, D - B, 0);
 			}
 
 			if (E - F >= 0)
 			{
-				add_tweights(var2, 0, E - F);
+				add_factor_tweights(var2, 0, E - F);
 			}
 			else
 			{
-				add_tweights(var2, F - E, 0);
+				add_factor_tweights(var2, F - E, 0);
 			}
 
-			add_edge(var2, var1, F + G - E - H, 0);
-			add_edge(var0, var2, D + G - C - H, 0);
-			add_edge(var1, var0, D + F - B - H, 0);
+			add_factor_edge(var2, var1, F + G - E - H, 0);
+			add_factor_edge(var0, var2, D + G - C - H, 0);
+			add_factor_edge(var1, var0, D + F - B - H, 0);
 
-			add_edge(id, var0, -P, 0);
-			add_edge(id, var1, -P, 0);
-			add_edge(id, var2, -P, 0);
-			add_tweights(id, -P, 0);
+			add_factor_edge(id, var0, -P, 0);
+			add_factor_edge(id, var1, -P, 0);
+			add_factor_edge(id, var2, -P, 0);
+			add_factor_tweights(id, -P, 0);
 		}
 	}
 	break;
@@ -424,6 +445,239 @@ int32_t GraphCut::get_tripleId(SGVector<int32_t> triple)
 	return counter;
 }
 
+void GraphCut::add_factor_tweights(int32_t i, float64_t cap_source, float64_t cap_sink)
+{
+	m_factor_tweights[i] += cap_source - cap_sink;
+
+	if (!m_updating)
+		add_tweights(i, cap_source, cap_sink);
+}
+
+void GraphCut::add_factor_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity)
+{
+	if (!m_updating)
+	{
+		add_edge(i, j, capacity, reverse_capacity);
+		m_factor_caps.push_back(capacity);
+		m_factor_caps.push_back(reverse_capacity);
+		m_num_factor_edges++;
+		return;
+	}
+
+	int32_t e = m_num_factor_edges++;
+	ASSERT(2 * e < m_num_edges);
+	ASSERT(m_edges[2 * e].reverse->head->id == i && m_edges[2 * e].head->id == j);
+
+	float64_t delta = capacity - m_factor_caps[2 * e];
+	float64_t reverse_delta = reverse_capacity - m_factor_caps[2 * e + 1];
+	if (delta != 0 || reverse_delta != 0)
+		update_edge(e, delta, reverse_delta);
+
+	m_factor_caps[2 * e] = capacity;
+	m_factor_caps[2 * e + 1] = reverse_capacity;
+}
+
+bool GraphCut::update_energies()
+{
+	// the edges of order-3 factors depend on their energies, so the s-t
+	// graph is built again
+	if (m_num_factors_at_order[3] > 0)
+	{
+		SG_FREE(m_nodes);
+		SG_FREE(m_edges);
+		m_triple_list.clear();
+		init();
+		return false;
+	}
+
+	std::vector<float64_t> tweights(m_num_nodes, 0);
+	std::swap(tweights, m_factor_tweights);
+
+	m_updating = true;
+	m_num_factor_edges = 0;
+	for (const auto& fac : m_fg->get_factors())
+		add_factor(fac);
+	m_updating = false;
+
+	for (int32_t i = 0; i < m_num_nodes; i++)
+	{
+		float64_t delta = m_factor_tweights[i] - tweights[i];
+
+		if (delta > 0)
+			update_tweights(i, delta, 0);
+		else if (delta < 0)
+			update_tweights(i, 0, -delta);
+	}
+
+	return true;
+}
+
+void GraphCut::update_tweights(int32_t i, float64_t cap_source, float64_t cap_sink)
+{
+	add_tweights(i, cap_source, cap_sink);
+	mark_node(i);
+}
+
+void GraphCut::update_edge(int32_t e, float64_t capacity, float64_t reverse_capacity)
+{
+	require(e >= 0 && 2 * e < m_num_edges, "{}::update_edge(): edge {} does not exist!",
+		get_name(), e);
+
+	GCEdge* edge = m_edges + 2 * e;
+	GCEdge* edge_rev = edge->reverse;
+	GCNode* node_i = edge_rev->head;
+	GCNode* node_j = edge->head;
+
+	edge->residual_capacity += capacity;
+	edge_rev->residual_capacity += reverse_capacity;
+
+	// if the flow exceeds the new capacity, the excess is taken back which
+	// leaves a surplus at one node and a deficit at the other. Adding the
+	// excess to both terminal edges of each node balances them and changes
+	// all cuts by the same constant.
+	if (edge->residual_capacity < 0)
+	{
+		float64_t excess = -edge->residual_capacity;
+		edge->residual_capacity = 0;
+		edge_rev->residual_capacity -= excess;
+		node_i->tree_cap += excess;
+		node_j->tree_cap -= excess;
+		m_flow -= excess;
+	}
+	else if (edge_rev->residual_capacity < 0)
+	{
+		float64_t excess = -edge_rev->residual_capacity;
+		edge_rev->residual_capacity = 0;
+		edge->residual_capacity -= excess;
+		node_j->tree_cap += excess;
+		node_i->tree_cap -= excess;
+		m_flow -= excess;
+	}
+
+	mark_node(node_i->id);
+	mark_node(node_j->id);
+}
+
+void GraphCut::mark_node(int32_t i)
+{
+	ASSERT(i >= 0 && i < m_num_nodes);
+
+	// marked nodes are queued in the active list until the search trees
+	// are initialized
+	set_active(m_nodes + i);
+	m_nodes[i].is_marked = true;
+}
+
+void GraphCut::init_maxflow_reuse_trees()
+{
+	GCNode* queue = m_active_first[1];
+	GCNode* node_i;
+
+	m_active_first[0] = NULL;
+	m_active_last[0] = NULL;
+	m_active_first[1] = NULL;
+	m_active_last[1] = NULL;
+	m_orphan_first = NULL;
+	m_orphan_last = NULL;
+
+	m_timestamp++;
+
+	while ((node_i = queue) != NULL)
+	{
+		queue = node_i->next;
+		if (queue == node_i)
+		{
+			queue = NULL;
+		}
+
+		node_i->next = NULL;
+		node_i->is_marked = false;
+		set_active(node_i);
+
+		if (node_i->tree_cap == 0)
+		{
+			if (node_i->parent != NULL)
+			{
+				set_orphan_rear(node_i);
+			}
+			continue;
+		}
+
+		ETerminalType type_tree = node_i->tree_cap > 0 ? SOURCE : SINK;
+
+		if (node_i->parent == NULL || node_i->type_tree != type_tree)
+		{
+			// the node moves to the other tree, its children become orphans
+			// and the other tree can grow to it
+			node_i->type_tree = type_tree;
+
+			for (GCEdge* edge = node_i->first; edge != NULL; edge = edge->next)
+			{
+				GCNode* node_j = edge->head;
+
+				if (node_j->is_marked)
+				{
+					continue;
+				}
+
+				if (node_j->parent == edge->reverse)
+				{
+					set_orphan_rear(node_j);
+				}
+
+				float64_t residual_capacity = type_tree == SOURCE ?
+					edge->residual_capacity : edge->reverse->residual_capacity;
+
+				if (node_j->parent != NULL && node_j->type_tree != type_tree && residual_capacity > 0)
+				{
+					set_active(node_j);
+				}
+			}
+		}
+
+		node_i->parent = TERMINAL_EDGE;
+		node_i->timestamp = m_timestamp;
+		node_i->dist_terminal = 1;
+	}
+
+	// adopt the orphans
+	GCNodePtr* np;
+
+	while ((np = m_orphan_first) != NULL)
+	{
+		m_orphan_first = np->next;
+		node_i = np->ptr;
+		delete_orphan_ptr(np);
+
+		if (m_orphan_first == NULL)
+		{
+			m_orphan_last = NULL;
+		}
+
+		process_orphan(node_i, node_i->type_tree);
+	}
+}
+
+GCNodePtr* GraphCut::new_orphan_ptr()
+{
+	GCNodePtr* np = m_orphan_free;
+
+	if (np != NULL)
+	{
+		m_orphan_free = np->next;
+		return np;
+	}
+
+	m_orphan_arena.emplace_back();
+	return &m_orphan_arena.back();
+}
+
+void GraphCut::delete_orphan_ptr(GCNodePtr* np)
+{
+	np->next = m_orphan_free;
+	m_orphan_free = np;
+}
+
 void GraphCut::add_tweights(int32_t i, float64_t cap_source, float64_t cap_sink)
 {
 	ASSERT(i >= 0 && i < m_num_nodes);
@@ -533,11 +787,18 @@ GCNode* GraphCut::next_active()
 	}
 }
 
-float64_t GraphCut::compute_maxflow()
+float64_t GraphCut::compute_maxflow(bool reuse_trees)
 {
 	GCNode* current_node = NULL;
 	bool active_set_found = true;
 
+	if (reuse_trees)
+	{
+		require(m_maxflow_computed, "{}::compute_maxflow(): there are no search "
+			"trees to reuse before the first max flow!", get_name());
+		init_maxflow_reuse_trees();
+	}
+
 	// start the main loop
 	while (true)
 	{
@@ -571,6 +832,8 @@ float64_t GraphCut::compute_maxflow()
 	if (env()->io()->get_loglevel() <= io::MSG_DEBUG)
 		test_consistency();
 
+	m_maxflow_computed = true;
+
 	return m_flow;
 }
 
@@ -795,7 +1058,7 @@ void GraphCut::adopt()
 		{
 			m_orphan_first = np->next;
 			node_i = np->ptr;
-			SG_FREE(np);
+			delete_orphan_ptr(np);
 
 			if (m_orphan_first == NULL)
 			{
@@ -813,7 +1076,7 @@ void GraphCut::set_orphan_front(GCNode* node_i)
 {
 	GCNodePtr* np;
 	node_i->parent = ORPHAN_EDGE;
-	np = SG_MALLOC(GCNodePtr, 1);
+	np = new_orphan_ptr();
 	np->ptr = node_i;
 	np->next = m_orphan_first;
 	m_orphan_first = np;
@@ -823,7 +1086,7 @@ void GraphCut::set_orphan_rear(GCNode* node_i)
 {
 	GCNodePtr* np;
 	node_i->parent = ORPHAN_EDGE;
-	np = SG_MALLOC(GCNodePtr, 1);
+	np = new_orphan_ptr();
 	np->ptr = node_i;
 
 	if (m_orphan_last != NULL)
@@ -14,6 +14,9 @@
 #include <shogun/structure/Factor.h>
 #include <shogun/structure/MAPInference.h>
 
+#include <deque>
+#include <vector>
+
 /* special constants for node->parent. */
 #define TERMINAL_EDGE ( (GCEdge *) 1 ) // to terminal
 #define ORPHAN_EDGE   ( (GCEdge *) 2 ) // orphan
@@ -74,6 +77,8 @@ struct GCNode
 	 * of the edge SOURCE->node otherwise -tree_cap is
 	 * residual capacity of the edge node->SINK */
 	float64_t tree_cap;
+	/** whether the node changed since the last max flow */
+	bool is_marked;
 };
 
 /** @brief Graph guts node pointer
@@ -96,6 +101,14 @@ struct GCNodePtr
  * In IEEE Transactions on Pattern Analysis and Machine Intelligence (PAMI), 2004.
  *
  * Currently, only binary lablel is supported, factor order <= 3
+ *
+ * Repeated inference on the same factor graph reads the changed factor
+ * energies and reuses the flow and the search trees of the previous call
+ * instead of starting from scratch:
+ *
+ * "Dynamic Graph Cuts for Efficient Inference in Markov Random Fields."
+ * Pushmeet Kohli and Philip H. S. Torr.
+ * In IEEE Transactions on Pattern Analysis and Machine Intelligence (PAMI), 2007.
  */
 class GraphCut : public MAPInferImpl
 {
@@ -172,6 +185,33 @@ public:
 	/** Initialize max flow, call this function after adding nodes and edges */
 	void init_maxflow();
 
+	/** Changes the terminal capacities of node 'i' after a max flow has been
+	 * computed, like add_tweights, and marks the node for compute_maxflow(true).
+	 *
+	 * @param i node id i
+	 * @param cap_source change of the SOURCE->i capacity
+	 * @param cap_sink change of the i->SINK capacity
+	 */
+	void update_tweights(int32_t i, float64_t cap_source, float64_t cap_sink);
+
+	/** Changes the capacities of the edge added by the e-th call of add_edge
+	 * after a max flow has been computed, and marks its nodes for
+	 * compute_maxflow(true). Flow exceeding a reduced capacity is moved to
+	 * the terminal edges of the nodes, which changes the flow by a constant.
+	 *
+	 * @param e edge index, in the order of add_edge
+	 * @param capacity change of the edge capacity
+	 * @param reverse_capacity change of the reverse edge capacity
+	 */
+	void update_edge(int32_t e, float64_t capacity, float64_t reverse_capacity);
+
+	/** Marks node 'i' as changed, the next compute_maxflow(true) rebuilds
+	 * the search trees around the marked nodes only.
+	 *
+	 * @param i node id
+	 */
+	void mark_node(int32_t i);
+
 	/** Compute the maxflow
 	 *
 	 * The algorithm builds up two search trees, a source-tree and a sink-tree.
@@ -196,9 +236,13 @@ public:
 	 * terminates when the search tree cannot grow (no active nodes) and the trees are seperated by
 	 * saturated edges. This implies that a maximum flow is achieved.
 	 *
+	 * @param reuse_trees continue from the flow and the search trees of the previous
+	 * call instead of those of init_maxflow(), after the capacities were changed
+	 * with update_tweights, update_edge or mark_node
+	 *
 	 * @return the total flow after computing max flow
 	 */
-	float64_t compute_maxflow();
+	float64_t compute_maxflow(bool reuse_trees = false);
 
 	/** After the maxflow is computed, this function returns to which
 	 * terminal the node 'i' belongs (ETerminalType::SOURCE or ETerminalType::SINK).
@@ -239,6 +283,31 @@ private:
 	 */
 	int32_t get_tripleId(SGVector<int32_t> triple);
 
+	/** Adds terminal capacities of a factor, or records them when updating */
+	void add_factor_tweights(int32_t i, float64_t cap_source, float64_t cap_sink);
+
+	/** Adds an edge of a factor, or updates its capacities when updating */
+	void add_factor_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity);
+
+	/** Applies the changes of the factor energies to the s-t graph
+	 *
+	 * @return whether the previous flow and search trees can be reused,
+	 * otherwise the s-t graph has been rebuilt
+	 */
+	bool update_energies();
+
+	/** Initialize max flow from the previous search trees and the marked nodes */
+	void init_maxflow_reuse_trees();
+
+	/** @return an orphan list entry from the arena */
+	GCNodePtr* new_orphan_ptr();
+
+	/** Returns an orphan list entry to the arena
+	 *
+	 * @param np the entry
+	 */
+	void delete_orphan_ptr(GCNodePtr* np);
+
 	/** Add a node to the active list
 	 *
 	 * node_i->next points to the next node in the list
@@ -333,6 +402,21 @@ private:
 	GCNodePtr*	m_orphan_first;
 	/** list of pointers to orphans */
 	GCNodePtr*	m_orphan_last;
+	/** storage of the orphan list entries */
+	std::deque<GCNodePtr> m_orphan_arena;
+	/** list of unused orphan list entries */
+	GCNodePtr*	m_orphan_free;
+
+	/** whether a max flow has been computed on the s-t graph */
+	bool		m_maxflow_computed;
+	/** whether the factors update the s-t graph instead of building it */
+	bool		m_updating;
+	/** net SOURCE->i capacity of each node from the factors */
+	std::vector<float64_t> m_factor_tweights;
+	/** capacity and reverse capacity of each edge from the factors */
+	std::vector<float64_t> m_factor_caps;
+	/** number of edges added by the factors */
+	int32_t		m_num_factor_edges;
 };
 
 }
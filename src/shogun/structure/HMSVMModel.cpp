@@ -77,16 +77,20 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 
 	// Translate from labels sequence to state sequence
 	SGVector< int32_t > state_seq = m_state_model->labels_to_states(label_seq);
-	m_transmission_weights.zero();
+	// The counts are local so that argmax_batch can decode concurrently
+	SGMatrix< float64_t > transmission_weights(
+			m_transmission_weights.num_rows, m_transmission_weights.num_cols);
+	transmission_weights.zero();
 
 	for ( int32_t i = 0 ; i < state_seq.vlen-1 ; ++i )
-		m_transmission_weights(state_seq[i],state_seq[i+1]) += 1;
+		transmission_weights(state_seq[i],state_seq[i+1]) += 1;
 
 	SGMatrix< float64_t > obs = mf->get_feature_vector(feat_idx);
 	require(obs.num_rows == D && obs.num_cols == state_seq.vlen,
 		"obs.num_rows ({}) != D ({}) OR obs.num_cols ({}) != state_seq.vlen ({})",
 		obs.num_rows, D, obs.num_cols, state_seq.vlen);
-	m_emission_weights.zero();
+	SGVector< float64_t > emission_weights(m_emission_weights.vlen);
+	emission_weights.zero();
 	index_t aux_idx, weight_idx;
 
 	if ( !m_use_plifs )	// Do not use PLiFs
@@ -98,11 +102,11 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			for ( int32_t j = 0 ; j < state_seq.vlen ; ++j )
 			{
 				weight_idx = aux_idx + state_seq[j]*D*m_num_obs + obs(f,j);
-				m_emission_weights[weight_idx] += 1;
+				emission_weights[weight_idx] += 1;
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_obs);
 	}
 	else	// Use PLiFs
@@ -133,15 +137,15 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 				weight_idx = aux_idx + state_seq[j]*D*m_num_plif_nodes;
 
 				if ( count == 0 )
-					m_emission_weights[weight_idx] += 1;
+					emission_weights[weight_idx] += 1;
 				else if ( count == m_num_plif_nodes )
-					m_emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
+					emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
 				else
 				{
-					m_emission_weights[weight_idx + count] +=
+					emission_weights[weight_idx + count] +=
 						(value-limits[count-1]) / (limits[count]-limits[count-1]);
 
-					m_emission_weights[weight_idx + count-1] +=
+					emission_weights[weight_idx + count-1] +=
 						(limits[count]-value) / (limits[count]-limits[count-1]);
 				}
 
@@ -149,7 +153,7 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_plif_nodes);
 	}
 
@@ -160,6 +164,22 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 		SGVector< float64_t > w,
 		int32_t feat_idx,
 		bool const training)
+{
+	set_viterbi_weights(w);
+	return viterbi(w, feat_idx, training);
+}
+
+std::vector<std::shared_ptr<ResultSet>> HMSVMModel::argmax_batch(
+		SGVector< float64_t > w,
+		SGVector< int32_t > feat_idx,
+		bool const training)
+{
+	// The weights are shared by all examples, the decoding only reads them
+	set_viterbi_weights(w);
+	return parallel_argmax(feat_idx, [&](int32_t idx) { return viterbi(w, idx, training); });
+}
+
+void HMSVMModel::set_viterbi_weights(SGVector< float64_t > w)
 {
 	ASSERT(w.vlen == get_dim())
 
@@ -169,12 +189,31 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	// Shorthand for the number of states
 	int32_t S = m_state_model->get_num_states();
 
-	if ( m_use_plifs )
+	if ( !m_use_plifs )
+	{
+		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
+	}
+	else
 	{
 		require(m_plif_matrix.size() == S*D, "Dimension mismatch in PLiF matrix, have the "
 				"feature dimension and/or number of states changed from training to prediction?");
+		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
 	}
 
+	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+}
+
+std::shared_ptr<ResultSet> HMSVMModel::viterbi(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		bool const training)
+{
+	// Shorthand for the number of features of the feature vector
+	auto mf = m_features->as<MatrixFeatures<float64_t>>();
+	int32_t D = mf->get_num_features();
+	// Shorthand for the number of states
+	int32_t S = m_state_model->get_num_states();
+
 	// Distribution of start states
 	SGVector< float64_t > p = m_state_model->get_start_states();
 	// Distribution of stop states
@@ -192,7 +231,6 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	if ( !m_use_plifs )	// Do not use PLiFs
 	{
 		index_t em_idx;
-		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
 
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
@@ -208,8 +246,6 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	}
 	else	// Use PLiFs
 	{
-		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
-
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
 			for ( int32_t f = 0 ; f < D ; ++f )
@@ -248,7 +284,6 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	// Initialize the dynamic programming table and the traceback matrix
 	SGMatrix< float64_t >  dp(T, S);
 	SGMatrix< float64_t > trb(T, S);
-	m_state_model->reshape_transmission_params(m_transmission_weights, w);
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
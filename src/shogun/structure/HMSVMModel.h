@@ -78,6 +78,20 @@ class HMSVMModel : public StructuredModel
 		 */
 		std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) override;
 
+		/**
+		 * obtains the argmax of several examples, which are decoded in
+		 * parallel
+		 *
+		 * @param w weight vector
+		 * @param feat_idx indices of the features
+		 * @param training see argmax()
+		 *
+		 * @return results in the order of feat_idx
+		 */
+		std::vector<std::shared_ptr<ResultSet>> argmax_batch(
+				SGVector< float64_t > w, SGVector< int32_t > feat_idx,
+				bool const training = true) override;
+
 		/** computes \f$ \Delta(y_{1}, y_{2}) \f$
 		 *
 		 * @param y1 an instance of structured data
@@ -172,6 +186,24 @@ class HMSVMModel : public StructuredModel
 		/* internal initialization */
 		void init();
 
+		/** sets the transmission and emission weights (or the PLiFs) used
+		 * in Viterbi from a weight vector
+		 *
+		 * @param w weight vector
+		 */
+		void set_viterbi_weights(SGVector< float64_t > w);
+
+		/** Viterbi decoding of an example with the weights of the last
+		 * set_viterbi_weights(), only reads the state of the model
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the feature
+		 * @param training see argmax()
+		 *
+		 * @return structure with the predicted output
+		 */
+		std::shared_ptr<ResultSet> viterbi(SGVector< float64_t > w, int32_t feat_idx, bool const training);
+
 	private:
 		/** in case of discrete observations, the cardinality of the space of observations */
 		int32_t m_num_obs;
@@ -6,6 +6,7 @@
 
 
 #include <stdio.h>
+#include <algorithm>
 
 #include <shogun/lib/config.h>
 #include <shogun/io/SGIO.h>
@@ -115,6 +116,15 @@ void Plif::delete_penalty_struct(std::vector<std::shared_ptr<Plif>>& PEN, int32_
 	PEN.clear();
 }
 
+int32_t Plif::find_limit_index(float64_t d_value) const
+{
+	// the limits are monotonically increasing, idx is the number of limits
+	// that are <= d_value
+	return std::partition_point(
+		limits.vector, limits.vector+len,
+		[d_value](float64_t limit) { return limit<=d_value; })-limits.vector ;
+}
+
 float64_t Plif::lookup_penalty_svm(
 	float64_t p_value, float64_t *d_values) const
 {
@@ -147,13 +157,8 @@ float64_t Plif::lookup_penalty_svm(
 		break ;
 	}
 
-	int32_t idx = 0 ;
 	float64_t ret ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
+	int32_t idx = find_limit_index(d_value) ;
 
 #ifdef PLIF_DEBUG
 	io::print("  -> idx = {} ", idx);
@@ -243,13 +248,8 @@ float64_t Plif::lookup_penalty(float64_t p_value, float64_t* svm_values) const
 	io::print("  -> value = {:1.4f} ", d_value);
 #endif
 
-	int32_t idx = 0 ;
 	float64_t ret ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
+	int32_t idx = find_limit_index(d_value) ;
 
 #ifdef PLIF_DEBUG
 	io::print("  -> idx = {} ", idx);
@@ -316,12 +316,7 @@ void Plif::penalty_add_derivative(float64_t p_value, float64_t* svm_values, floa
 		break ;
 	}
 
-	int32_t idx = 0 ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
+	int32_t idx = find_limit_index(d_value) ;
 
 	if (idx==0)
 		cum_derivatives[0]+= factor ;
@@ -363,12 +358,7 @@ void Plif::penalty_add_derivative_svm(float64_t p_value, float64_t *d_values, fl
 		break ;
 	}
 
-	int32_t idx = 0 ;
-	for (int32_t i=0; i<len; i++)
-		if (limits[i]<=d_value)
-			idx++ ;
-		else
-			break ; // assume it is monotonically increasing
+	int32_t idx = find_limit_index(d_value) ;
 
 	if (idx==0)
 		cum_derivatives[0]+=factor ;
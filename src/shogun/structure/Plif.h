@@ -417,6 +417,13 @@ class Plif: public PlifBase
 		const char* get_name() const override { return "Plif"; }
 
 	protected:
+		/** binary search for the interval of a transformed value
+		 *
+		 * @param d_value transformed value
+		 * @return number of limits that are <= d_value
+		 */
+		int32_t find_limit_index(float64_t d_value) const;
+
 		/** len */
 		int32_t len;
 		/** limits */
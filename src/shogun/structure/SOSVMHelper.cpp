@@ -57,21 +57,18 @@ float64_t SOSVMHelper::primal_objective(SGVector<float64_t> w, const std::shared
 	int32_t N = labels->get_num_labels();
 
 
-	for (int32_t i = 0; i < N; i++)
-	{
-		// solve the loss-augmented inference for point i
-		auto result = model->argmax(w, i);
-
-		// hinge loss for point i
-		float64_t hinge_loss_i = result->score;
-
-		if (hinge_loss_i < 0)
-			hinge_loss_i = 0;
+	// solve the loss-augmented inference for all points
+	model->for_each_argmax(w, true,
+		[&hinge_losses](int32_t, const std::shared_ptr<ResultSet>& result)
+		{
+			// hinge loss for point i
+			float64_t hinge_loss_i = result->score;
 
-		hinge_losses += hinge_loss_i;
+			if (hinge_loss_i < 0)
+				hinge_loss_i = 0;
 
-
-	}
+			hinge_losses += hinge_loss_i;
+		});
 
 	return (lbda/2 * linalg::dot(w, w) + hinge_losses/N);
 }
@@ -88,15 +85,12 @@ float64_t SOSVMHelper::average_loss(SGVector<float64_t> w, const std::shared_ptr
 	int32_t N = labels->get_num_labels();
 
 
-	for (int32_t i = 0; i < N; i++)
-	{
-		// solve the standard inference for point i
-		auto result = model->argmax(w, i, is_ub);
-
-		loss += result->delta;
-
-
-	}
+	// solve the standard inference for all points
+	model->for_each_argmax(w, is_ub,
+		[&loss](int32_t, const std::shared_ptr<ResultSet>& result)
+		{
+			loss += result->delta;
+		});
 
 	return loss / N;
 }
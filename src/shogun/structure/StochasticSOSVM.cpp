@@ -8,9 +8,12 @@
 #include <shogun/base/progress.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 StochasticSOSVM::StochasticSOSVM()
@@ -45,11 +48,13 @@ void StochasticSOSVM::init()
 	SG_ADD(&m_num_iter, "num_iter", "Number of iterations");
 	SG_ADD(&m_do_weighted_averaging, "do_weighted_averaging", "Do weighted averaging");
 	SG_ADD(&m_debug_multiplier, "debug_multiplier", "Debug multiplier");
+	SG_ADD(&m_batch_size, "batch_size", "Number of examples per update");
 
 	m_lambda = 1.0;
 	m_num_iter = 50;
 	m_do_weighted_averaging = true;
 	m_debug_multiplier = 0;
+	m_batch_size = 1;
 }
 
 StochasticSOSVM::~StochasticSOSVM()
@@ -95,10 +100,14 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 		m_helper = std::make_shared<SOSVMHelper>();
 	}
 
+	// Number of examples per update and of updates per pass
+	int32_t batch_size = Math::min(m_batch_size, N);
+	int32_t num_batches = (N + batch_size - 1) / batch_size;
+
 	int32_t debug_iter = 1;
 	if (m_debug_multiplier == 0)
 	{
-		debug_iter = N;
+		debug_iter = num_batches;
 		m_debug_multiplier = 100;
 	}
 
@@ -107,39 +116,49 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 	UniformIntDistribution<int32_t> uniform_int_dist;
 	for (auto pi : SG_PROGRESS(range(m_num_iter)))
 	{
-		for (int32_t si = 0; si < N; ++si)
+		for (int32_t si = 0; si < num_batches; ++si)
 		{
-			// 1) Picking random example
-			int32_t i = uniform_int_dist(m_prng, {0, N-1});
+			// 1) Picking random distinct examples
+			SGVector<int32_t> batch(batch_size);
+			for (int32_t b = 0; b < batch_size; ++b)
+			{
+				int32_t i;
+				do
+					i = uniform_int_dist(m_prng, {0, N-1});
+				while (std::find(batch.vector, batch.vector+b, i) != batch.vector+b);
+				batch[b] = i;
+			}
 
-			// 2) solve the loss-augmented inference for point i
-			auto result = m_model->argmax(m_w, i);
+			// 2) solve the loss-augmented inference for the examples
+			auto results = m_model->argmax_batch(m_w, batch);
 
-			// 3) get the subgradient
+			// 3) get the subgradient, summed over the examples
 			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
 			SGVector<float64_t> psi_i(M);
 			SGVector<float64_t> w_s(M);
+			psi_i.zero();
 
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
+			for (const auto& result : results)
 			{
-				error("model({}) should have either of psi_computed or psi_computed_sparse"
-						"to be set true", m_model->get_name());
+				if (result->psi_computed)
+				{
+					linalg::add(psi_i, result->psi_truth, psi_i);
+					linalg::add(psi_i, result->psi_pred, psi_i, 1.0, -1.0);
+				}
+				else if(result->psi_computed_sparse)
+				{
+					result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
+					result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
+				}
+				else
+				{
+					error("model({}) should have either of psi_computed or psi_computed_sparse"
+							"to be set true", m_model->get_name());
+				}
 			}
 
 			w_s = psi_i.clone();
-			w_s.scale(1.0 / (N*m_lambda));
+			w_s.scale(1.0 / (N*m_lambda*batch_size));
 
 			// 4) step-size gamma
 			float64_t gamma = 1.0 / (k+1.0);
@@ -174,9 +193,9 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 				SG_DEBUG("pass {} (iteration {}), SVM primal = {}, train_error = {} ",
 					pi, k, primal, train_error);
 
-				m_helper->add_debug_info(primal, (1.0*k) / N, train_error);
+				m_helper->add_debug_info(primal, (1.0*k*batch_size) / N, train_error);
 
-				debug_iter = Math::min(debug_iter+N, debug_iter*(1+m_debug_multiplier/100));
+				debug_iter = Math::min(debug_iter+num_batches, debug_iter*(1+m_debug_multiplier/100));
 			}
 		}
 	}
@@ -221,3 +240,14 @@ void StochasticSOSVM::set_debug_multiplier(int32_t multiplier)
 	m_debug_multiplier = multiplier;
 }
 
+int32_t StochasticSOSVM::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void StochasticSOSVM::set_batch_size(int32_t batch_size)
+{
+	require(batch_size > 0, "Batch size ({}) must be positive", batch_size);
+	m_batch_size = batch_size;
+}
+
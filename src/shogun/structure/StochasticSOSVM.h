@@ -82,6 +82,19 @@ public:
 	 */
 	void set_debug_multiplier(int32_t multiplier);
 
+	/** @return number of examples per update */
+	int32_t get_batch_size() const;
+
+	/** set the number of examples per update. The loss-augmented
+	 * inference of the examples of a minibatch is solved with
+	 * StructuredModel::argmax_batch(), in parallel for models that
+	 * support it, and the weights are updated with the average
+	 * subgradient.
+	 *
+	 * @param batch_size number of distinct examples per update
+	 */
+	void set_batch_size(int32_t batch_size);
+
 protected:
 	/** train primal SO-SVM
 	 *
@@ -112,6 +125,9 @@ private:
 	 */
 	int32_t m_debug_multiplier;
 
+	/** Number of examples per update (default: 1) */
+	int32_t m_batch_size;
+
 }; /* CStochasticSOSVM */
 
 } /* namespace shogun */
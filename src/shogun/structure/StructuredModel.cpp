@@ -7,6 +7,8 @@
 
 #include <shogun/structure/StructuredModel.h>
 
+#include <algorithm>
+#include <exception>
 #include <utility>
 
 using namespace shogun;
@@ -184,3 +186,59 @@ int32_t StructuredModel::get_num_aux_con() const
 {
 	return 0;
 }
+
+std::vector<std::shared_ptr<ResultSet>> StructuredModel::argmax_batch(
+		SGVector< float64_t > w, SGVector< int32_t > feat_idx,
+		bool const training)
+{
+	std::vector<std::shared_ptr<ResultSet>> results(feat_idx.vlen);
+	for (index_t i = 0; i < feat_idx.vlen; ++i)
+		results[i] = argmax(w, feat_idx[i], training);
+
+	return results;
+}
+
+void StructuredModel::for_each_argmax(
+		SGVector< float64_t > w, bool const training,
+		const std::function<void(int32_t, const std::shared_ptr<ResultSet>&)>& fn)
+{
+	int32_t num_examples = m_features->get_num_vectors();
+	// enough examples per batch to keep all threads busy
+	int32_t batch_size = std::max(env()->get_num_threads(), 1) * 32;
+
+	for (int32_t from = 0; from < num_examples; from += batch_size)
+	{
+		SGVector<int32_t> feat_idx(std::min(batch_size, num_examples - from));
+		feat_idx.range_fill(from);
+
+		auto results = argmax_batch(w, feat_idx, training);
+		for (index_t i = 0; i < feat_idx.vlen; ++i)
+			fn(feat_idx[i], results[i]);
+	}
+}
+
+std::vector<std::shared_ptr<ResultSet>> StructuredModel::parallel_argmax(
+		SGVector< int32_t > feat_idx,
+		const std::function<std::shared_ptr<ResultSet>(int32_t)>& solve) const
+{
+	std::vector<std::shared_ptr<ResultSet>> results(feat_idx.vlen);
+	std::exception_ptr exception;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < feat_idx.vlen; ++i)
+	{
+		try
+		{
+			results[i] = solve(feat_idx[i]);
+		}
+		catch (...)
+		{
+			#pragma omp critical
+			exception = std::current_exception();
+		}
+	}
+	if (exception)
+		std::rethrow_exception(exception);
+
+	return results;
+}
@@ -21,6 +21,9 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/StructuredData.h>
 
+#include <functional>
+#include <vector>
+
 namespace shogun
 {
 
@@ -236,6 +239,35 @@ class StructuredModel : public SGObject
 		 */
 		virtual std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) = 0;
 
+		/**
+		 * obtains the argmax for several examples with the same weight
+		 * vector. The default implementation calls argmax() for one example
+		 * after the other, models whose inference can run concurrently solve
+		 * the examples in parallel.
+		 *
+		 * @param w weight vector
+		 * @param feat_idx indices of the features, which have to be distinct
+		 * @param training see argmax()
+		 *
+		 * @return results in the order of feat_idx
+		 */
+		virtual std::vector<std::shared_ptr<ResultSet>> argmax_batch(
+				SGVector< float64_t > w, SGVector< int32_t > feat_idx,
+				bool const training = true);
+
+		/**
+		 * obtains the argmax of all examples with argmax_batch(), in batches
+		 * so that not all results are kept in memory at once
+		 *
+		 * @param w weight vector
+		 * @param training see argmax()
+		 * @param fn function that is called with the index and the result of
+		 * every example, in the order of the examples
+		 */
+		void for_each_argmax(
+				SGVector< float64_t > w, bool const training,
+				const std::function<void(int32_t, const std::shared_ptr<ResultSet>&)>& fn);
+
 		/** computes \f$ \Delta(y_{\text{true}}, y_{\text{pred}}) \f$
 		 *
 		 * @param ytrue_idx index of the true label in labels
@@ -298,6 +330,20 @@ class StructuredModel : public SGObject
 		/** internal initialization */
 		void init();
 
+	protected:
+		/** solves the examples in parallel with a function that is safe
+		 * to call concurrently, exceptions are rethrown after all threads
+		 * finished
+		 *
+		 * @param feat_idx indices of the features
+		 * @param solve function that returns the result for an index
+		 *
+		 * @return results in the order of feat_idx
+		 */
+		std::vector<std::shared_ptr<ResultSet>> parallel_argmax(
+				SGVector< int32_t > feat_idx,
+				const std::function<std::shared_ptr<ResultSet>(int32_t)>& solve) const;
+
 	protected:
 		/** structured labels */
 		std::shared_ptr<StructuredLabels> m_labels;
@@ -146,6 +146,25 @@ void DomainAdaptationSVM::set_train_factor(float64_t factor)
 }
 
 
+std::shared_ptr<Labels> DomainAdaptationSVM::predict(
+	const std::shared_ptr<Features>& data) const
+{
+	require(data, "No features provided.");
+	require(presvm, "No presvm set.");
+	ASSERT(presvm->get_bias()==0.0)
+
+	const int32_t num_examples=data->get_num_vectors();
+	auto out_current=SVMLight::predict(data)->as<BinaryLabels>();
+	// recursive call if used on DomainAdaptationSVM object
+	auto out_presvm=presvm->predict(data)->as<BinaryLabels>();
+
+	SGVector<float64_t> out_combined(num_examples);
+	for (int32_t i=0; i<num_examples; i++)
+		out_combined[i]=out_current->get_value(i)+B*out_presvm->get_value(i);
+
+	return std::make_shared<BinaryLabels>(out_combined);
+}
+
 std::shared_ptr<BinaryLabels> DomainAdaptationSVM::apply_binary(std::shared_ptr<Features> data)
 {
 	ASSERT(data)
@@ -58,6 +58,15 @@ class DomainAdaptationSVM : public SVMLight
 		 */
 		std::shared_ptr<BinaryLabels> apply_binary(std::shared_ptr<Features> data=NULL) override;
 
+		/** classify without modifying the machines, the outputs of the
+		 * presvm are added like in apply_binary(), see Machine::predict()
+		 *
+		 * @param data (test)data to be classified
+		 * @return classified labels
+		 */
+		std::shared_ptr<Labels> predict(
+			const std::shared_ptr<Features>& data) const override;
+
 		/** returns SVM that is used as prior information
 		 *
 		 * @return presvm
@@ -5,6 +5,8 @@
  *          Soeren Sonnenburg, Bjoern Esser
  */
 
+#include <algorithm>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -180,25 +182,32 @@ bool LibLinearMTL::train_machine(std::shared_ptr<Features> data)
 
 void LibLinearMTL::solve_l2r_l1l2_svc(const liblinear_problem *prob, double eps, double Cp, double Cn)
 {
-
-
-
 	int l = prob->l;
 	int w_size = prob->n;
-	int i, s, iter = 0;
-	double C, d, G;
+	int i, iter = 0;
 	double *QD = SG_MALLOC(double, l);
-	int *index = SG_MALLOC(int, l);
-	//double *alpha = SG_MALLOC(double, l);
 
 	int32_t *y = SG_MALLOC(int32_t, l);
-	int active_size = l;
 	// PG: projected gradient, for shrinking and stopping
-	double PG;
 	double PGmax_old = Math::INFTY;
 	double PGmin_old = -Math::INFTY;
 	double PGmax_new, PGmin_new;
 
+	const MappedSparseMatrix& tsm = task_similarity_matrix;
+	require(
+		tsm.get_num_rows() == num_tasks,
+		"Task similarity matrix has {} rows, expected {} (number of tasks)",
+		tsm.get_num_rows(), num_tasks);
+	for (auto e_i : tsm.col_indices)
+		require(
+			e_i >= 0 && e_i < num_tasks,
+			"Task similarity matrix refers to task {}, expected ids in "
+			"[0, {})", e_i, num_tasks);
+	require(
+		task_indicator_lhs.vlen == l,
+		"Task indicator has {} entries, expected {} (number of vectors)",
+		task_indicator_lhs.vlen, l);
+
 	// matrix W
 	V = SGMatrix<float64_t>(w_size,num_tasks);
 
@@ -234,6 +243,8 @@ void LibLinearMTL::solve_l2r_l1l2_svc(const liblinear_problem *prob, double eps,
 		alphas[i] = 0;
 	}
 
+	// examples of every task, the first active_size[t] of them are active
+	std::vector<std::vector<int32_t>> index(num_tasks);
 	for(i=0; i<l; i++)
 	{
 		if(prob->y[i] > 0)
@@ -246,8 +257,21 @@ void LibLinearMTL::solve_l2r_l1l2_svc(const liblinear_problem *prob, double eps,
 		}
 		QD[i] = diag[GETI(i)];
 		QD[i] += prob->x->dot(i, prob->x,i);
-		index[i] = i;
+
+		int32_t ti = task_indicator_lhs[i];
+		require(
+			ti >= 0 && ti < num_tasks,
+			"Task {} of vector {} is not in [0, {})", ti, i, num_tasks);
+		index[ti].push_back(i);
 	}
+	std::vector<int32_t> active_size(num_tasks);
+	for (int32_t t=0; t<num_tasks; t++)
+		active_size[t] = index[t].size();
+
+	// an update of an example of task t reads the columns of V of the
+	// neighbours of t and writes column t only, so tasks that are not
+	// adjacent in the task graph can be updated concurrently
+	const auto task_colors = color_task_graph();
 
 	auto pb = SG_PROGRESS(range(10));
 	Time start_time;
@@ -261,91 +285,100 @@ void LibLinearMTL::solve_l2r_l1l2_svc(const liblinear_problem *prob, double eps,
 		PGmax_new = -Math::INFTY;
 		PGmin_new = Math::INFTY;
 
-		for (i=0; i<active_size; i++)
+		for (int32_t t=0; t<num_tasks; t++)
 		{
-			int j = uniform_int_dist(m_prng, {i, active_size-1});
-			Math::swap(index[i], index[j]);
+			for (i=0; i<active_size[t]; i++)
+			{
+				int j = uniform_int_dist(m_prng, {i, active_size[t]-1});
+				Math::swap(index[t][i], index[t][j]);
+			}
 		}
 
-		for (s=0;s<active_size;s++)
+		for (const auto& tasks : task_colors)
 		{
-			i = index[s];
-			int32_t yi = y[i];
-			int32_t ti = task_indicator_lhs[i];
-			C = upper_bound[GETI(i)];
-
-			// we compute the inner sum by looping over tasks
-			// this update is the main result of MTL_DCD
-		    typedef std::map<index_t, float64_t>::const_iterator map_iter;
-
-			float64_t inner_sum = 0;
-			for (map_iter it=task_similarity_matrix.data[ti].begin(); it!=task_similarity_matrix.data[ti].end(); it++)
+			#pragma omp parallel for schedule(dynamic) \
+				reduction(max:PGmax_new) reduction(min:PGmin_new)
+			for (size_t c=0; c<tasks.size(); c++)
 			{
+				const int32_t ti = tasks[c];
+				auto& task_index = index[ti];
+				auto& task_active_size = active_size[ti];
+				float64_t* w_ti = V.get_column_vector(ti);
 
-				// get data from sparse matrix
-				int32_t e_i = it->first;
-                float64_t sim = it->second;
-
-				// fetch vector
-				SGVector<float64_t> tmp_w = V.get_column(e_i);
-				inner_sum += sim * yi * prob->x->dot(i, tmp_w);
-
-				//possibly deal with bias
-				//if (prob->use_bias)
-				//	G+=w[n];
-			}
-
-			// compute gradient
-			G = inner_sum-1.0;
-
-			// check if point can be removed from active set
-			PG = 0;
-			if (alphas[i] == 0)
-			{
-				if (G > PGmax_old)
+				for (int32_t s=0; s<task_active_size; s++)
 				{
-					active_size--;
-					Math::swap(index[s], index[active_size]);
-					s--;
-					continue;
+					const int32_t i = task_index[s];
+					const int32_t yi = y[i];
+					const double C = upper_bound[GETI(i)];
+
+					// we compute the inner sum by looping over tasks
+					// this update is the main result of MTL_DCD
+					float64_t inner_sum = 0;
+					for (index_t k=tsm.row_offsets[ti]; k<tsm.row_offsets[ti+1]; k++)
+					{
+						// get data from sparse matrix
+						int32_t e_i = tsm.col_indices[k];
+						float64_t sim = tsm.values[k];
+
+						SGVector<float64_t> tmp_w(V.get_column_vector(e_i), w_size, false);
+						inner_sum += sim * yi * prob->x->dot(i, tmp_w);
+
+						//possibly deal with bias
+						//if (prob->use_bias)
+						//	G+=w[n];
+					}
+
+					// compute gradient
+					const double G = inner_sum-1.0;
+
+					// check if point can be removed from active set
+					double PG = 0;
+					if (alphas[i] == 0)
+					{
+						if (G > PGmax_old)
+						{
+							task_active_size--;
+							Math::swap(task_index[s], task_index[task_active_size]);
+							s--;
+							continue;
+						}
+						else if (G < 0)
+							PG = G;
+					}
+					else if (alphas[i] == C)
+					{
+						if (G < PGmin_old)
+						{
+							task_active_size--;
+							Math::swap(task_index[s], task_index[task_active_size]);
+							s--;
+							continue;
+						}
+						else if (G > 0)
+							PG = G;
+					}
+					else
+						PG = G;
+
+					PGmax_new = Math::max(PGmax_new, PG);
+					PGmin_new = Math::min(PGmin_new, PG);
+
+					if(fabs(PG) > 1.0e-12)
+					{
+						// save previous alpha
+						double alpha_old = alphas[i];
+
+						// project onto feasible set
+						alphas[i] = Math::min(Math::max(alphas[i] - G/QD[i], 0.0), C);
+						double d = (alphas[i] - alpha_old)*yi;
+
+						// update corresponding weight vector
+						prob->x->add_to_dense_vec(d, i, w_ti, n);
+
+						//if (prob->use_bias)
+						//	w[n]+=d;
+					}
 				}
-				else if (G < 0)
-					PG = G;
-			}
-			else if (alphas[i] == C)
-			{
-				if (G < PGmin_old)
-				{
-					active_size--;
-					Math::swap(index[s], index[active_size]);
-					s--;
-					continue;
-				}
-				else if (G > 0)
-					PG = G;
-			}
-			else
-				PG = G;
-
-			PGmax_new = Math::max(PGmax_new, PG);
-			PGmin_new = Math::min(PGmin_new, PG);
-
-			if(fabs(PG) > 1.0e-12)
-			{
-				// save previous alpha
-				double alpha_old = alphas[i];
-
-				// project onto feasible set
-				alphas[i] = Math::min(Math::max(alphas[i] - G/QD[i], 0.0), C);
-				d = (alphas[i] - alpha_old)*yi;
-
-				// update corresponding weight vector
-				float64_t* tmp_w = V.get_column_vector(ti);
-				prob->x->add_to_dense_vec(d, i, tmp_w, n);
-
-
-				//if (prob->use_bias)
-				//	w[n]+=d;
 			}
 		}
 
@@ -356,11 +389,16 @@ void LibLinearMTL::solve_l2r_l1l2_svc(const liblinear_problem *prob, double eps,
 
 		if(gap <= eps)
 		{
-			if(active_size == l)
+			bool all_active = true;
+			for (int32_t t=0; t<num_tasks; t++)
+				all_active &= active_size[t] == (int32_t)index[t].size();
+
+			if(all_active)
 				break;
 			else
 			{
-				active_size = l;
+				for (int32_t t=0; t<num_tasks; t++)
+					active_size[t] = index[t].size();
 				PGmax_old = Math::INFTY;
 				PGmin_old = -Math::INFTY;
 				continue;
@@ -382,12 +420,60 @@ void LibLinearMTL::solve_l2r_l1l2_svc(const liblinear_problem *prob, double eps,
 				"(also see liblinear FAQ)");
 	}
 
+	SG_FREE(QD);
+	SG_FREE(y);
+}
 
+std::vector<std::vector<int32_t>> LibLinearMTL::color_task_graph() const
+{
+	const MappedSparseMatrix& tsm = task_similarity_matrix;
 
-	delete [] QD;
-	//delete [] alpha;
-	delete [] y;
-	delete [] index;
+	// symmetric adjacency of the task graph, two tasks are adjacent if
+	// either of their similarities is stored
+	std::vector<std::vector<int32_t>> adjacent(num_tasks);
+	for (int32_t s=0; s<num_tasks; s++)
+	{
+		for (index_t k=tsm.row_offsets[s]; k<tsm.row_offsets[s+1]; k++)
+		{
+			int32_t t = tsm.col_indices[k];
+			if (t == s)
+				continue;
+			adjacent[s].push_back(t);
+			adjacent[t].push_back(s);
+		}
+	}
+
+	// greedy coloring, tasks with many neighbours first
+	std::vector<int32_t> order(num_tasks);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+		return adjacent[a].size() > adjacent[b].size();
+	});
+
+	std::vector<int32_t> color(num_tasks, -1);
+	std::vector<int32_t> used_by(num_tasks, -1);
+	std::vector<std::vector<int32_t>> colors;
+	for (auto t : order)
+	{
+		for (auto u : adjacent[t])
+		{
+			if (color[u] >= 0)
+				used_by[color[u]] = t;
+		}
+
+		int32_t c = 0;
+		while (c < (int32_t)colors.size() && used_by[c] == t)
+			c++;
+		if (c == (int32_t)colors.size())
+			colors.emplace_back();
+
+		color[t] = c;
+		colors[c].push_back(t);
+	}
+
+	SG_DEBUG("scheduled {} tasks in {} conflict-free groups", num_tasks,
+			colors.size());
+	return colors;
 }
 
 
@@ -519,14 +605,15 @@ return obj
 
 	int32_t v_size = features->get_dim_feature_space();
 
-	// efficient computation
+	// efficient computation, only the non-zero similarities contribute
+	const MappedSparseMatrix& tsm = task_similarity_matrix;
 	for (int32_t s=0; s<num_tasks; s++)
 	{
 		float64_t* v_s = V.get_column_vector(s);
-		for (int32_t t=0; t<num_tasks; t++)
+		for (index_t k=tsm.row_offsets[s]; k<tsm.row_offsets[s+1]; k++)
 		{
-			float64_t* v_t = V.get_column_vector(t);
-			const float64_t ts = task_similarity_matrix(s, t);
+			float64_t* v_t = V.get_column_vector(tsm.col_indices[k]);
+			const float64_t ts = tsm.values[k];
 
 			for(int32_t i=0; i<v_size; i++)
 			{
@@ -17,7 +17,9 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/RandomMixin.h>
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 namespace shogun
 {
@@ -25,8 +27,11 @@ namespace shogun
 #ifdef HAVE_LAPACK
 
 
-/** @brief mapped sparse matrix for
- * representing graph relations of tasks
+/** @brief sparse matrix for representing graph relations of tasks
+ *
+ * The entries are stored row by row in compressed form (CSR) with the column
+ * indices of every row sorted, so the neighbours of a task are iterated over
+ * contiguous memory and single entries are looked up by binary search.
  */
 class MappedSparseMatrix
 {
@@ -39,50 +44,73 @@ class MappedSparseMatrix
      */
     inline const float64_t operator()(index_t i_row, index_t i_col) const
     {
-
 		// lookup complexity is O(log n)
-		std::map<index_t, float64_t>::const_iterator it = data[i_row].find(i_col);
+		auto first = col_indices.begin() + row_offsets[i_row];
+		auto last = col_indices.begin() + row_offsets[i_row + 1];
+		auto it = std::lower_bound(first, last, i_col);
 
-		if (it != data[i_row].end())
-		{
-			// use mapping for lookup
-			return it->second;
-		} else {
-			return 0.0;
-		}
+		if (it != last && *it == i_col)
+			return values[it - col_indices.begin()];
+
+		return 0.0;
 	}
 
-    /** set matrix from SGSparseMatrix
+    /** set matrix from SGSparseMatrix, later entries of a row overwrite
+     * earlier ones with the same index
      * @param sgm
      */
     void set_from_sparse(const SGSparseMatrix<float64_t> &sgm)
     {
-        data.clear();
+        row_offsets.assign(1, 0);
+        col_indices.clear();
+        values.clear();
 
         // deep copy sparse matrix
         for (int32_t i=0; i!=sgm.num_vectors; i++)
         {
-
+            std::map<index_t, float64_t> row;
             SGSparseVector<float64_t> ts_row = sgm.sparse_matrix[i];
-            data.push_back(std::map<index_t, float64_t>());
-
             for (int32_t k=0; k!=ts_row.num_feat_entries; k++)
+                row[ts_row.features[k].feat_index] = ts_row.features[k].entry;
+
+            for (const auto& e : row)
             {
-				// get data from sparse matrix
-				SGSparseVectorEntry<float64_t> e = ts_row.features[k];
-                data[i][e.feat_index] = e.entry;
+                col_indices.push_back(e.first);
+                values.push_back(e.second);
             }
-
+            row_offsets.push_back(col_indices.size());
         }
     }
 
-	/** under-the-hood data structure  */
-    std::vector< std::map<index_t, float64_t> > data;
+    /** @return number of rows */
+    inline index_t get_num_rows() const
+    {
+        return row_offsets.size() - 1;
+    }
+
+	/** offsets of the rows in col_indices and values, row i is stored in
+	 * [row_offsets[i], row_offsets[i+1]) */
+    std::vector<index_t> row_offsets = std::vector<index_t>(1, 0);
+
+	/** sorted column indices of the rows */
+    std::vector<index_t> col_indices;
+
+	/** entries of the rows */
+    std::vector<float64_t> values;
 
 };
 
 
-/** @brief class to implement LibLinear */
+/** @brief class to implement LibLinear for multitask learning
+ *
+ * Dual coordinate descent where the gradient of an example of task \f$t\f$
+ * sums over the weight vectors of all tasks similar to \f$t\f$. Since an
+ * update of such an example only writes the weight vector of \f$t\f$, the
+ * tasks are grouped by a greedy coloring of the task similarity graph and
+ * the tasks of a group, which are pairwise not similar, are updated in
+ * parallel, task by task. With a sparse task similarity matrix this scales
+ * to thousands of tasks.
+ */
 class LibLinearMTL : public RandomMixin<LinearMachine>
 {
 	public:
@@ -240,15 +268,18 @@ class LibLinearMTL : public RandomMixin<LinearMachine>
                 W.matrix[k] = 0;
             }
 
+            // only the non-zero similarities contribute
+            const auto& tsm = task_similarity_matrix;
             for (int32_t s=0; s<num_tasks; s++)
             {
                 float64_t* v_s = V.get_column_vector(s);
-                for (int32_t t=0; t<num_tasks; t++)
+                for (index_t k=tsm.row_offsets[s]; k<tsm.row_offsets[s+1]; k++)
                 {
-                    float64_t sim_ts = task_similarity_matrix(s,t);
+                    float64_t* w_t = W.get_column_vector(tsm.col_indices[k]);
+                    float64_t sim_ts = tsm.values[k];
                     for(int32_t i=0; i<w_size; i++)
                     {
-                        W.matrix[t*w_size + i] += sim_ts * v_s[i];
+                        w_t[i] += sim_ts * v_s[i];
                     }
                 }
             }
@@ -302,6 +333,13 @@ class LibLinearMTL : public RandomMixin<LinearMachine>
 		void solve_l2r_l1l2_svc(
 			const liblinear_problem *prob, double eps, double Cp, double Cn);
 
+		/** partition the tasks into groups of tasks that are pairwise not
+		 * adjacent in the task graph by greedy coloring
+		 *
+		 * @return the groups of tasks
+		 */
+		std::vector<std::vector<int32_t>> color_task_graph() const;
+
 
 	protected:
 		/** C1 */
@@ -62,6 +62,15 @@ public:
 		{
 			active_tasks.insert(active_tasks_vec[i]);
 		}
+
+		// dense lookup table of the active task ids
+		if (!active_tasks.empty() && *active_tasks.rbegin() >= 0)
+			is_active.resize(*active_tasks.rbegin() + 1, false);
+		for (auto task : active_tasks)
+		{
+			if (task >= 0)
+				is_active[task] = true;
+		}
 	}
 
 	/** default destructor */
@@ -177,8 +186,10 @@ public:
 	 */
 	float64_t get_similarity(int32_t task_lhs, int32_t task_rhs) const noexcept
 	{
-		const bool lhs_is_in = active_tasks.find(task_lhs) != active_tasks.end();
-		const bool rhs_is_in = active_tasks.find(task_rhs) != active_tasks.end();
+		const bool lhs_is_in = task_lhs >= 0 &&
+			task_lhs < (int32_t)is_active.size() && is_active[task_lhs];
+		const bool rhs_is_in = task_rhs >= 0 &&
+			task_rhs < (int32_t)is_active.size() && is_active[task_rhs];
 
 		float64_t similarity = 0.0;
 
@@ -235,6 +246,9 @@ protected:
 	/** list of active tasks **/
 	std::set<int32_t> active_tasks;
 
+	/** whether a task id is active, indexed by task id **/
+	std::vector<bool> is_active;
+
 	/** task vector indicating to which task each example on the left hand side belongs **/
 	std::vector<int32_t> task_vector_lhs;
 
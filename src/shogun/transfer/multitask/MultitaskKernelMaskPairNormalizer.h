@@ -12,6 +12,7 @@
 #include <shogun/kernel/normalizer/KernelNormalizer.h>
 #include <shogun/kernel/Kernel.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <utility>
@@ -49,6 +50,7 @@ public:
 	{
 		set_task_vector(task_vector_);
 		active_pairs = active_pairs_;
+		init_pair_lookup();
 	}
 
 
@@ -168,22 +170,24 @@ public:
 	 */
 	float64_t get_similarity(int32_t task_lhs, int32_t task_rhs) const noexcept
 	{
-		float64_t similarity = 0.0;
+		if (task_lhs < 0 || task_rhs < 0)
+			return 0.0;
 
-		for (int32_t i=0; i < active_pairs.size(); i++)
+		bool is_active;
+		if (!pair_table.empty())
+		{
+			// dense table of all pairs of task ids
+			is_active = task_lhs < num_task_ids && task_rhs < num_task_ids &&
+				pair_table[int64_t(task_lhs) * num_task_ids + task_rhs];
+		}
+		else
 		{
-			const auto& block = active_pairs[i];
-
 			// ignore order of pair
-			if ((block.first==task_lhs && block.second==task_rhs) ||
-				(block.first==task_rhs && block.second==task_lhs))
-			{
-				similarity = 1.0 / normalization_constant;
-				break;
-			}
+			is_active = std::binary_search(pair_keys.begin(), pair_keys.end(),
+				pair_key(task_lhs, task_rhs));
 		}
 
-		return similarity;
+		return is_active ? 1.0 / normalization_constant : 0.0;
 	}
 
 	/** @return vector of active pairs */
@@ -224,9 +228,57 @@ public:
 
 protected:
 
+	/** @return key of the unordered pair of task ids */
+	static int64_t pair_key(int32_t task_lhs, int32_t task_rhs) noexcept
+	{
+		return (int64_t(std::min(task_lhs, task_rhs)) << 32) |
+			uint32_t(std::max(task_lhs, task_rhs));
+	}
+
+	/** set up the lookup of the active pairs, a dense table over all pairs
+	 * of task ids for up to 4096 tasks or sorted pair keys for more */
+	void init_pair_lookup()
+	{
+		num_task_ids = 0;
+		pair_keys.clear();
+		for (const auto& block : active_pairs)
+		{
+			if (block.first < 0 || block.second < 0)
+				continue;
+			num_task_ids = std::max(num_task_ids,
+				std::max(block.first, block.second) + 1);
+			pair_keys.push_back(pair_key(block.first, block.second));
+		}
+		std::sort(pair_keys.begin(), pair_keys.end());
+		pair_keys.erase(std::unique(pair_keys.begin(), pair_keys.end()),
+			pair_keys.end());
+
+		pair_table.clear();
+		if (num_task_ids <= 4096)
+		{
+			pair_table.resize(int64_t(num_task_ids) * num_task_ids, false);
+			for (const auto& block : active_pairs)
+			{
+				if (block.first < 0 || block.second < 0)
+					continue;
+				pair_table[int64_t(block.first) * num_task_ids + block.second] = true;
+				pair_table[int64_t(block.second) * num_task_ids + block.first] = true;
+			}
+		}
+	}
+
 	/** list of active tasks **/
 	std::vector<std::pair<int32_t, int32_t> > active_pairs;
 
+	/** one more than the largest task id of the active pairs **/
+	int32_t num_task_ids = 0;
+
+	/** whether a pair of task ids is active, row-major over task ids **/
+	std::vector<bool> pair_table;
+
+	/** sorted keys of the active pairs, used for many tasks **/
+	std::vector<int64_t> pair_keys;
+
 	/** task vector indicating to which task each example on the left hand side belongs **/
 	std::vector<int32_t> task_vector_lhs;
 
@@ -101,6 +101,12 @@ namespace shogun
 			return false;
 		}
 
+		/** @return whether the transformer has been fitted */
+		bool is_fitted() const
+		{
+			return m_fitted;
+		}
+
 	protected:
 		/** Check current transformer has been fitted, throw NotFittedException
 		 * otherwise.
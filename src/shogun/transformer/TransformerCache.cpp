@@ -0,0 +1,283 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/range.h>
+#include <shogun/features/Features.h>
+#include <shogun/io/fs/FileSystem.h>
+#include <shogun/io/fs/Path.h>
+#include <shogun/io/serialization/BitseryDeserializer.h>
+#include <shogun/io/serialization/BitserySerializer.h>
+#include <shogun/io/stream/FileInputStream.h>
+#include <shogun/io/stream/FileOutputStream.h>
+#include <shogun/labels/Labels.h>
+#include <shogun/transformer/Transformer.h>
+#include <shogun/transformer/TransformerCache.h>
+#include <shogun/util/visitors/HashVisitor.h>
+
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+	void combine(size_t& seed, size_t value)
+	{
+		seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+
+	int64_t num_bytes(const std::shared_ptr<SGObject>& obj)
+	{
+		HashVisitor visitor(false, ParameterProperties::NONE);
+		visitor.visit_object(obj.get());
+		return visitor.get_num_bytes();
+	}
+} // namespace
+
+TransformerCache::TransformerCache() : SGObject()
+{
+	init();
+}
+
+TransformerCache::TransformerCache(int64_t memory_limit) : SGObject()
+{
+	init();
+	set_memory_limit(memory_limit);
+}
+
+TransformerCache::~TransformerCache()
+{
+	clear();
+}
+
+void TransformerCache::init()
+{
+	m_memory_limit = int64_t(1) << 30;
+	m_memory_usage = 0;
+	m_num_hits = 0;
+	m_num_misses = 0;
+
+	SG_ADD(&m_memory_limit, "memory_limit", "Memory limit in bytes");
+	SG_ADD(
+	    &m_spill_directory, "spill_directory",
+	    "Directory that evicted entries are written to");
+}
+
+void TransformerCache::set_memory_limit(int64_t memory_limit)
+{
+	require(
+	    memory_limit >= 0, "Memory limit ({}) must not be negative",
+	    memory_limit);
+	m_memory_limit = memory_limit;
+}
+
+void TransformerCache::set_spill_directory(const std::string& directory)
+{
+	require(
+	    directory.empty() || !env()->is_directory(directory),
+	    "Spill directory {} does not exist", directory);
+	m_spill_directory = directory;
+}
+
+size_t TransformerCache::input_key(const std::shared_ptr<Features>& features)
+{
+	return HashVisitor::hash(features);
+}
+
+std::shared_ptr<Features> TransformerCache::fit_transform(
+    std::shared_ptr<Transformer>& transformer,
+    const std::shared_ptr<Features>& features,
+    const std::shared_ptr<Labels>& labels, size_t& key)
+{
+	require(transformer, "No transformer provided");
+
+	const bool supervised = transformer->train_require_labels();
+	combine(key, HashVisitor::hash(transformer));
+	if (supervised)
+	{
+		require(labels, "{} requires labels", transformer->get_name());
+		combine(key, HashVisitor::hash(labels));
+	}
+
+	Entry entry;
+	if (lookup(key, entry))
+	{
+		transformer = make_clone(entry.transformer);
+		return entry.features->duplicate();
+	}
+
+	supervised ? transformer->fit(features, labels)
+	           : transformer->fit(features);
+	entry.transformer = make_clone(transformer);
+	entry.features = transformer->transform(features, false);
+	entry.num_bytes = num_bytes(entry.transformer) + num_bytes(entry.features);
+
+	auto result = entry.features->duplicate();
+	insert(key, std::move(entry));
+	return result;
+}
+
+bool TransformerCache::lookup(size_t key, Entry& entry)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(key);
+		if (it != m_entries.end())
+		{
+			m_lru.splice(m_lru.begin(), m_lru, it->second.second);
+			entry = it->second.first;
+			m_num_hits++;
+			return true;
+		}
+
+		if (!m_spilled.count(key))
+		{
+			m_num_misses++;
+			return false;
+		}
+	}
+
+	if (!load(key, entry))
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_num_misses++;
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_num_hits++;
+	}
+	insert(key, entry);
+	return true;
+}
+
+void TransformerCache::insert(size_t key, Entry entry)
+{
+	std::vector<std::pair<size_t, Entry>> evicted;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_entries.count(key))
+			return;
+
+		m_lru.push_front(key);
+		m_memory_usage += entry.num_bytes;
+		m_entries.emplace(key, std::make_pair(std::move(entry), m_lru.begin()));
+
+		while (m_memory_usage > m_memory_limit)
+		{
+			auto it = m_entries.find(m_lru.back());
+			m_memory_usage -= it->second.first.num_bytes;
+			if (!m_spill_directory.empty() && !m_spilled.count(it->first))
+				evicted.emplace_back(it->first, std::move(it->second.first));
+			m_entries.erase(it);
+			m_lru.pop_back();
+		}
+	}
+
+	// serialization happens outside of the lock
+	for (const auto& item : evicted)
+		spill(item.first, item.second);
+}
+
+std::string TransformerCache::spill_file(size_t key, const char* suffix) const
+{
+	return io::join_path(
+	    m_spill_directory,
+	    "TransformerCache-" + std::to_string(key) + "." + suffix);
+}
+
+void TransformerCache::spill(size_t key, const Entry& entry)
+{
+	const std::shared_ptr<SGObject> objects[2] = {
+	    entry.transformer, entry.features};
+	const char* suffixes[2] = {"transformer", "features"};
+	for (auto i : range(2))
+	{
+		std::unique_ptr<io::WritableFile> file;
+		if (env()->new_writable_file(spill_file(key, suffixes[i]), &file))
+		{
+			io::warn(
+			    "Could not spill {} to {}", objects[i]->get_name(),
+			    m_spill_directory);
+			return;
+		}
+		auto serializer = std::make_unique<io::BitserySerializer>();
+		serializer->attach(std::make_shared<io::FileOutputStream>(file.get()));
+		serializer->write(objects[i]);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_spilled.insert(key);
+}
+
+bool TransformerCache::load(size_t key, Entry& entry)
+{
+	std::shared_ptr<SGObject> objects[2];
+	const char* suffixes[2] = {"transformer", "features"};
+	for (auto i : range(2))
+	{
+		std::unique_ptr<io::RandomAccessFile> file;
+		if (env()->new_random_access_file(spill_file(key, suffixes[i]), &file))
+			return false;
+		auto deserializer = std::make_unique<io::BitseryDeserializer>();
+		deserializer->attach(std::make_shared<io::FileInputStream>(file.get()));
+		objects[i] = deserializer->read_object();
+	}
+
+	entry.transformer = objects[0]->as<Transformer>();
+	entry.features = objects[1]->as<Features>();
+	entry.num_bytes = num_bytes(entry.transformer) + num_bytes(entry.features);
+	return entry.transformer && entry.features;
+}
+
+void TransformerCache::delete_spilled(size_t key)
+{
+	for (auto suffix : {"transformer", "features"})
+	{
+		auto file_name = spill_file(key, suffix);
+		if (!env()->file_exists(file_name))
+			env()->delete_file(file_name);
+	}
+}
+
+int64_t TransformerCache::get_num_entries() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+int64_t TransformerCache::get_memory_usage() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_memory_usage;
+}
+
+int64_t TransformerCache::get_num_hits() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_num_hits;
+}
+
+int64_t TransformerCache::get_num_misses() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_num_misses;
+}
+
+void TransformerCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto key : m_spilled)
+		delete_spilled(key);
+
+	m_spilled.clear();
+	m_entries.clear();
+	m_lru.clear();
+	m_memory_usage = 0;
+	m_num_hits = 0;
+	m_num_misses = 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef TRANSFORMERCACHE_H_
+#define TRANSFORMERCACHE_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace shogun
+{
+	class Features;
+	class Labels;
+	class Transformer;
+
+	/** @brief Cache of fitted transformers and the features they
+	 * transformed, shared by the clones of a Pipeline.
+	 *
+	 * Entries are addressed by the content of the input: the key of the
+	 * first stage hashes the training features (including their subsets),
+	 * the key of every later stage chains the key of its input with the
+	 * parameters of the transformer (see HashVisitor) and, if the
+	 * transformer is supervised, the labels. Training the same
+	 * preprocessing on the same fold again, e.g. for every candidate of a
+	 * hyperparameter search or in repeated cross-validation, then only
+	 * costs the hashing.
+	 *
+	 * Cached features are shared and must not be modified, the cache
+	 * therefore transforms out of place and hands out shallow copies. When
+	 * the estimated memory of the entries exceeds the limit, the least
+	 * recently used ones are evicted, or written to the spill directory if
+	 * one is set, from where they are read back when used again. Spilled
+	 * files are deleted with the cache.
+	 *
+	 * The cache may be used from several threads at once. Entries are
+	 * computed outside of the lock, so two threads that miss the same key
+	 * at the same time both compute it.
+	 */
+	class TransformerCache : public SGObject
+	{
+	public:
+		/** constructor */
+		TransformerCache();
+
+		/** constructor
+		 * @param memory_limit memory limit in bytes
+		 */
+		TransformerCache(int64_t memory_limit);
+
+		/** destructor, deletes spilled files */
+		~TransformerCache() override;
+
+		/** get name */
+		const char* get_name() const override
+		{
+			return "TransformerCache";
+		}
+
+		/** @param memory_limit memory limit in bytes */
+		void set_memory_limit(int64_t memory_limit);
+
+		/** @return memory limit in bytes */
+		int64_t get_memory_limit() const
+		{
+			return m_memory_limit;
+		}
+
+		/** @param directory directory that evicted entries are written to,
+		 * empty to discard them
+		 */
+		void set_spill_directory(const std::string& directory);
+
+		/** @return spill directory */
+		std::string get_spill_directory() const
+		{
+			return m_spill_directory;
+		}
+
+		/** @param features features
+		 * @return key of features that are the input of a first stage
+		 */
+		static size_t input_key(const std::shared_ptr<Features>& features);
+
+		/** fits a transformer and transforms features, or takes both from
+		 * the cache
+		 *
+		 * @param transformer transformer to fit, replaced by a copy of the
+		 * cached fitted transformer
+		 * @param features features to fit on and to transform
+		 * @param labels labels, used if the transformer requires them
+		 * @param key key of the features, replaced by the key of the result
+		 * @return transformed features
+		 */
+		std::shared_ptr<Features> fit_transform(
+		    std::shared_ptr<Transformer>& transformer,
+		    const std::shared_ptr<Features>& features,
+		    const std::shared_ptr<Labels>& labels, size_t& key);
+
+		/** @return number of entries in memory */
+		int64_t get_num_entries() const;
+
+		/** @return estimated memory of the entries in memory in bytes */
+		int64_t get_memory_usage() const;
+
+		/** @return number of entries that were found */
+		int64_t get_num_hits() const;
+
+		/** @return number of entries that were computed */
+		int64_t get_num_misses() const;
+
+		/** removes all entries, including spilled ones, and resets the
+		 * statistics */
+		void clear();
+
+	private:
+		void init();
+
+		struct Entry
+		{
+			std::shared_ptr<Transformer> transformer;
+			std::shared_ptr<Features> features;
+			int64_t num_bytes = 0;
+		};
+
+		/** @return entry of a key, from memory or the spill directory */
+		bool lookup(size_t key, Entry& entry);
+
+		/** inserts an entry and evicts entries above the memory limit */
+		void insert(size_t key, Entry entry);
+
+		/** file name of a spilled entry */
+		std::string spill_file(size_t key, const char* suffix) const;
+
+		/** writes an entry to the spill directory */
+		void spill(size_t key, const Entry& entry);
+
+		/** reads an entry from the spill directory */
+		bool load(size_t key, Entry& entry);
+
+		/** deletes the files of a spilled entry */
+		void delete_spilled(size_t key);
+
+		/** memory limit in bytes */
+		int64_t m_memory_limit;
+
+		/** directory of spilled entries */
+		std::string m_spill_directory;
+
+		/** keys in the order of use, most recent first */
+		std::list<size_t> m_lru;
+
+		/** entries in memory, with their position in m_lru */
+		std::unordered_map<size_t, std::pair<Entry, std::list<size_t>::iterator>>
+		    m_entries;
+
+		/** keys of spilled entries */
+		std::unordered_set<size_t> m_spilled;
+
+		/** memory of the entries in m_entries */
+		int64_t m_memory_usage;
+
+		int64_t m_num_hits;
+		int64_t m_num_misses;
+
+		mutable std::mutex m_mutex;
+	};
+} // namespace shogun
+
+#endif /* TRANSFORMERCACHE_H_ */
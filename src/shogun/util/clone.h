@@ -45,6 +45,53 @@ namespace shogun
 			return value->clone();
 		}
 
+		/**
+		 * Whether clones made in this thread share the storage of
+		 * reference counted data, see ShareDataScope.
+		 * @return reference to the flag of the calling thread
+		 */
+		inline bool& sharing_data()
+		{
+			static thread_local bool share = false;
+			return share;
+		}
+
+		/**
+		 * While an instance exists, SGObject::clone() in the same thread
+		 * shares the storage of reference counted data (SGVector, SGMatrix,
+		 * SGSparseMatrix, ...) between the original and the clone, the
+		 * same way copies of these types share it, instead of copying it.
+		 * Nested objects (e.g. the features of a kernel) are cloned
+		 * with shared data as well.
+		 *
+		 * Writes to the shared data are visible in both objects. This is
+		 * meant for clones that only replace such parameters (e.g. a
+		 * machine that gets trained, a kernel that gets initialized with
+		 * new features), not for clones that change them in place.
+		 */
+		class ShareDataScope
+		{
+		public:
+			/** @param share whether to share data, nested scopes that do
+			 * not share keep the sharing of an enclosing scope */
+			explicit ShareDataScope(bool share = true)
+			    : m_previous(sharing_data())
+			{
+				sharing_data() = m_previous || share;
+			}
+
+			~ShareDataScope()
+			{
+				sharing_data() = m_previous;
+			}
+
+			ShareDataScope(const ShareDataScope&) = delete;
+			ShareDataScope& operator=(const ShareDataScope&) = delete;
+
+		private:
+			bool m_previous;
+		};
+
 		/**
 		 * Clone a Shogun object by calling its clone() method.
 		 * It also works with non-Shogun object by using the copy
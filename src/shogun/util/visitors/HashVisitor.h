@@ -0,0 +1,280 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#ifndef SHOGUN_HASHVISITOR_H
+#define SHOGUN_HASHVISITOR_H
+
+#include <shogun/base/SGObject.h>
+
+#include <functional>
+#include <string_view>
+#include <unordered_set>
+
+namespace shogun
+{
+	/** @brief Visitor that hashes the parameters of an object, recursing
+	 * into the objects it holds.
+	 *
+	 * Unlike std::hash<SGObject>, which hashes shared objects by address,
+	 * the hash depends on the values only, so two clones with the same
+	 * parameters hash equally. Parameters with any of the excluded
+	 * properties (by default the outcome of training and read-only state,
+	 * so fitted and unfitted objects hash equally) and watched methods are
+	 * skipped.
+	 *
+	 * Vectors and matrices are hashed by content, or by address and size
+	 * if hash_contents is false. The visitor also counts the bytes it
+	 * visited, which estimates the memory used by the object.
+	 */
+	class HashVisitor : public AnyVisitor
+	{
+	public:
+		HashVisitor(
+		    bool hash_contents = true,
+		    ParameterProperties excluded =
+		        ParameterProperties::MODEL | ParameterProperties::READONLY)
+		    : AnyVisitor(), m_hash_contents(hash_contents),
+		      m_excluded(excluded)
+		{
+		}
+
+		/** hash of an object
+		 * @param obj object, may be nullptr
+		 * @param hash_contents whether to hash the values of arrays
+		 * @return hash
+		 */
+		static size_t
+		hash(const std::shared_ptr<SGObject>& obj, bool hash_contents = true)
+		{
+			HashVisitor visitor(hash_contents);
+			visitor.visit_object(obj.get());
+			return visitor.get_hash();
+		}
+
+		/** hashes all parameters of an object that are not excluded
+		 * @param obj object, may be nullptr
+		 */
+		void visit_object(SGObject* obj)
+		{
+			if (!obj)
+			{
+				combine(0);
+				return;
+			}
+			// objects referenced twice, or by themselves, are hashed once
+			if (!m_visited.insert(obj).second)
+			{
+				combine(std::hash<const void*>{}(obj));
+				return;
+			}
+
+			combine(std::hash<std::string_view>{}(obj->get_name()));
+			for (const auto& param : obj->get_params())
+			{
+				const auto& value = param.second->get_value();
+				if (!value.cloneable() ||
+				    param.second->get_properties().has_property(m_excluded))
+					continue;
+
+				combine(std::hash<std::string>{}(param.first));
+				value.visit(this);
+			}
+		}
+
+		/** @return hash of everything visited so far */
+		size_t get_hash() const
+		{
+			return m_hash;
+		}
+
+		/** @return number of bytes of all values visited so far */
+		int64_t get_num_bytes() const
+		{
+			return m_num_bytes;
+		}
+
+		void on(bool* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(std::vector<bool>::reference* v) override
+		{
+			on_value(bool(*v));
+		}
+
+		void on(char* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(int8_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(uint8_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(int16_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(uint16_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(int32_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(uint32_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(int64_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(uint64_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(float32_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(float64_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(floatmax_t* v) override
+		{
+			on_value(*v);
+		}
+
+		void on(complex128_t* v) override
+		{
+			on_value(v->real());
+			on_value(v->imag());
+		}
+
+		void on(std::shared_ptr<SGObject>* v) override
+		{
+			visit_object(v->get());
+		}
+
+		void on(std::string* v) override
+		{
+			m_num_bytes += v->size();
+			combine(std::hash<std::string>{}(*v));
+		}
+
+		void on(AutoValueEmpty* v) override
+		{
+			combine(0);
+		}
+
+		bool
+		on_contiguous(void* data, size_t value_bytes, int64_t length) override
+		{
+			const size_t num_bytes = value_bytes * length;
+			m_num_bytes += num_bytes;
+			if (m_hash_contents)
+			{
+				combine(std::hash<std::string_view>{}(
+				    std::string_view((const char*)data, num_bytes)));
+			}
+			else
+			{
+				combine(std::hash<const void*>{}(data));
+				combine(num_bytes);
+			}
+			return true;
+		}
+
+		void enter_matrix(index_t* rows, index_t* cols) override
+		{
+			combine(*rows);
+			combine(*cols);
+		}
+
+		void enter_vector(index_t* size) override
+		{
+			combine(*size);
+		}
+
+		void enter_std_vector(size_t* size) override
+		{
+			combine(*size);
+		}
+
+		void enter_map(size_t* size) override
+		{
+			combine(*size);
+		}
+
+		void enter_auto_value(bool* is_empty) override
+		{
+			combine(*is_empty);
+		}
+
+		void enter_matrix_row(index_t* rows, index_t* cols) override
+		{
+		}
+
+		void exit_matrix_row(index_t* rows, index_t* cols) override
+		{
+		}
+
+		void exit_matrix(index_t* rows, index_t* cols) override
+		{
+		}
+
+		void exit_vector(index_t* size) override
+		{
+		}
+
+		void exit_std_vector(size_t* size) override
+		{
+		}
+
+		void exit_map(size_t* size) override
+		{
+		}
+
+	private:
+		template <typename T>
+		void on_value(const T& v)
+		{
+			m_num_bytes += sizeof(T);
+			combine(std::hash<T>{}(v));
+		}
+
+		void combine(size_t value)
+		{
+			m_hash ^= value + 0x9e3779b9 + (m_hash << 6) + (m_hash >> 2);
+		}
+
+		bool m_hash_contents;
+		ParameterProperties m_excluded;
+		std::unordered_set<const SGObject*> m_visited;
+		size_t m_hash = 0;
+		int64_t m_num_bytes = 0;
+	};
+} // namespace shogun
+
+#endif // SHOGUN_HASHVISITOR_H
@@ -35,6 +35,8 @@
 #include <gtest/gtest.h>
 #include <omp.h>
 
+#include <vector>
+
 using namespace shogun;
 
 TEST(Parallel, openmp_get_num_threads)
@@ -70,4 +72,31 @@ TEST(Parallel, openmp_set_num_threads)
 
 	env()->set_num_threads(orig_num_threads);
 }
+
+TEST(Parallel, nested_num_threads)
+{
+	int32_t orig_num_threads = env()->get_num_threads();
+	env()->set_num_threads(8);
+
+	std::vector<int32_t> inner_num_threads(2, 0);
+#pragma omp parallel num_threads(2)
+	{
+		// the two outer threads share the eight threads
+		EXPECT_EQ(env()->get_num_threads(), 4);
+		EXPECT_EQ(env()->get_max_num_threads(), 8);
+
+		env()->limit_nested_threads();
+#pragma omp parallel
+		{
+			#pragma omp master
+				inner_num_threads[omp_get_ancestor_thread_num(1)] =
+					omp_get_num_threads();
+		}
+	}
+	EXPECT_EQ(inner_num_threads[0], 4);
+	EXPECT_EQ(inner_num_threads[1], 4);
+	EXPECT_EQ(env()->get_num_threads(), 8);
+
+	env()->set_num_threads(orig_num_threads);
+}
 #endif // HAVE_OPENMP
@@ -256,6 +256,22 @@ TYPED_TEST(SGObjectClone, not_just_copied_pointer)
 		EXPECT_NE(clone_casted->m_raw_vector_object[i], obj->m_raw_vector_object[i]);
 }
 
+TYPED_TEST(SGObjectClone, share_data)
+{
+	auto obj = std::make_shared<CloneEqualsMock<TypeParam>>();
+	auto clone = make_clone(obj, ParameterProperties::ALL, true);
+	EXPECT_TRUE(clone->equals(obj));
+
+	// vectors and matrices are shared, objects are still cloned
+	EXPECT_EQ(clone->m_sg_vector.vector, obj->m_sg_vector.vector);
+	EXPECT_EQ(clone->m_sg_matrix.matrix, obj->m_sg_matrix.matrix);
+	EXPECT_NE(clone->m_object, obj->m_object);
+
+	auto copy = make_clone(obj);
+	EXPECT_NE(copy->m_sg_vector.vector, obj->m_sg_vector.vector);
+	EXPECT_NE(copy->m_sg_matrix.matrix, obj->m_sg_matrix.matrix);
+}
+
 TYPED_TEST(SGObjectClone, equals_other_has_null_param)
 {
 	auto obj = std::make_shared<CloneEqualsMock<TypeParam>>();
@@ -583,3 +599,29 @@ TEST(SGObject, auto_parameter)
     obj->put(MockObject::kAutoParameter, 1);
     EXPECT_EQ(obj->get<int32_t>(MockObject::kAutoParameter), 1);
 }
+
+TEST(SGObject, parameter_ref)
+{
+	auto obj = std::make_shared<MockObject>();
+	auto ref = obj->get_parameter_ref<int32_t>(MockObject::kWatchedInt);
+	EXPECT_EQ(ref.name(), std::string(MockObject::kWatchedInt));
+
+	ref.put(89);
+	EXPECT_EQ(ref.get(), 89);
+	EXPECT_EQ(obj->get_watched(), 89);
+	obj->set_watched(12);
+	EXPECT_EQ(ref.get(), 12);
+
+	auto constrained =
+	    obj->get_parameter_ref<int32_t>(MockObject::kConstrainedParameter);
+	EXPECT_THROW(constrained.put(10), ShogunException);
+	EXPECT_EQ(constrained.get(), 1);
+
+	EXPECT_THROW(obj->get_parameter_ref<int32_t>("foo"), ShogunException);
+	EXPECT_THROW(
+	    obj->get_parameter_ref<float64_t>(MockObject::kWatchedInt).get(),
+	    ShogunException);
+	EXPECT_THROW(
+	    obj->get_parameter_ref<int32_t>(MockObject::kSomeMethod),
+	    ShogunException);
+}
@@ -0,0 +1,101 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/LogisticRegression.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/TCPCommunicator.h>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace shogun;
+
+TEST(LogisticRegression, train)
+{
+	std::mt19937_64 prng(17);
+	auto data=DataGenerator::generate_gaussians(100, 2, 3, prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	SGVector<float64_t> lab(data.num_cols);
+	for (index_t i=0; i<lab.vlen; i++)
+		lab[i]=i<100 ? -1 : 1;
+	auto labels=std::make_shared<BinaryLabels>(lab);
+
+	auto machine=std::make_shared<LogisticRegression>(1.0);
+	machine->set_labels(labels);
+	machine->train(features);
+
+	auto predicted=machine->apply_binary(features);
+	index_t correct=0;
+	for (index_t i=0; i<lab.vlen; i++)
+		correct+=predicted->get_label(i)==lab[i];
+	EXPECT_GT(correct, 0.9*lab.vlen);
+}
+
+TEST(LogisticRegression, sharded_matches_single_process)
+{
+	const int32_t num_shards=3;
+	std::mt19937_64 prng(23);
+	auto data=DataGenerator::generate_gaussians(90, 2, 4, prng);
+	SGVector<float64_t> lab(data.num_cols);
+	for (index_t i=0; i<lab.vlen; i++)
+		lab[i]=i<90 ? -1 : 1;
+
+	auto single=std::make_shared<LogisticRegression>(0.5);
+	single->set_labels(std::make_shared<BinaryLabels>(lab));
+	single->train(std::make_shared<DenseFeatures<float64_t>>(data));
+	auto expected=single->get_w();
+
+	/* shard i holds the vectors i, i+num_shards, ... */
+	auto root=std::make_shared<TCPCommunicator>(
+		0, num_shards, "127.0.0.1", 0);
+	const int32_t port=root->get_port();
+	std::vector<std::shared_ptr<LogisticRegression>> machines(num_shards);
+	auto run=[&](std::shared_ptr<TCPCommunicator> communicator) {
+		const int32_t rank=communicator->get_rank();
+		const index_t num=(data.num_cols-rank+num_shards-1)/num_shards;
+		SGMatrix<float64_t> shard(data.num_rows, num);
+		SGVector<float64_t> shard_lab(num);
+		for (index_t i=0; i<num; i++)
+		{
+			const index_t idx=rank+i*num_shards;
+			for (index_t j=0; j<data.num_rows; j++)
+				shard(j, i)=data(j, idx);
+			shard_lab[i]=lab[idx];
+		}
+
+		auto machine=std::make_shared<LogisticRegression>(0.5);
+		machine->set_communicator(communicator);
+		machine->set_labels(std::make_shared<BinaryLabels>(shard_lab));
+		machine->train(std::make_shared<DenseFeatures<float64_t>>(shard));
+		machines[rank]=machine;
+	};
+
+	std::vector<std::thread> workers;
+	for (int32_t rank=1; rank<num_shards; rank++)
+	{
+		workers.emplace_back(run, std::make_shared<TCPCommunicator>(
+			rank, num_shards, "127.0.0.1", port));
+	}
+	run(root);
+	for (auto& worker : workers)
+		worker.join();
+
+	for (int32_t rank=0; rank<num_shards; rank++)
+	{
+		auto w=machines[rank]->get_w();
+		ASSERT_EQ(w.vlen, expected.vlen);
+		for (index_t i=0; i<w.vlen; i++)
+		{
+			EXPECT_NEAR(w[i], expected[i], 1e-3);
+			EXPECT_EQ(w[i], machines[0]->get_w()[i]);
+		}
+		EXPECT_NEAR(machines[rank]->get_bias(), single->get_bias(), 1e-3);
+	}
+}
@@ -42,6 +42,7 @@
 #include <shogun/evaluation/ContingencyTableEvaluation.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/observers/ConvergenceMonitor.h>
 
 using namespace shogun;
 
@@ -64,6 +65,31 @@ TEST(Perceptron, train)
 	EXPECT_EQ(acc->evaluate(results, test_labels), 1.0);
 }
 
+TEST(Perceptron, validation_monitor)
+{
+	auto env = linear_test_env->getBinaryLabelData();
+	auto features = env->get_features_train();
+	auto labels = env->get_labels_train();
+	auto test_features = env->get_features_test();
+	auto test_labels = env->get_labels_test();
+
+	auto monitor = std::make_shared<ConvergenceMonitor>(1000, 1);
+	monitor->set_early_stopping("validation", 1, true);
+
+	auto perceptron = std::make_shared<Perceptron>();
+	perceptron->set_labels(labels);
+	perceptron->set_convergence_monitor(monitor);
+	perceptron->set_validation_data(
+		test_features, test_labels, std::make_shared<AccuracyMeasure>());
+	perceptron->train(features);
+
+	auto scores = monitor->get_values("validation");
+	ASSERT_GT(scores.vlen, 0);
+	EXPECT_EQ(
+		scores.vlen, perceptron->get<int32_t>("current_iteration"));
+	EXPECT_TRUE(perceptron->is_complete());
+}
+
 TEST(Perceptron, custom_hyperplane_initialization)
 {
 	auto env = linear_test_env->getBinaryLabelData();
@@ -5,6 +5,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/classifier/svm/LibLinear.h>
 #include <shogun/features/DataGenerator.h>
 #include <shogun/features/DenseFeatures.h>
@@ -436,3 +437,64 @@ TEST_F(LibLinearFixture, simple_set_train_L2R_LR_DUAL_BIAS)
 	// bias, not l1
 	train_with_solver_simple(liblinear_solver_type, true, false, t_w);
 }
+
+TEST_F(LibLinearFixture, parallel_dual_matches_sequential)
+{
+	generate_data_l2();
+	auto old_num_threads = env()->get_num_threads();
+	env()->set_num_threads(4);
+
+	for (auto solver_type :
+	     {L2R_L2LOSS_SVC_DUAL, L2R_L1LOSS_SVC_DUAL, L2R_LR_DUAL})
+	{
+		auto train = [&](bool parallel_dual) {
+			auto ll = std::make_shared<LibLinear>(solver_type);
+			ll->set_features(train_feats);
+			ll->set_labels(ground_truth);
+			ll->set_epsilon(1e-8);
+			ll->set_max_iterations(10000);
+			ll->set_parallel_dual(parallel_dual);
+			ll->put("seed", 100);
+			ll->train();
+			return ll;
+		};
+
+		auto sequential = train(false);
+		auto parallel = train(true);
+
+		auto w = parallel->get_w();
+		auto expected_w = sequential->get_w();
+		for (auto i : range(w.vlen))
+			EXPECT_NEAR(w[i], expected_w[i], 1e-4);
+		EXPECT_NEAR(parallel->get_bias(), sequential->get_bias(), 1e-4);
+	}
+
+	env()->set_num_threads(old_num_threads);
+}
+
+TEST_F(LibLinearFixture, warm_start)
+{
+	generate_data_l2();
+
+	for (auto solver_type : {L2R_LR, L2R_L2LOSS_SVC})
+	{
+		auto previous = std::make_shared<LibLinear>(solver_type);
+		previous->set_labels(ground_truth);
+		previous->set_C(0.1, 0.1);
+		previous->train(train_feats);
+
+		auto cold = std::make_shared<LibLinear>(solver_type);
+		cold->set_labels(ground_truth);
+		cold->train(train_feats);
+
+		auto warm = std::make_shared<LibLinear>(solver_type);
+		warm->set_labels(ground_truth);
+		warm->train(train_feats, previous);
+
+		auto w = warm->get_w();
+		auto expected_w = cold->get_w();
+		for (auto i : range(w.vlen))
+			EXPECT_NEAR(w[i], expected_w[i], 1e-3);
+		EXPECT_NEAR(warm->get_bias(), cold->get_bias(), 1e-3);
+	}
+}
@@ -0,0 +1,179 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace shogun;
+
+TEST(LibSVM, warm_start)
+{
+	const index_t num_previous=60;
+	const index_t num_new=20;
+	std::mt19937_64 prng(57);
+	auto data=DataGenerator::generate_gaussians(
+		(num_previous+num_new)/2, 2, 2, prng);
+
+	/* mix the classes, the generator returns them one after the other */
+	SGVector<index_t> perm(data.num_cols);
+	perm.range_fill();
+	std::shuffle(perm.begin(), perm.end(), prng);
+	SGMatrix<float64_t> mixed(data.num_rows, data.num_cols);
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		for (index_t d=0; d<data.num_rows; d++)
+			mixed(d, i)=data(d, perm[i]);
+		labels[i]=perm[i]<data.num_cols/2 ? 1 : -1;
+	}
+
+	/* the new data is the previous data with the new vectors appended */
+	SGVector<index_t> previous_idx(num_previous);
+	previous_idx.range_fill();
+	auto features=std::make_shared<DenseFeatures<float64_t>>(mixed);
+	auto previous_features=features->copy_subset(previous_idx);
+	auto previous_labels=std::make_shared<BinaryLabels>(
+		SGVector<float64_t>(labels.vector, num_previous, false).clone());
+	auto all_labels=std::make_shared<BinaryLabels>(labels);
+
+	auto make_svm=[&](std::shared_ptr<BinaryLabels> lab) {
+		auto svm=std::make_shared<LibSVM>();
+		svm->set_kernel(std::make_shared<GaussianKernel>(2.0));
+		svm->set_labels(lab);
+		svm->set_epsilon(1e-8);
+		return svm;
+	};
+
+	auto previous=make_svm(previous_labels);
+	previous->train(previous_features);
+
+	auto cold=make_svm(all_labels);
+	cold->train(features);
+
+	auto warm=make_svm(all_labels);
+	warm->train(features, previous);
+
+	auto expected=cold->apply_binary(features)->get_values();
+	auto outputs=warm->apply_binary(features)->get_values();
+	for (index_t i=0; i<outputs.vlen; i++)
+		EXPECT_NEAR(outputs[i], expected[i], 1e-4);
+	EXPECT_NEAR(warm->get_bias(), cold->get_bias(), 1e-4);
+}
+
+TEST(LibSVM, predict_concurrently)
+{
+	std::mt19937_64 prng(57);
+	auto data=DataGenerator::generate_gaussians(40, 2, 2, prng);
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i=0; i<data.num_cols; i++)
+		labels[i]=i<data.num_cols/2 ? 1 : -1;
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto kernel=std::make_shared<GaussianKernel>(2.0);
+	auto svm=std::make_shared<LibSVM>();
+	svm->set_kernel(kernel);
+	svm->set_labels(std::make_shared<BinaryLabels>(labels));
+	svm->train(features);
+
+	std::vector<std::shared_ptr<DenseFeatures<float64_t>>> test_data;
+	for (int32_t t=0; t<4; t++)
+	{
+		test_data.push_back(std::make_shared<DenseFeatures<float64_t>>(
+			DataGenerator::generate_gaussians(10+t, 2, 2, prng)));
+	}
+
+	// the threads share the machine, each with its own test data
+	auto rhs=kernel->get_rhs();
+	std::vector<std::shared_ptr<Labels>> outputs(test_data.size());
+	std::vector<std::thread> threads;
+	for (size_t t=0; t<test_data.size(); t++)
+	{
+		threads.emplace_back(
+			[&, t]() { outputs[t]=svm->predict(test_data[t]); });
+	}
+	for (auto& thread : threads)
+		thread.join();
+	EXPECT_EQ(kernel->get_rhs(), rhs);
+
+	for (size_t t=0; t<test_data.size(); t++)
+	{
+		auto expected=svm->apply_binary(test_data[t])->get_values();
+		auto values=outputs[t]->as<BinaryLabels>()->get_values();
+		ASSERT_EQ(values.vlen, expected.vlen);
+		for (index_t i=0; i<values.vlen; i++)
+			EXPECT_NEAR(values[i], expected[i], 1e-10);
+	}
+}
+
+TEST(LibSVM, compact_support_vectors)
+{
+	std::mt19937_64 prng(57);
+	auto data=DataGenerator::generate_gaussians(60, 2, 2, prng);
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i=0; i<data.num_cols; i++)
+		labels[i]=i<data.num_cols/2 ? 1 : -1;
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto test_features=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(20, 2, 2, prng));
+
+	auto make_svm=[&]() {
+		auto svm=std::make_shared<LibSVM>();
+		svm->set_kernel(std::make_shared<GaussianKernel>(2.0));
+		svm->set_labels(std::make_shared<BinaryLabels>(labels));
+		svm->train(features);
+		return svm;
+	};
+	auto svm=make_svm();
+	auto expected=svm->apply_binary(test_features)->get_values();
+
+	/* split every alpha between two copies of its support vector */
+	auto svs=svm->get_support_vectors();
+	auto alphas=svm->get_alphas();
+	const int32_t num_svs=svs.vlen;
+	SGVector<int32_t> split_svs(2*num_svs);
+	SGVector<float64_t> split_alphas(2*num_svs);
+	for (index_t j=0; j<num_svs; j++)
+	{
+		split_svs[j]=split_svs[num_svs+j]=svs[j];
+		split_alphas[j]=0.25*alphas[j];
+		split_alphas[num_svs+j]=0.75*alphas[j];
+	}
+	svm->set_support_vectors(split_svs);
+	svm->set_alphas(split_alphas);
+	EXPECT_EQ(svm->merge_support_vectors(), num_svs);
+	EXPECT_EQ(svm->get_num_support_vectors(), num_svs);
+	auto merged=svm->apply_binary(test_features)->get_values();
+	for (index_t i=0; i<merged.vlen; i++)
+		EXPECT_NEAR(merged[i], expected[i], 1e-10);
+
+	/* k(x,x)=1, so the removed bound bounds the change of the outputs */
+	const float64_t removed=svm->prune_support_vectors(0.5);
+	EXPECT_LE(removed, 0.5);
+	auto pruned=svm->apply_binary(test_features)->get_values();
+	for (index_t i=0; i<pruned.vlen; i++)
+		EXPECT_LE(std::abs(pruned[i]-expected[i]), removed+1e-10);
+
+	/* |f(x)-f'(x)| <= |Psi-Psi'| and |Psi| <= sum_j |alpha_j| */
+	float64_t norm_bound=0;
+	for (auto alpha : alphas)
+		norm_bound+=std::abs(alpha);
+	const float64_t coarse=make_svm()->reduce_support_vectors(2);
+	svm=make_svm();
+	const float64_t error=svm->reduce_support_vectors(8);
+	EXPECT_LT(error, coarse);
+	EXPECT_EQ(svm->get_num_support_vectors(), 8);
+	auto reduced=svm->apply_binary(test_features)->get_values();
+	for (index_t i=0; i<reduced.vlen; i++)
+		EXPECT_LE(std::abs(reduced[i]-expected[i]), error*norm_bound+1e-10);
+}
@@ -0,0 +1,70 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/svm/OnlineSVMSGD.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+
+#include <random>
+
+using namespace shogun;
+
+/* linearly separable data, labels are the sign of the first coordinate */
+static void generate_data(
+	SGMatrix<float64_t>& data, SGVector<float64_t>& labels, uint64_t seed)
+{
+	std::mt19937_64 prng(seed);
+	std::normal_distribution<float64_t> normal;
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		labels[i]=i%2 ? 1 : -1;
+		data(0, i)=labels[i]*(1+std::abs(normal(prng)));
+		for (index_t j=1; j<data.num_rows; j++)
+			data(j, i)=normal(prng);
+	}
+}
+
+static float64_t train_accuracy(
+	int32_t num_workers, bool averaging, const SGMatrix<float64_t>& data,
+	SGVector<float64_t>& labels)
+{
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto stream=std::make_shared<StreamingDenseFeatures<float64_t>>(
+		features, labels.vector);
+
+	auto sgd=std::make_shared<OnlineSVMSGD>(1.0, stream);
+	sgd->set_lambda(1e-3);
+	sgd->set_epochs(2);
+	sgd->set_num_workers(num_workers);
+	sgd->set_batch_size(128);
+	sgd->set_averaging(averaging);
+	sgd->train();
+
+	auto w=sgd->get_w();
+	const float64_t bias=sgd->get_bias();
+	index_t correct=0;
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		float64_t output=bias;
+		for (index_t j=0; j<data.num_rows; j++)
+			output+=w[j]*data(j, i);
+		correct+=output*labels[i]>0;
+	}
+
+	return float64_t(correct)/data.num_cols;
+}
+
+TEST(OnlineSVMSGD, parallel_workers)
+{
+	SGMatrix<float64_t> data(5, 2000);
+	SGVector<float64_t> labels(data.num_cols);
+	generate_data(data, labels, 17);
+
+	EXPECT_GT(train_accuracy(1, false, data, labels), 0.95);
+	EXPECT_GT(train_accuracy(4, false, data, labels), 0.95);
+	EXPECT_GT(train_accuracy(4, true, data, labels), 0.95);
+}
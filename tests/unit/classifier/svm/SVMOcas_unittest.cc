@@ -5,9 +5,12 @@
 #include <shogun/evaluation/ContingencyTableEvaluation.h>
 #include <shogun/features/DataGenerator.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
 
 #include "environments/LinearTestEnvironment.h"
 
+#include <random>
+
 using namespace shogun;
 
 extern LinearTestEnvironment* linear_test_env;
@@ -39,3 +42,26 @@ TEST(SVMOcasTest,train)
 
 }
 #endif // HAVE_LAPACK
+
+TEST(SVMOcasTest, threads_match_sequential)
+{
+	std::mt19937_64 prng(17);
+	auto data=DataGenerator::generate_gaussians(2500, 2, 5, prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	SGVector<float64_t> lab(features->get_num_vectors());
+	for (index_t i=0; i<lab.vlen; i++)
+		lab[i]=i<lab.vlen/2 ? -1 : 1;
+	auto labels=std::make_shared<BinaryLabels>(lab);
+
+	auto train=[&](int32_t num_threads) {
+		env()->set_num_threads(num_threads);
+		auto ocas=std::make_shared<SVMOcas>(1.0, features, labels);
+		ocas->set_epsilon(1e-5);
+		ocas->train();
+		return ocas->compute_primal_objective();
+	};
+
+	const float64_t expected=train(1);
+	EXPECT_NEAR(train(4), expected, 1e-6*std::abs(expected));
+	env()->set_num_threads(1);
+}
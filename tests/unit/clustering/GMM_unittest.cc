@@ -0,0 +1,67 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+class GMMTest : public ::testing::TestWithParam<ECovType>
+{
+};
+
+TEST_P(GMMTest, train_em)
+{
+	std::mt19937_64 prng(19);
+	const index_t num=200;
+	// gaussians around (-5, -5) and (-10, 10)
+	auto features=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(num, 2, 2, prng));
+
+	auto gmm=std::make_shared<GMM>(2, GetParam());
+	gmm->put("seed", 3);
+	gmm->train(features);
+	const float64_t log_likelihood=gmm->train_em();
+
+	for (auto i : {0, 1})
+	{
+		auto mean=gmm->get_nth_mean(i);
+		const float64_t x=mean[0]<-7.5 ? -10 : -5;
+		const float64_t y=mean[0]<-7.5 ? 10 : -5;
+		EXPECT_NEAR(mean[0], x, 0.5);
+		EXPECT_NEAR(mean[1], y, 0.5);
+		EXPECT_NEAR(gmm->get_coef()[i], 0.5, 0.05);
+
+		// unit covariances
+		auto cov=gmm->get_nth_cov(i);
+		EXPECT_NEAR(cov(0, 0), 1, 0.3);
+		EXPECT_NEAR(cov(1, 1), 1, 0.3);
+		EXPECT_NEAR(cov(0, 1), 0, 0.3);
+	}
+
+	// the batched E-step agrees with the densities of the components
+	float64_t expected=0;
+	for (index_t i=0; i<features->get_num_vectors(); i++)
+	{
+		auto point=features->get_feature_vector(i);
+		float64_t likelihood=0;
+		for (auto j : {0, 1})
+		{
+			likelihood+=gmm->get_coef()[j]*
+				std::exp(gmm->get_comp()[j]->compute_log_PDF(point));
+		}
+		expected+=std::log(likelihood);
+	}
+	EXPECT_NEAR(log_likelihood, expected, 1e-6*std::abs(expected));
+}
+
+INSTANTIATE_TEST_CASE_P(
+	CovTypes, GMMTest, ::testing::Values(FULL, DIAG, SPHERICAL));
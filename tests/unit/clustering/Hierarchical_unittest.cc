@@ -0,0 +1,120 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/Hierarchical.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <random>
+
+using namespace shogun;
+
+/* the getters expose the first get_merges() entries only, but the tables
+ * hold all num-1 merges */
+static SGVector<float64_t> all_merge_distances(
+	const std::shared_ptr<Hierarchical>& clustering, index_t num)
+{
+	return SGVector<float64_t>(
+		clustering->get_merge_distances().vector, num-1, false);
+}
+
+static SGMatrix<int32_t> all_cluster_pairs(
+	const std::shared_ptr<Hierarchical>& clustering, index_t num)
+{
+	return SGMatrix<int32_t>(
+		clustering->get_cluster_pairs().matrix, 2, num-1, false);
+}
+
+TEST(Hierarchical, single_linkage_line)
+{
+	/* points 0, 1, 3, 7 on a line */
+	SGMatrix<float64_t> data(1, 4);
+	data[0]=0;
+	data[1]=1;
+	data[2]=3;
+	data[3]=7;
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+
+	auto clustering=std::make_shared<Hierarchical>(1, distance);
+	clustering->train(features);
+
+	auto merge_distances=all_merge_distances(clustering, 4);
+	EXPECT_NEAR(merge_distances[0], 1, 1e-12);
+	EXPECT_NEAR(merge_distances[1], 2, 1e-12);
+	EXPECT_NEAR(merge_distances[2], 4, 1e-12);
+
+	auto pairs=all_cluster_pairs(clustering, 4);
+	EXPECT_EQ(pairs(0, 0), 0);
+	EXPECT_EQ(pairs(1, 0), 1);
+	EXPECT_EQ(pairs(0, 1), 2);
+	EXPECT_EQ(pairs(1, 1), 4);
+	EXPECT_EQ(pairs(0, 2), 3);
+	EXPECT_EQ(pairs(1, 2), 5);
+}
+
+TEST(Hierarchical, on_demand_matches_precomputed)
+{
+	std::mt19937_64 prng(17);
+	auto data=DataGenerator::generate_gaussians(30, 4, 2, prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	const index_t num=features->get_num_vectors();
+
+	auto train=[&](EHierarchicalLinkage linkage, bool precompute) {
+		auto distance=std::make_shared<EuclideanDistance>(features, features);
+		auto clustering=std::make_shared<Hierarchical>(1, distance);
+		clustering->set_linkage(linkage);
+		clustering->set_precompute_distances(precompute);
+		clustering->train(features);
+		return clustering;
+	};
+
+	for (auto linkage : {LINKAGE_SINGLE, LINKAGE_WARD})
+	{
+		auto precomputed=train(linkage, true);
+		auto on_demand=train(linkage, false);
+
+		auto expected=all_merge_distances(precomputed, num);
+		auto merge_distances=all_merge_distances(on_demand, num);
+		for (index_t i=0; i<num-1; i++)
+		{
+			EXPECT_NEAR(merge_distances[i], expected[i], 1e-8);
+			if (i>0)
+				EXPECT_LE(merge_distances[i-1], merge_distances[i]);
+		}
+
+		auto expected_pairs=all_cluster_pairs(precomputed, num);
+		auto pairs=all_cluster_pairs(on_demand, num);
+		for (index_t i=0; i<2*(num-1); i++)
+			EXPECT_EQ(pairs[i], expected_pairs[i]);
+	}
+}
+
+TEST(Hierarchical, linkages_sorted)
+{
+	std::mt19937_64 prng(23);
+	auto data=DataGenerator::generate_gaussians(20, 3, 2, prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	const index_t num=features->get_num_vectors();
+
+	for (auto linkage : {LINKAGE_COMPLETE, LINKAGE_AVERAGE})
+	{
+		auto distance=std::make_shared<EuclideanDistance>(features, features);
+		auto clustering=std::make_shared<Hierarchical>(1, distance);
+		clustering->set_linkage(linkage);
+		clustering->train(features);
+
+		auto merge_distances=all_merge_distances(clustering, num);
+		for (index_t i=1; i<num-1; i++)
+			EXPECT_LE(merge_distances[i-1], merge_distances[i]);
+
+		auto assignment=clustering->get_assignment();
+		for (index_t i=1; i<num; i++)
+			EXPECT_EQ(assignment[i], assignment[0]);
+	}
+}
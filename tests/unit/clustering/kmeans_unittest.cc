@@ -9,13 +9,61 @@
 #include <shogun/clustering/KMeans.h>
 #include <shogun/clustering/KMeansMiniBatch.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DataGenerator.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
+#include <shogun/lib/TCPCommunicator.h>
 #include <shogun/lib/observers/ParameterObserver.h>
 #include <shogun/lib/observers/ParameterObserverLogger.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
 
 using namespace shogun;
 
+/* train one KMeans per shard with a TCPCommunicator, shard i holds the
+ * vectors i, i+num_shards, ... */
+template <class Setup>
+std::vector<SGMatrix<float64_t>> train_sharded(
+    const SGMatrix<float64_t>& data, int32_t num_shards, Setup setup)
+{
+	auto root=std::make_shared<TCPCommunicator>(
+		0, num_shards, "127.0.0.1", 0);
+	const int32_t port=root->get_port();
+	std::vector<SGMatrix<float64_t>> centers(num_shards);
+	auto run=[&](std::shared_ptr<TCPCommunicator> communicator) {
+		const int32_t rank=communicator->get_rank();
+		const index_t num=(data.num_cols-rank+num_shards-1)/num_shards;
+		SGMatrix<float64_t> shard(data.num_rows, num);
+		for (index_t i=0; i<num; i++)
+		{
+			for (index_t j=0; j<data.num_rows; j++)
+				shard(j, i)=data(j, rank+i*num_shards);
+		}
+
+		auto features=std::make_shared<DenseFeatures<float64_t>>(shard);
+		auto clustering=setup(features);
+		clustering->set_communicator(communicator);
+		clustering->train(features);
+		centers[rank]=clustering->get_cluster_centers();
+	};
+
+	std::vector<std::thread> workers;
+	for (int32_t rank=1; rank<num_shards; rank++)
+	{
+		workers.emplace_back(run, std::make_shared<TCPCommunicator>(
+			rank, num_shards, "127.0.0.1", port));
+	}
+	run(root);
+	for (auto& worker : workers)
+		worker.join();
+	return centers;
+}
+
 void check_consistency_observable(
     const std::shared_ptr<KMeans>& kmeans, const std::shared_ptr<ParameterObserver>& observer)
 {
@@ -293,3 +341,163 @@ TEST(KMeans, random_centers_assign)
 
 }
 
+
+TEST(KMeans, accelerated_algorithms_match_lloyd)
+{
+	std::mt19937_64 prng(41);
+	auto data=DataGenerator::generate_gaussians(100, 5, 3, prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	/* deliberately poor initial centers to force several iterations */
+	SGMatrix<float64_t> initial_centers(3, 8);
+	for (index_t j=0; j<initial_centers.num_cols; j++)
+	{
+		for (index_t i=0; i<initial_centers.num_rows; i++)
+			initial_centers(i, j)=data(i, j);
+	}
+
+	auto train=[&](EKMeansAlgorithm algorithm) {
+		auto distance=std::make_shared<EuclideanDistance>(features, features);
+		auto clustering=std::make_shared<KMeans>(8, distance, initial_centers);
+		clustering->set_algorithm(algorithm);
+		clustering->train(features);
+		return clustering->get_cluster_centers();
+	};
+
+	auto lloyd=train(KMEANS_LLOYD);
+	for (auto algorithm : {KMEANS_HAMERLY, KMEANS_ELKAN})
+	{
+		auto centers=train(algorithm);
+		ASSERT_EQ(centers.num_cols, lloyd.num_cols);
+		for (index_t i=0; i<centers.num_rows*centers.num_cols; i++)
+			EXPECT_NEAR(centers.matrix[i], lloyd.matrix[i], 1e-10);
+	}
+}
+
+TEST(KMeans, minibatch_streaming)
+{
+	/* four well separated blobs around (0,0) (0,100) (100,0) (100,100) */
+	const index_t num_per_blob=250;
+	std::mt19937_64 prng(29);
+	NormalDistribution<float64_t> normal;
+	SGMatrix<float64_t> data(2, 4*num_per_blob);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		data(0, i)=100*((i%4)/2)+normal(prng);
+		data(1, i)=100*(i%2)+normal(prng);
+	}
+
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto stream=std::make_shared<StreamingDenseFeatures<float64_t>>(features);
+	auto distance=std::make_shared<EuclideanDistance>();
+	auto clustering=std::make_shared<KMeansMiniBatch>(4, distance);
+	clustering->put("seed", 3);
+	clustering->put<int32_t>("batch_size", 50);
+	clustering->put<int32_t>("init_sample_size", 200);
+	clustering->put<int32_t>("num_passes", 2);
+	clustering->train(stream);
+
+	auto centers=clustering->get_cluster_centers();
+	ASSERT_EQ(centers.num_rows, 2);
+	ASSERT_EQ(centers.num_cols, 4);
+
+	/* every blob is found by exactly one center */
+	SGVector<int32_t> found(4);
+	found.zero();
+	for (index_t c=0; c<centers.num_cols; c++)
+	{
+		const int32_t x=std::lround(centers(0, c)/100);
+		const int32_t y=std::lround(centers(1, c)/100);
+		ASSERT_TRUE(x>=0 && x<=1 && y>=0 && y<=1);
+		EXPECT_NEAR(centers(0, c), 100*x, 0.5);
+		EXPECT_NEAR(centers(1, c), 100*y, 0.5);
+		found[2*x+y]++;
+	}
+	for (index_t b=0; b<found.vlen; b++)
+		EXPECT_EQ(found[b], 1);
+
+	/* the trained machine assigns in-memory data to the centers */
+	auto result=clustering->apply(features)->as<MulticlassLabels>();
+	EXPECT_EQ(result->get_num_labels(), data.num_cols);
+}
+
+TEST(KMeans, sharded_matches_single_process)
+{
+	std::mt19937_64 prng(43);
+	auto data=DataGenerator::generate_gaussians(60, 4, 3, prng);
+	SGMatrix<float64_t> initial_centers(3, 6);
+	for (index_t j=0; j<initial_centers.num_cols; j++)
+	{
+		for (index_t i=0; i<initial_centers.num_rows; i++)
+			initial_centers(i, j)=data(i, 3*j);
+	}
+
+	for (auto algorithm : {KMEANS_LLOYD, KMEANS_HAMERLY})
+	{
+		auto setup=[&](const std::shared_ptr<DenseFeatures<float64_t>>& features) {
+			auto distance=std::make_shared<EuclideanDistance>(features, features);
+			auto clustering=std::make_shared<KMeans>(
+				6, distance, initial_centers.clone());
+			clustering->set_algorithm(algorithm);
+			return clustering;
+		};
+
+		auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+		auto single=setup(features);
+		single->train(features);
+		auto expected=single->get_cluster_centers();
+
+		auto sharded=train_sharded(data, 3, setup);
+		for (const auto& centers : sharded)
+		{
+			ASSERT_EQ(centers.num_cols, expected.num_cols);
+			for (index_t i=0; i<centers.num_rows*centers.num_cols; i++)
+			{
+				EXPECT_NEAR(centers.matrix[i], expected.matrix[i], 1e-10);
+				EXPECT_EQ(centers.matrix[i], sharded[0].matrix[i]);
+			}
+		}
+	}
+}
+
+TEST(KMeans, sharded_kmeans_parallel_initialization)
+{
+	/* four well separated blobs around (0,0) (0,100) (100,0) (100,100) */
+	std::mt19937_64 prng(31);
+	NormalDistribution<float64_t> normal;
+	SGMatrix<float64_t> data(2, 400);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		data(0, i)=100*((i%4)/2)+normal(prng);
+		data(1, i)=100*(i%2)+normal(prng);
+	}
+
+	auto sharded=train_sharded(data, 3,
+		[](const std::shared_ptr<DenseFeatures<float64_t>>& features) {
+			auto distance=std::make_shared<EuclideanDistance>(features, features);
+			auto clustering=std::make_shared<KMeans>(4, distance, true);
+			clustering->put("seed", 5);
+			return clustering;
+		});
+
+	for (const auto& centers : sharded)
+	{
+		ASSERT_EQ(centers.num_cols, 4);
+		EXPECT_TRUE(centers.equals(sharded[0]));
+
+		/* every blob is found by exactly one center */
+		SGVector<int32_t> found(4);
+		found.zero();
+		for (index_t c=0; c<centers.num_cols; c++)
+		{
+			const int32_t x=std::lround(centers(0, c)/100);
+			const int32_t y=std::lround(centers(1, c)/100);
+			ASSERT_TRUE(x>=0 && x<=1 && y>=0 && y<=1);
+			EXPECT_NEAR(centers(0, c), 100*x, 0.5);
+			EXPECT_NEAR(centers(1, c), 100*y, 0.5);
+			found[2*x+y]++;
+		}
+		for (index_t b=0; b<found.vlen; b++)
+			EXPECT_EQ(found[b], 1);
+	}
+}
@@ -164,3 +164,37 @@ TEST(HashedDocConverterTest, apply_quadratic_test)
 	SG_FREE(hashes);
 
 }
+
+TEST(HashedDocConverterTest, transform_matches_apply)
+{
+	// enough documents for several chunks of the parallel loop
+	const char* words[] = {"lemons", "life", "gives", "you", "make", "when"};
+	std::vector<SGVector<char>> list;
+	for (index_t i=0; i<500; i++)
+	{
+		std::string doc;
+		for (index_t j=0; j<=i%13; j++)
+			doc += std::string(words[(i*j+j)%6]) + " ";
+		SGVector<char> string(doc.size());
+		std::copy(doc.begin(), doc.end(), string.vector);
+		list.push_back(string);
+	}
+	auto s_feats = std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+
+	auto converter = std::make_shared<HashedDocConverter>(8, true, 2, 1);
+	auto hashed = converter->transform(s_feats)
+		->as<SparseFeatures<float64_t>>();
+
+	ASSERT_EQ(hashed->get_num_vectors(), 500);
+	for (index_t i=0; i<500; i++)
+	{
+		SGSparseVector<float64_t> expected = converter->apply(list[i]);
+		SGSparseVector<float64_t> vec = hashed->get_sparse_feature_vector(i);
+		ASSERT_EQ(vec.num_feat_entries, expected.num_feat_entries);
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			EXPECT_EQ(vec.features[j].feat_index, expected.features[j].feat_index);
+			EXPECT_DOUBLE_EQ(vec.features[j].entry, expected.features[j].entry);
+		}
+	}
+}
@@ -10,6 +10,7 @@
 
 #include <shogun/converter/Isomap.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/NeighborGraph.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/DataGenerator.h>
 #include <shogun/mathematics/Math.h>
@@ -18,6 +19,93 @@
 
 using namespace shogun;
 
+#ifdef HAVE_LAPACK
+TEST(IsomapTest,precomputed_neighbors)
+{
+	std::mt19937_64 prng(11);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(30, 1, 3, prng));
+	auto distance = std::make_shared<EuclideanDistance>(features, features);
+
+	auto isomap = std::make_shared<Isomap>();
+	isomap->set_target_dim(2);
+	isomap->set_k(5);
+	auto expected = isomap->embed_distance(distance)->get_feature_matrix();
+
+	// one graph serves all k up to its number of neighbours
+	isomap->set_neighbor_graph(
+		std::make_shared<NeighborGraph>(distance, 8, true));
+	auto embedding = isomap->embed_distance(distance)->get_feature_matrix();
+
+	for (index_t i = 0; i < expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(std::abs(embedding[i]), std::abs(expected[i]), 1e-8);
+}
+
+TEST(IsomapTest,shared_neighbor_graph)
+{
+	std::mt19937_64 prng(11);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(30, 1, 3, prng));
+
+	auto isomap = std::make_shared<Isomap>();
+	isomap->set_target_dim(2);
+	isomap->set_k(5);
+	auto expected = isomap->transform(features)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	EXPECT_EQ(isomap->get_neighbor_graph(), nullptr);
+
+	// the graph computed by one embedding is reused by another
+	auto graph = isomap->compute_neighbor_graph(features, 8);
+	EXPECT_EQ(isomap->get_neighbor_graph(), graph);
+	EXPECT_EQ(graph->get_max_k(), 8);
+	EXPECT_EQ(graph->get_num_vectors(), 30);
+
+	auto other = std::make_shared<Isomap>();
+	other->set_target_dim(2);
+	other->set_k(5);
+	other->set_neighbor_graph(graph);
+	auto embedding = other->transform(features)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+
+	for (index_t i = 0; i < expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(std::abs(embedding[i]), std::abs(expected[i]), 1e-8);
+}
+
+TEST(IsomapTest,landmark_line)
+{
+	// points along a line, geodesic and euclidean distances agree so the
+	// landmark embedding is exact for the landmarks and the other points
+	const index_t n = 40;
+	SGMatrix<float64_t> matrix(3, n);
+	for (index_t i = 0; i < n; i++)
+	{
+		const float64_t t = (i*7 % n)*0.1;
+		matrix(0, i) = t;
+		matrix(1, i) = 2*t;
+		matrix(2, i) = -t;
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+
+	auto isomap = std::make_shared<Isomap>();
+	isomap->set_target_dim(1);
+	isomap->set_k(4);
+	isomap->set_landmark(true);
+	isomap->set_landmark_number(10);
+	auto embedding = isomap->transform(features)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+
+	for (index_t i = 0; i < n; i++)
+	{
+		for (index_t j = 0; j < n; j++)
+		{
+			const float64_t geodesic = std::sqrt(6.0)*
+				std::abs(matrix(0, i)-matrix(0, j));
+			EXPECT_NEAR(std::abs(embedding[i]-embedding[j]), geodesic, 1e-6);
+		}
+	}
+}
+#endif
+
 #ifdef HAVE_LAPACK
 TEST(IsomapTest,DISABLED_distance_preserving_max_k)
 {
@@ -40,5 +40,33 @@ TEST(TDistributedStochasticNeighborEmbeddingTest,basic)
 	EXPECT_EQ(n_target_dimensions,low_dimensional_features->get_dim_feature_space());
 	EXPECT_EQ(high_dimensional_features->get_num_vectors(),low_dimensional_features->get_num_vectors());
 }
+
+TEST(TDistributedStochasticNeighborEmbeddingTest,interpolation)
+{
+	std::mt19937_64 prng(24);
+
+	const index_t n_samples = 60;
+	const index_t n_dimensions = 3;
+	const index_t n_target_dimensions = 2;
+	auto high_dimensional_features =
+		std::make_shared<DenseFeatures<float64_t>>(DataGenerator::generate_gaussians(n_samples, 2, n_dimensions, prng));
+
+	auto embedder =
+		std::make_shared<TDistributedStochasticNeighborEmbedding>();
+	embedder->set_target_dim(n_target_dimensions);
+	embedder->set_perplexity(5.0);
+	embedder->set_interpolation(true);
+	EXPECT_TRUE(embedder->get_interpolation());
+
+	auto low_dimensional_features =
+	    embedder->transform(high_dimensional_features)
+	        ->as<DenseFeatures<float64_t>>();
+
+	EXPECT_EQ(n_target_dimensions,low_dimensional_features->get_dim_feature_space());
+	EXPECT_EQ(high_dimensional_features->get_num_vectors(),low_dimensional_features->get_num_vectors());
+	auto embedding = low_dimensional_features->get_feature_matrix();
+	for (index_t i = 0; i < embedding.num_rows * embedding.num_cols; i++)
+		EXPECT_TRUE(std::isfinite(embedding[i]));
+}
 #endif // HAVE_LAPACK
 
@@ -144,4 +144,39 @@ TEST(EuclideanDistance, heterogenous_features)
 
 
 
+}
+
+TEST(EuclideanDistance, get_distance_block)
+{
+	const index_t dim=7;
+	const index_t num_lhs=30;
+	const index_t num_rhs=200;
+
+	SGMatrix<float64_t> data_lhs(dim, num_lhs);
+	for (index_t i=0; i<dim*num_lhs; i++)
+		data_lhs[i]=std::sin(i*0.37);
+	SGMatrix<float64_t> data_rhs(dim, num_rhs);
+	for (index_t i=0; i<dim*num_rhs; i++)
+		data_rhs[i]=std::cos(i*0.11);
+
+	auto features_lhs=std::make_shared<DenseFeatures<float64_t>>(data_lhs);
+	auto features_rhs=std::make_shared<DenseFeatures<float64_t>>(data_rhs);
+	auto euclidean=std::make_shared<EuclideanDistance>(features_lhs,features_rhs);
+
+	SGVector<index_t> lhs_idx({4, 0, 29});
+	SGVector<index_t> rhs_idx({199, 3});
+	auto block=euclidean->get_distance_block(lhs_idx, rhs_idx);
+	for (index_t j=0; j<rhs_idx.vlen; j++)
+	{
+		for (index_t i=0; i<lhs_idx.vlen; i++)
+			EXPECT_NEAR(block(i,j), euclidean->distance(lhs_idx[i], rhs_idx[j]), 1e-12);
+	}
+
+	euclidean->set_disable_sqrt(true);
+	auto distance_matrix=euclidean->get_distance_matrix();
+	for (index_t j=0; j<num_rhs; j++)
+	{
+		for (index_t i=0; i<num_lhs; i++)
+			EXPECT_NEAR(distance_matrix(i,j), euclidean->distance(i,j), 1e-12);
+	}
 }
@@ -1,43 +1,96 @@
-/*
- * This software is distributed under BSD 3-clause license (see LICENSE file).
- *
- * Authors: Yuhui Liu
- *
- */
-#include <gtest/gtest.h>
-#include <memory>
-#include <shogun/distance/LevenshteinDistance.h>
-#include <shogun/features/StringFeatures.h>
-
-using namespace shogun;
-
-std::shared_ptr<StringFeatures<char>> create_string_lhs()
-{
-	std::vector<SGVector<char>> strings = {
-	    {'i', 'n', 't', 'e', 'n', 't', 'i', 'o', 'n'},
-	    {'h', 'o', 'r', 's', 'e'},
-	    {'G', 'a', 'u', 's', 's', 'i', 'a', 'n', 'K', 'e', 'r', 'n', 'e', 'l',
-	     's'}};
-	return std::make_shared<StringFeatures<char>>(strings, RAWBYTE);
-}
-
-std::shared_ptr<StringFeatures<char>> create_string_rhs()
-{
-	std::vector<SGVector<char>> strings = {
-	    {'e', 'x', 'e', 'c', 'u', 't', 'i', 'o', 'n'},
-	    {'r', 'o', 's'},
-	    {'G', 'a', 'u', 's', 's', 'i', 'a', 'n', 'K', 'e', 'r', 'n', 'e', 'l'}};
-	return std::make_shared<StringFeatures<char>>(strings, RAWBYTE);
-}
-
-TEST(LevenshteinDistance, distance)
-{
-	auto features_lhs = create_string_lhs();
-	auto features_rhs = create_string_rhs();
-	auto levenshtein =
-	    std::make_shared<LevenshteinDistance>(features_lhs, features_rhs);
-
-	EXPECT_EQ(levenshtein->distance(0, 0), 5);
-	EXPECT_EQ(levenshtein->distance(1, 1), 3);
-	EXPECT_EQ(levenshtein->distance(2, 2), 1);
-}
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Yuhui Liu
+ *
+ */
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <shogun/distance/LevenshteinDistance.h>
+#include <shogun/features/StringFeatures.h>
+
+using namespace shogun;
+
+std::shared_ptr<StringFeatures<char>> create_string_lhs()
+{
+	std::vector<SGVector<char>> strings = {
+	    {'i', 'n', 't', 'e', 'n', 't', 'i', 'o', 'n'},
+	    {'h', 'o', 'r', 's', 'e'},
+	    {'G', 'a', 'u', 's', 's', 'i', 'a', 'n', 'K', 'e', 'r', 'n', 'e', 'l',
+	     's'}};
+	return std::make_shared<StringFeatures<char>>(strings, RAWBYTE);
+}
+
+std::shared_ptr<StringFeatures<char>> create_string_rhs()
+{
+	std::vector<SGVector<char>> strings = {
+	    {'e', 'x', 'e', 'c', 'u', 't', 'i', 'o', 'n'},
+	    {'r', 'o', 's'},
+	    {'G', 'a', 'u', 's', 's', 'i', 'a', 'n', 'K', 'e', 'r', 'n', 'e', 'l'}};
+	return std::make_shared<StringFeatures<char>>(strings, RAWBYTE);
+}
+
+TEST(LevenshteinDistance, distance)
+{
+	auto features_lhs = create_string_lhs();
+	auto features_rhs = create_string_rhs();
+	auto levenshtein =
+	    std::make_shared<LevenshteinDistance>(features_lhs, features_rhs);
+
+	EXPECT_EQ(levenshtein->distance(0, 0), 5);
+	EXPECT_EQ(levenshtein->distance(1, 1), 3);
+	EXPECT_EQ(levenshtein->distance(2, 2), 1);
+}
+
+TEST(LevenshteinDistance, long_strings)
+{
+	// strings spanning several 64 bit words, compared with the dynamic
+	// programming table
+	std::mt19937_64 prng(3);
+	std::vector<SGVector<char>> strings;
+	for (int i = 0; i < 8; ++i)
+	{
+		SGVector<char> str(i * 37);
+		for (auto& c : str)
+			c = 'a' + prng() % (i % 2 ? 2 : 4);
+		strings.push_back(str);
+	}
+	auto features = std::make_shared<StringFeatures<char>>(strings, RAWBYTE);
+	auto levenshtein =
+	    std::make_shared<LevenshteinDistance>(features, features);
+
+	SGVector<index_t> lhs_idx({0, 3, 5, 6, 7});
+	SGVector<index_t> rhs_idx({1, 2, 7});
+	auto block = levenshtein->get_distance_block(lhs_idx, rhs_idx);
+	auto matrix = levenshtein->get_distance_matrix();
+	for (int i = 0; i < 8; ++i)
+	{
+		for (int j = 0; j < 8; ++j)
+		{
+			const auto& a = strings[i];
+			const auto& b = strings[j];
+			SGMatrix<int> dist(a.vlen + 1, b.vlen + 1);
+			for (int k = 0; k <= a.vlen; ++k)
+				dist(k, 0) = k;
+			for (int l = 0; l <= b.vlen; ++l)
+				dist(0, l) = l;
+			for (int k = 1; k <= a.vlen; ++k)
+			{
+				for (int l = 1; l <= b.vlen; ++l)
+					dist(k, l) = std::min(
+					    {dist(k - 1, l - 1) + (a[k - 1] != b[l - 1]),
+					     dist(k - 1, l) + 1, dist(k, l - 1) + 1});
+			}
+
+			EXPECT_EQ(levenshtein->distance(i, j), dist(a.vlen, b.vlen));
+			EXPECT_EQ(matrix(i, j), dist(a.vlen, b.vlen));
+		}
+	}
+	for (int i = 0; i < lhs_idx.vlen; ++i)
+	{
+		for (int j = 0; j < rhs_idx.vlen; ++j)
+			EXPECT_EQ(block(i, j), matrix(lhs_idx[i], rhs_idx[j]));
+	}
+}
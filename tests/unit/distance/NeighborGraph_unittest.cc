@@ -0,0 +1,110 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/NeighborGraph.h>
+#include <shogun/distance/NeighborGraphCache.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+TEST(NeighborGraph, matches_sorted_distances)
+{
+	std::mt19937_64 prng(5);
+	auto lhs=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(20, 3, 2, prng));
+	auto rhs=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(10, 2, 2, prng));
+	auto distance=std::make_shared<EuclideanDistance>(lhs, rhs);
+	auto matrix=distance->get_distance_matrix();
+
+	const int32_t max_k=5;
+	auto graph=std::make_shared<NeighborGraph>(distance, max_k);
+	EXPECT_EQ(graph->get_max_k(), max_k);
+	EXPECT_EQ(graph->get_num_vectors(), rhs->get_num_vectors());
+
+	auto neighbors=graph->get_neighbors(3);
+	auto distances=graph->get_distances(3);
+	EXPECT_EQ(neighbors.num_rows, 3);
+	for (index_t j=0; j<rhs->get_num_vectors(); j++)
+	{
+		std::vector<index_t> order(lhs->get_num_vectors());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](index_t a, index_t b) {
+			return matrix(a, j)<matrix(b, j);
+		});
+		for (index_t i=0; i<3; i++)
+		{
+			EXPECT_EQ(neighbors(i, j), order[i]);
+			EXPECT_NEAR(distances(i, j), matrix(order[i], j), 1e-12);
+		}
+	}
+}
+
+TEST(NeighborGraph, exclude_self)
+{
+	std::mt19937_64 prng(9);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(15, 2, 3, prng));
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+
+	auto graph=std::make_shared<NeighborGraph>(distance, 4, true);
+	auto with_self=std::make_shared<NeighborGraph>(distance, 5);
+	auto neighbors=graph->get_neighbors(4);
+	auto expected=with_self->get_neighbors(5);
+	for (index_t j=0; j<features->get_num_vectors(); j++)
+	{
+		EXPECT_EQ(expected(0, j), j);
+		for (index_t i=0; i<4; i++)
+			EXPECT_EQ(neighbors(i, j), expected(i+1, j));
+	}
+}
+
+TEST(NeighborGraphCache, keyed_by_subsets)
+{
+	std::mt19937_64 prng(3);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(10, 2, 2, prng));
+
+	SGVector<index_t> train(12);
+	train.range_fill();
+	SGVector<index_t> test(8);
+	test.range_fill(12);
+	auto lhs=features->duplicate()->as<DenseFeatures<float64_t>>();
+	auto rhs=features->duplicate()->as<DenseFeatures<float64_t>>();
+	lhs->add_subset(train);
+	rhs->add_subset(test);
+
+	auto cache=std::make_shared<NeighborGraphCache>(6);
+	EXPECT_EQ(cache->clone(), cache);
+
+	auto distance=std::make_shared<EuclideanDistance>(lhs, rhs);
+	auto graph=cache->get_graph(distance, 2);
+	EXPECT_EQ(graph->get_max_k(), 6);
+
+	// other objects selecting the same vectors hit the cache
+	auto other_lhs=features->duplicate()->as<DenseFeatures<float64_t>>();
+	auto other_rhs=features->duplicate()->as<DenseFeatures<float64_t>>();
+	other_lhs->add_subset(train);
+	other_rhs->add_subset(test);
+	auto other=std::make_shared<EuclideanDistance>(other_lhs, other_rhs);
+	EXPECT_EQ(cache->get_graph(other, 4), graph);
+	EXPECT_EQ(cache->get_num_graphs(), 1);
+
+	// a larger k rebuilds the graph
+	EXPECT_EQ(cache->get_graph(other, 8)->get_max_k(), 8);
+	EXPECT_EQ(cache->get_num_graphs(), 1);
+
+	cache->clear();
+	EXPECT_EQ(cache->get_num_graphs(), 0);
+}
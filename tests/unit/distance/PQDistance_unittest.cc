@@ -0,0 +1,78 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/PQDistance.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/PQDenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/multiclass/KNN.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(PQDistance, block_matches_distance)
+{
+	std::mt19937_64 prng(13);
+	auto data=std::make_shared<DenseFeatures<float64_t>>(
+		DataGenerator::generate_gaussians(40, 3, 6, prng));
+	auto pq=std::make_shared<PQDenseFeatures>(3, 4);
+	pq->put("seed", 2);
+	pq->fit(data);
+
+	auto distance=std::make_shared<PQDistance>(pq, data);
+	auto euclidean=std::make_shared<EuclideanDistance>(data, data);
+	const index_t num=data->get_num_vectors();
+
+	SGVector<index_t> idx(num);
+	idx.range_fill();
+	auto block=distance->get_distance_block(idx, idx);
+	float64_t error=0;
+	float64_t total=0;
+	for (index_t j=0; j<num; j++)
+	{
+		for (index_t i=0; i<num; i++)
+		{
+			EXPECT_NEAR(block(i, j), distance->distance(i, j), 1e-10);
+			error+=std::abs(block(i, j)-euclidean->distance(i, j));
+			total+=euclidean->distance(i, j);
+		}
+	}
+	EXPECT_LT(error, 0.2*total);
+
+	// product quantized rhs are compared by their reconstruction
+	auto symmetric=std::make_shared<PQDistance>(pq, pq);
+	EXPECT_NEAR(symmetric->distance(1, 1), 0, 1e-10);
+}
+
+TEST(PQDistance, knn)
+{
+	std::mt19937_64 prng(29);
+	const index_t num_per_class=30;
+	auto data=DataGenerator::generate_gaussians(num_per_class, 3, 4, prng);
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i=0; i<labels.vlen; i++)
+		labels[i]=i/num_per_class;
+
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto pq=std::make_shared<PQDenseFeatures>(2, 4);
+	pq->put("seed", 3);
+	pq->fit(features);
+
+	auto distance=std::make_shared<PQDistance>(pq, features);
+	auto knn=std::make_shared<KNN>(
+		3, distance, std::make_shared<MulticlassLabels>(labels));
+	knn->train();
+	auto output=knn->apply_multiclass(features);
+
+	index_t correct=0;
+	for (index_t i=0; i<labels.vlen; i++)
+		correct+=output->get_label(i)==labels[i];
+	EXPECT_GT(correct, 0.9*labels.vlen);
+}
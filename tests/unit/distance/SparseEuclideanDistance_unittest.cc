@@ -0,0 +1,68 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/SparseEuclideanDistance.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/lib/SGMatrix.h>
+
+using namespace shogun;
+
+TEST(SparseEuclideanDistance, get_distance_matrix)
+{
+	const index_t dim=50;
+	const index_t num_lhs=20;
+	const index_t num_rhs=300;
+
+	// sparse data, each vector has a few non-zero dimensions only
+	SGMatrix<float64_t> data_lhs(dim, num_lhs);
+	data_lhs.zero();
+	for (index_t i=0; i<num_lhs; i++)
+	{
+		for (index_t k=0; k<5; k++)
+			data_lhs((i*7+k*11)%dim, i)=(i+k)%4+0.5;
+	}
+	SGMatrix<float64_t> data_rhs(dim, num_rhs);
+	data_rhs.zero();
+	for (index_t j=0; j<num_rhs; j++)
+	{
+		for (index_t k=0; k<3; k++)
+			data_rhs((j*3+k*17)%dim, j)=(j*k)%5-2.0;
+	}
+
+	auto sparse_lhs=std::make_shared<SparseFeatures<float64_t>>(data_lhs);
+	auto sparse_rhs=std::make_shared<SparseFeatures<float64_t>>(data_rhs);
+	auto dense_lhs=std::make_shared<DenseFeatures<float64_t>>(data_lhs);
+	auto dense_rhs=std::make_shared<DenseFeatures<float64_t>>(data_rhs);
+
+	auto sparse=std::make_shared<SparseEuclideanDistance>(sparse_lhs, sparse_rhs);
+	auto dense=std::make_shared<EuclideanDistance>(dense_lhs, dense_rhs);
+
+	auto sparse_matrix=sparse->get_distance_matrix();
+	auto dense_matrix=dense->get_distance_matrix();
+	ASSERT_EQ(sparse_matrix.num_rows, num_lhs);
+	ASSERT_EQ(sparse_matrix.num_cols, num_rhs);
+
+	for (index_t j=0; j<num_rhs; j++)
+	{
+		for (index_t i=0; i<num_lhs; i++)
+		{
+			EXPECT_NEAR(sparse_matrix(i, j), dense_matrix(i, j), 1e-10);
+			EXPECT_NEAR(sparse->distance(i, j), dense_matrix(i, j), 1e-10);
+		}
+	}
+
+	SGVector<index_t> lhs_idx({3, 0, 7});
+	SGVector<index_t> rhs_idx({299, 5});
+	auto block=sparse->get_distance_block(lhs_idx, rhs_idx);
+	for (index_t j=0; j<rhs_idx.vlen; j++)
+	{
+		for (index_t i=0; i<lhs_idx.vlen; i++)
+			EXPECT_NEAR(block(i, j), dense_matrix(lhs_idx[i], rhs_idx[j]), 1e-10);
+	}
+}
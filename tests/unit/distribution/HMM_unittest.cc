@@ -0,0 +1,65 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/distributions/HMM.h>
+#include <shogun/features/StringFeatures.h>
+
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+std::shared_ptr<StringFeatures<uint16_t>> sequences()
+{
+	const int32_t num_vectors=20;
+	std::vector<SGVector<uint16_t>> strings;
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		SGVector<uint16_t> str(5+i%7);
+		for (int32_t t=0; t<str.vlen; t++)
+			str[t]=(i*t+t/2)%4;
+		strings.push_back(str);
+	}
+	return std::make_shared<StringFeatures<uint16_t>>(strings, DNA);
+}
+}
+
+TEST(HMM, model_probability_matches_forward)
+{
+	auto feats=sequences();
+	auto hmm=std::make_shared<HMM>(feats, 3, 4, 1e-10);
+
+	float64_t sum=0;
+	for (int32_t i=0; i<feats->get_num_vectors(); i++)
+		sum+=hmm->model_probability(i);
+
+	EXPECT_NEAR(
+	    hmm->model_probability(), sum/feats->get_num_vectors(), 1E-8);
+}
+
+TEST(HMM, baum_welch_increases_likelihood)
+{
+	auto feats=sequences();
+	auto hmm=std::make_shared<HMM>(feats, 3, 4, 1e-10);
+	auto estimate=std::make_shared<HMM>(hmm);
+
+	auto likelihood=hmm->model_probability();
+	for (auto i=0; i<5; i++)
+	{
+		hmm.swap(estimate);
+		hmm->estimate_model_baum_welch(estimate);
+		// the likelihood of the estimate is cached while computing the new
+		// model, and has to agree with the forward algorithm
+		EXPECT_NEAR(
+		    estimate->model_probability(), estimate->model_probability_comp()/
+		        feats->get_num_vectors(), 1E-8);
+		EXPECT_GE(hmm->model_probability(), likelihood-1E-10);
+		likelihood=hmm->model_probability();
+	}
+}
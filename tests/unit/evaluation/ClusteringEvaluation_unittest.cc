@@ -0,0 +1,96 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/base/range.h>
+#include <shogun/evaluation/ClusteringAccuracy.h>
+#include <shogun/evaluation/ClusteringMutualInformation.h>
+#include <shogun/labels/MulticlassLabels.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace shogun;
+
+class ClusteringEvaluationTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		// the predicted clusters are a permutation of the classes, with
+		// every tenth vector in the wrong cluster
+		std::mt19937_64 prng(7);
+		std::vector<int32_t> permutation(num_classes);
+		std::iota(permutation.begin(), permutation.end(), 0);
+		std::shuffle(permutation.begin(), permutation.end(), prng);
+
+		SGVector<float64_t> truth(num_vectors);
+		SGVector<float64_t> clusters(num_vectors);
+		for (auto i : range(num_vectors))
+		{
+			truth[i] = i % num_classes;
+			clusters[i] = i % 10 ? permutation[truth[i]]
+			                     : permutation[(i / 10) % num_classes];
+			if (clusters[i] == permutation[truth[i]])
+				num_correct++;
+		}
+
+		ground_truth = std::make_shared<MulticlassLabels>(truth);
+		predicted = std::make_shared<MulticlassLabels>(clusters);
+	}
+
+	const index_t num_classes = 500;
+	const index_t num_vectors = 20000;
+	index_t num_correct = 0;
+	std::shared_ptr<MulticlassLabels> ground_truth;
+	std::shared_ptr<MulticlassLabels> predicted;
+};
+
+TEST_F(ClusteringEvaluationTest, best_map)
+{
+	auto evaluator = std::make_shared<ClusteringAccuracy>();
+	auto mapped = evaluator->best_map(predicted, ground_truth);
+
+	ASSERT_EQ(mapped->get_num_labels(), num_vectors);
+	auto mapped_labels = multiclass_labels(mapped)->get_int_labels();
+	for (auto i : range(num_vectors))
+	{
+		if (i % 10)
+			EXPECT_EQ(mapped_labels[i], ground_truth->get_int_label(i));
+	}
+
+	EXPECT_NEAR(
+		evaluator->evaluate(predicted, ground_truth),
+		float64_t(num_correct) / num_vectors, 1e-12);
+}
+
+TEST_F(ClusteringEvaluationTest, extra_clusters)
+{
+	// more clusters than classes, the extra ones count as wrong
+	SGVector<float64_t> truth({0, 0, 1, 1});
+	SGVector<float64_t> clusters({2, 2, 0, 1});
+
+	auto evaluator = std::make_shared<ClusteringAccuracy>();
+	EXPECT_NEAR(
+		evaluator->evaluate(
+			std::make_shared<MulticlassLabels>(clusters),
+			std::make_shared<MulticlassLabels>(truth)),
+		0.75, 1e-12);
+}
+
+TEST_F(ClusteringEvaluationTest, mutual_information)
+{
+	auto evaluator = std::make_shared<ClusteringMutualInformation>();
+
+	// a permutation of the true labels has all the information
+	EXPECT_NEAR(evaluator->evaluate(ground_truth, ground_truth), 1.0, 1e-12);
+
+	auto score = evaluator->evaluate(predicted, ground_truth);
+	EXPECT_GT(score, 0.5);
+	EXPECT_LT(score, 1.0);
+}
@@ -192,3 +192,34 @@ TYPED_TEST(CrossValidationTests, single_multi_same_result)
 
 	EXPECT_NEAR(single, multi, 1e-7);
 }
+
+using CrossValidationLibSVM = CrossValidationTests<LibSVM>;
+using CrossValidationKRR = CrossValidationTests<KernelRidgeRegression>;
+
+TEST_F(CrossValidationKRR, precompute_kernel)
+{
+	auto reference = this->test_multi_thread();
+
+	init();
+	this->cv->put("seed", 1);
+	this->cv->set_precompute_kernel(true);
+	auto result = cv->evaluate()->get<float64_t>("mean");
+
+	// the shared kernel matrix is stored in single precision
+	EXPECT_NEAR(result, reference, 1e-3 * std::abs(reference));
+}
+
+TEST_F(CrossValidationLibSVM, precompute_kernel_warm_start)
+{
+	auto reference = this->test_multi_thread();
+
+	init();
+	this->cv->put("seed", 1);
+	this->cv->set_precompute_kernel(true);
+	this->cv->set_warm_start(true);
+	auto result = cv->evaluate()->get<float64_t>("mean");
+
+	// warm started folds converge to the same solutions up to the solver's
+	// tolerance, which may flip a few predictions close to the boundary
+	EXPECT_NEAR(result, reference, 0.05);
+}
@@ -0,0 +1,97 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/classifier/Perceptron.h>
+#include <shogun/evaluation/ContingencyTableEvaluation.h>
+#include <shogun/evaluation/CrossValidationSplitting.h>
+#include <shogun/evaluation/HyperparameterSearch.h>
+#include <shogun/evaluation/MeanSquaredError.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/regression/KernelRidgeRegression.h>
+
+#include <algorithm>
+
+using namespace shogun;
+
+TEST(HyperparameterSearch, grid)
+{
+	const index_t num_vectors = 40;
+	SGMatrix<float64_t> data(1, num_vectors);
+	SGVector<float64_t> targets(num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+	{
+		data(0, i) = 0.1 * i;
+		targets[i] = std::sin(data(0, i));
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<RegressionLabels>(targets);
+
+	auto machine = std::make_shared<KernelRidgeRegression>();
+	machine->set_kernel(std::make_shared<GaussianKernel>(1.0));
+
+	auto splitting = std::make_shared<CrossValidationSplitting>(labels, 4);
+	auto search = std::make_shared<HyperparameterSearch>(
+	    machine, features, labels, splitting,
+	    std::make_shared<MeanSquaredError>());
+	search->add_parameter("tau", SGVector<float64_t>({1e-3, 1e-1}));
+	search->add_parameter(
+	    "kernel::width", SGVector<float64_t>({0.1, 1.0, 10.0}));
+
+	auto best = search->search();
+
+	auto candidates = search->get_candidates();
+	auto scores = search->get_scores();
+	ASSERT_EQ(candidates.num_cols, 6);
+	ASSERT_EQ(scores.vlen, 6);
+	EXPECT_EQ(
+	    search->get_best_score(), *std::min_element(scores.begin(), scores.end()));
+
+	auto best_parameters = search->get_best_parameters();
+	EXPECT_EQ(best->get<float64_t>("tau"), best_parameters[0]);
+	EXPECT_EQ(
+	    best->get("kernel")->as<GaussianKernel>()->get_width(),
+	    best_parameters[1]);
+}
+
+TEST(HyperparameterSearch, successive_halving)
+{
+	const index_t num_vectors = 40;
+	SGMatrix<float64_t> data(2, num_vectors);
+	SGVector<float64_t> targets(num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+	{
+		targets[i] = i % 2 ? 1 : -1;
+		data(0, i) = targets[i] + 0.01 * i;
+		data(1, i) = 0.5 - 0.02 * i;
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<BinaryLabels>(targets);
+
+	auto splitting = std::make_shared<CrossValidationSplitting>(labels, 2);
+	auto search = std::make_shared<HyperparameterSearch>(
+	    std::make_shared<Perceptron>(), features, labels, splitting,
+	    std::make_shared<AccuracyMeasure>());
+	search->add_parameter("learn_rate", 0.01, 1.0, true);
+	search->set_strategy(HSS_SUCCESSIVE_HALVING);
+	search->set_num_candidates(9);
+	search->set_budget("max_iterations", 1, 9, 3);
+	search->put("seed", 17);
+
+	auto best = search->search();
+
+	// 9 candidates with budget 1, 3 with budget 3 and 1 with budget 9
+	auto budgets = search->get_budgets();
+	ASSERT_EQ(budgets.vlen, 13);
+	EXPECT_EQ(std::count(budgets.begin(), budgets.end(), 1), 9);
+	EXPECT_EQ(std::count(budgets.begin(), budgets.end(), 3), 3);
+	EXPECT_EQ(budgets[12], 9);
+	EXPECT_EQ(search->get_best_score(), search->get_scores()[12]);
+	EXPECT_EQ(best->get<int32_t>("max_iterations"), 9);
+}
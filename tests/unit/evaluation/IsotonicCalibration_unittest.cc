@@ -0,0 +1,91 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/evaluation/IsotonicCalibration.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(IsotonicCalibrationTest, binary_calibration)
+{
+	SGVector<float64_t> preds({0.1, 0.2, 0.3, 0.4, 0.5, 0.6});
+	SGVector<float64_t> labs({-1, 1, -1, 1, 1, 1});
+
+	auto predictions = std::make_shared<BinaryLabels>(preds);
+	auto labels = std::make_shared<BinaryLabels>(labs);
+
+	auto calibration = std::make_shared<IsotonicCalibration>();
+	EXPECT_EQ(calibration->fit_binary(predictions, labels), true);
+
+	// 0.2 and 0.3 violate the order and are pooled
+	SGVector<float64_t> test({0.05, 0.1, 0.2, 0.3, 0.35, 0.4, 1.0});
+	auto values = calibration->calibrate_binary(
+	                              std::make_shared<BinaryLabels>(test))
+	                  ->get_values();
+	EXPECT_EQ(values[0], 0.0);
+	EXPECT_EQ(values[1], 0.0);
+	EXPECT_EQ(values[2], 0.5);
+	EXPECT_EQ(values[3], 0.5);
+	EXPECT_NEAR(values[4], 0.75, 1E-12);
+	EXPECT_EQ(values[5], 1.0);
+	EXPECT_EQ(values[6], 1.0);
+}
+
+TEST(IsotonicCalibrationTest, multiclass_calibration_parallel)
+{
+	const index_t num_vec = 300;
+	const index_t num_class = 4;
+	std::mt19937_64 prng(23);
+	NormalDistribution<float64_t> normal_dist;
+
+	SGVector<float64_t> tgt(num_vec);
+	for (index_t i = 0; i < num_vec; i++)
+		tgt[i] = i % num_class;
+
+	auto predictions = std::make_shared<MulticlassLabels>(tgt);
+	auto targets = std::make_shared<MulticlassLabels>(tgt);
+	predictions->allocate_confidences_for(num_class);
+	for (index_t i = 0; i < num_vec; i++)
+	{
+		SGVector<float64_t> confs(num_class);
+		for (index_t j = 0; j < num_class; j++)
+			confs[j] = normal_dist(prng) + (j == tgt[i] ? 1.5 : 0.0);
+		predictions->set_multiclass_confidences(i, confs);
+	}
+
+	auto calibrate = [&](int32_t num_threads) {
+		env()->set_num_threads(num_threads);
+		auto calibration = std::make_shared<IsotonicCalibration>();
+		EXPECT_EQ(calibration->fit_multiclass(predictions, targets), true);
+		EXPECT_EQ(calibration->get_num_calibrated_classes(), num_class);
+		return calibration->calibrate_multiclass(predictions);
+	};
+
+	auto serial = calibrate(1);
+	auto parallel = calibrate(4);
+	env()->set_num_threads(1);
+
+	index_t num_correct = 0;
+	for (index_t i = 0; i < num_vec; i++)
+	{
+		auto probs = serial->get_multiclass_confidences(i);
+		auto parallel_probs = parallel->get_multiclass_confidences(i);
+		EXPECT_NEAR(SGVector<float64_t>::sum(probs), 1.0, 1E-12);
+		for (index_t j = 0; j < num_class; j++)
+		{
+			EXPECT_GE(probs[j], 0.0);
+			EXPECT_EQ(probs[j], parallel_probs[j]);
+		}
+		EXPECT_EQ(serial->get_label(i), parallel->get_label(i));
+		num_correct += serial->get_label(i) == tgt[i];
+	}
+	EXPECT_GT(num_correct, num_vec / 2);
+}
@@ -4,10 +4,17 @@
  * Authors: Thoralf Klein, Heiko Strathmann, Viktor Gal
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/labels/BinaryLabels.h>
+#include <shogun/evaluation/BinaryScoreHistogram.h>
+#include <shogun/evaluation/PRCEvaluation.h>
 #include <shogun/evaluation/ROCEvaluation.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <random>
+
 using namespace shogun;
 
 TEST(ROCEvaluation,one)
@@ -29,3 +36,110 @@ TEST(ROCEvaluation,one)
 	
 	
 }
+
+namespace
+{
+	/** noisy scores of random labels, rounded to produce ties */
+	void generate_scores(
+		index_t num_labels, std::shared_ptr<BinaryLabels>& predicted,
+		std::shared_ptr<BinaryLabels>& ground_truth)
+	{
+		std::mt19937_64 prng(23);
+		NormalDistribution<float64_t> randn;
+
+		SGVector<float64_t> labels(num_labels);
+		SGVector<float64_t> scores(num_labels);
+		for (index_t i=0; i<num_labels; i++)
+		{
+			labels[i] = randn(prng) > 0 ? 1 : -1;
+			scores[i] = std::round((labels[i] + 2 * randn(prng)) * 1000) / 1000;
+		}
+
+		ground_truth = std::make_shared<BinaryLabels>(labels);
+		predicted = std::make_shared<BinaryLabels>(labels);
+		predicted->set_values(scores);
+	}
+}
+
+TEST(ROCEvaluation, parallel_same_result)
+{
+	std::shared_ptr<BinaryLabels> predicted, ground_truth;
+	generate_scores(100000, predicted, ground_truth);
+	auto orig_num_threads = env()->get_num_threads();
+
+	env()->set_num_threads(1);
+	auto roc_single = std::make_shared<ROCEvaluation>();
+	auto auc_single = roc_single->evaluate(predicted, ground_truth);
+
+	env()->set_num_threads(4);
+	auto roc_multi = std::make_shared<ROCEvaluation>();
+	auto auc_multi = roc_multi->evaluate(predicted, ground_truth);
+
+	env()->set_num_threads(orig_num_threads);
+
+	EXPECT_EQ(auc_single, auc_multi);
+	EXPECT_TRUE(roc_single->get_ROC().equals(roc_multi->get_ROC()));
+	EXPECT_TRUE(roc_single->get_thresholds().equals(roc_multi->get_thresholds()));
+}
+
+TEST(ROCEvaluation, approximate)
+{
+	std::shared_ptr<BinaryLabels> predicted, ground_truth;
+	generate_scores(100000, predicted, ground_truth);
+
+	auto roc = std::make_shared<ROCEvaluation>();
+	auto exact = roc->evaluate(predicted, ground_truth);
+
+	roc->set_tolerance(1e-3);
+	auto approximate = roc->evaluate(predicted, ground_truth);
+
+	EXPECT_NEAR(approximate, exact, 1e-3);
+	auto graph = roc->get_ROC();
+	EXPECT_EQ(graph(0, 0), 0);
+	EXPECT_EQ(graph(1, graph.num_cols - 1), 1);
+	EXPECT_EQ(roc->get_thresholds().vlen, graph.num_cols - 1);
+}
+
+TEST(PRCEvaluation, approximate)
+{
+	std::shared_ptr<BinaryLabels> predicted, ground_truth;
+	generate_scores(100000, predicted, ground_truth);
+
+	auto prc = std::make_shared<PRCEvaluation>();
+	auto exact = prc->evaluate(predicted, ground_truth);
+
+	prc->set_tolerance(1e-2);
+	auto approximate = prc->evaluate(predicted, ground_truth);
+
+	EXPECT_NEAR(approximate, exact, 1e-2);
+}
+
+TEST(BinaryScoreHistogram, merge)
+{
+	std::shared_ptr<BinaryLabels> predicted, ground_truth;
+	generate_scores(10000, predicted, ground_truth);
+	auto scores = predicted->get_values();
+	auto labels = ground_truth->get_labels();
+
+	auto full = std::make_shared<BinaryScoreHistogram>(256, -8, 8);
+	full->add(scores, labels);
+
+	// two shards
+	auto first = std::make_shared<BinaryScoreHistogram>(256, -8, 8);
+	auto second = std::make_shared<BinaryScoreHistogram>(256, -8, 8);
+	first->add(
+		SGVector<float64_t>(scores.vector, 5000, false),
+		SGVector<float64_t>(labels.vector, 5000, false));
+	second->add(
+		SGVector<float64_t>(scores.vector + 5000, 5000, false),
+		SGVector<float64_t>(labels.vector + 5000, 5000, false));
+	first->merge(second);
+
+	EXPECT_TRUE(first->get_positives().equals(full->get_positives()));
+	EXPECT_TRUE(first->get_negatives().equals(full->get_negatives()));
+	EXPECT_EQ(first->get_num_positives() + first->get_num_negatives(), 10000);
+	EXPECT_EQ(first->get_auROC(), full->get_auROC());
+
+	auto different = std::make_shared<BinaryScoreHistogram>(128, -8, 8);
+	EXPECT_THROW(first->merge(different), ShogunException);
+}
@@ -0,0 +1,144 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/evaluation/CrossValidation.h>
+#include <shogun/evaluation/LOOCrossValidationSplitting.h>
+#include <shogun/evaluation/MeanSquaredError.h>
+#include <shogun/evaluation/RidgeLeaveOneOut.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/lib/View.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/regression/KernelRidgeRegression.h>
+#include <shogun/regression/LinearRidgeRegression.h>
+
+#include <random>
+
+using namespace shogun;
+
+class RidgeLeaveOneOutTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const index_t num_features = 3;
+		const index_t num_vectors = 20;
+
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> randn;
+
+		SGMatrix<float64_t> X(num_features, num_vectors);
+		SGVector<float64_t> y(num_vectors);
+		for (auto i : range(num_vectors))
+		{
+			y[i] = 1.0 + 0.1 * randn(prng);
+			for (auto j : range(num_features))
+			{
+				X(j, i) = randn(prng);
+				y[i] += (j + 1) * X(j, i);
+			}
+		}
+
+		features = std::make_shared<DenseFeatures<float64_t>>(X);
+		labels = std::make_shared<RegressionLabels>(y);
+	}
+
+	/** leave-one-out predictions by retraining the machine n times */
+	SGVector<float64_t> retrained_predictions(const std::shared_ptr<Machine>& machine)
+	{
+		const index_t n = labels->get_num_labels();
+		SGVector<float64_t> predictions(n);
+		for (auto i : range(n))
+		{
+			SGVector<index_t> idx_train(n - 1);
+			for (auto j : range(n - 1))
+				idx_train[j] = j < i ? j : j + 1;
+			SGVector<index_t> idx_test({i});
+
+			auto clone = make_clone(machine);
+			clone->set_labels(view(labels, idx_train));
+			clone->train(view(features, idx_train));
+			predictions[i] = clone->apply_regression(view(features, idx_test))
+			                     ->get_labels()[0];
+		}
+		return predictions;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<RegressionLabels> labels;
+};
+
+TEST_F(RidgeLeaveOneOutTest, linear_ridge_regression)
+{
+	auto machine = std::make_shared<LinearRidgeRegression>();
+	machine->set_tau(0.5);
+
+	auto expected = retrained_predictions(machine);
+	auto predictions =
+	    RidgeLeaveOneOut(machine, features, labels).loo_predictions();
+
+	ASSERT_EQ(predictions.vlen, expected.vlen);
+	for (auto i : range(expected.vlen))
+		EXPECT_NEAR(predictions[i], expected[i], 1e-8);
+}
+
+TEST_F(RidgeLeaveOneOutTest, kernel_ridge_regression)
+{
+	auto machine = std::make_shared<KernelRidgeRegression>(
+	    0.1, std::make_shared<GaussianKernel>(2.0), nullptr);
+
+	auto expected = retrained_predictions(machine);
+	auto predictions =
+	    RidgeLeaveOneOut(machine, features, labels).loo_predictions();
+
+	ASSERT_EQ(predictions.vlen, expected.vlen);
+	for (auto i : range(expected.vlen))
+		EXPECT_NEAR(predictions[i], expected[i], 1e-6);
+}
+
+TEST_F(RidgeLeaveOneOutTest, regularization_path)
+{
+	auto machine = std::make_shared<KernelRidgeRegression>(
+	    0.1, std::make_shared<GaussianKernel>(2.0), nullptr);
+	RidgeLeaveOneOut loo(machine, features, labels);
+
+	SGVector<float64_t> taus({0.001, 0.01, 0.1, 1.0});
+	auto errors = loo.loo_errors(taus);
+	auto gcv = loo.gcv_errors(taus);
+
+	for (auto k : range(taus.vlen))
+	{
+		auto predictions = loo.loo_predictions(taus[k]);
+		float64_t mse = 0;
+		for (auto i : range(predictions.vlen))
+			mse += Math::sq(predictions[i] - labels->get_label(i));
+		EXPECT_NEAR(errors[k], mse / predictions.vlen, 1e-10);
+		EXPECT_GT(gcv[k], 0);
+	}
+}
+
+TEST_F(RidgeLeaveOneOutTest, cross_validation)
+{
+	auto machine = std::make_shared<LinearRidgeRegression>();
+	machine->set_tau(0.5);
+
+	auto expected = retrained_predictions(machine);
+	float64_t mse = 0;
+	for (auto i : range(expected.vlen))
+		mse += Math::sq(expected[i] - labels->get_label(i));
+	mse /= expected.vlen;
+
+	auto cv = std::make_shared<CrossValidation>(
+	    machine, features, labels,
+	    std::make_shared<LOOCrossValidationSplitting>(labels),
+	    std::make_shared<MeanSquaredError>());
+	auto result = cv->evaluate()->get<float64_t>("mean");
+
+	EXPECT_NEAR(result, mse, 1e-8);
+}
@@ -5,6 +5,8 @@
  */
 #include <gtest/gtest.h>
 #include <shogun/evaluation/SigmoidCalibration.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -110,3 +112,45 @@ TEST(SigmoidCalibrationTest, multiclass_calibration)
 		}
 	}
 }
+
+TEST(SigmoidCalibrationTest, multiclass_outputs_match_labels)
+{
+	SGVector<float64_t> tgt({0, 1, 2, 0, 1, 2, 0, 2});
+	double preds[] = {2.1,  -0.3, -1.2, -0.5, 1.7,  -0.8, -1.1, 0.2,
+	                  1.4,  0.9,  -1.5, 0.3,  -0.7, 2.2,  -0.6, -1.3,
+	                  -0.2, 1.1,  0.4,  -0.9, -1.0, -1.4, 0.1,  0.8};
+	const index_t num_class = 3;
+
+	auto predictions = std::make_shared<MulticlassLabels>(tgt);
+	auto targets = std::make_shared<MulticlassLabels>(tgt);
+	predictions->allocate_confidences_for(num_class);
+	for (index_t i = 0; i < tgt.vlen; i++)
+	{
+		SGVector<float64_t> confs(num_class);
+		for (index_t j = 0; j < num_class; j++)
+			confs[j] = preds[i * num_class + j];
+		predictions->set_multiclass_confidences(i, confs);
+	}
+
+	auto calibration_method = std::make_shared<SigmoidCalibration>();
+	calibration_method->fit_multiclass(predictions, targets);
+	EXPECT_EQ(calibration_method->get_num_calibrated_classes(), num_class);
+
+	auto calib_result = calibration_method->calibrate_multiclass(predictions);
+	for (index_t i = 0; i < tgt.vlen; i++)
+	{
+		auto outputs = predictions->get_multiclass_confidences(i);
+		calibration_method->calibrate_multiclass_outputs(outputs);
+		auto vals = calib_result->get_multiclass_confidences(i);
+		for (index_t j = 0; j < num_class; j++)
+			EXPECT_EQ(vals[j], outputs[j]);
+		EXPECT_EQ(
+		    calib_result->get_label(i),
+		    Math::arg_max(vals.vector, 1, vals.vlen));
+	}
+
+	SGVector<float64_t> wrong_size(num_class + 1);
+	EXPECT_THROW(
+	    calibration_method->calibrate_multiclass_outputs(wrong_size),
+	    ShogunException);
+}
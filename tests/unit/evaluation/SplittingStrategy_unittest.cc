@@ -6,6 +6,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/evaluation/CrossValidationSplitting.h>
 #include <shogun/evaluation/LOOCrossValidationSplitting.h>
 #include <shogun/evaluation/StratifiedCrossValidationSplitting.h>
@@ -407,3 +408,50 @@ TEST(SplittingStrategy, timeseries_subsets_future_leak)
 		
 	}
 }
+
+TEST(SplittingStrategy, stratified_parallel_same_result)
+{
+	/* large enough for the classes to be shuffled in parallel */
+	index_t num_labels = 400000;
+	index_t num_subsets = 7;
+	auto labels = std::make_shared<MulticlassLabels>(num_labels);
+	for (index_t i = 0; i < num_labels; ++i)
+		labels->set_label(i, i % 3);
+	auto orig_num_threads = env()->get_num_threads();
+
+	auto build = [&](int32_t num_threads) {
+		env()->set_num_threads(num_threads);
+		auto splitting = std::make_shared<StratifiedCrossValidationSplitting>(
+		    labels, num_subsets);
+		splitting->put("seed", 3);
+		splitting->build_subsets();
+		return splitting;
+	};
+	auto single = build(1);
+	auto multi = build(4);
+	env()->set_num_threads(orig_num_threads);
+
+	SGVector<index_t> total(num_labels);
+	total.zero();
+	for (index_t i = 0; i < num_subsets; ++i)
+	{
+		auto subset = single->generate_subset_indices(i);
+		auto subset_multi = multi->generate_subset_indices(i);
+		ASSERT_EQ(subset.vlen, subset_multi.vlen);
+		EXPECT_LE(Math::abs(subset.vlen - num_labels / num_subsets), 1);
+		for (index_t j = 0; j < subset.vlen; ++j)
+		{
+			EXPECT_EQ(subset[j], subset_multi[j]);
+			total[subset[j]]++;
+		}
+
+		auto inverse = single->generate_subset_inverse(i);
+		EXPECT_EQ(inverse.vlen + subset.vlen, num_labels);
+		for (index_t j = 1; j < inverse.vlen; ++j)
+			EXPECT_LT(inverse[j - 1], inverse[j]);
+	}
+
+	/* every index is in exactly one subset */
+	for (index_t i = 0; i < num_labels; ++i)
+		EXPECT_EQ(total[i], 1);
+}
@@ -293,3 +293,53 @@ TEST(CombinedDotFeaturesTest, add_to_dense_vec)
 	delete[] vec;
 	delete[] vec2;
 }
+
+TEST(CombinedDotFeaturesTest, dense_dot_range_mixed)
+{
+	index_t num_vectors = 600;
+	index_t dim = 7;
+	float64_t b = -2;
+
+	SGMatrix<float64_t> data(dim, num_vectors + 10);
+	for (index_t j = 0; j < data.num_rows * data.num_cols; j++)
+		data[j] = (j % 5 == 0) ? 0 : j % 13 - 6;
+
+	auto shifted = std::make_shared<DenseFeatures<float64_t>>(data);
+	SGVector<index_t> range(num_vectors);
+	std::iota(range.vector, range.vector + num_vectors, 10);
+	shifted->add_subset(range);
+
+	// the dense subfeatures alone are computed in one pass, with the
+	// sparse subfeature every subfeature computes its own range
+	for (bool with_sparse : {false, true})
+	{
+		auto comb_feat = std::make_shared<CombinedDotFeatures>();
+		comb_feat->append_feature_obj(std::make_shared<DenseFeatures<float64_t>>(
+		    data.slice(0, num_vectors).clone()));
+		comb_feat->append_feature_obj(shifted);
+		if (with_sparse)
+			comb_feat->append_feature_obj(
+			    std::make_shared<SparseFeatures<float64_t>>(
+			        data.slice(0, num_vectors).clone()));
+		for (index_t i = 0; i < comb_feat->get_num_feature_obj(); i++)
+			comb_feat->set_subfeature_weight(i, 0.5 * (i + 1));
+
+		index_t total_dim = comb_feat->get_dim_feature_space();
+		SGVector<float64_t> vec(total_dim);
+		for (index_t i = 0; i < total_dim; i++)
+			vec[i] = 0.25 * i - 3;
+		SGVector<float64_t> alphas(num_vectors);
+		for (index_t i = 0; i < num_vectors; i++)
+			alphas[i] = i % 3 - 1;
+
+		index_t start = 3, stop = num_vectors - 1;
+		SGVector<float64_t> output(stop - start);
+		comb_feat->dense_dot_range(
+		    output.vector, start, stop, alphas.vector + start, vec.vector,
+		    total_dim, b);
+		for (index_t i = start; i < stop; i++)
+			EXPECT_NEAR(
+			    output[i - start],
+			    alphas[i] * comb_feat->dot(i, vec) + b, 1e-10);
+	}
+}
@@ -0,0 +1,147 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/CompressedDenseFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+/* features with 2, 3, 17 and 1000 distinct values */
+static SGMatrix<float64_t> create_data(int32_t num_vectors, uint64_t seed)
+{
+	std::mt19937_64 prng(seed);
+	std::uniform_int_distribution<int32_t> binary(0, 1);
+	std::uniform_int_distribution<int32_t> ternary(-1, 1);
+	std::uniform_int_distribution<int32_t> small(0, 16);
+	std::normal_distribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(4, num_vectors);
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		data(0, i)=binary(prng);
+		data(1, i)=0.5*ternary(prng);
+		data(2, i)=small(prng)+0.25;
+		data(3, i)=normal(prng);
+	}
+	return data;
+}
+
+TEST(CompressedDenseFeatures, lossless_encodings)
+{
+	auto data=create_data(1000, 3);
+	auto feats=std::make_shared<CompressedDenseFeatures>(data);
+
+	EXPECT_EQ(feats->get_num_vectors(), 1000);
+	EXPECT_EQ(feats->get_dim_feature_space(), 4);
+	EXPECT_EQ(feats->get_encoding(0), CE_DICTIONARY);
+	EXPECT_EQ(feats->get_encoding(1), CE_DICTIONARY);
+	EXPECT_EQ(feats->get_encoding(2), CE_DICTIONARY);
+	EXPECT_EQ(feats->get_encoding(3), CE_RAW);
+	EXPECT_LT(feats->get_memory_size(), 4*1000*int64_t(sizeof(float64_t)));
+
+	auto decoded=feats->get_feature_matrix();
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		EXPECT_EQ(decoded[i], data[i]);
+}
+
+TEST(CompressedDenseFeatures, dot_products_match_dense)
+{
+	auto data=create_data(3000, 5);
+	auto dense=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto feats=std::make_shared<CompressedDenseFeatures>(data);
+
+	SGVector<float64_t> w(4);
+	w[0]=1.5;
+	w[1]=0;
+	w[2]=-0.25;
+	w[3]=2;
+
+	SGVector<float64_t> expected(3000);
+	SGVector<float64_t> output(3000);
+	dense->dense_dot_range(expected.vector, 0, 3000, NULL, w.vector, 4, 0.5);
+	feats->dense_dot_range(output.vector, 0, 3000, NULL, w.vector, 4, 0.5);
+	for (index_t i=0; i<3000; i++)
+	{
+		EXPECT_NEAR(output[i], expected[i], 1e-12);
+		EXPECT_NEAR(feats->dot(i, w), dense->dot(i, w), 1e-12);
+	}
+	EXPECT_NEAR(feats->dot(7, dense, 8), dense->dot(7, dense, 8), 1e-12);
+
+	SGVector<float64_t> sum(4);
+	SGVector<float64_t> expected_sum(4);
+	sum.zero();
+	expected_sum.zero();
+	feats->add_to_dense_vec(-2, 11, sum.vector, 4, true);
+	dense->add_to_dense_vec(-2, 11, expected_sum.vector, 4, true);
+	for (index_t f=0; f<4; f++)
+		EXPECT_EQ(sum[f], expected_sum[f]);
+}
+
+TEST(CompressedDenseFeatures, subset)
+{
+	auto data=create_data(100, 7);
+	auto feats=std::make_shared<CompressedDenseFeatures>(data);
+
+	SGVector<index_t> subset(3);
+	subset[0]=42;
+	subset[1]=3;
+	subset[2]=99;
+	feats->add_subset(subset);
+	EXPECT_EQ(feats->get_num_vectors(), 3);
+
+	SGVector<float64_t> w(4);
+	w.set_const(1);
+	SGVector<float64_t> output(3);
+	feats->dense_dot_range(output.vector, 0, 3, NULL, w.vector, 4, 0);
+	for (index_t i=0; i<3; i++)
+	{
+		auto vec=feats->get_feature_vector(i);
+		float64_t expected=0;
+		for (index_t f=0; f<4; f++)
+		{
+			EXPECT_EQ(vec[f], data(f, subset[i]));
+			expected+=data(f, subset[i]);
+		}
+		EXPECT_NEAR(output[i], expected, 1e-12);
+	}
+}
+
+TEST(CompressedDenseFeatures, half_precision)
+{
+	auto data=create_data(200, 9);
+	data(3, 0)=std::nan("");
+	data(3, 1)=1e6;
+	auto feats=std::make_shared<CompressedDenseFeatures>(data, CE_FLOAT16);
+	auto bfeats=std::make_shared<CompressedDenseFeatures>(data, CE_BFLOAT16);
+	EXPECT_EQ(feats->get_encoding(3), CE_FLOAT16);
+	EXPECT_EQ(bfeats->get_encoding(3), CE_BFLOAT16);
+
+	auto vec=feats->get_feature_vector(0);
+	EXPECT_TRUE(std::isnan(vec[3]));
+	EXPECT_TRUE(std::isinf(feats->get_feature_vector(1)[3]));
+	EXPECT_NEAR(bfeats->get_feature_vector(1)[3], 1e6, 1e6*1e-2);
+	for (index_t i=2; i<200; i++)
+	{
+		EXPECT_NEAR(feats->get_value(3, i), data(3, i), std::abs(data(3, i))*1e-3+1e-7);
+		EXPECT_NEAR(bfeats->get_value(3, i), data(3, i), std::abs(data(3, i))*1e-2+1e-30);
+	}
+
+	/* exactly representable values */
+	for (float32_t f : {0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 6.1035156e-05f, 5.9604645e-08f})
+	{
+		EXPECT_EQ(CompressedDenseFeatures::half_to_float(
+			CompressedDenseFeatures::float_to_half(f)), f);
+	}
+	for (float32_t f : {0.0f, -0.0f, 1.0f, -2.5f, 65536.0f, 1.1754944e-38f})
+	{
+		EXPECT_EQ(CompressedDenseFeatures::bfloat16_to_float(
+			CompressedDenseFeatures::float_to_bfloat16(f)), f);
+	}
+}
@@ -5,6 +5,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/features/streaming/generators/GaussianBlobsDataGenerator.h>
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
@@ -151,3 +152,70 @@ TEST(MeanShiftDataGenerator,get_next_example)
 
 
 }
+
+TEST(MeanShiftDataGenerator,get_streamed_features)
+{
+	const index_t num_samples=10000;
+	auto gen=std::make_shared<MeanShiftDataGenerator>(2, 5, 1);
+	auto gen_block=std::make_shared<MeanShiftDataGenerator>(2, 5, 1);
+	gen->put("seed", 7);
+	gen_block->put("seed", 7);
+
+	/* a block holds the examples of the stream */
+	auto block=gen_block->get_streamed_features(num_samples)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	for (index_t i=0; i<num_samples; ++i)
+	{
+		gen->get_next_example();
+		auto sample=gen->get_vector();
+		for (index_t j=0; j<sample.vlen; ++j)
+			EXPECT_EQ(block(j, i), sample[j]);
+		gen->release_example();
+	}
+
+	/* parallel blocks only depend on the seed */
+	const auto num_threads=env()->get_num_threads();
+	gen_block->set_parallel(true);
+	SGMatrix<float64_t> parallel[2];
+	for (auto k : {0, 1})
+	{
+		env()->set_num_threads(k==0 ? 1 : 4);
+		gen_block->put("seed", 11);
+		parallel[k]=gen_block->get_streamed_features(num_samples)
+			->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	}
+	env()->set_num_threads(num_threads);
+	EXPECT_TRUE(parallel[0].equals(parallel[1]));
+
+	SGVector<float64_t> mean=Statistics::matrix_mean(parallel[0], false);
+	EXPECT_NEAR(mean[0], 0, 0.1);
+	EXPECT_NEAR(mean[1], 2, 0.1);
+}
+
+TEST(GaussianBlobsDataGenerator,get_streamed_features)
+{
+	const index_t num_samples=10000;
+	auto gen=std::make_shared<GaussianBlobsDataGenerator>(3, 3, 2, Math::PI/4);
+	auto gen_block=std::make_shared<GaussianBlobsDataGenerator>(3, 3, 2, Math::PI/4);
+	gen->put("seed", 7);
+	gen_block->put("seed", 7);
+
+	auto block=gen_block->get_streamed_features(num_samples)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	for (index_t i=0; i<num_samples; ++i)
+	{
+		gen->get_next_example();
+		auto sample=gen->get_vector();
+		EXPECT_EQ(block(0, i), sample[0]);
+		EXPECT_EQ(block(1, i), sample[1]);
+		gen->release_example();
+	}
+
+	gen_block->set_parallel(true);
+	gen_block->put("seed", 11);
+	auto parallel=gen_block->get_streamed_features(num_samples)
+		->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	SGVector<float64_t> mean=Statistics::matrix_mean(parallel, false);
+	EXPECT_NEAR(mean[0], 3, 0.2);
+	EXPECT_NEAR(mean[1], 3, 0.2);
+}
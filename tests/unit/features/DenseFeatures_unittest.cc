@@ -6,6 +6,7 @@
  */
 
 #include <algorithm>
+#include <cmath>
 #include <gtest/gtest.h>
 #include <numeric>
 #include <shogun/util/zip_iterator.h>
@@ -332,4 +333,33 @@ TEST(DenseFeaturesTest, const_iterator)
         for (const auto& [test, truth]: zip_iterator(iter, tmp))
             EXPECT_EQ(test, truth);
     }
-}
\ No newline at end of file
+}
+TEST(DenseFeaturesTest, dense_dot_range)
+{
+	const index_t dim=7, num=600;
+	SGMatrix<float64_t> mat(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		mat[i]=std::sin(i);
+	SGVector<float64_t> w(dim);
+	for (index_t j=0; j<dim; j++)
+		w[j]=j-3;
+	SGVector<float64_t> alphas(num);
+	for (index_t i=0; i<num; i++)
+		alphas[i]=std::cos(i);
+
+	auto feat=std::make_shared<DenseFeatures<float64_t>>(mat);
+	SGVector<float64_t> out(num-10);
+	feat->dense_dot_range(out.vector, 10, num, alphas.vector, w.vector, dim, 0.5);
+	for (index_t i=0; i<out.vlen; i++)
+		EXPECT_NEAR(out[i], alphas[i]*feat->dot(i+10, w)+0.5, 1e-12);
+
+	SGVector<index_t> subset(300);
+	for (index_t i=0; i<subset.vlen; i++)
+		subset[i]=(7*i)%num;
+	feat->add_subset(subset);
+	SGVector<float64_t> sub_out(subset.vlen);
+	feat->dense_dot_range(
+		sub_out.vector, 0, subset.vlen, NULL, w.vector, dim, 0.0);
+	for (index_t i=0; i<subset.vlen; i++)
+		EXPECT_NEAR(sub_out[i], feat->dot(i, w), 1e-12);
+}
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/DotFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 
 using namespace shogun;
 
@@ -165,3 +166,143 @@ TEST_F(DotFeaturesTest, dense_dot_range)
 		    i * (i + 1) * num_feats * ((1 + num_feats) / 2.0) + bias);
 	}
 }
+
+TEST(DotFeaturesBlockTest, dense_block)
+{
+	SGMatrix<float64_t> data(3, 10);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+		data.matrix[i] = i;
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto block = feats->get_dense_block(2, 4);
+	EXPECT_EQ(block.num_rows, 3);
+	EXPECT_EQ(block.num_cols, 4);
+	// in place without subset
+	EXPECT_EQ(block.matrix, data.get_column_vector(2));
+
+	feats->add_subset_range(3, 6);
+	block = feats->get_dense_block(1, 2);
+	EXPECT_EQ(block.matrix, data.get_column_vector(4));
+	feats->remove_subset();
+
+	SGVector<index_t> subset{7, 1, 8, 0};
+	feats->add_subset(subset);
+	block = feats->get_dense_block(1, 3);
+	for (index_t j = 0; j < 3; j++)
+		for (index_t i = 0; i < 3; i++)
+			EXPECT_EQ(block(i, j), data(i, subset[j + 1]));
+
+	EXPECT_THROW(feats->get_dense_block(2, 3), ShogunException);
+}
+
+TEST(DotFeaturesBlockTest, dense_block_cast)
+{
+	SGMatrix<int32_t> data(2, 5);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+		data.matrix[i] = -i;
+	auto feats = std::make_shared<DenseFeatures<int32_t>>(data);
+
+	auto block = feats->get_dense_block(1, 3);
+	for (index_t j = 0; j < 3; j++)
+		for (index_t i = 0; i < 2; i++)
+			EXPECT_EQ(block(i, j), data(i, j + 1));
+}
+
+TEST(DotFeaturesBlockTest, for_each_dense_block)
+{
+	SGMatrix<float64_t> data(2, 7);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+		data.matrix[i] = i;
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	index_t num_blocks = 0, next = 0;
+	feats->for_each_dense_block(
+	    3, [&](int32_t start, const SGMatrix<float64_t>& block) {
+		    EXPECT_EQ(start, next);
+		    EXPECT_EQ(block.num_cols, std::min(3, 7 - start));
+		    EXPECT_EQ(block(1, 0), data(1, start));
+		    next += block.num_cols;
+		    num_blocks++;
+	    });
+	EXPECT_EQ(num_blocks, 3);
+	EXPECT_EQ(next, 7);
+}
+
+TEST(DotFeaturesBlockTest, sparse_block)
+{
+	SGMatrix<float64_t> data(4, 5);
+	data.zero();
+	data(0, 0) = 1;
+	data(3, 0) = 2;
+	data(2, 2) = 3;
+	data(1, 3) = 4;
+	data(2, 3) = 5;
+	data(3, 4) = 6;
+	auto dense = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto sparse = std::make_shared<SparseFeatures<float64_t>>(data);
+
+	SGVector<index_t> subset{3, 2, 0};
+	dense->add_subset(subset);
+	sparse->add_subset(subset);
+
+	// the default implementation and the sparse one agree
+	for (const auto& feats :
+	     {std::static_pointer_cast<DotFeatures>(dense),
+	      std::static_pointer_cast<DotFeatures>(sparse)})
+	{
+		auto block = feats->get_sparse_block(0, 3);
+		EXPECT_EQ(block.num_features, 4);
+		ASSERT_EQ(block.row_offsets.vlen, 4);
+		EXPECT_EQ(block.row_offsets[0], 0);
+		EXPECT_EQ(block.row_offsets[1], 2);
+		EXPECT_EQ(block.row_offsets[2], 3);
+		EXPECT_EQ(block.row_offsets[3], 5);
+		ASSERT_EQ(block.values.vlen, 5);
+
+		SGVector<index_t> indices{1, 2, 2, 0, 3};
+		SGVector<float64_t> values{4, 5, 3, 1, 2};
+		for (index_t k = 0; k < 5; k++)
+		{
+			EXPECT_EQ(block.feature_indices[k], indices[k]);
+			EXPECT_EQ(block.values[k], values[k]);
+		}
+	}
+}
+
+TEST(DotFeaturesBlockTest, dense_dot_range_subset)
+{
+	const index_t num_feats = 5, num_vectors = 600;
+	SGMatrix<float64_t> data(num_feats, num_vectors);
+	for (index_t i = 0; i < num_feats * num_vectors; i++)
+		data.matrix[i] = (i % 17) - 8.0;
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGVector<float64_t> w{1, -2, 0.5, 3, -1};
+	SGVector<index_t> subset(num_vectors / 2);
+	for (index_t i = 0; i < subset.vlen; i++)
+		subset[i] = (i * 7) % num_vectors;
+	feats->add_subset(subset);
+
+	SGVector<float64_t> output(subset.vlen);
+	feats->dense_dot_range(
+	    output.vector, 0, subset.vlen, nullptr, w.vector, num_feats, 1.5);
+	for (index_t i = 0; i < subset.vlen; i++)
+	{
+		float64_t expected = 1.5;
+		for (index_t j = 0; j < num_feats; j++)
+			expected += w[j] * data(j, subset[i]);
+		EXPECT_NEAR(output[i], expected, 1e-12);
+	}
+
+	feats->remove_subset();
+	feats->add_subset_range(100, 400);
+	feats->dense_dot_range(
+	    output.vector, 10, 310, nullptr, w.vector, num_feats, 0);
+	for (index_t i = 0; i < 300; i++)
+	{
+		float64_t expected = 0;
+		for (index_t j = 0; j < num_feats; j++)
+			expected += w[j] * data(j, 110 + i);
+		EXPECT_NEAR(output[i], expected, 1e-12);
+	}
+}
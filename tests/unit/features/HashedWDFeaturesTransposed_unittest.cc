@@ -0,0 +1,110 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/features/hashed/HashedWDFeaturesTransposed.h>
+#include <shogun/lib/Hash.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+class HashedWDFeaturesTransposedTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::mt19937_64 prng(17);
+		std::vector<SGVector<uint8_t>> list;
+		for (index_t i=0; i<num_strings; i++)
+		{
+			SGVector<uint8_t> str(string_length);
+			for (index_t j=0; j<string_length; j++)
+				str[j]=prng()%4;
+			list.push_back(str);
+		}
+		auto strings=std::make_shared<StringFeatures<uint8_t>>(list, RAWDNA);
+		features=std::make_shared<HashedWDFeaturesTransposed>(strings, 0, 4, 4, 6);
+
+		w=SGVector<float64_t>(features->get_dim_feature_space());
+		for (index_t i=0; i<w.vlen; i++)
+			w[i]=float64_t(prng()%1000)/1000-0.5;
+	}
+
+	const index_t num_strings=600;
+	const index_t string_length=25;
+	std::shared_ptr<HashedWDFeaturesTransposed> features;
+	SGVector<float64_t> w;
+};
+
+TEST(Hash, MurmurHash3Prefixes)
+{
+	std::vector<uint8_t> data{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+	std::vector<uint32_t> hashes(data.size());
+	Hash::MurmurHash3Prefixes(data.data(), data.size(), 0xDEADBEAF, hashes.data());
+	for (size_t k=0; k<data.size(); k++)
+		EXPECT_EQ(hashes[k], Hash::MurmurHash3(data.data(), k+1, 0xDEADBEAF));
+}
+
+TEST_F(HashedWDFeaturesTransposedTest, dense_dot_range)
+{
+	SGVector<float64_t> alphas(num_strings);
+	for (index_t i=0; i<num_strings; i++)
+		alphas[i]=i%3-1;
+
+	SGVector<float64_t> output(num_strings-10);
+	features->dense_dot_range(
+		output.vector, 10, num_strings, alphas.vector, w.vector, w.vlen, 0.5);
+	for (index_t i=10; i<num_strings; i++)
+		EXPECT_NEAR(output[i-10], alphas[i]*features->dot(i, w)+0.5, 1e-12);
+
+	SGVector<int32_t> subset{5, 300, 2, 599};
+	SGVector<float64_t> sub_output(subset.vlen);
+	features->dense_dot_range_subset(
+		subset.vector, subset.vlen, sub_output.vector, nullptr, w.vector,
+		w.vlen, 0);
+	for (index_t i=0; i<subset.vlen; i++)
+		EXPECT_NEAR(sub_output[i], features->dot(subset[i], w), 1e-12);
+}
+
+TEST_F(HashedWDFeaturesTransposedTest, add_to_dense_vec)
+{
+	/* the added features are the ones of the dot product */
+	for (index_t i : {0, 7, 599})
+	{
+		SGVector<float64_t> phi(w.vlen);
+		phi.zero();
+		features->add_to_dense_vec(1.0, i, phi.vector, phi.vlen);
+		float64_t expected=0;
+		for (index_t j=0; j<w.vlen; j++)
+			expected+=phi[j]*w[j];
+		EXPECT_NEAR(features->dot(i, w), expected, 1e-12);
+	}
+}
+
+TEST_F(HashedWDFeaturesTransposedTest, add_to_dense_vec_range)
+{
+	SGVector<float64_t> alphas(num_strings-3);
+	for (index_t i=0; i<alphas.vlen; i++)
+		alphas[i]=(i%5)*0.25-0.5;
+
+	SGVector<float64_t> expected=w.clone();
+	for (index_t i=3; i<num_strings; i++)
+		features->add_to_dense_vec(alphas[i-3], i, expected.vector, expected.vlen);
+
+	const auto num_threads=env()->get_num_threads();
+	env()->set_num_threads(4);
+	SGVector<float64_t> result=w.clone();
+	features->add_to_dense_vec_range(
+		alphas.vector, 3, num_strings, result.vector, result.vlen);
+	env()->set_num_threads(num_threads);
+
+	for (index_t i=0; i<w.vlen; i++)
+		EXPECT_EQ(result[i], expected[i]);
+}
@@ -0,0 +1,96 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/PQDenseFeatures.h>
+
+#include <random>
+
+using namespace shogun;
+
+static std::shared_ptr<DenseFeatures<float64_t>> create_data(uint64_t seed)
+{
+	std::mt19937_64 prng(seed);
+	auto data=DataGenerator::generate_gaussians(50, 4, 8, prng);
+	return std::make_shared<DenseFeatures<float64_t>>(data);
+}
+
+TEST(PQDenseFeatures, codes)
+{
+	auto data=create_data(7);
+	auto pq=std::make_shared<PQDenseFeatures>(3, 4);
+	pq->put("seed", 11);
+	pq->fit(data);
+
+	EXPECT_EQ(pq->get_num_vectors(), data->get_num_vectors());
+	EXPECT_EQ(pq->get_num_centroids(), 16);
+	EXPECT_EQ(pq->get_dim(), 8);
+
+	auto codes=pq->get_codes();
+	EXPECT_EQ(codes.num_rows, 3);
+	EXPECT_EQ(codes.num_cols, data->get_num_vectors());
+	for (index_t i=0; i<codes.num_rows*codes.num_cols; i++)
+		EXPECT_LT(codes[i], 16);
+}
+
+TEST(PQDenseFeatures, reconstruction)
+{
+	auto data=create_data(7);
+	auto matrix=data->get_feature_matrix();
+
+	auto error=[&](int32_t num_subspaces) {
+		auto pq=std::make_shared<PQDenseFeatures>(num_subspaces, 4);
+		pq->put("seed", 11);
+		pq->fit(data);
+
+		float64_t result=0;
+		for (index_t i=0; i<matrix.num_cols; i++)
+		{
+			auto decoded=pq->decode(i);
+			for (index_t d=0; d<matrix.num_rows; d++)
+				result+=Math::sq(decoded[d]-matrix(d, i));
+		}
+		return result;
+	};
+
+	float64_t variance=0;
+	for (index_t d=0; d<matrix.num_rows; d++)
+	{
+		float64_t mean=0;
+		for (index_t i=0; i<matrix.num_cols; i++)
+			mean+=matrix(d, i)/matrix.num_cols;
+		for (index_t i=0; i<matrix.num_cols; i++)
+			variance+=Math::sq(matrix(d, i)-mean);
+	}
+
+	// finer subspaces quantize better
+	EXPECT_LT(error(8), error(2));
+	EXPECT_LT(error(2), variance);
+}
+
+TEST(PQDenseFeatures, lookup_table)
+{
+	auto data=create_data(3);
+	auto pq=std::make_shared<PQDenseFeatures>(4, 3);
+	pq->put("seed", 5);
+	pq->fit(data);
+
+	auto query=data->get_feature_vector(0);
+	auto table=pq->compute_lookup_table(query.vector);
+	EXPECT_EQ(table.num_rows, 8);
+	EXPECT_EQ(table.num_cols, 4);
+
+	for (index_t i=0; i<pq->get_num_vectors(); i++)
+	{
+		auto decoded=pq->decode(i);
+		float64_t expected=0;
+		for (index_t d=0; d<decoded.vlen; d++)
+			expected+=Math::sq(decoded[d]-query[d]);
+		EXPECT_NEAR(pq->asymmetric_distance(table, i), expected, 1e-10);
+	}
+}
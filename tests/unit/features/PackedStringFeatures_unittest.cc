@@ -0,0 +1,108 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/PackedStringFeatures.h>
+#include <shogun/features/StringFeatures.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+static std::shared_ptr<StringFeatures<char>>
+create_strings(EAlphabet alpha, const char* symbols, int32_t num_symbols)
+{
+	std::mt19937_64 prng(17);
+	std::uniform_int_distribution<int32_t> symbol(0, num_symbols-1);
+
+	std::vector<SGVector<char>> strings;
+	for (int32_t i=0; i<7; i++)
+	{
+		SGVector<char> str(i*13);
+		for (auto& c : str)
+			c=symbols[symbol(prng)];
+		strings.push_back(str);
+	}
+	return std::make_shared<StringFeatures<char>>(strings, alpha);
+}
+
+TEST(PackedStringFeatures, pack_unpack)
+{
+	for (auto nucleic : {false, true})
+	{
+		auto strings=nucleic ?
+			create_strings(IUPAC_NUCLEIC_ACID, "ACGTURYMKWSBDHVN", 16) :
+			create_strings(DNA, "ACGT", 4);
+		auto packed=std::make_shared<PackedStringFeatures>(strings);
+		EXPECT_EQ(packed->get_bits_per_symbol(), nucleic ? 4 : 2);
+		EXPECT_EQ(packed->get_num_vectors(), strings->get_num_vectors());
+		EXPECT_EQ(packed->get_max_vector_length(), 78);
+
+		auto unpacked=packed->unpack();
+		for (int32_t i=0; i<strings->get_num_vectors(); i++)
+		{
+			auto str=strings->get_feature_vector(i);
+			auto vec=unpacked->get_feature_vector(i);
+			ASSERT_EQ(vec.vlen, str.vlen);
+			for (int32_t j=0; j<str.vlen; j++)
+				EXPECT_EQ(vec[j], str[j]);
+		}
+	}
+}
+
+TEST(PackedStringFeatures, subset)
+{
+	auto strings=create_strings(DNA, "ACGT", 4);
+	auto packed=std::make_shared<PackedStringFeatures>(strings);
+	auto alpha=strings->get_alphabet();
+
+	SGVector<index_t> subset({5, 2});
+	packed->add_subset(subset);
+	EXPECT_EQ(packed->get_num_vectors(), 2);
+	for (int32_t i=0; i<subset.vlen; i++)
+	{
+		auto str=strings->get_feature_vector(subset[i]);
+		auto vec=packed->get_feature_vector(i);
+		ASSERT_EQ(packed->get_vector_length(i), str.vlen);
+		for (int32_t j=0; j<str.vlen; j++)
+		{
+			EXPECT_EQ(vec[j], alpha->remap_to_bin(str[j]));
+			EXPECT_EQ(packed->get_symbol(i, j), vec[j]);
+		}
+	}
+}
+
+TEST(PackedStringFeatures, obtain_from_packed)
+{
+	auto strings=create_strings(DNA, "ACGT", 4);
+	auto packed=std::make_shared<PackedStringFeatures>(strings);
+
+	for (auto rev : {false, true})
+	{
+		for (auto order : {1, 3, 8})
+		{
+			const int32_t start=order-1;
+			auto expected=std::make_shared<StringFeatures<uint16_t>>(
+				strings->get_alphabet());
+			expected->obtain_from_char(strings, start, order, 0, rev);
+			auto kmers=std::make_shared<StringFeatures<uint16_t>>(
+				packed->get_alphabet());
+			EXPECT_TRUE(kmers->obtain_from_packed(packed, start, order, rev));
+
+			EXPECT_EQ(kmers->get_num_symbols(), expected->get_num_symbols());
+			ASSERT_EQ(kmers->get_num_vectors(), expected->get_num_vectors());
+			for (int32_t i=0; i<expected->get_num_vectors(); i++)
+			{
+				auto vec=kmers->get_feature_vector(i);
+				auto ref=expected->get_feature_vector(i);
+				ASSERT_EQ(vec.vlen, ref.vlen);
+				for (int32_t j=0; j<ref.vlen; j++)
+					EXPECT_EQ(vec[j], ref[j]);
+			}
+		}
+	}
+}
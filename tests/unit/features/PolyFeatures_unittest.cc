@@ -0,0 +1,100 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/PolyFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+namespace
+{
+	SGMatrix<float64_t> make_data(index_t dim, index_t num_vectors)
+	{
+		std::mt19937_64 prng(7);
+		NormalDistribution<float64_t> normal;
+		SGMatrix<float64_t> data(dim, num_vectors);
+		for (auto i : range(data.size()))
+			data[i] = normal(prng);
+		return data;
+	}
+
+	float64_t input_dot(const SGMatrix<float64_t>& data, index_t a, index_t b)
+	{
+		float64_t sum = 0;
+		for (auto k : range(data.num_rows))
+			sum += data(k, a) * data(k, b);
+		return sum;
+	}
+} // namespace
+
+TEST(PolyFeatures, dot_is_polynomial_kernel)
+{
+	const index_t num_vectors = 6;
+	auto data = make_data(4, num_vectors);
+	auto dense = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	for (int32_t degree : {1, 2, 3})
+	{
+		auto poly = std::make_shared<PolyFeatures>(dense, degree, false);
+		for (auto i : range(num_vectors))
+		{
+			for (auto j : range(num_vectors))
+			{
+				EXPECT_NEAR(
+				    poly->dot(i, poly, j),
+				    std::pow(input_dot(data, i, j), degree), 1e-10);
+			}
+		}
+	}
+}
+
+TEST(PolyFeatures, dense_block_and_dot_block)
+{
+	const index_t num_vectors = 7;
+	auto data = make_data(3, num_vectors);
+	auto dense = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto poly = std::make_shared<PolyFeatures>(dense, 3, true);
+	const index_t dim = poly->get_dim_feature_space();
+
+	auto block = poly->get_dense_block(2, 4);
+	ASSERT_EQ(block.num_rows, dim);
+	ASSERT_EQ(block.num_cols, 4);
+
+	SGVector<float64_t> w(dim);
+	for (auto k : range(dim))
+		w[k] = 0.1 * k - 0.5;
+
+	for (auto i : range(4))
+	{
+		// the block agrees with add_to_dense_vec and dot
+		SGVector<float64_t> expanded(dim);
+		expanded.zero();
+		poly->add_to_dense_vec(1.0, 2 + i, expanded.vector, dim, false);
+		float64_t w_dot = 0;
+		for (auto k : range(dim))
+		{
+			EXPECT_NEAR(block(k, i), expanded[k], 1e-12);
+			w_dot += block(k, i) * w[k];
+		}
+		EXPECT_NEAR(poly->dot(2 + i, w), w_dot, 1e-10);
+		// normalized to unit norm
+		EXPECT_NEAR(poly->dot(2 + i, poly, 2 + i), 1.0, 1e-6);
+	}
+
+	SGVector<index_t> idx1({0, 3, 6});
+	SGVector<index_t> idx2({1, 2});
+	SGMatrix<float64_t> result(idx1.vlen, idx2.vlen);
+	poly->dot_block(idx1, poly, idx2, result);
+	for (auto i : range(idx1.vlen))
+	{
+		for (auto j : range(idx2.vlen))
+			EXPECT_NEAR(result(i, j), poly->dot(idx1[i], poly, idx2[j]), 1e-10);
+	}
+}
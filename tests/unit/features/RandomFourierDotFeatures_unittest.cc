@@ -5,6 +5,11 @@
  */
 #include <gtest/gtest.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <cmath>
+#include <random>
 
 
 using namespace shogun;
@@ -196,4 +201,61 @@ TEST(RandomFourierDotFeatures, dim_output)
 	EXPECT_EQ(cols, num_vecs);
 }
 
+TEST(RandomFourierDotFeatures, structured_orthogonal_gaussian_kernel)
+{
+	// the number of samples is not a multiple of the block size 32
+	int32_t num_dims = 20;
+	int32_t num_vecs = 10;
+	int32_t num_dims_rff = 2000;
+	float64_t width = 8;
+
+	std::mt19937_64 prng(7);
+	NormalDistribution<float64_t> normal;
+	SGMatrix<float64_t> data(num_dims, num_vecs);
+	for (index_t i=0; i<num_dims*num_vecs; i++)
+		data.matrix[i] = 0.3 * normal(prng);
+
+	auto d_feats = std::make_shared<DenseFeatures<float64_t>>(data);
+	SGVector<float64_t> params(1);
+	params[0] = width;
+	auto r_feats = std::make_shared<RandomFourierDotFeatures>(
+	    d_feats, num_dims_rff, GAUSSIAN, params, STRUCTURED_ORTHOGONAL);
+
+	EXPECT_EQ(r_feats->get_structure(), STRUCTURED_ORTHOGONAL);
+	EXPECT_EQ(r_feats->get_dim_feature_space(), num_dims_rff);
+	// only the offsets are stored per sample
+	EXPECT_EQ(r_feats->get_random_coefficients().num_rows, 1);
+	EXPECT_EQ(r_feats->get_random_coefficients().num_cols, num_dims_rff);
+
+	auto copy = r_feats->duplicate()->as<RandomFourierDotFeatures>();
+	for (index_t i=0; i<num_vecs; i++)
+	{
+		auto z = r_feats->get_random_features(i);
+		EXPECT_EQ(z.vlen, num_dims_rff);
+
+		for (index_t j=0; j<num_vecs; j++)
+		{
+			float64_t sq_dist = 0;
+			for (index_t k=0; k<num_dims; k++)
+				sq_dist += Math::sq(data(k, i) - data(k, j));
+
+			float64_t approx = r_feats->dot(i, r_feats, j);
+			EXPECT_NEAR(approx, std::exp(-sq_dist / width), 0.1);
+			EXPECT_DOUBLE_EQ(copy->dot(i, copy, j), approx);
+		}
 
+		// dense dot and add_to_dense_vec use the same features
+		SGVector<float64_t> ones(num_dims_rff);
+		ones.set_const(1);
+		SGVector<float64_t> zeros(num_dims_rff);
+		zeros.zero();
+		r_feats->add_to_dense_vec(1, i, zeros.vector, zeros.vlen, false);
+		float64_t sum = 0;
+		for (index_t j=0; j<num_dims_rff; j++)
+		{
+			EXPECT_DOUBLE_EQ(zeros[j], z[j]);
+			sum += z[j];
+		}
+		EXPECT_NEAR(r_feats->dot(i, ones), sum, 1e-10);
+	}
+}
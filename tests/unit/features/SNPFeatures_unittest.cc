@@ -0,0 +1,203 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/features/SNPFeatures.h>
+#include <shogun/features/StringFeatures.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+/* random genotypes over two alleles per locus, with missing values */
+std::vector<SGVector<uint8_t>> random_genotypes(
+	int32_t num_vectors, int32_t num_loci, std::mt19937_64& prng)
+{
+	const char alleles[][2]={{'A', 'G'}, {'C', 'T'}, {'A', 'C'}, {'G', 'T'}};
+	std::uniform_int_distribution<int32_t> uniform(0, 9);
+
+	std::vector<SGVector<uint8_t>> list;
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		SGVector<uint8_t> str(2*num_loci);
+		for (int32_t l=0; l<num_loci; l++)
+		{
+			for (int32_t k=0; k<2; k++)
+			{
+				const int32_t r=uniform(prng);
+				str[2*l+k]=r==0 ? '0' : alleles[l % 4][r % 2];
+			}
+		}
+		list.push_back(str);
+	}
+	return list;
+}
+
+/* make the first locus homozygous A in all vectors, so the base strings
+ * differ from those of other random genotypes */
+void fix_first_locus(std::vector<SGVector<uint8_t>>& list)
+{
+	for (auto& str : list)
+		str[0]=str[1]='A';
+}
+
+std::shared_ptr<SNPFeatures> snp_features(const std::vector<SGVector<uint8_t>>& list)
+{
+	return std::make_shared<SNPFeatures>(
+		std::make_shared<StringFeatures<uint8_t>>(list, SNP));
+}
+
+/* genotype of a locus: -1 missing, 0 heterozygous, 1 homozygous minor,
+ * 2 homozygous major */
+int32_t genotype(const SGVector<uint8_t>& str, const char* minor, int32_t l)
+{
+	const uint8_t a1=str[2*l];
+	const uint8_t a2=str[2*l+1];
+	if (a1=='0' || a2=='0')
+		return -1;
+	if (a1!=a2)
+		return 0;
+	return a1==minor[2*l] ? 1 : 2;
+}
+
+/* feature of a locus, heterozygous and missing genotypes are the same */
+int32_t feature(const SGVector<uint8_t>& str, const char* minor, int32_t l)
+{
+	return std::max(genotype(str, minor, l), 0);
+}
+
+float64_t reference_ibs(const SGVector<uint8_t>& a, const SGVector<uint8_t>& b,
+	const char* minor, int32_t num_loci)
+{
+	int32_t shared=0;
+	int32_t typed=0;
+	for (int32_t l=0; l<num_loci; l++)
+	{
+		const int32_t ga=genotype(a, minor, l);
+		const int32_t gb=genotype(b, minor, l);
+		if (ga<0 || gb<0)
+			continue;
+
+		typed++;
+		if (ga==gb)
+			shared+=2;
+		else if (ga==0 || gb==0)
+			shared+=1;
+	}
+	return typed ? shared/(2.0*typed) : 0.0;
+}
+} // namespace
+
+TEST(SNPFeatures, dot)
+{
+	const int32_t num_vectors=7;
+	const int32_t num_loci=150;
+	std::mt19937_64 prng(17);
+	auto list=random_genotypes(num_vectors, num_loci, prng);
+	auto feats=snp_features(list);
+	const char* minor=feats->get_minor_base_string();
+	ASSERT_EQ(feats->get_dim_feature_space(), 3*num_loci);
+
+	SGVector<float64_t> w(feats->get_dim_feature_space());
+	std::uniform_real_distribution<float64_t> uniform(-1, 1);
+	for (auto& v : w)
+		v=uniform(prng);
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		float64_t dot_w=0;
+		SGVector<float64_t> added(w.vlen);
+		added.zero();
+		for (int32_t l=0; l<num_loci; l++)
+		{
+			dot_w+=w[3*l+feature(list[i], minor, l)];
+			added[3*l+feature(list[i], minor, l)]+=0.5;
+		}
+		EXPECT_DOUBLE_EQ(feats->dot(i, w), dot_w/feats->get_normalization_const());
+
+		SGVector<float64_t> vec(w.vlen);
+		vec.zero();
+		feats->add_to_dense_vec(0.5, i, vec.vector, vec.vlen);
+		for (int32_t k=0; k<w.vlen; k++)
+			EXPECT_EQ(vec[k], added[k]);
+
+		for (int32_t j=0; j<num_vectors; j++)
+		{
+			int32_t same=0;
+			for (int32_t l=0; l<num_loci; l++)
+				same+=feature(list[i], minor, l)==feature(list[j], minor, l);
+			EXPECT_EQ(feats->dot(i, feats, j), same);
+		}
+	}
+}
+
+TEST(SNPFeatures, dot_different_base_strings)
+{
+	const int32_t num_loci=70;
+	std::mt19937_64 prng(3);
+	auto list_a=random_genotypes(4, num_loci, prng);
+	auto list_b=random_genotypes(5, num_loci, prng);
+	fix_first_locus(list_b);
+	auto feats_a=snp_features(list_a);
+	auto feats_b=snp_features(list_b);
+
+	// the genotype strings are compared, which is the same as the bit
+	// planes once the base strings agree
+	SGMatrix<float64_t> before(4, 5);
+	for (int32_t i=0; i<4; i++)
+		for (int32_t j=0; j<5; j++)
+			before(i, j)=feats_a->dot(i, feats_b, j);
+
+	feats_a->obtain_base_strings(feats_b);
+	feats_b->obtain_base_strings(feats_a);
+	for (int32_t i=0; i<4; i++)
+		for (int32_t j=0; j<5; j++)
+			EXPECT_EQ(feats_a->dot(i, feats_b, j), before(i, j));
+}
+
+TEST(SNPFeatures, ibs)
+{
+	const int32_t num_loci=130;
+	std::mt19937_64 prng(11);
+	auto list_a=random_genotypes(6, num_loci, prng);
+	auto list_b=random_genotypes(4, num_loci, prng);
+	fix_first_locus(list_b);
+	auto feats_a=snp_features(list_a);
+	auto feats_b=snp_features(list_b);
+
+	EXPECT_THROW(feats_a->ibs(0, feats_b, 0), ShogunException);
+
+	feats_a->obtain_base_strings(feats_b);
+	feats_b->obtain_base_strings(feats_a);
+	const char* minor=feats_a->get_minor_base_string();
+
+	auto cross=feats_a->get_ibs_matrix(feats_b);
+	ASSERT_EQ(cross.num_rows, 6);
+	ASSERT_EQ(cross.num_cols, 4);
+	for (int32_t i=0; i<6; i++)
+	{
+		for (int32_t j=0; j<4; j++)
+		{
+			const float64_t expected=reference_ibs(list_a[i], list_b[j], minor, num_loci);
+			EXPECT_DOUBLE_EQ(feats_a->ibs(i, feats_b, j), expected);
+			EXPECT_DOUBLE_EQ(cross(i, j), expected);
+		}
+	}
+
+	auto gram=feats_a->get_ibs_matrix(feats_a);
+	for (int32_t i=0; i<6; i++)
+	{
+		EXPECT_DOUBLE_EQ(gram(i, i), 1.0);
+		for (int32_t j=0; j<6; j++)
+			EXPECT_DOUBLE_EQ(gram(i, j),
+				reference_ibs(list_a[i], list_a[j], minor, num_loci));
+	}
+}
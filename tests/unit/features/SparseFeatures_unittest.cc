@@ -12,6 +12,7 @@
 #include <shogun/io/stream/FileOutputStream.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/SparseFeatures.h>
+#include <cmath>
 #include <string>
 
 using namespace shogun;
@@ -412,3 +413,20 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 
 }
+
+TEST(SparseFeaturesTest, dense_dot_range)
+{
+	const index_t dim=9, num=700;
+	SGMatrix<float64_t> mat(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		mat[i]=i%3 ? 0 : std::sin(i);
+	SGVector<float64_t> w(dim);
+	for (index_t j=0; j<dim; j++)
+		w[j]=j-4;
+
+	auto feat=std::make_shared<SparseFeatures<float64_t>>(mat);
+	SGVector<float64_t> out(num);
+	feat->dense_dot_range(out.vector, 0, num, NULL, w.vector, dim, 1.0);
+	for (index_t i=0; i<num; i++)
+		EXPECT_NEAR(out[i], feat->dot(i, w)+1.0, 1e-12);
+}
@@ -69,6 +69,54 @@ TEST(StreamingDenseFeaturesTest, example_reading_from_file)
 	std::remove(fname);
 }
 
+TEST(StreamingDenseFeaturesTest, example_reading_from_cache)
+{
+	index_t n=20;
+	index_t dim=3;
+	char fname[] = "StreamingDenseFeatures_cache.XXXXXX";
+	generate_temp_filename(fname);
+	char cache_fname[] = "StreamingDenseFeatures_cache_bin.XXXXXX";
+	generate_temp_filename(cache_fname);
+
+	SGMatrix<float64_t> data(dim,n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i] = i*0.25;
+
+	auto orig_feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto saved_features = std::make_shared<CSVFile>(fname, 'w');
+	orig_feats->save(saved_features);
+	saved_features->close();
+
+	auto input = std::make_shared<StreamingAsciiFile>(fname);
+	input->set_delimiter(',');
+	input->set_cache_file(cache_fname);
+	auto feats
+		= std::make_shared<StreamingDenseFeatures<float64_t>>(input, false, 5);
+	ASSERT_TRUE(feats->is_seekable());
+
+	feats->start_parser();
+	for (index_t pass = 0; pass < 3; pass++)
+	{
+		index_t i = 0;
+		while (feats->get_next_example())
+		{
+			SGVector<float64_t> example = feats->get_vector();
+			ASSERT_EQ(dim, example.vlen);
+			for (index_t j = 0; j < dim; j++)
+				EXPECT_NEAR(data(j, i), example.vector[j], 1E-5);
+
+			feats->release_example();
+			i++;
+		}
+		EXPECT_EQ(i, n);
+
+		// later passes read the cache only
+		std::remove(fname);
+		feats->reset_stream();
+	}
+	feats->end_parser();
+}
+
 TEST(StreamingDenseFeaturesTest, example_reading_from_features)
 {
 	int32_t seed = 17;
@@ -158,3 +158,47 @@ TEST(StreamingHashedDocFeaturesTest, dot_tests)
 
 
 }
+
+TEST(StreamingHashedDocFeaturesTest, streamed_features)
+{
+	const char* doc_1 = "You're never too old to rock and roll, if you're too young to die";
+	const char* doc_2 = "Give me some rope, tie me to dream, give me the hope to run out of steam";
+	const char* doc_3 = "Thank you Jack Daniels, Old Number Seven, Tennessee Whiskey got me drinking in heaven";
+
+	std::vector<SGVector<char>> list;
+	for (auto doc : {doc_1, doc_2, doc_3})
+	{
+		SGVector<char> string(strlen(doc));
+		sg_memcpy(string.vector, doc, string.vlen);
+		list.push_back(string);
+	}
+
+	auto tokenizer = std::make_shared<DelimiterTokenizer>();
+	tokenizer->delimiters[' '] = 1;
+	tokenizer->delimiters['\''] = 1;
+	tokenizer->delimiters[','] = 1;
+
+	auto converter = std::make_shared<HashedDocConverter>(tokenizer, 5, true);
+	auto doc_collection = std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+	auto feats = std::make_shared<StreamingHashedDocDotFeatures>(doc_collection,
+			tokenizer, 5);
+
+	// asks for more documents than there are
+	feats->start_parser();
+	auto hashed = feats->get_streamed_features(5)->as<SparseFeatures<float64_t>>();
+	feats->end_parser();
+
+	ASSERT_EQ(hashed->get_num_vectors(), 3);
+	for (index_t i=0; i<3; i++)
+	{
+		SGSparseVector<float64_t> example = hashed->get_sparse_feature_vector(i);
+		SGSparseVector<float64_t> converted_doc = converter->apply(list[i]);
+
+		ASSERT_EQ(example.num_feat_entries, converted_doc.num_feat_entries);
+		for (index_t j=0; j<example.num_feat_entries; j++)
+		{
+			EXPECT_EQ(example.features[j].feat_index, converted_doc.features[j].feat_index);
+			EXPECT_EQ(example.features[j].entry, converted_doc.features[j].entry);
+		}
+	}
+}
@@ -0,0 +1,101 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SubsetStack.h>
+
+using namespace shogun;
+
+static SGVector<index_t> make_indices(std::initializer_list<index_t> values)
+{
+	SGVector<index_t> indices(values.size());
+	std::copy(values.begin(), values.end(), indices.begin());
+	return indices;
+}
+
+TEST(SubsetStack, ranges_compose_without_indices)
+{
+	SubsetStack stack;
+	stack.add_subset_range(10, 50);
+	stack.add_subset_range(5, 20);
+	EXPECT_TRUE(stack.is_contiguous());
+	EXPECT_EQ(stack.get_size(), 20);
+	EXPECT_EQ(stack.subset_idx_conversion(0), 15);
+	EXPECT_EQ(stack.subset_idx_conversion(19), 34);
+	EXPECT_EQ(stack.get_last_subset()->get_subset_idx()[3], 18);
+
+	/* contiguous index vectors become ranges */
+	stack.add_subset(make_indices({2, 3, 4}));
+	EXPECT_TRUE(stack.get_last_subset()->is_range());
+	EXPECT_EQ(stack.subset_idx_conversion(1), 18);
+
+	stack.remove_subset();
+	EXPECT_EQ(stack.get_size(), 20);
+	stack.remove_subset();
+	EXPECT_EQ(stack.subset_idx_conversion(0), 10);
+}
+
+TEST(SubsetStack, indices_and_ranges_mixed)
+{
+	SubsetStack stack;
+	stack.add_subset(make_indices({9, 7, 5, 3, 1}));
+	EXPECT_FALSE(stack.is_contiguous());
+
+	/* a range of an index subset shares its indices */
+	stack.add_subset_range(1, 3);
+	EXPECT_EQ(stack.get_size(), 3);
+	EXPECT_EQ(stack.subset_idx_conversion(0), 7);
+	EXPECT_EQ(stack.subset_idx_conversion(2), 3);
+
+	/* indices of a range are mapped through the shared indices */
+	stack.add_subset(make_indices({2, 0}));
+	EXPECT_EQ(stack.subset_idx_conversion(0), 3);
+	EXPECT_EQ(stack.subset_idx_conversion(1), 7);
+
+	stack.remove_all_subsets();
+	stack.add_subset_range(100, 10);
+	stack.add_subset(make_indices({4, 1, 8}));
+	EXPECT_EQ(stack.subset_idx_conversion(0), 104);
+	EXPECT_EQ(stack.subset_idx_conversion(2), 108);
+	auto idx = stack.get_last_subset()->get_subset_idx();
+	EXPECT_EQ(idx[1], 101);
+}
+
+TEST(SubsetStack, add_subset_in_place)
+{
+	SubsetStack stack;
+	stack.add_subset_in_place(make_indices({4, 2, 0, 6}));
+	stack.add_subset_in_place(make_indices({3, 1}));
+	EXPECT_EQ(stack.get_size(), 2);
+	EXPECT_EQ(stack.subset_idx_conversion(0), 6);
+	EXPECT_EQ(stack.subset_idx_conversion(1), 2);
+
+	/* only one subset is on the stack */
+	stack.remove_subset();
+	EXPECT_FALSE(stack.has_subsets());
+}
+
+TEST(SubsetStack, dense_features_range_block_in_place)
+{
+	SGMatrix<float64_t> data(2, 10);
+	for (index_t i = 0; i < 20; i++)
+		data[i] = i;
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+	feats->add_subset_range(3, 5);
+	EXPECT_EQ(feats->get_num_vectors(), 5);
+
+	auto block = feats->get_feature_matrix_block(make_indices({1, 2, 3}));
+	EXPECT_EQ(block.matrix, data.get_column_vector(4));
+
+	auto matrix = feats->get_feature_matrix();
+	EXPECT_EQ(matrix.num_cols, 5);
+	for (index_t j = 0; j < 5; j++)
+	{
+		EXPECT_EQ(matrix(0, j), data(0, j + 3));
+		EXPECT_EQ(matrix(1, j), data(1, j + 3));
+	}
+}
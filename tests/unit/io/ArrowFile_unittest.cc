@@ -0,0 +1,169 @@
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_ARROW
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/io/ArrowFile.h>
+#include <shogun/io/streaming/StreamingArrowFile.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <parquet/arrow/writer.h>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+namespace
+{
+	// x: 0..9, y: 10*x as float, label: +-1
+	std::shared_ptr<arrow::Table> make_table()
+	{
+		arrow::Int32Builder x;
+		arrow::FloatBuilder y;
+		arrow::DoubleBuilder label;
+		for (int32_t i = 0; i < 10; i++)
+		{
+			EXPECT_TRUE(x.Append(i).ok());
+			EXPECT_TRUE(y.Append(10 * i).ok());
+			EXPECT_TRUE(label.Append(i % 2 ? 1 : -1).ok());
+		}
+
+		auto schema = arrow::schema(
+		    {arrow::field("x", arrow::int32()),
+		     arrow::field("y", arrow::float32()),
+		     arrow::field("label", arrow::float64())});
+		return arrow::Table::Make(
+		    schema, {x.Finish().ValueOrDie(), y.Finish().ValueOrDie(),
+		             label.Finish().ValueOrDie()});
+	}
+
+	void write_parquet(const char* fname)
+	{
+		auto out = arrow::io::FileOutputStream::Open(fname).ValueOrDie();
+		// two row groups of five rows
+		ASSERT_TRUE(parquet::arrow::WriteTable(
+		                *make_table(), arrow::default_memory_pool(), out, 5)
+		                .ok());
+		ASSERT_TRUE(out->Close().ok());
+	}
+
+	void write_ipc(const char* fname)
+	{
+		auto table = make_table();
+		auto out = arrow::io::FileOutputStream::Open(fname).ValueOrDie();
+		auto writer =
+		    arrow::ipc::MakeFileWriter(out, table->schema()).ValueOrDie();
+		ASSERT_TRUE(writer->WriteTable(*table, 4).ok());
+		ASSERT_TRUE(writer->Close().ok());
+		ASSERT_TRUE(out->Close().ok());
+	}
+}
+
+TEST(ArrowFileTest, parquet_matrix_and_labels)
+{
+	const char* fname = "ArrowFileTest_matrix.parquet";
+	write_parquet(fname);
+
+	auto file = std::make_shared<ArrowFile>(fname);
+	file->set_columns({"y", "x"});
+	SGMatrix<float64_t> matrix;
+	matrix.load(file);
+	ASSERT_EQ(matrix.num_rows, 2);
+	ASSERT_EQ(matrix.num_cols, 10);
+	for (index_t i = 0; i < 10; i++)
+	{
+		EXPECT_EQ(matrix(0, i), 10 * i);
+		EXPECT_EQ(matrix(1, i), i);
+	}
+
+	file->set_columns({"label"});
+	SGVector<float64_t> labels;
+	labels.load(file);
+	ASSERT_EQ(labels.vlen, 10);
+	for (index_t i = 0; i < 10; i++)
+		EXPECT_EQ(labels[i], i % 2 ? 1 : -1);
+
+	file->set_columns({"missing"});
+	EXPECT_THROW(matrix.load(file), ShogunException);
+
+	unlink(fname);
+}
+
+TEST(ArrowFileTest, parquet_row_group_predicate)
+{
+	const char* fname = "ArrowFileTest_predicate.parquet";
+	write_parquet(fname);
+
+	auto file = std::make_shared<ArrowFile>(fname);
+	file->set_columns({"x"});
+	file->add_range_predicate("x", 6, 100);
+	SGVector<int32_t> x;
+	x.load(file);
+	ASSERT_EQ(x.vlen, 5);
+	EXPECT_EQ(x[0], 5);
+
+	file->add_range_predicate("y", -10, -1);
+	x.load(file);
+	EXPECT_EQ(x.vlen, 0);
+
+	file->clear_predicates();
+	x.load(file);
+	EXPECT_EQ(x.vlen, 10);
+
+	unlink(fname);
+}
+
+TEST(ArrowFileTest, ipc_matrix)
+{
+	const char* fname = "ArrowFileTest_matrix.arrow";
+	write_ipc(fname);
+
+	auto file = std::make_shared<ArrowFile>(fname);
+	SGMatrix<float32_t> matrix;
+	matrix.load(file);
+	ASSERT_EQ(matrix.num_rows, 3);
+	ASSERT_EQ(matrix.num_cols, 10);
+	for (index_t i = 0; i < 10; i++)
+	{
+		EXPECT_EQ(matrix(0, i), i);
+		EXPECT_EQ(matrix(1, i), 10 * i);
+		EXPECT_EQ(matrix(2, i), i % 2 ? 1 : -1);
+	}
+
+	unlink(fname);
+}
+
+TEST(ArrowFileTest, streaming_dense_features)
+{
+	const char* fname = "ArrowFileTest_streaming.arrow";
+	write_ipc(fname);
+
+	auto file = std::make_shared<ArrowFile>(fname);
+	file->set_columns({"y", "label", "x"});
+	auto stream = std::make_shared<StreamingArrowFile>(file, "label");
+	auto feats =
+	    std::make_shared<StreamingDenseFeatures<float64_t>>(stream, true, 4);
+
+	feats->start_parser();
+	index_t i = 0;
+	while (feats->get_next_example())
+	{
+		auto vec = feats->get_vector();
+		ASSERT_EQ(vec.vlen, 2);
+		EXPECT_EQ(vec[0], 10 * i);
+		EXPECT_EQ(vec[1], i);
+		EXPECT_EQ(feats->get_label(), i % 2 ? 1 : -1);
+		feats->release_example();
+		i++;
+	}
+	feats->end_parser();
+	EXPECT_EQ(i, 10);
+
+	unlink(fname);
+}
+#endif // HAVE_ARROW
@@ -158,6 +158,73 @@ TEST(CSVFileTest, matrix_float64)
 	unlink("CSVFileTest_matrix_float64_output.txt");
 }
 
+TEST(CSVFileTest, matrix_transposed)
+{
+	int32_t num_rows=3;
+	int32_t num_cols=70;
+	SGMatrix<float64_t> data(num_rows, num_cols);
+	for (int32_t i=0; i<num_rows*num_cols; i++)
+		data[i]=i*0.25-7;
+
+	std::shared_ptr<CSVFile> fin, fout;
+
+	fout=std::make_shared<CSVFile>("CSVFileTest_matrix_transposed_output.txt",'w');
+	fout->set_transpose(true);
+	fout->set_matrix(data.matrix, num_rows, num_cols);
+	// flush the output
+	fout.reset();
+
+	SGMatrix<float64_t> data_from_file(true);
+	fin=std::make_shared<CSVFile>("CSVFileTest_matrix_transposed_output.txt",'r');
+	fin->set_transpose(true);
+	fin->get_matrix(data_from_file.matrix, data_from_file.num_rows, data_from_file.num_cols);
+	EXPECT_EQ(data_from_file.num_rows, num_rows);
+	EXPECT_EQ(data_from_file.num_cols, num_cols);
+
+	for (int32_t i=0; i<num_rows; i++)
+	{
+		for (int32_t j=0; j<num_cols; j++)
+			EXPECT_EQ(data_from_file(i, j), data(i, j));
+	}
+
+	unlink("CSVFileTest_matrix_transposed_output.txt");
+}
+
+TEST(CSVFileTest, matrix_skip_empty_lines)
+{
+	FILE* f=fopen("CSVFileTest_matrix_skip_output.txt", "w");
+	fprintf(f, "a,b,c\r\n1, 2,+3\r\n\n4,5e1,-6.5\r\n7,8,9");
+	fclose(f);
+
+	SGMatrix<float64_t> data_from_file(true);
+	auto fin=std::make_shared<CSVFile>("CSVFileTest_matrix_skip_output.txt",'r');
+	fin->set_lines_to_skip(1);
+	fin->get_matrix(data_from_file.matrix, data_from_file.num_rows, data_from_file.num_cols);
+	EXPECT_EQ(data_from_file.num_rows, 3);
+	EXPECT_EQ(data_from_file.num_cols, 3);
+
+	float64_t expected[]={1, 2, 3, 4, 50, -6.5, 7, 8, 9};
+	for (int32_t i=0; i<9; i++)
+		EXPECT_EQ(data_from_file[i], expected[i]);
+
+	unlink("CSVFileTest_matrix_skip_output.txt");
+}
+
+TEST(CSVFileTest, matrix_inconsistent_lines)
+{
+	FILE* f=fopen("CSVFileTest_matrix_inconsistent_output.txt", "w");
+	fprintf(f, "1,2,3\n4,5\n");
+	fclose(f);
+
+	float64_t* matrix=nullptr;
+	int32_t num_feat=0;
+	int32_t num_vec=0;
+	auto fin=std::make_shared<CSVFile>("CSVFileTest_matrix_inconsistent_output.txt",'r');
+	EXPECT_THROW(fin->get_matrix(matrix, num_feat, num_vec), ShogunException);
+
+	unlink("CSVFileTest_matrix_inconsistent_output.txt");
+}
+
 TEST(CSVFileTest, string_list_char)
 {
 	int32_t num_lines=5;
@@ -0,0 +1,106 @@
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_HDF5
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/io/HDF5File.h>
+#include <shogun/io/streaming/StreamingHDF5File.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+namespace
+{
+	void write_matrix(char* fname, EHDF5Compression compression)
+	{
+		SGMatrix<float64_t> data(3, 100);
+		for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+			data[i] = i;
+		SGVector<float64_t> labels(100);
+		for (index_t i = 0; i < labels.vlen; i++)
+			labels[i] = i % 2 ? 1 : -1;
+
+		auto file = std::make_shared<HDF5File>(fname, 'w', "/data/x");
+		// chunks do not line up with vectors
+		file->set_chunk_size(7);
+		file->set_compression(compression);
+		data.save(file);
+		file->set_variable_name("/data/y");
+		labels.save(file);
+	}
+}
+
+TEST(HDF5FileTest, matrix_range)
+{
+	char fname[] = "HDF5FileTest_matrix_range.h5";
+	for (auto compression : {HDF5_UNCOMPRESSED, HDF5_DEFLATE})
+	{
+		write_matrix(fname, compression);
+
+		auto file = std::make_shared<HDF5File>(fname, 'r', "/data/x");
+		int32_t num_feat, num_vec;
+		file->get_matrix_dims(num_feat, num_vec);
+		EXPECT_EQ(num_feat, 3);
+		EXPECT_EQ(num_vec, 100);
+
+		SGMatrix<float64_t> whole;
+		whole.load(file);
+		ASSERT_EQ(whole.num_rows, 3);
+		ASSERT_EQ(whole.num_cols, 100);
+		for (index_t i = 0; i < 300; i++)
+			EXPECT_EQ(whole[i], i);
+
+		float64_t* range = NULL;
+		num_vec = 40;
+		file->get_matrix_range(range, num_feat, 70, num_vec);
+		EXPECT_EQ(num_feat, 3);
+		// clipped to the end of the matrix
+		ASSERT_EQ(num_vec, 30);
+		for (index_t i = 0; i < num_feat * num_vec; i++)
+			EXPECT_EQ(range[i], 210 + i);
+		SG_FREE(range);
+
+		float64_t* labels = NULL;
+		int32_t len = 5;
+		file->get_vector_range(labels, 11, len, "/data/y");
+		ASSERT_EQ(len, 5);
+		for (index_t i = 0; i < len; i++)
+			EXPECT_EQ(labels[i], (11 + i) % 2 ? 1 : -1);
+		SG_FREE(labels);
+
+		unlink(fname);
+	}
+}
+
+TEST(HDF5FileTest, streaming_dense_features)
+{
+	char fname[] = "HDF5FileTest_streaming.h5";
+	write_matrix(fname, HDF5_DEFLATE);
+
+	auto file = std::make_shared<HDF5File>(fname, 'r', "/data/x");
+	auto stream = std::make_shared<StreamingHDF5File>(file, "/data/y", 16);
+	auto feats =
+	    std::make_shared<StreamingDenseFeatures<float64_t>>(stream, true, 8);
+
+	feats->start_parser();
+	index_t i = 0;
+	while (feats->get_next_example())
+	{
+		auto vec = feats->get_vector();
+		ASSERT_EQ(vec.vlen, 3);
+		for (index_t j = 0; j < vec.vlen; j++)
+			EXPECT_EQ(vec[j], 3 * i + j);
+		EXPECT_EQ(feats->get_label(), i % 2 ? 1 : -1);
+		feats->release_example();
+		i++;
+	}
+	feats->end_parser();
+	EXPECT_EQ(i, 100);
+
+	unlink(fname);
+}
+#endif // HAVE_HDF5
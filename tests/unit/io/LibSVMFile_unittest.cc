@@ -181,3 +181,46 @@ TEST(LibSVMFileTest, sparse_matrix_float64)
 	SG_FREE(labels_from_file);
 	unlink("LibSVMFileTest_sparse_matrix_float64_output.txt");
 }
+
+TEST(LibSVMFileTest, sparse_matrix_text)
+{
+	FILE* f = fopen("LibSVMFileTest_sparse_matrix_text_output.txt", "w");
+	fprintf(f, "1,2 1:0.5 3:-2\r\n\n-1 2:4e1\n\t7:1 \n+1\n");
+	fclose(f);
+
+	int32_t num_vec = 0;
+	int32_t num_feat = 0;
+	int32_t num_classes = 0;
+	SGSparseVector<float64_t>* data;
+	SGVector<float64_t>* labels;
+
+	auto fin = std::make_shared<LibSVMFile>("LibSVMFileTest_sparse_matrix_text_output.txt", 'r');
+	fin->get_sparse_matrix(data, num_feat, num_vec, labels, num_classes);
+
+	EXPECT_EQ(num_vec, 4);
+	EXPECT_EQ(num_feat, 7);
+	EXPECT_EQ(num_classes, 3);
+
+	ASSERT_EQ(labels[0].size(), 2);
+	EXPECT_EQ(labels[0][0], 1);
+	EXPECT_EQ(labels[0][1], 2);
+	ASSERT_EQ(data[0].num_feat_entries, 2);
+	EXPECT_EQ(data[0].features[1].feat_index, 2);
+	EXPECT_EQ(data[0].features[1].entry, -2);
+
+	ASSERT_EQ(data[1].num_feat_entries, 1);
+	EXPECT_EQ(data[1].features[0].entry, 40);
+
+	// lines starting with a feature have no label
+	EXPECT_EQ(labels[2].size(), 0);
+	ASSERT_EQ(data[2].num_feat_entries, 1);
+	EXPECT_EQ(data[2].features[0].feat_index, 6);
+
+	EXPECT_EQ(labels[3].size(), 1);
+	EXPECT_EQ(data[3].num_feat_entries, 0);
+
+	SG_FREE(data);
+	SG_FREE(labels);
+
+	unlink("LibSVMFileTest_sparse_matrix_text_output.txt");
+}
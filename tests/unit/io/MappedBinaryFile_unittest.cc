@@ -0,0 +1,113 @@
+#include <shogun/features/MappedDenseFeatures.h>
+#include <shogun/features/MappedSparseFeatures.h>
+#include <shogun/io/MappedBinaryFile.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+#include <cstdio>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(MappedBinaryFileTest, dense_matrix_with_labels)
+{
+	const char* fname = "MappedBinaryFileTest_dense.bin";
+	SGMatrix<float64_t> data(3, 5);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+		data[i] = i * 0.5 - 2;
+	SGVector<float64_t> labels(5);
+	for (index_t i = 0; i < labels.vlen; i++)
+		labels[i] = i % 2 ? 1 : -1;
+
+	MappedBinaryFile::write(fname, data, labels);
+
+	auto file = std::make_shared<MappedBinaryFile>(fname);
+	EXPECT_EQ(file->get_storage(), MS_DENSE);
+	EXPECT_EQ(file->get_primitive_type(), PT_FLOAT64);
+	EXPECT_EQ(file->get_num_features(), 3);
+	EXPECT_EQ(file->get_num_vectors(), 5);
+	ASSERT_TRUE(file->has_labels());
+	EXPECT_EQ(file->get_header().values_offset % MappedBinaryFile::alignment, 0);
+
+	SGVector<float64_t> labels_from_file = file->get_labels();
+	for (index_t i = 0; i < labels.vlen; i++)
+		EXPECT_EQ(labels_from_file[i], labels[i]);
+
+	EXPECT_THROW(file->get_matrix<float32_t>(), ShogunException);
+	EXPECT_THROW(file->get_sparse_vectors<float64_t>(), ShogunException);
+
+	std::shared_ptr<Features> copy;
+	{
+		auto feats = std::make_shared<MappedDenseFeatures<float64_t>>(fname);
+		EXPECT_EQ(feats->get_num_features(), 3);
+		EXPECT_EQ(feats->get_num_vectors(), 5);
+		copy = feats->duplicate();
+	}
+	file.reset();
+
+	// the duplicate keeps the mapping alive
+	auto mapped = std::static_pointer_cast<DenseFeatures<float64_t>>(copy);
+	SGMatrix<float64_t> matrix = mapped->get_feature_matrix();
+	for (index_t i = 0; i < data.num_rows * data.num_cols; i++)
+		EXPECT_EQ(matrix[i], data[i]);
+
+	// writing to the mapping leaves the file unchanged
+	matrix[0] = 100;
+	MappedDenseFeatures<float64_t> reread(fname);
+	EXPECT_EQ(reread.get_feature_matrix()[0], data[0]);
+
+	unlink(fname);
+}
+
+TEST(MappedBinaryFileTest, sparse_matrix)
+{
+	const char* fname = "MappedBinaryFileTest_sparse.bin";
+	SGMatrix<float32_t> dense(6, 4);
+	for (index_t i = 0; i < dense.num_rows * dense.num_cols; i++)
+		dense[i] = i % 3 ? 0 : i;
+
+	// converted matrices are contiguous, grown ones are not
+	SGSparseMatrix<float32_t> contiguous(dense);
+	SGSparseMatrix<float32_t> grown(dense);
+	grown(5, 1) = 7;
+	dense(5, 1) = 7;
+
+	for (const auto& sparse : {contiguous, grown})
+	{
+		MappedBinaryFile::write(fname, sparse);
+
+		MappedSparseFeatures<float32_t> feats(fname);
+		EXPECT_EQ(feats.get_num_features(), 6);
+		EXPECT_EQ(feats.get_num_vectors(), 4);
+		EXPECT_FALSE(feats.get_file()->has_labels());
+
+		for (index_t j = 0; j < sparse.num_vectors; j++)
+		{
+			auto vec = feats.get_sparse_feature_vector(j);
+			ASSERT_EQ(vec.num_feat_entries, sparse[j].num_feat_entries);
+			for (index_t k = 0; k < vec.num_feat_entries; k++)
+			{
+				EXPECT_EQ(vec.features[k].feat_index, sparse[j].features[k].feat_index);
+				EXPECT_EQ(vec.features[k].entry, sparse[j].features[k].entry);
+			}
+			feats.free_sparse_feature_vector(j);
+		}
+	}
+
+	unlink(fname);
+}
+
+TEST(MappedBinaryFileTest, invalid_file)
+{
+	const char* fname = "MappedBinaryFileTest_invalid.bin";
+	FILE* f = fopen(fname, "w");
+	fprintf(f, "0,1,2\n3,4,5\n");
+	fclose(f);
+
+	EXPECT_THROW(MappedBinaryFile file(fname), ShogunException);
+
+	unlink(fname);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <shogun/io/streaming/ParseBuffer.h>
+
+#include <set>
+#include <thread>
+
+using namespace shogun;
+
+TEST(ParseBuffer, batched_handoff_in_order)
+{
+	const int32_t num_examples=1000;
+	auto ring=std::make_shared<ParseBuffer<float64_t>>(8, 3);
+	ring->set_free_vectors_on_destruct(false);
+	EXPECT_EQ(ring->get_batch_size(), 3);
+
+	std::thread writer([&]() {
+		for (int32_t i=0; i<num_examples; i++)
+		{
+			Example<float64_t>* ex=ring->get_free_example();
+			ASSERT_NE(ex, nullptr);
+			if (ex->fv==NULL)
+				ex->fv=SG_MALLOC(float64_t, 1);
+			ex->fv[0]=i;
+			ex->length=1;
+			ex->label=-i;
+			ring->copy_example(ex);
+		}
+		ring->finish();
+	});
+
+	std::set<float64_t*> vectors;
+	int32_t num_read=0;
+	while (Example<float64_t>* ex=ring->wait_unused_example())
+	{
+		EXPECT_EQ(ex->length, 1);
+		EXPECT_EQ(ex->fv[0], num_read);
+		EXPECT_EQ(ex->label, -num_read);
+		vectors.insert(ex->fv);
+		ring->finalize_example(false);
+		num_read++;
+	}
+	writer.join();
+
+	EXPECT_EQ(num_read, num_examples);
+	// the vectors of the slots are recycled
+	EXPECT_LE(vectors.size(), 8);
+
+	for (auto vector : vectors)
+		SG_FREE(vector);
+}
+
+TEST(ParseBuffer, close_wakes_reader)
+{
+	auto ring=std::make_shared<ParseBuffer<float64_t>>(4);
+
+	std::thread reader([&]() { EXPECT_EQ(ring->wait_unused_example(), nullptr); });
+	ring->close();
+	reader.join();
+	EXPECT_EQ(ring->get_free_example(), nullptr);
+}
@@ -1,5 +1,7 @@
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/UniformRealDistribution.h>
@@ -257,6 +259,123 @@ TEST(ProtobufFileTest, sparse_matrix_float64)
 	unlink("ProtobufFileTest_sparse_matrix_float64_output.txt");
 }
 
+TEST(ProtobufFileTest, matrix_block_float64)
+{
+	int32_t seed = 100;
+	// a multiple of the elements per message, the last chunk is full
+	int32_t num_rows=64;
+	int32_t num_cols=8192;
+	SGMatrix<float64_t> data(num_rows, num_cols);
+
+	std::mt19937_64 prng(seed);
+	UniformRealDistribution<float64_t> uniform_real_dist(0., 1.);
+	for (int32_t i=0; i<num_rows*num_cols; i++)
+		data.matrix[i]=uniform_real_dist(prng);
+
+	env()->set_num_threads(4);
+	auto fout=std::make_shared<ProtobufFile>("ProtobufFileTest_matrix_block_float64_output.txt",'w');
+	fout->set_matrix(data.matrix, num_rows, num_cols);
+	fout.reset();
+
+	auto fin=std::make_shared<ProtobufFile>("ProtobufFileTest_matrix_block_float64_output.txt",'r');
+	SGMatrix<float64_t> block(num_rows, 3000);
+	float64_t* block_memory=block.matrix;
+	fin->get_matrix_block(block, 2500, 3000);
+	EXPECT_EQ(block.matrix, block_memory);
+	for (int32_t j=0; j<3000; j++)
+	{
+		for (int32_t i=0; i<num_rows; i++)
+			EXPECT_EQ(block(i, j), data(i, 2500+j));
+	}
+
+	// the file is back at the start of the matrix
+	SGMatrix<float64_t> all;
+	fin->get_matrix_block(all);
+	EXPECT_EQ(all.num_rows, num_rows);
+	EXPECT_EQ(all.num_cols, num_cols);
+	EXPECT_TRUE(all.equals(data));
+
+	float64_t* data_from_file=NULL;
+	int32_t num_rows_from_file=0;
+	int32_t num_cols_from_file=0;
+	fin->get_matrix(data_from_file, num_rows_from_file, num_cols_from_file);
+	EXPECT_EQ(num_rows_from_file, num_rows);
+	EXPECT_EQ(num_cols_from_file, num_cols);
+	for (int32_t i=0; i<num_rows*num_cols; i++)
+		EXPECT_EQ(data_from_file[i], data.matrix[i]);
+	SG_FREE(data_from_file);
+	env()->set_num_threads(1);
+
+	unlink("ProtobufFileTest_matrix_block_float64_output.txt");
+}
+
+TEST(ProtobufFileTest, sparse_matrix_block_int32)
+{
+	int32_t seed = 100;
+	int32_t max_num_entries=1024;
+	int32_t num_vec=2048;
+	int32_t num_feat=2*max_num_entries;
+
+	SGSparseVector<int32_t>* data=SG_MALLOC(SGSparseVector<int32_t>, num_vec);
+	std::mt19937_64 prng(seed);
+	UniformIntDistribution<int32_t> uniform_int_dist(0, max_num_entries);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		// some vectors are empty
+		data[i]=SGSparseVector<int32_t>(i%7 ? uniform_int_dist(prng) : 0);
+		for (int32_t j=0; j<data[i].num_feat_entries; j++)
+		{
+			data[i].features[j].feat_index=2*j+1;
+			data[i].features[j].entry=uniform_int_dist(prng);
+		}
+	}
+
+	env()->set_num_threads(4);
+	auto fout=std::make_shared<ProtobufFile>("ProtobufFileTest_sparse_matrix_block_int32_output.txt", 'w');
+	fout->set_sparse_matrix(data, num_feat, num_vec);
+	fout.reset();
+
+	auto fin=std::make_shared<ProtobufFile>("ProtobufFileTest_sparse_matrix_block_int32_output.txt", 'r');
+	SGSparseMatrix<int32_t> block;
+	fin->get_sparse_matrix_block(block, 700, 900);
+	EXPECT_EQ(block.num_vectors, 900);
+	EXPECT_EQ(block.num_features, num_feat);
+	for (int32_t i=0; i<block.num_vectors; i++)
+	{
+		ASSERT_EQ(block[i].num_feat_entries, data[700+i].num_feat_entries);
+		for (int32_t j=0; j<block[i].num_feat_entries; j++)
+		{
+			EXPECT_EQ(block[i].features[j].feat_index,
+					data[700+i].features[j].feat_index);
+			EXPECT_EQ(block[i].features[j].entry,
+					data[700+i].features[j].entry);
+		}
+	}
+
+	SGSparseVector<int32_t>* data_from_file;
+	int32_t num_vec_from_file=0;
+	int32_t num_feat_from_file=0;
+	fin->get_sparse_matrix(data_from_file, num_feat_from_file, num_vec_from_file);
+	EXPECT_EQ(num_vec_from_file, num_vec);
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		ASSERT_EQ(data_from_file[i].num_feat_entries, data[i].num_feat_entries);
+		for (int32_t j=0; j<data[i].num_feat_entries; j++)
+		{
+			EXPECT_EQ(data[i].features[j].feat_index,
+					data_from_file[i].features[j].feat_index);
+			EXPECT_EQ(data[i].features[j].entry,
+					data_from_file[i].features[j].entry);
+		}
+	}
+	env()->set_num_threads(1);
+
+	SG_FREE(data);
+	SG_FREE(data_from_file);
+
+	unlink("ProtobufFileTest_sparse_matrix_block_int32_output.txt");
+}
+
 TEST(ProtobufFileTest, DISABLED_string_list_char)
 {
 	int32_t seed = 100;
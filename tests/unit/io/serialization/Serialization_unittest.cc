@@ -145,3 +145,50 @@ TYPED_TEST(SerializationTest, serialize)
 
 	ASSERT_TRUE(obj->equals(deser_obj));
 }
+
+TYPED_TEST(SerializationTest, serialize_matrix_values)
+{
+	SGMatrix<float32_t> data(50, 200);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data.matrix[i] = 0.25f * i - 1000.0f;
+	auto obj = std::make_shared<DenseFeatures<float32_t>>(data);
+
+	auto serializer = std::make_shared<typename TypeParam::first_type>();
+	auto stream = std::make_shared<DummyOutputStream>();
+	serializer->attach(stream);
+	serializer->write(obj);
+
+	auto deserializer = std::make_shared<typename TypeParam::second_type>();
+	auto istream = std::make_shared<DummyInputStream>(stream->buffer());
+	deserializer->attach(istream);
+	auto deser_obj = deserializer->read_object();
+
+	ASSERT_TRUE(obj->equals(deser_obj));
+}
+
+TYPED_TEST(SerializationTest, serialize_parameter_filter)
+{
+	SGMatrix<float64_t> data {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+	auto df = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto obj = std::make_shared<GaussianKernel>(df, df, 2.0);
+
+	auto serializer = std::make_shared<typename TypeParam::first_type>();
+	auto stream = std::make_shared<DummyOutputStream>();
+	serializer->attach(stream);
+	serializer->write(obj);
+
+	auto deserializer = std::make_shared<typename TypeParam::second_type>();
+	deserializer->set_parameter_filter(
+		[](const SGObject&, const string& name, const AnyParameterProperties&) {
+			return name != "lhs" && name != "rhs";
+		});
+	auto istream = std::make_shared<DummyInputStream>(stream->buffer());
+	deserializer->attach(istream);
+	auto deser_obj =
+		std::dynamic_pointer_cast<GaussianKernel>(deserializer->read_object());
+
+	ASSERT_NE(deser_obj, nullptr);
+	EXPECT_EQ(deser_obj->get_width(), obj->get_width());
+	EXPECT_EQ(deser_obj->get_lhs(), nullptr);
+	EXPECT_EQ(deser_obj->get_rhs(), nullptr);
+}
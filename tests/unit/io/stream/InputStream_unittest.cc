@@ -6,7 +6,9 @@
 
 #include <gtest/gtest.h>
 #include <shogun/base/ShogunEnv.h>
+#include <shogun/io/ShogunErrc.h>
 #include <shogun/io/stream/FileInputStream.h>
+#include <shogun/io/stream/ReadaheadInputStream.h>
 #ifdef HAVE_LIBARCHIVE
 #include <shogun/io/stream/ArchiveInputStream.h>
 #endif
@@ -39,3 +41,36 @@ TEST_F(InputStream, raw_file)
 	ASSERT_EQ("ADD_TEST (", buffer);
 }
 
+
+TEST_F(InputStream, readahead_file)
+{
+	std::string from("shogun-unit-test_test.cmake");
+	unique_ptr<io::RandomAccessFile> file;
+	ASSERT_FALSE(fs_registry->new_random_access_file(from, &file));
+	auto fis = std::make_unique<io::FileInputStream>(file.get());
+	string expected;
+	auto r = fis->read(&expected, 1 << 20);
+	ASSERT_TRUE(io::is_out_of_range(r));
+	ASSERT_GT(expected.size(), 40);
+
+	unique_ptr<io::RandomAccessFile> readahead_file;
+	ASSERT_FALSE(fs_registry->new_random_access_file(from, &readahead_file));
+	// blocks smaller than the reads to cross block boundaries
+	auto ris = std::make_unique<io::ReadaheadInputStream>(
+		readahead_file.release(), 7, true);
+
+	string buffer, result;
+	while (!(r = ris->read(&buffer, 10)))
+		result += buffer;
+	ASSERT_TRUE(io::is_out_of_range(r));
+	result += buffer;
+	EXPECT_EQ(expected, result);
+	EXPECT_EQ(expected.size(), ris->tell());
+
+	ris->reset();
+	ASSERT_FALSE(ris->skip(3));
+	ASSERT_FALSE(ris->skip(20));
+	ASSERT_FALSE(ris->read(&buffer, 10));
+	EXPECT_EQ(expected.substr(23, 10), buffer);
+	EXPECT_TRUE(io::is_out_of_range(ris->skip(expected.size())));
+}
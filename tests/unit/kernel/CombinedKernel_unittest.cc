@@ -12,7 +12,9 @@
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
 using namespace shogun;
@@ -335,3 +337,130 @@ TEST(CombinedKernelTest,combination)
 		++j;
 	}
 }
+
+TEST(CombinedKernelTest, subkernel_caching)
+{
+	const index_t dim=3;
+	const index_t num_vectors=20;
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=normal(prng);
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto feats_combined=std::make_shared<CombinedFeatures>();
+	std::vector<std::shared_ptr<Kernel>> kernels{
+		std::make_shared<GaussianKernel>(1.0),
+		std::make_shared<GaussianKernel>(5.0),
+		std::make_shared<LinearKernel>()};
+
+	auto combined=std::make_shared<CombinedKernel>();
+	for (const auto& k : kernels)
+	{
+		combined->append_kernel(k);
+		feats_combined->append_feature_obj(feats);
+	}
+	combined->set_subkernel_caching(true);
+	EXPECT_TRUE(combined->get_subkernel_caching());
+	combined->init(feats_combined, feats_combined);
+
+	std::vector<SGMatrix<float64_t>> sub_matrices;
+	for (const auto& k : kernels)
+		sub_matrices.push_back(k->get_kernel_matrix());
+
+	SGVector<float64_t> weights({0.2, 0.0, 0.5});
+	// second pass with changed weights reuses the cached subkernel rows
+	for (auto pass=0; pass<2; ++pass)
+	{
+		combined->set_subkernel_weights(weights);
+		auto matrix=combined->get_kernel_matrix();
+
+		for (index_t j=0; j<num_vectors; ++j)
+		{
+			for (index_t i=0; i<num_vectors; ++i)
+			{
+				float64_t expected=0;
+				for (size_t k=0; k<kernels.size(); ++k)
+					expected+=weights[k]*sub_matrices[k](i, j);
+
+				EXPECT_NEAR(matrix(i, j), expected, 1e-10);
+				EXPECT_NEAR(combined->kernel(i, j), expected, 1e-10);
+			}
+		}
+
+		weights=SGVector<float64_t>({1.0, 0.3, 0.1});
+	}
+
+	combined->set_subkernel_caching(false);
+	auto matrix=combined->get_kernel_matrix();
+	for (index_t j=0; j<num_vectors; ++j)
+	{
+		for (index_t i=0; i<num_vectors; ++i)
+		{
+			float64_t expected=0;
+			for (size_t k=0; k<kernels.size(); ++k)
+				expected+=weights[k]*sub_matrices[k](i, j);
+
+			EXPECT_NEAR(matrix(i, j), expected, 1e-10);
+		}
+	}
+}
+
+TEST(CombinedKernelTest, compute_subkernel_quadratic_forms)
+{
+	const index_t dim=3;
+	const index_t num_vectors=30;
+	std::mt19937_64 prng(23);
+	NormalDistribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=normal(prng);
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto feats_combined=std::make_shared<CombinedFeatures>();
+	std::vector<std::shared_ptr<Kernel>> kernels{
+		std::make_shared<GaussianKernel>(1.0),
+		std::make_shared<GaussianKernel>(5.0),
+		std::make_shared<LinearKernel>()};
+
+	auto combined=std::make_shared<CombinedKernel>();
+	for (const auto& k : kernels)
+	{
+		combined->append_kernel(k);
+		feats_combined->append_feature_obj(feats);
+	}
+	combined->init(feats_combined, feats_combined);
+
+	std::vector<SGMatrix<float64_t>> sub_matrices;
+	for (const auto& k : kernels)
+		sub_matrices.push_back(k->get_kernel_matrix());
+
+	SGVector<index_t> idx({0, 3, 4, 8, 15, 16, 22, 29});
+	SGVector<float64_t> coef(idx.vlen);
+	for (index_t i=0; i<coef.vlen; ++i)
+		coef[i]=normal(prng);
+
+	for (auto caching : {false, true})
+	{
+		combined->set_subkernel_caching(caching);
+		auto forms=combined->compute_subkernel_quadratic_forms(idx, coef);
+		ASSERT_EQ(forms.vlen, (index_t)kernels.size());
+
+		for (size_t k=0; k<kernels.size(); ++k)
+		{
+			float64_t expected=0;
+			for (index_t j=0; j<idx.vlen; ++j)
+				for (index_t i=0; i<idx.vlen; ++i)
+					expected+=coef[i]*coef[j]*sub_matrices[k](idx[i], idx[j]);
+
+			EXPECT_NEAR(forms[k], expected, 1e-10);
+		}
+	}
+
+	EXPECT_THROW(
+		combined->compute_subkernel_quadratic_forms(idx, SGVector<float64_t>(2)),
+		ShogunException);
+}
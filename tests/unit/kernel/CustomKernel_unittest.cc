@@ -14,8 +14,13 @@
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
+#include "utils/Utils.h"
+
+#include <cstdio>
+
 using namespace shogun;
 using namespace Eigen;
 
@@ -638,4 +643,71 @@ TEST(CustomKernelTest, row_col_wise_sum_block_no_diag)
 
 
 
+}
+
+TEST(CustomKernelTest, memory_mapped_full_and_triangle)
+{
+	const index_t n=7;
+	const int32_t seed=17;
+	std::mt19937_64 prng(seed);
+	NormalDistribution<float64_t> normal_dist;
+
+	SGMatrix<float32_t> km(n, n);
+	for (index_t i=0; i<n; ++i)
+	{
+		for (index_t j=i; j<n; ++j)
+			km(i, j)=km(j, i)=normal_dist(prng);
+	}
+
+	// full column-major matrix
+	char full_fname[] = "CustomKernel_mmap_full.XXXXXX";
+	generate_temp_filename(full_fname);
+	FILE* f=fopen(full_fname, "wb");
+	ASSERT_TRUE(f);
+	ASSERT_EQ(fwrite(km.matrix, sizeof(float32_t), n*n, f), size_t(n*n));
+	fclose(f);
+
+	// row-wise packed upper triangle
+	char tri_fname[] = "CustomKernel_mmap_triangle.XXXXXX";
+	generate_temp_filename(tri_fname);
+	f=fopen(tri_fname, "wb");
+	ASSERT_TRUE(f);
+	for (index_t i=0; i<n; ++i)
+		for (index_t j=i; j<n; ++j)
+			fwrite(&km(i, j), sizeof(float32_t), 1, f);
+	fclose(f);
+
+	{
+		auto full=std::make_shared<CustomKernel>(full_fname);
+		auto tri=std::make_shared<CustomKernel>(tri_fname, true);
+		ASSERT_EQ(full->get_num_vec_lhs(), n);
+		ASSERT_EQ(full->get_num_vec_rhs(), n);
+		ASSERT_EQ(tri->get_num_vec_lhs(), n);
+		ASSERT_EQ(tri->get_num_vec_rhs(), n);
+
+		for (index_t j=0; j<n; ++j)
+		{
+			auto col=tri->get_kernel_col(j);
+			for (index_t i=0; i<n; ++i)
+			{
+				EXPECT_EQ(full->kernel(i, j), km(i, j));
+				EXPECT_EQ(tri->kernel(i, j), km(i, j));
+				EXPECT_EQ(col[i], km(i, j));
+			}
+		}
+
+		// subsets work on top of the mapping
+		SGVector<index_t> subset(3);
+		subset[0]=4;
+		subset[1]=0;
+		subset[2]=6;
+		tri->add_row_subset(subset);
+		tri->add_col_subset(subset);
+		for (index_t i=0; i<subset.vlen; ++i)
+			for (index_t j=0; j<subset.vlen; ++j)
+				EXPECT_EQ(tri->kernel(i, j), km(subset[i], subset[j]));
+	}
+
+	std::remove(full_fname);
+	std::remove(tri_fname);
 }
@@ -729,3 +729,51 @@ TEST(GaussianARDKernel,get_parameter_gradient_diagonal)
 
 
 }
+
+TEST(GaussianARDKernel_vector,get_parameter_gradients)
+{
+	index_t n=6;
+	index_t dim=3;
+	index_t m=4;
+	float64_t rel_tolerance=1e-10;
+	float64_t abs_tolerance;
+
+	SGMatrix<float64_t> feat_train(dim, n);
+	SGMatrix<float64_t> lat_feat_train(dim, m);
+	for (index_t i=0; i<dim*n; i++)
+		feat_train[i]=std::sin(i*0.7)*3.0;
+	for (index_t i=0; i<dim*m; i++)
+		lat_feat_train[i]=std::cos(i*1.3)*2.0;
+
+	auto features_train=std::make_shared<DenseFeatures<float64_t>>(feat_train);
+	auto latent_features_train=std::make_shared<DenseFeatures<float64_t>>(lat_feat_train);
+
+	auto kernel=std::make_shared<GaussianARDKernel>(10);
+	SGVector<float64_t> weights(dim);
+	weights[0]=0.5;
+	weights[1]=1.2;
+	weights[2]=0.3;
+	kernel->set_vector_weights(weights);
+
+	auto params=kernel->get_params();
+	auto weights_param=params.find("log_weights");
+
+	kernel->init(features_train, latent_features_train);
+	auto gradients=kernel->get_parameter_gradients(*weights_param, dim);
+	ASSERT_EQ(gradients.size(), size_t(dim));
+
+	for (index_t d=0; d<dim; d++)
+	{
+		SGMatrix<float64_t> mat=kernel->get_parameter_gradient(*weights_param, d);
+		ASSERT_EQ(gradients[d].num_rows, mat.num_rows);
+		ASSERT_EQ(gradients[d].num_cols, mat.num_cols);
+		for(int32_t i=0;i<mat.num_rows;i++)
+		{
+			for(int32_t j=0;j<mat.num_cols;j++)
+			{
+				abs_tolerance=Math::get_abs_tolerance(mat(i,j),rel_tolerance);
+				EXPECT_NEAR(gradients[d](i,j),mat(i,j),abs_tolerance);
+			}
+		}
+	}
+}
@@ -0,0 +1,162 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/kernel/HistogramIntersectionKernel.h>
+#include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+namespace
+{
+	SGMatrix<float64_t> histograms(int32_t dim, int32_t num, uint64_t seed)
+	{
+		std::mt19937_64 prng(seed);
+		std::uniform_int_distribution<int32_t> counts(0, 8);
+		SGMatrix<float64_t> matrix(dim, num);
+		for (index_t i = 0; i < matrix.num_rows * matrix.num_cols; i++)
+			matrix.matrix[i] = counts(prng) / 8.0;
+		return matrix;
+	}
+
+	/* sum_j alphas[j]*k(sv[j], vec[i]) computed pairwise */
+	SGVector<float64_t> pairwise_outputs(
+	    const std::shared_ptr<Kernel>& kernel, SGVector<int32_t> sv_idx,
+	    SGVector<float64_t> alphas, int32_t num_vec)
+	{
+		SGVector<float64_t> outputs(num_vec);
+		outputs.zero();
+		for (int32_t i = 0; i < num_vec; i++)
+		{
+			for (index_t j = 0; j < sv_idx.vlen; j++)
+				outputs[i] += alphas[j] * kernel->kernel(sv_idx[j], i);
+		}
+		return outputs;
+	}
+} // namespace
+
+TEST(HistogramIntersectionKernel, compute_batch)
+{
+	const int32_t dim = 13, num_sv = 40, num_vec = 150;
+	auto svs = std::make_shared<DenseFeatures<float64_t>>(
+	    histograms(dim, num_sv, 3));
+	auto vecs = std::make_shared<DenseFeatures<float64_t>>(
+	    histograms(dim, num_vec, 7));
+
+	// every other support vector with weights of both signs
+	SGVector<int32_t> sv_idx(num_sv / 2);
+	SGVector<float64_t> alphas(num_sv / 2);
+	for (index_t j = 0; j < sv_idx.vlen; j++)
+	{
+		sv_idx[j] = 2 * j + 1;
+		alphas[j] = (j % 3 == 0 ? -1.0 : 1.0) * (j + 1) / 10.0;
+	}
+	SGVector<int32_t> vec_idx(num_vec);
+	vec_idx.range_fill();
+
+	for (auto beta : {1.0, 0.5})
+	{
+		auto kernel =
+		    std::make_shared<HistogramIntersectionKernel>(svs, vecs, beta);
+		EXPECT_TRUE(kernel->has_property(KP_BATCHEVALUATION));
+
+		auto expected = pairwise_outputs(kernel, sv_idx, alphas, num_vec);
+		SGVector<float64_t> outputs(num_vec);
+		outputs.set_const(1.0);
+		kernel->compute_batch(
+		    num_vec, vec_idx.vector, outputs.vector, sv_idx.vlen,
+		    sv_idx.vector, alphas.vector, 2.0);
+		for (int32_t i = 0; i < num_vec; i++)
+			EXPECT_NEAR(outputs[i], 1.0 + 2.0 * expected[i], 1e-12);
+
+		// the interpolation error of a dimension is at most the width of
+		// a bin times the total change of the slope, sum_j |alpha_j|
+		const int32_t num_bins = 4096;
+		float64_t bound = 0;
+		for (auto alpha : alphas)
+			bound += std::abs(alpha) * dim / num_bins;
+
+		kernel->set_num_bins(num_bins);
+		outputs.zero();
+		kernel->compute_batch(
+		    num_vec, vec_idx.vector, outputs.vector, sv_idx.vlen,
+		    sv_idx.vector, alphas.vector);
+		for (int32_t i = 0; i < num_vec; i++)
+			EXPECT_NEAR(outputs[i], expected[i], bound);
+	}
+}
+
+TEST(HistogramIntersectionKernel, compute_batch_table_exact_at_bins)
+{
+	// with the values on the grid of the table, the interpolation is exact
+	const int32_t dim = 5, num_sv = 20, num_vec = 30;
+	auto sv_matrix = histograms(dim, num_sv, 11);
+	for (int32_t i = 0; i < dim; i++)
+	{
+		sv_matrix(i, 0) = 0;
+		sv_matrix(i, 1) = 1;
+	}
+	auto svs = std::make_shared<DenseFeatures<float64_t>>(sv_matrix);
+	auto vecs = std::make_shared<DenseFeatures<float64_t>>(
+	    histograms(dim, num_vec, 13));
+	auto kernel = std::make_shared<HistogramIntersectionKernel>(svs, vecs);
+
+	SGVector<int32_t> sv_idx(num_sv);
+	sv_idx.range_fill();
+	SGVector<float64_t> alphas(num_sv);
+	for (index_t j = 0; j < num_sv; j++)
+		alphas[j] = 0.25 * (j % 5) - 0.5;
+	SGVector<int32_t> vec_idx(num_vec);
+	vec_idx.range_fill();
+
+	// all values are multiples of 1/8 between 0 and 1, the extremes of
+	// every dimension
+	kernel->set_num_bins(8);
+	auto expected = pairwise_outputs(kernel, sv_idx, alphas, num_vec);
+	SGVector<float64_t> outputs(num_vec);
+	outputs.zero();
+	kernel->compute_batch(
+	    num_vec, vec_idx.vector, outputs.vector, num_sv, sv_idx.vector,
+	    alphas.vector);
+	for (int32_t i = 0; i < num_vec; i++)
+		EXPECT_NEAR(outputs[i], expected[i], 1e-12);
+
+	EXPECT_THROW(kernel->set_num_bins(-1), ShogunException);
+}
+
+TEST(HistogramIntersectionKernel, compute_batch_normalized)
+{
+	const int32_t dim = 9, num_sv = 25, num_vec = 40;
+	auto svs = std::make_shared<DenseFeatures<float64_t>>(
+	    histograms(dim, num_sv, 17));
+	auto vecs = std::make_shared<DenseFeatures<float64_t>>(
+	    histograms(dim, num_vec, 19));
+	auto kernel = std::make_shared<HistogramIntersectionKernel>();
+	kernel->set_normalizer(std::make_shared<SqrtDiagKernelNormalizer>());
+	kernel->init(svs, vecs);
+
+	SGVector<int32_t> sv_idx(num_sv);
+	sv_idx.range_fill();
+	SGVector<float64_t> alphas(num_sv);
+	for (index_t j = 0; j < num_sv; j++)
+		alphas[j] = std::sin(j + 1.0);
+	SGVector<int32_t> vec_idx(num_vec);
+	vec_idx.range_fill();
+
+	auto expected = pairwise_outputs(kernel, sv_idx, alphas, num_vec);
+	SGVector<float64_t> outputs(num_vec);
+	outputs.zero();
+	kernel->compute_batch(
+	    num_vec, vec_idx.vector, outputs.vector, num_sv, sv_idx.vector,
+	    alphas.vector);
+	for (int32_t i = 0; i < num_vec; i++)
+		EXPECT_NEAR(outputs[i], expected[i], 1e-12);
+}
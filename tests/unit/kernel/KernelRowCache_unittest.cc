@@ -0,0 +1,110 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/kernel/KernelRowCache.h>
+
+#include <atomic>
+
+using namespace shogun;
+
+static void fill_row(index_t row, float64_t* data, index_t len)
+{
+	for (index_t i=0; i<len; ++i)
+		data[i]=row*len+i;
+}
+
+TEST(KernelRowCache, hits_and_misses)
+{
+	const index_t num_rows=10;
+	const index_t len=5;
+	KernelRowCache<float64_t> cache(num_rows, len, 1, 2);
+
+	std::atomic<int32_t> num_computed(0);
+	auto compute=[&](index_t row, float64_t* data) {
+		num_computed++;
+		fill_row(row, data, len);
+	};
+
+	for (index_t r=0; r<num_rows; ++r)
+	{
+		EXPECT_FALSE(cache.is_cached(r));
+		auto row=cache.get_row(r, compute);
+		ASSERT_EQ(row.vlen, len);
+		for (index_t i=0; i<len; ++i)
+			EXPECT_EQ(row[i], r*len+i);
+	}
+	EXPECT_EQ(num_computed, num_rows);
+	EXPECT_EQ(cache.get_num_misses(), num_rows);
+
+	// everything fits, so all further requests are hits
+	for (index_t r=0; r<num_rows; ++r)
+	{
+		EXPECT_TRUE(cache.is_cached(r));
+		cache.get_row(r, compute);
+	}
+	EXPECT_EQ(num_computed, num_rows);
+	EXPECT_EQ(cache.get_num_hits(), num_rows);
+
+	cache.clear();
+	EXPECT_FALSE(cache.is_cached(0));
+	EXPECT_EQ(cache.get_num_hits(), 0);
+	EXPECT_EQ(cache.get_num_misses(), 0);
+}
+
+TEST(KernelRowCache, eviction_keeps_rows_alive)
+{
+	// one row of 2^17 doubles is exactly one megabyte, so the cache holds
+	// two rows only
+	const index_t num_rows=6;
+	const index_t len=1<<17;
+	KernelRowCache<float64_t> cache(num_rows, len, 2, 1);
+	EXPECT_EQ(cache.get_max_rows(), 2);
+
+	auto compute=[&](index_t row, float64_t* data) {
+		fill_row(row, data, len);
+	};
+
+	auto first=cache.get_row(0, compute);
+	for (index_t r=1; r<num_rows; ++r)
+		cache.get_row(r, compute);
+
+	EXPECT_FALSE(cache.is_cached(0));
+	EXPECT_TRUE(cache.is_cached(num_rows-1));
+
+	// the evicted row is still valid for its holder
+	for (index_t i=0; i<len; i+=1024)
+		EXPECT_EQ(first[i], i);
+}
+
+TEST(KernelRowCache, concurrent_access)
+{
+	const index_t num_rows=64;
+	const index_t len=16;
+	KernelRowCache<float64_t> cache(num_rows, len, 1, 4);
+	EXPECT_EQ(cache.get_num_shards(), 4);
+
+	auto compute=[&](index_t row, float64_t* data) {
+		fill_row(row, data, len);
+	};
+
+	std::atomic<int32_t> num_errors(0);
+#pragma omp parallel for
+	for (index_t k=0; k<1000; ++k)
+	{
+		const index_t r=(k*7)%num_rows;
+		auto row=cache.get_row(r, compute);
+		for (index_t i=0; i<len; ++i)
+		{
+			if (row[i]!=r*len+i)
+				num_errors++;
+		}
+	}
+
+	EXPECT_EQ(num_errors, 0);
+	EXPECT_EQ(cache.get_num_hits()+cache.get_num_misses(), 1000);
+}
@@ -33,7 +33,20 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/kernel/ANOVAKernel.h>
+#include <shogun/kernel/BesselKernel.h>
+#include <shogun/kernel/CauchyKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/JensenShannonKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/LogKernel.h>
+#include <shogun/kernel/PolyKernel.h>
+#include <shogun/kernel/PowerKernel.h>
+#include <shogun/kernel/SigmoidKernel.h>
+#include <shogun/kernel/SplineKernel.h>
+#include <shogun/kernel/WaveletKernel.h>
 #include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
@@ -366,7 +379,183 @@ TEST(Kernel, gaussian_get_kernel_matrix)
 	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
 	for (index_t i=0; i<km.num_rows; i++)
 		for (index_t j=0; j<km.num_cols; ++j)
-			EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-15);
+			EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-12);
+}
+
+TEST(Kernel, get_kernel_matrix_tiled_dense_kernels)
+{
+	const int32_t seed = 100;
+	const index_t num_feats_p=300;
+	const index_t num_feats_q=170;
+	const index_t dim=5;
+
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(num_feats_p, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(num_feats_q, dim, prng);
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+
+	// a subset forces the feature blocks to be copied
+	SGVector<index_t> subset(num_feats_q-20);
+	for (index_t i=0; i<subset.vlen; ++i)
+		subset[i]=num_feats_q-1-i;
+	feats_q->add_subset(subset);
+
+	std::vector<std::shared_ptr<Kernel>> kernels;
+	kernels.push_back(std::make_shared<GaussianKernel>(feats_p, feats_p, 2));
+	kernels.push_back(std::make_shared<GaussianKernel>(feats_p, feats_q, 2));
+	kernels.push_back(std::make_shared<LinearKernel>(feats_p, feats_q));
+	kernels.push_back(std::make_shared<PolyKernel>(feats_p, feats_p, 3, 1.0, 0.5));
+	kernels.push_back(std::make_shared<SigmoidKernel>(feats_p, feats_q, 10, 0.1, 0.5));
+
+	for (auto& kernel : kernels)
+	{
+		SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+		ASSERT_EQ(km.num_rows, kernel->get_num_vec_lhs());
+		ASSERT_EQ(km.num_cols, kernel->get_num_vec_rhs());
+		for (index_t i=0; i<km.num_rows; i++)
+			for (index_t j=0; j<km.num_cols; ++j)
+				EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-10);
+	}
+}
+
+TEST(Kernel, get_kernel_matrix_tiled_elementwise_kernels)
+{
+	const int32_t seed = 100;
+	const index_t num_feats_p=200;
+	const index_t num_feats_q=150;
+	const index_t dim=6;
+
+	// non-negative features with zeros, as the Jensen-Shannon kernel needs
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(num_feats_p, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(num_feats_q, dim, prng);
+	for (auto data : {data_p, data_q})
+	{
+		for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+			data.matrix[i]=i%7==0 ? 0 : std::abs(data.matrix[i]);
+	}
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+
+	std::vector<std::shared_ptr<Kernel>> kernels;
+	kernels.push_back(std::make_shared<JensenShannonKernel>(feats_p, feats_q, 10));
+	kernels.push_back(std::make_shared<WaveletKernel>(feats_p, feats_q, 10, 0.5, 2.0));
+	kernels.push_back(std::make_shared<SplineKernel>(feats_p, feats_p));
+	kernels.push_back(std::make_shared<ANOVAKernel>(feats_p, feats_q, 3, 10));
+	kernels.push_back(std::make_shared<ANOVAKernel>(feats_p, feats_q, 8, 10));
+	kernels.push_back(std::make_shared<BesselKernel>(
+		feats_p, feats_q, 1.0, 2.0, 2, std::make_shared<EuclideanDistance>()));
+	kernels.push_back(std::make_shared<LogKernel>(
+		feats_p, feats_q, 1.8, std::make_shared<EuclideanDistance>()));
+	kernels.push_back(std::make_shared<PowerKernel>(
+		feats_p, feats_q, 1.8, std::make_shared<EuclideanDistance>()));
+	kernels.push_back(std::make_shared<CauchyKernel>(
+		feats_p, feats_q, 2.0, std::make_shared<EuclideanDistance>()));
+
+	for (auto& kernel : kernels)
+	{
+		SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+		ASSERT_EQ(km.num_rows, kernel->get_num_vec_lhs());
+		ASSERT_EQ(km.num_cols, kernel->get_num_vec_rhs());
+		for (index_t i=0; i<km.num_rows; i++)
+		{
+			for (index_t j=0; j<km.num_cols; ++j)
+			{
+				const float64_t expected=kernel->kernel(i,j);
+				EXPECT_NEAR(expected, km(i, j),
+					1E-10*std::max(1.0, std::abs(expected))) << kernel->get_name();
+			}
+		}
+	}
+}
+
+TEST(Kernel, compute_weighted_outputs_dense_and_sparse)
+{
+	const int32_t seed = 100;
+	const index_t num_feats_p=200;
+	const index_t num_feats_q=150;
+	const index_t dim=7;
+
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(num_feats_p, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(num_feats_q, dim, prng);
+	for (index_t i=0; i<data_p.size(); i+=2)
+		data_p[i]=0;
+	for (index_t i=0; i<data_q.size(); i+=3)
+		data_q[i]=0;
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+	auto sparse_p=std::make_shared<SparseFeatures<float64_t>>(feats_p);
+	auto sparse_q=std::make_shared<SparseFeatures<float64_t>>(feats_q);
+
+	SGVector<index_t> lhs_idx(num_feats_p/3);
+	for (index_t i=0; i<lhs_idx.vlen; ++i)
+		lhs_idx[i]=3*i+1;
+	SGVector<index_t> rhs_idx(num_feats_q-10);
+	for (index_t j=0; j<rhs_idx.vlen; ++j)
+		rhs_idx[j]=num_feats_q-1-j;
 
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> coefficients(lhs_idx.vlen, 2);
+	for (index_t i=0; i<coefficients.size(); ++i)
+		coefficients[i]=normal_dist(prng);
+
+	std::vector<std::shared_ptr<Kernel>> kernels;
+	kernels.push_back(std::make_shared<GaussianKernel>(feats_p, feats_q, 2));
+	kernels.push_back(std::make_shared<LinearKernel>(feats_p, feats_q));
+	kernels.push_back(std::make_shared<LinearKernel>(sparse_p, sparse_q));
+	kernels.push_back(std::make_shared<PolyKernel>(sparse_p, sparse_q, 2, 1.0, 0.5));
+	kernels.push_back(std::make_shared<SigmoidKernel>(sparse_p, sparse_q, 10, 0.1, 0.5));
+
+	for (auto& kernel : kernels)
+	{
+		auto outputs=kernel->compute_weighted_outputs(
+			lhs_idx, coefficients, rhs_idx);
+		ASSERT_EQ(outputs.num_rows, rhs_idx.vlen);
+		ASSERT_EQ(outputs.num_cols, coefficients.num_cols);
 
+		for (index_t c=0; c<coefficients.num_cols; ++c)
+		{
+			for (index_t j=0; j<rhs_idx.vlen; ++j)
+			{
+				float64_t expected=0;
+				for (index_t i=0; i<lhs_idx.vlen; ++i)
+					expected+=coefficients(i, c)*kernel->kernel(lhs_idx[i], rhs_idx[j]);
+				EXPECT_NEAR(outputs(j, c), expected, 1E-10);
+			}
+		}
+	}
+}
+
+TEST(Kernel, single_precision_get_kernel_matrix)
+{
+	const int32_t seed = 100;
+	const index_t num_feats_p=150;
+	const index_t num_feats_q=140;
+	const index_t dim=6;
+
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(num_feats_p, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(num_feats_q, dim, prng);
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+
+	std::vector<std::shared_ptr<Kernel>> kernels;
+	kernels.push_back(std::make_shared<GaussianKernel>(feats_p, feats_q, 2));
+	kernels.push_back(std::make_shared<LinearKernel>(feats_p, feats_q));
+	kernels.push_back(std::make_shared<PolyKernel>(feats_p, feats_p, 2, 1.0, 0.5));
+
+	for (auto& kernel : kernels)
+	{
+		EXPECT_EQ(kernel->get_precision(), PRECISION_FLOAT64);
+		kernel->set_precision(PRECISION_FLOAT32);
+
+		SGMatrix<float32_t> km=kernel->get_kernel_matrix<float32_t>();
+		ASSERT_EQ(km.num_rows, kernel->get_num_vec_lhs());
+		ASSERT_EQ(km.num_cols, kernel->get_num_vec_rhs());
+		for (index_t i=0; i<km.num_rows; i++)
+			for (index_t j=0; j<km.num_cols; ++j)
+				EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-4);
+	}
 }
@@ -0,0 +1,46 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/LocalAlignmentStringKernel.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+TEST(LocalAlignmentStringKernel, block_matches_kernel)
+{
+	const char amino_acids[]="ARNDCQEGHILKMFPSTWYV";
+	std::mt19937_64 prng(11);
+	std::vector<SGVector<char>> list;
+	for (int32_t i=0; i<6; i++)
+	{
+		SGVector<char> str(5+i*7);
+		for (auto& c : str)
+			c=amino_acids[prng()%20];
+		list.push_back(str);
+	}
+	auto feats=std::make_shared<StringFeatures<char>>(list, PROTEIN);
+	auto kernel=std::make_shared<LocalAlignmentStringKernel>(feats, feats);
+
+	SGVector<index_t> lhs_idx({0, 2, 5});
+	SGVector<index_t> rhs_idx({1, 3, 4, 5});
+	auto block=kernel->get_kernel_block(lhs_idx, rhs_idx);
+	auto km=kernel->get_kernel_matrix();
+	for (index_t i=0; i<lhs_idx.vlen; i++)
+	{
+		for (index_t j=0; j<rhs_idx.vlen; j++)
+		{
+			EXPECT_EQ(block(i, j), kernel->kernel(lhs_idx[i], rhs_idx[j]));
+			EXPECT_NEAR(block(i, j), km(lhs_idx[i], rhs_idx[j]), 1E-6);
+		}
+	}
+	for (index_t i=0; i<km.num_rows; i++)
+		EXPECT_NEAR(km(i, i), 1.0, 1E-6);
+}
@@ -0,0 +1,86 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LowRankApproxKernel.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+static std::shared_ptr<DenseFeatures<float64_t>>
+generate_features(index_t num_vectors, index_t dim, int32_t seed)
+{
+	std::mt19937_64 prng(seed);
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t i=0; i<data.size(); ++i)
+		data[i]=normal_dist(prng);
+	return std::make_shared<DenseFeatures<float64_t>>(data);
+}
+
+TEST(LowRankApproxKernel, full_rank_is_exact)
+{
+	const index_t num_vectors=40;
+	auto feats=generate_features(num_vectors, 3, 100);
+	auto gaussian=std::make_shared<GaussianKernel>(2.0);
+
+	auto approx=std::make_shared<LowRankApproxKernel>(gaussian, num_vectors);
+	approx->init(feats, feats);
+	auto km_approx=approx->get_kernel_matrix();
+
+	gaussian->init(feats, feats);
+	auto km=gaussian->get_kernel_matrix();
+
+	for (index_t i=0; i<km.size(); ++i)
+		EXPECT_NEAR(km_approx[i], km[i], 1E-6);
+}
+
+TEST(LowRankApproxKernel, landmark_selection)
+{
+	const index_t num_vectors=100;
+	const int32_t num_landmarks=15;
+	auto feats=generate_features(num_vectors, 4, 200);
+	auto test_feats=generate_features(30, 4, 300);
+
+	for (auto selection : {LANDMARKS_UNIFORM, LANDMARKS_KMEANS_PLUS_PLUS,
+		LANDMARKS_LEVERAGE_SCORE})
+	{
+		auto gaussian=std::make_shared<GaussianKernel>(2.0);
+		auto approx=std::make_shared<LowRankApproxKernel>(
+			gaussian, num_landmarks, selection);
+		approx->put("seed", 17);
+		approx->fit(feats);
+
+		auto landmarks=approx->get_landmarks();
+		ASSERT_EQ(landmarks.vlen, num_landmarks);
+		for (index_t i=1; i<landmarks.vlen; ++i)
+			EXPECT_LT(landmarks[i-1], landmarks[i]);
+		EXPECT_GT(approx->get_rank(), 0);
+		EXPECT_LE(approx->get_rank(), num_landmarks);
+
+		auto mapped=approx->transform(test_feats);
+		EXPECT_EQ(mapped->get_num_features(), approx->get_rank());
+		EXPECT_EQ(mapped->get_num_vectors(), test_feats->get_num_vectors());
+
+		// the Nyström approximation is exact on the landmarks
+		approx->init(feats, feats);
+		gaussian->init(feats, feats);
+		for (index_t i=0; i<landmarks.vlen; ++i)
+		{
+			for (index_t j=0; j<landmarks.vlen; ++j)
+			{
+				EXPECT_NEAR(
+					approx->kernel(landmarks[i], landmarks[j]),
+					gaussian->kernel(landmarks[i], landmarks[j]), 1E-6);
+			}
+		}
+	}
+}
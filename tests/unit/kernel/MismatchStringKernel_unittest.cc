@@ -0,0 +1,94 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/MismatchStringKernel.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+namespace
+{
+/* explicit mismatch features, the counts of the k-mers within m
+ * mismatches of every k-mer over ACGT */
+std::vector<float64_t> mismatch_features(
+	const SGVector<char>& str, int32_t degree, int32_t max_mismatch)
+{
+	const char acgt[]="ACGT";
+	int32_t num_kmers=1;
+	for (int32_t t=0; t<degree; t++)
+		num_kmers*=4;
+
+	std::vector<float64_t> features(num_kmers);
+	for (int32_t beta=0; beta<num_kmers; beta++)
+	{
+		for (int32_t i=0; i+degree<=str.vlen; i++)
+		{
+			int32_t mismatches=0;
+			for (int32_t t=0, b=beta; t<degree; t++, b/=4)
+				mismatches+=str[i+t]!=acgt[b%4];
+			if (mismatches<=max_mismatch)
+				features[beta]++;
+		}
+	}
+	return features;
+}
+}
+
+TEST(MismatchStringKernel, matches_explicit_features)
+{
+	const char acgt[]="ACGT";
+	std::mt19937_64 prng(7);
+	std::vector<SGVector<char>> list;
+	for (int32_t i=0; i<12; i++)
+	{
+		// strings shorter than the degree have no k-mers
+		SGVector<char> str(i*3);
+		for (auto& c : str)
+			c=acgt[prng()%(i%2 ? 2 : 4)];
+		list.push_back(str);
+	}
+	auto feats=std::make_shared<StringFeatures<char>>(list, DNA);
+
+	for (auto degree : {1, 3, 4})
+	{
+		for (auto max_mismatch : {0, 1, 2})
+		{
+			auto kernel=std::make_shared<MismatchStringKernel>(
+				feats, feats, degree, max_mismatch);
+			auto km=kernel->get_kernel_matrix();
+
+			std::vector<std::vector<float64_t>> phi;
+			for (const auto& str : list)
+				phi.push_back(mismatch_features(str, degree, max_mismatch));
+
+			for (index_t i=0; i<km.num_rows; i++)
+			{
+				for (index_t j=0; j<km.num_cols; j++)
+				{
+					float64_t expected=0;
+					for (size_t b=0; b<phi[i].size(); b++)
+						expected+=phi[i][b]*phi[j][b];
+					EXPECT_EQ(km(i, j), expected);
+					EXPECT_EQ(kernel->kernel(i, j), expected);
+				}
+			}
+		}
+	}
+}
+
+TEST(MismatchStringKernel, neighbourhood_intersection)
+{
+	// (5,1) mismatch kernel over the amino acids
+	EXPECT_EQ(MismatchStringKernel::neighbourhood_intersection(0, 5, 1, 20), 96);
+	EXPECT_EQ(MismatchStringKernel::neighbourhood_intersection(1, 5, 1, 20), 20);
+	EXPECT_EQ(MismatchStringKernel::neighbourhood_intersection(2, 5, 1, 20), 2);
+	EXPECT_EQ(MismatchStringKernel::neighbourhood_intersection(3, 5, 1, 20), 0);
+}
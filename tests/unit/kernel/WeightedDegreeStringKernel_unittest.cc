@@ -0,0 +1,99 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+TEST(WeightedDegreeStringKernel, packed_dna_matches_bytewise)
+{
+	const index_t num_strings=20;
+	// spans several packed words and leaves a partial last word
+	const index_t len=77;
+	const char acgt[]="ACGT";
+
+	std::mt19937_64 prng(17);
+	std::vector<SGVector<char>> list;
+	SGVector<char> base(len);
+	for (index_t j=0; j<len; j++)
+		base[j]=acgt[prng()%4];
+	for (index_t i=0; i<num_strings; i++)
+	{
+		// mutate a few positions of a common sequence to get long matches
+		SGVector<char> str=base.clone();
+		for (index_t k=0; k<i; k++)
+			str[prng()%len]=acgt[prng()%4];
+		list.push_back(str);
+	}
+
+	auto dna_feats=std::make_shared<StringFeatures<char>>(list, DNA);
+	auto raw_feats=std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+
+	for (bool block : {true, false})
+	{
+		auto dna_kernel=std::make_shared<WeightedDegreeStringKernel>(
+			dna_feats, dna_feats, 10);
+		auto raw_kernel=std::make_shared<WeightedDegreeStringKernel>(
+			raw_feats, raw_feats, 10);
+		dna_kernel->set_use_block_computation(block);
+		raw_kernel->set_use_block_computation(block);
+
+		auto dna_km=dna_kernel->get_kernel_matrix();
+		auto raw_km=raw_kernel->get_kernel_matrix();
+		for (index_t i=0; i<dna_km.size(); i++)
+			EXPECT_NEAR(dna_km[i], raw_km[i], 1E-10);
+	}
+}
+
+TEST(WeightedDegreeStringKernel, parallel_tries_match_kernel)
+{
+	const index_t num_strings=30;
+	const index_t len=40;
+	const char acgt[]="ACGT";
+
+	std::mt19937_64 prng(3);
+	std::vector<SGVector<char>> list;
+	for (index_t i=0; i<num_strings; i++)
+	{
+		SGVector<char> str(len);
+		for (index_t j=0; j<len; j++)
+			str[j]=acgt[prng()%(i%2 ? 2 : 4)];
+		list.push_back(str);
+	}
+	auto feats=std::make_shared<StringFeatures<char>>(list, DNA);
+
+	SGVector<int32_t> idx(num_strings);
+	SGVector<float64_t> alphas(num_strings);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		idx[i]=i;
+		alphas[i]=i%3 ? 0.1*i-1.0 : 0.0;
+	}
+
+	const auto num_threads=env()->get_num_threads();
+	for (auto threads : {1, 4})
+	{
+		env()->set_num_threads(threads);
+		auto kernel=std::make_shared<WeightedDegreeStringKernel>(feats, feats, 20);
+		auto km=kernel->get_kernel_matrix();
+		kernel->init_optimization(num_strings, idx.vector, alphas.vector);
+		for (index_t j=0; j<num_strings; j++)
+		{
+			float64_t expected=0;
+			for (index_t i=0; i<num_strings; i++)
+				expected+=alphas[i]*km(i, j);
+			EXPECT_NEAR(kernel->compute_optimized(j), expected, 1E-4);
+		}
+	}
+	env()->set_num_threads(num_threads);
+}
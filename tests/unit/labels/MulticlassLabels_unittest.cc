@@ -11,6 +11,8 @@
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/View.h>
 
+#include <limits>
+
 using namespace shogun;
 
 class MulticlassLabelsTest : public ::testing::Test
@@ -107,3 +109,50 @@ TEST_F(MulticlassLabelsTest, view)
 		EXPECT_EQ(labels_subset->get_int_label(i), labels_true[subset[i]]);
 	}
 }
+
+TEST_F(MulticlassLabelsTest, confidence_storage)
+{
+	const int32_t n_classes = 4;
+	SGVector<float64_t> confs{0.25, -1.5, 3.0, 0.25};
+	const float64_t inf = std::numeric_limits<float64_t>::infinity();
+
+	for (auto storage :
+	     {CONFIDENCES_FLOAT64, CONFIDENCES_FLOAT32, CONFIDENCES_TOP_K})
+	{
+		auto labels = std::make_shared<MulticlassLabels>(labels_true);
+		labels->set_confidence_storage(storage, 2);
+		EXPECT_FALSE(labels->has_confidences());
+		labels->allocate_confidences_for(n_classes);
+		EXPECT_TRUE(labels->has_confidences());
+		for (auto i : range(labels->get_num_labels()))
+			labels->set_multiclass_confidences(i, confs);
+
+		auto obtained = labels->get_multiclass_confidences(0);
+		ASSERT_EQ(obtained.vlen, n_classes);
+		auto class_confs = labels->get_confidences_for_class(2);
+		ASSERT_EQ(class_confs.vlen, labels->get_num_labels());
+		EXPECT_EQ(class_confs[0], 3.0);
+
+		if (storage == CONFIDENCES_TOP_K)
+		{
+			// the tie between class 0 and 3 goes to the lower class
+			EXPECT_TRUE(labels->get_top_k_classes(0).equals({2, 0}));
+			EXPECT_TRUE(labels->get_top_k_confidences(0).equals({3.0, 0.25}));
+			EXPECT_EQ(obtained[0], 0.25);
+			EXPECT_EQ(obtained[1], -inf);
+			EXPECT_EQ(obtained[2], 3.0);
+			EXPECT_EQ(obtained[3], -inf);
+		}
+		else
+		{
+			for (auto j : range(n_classes))
+				EXPECT_EQ(obtained[j], confs[j]);
+			EXPECT_THROW(labels->get_top_k_classes(0), ShogunException);
+		}
+
+		auto copy = labels->duplicate()->as<MulticlassLabels>();
+		EXPECT_EQ(copy->get_confidence_storage(), storage);
+		EXPECT_TRUE(copy->get_multiclass_confidences(1).equals(
+		    labels->get_multiclass_confidences(1)));
+	}
+}
@@ -1,8 +1,14 @@
 #include "MockLatentModel.h"
 #include <shogun/lib/config.h>
 
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
 #include <shogun/latent/LatentSVM.h>
 
+#include <limits>
+#include <random>
+#include <vector>
+
 using namespace shogun;
 using ::testing::Return;
 using ::testing::NiceMock;
@@ -106,3 +112,156 @@ TEST(LatentSVM, apply)
 
 
 }
+
+namespace
+{
+	/** index of the selected column of an example */
+	class LatentIndex : public Data
+	{
+	public:
+		LatentIndex(index_t index = 0) : Data(), m_index(index)
+		{
+		}
+
+		const char* get_name() const override
+		{
+			return "LatentIndex";
+		}
+
+		index_t m_index;
+	};
+
+	/** every example has a few candidate vectors, h selects one of them */
+	class CandidateModel : public LatentModel
+	{
+	public:
+		CandidateModel(
+		    const std::vector<SGMatrix<float64_t>>& candidates,
+		    std::shared_ptr<LatentLabels> labels)
+		    : LatentModel(
+		          std::make_shared<LatentFeatures>(candidates.size()),
+		          std::move(labels)),
+		      m_candidates(candidates)
+		{
+		}
+
+		int32_t get_num_vectors() const override
+		{
+			return m_candidates.size();
+		}
+
+		int32_t get_dim() const override
+		{
+			return m_candidates[0].num_rows;
+		}
+
+		std::shared_ptr<DotFeatures> get_psi_feature_vectors() override
+		{
+			const int32_t num = get_num_vectors();
+			SGMatrix<float64_t> psi(get_dim(), num);
+			for (auto i : range(num))
+				get_psi_feature_vector(
+				    i, SGVector<float64_t>(
+				           psi.get_column_vector(i), get_dim(), false));
+			return std::make_shared<DenseFeatures<float64_t>>(psi);
+		}
+
+		bool supports_psi_feature_vector() const override
+		{
+			return true;
+		}
+
+		void get_psi_feature_vector(index_t idx, SGVector<float64_t> psi) override
+		{
+			auto h = m_labels->get_latent_label(idx)->as<LatentIndex>();
+			sg_memcpy(
+			    psi.vector, m_candidates[idx].get_column_vector(h->m_index),
+			    sizeof(float64_t) * psi.vlen);
+		}
+
+		std::shared_ptr<Data>
+		infer_latent_variable(const SGVector<float64_t>& w, index_t idx) override
+		{
+			const auto& x = m_candidates[idx];
+			index_t best = 0;
+			float64_t best_score = -std::numeric_limits<float64_t>::infinity();
+			for (auto j : range(x.num_cols))
+			{
+				float64_t score = 0;
+				for (auto k : range(x.num_rows))
+					score += w[k] * x(k, j);
+				if (score > best_score)
+				{
+					best = j;
+					best_score = score;
+				}
+			}
+			return std::make_shared<LatentIndex>(best);
+		}
+
+		const char* get_name() const override
+		{
+			return "CandidateModel";
+		}
+
+	private:
+		std::vector<SGMatrix<float64_t>> m_candidates;
+	};
+} // namespace
+
+TEST(LatentModel, parallel_argmax_h_and_psi_caching)
+{
+	const int32_t dim = 3, samples = 50, num_candidates = 4;
+	std::mt19937_64 prng(5);
+	std::normal_distribution<float64_t> normal;
+
+	std::vector<SGMatrix<float64_t>> candidates;
+	SGVector<float64_t> y(samples);
+	for (auto i : range(samples))
+	{
+		SGMatrix<float64_t> x(dim, num_candidates);
+		for (auto k : range(dim * num_candidates))
+			x.matrix[k] = normal(prng);
+		candidates.push_back(x);
+		y[i] = i % 3 == 0 ? -1 : 1;
+	}
+
+	auto make_model = [&](bool parallel) {
+		auto labels =
+		    std::make_shared<LatentLabels>(std::make_shared<BinaryLabels>(y));
+		for (auto i : range(samples))
+			labels->add_latent_label(std::make_shared<LatentIndex>(0));
+		auto model = std::make_shared<CandidateModel>(candidates, labels);
+		model->set_parallel_inference(parallel);
+		model->cache_psi_features();
+		return model;
+	};
+	auto serial = make_model(false);
+	auto parallel = make_model(true);
+	EXPECT_TRUE(parallel->get_parallel_inference());
+
+	auto cached = parallel->get_cached_psi_features();
+	ASSERT_TRUE(cached);
+	auto psi_matrix = cached->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+
+	SGVector<float64_t> w({1.0, -0.5, 0.25});
+	serial->argmax_h(w);
+	parallel->argmax_h(w);
+	parallel->cache_psi_features();
+
+	// the cached features are updated in place
+	EXPECT_EQ(parallel->get_cached_psi_features(), cached);
+	for (auto i : range(samples))
+	{
+		auto h = parallel->get_labels()->get_latent_label(i)->as<LatentIndex>();
+		auto h_serial =
+		    serial->get_labels()->get_latent_label(i)->as<LatentIndex>();
+		EXPECT_EQ(h->m_index, h_serial->m_index);
+		// only the positive examples are updated
+		if (y[i] != 1)
+			EXPECT_EQ(h->m_index, 0);
+
+		for (auto k : range(dim))
+			EXPECT_EQ(psi_matrix(k, i), candidates[i](k, h->m_index));
+	}
+}
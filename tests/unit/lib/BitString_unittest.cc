@@ -0,0 +1,53 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/lib/BitString.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace shogun;
+
+TEST(BitString, get_words)
+{
+	const char acgt[]="ACGT";
+	std::mt19937_64 prng(5);
+	std::uniform_int_distribution<int32_t> uniform(0, 3);
+
+	for (int32_t width : {1, 3, 16, 31, 32})
+	{
+		for (uint64_t len : {uint64_t(width), uint64_t(64), uint64_t(200)})
+		{
+			std::string dna(len, 'A');
+			for (auto& c : dna)
+				c=acgt[uniform(prng)];
+
+			BitString bs(DNA, width);
+			bs.obtain_from_char(&dna[0], len);
+			ASSERT_EQ(bs.get_length(), len-width+1);
+
+			for (uint64_t start : {uint64_t(0), uint64_t(len-width)/2})
+			{
+				const uint64_t num=bs.get_length()-start;
+				std::vector<uint64_t> words(num);
+				bs.get_words(start, num, words.data());
+
+				for (uint64_t i=0; i<num; i++)
+				{
+					uint64_t expected=0;
+					for (int32_t k=0; k<width; k++)
+						expected=(expected<<2) | (std::string(acgt).find(dna[start+i+k]));
+
+					EXPECT_EQ(words[i], expected);
+					EXPECT_EQ(bs[start+i], expected);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,116 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/lib/CacheManager.h>
+#include <shogun/lib/ConcurrentCache.h>
+
+using namespace shogun;
+
+namespace
+{
+CacheManager::Statistics statistics(int64_t misses, float64_t seconds)
+{
+	CacheManager::Statistics stats;
+	stats.misses=misses;
+	stats.miss_seconds=seconds;
+	return stats;
+}
+} // namespace
+
+TEST(CacheManager, no_budget)
+{
+	auto manager=std::make_shared<CacheManager>();
+	auto a=manager->add_cache("a");
+	auto b=manager->add_cache("b");
+	EXPECT_EQ(manager->get_num_caches(), 2);
+
+	EXPECT_EQ(a->reserve(1000), 1000);
+	EXPECT_EQ(b->reserve(5000), 5000);
+	EXPECT_EQ(manager->get_reserved(), 6000);
+
+	a->release();
+	EXPECT_EQ(manager->get_reserved(), 5000);
+	b.reset();
+	EXPECT_EQ(manager->get_num_caches(), 1);
+	EXPECT_EQ(manager->get_reserved(), 0);
+}
+
+TEST(CacheManager, budget_split_by_benefit)
+{
+	auto manager=std::make_shared<CacheManager>(1000);
+	// misses of b took three times as long as those of a
+	auto a=manager->add_cache("a", []() { return statistics(10, 1.0); });
+	auto b=manager->add_cache("b", []() { return statistics(10, 3.0); });
+	auto c=manager->add_cache("c", []() { return statistics(10, 3.0); });
+
+	EXPECT_EQ(c->reserve(200), 200);
+	EXPECT_EQ(a->reserve(1000), 800);
+	// the budget is used up until a reserves again
+	EXPECT_EQ(b->reserve(1000), 0);
+
+	// c needs little, the rest is split 1:3 between a and b
+	EXPECT_EQ(a->get_target(), 200);
+	EXPECT_EQ(b->get_target(), 600);
+	EXPECT_EQ(c->get_target(), 200);
+	EXPECT_EQ(a->reserve(1000), 200);
+	EXPECT_EQ(b->reserve(1000), 600);
+	EXPECT_EQ(manager->get_reserved(), 1000);
+}
+
+TEST(CacheManager, budget_is_not_exceeded)
+{
+	auto manager=std::make_shared<CacheManager>(1000);
+	auto a=manager->add_cache("a");
+	auto b=manager->add_cache("b");
+
+	// a is alone and gets everything it asks for
+	EXPECT_EQ(a->reserve(900), 900);
+
+	// b has the same target, but a holds its memory until it reserves again
+	EXPECT_EQ(b->reserve(900), 100);
+	EXPECT_EQ(a->get_target(), 500);
+	EXPECT_EQ(a->reserve(900), 500);
+	EXPECT_EQ(b->reserve(900), 500);
+	EXPECT_LE(manager->get_reserved(), 1000);
+
+	// the minimum is granted even if the budget is used up
+	auto c=manager->add_cache("c");
+	EXPECT_EQ(c->reserve(300, 50), 50);
+
+	// a larger budget is used on the next reservation
+	manager->set_budget(3000);
+	EXPECT_EQ(c->reserve(300, 50), 300);
+	EXPECT_EQ(a->reserve(900), 900);
+}
+
+TEST(CacheManager, concurrent_cache_within_budget)
+{
+	const auto budget=env()->get_cache_budget();
+	const auto reserved=env()->cache_manager()->get_reserved();
+	env()->set_cache_budget(1);
+	{
+		// asks for 4MB of lines of 1KB
+		ConcurrentCache<float64_t> cache(4, 128, 100000);
+		EXPECT_TRUE(cache.is_enabled());
+		EXPECT_LE(env()->cache_manager()->get_reserved(), 1024*1024+reserved);
+
+		auto* line=cache.set_entry(3);
+		ASSERT_NE(line, nullptr);
+		cache.commit_entry(3);
+		cache.unlock_entry(3, line);
+		EXPECT_EQ(cache.lock_entry(3), line);
+		cache.unlock_entry(3, line);
+
+		const auto stats=cache.get_statistics();
+		EXPECT_EQ(stats.hits, 1);
+		EXPECT_EQ(stats.misses, 1);
+	}
+	EXPECT_EQ(env()->cache_manager()->get_reserved(), reserved);
+	env()->set_cache_budget(budget);
+}
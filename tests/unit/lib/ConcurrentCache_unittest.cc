@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <shogun/lib/ConcurrentCache.h>
+
+#include <atomic>
+
+using namespace shogun;
+
+TEST(ConcurrentCache, set_commit_lock)
+{
+	ConcurrentCache<float64_t> cache(1, 4, 10, 2);
+	ASSERT_TRUE(cache.is_enabled());
+	EXPECT_EQ(cache.lock_entry(3), nullptr);
+
+	float64_t* line = cache.set_entry(3);
+	ASSERT_NE(line, nullptr);
+	/* being filled */
+	EXPECT_EQ(cache.set_entry(3), nullptr);
+	EXPECT_EQ(cache.lock_entry(3), nullptr);
+	for (index_t i = 0; i < 4; ++i)
+		line[i] = i;
+	cache.commit_entry(3);
+	cache.unlock_entry(3, line);
+
+	EXPECT_TRUE(cache.is_cached(3));
+	float64_t* cached = cache.lock_entry(3);
+	EXPECT_EQ(cached, line);
+	EXPECT_EQ(cached[3], 3);
+	cache.unlock_entry(3, cached);
+}
+
+TEST(ConcurrentCache, pinned_lines_are_not_replaced)
+{
+	/* one shard with two lines */
+	ConcurrentCache<float64_t> cache(1, 1024 * 1024 / 2 / sizeof(float64_t), 2, 1);
+	float64_t* a = cache.set_entry(0);
+	float64_t* b = cache.set_entry(1);
+	ASSERT_NE(a, nullptr);
+	ASSERT_NE(b, nullptr);
+	EXPECT_EQ(cache.set_entry(2), nullptr);
+
+	cache.commit_entry(0);
+	cache.unlock_entry(0, a);
+	EXPECT_EQ(cache.set_entry(2), a);
+	EXPECT_FALSE(cache.is_cached(0));
+
+	/* other buffers are not unlocked */
+	float64_t other;
+	cache.unlock_entry(1, &other);
+	EXPECT_EQ(cache.set_entry(3), nullptr);
+}
+
+TEST(ConcurrentCache, parallel_access)
+{
+	const int64_t obj_size = 16;
+	const int64_t num_entries = 200;
+	/* room for about a quarter of the objects */
+	ConcurrentCache<int64_t> cache(
+	    1, 1024 * 1024 / sizeof(int64_t) / 50, num_entries, 8);
+	std::atomic<int64_t> errors{0};
+
+#pragma omp parallel for num_threads(8)
+	for (int64_t k = 0; k < 20000; ++k)
+	{
+		/* two thirds of the accesses go to objects that fit */
+		const int64_t number = (k * 7919) % (k % 3 ? 30 : num_entries);
+		int64_t buffer[obj_size];
+		int64_t* obj = cache.lock_entry(number);
+		if (!obj)
+		{
+			obj = cache.set_entry(number);
+			int64_t* target = obj ? obj : buffer;
+			for (int64_t i = 0; i < obj_size; ++i)
+				target[i] = number * obj_size + i;
+			if (obj)
+				cache.commit_entry(number);
+			else
+				obj = buffer;
+		}
+
+		for (int64_t i = 0; i < obj_size; ++i)
+		{
+			if (obj[i] != number * obj_size + i)
+				errors++;
+		}
+		cache.unlock_entry(number, obj);
+	}
+
+	EXPECT_EQ(errors.load(), 0);
+}
@@ -54,3 +54,34 @@ TEST(DelimiterTokenizerTest, tokenization)
 	ASSERT_EQ(token_in_tokens, 5);
 	
 }
+
+TEST(DelimiterTokenizerTest, tokenize)
+{
+	const char* text = ",	This,, is  	the ultimate test!	,";
+	SGVector<char> cv(const_cast<char* >(text), 34, false);
+
+	auto tokenizer = std::make_shared<DelimiterTokenizer>();
+	tokenizer->init_for_whitespace();
+	tokenizer->delimiters[','] = 1;
+
+	std::vector<std::pair<index_t, index_t>> tokens;
+	for (auto skip : {false, true})
+	{
+		tokenizer->set_skip_delimiters(skip);
+		tokenizer->tokenize(cv, tokens);
+
+		tokenizer->set_text(cv);
+		size_t num_tokens = 0;
+		index_t token_start = 0;
+		while (tokenizer->has_next())
+		{
+			index_t token_end = tokenizer->next_token_idx(token_start);
+			ASSERT_LT(num_tokens, tokens.size());
+			EXPECT_EQ(tokens[num_tokens].first, token_start);
+			EXPECT_EQ(tokens[num_tokens].second, token_end);
+			num_tokens++;
+		}
+		EXPECT_EQ(tokens.size(), num_tokens);
+		EXPECT_EQ(num_tokens, skip ? 5 : 12);
+	}
+}
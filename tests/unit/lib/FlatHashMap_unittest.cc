@@ -0,0 +1,129 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/FlatHashMap.h>
+#include <shogun/lib/Map.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace shogun;
+
+TEST(FlatHashMap, matches_unordered_map)
+{
+	std::mt19937_64 prng(17);
+	std::uniform_int_distribution<int32_t> keys(0, 500);
+	std::uniform_int_distribution<int32_t> ops(0, 3);
+
+	FlatHashMap<int32_t, int64_t> map;
+	std::unordered_map<int32_t, int64_t> reference;
+	for (int32_t i = 0; i < 20000; i++)
+	{
+		const int32_t key = keys(prng);
+		switch (ops(prng))
+		{
+		case 0:
+			EXPECT_EQ(
+			    map.emplace(key, i).second, reference.emplace(key, i).second);
+			break;
+		case 1:
+			map[key] += i;
+			reference[key] += i;
+			break;
+		case 2:
+			EXPECT_EQ(map.erase(key), reference.erase(key));
+			break;
+		default:
+		{
+			auto it = map.find(key);
+			auto ref = reference.find(key);
+			ASSERT_EQ(it == map.end(), ref == reference.end());
+			if (ref != reference.end())
+				EXPECT_EQ(it->second, ref->second);
+		}
+		}
+		ASSERT_EQ(map.size(), reference.size());
+	}
+
+	size_t num_visited = 0;
+	for (const auto& element : map)
+	{
+		EXPECT_EQ(element.second, reference.at(element.first));
+		num_visited++;
+	}
+	EXPECT_EQ(num_visited, reference.size());
+}
+
+TEST(FlatHashMap, erase_while_iterating)
+{
+	FlatHashMap<int32_t, int32_t> map;
+	for (int32_t i = 0; i < 1000; i++)
+		map.emplace(i, i);
+
+	for (auto it = map.begin(); it != map.end();)
+	{
+		if (it->first % 3)
+			it = map.erase(it);
+		else
+			++it;
+	}
+	EXPECT_EQ(map.size(), 334);
+	for (int32_t i = 0; i < 1000; i++)
+		EXPECT_EQ(map.contains(i), i % 3 == 0);
+}
+
+TEST(FlatHashMap, reserve_clear_copy_move)
+{
+	FlatHashMap<std::string, int32_t> map;
+	map.reserve(100);
+	const auto capacity = map.bucket_count();
+	for (int32_t i = 0; i < 100; i++)
+		map.emplace(std::to_string(i), i);
+	EXPECT_EQ(map.bucket_count(), capacity);
+
+	auto copy = map;
+	map.clear();
+	EXPECT_TRUE(map.empty());
+	EXPECT_EQ(map.bucket_count(), capacity);
+	EXPECT_EQ(map.find("7"), map.end());
+
+	EXPECT_EQ(copy.size(), 100);
+	EXPECT_EQ(copy["42"], 42);
+
+	auto moved = std::move(copy);
+	EXPECT_EQ(moved.size(), 100);
+	EXPECT_EQ(moved.count("99"), 1);
+}
+
+TEST(CMap, add_remove_reuse)
+{
+	CMap<int32_t, float64_t> map;
+	for (int32_t i = 0; i < 50; i++)
+		EXPECT_EQ(map.add(i, i / 2.0), i);
+	EXPECT_EQ(map.add(3, 0.0), -1);
+	EXPECT_EQ(map.get_num_elements(), 50);
+
+	map.remove(10);
+	EXPECT_FALSE(map.contains(10));
+	EXPECT_EQ(map.index_of(10), -1);
+	EXPECT_EQ(map.get_element_ptr(10), nullptr);
+
+	// the freed node is used again
+	EXPECT_EQ(map.add(100, 1.0), 10);
+	EXPECT_EQ(map.get_array_size(), 50);
+	map.set_element(100, 2.0);
+	map.set_element(101, 3.0);
+	EXPECT_EQ(map.get_element(100), 2.0);
+	EXPECT_EQ(map.get_element(101), 3.0);
+	EXPECT_EQ(map.get_element(7), 3.5);
+	EXPECT_EQ(map.get_num_elements(), 51);
+
+	map.clear();
+	EXPECT_EQ(map.get_num_elements(), 0);
+	EXPECT_FALSE(map.contains(7));
+}
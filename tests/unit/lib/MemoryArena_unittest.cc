@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <shogun/lib/MemoryArena.h>
+#include <shogun/lib/SGVector.h>
+
+using namespace shogun;
+
+TEST(MemoryArena, allocate_aligned)
+{
+	MemoryArena arena(256);
+
+	char* c = arena.allocate_array<char>(3);
+	float64_t* d = arena.allocate_array<float64_t>(10);
+	void* v = arena.allocate(100, 64);
+	EXPECT_NE(c, nullptr);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(d) % alignof(float64_t), 0);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(v) % 64, 0);
+	EXPECT_EQ(arena.get_bytes_used(), 3 + 10 * sizeof(float64_t) + 100);
+
+	/* larger than a chunk */
+	int32_t* big = arena.allocate_array<int32_t>(1000);
+	for (int32_t i = 0; i < 1000; i++)
+		big[i] = i;
+	EXPECT_EQ(big[999], 999);
+	EXPECT_GE(arena.get_bytes_reserved(), 1000 * sizeof(int32_t));
+}
+
+TEST(MemoryArena, reset_reuses_chunks)
+{
+	MemoryArena arena(1024);
+
+	float64_t* first = arena.allocate_array<float64_t>(16);
+	const size_t reserved = arena.get_bytes_reserved();
+
+	arena.reset();
+	EXPECT_EQ(arena.get_bytes_used(), 0);
+	float64_t* second = arena.allocate_array<float64_t>(16);
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(arena.get_bytes_reserved(), reserved);
+
+	SGVector<float64_t> view(second, 16, false);
+	view.set_const(1);
+	EXPECT_EQ(second[15], 1);
+}
+
+TEST(MemoryArena, scope_rewinds)
+{
+	MemoryArena arena;
+
+	arena.allocate(10);
+	const size_t used = arena.get_bytes_used();
+	void* inner = nullptr;
+	{
+		MemoryArena::Scope scope(arena);
+		inner = arena.allocate(1000);
+		EXPECT_EQ(arena.get_bytes_used(), used + 1000);
+	}
+	EXPECT_EQ(arena.get_bytes_used(), used);
+	EXPECT_EQ(arena.allocate(1000), inner);
+}
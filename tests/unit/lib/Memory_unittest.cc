@@ -8,6 +8,7 @@
 #include <shogun/mathematics/NormalDistribution.h>
 
 #include <random>
+#include <vector>
 
 using namespace shogun;
 
@@ -85,3 +86,58 @@ TEST(MemoryTest, sg_memcpy)
 	SG_FREE(src);
 	SG_FREE(dest);
 }
+
+TEST(MemoryTest, small_block_pool)
+{
+	const bool enabled = get_small_block_pool_enabled();
+	set_small_block_pool_enabled(true);
+
+	std::vector<uint8_t*> blocks;
+	for (size_t size = 0; size <= 600; size += 7)
+	{
+		uint8_t* p = SG_MALLOC(uint8_t, size);
+		for (size_t i = 0; i < size; i++)
+			p[i] = i % 251;
+		blocks.push_back(p);
+	}
+
+	for (size_t k = 0; k < blocks.size(); k++)
+	{
+		const size_t size = k * 7;
+		blocks[k] = SG_REALLOC(uint8_t, blocks[k], size, size + 100);
+		for (size_t i = 0; i < size; i++)
+			EXPECT_EQ(blocks[k][i], i % 251);
+	}
+
+	int32_t* zeros = SG_CALLOC(int32_t, 20);
+	for (int32_t i = 0; i < 20; i++)
+		EXPECT_EQ(zeros[i], 0);
+
+	SGVector<float64_t> vec(10);
+	EXPECT_EQ(
+	    reinterpret_cast<uintptr_t>(vec.vector) %
+	        alignment::container_alignment,
+	    0);
+
+	set_small_block_pool_enabled(enabled);
+	/* blocks of the pool can be freed after disabling it */
+	for (auto p : blocks)
+		SG_FREE(p);
+	SG_FREE(zeros);
+}
+
+TEST(MemoryTest, statistics)
+{
+	set_memory_statistics_enabled(true);
+	reset_memory_statistics();
+
+	float64_t* p = SG_MALLOC(float64_t, 4);
+	SG_FREE(p);
+
+	auto stats = get_memory_statistics();
+	set_memory_statistics_enabled(false);
+
+	EXPECT_GE(stats.num_allocations, 1);
+	EXPECT_GE(stats.num_frees, 1);
+	EXPECT_GE(stats.bytes_allocated, 4 * sizeof(float64_t));
+}
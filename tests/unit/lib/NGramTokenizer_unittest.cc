@@ -29,3 +29,22 @@ TEST(NGramTokenizerTest, tokenization)
 
 	
 }
+
+TEST(NGramTokenizerTest, tokenize)
+{
+	const char* text = "This is the ultimate test!";
+	SGVector<char> cv(const_cast<char* >(text), 26, false);
+
+	auto tokenizer = std::make_shared<NGramTokenizer>(4);
+	std::vector<std::pair<index_t, index_t>> tokens;
+	tokenizer->tokenize(cv, tokens);
+	ASSERT_EQ(tokens.size(), 23);
+	for (index_t i=0; i<index_t(tokens.size()); i++)
+	{
+		EXPECT_EQ(tokens[i].first, i);
+		EXPECT_EQ(tokens[i].second, i+4);
+	}
+
+	tokenizer->tokenize(SGVector<char>(cv.vector, 3, false), tokens);
+	EXPECT_TRUE(tokens.empty());
+}
@@ -0,0 +1,134 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/lib/Profiler.h>
+#include <shogun/lib/observers/ParameterObserverLogger.h>
+
+#include <sstream>
+#include <thread>
+
+using namespace shogun;
+
+TEST(Profiler, counter)
+{
+	auto profiler = std::make_shared<Profiler>();
+	auto& counter = profiler->counter("hits");
+	EXPECT_EQ(&counter, &profiler->counter("hits"));
+
+	// disabled by default
+	counter.add(3);
+	EXPECT_EQ(counter.get(), 0);
+
+	profiler->set_enabled(true);
+	counter.add(3);
+	counter.add();
+	EXPECT_EQ(counter.get(), 4);
+	EXPECT_EQ(profiler->get_counters().at("hits"), 4);
+
+	profiler->reset();
+	EXPECT_EQ(counter.get(), 0);
+}
+
+TEST(Profiler, scoped_timer)
+{
+	auto profiler = std::make_shared<Profiler>();
+	auto& timer = profiler->timer("scope");
+	{
+		Profiler::ScopedTimer scope(timer);
+	}
+	EXPECT_EQ(timer.get_count(), 0);
+
+	profiler->set_enabled(true);
+	for (auto i = 0; i < 3; ++i)
+	{
+		Profiler::ScopedTimer scope(timer);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_EQ(profiler->get_timer_counts().at("scope"), 3);
+	EXPECT_GE(profiler->get_timer_seconds().at("scope"), 3e-3);
+	// without tracing nothing is recorded
+	EXPECT_EQ(profiler->get_num_trace_events(), 0);
+}
+
+TEST(Profiler, export_trace)
+{
+	auto profiler = std::make_shared<Profiler>();
+	profiler->set_tracing(true);
+	EXPECT_TRUE(profiler->is_enabled());
+	profiler->set_max_trace_events(3);
+
+	auto& timer = profiler->timer("a \"quoted\" scope");
+	auto record = [&]() {
+		for (auto i = 0; i < 2; ++i)
+			Profiler::ScopedTimer scope(timer);
+	};
+	std::thread thread(record);
+	record();
+	thread.join();
+	profiler->counter("hits").add(7);
+
+	// all scopes are timed, but only the first three are recorded
+	EXPECT_EQ(timer.get_count(), 4);
+	EXPECT_EQ(profiler->get_num_trace_events(), 3);
+
+	std::stringstream stream;
+	profiler->export_trace(stream);
+	const auto trace = stream.str();
+	EXPECT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0);
+	size_t num_events = 0;
+	for (auto pos = trace.find("\"ph\":\"X\""); pos != std::string::npos;
+	     pos = trace.find("\"ph\":\"X\"", pos + 1))
+		num_events++;
+	EXPECT_EQ(num_events, 3);
+	EXPECT_NE(trace.find("\"name\":\"a \\\"quoted\\\" scope\""), std::string::npos);
+	EXPECT_NE(
+	    trace.find("\"name\":\"hits\",\"cat\":\"shogun\",\"ph\":\"C\""),
+	    std::string::npos);
+	EXPECT_NE(trace.find("\"args\":{\"value\":7}"), std::string::npos);
+}
+
+TEST(Profiler, observe_counters)
+{
+	auto profiler = std::make_shared<Profiler>();
+	profiler->set_enabled(true);
+	profiler->counter("hits").add(5);
+	{
+		Profiler::ScopedTimer scope(profiler->timer("scope"));
+	}
+
+	auto observer = std::make_shared<ParameterObserverLogger>();
+	profiler->subscribe(observer);
+	profiler->observe_counters(1);
+	profiler->unsubscribe(observer);
+
+	ASSERT_EQ(observer->get<int32_t>("num_observations"), 2);
+	EXPECT_EQ(observer->get_observation(0)->get<int64_t>("hits"), 5);
+	EXPECT_GE(
+	    observer->get_observation(1)->get<float64_t>("scope.seconds"), 0.0);
+}
+
+#ifdef USE_PROFILING
+TEST(Profiler, macros)
+{
+	auto profiler = env()->profiler();
+	const auto enabled = profiler->is_enabled();
+	profiler->set_enabled(true);
+	const auto hits = profiler->counter("Profiler_unittest::hits").get();
+	const auto count = profiler->timer("Profiler_unittest::scope").get_count();
+	for (auto i = 0; i < 2; ++i)
+	{
+		SG_PROFILE_SCOPE("Profiler_unittest::scope");
+		SG_PROFILE_COUNT("Profiler_unittest::hits", 2);
+	}
+	profiler->set_enabled(enabled);
+
+	EXPECT_EQ(profiler->counter("Profiler_unittest::hits").get(), hits + 4);
+	EXPECT_EQ(
+	    profiler->timer("Profiler_unittest::scope").get_count(), count + 2);
+}
+#endif
@@ -812,3 +812,19 @@ TEST(SGMatrixTest, column_iterator)
 		EXPECT_EQ(*mat.get_column(col_idx), *mat_copy.get_column(col_idx) + 1.0);
 }
 
+
+TEST(SGMatrixTest, foreign_memory)
+{
+	float64_t data[] = {1, 2, 3, 4, 5, 6};
+	int32_t num_released = 0;
+	{
+		SGMatrix<float64_t> mat(data, 2, 3, [&]() { num_released++; });
+		EXPECT_EQ(mat.matrix, data);
+		EXPECT_EQ(mat(1, 2), 6);
+
+		SGVector<float64_t> vec(mat);
+		EXPECT_EQ(vec.vector, data);
+		EXPECT_EQ(num_released, 0);
+	}
+	EXPECT_EQ(num_released, 1);
+}
@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/range.h>
 #include <shogun/io/LibSVMFile.h>
 #include <shogun/lib/SGMatrix.h>
@@ -267,6 +268,97 @@ TEST(SGSparseMatrix, from_dense)
 			EXPECT_EQ(sparseMatrix(featIndex,vecIndex), denseMatrix(featIndex,vecIndex));
 }
 
+TEST(SGSparseMatrix, from_dense_contiguous)
+{
+	SGMatrix<float64_t> dense(3, 4);
+	dense.zero();
+	dense(0, 0) = 1;
+	dense(2, 0) = 2;
+	dense(1, 2) = 3;
+	dense(0, 3) = 4;
+	dense(2, 3) = 5;
+
+	SGSparseMatrix<float64_t> sparse(dense);
+	ASSERT_TRUE(sparse.is_contiguous());
+	EXPECT_EQ(sparse[0].num_feat_entries, 2);
+	EXPECT_EQ(sparse[1].num_feat_entries, 0);
+	EXPECT_EQ(sparse[2].num_feat_entries, 1);
+	EXPECT_EQ(sparse[3].num_feat_entries, 2);
+	EXPECT_EQ(sparse[0].features, sparse.contiguous_entries);
+	EXPECT_EQ(sparse[2].features, sparse.contiguous_entries + 2);
+	EXPECT_EQ(sparse[3].features, sparse.contiguous_entries + 3);
+	EXPECT_EQ(sparse[3].features[1].feat_index, 2);
+	EXPECT_EQ(sparse[3].features[1].entry, 5);
+
+	// adding an entry moves the vector out of the contiguous storage
+	sparse(1, 3) = 6;
+	EXPECT_EQ(sparse[3].num_feat_entries, 3);
+	EXPECT_EQ(sparse[3].features[2].feat_index, 1);
+	EXPECT_EQ(sparse[3].features[2].entry, 6);
+	EXPECT_EQ(sparse[0].features[1].entry, 2);
+
+	// shares the storage
+	SGSparseMatrix<float64_t> copy(sparse);
+	EXPECT_EQ(copy.contiguous_entries, sparse.contiguous_entries);
+}
+
+TEST(SGSparseMatrix, get_transposed_parallel)
+{
+	const index_t num_features = 7;
+	const index_t num_vectors = 1000;
+	const int32_t num_threads = env()->get_num_threads();
+	env()->set_num_threads(4);
+
+	SGSparseMatrix<float64_t> sparse(num_features, num_vectors);
+	for (index_t v = 0; v < num_vectors; v++)
+	{
+		const index_t len = v % num_features;
+		sparse[v] = SGSparseVector<float64_t>(len);
+		for (index_t i = 0; i < len; i++)
+		{
+			sparse[v].features[i].feat_index = (v + 2 * i) % num_features;
+			sparse[v].features[i].entry = v * num_features + i;
+		}
+	}
+
+	SGSparseMatrix<float64_t> transposed = sparse.get_transposed();
+	env()->set_num_threads(num_threads);
+
+	ASSERT_TRUE(transposed.is_contiguous());
+	EXPECT_EQ(transposed.num_vectors, num_features);
+	EXPECT_EQ(transposed.num_features, num_vectors);
+
+	index_t num_entries = 0;
+	for (index_t f = 0; f < num_features; f++)
+	{
+		const SGSparseVector<float64_t>& col = transposed[f];
+		EXPECT_EQ(col.features, transposed.contiguous_entries + num_entries);
+		num_entries += col.num_feat_entries;
+		for (index_t i = 0; i < col.num_feat_entries; i++)
+		{
+			if (i > 0)
+				EXPECT_LT(col.features[i - 1].feat_index, col.features[i].feat_index);
+
+			const SGSparseVector<float64_t>& vec = sparse[col.features[i].feat_index];
+			bool found = false;
+			for (index_t j = 0; j < vec.num_feat_entries; j++)
+			{
+				if (vec.features[j].feat_index == f)
+				{
+					EXPECT_EQ(vec.features[j].entry, col.features[i].entry);
+					found = true;
+				}
+			}
+			EXPECT_TRUE(found);
+		}
+	}
+
+	index_t expected = 0;
+	for (index_t v = 0; v < num_vectors; v++)
+		expected += sparse[v].num_feat_entries;
+	EXPECT_EQ(num_entries, expected);
+}
+
 TEST(SGSparseMatrix, transposed_square_matrix)
 {
 	const float64_t sparse_level=0.1;
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/lib/SGVectorView.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+using namespace shogun;
+
+TEST(SGVectorView, view_of_vector)
+{
+	SGVector<float64_t> vec(5);
+	vec.range_fill();
+
+	SGVectorView<float64_t> view(vec);
+	EXPECT_EQ(view.size(), 5);
+	EXPECT_EQ(view.data(), vec.vector);
+	view[2] = 10;
+	EXPECT_EQ(vec[2], 10);
+
+	SGVectorView<const float64_t> const_view = view;
+	SGVectorView<const float64_t> odd(vec.vector + 1, 2, 2);
+	EXPECT_FALSE(odd.is_contiguous());
+	EXPECT_EQ(odd[0], 1);
+	EXPECT_EQ(odd[1], 3);
+	EXPECT_EQ(const_view.slice(1, 3)[1], 10);
+
+	auto copy = odd.clone();
+	EXPECT_EQ(copy.vlen, 2);
+	EXPECT_EQ(copy[1], 3);
+}
+
+TEST(SGVectorView, does_not_touch_reference_count)
+{
+	SGVector<float64_t> vec(3);
+	const int32_t refs = vec.ref_count();
+	{
+		SGVectorView<float64_t> view(vec);
+		SGVectorView<float64_t> copy = view;
+		EXPECT_EQ(copy.size(), 3);
+		EXPECT_EQ(vec.ref_count(), refs);
+	}
+	EXPECT_EQ(vec.ref_count(), refs);
+}
+
+TEST(SGMatrixView, rows_and_columns)
+{
+	SGMatrix<float64_t> mat(3, 4);
+	for (index_t i = 0; i < mat.num_rows * mat.num_cols; ++i)
+		mat[i] = i;
+
+	SGMatrixView<const float64_t> view(mat);
+	EXPECT_TRUE(view.is_contiguous());
+	EXPECT_EQ(view(1, 2), mat(1, 2));
+
+	auto col = view.col(2);
+	auto row = view.row(1);
+	EXPECT_TRUE(col.is_contiguous());
+	EXPECT_EQ(row.stride(), 3);
+	for (index_t j = 0; j < 4; ++j)
+		EXPECT_EQ(row[j], mat(1, j));
+
+	auto block = view.rows(1, 3).cols(1, 3);
+	EXPECT_FALSE(block.is_contiguous());
+	auto copy = block.clone();
+	for (index_t j = 0; j < 2; ++j)
+		for (index_t i = 0; i < 2; ++i)
+			EXPECT_EQ(copy(i, j), mat(i + 1, j + 1));
+}
+
+TEST(SGVectorView, linalg_and_dot_features)
+{
+	SGMatrix<float64_t> mat(3, 2);
+	for (index_t i = 0; i < 6; ++i)
+		mat[i] = i + 1;
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(mat);
+
+	SGVector<float64_t> w(3);
+	w.set_const(2);
+	SGVectorView<const float64_t> wv(w);
+
+	auto x = feats->get_feature_vector_view(1);
+	EXPECT_EQ(x.data(), mat.get_column_vector(1));
+	EXPECT_DOUBLE_EQ(linalg::dot(x, wv), 2 * (4 + 5 + 6));
+	EXPECT_DOUBLE_EQ(feats->dot(1, wv), 2 * (4 + 5 + 6));
+
+	/* strided view of the first row */
+	auto row = feats->get_feature_matrix_view().row(0);
+	SGVector<float64_t> ones(2);
+	ones.set_const(1);
+	EXPECT_DOUBLE_EQ(
+	    linalg::dot(row, SGVectorView<const float64_t>(ones)), 1 + 4);
+
+	SGVector<float64_t> y(3);
+	y.zero();
+	linalg::axpy(0.5, x, SGVectorView<float64_t>(y));
+	EXPECT_DOUBLE_EQ(y[2], 3);
+}
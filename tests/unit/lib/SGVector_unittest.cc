@@ -489,3 +489,21 @@ TEST(SGVectorTest, slice)
 			EXPECT_EQ(vec[i], sliced_vec2[i - l - l2]);
 	}
 }
+
+TEST(SGVectorTest, foreign_memory)
+{
+	float64_t data[] = {1, 2, 3};
+	int32_t num_released = 0;
+	{
+		SGVector<float64_t> vec(data, 3, [&]() { num_released++; });
+		EXPECT_EQ(vec.vector, data);
+		EXPECT_EQ(vec.ref_count(), 1);
+
+		auto copy = vec;
+		EXPECT_EQ(vec.ref_count(), 2);
+		copy[0] = 5;
+	}
+	// the memory is handed back once, not freed
+	EXPECT_EQ(num_released, 1);
+	EXPECT_EQ(data[0], 5);
+}
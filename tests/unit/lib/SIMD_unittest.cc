@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/simd.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+using namespace shogun;
+
+template <typename T>
+class SIMDTest : public ::testing::Test
+{
+};
+
+typedef ::testing::Types<float64_t, float32_t, int8_t, uint8_t, int16_t>
+    SIMDTypes;
+TYPED_TEST_CASE(SIMDTest, SIMDTypes);
+
+TYPED_TEST(SIMDTest, dot_and_axpy)
+{
+	std::mt19937_64 prng(17);
+	std::uniform_int_distribution<int32_t> values(
+	    std::is_signed<TypeParam>::value ? -100 : 0, 100);
+	std::uniform_real_distribution<float64_t> weights(-10, 10);
+
+	const auto selected = simd::selected_isa();
+	for (auto isa : {simd::ISA::GENERIC, simd::ISA::SSE42, simd::ISA::AVX2,
+	                 simd::ISA::AVX512F, simd::ISA::NEON})
+	{
+		if (!simd::select_isa(isa))
+			continue;
+
+		// all lengths around the vector widths and their tails
+		for (index_t n = 0; n < 40; n++)
+		{
+			SGVector<TypeParam> x(n);
+			SGVector<float64_t> w(n), y(n), expected_y(n);
+			for (index_t i = 0; i < n; i++)
+			{
+				x[i] = values(prng);
+				if (std::is_floating_point<TypeParam>::value)
+					x[i] = x[i] / 8;
+				w[i] = weights(prng);
+				y[i] = expected_y[i] = weights(prng);
+			}
+
+			float64_t expected = 0;
+			for (index_t i = 0; i < n; i++)
+			{
+				expected += float64_t(x[i]) * w[i];
+				expected_y[i] += 0.75 * float64_t(x[i]);
+			}
+			EXPECT_NEAR(simd::dot(x.vector, w.vector, n), expected, 1e-10);
+
+			simd::axpy(0.75, x.vector, y.vector, n);
+			for (index_t i = 0; i < n; i++)
+				EXPECT_NEAR(y[i], expected_y[i], 1e-12);
+		}
+	}
+	simd::select_isa(selected);
+}
+
+TEST(SIMD, exp_and_log)
+{
+	std::mt19937_64 prng(23);
+	std::uniform_real_distribution<float64_t> exponents(-720, 720);
+	std::uniform_real_distribution<float64_t> decades(-300, 300);
+	const auto inf = std::numeric_limits<float64_t>::infinity();
+	const auto nan = std::numeric_limits<float64_t>::quiet_NaN();
+
+	const auto selected = simd::selected_isa();
+	for (auto isa : {simd::ISA::GENERIC, simd::ISA::SSE42, simd::ISA::AVX2,
+	                 simd::ISA::AVX512F, simd::ISA::NEON})
+	{
+		if (!simd::select_isa(isa))
+			continue;
+
+		for (index_t n = 0; n < 40; n++)
+		{
+			SGVector<float64_t> x(n), y(n);
+			for (index_t i = 0; i < n; i++)
+				x[i] = exponents(prng);
+			// arguments the approximation leaves to libm
+			if (n > 3)
+			{
+				x[1] = nan;
+				x[2] = -inf;
+				x[3] = 1000;
+			}
+
+			simd::exp(x.vector, y.vector, n);
+			for (index_t i = 0; i < n; i++)
+			{
+				const auto expected = std::exp(x[i]);
+				if (!std::isfinite(expected) || expected == 0)
+					EXPECT_TRUE(y[i] == expected || std::isnan(expected))
+					    << x[i];
+				else
+					EXPECT_NEAR(y[i], expected, 4e-16 * expected) << x[i];
+			}
+
+			for (index_t i = 0; i < n; i++)
+				x[i] = std::pow(10.0, decades(prng));
+			if (n > 5)
+			{
+				x[1] = 0;
+				x[2] = -1;
+				x[3] = 1e-310;
+				x[4] = inf;
+				x[5] = 1;
+			}
+
+			// in place
+			y = x.clone();
+			simd::log(y.vector, y.vector, n);
+			for (index_t i = 0; i < n; i++)
+			{
+				const auto expected = std::log(x[i]);
+				if (!std::isfinite(expected))
+					EXPECT_TRUE(y[i] == expected || std::isnan(y[i])) << x[i];
+				else
+					EXPECT_NEAR(y[i], expected, 4e-16 * std::abs(expected))
+					    << x[i];
+			}
+		}
+	}
+	simd::select_isa(selected);
+}
+
+TEST(SIMD, pow)
+{
+	std::mt19937_64 prng(29);
+	std::uniform_real_distribution<float64_t> values(0, 50);
+
+	// longer than a chunk, with arguments left to std::pow
+	const index_t n = 600;
+	SGVector<float64_t> x(n);
+	for (index_t i = 0; i < n; i++)
+		x[i] = values(prng);
+	x[0] = 0;
+	x[1] = -2;
+	x[300] = -0.5;
+
+	for (auto e : {1.8, -0.5, 3.0, 0.0})
+	{
+		SGVector<float64_t> y = x.clone();
+		simd::pow(y.vector, e, y.vector, n);
+		for (index_t i = 0; i < n; i++)
+		{
+			const auto expected = std::pow(x[i], e);
+			if (!std::isfinite(expected))
+				EXPECT_TRUE(y[i] == expected || std::isnan(y[i])) << x[i];
+			else
+				EXPECT_NEAR(y[i], expected, 1e-14 * std::abs(expected))
+				    << x[i] << "^" << e;
+		}
+	}
+}
+
+TEST(SIMD, select_isa)
+{
+	const auto detected = simd::detected_isa();
+	EXPECT_EQ(env()->simd_isa(), simd::isa_name(simd::selected_isa()));
+
+	// the plain loops are always available
+	EXPECT_TRUE(env()->set_simd_isa("generic"));
+	EXPECT_EQ(simd::selected_isa(), simd::ISA::GENERIC);
+	EXPECT_EQ(env()->simd_isa(), "generic");
+
+	EXPECT_FALSE(env()->set_simd_isa("mmx"));
+	EXPECT_EQ(simd::selected_isa(), simd::ISA::GENERIC);
+
+	EXPECT_TRUE(env()->set_simd_isa(simd::isa_name(detected)));
+	EXPECT_EQ(simd::selected_isa(), detected);
+}
@@ -0,0 +1,90 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/SmallVector.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace shogun;
+
+TEST(SmallVector, inline_and_heap)
+{
+	SmallVector<int32_t, 4> vector;
+	std::vector<int32_t> reference;
+	for (int32_t i = 0; i < 4; i++)
+	{
+		vector.push_back(i);
+		reference.push_back(i);
+	}
+	EXPECT_TRUE(vector.is_inline());
+
+	for (int32_t i = 4; i < 100; i++)
+	{
+		vector.push_back(i);
+		reference.push_back(i);
+	}
+	EXPECT_FALSE(vector.is_inline());
+	EXPECT_TRUE(std::equal(
+	    vector.begin(), vector.end(), reference.begin(), reference.end()));
+
+	vector.insert(vector.begin() + 3, -1);
+	reference.insert(reference.begin() + 3, -1);
+	vector.erase(vector.begin() + 50);
+	reference.erase(reference.begin() + 50);
+	vector.resize(70);
+	reference.resize(70);
+	EXPECT_TRUE(std::equal(
+	    vector.begin(), vector.end(), reference.begin(), reference.end()));
+
+	const auto capacity = vector.capacity();
+	vector.clear();
+	EXPECT_TRUE(vector.empty());
+	EXPECT_EQ(vector.capacity(), capacity);
+}
+
+TEST(SmallVector, copy_move)
+{
+	SmallVector<std::string, 2> small{"a", "b"};
+	SmallVector<std::string, 2> large{"a", "b", "c", "d"};
+
+	auto small_copy = small;
+	auto large_copy = large;
+	EXPECT_EQ(small_copy, small);
+	EXPECT_EQ(large_copy, large);
+
+	auto small_moved = std::move(small_copy);
+	auto large_moved = std::move(large_copy);
+	EXPECT_TRUE(small_moved.is_inline());
+	EXPECT_FALSE(large_moved.is_inline());
+	EXPECT_EQ(small_moved, small);
+	EXPECT_EQ(large_moved, large);
+	EXPECT_TRUE(small_copy.empty());
+	EXPECT_TRUE(large_copy.empty());
+
+	small_moved = large;
+	EXPECT_EQ(small_moved.back(), "d");
+	small_moved.pop_back();
+	EXPECT_EQ(small_moved.size(), 3);
+}
+
+TEST(SmallVector, element_lifetime)
+{
+	auto counter = std::make_shared<int32_t>(0);
+	{
+		SmallVector<std::shared_ptr<int32_t>, 3> vector;
+		for (int32_t i = 0; i < 10; i++)
+			vector.push_back(counter);
+		// pushing an element of the vector while it grows
+		vector.push_back(vector.front());
+		EXPECT_EQ(counter.use_count(), 12);
+		vector.resize(2);
+		EXPECT_EQ(counter.use_count(), 3);
+	}
+	EXPECT_EQ(counter.use_count(), 1);
+}
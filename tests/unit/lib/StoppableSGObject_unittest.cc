@@ -4,7 +4,9 @@
  * Authors: Giovanni De Toni
 */
 
+#include <chrono>
 #include <functional>
+#include <thread>
 #include <gtest/gtest.h>
 #include <rxcpp/rx-lite.hpp>
 #include <shogun/base/ShogunEnv.h>
@@ -108,3 +110,125 @@ TEST(StoppableSGObject, custom_callback_by_user)
 	EXPECT_TRUE(a.get_check() == 3);
 }
 #endif
+
+/**
+ * Model that counts the steps of its training loop, optionally after
+ * training a child model on another thread.
+ */
+class BudgetModel : public Machine
+{
+public:
+	BudgetModel(int32_t num_steps, int32_t step_ms)
+	    : m_num_steps(num_steps), m_step_ms(step_ms), m_num_done(0),
+	      m_computation(nullptr)
+	{
+	}
+
+	int32_t get_num_done() const
+	{
+		return m_num_done;
+	}
+
+	StoppableSGObject* get_computation() const
+	{
+		return m_computation;
+	}
+
+	void set_child(std::shared_ptr<BudgetModel> child)
+	{
+		m_child = std::move(child);
+	}
+
+	const char* get_name() const override
+	{
+		return "BudgetModel";
+	}
+
+protected:
+	bool train_require_labels() const override
+	{
+		return false;
+	}
+
+	bool train_machine(std::shared_ptr<Features> data = NULL) override
+	{
+		m_num_done = 0;
+		m_computation = current_computation();
+
+		if (m_child)
+		{
+			const auto computation = current_computation();
+#pragma omp parallel num_threads(2)
+			{
+				ComputationScope scope(computation);
+#pragma omp single
+				m_child->train();
+			}
+		}
+
+		for (int32_t i = 0; i < m_num_steps; i++)
+		{
+			COMPUTATION_CONTROLLERS
+			if (m_step_ms)
+				std::this_thread::sleep_for(
+				    std::chrono::milliseconds(m_step_ms));
+			m_num_done++;
+		}
+		return true;
+	}
+
+	int32_t m_num_steps;
+	int32_t m_step_ms;
+	int32_t m_num_done;
+	StoppableSGObject* m_computation;
+	std::shared_ptr<BudgetModel> m_child;
+};
+
+TEST(StoppableSGObject, iteration_budget)
+{
+	auto model = std::make_shared<BudgetModel>(100, 0);
+	model->set_iteration_budget(7);
+	model->train();
+	EXPECT_EQ(model->get_num_done(), 7);
+	EXPECT_TRUE(model->budget_expired());
+	EXPECT_EQ(model->get_computation(), model.get());
+	EXPECT_EQ(StoppableSGObject::current_computation(), nullptr);
+
+	// the budget is restarted for every training
+	model->train();
+	EXPECT_EQ(model->get_num_done(), 7);
+
+	model->set_iteration_budget(0);
+	model->train();
+	EXPECT_EQ(model->get_num_done(), 100);
+	EXPECT_FALSE(model->budget_expired());
+
+	EXPECT_THROW(model->set_iteration_budget(-1), ShogunException);
+}
+
+TEST(StoppableSGObject, time_budget)
+{
+	auto model = std::make_shared<BudgetModel>(10000, 1);
+	model->set_time_budget(0.05);
+	model->train();
+	EXPECT_GT(model->get_num_done(), 0);
+	EXPECT_LT(model->get_num_done(), 10000);
+	EXPECT_TRUE(model->budget_expired());
+
+	EXPECT_THROW(model->set_time_budget(-1), ShogunException);
+}
+
+TEST(StoppableSGObject, budget_stops_nested_computation)
+{
+	auto child = std::make_shared<BudgetModel>(10000, 1);
+	auto parent = std::make_shared<BudgetModel>(10, 0);
+	parent->set_child(child);
+	parent->set_time_budget(0.05);
+	parent->train();
+
+	// the child runs on another thread and stops with its parent
+	EXPECT_LT(child->get_num_done(), 10000);
+	EXPECT_FALSE(child->budget_expired());
+	EXPECT_TRUE(parent->budget_expired());
+	EXPECT_EQ(parent->get_num_done(), 0);
+}
@@ -0,0 +1,61 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/TCPCommunicator.h>
+
+#include <thread>
+#include <vector>
+
+using namespace shogun;
+
+TEST(TCPCommunicator, allreduce_and_broadcast)
+{
+	const int32_t size=4;
+	auto root=std::make_shared<TCPCommunicator>(0, size, "127.0.0.1", 0);
+	const int32_t port=root->get_port();
+	ASSERT_GT(port, 0);
+
+	std::vector<SGVector<float64_t>> sums(size);
+	std::vector<SGVector<float64_t>> broadcasts(size);
+	auto run=[&](std::shared_ptr<TCPCommunicator> communicator) {
+		const int32_t rank=communicator->get_rank();
+		SGVector<float64_t> data(3);
+		for (index_t i=0; i<data.vlen; i++)
+			data[i]=rank*10+i;
+		communicator->allreduce_sum(data);
+		sums[rank]=data;
+
+		SGVector<float64_t> value(1);
+		value[0]=rank;
+		communicator->broadcast(value, 2);
+		broadcasts[rank]=value;
+	};
+
+	std::vector<std::thread> workers;
+	for (int32_t rank=1; rank<size; rank++)
+	{
+		workers.emplace_back(run, std::make_shared<TCPCommunicator>(
+			rank, size, "127.0.0.1", port));
+	}
+	run(root);
+	for (auto& worker : workers)
+		worker.join();
+
+	for (int32_t rank=0; rank<size; rank++)
+	{
+		for (index_t i=0; i<3; i++)
+			EXPECT_EQ(sums[rank][i], 60+4*i);
+		EXPECT_EQ(broadcasts[rank][0], 2);
+	}
+}
+
+TEST(TCPCommunicator, single_process)
+{
+	TCPCommunicator communicator;
+	EXPECT_EQ(communicator.get_size(), 1);
+	EXPECT_EQ(communicator.allreduce_sum(3.0), 3.0);
+}
@@ -0,0 +1,73 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+
+#include <shogun/lib/observers/ConvergenceMonitor.h>
+#include <shogun/lib/observers/ScalarRingBuffer.h>
+
+using namespace shogun;
+
+TEST(ScalarRingBuffer, wraps_around)
+{
+	ScalarRingBuffer<float64_t> buffer(3);
+	EXPECT_TRUE(buffer.empty());
+
+	for (int64_t step = 0; step < 5; step++)
+		buffer.push(step, 10.0 * step);
+
+	ASSERT_EQ(buffer.size(), 3);
+	for (index_t i = 0; i < buffer.size(); i++)
+	{
+		EXPECT_EQ(buffer.step(i), i + 2);
+		EXPECT_EQ(buffer.value(i), 10.0 * (i + 2));
+	}
+
+	buffer.clear();
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(buffer.capacity(), 3);
+}
+
+TEST(ConvergenceMonitor, channels)
+{
+	auto monitor = std::make_shared<ConvergenceMonitor>(2, 5);
+	auto loss = monitor->add_channel("loss");
+	EXPECT_EQ(monitor->add_channel("loss"), loss);
+	EXPECT_EQ(monitor->get_channel("accuracy"), -1);
+
+	for (int64_t step = 0; step < 20; step++)
+	{
+		if (monitor->should_sample(step))
+			monitor->record(loss, step, 1.0 / (step + 1));
+	}
+
+	auto steps = monitor->get_steps("loss");
+	auto values = monitor->get_values("loss");
+	ASSERT_EQ(steps.vlen, 2);
+	EXPECT_EQ(steps[0], 10);
+	EXPECT_EQ(steps[1], 15);
+	EXPECT_EQ(values[1], 1.0 / 16);
+	EXPECT_FALSE(monitor->should_stop());
+}
+
+TEST(ConvergenceMonitor, early_stopping)
+{
+	auto monitor = std::make_shared<ConvergenceMonitor>();
+	monitor->set_early_stopping("error", 2, false, 0.01);
+	auto error = monitor->get_channel("error");
+
+	monitor->record(error, 0, 0.5);
+	monitor->record(error, 1, 0.3);
+	monitor->record(error, 2, 0.295);
+	EXPECT_FALSE(monitor->should_stop());
+	monitor->record(error, 3, 0.4);
+	EXPECT_TRUE(monitor->should_stop());
+	EXPECT_EQ(monitor->get_best_value(), 0.3);
+	EXPECT_EQ(monitor->get_best_step(), 1);
+
+	monitor->reset();
+	EXPECT_FALSE(monitor->should_stop());
+	EXPECT_TRUE(monitor->get_values("error").vlen == 0);
+}
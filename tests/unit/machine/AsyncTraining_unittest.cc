@@ -0,0 +1,97 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/machine/AsyncTraining.h>
+#include <shogun/machine/Machine.h>
+
+#include <atomic>
+
+using namespace shogun;
+
+namespace
+{
+/* trains until it is stopped or the given number of iterations is done */
+class CountingMachine : public Machine
+{
+public:
+	CountingMachine(int32_t max_iterations=-1)
+	    : m_max_iterations(max_iterations)
+	{
+	}
+
+	const char* get_name() const override
+	{
+		return "CountingMachine";
+	}
+
+	std::atomic<int32_t> m_iterations{0};
+
+protected:
+	bool train_require_labels() const override
+	{
+		return false;
+	}
+
+	bool train_machine(std::shared_ptr<Features> data=NULL) override
+	{
+		while (m_max_iterations<0 || m_iterations<m_max_iterations)
+		{
+			COMPUTATION_CONTROLLERS
+			m_iterations++;
+		}
+		if (m_max_iterations==0)
+			error("Nothing to train");
+		return m_iterations==m_max_iterations;
+	}
+
+	int32_t m_max_iterations;
+};
+}
+
+TEST(AsyncTraining, finishes)
+{
+	auto machine=std::make_shared<CountingMachine>(1000);
+	auto training=machine->train_async();
+	EXPECT_TRUE(training->get());
+	EXPECT_TRUE(training->is_done());
+	EXPECT_EQ(machine->m_iterations, 1000);
+	EXPECT_EQ(training->get_machine(), machine);
+}
+
+TEST(AsyncTraining, cancel)
+{
+	auto machine=std::make_shared<CountingMachine>();
+	auto training=machine->train_async();
+	while (machine->m_iterations==0)
+		;
+	EXPECT_FALSE(training->wait_for(0.01));
+	training->cancel();
+	training->wait();
+	EXPECT_TRUE(training->is_done());
+	EXPECT_FALSE(training->get());
+}
+
+TEST(AsyncTraining, cancel_after_finish)
+{
+	auto machine=std::make_shared<CountingMachine>(1000);
+	auto training=machine->train_async();
+	training->wait();
+
+	// the cancellation does not leak into the next training
+	training->cancel();
+	machine->m_iterations=0;
+	EXPECT_TRUE(machine->train());
+	EXPECT_EQ(machine->m_iterations, 1000);
+}
+
+TEST(AsyncTraining, error)
+{
+	auto machine=std::make_shared<CountingMachine>(0);
+	auto training=machine->train_async();
+	EXPECT_THROW(training->get(), ShogunException);
+}
@@ -0,0 +1,176 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/evaluation/SigmoidCalibration.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+#include <random>
+
+using namespace shogun;
+
+class LinearMulticlassMachineTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const index_t num_class=5, num_vec=200;
+		std::mt19937_64 prng(57);
+		NormalDistribution<float64_t> normal_dist;
+		SGMatrix<float64_t> matrix(num_class, num_vec);
+		labels=std::make_shared<MulticlassLabels>(num_vec);
+		for (index_t i=0; i<num_vec; i++)
+		{
+			// uneven class sizes give one-vs-one pairs of different sizes
+			const index_t label=(i*i)%num_class;
+			for (index_t j=0; j<num_class; j++)
+				matrix(j, i)=normal_dist(prng);
+			matrix(label, i)+=3;
+			labels->set_label(i, label);
+		}
+		features=std::make_shared<DenseFeatures<float64_t>>(matrix);
+	}
+
+	/* trains with the given number of threads, returns all sub-machines */
+	std::shared_ptr<LinearMulticlassMachine> train(
+		std::shared_ptr<MulticlassStrategy> strategy, int32_t num_threads)
+	{
+		const int32_t old_num_threads=env()->get_num_threads();
+		env()->set_num_threads(num_threads);
+		auto svm=std::make_shared<LibLinear>(L2R_L2LOSS_SVC_DUAL);
+		svm->set_epsilon(1e-8);
+		auto machine=std::make_shared<LinearMulticlassMachine>(
+			strategy, features, svm, labels);
+		machine->train();
+		env()->set_num_threads(old_num_threads);
+		return machine;
+	}
+
+	void expect_parallel_matches_sequential(
+		std::shared_ptr<MulticlassStrategy> strategy,
+		std::shared_ptr<MulticlassStrategy> parallel_strategy)
+	{
+		auto sequential=train(strategy, 1);
+		auto parallel=train(parallel_strategy, 4);
+
+		/* LibLinear shuffles with its own generator, each parallel
+		 * sub-machine starts from the same state, so the solutions agree up
+		 * to the tolerance only */
+		ASSERT_EQ(parallel->get_num_machines(), sequential->get_num_machines());
+		for (int32_t i=0; i<sequential->get_num_machines(); i++)
+		{
+			auto w=sequential->get_machine(i)->as<LinearMachine>()->get_w();
+			auto w_parallel=
+				parallel->get_machine(i)->as<LinearMachine>()->get_w();
+			ASSERT_EQ(w_parallel.vlen, w.vlen);
+			for (index_t j=0; j<w.vlen; j++)
+				EXPECT_NEAR(w_parallel[j], w[j], 1e-4);
+		}
+
+		env()->set_num_threads(4);
+		auto pred_parallel=parallel->apply_multiclass(features);
+		env()->set_num_threads(1);
+		auto pred=sequential->apply_multiclass(features);
+		for (index_t i=0; i<pred->get_num_labels(); i++)
+			EXPECT_EQ(pred_parallel->get_label(i), pred->get_label(i));
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<MulticlassLabels> labels;
+};
+
+TEST_F(LinearMulticlassMachineTest, one_vs_rest_parallel_matches_sequential)
+{
+	const int32_t num_threads=env()->get_num_threads();
+	expect_parallel_matches_sequential(
+		std::make_shared<MulticlassOneVsRestStrategy>(),
+		std::make_shared<MulticlassOneVsRestStrategy>());
+	env()->set_num_threads(num_threads);
+}
+
+TEST_F(LinearMulticlassMachineTest, one_vs_one_parallel_matches_sequential)
+{
+	const int32_t num_threads=env()->get_num_threads();
+	expect_parallel_matches_sequential(
+		std::make_shared<MulticlassOneVsOneStrategy>(),
+		std::make_shared<MulticlassOneVsOneStrategy>());
+	env()->set_num_threads(num_threads);
+}
+
+TEST_F(LinearMulticlassMachineTest, apply_blockwise_top_k)
+{
+	auto machine=train(std::make_shared<MulticlassOneVsRestStrategy>(), 1);
+	auto pred=machine->apply_multiclass(features);
+
+	machine->set_confidence_storage(CONFIDENCES_TOP_K, 2);
+	index_t next=0;
+	machine->apply_multiclass_blockwise(features, 64,
+		[&](index_t start, std::shared_ptr<MulticlassLabels> block)
+		{
+			EXPECT_EQ(start, next);
+			EXPECT_EQ(block->get_confidence_storage(), CONFIDENCES_TOP_K);
+			for (index_t i=0; i<block->get_num_labels(); i++)
+			{
+				EXPECT_EQ(block->get_label(i), pred->get_label(start+i));
+
+				// the predicted class is the most confident one
+				auto confs=pred->get_multiclass_confidences(start+i);
+				auto classes=block->get_top_k_classes(i);
+				auto top_confs=block->get_top_k_confidences(i);
+				ASSERT_EQ(classes.vlen, 2);
+				EXPECT_EQ(classes[0], pred->get_int_label(start+i));
+				for (index_t j=0; j<classes.vlen; j++)
+					EXPECT_NEAR(top_confs[j], confs[classes[j]], 1e-5);
+				EXPECT_GE(top_confs[0], top_confs[1]);
+			}
+			next+=block->get_num_labels();
+		});
+	// the blocks leave no subset behind
+	EXPECT_EQ(next, 200);
+	EXPECT_EQ(features->get_num_vectors(), 200);
+
+	EXPECT_THROW(
+		machine->set_confidence_storage(CONFIDENCES_TOP_K, 0),
+		ShogunException);
+}
+
+TEST_F(LinearMulticlassMachineTest, apply_calibrated)
+{
+	auto machine=train(std::make_shared<MulticlassOneVsRestStrategy>(), 1);
+	auto pred=machine->apply_multiclass(features);
+
+	auto calibration=std::make_shared<SigmoidCalibration>();
+	calibration->fit_multiclass(pred, labels);
+	auto expected=calibration->calibrate_multiclass(pred);
+
+	const int32_t num_threads=env()->get_num_threads();
+	env()->set_num_threads(4);
+	machine->set_calibration(calibration);
+	auto calibrated=machine->apply_multiclass(features);
+	env()->set_num_threads(num_threads);
+
+	for (index_t i=0; i<calibrated->get_num_labels(); i++)
+	{
+		auto probs=calibrated->get_multiclass_confidences(i);
+		auto expected_probs=expected->get_multiclass_confidences(i);
+		ASSERT_EQ(probs.vlen, expected_probs.vlen);
+		for (index_t j=0; j<probs.vlen; j++)
+			EXPECT_EQ(probs[j], expected_probs[j]);
+		EXPECT_NEAR(SGVector<float64_t>::sum(probs), 1.0, 1e-12);
+		EXPECT_EQ(calibrated->get_label(i), expected->get_label(i));
+	}
+
+	auto one_vs_one=train(std::make_shared<MulticlassOneVsOneStrategy>(), 1);
+	one_vs_one->set_calibration(calibration);
+	EXPECT_THROW(one_vs_one->apply_multiclass(features), ShogunException);
+}
@@ -4,8 +4,14 @@
 #include "transformer/MockTransformer.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/lib/View.h>
 #include <shogun/lib/exception/InvalidStateException.h>
 #include <shogun/machine/Pipeline.h>
+#include <shogun/preprocessor/NormOne.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+#include <shogun/regression/LinearRidgeRegression.h>
 #include <stdexcept>
 
 using namespace shogun;
@@ -92,4 +98,142 @@ TEST_F(PipelineTest, get)
 	    pipeline->get_transformer("MockTransformer"), transformer1);
 	EXPECT_EQ(pipeline->get_transformer(transformer_name), transformer2);
 	EXPECT_EQ(pipeline->get_machine(), machine);
+
+	auto transformers = pipeline->get_transformers();
+	ASSERT_EQ(transformers.size(), 2);
+	EXPECT_EQ(transformers[0], transformer1);
+	EXPECT_EQ(transformers[1], transformer2);
+}
+
+class PipelineCacheTest : public ::testing::Test
+{
+protected:
+	static constexpr auto kUntrained =
+	    ParameterProperties::HYPER | ParameterProperties::SETTING;
+
+	void SetUp() override
+	{
+		SGMatrix<float64_t> data(3, 40);
+		SGVector<float64_t> y(data.num_cols);
+		for (index_t i = 0; i < data.num_cols; i++)
+		{
+			data(0, i) = i % 7 + 1;
+			data(1, i) = (i * 13) % 11 + 0.5;
+			data(2, i) = (i * 5) % 3;
+			y[i] = data(0, i) - 2 * data(1, i) + 0.1 * data(2, i);
+		}
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		labels = std::make_shared<RegressionLabels>(y);
+	}
+
+	std::shared_ptr<Pipeline> make_pipeline() const
+	{
+		auto pipeline = std::make_shared<PipelineBuilder>()
+		                    ->over(std::make_shared<PruneVarSubMean>())
+		                    ->over(std::make_shared<NormOne>())
+		                    ->then(std::make_shared<LinearRidgeRegression>(
+		                        0.1, nullptr, nullptr));
+		pipeline->set_labels(labels);
+		return pipeline;
+	}
+
+	void expect_same_predictions(
+	    const std::shared_ptr<Pipeline>& pipeline,
+	    const std::shared_ptr<Pipeline>& expected)
+	{
+		auto result = pipeline->apply_regression(features)->get_labels();
+		auto expected_result =
+		    expected->apply_regression(features)->get_labels();
+		ASSERT_EQ(result.vlen, expected_result.vlen);
+		for (index_t i = 0; i < result.vlen; i++)
+			EXPECT_NEAR(result[i], expected_result[i], 1e-10);
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<RegressionLabels> labels;
+};
+
+TEST_F(PipelineCacheTest, cached_fit)
+{
+	auto reference = make_pipeline();
+	reference->train(features);
+
+	auto cache = std::make_shared<TransformerCache>();
+	auto pipeline = make_pipeline();
+	pipeline->set_cache(cache);
+
+	// clones share the cache, e.g. in cross-validation
+	auto first = make_clone(pipeline, kUntrained);
+	EXPECT_EQ(first->get_cache(), cache);
+	first->set_labels(labels);
+	first->train(features);
+	EXPECT_EQ(cache->get_num_misses(), 2);
+	EXPECT_EQ(cache->get_num_hits(), 0);
+	EXPECT_EQ(cache->get_num_entries(), 2);
+
+	auto second = make_clone(pipeline, kUntrained);
+	second->set_labels(labels);
+	second->train(features);
+	EXPECT_EQ(cache->get_num_misses(), 2);
+	EXPECT_EQ(cache->get_num_hits(), 2);
+	expect_same_predictions(first, reference);
+	expect_same_predictions(second, reference);
+
+	// other data misses
+	SGVector<index_t> idx({0, 2, 4, 6, 8, 10, 12, 14, 16, 18});
+	auto third = make_clone(pipeline, kUntrained);
+	third->set_labels(view(labels, idx));
+	third->train(view(features, idx));
+	EXPECT_EQ(cache->get_num_misses(), 4);
+
+	// the original data is not modified
+	EXPECT_EQ(features->get_num_features(), 3);
+}
+
+TEST_F(PipelineCacheTest, spill)
+{
+	auto reference = make_pipeline();
+	reference->train(features);
+
+	// every entry exceeds the limit and is written to disk
+	auto cache = std::make_shared<TransformerCache>(0);
+	cache->set_spill_directory(".");
+	auto pipeline = make_pipeline();
+	pipeline->set_cache(cache);
+
+	auto first = make_clone(pipeline, kUntrained);
+	first->set_labels(labels);
+	first->train(features);
+	EXPECT_EQ(cache->get_num_entries(), 0);
+	EXPECT_EQ(cache->get_memory_usage(), 0);
+
+	auto second = make_clone(pipeline, kUntrained);
+	second->set_labels(labels);
+	second->train(features);
+	EXPECT_EQ(cache->get_num_hits(), 2);
+	expect_same_predictions(second, reference);
+}
+
+TEST_F(PipelineCacheTest, fused_apply)
+{
+	auto pipeline = make_pipeline();
+	pipeline->train(features);
+
+	// applying the stages one after the other
+	std::shared_ptr<Features> transformed = features;
+	for (auto name : {"PruneVarSubMean", "NormOne"})
+	{
+		transformed =
+		    pipeline->get_transformer(name)->transform(transformed, false);
+	}
+	auto expected = pipeline->get_machine()
+	                    ->apply_regression(transformed)
+	                    ->get_labels();
+
+	auto result = pipeline->apply_regression(features)->get_labels();
+	ASSERT_EQ(result.vlen, expected.vlen);
+	for (index_t i = 0; i < result.vlen; i++)
+		EXPECT_NEAR(result[i], expected[i], 1e-12);
+
+	EXPECT_EQ(features->get_num_features(), 3);
 }
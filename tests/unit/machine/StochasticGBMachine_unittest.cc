@@ -177,3 +177,56 @@ TEST_F(StochasticGBMachineTest, sinusoid_curve_fitting_subset_fraction)
 	EXPECT_NEAR(ret[8], -0.4408978052, epsilon);
 	EXPECT_NEAR(ret[9], 0.5380825978, epsilon);
 }
+
+TEST_F(StochasticGBMachineTest, second_order_sinusoid_curve_fitting)
+{
+	SGVector<bool> ft(1);
+	ft[0] = false;
+	auto tree = std::make_shared<CARTree>(ft, PT_REGRESSION);
+	tree->set_max_depth(2);
+	tree->set_num_bins(32);
+	auto sq = std::make_shared<SquaredLoss>();
+
+	auto sgbm = std::make_shared<StochasticGBMachine>(tree, sq, 100, 0.1, 1.0);
+	sgbm->set_second_order(true);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	EXPECT_EQ(sgbm->get_num_weak_learners(), 100);
+
+	auto ret_labels = sgbm->apply_regression(test_feats);
+	auto mse = std::make_shared<MeanSquaredError>();
+	EXPECT_LT(mse->evaluate(ret_labels, test_labels), 0.05);
+}
+
+TEST_F(StochasticGBMachineTest, early_stopping_keeps_best_iteration)
+{
+	SGVector<bool> ft(1);
+	ft[0] = false;
+	auto tree = std::make_shared<CARTree>(ft, PT_REGRESSION);
+	tree->set_max_depth(2);
+	auto sq = std::make_shared<SquaredLoss>();
+
+	// a large learning rate overfits the small validation set quickly
+	auto sgbm = std::make_shared<StochasticGBMachine>(tree, sq, 500, 0.5, 1.0);
+	sgbm->set_second_order(true);
+	sgbm->set_validation_data(test_feats, test_labels);
+	sgbm->set_early_stopping_rounds(5);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+
+	const int32_t num_learners = sgbm->get_num_weak_learners();
+	EXPECT_GT(num_learners, 0);
+	EXPECT_LT(num_learners, 500);
+
+	auto full = std::make_shared<StochasticGBMachine>(tree, sq, num_learners + 5, 0.5, 1.0);
+	full->set_second_order(true);
+	full->set_labels(train_labels);
+	full->train(train_feats);
+
+	// the kept ensemble is at least as good on the validation data as the
+	// one trained for the rounds after it
+	auto mse = std::make_shared<MeanSquaredError>();
+	EXPECT_LE(
+	    mse->evaluate(sgbm->apply_regression(test_feats), test_labels),
+	    mse->evaluate(full->apply_regression(test_feats), test_labels) + epsilon);
+}
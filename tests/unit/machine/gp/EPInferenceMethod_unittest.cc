@@ -381,3 +381,69 @@ TEST(EPInferenceMethod, get_posterior_covariance_probit_likelihood)
 	EXPECT_NEAR(Sigma(4,3), 0.00151934275843193, 1E-3);
 	EXPECT_NEAR(Sigma(4,4), 1.26206797645117108, 1E-3);
 }
+
+TEST(EPInferenceMethod, parallel_updates_probit_likelihood)
+{
+	// create some easy random classification data
+	index_t n=5;
+
+	SGMatrix<float64_t> feat_train(2, n);
+	SGVector<float64_t> lab_train(n);
+
+	feat_train(0,0)=-1.07932;
+	feat_train(0,1)=1.15768;
+	feat_train(0,2)=3.26631;
+	feat_train(0,3)=1.79009;
+	feat_train(0,4)=-3.66051;
+
+	feat_train(1,0)=-1.83544;
+	feat_train(1,1)=2.91702;
+	feat_train(1,2)=-3.85663;
+	feat_train(1,3)=0.11949;
+	feat_train(1,4)=1.75159;
+
+	lab_train[0]=-1.0;
+	lab_train[1]=1.0;
+	lab_train[2]=1.0;
+	lab_train[3]=1.0;
+	lab_train[4]=-1.0;
+
+	// shogun representation of features and labels
+	auto features_train=std::make_shared<DenseFeatures<float64_t>>(feat_train);
+	auto labels_train=std::make_shared<BinaryLabels>(lab_train);
+
+	auto kernel=std::make_shared<GaussianKernel>(10, 8.0);
+	auto mean=std::make_shared<ZeroMean>();
+	auto likelihood=std::make_shared<ProbitLikelihood>();
+
+	// sequential and damped parallel updates have the same fixed point
+	auto inf=std::make_shared<EPInferenceMethod>(kernel,
+		features_train,	mean, labels_train, likelihood);
+	inf->set_scale(1.5);
+	inf->set_tolerance(1e-12);
+	inf->set_max_sweep(200);
+
+	auto inf_parallel=std::make_shared<EPInferenceMethod>(kernel,
+		features_train,	mean, labels_train, likelihood);
+	inf_parallel->set_scale(1.5);
+	inf_parallel->set_tolerance(1e-12);
+	inf_parallel->set_max_sweep(200);
+	inf_parallel->set_parallel_updates(true);
+	inf_parallel->set_damping(0.8);
+
+	EXPECT_NEAR(inf_parallel->get_negative_log_marginal_likelihood(),
+		inf->get_negative_log_marginal_likelihood(), 1E-8);
+
+	SGVector<float64_t> mu=inf->get_posterior_mean();
+	SGVector<float64_t> mu_parallel=inf_parallel->get_posterior_mean();
+	SGMatrix<float64_t> Sigma=inf->get_posterior_covariance();
+	SGMatrix<float64_t> Sigma_parallel=inf_parallel->get_posterior_covariance();
+	for (index_t i=0; i<n; i++)
+	{
+		EXPECT_NEAR(mu_parallel[i], mu[i], 1E-6);
+		for (index_t j=0; j<n; j++)
+			EXPECT_NEAR(Sigma_parallel(i,j), Sigma(i,j), 1E-6);
+	}
+
+	EXPECT_THROW(inf_parallel->set_damping(0), ShogunException);
+}
@@ -35,6 +35,7 @@
 
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianARDKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/machine/gp/ExactInferenceMethod.h>
 #include <shogun/machine/gp/ZeroMean.h>
@@ -472,3 +473,151 @@ TEST(ExactInferenceMethod,get_posterior_mean2)
 	abs_tolerance = Math::get_abs_tolerance(-0.9860387397670280495987072, rel_tolerance);
 	EXPECT_NEAR(mu[4],  -0.9860387397670280495987072,  abs_tolerance);
 }
+
+TEST(ExactInferenceMethod,add_and_remove_observations)
+{
+	index_t n=10;
+	SGMatrix<float64_t> X(1, n);
+	SGVector<float64_t> Y(n);
+	for (index_t i=0; i<n; ++i)
+	{
+		X[i]=0.7*i-3.0;
+		Y[i]=std::sin(X[i]);
+	}
+
+	auto lik=std::make_shared<GaussianLikelihood>();
+	lik->set_sigma(0.25);
+	auto make_inference=[&](SGVector<index_t> idx)
+	{
+		SGMatrix<float64_t> X_sub(1, idx.vlen);
+		SGVector<float64_t> Y_sub(idx.vlen);
+		for (index_t i=0; i<idx.vlen; ++i)
+		{
+			X_sub[i]=X[idx[i]];
+			Y_sub[i]=Y[idx[i]];
+		}
+		auto inf=std::make_shared<ExactInferenceMethod>(
+			std::make_shared<GaussianKernel>(10, 2.0),
+			std::make_shared<DenseFeatures<float64_t>>(X_sub),
+			std::make_shared<ZeroMean>(),
+			std::make_shared<RegressionLabels>(Y_sub), lik);
+		inf->set_scale(1.5);
+		return inf;
+	};
+	auto expect_same=[](std::shared_ptr<ExactInferenceMethod> updated,
+		std::shared_ptr<ExactInferenceMethod> expected)
+	{
+		SGMatrix<float64_t> L=updated->get_cholesky();
+		SGMatrix<float64_t> L_expected=expected->get_cholesky();
+		ASSERT_EQ(L.num_rows, L_expected.num_rows);
+		for (index_t i=0; i<L.num_rows*L.num_cols; ++i)
+			EXPECT_NEAR(L[i], L_expected[i], 1E-10);
+
+		SGVector<float64_t> alpha=updated->get_alpha();
+		SGVector<float64_t> alpha_expected=expected->get_alpha();
+		for (index_t i=0; i<alpha.vlen; ++i)
+			EXPECT_NEAR(alpha[i], alpha_expected[i], 1E-8);
+
+		EXPECT_NEAR(updated->get_negative_log_marginal_likelihood(),
+			expected->get_negative_log_marginal_likelihood(), 1E-10);
+	};
+
+	SGVector<index_t> first(6), all(n);
+	first.range_fill();
+	all.range_fill();
+	auto inf=make_inference(first);
+	inf->get_cholesky();
+
+	// a block of new observations
+	SGMatrix<float64_t> X_new(1, n-6);
+	SGVector<float64_t> Y_new(n-6);
+	for (index_t i=0; i<n-6; ++i)
+	{
+		X_new[i]=X[6+i];
+		Y_new[i]=Y[6+i];
+	}
+	inf->add_observations(std::make_shared<DenseFeatures<float64_t>>(X_new),
+		std::make_shared<RegressionLabels>(Y_new));
+	expect_same(inf, make_inference(all));
+
+	SGVector<index_t> removed(3);
+	removed[0]=7;
+	removed[1]=0;
+	removed[2]=4;
+	inf->remove_observations(removed);
+
+	SGVector<index_t> kept(7);
+	kept[0]=1;
+	kept[1]=2;
+	kept[2]=3;
+	kept[3]=5;
+	kept[4]=6;
+	kept[5]=8;
+	kept[6]=9;
+	expect_same(inf, make_inference(kept));
+}
+
+TEST(ExactInferenceMethod,get_negative_log_marginal_likelihood_derivatives_ard)
+{
+	index_t n=30;
+	index_t dim=4;
+	SGMatrix<float64_t> X(dim, n);
+	SGVector<float64_t> Y(n);
+	for (index_t i=0; i<n; ++i)
+	{
+		for (index_t d=0; d<dim; ++d)
+			X(d, i)=std::sin(0.37*i*(d+1)+d);
+		Y[i]=std::sin(2*X(0, i))+0.1*X(2, i);
+	}
+
+	SGVector<float64_t> weights(dim);
+	for (index_t d=0; d<dim; ++d)
+		weights[d]=0.5+0.3*d;
+
+	auto make_inference=[&](SGVector<float64_t> w)
+	{
+		auto kernel=std::make_shared<GaussianARDKernel>(10);
+		kernel->set_vector_weights(w);
+		auto inf=std::make_shared<ExactInferenceMethod>(kernel,
+			std::make_shared<DenseFeatures<float64_t>>(X),
+			std::make_shared<ZeroMean>(),
+			std::make_shared<RegressionLabels>(Y),
+			std::make_shared<GaussianLikelihood>(0.3));
+		inf->set_scale(1.2);
+		return inf;
+	};
+
+	// value, gradient and posterior share the factorizations of the same
+	// hyperparameters
+	auto inf=make_inference(weights);
+	float64_t nlZ=inf->get_negative_log_marginal_likelihood();
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> parameter_dictionary;
+	inf->build_gradient_parameter_dictionary(parameter_dictionary);
+	auto gradient=
+		inf->get_negative_log_marginal_likelihood_derivatives(parameter_dictionary);
+	EXPECT_EQ(inf->get_negative_log_marginal_likelihood(), nlZ);
+
+	// all elements of the weights against central differences
+	SGVector<float64_t> dnlZ=gradient["log_weights"];
+	ASSERT_EQ(dnlZ.vlen, dim);
+	const float64_t eps=1e-5;
+	for (index_t d=0; d<dim; ++d)
+	{
+		SGVector<float64_t> w_plus=weights.clone();
+		SGVector<float64_t> w_minus=weights.clone();
+		w_plus[d]*=std::exp(eps);
+		w_minus[d]*=std::exp(-eps);
+		float64_t diff=
+			(make_inference(w_plus)->get_negative_log_marginal_likelihood()-
+			 make_inference(w_minus)->get_negative_log_marginal_likelihood())/
+			(2*eps);
+		EXPECT_NEAR(dnlZ[d], diff, 1E-6);
+	}
+
+	// the posterior covariance is computed after the gradients
+	SGMatrix<float64_t> Sigma=inf->get_posterior_covariance();
+	SGMatrix<float64_t> Sigma_expected=
+		make_inference(weights)->get_posterior_covariance();
+	for (index_t i=0; i<Sigma.num_rows*Sigma.num_cols; ++i)
+		EXPECT_NEAR(Sigma[i], Sigma_expected[i], 1E-12);
+}
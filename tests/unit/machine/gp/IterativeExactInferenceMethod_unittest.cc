@@ -0,0 +1,128 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/gp/IterativeExactInferenceMethod.h>
+#include <shogun/machine/gp/ZeroMean.h>
+#include <shogun/regression/GaussianProcessRegression.h>
+
+using namespace shogun;
+
+class IterativeExactInferenceMethod_test : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// 1d sine wave, dense enough for the kernel matrix to be
+		// ill-conditioned without a preconditioner
+		const index_t n=40;
+		SGMatrix<float64_t> X(1, n);
+		SGVector<float64_t> Y(n);
+		for (index_t i=0; i<n; ++i)
+		{
+			X[i]=0.3*i-6.0;
+			Y[i]=std::sin(X[i]);
+		}
+		features=std::make_shared<DenseFeatures<float64_t>>(X);
+		labels=std::make_shared<RegressionLabels>(Y);
+
+		exact=std::make_shared<ExactInferenceMethod>(
+			std::make_shared<GaussianKernel>(10, 2.0), features,
+			std::make_shared<ZeroMean>(), labels,
+			std::make_shared<GaussianLikelihood>(0.25));
+		exact->set_scale(1.5);
+
+		iterative=std::make_shared<IterativeExactInferenceMethod>(
+			std::make_shared<GaussianKernel>(10, 2.0), features,
+			std::make_shared<ZeroMean>(), labels,
+			std::make_shared<GaussianLikelihood>(0.25));
+		iterative->set_scale(1.5);
+		iterative->put("seed", 7);
+		iterative->set_preconditioner_rank(20);
+		iterative->set_num_lanczos_steps(30);
+		iterative->set_tolerance(1E-12);
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<RegressionLabels> labels;
+	std::shared_ptr<ExactInferenceMethod> exact;
+	std::shared_ptr<IterativeExactInferenceMethod> iterative;
+};
+
+TEST_F(IterativeExactInferenceMethod_test, alpha_and_posterior_mean)
+{
+	SGVector<float64_t> alpha=iterative->get_alpha();
+	SGVector<float64_t> alpha_exact=exact->get_alpha();
+	ASSERT_EQ(alpha.vlen, alpha_exact.vlen);
+	for (index_t i=0; i<alpha.vlen; ++i)
+		EXPECT_NEAR(alpha[i], alpha_exact[i], 1E-6);
+
+	SGVector<float64_t> mu=iterative->get_posterior_mean();
+	SGVector<float64_t> mu_exact=exact->get_posterior_mean();
+	for (index_t i=0; i<mu.vlen; ++i)
+		EXPECT_NEAR(mu[i], mu_exact[i], 1E-6);
+}
+
+TEST_F(IterativeExactInferenceMethod_test, negative_log_marginal_likelihood)
+{
+	iterative->set_num_probe_vectors(10);
+	EXPECT_NEAR(iterative->get_negative_log_marginal_likelihood(),
+		exact->get_negative_log_marginal_likelihood(), 0.05);
+}
+
+TEST_F(IterativeExactInferenceMethod_test, derivatives)
+{
+	// the trace estimates have a standard deviation of about 0.5 with
+	// 200 probe vectors
+	iterative->set_num_probe_vectors(200);
+
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> dict;
+	iterative->build_gradient_parameter_dictionary(dict);
+	auto gradient=iterative->get_negative_log_marginal_likelihood_derivatives(dict);
+
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>>
+		dict_exact;
+	exact->build_gradient_parameter_dictionary(dict_exact);
+	auto gradient_exact=
+		exact->get_negative_log_marginal_likelihood_derivatives(dict_exact);
+
+	EXPECT_NEAR(gradient["log_sigma"][0], gradient_exact["log_sigma"][0], 2.5);
+	EXPECT_NEAR(gradient["log_scale"][0], gradient_exact["log_scale"][0], 2.5);
+	EXPECT_NEAR(gradient["width"][0], gradient_exact["width"][0],
+		0.1*std::abs(gradient_exact["width"][0])+1.0);
+}
+
+TEST_F(IterativeExactInferenceMethod_test, regression_predictions)
+{
+	const index_t m=5;
+	SGMatrix<float64_t> X_test(1, m);
+	for (index_t i=0; i<m; ++i)
+		X_test[i]=2.3*i-5.1;
+	auto features_test=std::make_shared<DenseFeatures<float64_t>>(X_test);
+
+	auto gpr=std::make_shared<GaussianProcessRegression>(iterative);
+	gpr->train();
+	SGVector<float64_t> mean=gpr->get_mean_vector(features_test);
+	SGVector<float64_t> variance=gpr->get_variance_vector(features_test);
+
+	auto gpr_exact=std::make_shared<GaussianProcessRegression>(exact);
+	gpr_exact->train();
+	SGVector<float64_t> mean_exact=gpr_exact->get_mean_vector(features_test);
+	SGVector<float64_t> variance_exact=
+		gpr_exact->get_variance_vector(features_test);
+
+	for (index_t i=0; i<m; ++i)
+	{
+		EXPECT_NEAR(mean[i], mean_exact[i], 1E-6);
+		EXPECT_NEAR(variance[i], variance_exact[i], 1E-6);
+	}
+}
@@ -0,0 +1,90 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/classifier/GaussianProcessClassification.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/machine/gp/LogitVGLikelihood.h>
+#include <shogun/machine/gp/SVGPInferenceMethod.h>
+#include <shogun/machine/gp/ZeroMean.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+TEST(SVGPInferenceMethod, binary_classification)
+{
+	// y=sign(sin(2x)) on [-3, 3], with inducing features on a grid
+	const index_t n = 600;
+	const index_t m = 15;
+	SGMatrix<float64_t> feat_train(1, n);
+	SGVector<float64_t> lab_train(n);
+	for (auto i : range(n))
+	{
+		feat_train(0, i) = -3.0 + 6.0 * i / (n - 1);
+		lab_train[i] = std::sin(2 * feat_train(0, i)) > 0 ? 1 : -1;
+	}
+	SGMatrix<float64_t> feat_inducing(1, m);
+	for (auto i : range(m))
+		feat_inducing(0, i) = -3.0 + 6.0 * i / (m - 1);
+
+	auto features_train = std::make_shared<DenseFeatures<float64_t>>(feat_train);
+	auto inducing_features =
+	    std::make_shared<DenseFeatures<float64_t>>(feat_inducing);
+	auto labels_train = std::make_shared<BinaryLabels>(lab_train);
+
+	auto kernel = std::make_shared<GaussianKernel>(10, 0.5);
+	auto mean = std::make_shared<ZeroMean>();
+	auto lik = std::make_shared<LogitVGLikelihood>();
+	auto inf = std::make_shared<SVGPInferenceMethod>(
+	    kernel, features_train, mean, labels_train, lik, inducing_features);
+	inf->put("seed", 7);
+	inf->set_scale(2.0);
+	inf->set_minibatch_size(64);
+
+	auto gpc = std::make_shared<GaussianProcessClassification>(inf);
+	gpc->train();
+	const float64_t nlml = inf->get_negative_log_marginal_likelihood();
+	EXPECT_TRUE(std::isfinite(nlml));
+	// the prior predicts 1/2 everywhere, its expected log likelihood is
+	// below -n*log(2)
+	EXPECT_LT(nlml, n * std::log(2.0));
+
+	auto L = inf->get_variational_cholesky();
+	EXPECT_EQ(L.num_rows, m);
+	EXPECT_EQ(L.num_cols, m);
+	for (auto j : range(m))
+	{
+		EXPECT_NE(L(j, j), 0);
+		for (auto i : range(j))
+			EXPECT_EQ(L(i, j), 0);
+	}
+
+	auto pred = gpc->apply_binary(features_train);
+	auto probs = gpc->get_probabilities(features_train);
+	index_t num_correct = 0;
+	for (auto i : range(n))
+	{
+		num_correct += pred->get_label(i) == lab_train[i];
+		EXPECT_GE(probs[i], 0);
+		EXPECT_LE(probs[i], 1);
+	}
+	EXPECT_GT(num_correct, 0.9 * n);
+
+	// the posterior means at the training features are computed minibatch
+	// by minibatch, their signs agree with the predictions
+	auto post_mean = inf->get_posterior_mean();
+	ASSERT_EQ(post_mean.vlen, n);
+	for (auto i : range(n))
+		EXPECT_EQ(post_mean[i] > 0 ? 1.0 : -1.0, pred->get_label(i));
+}
+
+TEST(SVGPInferenceMethod, set_minibatch_size)
+{
+	auto inf = std::make_shared<SVGPInferenceMethod>();
+	EXPECT_THROW(inf->set_minibatch_size(0), ShogunException);
+}
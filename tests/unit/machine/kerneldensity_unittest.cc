@@ -197,3 +197,73 @@ TEST(KernelDensity,dual_tree_single_tree_equivalence)
 	for (int32_t i=0;i<res_dual.vlen;i++)
 		EXPECT_NEAR(res_dual[i],res_single[i],1e-8);
 }
+
+TEST(KernelDensity,dual_tree_compact_kernels)
+{
+	std::mt19937_64 prng(3);
+
+	SGMatrix<float64_t> data(3,300);
+	random::fill_array(data, 0.0, 4.0, prng);
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGMatrix<float64_t> test(3,200);
+	random::fill_array(test, 0.0, 4.0, prng);
+	auto testfeats=std::make_shared<DenseFeatures<float64_t>>(test);
+
+	for (auto kernel : {K_GAUSSIAN, K_EXPONENTIAL, K_EPANECHNIKOV, K_TOPHAT})
+	{
+		const float64_t h=0.8;
+		const float64_t log_norm=KernelDensity::log_norm(kernel,h,3);
+
+		for (auto eval : {EM_KDTREE_DUAL, EM_BALLTREE_DUAL})
+		{
+			auto k=std::make_shared<KernelDensity>(h, kernel, D_EUCLIDEAN, eval, 4);
+			k->train(feats);
+			SGVector<float64_t> res=k->get_log_density(testfeats,3);
+
+			for (int32_t i=0;i<test.num_cols;i++)
+			{
+				float64_t density=0;
+				for (int32_t j=0;j<data.num_cols;j++)
+				{
+					float64_t dist=0;
+					for (int32_t d=0;d<3;d++)
+						dist+=(test(d,i)-data(d,j))*(test(d,i)-data(d,j));
+					density+=std::exp(KernelDensity::log_kernel(kernel,std::sqrt(dist),h));
+				}
+				density*=std::exp(log_norm)/data.num_cols;
+
+				EXPECT_NEAR(std::exp(res[i]),density,1e-10);
+			}
+		}
+	}
+}
+
+TEST(KernelDensity,dual_tree_tolerance)
+{
+	std::mt19937_64 prng(5);
+
+	SGMatrix<float64_t> data(2,500);
+	random::fill_array(data, 0.0, 1.0, prng);
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGMatrix<float64_t> test(2,300);
+	random::fill_array(test, 0.0, 1.0, prng);
+	auto testfeats=std::make_shared<DenseFeatures<float64_t>>(test);
+
+	auto exact=std::make_shared<KernelDensity>(0.2, K_GAUSSIAN, D_EUCLIDEAN, EM_BALLTREE_DUAL, 4);
+	exact->train(feats);
+	SGVector<float64_t> res_exact=exact->get_log_density(testfeats,4);
+
+	const float64_t atol=1e-3;
+	const float64_t rtol=1e-2;
+	auto approx=std::make_shared<KernelDensity>(0.2, K_GAUSSIAN, D_EUCLIDEAN, EM_BALLTREE_DUAL, 4, atol, rtol);
+	approx->train(feats);
+	SGVector<float64_t> res_approx=approx->get_log_density(testfeats,4);
+
+	for (int32_t i=0;i<test.num_cols;i++)
+	{
+		const float64_t density=std::exp(res_exact[i]);
+		EXPECT_LE(std::abs(std::exp(res_approx[i])-density),atol+rtol*density);
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/Philox.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <vector>
+
+using namespace shogun;
+
+TEST(Philox4x32, known_answers)
+{
+	// test vectors of the Random123 reference implementation
+	using block_t = std::array<uint32_t, 4>;
+	EXPECT_EQ(
+	    Philox4x32::encrypt({0, 0, 0, 0}, {0, 0}),
+	    (block_t{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+	EXPECT_EQ(
+	    Philox4x32::encrypt(
+	        {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+	        {0xffffffff, 0xffffffff}),
+	    (block_t{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+	EXPECT_EQ(
+	    Philox4x32::encrypt(
+	        {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+	        {0xa4093822, 0x299f31d0}),
+	    (block_t{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(Philox4x32, discard_and_generate)
+{
+	Philox4x32 prng(42, 3);
+	std::vector<uint64_t> expected(25);
+	for (auto& v : expected)
+		v = prng();
+
+	for (uint64_t skip : {0, 1, 2, 5, 12})
+	{
+		Philox4x32 skipped(42, 3);
+		skipped.discard(skip);
+		EXPECT_EQ(skipped(), expected[skip]);
+	}
+
+	Philox4x32 bulk(42, 3);
+	std::vector<uint64_t> values(25);
+	bulk();
+	bulk.generate(values.data() + 1, values.data() + 24);
+	values[0] = expected[0];
+	values[24] = bulk();
+	EXPECT_EQ(values, expected);
+
+	// different streams of the same key differ
+	EXPECT_NE(Philox4x32(42, 3)(), Philox4x32(42, 4)());
+}
+
+TEST(Philox4x32, parallel_fill_array_is_thread_independent)
+{
+	const auto num_threads = env()->get_num_threads();
+	const random::RandomStreams streams(2024);
+	NormalDistribution<float64_t> normal(1.0, 2.0);
+
+	std::vector<float64_t> single(20000);
+	env()->set_num_threads(1);
+	random::parallel_fill_array(single, normal, streams);
+
+	std::vector<float64_t> multi(20000);
+	env()->set_num_threads(4);
+	random::parallel_fill_array(multi, normal, streams);
+	env()->set_num_threads(num_threads);
+
+	EXPECT_EQ(single, multi);
+
+	float64_t mean = 0;
+	for (auto v : single)
+		mean += v;
+	mean /= single.size();
+	EXPECT_NEAR(mean, 1.0, 0.1);
+}
@@ -0,0 +1,82 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/base/range.h>
+#include <shogun/mathematics/SparseAssignment.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+TEST(SparseAssignment, brute_force)
+{
+	std::mt19937_64 prng(3);
+	for (auto trial : range(200))
+	{
+		const index_t num_rows = 1 + prng() % 6;
+		const index_t num_cols = 1 + prng() % 6;
+		std::vector<std::vector<int64_t>> weights(
+			num_rows, std::vector<int64_t>(num_cols, 0));
+
+		SparseAssignment assignment(num_rows, num_cols);
+		for (auto i : range(num_rows))
+		{
+			for (auto j : range(num_cols))
+			{
+				if (prng() % 2)
+				{
+					weights[i][j] = 1 + prng() % 5;
+					assignment.add_edge(i, j, weights[i][j]);
+				}
+			}
+		}
+		auto result = assignment.solve();
+
+		// best over all permutations of the padded columns
+		std::vector<index_t> perm(std::max(num_rows, num_cols));
+		std::iota(perm.begin(), perm.end(), 0);
+		int64_t best = 0;
+		do
+		{
+			int64_t sum = 0;
+			for (auto i : range(num_rows))
+				sum += perm[i] < num_cols ? weights[i][perm[i]] : 0;
+			best = std::max(best, sum);
+		} while (std::next_permutation(perm.begin(), perm.end()));
+
+		int64_t sum = 0;
+		std::vector<bool> used(num_cols, false);
+		for (auto i : range(num_rows))
+		{
+			if (result[i] < 0)
+				continue;
+			EXPECT_FALSE(used[result[i]]) << "trial " << trial;
+			used[result[i]] = true;
+			sum += weights[i][result[i]];
+		}
+		EXPECT_EQ(sum, best) << "trial " << trial;
+		EXPECT_EQ(assignment.get_total_weight(), best) << "trial " << trial;
+	}
+}
+
+TEST(SparseAssignment, conflicting_rows)
+{
+	// both rows prefer column 0, the second has no alternative
+	SparseAssignment assignment(2, 2);
+	assignment.add_edge(0, 0, 5);
+	assignment.add_edge(0, 1, 4);
+	assignment.add_edge(1, 0, 3);
+
+	auto result = assignment.solve();
+	EXPECT_EQ(result[0], 1);
+	EXPECT_EQ(result[1], 0);
+	EXPECT_EQ(assignment.get_total_weight(), 7);
+}
@@ -384,6 +384,37 @@ TEST(Statistics, lnormal_cdf)
 
 }
 
+TEST(Statistics, bulk_functions)
+{
+	// chunks of the parallel evaluation and their tails
+	const index_t n=2500;
+	SGVector<float64_t> x(n), p(n), positive(n);
+	for (index_t i=0; i<n; i++)
+	{
+		x[i]=-40.0+80.0*i/n;
+		p[i]=(i+0.5)/n;
+		positive[i]=0.01+30.0*i/n;
+	}
+
+	auto lphi=Statistics::lnormal_cdf(x);
+	auto phi=Statistics::normal_cdf(x, 2.0);
+	auto quantiles=Statistics::inverse_normal_cdf(p, 1.0, 3.0);
+	auto chi2=Statistics::chi2_cdf(positive, 3.0);
+	auto lgam=Statistics::lgamma(positive);
+	ASSERT_EQ(lphi.vlen, n);
+	for (index_t i=0; i<n; i++)
+	{
+		const float64_t expected=Statistics::lnormal_cdf(x[i]);
+		EXPECT_NEAR(lphi[i], expected, 1e-15*std::max(1.0, std::abs(expected)));
+		EXPECT_EQ(phi[i], Statistics::normal_cdf(x[i], 2.0));
+		EXPECT_EQ(quantiles[i], Statistics::inverse_normal_cdf(p[i], 1.0, 3.0));
+		EXPECT_EQ(chi2[i], Statistics::chi2_cdf(positive[i], 3.0));
+		EXPECT_EQ(lgam[i], Statistics::lgamma(positive[i]));
+	}
+
+	EXPECT_EQ(Statistics::lnormal_cdf(SGVector<float64_t>(0)).vlen, 0);
+}
+
 TEST(Statistics, normal_cdf)
 {
 	// assert with value calculated via Octave normcdf() method
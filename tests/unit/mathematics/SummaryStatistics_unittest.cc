@@ -0,0 +1,116 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/SummaryStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+namespace
+{
+	SGMatrix<float64_t> generate_data(index_t num_features, index_t num_vectors)
+	{
+		// large offsets and some zeros, to test the stability and the
+		// sparse representation
+		std::mt19937_64 prng(13);
+		NormalDistribution<float64_t> normal;
+		SGMatrix<float64_t> data(num_features, num_vectors);
+		for (auto i : range(num_vectors))
+		{
+			for (auto j : range(num_features))
+			{
+				if ((i + j) % 3 == 0)
+					data(j, i) = 0;
+				else
+					data(j, i) = 1e6 * j + (j + 1) * normal(prng);
+			}
+		}
+		return data;
+	}
+
+	void expect_statistics(
+	    const SummaryStatistics& stats, const SGMatrix<float64_t>& data)
+	{
+		ASSERT_EQ(stats.get_num_features(), data.num_rows);
+		EXPECT_EQ(stats.get_num_vectors(), data.num_cols);
+
+		auto mean = stats.get_mean();
+		auto var = stats.get_variance();
+		auto var_unbiased = stats.get_variance(true);
+		auto std_dev = stats.get_std_dev();
+		auto min = stats.get_min();
+		auto max = stats.get_max();
+		for (auto j : range(data.num_rows))
+		{
+			float64_t sum = 0;
+			float64_t cur_min = data(j, 0);
+			float64_t cur_max = data(j, 0);
+			for (auto i : range(data.num_cols))
+			{
+				sum += data(j, i);
+				cur_min = std::min(cur_min, data(j, i));
+				cur_max = std::max(cur_max, data(j, i));
+			}
+			const float64_t expected_mean = sum / data.num_cols;
+
+			float64_t sq_sum = 0;
+			for (auto i : range(data.num_cols))
+				sq_sum += (data(j, i) - expected_mean) * (data(j, i) - expected_mean);
+
+			EXPECT_NEAR(mean[j], expected_mean, 1e-9 * (1 + std::abs(expected_mean)));
+			EXPECT_NEAR(var[j], sq_sum / data.num_cols, 1e-6 * (1 + var[j]));
+			EXPECT_NEAR(
+			    var_unbiased[j], sq_sum / (data.num_cols - 1),
+			    1e-6 * (1 + var_unbiased[j]));
+			EXPECT_NEAR(std_dev[j], std::sqrt(var[j]), 1e-12);
+			EXPECT_EQ(min[j], cur_min);
+			EXPECT_EQ(max[j], cur_max);
+		}
+	}
+} // namespace
+
+TEST(SummaryStatistics, compute_dense)
+{
+	auto data = generate_data(5, 1001);
+	expect_statistics(SummaryStatistics::compute(data), data);
+
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+	expect_statistics(SummaryStatistics::compute(feats), data);
+}
+
+TEST(SummaryStatistics, compute_sparse)
+{
+	auto data = generate_data(5, 1001);
+	auto feats = std::make_shared<SparseFeatures<float64_t>>(data);
+	expect_statistics(SummaryStatistics::compute(feats), data);
+}
+
+TEST(SummaryStatistics, merge)
+{
+	auto data = generate_data(4, 300);
+
+	// two shards, one dense and one sparse
+	SummaryStatistics first(data.num_rows), second(data.num_rows);
+	for (auto i : range(100))
+		first.add(data.get_column(i));
+	auto sparse = std::make_shared<SparseFeatures<float64_t>>(data);
+	for (auto i : range(100, data.num_cols))
+		second.add(sparse->get_sparse_feature_vector(i));
+
+	first.merge(second);
+	expect_statistics(first, data);
+
+	SummaryStatistics other(3);
+	EXPECT_THROW(first.merge(other), ShogunException);
+	EXPECT_THROW(other.add(data.get_column(0)), ShogunException);
+	EXPECT_THROW(SummaryStatistics(2).get_variance(), ShogunException);
+}
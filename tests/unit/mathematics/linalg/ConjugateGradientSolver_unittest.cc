@@ -13,6 +13,7 @@
 #include <shogun/features/SparseFeatures.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
 #include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 #include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
 
@@ -48,3 +49,83 @@ TEST(ConjugateGradientSolver, solve)
 
 
 }
+
+TEST(ConjugateGradientSolver, solve_block)
+{
+	const int32_t size=20;
+	const int32_t num_rhs=4;
+	SGMatrix<float64_t> m(size, size);
+	m.set_const(0.0);
+	for (index_t i=0; i<size; ++i)
+	{
+		m(i,i)=4.0+i;
+		if (i>0)
+		{
+			m(i,i-1)=-1.0;
+			m(i-1,i)=-1.0;
+		}
+	}
+
+	SparseFeatures<float64_t> feat(m);
+	SGSparseMatrix<float64_t> mat=feat.get_sparse_feature_matrix();
+	auto A=std::make_shared<SparseMatrixOperator<float64_t>>(mat);
+
+	SGMatrix<float64_t> B(size, num_rhs);
+	for (index_t i=0; i<size*num_rhs; ++i)
+		B[i]=std::sin(i);
+	// an already solved system
+	for (index_t i=0; i<size; ++i)
+		B(i, 2)=0.0;
+
+	ConjugateGradientSolver linear_solver;
+	linear_solver.set_relative_tolerence(1E-12);
+	linear_solver.set_absolute_tolerence(1E-12);
+	SGMatrix<float64_t> X=linear_solver.solve_block(A, B);
+	ASSERT_EQ(X.num_rows, size);
+	ASSERT_EQ(X.num_cols, num_rhs);
+
+	Map<MatrixXd> map_m(m.matrix, m.num_rows, m.num_cols);
+	Map<MatrixXd> map_B(B.matrix, B.num_rows, B.num_cols);
+	Map<MatrixXd> map_X(X.matrix, X.num_rows, X.num_cols);
+	EXPECT_NEAR((map_X-map_m.llt().solve(map_B)).norm(), 0.0, 1E-10);
+	EXPECT_EQ(map_X.col(2).norm(), 0.0);
+}
+
+TEST(ConjugateGradientSolver, solve_preconditioned)
+{
+	const int32_t size=20;
+	SGMatrix<float64_t> m(size, size);
+	m.set_const(0.0);
+	SGMatrix<float64_t> jacobi(size, size);
+	jacobi.set_const(0.0);
+	for (index_t i=0; i<size; ++i)
+	{
+		m(i,i)=std::pow(10.0, i%5);
+		if (i>0)
+		{
+			m(i,i-1)=-0.5;
+			m(i-1,i)=-0.5;
+		}
+		jacobi(i,i)=1.0/m(i,i);
+	}
+
+	SparseFeatures<float64_t> feat(m);
+	SGSparseMatrix<float64_t> mat=feat.get_sparse_feature_matrix();
+	auto A=std::make_shared<SparseMatrixOperator<float64_t>>(mat);
+
+	SGVector<float64_t> b(size);
+	for (index_t i=0; i<size; ++i)
+		b[i]=std::cos(i);
+
+	ConjugateGradientSolver linear_solver;
+	linear_solver.set_relative_tolerence(1E-12);
+	linear_solver.set_absolute_tolerence(1E-12);
+	linear_solver.set_preconditioner(
+		std::make_shared<DenseMatrixOperator<float64_t>>(jacobi));
+	SGVector<float64_t> x=linear_solver.solve(A, b);
+
+	Map<MatrixXd> map_m(m.matrix, m.num_rows, m.num_cols);
+	Map<VectorXd> map_b(b.vector, b.vlen);
+	Map<VectorXd> map_x(x.vector, x.vlen);
+	EXPECT_NEAR((map_x-map_m.llt().solve(map_b)).norm(), 0.0, 1E-8);
+}
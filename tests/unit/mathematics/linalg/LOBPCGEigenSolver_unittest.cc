@@ -0,0 +1,109 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/eigsolver/LOBPCGEigenSolver.h>
+#include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+#include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+	/** tridiagonal (-1, 2, -1), the Laplacian of a path with fixed ends */
+	std::shared_ptr<SparseMatrixOperator<float64_t>> path_laplacian(index_t size)
+	{
+		SGSparseMatrix<float64_t> sm(size, size);
+		for (index_t i=0; i<size; ++i)
+		{
+			const index_t first=i>0 ? i-1 : i;
+			const index_t last=i<size-1 ? i+1 : i;
+			SGSparseVector<float64_t> row(last-first+1);
+			for (index_t j=first; j<=last; ++j)
+			{
+				row.features[j-first].feat_index=j;
+				row.features[j-first].entry=i==j ? 2.0 : -1.0;
+			}
+			sm.sparse_matrix[i]=row;
+		}
+
+		return std::make_shared<SparseMatrixOperator<float64_t>>(sm);
+	}
+
+	/** j-th smallest eigenvalue of the path Laplacian, starting at 0 */
+	float64_t path_eigenvalue(index_t size, index_t j)
+	{
+		return 2.0-2.0*std::cos(Math::PI*(j+1)/(size+1));
+	}
+}
+
+TEST(LOBPCGEigenSolver, smallest_eigenpairs)
+{
+	const index_t size=200;
+	const index_t k=3;
+	auto op=path_laplacian(size);
+
+	auto solver=std::make_shared<LOBPCGEigenSolver>(op, k);
+	solver->put("seed", 3);
+	solver->set_block_size(6);
+	solver->compute();
+
+	SGVector<float64_t> eigenvalues=solver->get_eigenvalues();
+	SGMatrix<float64_t> eigenvectors=solver->get_eigenvectors();
+	ASSERT_EQ(eigenvalues.vlen, k);
+	ASSERT_EQ(eigenvectors.num_rows, size);
+	ASSERT_EQ(eigenvectors.num_cols, k);
+
+	for (index_t j=0; j<k; ++j)
+	{
+		EXPECT_NEAR(eigenvalues[j], path_eigenvalue(size, j), 1E-8);
+
+		SGVector<float64_t> v=eigenvectors.get_column(j);
+		SGVector<float64_t> Av=op->apply(v);
+		Map<VectorXd> v_eig(v.vector, v.vlen);
+		Map<VectorXd> Av_eig(Av.vector, Av.vlen);
+		EXPECT_NEAR(v_eig.norm(), 1.0, 1E-10);
+		EXPECT_NEAR((Av_eig-eigenvalues[j]*v_eig).norm(), 0.0, 1E-6);
+	}
+	EXPECT_NEAR(solver->get_min_eigenvalue(), path_eigenvalue(size, 0), 1E-8);
+}
+
+TEST(LOBPCGEigenSolver, largest_eigenpairs)
+{
+	const index_t size=10;
+	SGMatrix<float64_t> m(size, size);
+	m.zero();
+	for (index_t i=0; i<size; ++i)
+	{
+		m(i,i)=i+1.0;
+		if (i>0)
+		{
+			m(i,i-1)=0.5;
+			m(i-1,i)=0.5;
+		}
+	}
+	auto op=std::make_shared<DenseMatrixOperator<float64_t>>(m);
+
+	auto solver=std::make_shared<LOBPCGEigenSolver>(op, 2);
+	solver->put("seed", 3);
+	solver->set_largest(true);
+	solver->compute();
+
+	Map<MatrixXd> m_eig(m.matrix, m.num_rows, m.num_cols);
+	SelfAdjointEigenSolver<MatrixXd> es(m_eig);
+
+	SGVector<float64_t> eigenvalues=solver->get_eigenvalues();
+	EXPECT_NEAR(eigenvalues[0], es.eigenvalues()[size-1], 1E-8);
+	EXPECT_NEAR(eigenvalues[1], es.eigenvalues()[size-2], 1E-8);
+	EXPECT_NEAR(solver->get_max_eigenvalue(), es.eigenvalues()[size-1], 1E-8);
+}
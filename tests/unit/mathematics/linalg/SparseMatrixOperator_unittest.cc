@@ -112,6 +112,39 @@ TEST(SparseMatrixOperator, asymmetric_apply)
 #endif
 }
 
+TEST(SparseMatrixOperator, apply_block)
+{
+	const index_t size=5;
+	const index_t num_cols=3;
+
+	SGMatrix<float64_t> m(size, size);
+	m.set_const(0.0);
+	for (index_t i=0; i<size; ++i)
+	{
+		m(i,i)=i+1.0;
+		m(i,(i+2)%size)=-0.5*i;
+	}
+
+	SparseFeatures<float64_t> feat(m);
+	SGSparseMatrix<float64_t> mat=feat.get_sparse_feature_matrix();
+	SparseMatrixOperator<float64_t> op(mat);
+
+	SGMatrix<float64_t> B(size, num_cols);
+	for (index_t i=0; i<size*num_cols; ++i)
+		B[i]=0.1*i-1.0;
+
+	SGMatrix<float64_t> result=op.apply_block(B);
+	ASSERT_EQ(result.num_rows, size);
+	ASSERT_EQ(result.num_cols, num_cols);
+
+	for (index_t j=0; j<num_cols; ++j)
+	{
+		SGVector<float64_t> expected=op.apply(B.get_column(j));
+		for (index_t i=0; i<size; ++i)
+			EXPECT_NEAR(result(i,j), expected[i], 1E-15);
+	}
+}
+
 TEST(SparseMatrixOperator, get_set_diagonal_no_alloc)
 {
 	const index_t size=2;
@@ -2,6 +2,7 @@
 
 #include <shogun/base/range.h>
 #include <shogun/lib/config.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/exception/ShogunException.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
@@ -2523,6 +2524,70 @@ TYPED_TEST(LinalgBackendEigenNonIntegerTypesTest, SGMatrix_sqrt_in_place)
 		EXPECT_NEAR(result[i], std::sqrt(data[i]), get_epsilon<TypeParam>());
 }
 
+TYPED_TEST(LinalgBackendEigenNonIntegerTypesTest, SGMatrix_pairwise_distance)
+{
+	const index_t dim = 3;
+	SGMatrix<TypeParam> A(dim, 4);
+	SGMatrix<TypeParam> B(dim, 5);
+	for (index_t i = 0; i < A.size(); ++i)
+		A[i] = std::sin((TypeParam)i);
+	for (index_t i = 0; i < B.size(); ++i)
+		B[i] = std::cos((TypeParam)(2 * i));
+
+	auto euclidean = linalg::pairwise_distance(A, B, DistanceMetric::Euclidean);
+	auto squared =
+	    linalg::pairwise_distance(A, B, DistanceMetric::SquaredEuclidean);
+	auto cosine = linalg::pairwise_distance(A, B, DistanceMetric::Cosine);
+	auto manhattan = linalg::pairwise_distance(A, B, DistanceMetric::Manhattan);
+	ASSERT_EQ(euclidean.num_rows, A.num_cols);
+	ASSERT_EQ(euclidean.num_cols, B.num_cols);
+
+	for (index_t j = 0; j < B.num_cols; ++j)
+	{
+		for (index_t i = 0; i < A.num_cols; ++i)
+		{
+			TypeParam sq = 0, l1 = 0, ab = 0, aa = 0, bb = 0;
+			for (index_t d = 0; d < dim; ++d)
+			{
+				sq += std::pow(A(d, i) - B(d, j), 2);
+				l1 += std::abs(A(d, i) - B(d, j));
+				ab += A(d, i) * B(d, j);
+				aa += A(d, i) * A(d, i);
+				bb += B(d, j) * B(d, j);
+			}
+			const TypeParam eps = get_epsilon<TypeParam>() * 10;
+			EXPECT_NEAR(squared(i, j), sq, eps);
+			EXPECT_NEAR(euclidean(i, j), std::sqrt(sq), eps);
+			EXPECT_NEAR(manhattan(i, j), l1, eps);
+			EXPECT_NEAR(
+			    cosine(i, j),
+			    std::max(1 - ab / (std::sqrt(aa) * std::sqrt(bb)), (TypeParam)0),
+			    eps);
+		}
+	}
+}
+
+TYPED_TEST(LinalgBackendEigenNonIntegerTypesTest, SGMatrix_colwise_k_smallest)
+{
+	SGMatrix<TypeParam> A(5, 2);
+	TypeParam data[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3};
+	std::copy_n(data, A.size(), A.matrix);
+
+	auto result = linalg::colwise_k_smallest(A, 3);
+	ASSERT_EQ(result.num_rows, 3);
+	ASSERT_EQ(result.num_cols, 2);
+
+	// ties go to the smaller index
+	EXPECT_EQ(result(0, 0), 1);
+	EXPECT_EQ(result(1, 0), 3);
+	EXPECT_EQ(result(2, 0), 0);
+	EXPECT_EQ(result(0, 1), 1);
+	EXPECT_EQ(result(1, 1), 4);
+	EXPECT_EQ(result(2, 1), 3);
+
+	EXPECT_THROW(linalg::colwise_k_smallest(A, 6), ShogunException);
+}
+
 TYPED_TEST(LinalgBackendEigenNonIntegerTypesTest, SGMatrix_squared_error)
 {
 	SGMatrix<TypeParam> A(4, 3);
@@ -2543,3 +2608,160 @@ TYPED_TEST(LinalgBackendEigenNonIntegerTypesTest, SGMatrix_squared_error)
 	auto result = linalg::squared_error(A, B);
 	EXPECT_NEAR(ref, result, get_epsilon<TypeParam>());
 }
+
+TEST(LinalgBackendEigen, SGVector_lazy_expression)
+{
+	const index_t len = 5;
+	SGVector<float64_t> a(len), b(len);
+	for (index_t i = 0; i < len; ++i)
+	{
+		a[i] = i + 1;
+		b[i] = 0.5 * i;
+	}
+
+	auto result = eval(2.0 * lazy(a) - lazy(a) * lazy(b) / 4.0 + 1.0);
+	for (index_t i = 0; i < len; ++i)
+		EXPECT_NEAR(result[i], 2 * a[i] - a[i] * b[i] / 4 + 1, 1e-15);
+
+	auto expr = exponent(lazy(b)) * lazy(a);
+	SGVector<float64_t> expected = element_prod(exponent(b), a);
+	EXPECT_NEAR(sum(expr), sum(expected), 1e-12);
+	EXPECT_NEAR(max(expr), max(expected), 1e-12);
+	EXPECT_NEAR(dot(lazy(a), sqrt(lazy(b))), dot(a, sqrt(b)), 1e-12);
+
+	// in place
+	eval(lazy(a) - lazy(b), a);
+	for (index_t i = 0; i < len; ++i)
+		EXPECT_NEAR(a[i], i + 1 - 0.5 * i, 1e-15);
+
+	SGVector<float64_t> c(len + 1);
+	EXPECT_THROW(lazy(a) + lazy(c), ShogunException);
+	EXPECT_THROW(eval(lazy(a), c), ShogunException);
+}
+
+TEST(LinalgBackendEigen, SGMatrix_lazy_expression)
+{
+	const index_t nrows = 3, ncols = 2;
+	SGMatrix<float64_t> A(nrows, ncols), B(nrows, ncols);
+	for (index_t i = 0; i < nrows * ncols; ++i)
+	{
+		A[i] = i;
+		B[i] = 0.1 * i;
+	}
+
+	auto result = eval(log(lazy(A) + 1.0) - lazy(B));
+	ASSERT_EQ(result.num_rows, nrows);
+	ASSERT_EQ(result.num_cols, ncols);
+	for (index_t i = 0; i < nrows * ncols; ++i)
+		EXPECT_NEAR(result[i], std::log(A[i] + 1) - B[i], 1e-15);
+
+	SGMatrix<float64_t> C(ncols, nrows);
+	EXPECT_THROW(lazy(A) * lazy(C), ShogunException);
+}
+
+TEST(LinalgBackendEigen, SGMatrixList_batch_cholesky)
+{
+	const index_t num_matrices = 5, size = 4, num_rhs = 2;
+	SGMatrixList<float64_t> A(num_matrices), B(num_matrices);
+	for (index_t k = 0; k < num_matrices; ++k)
+	{
+		SGMatrix<float64_t> m(size, size);
+		for (index_t i = 0; i < size; ++i)
+			for (index_t j = 0; j < size; ++j)
+				m(i, j) = i == j ? size + k : 1.0 / (1 + i + j);
+		A.set_matrix(k, m);
+
+		SGMatrix<float64_t> b(size, num_rhs);
+		for (index_t i = 0; i < size * num_rhs; ++i)
+			b[i] = k - 0.5 * i;
+		B.set_matrix(k, b);
+	}
+
+	auto L = batch_cholesky_factor(A);
+	auto U = batch_cholesky_factor(A, false);
+	auto X = batch_cholesky_solver(L, B);
+	auto X_upper = batch_cholesky_solver(U, B, false);
+	auto AX = batch_matrix_prod(A, X);
+	auto LLt = batch_matrix_prod(L, L, false, true);
+	ASSERT_EQ(L.num_matrices, num_matrices);
+	ASSERT_EQ(X.num_matrices, num_matrices);
+
+	for (index_t k = 0; k < num_matrices; ++k)
+	{
+		auto L_expected = cholesky_factor(A[k]);
+		auto U_expected = cholesky_factor(A[k], false);
+		for (index_t i = 0; i < size * size; ++i)
+		{
+			EXPECT_NEAR(L[k][i], L_expected[i], 1e-14);
+			EXPECT_NEAR(U[k][i], U_expected[i], 1e-14);
+			EXPECT_NEAR(LLt[k][i], A[k][i], 1e-13);
+		}
+		for (index_t i = 0; i < size * num_rhs; ++i)
+		{
+			EXPECT_NEAR(X_upper[k][i], X[k][i], 1e-13);
+			EXPECT_NEAR(AX[k][i], B[k][i], 1e-13);
+		}
+	}
+
+	A[2](0, 0) = -1.0;
+	EXPECT_THROW(batch_cholesky_factor(A), ShogunException);
+	EXPECT_THROW(batch_matrix_prod(B, A), ShogunException);
+}
+
+TEST(LinalgBackendEigen, SGMatrix_randomized_svd)
+{
+	const index_t m = 40, n = 30, rank = 4, k = 3;
+	std::mt19937_64 prng(11);
+	std::normal_distribution<float64_t> normal;
+
+	// low rank matrix with known singular values
+	MatrixXd L = MatrixXd::NullaryExpr(m, rank, [&]() { return normal(prng); });
+	MatrixXd R = MatrixXd::NullaryExpr(n, rank, [&]() { return normal(prng); });
+	HouseholderQR<MatrixXd> qr_L(L), qr_R(R);
+	MatrixXd Q_L = qr_L.householderQ() * MatrixXd::Identity(m, rank);
+	MatrixXd Q_R = qr_R.householderQ() * MatrixXd::Identity(n, rank);
+	VectorXd sigma(rank);
+	sigma << 10.0, 5.0, 2.0, 0.5;
+
+	SGMatrix<float64_t> A(m, n);
+	Map<MatrixXd> A_eig(A.matrix, m, n);
+	A_eig = Q_L * sigma.asDiagonal() * Q_R.transpose();
+
+	SGVector<float64_t> s;
+	SGMatrix<float64_t> U, V;
+	randomized_svd(A, k, s, U, V, prng);
+	ASSERT_EQ(s.vlen, k);
+	ASSERT_EQ(U.num_rows, m);
+	ASSERT_EQ(U.num_cols, k);
+	ASSERT_EQ(V.num_rows, n);
+	ASSERT_EQ(V.num_cols, k);
+
+	Map<MatrixXd> U_eig(U.matrix, m, k), V_eig(V.matrix, n, k);
+	for (index_t i = 0; i < k; ++i)
+	{
+		EXPECT_NEAR(s[i], sigma[i], 1e-10);
+		EXPECT_NEAR(std::abs(U_eig.col(i).dot(Q_L.col(i))), 1.0, 1e-10);
+		EXPECT_NEAR(std::abs(V_eig.col(i).dot(Q_R.col(i))), 1.0, 1e-10);
+	}
+
+	// the same matrix in sparse form, row i being sparse vector i
+	SGSparseMatrix<float64_t> A_sparse(n, m);
+	for (index_t i = 0; i < m; ++i)
+	{
+		SGSparseVector<float64_t> row(n);
+		for (index_t j = 0; j < n; ++j)
+		{
+			row.features[j].feat_index = j;
+			row.features[j].entry = A(i, j);
+		}
+		A_sparse.sparse_matrix[i] = row;
+	}
+
+	SGVector<float64_t> s_sparse;
+	SGMatrix<float64_t> U_sparse, V_sparse;
+	randomized_svd(A_sparse, k, s_sparse, U_sparse, V_sparse, prng, 5, 1);
+	for (index_t i = 0; i < k; ++i)
+		EXPECT_NEAR(s_sparse[i], sigma[i], 1e-10);
+
+	EXPECT_THROW(randomized_svd(A, n + 1, s, U, V, prng), ShogunException);
+}
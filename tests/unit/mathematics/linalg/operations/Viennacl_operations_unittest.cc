@@ -736,6 +736,42 @@ TEST(LinalgBackendViennaCL, SGMatrix_squared_error)
 	EXPECT_NEAR(ref, result, 1e-15);
 }
 
+TEST(LinalgBackendViennaCL, SGMatrix_pairwise_distance)
+{
+	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
+
+	SGMatrix<float64_t> A(3, 40), A_gpu;
+	SGMatrix<float64_t> B(3, 7), B_gpu;
+	for (index_t i = 0; i < A.size(); ++i)
+		A[i] = std::sin(i);
+	for (index_t i = 0; i < B.size(); ++i)
+		B[i] = std::cos(2 * i);
+
+	to_gpu(A, A_gpu);
+	to_gpu(B, B_gpu);
+
+	for (auto metric :
+	     {DistanceMetric::Euclidean, DistanceMetric::SquaredEuclidean,
+	      DistanceMetric::Cosine, DistanceMetric::Manhattan})
+	{
+		auto ref = linalg::pairwise_distance(A, B, metric);
+		auto result_gpu = linalg::pairwise_distance(A_gpu, B_gpu, metric);
+		SGMatrix<float64_t> result;
+		from_gpu(result_gpu, result);
+
+		for (index_t i = 0; i < ref.size(); ++i)
+			EXPECT_NEAR(result[i], ref[i], 1e-12);
+
+		auto ref_nn = linalg::colwise_k_smallest(ref, 5);
+		auto nn_gpu = linalg::colwise_k_smallest(result_gpu, 5);
+		SGMatrix<index_t> nn;
+		from_gpu(nn_gpu, nn);
+
+		for (index_t i = 0; i < ref_nn.size(); ++i)
+			EXPECT_EQ(nn[i], ref_nn[i]);
+	}
+}
+
 TEST(LinalgBackendViennaCL, SGVector_sum)
 {
 	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
@@ -866,4 +902,122 @@ TEST(LinalgBackendViennaCL, SGMatrix_rowwise_sum_no_diag)
 	EXPECT_NEAR(result[1], 6, 1E-15);
 }
 
+TEST(LinalgBackendViennaCL, SGMatrix_cholesky_factor)
+{
+	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
+
+	// larger than one block of the blocked factorization
+	const index_t n = 300;
+	SGMatrix<float32_t> M(n, n), A(n, n), A_gpu;
+	for (index_t i = 0; i < n * n; ++i)
+		M[i] = std::sin(float32_t(i));
+	A = matrix_prod(M, M, false, true);
+	for (index_t i = 0; i < n; ++i)
+		A(i, i) += n;
+
+	to_gpu(A, A_gpu);
+	for (bool lower : {true, false})
+	{
+		auto expected = cholesky_factor(A, lower);
+		auto result_gpu = cholesky_factor(A_gpu, lower);
+		SGMatrix<float32_t> result;
+		from_gpu(result_gpu, result);
+
+		ASSERT_EQ(result.num_rows, n);
+		ASSERT_EQ(result.num_cols, n);
+		for (index_t i = 0; i < n * n; ++i)
+			EXPECT_NEAR(expected[i], result[i], 1e-3);
+	}
+}
+
+TEST(LinalgBackendViennaCL, SGMatrix_cholesky_solver)
+{
+	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
+
+	const index_t n = 3;
+	SGMatrix<float32_t> A(n, n), A_gpu;
+	SGVector<float32_t> b(n), b_gpu;
+	A(0, 0) = 4; A(0, 1) = 2; A(0, 2) = 0.4;
+	A(1, 0) = 2; A(1, 1) = 5; A(1, 2) = 1;
+	A(2, 0) = 0.4; A(2, 1) = 1; A(2, 2) = 3;
+	b[0] = 1; b[1] = -2; b[2] = 0.5;
+
+	to_gpu(A, A_gpu);
+	to_gpu(b, b_gpu);
+	for (bool lower : {true, false})
+	{
+		auto expected = cholesky_solver(cholesky_factor(A, lower), b, lower);
+		auto L_gpu = cholesky_factor(A_gpu, lower);
+		auto result_gpu = cholesky_solver(L_gpu, b_gpu, lower);
+		SGVector<float32_t> result;
+		from_gpu(result_gpu, result);
+
+		for (index_t i = 0; i < n; ++i)
+			EXPECT_NEAR(expected[i], result[i], 1e-5);
+	}
+}
+
+TEST(LinalgBackendViennaCL, SGMatrix_triangular_solver)
+{
+	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
+
+	const index_t n = 3;
+	SGMatrix<float32_t> L(n, n), L_gpu;
+	SGMatrix<float32_t> B(n, 2), B_gpu;
+	L.zero();
+	L(0, 0) = 2; L(1, 0) = 1; L(1, 1) = 3; L(2, 0) = -1; L(2, 1) = 0.5;
+	L(2, 2) = 4;
+	for (index_t i = 0; i < B.size(); ++i)
+		B[i] = i + 1;
+
+	to_gpu(L, L_gpu);
+	to_gpu(B, B_gpu);
+	auto expected = triangular_solver(L, B, true);
+	auto result_gpu = triangular_solver(L_gpu, B_gpu, true);
+	SGMatrix<float32_t> result;
+	from_gpu(result_gpu, result);
+
+	for (index_t i = 0; i < B.size(); ++i)
+		EXPECT_NEAR(expected[i], result[i], 1e-5);
+}
+
+TEST(LinalgBackendViennaCL, SGMatrix_transpose_matrix)
+{
+	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
+
+	const index_t nrows = 2, ncols = 3;
+	SGMatrix<float32_t> A(nrows, ncols), A_gpu;
+	for (index_t i = 0; i < nrows * ncols; ++i)
+		A[i] = i;
+
+	to_gpu(A, A_gpu);
+	auto result_gpu = transpose_matrix(A_gpu);
+	SGMatrix<float32_t> result;
+	from_gpu(result_gpu, result);
+
+	ASSERT_EQ(result.num_rows, ncols);
+	ASSERT_EQ(result.num_cols, nrows);
+	for (index_t i = 0; i < nrows; ++i)
+		for (index_t j = 0; j < ncols; ++j)
+			EXPECT_NEAR(A(i, j), result(j, i), 1e-15);
+}
+
+TEST(LinalgBackendViennaCL, SGVector_exponent)
+{
+	env()->linalg()->set_gpu_backend(new LinalgBackendViennaCL());
+
+	const index_t len = 4;
+	SGVector<float32_t> a(len), a_gpu;
+	for (index_t i = 0; i < len; ++i)
+		a[i] = 0.5 * i;
+
+	to_gpu(a, a_gpu);
+	auto result_gpu = exponent(a_gpu);
+	SGVector<float32_t> result;
+	from_gpu(result_gpu, result);
+
+	for (index_t i = 0; i < len; ++i)
+		EXPECT_NEAR(std::exp(a[i]), result[i], 1e-5);
+}
+
 #endif // HAVE_VIENNACL
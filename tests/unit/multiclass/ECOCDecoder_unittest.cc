@@ -0,0 +1,185 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+
+#include <shogun/base/range.h>
+#include <shogun/lib/config.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/multiclass/ecoc/ECOCAEDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCEDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCHDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCIHDDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCLLBDecoder.h>
+#include <shogun/multiclass/ecoc/ECOCUtil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+
+using namespace shogun;
+using namespace Eigen;
+
+class ECOCDecoderTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		// codes longer than one word of bits, with zeros
+		const index_t num_machines = 70;
+		const index_t num_classes = 9;
+		const index_t num_vectors = 300;
+		std::mt19937_64 prng(5);
+		NormalDistribution<float64_t> normal;
+
+		codebook = SGMatrix<int32_t>(num_machines, num_classes);
+		for (auto j : range(num_classes))
+			for (auto i : range(num_machines))
+				codebook(i, j) = int32_t(prng() % 3) - 1;
+
+		outputs = SGMatrix<float64_t>(num_machines, num_vectors);
+		for (auto j : range(num_vectors))
+			for (auto i : range(num_machines))
+				outputs(i, j) = normal(prng);
+		outputs(0, 0) = 0;
+	}
+
+	/** every label has the smallest reference distance */
+	void check_labels(
+	    const SGVector<int32_t>& labels,
+	    std::function<float64_t(const SGVector<float64_t>&, const int32_t*)>
+	        distance)
+	{
+		ASSERT_EQ(labels.vlen, outputs.num_cols);
+		for (auto i : range(outputs.num_cols))
+		{
+			auto query = outputs.get_column(i);
+			float64_t best = std::numeric_limits<float64_t>::infinity();
+			for (auto j : range(codebook.num_cols))
+				best = std::min(
+				    best, distance(query, codebook.get_column_vector(j)));
+			EXPECT_NEAR(
+			    distance(query, codebook.get_column_vector(labels[i])), best,
+			    1e-9);
+		}
+	}
+
+	SGMatrix<int32_t> codebook;
+	SGMatrix<float64_t> outputs;
+};
+
+TEST_F(ECOCDecoderTest, hamming_distances)
+{
+	auto distances = ECOCUtil::hamming_distances(outputs, codebook);
+	ASSERT_EQ(distances.num_rows, codebook.num_cols);
+	ASSERT_EQ(distances.num_cols, outputs.num_cols);
+
+	SGVector<float64_t> query(outputs.num_rows);
+	for (auto i : range(outputs.num_cols))
+	{
+		for (auto k : range(outputs.num_rows))
+			query[k] = outputs(k, i) >= 0 ? 1 : -1;
+		for (auto j : range(codebook.num_cols))
+			EXPECT_EQ(
+			    distances(j, i),
+			    ECOCUtil::hamming_distance(
+			        query.vector, codebook.get_column_vector(j), query.vlen));
+	}
+}
+
+TEST_F(ECOCDecoderTest, batch_matches_single)
+{
+	ECOCHDDecoder hd;
+	ECOCLLBDecoder llb;
+	ECOCEDDecoder ed;
+	ECOCAEDDecoder aed;
+	for (ECOCDecoder* decoder :
+	     std::vector<ECOCDecoder*>{&hd, &llb, &ed, &aed})
+	{
+		auto labels = decoder->decide_labels(outputs, codebook);
+		for (auto i : range(outputs.num_cols))
+			EXPECT_EQ(
+			    labels[i],
+			    decoder->decide_label(outputs.get_column(i), codebook));
+	}
+}
+
+TEST_F(ECOCDecoderTest, HD)
+{
+	check_labels(
+	    ECOCHDDecoder().decide_labels(outputs, codebook),
+	    [](const SGVector<float64_t>& q, const int32_t* code) {
+		    float64_t dist = 0;
+		    for (auto k : range(q.vlen))
+			    dist += std::abs((q[k] >= 0 ? 1 : -1) - code[k]);
+		    return std::floor(dist / 2);
+	    });
+}
+
+TEST_F(ECOCDecoderTest, LLB)
+{
+	check_labels(
+	    ECOCLLBDecoder().decide_labels(outputs, codebook),
+	    [](const SGVector<float64_t>& q, const int32_t* code) {
+		    float64_t loss = 0;
+		    for (auto k : range(q.vlen))
+			    loss -= q[k] * code[k];
+		    return loss;
+	    });
+}
+
+TEST_F(ECOCDecoderTest, ED)
+{
+	check_labels(
+	    ECOCEDDecoder().decide_labels(outputs, codebook),
+	    [](const SGVector<float64_t>& q, const int32_t* code) {
+		    float64_t dist = 0;
+		    for (auto k : range(q.vlen))
+			    dist += (q[k] - code[k]) * (q[k] - code[k]);
+		    return std::sqrt(dist);
+	    });
+}
+
+TEST_F(ECOCDecoderTest, AED)
+{
+	check_labels(
+	    ECOCAEDDecoder().decide_labels(outputs, codebook),
+	    [](const SGVector<float64_t>& q, const int32_t* code) {
+		    float64_t dist = 0;
+		    for (auto k : range(q.vlen))
+			    dist += (q[k] - code[k]) * (q[k] - code[k]) * std::abs(code[k]);
+		    return std::sqrt(dist);
+	    });
+}
+
+#ifdef HAVE_LAPACK
+TEST_F(ECOCDecoderTest, IHD)
+{
+	const index_t num_classes = codebook.num_cols;
+	MatrixXd delta = MatrixXd::Zero(num_classes, num_classes);
+	for (auto i : range(num_classes))
+		for (auto j : range(num_classes))
+			if (i != j)
+				delta(i, j) = ECOCUtil::hamming_distance(
+				    codebook.get_column_vector(i),
+				    codebook.get_column_vector(j), codebook.num_rows);
+	const MatrixXd delta_inv = delta.inverse();
+
+	ECOCIHDDecoder decoder;
+	auto labels = decoder.decide_labels(outputs, codebook);
+	auto distances = ECOCUtil::hamming_distances(outputs, codebook);
+	for (auto i : range(outputs.num_cols))
+	{
+		const VectorXd scores =
+		    delta_inv *
+		    Map<VectorXd>(distances.get_column_vector(i), num_classes);
+		EXPECT_NEAR(scores[labels[i]], scores.maxCoeff(), 1e-9);
+		EXPECT_EQ(
+		    labels[i], decoder.decide_label(outputs.get_column(i), codebook));
+	}
+}
+#endif // HAVE_LAPACK
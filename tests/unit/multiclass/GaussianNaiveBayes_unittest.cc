@@ -0,0 +1,56 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/features/DataGenerator.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/multiclass/GaussianNaiveBayes.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(GaussianNaiveBayes, apply_matches_apply_one)
+{
+	const int32_t num = 700;
+	const int32_t dims = 3;
+	const int32_t classes = 3;
+	std::mt19937_64 prng(57);
+
+	// the vectors are offset so that the batched rates have to be accurate
+	// far from the origin, and span several blocks
+	auto feat = DataGenerator::generate_gaussians(num, classes, dims, prng);
+	for (auto& x : feat)
+		x += 1e4;
+	SGVector<float64_t> lab(classes * num);
+	for (auto i : range(classes))
+		for (auto j : range(num))
+			lab[i * num + j] = i;
+
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(feat);
+	auto gnb = std::make_shared<GaussianNaiveBayes>(features, labels);
+	gnb->train();
+
+	auto output = gnb->apply_multiclass(features);
+	int32_t num_correct = 0;
+	for (auto i : range(classes * num))
+	{
+		EXPECT_EQ(output->get_label(i), gnb->apply_one(i));
+		num_correct += output->get_label(i) == lab[i];
+
+		// the posteriors sum to one and are largest for the label
+		auto posterior = output->get_multiclass_confidences(i);
+		float64_t sum = 0;
+		for (auto p : posterior)
+		{
+			EXPECT_LE(p, posterior[output->get_int_label(i)]);
+			sum += p;
+		}
+		EXPECT_NEAR(sum, 1, 1e-12);
+	}
+	EXPECT_GT(num_correct, 0.9 * classes * num);
+}
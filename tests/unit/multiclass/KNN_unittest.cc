@@ -7,8 +7,13 @@
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/features/DataGenerator.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 using namespace shogun;
 
 template <typename PRNG>
@@ -129,6 +134,129 @@ TEST_F(KNNTest, lsh_solver_sparse)
 
 }
 
+TEST_F(KNNTest, hnsw_solver)
+{
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_HNSW);
+	knn->set_hnsw_parameters(4, 32, 16);
+	knn->train(features);
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+		EXPECT_EQ(output->get_label(i), labels_test->get_label(i));
+
+}
+
+TEST_F(KNNTest, predict_concurrently)
+{
+	for (auto solver : {KNN_BRUTE, KNN_KDTREE})
+	{
+		auto knn = std::make_shared<KNN>(k, distance, labels, solver);
+		knn->train(features);
+		auto rhs = distance->get_rhs();
+
+		// every thread classifies the test data with the same machine
+		std::vector<std::shared_ptr<Labels>> outputs(4);
+		std::vector<std::thread> threads;
+		for (auto& output : outputs)
+			threads.emplace_back([&]() { output = knn->predict(features_test); });
+		for (auto& thread : threads)
+			thread.join();
+
+		// the machine still holds the training data
+		EXPECT_EQ(distance->get_rhs(), rhs);
+
+		auto expected = knn->apply_multiclass(features_test);
+		for (const auto& output : outputs)
+		{
+			auto multiclass = output->as<MulticlassLabels>();
+			for (index_t i = 0; i < labels_test->get_num_labels(); ++i)
+				EXPECT_EQ(multiclass->get_label(i), expected->get_label(i));
+		}
+	}
+}
+
+TEST_F(KNNTest, neighbor_cache)
+{
+	auto cache = std::make_shared<NeighborGraphCache>(k);
+	for (int32_t kk = 1; kk <= k; ++kk)
+	{
+		auto expected_knn = std::make_shared<KNN>(kk, distance, labels);
+		expected_knn->train(features);
+		auto expected = expected_knn->apply_multiclass(features_test);
+
+		// every clone shares the cache, as in the folds of a cross-validation
+		auto knn = std::make_shared<KNN>(kk, distance, labels);
+		knn->set_neighbor_cache(cache);
+		auto clone = knn->clone()->as<KNN>();
+		EXPECT_EQ(clone->get_neighbor_cache(), cache);
+		clone->set_labels(labels);
+		clone->train(features);
+		auto output = clone->apply_multiclass(features_test);
+
+		for (index_t i = 0; i < labels_test->get_num_labels(); ++i)
+			EXPECT_EQ(output->get_label(i), expected->get_label(i));
+	}
+	EXPECT_EQ(cache->get_num_graphs(), 1);
+}
+
+TEST(HNSWKNNSolver, recall_and_add_points)
+{
+	std::mt19937_64 prng(23);
+	const index_t dim = 8;
+	const index_t num_points = 600;
+	const index_t num_queries = 50;
+	const int32_t num_neighbors = 5;
+
+	SGMatrix<float64_t> points(dim, num_points);
+	SGMatrix<float64_t> queries(dim, num_queries);
+	NormalDistribution<float64_t> normal;
+	for (index_t i = 0; i < points.num_rows * points.num_cols; ++i)
+		points.matrix[i] = normal(prng);
+	for (index_t i = 0; i < queries.num_rows * queries.num_cols; ++i)
+		queries.matrix[i] = normal(prng);
+
+	SGVector<index_t> first(num_points / 2);
+	first.range_fill();
+	SGVector<index_t> second(num_points / 2);
+	second.range_fill(num_points / 2);
+
+	auto all = std::make_shared<DenseFeatures<float64_t>>(points);
+	auto first_half = all->copy_subset(first)->as<DenseFeatures<float64_t>>();
+	auto second_half = all->copy_subset(second)->as<DenseFeatures<float64_t>>();
+	auto query = std::make_shared<DenseFeatures<float64_t>>(queries);
+
+	HNSWKNNSolver hnsw(
+	    num_neighbors, 1.0, 1, 0, SGVector<int32_t>(num_points), 8, 100, 50);
+	hnsw.build(first_half);
+	hnsw.add_points(second_half);
+	ASSERT_EQ(hnsw.get_num_points(), num_points);
+
+	auto distance = std::make_shared<EuclideanDistance>(all, query);
+	auto distances = distance->get_distance_matrix();
+	auto NN = hnsw.query_knn(query, num_neighbors);
+
+	index_t num_found = 0;
+	for (index_t i = 0; i < num_queries; ++i)
+	{
+		auto dists = distances.get_column(i);
+		SGVector<index_t> order(num_points);
+		order.range_fill();
+		std::sort(order.begin(), order.end(), [&dists](index_t a, index_t b) {
+			return dists[a] < dists[b];
+		});
+
+		for (int32_t j = 0; j < num_neighbors; ++j)
+		{
+			if (j > 0)
+				EXPECT_LE(dists[NN(j - 1, i)], dists[NN(j, i)]);
+			num_found += std::count(
+			    order.begin(), order.begin() + num_neighbors, NN(j, i));
+		}
+	}
+
+	EXPECT_GE(float64_t(num_found) / (num_queries * num_neighbors), 0.95);
+}
+
 TEST(KNN, classify_multiple_brute)
 {
 	std::mt19937_64 prng(17);
@@ -0,0 +1,74 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/svm/SVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/multiclass/MulticlassLibSVM.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(MulticlassLibSVMTest, train_pairs_in_parallel)
+{
+	const index_t num_vec = 120;
+	const index_t num_class = 4;
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal_dist;
+
+	// overlapping classes so that the pairs have many support vectors
+	SGMatrix<float64_t> matrix(2, num_vec);
+	auto labels = std::make_shared<MulticlassLabels>(num_vec);
+	for (index_t i = 0; i < num_vec; ++i)
+	{
+		// classes of different sizes
+		index_t label = (i * i) % num_class;
+		matrix(0, i) = normal_dist(prng) + 2.0 * (label % 2);
+		matrix(1, i) = normal_dist(prng) + 2.0 * (label / 2);
+		labels->set_label(i, label);
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+
+	auto train = [&](int32_t num_threads) {
+		env()->set_num_threads(num_threads);
+		auto kernel = std::make_shared<GaussianKernel>(features, features, 2.0);
+		auto svm = std::make_shared<MulticlassLibSVM>(1.0, kernel, labels);
+		svm->train();
+		return svm;
+	};
+
+	auto serial = train(1);
+	auto parallel = train(4);
+	env()->set_num_threads(1);
+
+	auto serial_pred = serial->apply(features)->as<MulticlassLabels>();
+	auto parallel_pred = parallel->apply(features)->as<MulticlassLabels>();
+	index_t num_correct = 0;
+	for (index_t i = 0; i < num_vec; ++i)
+	{
+		EXPECT_EQ(serial_pred->get_label(i), parallel_pred->get_label(i));
+		num_correct += serial_pred->get_label(i) == labels->get_label(i);
+	}
+	EXPECT_GT(num_correct, num_vec / 2);
+
+	ASSERT_EQ(serial->get_num_machines(), parallel->get_num_machines());
+	for (int32_t m = 0; m < serial->get_num_machines(); ++m)
+	{
+		auto a = serial->get_svm(m);
+		auto b = parallel->get_svm(m);
+		ASSERT_EQ(a->get_num_support_vectors(), b->get_num_support_vectors());
+		EXPECT_EQ(a->get_bias(), b->get_bias());
+		for (int32_t i = 0; i < a->get_num_support_vectors(); ++i)
+		{
+			EXPECT_EQ(a->get_support_vector(i), b->get_support_vector(i));
+			EXPECT_EQ(a->get_alpha(i), b->get_alpha(i));
+		}
+	}
+}
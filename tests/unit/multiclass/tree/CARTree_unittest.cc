@@ -29,12 +29,15 @@
  */
 
 #include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/tree/CARTree.h>
 
+#include <cmath>
 #include <random>
+#include <vector>
 
 using namespace shogun;
 
@@ -665,3 +668,214 @@ TEST(CARTree,cv_prune_simple)
 
 
 }
+
+/* continuous data with few distinct values, so that every value has its own
+ * bin and histogram split finding evaluates the same thresholds */
+static std::shared_ptr<DenseFeatures<float64_t>> discrete_data(
+    index_t num_vecs, std::mt19937_64& prng)
+{
+	std::uniform_int_distribution<int32_t> value(0, 9);
+	SGMatrix<float64_t> data(3, num_vecs);
+	for (index_t i=0; i<num_vecs; i++)
+	{
+		for (index_t j=0; j<3; j++)
+			data(j,i)=0.5*value(prng);
+	}
+	return std::make_shared<DenseFeatures<float64_t>>(data);
+}
+
+TEST(CARTree, histogram_splits_match_exact_splits)
+{
+	std::mt19937_64 prng(41);
+	auto feats=discrete_data(200, prng);
+	auto test_feats=discrete_data(50, prng);
+
+	SGVector<float64_t> class_labels(200);
+	SGVector<float64_t> regression_labels(200);
+	std::normal_distribution<float64_t> noise(0, 0.1);
+	for (index_t i=0; i<200; i++)
+	{
+		auto x=feats->get_feature_vector(i);
+		class_labels[i]=(x[0]+x[1]>4.) ? ((x[2]>2.) ? 2. : 1.) : 0.;
+		regression_labels[i]=x[0]-2*x[2]+noise(prng);
+	}
+
+	SGVector<bool> ft(3);
+	ft.set_const(false);
+
+	for (auto mode : {PT_MULTICLASS, PT_REGRESSION})
+	{
+		std::shared_ptr<Labels> labels;
+		if (mode==PT_MULTICLASS)
+			labels=std::make_shared<MulticlassLabels>(class_labels);
+		else
+			labels=std::make_shared<RegressionLabels>(regression_labels);
+
+		auto exact=std::make_shared<CARTree>(ft, mode);
+		exact->set_labels(labels);
+		exact->set_max_depth(4);
+		exact->train(feats);
+
+		auto histogram=std::make_shared<CARTree>(ft, mode);
+		histogram->set_labels(labels);
+		histogram->set_max_depth(4);
+		histogram->set_num_bins(16);
+		histogram->train(feats);
+
+		auto expected=exact->apply(test_feats)->as<DenseLabels>()->get_labels();
+		auto result=histogram->apply(test_feats)->as<DenseLabels>()->get_labels();
+		for (index_t i=0; i<expected.vlen; i++)
+			EXPECT_NEAR(expected[i], result[i], 1e-9);
+	}
+}
+
+TEST(CARTree, histogram_splits_quantize_continuous)
+{
+	std::mt19937_64 prng(43);
+	std::uniform_real_distribution<float64_t> uniform(0, 1);
+	SGMatrix<float64_t> data(2, 1000);
+	SGVector<float64_t> lab(1000);
+	for (index_t i=0; i<1000; i++)
+	{
+		data(0,i)=uniform(prng);
+		data(1,i)=uniform(prng);
+		lab[i]=(data(0,i)>0.5) ? 1. : 0.;
+	}
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGVector<bool> ft(2);
+	ft.set_const(false);
+	auto c=std::make_shared<CARTree>(ft, PT_MULTICLASS);
+	c->set_labels(std::make_shared<MulticlassLabels>(lab));
+	c->set_num_bins(32);
+	c->set_max_depth(3);
+	c->train(feats);
+
+	SGMatrix<uint8_t> bins;
+	SGMatrix<float64_t> thresholds;
+	c->quantize_features(feats, bins, thresholds);
+	EXPECT_EQ(bins.num_rows, 1000);
+	EXPECT_EQ(thresholds.num_rows, 32);
+	for (index_t i=0; i<1000; i++)
+	{
+		EXPECT_LT(bins(i,0), 32);
+		EXPECT_LE(data(0,i), thresholds(bins(i,0),0));
+		if (bins(i,0)>0)
+			EXPECT_GT(data(0,i), thresholds(bins(i,0)-1,0));
+	}
+
+	// the root splits at a bin boundary close to 0.5
+	auto root=c->get_root()->as<BinaryTreeMachineNode<CARTreeNodeData>>();
+	EXPECT_EQ(0, root->data.attribute_id);
+	EXPECT_NEAR(0.5, root->left()->data.transit_into_values[0], 0.05);
+
+	auto result=c->apply(feats)->as<MulticlassLabels>()->get_labels();
+	index_t errors=0;
+	for (index_t i=0; i<1000; i++)
+		errors+=(result[i]!=lab[i]);
+	EXPECT_LT(errors, 50);
+}
+
+TEST(CARTree, parallel_growth_matches_sequential)
+{
+	std::mt19937_64 prng(47);
+	std::uniform_real_distribution<float64_t> uniform(0, 1);
+	SGMatrix<float64_t> data(5, 5000);
+	SGVector<float64_t> lab(5000);
+	for (index_t i=0; i<5000; i++)
+	{
+		for (index_t j=0; j<5; j++)
+			data(j,i)=uniform(prng);
+		lab[i]=std::floor(3*data(0,i)*data(1,i)+data(2,i));
+	}
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGVector<bool> ft(5);
+	ft.set_const(false);
+	auto num_threads=env()->get_num_threads();
+	for (auto num_bins : {0, 64})
+	{
+		SGVector<float64_t> results[2];
+		for (index_t k=0; k<2; k++)
+		{
+			env()->set_num_threads(k==0 ? 1 : 4);
+			auto c=std::make_shared<CARTree>(ft, PT_MULTICLASS);
+			c->set_labels(std::make_shared<MulticlassLabels>(lab));
+			c->set_num_bins(num_bins);
+			c->train(feats);
+			results[k]=c->apply(feats)->as<MulticlassLabels>()->get_labels();
+		}
+		for (index_t i=0; i<5000; i++)
+			EXPECT_EQ(results[0][i], results[1][i]);
+	}
+	env()->set_num_threads(num_threads);
+}
+
+TEST(CARTree, bootstrap_weights_match_repeated_vectors)
+{
+	std::mt19937_64 prng(53);
+	std::uniform_real_distribution<float64_t> uniform(0, 1);
+	std::uniform_int_distribution<index_t> draw(0, 299);
+	SGMatrix<float64_t> data(3, 300);
+	SGVector<float64_t> lab(300);
+	for (index_t i=0; i<300; i++)
+	{
+		for (index_t j=0; j<3; j++)
+			data(j,i)=uniform(prng);
+		lab[i]=(data(0,i)+data(1,i)>1) ? 1 : (data(2,i)>0.5 ? 2 : 0);
+	}
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels=std::make_shared<MulticlassLabels>(lab);
+
+	// a bootstrap sample and its distinct vectors with their counts
+	SGVector<index_t> bag(300);
+	std::vector<index_t> counts(300, 0);
+	for (index_t i=0; i<300; i++)
+		counts[bag[i]=draw(prng)]++;
+	std::vector<index_t> distinct;
+	std::vector<float64_t> distinct_counts;
+	for (index_t i=0; i<300; i++)
+	{
+		if (counts[i])
+		{
+			distinct.push_back(i);
+			distinct_counts.push_back(counts[i]);
+		}
+	}
+
+	SGVector<bool> ft(3);
+	ft.set_const(false);
+	SGMatrix<float64_t> sorted_feats;
+	SGMatrix<index_t> sorted_indices;
+	SGVector<float64_t> results[2];
+	for (index_t k=0; k<2; k++)
+	{
+		auto c=std::make_shared<CARTree>(ft, PT_MULTICLASS);
+		c->pre_sort_features(feats, sorted_feats, sorted_indices);
+		c->set_sorted_features(sorted_feats, sorted_indices);
+		SGVector<index_t> subset;
+		SGVector<float64_t> weights;
+		if (k==0)
+		{
+			subset=bag;
+			weights=SGVector<float64_t>(300);
+			weights.set_const(1.0);
+		}
+		else
+		{
+			subset=SGVector<index_t>(distinct.data(), distinct.size(), false);
+			weights=SGVector<float64_t>(distinct_counts.data(), distinct_counts.size(), false);
+		}
+		feats->add_subset(subset);
+		labels->add_subset(subset);
+		c->set_weights(weights.clone());
+		c->set_labels(labels);
+		c->train(feats);
+		feats->remove_subset();
+		labels->remove_subset();
+		results[k]=c->apply(feats)->as<MulticlassLabels>()->get_labels();
+	}
+
+	for (index_t i=0; i<300; i++)
+		EXPECT_EQ(results[0][i], results[1][i]);
+}
@@ -0,0 +1,174 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/multiclass/tree/CARTree.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
+
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+/* the first feature is nominal with values 0..3, the others continuous */
+static SGMatrix<float64_t> mixed_data(index_t num_vecs, uint64_t seed)
+{
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> uniform(0, 1);
+	std::uniform_int_distribution<int32_t> category(0, 3);
+	SGMatrix<float64_t> data(3, num_vecs);
+	for (index_t i=0; i<num_vecs; i++)
+	{
+		data(0,i)=category(prng);
+		data(1,i)=uniform(prng);
+		data(2,i)=uniform(prng);
+	}
+	return data;
+}
+
+static SGVector<bool> mixed_types()
+{
+	SGVector<bool> ft(3);
+	ft[0]=true;
+	ft[1]=false;
+	ft[2]=false;
+	return ft;
+}
+
+TEST(FlatTreeEnsemble, matches_tree_apply)
+{
+	auto data=mixed_data(500, 3);
+	SGVector<float64_t> lab(500);
+	for (index_t i=0; i<500; i++)
+		lab[i]=(data(0,i)==1 || data(1,i)>0.7) ? 1 : (data(2,i)>0.4 ? 2 : 0);
+
+	auto c=std::make_shared<CARTree>(mixed_types(), PT_MULTICLASS);
+	c->set_labels(std::make_shared<MulticlassLabels>(lab));
+	c->set_max_depth(6);
+	c->train(std::make_shared<DenseFeatures<float64_t>>(data));
+
+	auto test=std::make_shared<DenseFeatures<float64_t>>(mixed_data(300, 5));
+	auto flat=c->apply(test)->as<MulticlassLabels>()->get_labels();
+
+	// a new root is not compiled, so the nodes are walked
+	c->set_root(c->clone_tree()->get_root());
+	auto walked=c->apply(test)->as<MulticlassLabels>()->get_labels();
+
+	for (index_t i=0; i<300; i++)
+		EXPECT_EQ(walked[i], flat[i]);
+}
+
+TEST(FlatTreeEnsemble, weighted_sum_of_trees)
+{
+	auto data=mixed_data(400, 7);
+	SGVector<float64_t> lab(400);
+	for (index_t i=0; i<400; i++)
+		lab[i]=data(0,i)+std::sin(4*data(1,i));
+
+	auto c=std::make_shared<CARTree>(mixed_types(), PT_REGRESSION);
+	c->set_labels(std::make_shared<RegressionLabels>(lab));
+	c->set_max_depth(4);
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	c->train(feats);
+	auto tree_labels=c->apply(feats)->as<RegressionLabels>()->get_labels();
+
+	FlatTreeEnsemble ensemble;
+	auto root=c->get_root()->as<FlatTreeEnsemble::bnode_t>();
+	ensemble.add_tree(root, mixed_types());
+	ensemble.add_tree(root, mixed_types());
+	EXPECT_EQ(ensemble.get_num_trees(), 2);
+	EXPECT_EQ(ensemble.get_num_nodes(), 4*root->data.num_leaves-2);
+
+	auto outputs=ensemble.apply(data);
+	SGVector<float64_t> weights(2);
+	weights[0]=1;
+	weights[1]=2;
+	auto sums=ensemble.apply_sum(data, weights, 0.5);
+	for (index_t i=0; i<400; i++)
+	{
+		EXPECT_EQ(outputs(i,0), tree_labels[i]);
+		EXPECT_EQ(outputs(i,1), tree_labels[i]);
+		EXPECT_NEAR(sums[i], 1.5*tree_labels[i], 1e-12);
+	}
+}
+
+TEST(FlatTreeEnsemble, shap_values_sum_to_outputs)
+{
+	auto data=mixed_data(300, 11);
+	SGVector<float64_t> lab(300);
+	for (index_t i=0; i<300; i++)
+		lab[i]=data(0,i)+std::sin(4*data(1,i))*data(2,i);
+
+	auto c=std::make_shared<CARTree>(mixed_types(), PT_REGRESSION);
+	c->set_labels(std::make_shared<RegressionLabels>(lab));
+	c->set_max_depth(5);
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	c->train(feats);
+
+	auto test=std::make_shared<DenseFeatures<float64_t>>(mixed_data(50, 13));
+	auto outputs=c->apply_regression(test)->get_labels();
+	auto background=std::make_shared<DenseFeatures<float64_t>>(mixed_data(20, 17));
+	for (auto bg : {std::shared_ptr<DenseFeatures<float64_t>>(), background})
+	{
+		auto phi=c->get_shap_values(test, bg);
+		ASSERT_EQ(phi.num_rows, 4);
+		ASSERT_EQ(phi.num_cols, 50);
+		for (index_t i=0; i<50; i++)
+		{
+			float64_t sum=0;
+			for (index_t j=0; j<4; j++)
+				sum+=phi(j,i);
+			EXPECT_NEAR(sum, outputs[i], 1e-10);
+		}
+	}
+}
+
+TEST(FlatTreeEnsemble, interventional_shap_matches_shapley_values)
+{
+	auto data=mixed_data(200, 19);
+	SGVector<float64_t> lab(200);
+	for (index_t i=0; i<200; i++)
+		lab[i]=data(0,i)*data(1,i)+data(2,i);
+
+	auto c=std::make_shared<CARTree>(mixed_types(), PT_REGRESSION);
+	c->set_labels(std::make_shared<RegressionLabels>(lab));
+	c->set_max_depth(6);
+	c->train(std::make_shared<DenseFeatures<float64_t>>(data));
+
+	auto x=mixed_data(1, 23);
+	auto z=mixed_data(1, 29);
+	auto phi=c->get_shap_values(
+		std::make_shared<DenseFeatures<float64_t>>(x),
+		std::make_shared<DenseFeatures<float64_t>>(z));
+
+	// outputs of the vectors taking the features of the subset from x and
+	// the others from z
+	SGMatrix<float64_t> hybrid(3, 8);
+	for (index_t s=0; s<8; s++)
+	{
+		for (index_t j=0; j<3; j++)
+			hybrid(j,s)=(s>>j)&1 ? x(j,0) : z(j,0);
+	}
+	auto f=c->apply_regression(std::make_shared<DenseFeatures<float64_t>>(hybrid))->get_labels();
+
+	const float64_t subset_weight[]={1.0/3, 1.0/6, 1.0/3};
+	for (index_t j=0; j<3; j++)
+	{
+		float64_t shapley=0;
+		for (index_t s=0; s<8; s++)
+		{
+			if ((s>>j)&1)
+				continue;
+			const index_t size=(s&1)+((s>>1)&1)+((s>>2)&1);
+			shapley+=subset_weight[size]*(f[s|(1<<j)]-f[s]);
+		}
+		EXPECT_NEAR(phi(j,0), shapley, 1e-10);
+	}
+	EXPECT_NEAR(phi(3,0), f[0], 1e-10);
+}
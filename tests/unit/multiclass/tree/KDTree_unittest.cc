@@ -32,6 +32,10 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/multiclass/tree/KDTree.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <algorithm>
+#include <random>
 
 using namespace shogun;
 
@@ -118,3 +122,52 @@ TEST(KDTree, knn_query)
 
 
 }
+
+TEST(KDTree, knn_query_parallel_build)
+{
+	// large enough for subtrees to be built as separate tasks and for
+	// several query blocks
+	const index_t num_vectors=10000;
+	const index_t num_queries=200;
+	const int32_t k=5;
+
+	std::mt19937_64 prng(57);
+	NormalDistribution<float64_t> normal;
+	SGMatrix<float64_t> data(3,num_vectors);
+	for (index_t i=0;i<data.num_rows*data.num_cols;i++)
+		data.matrix[i]=normal(prng);
+	SGMatrix<float64_t> test_data(3,num_queries);
+	for (index_t i=0;i<test_data.num_rows*test_data.num_cols;i++)
+		test_data.matrix[i]=normal(prng);
+
+	auto feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto qfeats=std::make_shared<DenseFeatures<float64_t>>(test_data);
+
+	auto tree=std::make_shared<KDTree>(4);
+	tree->build_tree(feats);
+	tree->query_knn(qfeats,k);
+
+	SGMatrix<float64_t> dists=tree->get_knn_dists();
+	SGMatrix<index_t> ind=tree->get_knn_indices();
+	for (index_t q=0;q<num_queries;q++)
+	{
+		SGVector<float64_t> brute(num_vectors);
+		for (index_t i=0;i<num_vectors;i++)
+		{
+			float64_t sq=0;
+			for (index_t d=0;d<data.num_rows;d++)
+				sq+=Math::sq(data(d,i)-test_data(d,q));
+			brute[i]=std::sqrt(sq);
+		}
+		std::sort(brute.begin(),brute.end());
+
+		for (int32_t j=0;j<k;j++)
+		{
+			EXPECT_NEAR(brute[j],dists(j,q),1e-12);
+			float64_t sq=0;
+			for (index_t d=0;d<data.num_rows;d++)
+				sq+=Math::sq(data(d,ind(j,q))-test_data(d,q));
+			EXPECT_NEAR(dists(j,q),std::sqrt(sq),1e-12);
+		}
+	}
+}
@@ -35,6 +35,7 @@
 #include <shogun/evaluation/MulticlassAccuracy.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/observers/ParameterObserverLogger.h>
 #include <shogun/machine/RandomForest.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <stdio.h>
@@ -150,6 +151,60 @@ TEST_F(RandomForestTest, classify_non_nominal_test)
 	EXPECT_NEAR(0.714285,c->get<float64_t>(RandomForest::kOobError),1e-6);
 }
 
+TEST_F(RandomForestTest, oob_error_streamed_to_observers)
+{
+	weather_ft.set_const(false);
+
+	auto c =
+	    std::make_shared<RandomForest>(weather_features_train, weather_labels_train, 20, 2);
+	c->set_feature_types(weather_ft);
+	c->set_combination_rule(std::make_shared<MajorityVote>());
+	c->put(RandomForest::kOobEvaluationMetric,
+		std::static_pointer_cast<Evaluation>(std::make_shared<MulticlassAccuracy>()));
+	c->put("seed", 2343);
+	auto observer = std::make_shared<ParameterObserverLogger>();
+	c->subscribe(observer);
+	c->train(weather_features_train);
+	c->unsubscribe(observer);
+
+	// one error per number of trees, the last one of the whole forest
+	auto num_observations = observer->get<int32_t>("num_observations");
+	ASSERT_EQ(num_observations, 20);
+	auto last = observer->get_observation(num_observations - 1);
+	EXPECT_EQ(
+	    last->get<float64_t>(RandomForest::kOobError),
+	    c->get<float64_t>(RandomForest::kOobError));
+}
+
+TEST_F(RandomForestTest, classify_non_nominal_histogram_test)
+{
+	int32_t seed = 2343;
+
+	weather_ft.set_const(false);
+
+	auto c =
+	    std::make_shared<RandomForest>(weather_features_train, weather_labels_train, 100, 2);
+	c->set_feature_types(weather_ft);
+	// the weather attributes have at most 3 values, so every value has its
+	// own bin and the forest predicts like the one without histograms
+	c->set_num_bins(8);
+	auto mv = std::make_shared<MajorityVote>();
+	c->set_combination_rule(mv);
+	env()->set_num_threads(1);
+	c->put("seed", seed);
+	c->train(weather_features_train);
+
+	auto result =
+	    c->apply(weather_features_test)->as<MulticlassLabels>();
+	SGVector<float64_t> res_vector=result->get_labels();
+
+	EXPECT_EQ(1.0,res_vector[0]);
+	EXPECT_EQ(0.0,res_vector[1]);
+	EXPECT_EQ(0.0,res_vector[2]);
+	EXPECT_EQ(1.0,res_vector[3]);
+	EXPECT_EQ(1.0,res_vector[4]);
+}
+
 TEST_F(RandomForestTest, score_compare_sklearn_toydata)
 {
 	int32_t seed = 211;
@@ -0,0 +1,63 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/multiclass/tree/SplitStatistics.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+TEST(SplitStatistics, contingency_table)
+{
+	SGVector<float64_t> values({2, 0, 2, 1, 0, 2});
+	SGVector<float64_t> labels({1, 1, 0, 1, 0, 0});
+	SGVector<float64_t> weights({1, 2, 3, 4, 5, 6});
+
+	SGMatrix<int32_t> counts;
+	SGMatrix<float64_t> weight_table;
+	SplitStatistics::contingency_table(values, labels, weights, counts, weight_table);
+
+	ASSERT_EQ(counts.num_rows, 3);
+	ASSERT_EQ(counts.num_cols, 2);
+	EXPECT_EQ(counts(0,0), 1);
+	EXPECT_EQ(counts(0,1), 1);
+	EXPECT_EQ(counts(1,0), 0);
+	EXPECT_EQ(counts(1,1), 1);
+	EXPECT_EQ(counts(2,0), 2);
+	EXPECT_EQ(counts(2,1), 1);
+	EXPECT_EQ(weight_table(0,0), 5);
+	EXPECT_EQ(weight_table(0,1), 2);
+	EXPECT_EQ(weight_table(1,1), 4);
+	EXPECT_EQ(weight_table(2,0), 9);
+	EXPECT_EQ(weight_table(2,1), 1);
+}
+
+TEST(SplitStatistics, entropy_matches_definition)
+{
+	EXPECT_EQ(SplitStatistics::xlogx(0), 0);
+	EXPECT_NEAR(SplitStatistics::xlogx(7), 7*std::log(7.0), 1e-12);
+	EXPECT_NEAR(SplitStatistics::xlogx(2.5), 2.5*std::log(2.5), 1e-12);
+
+	float64_t weights[]={3, 0, 1.5, 5};
+	float64_t expected=0;
+	for (auto w : weights)
+	{
+		if (w>0)
+			expected-=w/9.5*std::log(w/9.5);
+	}
+	EXPECT_NEAR(SplitStatistics::entropy(weights, 4), expected, 1e-12);
+
+	// two values, one pure and one evenly split
+	SGMatrix<float64_t> table(2, 2);
+	table(0,0)=4;
+	table(0,1)=0;
+	table(1,0)=2;
+	table(1,1)=2;
+	EXPECT_NEAR(SplitStatistics::conditional_entropy(table), 0.5*std::log(2.0), 1e-12);
+	EXPECT_NEAR(SplitStatistics::class_entropy(table),
+		-0.75*std::log(0.75)-0.25*std::log(0.25), 1e-12);
+}
@@ -228,3 +228,41 @@ TEST(Autoencoder, convolutional_with_stride_and_pooling)
 
 	EXPECT_NEAR(ae.check_gradients(), 0.0, tolerance);
 }
+
+/** Trains a contractive autoencoder with and without splitting the batches
+ * into shards, the gradients of the shards add up to those of the batch
+ */
+TEST(Autoencoder, contractive_logistic_shards)
+{
+	int32_t seed = 10;
+	int32_t num_features = 8;
+	int32_t num_examples = 128;
+
+	std::mt19937_64 prng(seed);
+	UniformRealDistribution<float64_t> uniform_real_dist(-1.0, 1.0);
+	SGMatrix<float64_t> data(num_features, num_examples);
+	for (int32_t i=0; i<num_features*num_examples; i++)
+		data[i] = uniform_real_dist(prng);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGVector<float64_t> params[2];
+	for (int32_t shard_size : {0, 16})
+	{
+		auto hidden_layer = std::make_shared<NeuralLogisticLayer>(6);
+		auto decoding_layer = std::make_shared<NeuralLinearLayer>(num_features);
+		hidden_layer->put("seed", seed);
+		decoding_layer->put("seed", seed);
+		Autoencoder ae(num_features, hidden_layer, decoding_layer);
+		ae.put("seed", seed);
+		ae.set_contraction_coefficient(0.5);
+		ae.set_max_num_epochs(5);
+		ae.set_shard_size(shard_size);
+
+		ae.train(features);
+		params[shard_size ? 1 : 0] = ae.get_parameters().clone();
+	}
+
+	ASSERT_EQ(params[0].vlen, params[1].vlen);
+	for (int32_t i=0; i<params[0].vlen; i++)
+		EXPECT_NEAR(params[0][i], params[1][i], 1e-8);
+}
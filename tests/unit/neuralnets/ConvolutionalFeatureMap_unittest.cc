@@ -750,6 +750,86 @@ TEST(ConvolutionalFeatureMap, compute_input_gradients)
 	
 }
 
+TEST(ConvolutionalFeatureMap, multiple_maps_at_once)
+{
+	const int32_t seed = 100;
+	const int32_t w = 8;
+	const int32_t h = 6;
+	const int32_t rx = 1;
+	const int32_t ry = 2;
+	const int32_t stride_x = 2;
+	const int32_t stride_y = 2;
+	const int32_t b = 3;
+	const int32_t num_maps = 3;
+	const int32_t num_outputs = (w/stride_x)*(h/stride_y);
+
+	std::mt19937_64 prng(seed);
+	NormalDistribution<float64_t> normal_dist;
+
+	// two channels
+	auto input = std::make_shared<NeuralLinearLayer> (2*w*h);
+	input->set_batch_size(b);
+	for (int32_t i=0; i<input->get_num_neurons()*b; i++)
+		input->get_activations()[i] = normal_dist(prng);
+
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(input);
+
+	SGVector<int32_t> input_indices(1);
+	input_indices[0] = 0;
+
+	const int32_t num_parameters_per_map = 1+(2*rx+1)*(2*ry+1)*2;
+	SGVector<float64_t> params(num_maps*num_parameters_per_map);
+	for (int32_t i=0; i<params.vlen; i++)
+		params[i] = normal_dist(prng);
+
+	SGMatrix<float64_t> AG(num_maps*num_outputs, b);
+	for (int32_t i=0; i<AG.num_rows*AG.num_cols; i++)
+		AG[i] = normal_dist(prng);
+
+	// all maps at once
+	CConvolutionalFeatureMap maps(w,h,rx,ry,stride_x,stride_y,0,
+		CMAF_RECTIFIED_LINEAR);
+	SGMatrix<float64_t> A(num_maps*num_outputs, b);
+	maps.compute_activations(params, layers, input_indices, A, num_maps);
+
+	SGMatrix<float64_t> G = AG.clone();
+	SGVector<float64_t> PG(params.vlen);
+	input->get_activation_gradients().zero();
+	maps.compute_gradients(params, A, G, layers, input_indices, PG, num_maps);
+	SGMatrix<float64_t> IG = input->get_activation_gradients().clone();
+
+	// one map after another
+	SGMatrix<float64_t> A_ref(num_maps*num_outputs, b);
+	SGMatrix<float64_t> G_ref = AG.clone();
+	SGVector<float64_t> PG_ref(params.vlen);
+	input->get_activation_gradients().zero();
+	for (int32_t m=0; m<num_maps; m++)
+	{
+		SGVector<float64_t> map_params(
+			params.vector+m*num_parameters_per_map,
+			num_parameters_per_map, false);
+		SGVector<float64_t> map_gradients(
+			PG_ref.vector+m*num_parameters_per_map,
+			num_parameters_per_map, false);
+
+		CConvolutionalFeatureMap map(w,h,rx,ry,stride_x,stride_y,m,
+			CMAF_RECTIFIED_LINEAR);
+		map.compute_activations(map_params, layers, input_indices, A_ref);
+		map.compute_gradients(map_params, A_ref, G_ref, layers,
+			input_indices, map_gradients);
+	}
+
+	for (int32_t i=0; i<A.num_rows*A.num_cols; i++)
+		EXPECT_NEAR(A[i], A_ref[i], 1e-12);
+
+	for (int32_t i=0; i<PG.vlen; i++)
+		EXPECT_NEAR(PG[i], PG_ref[i], 1e-12);
+
+	for (int32_t i=0; i<IG.num_rows*IG.num_cols; i++)
+		EXPECT_NEAR(IG[i], input->get_activation_gradients()[i], 1e-12);
+}
+
 TEST(ConvolutionalFeatureMap, pool_activations)
 {
 	const int32_t w = 6;
@@ -35,6 +35,7 @@
 #include <shogun/mathematics/UniformRealDistribution.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <random>
 
 using namespace shogun;
@@ -58,3 +59,32 @@ TEST(NeuralInputLayer, compute_activations)
 		for (int32_t j=0; j<A.num_cols; j++)
 			EXPECT_EQ(x(i+layer.get_start_index(), j), A(i,j));
 }
+
+TEST(NeuralInputLayer, compute_activations_gaussian_noise)
+{
+	int32_t seed = 100;
+	std::mt19937_64 prng(seed);
+	UniformRealDistribution<float64_t> uniform_real_dist(-10.0, 10.0);
+	SGMatrix<float64_t> x(20,500);
+	for (int32_t i=0; i<x.num_rows*x.num_cols; i++)
+		x[i] = uniform_real_dist(prng);
+
+	NeuralInputLayer layer(20);
+	layer.put("seed", seed);
+	layer.set_batch_size(x.num_cols);
+	layer.gaussian_noise = 0.5;
+
+	layer.compute_activations(x);
+	SGMatrix<float64_t> A = layer.get_activations();
+
+	// the noise is added to the inputs
+	float64_t mean = 0, variance = 0;
+	int32_t len = A.num_rows*A.num_cols;
+	for (int32_t i=0; i<len; i++)
+	{
+		mean += (A[i]-x[i])/len;
+		variance += (A[i]-x[i])*(A[i]-x[i])/len;
+	}
+	EXPECT_NEAR(mean, 0.0, 0.05);
+	EXPECT_NEAR(std::sqrt(variance), 0.5, 0.05);
+}
@@ -35,14 +35,17 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/neuralnets/NeuralNetwork.h>
+#include <shogun/neuralnets/NeuralNetworkPredictor.h>
 #include <shogun/neuralnets/NeuralInputLayer.h>
 #include <shogun/neuralnets/NeuralLogisticLayer.h>
 #include <shogun/neuralnets/NeuralSoftmaxLayer.h>
 #include <shogun/neuralnets/NeuralRectifiedLinearLayer.h>
+#include <shogun/neuralnets/NeuralLeakyRectifiedLinearLayer.h>
 #include <shogun/neuralnets/NeuralConvolutionalLayer.h>
 #include <shogun/neuralnets/NeuralLayers.h>
 
@@ -82,6 +85,39 @@ TEST(NeuralNetwork, backpropagation_linear)
 	EXPECT_NEAR(network->check_gradients(), 0.0, tolerance);
 }
 
+/** Tests that layers of a deep stack share the memory of their gradients
+ * and that backpropagation is still correct
+ */
+TEST(NeuralNetwork, shared_gradient_buffers)
+{
+	int32_t seed = 10;
+	float64_t tolerance = 1e-9;
+
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(std::make_shared<NeuralInputLayer>(5));
+	for (int32_t i=0; i<5; i++)
+		layers.push_back(std::make_shared<NeuralLogisticLayer>(6));
+	layers.push_back(std::make_shared<NeuralLinearLayer>(4));
+	auto network = std::make_shared<NeuralNetwork>(layers);
+	network->put("seed", seed);
+	network->quick_connect();
+	network->initialize_neural_network();
+
+	// in a chain the gradients of layers two apart are never alive at the
+	// same time
+	for (int32_t i=1; i<=4; i++)
+	{
+		EXPECT_EQ(layers[i]->get_activation_gradients().matrix,
+			layers[i+2]->get_activation_gradients().matrix);
+		EXPECT_NE(layers[i]->get_activation_gradients().matrix,
+			layers[i+1]->get_activation_gradients().matrix);
+	}
+	EXPECT_EQ(layers[1]->get_local_gradients().matrix,
+		layers[6]->get_local_gradients().matrix);
+
+	EXPECT_NEAR(network->check_gradients(), 0.0, tolerance);
+}
+
 /** Tests neural layers builder
  */
 TEST(NeuralNetwork, neural_layers_builder)
@@ -245,6 +281,91 @@ TEST(NeuralNetwork, backpropagation_convolutional)
 
 }
 
+/** Tests that single precision products give the double precision outputs
+ * up to float32 rounding
+ */
+TEST(NeuralNetwork, single_precision)
+{
+	int32_t seed = 10;
+	int32_t N = 5;
+
+	SGMatrix<float64_t> inputs_matrix(24, N);
+	for (int32_t i=0; i<inputs_matrix.num_rows*inputs_matrix.num_cols; i++)
+		inputs_matrix[i] = std::sin(i);
+	auto features =
+		std::make_shared<DenseFeatures<float64_t>>(inputs_matrix);
+
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(std::make_shared<NeuralInputLayer>(6,4));
+	layers.push_back(std::make_shared<NeuralConvolutionalLayer>(
+		CMAF_LOGISTIC, 2, 1, 1, 1, 1, 1, 1));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(8));
+	layers.push_back(std::make_shared<NeuralLinearLayer>(1));
+	auto network = std::make_shared<NeuralNetwork>(layers);
+	network->put("seed", seed);
+	network->quick_connect();
+	network->initialize_neural_network(0.5);
+
+	auto predictions = network->apply_regression(features);
+
+	network->set_precision(NLP_SINGLE);
+	auto predictions_single = network->apply_regression(features);
+
+	for (int32_t i=0; i<N; i++)
+	{
+		EXPECT_NEAR(predictions_single->get_label(i),
+			predictions->get_label(i),
+			1e-5*std::max(1.0, std::abs(predictions->get_label(i))));
+	}
+}
+
+/** Tests that training on shards of the batch gives the same network as
+ * training on the whole batch
+ */
+TEST(NeuralNetwork, sharded_training)
+{
+	int32_t N = 100;
+	SGMatrix<float64_t> inputs_matrix(2, N);
+	SGVector<float64_t> targets_vector(N);
+	for (int32_t i=0; i<N; i++)
+	{
+		inputs_matrix(0,i) = std::sin(0.1*i);
+		inputs_matrix(1,i) = std::cos(0.3*i);
+		targets_vector[i] = inputs_matrix(0,i)*inputs_matrix(1,i);
+	}
+
+	auto features =
+		std::make_shared<DenseFeatures<float64_t>>(inputs_matrix);
+	auto labels = std::make_shared<RegressionLabels>(targets_vector);
+
+	auto train = [&](int32_t shard_size)
+	{
+		std::vector<std::shared_ptr<NeuralLayer>> layers;
+		layers.push_back(std::make_shared<NeuralInputLayer>(2));
+		layers.push_back(std::make_shared<NeuralLogisticLayer>(10));
+		layers.push_back(std::make_shared<NeuralLinearLayer>(1));
+
+		auto network = std::make_shared<NeuralNetwork>(layers);
+		network->put("seed", 10);
+		network->quick_connect();
+		network->initialize_neural_network();
+		network->set_shard_size(shard_size);
+		network->set_l2_coefficient(0.01);
+		network->set_max_num_epochs(5);
+		network->set_labels(labels);
+		network->train(features);
+		return network->get_parameters();
+	};
+
+	SGVector<float64_t> params = train(0);
+	// 6 shards of 16 or 17 cases
+	SGVector<float64_t> params_sharded = train(16);
+
+	ASSERT_EQ(params.vlen, params_sharded.vlen);
+	for (int32_t i=0; i<params.vlen; i++)
+		EXPECT_NEAR(params[i], params_sharded[i], 1e-8);
+}
+
 /** tests a neural network on the binary XOR problem */
 TEST(NeuralNetwork, binary_classification)
 {
@@ -447,3 +568,105 @@ TEST(NeuralNetwork, gradient_descent)
 	for (int32_t i=0; i<4; i++)
 		EXPECT_EQ(predictions->get_label(i), labels->get_label(i));
 }
+
+/** tests gradient descent on shuffled minibatches of streamed features */
+TEST(NeuralNetwork, streaming_gradient_descent)
+{
+	int32_t seed = 100;
+
+	int32_t N = 100;
+	SGMatrix<float64_t> inputs_matrix(2,N);
+	SGVector<float64_t> targets_vector(N);
+	for (int32_t i=0; i<N; i++)
+	{
+		// classes are sorted in the stream
+		float64_t sign = i<N/2 ? -1.0 : 1.0;
+		inputs_matrix(0,i) = sign*(1.0+0.01*i);
+		inputs_matrix(1,i) = 0.01*(i%7);
+		targets_vector[i] = sign;
+	}
+
+	auto features =
+		std::make_shared<DenseFeatures<float64_t>>(inputs_matrix);
+	auto streaming_features =
+		std::make_shared<StreamingDenseFeatures<float64_t>>(features);
+
+	auto labels = std::make_shared<BinaryLabels>(targets_vector);
+
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(std::make_shared<NeuralInputLayer>(2));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(1));
+
+	auto network = std::make_shared<NeuralNetwork>(layers);
+	network->put("seed", seed);
+	network->put("sigma", 0.1);
+
+	network->set_optimization_method(NNOM_GRADIENT_DESCENT);
+	network->set_gd_learning_rate(1.0);
+	network->set_gd_mini_batch_size(10);
+	network->set_shuffle_buffer_size(32);
+	network->set_epsilon(0.0);
+	network->set_max_num_epochs(20);
+
+	network->set_labels(labels);
+	network->train(streaming_features);
+
+	auto predictions = network->apply_binary(features);
+
+	for (int32_t i=0; i<N; i++)
+		EXPECT_EQ(predictions->get_label(i), labels->get_label(i));
+}
+
+/** tests that a compiled predictor computes the same outputs as the network,
+ * with dropout scaling folded into its weights
+ */
+TEST(NeuralNetwork, compile_for_inference)
+{
+	int32_t seed = 100;
+	int32_t N = 20;
+
+	SGMatrix<float64_t> inputs(4, N);
+	for (int32_t i=0; i<inputs.num_rows*inputs.num_cols; i++)
+		inputs[i] = std::sin(0.37*i);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(inputs);
+
+	std::vector<std::shared_ptr<NeuralLayer>> layers;
+	layers.push_back(std::make_shared<NeuralInputLayer>(4));
+	layers.push_back(std::make_shared<NeuralLogisticLayer>(8));
+	layers.push_back(std::make_shared<NeuralRectifiedLinearLayer>(7));
+	layers.push_back(std::make_shared<NeuralLeakyRectifiedLinearLayer>(6));
+	layers.push_back(std::make_shared<NeuralLinearLayer>(5));
+	layers.push_back(std::make_shared<NeuralSoftmaxLayer>(3));
+
+	auto network = std::make_shared<NeuralNetwork>(layers);
+	network->put("seed", seed);
+	network->put("sigma", 1.0);
+	network->quick_connect();
+	network->initialize_neural_network();
+
+	for (int32_t i=0; i<5; i++)
+		network->get_layers()[i]->dropout_prop = 0.2;
+
+	SGMatrix<float64_t> expected = network->transform(features)
+		->get_feature_matrix();
+
+	auto predictor = network->compile_for_inference();
+	EXPECT_EQ(predictor->get_num_inputs(), 4);
+	EXPECT_EQ(predictor->get_num_outputs(), 3);
+
+	SGMatrix<float64_t> outputs = predictor->predict(inputs);
+	for (int32_t i=0; i<expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(outputs[i], expected[i], 1e-12);
+
+	SGVector<float64_t> output(3);
+	predictor->predict(inputs.get_column_vector(N-1), output.vector);
+	for (int32_t i=0; i<3; i++)
+		EXPECT_NEAR(output[i], expected(i, N-1), 1e-12);
+
+	auto quantized = network->compile_for_inference(true);
+	EXPECT_TRUE(quantized->is_quantized());
+
+	SGMatrix<float64_t> quantized_outputs = quantized->predict(inputs);
+	for (int32_t i=0; i<expected.num_rows*expected.num_cols; i++)
+		EXPECT_NEAR(quantized_outputs[i], expected[i], 0.05);
+}
@@ -187,3 +187,41 @@ TEST(RBM, pseudo_likelihood_binary)
 	// generated using scikit-learn
 	EXPECT_NEAR(-3.3698, pl, 0.02);
 }
+
+TEST(RBM, sample_bernoulli)
+{
+	int32_t num_rows = 64;
+	int32_t num_chains = 2048;
+
+	SGMatrix<float64_t> mean(num_rows, num_chains);
+	for (int32_t i=0; i<num_rows; i++)
+		for (int32_t j=0; j<num_chains; j++)
+			mean(i,j) = (i+0.5)/num_rows;
+
+	SGMatrix<float64_t> states(num_rows, num_chains);
+	states.set_const(-1.0);
+
+	std::mt19937_64 prng(10);
+	RBM::sample_bernoulli(mean, states, prng, 8, 48);
+
+	for (int32_t i=0; i<num_rows; i++)
+	{
+		float64_t freq = 0;
+		for (int32_t j=0; j<num_chains; j++)
+			freq += states(i,j)/num_chains;
+
+		if (i<8 || i>=56)
+			EXPECT_EQ(freq, -1.0);
+		else
+			EXPECT_NEAR(freq, mean(i,0), 0.05);
+	}
+
+	// the blocks are sampled reproducibly from the seed
+	SGMatrix<float64_t> states_again(num_rows, num_chains);
+	states_again.set_const(-1.0);
+	std::mt19937_64 prng_again(10);
+	RBM::sample_bernoulli(mean, states_again, prng_again, 8, 48);
+
+	for (int32_t i=0; i<num_rows*num_chains; i++)
+		EXPECT_EQ(states[i], states_again[i]);
+}
@@ -0,0 +1,179 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/optimization/ParallelCostFunction.h>
+#include <shogun/optimization/lbfgs/LBFGSMinimizer.h>
+
+#include <random>
+
+using namespace shogun;
+
+/* 0.5*||w||^2+0.5*sum_i (w'x_i-y_i)^2 */
+class RidgeCostFunction : public ParallelCostFunction
+{
+public:
+	RidgeCostFunction(SGMatrix<float64_t> x, SGVector<float64_t> y)
+		: ParallelCostFunction(), m_x(x), m_y(y), m_w(x.num_rows),
+		  m_num_block_calls(0)
+	{
+		m_w.zero();
+	}
+
+	SGVector<float64_t> obtain_variable_reference() override
+	{
+		return m_w;
+	}
+
+	/* cost evaluated sample by sample */
+	float64_t get_serial_cost()
+	{
+		float64_t cost=0;
+		for (index_t j=0; j<m_w.vlen; j++)
+			cost+=0.5*Math::sq(m_w[j]);
+		for (index_t i=0; i<m_x.num_cols; i++)
+			cost+=0.5*Math::sq(residual(i));
+		return cost;
+	}
+
+	int32_t get_num_block_calls() const
+	{
+		return m_num_block_calls;
+	}
+
+	const char* get_name() const override
+	{
+		return "RidgeCostFunction";
+	}
+
+protected:
+	index_t get_num_samples() override
+	{
+		return m_x.num_cols;
+	}
+
+	float64_t get_block_cost(
+		index_t begin, index_t end, SGVector<float64_t> gradient) override
+	{
+		#pragma omp atomic
+		m_num_block_calls++;
+
+		float64_t cost=0;
+		for (index_t i=begin; i<end; i++)
+		{
+			const float64_t r=residual(i);
+			cost+=0.5*r*r;
+			for (index_t j=0; j<m_w.vlen; j++)
+				gradient[j]+=r*m_x(j, i);
+		}
+		return cost;
+	}
+
+	float64_t get_regularization(SGVector<float64_t> gradient) override
+	{
+		float64_t cost=0;
+		for (index_t j=0; j<m_w.vlen; j++)
+		{
+			cost+=0.5*Math::sq(m_w[j]);
+			gradient[j]+=m_w[j];
+		}
+		return cost;
+	}
+
+private:
+	float64_t residual(index_t i)
+	{
+		float64_t prediction=0;
+		for (index_t j=0; j<m_w.vlen; j++)
+			prediction+=m_w[j]*m_x(j, i);
+		return prediction-m_y[i];
+	}
+
+	SGMatrix<float64_t> m_x;
+	SGVector<float64_t> m_y;
+	SGVector<float64_t> m_w;
+	int32_t m_num_block_calls;
+};
+
+static std::shared_ptr<RidgeCostFunction> ridge_cost_function()
+{
+	const index_t dim=5, num=1000;
+	std::mt19937_64 prng(23);
+	std::uniform_real_distribution<float64_t> uniform(-1, 1);
+	SGMatrix<float64_t> x(dim, num);
+	SGVector<float64_t> y(num);
+	for (index_t i=0; i<num; i++)
+	{
+		for (index_t j=0; j<dim; j++)
+			x(j, i)=uniform(prng);
+		y[i]=uniform(prng);
+	}
+
+	auto fun=std::make_shared<RidgeCostFunction>(x, y);
+	fun->set_block_size(64);
+	return fun;
+}
+
+TEST(ParallelCostFunction, matches_serial_evaluation)
+{
+	auto fun=ridge_cost_function();
+	auto w=fun->obtain_variable_reference();
+	for (index_t j=0; j<w.vlen; j++)
+		w[j]=0.1*(j+1);
+
+	EXPECT_NEAR(fun->get_cost(), fun->get_serial_cost(), 1e-9);
+
+	// central differences of the serial cost
+	auto gradient=fun->get_gradient();
+	for (index_t j=0; j<w.vlen; j++)
+	{
+		const float64_t w_j=w[j];
+		w[j]=w_j+1e-6;
+		const float64_t cost_plus=fun->get_serial_cost();
+		w[j]=w_j-1e-6;
+		const float64_t cost_minus=fun->get_serial_cost();
+		w[j]=w_j;
+		EXPECT_NEAR(gradient[j], (cost_plus-cost_minus)/2e-6, 1e-4);
+	}
+}
+
+TEST(ParallelCostFunction, gradient_reuses_evaluation)
+{
+	auto fun=ridge_cost_function();
+	fun->get_cost();
+	const int32_t num_block_calls=fun->get_num_block_calls();
+	EXPECT_EQ(num_block_calls, 16);
+
+	fun->get_gradient();
+	EXPECT_EQ(fun->get_num_block_calls(), num_block_calls);
+
+	fun->obtain_variable_reference()[0]=1;
+	fun->get_gradient();
+	EXPECT_EQ(fun->get_num_block_calls(), 2*num_block_calls);
+}
+
+TEST(ParallelCostFunction, independent_of_num_threads)
+{
+	const int32_t num_threads=env()->get_num_threads();
+	SGVector<float64_t> w[2];
+	float64_t cost[2];
+	for (int32_t k=0; k<2; k++)
+	{
+		env()->set_num_threads(k==0 ? 1 : 4);
+		auto fun=ridge_cost_function();
+		LBFGSMinimizer minimizer(fun);
+		cost[k]=minimizer.minimize();
+		w[k]=fun->obtain_variable_reference();
+	}
+	env()->set_num_threads(num_threads);
+
+	EXPECT_EQ(cost[0], cost[1]);
+	for (index_t j=0; j<w[0].vlen; j++)
+		EXPECT_EQ(w[0][j], w[1][j]);
+}
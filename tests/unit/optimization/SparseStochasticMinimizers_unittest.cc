@@ -0,0 +1,217 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/optimization/ConstLearningRate.h>
+#include <shogun/optimization/ElasticNetPenalty.h>
+#include <shogun/optimization/FirstOrderSparseSAGCostFunction.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/L1Penalty.h>
+#include <shogun/optimization/L2Penalty.h>
+#include <shogun/optimization/SAGAMinimizer.h>
+#include <shogun/optimization/SVRGMinimizer.h>
+
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+/* least squares 0.5*sum_i (w'x_i-y_i)^2 on sparse samples */
+class SparseRegressionCostFunction : public FirstOrderSparseSAGCostFunction
+{
+public:
+	SparseRegressionCostFunction(
+		SGSparseMatrix<float64_t> x, SGVector<float64_t> y)
+		: m_x(x), m_y(y), m_w(x.num_features), m_idx(-1)
+	{
+		m_w.zero();
+	}
+
+	float64_t get_cost() override
+	{
+		float64_t cost=0;
+		for (index_t i=0; i<m_x.num_vectors; i++)
+			cost+=0.5*Math::sq(prediction(i)-m_y[i]);
+		return cost;
+	}
+
+	SGVector<float64_t> obtain_variable_reference() override
+	{
+		return m_w;
+	}
+
+	SGVector<float64_t> get_average_gradient() override
+	{
+		SGVector<float64_t> gradient(m_w.vlen);
+		gradient.zero();
+		for (index_t i=0; i<m_x.num_vectors; i++)
+		{
+			const float64_t d=(prediction(i)-m_y[i])/m_x.num_vectors;
+			for (index_t k=0; k<m_x[i].num_feat_entries; k++)
+				gradient[m_x[i].features[k].feat_index]+=d*m_x[i].features[k].entry;
+		}
+		return gradient;
+	}
+
+	int32_t get_sample_size() override
+	{
+		return m_x.num_vectors;
+	}
+
+	void begin_sample() override
+	{
+		m_idx=-1;
+	}
+
+	bool next_sample() override
+	{
+		return ++m_idx<m_x.num_vectors;
+	}
+
+	index_t get_sample_index() override
+	{
+		return m_idx;
+	}
+
+	SGSparseVector<float64_t> get_sample_features() override
+	{
+		return m_x[m_idx];
+	}
+
+	float64_t get_sample_derivative(float64_t prediction) override
+	{
+		return prediction-m_y[m_idx];
+	}
+
+	const char* get_name() const override
+	{
+		return "SparseRegressionCostFunction";
+	}
+
+private:
+	float64_t prediction(index_t i)
+	{
+		return m_x[i].dense_dot(1.0, m_w.vector, m_w.vlen, 0.0);
+	}
+
+	SGSparseMatrix<float64_t> m_x;
+	SGVector<float64_t> m_y;
+	SGVector<float64_t> m_w;
+	index_t m_idx;
+};
+
+/* hides the sparse interface, so minimizers take their dense path */
+class DenseRegressionCostFunction : public FirstOrderSAGCostFunction
+{
+public:
+	DenseRegressionCostFunction(std::shared_ptr<SparseRegressionCostFunction> fun)
+		: m_fun(std::move(fun))
+	{
+	}
+
+	float64_t get_cost() override { return m_fun->get_cost(); }
+	SGVector<float64_t> obtain_variable_reference() override
+	{
+		return m_fun->obtain_variable_reference();
+	}
+	SGVector<float64_t> get_gradient() override { return m_fun->get_gradient(); }
+	SGVector<float64_t> get_average_gradient() override
+	{
+		return m_fun->get_average_gradient();
+	}
+	int32_t get_sample_size() override { return m_fun->get_sample_size(); }
+	void begin_sample() override { m_fun->begin_sample(); }
+	bool next_sample() override { return m_fun->next_sample(); }
+	const char* get_name() const override { return "DenseRegressionCostFunction"; }
+
+private:
+	std::shared_ptr<SparseRegressionCostFunction> m_fun;
+};
+
+static std::shared_ptr<SparseRegressionCostFunction> sparse_regression()
+{
+	const index_t dim=30, num=40;
+	std::mt19937_64 prng(17);
+	std::uniform_real_distribution<float64_t> uniform(-1, 1);
+	std::uniform_int_distribution<index_t> feature(0, dim-1);
+	SGMatrix<float64_t> x(dim, num);
+	x.zero();
+	SGVector<float64_t> y(num);
+	for (index_t i=0; i<num; i++)
+	{
+		for (index_t k=0; k<3; k++)
+			x(feature(prng), i)=uniform(prng);
+		y[i]=uniform(prng);
+	}
+
+	return std::make_shared<SparseRegressionCostFunction>(
+		SGSparseMatrix<float64_t>(x), y);
+}
+
+static SGVector<float64_t> minimize_svrg(
+	std::shared_ptr<FirstOrderSAGCostFunction> fun,
+	std::shared_ptr<Penalty> penalty, int32_t num_passes=20)
+{
+	auto opt=std::make_shared<SVRGMinimizer>(fun);
+	opt->set_penalty_type(penalty);
+	opt->set_penalty_weight(0.1);
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.05);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(num_passes);
+	opt->set_sgd_number_passes(0);
+	opt->set_average_update_interval(2);
+	opt->minimize();
+	return fun->obtain_variable_reference();
+}
+
+TEST(SVRGMinimizer, lazy_updates_match_dense)
+{
+	auto elastic_net=std::make_shared<ElasticNetPenalty>();
+	elastic_net->set_l1_ratio(0.5);
+	std::vector<std::shared_ptr<Penalty>> penalties={
+		std::make_shared<L2Penalty>(), std::make_shared<L1Penalty>(),
+		elastic_net};
+
+	for (const auto& penalty : penalties)
+	{
+		auto fun=sparse_regression();
+		auto expected=minimize_svrg(
+			std::make_shared<DenseRegressionCostFunction>(sparse_regression()),
+			penalty);
+		auto w=minimize_svrg(fun, penalty);
+
+		ASSERT_EQ(w.vlen, expected.vlen);
+		for (index_t j=0; j<w.vlen; j++)
+			EXPECT_NEAR(w[j], expected[j], 1e-6);
+	}
+}
+
+TEST(SAGAMinimizer, converges_like_svrg)
+{
+	auto fun=sparse_regression();
+	auto opt=std::make_shared<SAGAMinimizer>(fun);
+	opt->set_penalty_type(std::make_shared<L2Penalty>());
+	opt->set_penalty_weight(0.1);
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.05);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(300);
+	opt->minimize();
+	auto w=fun->obtain_variable_reference();
+
+	/* both converge to the minimizer of the penalized least squares */
+	auto expected=minimize_svrg(
+		std::make_shared<DenseRegressionCostFunction>(sparse_regression()),
+		std::make_shared<L2Penalty>(), 300);
+	for (index_t j=0; j<w.vlen; j++)
+		EXPECT_NEAR(w[j], expected[j], 1e-3);
+}
@@ -123,6 +123,19 @@ SGVector<float64_t> CRegressionExample::get_gradient(Parameters::const_reference
 	return res;
 }
 
+SGVector<float64_t> CRegressionExample::get_sample_gradient(index_t idx, SGVector<float64_t> w)
+{
+	require(idx>=0 && idx<m_y.vlen,"out of bound");
+	SGVector<float64_t> res(w.vlen);
+
+	Map<VectorXd> e_res(res.vector,res.vlen);
+	Map<MatrixXd> e_x(m_x.matrix, m_x.num_rows, m_x.num_cols);
+	Map<VectorXd> e_w(w.vector, w.vlen);
+
+	e_res=(e_x.row(idx).dot(e_w)-m_y[idx])*e_x.row(idx).transpose();
+	return res;
+}
+
 RegressionForTestCostFunction::RegressionForTestCostFunction()
 	:FirstOrderSAGCostFunction()
 {
@@ -191,6 +204,17 @@ bool RegressionForTestCostFunction::next_sample()
 	return m_idx<m_obj->get_sample_size();
 }
 
+index_t RegressionForTestCostFunction::get_sample_index()
+{
+	return m_idx;
+}
+
+SGVector<float64_t> RegressionForTestCostFunction::get_sample_gradient(index_t idx, SGVector<float64_t> variable)
+{
+	require(m_obj,"object not set");
+	return m_obj->get_sample_gradient(idx, variable);
+}
+
 SGVector<float64_t> RegressionForTestCostFunction::obtain_variable_reference()
 {
 	require(m_obj,"object not set");
@@ -473,6 +497,56 @@ TEST(SGDMinimizer,test1)
 	EXPECT_NEAR(cost,0.491198269864709, 1e-10);
 }
 
+TEST(SGDMinimizer,minibatch)
+{
+	SGVector<float64_t> w(3);
+	w.set_const(0.0);
+
+	RegressionFixture data;
+	auto aa=std::make_shared<CRegressionExample>();
+	aa->set_x(data.x);
+	aa->set_y(data.y);
+	aa->set_init_w(w);
+	auto fun=std::make_shared<RegressionForTestCostFunction>();
+	fun->set_target(aa);
+
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.01);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_learning_rate(rate);
+
+	// a minibatch of all samples is a step of full gradient descend
+	int32_t num_passes=5;
+	opt->set_number_passes(num_passes);
+	opt->set_minibatch_size(data.y.vlen);
+	opt->minimize();
+
+	Map<MatrixXd> x(data.x.matrix, data.x.num_rows, data.x.num_cols);
+	Map<VectorXd> y(data.y.vector, data.y.vlen);
+	VectorXd expected=VectorXd::Zero(3);
+	for(int32_t i=0; i<num_passes; i++)
+		expected-=0.01*x.transpose()*(x*expected-y)/data.y.vlen;
+
+	EXPECT_EQ(opt->get_iteration_counter(), num_passes);
+	for(index_t i=0; i<w.vlen; i++)
+		EXPECT_NEAR(w[i], expected[i], 1e-10);
+
+	// asynchronous updates use gradients that are one update stale
+	float64_t initial_cost=aa->get_cost();
+	auto async_opt=std::make_shared<SGDMinimizer>(fun);
+	async_opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	async_opt->set_learning_rate(rate);
+	async_opt->set_number_passes(num_passes);
+	async_opt->set_minibatch_size(4);
+	async_opt->set_asynchronous(true);
+	float64_t cost=async_opt->minimize();
+
+	EXPECT_EQ(async_opt->get_iteration_counter(),
+		num_passes*((data.y.vlen+3)/4));
+	EXPECT_LT(cost, initial_cost);
+}
+
 TEST(SGDMinimizer,test2)
 {
 	SGVector<float64_t> w(3);
@@ -53,6 +53,8 @@ public:
 	virtual int32_t get_sample_size();
 	virtual void begin_sample();
 	virtual bool next_sample();
+	virtual index_t get_sample_index();
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx, SGVector<float64_t> variable);
 	virtual const char* get_name() const { return "RegressionForTestCostFunction"; }
 private:
 	index_t m_idx;
@@ -113,6 +115,7 @@ private:
 	int get_sample_size();
 	SGVector<float64_t> get_gradient(Parameters::const_reference param, index_t idx);
 	SGVector<float64_t> get_gradient(Parameters::const_reference param);
+	SGVector<float64_t> get_sample_gradient(index_t idx, SGVector<float64_t> w);
 	SGVector<float64_t> get_variable(Parameters::const_reference param);
 	SGMatrix<float64_t> m_x;
 	SGVector<float64_t> m_w;
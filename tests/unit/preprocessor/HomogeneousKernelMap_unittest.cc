@@ -0,0 +1,66 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/preprocessor/HomogeneousKernelMap.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(HomogeneousKernelMap, chi2_approximation)
+{
+	const index_t dim = 5;
+	const index_t num_vectors = 20;
+	const uint64_t order = 3;
+	std::mt19937_64 prng(5);
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (auto i : range(data.size()))
+		data[i] = uniform(prng);
+	// zeros and values outside of the table map to zero
+	data(0, 0) = 0;
+	data(1, 0) = 1e-12;
+
+	auto hkm = std::make_shared<HomogeneousKernelMap>(
+	    HomogeneousKernelChi2, HomogeneousKernelMapWindowRectangular, 1.0,
+	    order);
+	auto mapped = hkm->transform(std::make_shared<DenseFeatures<float64_t>>(data))
+	                  ->as<DenseFeatures<float64_t>>()
+	                  ->get_feature_matrix();
+	const index_t out_dim = dim * (2 * order + 1);
+	ASSERT_EQ(mapped.num_rows, out_dim);
+	ASSERT_EQ(mapped.num_cols, num_vectors);
+
+	for (auto k : range(2 * (2 * order + 1)))
+		EXPECT_EQ(mapped(k, 0), 0.0);
+
+	for (auto i : range(num_vectors))
+	{
+		// the matrix is mapped like the individual vectors
+		auto vec = hkm->apply_to_feature_vector(data.get_column(i));
+		for (auto k : range(out_dim))
+			EXPECT_DOUBLE_EQ(mapped(k, i), vec[k]);
+
+		for (auto j : range(num_vectors))
+		{
+			float64_t chi2 = 0;
+			for (auto k : range(dim))
+			{
+				const float64_t x = data(k, i);
+				const float64_t y = data(k, j);
+				if (x + y > 0)
+					chi2 += 2 * x * y / (x + y);
+			}
+			float64_t approx = 0;
+			for (auto k : range(out_dim))
+				approx += mapped(k, i) * mapped(k, j);
+			EXPECT_NEAR(approx, chi2, 5e-3);
+		}
+	}
+}
@@ -7,6 +7,10 @@
 #include <shogun/preprocessor/KernelPCA.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <cmath>
+#include <random>
 
 
 using ::testing::Test;
@@ -101,3 +105,83 @@ TEST(KernelPCA, apply_to_feature_vector)
 
 
 }
+
+TEST(KernelPCA, nystrom_with_all_landmarks_is_exact)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	auto train_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(train_matrix);
+	auto test_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(test_matrix);
+
+	auto kernel = std::make_shared<GaussianKernel>();
+	kernel->set_width(1);
+
+	auto kpca = std::make_shared<KernelPCA>(kernel);
+	kpca->set_target_dim(target_dim);
+	kpca->set_method(KPCA_NYSTROM);
+	kpca->set_num_landmarks(num_vectors);
+	kpca->fit(train_feats);
+
+	SGMatrix<float64_t> embedding = kpca->transform(test_feats)
+	                                    ->as<DenseFeatures<float64_t>>()
+	                                    ->get_feature_matrix();
+
+	ASSERT_EQ(embedding.num_rows, target_dim);
+	ASSERT_EQ(embedding.num_cols, num_test_vectors);
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(Math::abs(embedding[i]), Math::abs(resdata[i]), 1E-6);
+}
+
+TEST(KernelPCA, nystrom_approximates_exact)
+{
+	const index_t n = 300;
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal;
+
+	// two well separated clusters, the leading component separates them
+	SGMatrix<float64_t> data(2, n);
+	for (index_t i = 0; i < n; ++i)
+	{
+		data(0, i) = normal(prng) * 0.5 + (i % 2 ? 3 : -3);
+		data(1, i) = normal(prng) * 0.5;
+	}
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto exact = std::make_shared<KernelPCA>(std::make_shared<GaussianKernel>(8.0));
+	exact->set_target_dim(1);
+	exact->fit(feats);
+	auto exact_embedding = exact->transform(feats)
+	                           ->as<DenseFeatures<float64_t>>()
+	                           ->get_feature_matrix();
+
+	auto nystrom = std::make_shared<KernelPCA>(std::make_shared<GaussianKernel>(8.0));
+	nystrom->set_target_dim(1);
+	nystrom->set_method(KPCA_NYSTROM);
+	nystrom->set_num_landmarks(40);
+	nystrom->put("seed", 3);
+	nystrom->fit(feats);
+	auto nystrom_embedding = nystrom->transform(feats)
+	                             ->as<DenseFeatures<float64_t>>()
+	                             ->get_feature_matrix();
+
+	ASSERT_EQ(nystrom_embedding.num_rows, 1);
+	ASSERT_EQ(nystrom_embedding.num_cols, n);
+
+	float64_t dot = 0, norm_exact = 0, norm_nystrom = 0;
+	for (index_t i = 0; i < n; ++i)
+	{
+		dot += exact_embedding[i] * nystrom_embedding[i];
+		norm_exact += exact_embedding[i] * exact_embedding[i];
+		norm_nystrom += nystrom_embedding[i] * nystrom_embedding[i];
+	}
+	// same component up to the sign, with about the same variance
+	EXPECT_GT(Math::abs(dot) / std::sqrt(norm_exact * norm_nystrom), 0.99);
+	EXPECT_NEAR(norm_nystrom / norm_exact, 1.0, 0.05);
+}
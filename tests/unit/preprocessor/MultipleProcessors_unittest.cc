@@ -7,6 +7,9 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/preprocessor/LogPlusOne.h>
+#include <shogun/preprocessor/NormOne.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+#include <shogun/preprocessor/RescaleFeatures.h>
 #include <shogun/preprocessor/SumOne.h>
 #include <shogun/lib/SGVector.h>
 
@@ -42,3 +45,101 @@ TEST(MultipleProcessors, transform)
 
 
 }
+
+class FusedPreprocessors : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		// the second feature is constant and gets pruned
+		data = SGMatrix<float64_t>(3, 50);
+		for (index_t i = 0; i < data.num_cols; i++)
+		{
+			data(0, i) = i % 7 + 1;
+			data(1, i) = 2;
+			data(2, i) = (i * 13) % 11 + 0.5;
+		}
+
+		preprocessors = {std::make_shared<PruneVarSubMean>(),
+		                 std::make_shared<RescaleFeatures>(),
+		                 std::make_shared<NormOne>(),
+		                 std::make_shared<LogPlusOne>()};
+
+		// fit on the output of the previous preprocessors and transform
+		// one after the other
+		std::shared_ptr<Features> feats =
+		    std::make_shared<DenseFeatures<float64_t>>(data.clone());
+		for (const auto& p : preprocessors)
+		{
+			p->fit(feats);
+			feats = p->transform(feats, false);
+		}
+		expected = feats->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> attached() const
+	{
+		auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+		for (const auto& p : preprocessors)
+			feats->add_preprocessor(p);
+		return feats;
+	}
+
+	SGMatrix<float64_t> data;
+	std::vector<std::shared_ptr<DensePreprocessor<float64_t>>> preprocessors;
+	SGMatrix<float64_t> expected;
+};
+
+TEST_F(FusedPreprocessors, on_access)
+{
+	ASSERT_EQ(expected.num_rows, 2);
+	for (const auto& p : preprocessors)
+		EXPECT_TRUE(p->supports_in_place());
+
+	auto feats = attached();
+	for (index_t i = 0; i < data.num_cols; i++)
+	{
+		auto v = feats->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, expected.num_rows);
+		for (index_t j = 0; j < v.vlen; j++)
+			EXPECT_NEAR(v[j], expected(j, i), 1e-12);
+	}
+
+	// the matrix is not modified
+	EXPECT_EQ(data(1, 0), 2);
+}
+
+TEST_F(FusedPreprocessors, apply_preprocessors)
+{
+	auto feats = attached();
+	feats->apply_preprocessors();
+
+	EXPECT_EQ(feats->get_num_preprocessors(), 0);
+	EXPECT_EQ(feats->get_num_features(), expected.num_rows);
+	auto matrix = feats->get_feature_matrix();
+	ASSERT_EQ(matrix.num_cols, data.num_cols);
+	for (index_t i = 0; i < matrix.num_cols; i++)
+		for (index_t j = 0; j < matrix.num_rows; j++)
+			EXPECT_NEAR(matrix(j, i), expected(j, i), 1e-12);
+}
+
+TEST_F(FusedPreprocessors, mixed_with_allocating)
+{
+	// SumOne has no in place version, the chain falls back to applying
+	// the preprocessors one after the other
+	auto sum1 = std::make_shared<SumOne>();
+	auto feats = attached();
+	feats->add_preprocessor(sum1);
+	EXPECT_FALSE(sum1->supports_in_place());
+
+	for (index_t i = 0; i < data.num_cols; i++)
+	{
+		auto v = feats->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, expected.num_rows);
+		float64_t sum = 0;
+		for (index_t j = 0; j < v.vlen; j++)
+			sum += expected(j, i);
+		for (index_t j = 0; j < v.vlen; j++)
+			EXPECT_NEAR(v[j], expected(j, i) / sum, 1e-12);
+	}
+}
@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -603,3 +604,117 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+TEST(PCA, PCA_RANDOMIZED)
+{
+	SGMatrix<float64_t> data(3,5);
+	data(0,0)=2.908008030729362;
+	data(0,1)=-1.058180257987362;
+	data(0,2)=1.098424617888623;
+	data(0,3)=-2.051816299911149;
+	data(0,4)=-1.577057022799202;
+	data(1,0)=0.825218894228491;
+	data(1,1)=-0.468615581100624;
+	data(1,2)=-0.277871932787639;
+	data(1,3)=-0.353849997774433;
+	data(1,4)=0.507974650905946;
+	data(2,0)=1.378971977916614;
+	data(2,1)=-0.272469409250187;
+	data(2,2)=0.701541458163284;
+	data(2,3)=-0.823586525156853;
+	data(2,4)=0.281984063670556;
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto pca = std::make_shared<PCA>(RANDOMIZED);
+	pca->put("seed", 17);
+	pca->set_target_dim(2);
+	pca->fit(features);
+
+	auto transmat = pca->get_transformation_matrix();
+	auto eigvec = pca->get_eigenvalues();
+	ASSERT_EQ(eigvec.vlen, 2);
+	ASSERT_EQ(transmat.num_cols, 2);
+
+	// the oversampled range covers all of the data, so the result is exact
+	float64_t epsilon = 1e-12;
+	EXPECT_NEAR(5.077526030285309,eigvec[0],epsilon);
+	EXPECT_NEAR(0.291219269837891,eigvec[1],epsilon);
+
+	SGVector<float64_t> ev0(3), ev1(3);
+	ev0[0]=0.922117955764778;
+	ev0[1]=0.151048915673366;
+	ev0[2]=0.356205980761254;
+	ev1[0]=-0.304406370622002;
+	ev1[1]=0.851501730295596;
+	ev1[2]=0.426944451689378;
+	check_eigenvector_eq(transmat.get_column(0), ev0, epsilon);
+	check_eigenvector_eq(transmat.get_column(1), ev1, epsilon);
+
+	// only a fixed number of components can be computed
+	pca = std::make_shared<PCA>(false, VARIANCE_EXPLAINED, 0.9, RANDOMIZED);
+	EXPECT_THROW(pca->fit(features), ShogunException);
+}
+
+TEST(PCA, PCA_INCREMENTAL)
+{
+	const index_t num_features = 5;
+	const index_t num_vectors = 60;
+	// three latent signals, so the truncated updates lose nothing
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t j = 0; j < num_vectors; ++j)
+		for (index_t i = 0; i < num_features; ++i)
+			data(i, j) = 0.1 * i + 3.0 * std::sin(0.3 * j) * (i + 1) +
+			             2.0 * std::cos(1.1 * j) * (i % 2) +
+			             std::sin(2.3 * j + 1.0) * (num_features - i);
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto batch = std::make_shared<PCA>(SVD);
+	batch->set_target_dim(3);
+	batch->fit(features);
+
+	auto incremental = std::make_shared<PCA>(SVD);
+	incremental->set_target_dim(3);
+	for (index_t start = 0; start < num_vectors; start += 25)
+	{
+		index_t size = std::min<index_t>(25, num_vectors - start);
+		SGMatrix<float64_t> chunk(num_features, size);
+		for (index_t j = 0; j < size; ++j)
+			for (index_t i = 0; i < num_features; ++i)
+				chunk(i, j) = data(i, start + j);
+		incremental->partial_fit(chunk);
+	}
+
+	// streaming fit in chunks reads the same vectors
+	auto streamed = std::make_shared<PCA>(SVD);
+	streamed->set_target_dim(3);
+	streamed->put("chunk_size", 7);
+	streamed->fit(
+	    std::make_shared<StreamingDenseFeatures<float64_t>>(features));
+
+	float64_t epsilon = 1e-9;
+	auto batch_transmat = batch->get_transformation_matrix();
+	auto batch_eigvals = batch->get_eigenvalues();
+	auto batch_mean = batch->get_mean();
+	for (auto pca : {incremental, streamed})
+	{
+		auto transmat = pca->get_transformation_matrix();
+		auto eigvals = pca->get_eigenvalues();
+		auto mean = pca->get_mean();
+		ASSERT_EQ(transmat.num_rows, num_features);
+		ASSERT_EQ(transmat.num_cols, 3);
+		ASSERT_EQ(eigvals.vlen, 3);
+
+		for (index_t i = 0; i < num_features; ++i)
+			EXPECT_NEAR(batch_mean[i], mean[i], epsilon);
+		for (index_t k = 0; k < 3; ++k)
+		{
+			EXPECT_NEAR(batch_eigvals[k], eigvals[k], epsilon);
+			check_eigenvector_eq(
+			    transmat.get_column(k), batch_transmat.get_column(k), 1e-7);
+		}
+	}
+
+	// the incremental state is only kept for a fixed number of components
+	auto variance = std::make_shared<PCA>(false, VARIANCE_EXPLAINED, 0.9);
+	EXPECT_THROW(variance->partial_fit(data), ShogunException);
+}
@@ -0,0 +1,41 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/preprocessor/PruneVarSubMean.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+TEST(PruneVarSubMean, transform)
+{
+	// the second feature is constant and removed
+	const index_t num_vectors = 4;
+	SGMatrix<float64_t> data(3, num_vectors);
+	for (auto i : range(num_vectors))
+	{
+		data(0, i) = i;
+		data(1, i) = 5;
+		data(2, i) = 10.0 * (i % 2);
+	}
+
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data.clone());
+	auto preproc = std::make_shared<PruneVarSubMean>(true);
+	preproc->fit(feats);
+	auto result = preproc->transform(feats)->as<DenseFeatures<float64_t>>();
+	auto matrix = result->get_feature_matrix();
+
+	ASSERT_EQ(matrix.num_rows, 2);
+	ASSERT_EQ(matrix.num_cols, num_vectors);
+	const float64_t std_0 = std::sqrt(1.25);
+	for (auto i : range(num_vectors))
+	{
+		EXPECT_NEAR(matrix(0, i), (i - 1.5) / std_0, 1e-12);
+		EXPECT_NEAR(matrix(1, i), i % 2 ? 1.0 : -1.0, 1e-12);
+	}
+}
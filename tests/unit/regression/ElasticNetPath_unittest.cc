@@ -0,0 +1,170 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/regression/ElasticNetPath.h>
+
+#include <random>
+
+using namespace Eigen;
+using namespace shogun;
+
+class ElasticNetPathTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::mt19937_64 prng(23);
+		NormalDistribution<float64_t> normal;
+
+		// few relevant features out of many more features than vectors
+		data = SGMatrix<float64_t>(num_features, num_vectors);
+		for (auto& x : data)
+			x = normal(prng);
+		lab = SGVector<float64_t>(num_vectors);
+		for (auto i : range(num_vectors))
+			lab[i] = 3 * data(1, i) - 2 * data(7, i) + data(20, i) + 5 +
+			         0.1 * normal(prng);
+
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		labels = std::make_shared<RegressionLabels>(lab);
+	}
+
+	/** largest violation of the optimality conditions along the path */
+	float64_t max_kkt_violation(
+	    const std::shared_ptr<ElasticNetPath>& path, float64_t l1_ratio)
+	{
+		Map<MatrixXd> X(data.matrix, num_features, num_vectors);
+		Map<VectorXd> y(lab.vector, num_vectors);
+		auto lambdas = path->get_lambdas();
+
+		float64_t violation = 0;
+		for (auto k : range(path->get_path_size()))
+		{
+			auto w = path->get_w_for_lambda(k);
+			Map<VectorXd> beta(w.vector, w.vlen);
+			VectorXd residual = y - X.transpose() * beta;
+			residual.array() -= path->get_bias_for_lambda(k);
+			EXPECT_NEAR(residual.sum(), 0, 1e-8);
+
+			VectorXd corr = X * residual / num_vectors;
+			for (auto j : range(num_features))
+			{
+				const float64_t l1 = l1_ratio * lambdas[k];
+				const float64_t l2 = (1 - l1_ratio) * lambdas[k];
+				if (beta[j] != 0)
+					violation = std::max(
+					    violation, std::abs(
+					                   corr[j] - l2 * beta[j] -
+					                   l1 * Math::sign(beta[j])));
+				else
+					violation =
+					    std::max(violation, std::abs(corr[j]) - l1);
+			}
+		}
+		return violation;
+	}
+
+	const int32_t num_features = 300;
+	const int32_t num_vectors = 60;
+	SGMatrix<float64_t> data;
+	SGVector<float64_t> lab;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<RegressionLabels> labels;
+};
+
+TEST_F(ElasticNetPathTest, optimality_along_path)
+{
+	auto path = std::make_shared<ElasticNetPath>(0.7);
+	path->put("num_lambdas", 50);
+	path->put("tolerance", 1e-14);
+	path->set_labels(labels);
+	path->train(features);
+
+	EXPECT_EQ(path->get_path_size(), 50);
+	auto lambdas = path->get_lambdas();
+	for (auto k : range(1, lambdas.vlen))
+		EXPECT_LT(lambdas[k], lambdas[k - 1]);
+
+	// nothing is selected at the largest constant
+	auto w_first = path->get_w_for_lambda(0);
+	for (auto w_i : w_first)
+		EXPECT_EQ(w_i, 0);
+	EXPECT_EQ(w_first.vlen, num_features);
+	EXPECT_LT(max_kkt_violation(path, 0.7), 1e-6);
+
+	// the last estimator is the default one and finds the relevant features
+	auto w = path->get_w();
+	EXPECT_NEAR(w[1], 3, 0.2);
+	EXPECT_NEAR(w[7], -2, 0.2);
+	EXPECT_NEAR(w[20], 1, 0.2);
+	EXPECT_NEAR(path->get_bias(), 5, 0.2);
+}
+
+TEST_F(ElasticNetPathTest, strong_rules_do_not_change_path)
+{
+	auto screened = std::make_shared<ElasticNetPath>();
+	screened->put("num_lambdas", 30);
+	screened->put("tolerance", 1e-14);
+	screened->set_labels(labels);
+	screened->train(features);
+
+	auto full = std::make_shared<ElasticNetPath>();
+	full->put("num_lambdas", 30);
+	full->put("tolerance", 1e-14);
+	full->put("strong_rules", false);
+	full->set_labels(labels);
+	full->train(features);
+
+	ASSERT_EQ(screened->get_path_size(), full->get_path_size());
+	for (auto k : range(full->get_path_size()))
+	{
+		auto w_screened = screened->get_w_for_lambda(k);
+		auto w_full = full->get_w_for_lambda(k);
+		for (auto j : range(num_features))
+			EXPECT_NEAR(w_screened[j], w_full[j], 1e-8);
+	}
+	EXPECT_LT(max_kkt_violation(screened, 1), 1e-6);
+}
+
+TEST_F(ElasticNetPathTest, early_stop_max_nonz)
+{
+	auto path = std::make_shared<ElasticNetPath>();
+	path->put("max_nonz", 2);
+	path->set_labels(labels);
+	path->train(features);
+
+	EXPECT_LT(path->get_path_size(), 100);
+	int32_t nonz = 0;
+	for (auto w_i : path->get_w())
+		nonz += w_i != 0;
+	EXPECT_GE(nonz, 2);
+}
+
+TEST_F(ElasticNetPathTest, given_lambdas)
+{
+	auto path = std::make_shared<ElasticNetPath>();
+	path->put("lambdas", SGVector<float64_t>({1.0, 0.5, 0.1}));
+	path->set_labels(labels);
+	path->train(features);
+
+	EXPECT_EQ(path->get_path_size(), 3);
+	EXPECT_EQ(path->get_lambdas()[2], 0.1);
+
+	path->switch_w(1);
+	auto w = path->get_w();
+	auto w_1 = path->get_w_for_lambda(1);
+	for (auto j : range(num_features))
+		EXPECT_EQ(w[j], w_1[j]);
+	EXPECT_EQ(path->get_bias(), path->get_bias_for_lambda(1));
+
+	path->put("lambdas", SGVector<float64_t>({0.1, 0.5}));
+	EXPECT_THROW(path->train(features), ShogunException);
+}
@@ -0,0 +1,96 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/lib/config.h>
+
+#ifdef USE_SVMLIGHT
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/regression/svr/LibSVR.h>
+#include <shogun/regression/svr/SVRLight.h>
+
+#include <cmath>
+#include <random>
+
+using namespace shogun;
+
+namespace
+{
+	/** train SVRLight and LibSVR on the same problem and compare the
+	 * predictions on the training data */
+	void expect_same_as_libsvr(
+	    std::shared_ptr<Kernel> kernel, std::shared_ptr<Features> features,
+	    std::shared_ptr<RegressionLabels> labels)
+	{
+		const float64_t C = 1;
+		const float64_t tube_epsilon = 0.1;
+
+		auto svr_light =
+		    std::make_shared<SVRLight>(C, tube_epsilon, kernel, labels);
+		svr_light->set_epsilon(1e-5);
+		svr_light->train(features);
+		auto light_output =
+		    svr_light->apply(features)->as<RegressionLabels>()->get_labels();
+
+		auto libsvr = std::make_shared<LibSVR>(
+		    C, tube_epsilon, kernel, labels, LIBSVR_EPSILON_SVR);
+		libsvr->set_epsilon(1e-5);
+		libsvr->train(features);
+		auto libsvr_output =
+		    libsvr->apply(features)->as<RegressionLabels>()->get_labels();
+
+		for (auto i : range(light_output.vlen))
+			EXPECT_NEAR(light_output[i], libsvr_output[i], 1e-2);
+	}
+} // namespace
+
+TEST(SVRLight, gaussian_kernel_small_cache)
+{
+	// more rows than fit into the smallest kernel cache of 10MB, so rows
+	// are evicted and the cache is shrunk
+	const index_t n = 1500;
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(1, n);
+	SGVector<float64_t> lab(n);
+	for (auto i : range(n))
+	{
+		data(0, i) = 6.0 * i / n - 3;
+		lab[i] = std::sin(data(0, i)) + 0.1 * normal(prng);
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto kernel = std::make_shared<GaussianKernel>(1.0);
+	kernel->set_cache_size(10);
+
+	expect_same_as_libsvr(
+	    kernel, features, std::make_shared<RegressionLabels>(lab));
+}
+
+TEST(SVRLight, linear_kernel_linadd)
+{
+	const index_t n = 200;
+	std::mt19937_64 prng(3);
+	NormalDistribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(2, n);
+	SGVector<float64_t> lab(n);
+	for (auto i : range(n))
+	{
+		data(0, i) = normal(prng);
+		data(1, i) = normal(prng);
+		lab[i] = 2 * data(0, i) - data(1, i) + 0.5 + 0.1 * normal(prng);
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	expect_same_as_libsvr(
+	    std::make_shared<LinearKernel>(), features,
+	    std::make_shared<RegressionLabels>(lab));
+}
+#endif // USE_SVMLIGHT
@@ -445,6 +445,48 @@ TEST(LeastAngleRegression, ols_equivalence)
 }
 #endif
 
+TEST(LeastAngleRegression, gram_mode_same_path)
+{
+	int32_t seed = 131;
+	std::mt19937_64 prng(seed);
+	UniformRealDistribution<float64_t> uniform_real_dist(-1.0, 1.0);
+
+	int32_t n_feat=20, n_vec=50;
+	SGMatrix<float64_t> data(n_feat, n_vec);
+	for (auto& x : data)
+		x = uniform_real_dist(prng);
+	SGVector<float64_t> lab(n_vec);
+	for (index_t i=0; i<n_vec; i++)
+		lab[i] = 2*data(3, i) - data(11, i) + 0.1*uniform_real_dist(prng);
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<RegressionLabels>(lab);
+
+	auto gram = std::make_shared<LeastAngleRegression>();
+	gram->put("gram_mode", LARS_GRAM_PRECOMPUTE);
+	gram->set_labels(labels);
+	gram->train(features);
+
+	auto no_gram = std::make_shared<LeastAngleRegression>();
+	no_gram->put("gram_mode", LARS_GRAM_NEVER);
+	no_gram->set_labels(labels);
+	no_gram->train(features);
+
+	ASSERT_EQ(gram->get_path_size(), no_gram->get_path_size());
+	for (index_t i=0; i<gram->get_path_size(); i++)
+	{
+		SGVector<float64_t> w_gram = gram->get_w_for_var(i);
+		SGVector<float64_t> w_no_gram = no_gram->get_w_for_var(i);
+		for (index_t j=0; j<n_feat; j++)
+			EXPECT_NEAR(w_gram[j], w_no_gram[j], 1E-10);
+	}
+
+	// stops once the requested number of variables is active
+	no_gram->put("max_nonz", 5);
+	no_gram->train(features);
+	EXPECT_EQ(no_gram->get_path_size(), 6);
+}
+
 TEST(LeastAngleRegression, early_stop_l1_norm)
 {
 	SGMatrix<float64_t> data(3,5);
@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/LinearKernel.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
 #include <shogun/statistical_testing/TestEnums.h>
@@ -152,6 +153,48 @@ TEST(
 	EXPECT_NO_THROW(mmd->select_kernel());
 }
 
+TEST(KernelSelectionMaxMMD, quadratic_time_mixed_distance_types)
+{
+	const int32_t seed=2;
+	const index_t m=8;
+	const index_t n=12;
+	const index_t dim=2;
+	const float64_t difference=0.5;
+	const index_t num_kernels=6;
+
+	auto gen_p=std::make_shared<MeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=std::make_shared<MeanShiftDataGenerator>(difference, dim, 0);
+	gen_p->put("seed", seed);
+	gen_q->put("seed", seed);
+
+	auto mmd=std::make_shared<QuadraticTimeMMD>();
+	mmd->set_p(gen_p->get_streamed_features(m));
+	mmd->set_q(gen_q->get_streamed_features(n));
+	mmd->set_statistic_type(ST_BIASED_FULL);
+
+	// gaussian kernels share one distance, the linear kernel is evaluated on
+	// its own, all of them have to get the same measure as when evaluated
+	// one by one
+	std::vector<std::shared_ptr<Kernel>> kernels;
+	for (auto i=0, sigma=-3; i<num_kernels-1; ++i, sigma+=1)
+		kernels.push_back(std::make_shared<GaussianKernel>(10, pow(2, sigma)));
+	kernels.insert(kernels.begin()+2, std::make_shared<LinearKernel>());
+
+	auto strategy=std::make_shared<KernelSelectionStrategy>(KSM_MAXIMIZE_MMD);
+	for (const auto& kernel : kernels)
+		strategy->add_kernel(kernel);
+	strategy->select_kernel(mmd);
+	auto measures=strategy->get_measure_vector();
+	ASSERT_EQ(measures.size(), num_kernels);
+
+	for (auto i=0; i<num_kernels; ++i)
+	{
+		mmd->set_kernel(kernels[i]);
+		EXPECT_NEAR(measures[i], mmd->compute_statistic(), 1E-4);
+		mmd->cleanup();
+	}
+}
+
 #ifdef USE_GPL_SHOGUN
 TEST(KernelSelectionMaxMMD, linear_time_weighted_kernel_streaming)
 {
@@ -30,11 +30,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/streaming/generators/MeanShiftDataGenerator.h>
 #include <shogun/statistical_testing/TestEnums.h>
 #include <shogun/statistical_testing/LinearTimeMMD.h>
+#include <shogun/statistical_testing/QuadraticTimeMMD.h>
 
 using namespace shogun;
 
@@ -441,3 +444,85 @@ TEST(LinearTimeMMD, perform_test_gaussian_unbiased_incomplete)
 	float64_t p_value_gaussian=mmd->compute_p_value(mmd->compute_statistic());
 	EXPECT_NEAR(p_value_gaussian, 0.46123518919938689, 1E-6);
 }
+
+TEST(LinearTimeMMD, online_statistic)
+{
+	const int32_t seed=12345;
+	const index_t m=8;
+	const index_t n=12;
+	const index_t dim=2;
+	const index_t num_blocks=4;
+
+	auto gen_p=std::make_shared<MeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=std::make_shared<MeanShiftDataGenerator>(0.5, dim, 0);
+	gen_p->put("seed", seed);
+	gen_q->put("seed", seed);
+	auto kernel=std::make_shared<GaussianKernel>(10, 2);
+
+	auto mmd=std::make_shared<LinearTimeMMD>();
+	mmd->set_kernel(kernel);
+	mmd->set_statistic_type(ST_UNBIASED_FULL);
+
+	std::vector<float64_t> statistics;
+	for (auto i=0; i<num_blocks; ++i)
+	{
+		auto block_p=gen_p->get_streamed_features(m);
+		auto block_q=gen_q->get_streamed_features(n);
+		mmd->update_online(block_p, block_q);
+
+		// the statistic of a block is its quadratic time statistic
+		auto block_mmd=std::make_shared<QuadraticTimeMMD>();
+		block_mmd->set_statistic_type(ST_UNBIASED_FULL);
+		block_mmd->set_p(block_p);
+		block_mmd->set_q(block_q);
+		block_mmd->set_kernel(kernel);
+		statistics.push_back(block_mmd->compute_statistic()*(m+n)/m/n);
+	}
+
+	float64_t mean=std::accumulate(statistics.begin(), statistics.end(), 0.0)/num_blocks;
+	float64_t variance=0;
+	for (auto statistic : statistics)
+		variance+=(statistic-mean)*(statistic-mean)/(num_blocks-1);
+
+	EXPECT_EQ(mmd->get_online_num_blocks(), num_blocks);
+	EXPECT_NEAR(mmd->get_online_statistic(), mean, 1E-5);
+	EXPECT_NEAR(mmd->get_online_variance(), variance, 1E-5);
+
+	mmd->reset_online();
+	EXPECT_EQ(mmd->get_online_num_blocks(), 0);
+	EXPECT_EQ(mmd->get_online_statistic(), 0);
+	EXPECT_EQ(mmd->get_online_p_value(), 1);
+}
+
+TEST(LinearTimeMMD, online_p_value)
+{
+	const int32_t seed=12345;
+	const index_t block_size=16;
+	const index_t dim=2;
+	const index_t num_blocks=50;
+
+	auto gen_p=std::make_shared<MeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=std::make_shared<MeanShiftDataGenerator>(3, dim, 0);
+	gen_p->put("seed", seed);
+	gen_q->put("seed", seed);
+
+	auto mmd=std::make_shared<LinearTimeMMD>();
+	mmd->set_kernel(std::make_shared<GaussianKernel>(10, 8));
+	mmd->set_statistic_type(ST_UNBIASED_FULL);
+	mmd->set_online_mixture_blocks(20);
+
+	float64_t last_p_value=1;
+	for (auto i=0; i<num_blocks; ++i)
+	{
+		mmd->update_online(gen_p->get_streamed_features(block_size),
+			gen_q->get_streamed_features(block_size));
+		auto p_value=mmd->get_online_p_value();
+		// anytime-valid p-values never increase
+		EXPECT_LE(p_value, last_p_value);
+		last_p_value=p_value;
+	}
+	EXPECT_LT(last_p_value, 0.01);
+
+	mmd->set_statistic_type(ST_BIASED_FULL);
+	EXPECT_THROW(mmd->get_online_p_value(), ShogunException);
+}
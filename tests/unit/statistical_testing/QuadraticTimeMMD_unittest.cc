@@ -283,6 +283,10 @@ TEST(QuadraticTimeMMD, compute_variance_h0)
 
 	float64_t var=mmd->compute_variance_h0();
 	EXPECT_NEAR(var, 0.0042963027954101562, FLT_EPSILON);
+
+	mmd->precompute_kernel_matrix(false);
+	var=mmd->compute_variance_h0();
+	EXPECT_NEAR(var, 0.0042963027954101562, 1E-6);
 }
 
 TEST(QuadraticTimeMMD, compute_variance_h1)
@@ -545,6 +549,59 @@ TEST(QuadraticTimeMMD, precomputed_vs_nonprecomputed)
 		EXPECT_NEAR(result_1[i], result_2[i], 1E-6);
 }
 
+TEST(QuadraticTimeMMD, precomputed_vs_blocked)
+{
+	const int32_t seed=12345;
+	// more samples than fit into one block of the kernel matrix
+	const index_t m=300;
+	const index_t n=300;
+	const index_t dim=3;
+	const index_t num_null_samples=5;
+
+	auto gen_p=std::make_shared<MeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=std::make_shared<MeanShiftDataGenerator>(0.5, dim, 0);
+	gen_p->put("seed", seed);
+	gen_q->put("seed", seed);
+	auto features_p=gen_p->get_streamed_features(m);
+	auto features_q=gen_q->get_streamed_features(n);
+
+	auto kernel=std::make_shared<GaussianKernel>(10, 2.0);
+	auto mmd=std::make_shared<QuadraticTimeMMD>();
+	mmd->set_p(features_p);
+	mmd->set_q(features_q);
+	mmd->set_kernel(kernel);
+	mmd->set_num_null_samples(num_null_samples);
+	mmd->set_null_approximation_method(NAM_PERMUTATION);
+
+	for (auto stype : {ST_BIASED_FULL, ST_UNBIASED_FULL, ST_UNBIASED_INCOMPLETE})
+	{
+		mmd->set_statistic_type(stype);
+		mmd->precompute_kernel_matrix(true);
+		auto statistic_1=mmd->compute_statistic();
+		mmd->put("seed", seed);
+		auto null_samples_1=mmd->sample_null();
+
+		mmd->precompute_kernel_matrix(false);
+		auto statistic_2=mmd->compute_statistic();
+		mmd->put("seed", seed);
+		auto null_samples_2=mmd->sample_null();
+
+		EXPECT_NEAR(statistic_1, statistic_2, 1E-5);
+		ASSERT_EQ(null_samples_1.size(), null_samples_2.size());
+		for (auto i=0; i<null_samples_1.size(); ++i)
+			EXPECT_NEAR(null_samples_1[i], null_samples_2[i], 1E-5);
+	}
+
+	mmd->precompute_kernel_matrix(true);
+	auto var_h0_1=mmd->compute_variance_h0();
+	auto var_h1_1=mmd->compute_variance_h1();
+	mmd->precompute_kernel_matrix(false);
+	auto var_h0_2=mmd->compute_variance_h0();
+	auto var_h1_2=mmd->compute_variance_h1();
+	EXPECT_NEAR(var_h0_1, var_h0_2, 1E-6);
+	EXPECT_NEAR(var_h1_1, var_h1_2, 1E-6);
+}
+
 TEST(QuadraticTimeMMD, multikernel_compute_statistic)
 {
 	const int32_t seed=1;
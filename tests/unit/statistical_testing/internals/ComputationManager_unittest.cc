@@ -0,0 +1,96 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/statistical_testing/TestEnums.h>
+#include <shogun/statistical_testing/internals/ComputationManager.h>
+#include <shogun/statistical_testing/internals/mmd/ComputeMMD.h>
+#include <shogun/statistical_testing/internals/mmd/WithinBlockDirect.h>
+
+using namespace shogun;
+using namespace internal;
+
+namespace
+{
+SGMatrix<float32_t> kernel_matrix(index_t n, index_t m)
+{
+	const index_t dim=2;
+	SGMatrix<float64_t> data_p(dim, n);
+	std::iota(data_p.matrix, data_p.matrix+dim*n, 1);
+	std::for_each(data_p.matrix, data_p.matrix+dim*n, [&n](float64_t& val) { val/=n; });
+
+	SGMatrix<float64_t> data_q(dim, m);
+	std::iota(data_q.matrix, data_q.matrix+dim*m, n+1);
+	std::for_each(data_q.matrix, data_q.matrix+dim*m, [&m](float64_t& val) { val/=2*m; });
+
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+	auto feats=feats_p->create_merged_copy(feats_q);
+
+	auto kernel=std::make_shared<GaussianKernel>();
+	kernel->set_width(2.0);
+	kernel->init(feats, feats);
+	return kernel->get_kernel_matrix<float32_t>();
+}
+}
+
+TEST(ComputationManager, gpu_jobs_same_result)
+{
+	const index_t n=13;
+	const index_t m=7;
+	auto mat=kernel_matrix(n, m);
+
+	// without a GPU backend the device matrix is the host matrix, which
+	// runs the GPU variants of the jobs on the CPU
+	for (auto stype : {ST_BIASED_FULL, ST_UNBIASED_FULL})
+	{
+		auto mmd=mmd::ComputeMMD();
+		mmd.m_n_x=n;
+		mmd.m_n_y=m;
+		mmd.m_stype=stype;
+		EXPECT_NEAR(mmd.compute_using_gpu(mat, mat), mmd(mat), 1E-5);
+	}
+
+	auto block=kernel_matrix(10, 10);
+	mmd::WithinBlockDirect direct;
+	EXPECT_NEAR(direct.compute_using_gpu(block, block), direct(block), 1E-5);
+}
+
+TEST(ComputationManager, use_gpu_without_backend)
+{
+	const index_t n=10;
+	auto mmd=mmd::ComputeMMD();
+	mmd.m_n_x=n;
+	mmd.m_n_y=n;
+	auto gpu_job=[mmd](const SGMatrix<float32_t>& km, const SGMatrix<float32_t>& device_km)
+	{
+		return mmd.compute_using_gpu(km, device_km);
+	};
+
+	ComputationManager cm;
+	cm.num_data(2);
+	cm.data(0)=kernel_matrix(n, n);
+	cm.data(1)=kernel_matrix(n, n);
+	cm.enqueue_job(mmd, gpu_job);
+	cm.enqueue_job(mmd::WithinBlockDirect());
+
+	cm.use_cpu().compute_data_parallel_jobs();
+	auto statistic=cm.result(0);
+	auto variance=cm.result(1);
+
+	cm.use_gpu().compute_data_parallel_jobs();
+	for (auto i=0; i<2; ++i)
+	{
+		EXPECT_NEAR(cm.result(0)[i], statistic[i], 1E-5);
+		EXPECT_NEAR(cm.result(1)[i], variance[i], 1E-5);
+	}
+	cm.done();
+}
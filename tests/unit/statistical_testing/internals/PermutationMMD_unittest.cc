@@ -546,3 +546,57 @@ TEST(PermutationMMD, unbiased_incomplete_multi_kernel)
 		kernel->remove_lhs_and_rhs();
 	}
 }
+
+TEST(PermutationMMD, multiple_batches_and_tiles_single_kernel)
+{
+	const index_t seed=12345;
+	const index_t dim=2;
+	const index_t n=150;
+	const index_t m=150;
+	const index_t num_null_samples=internal::mmd::PermutationMMD::kBatchSize+3;
+
+	std::mt19937_64 prng(seed);
+	auto gen_p=std::make_shared<MeanShiftDataGenerator>(0, dim, 0);
+	auto gen_q=std::make_shared<MeanShiftDataGenerator>(0.5, dim, 0);
+	gen_p->put("seed", seed);
+	gen_q->put("seed", seed);
+	auto feats_p=gen_p->get_streamed_features(n);
+	auto feats_q=gen_q->get_streamed_features(m);
+	auto feats=feats_p->create_merged_copy(feats_q);
+
+	auto kernel=std::make_shared<GaussianKernel>();
+	kernel->set_width(2.0);
+	kernel->init(feats, feats);
+	auto kernel_matrix=kernel->get_kernel_matrix<float32_t>();
+	ASSERT_GT(kernel_matrix.num_rows, internal::mmd::PermutationMMD::kTileSize);
+
+	for (auto stype : {ST_BIASED_FULL, ST_UNBIASED_FULL, ST_UNBIASED_INCOMPLETE})
+	{
+		auto permutation_mmd=internal::mmd::PermutationMMD();
+		permutation_mmd.m_n_x=n;
+		permutation_mmd.m_n_y=m;
+		permutation_mmd.m_stype=stype;
+		permutation_mmd.m_num_null_samples=num_null_samples;
+
+		prng.seed(seed);
+		SGVector<float32_t> result_1=permutation_mmd(kernel_matrix, prng);
+
+		auto compute_mmd=internal::mmd::ComputeMMD();
+		compute_mmd.m_n_x=n;
+		compute_mmd.m_n_y=m;
+		compute_mmd.m_stype=stype;
+
+		Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
+		prng.seed(seed);
+		for (auto i=0; i<num_null_samples; ++i)
+		{
+			PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
+			perm.setIdentity();
+			SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
+			random::shuffle(perminds, prng);
+			MatrixXf permuted = perm.transpose()*map*perm;
+			SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
+			EXPECT_NEAR(result_1[i], compute_mmd(permuted_km), 1E-5);
+		}
+	}
+}
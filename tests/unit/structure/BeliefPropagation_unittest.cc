@@ -5,6 +5,7 @@
 #include <shogun/structure/Factor.h>
 #include <shogun/labels/FactorGraphLabels.h>
 #include <shogun/structure/MAPInference.h>
+#include <shogun/structure/BeliefPropagation.h>
 #include <shogun/structure/FactorGraphDataGenerator.h>
 
 #include <gtest/gtest.h>
@@ -168,3 +169,113 @@ TEST(BeliefPropagation, tree_max_product_multi_states)
 
 }
 
+TEST(BeliefPropagation, loopy_max_product_multi_states)
+{
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+	auto fg = fg_test_data->multi_state_tree_graph();
+
+	// loopy belief propagation is exact on trees
+	for (auto schedule : {BP_SYNCHRONOUS, BP_RESIDUAL})
+	{
+		LoopyMaxProduct bp(fg);
+		bp.set_schedule(schedule);
+
+		SGVector<int32_t> assignment(fg->get_num_vars());
+		float64_t energy = bp.inference(assignment);
+
+		EXPECT_TRUE(bp.is_converged());
+		EXPECT_EQ(assignment[0],2);
+		EXPECT_EQ(assignment[1],0);
+		EXPECT_EQ(assignment[2],2);
+		EXPECT_NEAR(-3.8, energy, 1E-10);
+	}
+}
+
+TEST(BeliefPropagation, loopy_max_product_grid)
+{
+	int32_t w = 4;
+
+	SGVector<int32_t> card(2);
+	card[0] = 2;
+	card[1] = 2;
+	auto pairwise = std::make_shared<TableFactorType>(0, card, SGVector<float64_t>());
+
+	SGVector<int32_t> card1(1);
+	card1[0] = 2;
+	auto unary = std::make_shared<TableFactorType>(1, card1, SGVector<float64_t>());
+
+	SGVector<int32_t> vc(w * w);
+	SGVector<int32_t>::fill_vector(vc.vector, vc.vlen, 2);
+	auto fg = std::make_shared<FactorGraph>(vc);
+
+	// left half prefers state 1, right half state 0, one pixel only weakly
+	for (int32_t y = 0; y < w; ++y)
+	{
+		for (int32_t x = 0; x < w; ++x)
+		{
+			SGVector<float64_t> data(2);
+			data[0] = x < w / 2 ? 1.0 : 0.0;
+			data[1] = x < w / 2 ? 0.0 : 1.0;
+			if (x == 0 && y == 1)
+			{
+				data[0] = 0.6;
+				data[1] = 0.4;
+			}
+
+			SGVector<int32_t> var_index(1);
+			var_index[0] = grid_to_index(x, y, w);
+			fg->add_factor(std::make_shared<Factor>(unary, var_index, data));
+		}
+	}
+
+	// attractive Potts potentials over the 4-neighbourhood
+	for (int32_t y = 0; y < w; ++y)
+	{
+		for (int32_t x = 0; x < w; ++x)
+		{
+			SGVector<float64_t> data(4);
+			data[0] = 0.0;
+			data[1] = 0.3;
+			data[2] = 0.3;
+			data[3] = 0.0;
+
+			SGVector<int32_t> var_index(2);
+			var_index[0] = grid_to_index(x, y, w);
+			if (x > 0)
+			{
+				var_index[1] = grid_to_index(x - 1, y, w);
+				fg->add_factor(std::make_shared<Factor>(pairwise, var_index, data));
+			}
+			if (y > 0)
+			{
+				var_index[1] = grid_to_index(x, y - 1, w);
+				fg->add_factor(std::make_shared<Factor>(pairwise, var_index, data));
+			}
+		}
+	}
+
+	fg->connect_components();
+	fg->compute_energies();
+	EXPECT_FALSE(fg->is_tree_graph());
+
+	// graph cuts are exact for submodular energies
+	MAPInference graph_cut(fg, GRAPH_CUT);
+	graph_cut.inference();
+	SGVector<int32_t> assignment_expected = graph_cut.get_structured_outputs()->get_data();
+
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_expected[i]);
+	EXPECT_NEAR(graph_cut.get_energy(), infer_met.get_energy(), 1E-10);
+
+	LoopyMaxProduct bp(fg);
+	bp.set_schedule(BP_RESIDUAL);
+	bp.inference(assignment);
+
+	EXPECT_TRUE(bp.is_converged());
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_expected[i]);
+}
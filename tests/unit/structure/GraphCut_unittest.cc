@@ -47,6 +47,100 @@ TEST(GraphCut, graph_cut_st_graph)
 
 }
 
+// Test max-flow on an s-t graph whose capacities change after a max-flow
+TEST(GraphCut, graph_cut_st_graph_reuse_trees)
+{
+	int32_t num_nodes = 5;
+	int32_t num_edges = 6;
+
+	// terminal capacities and edges after the changes below
+	float64_t cap_source[] = {1, 2, 8, 0, 0};
+	float64_t cap_sink[] = {0, 0, 4, 7, 7};
+	int32_t edges[][2] = {{0, 2}, {0, 3}, {1, 2}, {1, 4}, {2, 3}, {2, 4}};
+	float64_t caps[] = {1, 2, 6, 2, 1, 3};
+
+	auto g = std::make_shared<GraphCut>(num_nodes, num_edges);
+	g->add_tweights(0, 4, 0);
+	g->add_tweights(1, 2, 0);
+	g->add_tweights(2, 8, 0);
+	g->add_tweights(2, 0, 4);
+	g->add_tweights(3, 0, 7);
+	g->add_tweights(4, 0, 5);
+
+	g->add_edge(0, 2, 5, 0);
+	g->add_edge(0, 3, 2, 0);
+	g->add_edge(1, 2, 6, 0);
+	g->add_edge(1, 4, 9, 0);
+	g->add_edge(2, 3, 1, 0);
+	g->add_edge(2, 4, 3, 0);
+
+	g->init_maxflow();
+	EXPECT_EQ(g->compute_maxflow(), 12);
+
+	// reduce capacities below their flow and increase others
+	g->update_tweights(0, -3, 0);
+	g->update_tweights(4, 0, 2);
+	g->update_edge(0, -4, 0);
+	g->update_edge(3, -7, 0);
+	float64_t flow = g->compute_maxflow(true);
+
+	auto g_new = std::make_shared<GraphCut>(num_nodes, num_edges);
+	for (int32_t i = 0; i < num_nodes; i++)
+		g_new->add_tweights(i, cap_source[i], cap_sink[i]);
+	for (int32_t e = 0; e < num_edges; e++)
+		g_new->add_edge(edges[e][0], edges[e][1], caps[e], 0);
+
+	g_new->init_maxflow();
+	EXPECT_NEAR(g_new->compute_maxflow(), flow, 1E-10);
+
+	// the assignment is a minimum cut of the changed graph
+	float64_t cut = 0;
+	for (int32_t i = 0; i < num_nodes; i++)
+		cut += g->get_assignment(i) == SOURCE ? cap_sink[i] : cap_source[i];
+	for (int32_t e = 0; e < num_edges; e++)
+	{
+		if (g->get_assignment(edges[e][0]) == SOURCE && g->get_assignment(edges[e][1]) == SINK)
+			cut += caps[e];
+	}
+	EXPECT_NEAR(cut, flow, 1E-10);
+}
+
+// Test graph-cuts inference repeated after the energies changed
+TEST(GraphCut, graph_cut_repeated_inference)
+{
+	SGVector<int32_t> assignment_expected;
+	float64_t min_energy_expected;
+
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+	fg_test_data->put("seed", 10);
+	auto fg = fg_test_data->random_chain_graph(assignment_expected, min_energy_expected, 3);
+
+	auto gc = std::make_shared<GraphCut>(fg);
+	SGVector<int32_t> assignment(fg->get_num_vars());
+	EXPECT_NEAR(gc->inference(assignment), fg->evaluate_energy(assignment), 1E-10);
+
+	for (int32_t iter = 0; iter < 3; iter++)
+	{
+		// flip the unary energies
+		for (auto& fac : fg->get_factors())
+		{
+			if (fac->get_num_vars() != 1)
+				continue;
+
+			SGVector<float64_t> energies = fac->get_energies().clone();
+			std::swap(energies[0], energies[1]);
+			fac->set_energies(energies);
+		}
+
+		float64_t energy = gc->inference(assignment);
+
+		auto gc_new = std::make_shared<GraphCut>(fg);
+		SGVector<int32_t> assignment_new(fg->get_num_vars());
+		EXPECT_NEAR(gc_new->inference(assignment_new), energy, 1E-10);
+		EXPECT_NEAR(fg->evaluate_energy(assignment), energy, 1E-10);
+	}
+}
+
 // Test graph-cuts inference for a simple two nodes chain structure graph
 TEST(GraphCut, graph_cut_chain)
 {
@@ -0,0 +1,37 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/structure/Plif.h>
+
+using namespace shogun;
+
+TEST(Plif, lookup_penalty)
+{
+	auto plif=std::make_shared<Plif>(4);
+	SGVector<float64_t> limits({1.0, 2.0, 4.0, 8.0});
+	SGVector<float64_t> penalties({0.0, 1.0, 3.0, -1.0});
+	plif->set_plif_limits(limits);
+	plif->set_plif_penalty(penalties);
+	plif->set_min_value(0);
+	plif->set_max_value(10);
+
+	// constant outside of the limits
+	EXPECT_DOUBLE_EQ(plif->lookup(0.5), 0.0);
+	EXPECT_DOUBLE_EQ(plif->lookup(9.0), -1.0);
+	// exact at the limits
+	EXPECT_DOUBLE_EQ(plif->lookup(1.0), 0.0);
+	EXPECT_DOUBLE_EQ(plif->lookup(4.0), 3.0);
+	// linear in between
+	EXPECT_DOUBLE_EQ(plif->lookup(1.5), 0.5);
+	EXPECT_DOUBLE_EQ(plif->lookup(3.0), 2.0);
+	EXPECT_DOUBLE_EQ(plif->lookup(6.0), 1.0);
+	// the integer lookup agrees
+	EXPECT_DOUBLE_EQ(plif->lookup_penalty(3, NULL), 2.0);
+	// out of range
+	EXPECT_EQ(plif->lookup(11.0), -Math::INFTY);
+}
@@ -176,4 +176,59 @@ TEST(SOSVM, fw_check_w_helper)
 
 
 
+}
+
+TEST(SOSVM, argmax_batch_matches_argmax)
+{
+	int32_t num_samples = 6;
+
+	// define factor type
+	SGVector<int32_t> card(1);
+	card[0] = 2;
+	SGVector<float64_t> w(2);
+	w[0] = -1;
+	w[1] = 1;
+	int32_t tid = 0;
+	auto factortype = std::make_shared<TableFactorType>(tid, card, w);
+
+	// create features and labels
+	auto instances = std::make_shared<FactorGraphFeatures>(num_samples);
+	auto labels = std::make_shared<FactorGraphLabels>(num_samples);
+
+	for (int32_t n = 0; n < num_samples; ++n)
+	{
+		SGVector<int32_t> vc(1);
+		vc[0] = 2;
+		auto fg = std::make_shared<FactorGraph>(vc);
+
+		SGVector<float64_t> data1(1);
+		data1[0] = n % 2 ? -1.0 : 1.0;
+		SGVector<int32_t> var_index1(1);
+		var_index1[0] = 0;
+		auto fac1 = std::make_shared<Factor>(factortype, var_index1, data1);
+		fg->add_factor(fac1);
+		instances->add_sample(fg);
+
+		fg->connect_components();
+		fg->compute_energies();
+
+		MAPInference infer_met(fg, TREE_MAX_PROD);
+		infer_met.inference();
+		labels->add_label(infer_met.get_structured_outputs());
+	}
+
+	auto model = std::make_shared<FactorGraphModel>(instances, labels, TREE_MAX_PROD, false);
+	model->add_factor_type(factortype);
+
+	SGVector<int32_t> feat_idx({4, 1, 0, 5, 2});
+	auto results = model->argmax_batch(w, feat_idx);
+	ASSERT_EQ(results.size(), feat_idx.vlen);
+
+	for (int32_t i = 0; i < feat_idx.vlen; ++i)
+	{
+		auto result = model->argmax(w, feat_idx[i]);
+		EXPECT_NEAR(result->score, results[i]->score, 1E-10);
+		EXPECT_NEAR(result->delta, results[i]->delta, 1E-10);
+		EXPECT_TRUE(result->argmax->equals(results[i]->argmax));
+	}
 }
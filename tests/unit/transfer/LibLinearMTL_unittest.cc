@@ -0,0 +1,119 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/transfer/multitask/LibLinearMTL.h>
+
+#include <cmath>
+
+using namespace shogun;
+using namespace Eigen;
+
+TEST(LibLinearMTL, chain_of_tasks)
+{
+	// every task separates the data along a slowly rotating direction, the
+	// similarity couples neighbouring tasks only
+	const index_t num_tasks = 6;
+	const index_t num_per_task = 40;
+	const index_t num_vec = num_tasks * num_per_task;
+	std::mt19937_64 prng(11);
+	NormalDistribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(2, num_vec);
+	SGVector<float64_t> lab(num_vec);
+	SGVector<int32_t> task_indicator(num_vec);
+	for (auto i : range(num_vec))
+	{
+		const int32_t t = i % num_tasks;
+		const float64_t angle = 0.2 * t;
+		data(0, i) = normal(prng);
+		data(1, i) = normal(prng);
+		lab[i] = std::cos(angle) * data(0, i) + std::sin(angle) * data(1, i) > 0
+			? 1 : -1;
+		task_indicator[i] = t;
+	}
+
+	SGMatrix<float64_t> similarity(num_tasks, num_tasks);
+	similarity.zero();
+	for (auto t : range(num_tasks))
+	{
+		similarity(t, t) = 1.0;
+		if (t > 0)
+		{
+			similarity(t, t - 1) = 0.2;
+			similarity(t - 1, t) = 0.2;
+		}
+	}
+	// the primal regularizer of the similarity M is given by M^-1 - I
+	SGMatrix<float64_t> laplacian(num_tasks, num_tasks);
+	Map<MatrixXd>(laplacian.matrix, num_tasks, num_tasks) =
+		Map<MatrixXd>(similarity.matrix, num_tasks, num_tasks).inverse() -
+		MatrixXd::Identity(num_tasks, num_tasks);
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<BinaryLabels>(lab);
+	auto svm = std::make_shared<LibLinearMTL>(1.0, features, labels);
+	svm->set_bias_enabled(false);
+	svm->set_epsilon(1e-6);
+	svm->set_num_tasks(num_tasks);
+	svm->set_task_indicator_lhs(task_indicator);
+	svm->set_task_indicator_rhs(task_indicator);
+	svm->set_task_similarity_matrix(SGSparseMatrix<float64_t>(similarity));
+	svm->set_graph_laplacian(laplacian);
+	svm->put("seed", 3);
+	svm->train();
+
+	auto alphas = svm->get_alphas();
+	for (auto i : range(num_vec))
+	{
+		EXPECT_GE(alphas[i], 0);
+		EXPECT_LE(alphas[i], 1.0);
+	}
+
+	// no duality gap at the optimum
+	const float64_t primal = svm->compute_primal_obj();
+	const float64_t dual = svm->compute_dual_obj();
+	EXPECT_GE(primal, dual - 1e-8);
+	EXPECT_NEAR(primal, dual, 1e-3 * std::abs(primal));
+
+	auto W = svm->get_W();
+	index_t num_correct = 0;
+	for (auto i : range(num_vec))
+	{
+		const int32_t t = task_indicator[i];
+		const float64_t f = W(0, t) * data(0, i) + W(1, t) * data(1, i);
+		num_correct += (f > 0 ? 1 : -1) == lab[i];
+	}
+	EXPECT_GT(num_correct, 0.9 * num_vec);
+}
+
+TEST(LibLinearMTL, task_out_of_range)
+{
+	SGMatrix<float64_t> data(1, 2);
+	data(0, 0) = 1;
+	data(0, 1) = -1;
+	SGVector<float64_t> lab({1, -1});
+	SGVector<int32_t> task_indicator({0, 2});
+
+	SGMatrix<float64_t> similarity(2, 2);
+	similarity.set_const(1.0);
+
+	auto svm = std::make_shared<LibLinearMTL>(
+		1.0, std::make_shared<DenseFeatures<float64_t>>(data),
+		std::make_shared<BinaryLabels>(lab));
+	svm->set_num_tasks(2);
+	svm->set_task_indicator_lhs(task_indicator);
+	svm->set_task_similarity_matrix(SGSparseMatrix<float64_t>(similarity));
+	EXPECT_THROW(svm->train(), ShogunException);
+}
+#endif // HAVE_LAPACK
@@ -0,0 +1,49 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: Soeren Sonnenburg
+ */
+#include <gtest/gtest.h>
+#include <shogun/transfer/multitask/MultitaskKernelMaskNormalizer.h>
+#include <shogun/transfer/multitask/MultitaskKernelMaskPairNormalizer.h>
+
+#include <utility>
+#include <vector>
+
+using namespace shogun;
+
+TEST(MultitaskKernelMaskPairNormalizer, get_similarity)
+{
+	// the second set of pairs has too many task ids for the dense table
+	for (int32_t offset : {0, 10000})
+	{
+		std::vector<std::pair<int32_t, int32_t>> pairs{
+			{0, 1}, {3 + offset, 2}, {4 + offset, 4 + offset}};
+		MultitaskKernelMaskPairNormalizer normalizer(
+			std::vector<int32_t>{0, 1, 2}, pairs);
+
+		EXPECT_EQ(normalizer.get_similarity(0, 1), 1.0);
+		EXPECT_EQ(normalizer.get_similarity(1, 0), 1.0);
+		EXPECT_EQ(normalizer.get_similarity(2, 3 + offset), 1.0);
+		EXPECT_EQ(normalizer.get_similarity(3 + offset, 2), 1.0);
+		EXPECT_EQ(normalizer.get_similarity(4 + offset, 4 + offset), 1.0);
+		EXPECT_EQ(normalizer.get_similarity(0, 0), 0.0);
+		EXPECT_EQ(normalizer.get_similarity(1, 2), 0.0);
+		EXPECT_EQ(normalizer.get_similarity(3 + offset, 3 + offset), 0.0);
+		EXPECT_EQ(normalizer.get_similarity(20000, 0), 0.0);
+		EXPECT_EQ(normalizer.get_similarity(-1, 0), 0.0);
+	}
+}
+
+TEST(MultitaskKernelMaskNormalizer, get_similarity)
+{
+	MultitaskKernelMaskNormalizer normalizer(
+		std::vector<int32_t>{0, 1, 2}, std::vector<int32_t>{0, 1, 2},
+		std::vector<int32_t>{1, 5});
+
+	EXPECT_EQ(normalizer.get_similarity(1, 5), 1.0);
+	EXPECT_EQ(normalizer.get_similarity(5, 5), 1.0);
+	EXPECT_EQ(normalizer.get_similarity(0, 1), 0.0);
+	EXPECT_EQ(normalizer.get_similarity(1, 6), 0.0);
+	EXPECT_EQ(normalizer.get_similarity(-1, 1), 0.0);
+}